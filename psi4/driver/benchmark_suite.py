@@ -0,0 +1,269 @@
+#
+# @BEGIN LICENSE
+#
+# Psi4: an open-source quantum chemistry software package
+#
+# Copyright (c) 2007-2023 The Psi4 Developers.
+#
+# The copyrights for code used from other parties are included in
+# the corresponding files.
+#
+# This file is part of Psi4.
+#
+# Psi4 is free software; you can redistribute it and/or modify
+# it under the terms of the GNU Lesser General Public License as published by
+# the Free Software Foundation, version 3.
+#
+# Psi4 is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public License along
+# with Psi4; if not, write to the Free Software Foundation, Inc.,
+# 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+#
+# @END LICENSE
+#
+
+"""
+Fixed-input performance benchmarks of the hot kernels, for tracking performance
+across releases and machines. Results are returned (and optionally written) as JSON.
+"""
+
+__all__ = [
+    "run_benchmark_suite",
+]
+
+import datetime
+import json
+import platform
+import time
+from typing import Callable, Dict, List, Optional
+
+import numpy as np
+
+from psi4 import core
+from psi4.metadata import __version__
+
+from . import driver, p4util
+from .p4util.exceptions import ValidationError
+
+# Fixed inputs; changing them invalidates comparisons with earlier results
+_benzene = """
+0 1
+C    0.000000    1.396792    0.000000
+C    1.209657    0.698396    0.000000
+C    1.209657   -0.698396    0.000000
+C    0.000000   -1.396792    0.000000
+C   -1.209657   -0.698396    0.000000
+C   -1.209657    0.698396    0.000000
+H    0.000000    2.484212    0.000000
+H    2.151390    1.242106    0.000000
+H    2.151390   -1.242106    0.000000
+H    0.000000   -2.484212    0.000000
+H   -2.151390   -1.242106    0.000000
+H   -2.151390    1.242106    0.000000
+symmetry c1
+no_reorient
+no_com
+"""
+
+_water = """
+0 1
+O    0.000000    0.000000    0.117790
+H    0.000000    0.755453   -0.471161
+H    0.000000   -0.755453   -0.471161
+symmetry c1
+no_reorient
+no_com
+"""
+
+_jk_types = ["PK", "DIRECT", "MEM_DF", "DISK_DF", "CD"]
+
+_kernels = ["jk", "xc", "df_transform", "dpd_ccsd", "triples", "ci_sigma", "psio"]
+
+
+def _time(work: Callable[[], None], repeats: int) -> Dict[str, float]:
+    times = []
+    for _ in range(repeats):
+        start = time.perf_counter()
+        work()
+        times.append(time.perf_counter() - start)
+    return {"min": min(times), "mean": sum(times) / len(times), "repeats": repeats}
+
+
+def _molecule(geometry: str) -> core.Molecule:
+    mol = core.Molecule.from_string(geometry)
+    mol.update_geometry()
+    return mol
+
+
+def _occupied_orbitals(basis: core.BasisSet, nocc: int) -> core.Matrix:
+    # Fixed seed, orthonormal in the AO metric
+    S = core.MintsHelper(basis).ao_overlap().np
+    C = np.random.default_rng(1).standard_normal((basis.nbf(), nocc))
+    L = np.linalg.cholesky(C.T @ S @ C)
+    return core.Matrix.from_array(np.linalg.solve(L, C.T).T)
+
+
+def _bench_jk(repeats: int) -> Dict:
+    mol = _molecule(_benzene)
+    basis = core.BasisSet.build(mol, "ORBITAL", "CC-PVDZ")
+    aux = core.BasisSet.build(mol, "DF_BASIS_SCF", "", "JKFIT", "CC-PVDZ")
+    C = _occupied_orbitals(basis, 21)
+
+    results = {}
+    for jk_type in _jk_types:
+        start = time.perf_counter()
+        jk = core.JK.build(basis, aux=aux if "DF" in jk_type else None, jk_type=jk_type)
+        jk.set_memory(int(core.get_memory() * 0.8 / 8))
+        jk.initialize()
+        setup = time.perf_counter() - start
+        jk.C_add(C)
+        results[jk_type] = _time(jk.compute, repeats)
+        results[jk_type]["setup"] = setup
+        results[jk_type]["gemm_flops"] = jk.stats().gemm_flops
+        jk.finalize()
+    return results
+
+
+def _scf(geometry: str, method: str, basis: str, scf_type: str):
+    optstash = p4util.OptionsState(["BASIS"], ["SCF_TYPE"], ["SCF", "E_CONVERGENCE"], ["SCF", "D_CONVERGENCE"])
+    core.set_global_option("BASIS", basis)
+    core.set_global_option("SCF_TYPE", scf_type)
+    core.set_local_option("SCF", "E_CONVERGENCE", 1.e-10)
+    core.set_local_option("SCF", "D_CONVERGENCE", 1.e-10)
+    mol = _molecule(geometry)
+    _, wfn = driver.energy(method, molecule=mol, return_wfn=True)
+    optstash.restore()
+    return mol, wfn
+
+
+def _bench_xc(repeats: int) -> Dict:
+    _, wfn = _scf(_benzene, "B3LYP", "CC-PVDZ", "DF")
+    Vpot = wfn.V_potential()
+    Vpot.set_D([wfn.Da()])
+    V = core.Matrix("V", wfn.nso(), wfn.nso())
+    return {"B3LYP": _time(lambda: Vpot.compute_V([V]), repeats)}
+
+
+def _bench_df_transform(repeats: int) -> Dict:
+    mol = _molecule(_benzene)
+    basis = core.BasisSet.build(mol, "ORBITAL", "CC-PVDZ")
+    aux = core.BasisSet.build(mol, "DF_BASIS_MP2", "", "RIFIT", "CC-PVDZ")
+    C = core.Matrix.from_array(np.linalg.qr(np.random.default_rng(1).standard_normal((basis.nbf(), basis.nbf())))[0])
+    Cocc = core.Matrix.from_array(C.np[:, :21])
+    Cvir = core.Matrix.from_array(C.np[:, 21:])
+
+    def work():
+        dfh = core.DFHelper(basis, aux)
+        dfh.set_memory(int(core.get_memory() * 0.8 / 8))
+        dfh.set_nthreads(core.get_num_threads())
+        dfh.initialize()
+        dfh.add_space("i", Cocc)
+        dfh.add_space("a", Cvir)
+        dfh.add_transformation("iaQ", "i", "a", "pqQ")
+        dfh.transform()
+        dfh.clear_all()
+
+    return {"iaQ": _time(work, repeats)}
+
+
+def _bench_correlated(method: str, repeats: int) -> Dict:
+    mol, wfn = _scf(_water, "SCF", "CC-PVDZ", "PK")
+    optstash = p4util.OptionsState(["BASIS"], ["QC_MODULE"])
+    core.set_global_option("BASIS", "CC-PVDZ")
+    core.set_global_option("QC_MODULE", "DETCI" if method == "detci" else "CCENERGY")
+    result = _time(lambda: driver.energy(method, molecule=mol, ref_wfn=wfn), repeats)
+    optstash.restore()
+    return result
+
+
+def _bench_psio(repeats: int) -> Dict:
+    return core.benchmark_disk(10, 0.05 * repeats)
+
+
+def run_benchmark_suite(kernels: Optional[List[str]] = None,
+                        threads: Optional[List[int]] = None,
+                        repeats: int = 3,
+                        filename: Optional[str] = None) -> Dict:
+    """Time the hot kernels of |PSIfour| on fixed inputs over a sweep of thread counts.
+
+    The kernels are JK builds per algorithm (PK, DIRECT, MEM_DF, DISK_DF, CD) and XC
+    integration (B3LYP) on benzene/cc-pVDZ, the DF-MP2 (ia|Q) transform, DPD
+    contractions (CCSD), the (T) correction and the CI sigma build (CISD) on
+    water/cc-pVDZ, and PSIO throughput. Wall times are measured around the kernel
+    only; setup such as the SCF reference is excluded.
+
+    Parameters
+    ----------
+    kernels
+        Subset of ``jk``, ``xc``, ``df_transform``, ``dpd_ccsd``, ``triples``,
+        ``ci_sigma`` and ``psio``. Defaults to all.
+    threads
+        Thread counts to sweep. Defaults to powers of two up to, and including,
+        the current :py:func:`~psi4.core.get_num_threads`.
+    repeats
+        Number of timed repetitions of each kernel.
+    filename
+        If given, the results are also written to this file as JSON.
+
+    Returns
+    -------
+    dict
+        Version and host information, and per kernel and thread count the
+        ``min`` and ``mean`` wall times [s] (throughputs [B/s] for ``psio``).
+
+    """
+    kernels = _kernels if kernels is None else [k.lower() for k in kernels]
+    unknown = set(kernels) - set(_kernels)
+    if unknown:
+        raise ValidationError(f"Unknown benchmark kernels {sorted(unknown)}; choose from {_kernels}.")
+
+    nthread = core.get_num_threads()
+    if threads is None:
+        threads = [n for n in (2**k for k in range(nthread.bit_length())) if n < nthread] + [nthread]
+
+    bench = {
+        "jk": _bench_jk,
+        "xc": _bench_xc,
+        "df_transform": _bench_df_transform,
+        "dpd_ccsd": lambda repeats: _bench_correlated("ccsd", repeats),
+        "triples": lambda repeats: _bench_correlated("ccsd(t)", repeats),
+        "ci_sigma": lambda repeats: _bench_correlated("detci", repeats),
+        "psio": _bench_psio,
+    }
+
+    results = {
+        "psi4_version": __version__,
+        "host": platform.node(),
+        "machine": platform.machine(),
+        "processor": platform.processor(),
+        "date": datetime.datetime.now().isoformat(),
+        "memory": core.get_memory(),
+        "repeats": repeats,
+        "kernels": {},
+    }
+
+    try:
+        for kernel in kernels:
+            results["kernels"][kernel] = {}
+            for n in threads:
+                core.set_num_threads(n, quiet=True)
+                core.print_out(f"\n  ==> Benchmark {kernel} on {n} threads <==\n\n")
+                results["kernels"][kernel][str(n)] = bench[kernel](repeats)
+                core.clean()
+    finally:
+        core.set_num_threads(nthread, quiet=True)
+
+    # (T) alone is the difference to the preceding CCSD
+    if "triples" in kernels and "dpd_ccsd" in kernels:
+        for n, data in results["kernels"]["triples"].items():
+            data["triples_only"] = data["min"] - results["kernels"]["dpd_ccsd"][n]["min"]
+
+    if filename is not None:
+        with open(filename, "w") as handle:
+            json.dump(results, handle, indent=1)
+
+    return results
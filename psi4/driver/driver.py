@@ -160,6 +160,8 @@ def energy(name, **kwargs):
     +-------------------------+---------------------------------------------------------------------------------------------------------------------------------------+
     | scs-dlpno-mp2           | spin-component-scaled DLPNO MP2 :ref:`[manual] <sec:dlpnomp2>`                                                                        |
     +-------------------------+---------------------------------------------------------------------------------------------------------------------------------------+
+    | mp2-f12                 | explicitly correlated DF-MP2-F12/3C(FIX) :ref:`[manual] <sec:dfmp2f12>`                                                               |
+    +-------------------------+---------------------------------------------------------------------------------------------------------------------------------------+
     | mp3                     | 3rd-order |MollerPlesset| perturbation theory (MP3) :ref:`[manual] <sec:occ_nonoo>` :ref:`[details] <dd_mp3>`                         |
     +-------------------------+---------------------------------------------------------------------------------------------------------------------------------------+
     | fno-mp3                 | MP3 with frozen natural orbitals :ref:`[manual] <sec:fnocc>`                                                                          |
@@ -487,7 +489,12 @@ def energy(name, **kwargs):
             restartfile = (restartfile, )
         # Rename the files to be read to be consistent with psi4's file system
         for item in restartfile:
-            is_numpy_file = (os.path.isfile(item) and item.endswith(".npy")) or os.path.isfile(item + ".npy")
+            # serialized wavefunctions are .npy files or, from to_file(..., compress=True), .npz archives
+            suffix = ".npy"
+            if item.endswith(".npz") or (not item.endswith(".npy") and not os.path.isfile(item + ".npy")
+                                         and os.path.isfile(item + ".npz")):
+                suffix = ".npz"
+            is_numpy_file = (os.path.isfile(item) and item.endswith(suffix)) or os.path.isfile(item + suffix)
             name_split = re.split(r'\.', item)
             if is_numpy_file:
                 core.set_local_option('SCF', 'GUESS' ,'READ')
@@ -495,9 +502,9 @@ def energy(name, **kwargs):
                 fname = os.path.split(os.path.abspath(core.get_writer_file_prefix(molecule.name())))[1]
                 psi_scratch = core.IOManager.shared_object().get_default_path()
                 file_num = item.split('.')[-2] if "180" in item else "180"
-                targetfile = os.path.join(psi_scratch, fname + "." + file_num + ".npy")
-                if not item.endswith(".npy"):
-                    item = item + ".npy"
+                targetfile = os.path.join(psi_scratch, fname + "." + file_num + suffix)
+                if not item.endswith(suffix):
+                    item = item + suffix
             else:
                 filenum = name_split[-1]
                 try:
@@ -139,6 +139,7 @@ FiniteDifferenceComputer.get_psi_results()
 
 import copy
 import logging
+import os
 from functools import partial
 from typing import TYPE_CHECKING, Any, Callable, Dict, Iterator, List, Optional, Tuple, Union
 
@@ -1244,6 +1245,15 @@ class FiniteDifferenceComputer(BaseComputer):
         core.print_out(info)
         logger.debug(info)
 
+        # The reference writes its orbitals so that every displaced SCF starts from them, projected onto the
+        #   displaced basis, rather than from a fresh SAD guess. A user-named file is kept; a scratch one is not.
+        orbital_file = data["keywords"]["function_kwargs"].get("write_orbitals")
+        if not isinstance(orbital_file, str):
+            orbital_file = os.path.join(core.IOManager.shared_object().get_default_path(),
+                                        f"psi.{os.getpid()}.findif_reference.npy")
+            data["keywords"]["function_kwargs"]["write_orbitals"] = orbital_file
+            self.metameta['scratch_orbital_file'] = orbital_file
+
         # var_dict = core.variables()
         packet = {
             "molecule": self.molecule,
@@ -1285,7 +1295,7 @@ class FiniteDifferenceComputer(BaseComputer):
                 "keywords": data["keywords"] or {},
             }
             # Displacements can run in lower symmetry. Don't overwrite orbitals from reference geom
-            packet['keywords']['function_kwargs'].update({"write_orbitals": False})
+            packet['keywords']['function_kwargs'].update({"write_orbitals": False, "guess_orbitals": orbital_file})
             if 'cbs_metadata' in data:
                 packet['cbs_metadata'] = data['cbs_metadata']
 
@@ -1313,6 +1323,10 @@ class FiniteDifferenceComputer(BaseComputer):
             for t in self.task_list.values():
                 t.compute(client=client)
 
+        orbital_file = self.metameta.get('scratch_orbital_file')
+        if orbital_file and os.path.isfile(orbital_file):
+            os.remove(orbital_file)
+
     def _prepare_results(self, client: Optional["qcportal.FractalClient"] = None):
         results_list = {k: v.get_results(client=client) for k, v in self.task_list.items()}
 
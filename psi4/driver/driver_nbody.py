@@ -167,7 +167,7 @@ from .constants import constants, pp
 from .driver_cbs import CompositeComputer
 from .driver_findif import FiniteDifferenceComputer
 from .p4util.exceptions import *
-from .task_base import AtomicComputer, BaseComputer, EnergyGradientHessianWfnReturn
+from .task_base import AtomicComputer, BaseComputer, EnergyGradientHessianWfnReturn, compute_concurrently
 
 if TYPE_CHECKING:
     import qcportal
@@ -236,6 +236,13 @@ def nbody():
         Dictionary of atom-centered point charges. keys: 1-based index of fragment, values: list of charges for each fragment.
         Add atom-centered point charges for fragments whose basis sets are not included in the computation.
 
+    :type concurrent_tasks: int
+    :param concurrent_tasks: |dl| ``1`` |dr| || ``4`` || etc.
+
+        Number of subsystem single-points to run simultaneously, each as its
+        own Psi4 process sharing out the threads and memory of this job. Requires
+        a ``psi4`` executable in ``PATH``; otherwise tasks run one at a time.
+
     """
 
 
@@ -864,6 +871,7 @@ class ManyBodyComputer(BaseComputer):
     embedding_charges: Dict[int, List[float]] = Field({}, description="Atom-centered point charges to be used on molecule fragments whose basis sets are not included in the computation. Keys: 1-based index of fragment. Values: list of atom charges for that fragment.")
 
     return_total_data: Optional[bool] = Field(None, description="When True, returns the total data (energy/gradient/Hessian) of the system, otherwise returns interaction data. Default is False for energies, True for gradients and Hessians. Note that the calculation of total counterpoise corrected energies implies the calculation of the energies of monomers in the monomer basis, hence specifying ``return_total_data = True`` may carry out more computations than ``return_total_data = False``.")
+    concurrent_tasks: int = Field(1, description="Number of independent single-point subsystem computations to run at once, each as a separate Psi4 process with an even share of the parent's threads and memory. Composite and finite-difference subtasks always run serially. Ignored when computing through QCFractal.")
     quiet: bool = Field(False, description="Whether to print/log formatted n-body energy analysis. Presently used by multi to suppress output. Candidate for removal from class once in-class/out-of-class functions sorted.")
 
     task_list: Dict[str, SubTaskComputers] = {}
@@ -1016,6 +1024,10 @@ class ManyBodyComputer(BaseComputer):
         logger.info(info)
 
         with p4util.hold_options_state():
+            if client is None and self.concurrent_tasks > 1:
+                atomic = [t for t in self.task_list.values() if isinstance(t, AtomicComputer)]
+                compute_concurrently(atomic, self.concurrent_tasks)
+
             for t in self.task_list.values():
                 t.compute(client=client)
 
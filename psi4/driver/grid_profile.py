@@ -0,0 +1,147 @@
+#
+# @BEGIN LICENSE
+#
+# Psi4: an open-source quantum chemistry software package
+#
+# Copyright (c) 2007-2023 The Psi4 Developers.
+#
+# The copyrights for code used from other parties are included in
+# the corresponding files.
+#
+# This file is part of Psi4.
+#
+# Psi4 is free software; you can redistribute it and/or modify
+# it under the terms of the GNU Lesser General Public License as published by
+# the Free Software Foundation, version 3.
+#
+# Psi4 is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public License along
+# with Psi4; if not, write to the Free Software Foundation, Inc.,
+# 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+#
+# @END LICENSE
+#
+
+
+__all__ = [
+    "dft_grid_profile",
+]
+
+from typing import Dict, List, Optional, Tuple
+
+from psi4 import core
+
+from .p4util.exceptions import ValidationError
+
+# Standard (radial, spherical) grids tried when no candidates are given, cheapest first
+_default_candidates = [(50, 110), (50, 194), (60, 194), (60, 302), (75, 302), (75, 434), (99, 302), (99, 590)]
+
+
+def _profile(Vpot: core.VBase, molecule: core.Molecule, basis: core.BasisSet, nrad: int, nsph: int) -> Dict:
+    grid = core.DFTGrid.build(molecule, basis, {
+        "DFT_RADIAL_POINTS": nrad,
+        "DFT_SPHERICAL_POINTS": nsph
+    }, {"DFT_BLOCK_SCHEME": "ATOMIC"})
+    values = Vpot.profile_grid(grid)
+    return {
+        "radial": nrad,
+        "spherical": nsph,
+        "npoints": grid.npoints(),
+        "grid": grid,
+        "rho": values["RHO"].np.copy(),
+        "functional": values["FUNCTIONAL"].np.copy(),
+        "time": values["TIME"].np.copy(),
+    }
+
+
+def dft_grid_profile(wfn: core.Wavefunction,
+                     candidates: Optional[List[Tuple[int, int]]] = None,
+                     tolerance: float = 1.e-6) -> Dict:
+    """Compare coarser DFT grids against the production grid of a KS wavefunction.
+
+    The density of *wfn* is integrated once on the production grid and on each
+    candidate grid. Per-atom integrated densities, exchange-correlation energies
+    and integration times are printed, and the candidate with the fewest points
+    whose per-atom density and total XC energy errors stay within *tolerance*
+    is recommended.
+
+    Parameters
+    ----------
+    wfn
+        Converged RKS or UKS wavefunction, whose |scf__dft_radial_points| and
+        |scf__dft_spherical_points| define the production grid.
+    candidates
+        (radial, spherical) point counts to try. Defaults to a ladder of
+        standard grids smaller than the production grid.
+    tolerance
+        Largest acceptable error [e, Eh] in any atomic density or in the XC energy.
+
+    Returns
+    -------
+    dict
+        ``"production"`` and ``"candidates"`` profiles, plus ``"recommended"``,
+        the (radial, spherical) pair to use, which is the production grid if
+        no candidate is accurate enough.
+
+    """
+    Vpot = wfn.V_potential()
+    if Vpot is None:
+        raise ValidationError("dft_grid_profile: requires a DFT wavefunction.")
+
+    if wfn.same_a_b_dens():
+        Vpot.set_D([wfn.Da()])
+    else:
+        Vpot.set_D([wfn.Da(), wfn.Db()])
+
+    molecule = wfn.molecule()
+    basis = wfn.basisset()
+    nrad = core.get_option("SCF", "DFT_RADIAL_POINTS")
+    nsph = core.get_option("SCF", "DFT_SPHERICAL_POINTS")
+    if candidates is None:
+        candidates = [c for c in _default_candidates if c[0] * c[1] < nrad * nsph]
+
+    production = _profile(Vpot, molecule, basis, nrad, nsph)
+    profiles = [_profile(Vpot, molecule, basis, r, s) for r, s in candidates]
+
+    recommended = (nrad, nsph)
+    best_npoints = production["npoints"]
+    for prof in profiles:
+        prof["max_rho_error"] = float(abs(prof["rho"] - production["rho"]).max())
+        prof["functional_error"] = float(abs(prof["functional"].sum() - production["functional"].sum()))
+        prof["accepted"] = (prof["max_rho_error"] <= tolerance and prof["functional_error"] <= tolerance)
+        if prof["accepted"] and prof["npoints"] < best_npoints:
+            recommended = (prof["radial"], prof["spherical"])
+            best_npoints = prof["npoints"]
+
+    core.print_out("\n  ==> DFT Grid Profile <==\n\n")
+    core.print_out(f"    Production grid: ({nrad}, {nsph}) with {production['npoints']} points"
+                   f" in {production['time'].sum():.3f} [s]\n")
+    core.print_out(f"    Tolerance:       {tolerance:.2E}\n\n")
+    core.print_out(f"    {'(Rad, Sph)':>12s} {'Points':>10s} {'Time [s]':>10s} {'Max |dN_A|':>12s} {'|dE_xc|':>12s}\n")
+    for prof in profiles:
+        core.print_out(f"    {'(%d, %d)' % (prof['radial'], prof['spherical']):>12s} {prof['npoints']:10d}"
+                       f" {prof['time'].sum():10.3f} {prof['max_rho_error']:12.3E} {prof['functional_error']:12.3E}"
+                       f" {'*' if prof['accepted'] else ''}\n")
+
+    core.print_out(f"\n    Per-atom density errors and times (time per atomic block family):\n\n")
+    core.print_out(f"    {'Atom':>8s}" + "".join(f" {'(%d, %d)' % (p['radial'], p['spherical']):>22s}"
+                                             for p in profiles) + "\n")
+    for A in range(molecule.natom()):
+        line = f"    {molecule.label(A) + str(A + 1):>8s}"
+        for prof in profiles:
+            line += f" {prof['rho'][A] - production['rho'][A]:11.2E} {prof['time'][A]:10.4f}"
+        core.print_out(line + "\n")
+
+    core.print_out(f"\n    Recommended grid: DFT_RADIAL_POINTS {recommended[0]}, DFT_SPHERICAL_POINTS {recommended[1]}\n\n")
+    if core.get_option("SCF", "PRINT") > 1:
+        for prof in profiles:
+            if (prof["radial"], prof["spherical"]) == recommended:
+                prof["grid"].print_details()
+
+    for prof in [production] + profiles:
+        del prof["grid"]
+    return {"production": production, "candidates": profiles, "recommended": recommended}
@@ -729,6 +729,8 @@ def process_input(raw_input: str, print_level: int = 1) -> str:
     imports += 'from psi4.driver.diatomic import anharmonicity\n'
     imports += 'from psi4.driver.gaussian_n import *\n'
     imports += 'from psi4.driver.frac import ip_fitting, frac_traverse\n'
+    imports += 'from psi4.driver.grid_profile import dft_grid_profile\n'
+    imports += 'from psi4.driver.benchmark_suite import run_benchmark_suite\n'
     imports += 'from psi4.driver.aliases import *\n'
     imports += 'from psi4.driver.driver_cbs import *\n'
     imports += 'from psi4.driver.wrapper_database import database, db, DB_RGT, DB_RXN\n'
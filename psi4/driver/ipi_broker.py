@@ -39,6 +39,8 @@ import numpy as np
 
 import psi4
 
+from .procrouting.scf_proc import guess_extrapolation
+
 try:
     from ipi.interfaces.clients import Client
     ipi_available = True
@@ -53,7 +55,7 @@ except ImportError:
 class IPIBroker(Client):
     """Interface implementation between i-PI (https://ipi-code.org/) and |PSIfour|."""
 
-    def __init__(self, LOT, options=None, serverdata=False, molecule=None):
+    def __init__(self, LOT, options=None, serverdata=False, molecule=None, persistent=False):
         self.serverdata = serverdata
         if not ipi_available:
             psi4.core.print_out("i-pi is not available for import: ")
@@ -84,6 +86,12 @@ class IPIBroker(Client):
             psi4.core.set_global_option(item, value)
         psi4.core.IO.set_default_namespace("xwrapper")
 
+        # Start each SCF from the orbitals extrapolated along the trajectory
+        if persistent:
+            if not psi4.core.has_option_changed('SCF', 'GUESS_EXTRAPOLATION'):
+                psi4.core.set_local_option('SCF', 'GUESS_EXTRAPOLATION', 'ASPC')
+            guess_extrapolation.reset()
+
         self.timing = {}
 
         atoms = np.array(self.initial_molecule.geometry())
@@ -139,7 +147,8 @@ def ipi_broker(
     LOT: str,
     molecule: Optional[psi4.core.Molecule] = None,
     serverdata: Union[str, bool] = False,
-    options: Optional[Dict] = None
+    options: Optional[Dict] = None,
+    persistent: bool = False,
 ) -> IPIBroker:
     """Runs :class:`~psi4.driver.ipi_broker.IPIBroker` to connect to i-PI (https://ipi-code.org/).
 
@@ -153,9 +162,12 @@ def ipi_broker(
         Configuration where to connect to ipi
     options
         any additional Psi4 options
+    persistent
+        Start each SCF from the orbitals extrapolated from the previous steps
+        (|scf__guess_extrapolation| ``ASPC`` unless set by the user).
 
     """
-    b = IPIBroker(LOT, molecule=molecule, serverdata=serverdata, options=options)
+    b = IPIBroker(LOT, molecule=molecule, serverdata=serverdata, options=options, persistent=persistent)
 
     try:
         if b.serverdata:
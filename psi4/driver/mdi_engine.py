@@ -41,6 +41,8 @@ import qcelemental as qcel
 
 import psi4
 
+from .procrouting.scf_proc import guess_extrapolation
+
 _have_mdi = False
 try:
     from mdi import (
@@ -76,6 +78,11 @@ class MDIEngine():
             Method (SCF or post-SCF) used when calculating energies or gradients.
         molecule
             The target molecule, if not the last molecule defined.
+        persistent
+            Keep results and orbitals warm between requests: an energy or forces
+            request at an unchanged system is answered from the last calculation,
+            and each SCF starts from the extrapolated orbitals of the previous
+            steps (|scf__guess_extrapolation| ``ASPC`` unless set by the user).
         kwargs
             Any additional arguments to pass to :func:`psi4.driver.energy` or
             :func:`psi4.driver.gradient` computation.
@@ -85,6 +92,14 @@ class MDIEngine():
         # Method used when the SCF command is received
         self.scf_method = scf_method
 
+        # Keep results and orbitals between requests
+        self.persistent = kwargs.pop('persistent', False)
+        self._results = {}
+        if self.persistent:
+            if not psi4.core.has_option_changed('SCF', 'GUESS_EXTRAPOLATION'):
+                psi4.core.set_local_option('SCF', 'GUESS_EXTRAPOLATION', 'ASPC')
+            guess_extrapolation.reset()
+
         # Additional arguments for energy, gradient, or optimization calculations
         self.kwargs = kwargs
 
@@ -162,6 +177,11 @@ class MDIEngine():
         for command in self.commands.keys():
             MDI_Register_Command("@DEFAULT", command)
 
+    def invalidate(self):
+        """ Forget the results of the last calculation, as the system has changed
+        """
+        self._results = {}
+
     def length_conversion(self):
         """ Obtain the conversion factor between the geometry specification units and bohr
 
@@ -234,7 +254,8 @@ class MDIEngine():
 
         :returns: *energy* Energy of the system
         """
-        self.run_scf()
+        if not (self.persistent and "energy" in self._results):
+            self.run_scf()
         MDI_Send(self.energy, 1, MDI_DOUBLE, self.comm)
         return self.energy
 
@@ -244,8 +265,13 @@ class MDIEngine():
 
         :returns: *forces* Atomic forces
         """
-        force_matrix = psi4.driver.gradient(self.scf_method, **self.kwargs)
-        forces = force_matrix.np.ravel()
+        if self.persistent and "forces" in self._results:
+            forces = self._results["forces"]
+        else:
+            force_matrix = psi4.driver.gradient(self.scf_method, **self.kwargs)
+            forces = force_matrix.np.ravel()
+            self.energy = psi4.variable('CURRENT ENERGY')
+            self._results = {"energy": self.energy, "forces": forces}
         MDI_Send(forces, len(forces), MDI_DOUBLE, self.comm)
         return forces
 
@@ -269,6 +295,7 @@ class MDIEngine():
                     raise Exception('Unexpected number of ghost atoms when receiving masses')
             self.molecule.set_nuclear_charge(iatom, charges[jatom])
             jatom = jatom + 1
+        self.invalidate()
 
 
     # Respond to the >COORDS command
@@ -284,6 +311,7 @@ class MDIEngine():
         matrix = psi4.core.Matrix.from_array(np.array(coords).reshape(-1, 3))
         self.molecule.set_geometry(matrix)
         self.molecule._initial_cartesian = matrix
+        self.invalidate()
 
     # Respond to the >MASSES command
     def recv_masses(self, masses=None):
@@ -318,6 +346,7 @@ class MDIEngine():
             arr.append(self.clattice[3 * ilat + 2])
         self.kwargs["external_potentials"] = np.array(arr).reshape((-1, 4))
         self.set_lattice = True
+        self.invalidate()
 
     # Respond to the >NLATTICE command
     def recv_nlattice(self, nlattice=None):
@@ -365,6 +394,7 @@ class MDIEngine():
         """ Run an energy calculation
         """
         self.energy = psi4.energy(self.scf_method, **self.kwargs)
+        self._results = {"energy": self.energy}
 
     # Respond to the <DIMENSIONS command
     def send_dimensions(self):
@@ -396,6 +426,7 @@ class MDIEngine():
         if charge is None:
             charge = MDI_Recv(1, MDI_DOUBLE, self.comm)
         self.molecule.set_molecular_charge(int(round(charge)))
+        self.invalidate()
 
     # Respond to the <ELEC_MULT command
     def send_multiplicity(self):
@@ -417,6 +448,7 @@ class MDIEngine():
         if multiplicity is None:
             multiplicity = MDI_Recv(1, MDI_INT, self.comm)
         self.molecule.set_multiplicity(multiplicity)
+        self.invalidate()
 
     # Respond to the EXIT command
     def exit(self):
@@ -476,6 +508,8 @@ def mdi_run(scf_method: str, **kwargs):
         Method (SCF or post-SCF) used when calculating energies or gradients.
     molecule
         The target molecule, if not the last molecule defined.
+    persistent
+        Keep results and orbitals warm between requests, see :class:`MDIEngine`.
     kwargs
         Any additional arguments to pass to :func:`psi4.driver.energy` or
         :func:`psi4.driver.gradient` computation.
@@ -46,7 +46,7 @@ from .exceptions import TestComparisonError, ValidationError
 from .testing import compare_integers, compare_recursive, compare_values
 
 
-def fcidump(wfn: core.Wavefunction, fname: str = 'INTDUMP', oe_ints: Optional[List] = None):
+def fcidump(wfn: core.Wavefunction, fname: str = 'INTDUMP', oe_ints: Optional[List] = None, binary: bool = False):
     """Save integrals to file in FCIDUMP format as defined in Comp. Phys. Commun. 54 75 (1989),
     https://doi.org/10.1016/0010-4655(89)90033-7 .
     Additional one-electron integrals, including orbital energies, can also be saved.
@@ -61,6 +61,12 @@ def fcidump(wfn: core.Wavefunction, fname: str = 'INTDUMP', oe_ints: Optional[Li
     oe_ints
         List of additional one-electron integrals to save to file. So far only
         EIGENVALUES is a valid option.
+    binary
+        Write the two-electron integrals to ``fname + '.bin'`` as packed
+        little-endian records of one float64 value and four int32 one-based
+        indices (same selection and order as the text lines). The text file
+        then holds only the header and the one-electron and constant terms.
+        Much faster than text for large active spaces.
 
     Raises
     ------
@@ -78,6 +84,10 @@ def fcidump(wfn: core.Wavefunction, fname: str = 'INTDUMP', oe_ints: Optional[Li
     >>> E, wfn = energy('scf', return_wfn=True)
     >>> fcidump(wfn, oe_ints=['EIGENVALUES'])
 
+    >>> # [3] Save the two-electron integrals in binary form to INTDUMP.bin
+    >>> E, wfn = energy('scf', return_wfn=True)
+    >>> fcidump(wfn, binary=True)
+
     """
     # Get some options
     reference = core.get_option('SCF', 'REFERENCE')
@@ -139,7 +149,12 @@ def fcidump(wfn: core.Wavefunction, fname: str = 'INTDUMP', oe_ints: Optional[Li
     if not wfn.same_a_b_orbs():
         DPD_info['beta_MO'] = ints.DPD_ID("[a>=a]+")
     # Write TEI to fname in FCIDUMP format
-    core.fcidump_tei_helper(nirrep, wfn.same_a_b_orbs(), DPD_info, ints_tolerance, fname)
+    if binary:
+        tei_fname = fname + '.bin'
+        open(tei_fname, 'wb').close()
+        core.fcidump_tei_helper(nirrep, wfn.same_a_b_orbs(), DPD_info, ints_tolerance, tei_fname, binary=True)
+    else:
+        core.fcidump_tei_helper(nirrep, wfn.same_a_b_orbs(), DPD_info, ints_tolerance, fname)
 
     # Read-in OEI and write them to fname in FCIDUMP format
     # Indexing functions to translate from zero-based (C and Python) to
@@ -249,7 +264,7 @@ def _irrep_map(wfn):
     return np.array(irrep_map, dtype='int')
 
 
-def fcidump_from_file(fname: str) -> Dict[str, Any]:
+def fcidump_from_file(fname: str, binary: bool = False) -> Dict[str, Any]:
     """Function to read in a FCIDUMP file.
 
     :returns: a dictionary with FCIDUMP header and integrals
@@ -266,6 +281,7 @@ def fcidump_from_file(fname: str) -> Dict[str, Any]:
       - 'eri' : electron-repulsion integrals
 
     :param fname: FCIDUMP file name
+    :param binary: read the two-electron integrals from ``fname + '.bin'``, as written by ``fcidump(..., binary=True)``
 
     """
     intdump = {}
@@ -294,6 +310,11 @@ def fcidump_from_file(fname: str) -> Dict[str, Any]:
 
     # Read the data and index, skip header
     raw_ints = np.genfromtxt(fname, skip_header=skiplines)
+    if binary:
+        record = np.dtype([('value', '<f8'), ('index', '<i4', (4, ))])
+        raw_tei = np.fromfile(fname + '.bin', dtype=record)
+        raw_tei = np.column_stack((raw_tei['value'], raw_tei['index']))
+        raw_ints = np.concatenate((raw_tei, raw_ints))
 
     # Read last line, i.e. Enuc + Efzc
     intdump['enuc'] = raw_ints[-1, 0]
@@ -424,6 +424,40 @@ def _np_write(
     np.savez(filename, **ret)
 
 
+def _npz_read_into(data: np.lib.npyio.NpzFile, key: str, view: np.ndarray):
+    """Reads array `key` of an NpzFile into `view`, streaming uncompressed
+    members straight into its memory instead of loading a temporary copy.
+
+    Parameters
+    ----------
+    data
+        Open NumPy archive.
+    key
+        Name of the array within the archive.
+    view
+        C-contiguous destination, typically a :attr:`~psi4.core.Matrix.nph` view.
+
+    """
+    member = key + ".npy"
+    zf = getattr(data, "zip", None)
+    if zf is not None and member in zf.namelist() and view.flags['C_CONTIGUOUS'] and view.size:
+        with zf.open(member) as fp:
+            version = np.lib.format.read_magic(fp)
+            if version in [(1, 0), (2, 0)]:
+                read_header = np.lib.format.read_array_header_1_0 if version == (1, 0) else \
+                    np.lib.format.read_array_header_2_0
+                shape, fortran_order, dtype = read_header(fp)
+                if tuple(shape) == view.shape and not fortran_order and dtype == view.dtype:
+                    dest = memoryview(view).cast('B')
+                    chunk = 1 << 24
+                    for start in range(0, len(dest), chunk):
+                        if fp.readinto(dest[start:start + chunk]) != len(dest[start:start + chunk]):
+                            raise ValidationError("File %s: array %s is truncated" % (data.fid, key))
+                    return
+
+    view[...] = np.asarray(data[key]).reshape(view.shape)
+
+
 def _np_read(
     self: Union[core.Matrix, core.Vector],
     filename: str,
@@ -452,14 +486,9 @@ def _np_read(
     else:
         raise Exception("Filename not understood: %s" % filename)
 
-    ret_data = []
-
     if ((prefix + "Irreps") not in data.keys()) or ((prefix + "Name") not in data.keys()):
         raise ValidationError("File %s does not appear to be a numpyz save" % filename)
 
-    for h in range(data[prefix + "Irreps"]):
-        ret_data.append(data[prefix + "IrrepData" + str(h)])
-
     arr_type = self.__mro__[0]
     if arr_type == core.Matrix:
         dim1 = core.Dimension.from_list(data[prefix + "Dim1"])
@@ -469,8 +498,10 @@ def _np_read(
         dim1 = core.Dimension.from_list(data[prefix + "Dim"])
         ret = self(str(data[prefix + "Name"]), dim1)
 
-    for h in range(data[prefix + "Irreps"]):
-        ret.nph[h][:] = ret_data[h]
+    # Fill each irrep block directly, one at a time, rather than holding all of them in memory first
+    for h, view in enumerate(ret.nph):
+        if 0 in view.shape: continue
+        _npz_read_into(data, prefix + "IrrepData" + str(h), view)
 
     return ret
 
@@ -254,7 +254,9 @@ def _core_wavefunction_from_file(wfn_data: Union[str, Dict, Path]) -> core.Wavef
     ----------
     wfn_data
         If a dict, use data directly. Otherwise, path-like passed to
-        :py:func:`numpy.load` to read from disk.
+        :py:func:`numpy.load` to read from disk. Paths ending in ``.npz``
+        (or bare names for which only the ``.npz`` file exists) are read as
+        the archive layout written by ``to_file(..., compress=True)``.
 
     Returns
     -------
@@ -265,10 +267,16 @@ def _core_wavefunction_from_file(wfn_data: Union[str, Dict, Path]) -> core.Wavef
     # load the wavefunction from file
     if isinstance(wfn_data, dict):
         pass
+    elif isinstance(wfn_data, (str, Path)) and str(wfn_data).endswith(".npz"):
+        wfn_data = _wavefunction_npz_load(wfn_data)
     elif isinstance(wfn_data, str):
         if not wfn_data.endswith(".npy"):
-            wfn_data = wfn_data + ".npy"
-        wfn_data = np.load(wfn_data, allow_pickle=True).item()
+            if not os.path.isfile(wfn_data + ".npy") and os.path.isfile(wfn_data + ".npz"):
+                wfn_data = _wavefunction_npz_load(wfn_data + ".npz")
+            else:
+                wfn_data = np.load(wfn_data + ".npy", allow_pickle=True).item()
+        else:
+            wfn_data = np.load(wfn_data, allow_pickle=True).item()
     else:
         # Could be path-like or file-like, let `np.load` handle it
         wfn_data = np.load(wfn_data, allow_pickle=True).item()
@@ -329,7 +337,71 @@ def _core_wavefunction_from_file(wfn_data: Union[str, Dict, Path]) -> core.Wavef
 core.Wavefunction.from_file = _core_wavefunction_from_file
 
 
-def _core_wavefunction_to_file(wfn: core.Wavefunction, filename: str = None) -> Dict[str, Dict[str, Any]]:
+# Layout version of the ``.npz`` wavefunction archive; bump when the member naming changes
+_WFN_NPZ_VERSION = 1
+_WFN_NPZ_ARRAY_KINDS = ('matrix', 'vector', 'matrixarr')
+
+
+def _wavefunction_npz_save(filename: str, wfn_data: Dict[str, Dict[str, Any]], compress: bool):
+    """Write the dictionary layout of :meth:`~psi4.core.Wavefunction.to_file`
+    as an ``.npz`` archive. Each array (or each irrep block of a symmetry-blocked
+    array) is its own member, so the bulk data is stored as raw binary rather
+    than inside a pickle; only the small scalar metadata is pickled.
+
+    """
+    arrays = {}
+    blocks = {}
+    for kind in _WFN_NPZ_ARRAY_KINDS:
+        for label, array in wfn_data[kind].items():
+            if array is None:
+                continue
+            key = f"{kind}.{label}"
+            if isinstance(array, list):
+                blocks[key] = len(array)
+                for h, block in enumerate(array):
+                    arrays[f"{key}.h{h}"] = block
+            else:
+                arrays[key] = array
+
+    metadata = {k: v for k, v in wfn_data.items() if k not in _WFN_NPZ_ARRAY_KINDS}
+    metadata['npz_version'] = _WFN_NPZ_VERSION
+    metadata['labels'] = {kind: list(wfn_data[kind].keys()) for kind in _WFN_NPZ_ARRAY_KINDS}
+    metadata['blocks'] = blocks
+
+    save = np.savez_compressed if compress else np.savez
+    save(filename, metadata=np.array(metadata, dtype=object), **arrays)
+
+
+def _wavefunction_npz_load(filename: Union[str, Path]) -> Dict[str, Dict[str, Any]]:
+    """Read an archive written by :func:`_wavefunction_npz_save` back into the
+    dictionary layout of :meth:`~psi4.core.Wavefunction.to_file`.
+
+    """
+    with np.load(filename, allow_pickle=True) as npz:
+        metadata = npz['metadata'].item()
+        version = metadata.pop('npz_version', None)
+        if version != _WFN_NPZ_VERSION:
+            raise ValidationError(f"Wavefunction archive {filename} has layout version {version}, "
+                                  f"but this Psi4 reads version {_WFN_NPZ_VERSION}.")
+        labels = metadata.pop('labels')
+        blocks = metadata.pop('blocks')
+
+        wfn_data = metadata
+        for kind in _WFN_NPZ_ARRAY_KINDS:
+            wfn_data[kind] = {}
+            for label in labels[kind]:
+                key = f"{kind}.{label}"
+                if key in blocks:
+                    wfn_data[kind][label] = [npz[f"{key}.h{h}"] for h in range(blocks[key])]
+                elif key in npz.files:
+                    wfn_data[kind][label] = npz[key]
+                else:
+                    wfn_data[kind][label] = None
+
+    return wfn_data
+
+
+def _core_wavefunction_to_file(wfn: core.Wavefunction, filename: str = None, compress: bool = False) -> Dict[str, Dict[str, Any]]:
     """Serialize a Wavefunction object. Opposite of
     :meth:`~psi4.core.Wavefunction.from_file`.
 
@@ -339,6 +411,10 @@ def _core_wavefunction_to_file(wfn: core.Wavefunction, filename: str = None) ->
         Wavefunction or inherited class instance.
     filename
         An optional filename to which to write the data.
+    compress
+        Write a compressed ``.npz`` archive instead of a ``.npy`` file. An
+        explicit ``.npz`` suffix on `filename` also selects the archive layout
+        (uncompressed unless `compress` is set).
 
     Returns
     -------
@@ -415,8 +491,12 @@ def _core_wavefunction_to_file(wfn: core.Wavefunction, filename: str = None) ->
     }  # yapf: disable
 
     if filename is not None:
-        if not filename.endswith('.npy'): filename += '.npy'
-        np.save(filename, wfn_data, allow_pickle=True)
+        if compress or filename.endswith('.npz'):
+            if not filename.endswith('.npz'): filename += '.npz'
+            _wavefunction_npz_save(filename, wfn_data, compress)
+        else:
+            if not filename.endswith('.npy'): filename += '.npy'
+            np.save(filename, wfn_data, allow_pickle=True)
 
     return wfn_data
 
@@ -438,6 +438,42 @@ def _gs_orth(engine, U, V, thresh: float = 1.0e-8):
     return U
 
 
+def _gs_orth_coefficients(C: np.ndarray, thresh: float = 1.0e-8) -> np.ndarray:
+    """Gram-Schmidt orthonormalization of the columns of C, the subspace counterpart of :func:`_gs_orth`
+
+    As the trial vectors are orthonormal, orthonormalizing their expansion coefficients is equivalent to
+    orthonormalizing the expanded vectors themselves.
+
+    Parameters
+    ----------
+    C
+       Numpy array {l, n}. Expansion coefficients of n vectors in an orthonormal basis of dimension l
+    thresh
+       If the orthogonalized column has a norm smaller than this value it is considered LD to the set
+
+    Returns
+    -------
+    Q
+       Numpy array {l, m}, m <= n. Orthonormal columns spanning the columns of C
+    """
+    Q = []
+    for i in range(C.shape[1]):
+        ci = C[:, i].copy()
+        for qj in Q:
+            ci -= np.dot(qj, ci) * qj
+        norm_ci = np.linalg.norm(ci)
+        if norm_ci >= thresh:
+            Q.append(ci / norm_ci)
+    return np.array(Q).T
+
+
+def _collapse_products(engine, coefficients: np.ndarray):
+    """Let an engine that caches products rotate them onto the collapsed trial space ``X @ coefficients``.
+    Engines without a ``collapse_products`` method recompute the products on the next iteration."""
+    if hasattr(engine, "collapse_products"):
+        engine.collapse_products(coefficients)
+
+
 def _best_vectors(engine, ss_vectors: np.ndarray, basis_vectors: List) -> List:
     r"""Compute the best approximation of the true eigenvectors as a linear combination of basis vectors:
 
@@ -491,6 +527,13 @@ class SolverEngine(ABC):
        Whatever data type is used and individual vector should be a
        single element in a list such that len(list) returns the number
        of vector-like objects.
+
+
+    .. note:: An engine that caches products may also define
+       ``collapse_products(coefficients)``. On a subspace collapse the solvers
+       call it with the {l, k} coefficients of the new trial vectors in the
+       old ones, so the products of the collapsed vectors are formed from the
+       cache instead of being recomputed.
     """
 
     @abstractmethod
@@ -836,8 +879,9 @@ def davidson_solver(
             break
         elif iter_info['collapse']:
 
-            # restart needed
+            # restart needed, products of the collapsed vectors follow from the cached ones
             vecs = best_eigvecs
+            _collapse_products(engine, alpha[:, :nk])
         else:
 
             # Regular subspace update, orthonormalize preconditioned residuals and add to the trial set
@@ -1101,7 +1145,10 @@ def hamiltonian_solver(
         elif iter_info['collapse']:
 
             # need to orthonormalize union of the Left/Right solutions on restart
-            vecs = _gs_orth(engine, [], best_R + best_L)
+            # done on the subspace coefficients so the cached products can be collapsed as well
+            coeffs = _gs_orth_coefficients(np.hstack((Rss[:, :nk], Lss[:, :nk])))
+            vecs = _best_vectors(engine, coeffs, vecs)
+            _collapse_products(engine, coeffs)
         else:
 
             # Regular subspace update, orthonormalize preconditioned residuals and add to the trial set
@@ -29,4 +29,5 @@
 from . import dft, diis, libcubeprop, response, scf_proc
 from .empirical_dispersion import EmpiricalDispersion
 from .proc import scf_helper, scf_wavefunction_factory
+from .scf_proc.scf_iterator import scf_compute_states
 from .proc_table import energy_only_methods, hooks, integrated_basis_methods, procedures
@@ -113,9 +113,12 @@ class DIIS:
         """ Wipe all data from previous iterations. """
         self.stored_vectors = [] # elt. i is entry i
         self.iter_num = -1
-        # At present, we only cache for DIIS, not EDIIS or ADIIS. In principle, we could, but
-        # their quantities are N^2, so we assume the savings are negligible.
+        # Index of the entry added most recently. Once the subspace is full, this need not be the last one.
+        self.latest_index = -1
+        # Dot products between entries are cached, so each new entry only costs one new row of the B matrix.
         self.cached_dot_products = dict()
+        # Same for the D_i . F_j products that A/EDIIS are built from. Keys are ordered (i, j).
+        self.cached_density_fock_products = dict()
 
     def copier(self, x, new_name: str):
         """ Copy the object x and give it a new_name. Save it to disk if needed. """
@@ -161,11 +164,12 @@ class DIIS:
         template_object = self.template[name][item_num]
         if isinstance(template_object, float) or self.storage_policy == StoragePolicy.InCore:
             quantity = self.stored_vectors[entry_num][name][item_num]
-            try:
-                quantity = quantity.clone()
-            except AttributeError:
-                # The quantity must have been a float. No need to clone.
-                pass
+            if force_new:
+                try:
+                    quantity = quantity.clone()
+                except AttributeError:
+                    # The quantity must have been a float. No need to clone.
+                    pass
         elif self.storage_policy == StoragePolicy.OnDisk:
             full_name = self.get_name(name, entry_num, item_num)
             psio = core.IO.shared_object()
@@ -195,13 +199,36 @@ class DIIS:
         except KeyError:
             dot_product = 0
             for item_num in range(len(self.template["error"])):
-                Rix = self.load_quantity("error", i, item_num)
-                Rjx = self.load_quantity("error", j, item_num)
+                Rix = self.load_quantity("error", i, item_num, force_new=False)
+                Rjx = self.load_quantity("error", j, item_num, force_new=False)
                 dot_product += Rix.vector_dot(Rjx)
 
             self.cached_dot_products[key] = dot_product
             return dot_product
 
+    def get_density_fock_product(self, i: int, j: int):
+        """ Get D_i . F_j, summed over items. i and j represent entry numbers. """
+        key = (i, j)
+        try:
+            return self.cached_density_fock_products[key]
+        except KeyError:
+            dot_product = 0
+            for item_num in range(len(self.template["densities"])):
+                Dix = self.load_quantity("densities", i, item_num, force_new=False)
+                Fjx = self.load_quantity("target", j, item_num, force_new=False)
+                dot_product += Dix.vector_dot(Fjx)
+
+            self.cached_density_fock_products[key] = dot_product
+            return dot_product
+
+    def density_fock_products(self):
+        """ The matrix of all D_i . F_j. Only products involving a new entry are actually computed. """
+        num_entries = len(self.stored_vectors)
+        DF = np.zeros((num_entries, num_entries))
+        for i, j in product(range(num_entries), repeat = 2):
+            DF[i][j] = self.get_density_fock_product(i, j)
+        return DF
+
 
     def set_error_vector_size(self, *args):
         """ Set the template for the DIIS error. Kept mainly for backwards compatibility. """
@@ -241,10 +268,13 @@ class DIIS:
                 raise Exception(f"RemovalPolicy {self.removal_policy} not recognized. This is a bug: contact developers.")
             # Purge imminently-outdated values from cache.
             self.cached_dot_products = {key: val for key, val in self.cached_dot_products.items() if target_index not in key}
+            self.cached_density_fock_products = {key: val for key, val in self.cached_density_fock_products.items() if target_index not in key}
             # Set the new entry.
             self.stored_vectors[target_index] = self.build_entry(entry, target_index)
         else:
-            self.stored_vectors.append(self.build_entry(entry, self.iter_num))
+            target_index = self.iter_num
+            self.stored_vectors.append(self.build_entry(entry, target_index))
+        self.latest_index = target_index
 
         return True
 
@@ -293,30 +323,13 @@ class DIIS:
 
     def adiis_populate(self):
         """ Fills linear and quadratic coefficients in ADIIS energy estimate. """
-        # We are currently assuming that all of dD and dF fit in-core.
-        # These quantities are N^2, so this should be fine in most cases.
+        # With n the latest entry, (D_i - D_n) . F_n and (D_i - D_n) . (F_j - F_n) both expand into D . F products,
+        # so the cached products serve here as well as for EDIIS.
+        DF = self.density_fock_products()
+        n = self.latest_index
 
-        num_entries = len(self.stored_vectors)
-        dD = [[] for x in range(num_entries)]
-        dF = [[] for x in range(num_entries)]
-        for name, array in zip(["densities", "target"], [dD, dF]):
-            for item_num in range(len(self.template[name])):
-                latest_entry = self.load_quantity(name, len(self.stored_vectors) - 1, item_num)
-                for entry_num in range(num_entries):
-                    temp = self.load_quantity(name, entry_num, item_num, force_new=True)
-                    temp.subtract(latest_entry)
-                    array[entry_num].append(temp)
-
-        self.adiis_linear = np.zeros((num_entries))
-        latest_fock = []
-        for item_num in range(len(self.template["target"])):
-            latest_fock.append(self.load_quantity("target", len(self.stored_vectors) - 1, item_num))
-        for i in range(num_entries):
-            self.adiis_linear[i] = sum(d.vector_dot(f) for d, f in zip(dD[i], latest_fock))
-
-        self.adiis_quadratic = np.zeros((num_entries, num_entries))
-        for i, j in product(range(num_entries), repeat = 2):
-            self.adiis_quadratic[i][j] = sum(d.vector_dot(f) for d, f in zip(dD[i], dF[j]))
+        self.adiis_linear = DF[:, n] - DF[n, n]
+        self.adiis_quadratic = DF - DF[:, n][:, None] - DF[n, :][None, :] + DF[n, n]
 
         if self.closed_shell:
             self.adiis_linear *= 2
@@ -346,15 +359,7 @@ class DIIS:
 
     def ediis_populate(self):
         """ Fills quadratic coefficients in ADIIS energy estimate. """
-        num_entries = len(self.stored_vectors)
-
-        self.ediis_quadratic = np.zeros((num_entries, num_entries))
-        for i in range(num_entries):
-            for item_num in range(len(self.template["densities"])):
-                d = self.load_quantity("densities", i, item_num)
-                for j in range(num_entries):
-                    f = self.load_quantity("target", j, item_num)
-                    self.ediis_quadratic[i][j] += d.vector_dot(f)
+        self.ediis_quadratic = self.density_fock_products()
 
         diag = np.diag(self.ediis_quadratic)
         # D_i F_i + D_j F_j - D_i F_j - D_j F_i; First two terms use broadcasting tricks
@@ -415,7 +420,7 @@ class DIIS:
         for j, Tj in enumerate(args):
             Tj.zero()
             for i, ci in enumerate(coeffs):
-                Tij = self.load_quantity("target", i, j)
+                Tij = self.load_quantity("target", i, j, force_new=False)
                 axpy(Tj, ci, Tij)
 
         return performed
@@ -27,6 +27,7 @@
 #
 
 import collections
+import functools
 from typing import Dict, List, Union
 
 import numpy as np
@@ -51,11 +52,13 @@ _engine_can_do = collections.OrderedDict([
 ]) # yapf: disable
 
 
+@functools.lru_cache(maxsize=None)
 def _capable_engines_for_disp()-> Dict[str, List[str]]:
     """Invert _engine_can_do dictionary and check program detection.
 
     Returns a dictionary with keys all dispersion levels and values a list of all
     capable engines, where the engine in the first element is available, if any are.
+    Program detection runs once per process; treat the result as read-only.
 
     """
     try:
@@ -361,7 +364,7 @@ class EmpiricalDispersion():
                         molecule: core.Molecule,
                         wfn: core.Wavefunction = None) -> core.Matrix:
         """Compute dispersion Hessian based on engine, dispersion level, and parameters in `self`.
-        Uses finite difference, as no dispersion engine has analytic second derivatives.
+        Analytic for the ``libdisp`` engine; other engines use finite difference of gradients.
 
         Parameters
         ----------
@@ -378,10 +381,16 @@ class EmpiricalDispersion():
         """
         from psi4.driver.driver_findif import assemble_hessian_from_gradients, hessian_from_gradients_geometries
 
+        if self.engine == 'libdisp':
+            H = self.disp.compute_hessian(molecule)
+            if wfn is not None:
+                wfn.set_variable('DISPERSION CORRECTION HESSIAN', H)
+            return H
+
         optstash = p4util.OptionsState(['PRINT'], ['PARENT_SYMMETRY'])
         core.set_global_option('PRINT', 0)
 
-        core.print_out("\n\n   Analytical Dispersion Hessians are not supported by any engine.\n")
+        core.print_out("\n\n   Analytical Dispersion Hessians are not supported by the {} engine.\n".format(self.engine))
         core.print_out("       Computing the Hessian through finite difference of gradients.\n\n")
 
         # Setup the molecule
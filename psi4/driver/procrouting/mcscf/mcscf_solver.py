@@ -80,6 +80,7 @@ def mcscf_solver(ref_wfn):
     mcscf_target_conv_type = core.get_option("DETCI", "MCSCF_ALGORITHM")
     mcscf_so_start_grad = core.get_option("DETCI", "MCSCF_SO_START_GRAD")
     mcscf_so_start_e = core.get_option("DETCI", "MCSCF_SO_START_E")
+    mcscf_hk_jk_grad = core.get_option("DETCI", "MCSCF_HK_JK_GRAD")
     mcscf_current_step_type = 'Initial CI'
 
     # Start with SCF energy and other params
@@ -193,6 +194,8 @@ def mcscf_solver(ref_wfn):
 
         # Which orbital convergence are we doing?
         if ah_step:
+            # Cheaper Hessian products, if set up, until the gradient is small
+            mcscf_obj.set_approx_hk(orb_grad_rms > mcscf_hk_jk_grad)
             converged, norb_iter, step = ah_iteration(mcscf_obj, print_micro=False)
             norb_iter += 1
 
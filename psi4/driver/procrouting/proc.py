@@ -58,7 +58,7 @@ from ..p4util.exceptions import (
 
 #from psi4.driver.molutil import *
 from ..qcdb.basislist import corresponding_basis
-from . import dft, empirical_dispersion, mcscf, proc_util, response, solvent
+from . import dft, empirical_dispersion, mcscf, proc_util, response, scf_proc, solvent
 from .proc_data import method_algorithm_type
 from .roa import run_roa
 
@@ -1779,6 +1779,8 @@ def scf_helper(name, post_scf=True, **kwargs):
     # The wfn from_file routine adds the npy suffix if needed, but we add it here so that
     # we can use os.path.isfile to query whether the file exists before attempting to read
     read_filename = scf_wfn.get_scratch_filename(180) + '.npy'
+    if not os.path.isfile(read_filename) and os.path.isfile(read_filename[:-4] + '.npz'):
+        read_filename = read_filename[:-4] + '.npz'
     if ((core.get_option('SCF', 'GUESS') == 'READ') and os.path.isfile(read_filename)):
         old_wfn = core.Wavefunction.from_file(read_filename)
 
@@ -1824,6 +1826,23 @@ def scf_helper(name, post_scf=True, **kwargs):
             scf_wfn.set_sad_fitting_basissets(sad_fitting_list)
 
 
+    # Seed from the orbitals of a nearby geometry (e.g., the reference of a finite difference campaign),
+    #   projected onto the basis at this geometry
+    seeded = False
+    guess_filename = kwargs.get('guess_orbitals', None)
+    if guess_filename and not read_orbitals and not cast:
+        if not guess_filename.endswith('.npy'):
+            guess_filename += '.npy'
+        if os.path.isfile(guess_filename):
+            old_wfn = core.Wavefunction.from_file(guess_filename)
+            if old_wfn.molecule().schoenflies_symbol() == scf_molecule.schoenflies_symbol():
+                core.print_out(f"  Projecting orbitals from {guess_filename} onto this geometry.\n\n")
+                pCa = scf_wfn.basis_projection(old_wfn.Ca_subset("SO", "OCC"), old_wfn.nalphapi(), old_wfn.basisset(), scf_wfn.basisset())
+                pCb = scf_wfn.basis_projection(old_wfn.Cb_subset("SO", "OCC"), old_wfn.nbetapi(), old_wfn.basisset(), scf_wfn.basisset())
+                scf_wfn.guess_Ca(pCa)
+                scf_wfn.guess_Cb(pCb)
+                seeded = True
+
     if cast:
         core.print_out("\n  Computing basis projection from %s to %s\n\n" % (ref_wfn.basisset().name(), base_wfn.basisset().name()))
         if ref_wfn.basisset().n_ecp_core() != base_wfn.basisset().n_ecp_core():
@@ -1835,6 +1854,10 @@ def scf_helper(name, post_scf=True, **kwargs):
         scf_wfn.guess_Ca(pCa)
         scf_wfn.guess_Cb(pCb)
 
+    # Along a trajectory, extrapolate from the solutions at previous geometries
+    if not cast and not seeded:
+        scf_proc.guess_extrapolation.extrapolate_guess(scf_wfn)
+
 
     # Print basis set info
     if core.get_option("SCF", "PRINT_BASIS"):
@@ -1878,7 +1901,14 @@ def scf_helper(name, post_scf=True, **kwargs):
             basisset=scf_wfn.basisset()
         )
 
+    # A gradient (1) or Hessian (2) that follows reuses the DFT collocation cache of the energy
+    collocation_dertype = kwargs.get('collocation_dertype', 0)
+    if scf_wfn.V_potential() and collocation_dertype:
+        xc_func = scf_wfn.V_potential().functional()
+        scf_wfn.V_potential().set_collocation_deriv(collocation_dertype + int(xc_func.is_gga() or xc_func.is_meta()))
+
     e_scf = scf_wfn.compute_energy()
+    scf_proc.guess_extrapolation.store_solution(scf_wfn)
     for obj in [core, scf_wfn]:
         # set_variable("SCF TOTAL ENERGY")  # P::e SCF
         for pv in ["SCF TOTAL ENERGY", "CURRENT ENERGY", "CURRENT REFERENCE ENERGY"]:
@@ -1985,6 +2015,8 @@ def run_dct(name, **kwargs):
     if ref_wfn is None:
         ref_wfn = scf_helper(name, **kwargs)
 
+    ref_wfn = proc_util.fno_truncate(name, ref_wfn)
+
     if (core.get_global_option("DCT_TYPE") == "DF"):
         core.print_out("  Constructing Basis Sets for DCT...\n\n")
         aux_basis = core.BasisSet.build(ref_wfn.molecule(), "DF_BASIS_DCT",
@@ -2004,6 +2036,8 @@ def run_dct(name, **kwargs):
         proc_util.check_iwl_file_from_scf_type(core.get_global_option('SCF_TYPE'), ref_wfn)
         dct_wfn = core.dct(ref_wfn)
 
+    proc_util.fno_correct(dct_wfn, ref_wfn.scalar_variables())
+
     for k, v in dct_wfn.variables().items():
         core.set_variable(k, v)
 
@@ -2165,8 +2199,12 @@ def run_dfocc(name, **kwargs):
     if core.get_option('SCF', 'REFERENCE') == 'ROHF':
         ref_wfn.semicanonicalize()
 
+    ref_wfn = proc_util.fno_truncate(name, ref_wfn)
+
     dfocc_wfn = core.dfocc(ref_wfn)
 
+    proc_util.fno_correct(dfocc_wfn, ref_wfn.scalar_variables())
+
     # Shove variables into global space
     for k, v in dfocc_wfn.variables().items():
         core.set_variable(k, v)
@@ -2679,7 +2717,7 @@ def run_scf_gradient(name, **kwargs):
     # Bypass the scf call if a reference wavefunction is given
     ref_wfn = kwargs.get('ref_wfn', None)
     if ref_wfn is None:
-        ref_wfn = run_scf(name, **kwargs)
+        ref_wfn = run_scf(name, collocation_dertype=1, **kwargs)
 
     if core.get_option('SCF', 'REFERENCE') in ['ROHF', 'CUHF']:
         ref_wfn.semicanonicalize()
@@ -2689,6 +2727,8 @@ def run_scf_gradient(name, **kwargs):
         ref_wfn.set_variable("-D Gradient", disp_grad)
 
     grad = core.scfgrad(ref_wfn)
+    if ref_wfn.V_potential():
+        ref_wfn.V_potential().clear_collocation_cache()
 
     ref_wfn.set_gradient(grad)
 
@@ -2716,18 +2756,28 @@ def run_scf_hessian(name, **kwargs):
     # Bypass the scf call if a reference wavefunction is given
     ref_wfn = kwargs.get('ref_wfn', None)
     if ref_wfn is None:
-        ref_wfn = run_scf(name, **kwargs)
+        ref_wfn = run_scf(name, collocation_dertype=2, **kwargs)
 
     badref = core.get_option('SCF', 'REFERENCE') in ['ROHF', 'CUHF']
     badint = core.get_global_option('SCF_TYPE') in [ 'CD', 'OUT_OF_CORE']
     if badref or badint:
         raise ValidationError("Only RHF/UHF/RKS/UKS Hessians are currently implemented. SCF_TYPE either CD or OUT_OF_CORE not supported")
 
+    # A density-fitted response on top of an exact-integral reference needs the fitting basis the SCF skipped
+    if "DF" in core.get_option('SCF', 'HESSIAN_RESPONSE_TYPE') and "DF" not in core.get_global_option('SCF_TYPE'):
+        aux_basis = core.BasisSet.build(ref_wfn.molecule(), "DF_BASIS_SCF",
+                                        core.get_option("SCF", "DF_BASIS_SCF"),
+                                        "JKFIT", core.get_global_option('BASIS'),
+                                        puream=ref_wfn.basisset().has_puream())
+        ref_wfn.set_basisset("DF_BASIS_SCF", aux_basis)
+
     if hasattr(ref_wfn, "_disp_functor"):
         disp_hess = ref_wfn._disp_functor.compute_hessian(ref_wfn.molecule(), ref_wfn)
         ref_wfn.set_variable("-D Hessian", disp_hess)
 
     H = core.scfhess(ref_wfn)
+    if ref_wfn.V_potential():
+        ref_wfn.V_potential().clear_collocation_cache()
     ref_wfn.set_hessian(H)
 
     ref_wfn.set_variable("SCF TOTAL HESSIAN", H)  # P::e SCF
@@ -2887,14 +2937,18 @@ def run_ccenergy(name, **kwargs):
     if ref_wfn is None:
         ref_wfn = scf_helper(name, **kwargs)  # C1 certified
 
-    if core.get_global_option("CC_TYPE") == "DF":
+    ref_wfn = proc_util.fno_truncate(name, ref_wfn)
+
+    tei_type = core.get_option('CCTRANSORT', 'TEI_TYPE')
+    if core.get_global_option("CC_TYPE") == "DF" or tei_type == "DF":
         aux_basis = core.BasisSet.build(ref_wfn.molecule(), "DF_BASIS_CC",
                                             core.get_global_option("DF_BASIS_CC"),
                                             "RIFIT", core.get_global_option("BASIS"))
         ref_wfn.set_basisset("DF_BASIS_CC", aux_basis)
 
-    # Ensure IWL files have been written
-    proc_util.check_iwl_file_from_scf_type(core.get_global_option('SCF_TYPE'), ref_wfn)
+    # Ensure IWL files have been written; DF and CD integrals are built in cctransort
+    if tei_type == "CONV":
+        proc_util.check_iwl_file_from_scf_type(core.get_global_option('SCF_TYPE'), ref_wfn)
 
     # Obtain semicanonical orbitals
     if ((core.get_option('SCF', 'REFERENCE') == 'ROHF')
@@ -2922,6 +2976,8 @@ def run_ccenergy(name, **kwargs):
         for k, v in lambdawfn.variables().items():
             ccwfn.set_variable(k, v)
 
+    proc_util.fno_correct(ccwfn, ref_wfn.scalar_variables())
+
     optstash.restore()
     return ccwfn
 
@@ -2941,6 +2997,9 @@ def run_ccenergy_gradient(name, **kwargs):
     if core.get_global_option('FREEZE_CORE') not in ["FALSE", "0"]:
         raise ValidationError('Frozen core is not available for the CC gradients.')
 
+    if core.get_option('CCTRANSORT', 'TEI_TYPE') != 'CONV':
+        raise ValidationError('CC gradients require exact integrals (CCTRANSORT TEI_TYPE CONV).')
+
     ccwfn = run_ccenergy(name, **kwargs)
 
     if name == 'cc2':
@@ -3628,8 +3687,10 @@ def run_eom_cc(name, **kwargs):
         core.set_local_option('CCEOM', 'WFN', 'EOM_CC3')
         ref_wfn = run_ccenergy('cc3', **kwargs)
 
+    cc_variables = ref_wfn.scalar_variables()
     core.cchbar(ref_wfn)
     core.cceom(ref_wfn)
+    proc_util.fno_correct(ref_wfn, cc_variables)
 
     optstash.restore()
     return ref_wfn
@@ -4058,7 +4119,8 @@ def run_detci(name, **kwargs):
         ['DETCI', 'MPN_ORDER_SAVE'],
         ['DETCI', 'MPN'],
         ['DETCI', 'FCI'],
-        ['DETCI', 'EX_LEVEL'])
+        ['DETCI', 'EX_LEVEL'],
+        ['DETCI', 'FROZEN_UOCC'])
 
     # throw exception for UHF
     if core.get_option('DETCI', 'REFERENCE') not in ['RHF', 'ROHF']:
@@ -4125,11 +4187,20 @@ def run_detci(name, **kwargs):
     if ref_wfn is None:
         ref_wfn = scf_helper(name, **kwargs)  # C1 certified
 
+    # DETCI takes its dropped virtuals from FROZEN_UOCC rather than from the reference
+    ref_wfn = proc_util.fno_truncate(name, ref_wfn)
+    if core.get_global_option('FROZEN_NAT_ORBS'):
+        if core.has_option_changed('DETCI', 'FROZEN_UOCC'):
+            raise ValidationError("Method '%s': FROZEN_UOCC is set by FROZEN_NAT_ORBS." % name)
+        core.set_local_option('DETCI', 'FROZEN_UOCC', list(ref_wfn.frzvpi().to_tuple()))
+
     # Ensure IWL files have been written
     proc_util.check_iwl_file_from_scf_type(core.get_global_option('SCF_TYPE'), ref_wfn)
 
     ciwfn = core.detci(ref_wfn)
 
+    proc_util.fno_correct(ciwfn, ref_wfn.scalar_variables())
+
     # Shove variables into global space
     for k, v in ciwfn.variables().items():
         core.set_variable(k, v)
@@ -4203,7 +4274,12 @@ def run_dfmp2(name, **kwargs):
     dfmp2_wfn = core.dfmp2(ref_wfn)
     dfmp2_wfn.compute_energy()
 
-    if name == 'scs-mp2':
+    if core.get_option('DFMP2', 'DFMP2_LAPLACE'):
+        # only the (scaled) opposite-spin energy is available
+        dfmp2_wfn.set_variable('CURRENT ENERGY', dfmp2_wfn.variable('CUSTOM SCS-MP2 TOTAL ENERGY'))
+        dfmp2_wfn.set_variable('CURRENT CORRELATION ENERGY', dfmp2_wfn.variable('CUSTOM SCS-MP2 CORRELATION ENERGY'))
+
+    elif name == 'scs-mp2':
         dfmp2_wfn.set_variable('CURRENT ENERGY', dfmp2_wfn.variable('SCS-MP2 TOTAL ENERGY'))
         dfmp2_wfn.set_variable('CURRENT CORRELATION ENERGY', dfmp2_wfn.variable('SCS-MP2 CORRELATION ENERGY'))
 
@@ -4220,6 +4296,76 @@ def run_dfmp2(name, **kwargs):
     return dfmp2_wfn
 
 
+def run_dfmp2_f12(name, **kwargs):
+    """Function encoding sequence of PSI module calls for
+    a density-fitted MP2-F12/3C(FIX) calculation.
+
+    """
+    optstash = p4util.OptionsState(
+        ['DF_BASIS_MP2'],
+        ['SCF_TYPE'])
+
+    # Alter default algorithm
+    if not core.has_global_option_changed('SCF_TYPE'):
+        core.set_global_option('SCF_TYPE', 'DF')
+        core.print_out("""    SCF Algorithm Type (re)set to DF.\n""")
+
+    # MP2-F12 is only DF
+    if core.get_global_option('MP2_TYPE') != "DF":
+        raise ValidationError("""  MP2-F12 is only implemented with density fitting.\n"""
+                              """  'mp2_type' must be set to 'DF'.\n""")
+
+    # Bypass the scf call if a reference wavefunction is given
+    ref_wfn = kwargs.get('ref_wfn', None)
+    if ref_wfn is None:
+        ref_wfn = scf_helper(name, use_c1=True, **kwargs)  # C1 certified
+    elif ref_wfn.molecule().schoenflies_symbol() != 'c1':
+        raise ValidationError("""  MP2-F12 does not make use of molecular symmetry: """
+                              """reference wavefunction must be C1.\n""")
+
+    if core.get_global_option('REFERENCE') != "RHF":
+        raise ValidationError("MP2-F12 is not available for %s references." %
+                              core.get_global_option('REFERENCE'))
+
+    core.tstart()
+    core.print_out('\n')
+    p4util.banner('DFMP2-F12')
+    core.print_out('\n')
+
+    aux_basis = core.BasisSet.build(ref_wfn.molecule(), "DF_BASIS_MP2",
+                                    core.get_option("DFMP2", "DF_BASIS_MP2"),
+                                    "RIFIT", core.get_global_option('BASIS'))
+    ref_wfn.set_basisset("DF_BASIS_MP2", aux_basis)
+
+    # The RI space is spanned by the union of the orbital basis and the CABS
+    orbital = core.get_global_option('BASIS')
+    cabs = core.get_option("DFMP2", "CABS_BASIS")
+    if not cabs:
+        if not orbital.lower().endswith('-f12'):
+            raise ValidationError("""  MP2-F12 has no default CABS for basis %s: set 'cabs_basis'.\n""" % orbital)
+        cabs = orbital + '-optri'
+    cabs_dict = qcdb.BasisSet.pyconstruct_combined(ref_wfn.molecule().to_dict(), ['BASIS', 'CABS_BASIS'],
+                                                   [orbital, cabs], ['ORBITAL', 'F12'], [orbital, orbital])
+    core.print_out(cabs_dict['message'])
+    cabs_basis = core.BasisSet.construct_from_pydict(ref_wfn.molecule(), cabs_dict,
+                                                     int(ref_wfn.basisset().has_puream()))
+    ref_wfn.set_basisset("CABS_BASIS", cabs_basis)
+
+    dfmp2_wfn = core.dfmp2_f12(ref_wfn)
+    dfmp2_wfn.compute_energy()
+
+    dfmp2_wfn.set_variable('CURRENT ENERGY', dfmp2_wfn.variable('MP2-F12 TOTAL ENERGY'))
+    dfmp2_wfn.set_variable('CURRENT CORRELATION ENERGY', dfmp2_wfn.variable('MP2-F12 CORRELATION ENERGY'))
+
+    # Shove variables into global space
+    for k, v in dfmp2_wfn.variables().items():
+        core.set_variable(k, v)
+
+    optstash.restore()
+    core.tstop()
+    return dfmp2_wfn
+
+
 def run_dfep2(name, **kwargs):
     """Function encoding sequence of PSI module calls for
     a density-fitted MP2 calculation.
@@ -4488,6 +4634,45 @@ def run_psimrcc_scf(name, **kwargs):
     return psimrcc_wfn
 
 
+# Last monomer SCF per SAPT monomer label, for sapt_reuse_monomers=True batches
+_sapt_monomer_cache = {}
+
+
+def _sapt_monomer_scf(label, monomer, reuse, do_delta_mp2, **kwargs):
+    """Runs the RHF (and MP2 for delta-MP2) of SAPT monomer `label`, returning the wavefunction
+    and the MP2 correlation energy (zero without delta-MP2). With `reuse`, a monomer whose
+    geometry, nuclei, charge, multiplicity and changed options all match the previous run for
+    that label is taken from the cache instead, e.g. the fixed partner of a rigid scan.
+
+    """
+    key = None
+    if reuse:
+        monomer.update_geometry()
+        geom = monomer.geometry().np
+        key = (tuple(np.round(geom.ravel(), 10)), tuple(monomer.Z(i) for i in range(monomer.natom())),
+               monomer.molecular_charge(), monomer.multiplicity(), do_delta_mp2,
+               repr(sorted(p4util.prepare_options_for_set_options().items())))
+
+        cached = _sapt_monomer_cache.get(label)
+        if cached is not None and cached[0] == key:
+            core.print_out(f'  Reusing monomer {label} wavefunction from the previous SAPT computation.\n')
+            return cached[1], cached[2]
+
+    core.timer_on(f"SAPT: Monomer {label} SCF")
+    wfn = scf_helper('RHF', molecule=monomer, **kwargs)
+    core.timer_off(f"SAPT: Monomer {label} SCF")
+
+    mp2_corl = 0.0
+    if do_delta_mp2:
+        select_mp2("mp2", ref_wfn=wfn, **kwargs)
+        mp2_corl = core.variable('MP2 CORRELATION ENERGY')
+
+    if reuse:
+        _sapt_monomer_cache[label] = (key, wfn, mp2_corl)
+
+    return wfn, mp2_corl
+
+
 def run_sapt(name, **kwargs):
     """Function encoding sequence of PSI module calls for
     a SAPT calculation of any level.
@@ -4508,6 +4693,10 @@ def run_sapt(name, **kwargs):
         sapt_dimer = ref_wfn.molecule()
 
     sapt_basis = kwargs.pop('sapt_basis', 'dimer')
+    reuse_monomers = kwargs.pop('sapt_reuse_monomers', False)
+    if reuse_monomers and sapt_basis != 'monomer':
+        core.print_out('  Warning! sapt_reuse_monomers requires sapt_basis=\'monomer\', monomers will be recomputed.\n')
+        reuse_monomers = False
 
     sapt_dimer, monomerA, monomerB = proc_util.prepare_sapt_molecule(sapt_dimer, sapt_basis)
 
@@ -4566,13 +4755,10 @@ def run_sapt(name, **kwargs):
     p4util.banner('Monomer A HF')
     core.print_out('\n')
 
-    core.timer_on("SAPT: Monomer A SCF")
-    monomerA_wfn = scf_helper('RHF', molecule=monomerA, **kwargs)
-    core.timer_off("SAPT: Monomer A SCF")
+    monomerA_wfn, monomerA_mp2 = _sapt_monomer_scf('A', monomerA, reuse_monomers, do_delta_mp2, **kwargs)
 
     if do_delta_mp2:
-        select_mp2("mp2", ref_wfn=monomerA_wfn, **kwargs)
-        mp2_corl_interaction_e -= core.variable('MP2 CORRELATION ENERGY')
+        mp2_corl_interaction_e -= monomerA_mp2
 
     # Compute Monomer B wavefunction
     if (sapt_basis == 'dimer') and (ri == 'DF'):
@@ -4582,14 +4768,11 @@ def run_sapt(name, **kwargs):
     p4util.banner('Monomer B HF')
     core.print_out('\n')
 
-    core.timer_on("SAPT: Monomer B SCF")
-    monomerB_wfn = scf_helper('RHF', molecule=monomerB, **kwargs)
-    core.timer_off("SAPT: Monomer B SCF")
+    monomerB_wfn, monomerB_mp2 = _sapt_monomer_scf('B', monomerB, reuse_monomers, do_delta_mp2, **kwargs)
 
     # Delta MP2
     if do_delta_mp2:
-        select_mp2("mp2", ref_wfn=monomerB_wfn, **kwargs)
-        mp2_corl_interaction_e -= core.variable('MP2 CORRELATION ENERGY')
+        mp2_corl_interaction_e -= monomerB_mp2
         core.set_variable("SAPT MP2 CORRELATION ENERGY", mp2_corl_interaction_e)  # P::e SAPT
     core.set_global_option('DF_INTS_IO', df_ints_io)
 
@@ -5471,6 +5654,14 @@ def run_detcas(name, **kwargs):
         raise ValidationError("Run DETCAS: MCSCF_TYPE %s not understood." % str(core.get_option('DETCI', 'MCSCF_TYPE')))
 
 
+    # Fitted AH Hessian products on top of exact integrals
+    if (core.get_option('DETCI', 'MCSCF_HK_JK') == 'DF') and (core.get_option('DETCI', 'MCSCF_TYPE') != 'DF'):
+        scf_aux_basis = core.BasisSet.build(ref_wfn.molecule(), "DF_BASIS_SCF",
+                                            core.get_option("SCF", "DF_BASIS_SCF"),
+                                            "JKFIT", core.get_global_option('BASIS'),
+                                            puream=ref_wfn.basisset().has_puream())
+        ref_wfn.set_basisset("DF_BASIS_SCF", scf_aux_basis)
+
     # Second-order SCF requires non-symmetric density matrix support
     if core.get_option('DETCI', 'MCSCF_ALGORITHM') in ['AH', 'OS']:
         proc_util.check_non_symmetric_jk_density("Second-order MCSCF")
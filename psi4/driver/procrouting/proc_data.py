@@ -125,6 +125,7 @@ method_governing_type_keywords = {
         "fno-ccsd(t)"  : "cc_type",
 
         "dlpno-mp2"    : "mp2_type",
+        "mp2-f12"      : "mp2_type",
 
         "ep2"          : "mp2_type",
         "eom-cc2"      : "cc_type",
@@ -66,6 +66,7 @@ procedures = {
         'custom-scs-omp2' : proc.run_occ,
         'dlpno-mp2'     : proc.run_dlpnomp2,
         'scs-dlpno-mp2' : proc.run_dlpnomp2,
+        'mp2-f12'       : proc.run_dfmp2_f12,
         'mp2.5'         : proc.select_mp2p5,
         'custom-scs-mp2.5' : proc.run_occ,
         'omp2.5'        : proc.select_omp2p5,
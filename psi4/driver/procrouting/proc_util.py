@@ -95,7 +95,7 @@ def check_iwl_file_from_scf_type(scf_type, wfn):
     Ensures that a IWL file has been written based on input SCF type.
     """
 
-    if scf_type in ['DF', 'DISK_DF', 'MEM_DF', 'CD', 'PK', 'DIRECT']:
+    if scf_type in ['DF', 'DISK_DF', 'MEM_DF', 'CD', 'PK', 'DIRECT', 'AUTO']:
         mints = core.MintsHelper(wfn.basisset())
         if core.get_global_option("RELATIVISTIC") in ["X2C", "DKH"]:
             rel_bas = core.BasisSet.build(wfn.molecule(),
@@ -115,7 +115,7 @@ def check_non_symmetric_jk_density(name):
     Ensure non-symmetric density matrices are supported for the selected JK routine.
     """
     scf_type = core.get_global_option('SCF_TYPE')
-    supp_jk_type = ['DF', 'DISK_DF', 'MEM_DF', 'CD', 'PK', 'DIRECT', 'OUT_OF_CORE']
+    supp_jk_type = ['DF', 'DISK_DF', 'MEM_DF', 'CD', 'PK', 'DIRECT', 'OUT_OF_CORE', 'AUTO']
     supp_string = ', '.join(supp_jk_type[:-1]) + ', or ' + supp_jk_type[-1] + '.'
 
     if scf_type not in supp_jk_type:
@@ -138,6 +138,67 @@ def check_disk_df(name, optstash):
             )
 
 
+def fno_truncate(name, ref_wfn):
+    """
+    Returns ref_wfn with its virtual space truncated to DF-MP2 frozen natural
+    orbitals if FROZEN_NAT_ORBS is set, and ref_wfn itself otherwise.
+    """
+
+    if not core.get_global_option('FROZEN_NAT_ORBS'):
+        return ref_wfn
+
+    if core.get_option('SCF', 'REFERENCE') != 'RHF':
+        raise ValidationError(f"Method '{name}': frozen natural orbitals require an RHF reference.")
+    if core.get_global_option('DERTYPE') != 'NONE':
+        raise ValidationError(f"Method '{name}': frozen natural orbitals are only available for energies.")
+
+    aux_basis = core.BasisSet.build(ref_wfn.molecule(), "DF_BASIS_MP2",
+                                    core.get_option("DFMP2", "DF_BASIS_MP2"),
+                                    "RIFIT", core.get_global_option('BASIS'),
+                                    puream=ref_wfn.basisset().has_puream())
+    ref_wfn.set_basisset("DF_BASIS_MP2", aux_basis)
+
+    return core.fno_wavefunction(ref_wfn)
+
+
+def fno_correct(wfn, inherited):
+    """
+    Adds the MP2 energy of the virtuals discarded by :py:func:`fno_truncate` to the
+    correlation and total energies that a module set on wfn, both on wfn and in the
+    globals. inherited holds the scalar variables the module started from; those
+    are left alone, so a later module can be corrected without correcting twice.
+    """
+
+    if 'MP2 FNO CORRECTION ENERGY' not in inherited:
+        return
+
+    delta = inherited['MP2 FNO CORRECTION ENERGY']
+    delta_os = inherited['MP2 FNO OPPOSITE-SPIN CORRECTION ENERGY']
+    delta_ss = inherited['MP2 FNO SAME-SPIN CORRECTION ENERGY']
+
+    for key, value in wfn.scalar_variables().items():
+        if inherited.get(key) == value or 'FNO' in key:
+            continue
+        if not (key == 'CURRENT ENERGY' or key.endswith('TOTAL ENERGY') or key.endswith('CORRELATION ENERGY')):
+            continue
+        # reference energies and spin-scaled variants are not corrected
+        if key.startswith(('SCF ', 'HF ', 'CURRENT REFERENCE')) or 'SCS' in key or 'SOS' in key:
+            continue
+
+        if 'OPPOSITE-SPIN' in key:
+            value += delta_os
+        elif 'SAME-SPIN' in key:
+            value += delta_ss
+        else:
+            value += delta
+        wfn.set_variable(key, value)
+        if core.has_scalar_variable(key):
+            core.set_variable(key, value)
+
+    if wfn.has_scalar_variable('CURRENT ENERGY'):
+        wfn.set_energy(wfn.variable('CURRENT ENERGY'))
+
+
 def print_ci_results(ciwfn, rname, scf_e, ci_e, print_opdm_no=False):
     """
     Printing for all CI Wavefunctions
@@ -130,6 +130,7 @@ class ProductCache:
             A list of product labels
         """
         self._products = {p: [] for p in product_types}
+        self.collapsed = False
 
     def add(self, pkey, new_elements):
         """Adds new elements to a given key
@@ -147,14 +148,54 @@ class ProductCache:
 
         for new in new_elements:
             self._products[pkey].append(new)
+            self.collapsed = False
 
         return self._products[pkey].copy()
 
+    def get(self, pkey):
+        """Returns the cached products for a given key
+
+        Parameters
+        ----------
+        pkey : str
+            Product label
+        """
+        if pkey not in self._products.keys():
+            raise AttributeError("No such product {}".format(pkey))
+
+        return self._products[pkey].copy()
+
+    def collapse(self, coefficients, engine):
+        """Replaces the cached products with linear combinations of themselves,
+        following a collapse of the trial space onto ``X_new = X @ coefficients``.
+        The products are linear in the trial vectors so no new products are needed.
+
+        Parameters
+        ----------
+        coefficients : numpy.ndarray
+            {l, k} expansion coefficients of the new trial vectors in the old ones
+        engine : object
+            Provides the `vector` algebra (``new_vector``, ``vector_axpy``)
+        """
+        l, k = coefficients.shape
+        for pkey, old in self._products.items():
+            if len(old) != l:
+                raise ValueError("Cache length does not match the collapse coefficients. Call a developer.")
+            new = []
+            for j in range(k):
+                v = engine.new_vector()
+                for i in range(l):
+                    v = engine.vector_axpy(coefficients[i, j], old[i], v)
+                new.append(v)
+            self._products[pkey] = new
+        self.collapsed = True
+
     def reset(self):
         """Resets the ProductCache by clearing all data.
         """
         for pkey in self._products.keys():
             self._products[pkey].clear()
+        self.collapsed = False
 
     def count(self):
         """Return the number of cached products
@@ -251,7 +292,7 @@ class TDRSCFEngine(SingleMatPerVector):
         n_old = self.product_cache.count()
         n_new = len(vectors)
 
-        if n_new <= n_old:
+        if (n_new < n_old) or (n_new == n_old and not self.product_cache.collapsed):
             self.product_cache.reset()
             compute_vectors = vectors
         else:
@@ -259,6 +300,13 @@ class TDRSCFEngine(SingleMatPerVector):
 
         n_prod = len(compute_vectors)
 
+        # Trial space was collapsed onto the cached products
+        if n_prod == 0:
+            if self.ptype == 'rpa':
+                return self.product_cache.get("H1"), self.product_cache.get("H2"), 0
+            else:
+                return self.product_cache.get("A"), 0
+
         # Build base one and two electron quantities
         Fx = self.wfn.onel_Hx(compute_vectors)
         twoel = self.wfn.twoel_Hx_full(compute_vectors, False, "SO", self.singlet)
@@ -283,6 +331,10 @@ class TDRSCFEngine(SingleMatPerVector):
             AX_all = self.product_cache.add("A", AX_new)
             return AX_all, n_prod
 
+    def collapse_products(self, coefficients):
+        """Rotate the cached products onto a collapsed trial space, see :meth:`ProductCache.collapse`"""
+        self.product_cache.collapse(coefficients, self)
+
     def precondition(self, Rvec, shift):
         """Applies the preconditioner with a shift to a residual vector
 
@@ -504,7 +556,7 @@ class TDUSCFEngine(PairedMatPerVector):
 
         n_old = self.product_cache.count()
         n_new = len(vectors)
-        if n_new <= n_old:
+        if (n_new < n_old) or (n_new == n_old and not self.product_cache.collapsed):
             self.product_cache.reset()
             compute_vectors = vectors
         else:
@@ -512,6 +564,15 @@ class TDUSCFEngine(PairedMatPerVector):
 
         n_prod = len(compute_vectors)
 
+        # Trial space was collapsed onto the cached products
+        if n_prod == 0:
+            if self.ptype == "rpa":
+                return self.product_cache.get("H1"), self.product_cache.get("H2"), 0
+            elif self.ptype == "hess":
+                return self.product_cache.get("H1"), 0
+            else:
+                return self.product_cache.get("A"), 0
+
         # flatten list of [(A,B)_i, ...] to [A_i, B_i, ...]
         vec_flat = sum(compute_vectors, [])
 
@@ -541,6 +602,10 @@ class TDUSCFEngine(PairedMatPerVector):
             AX_all = self.product_cache.add("A", AX_new)
             return AX_all, n_prod
 
+    def collapse_products(self, coefficients):
+        """Rotate the cached products onto a collapsed trial space, see :meth:`ProductCache.collapse`"""
+        self.product_cache.collapse(coefficients, self)
+
     def generate_guess(self, nguess):
         """Generate a set of guess vectors based on orbital energy differences
         """
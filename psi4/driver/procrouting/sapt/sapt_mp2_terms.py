@@ -151,11 +151,31 @@ def df_fdds_dispersion(primary, auxiliary, cache, is_hybrid, x_alpha, leg_points
         Rtinv_A = np.linalg.pinv(R_A, rcond=1.e-13).transpose()
         Rtinv_B = np.linalg.pinv(R_B, rcond=1.e-13).transpose()
 
-    for point, weight in zip(*np.polynomial.legendre.leggauss(leg_points)):
+    leg_grid = list(zip(*np.polynomial.legendre.leggauss(leg_points)))
+
+    # Pure functionals: the uncoupled amplitudes only need (ar|Q), so form them for as many
+    #   frequencies at once as memory allows, reading each (ar|Q) block once per batch
+    if not is_hybrid:
+        naux = auxiliary.nbf()
+        # A and B amplitudes held per frequency plus headroom for the coupled-loop temporaries
+        nbatch = int(0.4 * core.get_memory() / 8 / (6 * naux * naux))
+        nbatch = max(1, min(leg_points, nbatch))
+        X_A_batch = {}
+        X_B_batch = {}
+
+    for ipoint, (point, weight) in enumerate(leg_grid):
 
         omega = leg_lambda * (1.0 - point) / (1.0 + point)
         lambda_scale = ((2.0 * leg_lambda) / (point + 1.0)**2)
 
+        if not is_hybrid and ipoint not in X_A_batch:
+            X_A_batch.clear()
+            X_B_batch.clear()
+            batch = range(ipoint, min(ipoint + nbatch, leg_points))
+            batch_omegas = [leg_lambda * (1.0 - leg_grid[i][0]) / (1.0 + leg_grid[i][0]) for i in batch]
+            X_A_batch = dict(zip(batch, fdds_obj.form_unc_amplitudes("A", batch_omegas)))
+            X_B_batch = dict(zip(batch, fdds_obj.form_unc_amplitudes("B", batch_omegas)))
+
         # Monomer A
         if is_hybrid:
             aux_dict = fdds_obj.form_aux_matrices("A", omega)
@@ -167,7 +187,7 @@ def df_fdds_dispersion(primary, auxiliary, cache, is_hybrid, x_alpha, leg_points
             K_A = -x_alpha * aux_dict["K1LD"] - x_alpha * aux_dict["K2LD"] + x_alpha * x_alpha * aux_dict["K21L"]
             KRS_A = K_A.dot(Rtinv_A).dot(metric)
         else:
-            X_A = fdds_obj.form_unc_amplitude("A", omega)
+            X_A = X_A_batch.pop(ipoint)
             X_A.scale(-1.0)
             X_A = X_A.to_array()
             X_A_uc = X_A.copy()
@@ -195,7 +215,7 @@ def df_fdds_dispersion(primary, auxiliary, cache, is_hybrid, x_alpha, leg_points
             K_B = -x_alpha * aux_dict["K1LD"] - x_alpha * aux_dict["K2LD"] + x_alpha * x_alpha * aux_dict["K21L"]
             KRS_B = K_B.dot(Rtinv_B).dot(metric)
         else:
-            X_B = fdds_obj.form_unc_amplitude("B", omega)
+            X_B = X_B_batch.pop(ipoint)
             X_B.scale(-1.0)
             X_B = X_B.to_array()
             X_B_uc = X_B.copy()
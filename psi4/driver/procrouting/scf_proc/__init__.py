@@ -30,4 +30,4 @@
 A helper folder for auxiliary SCF functions and iterations.
 """
 
-from . import scf_iterator, subclass_methods
+from . import guess_extrapolation, scf_iterator, subclass_methods
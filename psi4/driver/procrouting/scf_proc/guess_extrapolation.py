@@ -0,0 +1,122 @@
+
+# @BEGIN LICENSE
+#
+# Psi4: an open-source quantum chemistry software package
+#
+# Copyright (c) 2007-2023 The Psi4 Developers.
+#
+# The copyrights for code used from other parties are included in
+# the corresponding files.
+#
+# This file is part of Psi4.
+#
+# Psi4 is free software; you can redistribute it and/or modify
+# it under the terms of the GNU Lesser General Public License as published by
+# the Free Software Foundation, version 3.
+#
+# Psi4 is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public License along
+# with Psi4; if not, write to the Free Software Foundation, Inc.,
+# 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+#
+# @END LICENSE
+#
+"""
+The SCF iteration functions
+"""
+import numpy as np
+
+"""
+Extrapolation of SCF guess orbitals along a sequence of geometries (geometry optimizations,
+molecular dynamics driven from one Psi4 session), from the converged solutions at previous steps.
+
+The predicted density is the always stable predictor-corrector (ASPC) combination of the previous
+densities [Kolafa, J. Comput. Chem. 25, 335 (2004); Kuhne et al., Phys. Rev. Lett. 98, 066401 (2007)].
+Occupied orbitals are recovered by projecting the latest orbitals onto the predicted density and
+orthonormalizing them in the current overlap metric.
+"""
+
+from math import comb
+
+from psi4 import core
+
+# Converged solutions of previous steps, most recent last.
+_history = []
+
+
+def _signature(wfn):
+    """ Everything that must agree for stored solutions to be combined. """
+    return (wfn.basisset().name(), wfn.molecule().natom(), wfn.nsopi().to_tuple(), wfn.nalphapi().to_tuple(),
+            wfn.nbetapi().to_tuple(), wfn.same_a_b_orbs())
+
+
+def aspc_coefficients(npoints):
+    """ ASPC predictor coefficients B_j, j = 1 .. npoints, for order K = npoints - 2.
+    A single point is taken over as is. """
+    if npoints == 1:
+        return [1.0]
+    K = npoints - 2
+    return [(-1)**(j + 1) * j * comb(2 * K + 4, K + 2 - j) / comb(2 * K + 2, K + 1) for j in range(1, npoints + 1)]
+
+
+def reset():
+    """ Forget all stored solutions. """
+    _history.clear()
+
+
+def store_solution(wfn):
+    """ Record the converged orbitals of wfn for use at later steps. """
+    if core.get_option('SCF', 'GUESS_EXTRAPOLATION') == 'NONE':
+        return
+
+    signature = _signature(wfn)
+    if _history and _history[-1]["signature"] != signature:
+        reset()
+
+    entry = {"signature": signature}
+    for spin, C in (("a", wfn.Ca_subset("SO", "OCC")), ("b", wfn.Cb_subset("SO", "OCC"))):
+        entry["C" + spin] = C
+        entry["D" + spin] = core.doublet(C, C, False, True)
+    _history.append(entry)
+
+    max_points = core.get_option('SCF', 'GUESS_EXTRAPOLATION_ORDER') + 2
+    del _history[:-max_points]
+
+
+def extrapolate_guess(wfn):
+    """ Set guess orbitals on wfn from the stored solutions. Returns whether a guess was set. """
+    if core.get_option('SCF', 'GUESS_EXTRAPOLATION') == 'NONE':
+        return False
+
+    signature = _signature(wfn)
+    usable = [entry for entry in _history if entry["signature"] == signature]
+    if not usable:
+        return False
+
+    coefficients = aspc_coefficients(len(usable))
+    S = core.MintsHelper(wfn.basisset()).so_overlap()
+
+    guess = {}
+    for spin in ("a", "b"):
+        D = usable[-1]["D" + spin].clone()
+        D.zero()
+        # B_1 multiplies the latest density
+        for B, entry in zip(coefficients, reversed(usable)):
+            D.axpy(B, entry["D" + spin])
+
+        C = core.triplet(D, S, usable[-1]["C" + spin], False, False, False)
+        M = core.triplet(C, S, C, True, False, False)
+        M.power(-0.5, 1.e-12)
+        guess[spin] = core.doublet(C, M, False, False)
+
+    if len(usable) == 1:
+        core.print_out("  Projecting guess orbitals from the previous SCF solution.\n\n")
+    else:
+        core.print_out(f"  Extrapolating guess orbitals from {len(usable)} previous SCF solutions (ASPC order {len(usable) - 2}).\n\n")
+    wfn.guess_Ca(guess["a"])
+    wfn.guess_Cb(guess["b"])
+    return True
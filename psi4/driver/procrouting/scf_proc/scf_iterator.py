@@ -77,7 +77,8 @@ def scf_compute_energy(self):
         # reset the DIIS & JK objects in prep for DIRECT
         if self.initialized_diis_manager_:
             self.diis_manager_.reset_subspace()
-        self.initialize_jk(self.memory_jk_)
+        shared_jk = _shared_jk(self)
+        self.initialize_jk(self.memory_jk_, jk=shared_jk, initialized=(shared_jk is not None))
     else:
         self.initialize()
 
@@ -107,7 +108,15 @@ def _build_jk(wfn, memory):
     return jk
 
 
-def initialize_jk(self, memory, jk=None):
+def _shared_jk(wfn):
+    """Returns the JK object handed to `wfn` by :py:func:`scf_compute_states`, if it was built for the current SCF_TYPE."""
+    scf_type, jk = getattr(wfn, "shared_jk_", (None, None))
+    if scf_type != core.get_global_option('SCF_TYPE'):
+        return None
+    return jk
+
+
+def initialize_jk(self, memory, jk=None, initialized=False):
 
     functional = self.functional()
     if jk is None:
@@ -116,7 +125,6 @@ def initialize_jk(self, memory, jk=None):
     self.set_jk(jk)
 
     jk.set_print(self.get_print())
-    jk.set_memory(memory)
     jk.set_do_K(functional.is_x_hybrid())
     jk.set_do_wK(functional.is_x_lrc())
     jk.set_omega(functional.x_omega())
@@ -124,6 +132,11 @@ def initialize_jk(self, memory, jk=None):
     jk.set_omega_alpha(functional.x_alpha())
     jk.set_omega_beta(functional.x_beta())   
 
+    # a JK shared between wavefunctions keeps its integrals and memory layout
+    if initialized:
+        return
+
+    jk.set_memory(memory)
     jk.initialize()
     jk.print_header()
 
@@ -140,15 +153,18 @@ def scf_initialize(self):
     vbase = self.V_potential()
     if vbase:
         collocation_size = vbase.grid().collocation_size()
-        if vbase.functional().ansatz() == 1:
+        if max(vbase.functional().ansatz(), vbase.collocation_deriv()) == 1:
             collocation_size *= 4  # First derivs
-        elif vbase.functional().ansatz() == 2:
+        elif max(vbase.functional().ansatz(), vbase.collocation_deriv()) == 2:
             collocation_size *= 10  # Second derivs
+        elif vbase.collocation_deriv() == 3:
+            collocation_size *= 20  # Third derivs, GGA Hessian
     else:
         collocation_size = 0
 
     # Change allocation for collocation matrices based on DFT type
-    jk = _build_jk(self, total_memory)
+    shared_jk = _shared_jk(self)
+    jk = shared_jk if shared_jk is not None else _build_jk(self, total_memory)
     jk_size = jk.memory_estimate()
 
     # Give remaining to collocation
@@ -189,7 +205,7 @@ def scf_initialize(self):
     if self.attempt_number_ == 1:
         mints = core.MintsHelper(self.basisset())
 
-        self.initialize_jk(self.memory_jk_, jk=jk)
+        self.initialize_jk(self.memory_jk_, jk=jk, initialized=(shared_jk is not None))
         if self.V_potential():
             self.V_potential().build_collocation_cache(self.memory_collocation_)
         core.timer_on("HF: Form core H")
@@ -279,6 +295,17 @@ def scf_iterate(self, e_conv=None, d_conv=None):
     # has early_screening changed from True to False?
     early_screening_disabled = False
 
+    # does the JK build contract in single precision until the density settles?
+    low_precision = core.get_option('SCF', 'SCF_MIXED_PRECISION')
+    low_precision_conv = core.get_option('SCF', 'SCF_MIXED_PRECISION_CONVERGENCE')
+    self.jk().set_low_precision(low_precision)
+
+    # does the DFT Fock build skip grid blocks of negligible density until convergence?
+    block_screening = bool(self.V_potential()) and self.V_potential().block_screening()
+
+    # does the DFT Fock build reuse the contributions of grid blocks whose density has settled?
+    incremental_xc = bool(self.V_potential()) and self.V_potential().incremental_xc()
+
     # SCF iterations!
     SCFE_old = 0.0
     Dnorm = 0.0
@@ -471,6 +498,15 @@ def scf_iterate(self, e_conv=None, d_conv=None):
         self.set_variable("SCF ITERATION ENERGY", SCFE)
         core.set_variable("SCF D NORM", Dnorm)
 
+        # switch the JK build back to double precision once the density is close enough
+        if low_precision and not ((self.iteration_ == 0) and self.sad_) and Dnorm < low_precision_conv:
+            low_precision = False
+            self.jk().set_low_precision(low_precision)
+            # the incremental Fock build must not reuse single-precision contributions
+            if hasattr(self.jk(), 'clear_D_prev'):
+                self.jk().clear_D_prev()
+            core.print_out("  Density converged below SCF_MIXED_PRECISION_CONVERGENCE. Switching JK build to double precision.\n\n")
+
         # After we've built the new D, damp the update
         if (damping_enabled and self.iteration_ > 1 and Dnorm > core.get_option('SCF', 'DAMPING_CONVERGENCE')):
             damping_percentage = core.get_option('SCF', "DAMPING_PERCENTAGE")
@@ -511,7 +547,33 @@ def scf_iterate(self, e_conv=None, d_conv=None):
         # Call any postiteration callbacks
         if not ((self.iteration_ == 0) and self.sad_) and _converged(Ediff, Dnorm, e_conv=e_conv, d_conv=d_conv):
 
-            if early_screening:
+            if low_precision:
+
+                # never stop on a single-precision Fock matrix
+                low_precision = False
+                self.jk().set_low_precision(low_precision)
+                if hasattr(self.jk(), 'clear_D_prev'):
+                    self.jk().clear_D_prev()
+                core.print_out("  Energy and wave function converged with a single-precision JK build.\n")
+                core.print_out("  Continuing SCF iterations in double precision.\n\n")
+
+            elif block_screening:
+
+                # never stop on a Fock matrix built from a density-screened grid
+                block_screening = False
+                self.V_potential().set_block_screening(block_screening)
+                core.print_out("  Energy and wave function converged with density-screened DFT grid blocks.\n")
+                core.print_out("  Continuing SCF iterations on the full grid.\n\n")
+
+            elif incremental_xc:
+
+                # never stop on a Fock matrix holding reused XC block contributions
+                incremental_xc = False
+                self.V_potential().set_incremental_xc(incremental_xc)
+                core.print_out("  Energy and wave function converged with incremental DFT grid block contributions.\n")
+                core.print_out("  Continuing SCF iterations with a full XC build.\n\n")
+
+            elif early_screening:
 
                 # we've reached convergence with early screning enabled; disable it on the JK object
                 early_screening = False
@@ -720,7 +782,8 @@ def scf_finalize_energy(self):
 
     # TODO re-enable
     self.finalize()
-    if self.V_potential():
+    # A following gradient or Hessian reuses the cache and clears it when done
+    if self.V_potential() and self.V_potential().collocation_deriv() < 0:
         self.V_potential().clear_collocation_cache()
 
     core.print_out("\nComputation Completed\n")
@@ -847,6 +910,54 @@ core.HF.print_energies = scf_print_energies
 core.HF.print_preiterations = scf_print_preiterations
 
 
+def scf_compute_states(wfns):
+    """Converges several SCF wavefunctions built on the same molecule and basis
+    (e.g., different spin states, MOM excited states, or broken-symmetry guesses)
+    one after the other, with a single JK object. The integrals held by the JK
+    object are computed for the first wavefunction only.
+
+    Parameters
+    ----------
+    wfns : list of :py:class:`psi4.core.HF`
+        Wavefunctions to converge. Their functionals must agree in range separation.
+
+    Returns
+    -------
+    list of float
+        The SCF energy of each wavefunction.
+
+    """
+    if not wfns:
+        return []
+
+    ref = wfns[0]
+    for wfn in wfns[1:]:
+        if wfn.basisset().name() != ref.basisset().name() or wfn.basisset().nbf() != ref.basisset().nbf():
+            raise ValidationError("scf_compute_states: all wavefunctions must share one orbital basis.")
+        if (wfn.functional().is_x_lrc() != ref.functional().is_x_lrc()
+                or wfn.functional().x_omega() != ref.functional().x_omega()):
+            raise ValidationError("scf_compute_states: all wavefunctions must share one range-separation parameter.")
+
+    energies = []
+    shared = None
+    with p4util.OptionsStateCM(['SAVE_JK']):
+        core.set_global_option('SAVE_JK', True)
+        for wfn in wfns:
+            if shared is not None:
+                # incremental Fock builds must not difference against another state's density
+                if hasattr(shared[1], 'clear_D_prev'):
+                    shared[1].clear_D_prev()
+                wfn.shared_jk_ = shared
+            energies.append(wfn.compute_energy())
+            shared = (core.get_global_option('SCF_TYPE'), wfn.jk())
+
+    for wfn in wfns:
+        if hasattr(wfn, "shared_jk_"):
+            del wfn.shared_jk_
+
+    return energies
+
+
 def _converged(e_delta, d_rms, e_conv=None, d_conv=None):
     if e_conv is None:
         e_conv = core.get_option("SCF", "E_CONVERGENCE")
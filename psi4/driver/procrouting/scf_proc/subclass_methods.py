@@ -50,8 +50,9 @@ def _UHF_orbital_gradient(self, save_fock: bool, max_diis_vectors: int) -> float
 
     if save_fock:
         if not self.initialized_diis_manager_:
+            storage_policy = StoragePolicy.InCore if self.scf_type() == "DIRECT" else StoragePolicy.OnDisk
             self.diis_manager_ = DIIS(max_diis_vectors, "HF DIIS vector", RemovalPolicy.LargestError,
-                                                          StoragePolicy.OnDisk, False, engines=diis_engine_helper(self))
+                                                          storage_policy, False, engines=diis_engine_helper(self))
             self.initialized_diis_manager_ = True
 
         entry = {"target": [self.Fa(), self.Fb()]}
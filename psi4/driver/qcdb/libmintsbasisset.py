@@ -39,7 +39,7 @@ from .exceptions import *
 from .psiutil import search_file
 from .molecule import Molecule
 from .libmintsgshell import ShellInfo
-from .libmintsbasissetparser import Gaussian94BasisSetParser
+from .libmintsbasissetparser import Gaussian94BasisSetParser, dataset_digest
 from .basislist import corresponding_basis, corresponding_zeta
 
 
@@ -555,7 +555,7 @@ class BasisSet(object):
             raise ValidationError("""Lengths of keys, targets, and fitroles must be equal""")
 
         # Create (if necessary) and update qcdb.Molecule
-        if isinstance(mol, str):
+        if isinstance(mol, (str, dict)):
             mol = Molecule(mol)
             returnBasisSet = False
         elif isinstance(mol, Molecule):
@@ -821,6 +821,7 @@ class BasisSet(object):
         ecp_atom_basis_shell = collections.OrderedDict()
         ecp_atom_basis_ncore = collections.OrderedDict()
         names = {}
+        digests = {}
         summary = []
         bastitles = []
 
@@ -925,11 +926,13 @@ class BasisSet(object):
                         names[index] = parser.load_file(fullfilename)
 
                 lines = names[index]
+                if index not in digests:
+                    digests[index] = dataset_digest(lines)
 
                 for entry in seek['entry']:
 
                     # Seek entry in lines, else skip to next entry
-                    shells, msg, ecp_shells, ecp_msg, ecp_ncore = parser.parse(entry, lines)
+                    shells, msg, ecp_shells, ecp_msg, ecp_ncore = parser.parse_cached(entry, lines, digests[index])
                     if shells is None:
                         continue
 
@@ -29,10 +29,63 @@
 import os
 import re
 import sys
+import copy
+import pickle
+import hashlib
+import tempfile
 
 from .exceptions import *
 from .libmintsgshell import *
 
+# Basis set text per (filename, basisname, mtime, size), shared by all parsers in this process
+_loaded_files = {}
+
+# Parsed entries per dataset digest, {(symbol, forced_puream): (shells, msg, ecp_shells, ecp_msg, ecp_ncore)},
+# shared by all parsers in this process. If PSI_BASIS_CACHE names a directory, each dataset's entries
+# are also pickled there so later jobs skip the parse.
+_parsed_entries = {}
+
+
+def dataset_digest(lines):
+    """Digest identifying the basis set text *lines* (list of lines or string) for the parsed entry cache."""
+    text = lines if isinstance(lines, str) else '\n'.join(lines)
+    return hashlib.sha1(text.encode('utf-8')).hexdigest()
+
+
+def _basis_cache_file(digest):
+    cache_dir = os.environ.get('PSI_BASIS_CACHE')
+    if not cache_dir or not os.path.isdir(cache_dir):
+        return None
+    return os.path.join(cache_dir, 'psi4basis_' + digest + '.pkl')
+
+
+def _cached_entries(digest):
+    if digest not in _parsed_entries:
+        entries = {}
+        cache_file = _basis_cache_file(digest)
+        if cache_file is not None and os.path.isfile(cache_file):
+            try:
+                with open(cache_file, 'rb') as handle:
+                    entries = pickle.load(handle)
+            except Exception:
+                entries = {}
+        _parsed_entries[digest] = entries
+    return _parsed_entries[digest]
+
+
+def _persist_entries(digest):
+    cache_file = _basis_cache_file(digest)
+    if cache_file is None:
+        return
+    # Write and rename so concurrent jobs never read a partial file
+    try:
+        fd, tmpname = tempfile.mkstemp(dir=os.path.dirname(cache_file), suffix='.tmp')
+        with os.fdopen(fd, 'wb') as handle:
+            pickle.dump(_parsed_entries[digest], handle, protocol=pickle.HIGHEST_PROTOCOL)
+        os.replace(tmpname, cache_file)
+    except OSError:
+        pass
+
 
 class Gaussian94BasisSetParser(object):
     """Class for parsing basis sets from a text file in Gaussian 94
@@ -68,8 +121,13 @@ class Gaussian94BasisSetParser(object):
             infile = open(filename, 'r')
         except IOError:
             raise BasisSetFileNotFound("""BasisSetParser::parse: Unable to open basis set file: %s""" % (filename))
-        if os.stat(filename).st_size == 0:
+        stat = os.stat(filename)
+        if stat.st_size == 0:
             raise ValidationError("""BasisSetParser::parse: given filename '%s' is blank.""" % (filename))
+        stamp = (filename, basisname, stat.st_mtime_ns, stat.st_size)
+        if stamp in _loaded_files:
+            infile.close()
+            return list(_loaded_files[stamp])
         contents = infile.readlines()
         infile.close()
 
@@ -93,8 +151,24 @@ class Gaussian94BasisSetParser(object):
                 if basisname == basis_separator.match(text).group(1):
                     found_basisname = True
 
+        _loaded_files[stamp] = list(lines)
         return lines
 
+    def parse_cached(self, symbol, dataset, digest):
+        """Same as :py:meth:`parse`, but results are kept per (*digest*, *symbol*)
+        so each element of a dataset is parsed once per process (or once
+        per :envvar:`PSI_BASIS_CACHE` directory). *digest* must identify
+        *dataset*, see :py:func:`dataset_digest`.
+
+        """
+        entries = _cached_entries(digest)
+        key = (symbol, self.force_puream_or_cartesian, self.forced_is_puream)
+        if key not in entries:
+            entries[key] = self.parse(symbol, dataset)
+            _persist_entries(digest)
+        # Callers may post-process the shells, hand out copies
+        return copy.deepcopy(entries[key])
+
     def parse(self, symbol, dataset):
         """Given a string, parse for the basis set needed for atom.
         * @param symbol atom symbol to look for in dataset
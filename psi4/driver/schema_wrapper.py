@@ -32,6 +32,8 @@ Runs a JSON input psi file.
 __all__ = [
     "run_json",
     "run_qcschema",
+    "run_qcschema_batch",
+    "run_qcschema_worker",
 ]
 
 import atexit
@@ -40,13 +42,15 @@ import datetime
 import json
 import os
 import pprint
+import subprocess
 import sys
 import traceback
 import uuid
 import warnings
 from collections import defaultdict
+from concurrent.futures import ThreadPoolExecutor
 from pathlib import Path
-from typing import Any, Dict, Union
+from typing import Any, Dict, List, TextIO, Union
 
 import numpy as np
 import qcelemental as qcel
@@ -488,6 +492,186 @@ def run_qcschema(
     return ret
 
 
+def run_qcschema_worker(instream: TextIO, outstream: TextIO, clean: bool = True) -> int:
+    """Serve many QCSchema jobs from one |PSIfour| process, avoiding the interpreter and
+    module startup for each of them.
+
+    Reads one :py:class:`qcelemental.models.AtomicInput` per line of **instream** as JSON
+    and writes the :py:class:`qcelemental.models.AtomicResult` or
+    :py:class:`qcelemental.models.FailedOperation` of each job as one line of JSON to
+    **outstream**, in input order. Blank lines are skipped; the worker returns at the end
+    of **instream**.
+
+    Parameters
+    ----------
+    instream
+        Stream of newline-delimited AtomicInput JSON, e.g. ``sys.stdin``.
+    outstream
+        Stream receiving one result per line, e.g. ``sys.stdout``.
+    clean
+        Reset global QCVariables, options, and scratch files between jobs.
+
+    Returns
+    -------
+    int
+        Number of jobs processed.
+
+    """
+    njobs = 0
+    for line in instream:
+        line = line.strip()
+        if not line:
+            continue
+
+        try:
+            data = qcel.util.deserialize(line, "json-ext")
+        except Exception as exc:
+            data = None
+            ret = qcel.models.FailedOperation(input_data=line,
+                                              success=False,
+                                              error={
+                                                  'error_type': 'input_error',
+                                                  'error_message': f"Could not parse QCSchema input: {exc}",
+                                              })
+
+        if data is not None:
+            ret = run_qcschema(data, clean=clean, postclean=False)
+
+            # run_qcschema closed the job output, which is absorbed into ret; remove it now rather than at exit
+            outfile = core.get_output_file()
+            core.be_quiet()
+            _quiet_remove(outfile)
+
+        outstream.write(ret.serialize("json") + "\n")
+        outstream.flush()
+        njobs += 1
+
+    return njobs
+
+
+def _batch_job_cost(input_model: qcel.models.AtomicInput) -> float:
+    """Relative cost of a batch job: cube of the number of electrons of the real atoms."""
+    mol = input_model.molecule
+    real = mol.real if mol.real is not None else [True] * len(mol.symbols)
+    nel = sum(Z for Z, r in zip(mol.atomic_numbers, real) if r) - mol.molecular_charge
+    return float(max(nel, 1))**3
+
+
+def _pack_batch(costs: List[float], elements: List[frozenset], nworkers: int) -> List[List[int]]:
+    """Assign jobs to workers, largest first to the least loaded worker (LPT).
+    Among workers that are about as idle, one already holding a job on the same
+    elements is preferred, so that it reuses its basis-set cache."""
+    loads = [0.0] * nworkers
+    held = [set() for _ in range(nworkers)]
+    assignment = [[] for _ in range(nworkers)]
+    for job in sorted(range(len(costs)), key=lambda j: costs[j], reverse=True):
+        least = min(loads)
+        candidates = [w for w in range(nworkers) if loads[w] - least <= costs[job]]
+        worker = min(candidates, key=lambda w: (elements[job] not in held[w], loads[w]))
+        assignment[worker].append(job)
+        loads[worker] += costs[job]
+        held[worker].add(elements[job])
+    return assignment
+
+
+def run_qcschema_batch(
+    inputs: List[Union[Dict[str, Any], qcel.models.AtomicInput]],
+    nworkers: int = None,
+    clean: bool = True,
+) -> List[Union[qcel.models.AtomicResult, qcel.models.FailedOperation]]:
+    """Run many independent QCSchema jobs concurrently, sharing out the threads and memory of
+    this |PSIfour| session among **nworkers** worker processes.
+
+    Jobs are packed onto the workers by estimated cost, largest first, so that small
+    molecules backfill the idle workers; jobs on the same elements are kept together
+    where the load allows. Each worker is one persistent ``psi4 --qcschema-worker``
+    process, so the startup cost is paid once per worker rather than per job. Falls
+    back to running the jobs one at a time in this process when no ``psi4``
+    executable is on the path.
+
+    Parameters
+    ----------
+    inputs
+        Quantum chemistry jobs in either AtomicInput class or dictionary form.
+    nworkers
+        Number of concurrent worker processes. Defaults to one per thread of this
+        session (:py:func:`psi4.core.get_num_threads`), capped at the number of jobs.
+    clean
+        Reset global QCVariables, options, and scratch files between jobs.
+
+    Returns
+    -------
+    list
+        The AtomicResult or FailedOperation of each job, in input order.
+
+    """
+    models = []
+    for data in inputs:
+        try:
+            models.append(qcng.util.model_wrapper(data, qcel.models.AtomicInput))
+        except Exception as exc:
+            models.append(qcel.models.FailedOperation(input_data=data,
+                                                      success=False,
+                                                      error={
+                                                          'error_type': 'input_error',
+                                                          'error_message': str(exc),
+                                                      }))
+    results = [m if isinstance(m, qcel.models.FailedOperation) else None for m in models]
+    jobs = [j for j, m in enumerate(models) if results[j] is None]
+
+    nthread = core.get_num_threads()
+    if nworkers is None:
+        nworkers = nthread
+    nworkers = max(1, min(nworkers, len(jobs)))
+
+    executable = qcel.util.which("psi4", return_bool=False)
+    if nworkers < 2 or executable is None:
+        for j in jobs:
+            results[j] = run_qcschema(models[j], clean=clean, postclean=False)
+        return results
+
+    costs = [_batch_job_cost(models[j]) for j in jobs]
+    elements = [frozenset(models[j].molecule.symbols) for j in jobs]
+    assignment = [[jobs[k] for k in worker] for worker in _pack_batch(costs, elements, nworkers)]
+
+    # Threads beyond an even split go to the most loaded workers
+    loads = [sum(_batch_job_cost(models[j]) for j in worker) for worker in assignment]
+    threads = [max(1, nthread // nworkers)] * nworkers
+    for w in sorted(range(nworkers), key=lambda w: loads[w], reverse=True)[:max(0, nthread - nworkers * threads[0])]:
+        threads[w] += 1
+    memory = f"{core.get_memory() // nworkers // 1000} kB"
+
+    env = os.environ.copy()
+    env["PSI_SCRATCH"] = core.IOManager.shared_object().get_default_path()
+
+    def serve(worker):
+        command = [executable, "--qcschema-worker", "--nthread", str(threads[worker]), "--memory", memory]
+        if not clean:
+            command.append("--messy")
+        stdin = "".join(models[j].json() + "\n" for j in assignment[worker])
+        proc = subprocess.run(command, input=stdin, capture_output=True, text=True, env=env)
+
+        # Anything but one JSON object per line is not ours
+        returned = [json.loads(line) for line in proc.stdout.splitlines() if line.startswith("{")]
+        for k, j in enumerate(assignment[worker]):
+            if k < len(returned):
+                data = returned[k]
+                model = qcel.models.AtomicResult if data.get("success", False) else qcel.models.FailedOperation
+                results[j] = model(**data)
+            else:
+                results[j] = qcel.models.FailedOperation(input_data=models[j],
+                                                         success=False,
+                                                         error={
+                                                             'error_type': 'unknown_error',
+                                                             'error_message': f"QCSchema worker exited with code {proc.returncode}:\n{proc.stderr}",
+                                                         })
+
+    with ThreadPoolExecutor(max_workers=nworkers) as pool:
+        list(pool.map(serve, range(nworkers)))
+
+    return results
+
+
 def run_json(json_data: Dict[str, Any], clean: bool = True) -> Dict[str, Any]:
 
     warnings.warn(
@@ -35,7 +35,8 @@ __all__ = [
 import abc
 import copy
 import logging
-from typing import TYPE_CHECKING, Any, Dict, Optional, Tuple, Union
+from concurrent.futures import ThreadPoolExecutor
+from typing import TYPE_CHECKING, Any, Dict, List, Optional, Tuple, Union
 
 try:
     from pydantic.v1 import Field, validator
@@ -104,8 +105,9 @@ class AtomicComputer(BaseComputer):
     def set_keywords(cls, keywords):
         return copy.deepcopy(keywords)
 
-    def plan(self) -> AtomicInput:
-        """Form QCSchema input from member data."""
+    def plan(self, psiapi: bool = True) -> AtomicInput:
+        """Form QCSchema input from member data. With `psiapi` False, QCEngine runs the
+        job as a separate ``psi4 --qcschema`` process rather than in this interpreter."""
 
         atomic_model = AtomicInput(**{
             "molecule": self.molecule.to_schema(dtype=2),
@@ -119,7 +121,7 @@ class AtomicComputer(BaseComputer):
                 "stdout": True,
             },
             "extras": {
-                "psiapi": True,
+                "psiapi": psiapi,
                 "wfn_qcvars_only": True,
             },
         })
@@ -260,6 +262,54 @@ class AtomicComputer(BaseComputer):
             return self.result
 
 
+def compute_concurrently(computers: List[AtomicComputer], nworkers: int) -> None:
+    """Run independent single-points `nworkers` at a time, each in its own Psi4 process.
+
+    The Psi4 core is a per-process singleton, so concurrency comes from QCEngine's
+    subprocess mode, with threads and memory of the parent split evenly among the
+    workers. Tasks are launched largest first (atom count, ghosts included, as a
+    proxy for basis size) so that small fragments backfill the idle workers at the
+    end. Output is collected in the calling thread in the original task order.
+    Falls back to leaving the tasks for serial execution when no ``psi4``
+    executable is on the path.
+
+    """
+    from psi4.driver import pp
+
+    pending = [c for c in computers if not c.computed]
+    if nworkers < 2 or len(pending) < 2:
+        return
+
+    if not qcng.get_program("psi4").found(raise_error=False):
+        logger.warning("Concurrent tasks need a psi4 executable in PATH; running serially.")
+        return
+
+    nworkers = min(nworkers, len(pending))
+    ncores = max(1, core.get_num_threads() // nworkers)
+    # B -> GiB
+    memory = core.get_memory() / nworkers / (2 ** 30)
+
+    def launch(computer):
+        logger.info(f'<<< JSON launch ... {computer.molecule.schoenflies_symbol()} {computer.molecule.nuclear_repulsion_energy()} (subprocess)')
+        return qcng.compute(computer.plan(psiapi=False),
+                            "psi4",
+                            raise_error=True,
+                            task_config={
+                                "memory": memory,
+                                "ncores": ncores,
+                            })
+
+    by_cost = sorted(pending, key=lambda c: c.molecule.natom(), reverse=True)
+    with ThreadPoolExecutor(max_workers=nworkers) as pool:
+        futures = {id(c): pool.submit(launch, c) for c in by_cost}
+
+    for computer in pending:
+        computer.result = futures[id(computer)].result()
+        logger.debug(pp.pformat(computer.result.dict()))
+        core.print_out(_drink_filter(computer.result.dict()["stdout"]))
+        computer.computed = True
+
+
 def _singlepointrecord_to_atomicresult(spr: "qcportal.singlepoint.SinglepointRecord") -> AtomicResult:
     atres = spr.to_qcschema_result()
 
@@ -75,6 +75,8 @@ parser.add_argument("-k", "--skip-preprocessor", action='store_true',
                     help="Skips input preprocessing. !Warning! expert option.")
 parser.add_argument("--qcschema", "--schema", action='store_true',
                     help="Runs input file as QCSchema. Can either be JSON or MessagePack input. Use `--output` to not overwrite schema input file.")
+parser.add_argument("--qcschema-worker", action='store_true',
+                    help="Keeps one process running QCSchema jobs: reads one AtomicInput JSON per line from stdin and writes one result JSON per line to stdout.")
 parser.add_argument("--json", action='store_true',
                     help="Runs a JSON input file. !Warning! depcrated option in 1.4, use --qcschema instead.")
 parser.add_argument("-t", "--test", nargs='?', const='smoke', default=None,
@@ -168,7 +170,7 @@ if len(unknown) > 2:
     raise KeyError(f"Too many unknown arguments: {unknown}")
 
 # Figure out output arg
-if (args["output"] is None) and (args["qcschema"] is False):
+if (args["output"] is None) and (args["qcschema"] is False) and (args["qcschema_worker"] is False):
     if args["input"] == "input.dat":
         args["output"] = "output.dat"
     else:
@@ -264,7 +266,7 @@ if args["append"] is None:
     args["append"] = False
 if args["inherit_loglevel"] is None:
     args["inherit_loglevel"] = False
-if args["qcschema"] is False:
+if (args["qcschema"] is False) and (args["qcschema_worker"] is False):
     psi4.set_output_file(
         args["output"],
         args["append"],
@@ -327,6 +329,18 @@ if args["qcschema"]:
 
     sys.exit()
 
+if args["qcschema_worker"]:
+    psi4.extras._success_flag_ = True
+    clean = True
+    if args["messy"]:
+        clean = False
+        for func in _clean_functions:
+            atexit.unregister(func)
+
+    psi4.schema_wrapper.run_qcschema_worker(sys.stdin, sys.stdout, clean=clean)
+
+    sys.exit()
+
 if args["json"]:
 
     with open(args["input"], 'r') as f:
@@ -40,6 +40,8 @@
 
 #include "psi4/cc/cclambda/cclambda.h"
 #include "psi4/cc/ccwave.h"
+#include "psi4/lib3index/dfcache.h"
+#include "psi4/libmints/blockpool.h"
 #include "psi4/libmints/matrix.h"
 #include "psi4/libmints/matrix.h"
 #include "psi4/libmints/molecule.h"
@@ -176,6 +178,7 @@ SharedWavefunction detci(SharedWavefunction, Options&);
 }
 namespace dfmp2 {
 SharedWavefunction dfmp2(SharedWavefunction, Options&);
+SharedWavefunction dfmp2_f12(SharedWavefunction, Options&);
 }
 namespace dlpno {
 SharedWavefunction dlpno(SharedWavefunction, Options&);
@@ -188,6 +191,7 @@ SharedWavefunction libfock(SharedWavefunction, Options&);
 }
 namespace fnocc {
 SharedWavefunction fnocc(SharedWavefunction, Options&);
+SharedWavefunction fno_wavefunction(SharedWavefunction, Options&);
 }
 namespace occwave {
 SharedWavefunction occwave(SharedWavefunction, Options&);
@@ -353,6 +357,11 @@ SharedWavefunction py_psi_dfmp2(SharedWavefunction ref_wfn) {
     return dfmp2::dfmp2(ref_wfn, Process::environment.options);
 }
 
+SharedWavefunction py_psi_dfmp2_f12(SharedWavefunction ref_wfn) {
+    py_psi_prepare_options_for_module("DFMP2");
+    return dfmp2::dfmp2_f12(ref_wfn, Process::environment.options);
+}
+
 SharedWavefunction py_psi_dlpno(SharedWavefunction ref_wfn) {
     py_psi_prepare_options_for_module("DLPNO");
     return dlpno::dlpno(ref_wfn, Process::environment.options);
@@ -392,6 +401,11 @@ SharedWavefunction py_psi_fnocc(SharedWavefunction ref_wfn) {
     return fnocc::fnocc(ref_wfn, Process::environment.options);
 }
 
+SharedWavefunction py_psi_fno_wavefunction(SharedWavefunction ref_wfn) {
+    py_psi_prepare_options_for_module("FNOCC");
+    return fnocc::fno_wavefunction(ref_wfn, Process::environment.options);
+}
+
 SharedWavefunction py_psi_detci(SharedWavefunction ref_wfn) {
     py_psi_prepare_options_for_module("DETCI");
     return detci::detci(ref_wfn, Process::environment.options);
@@ -492,7 +506,11 @@ SharedWavefunction py_psi_psimrcc(SharedWavefunction ref_wfn) {
     return psimrcc::psimrcc(ref_wfn, Process::environment.options);
 }
 
-void py_psi_clean() { PSIOManager::shared_object()->psiclean(); }
+void py_psi_clean() {
+    PSIOManager::shared_object()->psiclean();
+    DFIntegralCache::instance().clear();
+    BlockPool::shared().trim();
+}
 
 void py_psi_print_options() { Process::environment.options.print(); }
 
@@ -1302,6 +1320,7 @@ PYBIND11_MODULE(core, core) {
     core.def("scfhess", py_psi_scfhess, "ref_wfn"_a, "Run scfhess, which is a specialized DF-SCF hessian program.");
     core.def("dct", py_psi_dct, "ref_wfn"_a, "Runs the density cumulant (functional) theory code.");
     core.def("dfmp2", py_psi_dfmp2, "ref_wfn"_a, "Runs the DF-MP2 code.");
+    core.def("dfmp2_f12", py_psi_dfmp2_f12, "ref_wfn"_a, "Runs the DF-MP2-F12/3C(FIX) code.");
     core.def("dlpno", py_psi_dlpno, "Runs the DLPNO codes.");
     core.def("mcscf", py_psi_mcscf, "Runs the MCSCF code, (N.B. restricted to certain active spaces).");
     core.def("mrcc_generate_input", py_psi_mrcc_generate_input, "Generates an input for Kallay's MRCC code.");
@@ -1316,6 +1335,8 @@ PYBIND11_MODULE(core, core) {
     core.def("detci", py_psi_detci, "ref_wfn"_a, "Runs the determinant-based configuration interaction code.");
     core.def("dmrg", py_psi_dmrg, "ref_wfn"_a, "Runs the CheMPS2 interface DMRG code.");
     core.def("fnocc", py_psi_fnocc, "ref_wfn"_a, "Runs the FNO-CCSD(T)/QCISD(T)/MP4/CEPA energy code");
+    core.def("fno_wavefunction", py_psi_fno_wavefunction, "ref_wfn"_a,
+             "Truncates the virtual space of an RHF reference to DF-MP2 frozen natural orbitals");
     core.def("cchbar", py_psi_cchbar, "ref_wfn"_a, "Runs the code to generate the similarity transformed Hamiltonian.");
     core.def("cclambda", py_psi_cclambda, "ref_wfn"_a, "Runs the coupled cluster lambda equations code.");
     core.def("ccdensity", py_psi_ccdensity, "ref_wfn"_a, "Runs the code to compute coupled cluster density matrices.");
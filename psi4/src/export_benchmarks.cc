@@ -26,6 +26,7 @@
  * @END LICENSE
  */
 
+#include "psi4/libmints/basisset.h"
 #include "psi4/libmints/benchmark.h"
 #include "psi4/pybind11.h"
 
@@ -40,9 +41,15 @@ using namespace pybind11::literals;
     m.def("benchmark_blas3", &psi::benchmark_blas3, "max_dim"_a, "min_time"_a, "nthread"_a = 1,
           "Perform benchmark traverse of BLAS 3 routines. Use up to *max_dim* with each routine run at least *min_time* [s] on *nthread*.");
     m.def("benchmark_disk", &psi::benchmark_disk, "max_dim"_a, "min_time"_a,
-          "Perform benchmark of PSIO disk performance. Use up to *max_dim* with each routine run at least *min_time* [s].");
+          "Perform benchmark of PSIO disk performance. Use up to *max_dim* with each routine run at least *min_time* [s]. "
+          "Returns bytes per second keyed by operation and dimension.");
     m.def("benchmark_math", &psi::benchmark_math, "min_time"_a,
           "Perform benchmark of common double floating point operations including most of cmath. For each routine run at least *min_time* [s].");
     m.def("benchmark_integrals", &psi::benchmark_integrals, "max_am"_a, "min_time"_a,
           "Perform benchmark of psi integrals (of libmints type). Benchmark integrals called from different centers. For up to *max_am* with each shell combination run at least *min_time* [s].");
+    m.def("benchmark_integral_engines", &psi::benchmark_integral_engines, "basis"_a, "aux"_a = py::none(),
+          "min_time"_a = 0.1, "nthread"_a = 1,
+          "Benchmark the integral engines on *basis* (and *aux* for three-center ERIs) per angular momentum class, run "
+          "each class at least *min_time* [s], and measure ERI thread scaling up to *nthread*. Returns integrals per "
+          "second keyed by type and class.");
 }
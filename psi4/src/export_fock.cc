@@ -33,6 +33,8 @@
 #include "psi4/lib3index/denominator.h"
 #include "psi4/lib3index/dftensor.h"
 #include "psi4/lib3index/dfhelper.h"
+#include "psi4/lib3index/isdf.h"
+#include "psi4/libfock/cubature.h"
 #include "psi4/libmints/molecule.h"
 #include "psi4/libmints/matrix.h"
 #include "psi4/libmints/vector.h"
@@ -46,6 +48,26 @@ namespace py = pybind11;
 using namespace pybind11::literals;
 
 void export_fock(py::module &m) {
+    py::class_<JKStats>(m, "JKStats", "Performance counters of a single JK compute call")
+        .def_readonly("shells_computed", &JKStats::shells_computed, "Number of ERI shell n-lets computed")
+        .def_readonly("shells_screened", &JKStats::shells_screened, "Number of ERI shell n-lets skipped by screening")
+        .def_readonly("total_time", &JKStats::total_time, "Wall time of the compute call [s]")
+        .def_readonly("integral_time", &JKStats::integral_time, "Wall time spent computing integrals [s]")
+        .def_readonly("contraction_time", &JKStats::contraction_time, "Wall time spent contracting integrals with densities [s]")
+        .def_readonly("disk_bytes_read", &JKStats::disk_bytes_read, "Integral data read from disk [bytes]")
+        .def_readonly("gemm_flops", &JKStats::gemm_flops, "Floating point operations issued through BLAS")
+        .def_readonly("peak_scratch_bytes", &JKStats::peak_scratch_bytes, "Largest work buffer footprint [bytes]")
+        .def("__repr__", [](const JKStats& s) {
+            return "JKStats(shells_computed=" + std::to_string(s.shells_computed) +
+                   ", shells_screened=" + std::to_string(s.shells_screened) +
+                   ", total_time=" + std::to_string(s.total_time) +
+                   ", integral_time=" + std::to_string(s.integral_time) +
+                   ", contraction_time=" + std::to_string(s.contraction_time) +
+                   ", disk_bytes_read=" + std::to_string(s.disk_bytes_read) +
+                   ", gemm_flops=" + std::to_string(s.gemm_flops) +
+                   ", peak_scratch_bytes=" + std::to_string(s.peak_scratch_bytes) + ")";
+        });
+
     py::class_<JK, std::shared_ptr<JK>>(m, "JK", "docstring")
         .def_static("build_JK",
                     [](std::shared_ptr<BasisSet> basis, std::shared_ptr<BasisSet> aux) {
@@ -55,6 +77,13 @@ void export_fock(py::module &m) {
                     [](std::shared_ptr<BasisSet> basis, std::shared_ptr<BasisSet> aux, bool do_wK, size_t doubles) {
                         return JK::build_JK(basis, aux, Process::environment.options, do_wK, doubles);
                     })
+        .def_static(
+            "select_JK_type",
+            [](std::shared_ptr<BasisSet> basis, bool do_wK, size_t doubles) {
+                return JK::select_JK_type(basis, Process::environment.options, do_wK, doubles);
+            },
+            "basis"_a, "do_wK"_a, "doubles"_a,
+            "SCF_TYPE that SCF_TYPE AUTO selects for *basis* with *doubles* of memory.")
         .def("name", &JK::name)
         .def("memory_estimate", &JK::memory_estimate)
         .def("initialize", &JK::initialize)
@@ -76,6 +105,8 @@ void export_fock(py::module &m) {
         .def("get_omega_beta", &JK::get_omega_beta, "Weight for dampened exchange term in range-separated DFT")
         .def("set_early_screening", &JK::set_early_screening, "Use severe screening techniques? Useful in early SCF iterations.", "early_screening"_a)
         .def("get_early_screening", &JK::get_early_screening, "Use severe screening techniques? Useful in early SCF iterations.")
+        .def("set_low_precision", &JK::set_low_precision, "Use single precision kernels where supported? Useful in early SCF iterations.", "low_precision"_a)
+        .def("get_low_precision", &JK::get_low_precision, "Use single precision kernels where supported? Useful in early SCF iterations.")
         .def("compute", &JK::compute)
         .def("finalize", &JK::finalize)
         .def("C_clear",
@@ -96,6 +127,9 @@ void export_fock(py::module &m) {
         .def("D", &JK::D, py::return_value_policy::reference_internal)
         .def("computed_shells_per_iter", py::overload_cast<>(&JK::computed_shells_per_iter), "Array containing the number of ERI shell n-lets (triplets, quartets) computed (not screened out) during each compute call.")
         .def("computed_shells_per_iter", py::overload_cast<const std::string&>(&JK::computed_shells_per_iter), "Array containing the number of ERI shell n-lets (triplets, quartets) computed (not screened out) during each compute call.")
+        .def("stats", &JK::stats, py::return_value_policy::copy, "Performance counters of the last compute call.")
+        .def("stats_per_iter", &JK::stats_per_iter, py::return_value_policy::copy, "Performance counters of every compute call since the last clear_stats.")
+        .def("clear_stats", &JK::clear_stats, "Clears the accumulated performance counters.")
         .def("print_header", &JK::print_header, "docstring");
 
     py::class_<LaplaceDenominator, std::shared_ptr<LaplaceDenominator>>(m, "LaplaceDenominator", "Computer class for a Laplace factorization of the four-index energy denominator in MP2 and coupled-cluster")
@@ -132,6 +166,9 @@ void export_fock(py::module &m) {
         .def("form_eig_inverse", &FittingMetric::form_eig_inverse, "docstring")
         .def("form_full_inverse", &FittingMetric::form_full_inverse, "docstring");
 
+    typedef SharedMatrix (SOMCSCF::*hk_single)(SharedMatrix);
+    typedef std::vector<SharedMatrix> (SOMCSCF::*hk_batch)(const std::vector<SharedMatrix>&);
+
     py::class_<SOMCSCF, std::shared_ptr<SOMCSCF>>(m, "SOMCSCF", "docstring")
         // .def(init<std::shared_ptr<JK>, SharedMatrix, SharedMatrix >())
         .def("Ck", &SOMCSCF::Ck)
@@ -141,7 +178,10 @@ void export_fock(py::module &m) {
         .def("approx_solve", &SOMCSCF::approx_solve)
         .def("solve", &SOMCSCF::solve)
         .def("H_approx_diag", &SOMCSCF::H_approx_diag)
-        .def("compute_Hk", &SOMCSCF::Hk)
+        .def("compute_Hk", hk_single(&SOMCSCF::Hk))
+        .def("compute_Hk", hk_batch(&SOMCSCF::Hk), "Hessian times several trial vectors with a single JK call")
+        .def("set_approx_jk", &SOMCSCF::set_approx_jk)
+        .def("set_approx_hk", &SOMCSCF::set_approx_hk)
         .def("compute_Q", &SOMCSCF::compute_Q)
         .def("compute_Qk", &SOMCSCF::compute_Qk)
         .def("compute_AFock", &SOMCSCF::compute_AFock)
@@ -178,6 +218,15 @@ void export_fock(py::module &m) {
         .def("get_AO_core", &DFHelper::get_AO_core)
         .def("set_MO_core", &DFHelper::set_MO_core)
         .def("get_MO_core", &DFHelper::get_MO_core)
+        .def("set_disk_mmap", &DFHelper::set_disk_mmap)
+        .def("get_disk_mmap", &DFHelper::get_disk_mmap)
+        .def("set_overlap_io", &DFHelper::set_overlap_io)
+        .def("get_overlap_io", &DFHelper::get_overlap_io)
+        .def("set_disk_compress", &DFHelper::set_disk_compress)
+        .def("get_disk_compress", &DFHelper::get_disk_compress)
+        .def("set_aux_rank_tolerance", &DFHelper::set_aux_rank_tolerance)
+        .def("get_aux_rank_tolerance", &DFHelper::get_aux_rank_tolerance)
+        .def("get_naux", &DFHelper::get_naux)
         .def("add_space", &DFHelper::add_space)
         .def("initialize", &DFHelper::initialize)
         .def("print_header", &DFHelper::print_header)
@@ -192,8 +241,26 @@ void export_fock(py::module &m) {
         .def("get_tensor", take_string(&DFHelper::get_tensor))
         .def("get_tensor", tensor_access3(&DFHelper::get_tensor));
 
+    py::class_<ISDF, std::shared_ptr<ISDF>>(m, "ISDF", "Interpolative separable density fitting of the DF integrals")
+        .def(py::init<std::shared_ptr<BasisSet>, std::shared_ptr<BasisSet>, std::shared_ptr<DFTGrid>>())
+        .def("set_tolerance", &ISDF::set_tolerance, "Pivot tolerance, relative to the largest grid diagonal")
+        .def("set_condition", &ISDF::set_condition, "Relative condition cutoff for the metric inverses")
+        .def("set_memory", &ISDF::set_memory, "Memory in doubles for the point selection")
+        .def("set_nthreads", &ISDF::set_nthreads)
+        .def("set_print", &ISDF::set_print)
+        .def("compute", &ISDF::compute, "Select the interpolation points and fit the factors")
+        .def("npoints", &ISDF::npoints, "Number of interpolation points")
+        .def("points", &ISDF::points, "Grid indices (in block order) of the interpolation points")
+        .def("X", &ISDF::X, "Basis functions at the interpolation points, nbf x npoints")
+        .def("Y", &ISDF::Y, "J^-1/2-fitted factor, naux x npoints, so (Q|mn) ~ sum_P Y_QP X_mP X_nP")
+        .def("Z", &ISDF::Z, "THC core Y^T Y, npoints x npoints");
+
     py::class_<MemDFJK, std::shared_ptr<MemDFJK>, JK>(m, "MemDFJK", "docstring")
-        .def("dfh", &MemDFJK::dfh, "Return the DFHelper object.");
+        .def("dfh", &MemDFJK::dfh, "Return the DFHelper object.")
+        .def("do_incfock_iter", &MemDFJK::do_incfock_iter, "Was the last Fock build incremental?");
+
+    py::class_<DiskDFJK, std::shared_ptr<DiskDFJK>, JK>(m, "DiskDFJK", "docstring")
+        .def("do_incfock_iter", &DiskDFJK::do_incfock_iter, "Was the last Fock build incremental?");
 
     py::class_<DirectJK, std::shared_ptr<DirectJK>, JK>(m, "DirectJK", "docstring")
         .def("do_incfock_iter", &DirectJK::do_incfock_iter, "Was the last Fock build incremental?");
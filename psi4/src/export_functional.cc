@@ -234,6 +234,8 @@ void export_functional(py::module &m) {
 
     py::class_<MolecularGrid, std::shared_ptr<MolecularGrid>>(m, "MolecularGrid", "docstring")
         .def("print", &MolecularGrid::print, "Prints grid information.")
+        .def("print_details", &MolecularGrid::print_details, "out_fname"_a = "outfile", "print"_a = 2,
+             "Prints the radial and spherical grids of each atom.")
         .def("orientation", &MolecularGrid::orientation, "Returns the orientation of the grid.")
         .def("npoints", &MolecularGrid::npoints, "Returns the number of grid points.")
         .def("max_points", &MolecularGrid::max_points, "Returns the maximum number of points in a block.")
@@ -269,6 +271,17 @@ void export_functional(py::module &m) {
         .def("build_collocation_cache", &VBase::build_collocation_cache,
              "Constructs a collocation cache to prevent recomputation.")
         .def("clear_collocation_cache", &VBase::clear_collocation_cache, "Clears the collocation cache.")
+        .def("set_collocation_deriv", &VBase::set_collocation_deriv, "deriv"_a,
+             "Sets the derivative order a following gradient or Hessian needs from the collocation cache, -1 for none.")
+        .def("collocation_deriv", &VBase::collocation_deriv,
+             "Derivative order a following gradient or Hessian needs from the collocation cache.")
+        .def("profile_grid", &VBase::profile_grid, "grid"_a,
+             "Integrates the current density and functional per atom on an ATOMIC-blocked grid.")
+        .def("set_block_screening", &VBase::set_block_screening, "Enables or disables density screening of grid blocks.")
+        .def("block_screening", &VBase::block_screening, "Is density screening of grid blocks active?")
+        .def("set_incremental_xc", &VBase::set_incremental_xc,
+             "Enables or disables reuse of the stored XC contributions of grid blocks whose density has settled.")
+        .def("incremental_xc", &VBase::incremental_xc, "Are stored XC contributions of grid blocks reused?")
         .def("set_D", &VBase::set_D, "Sets the internal density.")
         .def("Dao", &VBase::set_D, "Returns internal AO density.")
         .def("compute_V", &VBase::compute_V, "doctsring")
@@ -324,6 +337,8 @@ void export_functional(py::module &m) {
              "Projects a density from the primary AO to auxiliary AO space.")
         .def("form_unc_amplitude", &sapt::FDDS_Dispersion::form_unc_amplitude,
              "Forms the uncoupled amplitudes for either monomer.")
+        .def("form_unc_amplitudes", &sapt::FDDS_Dispersion::form_unc_amplitudes,
+             "Forms the uncoupled amplitudes for either monomer at a batch of frequencies.")
         .def("get_tensor_pqQ", &sapt::FDDS_Dispersion::get_tensor_pqQ,
              "Debug only: fetches 3-index intermediate from disk and return as matrix.")
         .def("print_tensor_pqQ", &sapt::FDDS_Dispersion::print_tensor_pqQ,
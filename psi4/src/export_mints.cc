@@ -474,6 +474,12 @@ void export_mints(py::module& m) {
         .value("Descending", descending)
         .export_values();
 
+    py::enum_<diagonalize_algorithm>(m, "DiagonalizeAlgorithm", "Defines the LAPACK eigensolver used by diagonalization")
+        .value("DSYEV", diag_dsyev)
+        .value("DSYEVD", diag_dsyevd)
+        .value("DSYEVR", diag_dsyevr)
+        .export_values();
+
     py::enum_<Molecule::GeometryUnits>(m, "GeometryUnits", "The units used to define the geometry")
         .value("Angstrom", Molecule::Angstrom)
         .value("Bohr", Molecule::Bohr)
@@ -486,7 +492,8 @@ void export_mints(py::module& m) {
         .export_values();
 
     typedef void (Matrix::*matrix_multiply)(bool, bool, double, const SharedMatrix&, const SharedMatrix&, double);
-    typedef void (Matrix::*matrix_diagonalize)(SharedMatrix&, std::shared_ptr<Vector>&, diagonalize_order);
+    typedef void (Matrix::*matrix_diagonalize)(SharedMatrix&, std::shared_ptr<Vector>&, diagonalize_order,
+                                               diagonalize_algorithm);
     typedef void (Matrix::*matrix_one)(const SharedMatrix&);
     typedef double (Matrix::*double_matrix_one)(const SharedMatrix&);
     typedef void (Matrix::*matrix_two)(const SharedMatrix&, const SharedMatrix&);
@@ -495,6 +502,7 @@ void export_mints(py::module& m) {
     typedef void (Matrix::*matrix_set1)(double);
     typedef void (Matrix::*matrix_set3)(int, int, double);
     typedef void (Matrix::*matrix_set4)(int, int, int, double);
+    typedef void (Matrix::*matrix_axpby)(double, const SharedMatrix&, double);
     typedef double (Matrix::*matrix_get3)(const int&, const int&, const int&) const;
     typedef double (Matrix::*matrix_get2)(const int&, const int&) const;
     typedef void (Matrix::*matrix_load)(const std::string&);
@@ -550,10 +558,14 @@ void export_mints(py::module& m) {
         .def("transpose_this", &Matrix::transpose_this, "Transpose the matrix in-place")
         .def("transpose", &Matrix::transpose, "Creates a new matrix that is the transpose of this matrix")
         .def("hermitivitize", &Matrix::hermitivitize, "Average off-diagonal element in-place")
+        .def("antisymmetrize", &Matrix::antisymmetrize, "Replace by M - M^T in-place")
         .def("add", matrix_one(&Matrix::add), "Adds a matrix to this matrix")
         .def("add", matrix_set4(&Matrix::add), "Increments row m and column n of irrep h's block matrix by val.", "h"_a,
              "m"_a, "n"_a, "val"_a)
         .def("axpy", &Matrix::axpy, "Add to this matrix another matrix scaled by a", "a"_a, "X"_a)
+        .def("axpby", matrix_axpby(&Matrix::axpby),
+             "Scale this matrix by b and add another matrix scaled by a in one pass; self <- a * X + b * self", "a"_a,
+             "X"_a, "b"_a)
         .def("subtract", matrix_one(&Matrix::subtract), "Substract a matrix from this matrix")
         .def("accumulate_product", matrix_two(&Matrix::accumulate_product),
              "Multiplies two arguments and adds the result to this matrix")
@@ -588,7 +600,15 @@ void export_mints(py::module& m) {
         .def("diagonalize", matrix_diagonalize(&Matrix::diagonalize),
              "Diagonalizes this matrix, space for the eigvectors and eigvalues must be created by caller. Only for "
              "symmetric matrices.",
-             "eigvectors"_a, "eigvalues"_a, "order"_a = ascending)
+             "eigvectors"_a, "eigvalues"_a, "order"_a = ascending, "algorithm"_a = diag_dsyev)
+        .def("diagonalize_lowest", &Matrix::diagonalize_lowest,
+             "Returns the (eigvectors, eigvalues) of the nroots lowest eigenpairs per irrep. Only for symmetric "
+             "matrices.",
+             "nroots"_a)
+        .def("diagonalize_range", &Matrix::diagonalize_range,
+             "Returns the (eigvectors, eigvalues) of all eigenpairs with eigenvalues in (vl, vu]. Only for symmetric "
+             "matrices.",
+             "vl"_a, "vu"_a)
         .def("cholesky_factorize", &Matrix::cholesky_factorize,
              "Computes the Cholesky factorization of a real symmetric positive definite matrix")
         .def(
@@ -1641,6 +1661,10 @@ void export_mints(py::module& m) {
         .def("addBasis", &ExternalPotential::addBasis, "Add a basis of S auxiliary functions iwth Df coefficients",
              "basis"_a, "coefs"_a)
         .def("clear", &ExternalPotential::clear, "Reset the field to zero (eliminates all entries)")
+        .def("set_far_field", &ExternalPotential::set_far_field,
+             "Replace distant cells of charges by their multipole expansion in computePotentialMatrix", "order"_a,
+             "box_length"_a = 10.0, "separation"_a = 4.0)
+        .def("unset_far_field", &ExternalPotential::unset_far_field, "Treat every charge exactly")
         .def("computePotentialMatrix", &ExternalPotential::computePotentialMatrix,
              "Compute the external potential matrix in the given basis set", "basis"_a)
         .def("computeNuclearEnergy", &ExternalPotential::computeNuclearEnergy,
@@ -29,6 +29,11 @@
 #include "psi4/pybind11.h"
 
 #include "psi4/libciomr/libciomr.h"
+#include "psi4/libmints/blockpool.h"
+#include "psi4/libpsi4util/huge_pages.h"
+#include "psi4/libpsi4util/memory_governor.h"
+#include "psi4/libpsi4util/PsiOutStream.h"
+#include "psi4/psi4-dec.h"
 #include "psi4/libqt/qt.h"
 
 using namespace psi;
@@ -41,4 +46,34 @@ void export_misc(py::module &m) {
     m.def("tstart", tstart, "Start module-level timer. Only one active at once.");
     m.def("tstop", tstop, "Stop module-level timer. Prints user, system, and total times to outfile.");
     m.def("clean_timers", clean_timers, "Reinitialize timers for independent ``timer.dat`` entries. Vital when earlier independent calc finished improperly.");
+    m.def("timer_trace_start", timer_trace_start,
+          "Start recording a per-thread event trace of all timers. Discards any previous trace.");
+    m.def("timer_trace_stop", timer_trace_stop, "Stop recording the timer event trace.");
+    m.def("timer_trace_events", timer_trace_events,
+          "Recorded timer trace as a list of (name, phase, thread, time [us], counter value) tuples. "
+          "Phase is 'B' (begin), 'E' (end) or 'C' (counter).");
+    m.def("timer_trace_dump", timer_trace_dump, "filename"_a,
+          "Write the timer trace to *filename* in Chrome trace event JSON format (chrome://tracing, Perfetto).");
+    m.def(
+        "get_memory_available", []() { return MemoryGovernor::instance().available(); },
+        "Returns the job memory (in bytes) not reserved by any module through the memory governor.");
+    m.def(
+        "print_memory_reservations", []() { MemoryGovernor::instance().print(outfile); },
+        "Prints the memory reservations held by modules to the output file.");
+    m.def("set_huge_page_threshold", set_huge_page_threshold, "bytes"_a,
+          "Back Matrix, DPD, DFHelper and other buffers of at least *bytes* with transparent huge pages "
+          "(madvise, Linux only; ignored where unavailable). 0, the default, disables huge pages.");
+    m.def("get_huge_page_threshold", huge_page_threshold,
+          "Returns the smallest buffer (in bytes) backed with transparent huge pages, 0 if disabled.");
+    m.def(
+        "set_block_pool_limit", [](size_t bytes) { return BlockPool::shared().set_limit(bytes); }, "bytes"_a,
+        "Keep up to *bytes* of freed Matrix and Vector storage for reuse. The limit is reserved with the memory "
+        "governor but not subtracted from the memory other modules size themselves from, so lower the job memory "
+        "to match. 0, the default, disables pooling. Returns the limit granted.");
+    m.def(
+        "get_block_pool_limit", []() { return BlockPool::shared().limit(); },
+        "Returns the most freed Matrix and Vector storage (in bytes) kept for reuse, 0 if pooling is disabled.");
+    m.def(
+        "get_block_pool_cached", []() { return BlockPool::shared().cached_bytes(); },
+        "Returns the freed Matrix and Vector storage (in bytes) currently kept for reuse.");
 }
@@ -59,6 +59,10 @@ void export_psio(py::module &m) {
         .def("tocscan", &PSIO::tocscan,
              "Seek string in binary file. This export is only good for catching None, as returned success object not "
              "exported.")
+        .def("filecfg_kwd",
+             py::overload_cast<const char*, const char*, int, const char*>(&PSIO::filecfg_kwd),
+             "Set a file configuration keyword (NAME, NVOLUME, VOLUMEn) for a unit, or for all units if unit is -1",
+             "kwdgrp"_a, "kwd"_a, "unit"_a, "kwdval"_a)
         .def("getpid", &PSIO::getpid, "Lookup process id")
         .def("set_pid", &PSIO::set_pid, "Set process id", "pid"_a)
         .def_static("shared_object", &PSIO::shared_object, "Return the global shared object")
@@ -93,5 +97,18 @@ void export_psio(py::module &m) {
         .def("get_file_path", &PSIOManager::get_file_path, "Get the path for a specific file number", "fileno"_a)
         .def("set_specific_retention", &PSIOManager::set_specific_retention,
              "Set the specific file number to be retained", "fileno"_a, "retain"_a)
+        .def("set_specific_memory", &PSIOManager::set_specific_memory,
+             "Hold the specific file number in memory instead of on disk", "fileno"_a, "in_memory"_a)
+        .def("get_specific_memory", &PSIOManager::get_specific_memory,
+             "Is the specific file number held in memory?", "fileno"_a)
+        .def("set_memory_limit", &PSIOManager::set_memory_limit,
+             "Cap the total bytes of in-memory files before they spill to disk (0 for no limit)", "bytes"_a)
+        .def("get_memory_limit", &PSIOManager::get_memory_limit, "Return the cap on in-memory files in bytes")
+        .def("set_io_tracing", &PSIOManager::set_io_tracing,
+             "Record PSIO traffic per file number and TOC entry; printed and cleared at each psiclean", "trace"_a)
+        .def("get_io_tracing", &PSIOManager::get_io_tracing, "Is PSIO traffic being recorded?")
+        .def("print_io_trace", &PSIOManager::print_io_trace,
+             "Print the recorded PSIO traffic: calls, bytes, bandwidth and latency per TOC entry", "out"_a = "outfile")
+        .def("reset_io_trace", &PSIOManager::reset_io_trace, "Forget the recorded PSIO traffic")
         .def("get_default_path", &PSIOManager::get_default_path, "Return the default path");
 }
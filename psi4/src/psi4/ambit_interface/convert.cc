@@ -62,6 +62,12 @@ void PSI_API convert(const psi::Matrix &matrix, ambit::Tensor *target) {
     size_t row = target->dim(0);
     size_t col = target->dim(1);
 
+    if (target->type() == CoreTensor) {
+        // Row-major core storage matches psi::Matrix, so copy straight in without a staging tensor
+        if (row && col) std::copy(matrix.pointer()[0], matrix.pointer()[0] + (row * col), target->data().begin());
+        return;
+    }
+
     Tensor local_tensor = Tensor::build(CoreTensor, "Local Data", {row, col});
 
     if (row && col) {
@@ -89,6 +95,11 @@ void PSI_API convert(const psi::Vector &vector, ambit::Tensor *target) {
 
     size_t row = target->dim(0);
 
+    if (target->type() == CoreTensor) {
+        std::copy(vector.pointer(), vector.pointer() + (row), target->data().begin());
+        return;
+    }
+
     Tensor local_tensor = Tensor::build(CoreTensor, "Local Data", {row});
 
     // copy data from SharedMatrix to local_tensor
@@ -30,7 +30,12 @@
 // Created by Justin Turney on 12/17/15.
 //
 
+#include <memory>
 #include <stdexcept>
+#include <vector>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 #include "integrals.h"
 #include <ambit/tensor.h>
@@ -115,75 +120,67 @@ void PSI_API integrals(psi::TwoBodyAOInt &integral, Tensor *target) {
     if (max_quartet.size() != target->rank())
         throw std::runtime_error("TwoBodyAOInt and Tensor do not have same rank.");
 
-    // Allocate local CoreTensor that can hold a quartets worth
-    // of integrals.
-    Tensor local_tensor = Tensor::build(CoreTensor, "Local Data", max_quartet);
-
-    IndexRange target_range(target->rank());
-    IndexRange local_range(target->rank());
+    // Row-major strides of the target for each of the four centers; a center
+    // with a single (dummy) function does not appear in the tensor.
+    std::vector<size_t> tensor_stride(target->rank(), 1L);
+    for (int i = static_cast<int>(target->rank()) - 2; i >= 0; i--) {
+        tensor_stride[i] = tensor_stride[i + 1] * target->dim(i + 1);
+    }
+    size_t stride[4];
+    for (int c = 0; c < 4; c++) {
+        stride[c] = (centers_dim[c] == -1 ? 0L : tensor_stride[centers_dim[c]]);
+    }
 
-    for (int i = 0; i < target->rank(); i++) {
-        target_range[i] = {0L, 0L};
-        local_range[i] = {0L, 0L};
+    // Per-thread integral objects; thread 0 uses the caller's
+    int nthread = 1;
+#ifdef _OPENMP
+    nthread = omp_get_max_threads();
+#endif
+    std::vector<std::unique_ptr<psi::TwoBodyAOInt>> clones;
+    std::vector<psi::TwoBodyAOInt *> eris(1, &integral);
+    for (int thread = 1; thread < nthread; thread++) {
+        clones.emplace_back(integral.clone());
+        eris.push_back(clones.back().get());
     }
 
-    const double *buffer = integral.buffer();
-    for (int P = 0; P < basis1.nshell(); P++) {
+    // Each (P,Q) shell pair owns a disjoint slab of the target, so the quartets
+    // are written straight into the tensor storage without a staging tensor.
+    std::vector<double> &data = target->data();
+    size_t nshellP = basis1.nshell();
+    size_t nshellQ = basis2.nshell();
+#pragma omp parallel for schedule(dynamic) num_threads(nthread)
+    for (size_t PQ = 0L; PQ < nshellP * nshellQ; PQ++) {
+        int thread = 0;
+#ifdef _OPENMP
+        thread = omp_get_thread_num();
+#endif
+        psi::TwoBodyAOInt *eri = eris[thread];
+        int P = PQ / nshellQ;
+        int Q = PQ % nshellQ;
         int nP = basis1.shell(P).nfunction();
-        int startP = basis1.shell(P).function_index();
-        if (centers_dim[0] != -1) {
-            max_quartet[centers_dim[0]] = static_cast<size_t>(nP);
-            target_range[centers_dim[0]][0] = static_cast<size_t>(startP);
-            target_range[centers_dim[0]][1] = static_cast<size_t>(startP + nP);
-            local_range[centers_dim[0]][1] = static_cast<size_t>(nP);
-        }
-
-        for (int Q = 0; Q < basis2.nshell(); Q++) {
-            int nQ = basis2.shell(Q).nfunction();
-            int startQ = basis2.shell(Q).function_index();
-            if (centers_dim[1] != -1) {
-                max_quartet[centers_dim[1]] = static_cast<size_t>(nQ);
-                target_range[centers_dim[1]][0] = static_cast<size_t>(startQ);
-                target_range[centers_dim[1]][1] = static_cast<size_t>(startQ + nQ);
-                local_range[centers_dim[1]][1] = static_cast<size_t>(nQ);
-            }
-
-            for (int R = 0; R < basis3.nshell(); R++) {
-                int nR = basis3.shell(R).nfunction();
-                int startR = basis3.shell(R).function_index();
-                if (centers_dim[2] != -1) {
-                    max_quartet[centers_dim[2]] = static_cast<size_t>(nR);
-                    target_range[centers_dim[2]][0] = static_cast<size_t>(startR);
-                    target_range[centers_dim[2]][1] = static_cast<size_t>(startR + nR);
-                    local_range[centers_dim[2]][1] = static_cast<size_t>(nR);
-                }
-
-                for (int S = 0; S < basis4.nshell(); S++) {
-                    int nS = basis4.shell(S).nfunction();
-                    int startS = basis4.shell(S).function_index();
-                    if (centers_dim[3] != -1) {
-                        max_quartet[centers_dim[3]] = static_cast<size_t>(nS);
-                        target_range[centers_dim[3]][0] = static_cast<size_t>(startS);
-                        target_range[centers_dim[3]][1] = static_cast<size_t>(startS + nS);
-                        local_range[centers_dim[3]][1] = static_cast<size_t>(nS);
+        int nQ = basis2.shell(Q).nfunction();
+        size_t offsetPQ = basis1.shell(P).function_index() * stride[0] + basis2.shell(Q).function_index() * stride[1];
+
+        for (int R = 0; R < basis3.nshell(); R++) {
+            int nR = basis3.shell(R).nfunction();
+            size_t offsetPQR = offsetPQ + basis3.shell(R).function_index() * stride[2];
+
+            for (int S = 0; S < basis4.nshell(); S++) {
+                int nS = basis4.shell(S).nfunction();
+                size_t offsetPQRS = offsetPQR + basis4.shell(S).function_index() * stride[3];
+
+                // Screened quartets leave the buffer untouched, so they are zeroed explicitly
+                const double *buffer = (eri->compute_shell(P, Q, R, S) ? eri->buffer() : nullptr);
+                size_t index = 0L;
+                for (int p = 0; p < nP; p++) {
+                    for (int q = 0; q < nQ; q++) {
+                        for (int r = 0; r < nR; r++) {
+                            double *row = &data[offsetPQRS + p * stride[0] + q * stride[1] + r * stride[2]];
+                            for (int s = 0; s < nS; s++, index++) {
+                                row[s * stride[3]] = (buffer ? buffer[index] : 0.0);
+                            }
+                        }
                     }
-
-                    // Have Psi4 compute the integral
-                    integral.compute_shell(P, Q, R, S);
-
-                    // Unfortunately we have to perform a memcpy :(
-                    // from Psi4 integral buffer to local_tensor
-                    std::copy(buffer, buffer + (nP * nQ * nR * nS), local_tensor.data().begin());
-
-                    // "reshape" the local tensor
-                    local_tensor.reshape(max_quartet);
-
-                    // Slice the data from local_tensor into the target.
-                    // For CoreTensor this isn't the optimal procedure to
-                    // follow.
-                    // However, this is similar to the parallel scheme that will
-                    // follow.
-                    (*target)(target_range) = local_tensor(local_range);
                 }
             }
         }
@@ -87,6 +87,7 @@ void build_A_RHF() {
         global_dpd_->buf4_mat_irrep_init(&Amat, h);
         global_dpd_->buf4_mat_irrep_rd(&Amat, h);
 
+#pragma omp parallel for private(e, m, a, i, ai, E, M, A, I, Esym, Msym, Asym, Isym)
         for (em = 0; em < Amat.params->rowtot[h]; em++) {
             e = Amat.params->roworb[h][em][0];
             m = Amat.params->roworb[h][em][1];
@@ -114,6 +114,7 @@ void build_A_ROHF() {
         global_dpd_->buf4_mat_irrep_init(&Amat, h);
         global_dpd_->buf4_mat_irrep_rd(&Amat, h);
 
+#pragma omp parallel for private(e, m, a, i, ai, E, M, A, I, Esym, Msym, Asym, Isym)
         for (em = 0; em < Amat.params->rowtot[h]; em++) {
             e = Amat.params->roworb[h][em][0];
             m = Amat.params->roworb[h][em][1];
@@ -152,6 +153,7 @@ void build_A_ROHF() {
         global_dpd_->buf4_mat_irrep_init(&Amat, h);
         global_dpd_->buf4_mat_irrep_rd(&Amat, h);
 
+#pragma omp parallel for private(e, m, a, i, ai, E, M, A, I, Esym, Msym, Asym, Isym)
         for (em = 0; em < Amat.params->rowtot[h]; em++) {
             e = Amat.params->roworb[h][em][0];
             m = Amat.params->roworb[h][em][1];
@@ -190,6 +192,7 @@ void build_A_ROHF() {
         global_dpd_->buf4_mat_irrep_init(&Amat, h);
         global_dpd_->buf4_mat_irrep_rd(&Amat, h);
 
+#pragma omp parallel for private(e, m, a, i, ai, E, M, A, I, Esym, Msym, Asym, Isym)
         for (em = 0; em < Amat.params->rowtot[h]; em++) {
             e = Amat.params->roworb[h][em][0];
             m = Amat.params->roworb[h][em][1];
@@ -95,6 +95,7 @@ void build_A_UHF() {
         global_dpd_->buf4_mat_irrep_init(&Amat, h);
         global_dpd_->buf4_mat_irrep_rd(&Amat, h);
 
+#pragma omp parallel for private(col, a, i, b, j, A, I, B, J, Asym, Isym, Bsym, Jsym)
         for (row = 0; row < Amat.params->rowtot[h]; row++) {
             a = Amat.params->roworb[h][row][0];
             i = Amat.params->roworb[h][row][1];
@@ -132,6 +133,7 @@ void build_A_UHF() {
         global_dpd_->buf4_mat_irrep_init(&Amat, h);
         global_dpd_->buf4_mat_irrep_rd(&Amat, h);
 
+#pragma omp parallel for private(col, a, i, b, j, A, I, B, J, Asym, Isym, Bsym, Jsym)
         for (row = 0; row < Amat.params->rowtot[h]; row++) {
             a = Amat.params->roworb[h][row][0];
             i = Amat.params->roworb[h][row][1];
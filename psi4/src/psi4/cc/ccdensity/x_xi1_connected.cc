@@ -35,6 +35,7 @@
 #include "MOInfo.h"
 #include "Params.h"
 #include "Frozen.h"
+#include "psi4/cc/sort_registry.h"
 #define EXTERN
 #include "globals.h"
 
@@ -130,12 +131,15 @@ void x_xi1_connected() {
         global_dpd_->file2_close(&I1);
 
         /* -= Rme Lmnef Wifan */
-        global_dpd_->buf4_init(&H2, PSIF_CC_HBAR, 0, 10, 10, 10, 10, 0, "2 W(ME,jb) + W(Me,Jb)");
-        global_dpd_->buf4_sort(&H2, PSIF_EOM_TMP_XI, prqs, 0, 5, "2 W(ME,jb) + W(Me,Jb) (Mj,Eb)");
-        global_dpd_->buf4_close(&H2);
+        if (!sort_registry_has(PSIF_CC_HBAR, "2 W(ME,jb) + W(Me,Jb) (Mj,Eb)", 0)) {
+            global_dpd_->buf4_init(&H2, PSIF_CC_HBAR, 0, 10, 10, 10, 10, 0, "2 W(ME,jb) + W(Me,Jb)");
+            global_dpd_->buf4_sort(&H2, PSIF_CC_HBAR, prqs, 0, 5, "2 W(ME,jb) + W(Me,Jb) (Mj,Eb)");
+            global_dpd_->buf4_close(&H2);
+            sort_registry_add(PSIF_CC_HBAR, "2 W(ME,jb) + W(Me,Jb) (Mj,Eb)", 0);
+        }
 
         global_dpd_->file2_init(&I1, PSIF_EOM_TMP, G_irr, 0, 1, "L2R1_OV");
-        global_dpd_->buf4_init(&H2, PSIF_EOM_TMP_XI, 0, 0, 5, 0, 5, 0, "2 W(ME,jb) + W(Me,Jb) (Mj,Eb)");
+        global_dpd_->buf4_init(&H2, PSIF_CC_HBAR, 0, 0, 5, 0, 5, 0, "2 W(ME,jb) + W(Me,Jb) (Mj,Eb)");
         global_dpd_->dot24(&I1, &H2, &HIA, 0, 0, -1.0, 1.0);
         global_dpd_->buf4_close(&H2);
         global_dpd_->file2_close(&I1);
@@ -156,7 +160,7 @@ void x_xi1_connected() {
         global_dpd_->file2_close(&F1);
 
         global_dpd_->file2_init(&R1, PSIF_CC_GR, R_irr, 0, 1, "RIA");
-        global_dpd_->buf4_init(&H2, PSIF_EOM_TMP_XI, 0, 0, 5, 0, 5, 0, "2 W(ME,jb) + W(Me,Jb) (Mj,Eb)");
+        global_dpd_->buf4_init(&H2, PSIF_CC_HBAR, 0, 0, 5, 0, 5, 0, "2 W(ME,jb) + W(Me,Jb) (Mj,Eb)");
         global_dpd_->dot13(&R1, &H2, &IME, 0, 0, 1.0, 1.0);
         global_dpd_->buf4_close(&H2);
         global_dpd_->file2_close(&R1);
@@ -256,33 +260,45 @@ void x_xi1_connected() {
         global_dpd_->file2_close(&I1);
 
         /* -= Rme Lmnef Wifan */
-        global_dpd_->buf4_init(&H2, PSIF_CC_HBAR, 0, 10, 10, 10, 10, 0, "WMBEJ");
-        global_dpd_->buf4_sort(&H2, PSIF_EOM_TMP_XI, prqs, 0, 5, "WMBEJ (MJ,EB)");
-        global_dpd_->buf4_close(&H2);
-        global_dpd_->buf4_init(&H2, PSIF_CC_HBAR, 0, 10, 10, 10, 10, 0, "Wmbej");
-        global_dpd_->buf4_sort(&H2, PSIF_EOM_TMP_XI, prqs, 0, 5, "Wmbej (mj,eb)");
-        global_dpd_->buf4_close(&H2);
-        global_dpd_->buf4_init(&H2, PSIF_CC_HBAR, 0, 10, 10, 10, 10, 0, "WMbEj");
-        global_dpd_->buf4_sort(&H2, PSIF_EOM_TMP_XI, prqs, 0, 5, "WMbEj (Mj,Eb)");
-        global_dpd_->buf4_close(&H2);
-        global_dpd_->buf4_init(&H2, PSIF_CC_HBAR, 0, 10, 10, 10, 10, 0, "WmBeJ");
-        global_dpd_->buf4_sort(&H2, PSIF_EOM_TMP_XI, prqs, 0, 5, "WmBeJ (mJ,eB)");
-        global_dpd_->buf4_close(&H2);
+        if (!sort_registry_has(PSIF_CC_HBAR, "WMBEJ (MJ,EB)", 0)) {
+            global_dpd_->buf4_init(&H2, PSIF_CC_HBAR, 0, 10, 10, 10, 10, 0, "WMBEJ");
+            global_dpd_->buf4_sort(&H2, PSIF_CC_HBAR, prqs, 0, 5, "WMBEJ (MJ,EB)");
+            global_dpd_->buf4_close(&H2);
+            sort_registry_add(PSIF_CC_HBAR, "WMBEJ (MJ,EB)", 0);
+        }
+        if (!sort_registry_has(PSIF_CC_HBAR, "Wmbej (mj,eb)", 0)) {
+            global_dpd_->buf4_init(&H2, PSIF_CC_HBAR, 0, 10, 10, 10, 10, 0, "Wmbej");
+            global_dpd_->buf4_sort(&H2, PSIF_CC_HBAR, prqs, 0, 5, "Wmbej (mj,eb)");
+            global_dpd_->buf4_close(&H2);
+            sort_registry_add(PSIF_CC_HBAR, "Wmbej (mj,eb)", 0);
+        }
+        if (!sort_registry_has(PSIF_CC_HBAR, "WMbEj (Mj,Eb)", 0)) {
+            global_dpd_->buf4_init(&H2, PSIF_CC_HBAR, 0, 10, 10, 10, 10, 0, "WMbEj");
+            global_dpd_->buf4_sort(&H2, PSIF_CC_HBAR, prqs, 0, 5, "WMbEj (Mj,Eb)");
+            global_dpd_->buf4_close(&H2);
+            sort_registry_add(PSIF_CC_HBAR, "WMbEj (Mj,Eb)", 0);
+        }
+        if (!sort_registry_has(PSIF_CC_HBAR, "WmBeJ (mJ,eB)", 0)) {
+            global_dpd_->buf4_init(&H2, PSIF_CC_HBAR, 0, 10, 10, 10, 10, 0, "WmBeJ");
+            global_dpd_->buf4_sort(&H2, PSIF_CC_HBAR, prqs, 0, 5, "WmBeJ (mJ,eB)");
+            global_dpd_->buf4_close(&H2);
+            sort_registry_add(PSIF_CC_HBAR, "WmBeJ (mJ,eB)", 0);
+        }
 
         global_dpd_->file2_init(&I1, PSIF_EOM_TMP, G_irr, 0, 1, "L2R1_OV");
-        global_dpd_->buf4_init(&H2, PSIF_EOM_TMP_XI, 0, 0, 5, 0, 5, 0, "WMBEJ (MJ,EB)");
+        global_dpd_->buf4_init(&H2, PSIF_CC_HBAR, 0, 0, 5, 0, 5, 0, "WMBEJ (MJ,EB)");
         global_dpd_->dot24(&I1, &H2, &HIA, 0, 0, -1.0, 1.0);
         global_dpd_->buf4_close(&H2);
-        global_dpd_->buf4_init(&H2, PSIF_EOM_TMP_XI, 0, 0, 5, 0, 5, 0, "WmBeJ (mJ,eB)");
+        global_dpd_->buf4_init(&H2, PSIF_CC_HBAR, 0, 0, 5, 0, 5, 0, "WmBeJ (mJ,eB)");
         global_dpd_->dot24(&I1, &H2, &Hia, 0, 0, -1.0, 1.0);
         global_dpd_->buf4_close(&H2);
         global_dpd_->file2_close(&I1);
 
         global_dpd_->file2_init(&I1, PSIF_EOM_TMP, G_irr, 0, 1, "L2R1_ov");
-        global_dpd_->buf4_init(&H2, PSIF_EOM_TMP_XI, 0, 0, 5, 0, 5, 0, "Wmbej (mj,eb)");
+        global_dpd_->buf4_init(&H2, PSIF_CC_HBAR, 0, 0, 5, 0, 5, 0, "Wmbej (mj,eb)");
         global_dpd_->dot24(&I1, &H2, &Hia, 0, 0, -1.0, 1.0);
         global_dpd_->buf4_close(&H2);
-        global_dpd_->buf4_init(&H2, PSIF_EOM_TMP_XI, 0, 0, 5, 0, 5, 0, "WMbEj (Mj,Eb)");
+        global_dpd_->buf4_init(&H2, PSIF_CC_HBAR, 0, 0, 5, 0, 5, 0, "WMbEj (Mj,Eb)");
         global_dpd_->dot24(&I1, &H2, &HIA, 0, 0, -1.0, 1.0);
         global_dpd_->buf4_close(&H2);
         global_dpd_->file2_close(&I1);
@@ -314,19 +330,19 @@ void x_xi1_connected() {
         global_dpd_->file2_close(&F1);
 
         global_dpd_->file2_init(&R1, PSIF_CC_GR, R_irr, 0, 1, "RIA");
-        global_dpd_->buf4_init(&H2, PSIF_EOM_TMP_XI, 0, 0, 5, 0, 5, 0, "WMBEJ (MJ,EB)");
+        global_dpd_->buf4_init(&H2, PSIF_CC_HBAR, 0, 0, 5, 0, 5, 0, "WMBEJ (MJ,EB)");
         global_dpd_->dot13(&R1, &H2, &IME, 0, 0, 1.0, 1.0);
         global_dpd_->buf4_close(&H2);
-        global_dpd_->buf4_init(&H2, PSIF_EOM_TMP_XI, 0, 0, 5, 0, 5, 0, "WMbEj (Mj,Eb)");
+        global_dpd_->buf4_init(&H2, PSIF_CC_HBAR, 0, 0, 5, 0, 5, 0, "WMbEj (Mj,Eb)");
         global_dpd_->dot13(&R1, &H2, &Ime, 0, 0, 1.0, 1.0);
         global_dpd_->buf4_close(&H2);
         global_dpd_->file2_close(&R1);
 
         global_dpd_->file2_init(&R1, PSIF_CC_GR, R_irr, 0, 1, "Ria");
-        global_dpd_->buf4_init(&H2, PSIF_EOM_TMP_XI, 0, 0, 5, 0, 5, 0, "Wmbej (mj,eb)");
+        global_dpd_->buf4_init(&H2, PSIF_CC_HBAR, 0, 0, 5, 0, 5, 0, "Wmbej (mj,eb)");
         global_dpd_->dot13(&R1, &H2, &Ime, 0, 0, 1.0, 1.0);
         global_dpd_->buf4_close(&H2);
-        global_dpd_->buf4_init(&H2, PSIF_EOM_TMP_XI, 0, 0, 5, 0, 5, 0, "WmBeJ (mJ,eB)");
+        global_dpd_->buf4_init(&H2, PSIF_CC_HBAR, 0, 0, 5, 0, 5, 0, "WmBeJ (mJ,eB)");
         global_dpd_->dot13(&R1, &H2, &IME, 0, 0, 1.0, 1.0);
         global_dpd_->buf4_close(&H2);
         global_dpd_->file2_close(&R1);
@@ -441,32 +457,44 @@ void x_xi1_connected() {
         global_dpd_->file2_close(&I1);
 
         /* -= Rme Lmnef Wifan */
-        global_dpd_->buf4_init(&H2, PSIF_CC_HBAR, 0, 20, 20, 20, 20, 0, "WMBEJ");
-        global_dpd_->buf4_sort(&H2, PSIF_EOM_TMP_XI, prqs, 0, 5, "WMBEJ (MJ,EB)");
-        global_dpd_->buf4_close(&H2);
-        global_dpd_->buf4_init(&H2, PSIF_CC_HBAR, 0, 30, 30, 30, 30, 0, "Wmbej");
-        global_dpd_->buf4_sort(&H2, PSIF_EOM_TMP_XI, prqs, 10, 15, "Wmbej (mj,eb)");
-        global_dpd_->buf4_close(&H2);
-        global_dpd_->buf4_init(&H2, PSIF_CC_HBAR, 0, 20, 30, 20, 30, 0, "WMbEj");
-        global_dpd_->buf4_sort(&H2, PSIF_EOM_TMP_XI, prqs, 22, 28, "WMbEj (Mj,Eb)");
-        global_dpd_->buf4_close(&H2);
-        global_dpd_->buf4_init(&H2, PSIF_CC_HBAR, 0, 30, 20, 30, 20, 0, "WmBeJ");
-        global_dpd_->buf4_sort(&H2, PSIF_EOM_TMP_XI, prqs, 23, 29, "WmBeJ (mJ,eB)");
-        global_dpd_->buf4_close(&H2);
+        if (!sort_registry_has(PSIF_CC_HBAR, "WMBEJ (MJ,EB)", 0)) {
+            global_dpd_->buf4_init(&H2, PSIF_CC_HBAR, 0, 20, 20, 20, 20, 0, "WMBEJ");
+            global_dpd_->buf4_sort(&H2, PSIF_CC_HBAR, prqs, 0, 5, "WMBEJ (MJ,EB)");
+            global_dpd_->buf4_close(&H2);
+            sort_registry_add(PSIF_CC_HBAR, "WMBEJ (MJ,EB)", 0);
+        }
+        if (!sort_registry_has(PSIF_CC_HBAR, "Wmbej (mj,eb)", 0)) {
+            global_dpd_->buf4_init(&H2, PSIF_CC_HBAR, 0, 30, 30, 30, 30, 0, "Wmbej");
+            global_dpd_->buf4_sort(&H2, PSIF_CC_HBAR, prqs, 10, 15, "Wmbej (mj,eb)");
+            global_dpd_->buf4_close(&H2);
+            sort_registry_add(PSIF_CC_HBAR, "Wmbej (mj,eb)", 0);
+        }
+        if (!sort_registry_has(PSIF_CC_HBAR, "WMbEj (Mj,Eb)", 0)) {
+            global_dpd_->buf4_init(&H2, PSIF_CC_HBAR, 0, 20, 30, 20, 30, 0, "WMbEj");
+            global_dpd_->buf4_sort(&H2, PSIF_CC_HBAR, prqs, 22, 28, "WMbEj (Mj,Eb)");
+            global_dpd_->buf4_close(&H2);
+            sort_registry_add(PSIF_CC_HBAR, "WMbEj (Mj,Eb)", 0);
+        }
+        if (!sort_registry_has(PSIF_CC_HBAR, "WmBeJ (mJ,eB)", 0)) {
+            global_dpd_->buf4_init(&H2, PSIF_CC_HBAR, 0, 30, 20, 30, 20, 0, "WmBeJ");
+            global_dpd_->buf4_sort(&H2, PSIF_CC_HBAR, prqs, 23, 29, "WmBeJ (mJ,eB)");
+            global_dpd_->buf4_close(&H2);
+            sort_registry_add(PSIF_CC_HBAR, "WmBeJ (mJ,eB)", 0);
+        }
 
         global_dpd_->file2_init(&I1, PSIF_EOM_TMP, G_irr, 0, 1, "L2R1_OV");
-        global_dpd_->buf4_init(&H2, PSIF_EOM_TMP_XI, 0, 0, 5, 0, 5, 0, "WMBEJ (MJ,EB)");
+        global_dpd_->buf4_init(&H2, PSIF_CC_HBAR, 0, 0, 5, 0, 5, 0, "WMBEJ (MJ,EB)");
         global_dpd_->dot24(&I1, &H2, &HIA, 0, 0, -1.0, 1.0);
         global_dpd_->buf4_close(&H2);
-        global_dpd_->buf4_init(&H2, PSIF_EOM_TMP_XI, 0, 23, 29, 23, 29, 0, "WmBeJ (mJ,eB)");
+        global_dpd_->buf4_init(&H2, PSIF_CC_HBAR, 0, 23, 29, 23, 29, 0, "WmBeJ (mJ,eB)");
         global_dpd_->dot24(&I1, &H2, &Hia, 0, 0, -1.0, 1.0);
         global_dpd_->buf4_close(&H2);
         global_dpd_->file2_close(&I1);
         global_dpd_->file2_init(&I1, PSIF_EOM_TMP, G_irr, 2, 3, "L2R1_ov");
-        global_dpd_->buf4_init(&H2, PSIF_EOM_TMP_XI, 0, 10, 15, 10, 15, 0, "Wmbej (mj,eb)");
+        global_dpd_->buf4_init(&H2, PSIF_CC_HBAR, 0, 10, 15, 10, 15, 0, "Wmbej (mj,eb)");
         global_dpd_->dot24(&I1, &H2, &Hia, 0, 0, -1.0, 1.0);
         global_dpd_->buf4_close(&H2);
-        global_dpd_->buf4_init(&H2, PSIF_EOM_TMP_XI, 0, 22, 28, 22, 28, 0, "WMbEj (Mj,Eb)");
+        global_dpd_->buf4_init(&H2, PSIF_CC_HBAR, 0, 22, 28, 22, 28, 0, "WMbEj (Mj,Eb)");
         global_dpd_->dot24(&I1, &H2, &HIA, 0, 0, -1.0, 1.0);
         global_dpd_->buf4_close(&H2);
         global_dpd_->file2_close(&I1);
@@ -498,18 +526,18 @@ void x_xi1_connected() {
         global_dpd_->file2_close(&F1);
 
         global_dpd_->file2_init(&R1, PSIF_CC_GR, R_irr, 0, 1, "RIA");
-        global_dpd_->buf4_init(&H2, PSIF_EOM_TMP_XI, 0, 0, 5, 0, 5, 0, "WMBEJ (MJ,EB)");
+        global_dpd_->buf4_init(&H2, PSIF_CC_HBAR, 0, 0, 5, 0, 5, 0, "WMBEJ (MJ,EB)");
         global_dpd_->dot13(&R1, &H2, &IME, 0, 0, 1.0, 1.0);
         global_dpd_->buf4_close(&H2);
-        global_dpd_->buf4_init(&H2, PSIF_EOM_TMP_XI, 0, 22, 28, 22, 28, 0, "WMbEj (Mj,Eb)");
+        global_dpd_->buf4_init(&H2, PSIF_CC_HBAR, 0, 22, 28, 22, 28, 0, "WMbEj (Mj,Eb)");
         global_dpd_->dot13(&R1, &H2, &Ime, 0, 0, 1.0, 1.0);
         global_dpd_->buf4_close(&H2);
         global_dpd_->file2_close(&R1);
         global_dpd_->file2_init(&R1, PSIF_CC_GR, R_irr, 2, 3, "Ria");
-        global_dpd_->buf4_init(&H2, PSIF_EOM_TMP_XI, 0, 10, 15, 10, 15, 0, "Wmbej (mj,eb)");
+        global_dpd_->buf4_init(&H2, PSIF_CC_HBAR, 0, 10, 15, 10, 15, 0, "Wmbej (mj,eb)");
         global_dpd_->dot13(&R1, &H2, &Ime, 0, 0, 1.0, 1.0);
         global_dpd_->buf4_close(&H2);
-        global_dpd_->buf4_init(&H2, PSIF_EOM_TMP_XI, 0, 23, 29, 23, 29, 0, "WmBeJ (mJ,eB)");
+        global_dpd_->buf4_init(&H2, PSIF_CC_HBAR, 0, 23, 29, 23, 29, 0, "WmBeJ (mJ,eB)");
         global_dpd_->dot13(&R1, &H2, &IME, 0, 0, 1.0, 1.0);
         global_dpd_->buf4_close(&H2);
         global_dpd_->file2_close(&R1);
@@ -0,0 +1,233 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Psi4: an open-source quantum chemistry software package
+ *
+ * Copyright (c) 2007-2023 The Psi4 Developers.
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This file is part of Psi4.
+ *
+ * Psi4 is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * Psi4 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with Psi4; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * @END LICENSE
+ */
+
+/*! \file
+    \ingroup CCENERGY
+    \brief Integral-direct AO-basis contribution of the <ab||cd> ladder (RHF)
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "psi4/libciomr/libciomr.h"
+#include "psi4/libdpd/dpd.h"
+#include "psi4/libmints/integral.h"
+#include "psi4/libmints/sobasis.h"
+#include "psi4/libmints/sointegral_twobody.h"
+#include "psi4/libmints/twobody.h"
+#include "psi4/libpsi4util/PsiOutStream.h"
+#include "psi4/libpsi4util/exception.h"
+#include "psi4/libqt/qt.h"
+#include "psi4/cc/ccwave.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace psi {
+namespace ccenergy {
+
+namespace {
+
+/*
+ * Receives unique SO integrals (pq|rs) from TwoBodySOInt and adds every
+ * permutation into Z(pr,ij) += (pq|rs) tau(qs,ij), exactly as AO_contribute()
+ * does for integrals read from disk.  T1 and Z hold one batch of ij columns,
+ * stored as [h][pq][ij] so that each update is a single contiguous axpy.
+ * Several threads feed integrals concurrently; rows of Z are guarded by a
+ * set of striped locks.
+ */
+class AODirectLadderFunctor {
+    const dpdparams4 *params_;
+    double ***T1_;
+    double ***Z_;
+    const int *nij_;
+    std::vector<std::mutex> &locks_;
+
+    void axpy(int G, int target, int source, double value) {
+        if (!nij_[G]) return;
+        std::lock_guard<std::mutex> lock(locks_[((size_t)target * 8 + G) % locks_.size()]);
+        C_DAXPY(nij_[G], value, T1_[G][source], 1, Z_[G][target], 1);
+    }
+
+   public:
+    AODirectLadderFunctor(const dpdparams4 *params, double ***T1, double ***Z, const int *nij,
+                          std::vector<std::mutex> &locks)
+        : params_(params), T1_(T1), Z_(Z), nij_(nij), locks_(locks) {}
+
+    void operator()(int p, int q, int r, int s, int, int, int, int, int, int, int, int, double value) {
+        int Gp = params_->rsym[p];
+        int Gq = params_->rsym[q];
+        int Gr = params_->rsym[r];
+        int Gs = params_->rsym[s];
+
+        int pq = params_->colidx[p][q];
+        int rs = params_->colidx[r][s];
+
+        int pr = params_->colidx[p][r];
+        int rp = params_->colidx[r][p];
+        int ps = params_->colidx[p][s];
+        int sp = params_->colidx[s][p];
+        int qr = params_->colidx[q][r];
+        int rq = params_->colidx[r][q];
+        int qs = params_->colidx[q][s];
+        int sq = params_->colidx[s][q];
+
+        /* (pq|rs) */
+        axpy(Gp ^ Gr, pr, qs, value);
+
+        if (p != q && r != s && pq != rs) {
+            axpy(Gp ^ Gs, ps, qr, value); /* (pq|sr) */
+            axpy(Gq ^ Gr, qr, ps, value); /* (qp|rs) */
+            axpy(Gq ^ Gs, qs, pr, value); /* (qp|sr) */
+            axpy(Gr ^ Gp, rp, sq, value); /* (rs|pq) */
+            axpy(Gs ^ Gp, sp, rq, value); /* (sr|pq) */
+            axpy(Gr ^ Gq, rq, sp, value); /* (rs|qp) */
+            axpy(Gs ^ Gq, sq, rp, value); /* (sr|qp) */
+        } else if (p != q && r != s && pq == rs) {
+            axpy(Gp ^ Gs, ps, qr, value); /* (pq|sr) */
+            axpy(Gq ^ Gr, qr, ps, value); /* (qp|rs) */
+            axpy(Gq ^ Gs, qs, pr, value); /* (qp|sr) */
+        } else if (p != q && r == s) {
+            axpy(Gq ^ Gr, qr, ps, value); /* (qp|rs) */
+            axpy(Gr ^ Gp, rp, sq, value); /* (rs|pq) */
+            axpy(Gr ^ Gq, rq, sp, value); /* (rs|qp) */
+        } else if (p == q && r != s) {
+            axpy(Gp ^ Gs, ps, qr, value); /* (pq|sr) */
+            axpy(Gr ^ Gp, rp, sq, value); /* (rs|pq) */
+            axpy(Gs ^ Gp, sp, rq, value); /* (sr|pq) */
+        } else if (p == q && r == s && pq != rs) {
+            axpy(Gr ^ Gp, rp, sq, value); /* (rs|pq) */
+        }
+    }
+};
+
+}  // namespace
+
+/* AO_contribute_direct(): Integral-direct replacement for the AO_contribute()
+** loop over the SO integral file.
+**
+** dpdbuf4 *tau1_AO: tau(ij,pq), half back-transformed amplitudes (DPD 1, "0,5")
+** dpdbuf4 *tau2_AO: Z(ij,pq), the result; overwritten (DPD 1, "0,5")
+**
+** The ij rows are processed in batches small enough that tau and Z for the
+** batch fit in the free DPD memory (or in AO_DIRECT_NBATCH batches, if given),
+** and the SO integrals are recomputed for every batch.  Within a batch, the
+** shell pairs (PQ| are distributed over the threads.
+*/
+void CCEnergyWavefunction::AO_contribute_direct(dpdbuf4 *tau1_AO, dpdbuf4 *tau2_AO) {
+    auto nirreps = moinfo_.nirreps;
+    auto params = tau1_AO->params;
+    int nthreads = std::max(1, params_.nthreads);
+
+    /* Choose the batches: the transposed tau and Z of a batch plus the rows being staged, 3 doubles per element */
+    size_t total = 0;
+    for (int h = 0; h < nirreps; h++) total += 3 * (size_t)params->rowtot[h] * params->coltot[h];
+    int nbatch = params_.ao_direct_nbatch;
+    if (nbatch <= 0) {
+        size_t memfree = std::max(dpd_memfree(), 1L);
+        nbatch = std::max<size_t>(1, (total + memfree - 1) / memfree);
+    }
+    int max_rows = 0;
+    for (int h = 0; h < nirreps; h++) max_rows = std::max(max_rows, params->rowtot[h]);
+    nbatch = std::max(1, std::min(nbatch, max_rows));
+
+    std::vector<int> rows_per_batch(nirreps);
+    for (int h = 0; h < nirreps; h++) rows_per_batch[h] = (params->rowtot[h] + nbatch - 1) / nbatch;
+
+    if (params_.print & 2)
+        outfile->Printf("     *** Direct <ab||cd> --> T2 in %d batch(es) of ij pairs, %d thread(s)\n", nbatch,
+                        nthreads);
+
+    /* Integral machinery: one AO engine per thread */
+    std::vector<std::shared_ptr<TwoBodyAOInt>> tb;
+    tb.push_back(std::shared_ptr<TwoBodyAOInt>(integral_->eri()));
+    for (int t = 1; t < nthreads; t++) tb.push_back(std::shared_ptr<TwoBodyAOInt>(tb.front()->clone()));
+    auto eri = std::make_shared<TwoBodySOInt>(tb, integral_);
+    eri->set_cutoff(1.0e-14);
+
+    std::vector<std::pair<int, int>> PQ_pairs;
+    SO_PQ_Iterator PQIter(sobasisset_);
+    for (PQIter.first(); PQIter.is_done() == false; PQIter.next()) PQ_pairs.emplace_back(PQIter.p(), PQIter.q());
+
+    std::vector<std::mutex> locks(1024 * nthreads);
+    std::vector<double **> T1(nirreps), Z(nirreps);
+    std::vector<int> nij(nirreps), ij0(nirreps);
+
+    global_dpd_->buf4_scm(tau2_AO, 0.0);
+
+    for (int batch = 0; batch < nbatch; batch++) {
+        /* Gather this batch of tau rows, transposed to [pq][ij] */
+        for (int h = 0; h < nirreps; h++) {
+            ij0[h] = std::min(batch * rows_per_batch[h], params->rowtot[h]);
+            nij[h] = std::min(rows_per_batch[h], params->rowtot[h] - ij0[h]);
+            T1[h] = Z[h] = nullptr;
+            if (!nij[h] || !params->coltot[h]) {
+                nij[h] = 0;
+                continue;
+            }
+            global_dpd_->buf4_mat_irrep_init_block(tau1_AO, h, nij[h]);
+            global_dpd_->buf4_mat_irrep_rd_block(tau1_AO, h, ij0[h], nij[h]);
+            T1[h] = global_dpd_->dpd_block_matrix(params->coltot[h], nij[h]);
+            for (int ij = 0; ij < nij[h]; ij++)
+                for (int pq = 0; pq < params->coltot[h]; pq++) T1[h][pq][ij] = tau1_AO->matrix[h][ij][pq];
+            global_dpd_->buf4_mat_irrep_close_block(tau1_AO, h, nij[h]);
+            Z[h] = global_dpd_->dpd_block_matrix(params->coltot[h], nij[h]);
+        }
+
+        AODirectLadderFunctor functor(params, T1.data(), Z.data(), nij.data(), locks);
+#pragma omp parallel for schedule(dynamic) num_threads(nthreads)
+        for (size_t PQ = 0; PQ < PQ_pairs.size(); PQ++) {
+            int P = PQ_pairs[PQ].first;
+            int Q = PQ_pairs[PQ].second;
+            SO_RS_Iterator RSIter(P, Q, sobasisset_, sobasisset_, sobasisset_, sobasisset_);
+            for (RSIter.first(); RSIter.is_done() == false; RSIter.next()) {
+                eri->compute_shell(RSIter.p(), RSIter.q(), RSIter.r(), RSIter.s(), functor);
+            }
+        }
+
+        /* Scatter the result back into Z(ij,pq) */
+        for (int h = 0; h < nirreps; h++) {
+            if (!nij[h]) continue;
+            global_dpd_->buf4_mat_irrep_init_block(tau2_AO, h, nij[h]);
+            for (int ij = 0; ij < nij[h]; ij++)
+                for (int pq = 0; pq < params->coltot[h]; pq++) tau2_AO->matrix[h][ij][pq] = Z[h][pq][ij];
+            global_dpd_->buf4_mat_irrep_wrt_block(tau2_AO, h, ij0[h], nij[h]);
+            global_dpd_->buf4_mat_irrep_close_block(tau2_AO, h, nij[h]);
+            global_dpd_->free_dpd_block(T1[h], params->coltot[h], nij[h]);
+            global_dpd_->free_dpd_block(Z[h], params->coltot[h], nij[h]);
+        }
+    }
+}
+
+}  // namespace ccenergy
+}  // namespace psi
@@ -58,7 +58,6 @@ void CCEnergyWavefunction::BT2_AO() {
     int **T2_cd_row_start, **T2_pq_row_start;
     int **T2_CD_row_start, **T2_Cd_row_start;
     dpdbuf4 tau, t2, tau1_AO, tau2_AO;
-    dpdfile4 T;
     struct iwlbuf InBuf;
     int lastbuf;
     double tolerance = 1e-14;
@@ -206,19 +205,37 @@ void CCEnergyWavefunction::BT2_AO() {
             global_dpd_->buf4_close(&tau2_AO);
 
         } else if (params_.aobasis == "DIRECT") {
-            global_dpd_->file4_init(&T, PSIF_CC_TAMPS, 0, 0, 5, "tauIjAb");
-            global_dpd_->file4_cache_del(&T);
-            global_dpd_->file4_close(&T);
+            /* Same half-transformations as above, but the SO integrals are computed on the fly
+               and tau never needs to be transposed */
+            dpd_set_default(1);
+            global_dpd_->buf4_init(&tau1_AO, PSIF_CC_TAMPS, 0, 0, 5, 0, 5, 0, "tauIjPq (1)");
+            global_dpd_->buf4_scm(&tau1_AO, 0.0);
 
-            global_dpd_->file4_init(&T, PSIF_CC_TAMPS, 0, 0, 5, "New tIjAb");
-            global_dpd_->file4_cache_del(&T);
-            global_dpd_->file4_close(&T);
+            dpd_set_default(0);
+            global_dpd_->buf4_init(&tau, PSIF_CC_TAMPS, 0, 0, 5, 0, 5, 0, "tauIjAb");
 
-            /* close the CC_TAMPS file for cints to use it */
-            psio_close(PSIF_CC_TAMPS, 1);
+            halftrans(&tau, 0, &tau1_AO, 1, C, C, nirreps, T2_cd_row_start, T2_pq_row_start, virtpi, virtpi, sopi, 0,
+                      1.0, 0.0);
 
-            /* re-open CCC_TAMPS for remaining terms */
-            psio_open(PSIF_CC_TAMPS, PSIO_OPEN_OLD);
+            global_dpd_->buf4_close(&tau);
+            global_dpd_->buf4_close(&tau1_AO);
+
+            dpd_set_default(1);
+            global_dpd_->buf4_init(&tau1_AO, PSIF_CC_TAMPS, 0, 0, 5, 0, 5, 0, "tauIjPq (1)");
+            global_dpd_->buf4_init(&tau2_AO, PSIF_CC_TAMPS, 0, 0, 5, 0, 5, 0, "tauIjPq (2)");
+
+            AO_contribute_direct(&tau1_AO, &tau2_AO);
+
+            global_dpd_->buf4_close(&tau1_AO);
+
+            dpd_set_default(0);
+            global_dpd_->buf4_init(&t2, PSIF_CC_TAMPS, 0, 0, 5, 0, 5, 0, "New tIjAb");
+
+            halftrans(&t2, 0, &tau2_AO, 1, C, C, nirreps, T2_cd_row_start, T2_pq_row_start, virtpi, virtpi, sopi, 1,
+                      1.0, 1.0);
+
+            global_dpd_->buf4_close(&t2);
+            global_dpd_->buf4_close(&tau2_AO);
         }
 
     } else if (params_.ref == 1) { /** ROHF **/
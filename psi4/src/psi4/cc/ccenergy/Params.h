@@ -45,8 +45,11 @@ struct Params {
     double convergence;
     double e_convergence;
     int restart;
+    int checkpoint_freq; /* iterations between amplitude checkpoints; 0 = never */
+    int checkpoint_restart;
     long int memory;
     std::string aobasis;
+    int ao_direct_nbatch;
     int cachelev;
     int cachetype;
     int ref;
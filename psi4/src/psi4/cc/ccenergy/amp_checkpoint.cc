@@ -0,0 +1,280 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Psi4: an open-source quantum chemistry software package
+ *
+ * Copyright (c) 2007-2023 The Psi4 Developers.
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This file is part of Psi4.
+ *
+ * Psi4 is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * Psi4 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with Psi4; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * @END LICENSE
+ */
+
+/*! \file
+    \ingroup CCENERGY
+    \brief Checkpoint and restart of the CC amplitude iterations
+*/
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "psi4/libdpd/dpd.h"
+#include "psi4/libpsio/psio.h"
+#include "psi4/libmints/molecule.h"
+#include "psi4/libmints/writer_file_prefix.h"
+#include "psi4/libpsi4util/PsiOutStream.h"
+#include "psi4/psifiles.h"
+#include "MOInfo.h"
+#include "Params.h"
+#include "psi4/cc/ccwave.h"
+
+namespace psi {
+namespace ccenergy {
+
+/*
+** The checkpoint file holds, in this order:
+**   a header (magic, version, reference, nirreps, completed iterations)
+**   the T1 and T2 amplitudes, irrep by irrep, as the DPD stores them
+**   the DIIS error and amplitude vectors, as raw copies of their entries
+**
+** It is written to a temporary file which then replaces the previous
+** checkpoint, so a job killed while writing leaves the last one intact.
+*/
+
+namespace {
+
+const char checkpoint_magic[8] = "CCCHKPT";
+const int checkpoint_version = 1;
+
+/* An amplitude entry and the DPD shape it is stored with */
+struct AmpEntry {
+    const char *label;
+    bool t2;
+    int p, q;
+};
+
+std::vector<AmpEntry> amp_entries(int ref) {
+    if (ref == 0) return {{"tIA", false, 0, 1}, {"tIjAb", true, 0, 5}};
+    if (ref == 1)
+        return {{"tIA", false, 0, 1},
+                {"tia", false, 0, 1},
+                {"tIJAB", true, 2, 7},
+                {"tijab", true, 2, 7},
+                {"tIjAb", true, 0, 5}};
+    return {{"tIA", false, 0, 1},
+            {"tia", false, 2, 3},
+            {"tIJAB", true, 2, 7},
+            {"tijab", true, 12, 17},
+            {"tIjAb", true, 22, 28}};
+}
+
+struct DiisEntry {
+    int unit;
+    const char *label;
+};
+
+const DiisEntry diis_entries[2] = {{PSIF_CC_DIIS_ERR, "DIIS Error Vectors"},
+                                   {PSIF_CC_DIIS_AMP, "DIIS Amplitude Vectors"}};
+
+size_t entry_bytes(int unit, const char *label) {
+    psio_tocentry *entry = psio_tocscan(unit, label);
+    if (entry == nullptr) return 0;
+    return (entry->eadd.page - entry->sadd.page) * PSIO_PAGELEN + entry->eadd.offset - entry->sadd.offset;
+}
+
+/* Raw entries are copied through a buffer of this many bytes */
+const size_t copy_chunk = 64 * PSIO_PAGELEN;
+
+}  // namespace
+
+std::string CCEnergyWavefunction::checkpoint_filename() {
+    return get_writer_file_prefix(molecule_->name()) + ".ccchk";
+}
+
+void CCEnergyWavefunction::save_amps_checkpoint() {
+    dpdfile2 T1;
+    dpdbuf4 T2;
+
+    std::string filename = checkpoint_filename();
+    std::string tmpname = filename + ".tmp";
+    FILE *out = fopen(tmpname.c_str(), "wb");
+    if (out == nullptr) {
+        outfile->Printf("    Unable to open %s; checkpoint skipped.\n", tmpname.c_str());
+        return;
+    }
+
+    int header[4] = {checkpoint_version, params_.ref, moinfo_.nirreps, moinfo_.iter};
+    fwrite(checkpoint_magic, sizeof(char), sizeof(checkpoint_magic), out);
+    fwrite(header, sizeof(int), 4, out);
+
+    for (const auto &amp : amp_entries(params_.ref)) {
+        if (amp.t2) {
+            global_dpd_->buf4_init(&T2, PSIF_CC_TAMPS, 0, amp.p, amp.q, amp.p, amp.q, 0, amp.label);
+            for (int h = 0; h < moinfo_.nirreps; h++) {
+                size_t nwords = (size_t)T2.params->rowtot[h] * T2.params->coltot[h];
+                fwrite(&nwords, sizeof(size_t), 1, out);
+                if (!nwords) continue;
+                global_dpd_->buf4_mat_irrep_init(&T2, h);
+                global_dpd_->buf4_mat_irrep_rd(&T2, h);
+                fwrite(T2.matrix[h][0], sizeof(double), nwords, out);
+                global_dpd_->buf4_mat_irrep_close(&T2, h);
+            }
+            global_dpd_->buf4_close(&T2);
+        } else {
+            global_dpd_->file2_init(&T1, PSIF_CC_OEI, 0, amp.p, amp.q, amp.label);
+            global_dpd_->file2_mat_init(&T1);
+            global_dpd_->file2_mat_rd(&T1);
+            for (int h = 0; h < moinfo_.nirreps; h++) {
+                size_t nwords = (size_t)T1.params->rowtot[h] * T1.params->coltot[h];
+                fwrite(&nwords, sizeof(size_t), 1, out);
+                if (nwords) fwrite(T1.matrix[h][0], sizeof(double), nwords, out);
+            }
+            global_dpd_->file2_mat_close(&T1);
+            global_dpd_->file2_close(&T1);
+        }
+    }
+
+    std::vector<char> buffer;
+    for (const auto &diis : diis_entries) {
+        size_t nbytes = params_.diis ? entry_bytes(diis.unit, diis.label) : 0;
+        fwrite(&nbytes, sizeof(size_t), 1, out);
+        buffer.resize(std::min(nbytes, copy_chunk));
+        psio_address next = PSIO_ZERO;
+        for (size_t done = 0; done < nbytes; done += buffer.size()) {
+            size_t n = std::min(buffer.size(), nbytes - done);
+            psio_read(diis.unit, diis.label, buffer.data(), n, next, &next);
+            fwrite(buffer.data(), sizeof(char), n, out);
+        }
+    }
+
+    bool ok = !ferror(out);
+    ok = (fclose(out) == 0) && ok;
+    if (!ok || std::rename(tmpname.c_str(), filename.c_str()) != 0) {
+        outfile->Printf("    Unable to write %s; checkpoint skipped.\n", filename.c_str());
+        std::remove(tmpname.c_str());
+    }
+}
+
+int CCEnergyWavefunction::load_amps_checkpoint() {
+    dpdfile2 T1;
+    dpdbuf4 T2;
+
+    std::string filename = checkpoint_filename();
+    FILE *in = fopen(filename.c_str(), "rb");
+    if (in == nullptr) {
+        outfile->Printf("    No checkpoint file %s found; starting from the usual guess.\n", filename.c_str());
+        return 0;
+    }
+
+    /* First pass: check that every block matches the current calculation
+       before anything on disk is overwritten */
+    char magic[sizeof(checkpoint_magic)];
+    int header[4];
+    bool match = fread(magic, sizeof(char), sizeof(magic), in) == sizeof(magic) &&
+                 !std::memcmp(magic, checkpoint_magic, sizeof(magic)) && fread(header, sizeof(int), 4, in) == 4 &&
+                 header[0] == checkpoint_version && header[1] == params_.ref && header[2] == moinfo_.nirreps &&
+                 header[3] > 0;
+
+    auto amps = amp_entries(params_.ref);
+    for (const auto &amp : amps) {
+        if (!match) break;
+        dpdparams4 *params = nullptr;
+        if (amp.t2) {
+            global_dpd_->buf4_init(&T2, PSIF_CC_TAMPS, 0, amp.p, amp.q, amp.p, amp.q, 0, amp.label);
+            params = T2.params;
+        } else {
+            global_dpd_->file2_init(&T1, PSIF_CC_OEI, 0, amp.p, amp.q, amp.label);
+        }
+        for (int h = 0; h < moinfo_.nirreps && match; h++) {
+            size_t nwords, expected;
+            if (amp.t2)
+                expected = (size_t)params->rowtot[h] * params->coltot[h];
+            else
+                expected = (size_t)T1.params->rowtot[h] * T1.params->coltot[h];
+            match = fread(&nwords, sizeof(size_t), 1, in) == 1 && nwords == expected &&
+                    !fseek(in, nwords * sizeof(double), SEEK_CUR);
+        }
+        if (amp.t2)
+            global_dpd_->buf4_close(&T2);
+        else
+            global_dpd_->file2_close(&T1);
+    }
+    for (int n = 0; n < 2 && match; n++) {
+        /* DIIS expects the vectors of all earlier iterations to be on disk */
+        size_t nbytes = 0;
+        match = fread(&nbytes, sizeof(size_t), 1, in) == 1 && (nbytes || !params_.diis) &&
+                !fseek(in, nbytes, SEEK_CUR);
+    }
+    if (!match) {
+        fclose(in);
+        outfile->Printf("    Checkpoint file %s does not match this calculation; starting from the usual guess.\n",
+                        filename.c_str());
+        return 0;
+    }
+
+    /* Second pass: restore the amplitudes and the DIIS subspace */
+    fseek(in, sizeof(checkpoint_magic) + 4 * sizeof(int), SEEK_SET);
+    size_t nwords;
+    for (const auto &amp : amps) {
+        if (amp.t2) {
+            global_dpd_->buf4_init(&T2, PSIF_CC_TAMPS, 0, amp.p, amp.q, amp.p, amp.q, 0, amp.label);
+            for (int h = 0; h < moinfo_.nirreps; h++) {
+                fread(&nwords, sizeof(size_t), 1, in);
+                if (!nwords) continue;
+                global_dpd_->buf4_mat_irrep_init(&T2, h);
+                fread(T2.matrix[h][0], sizeof(double), nwords, in);
+                global_dpd_->buf4_mat_irrep_wrt(&T2, h);
+                global_dpd_->buf4_mat_irrep_close(&T2, h);
+            }
+            global_dpd_->buf4_close(&T2);
+        } else {
+            global_dpd_->file2_init(&T1, PSIF_CC_OEI, 0, amp.p, amp.q, amp.label);
+            global_dpd_->file2_mat_init(&T1);
+            for (int h = 0; h < moinfo_.nirreps; h++) {
+                fread(&nwords, sizeof(size_t), 1, in);
+                if (nwords) fread(T1.matrix[h][0], sizeof(double), nwords, in);
+            }
+            global_dpd_->file2_mat_wrt(&T1);
+            global_dpd_->file2_mat_close(&T1);
+            global_dpd_->file2_close(&T1);
+        }
+    }
+
+    std::vector<char> buffer;
+    for (const auto &diis : diis_entries) {
+        size_t nbytes;
+        fread(&nbytes, sizeof(size_t), 1, in);
+        buffer.resize(std::min(nbytes, copy_chunk));
+        psio_address next = PSIO_ZERO;
+        for (size_t done = 0; done < nbytes; done += buffer.size()) {
+            size_t n = std::min(buffer.size(), nbytes - done);
+            fread(buffer.data(), sizeof(char), n, in);
+            psio_write(diis.unit, diis.label, buffer.data(), n, next, &next);
+        }
+    }
+    fclose(in);
+
+    int iter = header[3];
+    outfile->Printf("    Restarting from checkpoint %s after iteration %d.\n", filename.c_str(), iter);
+    return iter;
+}
+
+}  // namespace ccenergy
+}  // namespace psi
@@ -110,7 +110,8 @@ double CCEnergyWavefunction::compute_energy() {
         spaces.push_back(moinfo_.bvirtpi);
         spaces.push_back(moinfo_.bvir_sym);
         delete[] dpd_list[0];
-        dpd_list[0] = new DPD(0, moinfo_.nirreps, params_.memory, 0, cachefiles.data(), cachelist, nullptr, 4, spaces);
+        dpd_list[0] = new DPD(0, moinfo_.nirreps, params_.memory, params_.cachetype, cachefiles.data(), cachelist, nullptr,
+                              4, spaces);
         dpd_set_default(0);
 
         if (params_.df) {
@@ -171,6 +172,11 @@ double CCEnergyWavefunction::compute_energy() {
     }
 
     init_amps();
+    int first_iter = 1;
+    if (params_.checkpoint_restart) {
+        first_iter = load_amps_checkpoint() + 1;
+        moinfo_.iter = first_iter - 1;
+    }
 
     /* Compute the MP2 energy while we're here */
     if (params_.ref == 0 || params_.ref == 2) {
@@ -210,7 +216,7 @@ double CCEnergyWavefunction::compute_energy() {
     moinfo_.d2diag = d2diag();
     update();
     checkpoint();
-    for (moinfo_.iter = 1; moinfo_.iter <= params_.maxiter; moinfo_.iter++) {
+    for (moinfo_.iter = first_iter; moinfo_.iter <= params_.maxiter; moinfo_.iter++) {
         sort_amps();
 
         timer_on("F build");
@@ -291,6 +297,8 @@ double CCEnergyWavefunction::compute_energy() {
             outfile->Printf("\n");
             amp_write();
             if (params_.analyze != 0) analyze();
+            /* A converged run has nothing left to restart */
+            if (params_.checkpoint_freq) std::remove(checkpoint_filename().c_str());
             break;
         }
         if (params_.diis) diis(moinfo_.iter);
@@ -305,6 +313,11 @@ double CCEnergyWavefunction::compute_energy() {
         moinfo_.d2diag = d2diag();
         update();
         checkpoint();
+        if (params_.checkpoint_freq && moinfo_.iter % params_.checkpoint_freq == 0) save_amps_checkpoint();
+
+        /* The first iteration has exercised every intermediate; let the
+           adaptive cache switch to its cost model */
+        if (params_.cachetype == 2 && moinfo_.iter == 1) global_dpd_->file4_cache_adapt();
     }  // end loop over iterations
 
     // DGAS Edit
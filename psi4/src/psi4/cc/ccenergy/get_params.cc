@@ -109,10 +109,20 @@ void CCEnergyWavefunction::get_params(Options &options) {
     params_.convergence = options.get_double("R_CONVERGENCE");
     params_.e_convergence = options.get_double("E_CONVERGENCE");
     params_.restart = options.get_bool("RESTART");
+    params_.checkpoint_freq = options.get_int("AMPS_CHECKPOINT_FREQ");
+    params_.checkpoint_restart = options.get_bool("AMPS_CHECKPOINT_RESTART");
 
     params_.memory = Process::environment.get_memory();
 
     params_.aobasis = options.get_str("AO_BASIS");
+    params_.ao_direct_nbatch = options.get_int("AO_DIRECT_NBATCH");
+    if (params_.aobasis == "DIRECT") {
+        if (params_.ref != 0 || params_.dertype != 0 || params_.df)
+            throw PsiException("AO_BASIS = DIRECT is only available for conventional RHF energies", __FILE__, __LINE__);
+        if (params_.wfn != "CCSD" && params_.wfn != "CCSD_T" && params_.wfn != "BCCD" && params_.wfn != "BCCD_T")
+            throw PsiException("AO_BASIS = DIRECT is only available for CCSD, CCSD(T), and Brueckner energies",
+                               __FILE__, __LINE__);
+    }
     params_.cachelev = options.get_int("CACHELEVEL");
 
     params_.cachetype = 1;
@@ -121,10 +131,12 @@ void CCEnergyWavefunction::get_params(Options &options) {
         params_.cachetype = 1;
     else if (cachetype == "LRU")
         params_.cachetype = 0;
+    else if (cachetype == "ADAPTIVE")
+        params_.cachetype = 2;
     else
         throw PsiException("Error in input: invalid CACHETYPE", __FILE__, __LINE__);
 
-    if (params_.ref == 2) /* No LOW cacheing yet for UHF references */
+    if (params_.ref == 2 && params_.cachetype == 1) /* No LOW cacheing yet for UHF references */
         params_.cachetype = 0;
 
     params_.nthreads = Process::environment.get_n_threads();
@@ -203,11 +215,13 @@ void CCEnergyWavefunction::get_params(Options &options) {
     outfile->Printf("    R_Convergence   =     %3.1e\n", params_.convergence);
     outfile->Printf("    E_Convergence   =     %3.1e\n", params_.e_convergence);
     outfile->Printf("    Restart         =     %s\n", params_.restart ? "Yes" : "No");
+    if (params_.checkpoint_freq) outfile->Printf("    Checkpoint freq =   %4d\n", params_.checkpoint_freq);
     outfile->Printf("    DIIS            =     %s\n", params_.diis ? "Yes" : "No");
     outfile->Printf("    AO Basis        =     %s\n", params_.aobasis.c_str());
     outfile->Printf("    ABCD            =     %s\n", params_.abcd.c_str());
     outfile->Printf("    Cache Level     =     %1d\n", params_.cachelev);
-    outfile->Printf("    Cache Type      =    %4s\n", params_.cachetype ? "LOW" : "LRU");
+    outfile->Printf("    Cache Type      =    %4s\n",
+                    params_.cachetype == 2 ? "ADAPTIVE" : (params_.cachetype ? "LOW" : "LRU"));
     outfile->Printf("    Print Level     =     %1d\n", params_.print);
     outfile->Printf("    Num. of threads =     %d\n", params_.nthreads);
     outfile->Printf("    # Amps to Print =     %1d\n", params_.num_amps);
@@ -78,25 +78,12 @@ void CCEnergyWavefunction::local_init() {
     psio_read_entry(PSIF_CC_INFO, "Local Weak Pairs", (char *)local_.weak_pairs,
                     sizeof(int) * local_.nocc * local_.nocc);
 
-    outfile->Printf("    Localization parameters ready.\n\n");
-}
-
-void CCEnergyWavefunction::local_done() { outfile->Printf("    Local parameters free.\n"); }
-
-void CCEnergyWavefunction::local_filter_T1(dpdfile2 *T1) {
-    int ii;
-    double *T1tilde, *T1bar;
-    psio_address next;
-
-    auto nocc = local_.nocc;
+    /* The pair domains are fixed for the whole run, so read them once instead of on every filter call */
     auto nvir = local_.nvir;
-
-    /*   local.weak_pairs = init_int_array(nocc*nocc); */
+    psio_address next;
     local_.pairdom_len = init_int_array(nocc * nocc);
     local_.pairdom_nrlen = init_int_array(nocc * nocc);
     local_.eps_occ = init_array(nocc);
-    /*   psio_read_entry(CC_INFO, "Local Weak Pairs", (char *) local.weak_pairs, */
-    /* 		  local.nocc*local.nocc*sizeof(int)); */
     psio_read_entry(PSIF_CC_INFO, "Local Pair Domain Length", (char *)local_.pairdom_len, sizeof(int) * nocc * nocc);
     psio_read_entry(PSIF_CC_INFO, "Local Pair Domain NR Length", (char *)local_.pairdom_nrlen,
                     sizeof(int) * nocc * nocc);
@@ -124,6 +111,34 @@ void CCEnergyWavefunction::local_filter_T1(dpdfile2 *T1) {
                   sizeof(double) * local_.pairdom_len[ij] * local_.pairdom_nrlen[ij], next, &next);
     }
 
+    outfile->Printf("    Localization parameters ready.\n\n");
+}
+
+void CCEnergyWavefunction::local_done() {
+    auto nocc = local_.nocc;
+    for (int ij = 0; ij < nocc * nocc; ij++) {
+        free_block(local_.W[ij]);
+        free_block(local_.V[ij]);
+        free(local_.eps_vir[ij]);
+    }
+    free(local_.W);
+    free(local_.V);
+    free(local_.eps_vir);
+
+    free(local_.eps_occ);
+    free(local_.pairdom_len);
+    free(local_.pairdom_nrlen);
+
+    outfile->Printf("    Local parameters free.\n");
+}
+
+void CCEnergyWavefunction::local_filter_T1(dpdfile2 *T1) {
+    int ii;
+    double *T1tilde, *T1bar;
+
+    auto nocc = local_.nocc;
+    auto nvir = local_.nvir;
+
     global_dpd_->file2_mat_init(T1);
     global_dpd_->file2_mat_rd(T1);
 
@@ -163,73 +178,29 @@ void CCEnergyWavefunction::local_filter_T1(dpdfile2 *T1) {
 
     global_dpd_->file2_mat_wrt(T1);
     global_dpd_->file2_mat_close(T1);
-
-    for (int ij = 0; ij < nocc * nocc; ij++) {
-        free_block(local_.W[ij]);
-        free_block(local_.V[ij]);
-        free(local_.eps_vir[ij]);
-    }
-    free(local_.W);
-    free(local_.V);
-    free(local_.eps_vir);
-
-    free(local_.eps_occ);
-    free(local_.pairdom_len);
-    free(local_.pairdom_nrlen);
-    /*   free(local.weak_pairs); */
 }
 
 void CCEnergyWavefunction::local_filter_T2(dpdbuf4 *T2) {
-    psio_address next;
-
     auto nso = local_.nso;
     auto nocc = local_.nocc;
     auto nvir = local_.nvir;
 
-    /*   local.weak_pairs = init_int_array(nocc*nocc); */
-    local_.pairdom_len = init_int_array(nocc * nocc);
-    local_.pairdom_nrlen = init_int_array(nocc * nocc);
-    local_.eps_occ = init_array(nocc);
-    /*   psio_read_entry(CC_INFO, "Local Weak Pairs", (char *) local.weak_pairs, */
-    /* 		  local.nocc*local.nocc*sizeof(int)); */
-    psio_read_entry(PSIF_CC_INFO, "Local Pair Domain Length", (char *)local_.pairdom_len, sizeof(int) * nocc * nocc);
-    psio_read_entry(PSIF_CC_INFO, "Local Pair Domain NR Length", (char *)local_.pairdom_nrlen,
-                    sizeof(int) * nocc * nocc);
-    psio_read_entry(PSIF_CC_INFO, "Local Occupied Orbital Energies", (char *)local_.eps_occ, nocc * sizeof(double));
-
-    local_.W = (double ***)malloc(sizeof(double **) * nocc * nocc);
-    local_.V = (double ***)malloc(sizeof(double **) * nocc * nocc);
-    local_.eps_vir = (double **)malloc(sizeof(double *) * nocc * nocc);
-    next = PSIO_ZERO;
-    for (int ij = 0; ij < nocc * nocc; ij++) {
-        local_.eps_vir[ij] = init_array(local_.pairdom_nrlen[ij]);
-        psio_read(PSIF_CC_INFO, "Local Virtual Orbital Energies", (char *)local_.eps_vir[ij],
-                  local_.pairdom_nrlen[ij] * sizeof(double), next, &next);
-    }
-    next = PSIO_ZERO;
-    for (int ij = 0; ij < nocc * nocc; ij++) {
-        local_.V[ij] = block_matrix(nvir, local_.pairdom_len[ij]);
-        psio_read(PSIF_CC_INFO, "Local Residual Vector (V)", (char *)local_.V[ij][0],
-                  sizeof(double) * nvir * local_.pairdom_len[ij], next, &next);
-    }
-    next = PSIO_ZERO;
-    for (int ij = 0; ij < nocc * nocc; ij++) {
-        local_.W[ij] = block_matrix(local_.pairdom_len[ij], local_.pairdom_nrlen[ij]);
-        psio_read(PSIF_CC_INFO, "Local Transformation Matrix (W)", (char *)local_.W[ij][0],
-                  sizeof(double) * local_.pairdom_len[ij] * local_.pairdom_nrlen[ij], next, &next);
-    }
-
     /* Grab the MO-basis T2's */
     global_dpd_->buf4_mat_irrep_init(T2, 0);
     global_dpd_->buf4_mat_irrep_rd(T2, 0);
 
-    auto X1 = block_matrix(nso, nvir);
-    auto X2 = block_matrix(nvir, nso);
-    auto T2tilde = block_matrix(nso, nso);
-    auto T2bar = block_matrix(nvir, nvir);
-
-    for (int i = 0, ij = 0; i < nocc; i++) {
-        for (int j = 0; j < nocc; j++, ij++) {
+    /* Pairs are filtered independently, each thread works in its own scratch */
+#pragma omp parallel num_threads(params_.nthreads)
+    {
+        auto X1 = block_matrix(nso, nvir);
+        auto X2 = block_matrix(nvir, nso);
+        auto T2tilde = block_matrix(nso, nso);
+        auto T2bar = block_matrix(nvir, nvir);
+
+#pragma omp for schedule(dynamic)
+        for (int ij = 0; ij < nocc * nocc; ij++) {
+            int i = ij / nocc;
+            int j = ij % nocc;
             if (!local_.weak_pairs[ij]) {
                 /* Transform the virtuals to the redundant projected virtual basis */
                 C_DGEMM('t', 'n', local_.pairdom_len[ij], nvir, nvir, 1.0, &(local_.V[ij][0][0]),
@@ -263,30 +234,16 @@ void CCEnergyWavefunction::local_filter_T2(dpdbuf4 *T2) {
             } else /* This must be a neglected weak pair; force it to zero */
                 memset((void *)T2->matrix[0][ij], 0, sizeof(double) * nvir * nvir);
         }
-    }
 
-    free_block(X1);
-    free_block(X2);
-    free_block(T2tilde);
-    free_block(T2bar);
+        free_block(X1);
+        free_block(X2);
+        free_block(T2tilde);
+        free_block(T2bar);
+    }
 
     /* Write the updated MO-basis T2's to disk */
     global_dpd_->buf4_mat_irrep_wrt(T2, 0);
     global_dpd_->buf4_mat_irrep_close(T2, 0);
-
-    for (int i = 0; i < nocc * nocc; i++) {
-        free_block(local_.W[i]);
-        free_block(local_.V[i]);
-        free(local_.eps_vir[i]);
-    }
-    free(local_.W);
-    free(local_.V);
-    free(local_.eps_vir);
-
-    free(local_.eps_occ);
-    free(local_.pairdom_len);
-    free(local_.pairdom_nrlen);
-    /*   free(local.weak_pairs); */
 }
 }  // namespace ccenergy
 }  // namespace psi
@@ -32,7 +32,9 @@
 */
 #include <cstdio>
 #include <cstdlib>
+#include <algorithm>
 #include <string>
+#include <vector>
 #include "psi4/libciomr/libciomr.h"
 #include "psi4/libpsio/psio.h"
 #include "psi4/libqt/qt.h"
@@ -57,148 +59,14 @@ void WabefDD(int i, int C_irr) {
     dpdbuf4 CMNEF, Cmnef, CMnEf, X, F, tau, D, WM, WP, Z;
     char CMNEF_lbl[32], Cmnef_lbl[32], CMnEf_lbl[32];
     char SIJAB_lbl[32], Sijab_lbl[32], SIjAb_lbl[32], SIA_lbl[32], Sia_lbl[32];
-    char lbl_a[32], lbl_s[32];
-    dpdbuf4 tau_a, tau_s;
-    dpdbuf4 B_a, B_s;
-    dpdbuf4 S, A;
-    double **B_diag, **tau_diag;
-    int ij, Gc, C, c, cc;
-    int nbuckets, rows_per_bucket, rows_left, m, row_start, ab, cd, dc, d;
-    int nrows, ncols, nlinks;
-    psio_address next;
 
     if (params.eom_ref == 0) { /* RHF */
         /* SIjAb += WAbEf*CIjEf */
         sprintf(SIjAb_lbl, "%s %d", "SIjAb", i);
         sprintf(CMnEf_lbl, "%s %d", "CMnEf", i);
 
-        /* SIjAb += <Ab|Ef> CIjEf -- allow out of core algorithm */
-
-        timer_on("WabefDD Z");
-
-        if (params.abcd == "OLD") {
-            global_dpd_->buf4_init(&CMnEf, PSIF_EOM_CMnEf, C_irr, 0, 5, 0, 5, 0, CMnEf_lbl);
-            global_dpd_->buf4_init(&Z, PSIF_EOM_TMP, C_irr, 5, 0, 5, 0, 0, "WabefDD Z(Ab,Ij)");
-            global_dpd_->buf4_init(&B, PSIF_CC_BINTS, H_IRR, 5, 5, 5, 5, 0, "B <ab|cd>");
-            global_dpd_->contract444(&B, &CMnEf, &Z, 0, 0, 1.0, 0.0);
-            global_dpd_->buf4_close(&B);
-            global_dpd_->buf4_close(&CMnEf);
-            global_dpd_->buf4_sort(&Z, PSIF_EOM_TMP, rspq, 0, 5, "WabefDD Z(Ij,Ab)");
-            global_dpd_->buf4_close(&Z);
-
-            global_dpd_->buf4_init(&SIjAb, PSIF_EOM_SIjAb, C_irr, 0, 5, 0, 5, 0, SIjAb_lbl);
-            global_dpd_->buf4_init(&Z, PSIF_EOM_TMP, C_irr, 0, 5, 0, 5, 0, "WabefDD Z(Ij,Ab)");
-            global_dpd_->buf4_axpy(&Z, &SIjAb, 1);
-            global_dpd_->buf4_close(&Z);
-            global_dpd_->buf4_close(&SIjAb);
-        } else if (params.abcd == "NEW") {
-            sprintf(lbl_a, "CMnEf(-)(mn,ef) %d", i);
-            sprintf(lbl_s, "CMnEf(+)(mn,ef) %d", i);
-
-            /* L_a(-)(ij,ab) (i>j, a>b) = L(ij,ab) - L(ij,ba) */
-            global_dpd_->buf4_init(&tau_a, PSIF_EOM_CMnEf, C_irr, 4, 9, 0, 5, 1, CMnEf_lbl);
-            global_dpd_->buf4_copy(&tau_a, PSIF_EOM_CMnEf, lbl_a);
-            global_dpd_->buf4_close(&tau_a);
-
-            /* L_s(+)(ij,ab) (i>=j, a>=b) = L(ij,ab) + L(ij,ba) */
-            global_dpd_->buf4_init(&tau_a, PSIF_EOM_CMnEf, C_irr, 0, 5, 0, 5, 0, CMnEf_lbl);
-            global_dpd_->buf4_copy(&tau_a, PSIF_EOM_TMP, lbl_s);
-            global_dpd_->buf4_sort_axpy(&tau_a, PSIF_EOM_TMP, pqsr, 0, 5, lbl_s, 1);
-            global_dpd_->buf4_close(&tau_a);
-            global_dpd_->buf4_init(&tau_a, PSIF_EOM_TMP, C_irr, 3, 8, 0, 5, 0, lbl_s);
-            global_dpd_->buf4_copy(&tau_a, PSIF_EOM_CMnEf, lbl_s);
-            global_dpd_->buf4_close(&tau_a);
-
-            timer_on("ABCD:S");
-            global_dpd_->buf4_init(&tau_s, PSIF_EOM_CMnEf, C_irr, 3, 8, 3, 8, 0, lbl_s);
-            global_dpd_->buf4_init(&B_s, PSIF_CC_BINTS, 0, 8, 8, 8, 8, 0, "B(+) <ab|cd> + <ab|dc>");
-            global_dpd_->buf4_init(&S, PSIF_EOM_TMP, C_irr, 8, 3, 8, 3, 0, "S(ab,ij)");
-            global_dpd_->contract444(&B_s, &tau_s, &S, 0, 0, 0.5, 0);
-            global_dpd_->buf4_close(&S);
-            global_dpd_->buf4_close(&B_s);
-            global_dpd_->buf4_close(&tau_s);
-            timer_off("ABCD:S");
-
-            /* L_diag(ij,c)  = 2 * L(ij,cc)*/
-
-            /* NB: Gcc = 0, and B is totally symmetric, so Gab = 0 */
-            /* But Gij = L_irr ^ Gab = L_irr */
-            global_dpd_->buf4_init(&tau, PSIF_EOM_CMnEf, C_irr, 3, 8, 3, 8, 0, lbl_s);
-            global_dpd_->buf4_mat_irrep_init(&tau, C_irr);
-            global_dpd_->buf4_mat_irrep_rd(&tau, C_irr);
-            tau_diag = global_dpd_->dpd_block_matrix(tau.params->rowtot[C_irr], moinfo.nvirt);
-            for (ij = 0; ij < tau.params->rowtot[C_irr]; ij++)
-                for (Gc = 0; Gc < moinfo.nirreps; Gc++)
-                    for (C = 0; C < moinfo.virtpi[Gc]; C++) {
-                        c = C + moinfo.vir_off[Gc];
-                        cc = tau.params->colidx[c][c];
-                        tau_diag[ij][c] = tau.matrix[C_irr][ij][cc];
-                    }
-            global_dpd_->buf4_mat_irrep_close(&tau, C_irr);
-
-            global_dpd_->buf4_init(&B_s, PSIF_CC_BINTS, 0, 8, 8, 8, 8, 0, "B(+) <ab|cd> + <ab|dc>");
-            global_dpd_->buf4_init(&S, PSIF_EOM_TMP, C_irr, 8, 3, 8, 3, 0, "S(ab,ij)");
-            global_dpd_->buf4_mat_irrep_init(&S, 0);
-            global_dpd_->buf4_mat_irrep_rd(&S, 0);
-
-            rows_per_bucket = dpd_memfree() / (B_s.params->coltot[0] + moinfo.nvirt);
-            if (rows_per_bucket > B_s.params->rowtot[0]) rows_per_bucket = B_s.params->rowtot[0];
-            nbuckets = (int)ceil((double)B_s.params->rowtot[0] / (double)rows_per_bucket);
-            rows_left = B_s.params->rowtot[0] % rows_per_bucket;
-
-            B_diag = global_dpd_->dpd_block_matrix(rows_per_bucket, moinfo.nvirt);
-            next = PSIO_ZERO;
-            ncols = tau.params->rowtot[C_irr];
-            nlinks = moinfo.nvirt;
-            for (m = 0; m < (rows_left ? nbuckets - 1 : nbuckets); m++) {
-                row_start = m * rows_per_bucket;
-                nrows = rows_per_bucket;
-                if (nrows && ncols && nlinks) {
-                    psio_read(PSIF_CC_BINTS, "B(+) <ab|cc>", (char *)B_diag[0], sizeof(double) * nrows * nlinks, next,
-                              &next);
-                    C_DGEMM('n', 't', nrows, ncols, nlinks, -0.25, B_diag[0], nlinks, tau_diag[0], nlinks, 1,
-                            S.matrix[0][row_start], ncols);
-                }
-            }
-            if (rows_left) {
-                row_start = m * rows_per_bucket;
-                nrows = rows_left;
-                if (nrows && ncols && nlinks) {
-                    psio_read(PSIF_CC_BINTS, "B(+) <ab|cc>", (char *)B_diag[0], sizeof(double) * nrows * nlinks, next,
-                              &next);
-                    C_DGEMM('n', 't', nrows, ncols, nlinks, -0.25, B_diag[0], nlinks, tau_diag[0], nlinks, 1,
-                            S.matrix[0][row_start], ncols);
-                }
-            }
-            global_dpd_->buf4_mat_irrep_wrt(&S, 0);
-            global_dpd_->buf4_mat_irrep_close(&S, 0);
-            global_dpd_->buf4_close(&S);
-            global_dpd_->buf4_close(&B_s);
-            global_dpd_->free_dpd_block(B_diag, rows_per_bucket, moinfo.nvirt);
-            global_dpd_->free_dpd_block(tau_diag, tau.params->rowtot[C_irr], moinfo.nvirt);
-            global_dpd_->buf4_close(&tau);
-
-            timer_on("ABCD:A");
-            global_dpd_->buf4_init(&tau_a, PSIF_EOM_CMnEf, C_irr, 4, 9, 4, 9, 0, lbl_a);
-            global_dpd_->buf4_init(&B_a, PSIF_CC_BINTS, 0, 9, 9, 9, 9, 0, "B(-) <ab|cd> - <ab|dc>");
-            global_dpd_->buf4_init(&A, PSIF_EOM_TMP, C_irr, 9, 4, 9, 4, 0, "A(ab,ij)");
-            global_dpd_->contract444(&B_a, &tau_a, &A, 0, 0, 0.5, 0);
-            global_dpd_->buf4_close(&A);
-            global_dpd_->buf4_close(&B_a);
-            global_dpd_->buf4_close(&tau_a);
-            timer_off("ABCD:A");
-
-            timer_on("ABCD:axpy");
-            global_dpd_->buf4_init(&S, PSIF_EOM_TMP, C_irr, 5, 0, 8, 3, 0, "S(ab,ij)");
-            global_dpd_->buf4_sort_axpy(&S, PSIF_EOM_SIjAb, rspq, 0, 5, SIjAb_lbl, 1);
-            global_dpd_->buf4_close(&S);
-            global_dpd_->buf4_init(&A, PSIF_EOM_TMP, C_irr, 5, 0, 9, 4, 0, "A(ab,ij)");
-            global_dpd_->buf4_sort_axpy(&A, PSIF_EOM_SIjAb, rspq, 0, 5, SIjAb_lbl, 1);
-            global_dpd_->buf4_close(&A);
-            timer_off("ABCD:axpy");
-        }
-
-        timer_off("WabefDD Z");
+        /* SIjAb += <Ab|Ef> CIjEf is built for all new C vectors at once
+           by WabefDD_RHF_abcd() */
 
         /* construct XIjMb = CIjEf * <mb|ef> */
         global_dpd_->buf4_init(&X, PSIF_EOM_TMP, C_irr, 10, 0, 10, 0, 0, "WabefDD X(Mb,Ij)");
@@ -525,5 +393,195 @@ void WabefDD(int i, int C_irr) {
     return;
 }
 
+/* Out_n(ij,ab) (+)= alpha * In_n(ij,cd) B(ab,cd) for a batch of C vectors n.
+   B is read only once, in buckets of rows, and each bucket is contracted with
+   all vectors of the batch in a single GEMM: the irreps of the In_n and Out_n
+   are stacked one on top of the other as rows of one matrix.  If B_diag_lbl
+   is given, the -1/4 In_n(ij,cc) <ab|cc> correction of the symmetric ABCD
+   algorithm is applied to the totally symmetric ab block as well. */
+static void WabefDD_abcd_batch(dpdbuf4 *B, std::vector<dpdbuf4> &In, std::vector<dpdbuf4> &Out, int C_irr,
+                               double alpha, bool accumulate, const char *B_diag_lbl) {
+    int nvec = In.size();
+    int nvirt = moinfo.nvirt;
+
+    for (int h = 0; h < moinfo.nirreps; h++) {
+        int Gij = h ^ C_irr;
+        long int nij = In[0].params->rowtot[Gij];
+        long int ncd = B->params->coltot[h];
+        long int nab = B->params->rowtot[h];
+        if (!nij || !nab) continue;
+        long int nstack = nvec * nij;
+
+        double **C_stack = global_dpd_->dpd_block_matrix(nstack, ncd);
+        double **S_stack = global_dpd_->dpd_block_matrix(nstack, nab);
+        for (int n = 0; n < nvec; n++) {
+            In[n].matrix[Gij] = &C_stack[n * nij];
+            global_dpd_->buf4_mat_irrep_rd(&In[n], Gij);
+            Out[n].matrix[Gij] = &S_stack[n * nij];
+            if (accumulate) global_dpd_->buf4_mat_irrep_rd(&Out[n], Gij);
+        }
+
+        long int rows_per_bucket = (ncd ? dpd_memfree() / ncd : nab);
+        if (rows_per_bucket > nab) rows_per_bucket = nab;
+        if (rows_per_bucket < 1) rows_per_bucket = 1;
+        if (ncd) {
+            B->matrix[h] = global_dpd_->dpd_block_matrix(rows_per_bucket, ncd);
+            for (long int row_start = 0; row_start < nab; row_start += rows_per_bucket) {
+                long int nrows = std::min(rows_per_bucket, nab - row_start);
+                global_dpd_->buf4_mat_irrep_rd_block(B, h, row_start, nrows);
+                C_DGEMM('n', 't', nstack, nrows, ncd, alpha, C_stack[0], ncd, B->matrix[h][0], ncd, 1.0,
+                        &S_stack[0][row_start], nab);
+            }
+            global_dpd_->free_dpd_block(B->matrix[h], rows_per_bucket, ncd);
+        }
+
+        if (B_diag_lbl != nullptr && h == 0 && nvirt) {
+            /* In_diag(ij,c) = In(ij,cc) */
+            double **In_diag = global_dpd_->dpd_block_matrix(nstack, nvirt);
+            for (long int ij = 0; ij < nstack; ij++)
+                for (int Gc = 0; Gc < moinfo.nirreps; Gc++)
+                    for (int C = 0; C < moinfo.virtpi[Gc]; C++) {
+                        int c = C + moinfo.vir_off[Gc];
+                        In_diag[ij][c] = C_stack[ij][In[0].params->colidx[c][c]];
+                    }
+
+            rows_per_bucket = dpd_memfree() / nvirt;
+            if (rows_per_bucket > nab) rows_per_bucket = nab;
+            if (rows_per_bucket < 1) rows_per_bucket = 1;
+            double **B_diag = global_dpd_->dpd_block_matrix(rows_per_bucket, nvirt);
+            psio_address next = PSIO_ZERO;
+            for (long int row_start = 0; row_start < nab; row_start += rows_per_bucket) {
+                long int nrows = std::min(rows_per_bucket, nab - row_start);
+                psio_read(PSIF_CC_BINTS, B_diag_lbl, (char *)B_diag[0], sizeof(double) * nrows * nvirt, next, &next);
+                C_DGEMM('n', 't', nstack, nrows, nvirt, -0.25, In_diag[0], nvirt, B_diag[0], nvirt, 1.0,
+                        &S_stack[0][row_start], nab);
+            }
+            global_dpd_->free_dpd_block(B_diag, rows_per_bucket, nvirt);
+            global_dpd_->free_dpd_block(In_diag, nstack, nvirt);
+        }
+
+        for (int n = 0; n < nvec; n++) {
+            global_dpd_->buf4_mat_irrep_wrt(&Out[n], Gij);
+            In[n].matrix[Gij] = nullptr;
+            Out[n].matrix[Gij] = nullptr;
+        }
+        global_dpd_->free_dpd_block(C_stack, nstack, ncd);
+        global_dpd_->free_dpd_block(S_stack, nstack, nab);
+    }
+}
+
+/* This function computes the <Ab|Ef> CIjEf contribution of the H-bar
+   doubles-doubles block to the RHF Sigma vectors first,...,last-1.  The
+   vectors are taken in batches as large as memory allows, and the B
+   integrals are read once per batch rather than once per vector. */
+
+void WabefDD_RHF_abcd(int first, int last, int C_irr) {
+    dpdbuf4 B, C, tau_a;
+    char lbl[32], lbl_a[32], lbl_s[32];
+
+    /* size of the stacked C and Sigma irreps for one vector */
+    sprintf(lbl, "%s %d", "CMnEf", first);
+    global_dpd_->buf4_init(&C, PSIF_EOM_CMnEf, C_irr, 0, 5, 0, 5, 0, lbl);
+    long int vec_words = 0;
+    for (int h = 0; h < moinfo.nirreps; h++)
+        vec_words = std::max(vec_words, 2L * C.params->rowtot[h] * C.params->coltot[h ^ C_irr]);
+    global_dpd_->buf4_close(&C);
+
+    /* leave at least half of the memory for the B buckets */
+    int max_vec = (vec_words ? dpd_memfree() / 2 / vec_words : last - first);
+    if (max_vec < 1) max_vec = 1;
+
+    for (int start = first; start < last; start += max_vec) {
+        int nvec = std::min(max_vec, last - start);
+        std::vector<dpdbuf4> In(nvec), Out(nvec);
+
+        if (params.abcd == "OLD") {
+            /* SIjAb += <Ab|Ef> CIjEf */
+            for (int n = 0; n < nvec; n++) {
+                sprintf(lbl, "%s %d", "CMnEf", start + n);
+                global_dpd_->buf4_init(&In[n], PSIF_EOM_CMnEf, C_irr, 0, 5, 0, 5, 0, lbl);
+                sprintf(lbl, "%s %d", "SIjAb", start + n);
+                global_dpd_->buf4_init(&Out[n], PSIF_EOM_SIjAb, C_irr, 0, 5, 0, 5, 0, lbl);
+            }
+            global_dpd_->buf4_init(&B, PSIF_CC_BINTS, H_IRR, 5, 5, 5, 5, 0, "B <ab|cd>");
+            WabefDD_abcd_batch(&B, In, Out, C_irr, 1.0, true, nullptr);
+            global_dpd_->buf4_close(&B);
+            for (int n = 0; n < nvec; n++) {
+                global_dpd_->buf4_close(&In[n]);
+                global_dpd_->buf4_close(&Out[n]);
+            }
+        } else if (params.abcd == "NEW") {
+            for (int n = 0; n < nvec; n++) {
+                sprintf(lbl, "%s %d", "CMnEf", start + n);
+                sprintf(lbl_a, "CMnEf(-)(mn,ef) %d", start + n);
+                sprintf(lbl_s, "CMnEf(+)(mn,ef) %d", start + n);
+
+                /* L_a(-)(ij,ab) (i>j, a>b) = L(ij,ab) - L(ij,ba) */
+                global_dpd_->buf4_init(&tau_a, PSIF_EOM_CMnEf, C_irr, 4, 9, 0, 5, 1, lbl);
+                global_dpd_->buf4_copy(&tau_a, PSIF_EOM_CMnEf, lbl_a);
+                global_dpd_->buf4_close(&tau_a);
+
+                /* L_s(+)(ij,ab) (i>=j, a>=b) = L(ij,ab) + L(ij,ba) */
+                global_dpd_->buf4_init(&tau_a, PSIF_EOM_CMnEf, C_irr, 0, 5, 0, 5, 0, lbl);
+                global_dpd_->buf4_copy(&tau_a, PSIF_EOM_TMP, lbl_s);
+                global_dpd_->buf4_sort_axpy(&tau_a, PSIF_EOM_TMP, pqsr, 0, 5, lbl_s, 1);
+                global_dpd_->buf4_close(&tau_a);
+                global_dpd_->buf4_init(&tau_a, PSIF_EOM_TMP, C_irr, 3, 8, 0, 5, 0, lbl_s);
+                global_dpd_->buf4_copy(&tau_a, PSIF_EOM_CMnEf, lbl_s);
+                global_dpd_->buf4_close(&tau_a);
+            }
+
+            timer_on("ABCD:S");
+            for (int n = 0; n < nvec; n++) {
+                sprintf(lbl_s, "CMnEf(+)(mn,ef) %d", start + n);
+                global_dpd_->buf4_init(&In[n], PSIF_EOM_CMnEf, C_irr, 3, 8, 3, 8, 0, lbl_s);
+                sprintf(lbl, "S(ij,ab) %d", start + n);
+                global_dpd_->buf4_init(&Out[n], PSIF_EOM_TMP, C_irr, 3, 8, 3, 8, 0, lbl);
+            }
+            global_dpd_->buf4_init(&B, PSIF_CC_BINTS, 0, 8, 8, 8, 8, 0, "B(+) <ab|cd> + <ab|dc>");
+            WabefDD_abcd_batch(&B, In, Out, C_irr, 0.5, false, "B(+) <ab|cc>");
+            global_dpd_->buf4_close(&B);
+            for (int n = 0; n < nvec; n++) {
+                global_dpd_->buf4_close(&In[n]);
+                global_dpd_->buf4_close(&Out[n]);
+            }
+            timer_off("ABCD:S");
+
+            timer_on("ABCD:A");
+            for (int n = 0; n < nvec; n++) {
+                sprintf(lbl_a, "CMnEf(-)(mn,ef) %d", start + n);
+                global_dpd_->buf4_init(&In[n], PSIF_EOM_CMnEf, C_irr, 4, 9, 4, 9, 0, lbl_a);
+                sprintf(lbl, "A(ij,ab) %d", start + n);
+                global_dpd_->buf4_init(&Out[n], PSIF_EOM_TMP, C_irr, 4, 9, 4, 9, 0, lbl);
+            }
+            global_dpd_->buf4_init(&B, PSIF_CC_BINTS, 0, 9, 9, 9, 9, 0, "B(-) <ab|cd> - <ab|dc>");
+            WabefDD_abcd_batch(&B, In, Out, C_irr, 0.5, false, nullptr);
+            global_dpd_->buf4_close(&B);
+            for (int n = 0; n < nvec; n++) {
+                global_dpd_->buf4_close(&In[n]);
+                global_dpd_->buf4_close(&Out[n]);
+            }
+            timer_off("ABCD:A");
+
+            timer_on("ABCD:axpy");
+            for (int n = 0; n < nvec; n++) {
+                dpdbuf4 SIjAb, S, A;
+                sprintf(lbl, "%s %d", "SIjAb", start + n);
+                global_dpd_->buf4_init(&SIjAb, PSIF_EOM_SIjAb, C_irr, 0, 5, 0, 5, 0, lbl);
+                sprintf(lbl, "S(ij,ab) %d", start + n);
+                global_dpd_->buf4_init(&S, PSIF_EOM_TMP, C_irr, 0, 5, 3, 8, 0, lbl);
+                global_dpd_->buf4_axpy(&S, &SIjAb, 1);
+                global_dpd_->buf4_close(&S);
+                sprintf(lbl, "A(ij,ab) %d", start + n);
+                global_dpd_->buf4_init(&A, PSIF_EOM_TMP, C_irr, 0, 5, 4, 9, 0, lbl);
+                global_dpd_->buf4_axpy(&A, &SIjAb, 1);
+                global_dpd_->buf4_close(&A);
+                global_dpd_->buf4_close(&SIjAb);
+            }
+            timer_off("ABCD:axpy");
+        }
+    }
+}
+
 }  // namespace cceom
 }  // namespace psi
@@ -93,6 +93,7 @@ void sigmaSS(int index, int irrep);
 void sigmaSD(int index, int irrep);
 void sigmaDS(int index, int irrep);
 void sigmaDD(int index, int irrep);
+void WabefDD_RHF_abcd(int first, int last, int C_irr);
 void sigma00(int index, int irrep);
 void sigma0S(int index, int irrep);
 void sigma0D(int index, int irrep);
@@ -327,7 +328,19 @@ void diag(ccenergy::CCEnergyWavefunction& wfn) {
                 if (params.full_matrix) init_S0(i);
                 init_S1(i, C_irr);
                 init_S2(i, C_irr);
+            }
+
+            /* The RHF <ab|cd> term is built for all new C vectors together,
+               reading the B integrals once per batch of vectors */
+            if (params.eom_ref == 0 && params.wfn != "EOM_CC2" && already_sigma < L) {
+                timer_on("SIGMA ALL");
+                timer_on("WabefDD ABCD");
+                WabefDD_RHF_abcd(already_sigma, L, C_irr);
+                timer_off("WabefDD ABCD");
+                timer_off("SIGMA ALL");
+            }
 
+            for (int i = already_sigma; i < L; ++i) {
                 sort_C(i, C_irr);
 
 /* Computing sigma vectors */
@@ -35,6 +35,7 @@
 #include "MOInfo.h"
 #include "Params.h"
 #include "Local.h"
+#include "psi4/cc/sort_registry.h"
 #define EXTERN
 #include "globals.h"
 
@@ -45,83 +46,142 @@ void hbar_extra() {
     dpdbuf4 W, W1, W2, WAmEf, WmBeJ, WmBEj, WmNIe, WMnIe;
 
     if (params.eom_ref == 2) {
-        global_dpd_->buf4_init(&W, PSIF_CC_HBAR, H_IRR, 20, 20, 20, 20, 0, "WMBEJ");
-        global_dpd_->buf4_sort(&W, PSIF_CC_HBAR, rspq, 20, 20, "WMBEJ (JB,ME)");
-        global_dpd_->buf4_close(&W);
-        global_dpd_->buf4_init(&W, PSIF_CC_HBAR, H_IRR, 30, 20, 30, 20, 0, "WmBeJ"); /* (me,JB) */
-        global_dpd_->buf4_sort(&W, PSIF_CC_HBAR, rspq, 20, 30, "WmBeJ (JB,me)");
-        global_dpd_->buf4_close(&W);
-        global_dpd_->buf4_init(&W, PSIF_CC_HBAR, H_IRR, 30, 30, 30, 30, 0, "Wmbej");
-        global_dpd_->buf4_sort(&W, PSIF_CC_HBAR, rspq, 30, 30, "Wmbej (jb,me)");
-        global_dpd_->buf4_close(&W);
-        global_dpd_->buf4_init(&W, PSIF_CC_HBAR, H_IRR, 20, 30, 20, 30, 0, "WMbEj"); /* (ME,jb) */
-        global_dpd_->buf4_sort(&W, PSIF_CC_HBAR, rspq, 30, 20, "WMbEj (jb,ME)");
-        global_dpd_->buf4_close(&W);
+        if (!sort_registry_has(PSIF_CC_HBAR, "WMBEJ (JB,ME)", H_IRR)) {
+            global_dpd_->buf4_init(&W, PSIF_CC_HBAR, H_IRR, 20, 20, 20, 20, 0, "WMBEJ");
+            global_dpd_->buf4_sort(&W, PSIF_CC_HBAR, rspq, 20, 20, "WMBEJ (JB,ME)");
+            global_dpd_->buf4_close(&W);
+            sort_registry_add(PSIF_CC_HBAR, "WMBEJ (JB,ME)", H_IRR);
+        }
+        if (!sort_registry_has(PSIF_CC_HBAR, "WmBeJ (JB,me)", H_IRR)) {
+            global_dpd_->buf4_init(&W, PSIF_CC_HBAR, H_IRR, 30, 20, 30, 20, 0, "WmBeJ"); /* (me,JB) */
+            global_dpd_->buf4_sort(&W, PSIF_CC_HBAR, rspq, 20, 30, "WmBeJ (JB,me)");
+            global_dpd_->buf4_close(&W);
+            sort_registry_add(PSIF_CC_HBAR, "WmBeJ (JB,me)", H_IRR);
+        }
+        if (!sort_registry_has(PSIF_CC_HBAR, "Wmbej (jb,me)", H_IRR)) {
+            global_dpd_->buf4_init(&W, PSIF_CC_HBAR, H_IRR, 30, 30, 30, 30, 0, "Wmbej");
+            global_dpd_->buf4_sort(&W, PSIF_CC_HBAR, rspq, 30, 30, "Wmbej (jb,me)");
+            global_dpd_->buf4_close(&W);
+            sort_registry_add(PSIF_CC_HBAR, "Wmbej (jb,me)", H_IRR);
+        }
+        if (!sort_registry_has(PSIF_CC_HBAR, "WMbEj (jb,ME)", H_IRR)) {
+            global_dpd_->buf4_init(&W, PSIF_CC_HBAR, H_IRR, 20, 30, 20, 30, 0, "WMbEj"); /* (ME,jb) */
+            global_dpd_->buf4_sort(&W, PSIF_CC_HBAR, rspq, 30, 20, "WMbEj (jb,ME)");
+            global_dpd_->buf4_close(&W);
+            sort_registry_add(PSIF_CC_HBAR, "WMbEj (jb,ME)", H_IRR);
+        }
 
-        global_dpd_->buf4_init(&W, PSIF_CC_HBAR, H_IRR, 27, 23, 27, 23, 0, "WmBiJ");
-        global_dpd_->buf4_sort(&W, PSIF_CC_HBAR, pqsr, 27, 22, "WmBiJ (mB,Ji)");
-        global_dpd_->buf4_close(&W);
-        global_dpd_->buf4_init(&W, PSIF_CC_HBAR, H_IRR, 27, 22, 27, 22, 0, "WmBiJ (mB,Ji)");
-        global_dpd_->buf4_sort(&W, PSIF_CC_HBAR, qprs, 26, 22, "WmBiJ (Bm,Ji)");
-        global_dpd_->buf4_close(&W);
+        if (!sort_registry_has(PSIF_CC_HBAR, "WmBiJ (mB,Ji)", H_IRR)) {
+            global_dpd_->buf4_init(&W, PSIF_CC_HBAR, H_IRR, 27, 23, 27, 23, 0, "WmBiJ");
+            global_dpd_->buf4_sort(&W, PSIF_CC_HBAR, pqsr, 27, 22, "WmBiJ (mB,Ji)");
+            global_dpd_->buf4_close(&W);
+            sort_registry_add(PSIF_CC_HBAR, "WmBiJ (mB,Ji)", H_IRR);
+        }
+        if (!sort_registry_has(PSIF_CC_HBAR, "WmBiJ (Bm,Ji)", H_IRR)) {
+            global_dpd_->buf4_init(&W, PSIF_CC_HBAR, H_IRR, 27, 22, 27, 22, 0, "WmBiJ (mB,Ji)");
+            global_dpd_->buf4_sort(&W, PSIF_CC_HBAR, qprs, 26, 22, "WmBiJ (Bm,Ji)");
+            global_dpd_->buf4_close(&W);
+            sort_registry_add(PSIF_CC_HBAR, "WmBiJ (Bm,Ji)", H_IRR);
+        }
 
-        global_dpd_->buf4_init(&W, PSIF_CC_HBAR, H_IRR, 25, 29, 25, 29, 0, "WeIaB");
-        global_dpd_->buf4_sort(&W, PSIF_CC_HBAR, qprs, 24, 29, "WeIaB (Ie,aB)");
-        global_dpd_->buf4_close(&W);
-        global_dpd_->buf4_init(&W, PSIF_CC_HBAR, H_IRR, 24, 29, 24, 29, 0, "WeIaB (Ie,aB)");
-        global_dpd_->buf4_sort(&W, PSIF_CC_HBAR, pqsr, 24, 28, "WeIaB (Ie,Ab)");
-        global_dpd_->buf4_close(&W);
+        if (!sort_registry_has(PSIF_CC_HBAR, "WeIaB (Ie,aB)", H_IRR)) {
+            global_dpd_->buf4_init(&W, PSIF_CC_HBAR, H_IRR, 25, 29, 25, 29, 0, "WeIaB");
+            global_dpd_->buf4_sort(&W, PSIF_CC_HBAR, qprs, 24, 29, "WeIaB (Ie,aB)");
+            global_dpd_->buf4_close(&W);
+            sort_registry_add(PSIF_CC_HBAR, "WeIaB (Ie,aB)", H_IRR);
+        }
+        if (!sort_registry_has(PSIF_CC_HBAR, "WeIaB (Ie,Ab)", H_IRR)) {
+            global_dpd_->buf4_init(&W, PSIF_CC_HBAR, H_IRR, 24, 29, 24, 29, 0, "WeIaB (Ie,aB)");
+            global_dpd_->buf4_sort(&W, PSIF_CC_HBAR, pqsr, 24, 28, "WeIaB (Ie,Ab)");
+            global_dpd_->buf4_close(&W);
+            sort_registry_add(PSIF_CC_HBAR, "WeIaB (Ie,Ab)", H_IRR);
+        }
     }
 
     if (params.eom_ref == 1) {
-        global_dpd_->buf4_init(&W, PSIF_CC_HBAR, H_IRR, 10, 10, 10, 10, 0, "WMBEJ");
-        global_dpd_->buf4_sort(&W, PSIF_CC_HBAR, rspq, 10, 10, "WMBEJ (JB,ME)");
-        global_dpd_->buf4_close(&W);
-        global_dpd_->buf4_init(&W, PSIF_CC_HBAR, H_IRR, 10, 10, 10, 10, 0, "WmBeJ");
-        global_dpd_->buf4_sort(&W, PSIF_CC_HBAR, rspq, 10, 10, "WmBeJ (JB,me)");
-        global_dpd_->buf4_close(&W);
-        global_dpd_->buf4_init(&W, PSIF_CC_HBAR, H_IRR, 10, 10, 10, 10, 0, "Wmbej");
-        global_dpd_->buf4_sort(&W, PSIF_CC_HBAR, rspq, 10, 10, "Wmbej (jb,me)");
-        global_dpd_->buf4_close(&W);
-        global_dpd_->buf4_init(&W, PSIF_CC_HBAR, H_IRR, 10, 10, 10, 10, 0, "WMbEj");
-        global_dpd_->buf4_sort(&W, PSIF_CC_HBAR, rspq, 10, 10, "WMbEj (jb,ME)");
-        global_dpd_->buf4_close(&W);
+        if (!sort_registry_has(PSIF_CC_HBAR, "WMBEJ (JB,ME)", H_IRR)) {
+            global_dpd_->buf4_init(&W, PSIF_CC_HBAR, H_IRR, 10, 10, 10, 10, 0, "WMBEJ");
+            global_dpd_->buf4_sort(&W, PSIF_CC_HBAR, rspq, 10, 10, "WMBEJ (JB,ME)");
+            global_dpd_->buf4_close(&W);
+            sort_registry_add(PSIF_CC_HBAR, "WMBEJ (JB,ME)", H_IRR);
+        }
+        if (!sort_registry_has(PSIF_CC_HBAR, "WmBeJ (JB,me)", H_IRR)) {
+            global_dpd_->buf4_init(&W, PSIF_CC_HBAR, H_IRR, 10, 10, 10, 10, 0, "WmBeJ");
+            global_dpd_->buf4_sort(&W, PSIF_CC_HBAR, rspq, 10, 10, "WmBeJ (JB,me)");
+            global_dpd_->buf4_close(&W);
+            sort_registry_add(PSIF_CC_HBAR, "WmBeJ (JB,me)", H_IRR);
+        }
+        if (!sort_registry_has(PSIF_CC_HBAR, "Wmbej (jb,me)", H_IRR)) {
+            global_dpd_->buf4_init(&W, PSIF_CC_HBAR, H_IRR, 10, 10, 10, 10, 0, "Wmbej");
+            global_dpd_->buf4_sort(&W, PSIF_CC_HBAR, rspq, 10, 10, "Wmbej (jb,me)");
+            global_dpd_->buf4_close(&W);
+            sort_registry_add(PSIF_CC_HBAR, "Wmbej (jb,me)", H_IRR);
+        }
+        if (!sort_registry_has(PSIF_CC_HBAR, "WMbEj (jb,ME)", H_IRR)) {
+            global_dpd_->buf4_init(&W, PSIF_CC_HBAR, H_IRR, 10, 10, 10, 10, 0, "WMbEj");
+            global_dpd_->buf4_sort(&W, PSIF_CC_HBAR, rspq, 10, 10, "WMbEj (jb,ME)");
+            global_dpd_->buf4_close(&W);
+            sort_registry_add(PSIF_CC_HBAR, "WMbEj (jb,ME)", H_IRR);
+        }
     }
 
     if (params.eom_ref == 1) { /* ROHF */
 
-        global_dpd_->buf4_init(&W, PSIF_CC_HBAR, H_IRR, 10, 0, 10, 0, 0, "WmBiJ");
-        global_dpd_->buf4_sort(&W, PSIF_CC_HBAR, pqsr, 10, 0, "WmBiJ (mB,Ji)");
-        global_dpd_->buf4_close(&W);
-        global_dpd_->buf4_init(&W, PSIF_CC_HBAR, H_IRR, 10, 0, 10, 0, 0, "WmBiJ (mB,Ji)");
-        global_dpd_->buf4_sort(&W, PSIF_CC_HBAR, qprs, 11, 0, "WmBiJ (Bm,Ji)");
-        global_dpd_->buf4_close(&W);
+        if (!sort_registry_has(PSIF_CC_HBAR, "WmBiJ (mB,Ji)", H_IRR)) {
+            global_dpd_->buf4_init(&W, PSIF_CC_HBAR, H_IRR, 10, 0, 10, 0, 0, "WmBiJ");
+            global_dpd_->buf4_sort(&W, PSIF_CC_HBAR, pqsr, 10, 0, "WmBiJ (mB,Ji)");
+            global_dpd_->buf4_close(&W);
+            sort_registry_add(PSIF_CC_HBAR, "WmBiJ (mB,Ji)", H_IRR);
+        }
+        if (!sort_registry_has(PSIF_CC_HBAR, "WmBiJ (Bm,Ji)", H_IRR)) {
+            global_dpd_->buf4_init(&W, PSIF_CC_HBAR, H_IRR, 10, 0, 10, 0, 0, "WmBiJ (mB,Ji)");
+            global_dpd_->buf4_sort(&W, PSIF_CC_HBAR, qprs, 11, 0, "WmBiJ (Bm,Ji)");
+            global_dpd_->buf4_close(&W);
+            sort_registry_add(PSIF_CC_HBAR, "WmBiJ (Bm,Ji)", H_IRR);
+        }
 
-        global_dpd_->buf4_init(&W, PSIF_CC_HBAR, H_IRR, 11, 5, 11, 5, 0, "WeIaB");
-        global_dpd_->buf4_sort(&W, PSIF_CC_HBAR, qprs, 10, 5, "WeIaB (Ie,aB)");
-        global_dpd_->buf4_close(&W);
-        global_dpd_->buf4_init(&W, PSIF_CC_HBAR, H_IRR, 10, 5, 10, 5, 0, "WeIaB (Ie,aB)");
-        global_dpd_->buf4_sort(&W, PSIF_CC_HBAR, pqsr, 10, 5, "WeIaB (Ie,Ab)");
-        global_dpd_->buf4_close(&W);
+        if (!sort_registry_has(PSIF_CC_HBAR, "WeIaB (Ie,aB)", H_IRR)) {
+            global_dpd_->buf4_init(&W, PSIF_CC_HBAR, H_IRR, 11, 5, 11, 5, 0, "WeIaB");
+            global_dpd_->buf4_sort(&W, PSIF_CC_HBAR, qprs, 10, 5, "WeIaB (Ie,aB)");
+            global_dpd_->buf4_close(&W);
+            sort_registry_add(PSIF_CC_HBAR, "WeIaB (Ie,aB)", H_IRR);
+        }
+        if (!sort_registry_has(PSIF_CC_HBAR, "WeIaB (Ie,Ab)", H_IRR)) {
+            global_dpd_->buf4_init(&W, PSIF_CC_HBAR, H_IRR, 10, 5, 10, 5, 0, "WeIaB (Ie,aB)");
+            global_dpd_->buf4_sort(&W, PSIF_CC_HBAR, pqsr, 10, 5, "WeIaB (Ie,Ab)");
+            global_dpd_->buf4_close(&W);
+            sort_registry_add(PSIF_CC_HBAR, "WeIaB (Ie,Ab)", H_IRR);
+        }
     }
 
     if (params.eom_ref == 0) { /* RHF */
         /* 2 W(ME,jb) + W(Me,Jb) */
-        global_dpd_->buf4_init(&W, PSIF_CC_HBAR, H_IRR, 10, 10, 10, 10, 0, "WMbeJ");
-        global_dpd_->buf4_copy(&W, PSIF_CC_HBAR, "2 W(ME,jb) + W(Me,Jb)");
-        global_dpd_->buf4_close(&W);
-        global_dpd_->buf4_init(&W1, PSIF_CC_HBAR, H_IRR, 10, 10, 10, 10, 0, "2 W(ME,jb) + W(Me,Jb)");
-        global_dpd_->buf4_init(&W2, PSIF_CC_HBAR, H_IRR, 10, 10, 10, 10, 0, "WMbEj");
-        global_dpd_->buf4_axpy(&W2, &W1, 2);
-        global_dpd_->buf4_close(&W2);
-        global_dpd_->buf4_sort(&W1, PSIF_CC_HBAR, rspq, 10, 10, "2 W(jb,ME) + W(Jb,Me)");
-        global_dpd_->buf4_close(&W1);
+        if (!sort_registry_has(PSIF_CC_HBAR, "2 W(ME,jb) + W(Me,Jb)", H_IRR)) {
+            global_dpd_->buf4_init(&W, PSIF_CC_HBAR, H_IRR, 10, 10, 10, 10, 0, "WMbeJ");
+            global_dpd_->buf4_copy(&W, PSIF_CC_HBAR, "2 W(ME,jb) + W(Me,Jb)");
+            global_dpd_->buf4_close(&W);
+            global_dpd_->buf4_init(&W1, PSIF_CC_HBAR, H_IRR, 10, 10, 10, 10, 0, "2 W(ME,jb) + W(Me,Jb)");
+            global_dpd_->buf4_init(&W2, PSIF_CC_HBAR, H_IRR, 10, 10, 10, 10, 0, "WMbEj");
+            global_dpd_->buf4_axpy(&W2, &W1, 2);
+            global_dpd_->buf4_close(&W2);
+            global_dpd_->buf4_close(&W1);
+            sort_registry_add(PSIF_CC_HBAR, "2 W(ME,jb) + W(Me,Jb)", H_IRR);
+        }
+        if (!sort_registry_has(PSIF_CC_HBAR, "2 W(jb,ME) + W(Jb,Me)", H_IRR)) {
+            global_dpd_->buf4_init(&W1, PSIF_CC_HBAR, H_IRR, 10, 10, 10, 10, 0, "2 W(ME,jb) + W(Me,Jb)");
+            global_dpd_->buf4_sort(&W1, PSIF_CC_HBAR, rspq, 10, 10, "2 W(jb,ME) + W(Jb,Me)");
+            global_dpd_->buf4_close(&W1);
+            sort_registry_add(PSIF_CC_HBAR, "2 W(jb,ME) + W(Jb,Me)", H_IRR);
+        }
 
         /* used in WamefSD */
-        global_dpd_->buf4_init(&W, PSIF_CC_HBAR, H_IRR, 11, 5, 11, 5, 0, "WAmEf");
-        global_dpd_->buf4_scmcopy(&W, PSIF_CC_HBAR, "WAmEf 2(Am,Ef) - (Am,fE)", 2);
-        global_dpd_->buf4_sort_axpy(&W, PSIF_CC_HBAR, pqsr, 11, 5, "WAmEf 2(Am,Ef) - (Am,fE)", -1);
-        global_dpd_->buf4_close(&W);
+        if (!sort_registry_has(PSIF_CC_HBAR, "WAmEf 2(Am,Ef) - (Am,fE)", H_IRR)) {
+            global_dpd_->buf4_init(&W, PSIF_CC_HBAR, H_IRR, 11, 5, 11, 5, 0, "WAmEf");
+            global_dpd_->buf4_scmcopy(&W, PSIF_CC_HBAR, "WAmEf 2(Am,Ef) - (Am,fE)", 2);
+            global_dpd_->buf4_sort_axpy(&W, PSIF_CC_HBAR, pqsr, 11, 5, "WAmEf 2(Am,Ef) - (Am,fE)", -1);
+            global_dpd_->buf4_close(&W);
+            sort_registry_add(PSIF_CC_HBAR, "WAmEf 2(Am,Ef) - (Am,fE)", H_IRR);
+        }
     }
 
     return;
@@ -47,6 +47,7 @@
 #include "psi4/psifiles.h"
 #include "psi4/psi4-dec.h"
 #include "psi4/libqt/qt.h"
+#include "psi4/cc/sort_registry.h"
 
 #include <cstdio>
 #include <cstdlib>
@@ -124,6 +125,9 @@ PsiReturnType cchbar(std::shared_ptr<Wavefunction> ref_wfn, Options &options) {
         dpd_init(0, moinfo.nirreps, params.memory, 0, cachefiles, cachelist, nullptr, 4, spaces);
     }
 
+    /* HBAR is about to be rewritten; sorts of the old elements are stale */
+    sort_registry_reset(PSIF_CC_HBAR);
+
     sort_amps();
     tau_build();
     taut_build();
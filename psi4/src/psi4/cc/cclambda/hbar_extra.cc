@@ -34,6 +34,7 @@
 #include "psi4/libdpd/dpd.h"
 #include "MOInfo.h"
 #include "Params.h"
+#include "psi4/cc/sort_registry.h"
 #define EXTERN
 #include "globals.h"
 
@@ -44,15 +45,18 @@ void hbar_extra() {
     dpdbuf4 W1, W2, W;
 
     if (params.ref == 0) {
-        /* 2 W(ME,jb) + W(Me,Jb) */
-        global_dpd_->buf4_init(&W1, PSIF_CC_HBAR, 0, 10, 10, 10, 10, 0, "WMbeJ");
-        global_dpd_->buf4_copy(&W1, PSIF_CC_HBAR, "2 W(ME,jb) + W(Me,Jb)");
-        global_dpd_->buf4_close(&W1);
-        global_dpd_->buf4_init(&W1, PSIF_CC_HBAR, 0, 10, 10, 10, 10, 0, "2 W(ME,jb) + W(Me,Jb)");
-        global_dpd_->buf4_init(&W2, PSIF_CC_HBAR, 0, 10, 10, 10, 10, 0, "WMbEj");
-        global_dpd_->buf4_axpy(&W2, &W1, 2);
-        global_dpd_->buf4_close(&W2);
-        global_dpd_->buf4_close(&W1);
+        /* 2 W(ME,jb) + W(Me,Jb); cceom may have built it already */
+        if (!sort_registry_has(PSIF_CC_HBAR, "2 W(ME,jb) + W(Me,Jb)", 0)) {
+            global_dpd_->buf4_init(&W1, PSIF_CC_HBAR, 0, 10, 10, 10, 10, 0, "WMbeJ");
+            global_dpd_->buf4_copy(&W1, PSIF_CC_HBAR, "2 W(ME,jb) + W(Me,Jb)");
+            global_dpd_->buf4_close(&W1);
+            global_dpd_->buf4_init(&W1, PSIF_CC_HBAR, 0, 10, 10, 10, 10, 0, "2 W(ME,jb) + W(Me,Jb)");
+            global_dpd_->buf4_init(&W2, PSIF_CC_HBAR, 0, 10, 10, 10, 10, 0, "WMbEj");
+            global_dpd_->buf4_axpy(&W2, &W1, 2);
+            global_dpd_->buf4_close(&W2);
+            global_dpd_->buf4_close(&W1);
+            sort_registry_add(PSIF_CC_HBAR, "2 W(ME,jb) + W(Me,Jb)", 0);
+        }
 
         /*     dpd_buf4_init(&W, CC_HBAR, 0, 11, 5, 11, 5, 0, "WAmEf"); */
         /*     dpd_buf4_scmcopy(&W, CC_HBAR, "WAmEf 2(Am,Ef) - (Am,fE)", 2); */
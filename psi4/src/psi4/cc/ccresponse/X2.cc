@@ -34,6 +34,9 @@
 #include <cstdlib>
 #include <cstring>
 #include <cmath>
+#include <algorithm>
+#include <string>
+#include <vector>
 #include "psi4/libdpd/dpd.h"
 #include "psi4/libqt/qt.h"
 #include "psi4/libpsio/psio.h"
@@ -50,7 +53,11 @@ namespace ccresponse {
 void denom2(dpdbuf4 *X2, double omega);
 void local_filter_T2(dpdbuf4 *T2);
 
-void X2_build(const char *pert, int irrep, double omega) {
+/* X2_build(): Builds the new X2 amplitudes.  When abcd is false the
+** <ab|cd> term and the denominators are left to X2_abcd_batch(), which
+** adds the term for several perturbed wave functions at once. */
+
+void X2_build(const char *pert, int irrep, double omega, bool abcd) {
     dpdfile2 X1, z, F, t1;
     dpdbuf4 X2, X2new, Z, Z1, Z2, W, T2, I;
     char lbl[32];
@@ -240,7 +247,7 @@ void X2_build(const char *pert, int irrep, double omega) {
     global_dpd_->contract444(&W, &X2, &X2new, 1, 1, 1, 1);
     global_dpd_->buf4_close(&W);
 
-    if (params.abcd == "OLD") {
+    if (abcd && params.abcd == "OLD") {
         sprintf(lbl, "Z(Ab,Ij) %s", pert);
         global_dpd_->buf4_init(&Z, PSIF_CC_TMP0, irrep, 5, 0, 5, 0, 0, lbl);
         global_dpd_->buf4_init(&I, PSIF_CC_BINTS, 0, 5, 5, 5, 5, 0, "B <ab|cd>");
@@ -251,7 +258,7 @@ void X2_build(const char *pert, int irrep, double omega) {
         global_dpd_->buf4_sort_axpy(&Z, PSIF_CC_LR, rspq, 0, 5, lbl, 1);
         global_dpd_->buf4_init(&X2new, PSIF_CC_LR, irrep, 0, 5, 0, 5, 0, lbl); /* re-open X2new here */
         global_dpd_->buf4_close(&Z);
-    } else if (params.abcd == "NEW") {
+    } else if (abcd && params.abcd == "NEW") {
         timer_on("ABCD:new");
 
         global_dpd_->buf4_close(&X2);
@@ -472,12 +479,213 @@ void X2_build(const char *pert, int irrep, double omega) {
     global_dpd_->buf4_init(&X2new, PSIF_CC_LR, irrep, 0, 5, 0, 5, 0, lbl); /* re-open X2new here */
     global_dpd_->buf4_close(&Z);
 
-    if (params.local)
-        local_filter_T2(&X2new);
-    else
-        denom2(&X2new, omega);
+    if (abcd) {
+        if (params.local)
+            local_filter_T2(&X2new);
+        else
+            denom2(&X2new, omega);
+    }
     global_dpd_->buf4_close(&X2new);
 }
 
+/* Out(ij,ab) = alpha * In(ij,cd) B(ab,cd) for every vector of a batch.  The
+** vectors may belong to different irreps; for each irrep of B their rows
+** are stacked so that every bucket of B read from disk is used in a
+** single GEMM.  If B_diag_lbl is given, the -1/4 B(ab,cc) In(ij,cc) term of
+** the symmetric NEW algorithm is added as well. */
+
+static void X2_abcd_contract(dpdbuf4 *B, std::vector<dpdbuf4> &In, std::vector<dpdbuf4> &Out,
+                             const std::vector<int> &irreps, double alpha, const char *B_diag_lbl) {
+    int nvec = In.size();
+    int nvirt = moinfo.nvirt;
+    std::vector<long int> offset(nvec);
+
+    for (int h = 0; h < moinfo.nirreps; h++) {
+        long int ncd = B->params->coltot[h];
+        long int nab = B->params->rowtot[h];
+        long int nstack = 0;
+        for (int n = 0; n < nvec; n++) {
+            offset[n] = nstack;
+            nstack += In[n].params->rowtot[h ^ irreps[n]];
+        }
+        if (!nstack || !nab) continue;
+
+        double **X_stack = global_dpd_->dpd_block_matrix(nstack, ncd);
+        double **Z_stack = global_dpd_->dpd_block_matrix(nstack, nab);
+        for (int n = 0; n < nvec; n++) {
+            int Gij = h ^ irreps[n];
+            if (!In[n].params->rowtot[Gij]) continue;
+            In[n].matrix[Gij] = &X_stack[offset[n]];
+            global_dpd_->buf4_mat_irrep_rd(&In[n], Gij);
+            Out[n].matrix[Gij] = &Z_stack[offset[n]];
+        }
+
+        long int rows_per_bucket = (ncd ? dpd_memfree() / ncd : nab);
+        if (rows_per_bucket > nab) rows_per_bucket = nab;
+        if (rows_per_bucket < 1) rows_per_bucket = 1;
+        if (ncd) {
+            B->matrix[h] = global_dpd_->dpd_block_matrix(rows_per_bucket, ncd);
+            for (long int row_start = 0; row_start < nab; row_start += rows_per_bucket) {
+                long int nrows = std::min(rows_per_bucket, nab - row_start);
+                global_dpd_->buf4_mat_irrep_rd_block(B, h, row_start, nrows);
+                C_DGEMM('n', 't', nstack, nrows, ncd, alpha, X_stack[0], ncd, B->matrix[h][0], ncd, 1.0,
+                        &Z_stack[0][row_start], nab);
+            }
+            global_dpd_->free_dpd_block(B->matrix[h], rows_per_bucket, ncd);
+        }
+
+        /* NB: Gcc = 0 and B is totally symmetric, so only Gab = 0 contributes */
+        if (B_diag_lbl != nullptr && h == 0 && nvirt) {
+            /* X_diag(ij,c) = X(ij,cc) */
+            double **X_diag = global_dpd_->dpd_block_matrix(nstack, nvirt);
+            for (long int ij = 0; ij < nstack; ij++)
+                for (int Gc = 0; Gc < moinfo.nirreps; Gc++)
+                    for (int C = 0; C < moinfo.virtpi[Gc]; C++) {
+                        int c = C + moinfo.vir_off[Gc];
+                        X_diag[ij][c] = X_stack[ij][In[0].params->colidx[c][c]];
+                    }
+
+            rows_per_bucket = dpd_memfree() / nvirt;
+            if (rows_per_bucket > nab) rows_per_bucket = nab;
+            if (rows_per_bucket < 1) rows_per_bucket = 1;
+            double **B_diag = global_dpd_->dpd_block_matrix(rows_per_bucket, nvirt);
+            psio_address next = PSIO_ZERO;
+            for (long int row_start = 0; row_start < nab; row_start += rows_per_bucket) {
+                long int nrows = std::min(rows_per_bucket, nab - row_start);
+                psio_read(PSIF_CC_BINTS, B_diag_lbl, (char *)B_diag[0], sizeof(double) * nrows * nvirt, next, &next);
+                C_DGEMM('n', 't', nstack, nrows, nvirt, -0.25, X_diag[0], nvirt, B_diag[0], nvirt, 1.0,
+                        &Z_stack[0][row_start], nab);
+            }
+            global_dpd_->free_dpd_block(B_diag, rows_per_bucket, nvirt);
+            global_dpd_->free_dpd_block(X_diag, nstack, nvirt);
+        }
+
+        for (int n = 0; n < nvec; n++) {
+            int Gij = h ^ irreps[n];
+            if (!In[n].params->rowtot[Gij]) continue;
+            global_dpd_->buf4_mat_irrep_wrt(&Out[n], Gij);
+            In[n].matrix[Gij] = nullptr;
+            Out[n].matrix[Gij] = nullptr;
+        }
+        global_dpd_->free_dpd_block(X_stack, nstack, ncd);
+        global_dpd_->free_dpd_block(Z_stack, nstack, nab);
+    }
+}
+
+/* X2_abcd_batch(): Adds the <ab|cd> term to the new X2 amplitudes of
+** several perturbed wave functions left unfinished by X2_build(..., false),
+** then applies the denominators.  The wave functions are taken in batches as
+** large as memory allows, and the B integrals are read once per batch rather
+** than once per wave function. */
+
+void X2_abcd_batch(const std::vector<std::string> &perts, const std::vector<int> &irreps,
+                   const std::vector<double> &omegas) {
+    dpdbuf4 B, X2, X2new, Z;
+    char lbl[32];
+    int nrhs = perts.size();
+
+    /* size of the stacked X and Z irreps for one wave function */
+    long int vec_words = 0;
+    for (int n = 0; n < nrhs; n++) {
+        sprintf(lbl, "X_%s_IjAb (%5.3f)", perts[n].c_str(), omegas[n]);
+        global_dpd_->buf4_init(&X2, PSIF_CC_LR, irreps[n], 0, 5, 0, 5, 0, lbl);
+        for (int h = 0; h < moinfo.nirreps; h++)
+            vec_words = std::max(vec_words, 2L * X2.params->rowtot[h] * X2.params->coltot[h ^ irreps[n]]);
+        global_dpd_->buf4_close(&X2);
+    }
+
+    /* leave at least half of the memory for the B buckets */
+    int max_vec = (vec_words ? dpd_memfree() / 2 / vec_words : nrhs);
+    if (max_vec < 1) max_vec = 1;
+
+    for (int start = 0; start < nrhs; start += max_vec) {
+        int nvec = std::min(max_vec, nrhs - start);
+        std::vector<int> batch_irreps(irreps.begin() + start, irreps.begin() + start + nvec);
+        std::vector<dpdbuf4> In(nvec), Out(nvec);
+
+        if (params.abcd == "OLD") {
+            for (int n = 0; n < nvec; n++) {
+                const char *pert = perts[start + n].c_str();
+                double omega = omegas[start + n];
+                sprintf(lbl, "X_%s_IjAb (%5.3f)", pert, omega);
+                global_dpd_->buf4_init(&In[n], PSIF_CC_LR, irreps[start + n], 0, 5, 0, 5, 0, lbl);
+                sprintf(lbl, "Z(Ij,Ab) %s (%5.3f)", pert, omega);
+                global_dpd_->buf4_init(&Out[n], PSIF_CC_TMP0, irreps[start + n], 0, 5, 0, 5, 0, lbl);
+            }
+            global_dpd_->buf4_init(&B, PSIF_CC_BINTS, 0, 5, 5, 5, 5, 0, "B <ab|cd>");
+            X2_abcd_contract(&B, In, Out, batch_irreps, 1.0, nullptr);
+            global_dpd_->buf4_close(&B);
+            for (int n = 0; n < nvec; n++) {
+                global_dpd_->buf4_close(&In[n]);
+                global_dpd_->buf4_close(&Out[n]);
+            }
+        } else if (params.abcd == "NEW") {
+            timer_on("ABCD:S");
+            for (int n = 0; n < nvec; n++) {
+                const char *pert = perts[start + n].c_str();
+                double omega = omegas[start + n];
+                sprintf(lbl, "X_%s_(+)(ij,ab) (%5.3f)", pert, omega);
+                global_dpd_->buf4_init(&In[n], PSIF_CC_LR, irreps[start + n], 3, 8, 3, 8, 0, lbl);
+                sprintf(lbl, "S_%s_(ij,ab) (%5.3f)", pert, omega);
+                global_dpd_->buf4_init(&Out[n], PSIF_CC_TMP0, irreps[start + n], 3, 8, 3, 8, 0, lbl);
+            }
+            global_dpd_->buf4_init(&B, PSIF_CC_BINTS, 0, 8, 8, 8, 8, 0, "B(+) <ab|cd> + <ab|dc>");
+            X2_abcd_contract(&B, In, Out, batch_irreps, 0.5, "B(+) <ab|cc>");
+            global_dpd_->buf4_close(&B);
+            for (int n = 0; n < nvec; n++) {
+                global_dpd_->buf4_close(&In[n]);
+                global_dpd_->buf4_close(&Out[n]);
+            }
+            timer_off("ABCD:S");
+
+            timer_on("ABCD:A");
+            for (int n = 0; n < nvec; n++) {
+                const char *pert = perts[start + n].c_str();
+                double omega = omegas[start + n];
+                sprintf(lbl, "X_%s_(-)(ij,ab) (%5.3f)", pert, omega);
+                global_dpd_->buf4_init(&In[n], PSIF_CC_LR, irreps[start + n], 4, 9, 4, 9, 0, lbl);
+                sprintf(lbl, "A_%s_(ij,ab) (%5.3f)", pert, omega);
+                global_dpd_->buf4_init(&Out[n], PSIF_CC_TMP0, irreps[start + n], 4, 9, 4, 9, 0, lbl);
+            }
+            global_dpd_->buf4_init(&B, PSIF_CC_BINTS, 0, 9, 9, 9, 9, 0, "B(-) <ab|cd> - <ab|dc>");
+            X2_abcd_contract(&B, In, Out, batch_irreps, 0.5, nullptr);
+            global_dpd_->buf4_close(&B);
+            for (int n = 0; n < nvec; n++) {
+                global_dpd_->buf4_close(&In[n]);
+                global_dpd_->buf4_close(&Out[n]);
+            }
+            timer_off("ABCD:A");
+        }
+
+        for (int n = 0; n < nvec; n++) {
+            const char *pert = perts[start + n].c_str();
+            double omega = omegas[start + n];
+            int irrep = irreps[start + n];
+            sprintf(lbl, "New X_%s_IjAb (%5.3f)", pert, omega);
+            global_dpd_->buf4_init(&X2new, PSIF_CC_LR, irrep, 0, 5, 0, 5, 0, lbl);
+            if (params.abcd == "OLD") {
+                sprintf(lbl, "Z(Ij,Ab) %s (%5.3f)", pert, omega);
+                global_dpd_->buf4_init(&Z, PSIF_CC_TMP0, irrep, 0, 5, 0, 5, 0, lbl);
+                global_dpd_->buf4_axpy(&Z, &X2new, 1);
+                global_dpd_->buf4_close(&Z);
+            } else if (params.abcd == "NEW") {
+                sprintf(lbl, "S_%s_(ij,ab) (%5.3f)", pert, omega);
+                global_dpd_->buf4_init(&Z, PSIF_CC_TMP0, irrep, 0, 5, 3, 8, 0, lbl);
+                global_dpd_->buf4_axpy(&Z, &X2new, 1);
+                global_dpd_->buf4_close(&Z);
+                sprintf(lbl, "A_%s_(ij,ab) (%5.3f)", pert, omega);
+                global_dpd_->buf4_init(&Z, PSIF_CC_TMP0, irrep, 0, 5, 4, 9, 0, lbl);
+                global_dpd_->buf4_axpy(&Z, &X2new, 1);
+                global_dpd_->buf4_close(&Z);
+            }
+            if (params.local)
+                local_filter_T2(&X2new);
+            else
+                denom2(&X2new, omega);
+            global_dpd_->buf4_close(&X2new);
+        }
+    }
+}
+
 }  // namespace ccresponse
 }  // namespace psi
@@ -34,6 +34,9 @@
 #include <cstdlib>
 #include <cstring>
 #include <cmath>
+#include <algorithm>
+#include <string>
+#include <vector>
 #include "psi4/libdpd/dpd.h"
 #include "psi4/libqt/qt.h"
 #include "psi4/libpsio/psio.h"
@@ -52,7 +55,9 @@ void init_X(const char *pert, int irrep, double omega);
 void sort_X(const char *pert, int irrep, double omega);
 void cc2_sort_X(const char *pert, int irrep, double omega);
 void X1_build(const char *pert, int irrep, double omega);
-void X2_build(const char *pert, int irrep, double omega);
+void X2_build(const char *pert, int irrep, double omega, bool abcd);
+void X2_abcd_batch(const std::vector<std::string> &perts, const std::vector<int> &irreps,
+                   const std::vector<double> &omegas);
 void cc2_X1_build(const char *pert, int irrep, double omega);
 void cc2_X2_build(const char *pert, int irrep, double omega);
 double converged(const char *pert, int irrep, double omega);
@@ -95,7 +100,7 @@ void compute_X(const char *pert, int irrep, double omega) {
         } else {
             sort_X(pert, irrep, omega);
             X1_build(pert, irrep, omega);
-            X2_build(pert, irrep, omega);
+            X2_build(pert, irrep, omega, true);
         }
         update_X(pert, irrep, omega);
         rms = converged(pert, irrep, omega);
@@ -156,5 +161,158 @@ void compute_X(const char *pert, int irrep, double omega) {
     timer_off("compute_X");
 }
 
+/* compute_X_batch(): Solves the perturbed-amplitude equations of several
+** (perturbation, frequency) pairs together, in batches of at most
+** params.batch_size.  The wave functions of a batch are iterated in
+** lockstep, each with its own DIIS subspace, so that the <ab|cd> term of
+** all of them is built from a single pass over the B integrals. */
+
+void compute_X_batch(const std::vector<std::string> &perts, const std::vector<int> &irreps,
+                     const std::vector<double> &omegas) {
+    char lbl[32];
+    dpdbuf4 X2;
+
+    /* Drop repeated (perturbation, frequency) pairs; they share disk labels */
+    std::vector<std::string> all_perts, all_keys;
+    std::vector<int> all_irreps;
+    std::vector<double> all_omegas;
+    for (size_t n = 0; n < perts.size(); n++) {
+        sprintf(lbl, "%s (%5.3f)", perts[n].c_str(), omegas[n]);
+        if (std::find(all_keys.begin(), all_keys.end(), std::string(lbl)) != all_keys.end()) continue;
+        all_keys.push_back(lbl);
+        all_perts.push_back(perts[n]);
+        all_irreps.push_back(irreps[n]);
+        all_omegas.push_back(omegas[n]);
+    }
+
+    int nrhs = all_perts.size();
+    int batch = (params.batch_size ? params.batch_size : nrhs);
+    if (batch <= 1) {
+        for (int n = 0; n < nrhs; n++) compute_X(all_perts[n].c_str(), all_irreps[n], all_omegas[n]);
+        return;
+    }
+
+    for (int start = 0; start < nrhs; start += batch) {
+        int nvec = std::min(batch, nrhs - start);
+        if (nvec == 1) {
+            compute_X(all_perts[start].c_str(), all_irreps[start], all_omegas[start]);
+            continue;
+        }
+
+        timer_on("compute_X");
+
+        std::vector<std::string> bperts(all_perts.begin() + start, all_perts.begin() + start + nvec);
+        std::vector<int> birreps(all_irreps.begin() + start, all_irreps.begin() + start + nvec);
+        std::vector<double> bomegas(all_omegas.begin() + start, all_omegas.begin() + start + nvec);
+
+        outfile->Printf("\n\tComputing %d Perturbed Wave Functions Together.\n", nvec);
+        for (int n = 0; n < nvec; n++) {
+            const char *pert = bperts[n].c_str();
+            init_X(pert, birreps[n], bomegas[n]);
+            if (params.wfn == "CC2")
+                cc2_sort_X(pert, birreps[n], bomegas[n]);
+            else
+                sort_X(pert, birreps[n], bomegas[n]);
+        }
+        outfile->Printf("\tIter   Perturbation (Omega)    Pseudopolarizability       RMS \n");
+        outfile->Printf("\t----   --------------------   --------------------   -----------\n");
+        for (int n = 0; n < nvec; n++) {
+            double polar = -2.0 * pseudopolar(bperts[n].c_str(), birreps[n], bomegas[n]);
+            sprintf(lbl, "%s (%5.3f)", bperts[n].c_str(), bomegas[n]);
+            outfile->Printf("\t%4d   %-20s   %20.12f\n", 0, lbl, polar);
+        }
+
+        /* Wave functions still being iterated */
+        std::vector<int> active(nvec);
+        for (int n = 0; n < nvec; n++) active[n] = n;
+
+        for (int iter = 1; iter <= params.maxiter && !active.empty(); iter++) {
+            std::vector<std::string> aperts;
+            std::vector<int> airreps;
+            std::vector<double> aomegas;
+            for (int n : active) {
+                const char *pert = bperts[n].c_str();
+                if (params.wfn == "CC2") {
+                    cc2_sort_X(pert, birreps[n], bomegas[n]);
+                    cc2_X1_build(pert, birreps[n], bomegas[n]);
+                    cc2_X2_build(pert, birreps[n], bomegas[n]);
+                } else {
+                    sort_X(pert, birreps[n], bomegas[n]);
+                    X1_build(pert, birreps[n], bomegas[n]);
+                    X2_build(pert, birreps[n], bomegas[n], false);
+                }
+                aperts.push_back(bperts[n]);
+                airreps.push_back(birreps[n]);
+                aomegas.push_back(bomegas[n]);
+            }
+            if (params.wfn != "CC2") X2_abcd_batch(aperts, airreps, aomegas);
+
+            std::vector<int> still_active;
+            for (int n : active) {
+                const char *pert = bperts[n].c_str();
+                int irrep = birreps[n];
+                double omega = bomegas[n];
+                sprintf(lbl, "%s (%5.3f)", pert, omega);
+
+                update_X(pert, irrep, omega);
+                double rms = converged(pert, irrep, omega);
+                if (rms <= params.convergence) {
+                    save_X(pert, irrep, omega);
+                    if (params.wfn == "CC2")
+                        cc2_sort_X(pert, irrep, omega);
+                    else
+                        sort_X(pert, irrep, omega);
+                    outfile->Printf("\t%4d   %-20s   %20s    %4.3e  Converged\n", iter, lbl, "", rms);
+                    if (params.print & 2) {
+                        sprintf(lbl, "X_%s_IjAb (%5.3f)", pert, omega);
+                        global_dpd_->buf4_init(&X2, PSIF_CC_LR, irrep, 0, 5, 0, 5, 0, lbl);
+                        double X2_norm = sqrt(global_dpd_->buf4_dot_self(&X2));
+                        global_dpd_->buf4_close(&X2);
+                        outfile->Printf("\tNorm of the converged X2 amplitudes %20.15f\n", X2_norm);
+                        amp_write(pert, irrep, omega);
+                    }
+                    continue;
+                }
+                if (params.diis) diis(iter, pert, irrep, omega);
+                save_X(pert, irrep, omega);
+                if (params.wfn == "CC2")
+                    cc2_sort_X(pert, irrep, omega);
+                else
+                    sort_X(pert, irrep, omega);
+
+                double polar = -2.0 * pseudopolar(pert, irrep, omega);
+                outfile->Printf("\t%4d   %-20s   %20.12f    %4.3e\n", iter, lbl, polar, rms);
+                still_active.push_back(n);
+            }
+            active = still_active;
+        }
+        if (!active.empty()) {
+            dpd_close(0);
+            cleanup();
+            exit_io();
+            throw PsiException("Failed to converge perturbed wavefunction", __FILE__, __LINE__);
+        }
+        outfile->Printf("\t----------------------------------------------------------------------\n");
+        outfile->Printf("\tConverged %d Perturbed Wfns to %4.3e\n", nvec, params.convergence);
+
+        /* Clean up disk space */
+        psio_close(PSIF_CC_DIIS_AMP, 0);
+        psio_close(PSIF_CC_DIIS_ERR, 0);
+
+        psio_open(PSIF_CC_DIIS_AMP, 0);
+        psio_open(PSIF_CC_DIIS_ERR, 0);
+
+        for (int i = PSIF_CC_TMP; i <= PSIF_CC_TMP11; i++) {
+            psio_close(i, 0);
+            psio_open(i, 0);
+        }
+
+        if (params.analyze)
+            for (int n = 0; n < nvec; n++) analyze(bperts[n].c_str(), birreps[n], bomegas[n]);
+
+        timer_off("compute_X");
+    }
+}
+
 }  // namespace ccresponse
 }  // namespace psi
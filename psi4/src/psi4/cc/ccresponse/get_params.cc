@@ -157,6 +157,8 @@ void get_params(std::shared_ptr<Wavefunction> wfn, Options &options) {
     params.maxiter = options.get_int("MAXITER");
     params.convergence = options.get_double("R_CONVERGENCE");
     params.diis = options.get_bool("DIIS");
+    params.batch_size = options.get_int("RESPONSE_BATCH_SIZE");
+    if (params.batch_size < 0) throw PsiException("RESPONSE_BATCH_SIZE must not be negative", __FILE__, __LINE__);
 
     params.prop = options.get_str("PROPERTY");
     if (params.prop != "POLARIZABILITY" && params.prop != "ROTATION" && params.prop != "ROA" &&
@@ -222,6 +224,10 @@ void get_params(std::shared_ptr<Wavefunction> wfn, Options &options) {
     outfile->Printf("\tConvergence      =    %3.1e\n", params.convergence);
     outfile->Printf("\tRestart          =    %s\n", params.restart ? "Allowed" : "Not Allowed");
     outfile->Printf("\tDIIS             =    %s\n", params.diis ? "Yes" : "No");
+    if (params.batch_size)
+        outfile->Printf("\tBatch Size       =    %d\n", params.batch_size);
+    else
+        outfile->Printf("\tBatch Size       =    All\n");
     outfile->Printf("\tModel III        =    %s\n", params.sekino ? "Yes" : "No");
     outfile->Printf("\tLinear Model     =    %s\n", params.linear ? "Yes" : "No");
     outfile->Printf("\tABCD             =    %s\n", params.abcd.c_str());
@@ -35,6 +35,7 @@
 #include "MOInfo.h"
 #include "Params.h"
 #include "Local.h"
+#include "psi4/cc/sort_registry.h"
 #define EXTERN
 #include "globals.h"
 
@@ -63,16 +64,24 @@ void hbar_extra() {
 
     global_dpd_->file2_close(&lt);
 
-    /* 2 W(ME,jb) + W(Me,Jb) */
-    global_dpd_->buf4_init(&W1, PSIF_CC_HBAR, 0, 10, 10, 10, 10, 0, "WMbeJ");
-    global_dpd_->buf4_copy(&W1, PSIF_CC_HBAR, "2 W(ME,jb) + W(Me,Jb)");
-    global_dpd_->buf4_close(&W1);
-    global_dpd_->buf4_init(&W1, PSIF_CC_HBAR, 0, 10, 10, 10, 10, 0, "2 W(ME,jb) + W(Me,Jb)");
-    global_dpd_->buf4_init(&W2, PSIF_CC_HBAR, 0, 10, 10, 10, 10, 0, "WMbEj");
-    global_dpd_->buf4_axpy(&W2, &W1, 2);
-    global_dpd_->buf4_close(&W2);
-    global_dpd_->buf4_sort(&W1, PSIF_CC_HBAR, rspq, 10, 10, "2 W(jb,ME) + W(Jb,Me)");
-    global_dpd_->buf4_close(&W1);
+    /* 2 W(ME,jb) + W(Me,Jb); cclambda or cceom may have built it already */
+    if (!sort_registry_has(PSIF_CC_HBAR, "2 W(ME,jb) + W(Me,Jb)", 0)) {
+        global_dpd_->buf4_init(&W1, PSIF_CC_HBAR, 0, 10, 10, 10, 10, 0, "WMbeJ");
+        global_dpd_->buf4_copy(&W1, PSIF_CC_HBAR, "2 W(ME,jb) + W(Me,Jb)");
+        global_dpd_->buf4_close(&W1);
+        global_dpd_->buf4_init(&W1, PSIF_CC_HBAR, 0, 10, 10, 10, 10, 0, "2 W(ME,jb) + W(Me,Jb)");
+        global_dpd_->buf4_init(&W2, PSIF_CC_HBAR, 0, 10, 10, 10, 10, 0, "WMbEj");
+        global_dpd_->buf4_axpy(&W2, &W1, 2);
+        global_dpd_->buf4_close(&W2);
+        global_dpd_->buf4_close(&W1);
+        sort_registry_add(PSIF_CC_HBAR, "2 W(ME,jb) + W(Me,Jb)", 0);
+    }
+    if (!sort_registry_has(PSIF_CC_HBAR, "2 W(jb,ME) + W(Jb,Me)", 0)) {
+        global_dpd_->buf4_init(&W1, PSIF_CC_HBAR, 0, 10, 10, 10, 10, 0, "2 W(ME,jb) + W(Me,Jb)");
+        global_dpd_->buf4_sort(&W1, PSIF_CC_HBAR, rspq, 10, 10, "2 W(jb,ME) + W(Jb,Me)");
+        global_dpd_->buf4_close(&W1);
+        sort_registry_add(PSIF_CC_HBAR, "2 W(jb,ME) + W(Jb,Me)", 0);
+    }
 }
 
 }  // namespace ccresponse
@@ -72,6 +72,8 @@
 #include <cstdlib>
 #include <cmath>
 #include <sstream>
+#include <string>
+#include <vector>
 
 #include "psi4/libpsi4util/process.h"
 #include "psi4/libciomr/libciomr.h"
@@ -93,7 +95,8 @@ namespace psi {
 namespace ccresponse {
 
 void pertbar(const char *pert, int irrep, int anti);
-void compute_X(const char *pert, int irrep, double omega);
+void compute_X_batch(const std::vector<std::string> &perts, const std::vector<int> &irreps,
+                     const std::vector<double> &omegas);
 void linresp(double *tensor, double A, double B, const char *pert_x, int x_irrep, double omega_x, const char *pert_y,
              int y_irrep, double omega_y);
 
@@ -150,15 +153,23 @@ void optrot(std::shared_ptr<Wavefunction> ref_wfn) {
 
         sprintf(lbl1, "<<P;L>>_(%5.3f)", 0.0);
         if (!params.restart || !psio_tocscan(PSIF_CC_INFO, lbl1)) {
+            std::vector<std::string> perts;
+            std::vector<int> irreps;
+            std::vector<double> omegas;
             for (alpha = 0; alpha < 3; alpha++) {
                 sprintf(pert, "P_%1s", cartcomp[alpha]);
                 pertbar(pert, moinfo.mu_irreps[alpha], 1);
-                compute_X(pert, moinfo.mu_irreps[alpha], 0);
+                perts.push_back(pert);
+                irreps.push_back(moinfo.mu_irreps[alpha]);
+                omegas.push_back(0.0);
 
                 sprintf(pert, "L_%1s", cartcomp[alpha]);
                 pertbar(pert, moinfo.l_irreps[alpha], 1);
-                compute_X(pert, moinfo.l_irreps[alpha], 0);
+                perts.push_back(pert);
+                irreps.push_back(moinfo.l_irreps[alpha]);
+                omegas.push_back(0.0);
             }
+            compute_X_batch(perts, irreps, omegas);
 
             outfile->Printf("\n\tComputing %s tensor.\n", lbl1);
             for (alpha = 0; alpha < 3; alpha++) {
@@ -234,20 +245,30 @@ void optrot(std::shared_ptr<Wavefunction> ref_wfn) {
             }
 
             /* Compute the +omega magnetic-dipole and -omega electric-dipole CC wave functions */
+            std::vector<std::string> perts;
+            std::vector<int> irreps;
+            std::vector<double> omegas;
             for (alpha = 0; alpha < 3; alpha++) {
                 if (compute_rl) {
                     sprintf(pert, "Mu_%1s", cartcomp[alpha]);
-                    compute_X(pert, moinfo.mu_irreps[alpha], -params.omega[i]);
+                    perts.push_back(pert);
+                    irreps.push_back(moinfo.mu_irreps[alpha]);
+                    omegas.push_back(-params.omega[i]);
                 }
 
                 if (compute_pl) {
                     sprintf(pert, "P_%1s", cartcomp[alpha]);
-                    compute_X(pert, moinfo.mu_irreps[alpha], -params.omega[i]);
+                    perts.push_back(pert);
+                    irreps.push_back(moinfo.mu_irreps[alpha]);
+                    omegas.push_back(-params.omega[i]);
                 }
 
                 sprintf(pert, "L_%1s", cartcomp[alpha]);
-                compute_X(pert, moinfo.l_irreps[alpha], params.omega[i]);
+                perts.push_back(pert);
+                irreps.push_back(moinfo.l_irreps[alpha]);
+                omegas.push_back(params.omega[i]);
             }
+            compute_X_batch(perts, irreps, omegas);
 
             outfile->Printf("\n");
             if (compute_rl) {
@@ -323,19 +344,29 @@ void optrot(std::shared_ptr<Wavefunction> ref_wfn) {
             }
 
             /* Compute the -omega magnetic-dipole and +omega electric-dipole CC wave functions */
+            std::vector<std::string> perts;
+            std::vector<int> irreps;
+            std::vector<double> omegas;
             for (alpha = 0; alpha < 3; alpha++) {
                 if (compute_rl) {
                     sprintf(pert, "Mu_%1s", cartcomp[alpha]);
-                    compute_X(pert, moinfo.mu_irreps[alpha], params.omega[i]);
+                    perts.push_back(pert);
+                    irreps.push_back(moinfo.mu_irreps[alpha]);
+                    omegas.push_back(params.omega[i]);
                 }
                 if (compute_pl) {
                     sprintf(pert, "P*_%1s", cartcomp[alpha]);
-                    compute_X(pert, moinfo.mu_irreps[alpha], params.omega[i]);
+                    perts.push_back(pert);
+                    irreps.push_back(moinfo.mu_irreps[alpha]);
+                    omegas.push_back(params.omega[i]);
                 }
 
                 sprintf(pert, "L*_%1s", cartcomp[alpha]);
-                compute_X(pert, moinfo.l_irreps[alpha], -params.omega[i]);
+                perts.push_back(pert);
+                irreps.push_back(moinfo.l_irreps[alpha]);
+                omegas.push_back(-params.omega[i]);
             }
+            compute_X_batch(perts, irreps, omegas);
 
             outfile->Printf("\n");
             if (compute_rl) {
@@ -35,6 +35,8 @@
 #include <cstdlib>
 #include <cmath>
 #include <sstream>
+#include <string>
+#include <vector>
 
 #include "psi4/libpsi4util/process.h"
 #include "psi4/libciomr/libciomr.h"
@@ -54,7 +56,8 @@ namespace psi {
 namespace ccresponse {
 
 void pertbar(const char *pert, int irrep, int anti);
-void compute_X(const char *pert, int irrep, double omega);
+void compute_X_batch(const std::vector<std::string> &perts, const std::vector<int> &irreps,
+                     const std::vector<double> &omegas);
 void linresp(double *tensor, double A, double B, const char *pert_x, int x_irrep, double omega_x, const char *pert_y,
              int y_irrep, double omega_y);
 
@@ -76,16 +79,46 @@ void polar(std::shared_ptr<Wavefunction> ref_wfn) {
 
     trace = init_array(params.nomega);
 
+    /* Frequencies whose tensors are not on disk yet */
+    std::vector<int> todo;
+    std::vector<bool> computed(params.nomega, false);
     for (i = 0; i < params.nomega; i++) {
         sprintf(lbl, "<<Mu;Mu>_(%5.3f)", params.omega[i]);
-        if (!params.restart || !psio_tocscan(PSIF_CC_INFO, lbl)) {
+        if (!params.restart || !psio_tocscan(PSIF_CC_INFO, lbl)) todo.push_back(i);
+    }
+
+    /* Solve for the perturbed wave functions of as many frequencies at a
+       time as the batch size allows */
+    for (size_t first = 0, last; first < todo.size(); first = last) {
+        std::vector<std::string> perts;
+        std::vector<int> irreps;
+        std::vector<double> omegas;
+        for (last = first; last < todo.size(); last++) {
+            double omega = params.omega[todo[last]];
+            size_t nrhs = (omega != 0.0 ? 6 : 3);
+            if (last > first && params.batch_size && perts.size() + nrhs > (size_t)params.batch_size) break;
             for (alpha = 0; alpha < 3; alpha++) {
                 sprintf(pert, "Mu_%1s", cartcomp[alpha]);
-                pertbar(pert, moinfo.mu_irreps[alpha], 0);
-                compute_X(pert, moinfo.mu_irreps[alpha], params.omega[i]);
-                if (params.omega[i] != 0.0) compute_X(pert, moinfo.mu_irreps[alpha], -params.omega[i]);
+                perts.push_back(pert);
+                irreps.push_back(moinfo.mu_irreps[alpha]);
+                omegas.push_back(omega);
+                if (omega != 0.0) {
+                    perts.push_back(pert);
+                    irreps.push_back(moinfo.mu_irreps[alpha]);
+                    omegas.push_back(-omega);
+                }
             }
+        }
+
+        for (alpha = 0; alpha < 3; alpha++) {
+            sprintf(pert, "Mu_%1s", cartcomp[alpha]);
+            pertbar(pert, moinfo.mu_irreps[alpha], 0);
+        }
+        compute_X_batch(perts, irreps, omegas);
 
+        for (size_t n = first; n < last; n++) {
+            i = todo[n];
+            sprintf(lbl, "<<Mu;Mu>_(%5.3f)", params.omega[i]);
             outfile->Printf("\n\tComputing %s tensor.\n", lbl);
             for (alpha = 0; alpha < 3; alpha++) {
                 for (beta = 0; beta < 3; beta++) {
@@ -97,10 +130,16 @@ void polar(std::shared_ptr<Wavefunction> ref_wfn) {
             }
 
             psio_write_entry(PSIF_CC_INFO, lbl, (char *)tensor[i][0], 9 * sizeof(double));
+            computed[i] = true;
+        }
 
-            psio_close(PSIF_CC_LR, 0);
-            psio_open(PSIF_CC_LR, 0);
-        } else {
+        psio_close(PSIF_CC_LR, 0);
+        psio_open(PSIF_CC_LR, 0);
+    }
+
+    for (i = 0; i < params.nomega; i++) {
+        sprintf(lbl, "<<Mu;Mu>_(%5.3f)", params.omega[i]);
+        if (!computed[i]) {
             outfile->Printf("Using %s tensor found on disk.\n", lbl);
             psio_read_entry(PSIF_CC_INFO, lbl, (char *)tensor[i], 9 * sizeof(double));
         }
@@ -45,10 +45,7 @@
 #define EXTERN
 #include "globals.h"
 #include "psi4/libpsi4util/PsiOutStream.h"
-// MKL Header
-#ifdef USING_LAPACK_MKL
-#include <mkl.h>
-#endif
+#include "psi4/libpsi4util/threading.h"
 
 namespace psi {
 namespace cctriples {
@@ -93,11 +90,6 @@ double EaT_RHF() {
     nthreads = params.nthreads;
     std::vector<EaT_RHF_thread_data> thread_data_array(nthreads);
 
-#ifdef USING_LAPACK_MKL
-    int old_threads = mkl_get_max_threads();
-    mkl_set_num_threads(1);
-#endif
-
     global_dpd_->file2_init(&fIJ, PSIF_CC_OEI, 0, 0, 0, "fIJ");
     global_dpd_->file2_init(&fAB, PSIF_CC_OEI, 0, 1, 1, "fAB");
     global_dpd_->file2_init(&fIA, PSIF_CC_OEI, 0, 0, 1, "fIA");
@@ -215,6 +207,8 @@ double EaT_RHF() {
 
 #pragma omp parallel num_threads(nthreads)
                 {
+                    // Don't parallelize BLAS if explicit threads are used
+                    BlasThreadsGuard blas_threads(1);
                     int ithread = 0;
 #ifdef _OPENMP
                     ithread = omp_get_thread_num();
@@ -259,10 +253,6 @@ double EaT_RHF() {
 
     timer_off("ET_RHF");
 
-#ifdef USING_LAPACK_MKL
-    mkl_set_num_threads(old_threads);
-#endif
-
     return ET;
 }
 
@@ -79,6 +79,9 @@ class CCEnergyWavefunction : public Wavefunction {
     void spinad_amps();
     void amp_write();
     void checkpoint();
+    std::string checkpoint_filename();
+    void save_amps_checkpoint();
+    int load_amps_checkpoint();
 
     /* intermediates */
     void update();
@@ -184,6 +187,7 @@ class CCEnergyWavefunction : public Wavefunction {
                    int **mo_row, int **so_row, int *mospi_left, int *mospi_right, int *sospi, int type, double alpha,
                    double beta);
     int AO_contribute(struct iwlbuf *InBuf, dpdbuf4 *tau1_AO, dpdbuf4 *tau2_AO);
+    void AO_contribute_direct(dpdbuf4 *tau1_AO, dpdbuf4 *tau2_AO);
 
     double rhf_energy();
     double uhf_energy();
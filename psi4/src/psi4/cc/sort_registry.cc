@@ -0,0 +1,81 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Psi4: an open-source quantum chemistry software package
+ *
+ * Copyright (c) 2007-2023 The Psi4 Developers.
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This file is part of Psi4.
+ *
+ * Psi4 is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * Psi4 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with Psi4; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * @END LICENSE
+ */
+
+/*! \file
+    \brief Registry of DPD sort orders shared between the CC modules
+*/
+#include <cstdio>
+#include <string>
+#include "psi4/libpsio/psio.h"
+#include "psi4/libpsio/config.h"
+#include "psi4/psifiles.h"
+#include "sort_registry.h"
+
+namespace psi {
+
+namespace {
+
+std::string generation_key(int filenum) { return "Sort Registry Generation " + std::to_string(filenum); }
+
+std::string entry_key(int filenum, const std::string &label) {
+    return "Sorted " + std::to_string(filenum) + " " + label;
+}
+
+int generation(int filenum) {
+    int gen = 0;
+    std::string key = generation_key(filenum);
+    if (psio_tocentry_exists(PSIF_CC_INFO, key.c_str()))
+        psio_read_entry(PSIF_CC_INFO, key.c_str(), (char *)&gen, sizeof(int));
+    return gen;
+}
+
+}  // namespace
+
+void sort_registry_reset(int filenum) {
+    int gen = generation(filenum) + 1;
+    psio_write_entry(PSIF_CC_INFO, generation_key(filenum).c_str(), (char *)&gen, sizeof(int));
+}
+
+bool sort_registry_has(int filenum, const std::string &label, int irrep) {
+    std::string key = entry_key(filenum, label);
+    if (key.size() >= PSIO_KEYLEN || !psio_tocentry_exists(PSIF_CC_INFO, key.c_str())) return false;
+
+    int stamp[2];
+    psio_read_entry(PSIF_CC_INFO, key.c_str(), (char *)stamp, sizeof(stamp));
+    return stamp[0] == generation(filenum) && stamp[1] == irrep && psio_tocentry_exists(filenum, label.c_str());
+}
+
+void sort_registry_add(int filenum, const std::string &label, int irrep) {
+    std::string key = entry_key(filenum, label);
+    if (key.size() >= PSIO_KEYLEN) return;
+
+    int stamp[2] = {generation(filenum), irrep};
+    psio_write_entry(PSIF_CC_INFO, key.c_str(), (char *)stamp, sizeof(stamp));
+}
+
+}  // namespace psi
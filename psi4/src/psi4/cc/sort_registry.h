@@ -0,0 +1,64 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Psi4: an open-source quantum chemistry software package
+ *
+ * Copyright (c) 2007-2023 The Psi4 Developers.
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This file is part of Psi4.
+ *
+ * Psi4 is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * Psi4 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with Psi4; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * @END LICENSE
+ */
+
+/*! \file
+    \brief Registry of DPD sort orders shared between the CC modules
+*/
+
+#ifndef CC_SORT_REGISTRY_H
+#define CC_SORT_REGISTRY_H
+
+#include <string>
+
+namespace psi {
+
+/*
+** cchbar writes the HBAR elements once, and cclambda, cceom, ccresponse and
+** ccdensity each need some of them in other index orders.  The registry
+** records, in CC_INFO, which of those derived buffers are already on disk so
+** that a later module can reuse them instead of sorting again.
+**
+** Every file carries a generation number.  sort_registry_reset() starts a new
+** generation, which makes every buffer recorded for the file stale; it must be
+** called by whatever rewrites the source elements (cchbar for CC_HBAR).
+** CC_INFO and the file itself must be open when these are called.
+*/
+
+/* Invalidate everything recorded for filenum */
+void sort_registry_reset(int filenum);
+
+/* True if label was recorded for filenum in the current generation, for the
+   same irrep, and is still in the file */
+bool sort_registry_has(int filenum, const std::string &label, int irrep);
+
+/* Record that label has been written to filenum with the given irrep */
+void sort_registry_add(int filenum, const std::string &label, int irrep);
+
+}  // namespace psi
+
+#endif
@@ -26,6 +26,8 @@
  * @END LICENSE
  */
 
+#include <cmath>
+
 #include "psi4/psi4-dec.h"
 #include "psi4/liboptions/liboptions.h"
 #include "psi4/libmints/matrix.h"
@@ -53,8 +55,10 @@ void memcheck(const int reference);
 
 vector<int> pitzer2qt(vector<Dimension> &spaces);
 
-void sort_tei_rhf(std::shared_ptr<PSIO> psio, int print);
+void sort_tei_rhf(std::shared_ptr<PSIO> psio, int print, bool vvvv);
 void sort_tei_uhf(std::shared_ptr<PSIO> psio, int print);
+double df_tei_rhf(std::shared_ptr<Wavefunction> ref, const std::string &type, double cd_tol, Dimension &frzcpi,
+                  Dimension &occpi, Dimension &openpi, Dimension &uoccpi, bool vvvv, std::shared_ptr<PSIO> psio);
 
 void c_sort(int reference);
 void d_sort(int reference);
@@ -186,6 +190,28 @@ PsiReturnType cctransort(SharedWavefunction ref, Options &options) {
 
     psio->open(PSIF_CC_INFO, PSIO_OPEN_OLD);
 
+    /* The signature of a completed sort: completion flag, SCF energy,
+       reference type, the number of active and total orbitals, and the
+       kind of two-electron integrals (0 = exact, 1 = DF, 2 = CD) */
+    std::string tei_type = options.get_str("TEI_TYPE");
+    double tei_code = tei_type == "DF" ? 1.0 : (tei_type == "CD" ? 2.0 : 0.0);
+    double signature[6] = {0.0, escf, (double)reference, (double)nactive, (double)nmo, tei_code};
+    if (options.get_bool("REUSE_SORTED_INTS") && psio->tocentry_exists(PSIF_CC_INFO, "Sorted Integrals Signature")) {
+        double old_signature[6];
+        psio->read_entry(PSIF_CC_INFO, "Sorted Integrals Signature", (char *)old_signature, sizeof(old_signature));
+        if (old_signature[0] == 1.0 && std::fabs(old_signature[1] - escf) < 1.0e-10 &&
+            old_signature[2] == signature[2] && old_signature[3] == signature[3] && old_signature[4] == signature[4] &&
+            old_signature[5] == signature[5]) {
+            outfile->Printf("\tSorted integrals from a previous run are intact; skipping the sort.\n");
+            psio->close(PSIF_CC_INFO, 1);
+            tstop();
+            return Success;
+        }
+        outfile->Printf("\tSorted integrals on disk do not match this reference; sorting again.\n");
+    }
+    /* Mark the sort as incomplete until every file has been written */
+    psio->write_entry(PSIF_CC_INFO, "Sorted Integrals Signature", (char *)signature, sizeof(signature));
+
     psio->write_entry(PSIF_CC_INFO, "Reference Wavefunction", (char *)&(reference), sizeof(int));
     psio->write_entry(PSIF_CC_INFO, "Frozen Core Orbs Per Irrep", (char *)(int *)frzcpi, sizeof(int) * nirreps);
     psio->write_entry(PSIF_CC_INFO, "Frozen Virt Orbs Per Irrep", (char *)(int *)frzvpi, sizeof(int) * nirreps);
@@ -378,114 +404,107 @@ PsiReturnType cctransort(SharedWavefunction ref, Options &options) {
                         frzcpi[i], clsdpi[i], openpi[i], uoccpi[i], frzvpi[i]);
     }
 
-    // Transformation
+    // The integral-direct RHF ladder in ccenergy never touches <ab|cd>
+    bool vvvv = !(reference == 0 && options.get_str("AO_BASIS") == "DIRECT");
 
-    outfile->Printf("\tTransforming integrals...\n");
-    std::vector<std::shared_ptr<MOSpace> > transspaces;
-    transspaces.push_back(MOSpace::occ);
-    transspaces.push_back(MOSpace::vir);
+    // Transformation
 
-    IntegralTransform *ints;
-    if (options.get_str("REFERENCE") == "RHF")
-        ints = new IntegralTransform(ref, transspaces, IntegralTransform::TransformationType::Restricted,
-                                     IntegralTransform::OutputType::DPDOnly);
-    else if (options.get_str("REFERENCE") == "ROHF") {
-        if (semicanonical)
-            // Importantly the transform is handled python-side so we technically have unrestricted orbitals at this
-            // point
+    double efzc = 0.0;
+    bool presort_predone = false;
+    if (tei_type == "CONV") {
+        outfile->Printf("\tTransforming integrals...\n");
+        std::vector<std::shared_ptr<MOSpace> > transspaces;
+        transspaces.push_back(MOSpace::occ);
+        transspaces.push_back(MOSpace::vir);
+
+        IntegralTransform *ints;
+        if (options.get_str("REFERENCE") == "RHF")
+            ints = new IntegralTransform(ref, transspaces, IntegralTransform::TransformationType::Restricted,
+                                         IntegralTransform::OutputType::DPDOnly);
+        else if (options.get_str("REFERENCE") == "ROHF") {
+            if (semicanonical)
+                // Importantly the transform is handled python-side so we technically have unrestricted orbitals at this
+                // point
+                ints = new IntegralTransform(ref, transspaces, IntegralTransform::TransformationType::Unrestricted,
+                                             IntegralTransform::OutputType::DPDOnly);
+            else
+                ints = new IntegralTransform(ref, transspaces, IntegralTransform::TransformationType::Restricted,
+                                             IntegralTransform::OutputType::DPDOnly);
+        } else if (options.get_str("REFERENCE") == "UHF")
             ints = new IntegralTransform(ref, transspaces, IntegralTransform::TransformationType::Unrestricted,
                                          IntegralTransform::OutputType::DPDOnly);
         else
-            ints = new IntegralTransform(ref, transspaces, IntegralTransform::TransformationType::Restricted,
-                                         IntegralTransform::OutputType::DPDOnly);
-    } else if (options.get_str("REFERENCE") == "UHF")
-        ints = new IntegralTransform(ref, transspaces, IntegralTransform::TransformationType::Unrestricted,
-                                     IntegralTransform::OutputType::DPDOnly);
-    else
-        throw PSIEXCEPTION("Invalid choice of reference wave function.");
+            throw PSIEXCEPTION("Invalid choice of reference wave function.");
+
+        dpd_set_default(ints->get_dpd_id());
+        ints->set_keep_dpd_so_ints(true);
+        if (!options.get_bool("DELETE_TEI") || options.get_str("AO_BASIS") == "DISK") {
+            outfile->Printf("\tIWL integrals will be retained.\n");
+            ints->set_keep_iwl_so_ints(true);
+        } else {
+            outfile->Printf("\tIWL integrals will be deleted.\n");
+            ints->set_keep_iwl_so_ints(false);
+        }
 
-    dpd_set_default(ints->get_dpd_id());
-    ints->set_keep_dpd_so_ints(true);
-    if (!options.get_bool("DELETE_TEI") || options.get_str("AO_BASIS") == "DISK") {
-        outfile->Printf("\tIWL integrals will be retained.\n");
-        ints->set_keep_iwl_so_ints(true);
-    } else {
-        outfile->Printf("\tIWL integrals will be deleted.\n");
-        ints->set_keep_iwl_so_ints(false);
-    }
+        // On the second and later passes of Brueckner, the presort is already done
+        // TDC: Always re-compute the presorted integrals until the frozen-core operator is included
+        /*
+        if(psio->tocentry_exists(PSIF_SO_PRESORT, "SO Ints (nn|nn)")) {
+          outfile->Printf("\tPresorted integrals already available.\n");
+          ints->set_tei_already_presorted(true);
+          presort_predone = true;
+        }
+        else {
+          outfile->Printf("\tPresorted integrals will be generated.\n");
+          ints->set_tei_already_presorted(false);
+        }
+        */
+
+        outfile->Printf("\t(OO|OO)...\n");
+        ints->transform_tei(MOSpace::occ, MOSpace::occ, MOSpace::occ, MOSpace::occ,
+                            IntegralTransform::HalfTrans::MakeAndKeep);
+        outfile->Printf("\t(OO|OV)...\n");
+        ints->transform_tei(MOSpace::occ, MOSpace::occ, MOSpace::occ, MOSpace::vir,
+                            IntegralTransform::HalfTrans::ReadAndKeep);
+        outfile->Printf("\t(OO|VV)...\n");
+        ints->transform_tei(MOSpace::occ, MOSpace::occ, MOSpace::vir, MOSpace::vir,
+                            IntegralTransform::HalfTrans::ReadAndNuke);
+
+        outfile->Printf("\t(OV|OO)...\n");
+        ints->transform_tei(MOSpace::occ, MOSpace::vir, MOSpace::occ, MOSpace::occ,
+                            IntegralTransform::HalfTrans::MakeAndKeep);
+        outfile->Printf("\t(OV|OV)...\n");
+        ints->transform_tei(MOSpace::occ, MOSpace::vir, MOSpace::occ, MOSpace::vir,
+                            IntegralTransform::HalfTrans::ReadAndKeep);
+        outfile->Printf("\t(OV|VV)...\n");
+        ints->transform_tei(MOSpace::occ, MOSpace::vir, MOSpace::vir, MOSpace::vir,
+                            IntegralTransform::HalfTrans::ReadAndNuke);
+
+        if (options.get_bool("DELETE_TEI")) ints->set_keep_dpd_so_ints(false);
+
+        outfile->Printf("\t(VV|OO)...\n");
+        ints->transform_tei(MOSpace::vir, MOSpace::vir, MOSpace::occ, MOSpace::occ,
+                            IntegralTransform::HalfTrans::MakeAndKeep);
+        outfile->Printf("\t(VV|OV)...\n");
+        ints->transform_tei(MOSpace::vir, MOSpace::vir, MOSpace::occ, MOSpace::vir,
+                            vvvv ? IntegralTransform::HalfTrans::ReadAndKeep : IntegralTransform::HalfTrans::ReadAndNuke);
+        if (vvvv) {
+            outfile->Printf("\t(VV|VV)...\n");
+            ints->transform_tei(MOSpace::vir, MOSpace::vir, MOSpace::vir, MOSpace::vir,
+                                IntegralTransform::HalfTrans::ReadAndNuke);
+        } else {
+            outfile->Printf("\t(VV|VV) skipped for AO_BASIS = DIRECT.\n");
+        }
 
-    // On the second and later passes of Brueckner, the presort is already done
-    // TDC: Always re-compute the presorted integrals until the frozen-core operator is included
-    bool presort_predone = false;
-    /*
-    if(psio->tocentry_exists(PSIF_SO_PRESORT, "SO Ints (nn|nn)")) {
-      outfile->Printf("\tPresorted integrals already available.\n");
-      ints->set_tei_already_presorted(true);
-      presort_predone = true;
-    }
-    else {
-      outfile->Printf("\tPresorted integrals will be generated.\n");
-      ints->set_tei_already_presorted(false);
-    }
-    */
-
-    outfile->Printf("\t(OO|OO)...\n");
-    ints->transform_tei(MOSpace::occ, MOSpace::occ, MOSpace::occ, MOSpace::occ,
-                        IntegralTransform::HalfTrans::MakeAndKeep);
-    outfile->Printf("\t(OO|OV)...\n");
-    ints->transform_tei(MOSpace::occ, MOSpace::occ, MOSpace::occ, MOSpace::vir,
-                        IntegralTransform::HalfTrans::ReadAndKeep);
-    outfile->Printf("\t(OO|VV)...\n");
-    ints->transform_tei(MOSpace::occ, MOSpace::occ, MOSpace::vir, MOSpace::vir,
-                        IntegralTransform::HalfTrans::ReadAndNuke);
-
-    outfile->Printf("\t(OV|OO)...\n");
-    ints->transform_tei(MOSpace::occ, MOSpace::vir, MOSpace::occ, MOSpace::occ,
-                        IntegralTransform::HalfTrans::MakeAndKeep);
-    outfile->Printf("\t(OV|OV)...\n");
-    ints->transform_tei(MOSpace::occ, MOSpace::vir, MOSpace::occ, MOSpace::vir,
-                        IntegralTransform::HalfTrans::ReadAndKeep);
-    outfile->Printf("\t(OV|VV)...\n");
-    ints->transform_tei(MOSpace::occ, MOSpace::vir, MOSpace::vir, MOSpace::vir,
-                        IntegralTransform::HalfTrans::ReadAndNuke);
-
-    if (options.get_bool("DELETE_TEI")) ints->set_keep_dpd_so_ints(false);
-
-    outfile->Printf("\t(VV|OO)...\n");
-    ints->transform_tei(MOSpace::vir, MOSpace::vir, MOSpace::occ, MOSpace::occ,
-                        IntegralTransform::HalfTrans::MakeAndKeep);
-    outfile->Printf("\t(VV|OV)...\n");
-    ints->transform_tei(MOSpace::vir, MOSpace::vir, MOSpace::occ, MOSpace::vir,
-                        IntegralTransform::HalfTrans::ReadAndKeep);
-    outfile->Printf("\t(VV|VV)...\n");
-    ints->transform_tei(MOSpace::vir, MOSpace::vir, MOSpace::vir, MOSpace::vir,
-                        IntegralTransform::HalfTrans::ReadAndNuke);
-
-    double efzc;
-    psio->open(PSIF_CC_INFO, PSIO_OPEN_OLD);
-    if (presort_predone)
-        psio->read_entry(PSIF_CC_INFO, "Frozen-Core Energy", (char *)&(efzc), sizeof(double));
-    else {
         efzc = ints->get_frozen_core_energy();
-        psio->write_entry(PSIF_CC_INFO, "Frozen-Core Energy", (char *)&(efzc), sizeof(double));
-    }
-    psio->close(PSIF_CC_INFO, 1);
-    outfile->Printf("\tFrozen core energy     =  %20.14f\n", efzc);
-
-    if (nfzc && (std::fabs(efzc) < 1e-7)) {
-        outfile->Printf("\tCCSORT Error: Orbitals are frozen in input,\n");
-        outfile->Printf("\tbut frozen core energy is small!\n");
-        outfile->Printf("\tCalculation will be aborted...\n");
-        exit(PSI_RETURN_FAILURE);
-    } else if (!nfzc && std::fabs(efzc)) {
-        outfile->Printf("\tCCSORT Warning: No orbitals are frozen,\n");
-        outfile->Printf("\tbut the frozen-core energy in wfn is non-zero.\n");
-        outfile->Printf("\tCalculation will continue with zero efzc...\n");
-        efzc = 0.0;
+        delete ints;
+    } else {
+        if (reference == 2)
+            throw PSIEXCEPTION("TEI_TYPE " + tei_type + " requires an RHF or non-semicanonical ROHF reference.");
+        if (options.get_str("AO_BASIS") == "DISK")
+            throw PSIEXCEPTION("TEI_TYPE " + tei_type + " cannot be combined with AO_BASIS DISK.");
     }
 
-    delete ints;
-
     // Set up DPD object
     std::vector<DPDMOSpace> spaces;
     int *cachefiles = init_int_array(PSIO_MAXUNIT);
@@ -524,12 +543,37 @@ PsiReturnType cctransort(SharedWavefunction ref, Options &options) {
 
     memcheck(reference);
 
+    // Build the MO integrals and frozen-core operator from three-index factors
+    if (tei_type != "CONV")
+        efzc = df_tei_rhf(ref, tei_type, options.get_double("CHOLESKY_TOLERANCE"), frzcpi, occpi, openpi, uoccpi, vvvv,
+                          psio);
+
+    psio->open(PSIF_CC_INFO, PSIO_OPEN_OLD);
+    if (presort_predone)
+        psio->read_entry(PSIF_CC_INFO, "Frozen-Core Energy", (char *)&(efzc), sizeof(double));
+    else
+        psio->write_entry(PSIF_CC_INFO, "Frozen-Core Energy", (char *)&(efzc), sizeof(double));
+    psio->close(PSIF_CC_INFO, 1);
+    outfile->Printf("\tFrozen core energy     =  %20.14f\n", efzc);
+
+    if (nfzc && (std::fabs(efzc) < 1e-7)) {
+        outfile->Printf("\tCCSORT Error: Orbitals are frozen in input,\n");
+        outfile->Printf("\tbut frozen core energy is small!\n");
+        outfile->Printf("\tCalculation will be aborted...\n");
+        exit(PSI_RETURN_FAILURE);
+    } else if (!nfzc && std::fabs(efzc)) {
+        outfile->Printf("\tCCSORT Warning: No orbitals are frozen,\n");
+        outfile->Printf("\tbut the frozen-core energy in wfn is non-zero.\n");
+        outfile->Printf("\tCalculation will continue with zero efzc...\n");
+        efzc = 0.0;
+    }
+
     // Sort two-electron integrals into six main categories
     psio->open(PSIF_LIBTRANS_DPD, PSIO_OPEN_OLD);
     if (reference == 2)
         sort_tei_uhf(psio, print);
     else
-        sort_tei_rhf(psio, print);
+        sort_tei_rhf(psio, print, vvvv);
     psio->close(PSIF_LIBTRANS_DPD, 0);  // delete file
 
     for (int i = PSIF_CC_MIN; i <= PSIF_CC_MAX; i++) psio->open(i, 1);
@@ -693,7 +737,7 @@ PsiReturnType cctransort(SharedWavefunction ref, Options &options) {
     e_sort(reference);
     f_sort(reference);
     if (reference == 0) {
-        b_spinad(psio);
+        if (vvvv) b_spinad(psio);
         a_spinad();
         d_spinad();
         e_spinad();
@@ -767,6 +811,9 @@ PsiReturnType cctransort(SharedWavefunction ref, Options &options) {
                             nsopi[h] * virpi[h] * sizeof(double), next, &next);
     }
 
+    signature[0] = 1.0;
+    psio->write_entry(PSIF_CC_INFO, "Sorted Integrals Signature", (char *)signature, sizeof(signature));
+
     dpd_close(0);
     if (reference == 2)
         cachedone_uhf(cachelist);
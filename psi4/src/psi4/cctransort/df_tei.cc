@@ -0,0 +1,325 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Psi4: an open-source quantum chemistry software package
+ *
+ * Copyright (c) 2007-2023 The Psi4 Developers.
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This file is part of Psi4.
+ *
+ * Psi4 is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * Psi4 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with Psi4; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * @END LICENSE
+ */
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "psi4/psifiles.h"
+#include "psi4/libpsio/psio.hpp"
+#include "psi4/libdpd/dpd.h"
+#include "psi4/libqt/qt.h"
+#include "psi4/libmints/basisset.h"
+#include "psi4/libmints/dimension.h"
+#include "psi4/libmints/integral.h"
+#include "psi4/libmints/matrix.h"
+#include "psi4/libmints/petitelist.h"
+#include "psi4/libmints/twobody.h"
+#include "psi4/libmints/wavefunction.h"
+#include "psi4/lib3index/cholesky.h"
+#include "psi4/lib3index/dftensor.h"
+#include "psi4/libpsi4util/PsiOutStream.h"
+#include "psi4/libpsi4util/process.h"
+
+namespace psi {
+namespace cctransort {
+
+/*
+** The three-index factors, L(Q|mn) in the AO basis.  With density fitting
+** the auxiliary index is symmetry adapted and Q of irrep h only couples to
+** mn of irrep h; Cholesky vectors carry no symmetry and are used for every
+** irrep.  qset[h] is the set used for pairs of irrep h.
+*/
+struct ThreeIndex {
+    std::vector<SharedMatrix> sets;
+    std::vector<int> qset;
+};
+
+static ThreeIndex three_index_factors(std::shared_ptr<Wavefunction> ref, const std::string &type, double cd_tol) {
+    ThreeIndex L;
+    std::shared_ptr<BasisSet> basis = ref->basisset();
+    int nirreps = ref->nirrep();
+    int nbf = basis->nbf();
+    int nbf2 = nbf * nbf;
+
+    if (type == "DF") {
+        std::shared_ptr<BasisSet> dfBasis = ref->get_basisset("DF_BASIS_CC");
+        int nocc = ref->doccpi().sum();
+        DFTensor dfints(basis, dfBasis, ref->Ca_subset("AO"), nocc, ref->nmo() - nocc);
+        SharedMatrix Qao = dfints.Qso();
+        double **pQao = Qao->pointer();
+
+        // Symmetry adapt the auxiliary index, as ccenergy does for its DF terms
+        PetiteList petite(dfBasis, ref->integral(), false);
+        SharedMatrix dfAOtoSO = petite.aotoso();
+        for (int h = 0; h < nirreps; h++) {
+            int nQso = dfAOtoSO->coldim(h);
+            int nQao = dfAOtoSO->rowdim(h);
+            auto Qh = std::make_shared<Matrix>("L(Q|mn)", nQso, nbf2);
+            if (nQso)
+                C_DGEMM('t', 'n', nQso, nbf2, nQao, 1.0, dfAOtoSO->pointer(h)[0], nQso, pQao[0], nbf2, 0.0,
+                        Qh->pointer()[0], nbf2);
+            L.sets.push_back(Qh);
+            L.qset.push_back(h);
+        }
+        outfile->Printf("\tNumber of auxiliary functions:  %5d\n", dfBasis->nbf());
+    } else {
+        auto Ch = std::make_shared<CholeskyERI>(std::shared_ptr<TwoBodyAOInt>(ref->integral()->eri()), 0.0, cd_tol,
+                                                Process::environment.get_memory());
+        Ch->choleskify();
+        L.sets.push_back(Ch->L());
+        L.qset.assign(nirreps, 0);
+        outfile->Printf("\tCholesky decomposition threshold: %8.2e\n", cd_tol);
+        outfile->Printf("\tNumber of Cholesky vectors:       %5zu\n", Ch->Q());
+    }
+
+    return L;
+}
+
+/*
+** Builds L(Q|pq) for the pairs of irrep h of one side of a DPD buffer.
+** pairorb, psym, poff, ... are the orbital lookups of that side and
+** Cp/Cq hold the AO coefficients of the p and q spaces per irrep.  The
+** AO-to-MO transformation is threaded over Q.
+*/
+static SharedMatrix mo_factors(const ThreeIndex &L, int h, int npairs, int **pairorb, const int *psym,
+                               const int *qsym, const int *poff, const int *qoff, const std::vector<SharedMatrix> &Cp,
+                               const std::vector<SharedMatrix> &Cq) {
+    SharedMatrix Qao = L.sets[L.qset[h]];
+    int nQ = Qao->rowdim();
+    int nirreps = Cp.size();
+    int nbf = Cp[0]->rowdim();
+
+    // Column offsets of each (Gp,Gq) block of the unpacked pq list
+    std::vector<long int> blk_off(nirreps);
+    long int nunpacked = 0;
+    for (int Gp = 0; Gp < nirreps; Gp++) {
+        blk_off[Gp] = nunpacked;
+        nunpacked += (long int)Cp[Gp]->coldim() * Cq[Gp ^ h]->coldim();
+    }
+    std::vector<long int> unpacked(npairs);
+    for (int pq = 0; pq < npairs; pq++) {
+        int p = pairorb[pq][0];
+        int q = pairorb[pq][1];
+        int Gp = psym[p];
+        int Gq = qsym[q];
+        unpacked[pq] = blk_off[Gp] + (long int)(p - poff[Gp]) * Cq[Gq]->coldim() + (q - qoff[Gq]);
+    }
+
+    auto B = std::make_shared<Matrix>("L(Q|pq)", nQ, npairs);
+    double **Bp = B->pointer();
+    double **Qp = Qao->pointer();
+
+    int nthreads = 1;
+#ifdef _OPENMP
+    nthreads = Process::environment.get_n_threads();
+#endif
+    std::vector<std::vector<double>> half(nthreads, std::vector<double>((size_t)nbf * nbf));
+    std::vector<std::vector<double>> full(nthreads, std::vector<double>(nunpacked));
+
+#pragma omp parallel for schedule(dynamic) num_threads(nthreads)
+    for (int Q = 0; Q < nQ; Q++) {
+        int thread = 0;
+#ifdef _OPENMP
+        thread = omp_get_thread_num();
+#endif
+        double *X = half[thread].data();
+        double *Y = full[thread].data();
+        for (int Gp = 0; Gp < nirreps; Gp++) {
+            int Gq = Gp ^ h;
+            int np = Cp[Gp]->coldim();
+            int nq = Cq[Gq]->coldim();
+            if (!np || !nq) continue;
+            // (Q|mn) C(n,q) -> (Q|mq), then C(m,p) (Q|mq) -> (Q|pq)
+            C_DGEMM('n', 'n', nbf, nq, nbf, 1.0, Qp[Q], nbf, Cq[Gq]->pointer()[0], nq, 0.0, X, nq);
+            C_DGEMM('t', 'n', np, nq, nbf, 1.0, Cp[Gp]->pointer()[0], np, X, nq, 0.0, &Y[blk_off[Gp]], nq);
+        }
+        for (int pq = 0; pq < npairs; pq++) Bp[Q][pq] = Y[unpacked[pq]];
+    }
+
+    return B;
+}
+
+/*
+** Writes (pq|rs) = sum_Q L(Q|pq) L(Q|rs) to PSIF_LIBTRANS_DPD under the label
+** and pair indices libtrans would use, so that sort_tei_rhf() can read it.
+*/
+static void build_tei(const ThreeIndex &L, const char *label, const char *pq_lbl, const char *rs_lbl,
+                      const std::vector<SharedMatrix> &Cp, const std::vector<SharedMatrix> &Cq,
+                      const std::vector<SharedMatrix> &Cr, const std::vector<SharedMatrix> &Cs) {
+    dpdbuf4 K;
+    global_dpd_->buf4_init(&K, PSIF_LIBTRANS_DPD, 0, pq_lbl, rs_lbl, pq_lbl, rs_lbl, 0, label);
+    bool same = !std::string(pq_lbl).compare(rs_lbl) && &Cp == &Cr && &Cq == &Cs;
+
+    for (int h = 0; h < K.params->nirreps; h++) {
+        long int nrows = K.params->rowtot[h];
+        long int ncols = K.params->coltot[h];
+        if (!nrows || !ncols) continue;
+
+        SharedMatrix Bpq = mo_factors(L, h, nrows, K.params->roworb[h], K.params->psym, K.params->qsym,
+                                      K.params->poff, K.params->qoff, Cp, Cq);
+        SharedMatrix Brs = same ? Bpq
+                                : mo_factors(L, h, ncols, K.params->colorb[h], K.params->rsym, K.params->ssym,
+                                             K.params->roff, K.params->soff, Cr, Cs);
+        int nQ = Bpq->rowdim();
+
+        long int factor_words = nQ * (nrows + (same ? 0 : ncols));
+        long int rows_per_bucket = (dpd_memfree() - factor_words) / ncols;
+        if (rows_per_bucket > nrows) rows_per_bucket = nrows;
+        if (rows_per_bucket < 1) rows_per_bucket = 1;
+
+        K.matrix[h] = global_dpd_->dpd_block_matrix(rows_per_bucket, ncols);
+        for (long int row = 0; row < nrows; row += rows_per_bucket) {
+            long int n = std::min(rows_per_bucket, nrows - row);
+            if (nQ)
+                C_DGEMM('t', 'n', n, ncols, nQ, 1.0, &Bpq->pointer()[0][row], nrows, Brs->pointer()[0], ncols, 0.0,
+                        K.matrix[h][0], ncols);
+            global_dpd_->buf4_mat_irrep_wrt_block(&K, h, row, n);
+        }
+        global_dpd_->free_dpd_block(K.matrix[h], rows_per_bucket, ncols);
+    }
+
+    global_dpd_->buf4_close(&K);
+}
+
+/*
+** DF_TEI_RHF(): Generates the RHF/ROHF MO integrals needed by sort_tei_rhf()
+** and the MO-basis frozen-core operator directly from DF or Cholesky
+** three-index factors.  This replaces the IWL presort and the libtrans
+** four-index transformation.  Returns the frozen-core energy.
+*/
+double df_tei_rhf(std::shared_ptr<Wavefunction> ref, const std::string &type, double cd_tol, Dimension &frzcpi,
+                  Dimension &occpi, Dimension &openpi, Dimension &uoccpi, bool vvvv, std::shared_ptr<PSIO> psio) {
+    int nirreps = ref->nirrep();
+    int nbf = ref->basisset()->nbf();
+    SharedMatrix AO2SO = ref->aotoso();
+    SharedMatrix Ca = ref->Ca();
+    Dimension nsopi = ref->nsopi();
+
+    outfile->Printf("\tBuilding %s integrals from three-index factors...\n", type.c_str());
+    ThreeIndex L = three_index_factors(ref, type, cd_tol);
+
+    // AO coefficients of the frozen, active occupied, and active virtual
+    // orbitals, the last with the singly occupied ones after the unoccupied
+    auto ao_block = [&](int h, const std::vector<std::pair<int, int>> &cols) {
+        int ncol = 0;
+        for (const auto &c : cols) ncol += c.second;
+        auto C = std::make_shared<Matrix>("C", nbf, ncol);
+        int offset = 0;
+        for (const auto &c : cols) {
+            if (nbf && nsopi[h] && c.second)
+                C_DGEMM('n', 'n', nbf, c.second, nsopi[h], 1.0, AO2SO->pointer(h)[0], nsopi[h],
+                        &Ca->pointer(h)[0][c.first], Ca->colspi(h), 0.0, &C->pointer()[0][offset], ncol);
+            offset += c.second;
+        }
+        return C;
+    };
+    std::vector<SharedMatrix> Cfzc, Cocc, Cvir;
+    for (int h = 0; h < nirreps; h++) {
+        int nclsd = occpi[h] - openpi[h];
+        Cfzc.push_back(ao_block(h, {{0, frzcpi[h]}}));
+        Cocc.push_back(ao_block(h, {{frzcpi[h], occpi[h]}}));
+        Cvir.push_back(ao_block(h, {{frzcpi[h] + occpi[h], uoccpi[h]}, {frzcpi[h] + nclsd, openpi[h]}}));
+    }
+
+    psio->open(PSIF_LIBTRANS_DPD, PSIO_OPEN_NEW);
+    outfile->Printf("\t(OO|OO)...\n");
+    build_tei(L, "MO Ints (OO|OO)", "i>=j+", "k>=l+", Cocc, Cocc, Cocc, Cocc);
+    outfile->Printf("\t(OO|OV)...\n");
+    build_tei(L, "MO Ints (OO|OV)", "i>=j+", "ka", Cocc, Cocc, Cocc, Cvir);
+    outfile->Printf("\t(OO|VV)...\n");
+    build_tei(L, "MO Ints (OO|VV)", "i>=j+", "a>=b+", Cocc, Cocc, Cvir, Cvir);
+    outfile->Printf("\t(OV|OV)...\n");
+    build_tei(L, "MO Ints (OV|OV)", "ia", "jb", Cocc, Cvir, Cocc, Cvir);
+    outfile->Printf("\t(OV|VV)...\n");
+    build_tei(L, "MO Ints (OV|VV)", "ia", "b>=c+", Cocc, Cvir, Cvir, Cvir);
+    if (vvvv) {
+        outfile->Printf("\t(VV|VV)...\n");
+        build_tei(L, "MO Ints (VV|VV)", "a>=b+", "c>=d+", Cvir, Cvir, Cvir, Cvir);
+    } else {
+        outfile->Printf("\t(VV|VV) skipped for AO_BASIS = DIRECT.\n");
+    }
+    psio->close(PSIF_LIBTRANS_DPD, 1);
+
+    // Frozen-core operator F = H + 2J - K in the AO basis, from the same factors
+    int nfzc = frzcpi.sum();
+    auto Dfzc = std::make_shared<Matrix>("D", nbf, nbf);
+    auto Gao = std::make_shared<Matrix>("G", nbf, nbf);
+    for (int h = 0; h < nirreps; h++)
+        if (frzcpi[h])
+            C_DGEMM('n', 't', nbf, nbf, frzcpi[h], 1.0, Cfzc[h]->pointer()[0], frzcpi[h], Cfzc[h]->pointer()[0],
+                    frzcpi[h], 1.0, Dfzc->pointer()[0], nbf);
+    if (nfzc) {
+        // All frozen orbitals, for the exchange term
+        auto Call = std::make_shared<Matrix>("C", nbf, nfzc);
+        for (int h = 0, offset = 0; h < nirreps; offset += frzcpi[h], h++)
+            for (int m = 0; m < nbf; m++)
+                for (int k = 0; k < frzcpi[h]; k++) Call->pointer()[m][offset + k] = Cfzc[h]->pointer()[m][k];
+        std::vector<double> X((size_t)nbf * nfzc);
+        for (const auto &Q : L.sets) {
+            double **Qp = Q->pointer();
+            for (int P = 0; P < Q->rowdim(); P++) {
+                double dQ = C_DDOT((size_t)nbf * nbf, Qp[P], 1, Dfzc->pointer()[0], 1);
+                C_DAXPY((size_t)nbf * nbf, 2.0 * dQ, Qp[P], 1, Gao->pointer()[0], 1);
+                C_DGEMM('n', 'n', nbf, nfzc, nbf, 1.0, Qp[P], nbf, Call->pointer()[0], nfzc, 0.0, X.data(), nfzc);
+                C_DGEMM('n', 't', nbf, nbf, nfzc, -1.0, X.data(), nfzc, X.data(), nfzc, 1.0, Gao->pointer()[0], nbf);
+            }
+        }
+    }
+
+    auto Fzc = std::make_shared<Matrix>(PSIF_MO_FZC, nsopi, nsopi);
+    Fzc->copy(ref->H());
+    std::vector<double> T((size_t)nbf * nsopi.max());
+    for (int h = 0; h < nirreps; h++) {
+        if (!nsopi[h] || !nbf) continue;
+        C_DGEMM('n', 'n', nbf, nsopi[h], nbf, 1.0, Gao->pointer()[0], nbf, AO2SO->pointer(h)[0], nsopi[h], 0.0,
+                T.data(), nsopi[h]);
+        C_DGEMM('t', 'n', nsopi[h], nsopi[h], nbf, 1.0, AO2SO->pointer(h)[0], nsopi[h], T.data(), nsopi[h], 1.0,
+                Fzc->pointer(h)[0], nsopi[h]);
+    }
+
+    // efzc = sum_k (h_kk + f_kk) over the frozen orbitals
+    auto Hmo = ref->H()->clone();
+    Hmo->transform(Ca);
+    Fzc->transform(Ca);
+    double efzc = 0.0;
+    for (int h = 0; h < nirreps; h++)
+        for (int k = 0; k < frzcpi[h]; k++) efzc += Hmo->get(h, k, k) + Fzc->get(h, k, k);
+
+    Fzc->set_name(PSIF_MO_FZC);
+    Fzc->save(psio, PSIF_OEI, Matrix::SaveType::LowerTriangle);
+
+    return efzc;
+}
+
+}  // namespace cctransort
+}  // namespace psi
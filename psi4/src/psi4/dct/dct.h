@@ -542,8 +542,6 @@ class DCTSolver : public Wavefunction {
     void form_df_g_vooo();
     /// Form density-fitted MO-basis TEI g(OV|VV) in chemists' notation
     void form_df_g_ovvv();
-    /// Form density-fitted MO-basis TEI g<VV|VV> in physists' notation
-    void form_df_g_vvvv();
     /// Form MO-based Gbar*Gamma
     void build_gbarGamma_RHF();
     void build_gbarGamma_UHF();
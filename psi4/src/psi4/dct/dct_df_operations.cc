@@ -889,73 +889,6 @@ void DCTSolver::form_df_g_ovvv() {
     dct_timer_off("DCTSolver::DF Transform_OVVV");
 }
 
-/**
- * Form density-fitted MO-basis TEI g(VV|VV)
- */
-void DCTSolver::form_df_g_vvvv() {
-    dct_timer_on("DCTSolver::DF Transform_VVVV");
-
-    int nthreads = 1;
-#ifdef _OPENMP
-    nthreads = Process::environment.get_n_threads();
-#endif
-
-    dpdbuf4 I;
-
-    // g(ab|cd) = Sum_Q b(ab|Q) b(Q|cd)
-    // Alpha-Alpha
-    global_dpd_->buf4_init(&I, PSIF_LIBTRANS_DPD, 0, ID("[V,V]"), ID("[V,V]"), ID("[V>=V]+"), ID("[V>=V]+"), 0,
-                           "MO Ints (VV|VV)");
-    for (int h = 0; h < nirrep_; ++h) {
-        if (I.params->rowtot[h] > 0 && I.params->coltot[h] > 0) {
-            double** bQabA_mo_p = bQabA_mo_.pointer(h);
-            global_dpd_->buf4_mat_irrep_init(&I, h);
-            C_DGEMM('T', 'N', I.params->rowtot[h], I.params->coltot[h], nQ_, 1.0, bQabA_mo_p[0], bQabA_mo_.coldim(h),
-                    bQabA_mo_p[0], bQabA_mo_.coldim(h), 0.0, I.matrix[h][0], I.params->coltot[h]);
-            global_dpd_->buf4_mat_irrep_wrt(&I, h);
-            global_dpd_->buf4_mat_irrep_close(&I, h);
-        }
-    }
-    global_dpd_->buf4_close(&I);
-
-    if (options_.get_str("REFERENCE") != "RHF") {
-        // Alpha-Beta
-        global_dpd_->buf4_init(&I, PSIF_LIBTRANS_DPD, 0, ID("[V,V]"), ID("[v,v]"), ID("[V>=V]+"), ID("[v>=v]+"), 0,
-                               "MO Ints (VV|vv)");
-        for (int h = 0; h < nirrep_; ++h) {
-            if (I.params->rowtot[h] > 0 && I.params->coltot[h] > 0) {
-                double** bQabA_mo_p = bQabA_mo_.pointer(h);
-                double** bQabB_mo_p = bQabB_mo_.pointer(h);
-                global_dpd_->buf4_mat_irrep_init(&I, h);
-                C_DGEMM('T', 'N', I.params->rowtot[h], I.params->coltot[h], nQ_, 1.0, bQabA_mo_p[0],
-                        bQabA_mo_.coldim(h), bQabB_mo_p[0], bQabB_mo_.coldim(h), 0.0, I.matrix[h][0],
-                        I.params->coltot[h]);
-                global_dpd_->buf4_mat_irrep_wrt(&I, h);
-                global_dpd_->buf4_mat_irrep_close(&I, h);
-            }
-        }
-        global_dpd_->buf4_close(&I);
-
-        // Beta-Beta
-        global_dpd_->buf4_init(&I, PSIF_LIBTRANS_DPD, 0, ID("[v,v]"), ID("[v,v]"), ID("[v>=v]+"), ID("[v>=v]+"), 0,
-                               "MO Ints (vv|vv)");
-        for (int h = 0; h < nirrep_; ++h) {
-            if (I.params->rowtot[h] > 0 && I.params->coltot[h] > 0) {
-                double** bQabB_mo_p = bQabB_mo_.pointer(h);
-                global_dpd_->buf4_mat_irrep_init(&I, h);
-                C_DGEMM('T', 'N', I.params->rowtot[h], I.params->coltot[h], nQ_, 1.0, bQabB_mo_p[0],
-                        bQabB_mo_.coldim(h), bQabB_mo_p[0], bQabB_mo_.coldim(h), 0.0, I.matrix[h][0],
-                        I.params->coltot[h]);
-                global_dpd_->buf4_mat_irrep_wrt(&I, h);
-                global_dpd_->buf4_mat_irrep_close(&I, h);
-            }
-        }
-        global_dpd_->buf4_close(&I);
-    }
-
-    dct_timer_off("DCTSolver::DF Transform_VVVV");
-}
-
 /**
  * Compute the density-fitted ERI <vv||vv> tensors in G intermediates
  * and contract with lambda_ijcd.
@@ -2054,10 +1987,11 @@ void DCTSolver::three_idx_cumulant_density() {
 
     global_dpd_->buf4_init(&G, PSIF_DCT_DENSITY, 0, ID("[V,V]"), ID("[V,V]"), ID("[V,V]"), ID("[V,V]"), 0,
                            "Lambda (VV|VV)");
-    result = DFTensor("3-Center PDM B: AB", nQ_, bQabA_mo_.idx2pi(), bQabA_mo_.idx3pi());
-    result.load(psio_, PSIF_DCT_DENSITY, Matrix::SaveType::SubBlocks);
+    // The VVVV part of the three-index density is kept separately as well: contracted with b(Q|EC), it gives the
+    // VVVV terms of the VV Lagrangian without ever forming <VV|VV> integrals.
+    auto vvvv = DFTensor("3-Center PDM B VVVV: AB", nQ_, bQabA_mo_.idx2pi(), bQabA_mo_.idx3pi());
     // gAB += b(Q|CD) L^AC_BD
-    result.contract343(bQabA_mo_, G, false, 4.0, 1.0);
+    vvvv.contract343(bQabA_mo_, G, false, 4.0, 0.0);
     global_dpd_->buf4_close(&G);
     // 13. From AbCd
     global_dpd_->buf4_init(&G, PSIF_DCT_DENSITY, 0, ID("[V,v]"), ID("[V,v]"), ID("[V,v]"), ID("[V,v]"), 0,
@@ -2068,12 +2002,15 @@ void DCTSolver::three_idx_cumulant_density() {
     global_dpd_->buf4_init(&G, PSIF_DCT_DENSITY, 0, ID("[v,v]"), ID("[V,V]"), ID("[v,v]"), ID("[V,V]"), 0,
                            "Lambda (vv|VV)");
     // gAB += b(Q|ab) L^aA_bB
-    result.contract343(bQabB_mo_, G, false, 4.0, 1.0);
-    result.save(psio_, PSIF_DCT_DENSITY, Matrix::SaveType::SubBlocks);
-    result = DFTensor("3-Center PDM B: ab", nQ_, bQabB_mo_.idx3pi(), bQabB_mo_.idx2pi());
+    vvvv.contract343(bQabB_mo_, G, false, 4.0, 1.0);
+    vvvv.save(psio_, PSIF_DCT_DENSITY, Matrix::SaveType::SubBlocks);
+    result = DFTensor("3-Center PDM B: AB", nQ_, bQabA_mo_.idx2pi(), bQabA_mo_.idx3pi());
     result.load(psio_, PSIF_DCT_DENSITY, Matrix::SaveType::SubBlocks);
+    result.add(vvvv);
+    result.save(psio_, PSIF_DCT_DENSITY, Matrix::SaveType::SubBlocks);
+    vvvv = DFTensor("3-Center PDM B VVVV: ab", nQ_, bQabB_mo_.idx2pi(), bQabB_mo_.idx3pi());
     // gab = b(Q|AB) L^Aa_Bb
-    result.contract343(bQabA_mo_, G, true, 4.0, 1.0);
+    vvvv.contract343(bQabA_mo_, G, true, 4.0, 0.0);
     global_dpd_->buf4_close(&G);
 
     global_dpd_->buf4_init(&G, PSIF_DCT_DENSITY, 0, ID("[v,v]"), ID("[v,v]"), ID("[v>v]-"), ID("[v>v]-"), 0,
@@ -2084,7 +2021,11 @@ void DCTSolver::three_idx_cumulant_density() {
     global_dpd_->buf4_init(&G, PSIF_DCT_DENSITY, 0, ID("[v,v]"), ID("[v,v]"), ID("[v,v]"), ID("[v,v]"), 0,
                            "Lambda (vv|vv)");
     // gab += b(Q|cd) L^ac_bd
-    result.contract343(bQabB_mo_, G, false, 4.0, 1.0);
+    vvvv.contract343(bQabB_mo_, G, false, 4.0, 1.0);
+    vvvv.save(psio_, PSIF_DCT_DENSITY, Matrix::SaveType::SubBlocks);
+    result = DFTensor("3-Center PDM B: ab", nQ_, bQabB_mo_.idx2pi(), bQabB_mo_.idx3pi());
+    result.load(psio_, PSIF_DCT_DENSITY, Matrix::SaveType::SubBlocks);
+    result.add(vvvv);
     result.save(psio_, PSIF_DCT_DENSITY, Matrix::SaveType::SubBlocks);
     global_dpd_->buf4_close(&G);
 
@@ -2233,10 +2174,10 @@ void DCTSolver::three_idx_cumulant_density_RHF() {
     global_dpd_->buf4_close(&G);
     global_dpd_->buf4_init(&G, PSIF_DCT_DENSITY, 0, ID("[V,V]"), ID("[V,V]"), ID("[V,V]"), ID("[V,V]"), 0,
                            "Lambda (VV|VV)");
-    result = DFTensor("3-Center PDM B: AB", nQ_, bQabA_mo_.idx2pi(), bQabA_mo_.idx3pi());
-    result.load(psio_, PSIF_DCT_DENSITY, Matrix::SaveType::SubBlocks);
+    // As in the UHF code, the VVVV part is also saved on its own for the VV Lagrangian.
+    auto vvvv = DFTensor("3-Center PDM B VVVV: AB", nQ_, bQabA_mo_.idx2pi(), bQabA_mo_.idx3pi());
     // gAB += b(Q|CD) L^CA_DB
-    result.contract343(bQabA_mo_, G, false, 4.0, 1.0);
+    vvvv.contract343(bQabA_mo_, G, false, 4.0, 0.0);
     global_dpd_->buf4_close(&G);
     // 9. AaBb
     global_dpd_->buf4_init(&G, PSIF_DCT_DENSITY, 0, ID("[V,V]"), ID("[V,V]"), ID("[V,V]"), ID("[V,V]"), 0,
@@ -2245,7 +2186,11 @@ void DCTSolver::three_idx_cumulant_density_RHF() {
     global_dpd_->buf4_close(&G);
     global_dpd_->buf4_init(&G, PSIF_DCT_DENSITY, 0, ID("[V,V]"), ID("[V,V]"), ID("[V,V]"), ID("[V,V]"), 0,
                            "Lambda SF (VV|VV)");
-    result.contract343(bQabA_mo_, G, false, 4.0, 1.0);
+    vvvv.contract343(bQabA_mo_, G, false, 4.0, 1.0);
+    vvvv.save(psio_, PSIF_DCT_DENSITY, Matrix::SaveType::SubBlocks);
+    result = DFTensor("3-Center PDM B: AB", nQ_, bQabA_mo_.idx2pi(), bQabA_mo_.idx3pi());
+    result.load(psio_, PSIF_DCT_DENSITY, Matrix::SaveType::SubBlocks);
+    result.add(vvvv);
     result.save(psio_, PSIF_DCT_DENSITY, Matrix::SaveType::SubBlocks);
 
     auto J = Matrix("J^-1/2 Correlation", nQ_, nQ_);
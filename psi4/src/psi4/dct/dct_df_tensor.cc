@@ -204,6 +204,56 @@ DFTensor DFTensor::contract123(const Matrix& Q, const Matrix& G) {
     return result;
 }
 
+Matrix DFTensor::contract332(const DFTensor& L, const DFTensor& R) {
+    if (L.symmetry() || R.symmetry()) {
+        throw PSIEXCEPTION("contract332: Can only handle totally symmetric tensors.");
+    }
+    if (L.rowspi() != R.rowspi()) {
+        throw PSIEXCEPTION("contract332: Left and right operands disagree about number of aux. functions.");
+    }
+    if (L.dim2_ != R.dim2_ || L.dim3_ != R.dim3_) {
+        throw PSIEXCEPTION("contract332: Left and right operands must have the same primary dimensions.");
+    }
+
+    int nthreads = 1;
+#ifdef _OPENMP
+    nthreads = Process::environment.get_n_threads();
+#endif
+
+    auto nirrep = L.nirrep();
+    auto result = Matrix("sum_Q sum_r L(Q|pr) R(Q|qr)", L.dim2_, R.dim2_);
+    // The aux. index is the longest, so each thread accumulates its own copy of the result over a slice of Q.
+    std::vector<Matrix> partial(nthreads, Matrix(result.name(), L.dim2_, R.dim2_));
+
+    for (int h = 0; h < nirrep; ++h) {
+        auto Lp = L.pointer(h);
+        auto Rp = R.pointer(h);
+        auto nQ = L.rowspi(h);
+        int offset = 0;
+        for (int hp = 0; hp < nirrep; ++hp) {
+            const auto np = L.dim2_[hp];
+            const auto nr = L.dim3_[hp ^ h];
+            if (np > 0 && nr > 0) {
+#pragma omp parallel for schedule(static) num_threads(nthreads)
+                for (int Q = 0; Q < nQ; ++Q) {
+                    int thread = 0;
+#ifdef _OPENMP
+                    thread = omp_get_thread_num();
+#endif
+                    C_DGEMM('N', 'T', np, np, nr, 1.0, Lp[Q] + offset, nr, Rp[Q] + offset, nr, 1.0,
+                            partial[thread].pointer(hp)[0], np);
+                }
+            }
+            offset += np * nr;
+        }
+        if (offset != L.colspi(h)) throw PSIEXCEPTION("contract332: Dimension mismatch");
+    }
+
+    for (const auto& part : partial) result.add(part);
+
+    return result;
+}
+
 void DFTensor::add_3idx_transpose_inplace() {
     if (symmetry()) {
         throw PSIEXCEPTION("add_3idx_transpose_inplace: Tensor must be totally symmetric.");
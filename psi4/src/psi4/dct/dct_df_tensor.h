@@ -65,6 +65,8 @@ class DFTensor : public Matrix {
       static DFTensor contract233(const Matrix& J, const DFTensor& B);
       /// (Q) (p|q) -> (Q|pq)
       static DFTensor contract123(const Matrix& Q, const Matrix& G);
+      /// r(p|q) = \sum_Q \sum_r L(Q|pr) R(Q|qr)
+      static Matrix contract332(const DFTensor& L, const DFTensor& R);
 
 };
 
@@ -262,31 +262,42 @@ void DCTSolver::compute_lagrangian_VV_RHF(bool separate_gbargamma) {
     // 2 * <VV||VV> Г_VVVV
     //
 
-    // X_EA += 2 * <EB||CD> Г_ABCD
-    dct_timer_on("DCTSolver::2 * g_EBCD Gamma_ABCD");
-    global_dpd_->file2_init(&X, PSIF_DCT_DPD, 0, ID('V'), ID('V'), "X <V|V>");
-    global_dpd_->buf4_init(&I, PSIF_LIBTRANS_DPD, 0, ID("[V,V]"), ID("[V,V]"), ID("[V,V]"), ID("[V,V]"), 1,
-                           "MO Ints <VV|VV>");
-    global_dpd_->buf4_init(&G, PSIF_DCT_DENSITY, 0, ID("[V,V]"), ID("[V,V]"), ID("[V,V]"), ID("[V,V]"), 0,
-                           varname("<VV|VV>"));
-
-    global_dpd_->contract442(&I, &G, &X, 0, 0, 2.0, 1.0);
-    global_dpd_->buf4_close(&G);
-    global_dpd_->buf4_close(&I);
-    global_dpd_->file2_close(&X);
-    dct_timer_off("DCTSolver::2 * g_EBCD Gamma_ABCD");
-
-    // X_EA += 4 * <Eb|Cd> Г_AbCd
-    global_dpd_->file2_init(&X, PSIF_DCT_DPD, 0, ID('V'), ID('V'), "X <V|V>");
-    global_dpd_->buf4_init(&I, PSIF_LIBTRANS_DPD, 0, ID("[V,V]"), ID("[V,V]"), ID("[V,V]"), ID("[V,V]"), 0,
-                           "MO Ints <VV|VV>");
-    global_dpd_->buf4_init(&G, PSIF_DCT_DENSITY, 0, ID("[V,V]"), ID("[V,V]"), ID("[V,V]"), ID("[V,V]"), 0,
-                           varname("SF <VV|VV>"));
+    if (separate_gbargamma) {
+        // With density fitting, the VVVV terms are b(Q|EC) g(Q|AC); see compute_lagrangian_VV.
+        auto gAB = DFTensor("3-Center PDM B VVVV: AB", nQ_, bQabA_mo_.idx2pi(), bQabA_mo_.idx3pi());
+        gAB.load(psio_, PSIF_DCT_DENSITY, Matrix::SaveType::SubBlocks);
+        global_dpd_->file2_init(&X, PSIF_DCT_DPD, 0, ID('V'), ID('V'), "X <V|V>");
+        auto X_VV = Matrix(&X);
+        X_VV.add(DFTensor::contract332(bQabA_mo_, gAB));
+        X_VV.write_to_dpdfile2(&X);
+        global_dpd_->file2_close(&X);
+    } else {
+        // X_EA += 2 * <EB||CD> Г_ABCD
+        dct_timer_on("DCTSolver::2 * g_EBCD Gamma_ABCD");
+        global_dpd_->file2_init(&X, PSIF_DCT_DPD, 0, ID('V'), ID('V'), "X <V|V>");
+        global_dpd_->buf4_init(&I, PSIF_LIBTRANS_DPD, 0, ID("[V,V]"), ID("[V,V]"), ID("[V,V]"), ID("[V,V]"), 1,
+                               "MO Ints <VV|VV>");
+        global_dpd_->buf4_init(&G, PSIF_DCT_DENSITY, 0, ID("[V,V]"), ID("[V,V]"), ID("[V,V]"), ID("[V,V]"), 0,
+                               varname("<VV|VV>"));
+
+        global_dpd_->contract442(&I, &G, &X, 0, 0, 2.0, 1.0);
+        global_dpd_->buf4_close(&G);
+        global_dpd_->buf4_close(&I);
+        global_dpd_->file2_close(&X);
+        dct_timer_off("DCTSolver::2 * g_EBCD Gamma_ABCD");
 
-    global_dpd_->contract442(&I, &G, &X, 0, 0, 4.0, 1.0);
-    global_dpd_->buf4_close(&G);
-    global_dpd_->buf4_close(&I);
-    global_dpd_->file2_close(&X);
+        // X_EA += 4 * <Eb|Cd> Г_AbCd
+        global_dpd_->file2_init(&X, PSIF_DCT_DPD, 0, ID('V'), ID('V'), "X <V|V>");
+        global_dpd_->buf4_init(&I, PSIF_LIBTRANS_DPD, 0, ID("[V,V]"), ID("[V,V]"), ID("[V,V]"), ID("[V,V]"), 0,
+                               "MO Ints <VV|VV>");
+        global_dpd_->buf4_init(&G, PSIF_DCT_DENSITY, 0, ID("[V,V]"), ID("[V,V]"), ID("[V,V]"), ID("[V,V]"), 0,
+                               varname("SF <VV|VV>"));
+
+        global_dpd_->contract442(&I, &G, &X, 0, 0, 4.0, 1.0);
+        global_dpd_->buf4_close(&G);
+        global_dpd_->buf4_close(&I);
+        global_dpd_->file2_close(&X);
+    }
 
     //
     // <OO||VV> Г_OOVV
@@ -315,13 +315,9 @@ void DCTSolver::dc06_response_init() {
 
 void DCTSolver::oo_gradient_init() {
     // If the <VV|VV> integrals were not used for the energy computation (AO_BASIS = DISK) -> compute them for the
-    // gradients
+    // gradients. The DF gradient never needs them; its VVVV Lagrangian terms come from three-index quantities.
     if (options_.get_str("AO_BASIS") == "DISK" && options_.get_str("DCT_TYPE") == "CONV") {
         _ints->transform_tei(MOSpace::vir, MOSpace::vir, MOSpace::vir, MOSpace::vir);
-    } else if (options_.get_str("DCT_TYPE") == "DF") {
-        psio_->open(PSIF_LIBTRANS_DPD, PSIO_OPEN_OLD);
-        form_df_g_vvvv();
-        psio_->close(PSIF_LIBTRANS_DPD, 1);
     } else {
         return;
     }
@@ -3367,53 +3363,73 @@ void DCTSolver::compute_lagrangian_VV(bool separate_gbargamma) {
     // 2 * <VV||VV> Г_VVVV
     //
 
-    // X_EA += 2 * <EB||CD> Г_ABCD
-    global_dpd_->file2_init(&X, PSIF_DCT_DPD, 0, ID('V'), ID('V'), "X <V|V>");
-    global_dpd_->buf4_init(&I, PSIF_LIBTRANS_DPD, 0, ID("[V,V]"), ID("[V,V]"), ID("[V,V]"), ID("[V,V]"), 1,
-                           "MO Ints <VV|VV>");
-    global_dpd_->buf4_init(&G, PSIF_DCT_DENSITY, 0, ID("[V,V]"), ID("[V,V]"), ID("[V>V]-"), ID("[V>V]-"), 0,
-                           varname("<VV|VV>"));
+    if (separate_gbargamma) {
+        // With density fitting, 2 <EB||CD> Г_ABCD + 4 <Eb|Cd> Г_AbCd = b(Q|EC) g(Q|AC), where g(Q|AC) is the VVVV
+        // part of the three-index cumulant density. This avoids the V^4 <VV|VV> integrals entirely.
+        auto gAB = DFTensor("3-Center PDM B VVVV: AB", nQ_, bQabA_mo_.idx2pi(), bQabA_mo_.idx3pi());
+        gAB.load(psio_, PSIF_DCT_DENSITY, Matrix::SaveType::SubBlocks);
+        global_dpd_->file2_init(&X, PSIF_DCT_DPD, 0, ID('V'), ID('V'), "X <V|V>");
+        auto X_VV = Matrix(&X);
+        X_VV.add(DFTensor::contract332(bQabA_mo_, gAB));
+        X_VV.write_to_dpdfile2(&X);
+        global_dpd_->file2_close(&X);
 
-    global_dpd_->contract442(&I, &G, &X, 0, 0, 2.0, 1.0);
-    global_dpd_->buf4_close(&G);
-    global_dpd_->buf4_close(&I);
-    global_dpd_->file2_close(&X);
+        auto gab = DFTensor("3-Center PDM B VVVV: ab", nQ_, bQabB_mo_.idx2pi(), bQabB_mo_.idx3pi());
+        gab.load(psio_, PSIF_DCT_DENSITY, Matrix::SaveType::SubBlocks);
+        global_dpd_->file2_init(&X, PSIF_DCT_DPD, 0, ID('v'), ID('v'), "X <v|v>");
+        auto X_vv = Matrix(&X);
+        X_vv.add(DFTensor::contract332(bQabB_mo_, gab));
+        X_vv.write_to_dpdfile2(&X);
+        global_dpd_->file2_close(&X);
+    } else {
+        // X_EA += 2 * <EB||CD> Г_ABCD
+        global_dpd_->file2_init(&X, PSIF_DCT_DPD, 0, ID('V'), ID('V'), "X <V|V>");
+        global_dpd_->buf4_init(&I, PSIF_LIBTRANS_DPD, 0, ID("[V,V]"), ID("[V,V]"), ID("[V,V]"), ID("[V,V]"), 1,
+                               "MO Ints <VV|VV>");
+        global_dpd_->buf4_init(&G, PSIF_DCT_DENSITY, 0, ID("[V,V]"), ID("[V,V]"), ID("[V>V]-"), ID("[V>V]-"), 0,
+                               varname("<VV|VV>"));
 
-    // X_EA += 4 * <Eb|Cd> Г_AbCd
-    global_dpd_->file2_init(&X, PSIF_DCT_DPD, 0, ID('V'), ID('V'), "X <V|V>");
-    global_dpd_->buf4_init(&I, PSIF_LIBTRANS_DPD, 0, ID("[V,v]"), ID("[V,v]"), ID("[V,v]"), ID("[V,v]"), 0,
-                           "MO Ints <Vv|Vv>");
-    global_dpd_->buf4_init(&G, PSIF_DCT_DENSITY, 0, ID("[V,v]"), ID("[V,v]"), ID("[V,v]"), ID("[V,v]"), 0,
-                           varname("<Vv|Vv>"));
+        global_dpd_->contract442(&I, &G, &X, 0, 0, 2.0, 1.0);
+        global_dpd_->buf4_close(&G);
+        global_dpd_->buf4_close(&I);
+        global_dpd_->file2_close(&X);
 
-    global_dpd_->contract442(&I, &G, &X, 0, 0, 4.0, 1.0);
-    global_dpd_->buf4_close(&G);
-    global_dpd_->buf4_close(&I);
-    global_dpd_->file2_close(&X);
+        // X_EA += 4 * <Eb|Cd> Г_AbCd
+        global_dpd_->file2_init(&X, PSIF_DCT_DPD, 0, ID('V'), ID('V'), "X <V|V>");
+        global_dpd_->buf4_init(&I, PSIF_LIBTRANS_DPD, 0, ID("[V,v]"), ID("[V,v]"), ID("[V,v]"), ID("[V,v]"), 0,
+                               "MO Ints <Vv|Vv>");
+        global_dpd_->buf4_init(&G, PSIF_DCT_DENSITY, 0, ID("[V,v]"), ID("[V,v]"), ID("[V,v]"), ID("[V,v]"), 0,
+                               varname("<Vv|Vv>"));
 
-    // X_ea += 2 * <ib||cd> Г_abcd
-    global_dpd_->file2_init(&X, PSIF_DCT_DPD, 0, ID('v'), ID('v'), "X <v|v>");
-    global_dpd_->buf4_init(&I, PSIF_LIBTRANS_DPD, 0, ID("[v,v]"), ID("[v,v]"), ID("[v,v]"), ID("[v,v]"), 1,
-                           "MO Ints <vv|vv>");
-    global_dpd_->buf4_init(&G, PSIF_DCT_DENSITY, 0, ID("[v,v]"), ID("[v,v]"), ID("[v>v]-"), ID("[v>v]-"), 0,
-                           varname("<vv|vv>"));
+        global_dpd_->contract442(&I, &G, &X, 0, 0, 4.0, 1.0);
+        global_dpd_->buf4_close(&G);
+        global_dpd_->buf4_close(&I);
+        global_dpd_->file2_close(&X);
 
-    global_dpd_->contract442(&I, &G, &X, 0, 0, 2.0, 1.0);
-    global_dpd_->buf4_close(&G);
-    global_dpd_->buf4_close(&I);
-    global_dpd_->file2_close(&X);
+        // X_ea += 2 * <ib||cd> Г_abcd
+        global_dpd_->file2_init(&X, PSIF_DCT_DPD, 0, ID('v'), ID('v'), "X <v|v>");
+        global_dpd_->buf4_init(&I, PSIF_LIBTRANS_DPD, 0, ID("[v,v]"), ID("[v,v]"), ID("[v,v]"), ID("[v,v]"), 1,
+                               "MO Ints <vv|vv>");
+        global_dpd_->buf4_init(&G, PSIF_DCT_DENSITY, 0, ID("[v,v]"), ID("[v,v]"), ID("[v>v]-"), ID("[v>v]-"), 0,
+                               varname("<vv|vv>"));
 
-    // X_ea += 4 * <eB|cD> Г_AbCd
-    global_dpd_->file2_init(&X, PSIF_DCT_DPD, 0, ID('v'), ID('v'), "X <v|v>");
-    global_dpd_->buf4_init(&I, PSIF_LIBTRANS_DPD, 0, ID("[V,v]"), ID("[V,v]"), ID("[V,v]"), ID("[V,v]"), 0,
-                           "MO Ints <Vv|Vv>");
-    global_dpd_->buf4_init(&G, PSIF_DCT_DENSITY, 0, ID("[V,v]"), ID("[V,v]"), ID("[V,v]"), ID("[V,v]"), 0,
-                           varname("<Vv|Vv>"));
+        global_dpd_->contract442(&I, &G, &X, 0, 0, 2.0, 1.0);
+        global_dpd_->buf4_close(&G);
+        global_dpd_->buf4_close(&I);
+        global_dpd_->file2_close(&X);
 
-    global_dpd_->contract442(&I, &G, &X, 1, 1, 4.0, 1.0);
-    global_dpd_->buf4_close(&G);
-    global_dpd_->buf4_close(&I);
-    global_dpd_->file2_close(&X);
+        // X_ea += 4 * <eB|cD> Г_AbCd
+        global_dpd_->file2_init(&X, PSIF_DCT_DPD, 0, ID('v'), ID('v'), "X <v|v>");
+        global_dpd_->buf4_init(&I, PSIF_LIBTRANS_DPD, 0, ID("[V,v]"), ID("[V,v]"), ID("[V,v]"), ID("[V,v]"), 0,
+                               "MO Ints <Vv|Vv>");
+        global_dpd_->buf4_init(&G, PSIF_DCT_DENSITY, 0, ID("[V,v]"), ID("[V,v]"), ID("[V,v]"), ID("[V,v]"), 0,
+                               varname("<Vv|Vv>"));
+
+        global_dpd_->contract442(&I, &G, &X, 1, 1, 4.0, 1.0);
+        global_dpd_->buf4_close(&G);
+        global_dpd_->buf4_close(&I);
+        global_dpd_->file2_close(&X);
+    }
 
     //
     // <OO||VV> Г_OOVV
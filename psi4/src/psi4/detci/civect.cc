@@ -46,9 +46,13 @@
 **
 */
 
+#include <algorithm>
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include <cmath>
+#include <map>
+#include <vector>
 #include "psi4/pybind11.h"
 
 #include "psi4/libciomr/libciomr.h"
@@ -82,6 +86,77 @@ extern int calc_orb_diff(int cnt, unsigned char *I, unsigned char *J, int *I_alp
 #define MIN0(a, b) (((a) < (b)) ? (a) : (b))
 #define MAX0(a, b) (((a) > (b)) ? (a) : (b))
 
+namespace {
+
+/*
+** CI vector buffers kept in memory in place of their PSIO entries, by
+** unit and buffer number.  Vectors sharing a unit (e.g. the Ivec/Jvec
+** pairs of the density code) see the same buffers, as they would on disk.
+** The entries are written out to PSIO only when the files are closed
+** and kept.
+*/
+struct MemBuffer {
+    double *data;
+    size_t size;
+};
+std::map<int, std::map<int, MemBuffer>> mem_store;
+size_t mem_budget = 0;
+size_t mem_used = 0;
+
+/* Words per pass of the fused vector kernels; a chunk of each operand
+   stays in cache while all the vectors are run over it */
+const size_t fuse_chunk = 2048;
+
+/* target += sum_k coef[k] * src[k], one chunk of target at a time */
+void fused_combine(double *target, size_t size, const std::vector<double> &coef, const std::vector<double *> &src) {
+    for (size_t off = 0; off < size; off += fuse_chunk) {
+        size_t n = std::min(fuse_chunk, size - off);
+        for (size_t k = 0; k < src.size(); k++) C_DAXPY(n, coef[k], src[k] + off, 1, target + off, 1);
+    }
+}
+
+size_t mem_bytes(size_t size) { return ((size * sizeof(double) + 63) / 64) * 64; }
+
+void mem_drop(int unit) {
+    auto it = mem_store.find(unit);
+    if (it == mem_store.end()) return;
+    for (auto &entry : it->second) {
+        free(entry.second.data);
+        mem_used -= mem_bytes(entry.second.size);
+    }
+    mem_store.erase(it);
+}
+
+MemBuffer *mem_find(int unit, int buf, size_t size) {
+    auto it = mem_store.find(unit);
+    if (it == mem_store.end()) return nullptr;
+    auto jt = it->second.find(buf);
+    if (jt == it->second.end() || jt->second.size < size) return nullptr;
+    return &jt->second;
+}
+
+/* Memory entry for a buffer that is about to be written, or nullptr if
+   it does not fit in the budget and has to go to disk */
+MemBuffer *mem_get(int unit, int buf, size_t size) {
+    auto &entries = mem_store[unit];
+    auto it = entries.find(buf);
+    if (it != entries.end()) {
+        if (it->second.size >= size) return &it->second;
+        free(it->second.data);
+        mem_used -= mem_bytes(it->second.size);
+        entries.erase(it);
+    }
+    if (mem_used + mem_bytes(size) > mem_budget) return nullptr;
+    auto *data = static_cast<double *>(aligned_alloc(64, mem_bytes(size)));
+    if (data == nullptr) return nullptr;
+    mem_used += mem_bytes(size);
+    return &(entries[buf] = MemBuffer{data, size});
+}
+
+}  // namespace
+
+void CIvect::set_memory_budget(size_t bytes) { mem_budget = bytes; }
+
 CIvect::CIvect()  // Default constructor
 {
     common_init();
@@ -1722,6 +1797,7 @@ void CIvect::init_io_files(bool open_old) {
                 psio_open((size_t)units_[i], PSIO_OPEN_OLD);
             } else {
                 psio_open((size_t)units_[i], PSIO_OPEN_NEW);
+                mem_drop(units_[i]);
             }
         }
     }
@@ -1742,7 +1818,16 @@ void CIvect::close_io_files(int keep) {
         return;
     }
 
+    char key[20];
     for (size_t i = 0; i < nunits_; i++) {
+        if (keep && mem_store.count(units_[i])) {
+            for (auto &entry : mem_store[units_[i]]) {
+                sprintf(key, "buffer_ %d", entry.first);
+                psio_write_entry((size_t)units_[i], key, (char *)entry.second.data,
+                                 entry.second.size * (size_t)sizeof(double));
+            }
+        }
+        mem_drop(units_[i]);
         psio_close(units_[i], keep);
     }
     fopen_ = false;
@@ -1780,17 +1865,17 @@ int CIvect::read(int ivect, int ibuf) {
     }
 
     if (icore_ == 1) ibuf = 0;
-    buf = ivect * buf_per_vect_ + ibuf;
-
+    buf = phys_buf(ivect, ibuf);
     size = buf_size_[ibuf] * (size_t)sizeof(double);
-
-    /* translate buffer number in case we renumbered after collapse * */
-    buf += new_first_buf_;
-    if (buf >= buf_total_) buf -= buf_total_;
-    sprintf(key, "buffer_ %d", buf);
     unit = file_number_[buf];
 
-    psio_read_entry((size_t)unit, key, (char *)buffer_, size);
+    MemBuffer *mem = mem_find(unit, buf, buf_size_[ibuf]);
+    if (mem != nullptr) {
+        memcpy(buffer_, mem->data, size);
+    } else {
+        sprintf(key, "buffer_ %d", buf);
+        psio_read_entry((size_t)unit, key, (char *)buffer_, size);
+    }
 
     cur_vect_ = ivect;
     cur_buf_ = ibuf;
@@ -1831,16 +1916,17 @@ int CIvect::write(int ivect, int ibuf) {
     //    }
 
     if (icore_ == 1) ibuf = 0;
-    buf = ivect * buf_per_vect_ + ibuf;
+    buf = phys_buf(ivect, ibuf);
     size = buf_size_[ibuf] * (size_t)sizeof(double);
-
-    /* translate buffer number in case we renumbered after collapse * */
-    buf += new_first_buf_;
-    if (buf >= buf_total_) buf -= buf_total_;
-    sprintf(key, "buffer_ %d", buf);
     unit = file_number_[buf];
 
-    psio_write_entry((size_t)unit, key, (char *)buffer_, size);
+    MemBuffer *mem = mem_budget ? mem_get(unit, buf, buf_size_[ibuf]) : nullptr;
+    if (mem != nullptr) {
+        memcpy(mem->data, buffer_, size);
+    } else {
+        sprintf(key, "buffer_ %d", buf);
+        psio_write_entry((size_t)unit, key, (char *)buffer_, size);
+    }
 
     if (ivect >= nvect_) nvect_ = ivect + 1;
     cur_vect_ = ivect;
@@ -1851,6 +1937,65 @@ int CIvect::write(int ivect, int ibuf) {
     return (1);
 }
 
+/*
+** CIvect::phys_buf(): Buffer number of buffer ibuf of vector ivect,
+**    translated in case we renumbered after a collapse
+*/
+int CIvect::phys_buf(int ivect, int ibuf) {
+    int buf = ivect * buf_per_vect_ + ibuf + new_first_buf_;
+    if (buf >= buf_total_) buf -= buf_total_;
+    return buf;
+}
+
+/*
+** CIvect::mem_buffers(): Collect pointers to the in-memory copies of
+**    buffer ibuf of vectors first...last-1.
+**
+** Returns: true if all of them are in memory, else false
+*/
+bool CIvect::mem_buffers(int first, int last, int ibuf, std::vector<double *> &bufs) {
+    bufs.clear();
+    if (nunits_ < 1) return false;
+    for (int ivect = first; ivect < last; ivect++) {
+        int buf = phys_buf(ivect, ibuf);
+        MemBuffer *mem = mem_find(file_number_[buf], buf, buf_size_[ibuf]);
+        if (mem == nullptr) return false;
+        bufs.push_back(mem->data);
+    }
+    return true;
+}
+
+/*
+** CIvect::dot_vectors(): Scalar products of vectors first...last-1 of C
+**    with vector ivect of this CIvect, dots[j-first] = C[j] * this[ivect].
+**    Buffers held in memory are run over once, a chunk at a time for all
+**    the C vectors; otherwise they are read in turn as in operator*().
+**    Both CIvects must have their buffers locked.
+*/
+void CIvect::dot_vectors(CIvect &C, int ivect, int first, int last, double *dots) {
+    int nvec = last - first;
+    std::vector<double *> cbufs, sbuf;
+
+    for (int j = 0; j < nvec; j++) dots[j] = 0.0;
+
+    for (int buf = 0; buf < buf_per_vect_; buf++) {
+        double factor = (Ms0_ && buf_offdiag_[buf]) ? 2.0 : 1.0;
+        size_t size = buf_size_[buf];
+        if (mem_buffers(ivect, ivect + 1, buf, sbuf) && C.mem_buffers(first, last, buf, cbufs)) {
+            for (size_t off = 0; off < size; off += fuse_chunk) {
+                size_t n = std::min(fuse_chunk, size - off);
+                for (int j = 0; j < nvec; j++) dots[j] += factor * C_DDOT(n, cbufs[j] + off, 1, sbuf[0] + off, 1);
+            }
+        } else {
+            read(ivect, buf);
+            for (int j = 0; j < nvec; j++) {
+                C.read(first + j, buf);
+                dots[j] += factor * C_DDOT(size, C.buffer_, 1, buffer_, 1);
+            }
+        }
+    }
+}
+
 /*
 ** CIvect::schmidt_add()
 **
@@ -2120,6 +2265,9 @@ void CIvect::dcalc(int nr, int L, double **alpha, double *lambda, double *norm_a
                    double *buf2, int *root_converged, int printflag, double *E_est) {
     int buf, ivect, root, tmproot, converged = 0, i;
     double tval;
+    bool davidson = (CI_Params_->update == UPDATE_DAVIDSON);
+    std::vector<double *> cbufs, sbufs, src;
+    std::vector<double> coef;
 
     buf_lock(buf2);
 
@@ -2147,19 +2295,33 @@ void CIvect::dcalc(int nr, int L, double **alpha, double *lambda, double *norm_a
                 xeax(buffer_, -E_est[root], buf_size_[buf]);
                 /* buffer is know E_est*C^k */
             }
-            for (ivect = 0; ivect < L; ivect++) {
-                if (CI_Params_->update == UPDATE_DAVIDSON) { /* DAVIDSON update formula */
-                    C.buf_lock(buf1);
-                    C.read(ivect, buf);
-                    tval = -alpha[ivect][root] * lambda[root];
-                    xpeay(buffer_, tval, C.buffer_, buf_size_[buf]);
-                    C.buf_unlock();
+            if (S.mem_buffers(0, L, buf, sbufs) && (!davidson || C.mem_buffers(0, L, buf, cbufs))) {
+                coef.clear();
+                src.clear();
+                for (ivect = 0; ivect < L; ivect++) {
+                    if (davidson) {
+                        coef.push_back(-alpha[ivect][root] * lambda[root]);
+                        src.push_back(cbufs[ivect]);
+                    }
+                    coef.push_back(alpha[ivect][root]);
+                    src.push_back(sbufs[ivect]);
                 }
-                S.buf_lock(buf1);
-                S.read(ivect, buf);
-                xpeay(buffer_, alpha[ivect][root], S.buffer_, buf_size_[buf]);
-                S.buf_unlock();
-            } /* end loop over ivect */
+                fused_combine(buffer_, buf_size_[buf], coef, src);
+            } else {
+                for (ivect = 0; ivect < L; ivect++) {
+                    if (davidson) { /* DAVIDSON update formula */
+                        C.buf_lock(buf1);
+                        C.read(ivect, buf);
+                        tval = -alpha[ivect][root] * lambda[root];
+                        xpeay(buffer_, tval, C.buffer_, buf_size_[buf]);
+                        C.buf_unlock();
+                    }
+                    S.buf_lock(buf1);
+                    S.read(ivect, buf);
+                    xpeay(buffer_, alpha[ivect][root], S.buffer_, buf_size_[buf]);
+                    S.buf_unlock();
+                } /* end loop over ivect */
+            }
             // dot_arr(buffer_, buffer_, buf_size_[buf], &tval);
             tval = C_DDOT(buf_size_[buf], buffer_, 1, buffer_, 1);
             if (buf_offdiag_[buf]) tval *= 2.0;
@@ -2747,14 +2909,23 @@ void CIvect::copy(CIvect &Src, int targetvec, int srcvec) {
 void CIvect::restart_gather(int ivec, int nvec, int nroot, double **alpha, double *buffer_1, double *buffer_2) {
     int buf, oldvec;
 
+    std::vector<double *> bufs;
+    std::vector<double> coef(nvec);
+
+    for (oldvec = 0; oldvec < nvec; oldvec++) coef[oldvec] = alpha[oldvec][nroot];
+
     for (buf = 0; buf < buf_per_vect_; buf++) {
         zero_arr(buffer_2, buf_size_[buf]);
-        buf_lock(buffer_1);
-        for (oldvec = 0; oldvec < nvec; oldvec++) {
-            read(oldvec, buf);
-            xpeay(buffer_2, alpha[oldvec][nroot], buffer_1, buf_size_[buf]);
+        if (mem_buffers(0, nvec, buf, bufs)) {
+            fused_combine(buffer_2, buf_size_[buf], coef, bufs);
+        } else {
+            buf_lock(buffer_1);
+            for (oldvec = 0; oldvec < nvec; oldvec++) {
+                read(oldvec, buf);
+                xpeay(buffer_2, alpha[oldvec][nroot], buffer_1, buf_size_[buf]);
+            }
+            buf_unlock();
         }
-        buf_unlock();
         buf_lock(buffer_2);
         write(ivec, buf);
         buf_unlock();
@@ -2775,13 +2946,22 @@ void CIvect::restart_gather(int ivec, int nvec, int nroot, double **alpha, doubl
 void CIvect::gather(int ivec, int nvec, int nroot, double **alpha, CIvect &C) {
     int buf, oldvec;
 
+    std::vector<double *> bufs;
+    std::vector<double> coef(nvec);
+
+    for (oldvec = 0; oldvec < nvec; oldvec++) coef[oldvec] = alpha[oldvec][nroot];
+
     /* outfile->Printf("In CIvect::gather\n"); */
     for (buf = 0; buf < buf_per_vect_; buf++) {
         zero_arr(buffer_, buf_size_[buf]);
-        for (oldvec = 0; oldvec < nvec; oldvec++) {
-            C.read(oldvec, buf);
-            xpeay(buffer_, alpha[oldvec][nroot], C.buffer_, buf_size_[buf]);
-            /* outfile->Printf("coef[%d][%d] = %10.7f\n",oldvec,nroot,alpha[oldvec][nroot]); */
+        if (C.mem_buffers(0, nvec, buf, bufs)) {
+            fused_combine(buffer_, buf_size_[buf], coef, bufs);
+        } else {
+            for (oldvec = 0; oldvec < nvec; oldvec++) {
+                C.read(oldvec, buf);
+                xpeay(buffer_, alpha[oldvec][nroot], C.buffer_, buf_size_[buf]);
+                /* outfile->Printf("coef[%d][%d] = %10.7f\n",oldvec,nroot,alpha[oldvec][nroot]); */
+            }
         }
         write(ivec, buf);
     }
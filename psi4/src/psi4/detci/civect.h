@@ -125,6 +125,8 @@ class CIvect {
 
     double ssq(struct stringwr *alplist, struct stringwr *betlist, double **CL, double **CR, int nas, int nbs,
                int Ja_list, int Jb_list);
+    int phys_buf(int ivect, int ibuf);
+    bool mem_buffers(int first, int last, int ibuf, std::vector<double *> &bufs);
 
    public:
     CIvect();
@@ -165,6 +167,8 @@ class CIvect {
     void buf_unlock();
     double *buf_malloc();
     void set_nvect(int i);
+    /// Bytes of CI vector buffers that may be kept in memory instead of on disk
+    static void set_memory_budget(size_t bytes);
 
     // Questionable functions and/or should be private
     void set(int incor, int maxvect, int nunits, int funit, struct ci_blks *CIblks);
@@ -172,6 +176,7 @@ class CIvect {
              int nbc, int nirr, int cdperirr, int maxvect, int nunits, int funit, int *fablk, int *lablk, int **dc);
     void print();
     double operator*(CIvect &b);
+    void dot_vectors(CIvect &C, int ivect, int first, int last, double *dots);
     void setarray(const double *a, size_t len);
     void max_abs_vals(int nval, int *iac, int *ibc, int *iaidx, int *ibidx, double *coeff, int neg_only);
     double blk_max_abs_vals(int i, int offdiag, int nval, int *iac, int *ibc, int *iaidx, int *ibidx, double *coeff,
@@ -33,6 +33,7 @@
 #include "psi4/libscf_solver/hf.h"
 #include "psi4/libmints/vector.h"
 #include "psi4/libmints/matrix.h"
+#include "psi4/libfock/jk.h"
 #include "psi4/libfock/soscf.h"
 #include "psi4/detci/globaldefs.h"
 #include "psi4/detci/ciwave.h"
@@ -83,6 +84,9 @@ void CIWavefunction::common_init() {
     get_mo_info();            /* read DOCC, SOCC, frozen, nmo, etc        */
     set_ras_parameters();     /* set fermi levels and the like            */
 
+    // CI vector buffers may be held in up to half of the memory instead of on disk
+    CIvect::set_memory_budget(Parameters_->vecs_in_memory ? Process::environment.get_memory() / 2 : 0);
+
     // Print out information
     print_ = Parameters_->print_;
     print_parameters();
@@ -115,6 +119,15 @@ void CIWavefunction::common_init() {
     cleaned_up_ci_ = false;
     fzc_fock_computed_ = false;
 
+    name_ = "CIWavefunction";
+    module_ = "detci";
+
+    // The selected CI builds its own determinant space, no strings needed
+    if (Parameters_->diag_method == METHOD_HCI) {
+        sci_init();
+        return;
+    }
+
     // Form strings
     outfile->Printf("\n   ==> Setting up CI strings <==\n\n");
     form_strings();
@@ -122,9 +135,6 @@ void CIWavefunction::common_init() {
     // Form Bendazzoli OV arrays
     if (Parameters_->bendazzoli) form_ov();
 
-    name_ = "CIWavefunction";
-    module_ = "detci";
-
     // Init H0 block
     H0block_init(CIblks_->vectlen);
 
@@ -132,7 +142,10 @@ void CIWavefunction::common_init() {
         throw PSIEXCEPTION("CIWavefunction: Must have more than one determinant!");
     }
 }
-size_t CIWavefunction::ndet() { return (size_t)CIblks_->vectlen; }
+size_t CIWavefunction::ndet() {
+    if (Parameters_->diag_method == METHOD_HCI) return sci_->alp.size();
+    return (size_t)CIblks_->vectlen;
+}
 
 double CIWavefunction::compute_energy() {
     if (Parameters_->istop) { /* Print size of space, other stuff, only   */
@@ -443,6 +456,8 @@ SharedMatrix CIWavefunction::get_tpdm(const std::string& spin, bool symmetrize)
 }
 
 void CIWavefunction::reset_ci_H0block() {
+    if (Parameters_->diag_method == METHOD_HCI) return;
+
     // Free H0block
     H0block_free();
 
@@ -466,10 +481,11 @@ void CIWavefunction::cleanup_ci() {
         if (CalcInfo_->sigma_initialized) sigma_free();
         delete SigmaData_;
 
-        free_int_matrix(CIblks_->decode);
+        if (CIblks_->decode) free_int_matrix(CIblks_->decode);
         free(CIblks_->first_iablk);
         free(CIblks_->last_iablk);
         delete CIblks_;
+        sci_.reset();
 
         // delete Parameters_;
 
@@ -649,6 +665,19 @@ void CIWavefunction::init_mcscf_object() {
 
     somcscf_->set_memory(Process::environment.get_memory() * 0.8 / sizeof(double));
 
+    // Cheaper JK for the AH hessian vector products, COSX and LinK cannot take their non-symmetric densities
+    if ((options_.get_str("MCSCF_HK_JK") == "DF") && (Parameters_->mcscf_type != "DF")) {
+        outfile->Printf("\n   ==> Setting up DF JK for the orbital Hessian products <==\n\n");
+        size_t hk_memory = Process::environment.get_memory() * 0.4 / sizeof(double);
+        auto hk_jk = JK::build_JK(basisset_, get_basisset("DF_BASIS_SCF"), options_, "MEM_DF");
+        hk_jk->set_do_J(true);
+        hk_jk->set_do_K(true);
+        hk_jk->set_memory(hk_memory);
+        hk_jk->initialize();
+        hk_jk->print_header();
+        somcscf_->set_approx_jk(hk_jk);
+    }
+
     // Set fzc energy
     SharedMatrix Cfzc = get_orbitals("FZC");
     somcscf_->set_frozen_orbitals(Cfzc);
@@ -63,6 +63,7 @@ struct stringwr;
 struct ci_blks;
 struct olsen_graph;
 struct H_zero_block;
+struct sci_space;
 typedef std::shared_ptr<psi::detci::CIvect> SharedCIVector;
 }  // namespace detci
 }  // namespace psi
@@ -353,6 +354,7 @@ class CIWavefunction : public Wavefunction {
     /// Non-DF integral functions
     void setup_mcscf_ints();
     void transform_mcscf_ints(bool approx_only = false);
+    void transform_mcscf_ints_incore();
     void read_dpd_ci_ints();
     void rotate_mcscf_twoel_ints(SharedMatrix K, SharedVector twoel_out);
 
@@ -427,17 +429,21 @@ class CIWavefunction : public Wavefunction {
     void sigma_init(CIvect &C, CIvect &S);
     void sigma_free();
     void sigma(CIvect &C, CIvect &S, double *oei, double *tei, int ivec);
+    void sigma_multi(CIvect &C, CIvect &S, double *oei, double *tei, int first, int nvec);
 
     void sigma_a(struct stringwr **alplist, struct stringwr **betlist, CIvect &C, CIvect &S, double *oei, double *tei,
                  int fci, int ivec);
     void sigma_b(struct stringwr **alplist, struct stringwr **betlist, CIvect &C, CIvect &S, double *oei, double *tei,
                  int fci, int ivec);
+    void sigma_b_vectors(struct stringwr **alplist, struct stringwr **betlist, CIvect &C, CIvect &S, double *oei,
+                         double *tei, int fci, std::vector<double ***> &cblocks, std::vector<double ***> &sblocks,
+                         std::vector<double *> &sbufs);
     void sigma_c(struct stringwr **alplist, struct stringwr **betlist, CIvect &C, CIvect &S, double *oei, double *tei,
                  int fci, int ivec);
 
     void sigma_block(struct stringwr **alplist, struct stringwr **betlist, double **cmat, double **smat, double *oei,
                      double *tei, int fci, int cblock, int sblock, int nas, int nbs, int sac, int sbc, int cac, int cbc,
-                     int cnas, int cnbs, int cnac, int cnbc, int sbirr, int cbirr, int Ms0);
+                     int cnas, int cnbs, int cnac, int cnbc, int sbirr, int cbirr, int Ms0, struct sigma_data *SD);
     void sigma_get_contrib(struct stringwr **alplist, struct stringwr **betlist, CIvect &C, CIvect &S, int **s1_contrib,
                            int **s2_contrib, int **s3_contrib);
     void form_ov();
@@ -446,6 +452,13 @@ class CIWavefunction : public Wavefunction {
 
     void print_vec(size_t nprint, int *Ialist, int *Iblist, int *Iaidx, int *Ibidx, double *coeff);
 
+    /// => Heat-bath selected CI <= //
+    std::shared_ptr<sci_space> sci_;
+    void sci_init();
+    void sci_diag(double *evals, double conv_e, double conv_rms);
+    std::vector<std::vector<SharedMatrix> > sci_opdm(std::vector<std::tuple<int, int> > states_vec);
+    std::vector<SharedMatrix> sci_tpdm(std::vector<std::tuple<int, int, double> > states_vec);
+
     /// => MCSCF helpers <= //
 
     /// => MPn helpers <= //
@@ -455,6 +468,8 @@ class CIWavefunction : public Wavefunction {
     std::vector<std::vector<SharedMatrix> > opdm(SharedCIVector Ivec, SharedCIVector Jvec,
                                                  std::vector<std::tuple<int, int> > states_vec);
     SharedMatrix opdm_add_inactive(SharedMatrix opdm, double value, bool virt = false);
+    void opdm_from_ci_order(std::vector<std::vector<SharedMatrix> > &opdm_list, double **onepdm_a, double **onepdm_b,
+                            int Iroot, int Jroot);
     void opdm_block(struct stringwr **alplist, struct stringwr **betlist, double **onepdm_a, double **onepdm_b,
                     double **CJ, double **CI, int Ja_list, int Jb_list, int Jnas, int Jnbs, int Ia_list, int Ib_list,
                     int Inas, int Inbs);
@@ -472,6 +487,7 @@ class CIWavefunction : public Wavefunction {
     void tpdm_block(struct stringwr **alplist, struct stringwr **betlist, int nbf, int nalplists, int nbetlists,
                     double *twopdm_aa, double *twopdm_bb, double *twopdm_ab, double **CJ, double **CI, int Ja_list,
                     int Jb_list, int Jnas, int Jnbs, int Ia_list, int Ib_list, int Inas, int Inbs, double weight);
+    std::vector<SharedMatrix> tpdm_from_ci_order(double *twopdm_aa, double *twopdm_ab, double *twopdm_bb);
 
     bool tpdm_called_;
     SharedMatrix tpdm_;
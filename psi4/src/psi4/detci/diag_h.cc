@@ -77,15 +77,21 @@ int CIWavefunction::diag_h(double conv_e, double conv_rms) {
     Parameters_->diag_h_converged = false;
     Parameters_->diag_iters_taken = 0;
 
-    size = CIblks_->vectlen;
+    size = ndet();
     if ((size_t)Parameters_->nprint > size) Parameters_->nprint = (int)size;
     nucrep = CalcInfo_->enuc;
     edrc = CalcInfo_->edrc;
 
     if (Parameters_->bendazzoli) outfile->Printf("    Bendazzoli algorithm selected for sigma3\n");
 
+    /* Heat-bath selected CI --- grows its own determinant space */
+    if (Parameters_->diag_method == METHOD_HCI) {
+        evals = init_array(nroots);
+        sci_diag(evals, conv_e, conv_rms);
+    }
+
     /* Direct Method --- use RSP diagonalization routine */
-    if (Parameters_->diag_method == METHOD_RSP) {
+    else if (Parameters_->diag_method == METHOD_RSP) {
         double h_size = (double)(8 * size * size);
         if (h_size > (Process::environment.get_memory() * 0.4)) {
             outfile->Printf("CIWave::Requsted size of the hamiltonian is %4.2lf GB!\n", h_size / 1E9);
@@ -295,7 +301,9 @@ int CIWavefunction::diag_h(double conv_e, double conv_rms) {
     set_scalar_variable("CI TOTAL ENERGY", tval);
     set_scalar_variable("CI CORRELATION ENERGY", tval - CalcInfo_->escf);
 
-    if (Parameters_->fci) {
+    if (Parameters_->diag_method == METHOD_HCI) {
+        // the selected CI only approximates these, only the CI energies are set
+    } else if (Parameters_->fci) {
         set_scalar_variable("FCI TOTAL ENERGY", tval);
         set_scalar_variable("FCI CORRELATION ENERGY", tval - CalcInfo_->escf);
     } else {
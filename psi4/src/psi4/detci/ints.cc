@@ -385,7 +385,7 @@ void CIWavefunction::setup_mcscf_ints_ao() {
         throw PSIEXCEPTION("GTFock was not compiled in this version");
 #endif
     } else if ((options_.get_str("SCF_TYPE").find("DF") != std::string::npos) || scf_type == "CD" || scf_type == "PK" ||
-               scf_type == "DIRECT" || scf_type == "OUT_OF_CORE") {
+               scf_type == "DIRECT" || scf_type == "OUT_OF_CORE" || scf_type == "AUTO") {
         jk_ = JK::build_JK(this->basisset(), get_basisset("DF_BASIS_SCF"), options_, false,
                            Process::environment.get_memory() * 0.8 / sizeof(double));
     } else {
@@ -581,6 +581,16 @@ void CIWavefunction::transform_mcscf_ints(bool approx_only) {
     // The orbital matrix need to be identical to the previous one
     ints_->set_orbitals(get_orbitals("ALL"));
 
+    // Small active spaces skip the DPD files, (aR|aa) and the half transformed ints are held in core
+    size_t nact = CalcInfo_->num_ci_orbs;
+    size_t nrot = CalcInfo_->num_rot_orbs;
+    double incore_size = 8.0 * nact * nact * (nrot * nact + 0.5 * nso_ * nso_);
+    if (approx_only && (incore_size < 0.2 * Process::environment.get_memory())) {
+        transform_mcscf_ints_incore();
+        timer_off("CIWave: MCSCF integral transform");
+        return;
+    }
+
     if (approx_only) {
         // We only need (aa|aa), (aa|aN) for appoximate update
         ints_->set_keep_ht_ints(true);  // Save the aa half ints here
@@ -604,6 +614,9 @@ void CIWavefunction::transform_mcscf_ints(bool approx_only) {
 
     // Read DPD ints into memory
     read_dpd_ci_ints();
+    if (mcscf_object_init_) {
+        somcscf_->set_eri_tensors(SharedMatrix(), SharedMatrix());
+    }
 
     // => Compute onel ints <= //
     // Libtrans does NOT change efzc or MO_FZC unless presort is called.
@@ -617,6 +630,41 @@ void CIWavefunction::transform_mcscf_ints(bool approx_only) {
     timer_off("CIWave: MCSCF integral transform");
 }
 
+void CIWavefunction::transform_mcscf_ints_incore() {
+    timer_on("CIWave: In-core MCSCF integral transform");
+    size_t nact = CalcInfo_->num_ci_orbs;
+
+    // (Ra|aa), the rot and active spaces run over their orbitals in Pitzer order
+    SharedMatrix raaa = ints_->transform_tei_incore(rot_space_, act_space_, act_space_, act_space_);
+
+    std::vector<size_t> active_abs;
+    for (int h = 0, orbnum = 0; h < CalcInfo_->nirreps; h++) {
+        orbnum += CalcInfo_->rstr_docc[h];
+        for (int i = 0; i < CalcInfo_->ci_orbs[h]; i++) {
+            active_abs.push_back(orbnum++);
+        }
+        orbnum += CalcInfo_->rstr_uocc[h];
+    }
+
+    auto aaaa = std::make_shared<Matrix>("ALL Active", nact * nact, nact * nact);
+    for (size_t u = 0; u < nact; u++) {
+        C_DCOPY(nact * nact * nact, raaa->pointer()[active_abs[u] * nact], 1, aaaa->pointer()[u * nact], 1);
+    }
+
+    // The one-electron integrals come from the JK object below
+    pitzer_to_ci_order_twoel(aaaa, CalcInfo_->twoel_ints);
+    tei_raaa_ = raaa;
+    tei_aaaa_ = aaaa;
+    if (mcscf_object_init_) {
+        somcscf_->set_eri_tensors(tei_aaaa_, tei_raaa_);
+    }
+
+    onel_ints_from_jk();
+
+    tf_onel_ints(CalcInfo_->onel_ints, CalcInfo_->twoel_ints, CalcInfo_->tf_onel_ints);
+    form_gmat(CalcInfo_->onel_ints, CalcInfo_->twoel_ints, CalcInfo_->gmat);
+    timer_off("CIWave: In-core MCSCF integral transform");
+}
 void CIWavefunction::read_dpd_ci_ints() {
     // => Read one electron integrals <= //
     // Build temporary desired arrays
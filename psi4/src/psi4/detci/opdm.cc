@@ -60,7 +60,8 @@ namespace detci {
 void CIWavefunction::form_opdm() {
     // if we're trying to follow a root, figure out which one here
     // CDS help: Why is this here and where can we move it?
-    if (Parameters_->follow_vec_num > 0) {
+    bool sci = (Parameters_->diag_method == METHOD_HCI);
+    if (Parameters_->follow_vec_num > 0 && !sci) {
         CIvect Ivec(Parameters_->icore, Parameters_->num_roots, 1, Parameters_->d_filenum, CIblks_, CalcInfo_,
                     Parameters_, H0block_, false);
         Ivec.init_io_files(true);
@@ -101,10 +102,17 @@ void CIWavefunction::form_opdm() {
         set_scalar_variable("CURRENT REFERENCE ENERGY", CalcInfo_->escf);
     }
 
-    SharedCIVector Ivec = new_civector(Parameters_->num_roots, Parameters_->d_filenum);
-    Ivec->init_io_files(true);
-    SharedCIVector Jvec = new_civector(Parameters_->num_roots, Parameters_->d_filenum);
-    Jvec->init_io_files(true);
+    // The selected-CI roots are held in memory rather than in the D file
+    SharedCIVector Ivec, Jvec;
+    if (!sci) {
+        Ivec = new_civector(Parameters_->num_roots, Parameters_->d_filenum);
+        Ivec->init_io_files(true);
+        Jvec = new_civector(Parameters_->num_roots, Parameters_->d_filenum);
+        Jvec->init_io_files(true);
+    }
+    auto opdm_states = [&](std::vector<std::tuple<int, int> > &states) {
+        return sci ? sci_opdm(states) : opdm(Ivec, Jvec, states);
+    };
 
     std::vector<std::vector<SharedMatrix> > opdm_list;
     std::vector<std::tuple<int, int> > states_vec;
@@ -117,7 +125,7 @@ void CIWavefunction::form_opdm() {
                 states_vec.push_back(std::make_tuple(i, j));
             }
         }
-        opdm_list = opdm(Ivec, Jvec, states_vec);
+        opdm_list = opdm_states(states_vec);
         for (const auto& tdm : opdm_list) {
             opdm_map_[tdm[0]->name()] = tdm[0];
             opdm_map_[tdm[1]->name()] = tdm[1];
@@ -130,13 +138,13 @@ void CIWavefunction::form_opdm() {
     for (int i = 0; i < Parameters_->num_roots; ++i) {
         states_vec.push_back(std::make_tuple(i, i));
     }
-    opdm_list = opdm(Ivec, Jvec, states_vec);
+    opdm_list = opdm_states(states_vec);
     for (int i = 0; i < Parameters_->num_roots; i++) {
         opdm_map_[opdm_list[i][0]->name()] = opdm_list[i][0];
         opdm_map_[opdm_list[i][1]->name()] = opdm_list[i][1];
         opdm_map_[opdm_list[i][2]->name()] = opdm_list[i][2];
     }
-    Ivec->close_io_files(true);  // Closes Jvec too
+    if (!sci) Ivec->close_io_files(true);  // Closes Jvec too
 
     // Figure out which OPDM should be current
     if (Parameters_->opdm_ave) {
@@ -253,7 +261,6 @@ std::vector<std::vector<SharedMatrix> > CIWavefunction::opdm(SharedCIVector Ivec
     }
 
     int nci = CalcInfo_->num_ci_orbs;
-    Dimension act_dim = get_dimension("ACT");
     auto scratch_a = std::make_shared<Matrix>("OPDM A Scratch", nci, nci);
     auto scratch_b = std::make_shared<Matrix>("OPDM B Scratch", nci, nci);
     double **scratch_ap = scratch_a->pointer();
@@ -443,77 +450,87 @@ std::vector<std::vector<SharedMatrix> > CIWavefunction::opdm(SharedCIVector Ivec
             throw PSIEXCEPTION("CIWavefunction::opdm: unrecognized core option!\n");
         }
 
-        std::stringstream opdm_name;
-        opdm_name << "MO-basis Alpha OPDM <" << Iroot << "| Etu |" << Jroot << ">";
-        auto new_OPDM_a = std::make_shared<Matrix>(opdm_name.str(), nirrep_, act_dim, act_dim);
+        opdm_from_ci_order(opdm_list, scratch_ap, scratch_bp, Iroot, Jroot);
+    } /* end loop over states_vec */
 
-        opdm_name.str(std::string());
-        opdm_name << "MO-basis Beta OPDM <" << Iroot << "| Etu |" << Jroot << ">";
-        auto new_OPDM_b = std::make_shared<Matrix>(opdm_name.str(), nirrep_, act_dim, act_dim);
+    if (transp_tmp) free(transp_tmp[0]);
+    free(transp_tmp);
+    if (transp_tmp2) free(transp_tmp2[0]);
+    free(transp_tmp2);
 
-        opdm_name.str(std::string());
-        opdm_name << "MO-basis OPDM <" << Iroot << "| Etu |" << Jroot << ">";
-        auto new_OPDM = std::make_shared<Matrix>(opdm_name.str(), nirrep_, act_dim, act_dim);
+    scratch_a.reset();
+    scratch_b.reset();
+    timer_off("CIWave: opdm");
 
-        int offset = 0;
-        for (int h = 0; h < nirrep_; h++) {
-            if (!CalcInfo_->ci_orbs[h]) continue;
+    return opdm_list;
+}
 
-            double *opdm_a = new_OPDM_a->pointer(h)[0];
-            double *opdm_b = new_OPDM_b->pointer(h)[0];
-            double *opdm = new_OPDM->pointer(h)[0];
+/*
+** Converts the CI-ordered <Iroot| Etu |Jroot> alpha and beta OPDMs into
+** symmetry-blocked active-space Matrices, appending the alpha, beta, and
+** summed matrices (and, for a transition density, their transposes) to opdm_list.
+*/
+void CIWavefunction::opdm_from_ci_order(std::vector<std::vector<SharedMatrix> > &opdm_list, double **onepdm_a,
+                                        double **onepdm_b, int Iroot, int Jroot) {
+    Dimension act_dim = get_dimension("ACT");
 
-            for (int i = 0, target = 0; i < CalcInfo_->ci_orbs[h]; i++) {
-                int ni = CalcInfo_->act_reorder[i + offset];
-                for (int j = 0; j < CalcInfo_->ci_orbs[h]; j++) {
-                    int nj = CalcInfo_->act_reorder[j + offset];
+    std::stringstream opdm_name;
+    opdm_name << "MO-basis Alpha OPDM <" << Iroot << "| Etu |" << Jroot << ">";
+    auto new_OPDM_a = std::make_shared<Matrix>(opdm_name.str(), nirrep_, act_dim, act_dim);
 
-                    opdm_a[target] = scratch_ap[ni][nj];
-                    opdm_b[target] = scratch_bp[ni][nj];
-                    opdm[target++] = scratch_ap[ni][nj] + scratch_bp[ni][nj];
-                }
-            }
-            offset += CalcInfo_->ci_orbs[h];
-        }
+    opdm_name.str(std::string());
+    opdm_name << "MO-basis Beta OPDM <" << Iroot << "| Etu |" << Jroot << ">";
+    auto new_OPDM_b = std::make_shared<Matrix>(opdm_name.str(), nirrep_, act_dim, act_dim);
 
-        std::vector<SharedMatrix> opdm_root_vec = {new_OPDM_a, new_OPDM_b, new_OPDM};
+    opdm_name.str(std::string());
+    opdm_name << "MO-basis OPDM <" << Iroot << "| Etu |" << Jroot << ">";
+    auto new_OPDM = std::make_shared<Matrix>(opdm_name.str(), nirrep_, act_dim, act_dim);
 
-        opdm_list.push_back(opdm_root_vec);
+    int offset = 0;
+    for (int h = 0; h < nirrep_; h++) {
+        if (!CalcInfo_->ci_orbs[h]) continue;
+
+        double *opdm_a = new_OPDM_a->pointer(h)[0];
+        double *opdm_b = new_OPDM_b->pointer(h)[0];
+        double *opdm = new_OPDM->pointer(h)[0];
+
+        for (int i = 0, target = 0; i < CalcInfo_->ci_orbs[h]; i++) {
+            int ni = CalcInfo_->act_reorder[i + offset];
+            for (int j = 0; j < CalcInfo_->ci_orbs[h]; j++) {
+                int nj = CalcInfo_->act_reorder[j + offset];
 
-        // Now for the other order.
-        if (Iroot != Jroot) {
-            auto alpha_transpose = new_OPDM_a->transpose();
-            opdm_name.str(std::string());
-            opdm_name << "MO-basis Alpha OPDM <" << Jroot << "| Etu |" << Iroot << ">";
-            alpha_transpose->set_name(opdm_name.str());
-
-            auto beta_transpose = new_OPDM_b->transpose();
-            opdm_name.str(std::string());
-            opdm_name << "MO-basis Beta OPDM <" << Jroot << "| Etu |" << Iroot << ">";
-            beta_transpose->set_name(opdm_name.str());
-
-            auto sum_transpose = new_OPDM->transpose();
-            opdm_name.str(std::string());
-            opdm_name << "MO-basis OPDM <" << Jroot << "| Etu |" << Iroot << ">";
-            sum_transpose->set_name(opdm_name.str());
-
-            opdm_root_vec = {alpha_transpose, beta_transpose, sum_transpose};
-            opdm_list.push_back(opdm_root_vec);
+                opdm_a[target] = onepdm_a[ni][nj];
+                opdm_b[target] = onepdm_b[ni][nj];
+                opdm[target++] = onepdm_a[ni][nj] + onepdm_b[ni][nj];
+            }
         }
+        offset += CalcInfo_->ci_orbs[h];
+    }
 
+    std::vector<SharedMatrix> opdm_root_vec = {new_OPDM_a, new_OPDM_b, new_OPDM};
 
-    } /* end loop over states_vec */
+    opdm_list.push_back(opdm_root_vec);
 
-    if (transp_tmp) free(transp_tmp[0]);
-    free(transp_tmp);
-    if (transp_tmp2) free(transp_tmp2[0]);
-    free(transp_tmp2);
+    // Now for the other order.
+    if (Iroot != Jroot) {
+        auto alpha_transpose = new_OPDM_a->transpose();
+        opdm_name.str(std::string());
+        opdm_name << "MO-basis Alpha OPDM <" << Jroot << "| Etu |" << Iroot << ">";
+        alpha_transpose->set_name(opdm_name.str());
 
-    scratch_a.reset();
-    scratch_b.reset();
-    timer_off("CIWave: opdm");
+        auto beta_transpose = new_OPDM_b->transpose();
+        opdm_name.str(std::string());
+        opdm_name << "MO-basis Beta OPDM <" << Jroot << "| Etu |" << Iroot << ">";
+        beta_transpose->set_name(opdm_name.str());
 
-    return opdm_list;
+        auto sum_transpose = new_OPDM->transpose();
+        opdm_name.str(std::string());
+        opdm_name << "MO-basis OPDM <" << Jroot << "| Etu |" << Iroot << ">";
+        sum_transpose->set_name(opdm_name.str());
+
+        opdm_root_vec = {alpha_transpose, beta_transpose, sum_transpose};
+        opdm_list.push_back(opdm_root_vec);
+    }
 }
 
 void CIWavefunction::opdm_block(struct stringwr **alplist, struct stringwr **betlist, double **onepdm_a,
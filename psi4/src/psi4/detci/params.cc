@@ -330,8 +330,12 @@ void CIWavefunction::get_parameters(Options &options) {
             Parameters_->diag_method = METHOD_DAVIDSON_LIU_SEM;
         } else if (line1 == "SEM") {
             Parameters_->diag_method = METHOD_DAVIDSON_LIU_SEM;
+        } else if (line1 == "HCI") {
+            Parameters_->diag_method = METHOD_HCI;
         }
     }
+    Parameters_->hci_epsilon = options.get_double("HCI_EPSILON");
+    Parameters_->hci_maxiter = options.get_int("HCI_MAXITER");
 
     if ((Parameters_->diag_method == METHOD_RSP) & (Parameters_->icore != 1)) {
         outfile->Printf("RSP only works with icore = 1, switching.");
@@ -394,6 +398,8 @@ void CIWavefunction::get_parameters(Options &options) {
         Parameters_->maxnvect = 2;
     } else if (Parameters_->maxnvect == 0 && Parameters_->diag_method == METHOD_OLSEN) {
         Parameters_->maxnvect = 1;
+    } else if (Parameters_->maxnvect == 0 && Parameters_->diag_method == METHOD_HCI) {
+        Parameters_->maxnvect = 8 * Parameters_->num_roots;
     } else { /* the user tried to specify a value for maxnvect...check it */
         /*    if (Parameters_->maxnvect / (Parameters_->collapse_size *
               Parameters_->num_roots) < 2) {
@@ -463,6 +469,8 @@ void CIWavefunction::get_parameters(Options &options) {
     }
     if (Parameters_->nthreads < 1) Parameters_->nthreads = 1;
 
+    Parameters_->vecs_in_memory = options.get_bool("CI_VECS_IN_MEMORY");
+
     Parameters_->sf_restrict = options["SF_RESTRICT"].to_integer();
     Parameters_->print_sigma_overlap = options["SIGMA_OVERLAP"].to_integer();
 
@@ -710,6 +718,9 @@ void CIWavefunction::print_parameters() {
         case 3:
             outfile->Printf("%6s", "SEM");
             break;
+        case 4:
+            outfile->Printf("%6s", "HCI");
+            break;
         default:
             outfile->Printf("%6s", "???");
             break;
@@ -843,6 +854,13 @@ void CIWavefunction::print_parameters() {
     if (Parameters_->restart) {
         outfile->Printf("    RESTART        =   %6s\n", Parameters_->restart ? "YES" : "NO");
     }
+    if (Parameters_->vecs_in_memory) {
+        outfile->Printf("    VECS IN MEMORY =   %6s\n", "YES");
+    }
+    if (Parameters_->diag_method == METHOD_HCI) {
+        outfile->Printf("    HCI EPSILON    = %6.2e      HCI MAXITER   =   %6d\n", Parameters_->hci_epsilon,
+                        Parameters_->hci_maxiter);
+    }
     outfile->Printf("    MAX NUM VECS   =   %6d   ", Parameters_->maxnvect);
     if (Parameters_->ref_sym == -1) {
         outfile->Printf("   REF SYM       =   %6s\n", "AUTO");
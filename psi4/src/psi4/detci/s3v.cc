@@ -36,6 +36,9 @@
 
 #include <cstdio>
 #include <cstdlib>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 #include "psi4/libciomr/libciomr.h"
 #include "psi4/libqt/qt.h"
 #include "psi4/libmints/wavefunction.h"
@@ -173,7 +176,11 @@ void s3_block_v(struct stringwr *alplist, struct stringwr *betlist, double **C,
                 }
             }
 
+#ifdef _OPENMP
+            if (!omp_in_parallel()) timer_on("CIWave: s3_mt");
+#else
             timer_on("CIWave: s3_mt");
+#endif
             for (Ia = alplist, Ia_idx = 0; Ia_idx < nas; Ia_idx++, Ia++) {
                 /* loop over excitations E^a_{kl} from |A(I_a)> */
                 Jacnt = Ia->cnt[Ja_list];
@@ -207,7 +214,11 @@ void s3_block_v(struct stringwr *alplist, struct stringwr *betlist, double **C,
                 }
 
             } /* end loop over Ia */
+#ifdef _OPENMP
+            if (!omp_in_parallel()) timer_off("CIWave: s3_mt");
+#else
             timer_off("CIWave: s3_mt");
+#endif
 
         } /* end loop over j */
     }     /* end loop over i */
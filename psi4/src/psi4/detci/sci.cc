@@ -0,0 +1,920 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Psi4: an open-source quantum chemistry software package
+ *
+ * Copyright (c) 2007-2023 The Psi4 Developers.
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This file is part of Psi4.
+ *
+ * Psi4 is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * Psi4 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with Psi4; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * @END LICENSE
+ */
+
+/*! \file
+    \ingroup DETCI
+    \brief Heat-bath selected CI
+*/
+
+/*
+** Heat-bath selected CI (Holmes, Tubman, and Umrigar, JCTC 12, 3674 (2016))
+**
+** Rather than the string-driven CI space of the rest of DETCI, determinants
+** are kept as pairs of alpha/beta occupation bitstrings over the CI orbitals
+** and the space is grown from the reference: a determinant I is added when
+** |H_IJ c_J| > HCI_EPSILON for some J already selected.  Double excitations
+** are screened with lists of the integrals sorted by size, so only those
+** that can pass the threshold are ever looked at.  H is kept as a sparse
+** matrix whose connections are found by hashing the alpha and beta strings,
+** and its lowest roots are found by Davidson-Liu.  The integrals (and so
+** the MCSCF orbital optimization) and the density conventions are those of
+** the rest of DETCI.
+*/
+
+#include <algorithm>
+#include <bitset>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#include "psi4/libciomr/libciomr.h"
+#include "psi4/libqt/qt.h"
+#include "psi4/libmints/matrix.h"
+#include "psi4/libmints/vector.h"
+#include "psi4/libpsi4util/PsiOutStream.h"
+#include "psi4/libpsi4util/process.h"
+#include "psi4/detci/structs.h"
+#include "psi4/detci/ciwave.h"
+
+namespace psi {
+namespace detci {
+
+#define INDEX(i, j) ((i > j) ? (ioff[(i)] + (j)) : (ioff[(j)] + (i)))
+
+namespace {
+
+typedef std::pair<uint64_t, uint64_t> sci_det;
+
+struct sci_det_hash {
+    size_t operator()(const sci_det &d) const {
+        return std::hash<uint64_t>()(d.first * 0x9E3779B97F4A7C15ULL ^ (d.second + (d.second >> 29)));
+    }
+};
+
+typedef std::unordered_map<sci_det, size_t, sci_det_hash> sci_det_map;
+
+inline uint64_t bit(int p) { return (uint64_t)1 << p; }
+inline int bit_count(uint64_t s) { return (int)std::bitset<64>(s).count(); }
+
+/* the occupied orbitals of string s, in increasing order */
+inline int occ_list(uint64_t s, int n, int *occ) {
+    int cnt = 0;
+    for (int p = 0; p < n; p++)
+        if (s & bit(p)) occ[cnt++] = p;
+    return cnt;
+}
+
+/* sign of a+_a a_i acting on string s, with i occupied and a empty */
+inline double excite_sign(uint64_t s, int i, int a) {
+    int lo = std::min(i, a), hi = std::max(i, a);
+    uint64_t between = (bit(hi) - 1) & ~(bit(lo + 1) - 1);
+    return (bit_count(s & between) % 2) ? -1.0 : 1.0;
+}
+
+/* the single excitation i -> a taking string from to string to */
+inline void single_diff(uint64_t from, uint64_t to, int n, int &i, int &a) {
+    uint64_t d = from ^ to;
+    for (int p = 0; p < n; p++) {
+        if (!(d & bit(p))) continue;
+        if (from & bit(p))
+            i = p;
+        else
+            a = p;
+    }
+}
+
+/* the double excitation i,j -> a,b (i < j, a < b) taking string from to string to */
+inline void double_diff(uint64_t from, uint64_t to, int n, int &i, int &j, int &a, int &b) {
+    int holes[2], parts[2], nh = 0, np = 0;
+    uint64_t d = from ^ to;
+    for (int p = 0; p < n; p++) {
+        if (!(d & bit(p))) continue;
+        if (from & bit(p))
+            holes[nh++] = p;
+        else
+            parts[np++] = p;
+    }
+    i = holes[0];
+    j = holes[1];
+    a = parts[0];
+    b = parts[1];
+}
+
+/* Irrep of the determinant with strings sa and sb */
+inline int det_sym(uint64_t sa, uint64_t sb, const std::vector<int> &orbsym) {
+    int sym = 0;
+    for (size_t p = 0; p < orbsym.size(); p++) {
+        if (((sa ^ sb) >> p) & 1) sym ^= orbsym[p];
+    }
+    return sym;
+}
+
+/*
+** The CI-order integrals, with the one-electron part and the Coulomb and
+** exchange integrals of the diagonal unpacked
+*/
+struct sci_ints {
+    int n;
+    const double *tei;
+    std::vector<double> h, J, K;
+
+    sci_ints(int nci, const double *oei, const double *twoel) : n(nci), tei(twoel), h(nci * nci), J(nci * nci), K(nci * nci) {
+        for (int p = 0; p < n; p++) {
+            for (int q = 0; q < n; q++) {
+                h[p * n + q] = oei[INDEX(p, q)];
+                J[p * n + q] = eri(p, p, q, q);
+                K[p * n + q] = eri(p, q, q, p);
+            }
+        }
+    }
+
+    /* (pq|rs) */
+    double eri(int p, int q, int r, int s) const {
+        size_t pq = INDEX(p, q);
+        size_t rs = INDEX(r, s);
+        return tei[INDEX(pq, rs)];
+    }
+
+    double diag(uint64_t sa, uint64_t sb) const {
+        int oa[64], ob[64];
+        int na = occ_list(sa, n, oa), nb = occ_list(sb, n, ob);
+        double val = 0.0;
+        for (int x = 0; x < na; x++) {
+            int i = oa[x];
+            val += h[i * n + i];
+            for (int y = 0; y < x; y++) val += J[i * n + oa[y]] - K[i * n + oa[y]];
+            for (int y = 0; y < nb; y++) val += J[i * n + ob[y]];
+        }
+        for (int x = 0; x < nb; x++) {
+            int i = ob[x];
+            val += h[i * n + i];
+            for (int y = 0; y < x; y++) val += J[i * n + ob[y]] - K[i * n + ob[y]];
+        }
+        return val;
+    }
+
+    /* <I| H |J> for I = a+_a a_i J in the string same, other is the string of the other spin */
+    double single(uint64_t same, uint64_t other, int i, int a) const {
+        double val = h[a * n + i];
+        for (int k = 0; k < n; k++) {
+            if ((same & bit(k)) && k != i) val += eri(a, i, k, k) - eri(a, k, k, i);
+            if (other & bit(k)) val += eri(a, i, k, k);
+        }
+        return excite_sign(same, i, a) * val;
+    }
+
+    /* <I| H |J> for I = a+_b a_j a+_a a_i J, all in the same string */
+    double same_double(uint64_t s, int i, int j, int a, int b) const {
+        double sgn = excite_sign(s, i, a);
+        sgn *= excite_sign(s ^ bit(i) ^ bit(a), j, b);
+        return sgn * (eri(a, i, b, j) - eri(a, j, b, i));
+    }
+
+    /* <I| H |J> for I = a+_a a_i (alpha) a+_b a_j (beta) J */
+    double opp_double(uint64_t sa, uint64_t sb, int i, int j, int a, int b) const {
+        return excite_sign(sa, i, a) * excite_sign(sb, j, b) * eri(a, i, b, j);
+    }
+
+    /* <I| H |J> for two different determinants, zero beyond doubles */
+    double element(uint64_t Ia, uint64_t Ib, uint64_t Ja, uint64_t Jb) const {
+        int da = bit_count(Ia ^ Ja), db = bit_count(Ib ^ Jb);
+        int i = 0, j = 0, a = 0, b = 0;
+        if (da == 2 && db == 0) {
+            single_diff(Ja, Ia, n, i, a);
+            return single(Ja, Jb, i, a);
+        } else if (da == 0 && db == 2) {
+            single_diff(Jb, Ib, n, i, a);
+            return single(Jb, Ja, i, a);
+        } else if (da == 2 && db == 2) {
+            single_diff(Ja, Ia, n, i, a);
+            single_diff(Jb, Ib, n, j, b);
+            return opp_double(Ja, Jb, i, j, a, b);
+        } else if (da == 4 && db == 0) {
+            double_diff(Ja, Ia, n, i, j, a, b);
+            return same_double(Ja, i, j, a, b);
+        } else if (da == 0 && db == 4) {
+            double_diff(Jb, Ib, n, i, j, a, b);
+            return same_double(Jb, i, j, a, b);
+        }
+        return 0.0;
+    }
+};
+
+/*
+** Heat-bath lists: for each pair of occupied orbitals, the orbitals the
+** pair may be excited into, largest |H_IJ| first.  Same-spin lists are kept
+** for i < j (and a < b), opposite-spin ones for an alpha i and a beta j.
+*/
+struct sci_heat_bath {
+    struct entry {
+        float v;
+        uint8_t a, b;
+    };
+    std::vector<std::vector<entry> > same, opp;
+    double max_single; /* bound on |H_IJ| of any single excitation */
+    double max_double; /* largest |H_IJ| of any double excitation */
+
+    explicit sci_heat_bath(const sci_ints &ints) {
+        int n = ints.n;
+        same.resize(n * n);
+        opp.resize(n * n);
+        auto by_size = [](const entry &x, const entry &y) { return x.v > y.v; };
+#pragma omp parallel for schedule(dynamic)
+        for (int ij = 0; ij < n * n; ij++) {
+            int i = ij / n, j = ij % n;
+            for (int a = 0; a < n; a++) {
+                for (int b = 0; b < n; b++) {
+                    double v = std::fabs(ints.eri(a, i, b, j));
+                    if (v > 1.0E-12) opp[ij].push_back({(float)v, (uint8_t)a, (uint8_t)b});
+                    if (i < j && a < b) {
+                        v = std::fabs(ints.eri(a, i, b, j) - ints.eri(a, j, b, i));
+                        if (v > 1.0E-12) same[ij].push_back({(float)v, (uint8_t)a, (uint8_t)b});
+                    }
+                }
+            }
+            std::sort(opp[ij].begin(), opp[ij].end(), by_size);
+            std::sort(same[ij].begin(), same[ij].end(), by_size);
+        }
+
+        max_double = 0.0;
+        for (int ij = 0; ij < n * n; ij++) {
+            if (!opp[ij].empty()) max_double = std::max(max_double, (double)opp[ij][0].v);
+            if (!same[ij].empty()) max_double = std::max(max_double, (double)same[ij][0].v);
+        }
+        max_single = 0.0;
+        for (int a = 0; a < n; a++) {
+            for (int i = 0; i < n; i++) {
+                double v = std::fabs(ints.h[a * n + i]);
+                for (int k = 0; k < n; k++) v += 2.0 * std::fabs(ints.eri(a, i, k, k)) + std::fabs(ints.eri(a, k, k, i));
+                max_single = std::max(max_single, v);
+            }
+        }
+    }
+};
+
+/*
+** Heat-bath selection: returns the determinants outside the space that are
+** connected to some J in it by |H_IJ| weight_J > eps
+*/
+std::vector<sci_det> sci_select(const sci_ints &ints, const sci_heat_bath &hb, const std::vector<uint64_t> &alp,
+                                const std::vector<uint64_t> &bet, const sci_det_map &index,
+                                const std::vector<double> &weight, double eps, int nthreads) {
+    int n = ints.n;
+    size_t ndet = alp.size();
+    std::vector<std::vector<sci_det> > found(nthreads);
+
+#pragma omp parallel for schedule(dynamic, 16) num_threads(nthreads)
+    for (size_t x = 0; x < ndet; x++) {
+        double w = weight[x];
+        if (w * std::max(hb.max_single, hb.max_double) <= eps) continue;
+        int thread = 0;
+#ifdef _OPENMP
+        thread = omp_get_thread_num();
+#endif
+        std::vector<sci_det> &out = found[thread];
+        uint64_t sa = alp[x], sb = bet[x];
+        int oa[64], ob[64];
+        int na = occ_list(sa, n, oa), nb = occ_list(sb, n, ob);
+        auto keep = [&](uint64_t ta, uint64_t tb) {
+            if (index.find(sci_det(ta, tb)) == index.end()) out.emplace_back(ta, tb);
+        };
+
+        // Singles are few enough to be computed exactly
+        if (w * hb.max_single > eps) {
+            for (int spin = 0; spin < 2; spin++) {
+                uint64_t same = spin ? sb : sa, other = spin ? sa : sb;
+                int *occ = spin ? ob : oa;
+                int nocc = spin ? nb : na;
+                for (int y = 0; y < nocc; y++) {
+                    int i = occ[y];
+                    for (int a = 0; a < n; a++) {
+                        if (same & bit(a)) continue;
+                        if (std::fabs(ints.single(same, other, i, a)) * w <= eps) continue;
+                        uint64_t t = same ^ bit(i) ^ bit(a);
+                        if (spin)
+                            keep(sa, t);
+                        else
+                            keep(t, sb);
+                    }
+                }
+            }
+        }
+
+        // Doubles walk the sorted lists only as far as they can pass
+        for (int spin = 0; spin < 2; spin++) {
+            uint64_t same = spin ? sb : sa;
+            int *occ = spin ? ob : oa;
+            int nocc = spin ? nb : na;
+            for (int y = 0; y < nocc; y++) {
+                for (int z = y + 1; z < nocc; z++) {
+                    int i = occ[y], j = occ[z];
+                    for (const auto &e : hb.same[i * n + j]) {
+                        if (e.v * w <= eps) break;
+                        if ((same & bit(e.a)) || (same & bit(e.b))) continue;
+                        uint64_t t = same ^ bit(i) ^ bit(j) ^ bit(e.a) ^ bit(e.b);
+                        if (spin)
+                            keep(sa, t);
+                        else
+                            keep(t, sb);
+                    }
+                }
+            }
+        }
+        for (int y = 0; y < na; y++) {
+            for (int z = 0; z < nb; z++) {
+                int i = oa[y], j = ob[z];
+                for (const auto &e : hb.opp[i * n + j]) {
+                    if (e.v * w <= eps) break;
+                    if ((sa & bit(e.a)) || (sb & bit(e.b))) continue;
+                    keep(sa ^ bit(i) ^ bit(e.a), sb ^ bit(j) ^ bit(e.b));
+                }
+            }
+        }
+    }
+
+    std::vector<sci_det> ret;
+    for (auto &f : found) ret.insert(ret.end(), f.begin(), f.end());
+    return ret;
+}
+
+/*
+** Finds every pair of determinants I < J that differ by at most a double
+** excitation and stores H_IJ for it in CSR form.  The determinants are
+** hashed by their alpha and their beta strings: pairs that share one of
+** them are found within its group, and pairs that differ by a single in
+** both come from the groups of the singly-excited alpha strings.
+*/
+void sci_connect(const sci_ints &ints, sci_space &space, int nthreads) {
+    int n = ints.n;
+    const std::vector<uint64_t> &alp = space.alp, &bet = space.bet;
+    size_t ndet = alp.size();
+
+    std::unordered_map<uint64_t, size_t> alp_id, bet_id;
+    std::vector<std::vector<size_t> > alp_dets, bet_dets;
+    std::vector<size_t> alp_of(ndet);
+    for (size_t x = 0; x < ndet; x++) {
+        auto ia = alp_id.emplace(alp[x], alp_dets.size());
+        if (ia.second) alp_dets.emplace_back();
+        alp_dets[ia.first->second].push_back(x);
+        alp_of[x] = ia.first->second;
+        auto ib = bet_id.emplace(bet[x], bet_dets.size());
+        if (ib.second) bet_dets.emplace_back();
+        bet_dets[ib.first->second].push_back(x);
+    }
+
+    std::vector<std::vector<std::pair<size_t, double> > > rows(ndet);
+
+    // Same alpha string, beta differs by a single or a double
+#pragma omp parallel for schedule(dynamic) num_threads(nthreads)
+    for (size_t g = 0; g < alp_dets.size(); g++) {
+        const std::vector<size_t> &dets = alp_dets[g];
+        for (size_t u = 0; u < dets.size(); u++) {
+            size_t x = dets[u];
+            for (size_t v = u + 1; v < dets.size(); v++) {
+                size_t y = dets[v];
+                if (bit_count(bet[x] ^ bet[y]) > 4) continue;
+                rows[x].emplace_back(y, ints.element(alp[x], bet[x], alp[y], bet[y]));
+            }
+        }
+    }
+
+    // Same beta string, alpha differs by a single or a double
+#pragma omp parallel for schedule(dynamic) num_threads(nthreads)
+    for (size_t g = 0; g < bet_dets.size(); g++) {
+        const std::vector<size_t> &dets = bet_dets[g];
+        for (size_t u = 0; u < dets.size(); u++) {
+            size_t x = dets[u];
+            for (size_t v = u + 1; v < dets.size(); v++) {
+                size_t y = dets[v];
+                if (bit_count(alp[x] ^ alp[y]) > 4) continue;
+                rows[x].emplace_back(y, ints.element(alp[x], bet[x], alp[y], bet[y]));
+            }
+        }
+    }
+
+    // Alpha strings one excitation apart
+    std::vector<std::vector<size_t> > alp_singles(alp_dets.size());
+#pragma omp parallel for schedule(dynamic) num_threads(nthreads)
+    for (size_t g = 0; g < alp_dets.size(); g++) {
+        uint64_t s = alp[alp_dets[g][0]];
+        for (int i = 0; i < n; i++) {
+            if (!(s & bit(i))) continue;
+            for (int a = 0; a < n; a++) {
+                if (s & bit(a)) continue;
+                auto it = alp_id.find(s ^ bit(i) ^ bit(a));
+                if (it != alp_id.end()) alp_singles[g].push_back(it->second);
+            }
+        }
+    }
+
+    // Alpha and beta each differ by a single
+#pragma omp parallel for schedule(dynamic, 64) num_threads(nthreads)
+    for (size_t x = 0; x < ndet; x++) {
+        for (size_t g : alp_singles[alp_of[x]]) {
+            for (size_t y : alp_dets[g]) {
+                if (y <= x || bit_count(bet[x] ^ bet[y]) != 2) continue;
+                rows[x].emplace_back(y, ints.element(alp[x], bet[x], alp[y], bet[y]));
+            }
+        }
+    }
+
+    space.hdiag.resize(ndet);
+    space.conn_start.assign(ndet + 1, 0);
+    for (size_t x = 0; x < ndet; x++) {
+        space.hdiag[x] = ints.diag(alp[x], bet[x]);
+        space.conn_start[x + 1] = space.conn_start[x] + rows[x].size();
+    }
+    space.conn_det.resize(space.conn_start[ndet]);
+    space.conn_h.resize(space.conn_start[ndet]);
+    for (size_t x = 0; x < ndet; x++) {
+        size_t off = space.conn_start[x];
+        for (const auto &r : rows[x]) {
+            space.conn_det[off] = r.first;
+            space.conn_h[off++] = r.second;
+        }
+        std::vector<std::pair<size_t, double> >().swap(rows[x]);
+    }
+}
+
+/* s = H c over the sparse upper triangle, each thread into its own s */
+void sci_sigma(const sci_space &space, const double *c, double *s, std::vector<std::vector<double> > &tbuf) {
+    size_t ndet = space.alp.size();
+    int nthreads = tbuf.size() + 1;
+
+#pragma omp parallel num_threads(nthreads)
+    {
+        int thread = 0;
+#ifdef _OPENMP
+        thread = omp_get_thread_num();
+#endif
+        double *st = thread ? tbuf[thread - 1].data() : s;
+        std::fill(st, st + ndet, 0.0);
+#pragma omp barrier
+#pragma omp for schedule(dynamic, 256)
+        for (size_t x = 0; x < ndet; x++) {
+            double sx = space.hdiag[x] * c[x];
+            double cx = c[x];
+            for (size_t off = space.conn_start[x]; off < space.conn_start[x + 1]; off++) {
+                size_t y = space.conn_det[off];
+                double h = space.conn_h[off];
+                sx += h * c[y];
+                st[y] += h * cx;
+            }
+            st[x] += sx;
+        }
+#pragma omp for schedule(static)
+        for (size_t x = 0; x < ndet; x++) {
+            for (const auto &t : tbuf) s[x] += t[x];
+        }
+    }
+}
+
+}  // namespace
+
+/*
+** sci_init(): Sets up the selected CI with the reference determinant: the
+**    DOCC (and, high-spin, the SOCC) orbitals of the RAS I and II spaces
+*/
+void CIWavefunction::sci_init() {
+    int nci = CalcInfo_->num_ci_orbs;
+    if (nci > 64) {
+        throw PSIEXCEPTION("CIWavefunction: DIAG_METHOD HCI can handle at most 64 active orbitals.");
+    }
+    if (Parameters_->opentype == PARM_OPENTYPE_SINGLET) {
+        throw PSIEXCEPTION("CIWavefunction: DIAG_METHOD HCI is not available for open-shell singlets.");
+    }
+
+    uint64_t alp = 0, bet = 0;
+    for (int h = 0; h < CalcInfo_->nirreps; h++) {
+        int ndocc = CalcInfo_->docc[h] - CalcInfo_->dropped_docc[h];
+        int nsocc = (Parameters_->opentype == PARM_OPENTYPE_HIGHSPIN) ? CalcInfo_->socc[h] : 0;
+        for (int m = 0; m < ndocc + nsocc; m++) {
+            int ras = 0, idx = m;
+            while (idx >= CalcInfo_->ras_opi[ras][h]) idx -= CalcInfo_->ras_opi[ras++][h];
+            int orb = CalcInfo_->ras_orbs[ras][h][idx];
+            alp |= bit(orb);
+            if (m < ndocc) bet |= bit(orb);
+        }
+    }
+    if (bit_count(alp) != CalcInfo_->num_alp_expl || bit_count(bet) != CalcInfo_->num_bet_expl) {
+        throw PSIEXCEPTION("CIWavefunction: could not place the electrons of the HCI reference determinant.");
+    }
+
+    sci_ = std::make_shared<sci_space>();
+    sci_->orbsym.resize(nci);
+    for (int p = 0; p < nci; p++) sci_->orbsym[p] = CalcInfo_->orbsym[p + CalcInfo_->num_drc_orbs];
+
+    // The space grows from the reference determinant, so all roots share its irrep
+    sci_->sym = det_sym(alp, bet, sci_->orbsym);
+    if (Parameters_->ref_sym != -1 && Parameters_->ref_sym != sci_->sym) {
+        throw PSIEXCEPTION("CIWavefunction: DIAG_METHOD HCI can only find states of the irrep of the reference "
+                           "determinant (" + std::to_string(sci_->sym) + "), not REFERENCE_SYM " +
+                           std::to_string(Parameters_->ref_sym) + ".");
+    }
+    CalcInfo_->ref_sym = sci_->sym;
+
+    sci_->alp.push_back(alp);
+    sci_->bet.push_back(bet);
+}
+
+/*
+** sci_diag(): Grows the heat-bath selected CI space until no new determinant
+**    passes HCI_EPSILON (or for HCI_MAXITER iterations) and finds the lowest
+**    roots of H in it.  A space (and roots) left from an earlier call, e.g.
+**    the last MCSCF iteration, is the starting point.
+*/
+void CIWavefunction::sci_diag(double *evals, double conv_e, double conv_rms) {
+    timer_on("CIWave: HCI");
+    int nci = CalcInfo_->num_ci_orbs;
+    int nroots = Parameters_->num_roots;
+    int nthreads = std::max(1, Parameters_->nthreads);
+    int maxsub = std::max(Parameters_->maxnvect, 2 * nroots);
+    double eps = Parameters_->hci_epsilon;
+    double enuc_edrc = CalcInfo_->enuc + CalcInfo_->edrc;
+
+    sci_ints ints(nci, CalcInfo_->onel_ints->pointer(), CalcInfo_->twoel_ints->pointer());
+    sci_heat_bath hb(ints);
+
+    std::vector<uint64_t> &alp = sci_->alp;
+    std::vector<uint64_t> &bet = sci_->bet;
+    sci_det_map index;
+    for (size_t x = 0; x < alp.size(); x++) index[sci_det(alp[x], bet[x])] = x;
+    bool flip = (CalcInfo_->num_alp_expl == CalcInfo_->num_bet_expl);
+
+    if (print_) {
+        outfile->Printf("    Heat-bath selected CI, HCI EPSILON = %8.2e\n\n", eps);
+        outfile->Printf("     Iter   Root       Total Energy       Delta E      C RMS     Determinants\n\n");
+    }
+
+    std::vector<double> last(nroots, 0.0), previous(nroots, 0.0), rnorm(nroots, 0.0);
+    bool fresh = false, space_converged = false, converged = false;
+    int total_iters = 0;
+
+    for (int iter = 1; iter <= Parameters_->hci_maxiter; iter++) {
+        // Select from the current roots, or from the reference alone
+        size_t nold = alp.size();
+        std::vector<double> weight(nold, 1.0);
+        if (sci_->evecs) {
+            double **vp = sci_->evecs->pointer();
+            size_t nvec = sci_->evecs->coldim();
+            for (size_t x = 0; x < nold; x++) {
+                weight[x] = 0.0;
+                if (x < nvec)
+                    for (int k = 0; k < nroots; k++) weight[x] = std::max(weight[x], std::fabs(vp[k][x]));
+            }
+        }
+        for (const auto &d : sci_select(ints, hb, alp, bet, index, weight, eps, nthreads)) {
+            // Integrals that vanish by symmetry only up to round-off must not leak other irreps in
+            if (det_sym(d.first, d.second, sci_->orbsym) != sci_->sym) continue;
+            for (int f = 0; f < (flip ? 2 : 1); f++) {
+                sci_det t = f ? sci_det(d.second, d.first) : d;
+                if (index.emplace(t, alp.size()).second) {
+                    alp.push_back(t.first);
+                    bet.push_back(t.second);
+                }
+            }
+        }
+        size_t ndet = alp.size();
+        if (fresh && ndet == nold) {
+            space_converged = true;
+            break;
+        }
+        if (ndet < (size_t)nroots) {
+            throw PSIEXCEPTION("CIWavefunction: the HCI space holds fewer determinants than NUM_ROOTS.");
+        }
+
+        timer_on("CIWave: HCI H build");
+        sci_connect(ints, *sci_, nthreads);
+        timer_off("CIWave: HCI H build");
+
+        // Davidson-Liu, starting from the roots of the smaller space
+        std::vector<std::vector<double> > tbuf(nthreads - 1, std::vector<double>(ndet));
+        std::vector<std::vector<double> > B, S;
+        auto add_vector = [&](std::vector<double> &v) {
+            for (int pass = 0; pass < 2; pass++) {
+                for (const auto &b : B) C_DAXPY(ndet, -C_DDOT(ndet, b.data(), 1, v.data(), 1), b.data(), 1, v.data(), 1);
+            }
+            double norm = std::sqrt(C_DDOT(ndet, v.data(), 1, v.data(), 1));
+            if (norm < 1.0E-8) return false;
+            C_DSCAL(ndet, 1.0 / norm, v.data(), 1);
+            B.push_back(v);
+            S.emplace_back(ndet);
+            sci_sigma(*sci_, B.back().data(), S.back().data(), tbuf);
+            return true;
+        };
+
+        std::vector<size_t> by_diag(ndet);
+        for (size_t x = 0; x < ndet; x++) by_diag[x] = x;
+        std::sort(by_diag.begin(), by_diag.end(),
+                  [&](size_t x, size_t y) { return sci_->hdiag[x] < sci_->hdiag[y]; });
+        for (int k = 0; k < nroots; k++) {
+            std::vector<double> v(ndet, 0.0);
+            if (sci_->evecs) {
+                double **vp = sci_->evecs->pointer();
+                for (size_t x = 0; x < std::min(ndet, (size_t)sci_->evecs->coldim()); x++) v[x] = vp[k][x];
+            }
+            if (!add_vector(v)) {
+                for (size_t x : by_diag) {
+                    std::vector<double> u(ndet, 0.0);
+                    u[x] = 1.0;
+                    if (add_vector(u)) break;
+                }
+            }
+        }
+
+        auto X = std::make_shared<Matrix>("HCI Vectors", nroots, ndet);
+        double **Xp = X->pointer();
+        std::vector<double> lambda(nroots);
+        converged = false;
+        for (int diter = 1; diter <= Parameters_->maxiter; diter++) {
+            int L = B.size();
+            auto G = std::make_shared<Matrix>("HCI G", L, L);
+            for (int i = 0; i < L; i++) {
+                for (int j = 0; j <= i; j++) {
+                    double g = 0.5 * (C_DDOT(ndet, B[i].data(), 1, S[j].data(), 1) +
+                                      C_DDOT(ndet, B[j].data(), 1, S[i].data(), 1));
+                    G->set(i, j, g);
+                    G->set(j, i, g);
+                }
+            }
+            auto alpha = std::make_shared<Matrix>("HCI alpha", L, L);
+            auto theta = std::make_shared<Vector>("HCI theta", L);
+            G->diagonalize(alpha, theta, ascending);
+
+            std::vector<std::vector<double> > R(nroots, std::vector<double>(ndet, 0.0));
+            converged = true;
+            for (int k = 0; k < nroots; k++) {
+                lambda[k] = theta->get(k);
+                std::fill(Xp[k], Xp[k] + ndet, 0.0);
+                for (int i = 0; i < L; i++) {
+                    double a = alpha->get(i, k);
+                    C_DAXPY(ndet, a, B[i].data(), 1, Xp[k], 1);
+                    C_DAXPY(ndet, a, S[i].data(), 1, R[k].data(), 1);
+                }
+                C_DAXPY(ndet, -lambda[k], Xp[k], 1, R[k].data(), 1);
+                rnorm[k] = std::sqrt(C_DDOT(ndet, R[k].data(), 1, R[k].data(), 1));
+                if (rnorm[k] > conv_rms || std::fabs(lambda[k] - last[k]) > conv_e) converged = false;
+            }
+            total_iters++;
+            if (converged || diter == Parameters_->maxiter) break;
+            for (int k = 0; k < nroots; k++) last[k] = lambda[k];
+
+            // Collapse onto the current roots once the subspace is full
+            if (L + nroots > maxsub) {
+                std::vector<std::vector<double> > SX(nroots, std::vector<double>(ndet, 0.0));
+                for (int k = 0; k < nroots; k++)
+                    for (int i = 0; i < L; i++) C_DAXPY(ndet, alpha->get(i, k), S[i].data(), 1, SX[k].data(), 1);
+                B.clear();
+                S.clear();
+                for (int k = 0; k < nroots; k++) {
+                    B.emplace_back(Xp[k], Xp[k] + ndet);
+                    S.push_back(SX[k]);
+                }
+            }
+
+            // Davidson correction vectors
+            int nadded = 0;
+            for (int k = 0; k < nroots; k++) {
+                if (rnorm[k] <= conv_rms) continue;
+                for (size_t x = 0; x < ndet; x++) {
+                    double denom = lambda[k] - sci_->hdiag[x];
+                    if (std::fabs(denom) < 1.0E-4) denom = (denom < 0.0) ? -1.0E-4 : 1.0E-4;
+                    R[k][x] /= denom;
+                }
+                if (add_vector(R[k])) nadded++;
+            }
+            if (!nadded) {
+                converged = std::all_of(rnorm.begin(), rnorm.end(), [&](double r) { return r <= conv_rms; });
+                break;
+            }
+        }
+        sci_->evecs = X;
+        fresh = true;
+
+        for (int k = 0; k < nroots; k++) {
+            if (print_) {
+                outfile->Printf("   @HCI %2d:   %2d  %18.12lf   %10.4E   %10.4E   %10zu\n", iter, k,
+                                lambda[k] + enuc_edrc, lambda[k] - previous[k], rnorm[k], ndet);
+            }
+            previous[k] = last[k] = evals[k] = lambda[k];
+        }
+        if (print_ && nroots > 1) outfile->Printf("\n");
+    }
+
+    if (print_) {
+        if (space_converged)
+            outfile->Printf("\n    HCI space converged with %zu determinants\n\n", alp.size());
+        else
+            outfile->Printf("\n    Warning! HCI space still growing after %d iterations, %zu determinants\n\n",
+                            Parameters_->hci_maxiter, alp.size());
+    }
+
+    double avg_vec_norm = 0.0;
+    for (int i = 0; i < Parameters_->average_num; i++) {
+        avg_vec_norm += rnorm[Parameters_->average_states[i]] * Parameters_->average_weights[i];
+    }
+    set_scalar_variable("DETCI AVG DVEC NORM", avg_vec_norm);
+    Parameters_->diag_h_converged = converged;
+    Parameters_->diag_iters_taken = total_iters;
+    timer_off("CIWave: HCI");
+}
+
+namespace {
+
+/*
+** Adds coef times the densities <I| Epq |J> to opdm_a/opdm_b and
+** <I| Epq Ers - delta_qr Eps |J> to the CI-order TPDMs in the layout of
+** tpdm_block: aa/bb packed over pq >= rs, ab full with the beta pair first.
+** Either set may be null.
+*/
+void sci_pair_density(int n, uint64_t Ia, uint64_t Ib, uint64_t Ja, uint64_t Jb, double coef, double **opdm_a,
+                      double **opdm_b, double *aa, double *ab, double *bb) {
+    int n2 = n * n;
+    auto add = [](double &target, double val) {
+#pragma omp atomic
+        target += val;
+    };
+    auto add_ss = [&](double *t, int p, int q, int r, int s, double val) {
+        size_t pq = p * n + q, rs = r * n + s;
+        if (pq >= rs) add(t[INDEX(pq, rs)], val);
+    };
+    auto add_ab = [&](int p, int q, int r, int s, double val) { add(ab[(size_t)(p * n + q) * n2 + r * n + s], val); };
+
+    int oa[64], ob[64];
+    int na = occ_list(Ja, n, oa), nb = occ_list(Jb, n, ob);
+    int da = bit_count(Ia ^ Ja), db = bit_count(Ib ^ Jb);
+
+    if (da == 0 && db == 0) {
+        if (opdm_a) {
+            for (int x = 0; x < na; x++) add(opdm_a[oa[x]][oa[x]], coef);
+            for (int x = 0; x < nb; x++) add(opdm_b[ob[x]][ob[x]], coef);
+        }
+        if (!aa) return;
+        for (int spin = 0; spin < 2; spin++) {
+            double *t = spin ? bb : aa;
+            int *occ = spin ? ob : oa;
+            int nocc = spin ? nb : na;
+            for (int x = 0; x < nocc; x++) {
+                for (int y = 0; y < nocc; y++) {
+                    if (x == y) continue;
+                    add_ss(t, occ[x], occ[x], occ[y], occ[y], coef);
+                    add_ss(t, occ[x], occ[y], occ[y], occ[x], -coef);
+                }
+            }
+        }
+        for (int x = 0; x < nb; x++)
+            for (int y = 0; y < na; y++) add_ab(ob[x], ob[x], oa[y], oa[y], coef);
+    } else if ((da == 2 && db == 0) || (da == 0 && db == 2)) {
+        int spin = (db == 2);
+        uint64_t from = spin ? Jb : Ja, to = spin ? Ib : Ia;
+        int i = 0, a = 0;
+        single_diff(from, to, n, i, a);
+        double val = coef * excite_sign(from, i, a);
+        if (opdm_a) add(spin ? opdm_b[a][i] : opdm_a[a][i], val);
+        if (!aa) return;
+        double *t = spin ? bb : aa;
+        int *same = spin ? ob : oa, *other = spin ? oa : ob;
+        int nsame = spin ? nb : na, nother = spin ? na : nb;
+        for (int x = 0; x < nsame; x++) {
+            int k = same[x];
+            if (k == i) continue;
+            add_ss(t, a, i, k, k, val);
+            add_ss(t, k, k, a, i, val);
+            add_ss(t, a, k, k, i, -val);
+            add_ss(t, k, i, a, k, -val);
+        }
+        for (int x = 0; x < nother; x++) {
+            int k = other[x];
+            if (spin)
+                add_ab(a, i, k, k, val);
+            else
+                add_ab(k, k, a, i, val);
+        }
+    } else if (!aa) {
+        return;
+    } else if (da == 2 && db == 2) {
+        int i = 0, a = 0, j = 0, b = 0;
+        single_diff(Ja, Ia, n, i, a);
+        single_diff(Jb, Ib, n, j, b);
+        add_ab(b, j, a, i, coef * excite_sign(Ja, i, a) * excite_sign(Jb, j, b));
+    } else if ((da == 4 && db == 0) || (da == 0 && db == 4)) {
+        uint64_t from = (da == 4) ? Ja : Jb, to = (da == 4) ? Ia : Ib;
+        double *t = (da == 4) ? aa : bb;
+        int i = 0, j = 0, a = 0, b = 0;
+        double_diff(from, to, n, i, j, a, b);
+        double val = coef * excite_sign(from, i, a) * excite_sign(from ^ bit(i) ^ bit(a), j, b);
+        add_ss(t, a, i, b, j, val);
+        add_ss(t, b, j, a, i, val);
+        add_ss(t, a, j, b, i, -val);
+        add_ss(t, b, i, a, j, -val);
+    }
+}
+
+/* runs f(I, J) over every ordered pair of connected determinants, I == J included */
+void sci_pairs(const sci_space &space, int nthreads, const std::function<void(size_t, size_t)> &f) {
+    size_t ndet = space.alp.size();
+#pragma omp parallel for schedule(dynamic, 64) num_threads(nthreads)
+    for (size_t x = 0; x < ndet; x++) {
+        f(x, x);
+        for (size_t off = space.conn_start[x]; off < space.conn_start[x + 1]; off++) {
+            size_t y = space.conn_det[off];
+            f(x, y);
+            f(y, x);
+        }
+    }
+}
+
+}  // namespace
+
+/*
+** sci_opdm(): The OPDMs <Iroot| Etu |Jroot> of the selected-CI roots, as
+**    opdm() returns them for the string-driven CI
+*/
+std::vector<std::vector<SharedMatrix> > CIWavefunction::sci_opdm(std::vector<std::tuple<int, int> > states_vec) {
+    timer_on("CIWave: opdm");
+    int nci = CalcInfo_->num_ci_orbs;
+    double **vp = sci_->evecs->pointer();
+    auto scratch_a = std::make_shared<Matrix>("OPDM A Scratch", nci, nci);
+    auto scratch_b = std::make_shared<Matrix>("OPDM B Scratch", nci, nci);
+    double **scratch_ap = scratch_a->pointer();
+    double **scratch_bp = scratch_b->pointer();
+
+    std::vector<std::vector<SharedMatrix> > opdm_list;
+    for (const auto &states : states_vec) {
+        int Iroot = std::get<0>(states);
+        int Jroot = std::get<1>(states);
+        scratch_a->zero();
+        scratch_b->zero();
+        sci_pairs(*sci_, Parameters_->nthreads, [&](size_t x, size_t y) {
+            sci_pair_density(nci, sci_->alp[x], sci_->bet[x], sci_->alp[y], sci_->bet[y], vp[Iroot][x] * vp[Jroot][y],
+                             scratch_ap, scratch_bp, nullptr, nullptr, nullptr);
+        });
+        opdm_from_ci_order(opdm_list, scratch_ap, scratch_bp, Iroot, Jroot);
+    }
+    timer_off("CIWave: opdm");
+
+    return opdm_list;
+}
+
+/*
+** sci_tpdm(): The weighted sum of the TPDMs <Iroot| etuvw |Jroot> of the
+**    selected-CI roots, as tpdm() returns it for the string-driven CI
+*/
+std::vector<SharedMatrix> CIWavefunction::sci_tpdm(std::vector<std::tuple<int, int, double> > states_vec) {
+    timer_on("CIWave: TPDM");
+    int nact = CalcInfo_->num_ci_orbs;
+    int nact2 = nact * nact;
+    size_t ntri2 = ((size_t)nact2 * (nact2 + 1)) / 2;
+    double **vp = sci_->evecs->pointer();
+
+    std::vector<double> tpdm_aa(ntri2, 0.0), tpdm_ab((size_t)nact2 * nact2, 0.0), tpdm_bb(ntri2, 0.0);
+    for (const auto &states : states_vec) {
+        int Iroot = std::get<0>(states);
+        int Jroot = std::get<1>(states);
+        double weight = std::get<2>(states);
+        sci_pairs(*sci_, Parameters_->nthreads, [&](size_t x, size_t y) {
+            sci_pair_density(nact, sci_->alp[x], sci_->bet[x], sci_->alp[y], sci_->bet[y],
+                             weight * vp[Iroot][x] * vp[Jroot][y], nullptr, nullptr, tpdm_aa.data(), tpdm_ab.data(),
+                             tpdm_bb.data());
+        });
+    }
+
+    std::vector<SharedMatrix> ret_list = tpdm_from_ci_order(tpdm_aa.data(), tpdm_ab.data(), tpdm_bb.data());
+    timer_off("CIWave: TPDM");
+
+    return ret_list;
+}
+
+}  // namespace detci
+}  // namespace psi
@@ -525,33 +525,37 @@ void CIWavefunction::sem_iter(CIvect &Hd, struct stringwr **alplist, struct stri
         Cvec.buf_lock(buffer1);
         Sigma.buf_lock(buffer2);
 
+        /* the new vectors (one per root) get their sigma vectors together */
+        int multi_sigma = (L - Llast > 1 && !Parameters_->z_scale_H && print_ <= 3);
+        if (multi_sigma) sigma_multi(Cvec, Sigma, oei, tei, Llast, L - Llast);
+
         for (i = Llast; i < L; i++) {
-            Cvec.read(i, 0);
-            if (print_ > 3) {
-                outfile->Printf("b[%d] =\n", i);
-                Cvec.print();
-            }
+            if (!multi_sigma) {
+                Cvec.read(i, 0);
+                if (print_ > 3) {
+                    outfile->Printf("b[%d] =\n", i);
+                    Cvec.print();
+                }
 
-            sigma(Cvec, Sigma, oei, tei, i);
+                sigma(Cvec, Sigma, oei, tei, i);
 
-            if (Parameters_->z_scale_H) {
-                Cvec.buf_unlock();
-                Sigma.buf_unlock();
-                Sigma.scale_sigma(Hd, Cvec, alplist, betlist, i, buffer1, buffer2);
-                Cvec.buf_lock(buffer1);
-                Sigma.buf_lock(buffer2);
-                Sigma.read(i, 0);
-            }
+                if (Parameters_->z_scale_H) {
+                    Cvec.buf_unlock();
+                    Sigma.buf_unlock();
+                    Sigma.scale_sigma(Hd, Cvec, alplist, betlist, i, buffer1, buffer2);
+                    Cvec.buf_lock(buffer1);
+                    Sigma.buf_lock(buffer2);
+                    Sigma.read(i, 0);
+                }
 
-            if (print_ > 3) { /* and this as well */
-                outfile->Printf("H * b[%d] = \n", i);
-                Sigma.print();
+                if (print_ > 3) { /* and this as well */
+                    outfile->Printf("H * b[%d] = \n", i);
+                    Sigma.print();
+                }
             }
 
-            for (j = 0; j < L; j++) {
-                Cvec.read(j, 0);
-                G[j][i] = G[i][j] = Cvec * Sigma;
-            }
+            Sigma.dot_vectors(Cvec, i, 0, L, G[i]);
+            for (j = 0; j < L; j++) G[j][i] = G[i][j];
         }
         Sigma.write_num_vecs(L);
         Llast = L;
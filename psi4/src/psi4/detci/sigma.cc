@@ -45,8 +45,19 @@
 #include <cstdlib>
 #include <cmath>
 #include <cstring>
+#include <algorithm>
+#include <utility>
+#include <vector>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#ifdef USING_MPI
+#include <mpi.h>
+#endif
 #include "psi4/libciomr/libciomr.h"
 #include "psi4/libqt/qt.h"
+#include "psi4/libpsi4util/process.h"
+#include "psi4/libfock/jk.h"
 #include "psi4/libmints/vector.h"
 #include "psi4/detci/structs.h"
 #include "psi4/detci/civect.h"
@@ -100,6 +111,15 @@ extern void s3_block_vdiag_rotf(int *Cnt[2], int **Ij[2], int **Ridx[2], signed
                                 int Ib_sym, int Jb_sym, double **Cprime, double *F, double *V, double *Sgn, int *L,
                                 int *R, int norbs, int *orbsym);
 
+/* the CIWave timers are serial; the threaded sigma build skips them */
+static bool in_threads() {
+#ifdef _OPENMP
+    return omp_in_parallel();
+#else
+    return false;
+#endif
+}
+
 /*
 ** sigma_init()
 **
@@ -222,6 +242,35 @@ void CIWavefunction::sigma_init(CIvect &C, CIvect &S) {
         }
     }
 
+    /* the icore=1 sigma build runs its subblocks in threads, each of which
+       needs its own copy of the scratch arrays above */
+    SigmaData_->nthreads = 1;
+    SigmaData_->thread_data = nullptr;
+    SigmaData_->mpi_rank = DistributedJK::mpi_rank();
+    SigmaData_->mpi_nranks = DistributedJK::mpi_size();
+    if (C.icore_ == 1 && Parameters_->nthreads > 1 && !Parameters_->repl_otf && print_ <= 3) {
+        SigmaData_->nthreads = Parameters_->nthreads;
+        SigmaData_->thread_data = new sigma_data[Parameters_->nthreads - 1];
+        for (i = 0; i < Parameters_->nthreads - 1; i++) {
+            struct sigma_data *SD = SigmaData_->thread_data + i;
+            *SD = *SigmaData_;
+            SD->nthreads = 1;
+            SD->thread_data = nullptr;
+            SD->transp_tmp = nullptr;
+            SD->F = init_array(SigmaData_->max_dim);
+            SD->Sgn = init_array(SigmaData_->max_dim);
+            SD->V = init_array(SigmaData_->max_dim);
+            SD->L = init_int_array(SigmaData_->max_dim);
+            SD->R = init_int_array(SigmaData_->max_dim);
+            SD->cprime = (double **)malloc(maxrows * sizeof(double *));
+            SD->cprime[0] = init_array(bufsz);
+            if (Parameters_->bendazzoli) {
+                SD->sprime = (double **)malloc(maxrows * sizeof(double *));
+                SD->sprime[0] = init_array(bufsz);
+            }
+        }
+    }
+
     CalcInfo_->sigma_initialized = 1;
 }
 
@@ -243,6 +292,23 @@ void CIWavefunction::sigma_free() {
             free(SigmaData_->Jsgn[i]);
         }
     }
+    for (int t = 0; t < SigmaData_->nthreads - 1; t++) {
+        struct sigma_data *SD = SigmaData_->thread_data + t;
+        free(SD->F);
+        free(SD->Sgn);
+        free(SD->V);
+        free(SD->L);
+        free(SD->R);
+        free(SD->cprime[0]);
+        free(SD->cprime);
+        if (SD->sprime != nullptr) {
+            free(SD->sprime[0]);
+            free(SD->sprime);
+        }
+    }
+    delete[] SigmaData_->thread_data;
+    SigmaData_->thread_data = nullptr;
+    SigmaData_->nthreads = 1;
     CalcInfo_->sigma_initialized = false;
     // DGAS: Not sure how to free these yet
     //      SigmaData_->Toccs = (unsigned char **) malloc (sizeof(unsigned char *) * nsingles);
@@ -277,6 +343,94 @@ void CIWavefunction::sigma(CIvect &C, CIvect &S, double *oei, double *tei, int i
             break;
     }
 }
+
+/*
+** sigma_multi(): Sigma vectors for C vectors first...first+nvec-1, written
+**    to the same vector numbers of S.  With icore=1 several are built at
+**    once by sigma_b_vectors(), which needs a C and sigma buffer for each;
+**    at most a quarter of the memory goes to these.  Otherwise the vectors
+**    are done one at a time.  C and S must have their buffers locked.
+*/
+void CIWavefunction::sigma_multi(CIvect &C, CIvect &S, double *oei, double *tei, int first, int nvec) {
+    if (!CalcInfo_->sigma_initialized) sigma_init(C, S);
+
+    size_t vec_bytes = 2 * C.buffer_size_ * sizeof(double);
+    size_t maxbatch = std::max((size_t)1, Process::environment.get_memory() / 4 / vec_bytes);
+    int batch = (int)std::min((size_t)nvec, maxbatch);
+
+    if (C.icore_ != 1 || batch < 2) {
+        for (int i = first; i < first + nvec; i++) {
+            C.read(i, 0);
+            sigma(C, S, oei, tei, i);
+        }
+        return;
+    }
+
+    /* the row pointers buf_lock() sets up for each buffer */
+    auto block_rows = [](CIvect &V, std::vector<double *> &rows, std::vector<double **> &blocks) {
+        size_t nrows = 0;
+        for (int blk = 0; blk < V.num_blocks_; blk++) nrows += V.Ia_size_[blk];
+        rows.resize(nrows);
+        blocks.resize(V.num_blocks_);
+        for (int blk = 0, r = 0; blk < V.num_blocks_; r += V.Ia_size_[blk], blk++) {
+            blocks[blk] = rows.data() + r;
+            for (int i = 0; i < V.Ia_size_[blk]; i++) rows[r + i] = V.blocks_[blk][i];
+        }
+    };
+
+    double *cbuf = C.buffer_, *sbuf = S.buffer_;
+    std::vector<double *> cbufs(batch), sbufs(batch);
+    std::vector<std::vector<double *>> crows(batch), srows(batch);
+    std::vector<std::vector<double **>> cblk(batch), sblk(batch);
+    cbufs[0] = cbuf;
+    sbufs[0] = sbuf;
+    for (int k = 1; k < batch; k++) {
+        cbufs[k] = C.buf_malloc();
+        sbufs[k] = S.buf_malloc();
+    }
+
+    for (int i0 = first; i0 < first + nvec; i0 += batch) {
+        int n = std::min(batch, first + nvec - i0);
+        std::vector<double ***> cblocks(n), sblocks(n);
+        for (int k = 0; k < n; k++) {
+            C.buf_unlock();
+            C.buf_lock(cbufs[k]);
+            C.read(i0 + k, 0);
+            block_rows(C, crows[k], cblk[k]);
+            cblocks[k] = cblk[k].data();
+            S.buf_unlock();
+            S.buf_lock(sbufs[k]);
+            S.zero();
+            block_rows(S, srows[k], sblk[k]);
+            sblocks[k] = sblk[k].data();
+        }
+
+        std::vector<double *> batch_sbufs(sbufs.begin(), sbufs.begin() + n);
+        sigma_b_vectors(alplist_, betlist_, C, S, oei, tei, Parameters_->fci, cblocks, sblocks, batch_sbufs);
+
+        for (int k = 0; k < n; k++) {
+            S.buf_unlock();
+            S.buf_lock(sbufs[k]);
+            if (S.Ms0_) {
+                if ((int)Parameters_->S % 2)
+                    S.symmetrize(-1.0, 0);
+                else
+                    S.symmetrize(1.0, 0);
+            }
+            S.write(i0 + k, 0);
+        }
+    }
+
+    C.buf_unlock();
+    C.buf_lock(cbuf);
+    S.buf_unlock();
+    S.buf_lock(sbuf);
+    for (int k = 1; k < batch; k++) {
+        free(cbufs[k]);
+        free(sbufs[k]);
+    }
+}
+
 void CIWavefunction::sigma(SharedCIVector C, SharedCIVector S, int cvec, int svec) {
     C->cur_vect_ = cvec;
     double *oei;
@@ -367,7 +521,7 @@ void CIWavefunction::sigma_a(struct stringwr **alplist, struct stringwr **betlis
                 if (SigmaData_->cprime != nullptr) set_row_ptrs(cnas, cnbs, SigmaData_->cprime);
                 sigma_block(alplist, betlist, C.blocks_[cblock], S.blocks_[sblock], oei, tei, fci, cblock, sblock, nas,
                             nbs, sac, sbc, cac, cbc, cnas, cnbs, C.num_alpcodes_, C.num_betcodes_, sbirr, cbirr,
-                            S.Ms0_);
+                            S.Ms0_, SigmaData_);
                 did_sblock = 1;
             }
 
@@ -383,7 +537,7 @@ void CIWavefunction::sigma_a(struct stringwr **alplist, struct stringwr **betlis
                 if (SigmaData_->cprime != nullptr) set_row_ptrs(cnbs, cnas, SigmaData_->cprime);
                 sigma_block(alplist, betlist, C.blocks_[cblock2], S.blocks_[sblock], oei, tei, fci, cblock2, sblock,
                             nas, nbs, sac, sbc, cbc, cac, cnbs, cnas, C.num_alpcodes_, C.num_betcodes_, sbirr, cairr,
-                            S.Ms0_);
+                            S.Ms0_, SigmaData_);
                 did_sblock = 1;
             }
 
@@ -429,64 +583,136 @@ void CIWavefunction::sigma_a(struct stringwr **alplist, struct stringwr **betlis
 */
 void CIWavefunction::sigma_b(struct stringwr **alplist, struct stringwr **betlist, CIvect &C, CIvect &S, double *oei,
                              double *tei, int fci, int ivec) {
+    S.zero();
+    C.read(C.cur_vect_, 0);
+
+    std::vector<double ***> cblocks(1, C.blocks_), sblocks(1, S.blocks_);
+    std::vector<double *> sbufs(1, S.buffer_);
+    sigma_b_vectors(alplist, betlist, C, S, oei, tei, fci, cblocks, sblocks, sbufs);
+
+    if (S.Ms0_) {
+        if ((int)Parameters_->S % 2)
+            S.symmetrize(-1.0, 0);
+        else
+            S.symmetrize(1.0, 0);
+    }
+
+    S.write(ivec, 0);
+}
+
+/*
+** sigma_b_vectors(): Adds H C to S for one or more in-core vectors, given
+**    as the block row pointers of each C and (zeroed) sigma vector.  Each
+**    pair of subblocks is applied to all of the vectors in turn, so that
+**    the string replacement lists and integrals it touches are reused
+**    while they are in cache.  Leaves the Ms=0 symmetrization to the caller.
+**    When several MPI ranks run the calculation, each builds its share of
+**    the sigma subblocks and the vectors (sbufs) are summed over them.
+*/
+void CIWavefunction::sigma_b_vectors(struct stringwr **alplist, struct stringwr **betlist, CIvect &C, CIvect &S,
+                                     double *oei, double *tei, int fci, std::vector<double ***> &cblocks,
+                                     std::vector<double ***> &sblocks, std::vector<double *> &sbufs) {
     int sblock, cblock; /* id of sigma and C blocks */
     int sac, sbc, nas, nbs;
-    int cac, cbc, cnas, cnbs;
-    int sbirr, cbirr;
-    int did_sblock = 0;
     int phase;
+    int nvec = cblocks.size();
 
     if (!Parameters_->Ms0)
         phase = 1;
     else
         phase = ((int)Parameters_->S % 2) ? -1 : 1;
 
-    S.zero();
-    C.read(C.cur_vect_, 0);
-
-    /* loop over unique sigma subblocks */
+    /* collect the unique sigma subblocks, largest amount of work first, so
+       the threads below pick them up in an order that balances their load */
+    std::vector<std::pair<double, int>> tasks;
     for (sblock = 0; sblock < S.num_blocks_; sblock++) {
         // if (Parameters_->cc && !cc_reqd_sblocks[sblock]) continue;
-        did_sblock = 0;
         sac = S.Ia_code_[sblock];
         sbc = S.Ib_code_[sblock];
         nas = S.Ia_size_[sblock];
         nbs = S.Ib_size_[sblock];
         if (nas == 0 || nbs == 0) continue;
         if (S.Ms0_ && sbc > sac) continue;
-        sbirr = sbc / BetaG_->subgr_per_irrep;
-        if (SigmaData_->sprime != nullptr) set_row_ptrs(nas, nbs, SigmaData_->sprime);
-
+        int ncontrib = 0;
         for (cblock = 0; cblock < C.num_blocks_; cblock++) {
             if (C.check_zero_block(cblock)) continue;
-            cac = C.Ia_code_[cblock];
-            cbc = C.Ib_code_[cblock];
-            cnas = C.Ia_size_[cblock];
-            cnbs = C.Ib_size_[cblock];
-            cbirr = cbc / BetaG_->subgr_per_irrep;
+            if (s1_contrib_[sblock][cblock] || s2_contrib_[sblock][cblock] || s3_contrib_[sblock][cblock]) ncontrib++;
+        }
+        tasks.emplace_back((double)nas * nbs * ncontrib, sblock);
+    }
+    std::stable_sort(tasks.begin(), tasks.end(),
+                     [](const std::pair<double, int> &a, const std::pair<double, int> &b) { return a.first > b.first; });
+
+    /* each sigma subblock is built by one thread of one rank from the shared
+       C vectors, with that thread's own scratch */
+    std::vector<int> did_sblock(S.num_blocks_, 0);
+    int nthreads = std::max(1, std::min(SigmaData_->nthreads, (int)tasks.size()));
+#pragma omp parallel for schedule(dynamic, 1) num_threads(nthreads)
+    for (size_t task = 0; task < tasks.size(); task++) {
+        if ((int)(task % SigmaData_->mpi_nranks) != SigmaData_->mpi_rank) continue;
+        int thread = 0;
+#ifdef _OPENMP
+        thread = omp_get_thread_num();
+#endif
+        struct sigma_data *SD = thread ? SigmaData_->thread_data + thread - 1 : SigmaData_;
+        int sblock = tasks[task].second;
+        int sac = S.Ia_code_[sblock];
+        int sbc = S.Ib_code_[sblock];
+        int nas = S.Ia_size_[sblock];
+        int nbs = S.Ib_size_[sblock];
+        int sbirr = sbc / BetaG_->subgr_per_irrep;
+        if (SD->sprime != nullptr) set_row_ptrs(nas, nbs, SD->sprime);
+
+        for (int cblock = 0; cblock < C.num_blocks_; cblock++) {
+            if (C.check_zero_block(cblock)) continue;
+            int cac = C.Ia_code_[cblock];
+            int cbc = C.Ib_code_[cblock];
+            int cnas = C.Ia_size_[cblock];
+            int cnbs = C.Ib_size_[cblock];
+            int cbirr = cbc / BetaG_->subgr_per_irrep;
             if (s1_contrib_[sblock][cblock] || s2_contrib_[sblock][cblock] || s3_contrib_[sblock][cblock]) {
-                if (SigmaData_->cprime != nullptr) set_row_ptrs(cnas, cnbs, SigmaData_->cprime);
-                sigma_block(alplist, betlist, C.blocks_[cblock], S.blocks_[sblock], oei, tei, fci, cblock, sblock, nas,
-                            nbs, sac, sbc, cac, cbc, cnas, cnbs, C.num_alpcodes_, C.num_betcodes_, sbirr, cbirr,
-                            S.Ms0_);
-                did_sblock = 1;
+                if (SD->cprime != nullptr) set_row_ptrs(cnas, cnbs, SD->cprime);
+                for (int k = 0; k < nvec; k++) {
+                    sigma_block(alplist, betlist, cblocks[k][cblock], sblocks[k][sblock], oei, tei, fci, cblock,
+                                sblock, nas, nbs, sac, sbc, cac, cbc, cnas, cnbs, C.num_alpcodes_, C.num_betcodes_,
+                                sbirr, cbirr, S.Ms0_, SD);
+                }
+                did_sblock[sblock] = 1;
             }
         } /* end loop over c blocks */
+    }     /* end loop over sigma blocks */
 
-        if (did_sblock) S.set_zero_block(sblock, 0);
-
-        if (S.Ms0_ && (sac == sbc)) transp_sigma(S.blocks_[sblock], nas, nbs, phase);
-        H0block_gather(S.blocks_[sblock], sac, sbc, 1, Parameters_->Ms0, phase);
-    } /* end loop over sigma blocks */
+#ifdef USING_MPI
+    if (SigmaData_->mpi_nranks > 1) {
+        timer_on("CIWave: sigma MPI");
+        const size_t chunk = (size_t)1 << 28;
+        for (double *sbuf : sbufs) {
+            for (size_t off = 0; off < S.buffer_size_; off += chunk) {
+                int n = (int)std::min(chunk, S.buffer_size_ - off);
+                MPI_Allreduce(MPI_IN_PLACE, sbuf + off, n, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+            }
+        }
+        MPI_Allreduce(MPI_IN_PLACE, did_sblock.data(), S.num_blocks_, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+        timer_off("CIWave: sigma MPI");
+    }
+#endif
 
-    if (S.Ms0_) {
-        if ((int)Parameters_->S % 2)
-            S.symmetrize(-1.0, 0);
-        else
-            S.symmetrize(1.0, 0);
+    for (const auto &task : tasks) {
+        if (did_sblock[task.second]) S.set_zero_block(task.second, 0);
     }
 
-    S.write(ivec, 0);
+    for (int k = 0; k < nvec; k++) {
+        for (const auto &task : tasks) {
+            sblock = task.second;
+            sac = S.Ia_code_[sblock];
+            sbc = S.Ib_code_[sblock];
+            nas = S.Ia_size_[sblock];
+            nbs = S.Ib_size_[sblock];
+
+            if (S.Ms0_ && (sac == sbc)) transp_sigma(sblocks[k][sblock], nas, nbs, phase);
+            H0block_gather(sblocks[k][sblock], sac, sbc, 1, Parameters_->Ms0, phase);
+        }
+    }
 }
 
 /*
@@ -554,7 +780,7 @@ void CIWavefunction::sigma_c(struct stringwr **alplist, struct stringwr **betlis
                         if (SigmaData_->cprime != nullptr) set_row_ptrs(cnas, cnbs, SigmaData_->cprime);
                         sigma_block(alplist, betlist, C.blocks_[cblock], S.blocks_[sblock], oei, tei, fci, cblock,
                                     sblock, nas, nbs, sac, sbc, cac, cbc, cnas, cnbs, C.num_alpcodes_, C.num_betcodes_,
-                                    sbirr, cbirr, S.Ms0_);
+                                    sbirr, cbirr, S.Ms0_, SigmaData_);
                         did_sblock = 1;
                     }
 
@@ -567,7 +793,7 @@ void CIWavefunction::sigma_c(struct stringwr **alplist, struct stringwr **betlis
                             if (SigmaData_->cprime != nullptr) set_row_ptrs(cnbs, cnas, SigmaData_->cprime);
                             sigma_block(alplist, betlist, SigmaData_->transp_tmp, S.blocks_[sblock], oei, tei, fci,
                                         cblock2, sblock, nas, nbs, sac, sbc, cbc, cac, cnbs, cnas, C.num_alpcodes_,
-                                        C.num_betcodes_, sbirr, cairr, S.Ms0_);
+                                        C.num_betcodes_, sbirr, cairr, S.Ms0_, SigmaData_);
                             did_sblock = 1;
                         }
                     }
@@ -612,23 +838,23 @@ void CIWavefunction::sigma_c(struct stringwr **alplist, struct stringwr **betlis
 void CIWavefunction::sigma_block(struct stringwr **alplist, struct stringwr **betlist, double **cmat, double **smat,
                                  double *oei, double *tei, int fci, int cblock, int sblock, int nas, int nbs, int sac,
                                  int sbc, int cac, int cbc, int cnas, int cnbs, int cnac, int cnbc, int sbirr,
-                                 int cbirr, int Ms0) {
+                                 int cbirr, int Ms0, struct sigma_data *SD) {
     /* SIGMA2 CONTRIBUTION */
     if (s2_contrib_[sblock][cblock]) {
-        timer_on("CIWave: s2");
+        if (!in_threads()) timer_on("CIWave: s2");
 
         if (fci) {
-            s2_block_vfci(alplist, betlist, cmat, smat, oei, tei, SigmaData_->F, cnac, nas, nbs, sac, cac, cnas);
+            s2_block_vfci(alplist, betlist, cmat, smat, oei, tei, SD->F, cnac, nas, nbs, sac, cac, cnas);
         } else {
             if (Parameters_->repl_otf) {
-                s2_block_vras_rotf(SigmaData_->Jcnt, SigmaData_->Jij, SigmaData_->Joij, SigmaData_->Jridx,
-                                   SigmaData_->Jsgn, SigmaData_->Toccs, cmat, smat, oei, tei, SigmaData_->F, cnac, nas,
+                s2_block_vras_rotf(SD->Jcnt, SD->Jij, SD->Joij, SD->Jridx,
+                                   SD->Jsgn, SD->Toccs, cmat, smat, oei, tei, SD->F, cnac, nas,
                                    nbs, sac, cac, cnas, AlphaG_, BetaG_, CalcInfo_, Occs_);
             } else {
-                s2_block_vras(alplist, betlist, cmat, smat, oei, tei, SigmaData_->F, cnac, nas, nbs, sac, cac, cnas);
+                s2_block_vras(alplist, betlist, cmat, smat, oei, tei, SD->F, cnac, nas, nbs, sac, cac, cnas);
             }
         }
-        timer_off("CIWave: s2");
+        if (!in_threads()) timer_off("CIWave: s2");
 
     } /* end sigma2 */
 
@@ -639,24 +865,24 @@ void CIWavefunction::sigma_block(struct stringwr **alplist, struct stringwr **be
 
     /* SIGMA1 CONTRIBUTION */
     if (!Ms0 || (sac != sbc)) {
-        timer_on("CIWave: s1");
+        if (!in_threads()) timer_on("CIWave: s1");
 
         if (s1_contrib_[sblock][cblock]) {
             if (fci) {
-                s1_block_vfci(alplist, betlist, cmat, smat, oei, tei, SigmaData_->F, cnbc, nas, nbs, sbc, cbc, cnbs);
+                s1_block_vfci(alplist, betlist, cmat, smat, oei, tei, SD->F, cnbc, nas, nbs, sbc, cbc, cnbs);
             } else {
                 if (Parameters_->repl_otf) {
-                    s1_block_vras_rotf(SigmaData_->Jcnt, SigmaData_->Jij, SigmaData_->Joij, SigmaData_->Jridx,
-                                       SigmaData_->Jsgn, SigmaData_->Toccs, cmat, smat, oei, tei, SigmaData_->F, cnbc,
+                    s1_block_vras_rotf(SD->Jcnt, SD->Jij, SD->Joij, SD->Jridx,
+                                       SD->Jsgn, SD->Toccs, cmat, smat, oei, tei, SD->F, cnbc,
                                        nas, nbs, sbc, cbc, cnbs, BetaG_, CalcInfo_, Occs_);
                 } else {
-                    s1_block_vras(alplist, betlist, cmat, smat, oei, tei, SigmaData_->F, cnbc, nas, nbs, sbc, cbc,
+                    s1_block_vras(alplist, betlist, cmat, smat, oei, tei, SD->F, cnbc, nas, nbs, sbc, cbc,
                                   cnbs);
                 }
             }
         }
 
-        timer_off("CIWave: s1");
+        if (!in_threads()) timer_off("CIWave: s1");
     } /* end sigma1 */
 
     if (print_ > 3) {
@@ -666,46 +892,46 @@ void CIWavefunction::sigma_block(struct stringwr **alplist, struct stringwr **be
 
     /* SIGMA3 CONTRIBUTION */
     if (s3_contrib_[sblock][cblock]) {
-        timer_on("CIWave: s3");
+        if (!in_threads()) timer_on("CIWave: s3");
 
         /* zero_mat(smat, nas, nbs); */
 
         if (!Ms0 || (sac != sbc)) {
             if (Parameters_->repl_otf) {
-                b2brepl(Occs_[sac], SigmaData_->Jcnt[0], SigmaData_->Jij[0], SigmaData_->Joij[0], SigmaData_->Jridx[0],
-                        SigmaData_->Jsgn[0], AlphaG_, sac, cac, nas, CalcInfo_);
-                b2brepl(Occs_[sbc], SigmaData_->Jcnt[1], SigmaData_->Jij[1], SigmaData_->Joij[1], SigmaData_->Jridx[1],
-                        SigmaData_->Jsgn[1], BetaG_, sbc, cbc, nbs, CalcInfo_);
-                s3_block_vrotf(SigmaData_->Jcnt, SigmaData_->Jij, SigmaData_->Jridx, SigmaData_->Jsgn, cmat, smat, tei,
-                               nas, nbs, cnas, sbc, cac, cbc, sbirr, cbirr, SigmaData_->cprime, SigmaData_->F,
-                               SigmaData_->V, SigmaData_->Sgn, SigmaData_->L, SigmaData_->R, CalcInfo_->num_ci_orbs,
+                b2brepl(Occs_[sac], SD->Jcnt[0], SD->Jij[0], SD->Joij[0], SD->Jridx[0],
+                        SD->Jsgn[0], AlphaG_, sac, cac, nas, CalcInfo_);
+                b2brepl(Occs_[sbc], SD->Jcnt[1], SD->Jij[1], SD->Joij[1], SD->Jridx[1],
+                        SD->Jsgn[1], BetaG_, sbc, cbc, nbs, CalcInfo_);
+                s3_block_vrotf(SD->Jcnt, SD->Jij, SD->Jridx, SD->Jsgn, cmat, smat, tei,
+                               nas, nbs, cnas, sbc, cac, cbc, sbirr, cbirr, SD->cprime, SD->F,
+                               SD->V, SD->Sgn, SD->L, SD->R, CalcInfo_->num_ci_orbs,
                                CalcInfo_->orbsym + CalcInfo_->num_drc_orbs);
             } else {
                 s3_block_v(alplist[sac], betlist[sbc], cmat, smat, tei, nas, nbs, cnas, sbc, cac, cbc, sbirr, cbirr,
-                           SigmaData_->cprime, SigmaData_->F, SigmaData_->V, SigmaData_->Sgn, SigmaData_->L,
-                           SigmaData_->R, CalcInfo_->num_ci_orbs, CalcInfo_->orbsym + CalcInfo_->num_drc_orbs);
+                           SD->cprime, SD->F, SD->V, SD->Sgn, SD->L,
+                           SD->R, CalcInfo_->num_ci_orbs, CalcInfo_->orbsym + CalcInfo_->num_drc_orbs);
             }
         }
 
         else if (Parameters_->bendazzoli) {
-            s3_block_bz(sac, sbc, cac, cbc, nas, nbs, cnas, tei, cmat, smat, SigmaData_->cprime, SigmaData_->sprime,
+            s3_block_bz(sac, sbc, cac, cbc, nas, nbs, cnas, tei, cmat, smat, SD->cprime, SD->sprime,
                         CalcInfo_, OV_);
         }
 
         else {
             if (Parameters_->repl_otf) {
-                b2brepl(Occs_[sac], SigmaData_->Jcnt[0], SigmaData_->Jij[0], SigmaData_->Joij[0], SigmaData_->Jridx[0],
-                        SigmaData_->Jsgn[0], AlphaG_, sac, cac, nas, CalcInfo_);
-                b2brepl(Occs_[sbc], SigmaData_->Jcnt[1], SigmaData_->Jij[1], SigmaData_->Joij[1], SigmaData_->Jridx[1],
-                        SigmaData_->Jsgn[1], BetaG_, sbc, cbc, nbs, CalcInfo_);
-                s3_block_vdiag_rotf(SigmaData_->Jcnt, SigmaData_->Jij, SigmaData_->Jridx, SigmaData_->Jsgn, cmat, smat,
-                                    tei, nas, nbs, cnas, sbc, cac, cbc, sbirr, cbirr, SigmaData_->cprime, SigmaData_->F,
-                                    SigmaData_->V, SigmaData_->Sgn, SigmaData_->L, SigmaData_->R,
+                b2brepl(Occs_[sac], SD->Jcnt[0], SD->Jij[0], SD->Joij[0], SD->Jridx[0],
+                        SD->Jsgn[0], AlphaG_, sac, cac, nas, CalcInfo_);
+                b2brepl(Occs_[sbc], SD->Jcnt[1], SD->Jij[1], SD->Joij[1], SD->Jridx[1],
+                        SD->Jsgn[1], BetaG_, sbc, cbc, nbs, CalcInfo_);
+                s3_block_vdiag_rotf(SD->Jcnt, SD->Jij, SD->Jridx, SD->Jsgn, cmat, smat,
+                                    tei, nas, nbs, cnas, sbc, cac, cbc, sbirr, cbirr, SD->cprime, SD->F,
+                                    SD->V, SD->Sgn, SD->L, SD->R,
                                     CalcInfo_->num_ci_orbs, CalcInfo_->orbsym + CalcInfo_->num_drc_orbs);
             } else {
                 s3_block_vdiag(alplist[sac], betlist[sbc], cmat, smat, tei, nas, nbs, cnas, sbc, cac, cbc, sbirr, cbirr,
-                               SigmaData_->cprime, SigmaData_->F, SigmaData_->V, SigmaData_->Sgn, SigmaData_->L,
-                               SigmaData_->R, CalcInfo_->num_ci_orbs, CalcInfo_->orbsym + CalcInfo_->num_drc_orbs);
+                               SD->cprime, SD->F, SD->V, SD->Sgn, SD->L,
+                               SD->R, CalcInfo_->num_ci_orbs, CalcInfo_->orbsym + CalcInfo_->num_drc_orbs);
             }
         }
 
@@ -714,7 +940,7 @@ void CIWavefunction::sigma_block(struct stringwr **alplist, struct stringwr **be
             print_mat(smat, nas, nbs, "outfile");
         }
 
-        timer_off("CIWave: s3");
+        if (!in_threads()) timer_off("CIWave: s3");
 
     } /* end sigma3 */
 }
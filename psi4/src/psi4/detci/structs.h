@@ -42,7 +42,9 @@
 #ifndef _psi_src_bin_detci_structs_h
 #define _psi_src_bin_detci_structs_h
 
+#include <cstdint>
 #include <string>
+#include <vector>
 #include "psi4/pragma.h"
 PRAGMA_WARNING_PUSH
 PRAGMA_WARNING_IGNORE_DEPRECATED_DECLARATIONS
@@ -71,6 +73,7 @@ namespace detci {
 #define METHOD_OLSEN 1
 #define METHOD_MITRUSHENKOV 2
 #define METHOD_DAVIDSON_LIU_SEM 3
+#define METHOD_HCI 4
 #define PRECON_LANCZOS 0
 #define PRECON_DAVIDSON 1
 #define PRECON_EVANGELISTI 2
@@ -535,6 +538,9 @@ struct params {
     int z_scale_H;                       /* 1(0) if pert. scaling used */
     double special_conv;                 /* special convergence value */
     int nthreads;                        /* number of threads to use in sigma routines */
+    int vecs_in_memory;                  /* keep CI vector buffers in memory, not on disk? */
+    double hci_epsilon;                  /* heat-bath selection threshold on |H_IJ c_J| */
+    int hci_maxiter;                     /* maximum number of HCI selection iterations */
     int sf_restrict;                     /* 1 if restrict CI space (CI blocks) to
                                             do only determinants (or their
                                             spin-complements) in RASCI versions of
@@ -641,6 +647,25 @@ struct sigma_data {
     double *V, *Sgn;
     int *L, *R;
     int max_dim;
+    int nthreads;                   /* threads sharing the icore=1 sigma build */
+    struct sigma_data *thread_data; /* scratch of threads 1..nthreads-1 */
+    int mpi_rank, mpi_nranks;       /* this process's share of the icore=1 sigma build */
+};
+
+/*
+** Selected-CI (heat-bath) space: the determinants kept so far, as alpha and
+** beta occupation bitstrings over the CI orbitals, and the current roots.
+*/
+struct sci_space {
+    std::vector<uint64_t> alp;      /* alpha string of each determinant */
+    std::vector<uint64_t> bet;      /* beta string of each determinant */
+    std::vector<int> orbsym;        /* irrep of each CI orbital */
+    int sym;                        /* irrep of every determinant in the space */
+    std::vector<double> hdiag;      /* H_II, without edrc */
+    std::vector<size_t> conn_start; /* CSR offsets of the determinants J > I */
+    std::vector<size_t> conn_det;   /* connected to each I by at most a double */
+    std::vector<double> conn_h;     /* and the H_IJ between them */
+    SharedMatrix evecs;             /* nroots x ndet CI vectors */
 };
 }
 }  // namespace psi
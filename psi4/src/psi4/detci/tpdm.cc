@@ -53,11 +53,6 @@ namespace detci {
 
 // DGAS this is still awkward, I think the TPDM code can be less general than the OPDM one for now.
 void CIWavefunction::form_tpdm() {
-    SharedCIVector Ivec = new_civector(Parameters_->num_roots, Parameters_->d_filenum);
-    Ivec->init_io_files(true);
-    SharedCIVector Jvec = new_civector(Parameters_->num_roots, Parameters_->d_filenum);
-    Jvec->init_io_files(true);
-
     std::vector<SharedMatrix> tpdm_list;
     std::vector<std::tuple<int, int, double> > states_vec;
     for (int root_idx = 0; root_idx < Parameters_->average_num; root_idx++) {
@@ -66,9 +61,18 @@ void CIWavefunction::form_tpdm() {
                                              Parameters_->average_weights[root_idx]));
     }
 
-    tpdm_list = tpdm(Ivec, Jvec, states_vec);
+    if (Parameters_->diag_method == METHOD_HCI) {
+        tpdm_list = sci_tpdm(states_vec);
+    } else {
+        SharedCIVector Ivec = new_civector(Parameters_->num_roots, Parameters_->d_filenum);
+        Ivec->init_io_files(true);
+        SharedCIVector Jvec = new_civector(Parameters_->num_roots, Parameters_->d_filenum);
+        Jvec->init_io_files(true);
+
+        tpdm_list = tpdm(Ivec, Jvec, states_vec);
 
-    Ivec->close_io_files(true);  // Closes Jvec too
+        Ivec->close_io_files(true);  // Closes Jvec too
+    }
 
     tpdm_aa_ = tpdm_list[0];
     tpdm_ab_ = tpdm_list[1];
@@ -349,6 +353,29 @@ std::vector<SharedMatrix> CIWavefunction::tpdm(SharedCIVector Ivec, SharedCIVect
         throw PSIEXCEPTION("CIWavefunction::tpdm: unrecognized core option!\n");
     }
 
+    std::vector<SharedMatrix> ret_list = tpdm_from_ci_order(tpdm_aap, tpdm_abp, tpdm_bbp);
+
+    // Ivec->buf_unlock();
+    // Jvec->buf_unlock();
+    if (transp_tmp) free(transp_tmp[0]);
+    free(transp_tmp);
+    if (transp_tmp2) free(transp_tmp2[0]);
+    free(transp_tmp2);
+
+    timer_off("CIWave: TPDM");
+
+    return ret_list;
+}
+
+/*
+** Reorders the CI-ordered AA, AB, and BB TPDMs (as built by tpdm_block) into
+** act^2 x act^2 Pitzer-ordered Matrices and forms the spin-summed TPDM.
+** Returns the AA, AB, BB, and summed TPDM's.
+*/
+std::vector<SharedMatrix> CIWavefunction::tpdm_from_ci_order(double *twopdm_aa, double *twopdm_ab, double *twopdm_bb) {
+    int nact = CalcInfo_->num_ci_orbs;
+    int nact2 = nact * nact;
+
     timer_on("CIWave: TPDM Reorder");
     // Symmetrize and reorder the TPDM
     auto tpdm_aam = std::make_shared<Matrix>("MO-basis TPDM AA", nact2, nact2);
@@ -376,16 +403,13 @@ std::vector<SharedMatrix> CIWavefunction::tpdm(SharedCIVector Ivec, SharedCIVect
                     int rs = r * nact + s;
                     size_t pqrs = INDEX(pq, rs);
 
-                    tpdm_aamp[r_pq][r_rs] = tpdm_aap[pqrs];
-                    tpdm_abmp[r_pq][r_rs] = tpdm_abp[pq * nact2 + rs];
-                    tpdm_bbmp[r_pq][r_rs] = tpdm_bbp[pqrs];
+                    tpdm_aamp[r_pq][r_rs] = twopdm_aa[pqrs];
+                    tpdm_abmp[r_pq][r_rs] = twopdm_ab[pq * nact2 + rs];
+                    tpdm_bbmp[r_pq][r_rs] = twopdm_bb[pqrs];
                 }
             }
         }
     }
-    tpdm_aa.reset();
-    tpdm_ab.reset();
-    tpdm_bb.reset();
 
     // Build our spin summed density matrix
     auto tpdm = std::make_shared<Matrix>("MO-basis TPDM", nact2, nact2);
@@ -408,13 +432,6 @@ std::vector<SharedMatrix> CIWavefunction::tpdm(SharedCIVector Ivec, SharedCIVect
     }
     timer_off("CIWave: TPDM Reorder");
 
-    // Ivec->buf_unlock();
-    // Jvec->buf_unlock();
-    if (transp_tmp) free(transp_tmp[0]);
-    free(transp_tmp);
-    if (transp_tmp2) free(transp_tmp2[0]);
-    free(transp_tmp2);
-
     std::vector<int> nshape{nact, nact, nact, nact};
     tpdm_aam->set_numpy_shape(nshape);
     tpdm_abm->set_numpy_shape(nshape);
@@ -427,8 +444,6 @@ std::vector<SharedMatrix> CIWavefunction::tpdm(SharedCIVector Ivec, SharedCIVect
     ret_list.push_back(tpdm_bbm);
     ret_list.push_back(tpdm);
 
-    timer_off("CIWave: TPDM");
-
     return ret_list;
 }
 
@@ -315,12 +315,17 @@ std::vector<std::vector<std::pair<double, double>>> DFEP2Wavefunction::compute(
 
     // ==> More Sizing <== /
 
-    size_t aaE_size = memory_doubles_ / nvir * nvir * nE;
+    // Both integral buffers live for the whole Newton solve, split the memory between them
+    size_t buffer_doubles = memory_doubles_ / 2;
+
+    size_t aaE_size = buffer_doubles / (nvir * nvir * nE);
     if (aaE_size > nocc) aaE_size = nocc;
+    if (aaE_size < 1) aaE_size = 1;
     // aaE_size = 2;
 
-    size_t ooE_size = memory_doubles_ / nocc * nocc * nE;
+    size_t ooE_size = buffer_doubles / (nocc * nocc * nE);
     if (ooE_size > nvir) ooE_size = nvir;
+    if (ooE_size < 1) ooE_size = 1;
     // ooE_size = 2;
 
     size_t aaE_nblocks = 1 + ((nocc - 1) / aaE_size);
@@ -346,14 +351,27 @@ std::vector<std::vector<std::pair<double, double>>> DFEP2Wavefunction::compute(
     std::vector<double> Ederiv(nE);
     std::vector<double> Eerror(nE);
 
+    // Orbitals still being iterated, converged orbitals are frozen and drop out of the passes
+    std::vector<size_t> active(nE);
+    for (size_t e = 0; e < nE; e++) active[e] = e;
+
     // thread info
     std::vector<std::vector<double>> deriv_temps(num_threads_, std::vector<double>(nE));
     std::vector<std::vector<double>> sigma_temps(num_threads_, std::vector<double>(nE));
-    size_t rank = 0;
+
+    // The integral buffers are allocated once, if a tensor fits in a single block it is only read once
+    auto I_ovvE = std::make_shared<Matrix>(aaE_size * nvir, nvir * nE);
+    auto I_vooE = std::make_shared<Matrix>(ooE_size * nocc, nocc * nE);
+    double** I_ovvEp = I_ovvE->pointer();
+    double** I_vooEp = I_vooE->pointer();
 
     for (size_t iter = 0; iter < max_iter_; iter++) {
+        size_t nactive = active.size();
+        const size_t* activep = active.data();
+
         // Reset data for loop
-        for (size_t i = 0; i < nE; i++) {
+        for (size_t k = 0; k < nactive; k++) {
+            size_t i = activep[k];
             Esigma[i] = 0.0;
             Ederiv[i] = 0.0;
             Eold[i] = Enew[i];
@@ -367,9 +385,6 @@ std::vector<std::vector<std::pair<double, double>>> DFEP2Wavefunction::compute(
         // sigma <= (Eabi - Ebai) * Eabi / (E - v - v + o)
 
         ovvE_addr = psio_get_address(PSIO_ZERO, 0);
-        auto I_ovvE = std::make_shared<Matrix>(aaE_size * nvir, nvir * nE);
-        double** I_ovvEp = I_ovvE->pointer();
-
         for (size_t i_block = 0; i_block < aaE_nblocks; i_block++) {
             size_t i_start = aaE_size * i_block;
             size_t ib_size = aaE_size;
@@ -377,38 +392,44 @@ std::vector<std::vector<std::pair<double, double>>> DFEP2Wavefunction::compute(
                 ib_size = nocc - i_start;
             }
 
-            psio_->read(unit_, "EP2 I_ovvE Integrals", (char*)I_ovvEp[0], (sizeof(double) * ib_size * nvir * nvir * nE),
-                        ovvE_addr, &ovvE_addr);
+            if ((aaE_nblocks > 1) || (iter == 0)) {
+                psio_->read(unit_, "EP2 I_ovvE Integrals", (char*)I_ovvEp[0],
+                            (sizeof(double) * ib_size * nvir * nvir * nE), ovvE_addr, &ovvE_addr);
+            }
 
-#pragma omp parallel for private(rank) schedule(dynamic, 1) collapse(2) num_threads(num_threads_)
+#pragma omp parallel for schedule(dynamic, 1) collapse(2) num_threads(num_threads_)
             for (size_t i = 0; i < ib_size; i++) {
                 for (size_t a = 0; a < nvir; a++) {
+                    size_t rank = 0;
 #ifdef _OPENMP
                     rank = omp_get_thread_num();
 #endif
+                    double* sigmap = sigma_temps[rank].data();
+                    double* derivp = deriv_temps[rank].data();
+                    double eps_ia = eps_occ[i_start + i] - eps_vir[a];
                     for (size_t b = 0; b < nvir; b++) {
-                        for (size_t e = 0; e < nE; e++) {
-                            double Eabi = I_ovvEp[i * nvir + b][a * nE + e];
-                            double Ebai = I_ovvEp[i * nvir + a][b * nE + e];
+                        double* Eabp = I_ovvEp[i * nvir + b] + a * nE;
+                        double* Ebap = I_ovvEp[i * nvir + a] + b * nE;
+                        double eps_iab = eps_ia - eps_vir[b];
+                        for (size_t k = 0; k < nactive; k++) {
+                            size_t e = activep[k];
+                            double Eabi = Eabp[e];
+                            double Ebai = Ebap[e];
                             double numer = (2.0 * Eabi - Ebai) * Eabi;
-                            double denom = (denom_E[e] - eps_vir[a] - eps_vir[b] + eps_occ[i_start + i]);
+                            double denom = denom_E[e] + eps_iab;
 
-                            sigma_temps[rank][e] += numer / denom;
-                            deriv_temps[rank][e] += numer / (denom * denom);
+                            sigmap[e] += numer / denom;
+                            derivp[e] += numer / (denom * denom);
                         }
                     }
                 }
             }
         }
-        I_ovvE.reset();
 
         // => De-excitations <= //
         // sigma <= (Eija - Ejia) * Eija / (E - o - o + v)
 
         vooE_addr = psio_get_address(PSIO_ZERO, 0);
-        auto I_vooE = std::make_shared<Matrix>(ooE_size * nocc, nocc * nE);
-        double** I_vooEp = I_vooE->pointer();
-
         for (size_t a_block = 0; a_block < ooE_nblocks; a_block++) {
             size_t a_start = ooE_size * a_block;
             size_t ab_size = ooE_size;
@@ -416,45 +437,56 @@ std::vector<std::vector<std::pair<double, double>>> DFEP2Wavefunction::compute(
                 ab_size = nvir - a_start;
             }
 
-            psio_->read(unit_, "EP2 I_vooE Integrals", (char*)I_vooEp[0], sizeof(double) * ab_size * nocc * nocc * nE,
-                        vooE_addr, &vooE_addr);
+            if ((ooE_nblocks > 1) || (iter == 0)) {
+                psio_->read(unit_, "EP2 I_vooE Integrals", (char*)I_vooEp[0],
+                            sizeof(double) * ab_size * nocc * nocc * nE, vooE_addr, &vooE_addr);
+            }
 
-#pragma omp parallel for private(rank) schedule(dynamic, 1) collapse(2) num_threads(num_threads_)
+#pragma omp parallel for schedule(dynamic, 1) collapse(2) num_threads(num_threads_)
             for (size_t a = 0; a < ab_size; a++) {
                 for (size_t i = 0; i < nocc; i++) {
+                    size_t rank = 0;
 #ifdef _OPENMP
                     rank = omp_get_thread_num();
 #endif
+                    double* sigmap = sigma_temps[rank].data();
+                    double* derivp = deriv_temps[rank].data();
+                    double eps_ai = eps_vir[a_start + a] - eps_occ[i];
                     for (size_t j = 0; j < nocc; j++) {
-                        for (size_t e = 0; e < nE; e++) {
-                            double Eija = I_vooEp[a * nocc + j][i * nE + e];
-                            double Ejia = I_vooEp[a * nocc + i][j * nE + e];
+                        double* Eijp = I_vooEp[a * nocc + j] + i * nE;
+                        double* Ejip = I_vooEp[a * nocc + i] + j * nE;
+                        double eps_aij = eps_ai - eps_occ[j];
+                        for (size_t k = 0; k < nactive; k++) {
+                            size_t e = activep[k];
+                            double Eija = Eijp[e];
+                            double Ejia = Ejip[e];
                             double numer = (2.0 * Eija - Ejia) * Eija;
-                            double denom = (denom_E[e] - eps_occ[i] - eps_occ[j] + eps_vir[a_start + a]);
+                            double denom = denom_E[e] + eps_aij;
 
-                            sigma_temps[rank][e] += numer / denom;
-                            deriv_temps[rank][e] += numer / (denom * denom);
+                            sigmap[e] += numer / denom;
+                            derivp[e] += numer / (denom * denom);
                         }
                     }
                 }
             }
         }
-        I_vooE.reset();
 
         // Sum up thread data
-        for (size_t i = 0; i < nE; i++) {
+        for (size_t k = 0; k < nactive; k++) {
+            size_t i = activep[k];
             for (size_t j = 0; j < num_threads_; j++) {
                 Ederiv[i] += deriv_temps[j][i];
                 Esigma[i] += sigma_temps[j][i];
             }
         }
 
-        // Update
+        // Update, the statistics only cover the orbitals iterated this pass
         double max_error = 0.0;
         double mean_error = 0.0;
-        size_t nremain = nE;
-        for (size_t i = 0; i < nE; i++) {
-            // printf("%16.8f  ", Enew[i]);
+        size_t nremain = nactive;
+        std::vector<size_t> still_active;
+        for (size_t k = 0; k < nactive; k++) {
+            size_t i = activep[k];
 
             // Compute new energy and update
             Enew[i] = eps_E[i] + Esigma[i];
@@ -465,27 +497,22 @@ std::vector<std::vector<std::pair<double, double>>> DFEP2Wavefunction::compute(
             mean_error += Eerror[i];
             if (Eerror[i] < conv_thresh_) {
                 nremain--;
+            } else {
+                still_active.push_back(i);
             }
             if (Eerror[i] > max_error) {
                 max_error = Eerror[i];
             }
         }
-        mean_error /= (double)nE;
-        // printf("\n");
+        mean_error /= (double)nactive;
 
         outfile->Printf("    %3zu %14.8f %14.8f   %4zu\n", (iter + 1), mean_error, max_error, nremain);
 
         if (max_error < conv_thresh_) break;
-
-        for (size_t i = 0; i < nE; i++) {
-            // printf("%8.2f %8.2f |  ", Esigma[i], Ederiv[i]);
-            // Reset E's
-            Eold[i] = Enew[i];
-            Esigma[i] = 0.0;
-            Ederiv[i] = 0.0;
-        }
-        // printf("\n");
+        active.swap(still_active);
     }
+    I_ovvE.reset();
+    I_vooE.reset();
     outfile->Printf("   --------------------------------------------\n\n");
     psio->close(unit_, 0);
 
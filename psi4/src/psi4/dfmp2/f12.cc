@@ -0,0 +1,605 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Psi4: an open-source quantum chemistry software package
+ *
+ * Copyright (c) 2007-2023 The Psi4 Developers.
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This file is part of Psi4.
+ *
+ * Psi4 is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * Psi4 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with Psi4; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * @END LICENSE
+ */
+
+#include "f12.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "psi4/psi4-dec.h"
+#include "psi4/libmints/basisset.h"
+#include "psi4/libmints/integral.h"
+#include "psi4/libmints/matrix.h"
+#include "psi4/libmints/mintshelper.h"
+#include "psi4/libmints/molecule.h"
+#include "psi4/libmints/orbitalspace.h"
+#include "psi4/libmints/twobody.h"
+#include "psi4/libmints/vector.h"
+#include "psi4/libpsi4util/exception.h"
+#include "psi4/libpsi4util/PsiOutStream.h"
+#include "psi4/libpsi4util/process.h"
+#include "psi4/libqt/qt.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace psi {
+namespace dfmp2 {
+
+namespace {
+
+// Frobenius product <A, B^T> of two n x n matrices
+double dot_transpose(size_t n, const double* A, const double* B) {
+    double val = 0.0;
+    for (size_t x = 0; x < n; x++) {
+        for (size_t y = 0; y < n; y++) {
+            val += A[x * n + y] * B[y * n + x];
+        }
+    }
+    return val;
+}
+
+// S = F M + M F for n x n matrices
+void anticommutator(int n, double* F, double* M, double* S) {
+    C_DGEMM('N', 'N', n, n, n, 1.0, F, n, M, n, 0.0, S, n);
+    C_DGEMM('N', 'N', n, n, n, 1.0, M, n, F, n, 1.0, S, n);
+}
+
+}  // namespace
+
+RDFMP2F12::RDFMP2F12(SharedWavefunction ref_wfn, Options& options, std::shared_ptr<PSIO> psio)
+    : RDFMP2(ref_wfn, options, psio) {
+    common_init();
+}
+RDFMP2F12::~RDFMP2F12() {}
+void RDFMP2F12::common_init() {
+    name_ = "DF-MP2-F12";
+
+    if (molecule_->schoenflies_symbol() != "c1") {
+        throw PSIEXCEPTION("DF-MP2-F12: Only C1 symmetry is supported.");
+    }
+    if (basisset_->has_ECP()) {
+        throw PSIEXCEPTION("DF-MP2-F12: ECP basis sets are not supported.");
+    }
+
+    cabs_basis_ = get_basisset("CABS_BASIS");
+    beta_ = options_.get_double("F12_BETA");
+
+    // f12_cgtg fits -exp(-beta r12); the cusp conditions of the fixed amplitudes need the 1/beta
+    MintsHelper mints(basisset_, options_);
+    cgtg_ = mints.f12_cgtg(beta_);
+    for (auto& exp_coeff : cgtg_) exp_coeff.second /= beta_;
+
+    variables_["MP2-F12 CORRECTION ENERGY"] = 0.0;
+}
+void RDFMP2F12::print_header() {
+    RDFMP2::print_header();
+
+    outfile->Printf("\t --------------------------------------------------------\n");
+    outfile->Printf("\t               MP2-F12/3C(FIX), Beta = %6.3f\n", beta_);
+    outfile->Printf("\t --------------------------------------------------------\n\n");
+
+    if (print_ >= 1) {
+        outfile->Printf("   => OBS + CABS Basis Set <=\n\n");
+        cabs_basis_->print_by_level("outfile", print_);
+    }
+}
+double RDFMP2F12::compute_energy() {
+    DFMP2::compute_energy();
+
+    timer_on("DFMP2F12 CABS");
+    form_cabs();
+    timer_off("DFMP2F12 CABS");
+
+    timer_on("DFMP2F12 Energy");
+    form_f12_energy();
+    timer_off("DFMP2F12 Energy");
+
+    print_f12_energies();
+    energy_ = variables_["MP2-F12 TOTAL ENERGY"];
+
+    return energy_;
+}
+void RDFMP2F12::form_cabs() {
+    double lindep_tol = options_.get_double("CABS_LINDEP_TOLERANCE");
+
+    OrbitalSpace obs("p", "OBS", Ca_subset("AO", "ALL"), epsilon_a_subset("AO", "ALL"), basisset_, integral_);
+    OrbitalSpace ri = OrbitalSpace::build_ri_space(cabs_basis_, lindep_tol);
+    OrbitalSpace cabs = OrbitalSpace::build_cabs_space(obs, ri, lindep_tol);
+
+    Ccabs_ = cabs.C();
+}
+void RDFMP2F12::form_Aix(const IntsBuilder& build, std::shared_ptr<BasisSet> basis2, SharedMatrix C1,
+                         SharedMatrix C2, SharedMatrix Aix, int xoff) {
+    int nthread = 1;
+#ifdef _OPENMP
+    if (options_.get_int("DF_INTS_NUM_THREADS") == 0) {
+        nthread = Process::environment.get_n_threads();
+    } else {
+        nthread = options_.get_int("DF_INTS_NUM_THREADS");
+    }
+#endif
+
+    int nbf1 = basisset_->nbf();
+    int nbf2 = basis2->nbf();
+    int ni = C1->colspi()[0];
+    int nx = C2->colspi()[0];
+    if (ni == 0 || nx == 0) return;
+    int ldx = Aix->colspi()[0] / ni;
+    int maxQ = ribasis_->max_function_per_shell();
+
+    IntegralFactory factory(ribasis_, BasisSet::zero_ao_basis_set(), basisset_, basis2);
+    std::vector<std::unique_ptr<TwoBodyAOInt>> ints;
+    for (int thread = 0; thread < nthread; thread++) ints.push_back(build(factory));
+
+    // One (Q|mn) block and one half-transformed row per thread; Q shells are independent
+    std::vector<std::vector<double>> Amn(nthread, std::vector<double>(maxQ * (size_t)nbf1 * nbf2));
+    std::vector<std::vector<double>> Ain(nthread, std::vector<double>(ni * (size_t)nbf2));
+
+    double** C1p = C1->pointer();
+    double** C2p = C2->pointer();
+    double** Aixp = Aix->pointer();
+
+#pragma omp parallel for schedule(dynamic) num_threads(nthread)
+    for (int Q = 0; Q < ribasis_->nshell(); Q++) {
+        int thread = 0;
+#ifdef _OPENMP
+        thread = omp_get_thread_num();
+#endif
+        int nq = ribasis_->shell(Q).nfunction();
+        int sq = ribasis_->shell(Q).function_index();
+        double* Amnp = Amn[thread].data();
+        double* Ainp = Ain[thread].data();
+
+        for (int M = 0; M < basisset_->nshell(); M++) {
+            int nm = basisset_->shell(M).nfunction();
+            int sm = basisset_->shell(M).function_index();
+            for (int N = 0; N < basis2->nshell(); N++) {
+                int nn = basis2->shell(N).nfunction();
+                int sn = basis2->shell(N).function_index();
+
+                ints[thread]->compute_shell(Q, 0, M, N);
+                const double* buffer = ints[thread]->buffer();
+
+                for (int oq = 0; oq < nq; oq++) {
+                    for (int om = 0; om < nm; om++) {
+                        for (int on = 0; on < nn; on++) {
+                            Amnp[(oq * (size_t)nbf1 + om + sm) * nbf2 + on + sn] = *buffer++;
+                        }
+                    }
+                }
+            }
+        }
+
+        for (int oq = 0; oq < nq; oq++) {
+            C_DGEMM('T', 'N', ni, nbf2, nbf1, 1.0, C1p[0], ni, Amnp + oq * (size_t)nbf1 * nbf2, nbf2, 0.0, Ainp,
+                    nbf2);
+            C_DGEMM('N', 'N', ni, nx, nbf2, 1.0, Ainp, nbf2, C2p[0], nx, 0.0, Aixp[sq + oq] + xoff, ldx);
+        }
+    }
+}
+SharedMatrix RDFMP2F12::form_AB(const IntsBuilder& build) {
+    int naux = ribasis_->nbf();
+    auto AB = std::make_shared<Matrix>("(A|O|B)", naux, naux);
+    double** ABp = AB->pointer();
+
+    IntegralFactory factory(ribasis_, BasisSet::zero_ao_basis_set(), ribasis_, BasisSet::zero_ao_basis_set());
+    auto ints = build(factory);
+
+    for (int P = 0; P < ribasis_->nshell(); P++) {
+        int np = ribasis_->shell(P).nfunction();
+        int sp = ribasis_->shell(P).function_index();
+        for (int Q = 0; Q <= P; Q++) {
+            int nq = ribasis_->shell(Q).nfunction();
+            int sq = ribasis_->shell(Q).function_index();
+
+            ints->compute_shell(P, 0, Q, 0);
+            const double* buffer = ints->buffer();
+
+            for (int op = 0; op < np; op++) {
+                for (int oq = 0; oq < nq; oq++) {
+                    ABp[sp + op][sq + oq] = ABp[sq + oq][sp + op] = *buffer++;
+                }
+            }
+        }
+    }
+
+    return AB;
+}
+SharedMatrix RDFMP2F12::form_Amn_contracted(std::shared_ptr<BasisSet> basis1, std::shared_ptr<BasisSet> basis2,
+                                            SharedVector gamma) {
+    int nthread = 1;
+#ifdef _OPENMP
+    nthread = Process::environment.get_n_threads();
+#endif
+
+    int nbf1 = basis1->nbf();
+    int nbf2 = basis2->nbf();
+
+    IntegralFactory factory(ribasis_, BasisSet::zero_ao_basis_set(), basis1, basis2);
+    std::vector<std::unique_ptr<TwoBodyAOInt>> ints;
+    std::vector<SharedMatrix> Jt;
+    for (int thread = 0; thread < nthread; thread++) {
+        ints.push_back(factory.eri(0, false));
+        Jt.push_back(std::make_shared<Matrix>("J", nbf1, nbf2));
+    }
+    double* gammap = gamma->pointer();
+
+#pragma omp parallel for schedule(dynamic) num_threads(nthread)
+    for (int Q = 0; Q < ribasis_->nshell(); Q++) {
+        int thread = 0;
+#ifdef _OPENMP
+        thread = omp_get_thread_num();
+#endif
+        int nq = ribasis_->shell(Q).nfunction();
+        int sq = ribasis_->shell(Q).function_index();
+        double** Jp = Jt[thread]->pointer();
+
+        for (int M = 0; M < basis1->nshell(); M++) {
+            int nm = basis1->shell(M).nfunction();
+            int sm = basis1->shell(M).function_index();
+            for (int N = 0; N < basis2->nshell(); N++) {
+                int nn = basis2->shell(N).nfunction();
+                int sn = basis2->shell(N).function_index();
+
+                ints[thread]->compute_shell(Q, 0, M, N);
+                const double* buffer = ints[thread]->buffer();
+
+                for (int oq = 0; oq < nq; oq++) {
+                    double g = gammap[sq + oq];
+                    for (int om = 0; om < nm; om++) {
+                        for (int on = 0; on < nn; on++) {
+                            Jp[sm + om][sn + on] += g * (*buffer++);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    for (int thread = 1; thread < nthread; thread++) Jt[0]->add(Jt[thread]);
+    return Jt[0];
+}
+SharedMatrix RDFMP2F12::form_ri_operator(SharedMatrix Aoo, SharedMatrix Aoc, SharedMatrix Acc) {
+    SharedMatrix Cobs = Ca_subset("AO", "ALL");
+    int nmo = Cobs->colspi()[0];
+    int ncabs = Ccabs_->colspi()[0];
+    int nri = nmo + ncabs;
+
+    auto A = std::make_shared<Matrix>("RI Operator", nri, nri);
+    double** Ap = A->pointer();
+
+    auto App = linalg::triplet(Cobs, Aoo, Cobs, true, false, false);
+    auto Apc = linalg::triplet(Cobs, Aoc, Ccabs_, true, false, false);
+    auto Acc_mo = linalg::triplet(Ccabs_, Acc, Ccabs_, true, false, false);
+
+    for (int p = 0; p < nmo; p++) {
+        for (int q = 0; q < nmo; q++) Ap[p][q] = App->get(p, q);
+        for (int c = 0; c < ncabs; c++) Ap[p][nmo + c] = Ap[nmo + c][p] = Apc->get(p, c);
+    }
+    for (int c = 0; c < ncabs; c++) {
+        for (int d = 0; d < ncabs; d++) Ap[nmo + c][nmo + d] = Acc_mo->get(c, d);
+    }
+
+    return A;
+}
+void RDFMP2F12::form_f12_energy() {
+    int nthread = 1;
+#ifdef _OPENMP
+    nthread = Process::environment.get_n_threads();
+#endif
+
+    SharedMatrix Cobs = Ca_subset("AO", "ALL");
+    SharedMatrix Cocc = Ca_subset("AO", "OCC");
+    SharedVector eps = epsilon_a_subset("AO", "ALL");
+    double* epsp = eps->pointer();
+
+    int nmo = Cobs->colspi()[0];
+    int nfocc = frzcpi_.sum();
+    int naocc = Caocc_->colspi()[0];
+    int nocc = nfocc + naocc;
+    int navir = Cavir_->colspi()[0];
+    int ncabs = Ccabs_->colspi()[0];
+    int nri = nmo + ncabs;
+    int naux = ribasis_->nbf();
+    size_t nri2 = nri * (size_t)nri;
+    size_t nox = nocc * (size_t)nri;
+    size_t noo = nocc * (size_t)nocc;
+
+    // Four (A|mx) tensors are live through the pair loop, plus a fifth while (A|f12^2|mx) is contracted
+    size_t required = 5L * naux * nox + 8L * naux * noo + 6L * naux * naux + 3L * nri2 +
+                      nthread * (5L * nri2 + navir * (size_t)navir);
+    size_t doubles = (size_t)(memory_ / 8L);
+    outfile->Printf("\t F12 intermediates require %zu MiB, %zu MiB available\n\n", required * 8L / (1024L * 1024L),
+                    doubles * 8L / (1024L * 1024L));
+    if (required > doubles) {
+        throw PSIEXCEPTION("DF-MP2-F12: Not enough memory for the three-index F12 intermediates.");
+    }
+
+    IntsBuilder eri = [](IntegralFactory& factory) { return factory.eri(0, false); };
+    IntsBuilder f12 = [this](IntegralFactory& factory) { return factory.f12(cgtg_, 0, false); };
+    IntsBuilder f12_squared = [this](IntegralFactory& factory) { return factory.f12_squared(cgtg_, 0, false); };
+    IntsBuilder f12g12 = [this](IntegralFactory& factory) { return factory.f12g12(cgtg_, 0, false); };
+    IntsBuilder f12_double_commutator = [this](IntegralFactory& factory) {
+        return factory.f12_double_commutator(cgtg_, 0, false);
+    };
+
+    // => Coulomb Fitting <= //
+
+    timer_on("DFMP2F12 Coulomb");
+    SharedMatrix Jm12 = form_inverse_metric();
+    SharedMatrix Jinv = linalg::doublet(Jm12, Jm12);
+    double** Jinvp = Jinv->pointer();
+
+    // (A|mx) and d_A^mx = J^-1_AB (B|mx) over the OBS + CABS orbitals x
+    auto Jmx = std::make_shared<Matrix>("(A|mx)", naux, nox);
+    form_Aix(eri, basisset_, Cocc, Cobs, Jmx, 0);
+    form_Aix(eri, cabs_basis_, Cocc, Ccabs_, Jmx, nmo);
+    auto dmx = std::make_shared<Matrix>("d(A|mx)", naux, nox);
+    double** Jmxp = Jmx->pointer();
+    double** dmxp = dmx->pointer();
+    C_DGEMM('N', 'N', naux, nox, naux, 1.0, Jinvp[0], naux, Jmxp[0], nox, 0.0, dmxp[0], nox);
+
+    // d_A^mn over the occupied block only
+    auto dmn = std::make_shared<Matrix>("d(A|mn)", naux, noo);
+    double** dmnp = dmn->pointer();
+    for (int A = 0; A < naux; A++) {
+        for (int m = 0; m < nocc; m++) {
+            ::memcpy(&dmnp[A][m * (size_t)nocc], &dmxp[A][m * (size_t)nri], sizeof(double) * nocc);
+        }
+    }
+    timer_off("DFMP2F12 Coulomb");
+
+    // => Fock Operator over OBS + CABS <= //
+
+    timer_on("DFMP2F12 Fock");
+    auto K = std::make_shared<Matrix>("K", nri, nri);
+    double** Kp = K->pointer();
+    C_DGEMM('T', 'N', nri, nri, naux * nocc, 1.0, Jmxp[0], nri, dmxp[0], nri, 0.0, Kp[0], nri);
+    K->hermitivitize();
+
+    auto gamma = std::make_shared<Vector>("gamma", naux);
+    double* gammap = gamma->pointer();
+    for (int A = 0; A < naux; A++) {
+        for (int m = 0; m < nocc; m++) gammap[A] += 2.0 * dmxp[A][m * (size_t)nri + m];
+    }
+
+    MintsHelper mints(basisset_, options_);
+    std::vector<std::pair<std::shared_ptr<BasisSet>, std::shared_ptr<BasisSet>>> blocks = {
+        {basisset_, basisset_}, {basisset_, cabs_basis_}, {cabs_basis_, cabs_basis_}};
+    std::vector<SharedMatrix> hJ_blocks;
+    for (const auto& block : blocks) {
+        SharedMatrix hJ = mints.ao_kinetic(block.first, block.second);
+        hJ->add(mints.ao_potential(block.first, block.second));
+        hJ->axpy(2.0, form_Amn_contracted(block.first, block.second, gamma));
+        hJ_blocks.push_back(hJ);
+    }
+
+    // h + 2J for the local part of <f12 F f12>, and the full Fock operator
+    SharedMatrix hJ = form_ri_operator(hJ_blocks[0], hJ_blocks[1], hJ_blocks[2]);
+    SharedMatrix F = hJ->clone();
+    F->subtract(K);
+    double** hJp = hJ->pointer();
+    double** Fp = F->pointer();
+    timer_off("DFMP2F12 Fock");
+
+    // => Occupied-Only F12 Kernels <= //
+
+    timer_on("DFMP2F12 Kernels");
+    // (A|O|mn) and E = (A|O|mn) - (A|O|B) d_B^mn, so that the robust fit is
+    // (km|O|ln) = (A|O|km) d_A^ln + d_A^km E_A^ln
+    auto form_robust = [&](const IntsBuilder& build, SharedMatrix& Omn, SharedMatrix& Emn) {
+        Omn = std::make_shared<Matrix>("(A|O|mn)", naux, noo);
+        form_Aix(build, basisset_, Cocc, Cocc, Omn, 0);
+        Emn = Omn->clone();
+        SharedMatrix W = form_AB(build);
+        C_DGEMM('N', 'N', naux, noo, naux, -1.0, W->pointer()[0], naux, dmnp[0], noo, 1.0, Emn->pointer()[0], noo);
+    };
+    auto robust = [&](const SharedMatrix& Omn, const SharedMatrix& dkm, const SharedMatrix& Emn, int k, int m, int l,
+                      int n) {
+        size_t km = k * (size_t)nocc + m;
+        size_t ln = l * (size_t)nocc + n;
+        return C_DDOT(naux, &Omn->pointer()[0][km], noo, &dmnp[0][ln], noo) +
+               C_DDOT(naux, &dkm->pointer()[0][km], noo, &Emn->pointer()[0][ln], noo);
+    };
+
+    SharedMatrix FGmn, FGEmn, Umn, UEmn;
+    form_robust(f12g12, FGmn, FGEmn);
+    form_robust(f12_double_commutator, Umn, UEmn);
+
+    // f12^2 is also needed with one ket orbital dressed by h + 2J, m~ = sum_x |x> (h + 2J)_xm
+    SharedMatrix F2mn, F2Emn;
+    auto F2tmn = std::make_shared<Matrix>("(A|f12^2|km~)", naux, noo);
+    auto dtmn = std::make_shared<Matrix>("d(A|km~)", naux, noo);
+    {
+        auto F2mx = std::make_shared<Matrix>("(A|f12^2|mx)", naux, nox);
+        form_Aix(f12_squared, basisset_, Cocc, Cobs, F2mx, 0);
+        form_Aix(f12_squared, cabs_basis_, Cocc, Ccabs_, F2mx, nmo);
+        double** F2mxp = F2mx->pointer();
+
+        C_DGEMM('N', 'N', naux * nocc, nocc, nri, 1.0, F2mxp[0], nri, hJp[0], nri, 0.0, F2tmn->pointer()[0], nocc);
+        C_DGEMM('N', 'N', naux * nocc, nocc, nri, 1.0, dmxp[0], nri, hJp[0], nri, 0.0, dtmn->pointer()[0], nocc);
+
+        F2mn = std::make_shared<Matrix>("(A|f12^2|mn)", naux, noo);
+        double** F2mnp = F2mn->pointer();
+        for (int A = 0; A < naux; A++) {
+            for (int m = 0; m < nocc; m++) {
+                ::memcpy(&F2mnp[A][m * (size_t)nocc], &F2mxp[A][m * (size_t)nri], sizeof(double) * nocc);
+            }
+        }
+        F2Emn = F2mn->clone();
+        SharedMatrix W = form_AB(f12_squared);
+        C_DGEMM('N', 'N', naux, noo, naux, -1.0, W->pointer()[0], naux, dmnp[0], noo, 1.0, F2Emn->pointer()[0], noo);
+    }
+    timer_off("DFMP2F12 Kernels");
+
+    // => F12 over OBS + CABS <= //
+
+    timer_on("DFMP2F12 (A|f12|mx)");
+    auto Fmx = std::make_shared<Matrix>("(A|f12|mx)", naux, nox);
+    form_Aix(f12, basisset_, Cocc, Cobs, Fmx, 0);
+    form_Aix(f12, cabs_basis_, Cocc, Ccabs_, Fmx, nmo);
+    auto Emx = Fmx->clone();
+    double** Fmxp = Fmx->pointer();
+    double** Emxp = Emx->pointer();
+    {
+        SharedMatrix W = form_AB(f12);
+        C_DGEMM('N', 'N', naux, nox, naux, -1.0, W->pointer()[0], naux, dmxp[0], nox, 1.0, Emxp[0], nox);
+    }
+    timer_off("DFMP2F12 (A|f12|mx)");
+
+    // Pairs (xy) kept by P12 = P1 P2 + O1 P'2 + P'1 O2; Q12 = 1 - P12 is Ansatz 3
+    std::vector<double> proj(nri2, 0.0);
+    for (int x = 0; x < nri; x++) {
+        for (int y = 0; y < nri; y++) {
+            if ((x < nmo && y < nmo) || (x < nocc && y >= nmo) || (x >= nmo && y < nocc)) {
+                proj[x * (size_t)nri + y] = 1.0;
+            }
+        }
+    }
+
+    std::vector<std::pair<int, int>> pairs;
+    for (int i = nfocc; i < nocc; i++) {
+        for (int j = i; j < nocc; j++) pairs.emplace_back(i, j);
+    }
+
+    // => Pair Energies <= //
+
+    timer_on("DFMP2F12 Pairs");
+    std::vector<std::vector<double>> work(nthread, std::vector<double>(4 * nri2 + navir * (size_t)navir));
+    double e_singlet = 0.0;
+    double e_triplet = 0.0;
+    double e_coupling = 0.0;
+
+#pragma omp parallel for schedule(dynamic) num_threads(nthread) reduction(+ : e_singlet, e_triplet, e_coupling)
+    for (size_t ij = 0; ij < pairs.size(); ij++) {
+        int thread = 0;
+#ifdef _OPENMP
+        thread = omp_get_thread_num();
+#endif
+        int i = pairs[ij].first;
+        int j = pairs[ij].second;
+
+        double* M = work[thread].data();
+        double* PM = M + nri2;
+        double* G = PM + nri2;
+        double* S = G + nri2;
+        double* C = S + nri2;
+
+        // M_xy = (ix|f12|jy) = <xy|f12|ij>, PM = P12 M, and G_xy = (ix|jy)
+        C_DGEMM('T', 'N', nri, nri, naux, 1.0, Fmxp[0] + i * (size_t)nri, nox, dmxp[0] + j * (size_t)nri, nox, 0.0, M,
+                nri);
+        C_DGEMM('T', 'N', nri, nri, naux, 1.0, dmxp[0] + i * (size_t)nri, nox, Emxp[0] + j * (size_t)nri, nox, 1.0, M,
+                nri);
+        C_DGEMM('T', 'N', nri, nri, naux, 1.0, Jmxp[0] + i * (size_t)nri, nox, dmxp[0] + j * (size_t)nri, nox, 0.0, G,
+                nri);
+        for (size_t xy = 0; xy < nri2; xy++) PM[xy] = proj[xy] * M[xy];
+
+        // Direct (ij|ij) and exchanged (ij|ji) elements of V, X, and B
+        double V1 = robust(FGmn, dmn, FGEmn, i, i, j, j) - C_DDOT(nri2, G, 1, PM, 1);
+        double V2 = robust(FGmn, dmn, FGEmn, i, j, j, i) - dot_transpose(nri, G, PM);
+        double X1 = robust(F2mn, dmn, F2Emn, i, i, j, j) - C_DDOT(nri2, PM, 1, M, 1);
+        double X2 = robust(F2mn, dmn, F2Emn, i, j, j, i) - dot_transpose(nri, PM, M);
+
+        // <f12 F f12>: double commutator, f12^2 against h + 2J, and the RI exchange
+        double B1 = robust(Umn, dmn, UEmn, i, i, j, j) + robust(F2tmn, dtmn, F2Emn, i, i, j, j) +
+                    robust(F2tmn, dtmn, F2Emn, j, j, i, i);
+        double B2 = robust(Umn, dmn, UEmn, i, j, j, i) + robust(F2tmn, dtmn, F2Emn, i, j, j, i) +
+                    robust(F2tmn, dtmn, F2Emn, j, i, i, j);
+        anticommutator(nri, Kp[0], M, S);
+        B1 -= C_DDOT(nri2, M, 1, S, 1);
+        B2 -= dot_transpose(nri, M, S);
+
+        // - <f12 P12 F f12> - <f12 F P12 f12> + <f12 P12 F P12 f12>
+        anticommutator(nri, Fp[0], M, S);
+        B1 -= 2.0 * C_DDOT(nri2, PM, 1, S, 1);
+        B2 -= 2.0 * dot_transpose(nri, PM, S);
+        anticommutator(nri, Fp[0], PM, S);
+        B1 += C_DDOT(nri2, PM, 1, S, 1);
+        B2 += dot_transpose(nri, PM, S);
+
+        // Fixed amplitudes: 1/2 for singlet and 1/4 for triplet pairs
+        double eij = epsp[i] + epsp[j];
+        double norm = (i == j ? 0.5 : 1.0);
+        double Vs = norm * (V1 + V2);
+        double Xs = norm * (X1 + X2);
+        double Bs = norm * (B1 + B2);
+        e_singlet += Vs + 0.25 * (Bs - eij * Xs);
+        if (i != j) {
+            e_triplet += 3.0 * (0.5 * (V1 - V2) + 0.0625 * ((B1 - B2) - eij * (X1 - X2)));
+        }
+
+        // Relaxing the conventional amplitudes in the presence of C_ab = f_aa' M_a'b + M_aa' f_a'b
+        if (ncabs == 0 || navir == 0) continue;
+        C_DGEMM('N', 'N', navir, navir, ncabs, 1.0, &Fp[nocc][nmo], nri, M + nmo * (size_t)nri + nocc, nri, 0.0, C,
+                navir);
+        C_DGEMM('N', 'N', navir, navir, ncabs, 1.0, M + nocc * (size_t)nri + nmo, nri, &Fp[nmo][nocc], nri, 1.0, C,
+                navir);
+        double e_pair = 0.0;
+        for (int a = 0; a < navir; a++) {
+            for (int b = 0; b < navir; b++) {
+                double Kab = G[(nocc + a) * (size_t)nri + nocc + b];
+                double Kba = G[(nocc + b) * (size_t)nri + nocc + a];
+                double Rab = Kab + 0.375 * C[a * (size_t)navir + b] + 0.125 * C[b * (size_t)navir + a];
+                double Rba = Kba + 0.375 * C[b * (size_t)navir + a] + 0.125 * C[a * (size_t)navir + b];
+                double denom = epsp[nocc + a] + epsp[nocc + b] - eij;
+                e_pair += ((2.0 * Rab - Rba) * Rab - (2.0 * Kab - Kba) * Kab) / denom;
+            }
+        }
+        e_coupling -= (i == j ? 1.0 : 2.0) * e_pair;
+    }
+    timer_off("DFMP2F12 Pairs");
+
+    e_singlet_ = e_singlet;
+    e_triplet_ = e_triplet;
+    e_coupling_ = e_coupling;
+
+    variables_["MP2-F12 CORRECTION ENERGY"] = e_singlet_ + e_triplet_ + e_coupling_;
+    variables_["MP2-F12 CORRELATION ENERGY"] =
+        variables_["MP2 CORRELATION ENERGY"] + variables_["MP2-F12 CORRECTION ENERGY"];
+    variables_["MP2-F12 TOTAL ENERGY"] = variables_["SCF TOTAL ENERGY"] + variables_["MP2-F12 CORRELATION ENERGY"];
+}
+void RDFMP2F12::print_f12_energies() {
+    outfile->Printf("\t-----------------------------------------------------------\n");
+    outfile->Printf("\t ================> DF-MP2-F12 Energies <================== \n");
+    outfile->Printf("\t-----------------------------------------------------------\n");
+    outfile->Printf("\t %-25s = %24.16f [Eh]\n", "Singlet F12 Energy", e_singlet_);
+    outfile->Printf("\t %-25s = %24.16f [Eh]\n", "Triplet F12 Energy", e_triplet_);
+    outfile->Printf("\t %-25s = %24.16f [Eh]\n", "CABS Coupling Energy", e_coupling_);
+    outfile->Printf("\t %-25s = %24.16f [Eh]\n", "F12 Correction", variables_["MP2-F12 CORRECTION ENERGY"]);
+    outfile->Printf("\t %-25s = %24.16f [Eh]\n", "MP2 Correlation Energy", variables_["MP2 CORRELATION ENERGY"]);
+    outfile->Printf("\t %-25s = %24.16f [Eh]\n", "Correlation Energy", variables_["MP2-F12 CORRELATION ENERGY"]);
+    outfile->Printf("\t %-25s = %24.16f [Eh]\n", "Total Energy", variables_["MP2-F12 TOTAL ENERGY"]);
+    outfile->Printf("\t-----------------------------------------------------------\n");
+    outfile->Printf("\n");
+}
+
+}  // namespace dfmp2
+}  // namespace psi
@@ -0,0 +1,100 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Psi4: an open-source quantum chemistry software package
+ *
+ * Copyright (c) 2007-2023 The Psi4 Developers.
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This file is part of Psi4.
+ *
+ * Psi4 is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * Psi4 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with Psi4; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * @END LICENSE
+ */
+
+#ifndef DFMP2_F12_H
+#define DFMP2_F12_H
+
+#include "mp2.h"
+
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace psi {
+
+class IntegralFactory;
+class TwoBodyAOInt;
+
+namespace dfmp2 {
+
+// DF-MP2-F12/3C(FIX): Werner, Adler, and Manby, J. Chem. Phys. 126, 164102 (2007), with the
+// fixed cusp amplitudes of Ten-no, J. Chem. Phys. 121, 117 (2004). Every two-electron quantity,
+// F12 kernels included, is robustly fitted in the Coulomb metric of DF_BASIS_MP2 (Manby,
+// J. Chem. Phys. 119, 4607 (2003)), and the RI is done over OBS + CABS.
+
+class RDFMP2F12 : public RDFMP2 {
+   protected:
+    using IntsBuilder = std::function<std::unique_ptr<TwoBodyAOInt>(IntegralFactory&)>;
+
+    // Union of the orbital and complementary auxiliary basis sets
+    std::shared_ptr<BasisSet> cabs_basis_;
+    // CABS orbitals, expanded in cabs_basis_
+    SharedMatrix Ccabs_;
+    // Slater exponent of the geminal -exp(-beta r12) / beta
+    double beta_;
+    // Gaussian expansion of the geminal
+    std::vector<std::pair<double, double>> cgtg_;
+
+    // Singlet- and triplet-pair F12 energies and the conventional-F12 coupling
+    double e_singlet_;
+    double e_triplet_;
+    double e_coupling_;
+
+    void common_init();
+
+    // Print additional header
+    void print_header() override;
+    // Build the CABS orbitals by projecting the orbital basis out of the union basis
+    void form_cabs();
+    // Form (A|O|ix) = C1_mi (A|O|mn) C2_nx into columns [xoff, xoff + nx) of each i block of Aix
+    void form_Aix(const IntsBuilder& build, std::shared_ptr<BasisSet> basis2, SharedMatrix C1, SharedMatrix C2,
+                  SharedMatrix Aix, int xoff);
+    // Form the two-center (A|O|B) metric of an operator
+    SharedMatrix form_AB(const IntsBuilder& build);
+    // Form sum_A gamma_A (A|mn) over the orbital basis and basis2
+    SharedMatrix form_Amn_contracted(std::shared_ptr<BasisSet> basis1, std::shared_ptr<BasisSet> basis2,
+                                     SharedVector gamma);
+    // Assemble an operator over the OBS + CABS orbitals from its AO blocks
+    SharedMatrix form_ri_operator(SharedMatrix Aoo, SharedMatrix Aoc, SharedMatrix Acc);
+    // Form the 3C(FIX) correction and the OBS-CABS coupling
+    void form_f12_energy();
+    // Print the F12 energies
+    void print_f12_energies();
+
+   public:
+    RDFMP2F12(SharedWavefunction ref_wfn, Options& options, std::shared_ptr<PSIO> psio);
+    ~RDFMP2F12() override;
+
+    double compute_energy() override;
+};
+
+}  // namespace dfmp2
+}  // namespace psi
+
+#endif
@@ -56,6 +56,9 @@
 
 #include "corr_grad.h"
 
+#include <future>
+#include <utility>
+
 namespace psi {
 namespace dfmp2 {
 
@@ -181,6 +184,7 @@ void DFMP2::common_init() {
 
     sss_ = options_.get_double("MP2_SS_SCALE");
     oss_ = options_.get_double("MP2_OS_SCALE");
+    laplace_ = options_.get_bool("DFMP2_LAPLACE");
 
     ribasis_ = get_basisset("DF_BASIS_MP2");
 }
@@ -195,8 +199,8 @@ double DFMP2::compute_energy() {
         variables_["MP2 OPPOSITE-SPIN CORRELATION ENERGY"] = 0.0;
         variables_["MP2 CORRELATION ENERGY"] = 0.0;
         print_energies();
-        energy_ = variables_["MP2 TOTAL ENERGY"];
-        return variables_["MP2 TOTAL ENERGY"];
+        energy_ = variables_[(laplace_ ? "CUSTOM SCS-MP2 TOTAL ENERGY" : "MP2 TOTAL ENERGY")];
+        return energy_;
     }
     timer_on("DFMP2 Singles");
     form_singles();
@@ -208,14 +212,19 @@ double DFMP2::compute_energy() {
     form_Bia();
     timer_off("DFMP2 Bia");
     timer_on("DFMP2 Energy");
-    form_energy();
+    if (laplace_) {
+        form_laplace_energy();
+    } else {
+        form_energy();
+    }
     timer_off("DFMP2 Energy");
     print_energies();
-    energy_ = variables_["MP2 TOTAL ENERGY"];
+    energy_ = variables_[(laplace_ ? "CUSTOM SCS-MP2 TOTAL ENERGY" : "MP2 TOTAL ENERGY")];
 
-    return variables_["MP2 TOTAL ENERGY"];
+    return energy_;
 }
 SharedMatrix DFMP2::compute_gradient() {
+    if (laplace_) throw PSIEXCEPTION("DFMP2: Analytic gradients are not available with DFMP2_LAPLACE.");
     print_header();
 
     if (Ca_subset("AO", "ACTIVE_OCC")->colspi()[0] == 0) {
@@ -314,6 +323,9 @@ SharedMatrix DFMP2::compute_gradient() {
 
     return gradients_["Total"];
 }
+void DFMP2::form_laplace_energy() {
+    throw PSIEXCEPTION("DFMP2: Laplace-transformed SOS-MP2 is only available for RHF references.");
+}
 void DFMP2::form_singles() {
     double E_singles_a = 0.0;
     double E_singles_b = 0.0;
@@ -714,6 +726,32 @@ void DFMP2::apply_B_transpose(size_t file, size_t naux, size_t naocc, size_t nav
     psio_->close(file, 1);
 }
 void DFMP2::print_energies() {
+    if (laplace_) {
+        // Only the opposite-spin term was formed
+        variables_["SOS-MP2 CORRELATION ENERGY"] = 1.3 * variables_["MP2 OPPOSITE-SPIN CORRELATION ENERGY"] +
+                                                   variables_["MP2 SINGLES ENERGY"];
+        variables_["SOS-MP2 TOTAL ENERGY"] = variables_["SCF TOTAL ENERGY"] + variables_["SOS-MP2 CORRELATION ENERGY"];
+        variables_["CUSTOM SCS-MP2 CORRELATION ENERGY"] = oss_ * variables_["MP2 OPPOSITE-SPIN CORRELATION ENERGY"] +
+                                                          variables_["MP2 SINGLES ENERGY"];
+        variables_["CUSTOM SCS-MP2 TOTAL ENERGY"] = variables_["SCF TOTAL ENERGY"] + variables_["CUSTOM SCS-MP2 CORRELATION ENERGY"];
+
+        outfile->Printf("\t-----------------------------------------------------------\n");
+        outfile->Printf("\t ===============> DF-SOS-MP2 Energies <=================== \n");
+        outfile->Printf("\t-----------------------------------------------------------\n");
+        outfile->Printf("\t %-25s = %24.16f [Eh]\n", "Reference Energy", variables_["SCF TOTAL ENERGY"]);
+        outfile->Printf("\t %-25s = %24.16f [Eh]\n", "Singles Energy", variables_["MP2 SINGLES ENERGY"]);
+        outfile->Printf("\t %-25s = %24.16f [Eh]\n", "Opposite-Spin Energy",
+                        variables_["MP2 OPPOSITE-SPIN CORRELATION ENERGY"]);
+        outfile->Printf("\t %-25s = %24.16f [-]\n", "SCS Opposite-Spin Scale", oss_);
+        outfile->Printf("\t %-25s = %24.16f [Eh]\n", "SCS Correlation Energy",
+                        variables_["CUSTOM SCS-MP2 CORRELATION ENERGY"]);
+        outfile->Printf("\t %-25s = %24.16f [Eh]\n", "SCS Total Energy", variables_["CUSTOM SCS-MP2 TOTAL ENERGY"]);
+        outfile->Printf("\t %-25s = %24.16f [Eh]\n", "SOS Total Energy", variables_["SOS-MP2 TOTAL ENERGY"]);
+        outfile->Printf("\t-----------------------------------------------------------\n");
+        outfile->Printf("\n");
+        return;
+    }
+
     variables_["MP2 DOUBLES ENERGY"] = variables_["MP2 OPPOSITE-SPIN CORRELATION ENERGY"] +
                                        variables_["MP2 SAME-SPIN CORRELATION ENERGY"];
     variables_["MP2 CORRELATION ENERGY"] = variables_["MP2 OPPOSITE-SPIN CORRELATION ENERGY"] +
@@ -1007,7 +1045,8 @@ void RDFMP2::form_energy() {
         throw PSIEXCEPTION("DFMP2: Insufficient memory for Iab buffers. Reduce OMP Threads or increase memory.");
     }
     size_t remainder = doubles - nthread * Iab_memory;
-    size_t max_i = remainder / (2L * Qa_memory);
+    // Two (ia|Q) and two (jb|Q) buffers, so the next block pair is read while this one is contracted
+    size_t max_i = remainder / (4L * Qa_memory);
     max_i = (max_i > naocc ? naocc : max_i);
     max_i = (max_i < 1L ? 1L : max_i);
 
@@ -1024,10 +1063,12 @@ void RDFMP2::form_energy() {
     // block_status(i_starts, __FILE__,__LINE__);
 
     // Tensor blocks
-    auto Bia = std::make_shared<Matrix>("B(ia|Q)", max_i * (size_t)navir, naux);
-    auto Bjb = std::make_shared<Matrix>("B(jb|Q)", max_i * (size_t)navir, naux);
-    double** Biap = Bia->pointer();
-    double** Bjbp = Bjb->pointer();
+    std::vector<SharedMatrix> Bia;
+    std::vector<SharedMatrix> Bjb;
+    for (int slot = 0; slot < 2; slot++) {
+        Bia.push_back(std::make_shared<Matrix>("B(ia|Q)", max_i * (size_t)navir, naux));
+        Bjb.push_back(std::make_shared<Matrix>("B(jb|Q)", max_i * (size_t)navir, naux));
+    }
 
     std::vector<SharedMatrix> Iab;
     for (int i = 0; i < nthread; i++) {
@@ -1037,76 +1078,194 @@ void RDFMP2::form_energy() {
     double* eps_aoccp = eps_aocc_->pointer();
     double* eps_avirp = eps_avir_->pointer();
 
+    // Unique pairs of blocks, row by row
+    std::vector<std::pair<int, int>> block_pairs;
+    for (int block_i = 0; block_i < i_starts.size() - 1; block_i++) {
+        for (int block_j = 0; block_j <= block_i; block_j++) {
+            block_pairs.push_back(std::make_pair(block_i, block_j));
+        }
+    }
+
+    // The i block of row block_i lives in Bia[block_i % 2], the j block of pair k in Bjb[k % 2]
+    auto read_block = [&](SharedMatrix B, size_t start, size_t n) {
+        psio_address next_BIA = psio_get_address(PSIO_ZERO, sizeof(double) * (start * navir * naux));
+        psio_->read(PSIF_DFMP2_AIA, "B(ia|Q)", (char*)B->pointer()[0], sizeof(double) * (n * navir * naux), next_BIA,
+                    &next_BIA);
+    };
+    auto read_pair = [&](size_t k) {
+        int block_i = block_pairs[k].first;
+        int block_j = block_pairs[k].second;
+        if (k == 0 || block_pairs[k - 1].first != block_i) {
+            read_block(Bia[block_i % 2], i_starts[block_i], i_starts[block_i + 1] - i_starts[block_i]);
+        }
+        if (block_i != block_j) {
+            read_block(Bjb[k % 2], i_starts[block_j], i_starts[block_j + 1] - i_starts[block_j]);
+        }
+    };
+
     // Loop through pairs of blocks
     psio_->open(PSIF_DFMP2_AIA, PSIO_OPEN_OLD);
-    psio_address next_BIA = PSIO_ZERO;
-    for (int block_i = 0; block_i < i_starts.size() - 1; block_i++) {
+    std::future<void> prefetch;
+    for (size_t k = 0; k < block_pairs.size(); k++) {
+        int block_i = block_pairs[k].first;
+        int block_j = block_pairs[k].second;
+
         // Sizing
         size_t istart = i_starts[block_i];
         size_t istop = i_starts[block_i + 1];
         size_t ni = istop - istart;
+        size_t jstart = i_starts[block_j];
+        size_t jstop = i_starts[block_j + 1];
+        size_t nj = jstop - jstart;
 
-        // Read iaQ chunk
+        // Wait for this pair's blocks, then start on the next pair's
         timer_on("DFMP2 Bia Read");
-        next_BIA = psio_get_address(PSIO_ZERO, sizeof(double) * (istart * navir * naux));
-        psio_->read(PSIF_DFMP2_AIA, "B(ia|Q)", (char*)Biap[0], sizeof(double) * (ni * navir * naux), next_BIA,
-                    &next_BIA);
+        if (k == 0) {
+            read_pair(k);
+        } else {
+            prefetch.get();
+        }
         timer_off("DFMP2 Bia Read");
+        if (k + 1 < block_pairs.size()) {
+            prefetch = std::async(std::launch::async, read_pair, k + 1);
+        }
 
-        for (int block_j = 0; block_j <= block_i; block_j++) {
+        double** Biap = Bia[block_i % 2]->pointer();
+        double** Bjbp = (block_i == block_j ? Biap : Bjb[k % 2]->pointer());
+
+#pragma omp parallel for schedule(dynamic) num_threads(nthread) reduction(+ : e_ss, e_os)
+        for (long int ij = 0L; ij < ni * nj; ij++) {
             // Sizing
-            size_t jstart = i_starts[block_j];
-            size_t jstop = i_starts[block_j + 1];
-            size_t nj = jstop - jstart;
+            size_t i = ij / nj + istart;
+            size_t j = ij % nj + jstart;
+            if (j > i) continue;
 
-            // Read iaQ chunk (if unique)
-            timer_on("DFMP2 Bia Read");
-            if (block_i == block_j) {
-                ::memcpy((void*)Bjbp[0], (void*)Biap[0], sizeof(double) * (ni * navir * naux));
-            } else {
-                next_BIA = psio_get_address(PSIO_ZERO, sizeof(double) * (jstart * navir * naux));
-                psio_->read(PSIF_DFMP2_AIA, "B(ia|Q)", (char*)Bjbp[0], sizeof(double) * (nj * navir * naux), next_BIA,
-                            &next_BIA);
-            }
-            timer_off("DFMP2 Bia Read");
+            double perm_factor = (i == j ? 1.0 : 2.0);
 
-#pragma omp parallel for schedule(dynamic) num_threads(nthread) reduction(+ : e_ss, e_os)
-            for (long int ij = 0L; ij < ni * nj; ij++) {
-                // Sizing
-                size_t i = ij / nj + istart;
-                size_t j = ij % nj + jstart;
-                if (j > i) continue;
+            // Which thread is this?
+            int thread = 0;
+#ifdef _OPENMP
+            thread = omp_get_thread_num();
+#endif
+            double** Iabp = Iab[thread]->pointer();
+
+            // Form the integral block (ia|jb) = (ia|Q)(Q|jb)
+            C_DGEMM('N', 'T', navir, navir, naux, 1.0, Biap[(i - istart) * navir], naux, Bjbp[(j - jstart) * navir],
+                    naux, 0.0, Iabp[0], navir);
+
+            // Add the MP2 energy contributions
+            for (int a = 0; a < navir; a++) {
+                for (int b = 0; b < navir; b++) {
+                    double iajb = Iabp[a][b];
+                    double ibja = Iabp[b][a];
+                    double denom = -perm_factor / (eps_avirp[a] + eps_avirp[b] - eps_aoccp[i] - eps_aoccp[j]);
+
+                    e_ss += (iajb * iajb - iajb * ibja) * denom;
+                    e_os += (iajb * iajb) * denom;
+                }
+            }
+        }
+    }
+    psio_->close(PSIF_DFMP2_AIA, 0);
 
-                double perm_factor = (i == j ? 1.0 : 2.0);
+    variables_["MP2 SAME-SPIN CORRELATION ENERGY"] = e_ss;
+    variables_["MP2 OPPOSITE-SPIN CORRELATION ENERGY"] = e_os;
+}
+void RDFMP2::form_laplace_energy() {
+    // Sizing
+    size_t naux = ribasis_->nbf();
+    size_t naocc = Caocc_->colspi()[0];
+    size_t navir = Cavir_->colspi()[0];
+    size_t nia = naocc * navir;
 
-                // Which thread is this?
-                int thread = 0;
+    // Thread considerations
+    int nthread = 1;
 #ifdef _OPENMP
-                thread = omp_get_thread_num();
+    nthread = Process::environment.get_n_threads();
 #endif
-                double** Iabp = Iab[thread]->pointer();
 
-                // Form the integral block (ia|jb) = (ia|Q)(Q|jb)
-                C_DGEMM('N', 'T', navir, navir, naux, 1.0, Biap[(i - istart) * navir], naux, Bjbp[(j - jstart) * navir],
-                        naux, 0.0, Iabp[0], navir);
+    // Denominator factorization 1 / (e_a + e_b - e_i - e_j) = sum_w tau^w_ia tau^w_jb
+    std::shared_ptr<Denominator> denom =
+        Denominator::buildDenominator(options_.get_str("DFMP2_DENOMINATOR_ALGORITHM"), eps_aocc_, eps_avir_,
+                                      options_.get_double("DFMP2_DENOMINATOR_DELTA"));
+    size_t nw = denom->nvector();
+    double** taup = denom->denominator()->pointer();
 
-                // Add the MP2 energy contributions
-                for (int a = 0; a < navir; a++) {
-                    for (int b = 0; b < navir; b++) {
-                        double iajb = Iabp[a][b];
-                        double ibja = Iabp[b][a];
-                        double denom = -perm_factor / (eps_avirp[a] + eps_avirp[b] - eps_aoccp[i] - eps_aoccp[j]);
+    // Memory: a batch of X^w_PQ, then a block of B(ia|Q) and the thread-blocked tau-scaled copy
+    size_t doubles = ((size_t)(options_.get_double("DFMP2_MEM_FACTOR") * memory_ / 8L));
+    size_t X_memory = naux * naux;
+    if (doubles < X_memory + 2L * naux) {
+        throw PSIEXCEPTION("DFMP2: Insufficient memory for Laplace X^w_PQ intermediates. Increase memory.");
+    }
+    size_t max_w = (doubles / 2L) / X_memory;
+    max_w = (max_w > nw ? nw : max_w);
+    max_w = (max_w < 1L ? 1L : max_w);
+    size_t max_ia = (doubles - max_w * X_memory) / (2L * naux);
+    max_ia = (max_ia > nia ? nia : max_ia);
 
-                        e_ss += (iajb * iajb - iajb * ibja) * denom;
-                        e_os += (iajb * iajb) * denom;
+    // Q blocks, one per thread
+    size_t Q_per_thread = (naux + nthread - 1) / nthread;
+    std::vector<size_t> Q_starts;
+    for (size_t Q = 0; Q < naux; Q += Q_per_thread) Q_starts.push_back(Q);
+    Q_starts.push_back(naux);
+
+    outfile->Printf("\t => Laplace SOS-MP2: %zu quadrature points, %zu per pass, %zu ia per block <=\n\n", nw, max_w,
+                    max_ia);
+
+    // Tensor blocks
+    auto Bia = std::make_shared<Matrix>("B(ia|Q)", max_ia, naux);
+    auto Tia = std::make_shared<Matrix>("tau B(ia|Q)", max_ia, naux);
+    double** Biap = Bia->pointer();
+    double* Tiap = Tia->pointer()[0];
+
+    std::vector<SharedMatrix> X;
+    for (size_t w = 0; w < max_w; w++) {
+        X.push_back(std::make_shared<Matrix>("X^w", naux, naux));
+    }
+
+    double e_os = 0.0;
+
+    psio_->open(PSIF_DFMP2_AIA, PSIO_OPEN_OLD);
+    for (size_t wstart = 0; wstart < nw; wstart += max_w) {
+        size_t nwblock = (wstart + max_w > nw ? nw - wstart : max_w);
+        for (size_t w = 0; w < nwblock; w++) X[w]->zero();
+
+        for (size_t iastart = 0; iastart < nia; iastart += max_ia) {
+            size_t nblock = (iastart + max_ia > nia ? nia - iastart : max_ia);
+
+            timer_on("DFMP2 Bia Read");
+            psio_address next_BIA = psio_get_address(PSIO_ZERO, sizeof(double) * (iastart * naux));
+            psio_->read(PSIF_DFMP2_AIA, "B(ia|Q)", (char*)Biap[0], sizeof(double) * (nblock * naux), next_BIA,
+                        &next_BIA);
+            timer_off("DFMP2 Bia Read");
+
+            for (size_t w = 0; w < nwblock; w++) {
+                double* tauwp = &taup[wstart + w][iastart];
+                double** Xp = X[w]->pointer();
+
+                // X^w_PQ += sum_ia tau^w_ia B_iaP B_iaQ, each thread owning a slab of P
+#pragma omp parallel for schedule(static) num_threads(nthread)
+                for (size_t block = 0; block < Q_starts.size() - 1; block++) {
+                    size_t Pstart = Q_starts[block];
+                    size_t nP = Q_starts[block + 1] - Pstart;
+                    double* Tp = &Tiap[Pstart * nblock];
+                    for (size_t ia = 0; ia < nblock; ia++) {
+                        for (size_t P = 0; P < nP; P++) {
+                            Tp[ia * nP + P] = tauwp[ia] * Biap[ia][Pstart + P];
+                        }
                     }
+                    C_DGEMM('T', 'N', nP, naux, nblock, 1.0, Tp, nP, Biap[0], naux, 1.0, Xp[Pstart], naux);
                 }
             }
         }
+
+        // E_os = - sum_w sum_PQ X^w_PQ X^w_PQ
+        for (size_t w = 0; w < nwblock; w++) {
+            e_os -= C_DDOT(X_memory, X[w]->pointer()[0], 1, X[w]->pointer()[0], 1);
+        }
     }
     psio_->close(PSIF_DFMP2_AIA, 0);
 
-    variables_["MP2 SAME-SPIN CORRELATION ENERGY"] = e_ss;
     variables_["MP2 OPPOSITE-SPIN CORRELATION ENERGY"] = e_os;
 }
 void RDFMP2::form_Pab() {
@@ -1129,7 +1288,8 @@ void RDFMP2::form_Pab() {
     size_t doubles = static_cast<size_t>(options_.get_double("DFMP2_MEM_FACTOR") * memory_ / 8L);
     doubles -= static_cast<double>(navir) * static_cast<double>(navir);
     double C = -(double)doubles;
-    double B = 4.0 * navir * naux;
+    // Two B(jb|Q) and C(jb|Q) buffers, so the next j block is read while this one is contracted
+    double B = 6.0 * navir * naux;
     double A = 2.0 * navir * (double)navir;
 
     int max_i = (int)((-B + sqrt(B * B - 4.0 * A * C)) / (2.0 * A));
@@ -1157,14 +1317,16 @@ void RDFMP2::form_Pab() {
 
     // 3-Index Tensor blocks
     auto Bia = std::make_shared<Matrix>("B(ia|Q)", max_i * (size_t)navir, naux);
-    auto Bjb = std::make_shared<Matrix>("B(jb|Q)", max_i * (size_t)navir, naux);
     auto Gia = std::make_shared<Matrix>("Gia", max_i * (size_t)navir, naux);
-    auto Cjb = std::make_shared<Matrix>("C(jb|Q)", max_i * (size_t)navir, naux);
+    std::vector<SharedMatrix> Bjb;
+    std::vector<SharedMatrix> Cjb;
+    for (int slot = 0; slot < 2; slot++) {
+        Bjb.push_back(std::make_shared<Matrix>("B(jb|Q)", max_i * (size_t)navir, naux));
+        Cjb.push_back(std::make_shared<Matrix>("C(jb|Q)", max_i * (size_t)navir, naux));
+    }
 
     auto Biap = Bia->pointer();
-    auto Bjbp = Bjb->pointer();
     auto Giap = Gia->pointer();
-    auto Cjbp = Cjb->pointer();
 
     // 4-index Tensor blocks
     auto I = std::make_shared<Matrix>("I", max_i * (size_t)navir, max_i * (size_t)navir);
@@ -1177,9 +1339,26 @@ void RDFMP2::form_Pab() {
     auto eps_aoccp = eps_aocc_->pointer();
     auto eps_avirp = eps_avir_->pointer();
 
+    // The j block of the i block row lives in slot block_j % 2; B(jb|Q) is only read if it is not the i block
+    auto read_j = [&](int block_i, int block_j) {
+        size_t jstart = i_starts[block_j];
+        size_t nj = i_starts[block_j + 1] - jstart;
+        int slot = block_j % 2;
+        psio_address next_QJB;
+        if (block_i != block_j) {
+            next_QJB = psio_get_address(PSIO_ZERO, sizeof(double) * (jstart * navir * naux));
+            psio_->read(PSIF_DFMP2_AIA, "B(ia|Q)", (char*)Bjb[slot]->pointer()[0], sizeof(double) * (nj * navir * naux),
+                        next_QJB, &next_QJB);
+        }
+        next_QJB = psio_get_address(PSIO_ZERO, sizeof(double) * (jstart * navir * naux));
+        psio_->read(PSIF_DFMP2_AIA, "C(ia|Q)", (char*)Cjb[slot]->pointer()[0], sizeof(double) * (nj * navir * naux),
+                    next_QJB, &next_QJB);
+    };
+
     // Loop through pairs of blocks
     psio_address next_QIA = PSIO_ZERO;
     psio_->open(PSIF_DFMP2_AIA, PSIO_OPEN_OLD);
+    std::future<void> prefetch;
     for (int block_i = 0; block_i < i_starts.size() - 1; block_i++) {
         // Sizing
         size_t istart = i_starts[block_i];
@@ -1202,23 +1381,20 @@ void RDFMP2::form_Pab() {
             size_t jstop = i_starts[block_j + 1];
             size_t nj = jstop - jstart;
 
-            // Read iaQ chunk (if unique)
-            timer_on("DFMP2 Bia Read");
-            if (block_i == block_j) {
-                ::memcpy((void*)Bjbp[0], (void*)Biap[0], sizeof(double) * (ni * navir * naux));
+            // Wait for this j block, then start on the next one of the row
+            timer_on("DFMP2 Cia Read");
+            if (block_j == 0) {
+                read_j(block_i, block_j);
             } else {
-                next_QIA = psio_get_address(PSIO_ZERO, sizeof(double) * (jstart * navir * naux));
-                psio_->read(PSIF_DFMP2_AIA, "B(ia|Q)", (char*)Bjbp[0], sizeof(double) * (nj * navir * naux), next_QIA,
-                            &next_QIA);
+                prefetch.get();
             }
-            timer_off("DFMP2 Bia Read");
-
-            // Read iaC chunk
-            timer_on("DFMP2 Cia Read");
-            next_QIA = psio_get_address(PSIO_ZERO, sizeof(double) * (jstart * navir * naux));
-            psio_->read(PSIF_DFMP2_AIA, "C(ia|Q)", (char*)Cjbp[0], sizeof(double) * (nj * navir * naux), next_QIA,
-                        &next_QIA);
             timer_off("DFMP2 Cia Read");
+            if (block_j + 1 < i_starts.size() - 1) {
+                prefetch = std::async(std::launch::async, read_j, block_i, block_j + 1);
+            }
+
+            double** Bjbp = (block_i == block_j ? Biap : Bjb[block_j % 2]->pointer());
+            double** Cjbp = Cjb[block_j % 2]->pointer();
 
             // Form the integrals (ia|jb) = B_ia^Q B_jb^Q
             timer_on("DFMP2 I");
@@ -1325,7 +1501,8 @@ void RDFMP2::form_Pij() {
     size_t doubles = static_cast<size_t>(options_.get_double("DFMP2_MEM_FACTOR") * memory_ / 8L);
     doubles -= naocc * naocc;
     double C = -(double)doubles;
-    double B = 2.0 * naocc * naux;
+    // Two B(bj|Q) buffers, so the next b block is read while this one is contracted
+    double B = 3.0 * naocc * naux;
     double A = 2.0 * naocc * (double)naocc;
 
     int max_a = (int)((-B + sqrt(B * B - 4.0 * A * C)) / (2.0 * A));
@@ -1353,10 +1530,12 @@ void RDFMP2::form_Pij() {
 
     // 3-Index Tensor blocks
     auto Bia = std::make_shared<Matrix>("B(ia|Q)", max_a * (size_t)naocc, naux);
-    auto Bjb = std::make_shared<Matrix>("B(jb|Q)", max_a * (size_t)naocc, naux);
+    std::vector<SharedMatrix> Bjb;
+    for (int slot = 0; slot < 2; slot++) {
+        Bjb.push_back(std::make_shared<Matrix>("B(jb|Q)", max_a * (size_t)naocc, naux));
+    }
 
     auto Biap = Bia->pointer();
-    auto Bjbp = Bjb->pointer();
 
     // 4-index Tensor blocks
     auto I = std::make_shared<Matrix>("I", max_a * (size_t)naocc, max_a * (size_t)naocc);
@@ -1369,9 +1548,20 @@ void RDFMP2::form_Pij() {
     auto eps_aoccp = eps_aocc_->pointer();
     auto eps_avirp = eps_avir_->pointer();
 
+    // Off-diagonal b blocks of an a block row alternate between the two buffers, skipping the a block itself
+    auto slot_of = [](int block_a, int block_b) { return (block_b < block_a ? block_b : block_b - 1) % 2; };
+    auto read_b = [&](int block_b, int slot) {
+        size_t bstart = a_starts[block_b];
+        size_t nb = a_starts[block_b + 1] - bstart;
+        psio_address next_BBJ = psio_get_address(PSIO_ZERO, sizeof(double) * (bstart * naocc * naux));
+        psio_->read(PSIF_DFMP2_AIA, "B(ai|Q)", (char*)Bjb[slot]->pointer()[0],
+                    sizeof(double) * (nb * naocc * naux), next_BBJ, &next_BBJ);
+    };
+
     // Loop through pairs of blocks
     psio_address next_BAI = PSIO_ZERO;
     psio_->open(PSIF_DFMP2_AIA, PSIO_OPEN_OLD);
+    std::future<void> prefetch;
     for (int block_a = 0; block_a < a_starts.size() - 1; block_a++) {
         // Sizing
         size_t astart = a_starts[block_a];
@@ -1391,16 +1581,22 @@ void RDFMP2::form_Pij() {
             size_t bstop = a_starts[block_b + 1];
             size_t nb = bstop - bstart;
 
-            // Read iaQ chunk (if unique)
+            // Wait for this b block, then start on the next one of the row that is not the a block
             timer_on("DFMP2 Qai Read");
-            if (block_a == block_b) {
-                ::memcpy((void*)Bjbp[0], (void*)Biap[0], sizeof(double) * (na * naocc * naux));
-            } else {
-                next_BAI = psio_get_address(PSIO_ZERO, sizeof(double) * (bstart * naocc * naux));
-                psio_->read(PSIF_DFMP2_AIA, "B(ai|Q)", (char*)Bjbp[0], sizeof(double) * (nb * naocc * naux), next_BAI,
-                            &next_BAI);
+            if (block_b != block_a) {
+                if (prefetch.valid()) {
+                    prefetch.get();
+                } else {
+                    read_b(block_b, slot_of(block_a, block_b));
+                }
             }
             timer_off("DFMP2 Qai Read");
+            int next_b = (block_b + 1 == block_a ? block_b + 2 : block_b + 1);
+            if (next_b < a_starts.size() - 1) {
+                prefetch = std::async(std::launch::async, read_b, next_b, slot_of(block_a, next_b));
+            }
+
+            double** Bjbp = (block_a == block_b ? Biap : Bjb[slot_of(block_a, block_b)]->pointer());
 
             // Form the integrals (ia|jb) = B_ia^Q B_jb^Q
             timer_on("DFMP2 I");
@@ -1770,8 +1966,6 @@ void RDFMP2::form_L() {
     auto Caoccp = Caocc_->pointer();
     auto Cavirp = Cavir_->pointer();
 
-    std::vector<double> temp(naocc * navir);
-
     // => Targets <= //
 
     auto Lmi = std::make_shared<Matrix>("L_ma", nso, naocc);
@@ -1851,8 +2045,9 @@ void RDFMP2::form_L() {
         C_DGEMM('T', 'N', nso, navir, naocc * (size_t)np, 1.0, Gimp[0], nso, Giap[0], navir, 1.0, Lmap[0], navir);
 
         // Sort G_P^ia to G_P^ai
+#pragma omp parallel for
         for (int p = 0; p < np; p++) {
-            ::memcpy((void*)temp.data(), (void*)Giap[p], sizeof(double) * naocc * navir);
+            std::vector<double> temp(Giap[p], Giap[p] + naocc * (size_t)navir);
             for (int i = 0; i < naocc; i++) {
                 C_DCOPY(navir, &temp[i * navir], 1, &Giap[p][i], naocc);
             }
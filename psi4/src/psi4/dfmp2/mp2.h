@@ -51,6 +51,8 @@ class DFMP2 : public Wavefunction {
     double sss_;
     // Opposite-spin scale
     double oss_;
+    // Laplace-transformed opposite-spin-only energy?
+    bool laplace_;
 
     void common_init();
     // Common printing of energies/SCS
@@ -69,6 +71,8 @@ class DFMP2 : public Wavefunction {
     virtual void form_Bia_transpose() = 0;
     // Form the energy contributions
     virtual void form_energy() = 0;
+    // Form the opposite-spin energy by Laplace quadrature of the denominator
+    virtual void form_laplace_energy();
     // Form the VV block of the correlation OPDM (DiStasio 8) and Gamma_ia^Q (DiStasio 2)
     virtual void form_Pab() = 0;
     // Form the OO block of the correlation OPDM (DiStasio 7)
@@ -147,6 +151,8 @@ class RDFMP2 : public DFMP2 {
     void form_Bia_transpose() override;
     // Form the energy contributions
     void form_energy() override;
+    // Form the opposite-spin energy E_os = - sum_w X^w_PQ X^w_PQ, X^w_PQ = (Q|ia) tau^w_ia (ia|P)
+    void form_laplace_energy() override;
     // Form the energy contributions and gradients
     void form_Pab() override;
     // Form the energy contributions and gradients
@@ -45,6 +45,7 @@
 #include "psi4/psi4-dec.h"
 
 #include "mp2.h"
+#include "f12.h"
 
 namespace psi {
 namespace dfmp2 {
@@ -65,5 +66,15 @@ SharedWavefunction dfmp2(SharedWavefunction ref_wfn, Options& options) {
 
     return dfmp2;
 }
+
+SharedWavefunction dfmp2_f12(SharedWavefunction ref_wfn, Options& options) {
+    auto psio = std::make_shared<PSIO>();
+
+    if (options.get_str("REFERENCE") != "RHF") {
+        throw PSIEXCEPTION("DF-MP2-F12: Only RHF references are supported");
+    }
+
+    return std::make_shared<RDFMP2F12>(ref_wfn, options, psio);
+}
 }  // namespace dfmp2
 }  // namespace psi
@@ -130,8 +130,24 @@ void DFOCC::cd_ints() {
 
     // Cholesky
 
-    // read integrals from disk if they were generated in the SCF
-    if (options_.get_str("SCF_TYPE") == "CD") {
+    // read integrals from disk if they were generated in the SCF, for this basis and threshold
+    bool read_scf_cd = false;
+    if (options_.get_str("SCF_TYPE") == "CD" && psio_->exists(PSIF_DFSCF_BJ)) {
+        psio_->open(PSIF_DFSCF_BJ, PSIO_OPEN_OLD);
+        if (psio_->tocentry_exists(PSIF_DFSCF_BJ, "Cholesky Signature")) {
+            double signature[3];
+            psio_->read_entry(PSIF_DFSCF_BJ, "Cholesky Signature", (char*)signature, sizeof(signature));
+            read_scf_cd = signature[0] == options_.get_double("CHOLESKY_TOLERANCE") && signature[1] == nso_ &&
+                          signature[2] == ntri_cd;
+        } else {
+            // Written before signatures were recorded; trust it as before
+            read_scf_cd = psio_->tocentry_exists(PSIF_DFSCF_BJ, "length");
+        }
+        psio_->close(PSIF_DFSCF_BJ, 1);
+        if (!read_scf_cd) outfile->Printf("\tCholesky vectors of the SCF do not apply here; decomposing again.\n");
+    }
+
+    if (read_scf_cd) {
         outfile->Printf("\tReading Cholesky vectors from disk ...\n");
 
         // ntri comes from sieve above
@@ -159,7 +175,7 @@ void DFOCC::cd_ints() {
             }
         }
         bQso->write(psio_, PSIF_DFOCC_INTS, true, true);
-    }  // end if ( options_.get_str("SCF_TYPE") == "CD" )
+    }  // end if (read_scf_cd)
 
     else {
         // generate Cholesky 3-index integrals
@@ -56,6 +56,7 @@ void DFOCC::common_init() {
     cc_maxiter = options_.get_int("CC_MAXITER");
     mo_maxiter = options_.get_int("MO_MAXITER");
     num_vecs = options_.get_int("MO_DIIS_NUM_VECS");
+    lbfgs_nvec = options_.get_int("MO_LBFGS_NUM_VECS");
     cc_maxdiis_ = options_.get_int("CC_DIIS_MAX_VECS");
     cc_mindiis_ = options_.get_int("CC_DIIS_MIN_VECS");
     exp_cutoff = options_.get_int("CUTOFF");
@@ -106,6 +107,7 @@ void DFOCC::common_init() {
     cc_lambda_ = options_.get_str("CC_LAMBDA");
     Wabef_type_ = options_.get_str("PPL_TYPE");
     triples_iabc_type_ = options_.get_str("TRIPLES_IABC_TYPE");
+    do_triples_direct = false;
     do_cd = options_.get_str("CHOLESKY");
 
     if ((dertype == "FIRST" || orb_opt_ == "TRUE" || wfn_type_ == "DF-CCSD(AT)") && cc_lambda_ == "FALSE") {
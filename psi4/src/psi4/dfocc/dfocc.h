@@ -98,6 +98,7 @@ class DFOCC : public Wavefunction {
     void orb_resp_pcg_rhf();
     void orb_resp_pcg_uhf();
     void kappa_diag_hess();
+    void kappa_lbfgs();
     void kappa_qchf();
     void update_mo();
     void update_hfmo();
@@ -150,6 +151,12 @@ class DFOCC : public Wavefunction {
               SharedTensor1d &errvec_new);
     void sigma_rhf(SharedTensor1d &sigma, SharedTensor1d &p_vec);
     void sigma_uhf(SharedTensor1d &sigma_A, SharedTensor1d &sigma_B, SharedTensor1d &p_vecA, SharedTensor1d &p_vecB);
+    void pcg_ints_init();
+    void pcg_ints_clear();
+    void pcg_precond(SharedTensor1d &Minv, bool alpha, int offset, double shift);
+    SharedTensor2d pcg_bQvo(bool alpha);
+    SharedTensor2d pcg_bQoo(bool alpha);
+    SharedTensor2d pcg_bQvv(bool alpha);
     void sigma_orb_resp_rhf(SharedTensor1d &sigma, SharedTensor1d &p_vec);
     void build_rhf_mohess(SharedTensor2d &Aorb_);
     void build_uhf_mohess(SharedTensor2d &Aorb_);
@@ -544,8 +551,13 @@ class DFOCC : public Wavefunction {
 
     // UHF-CCSD(T)
     void uccsd_triples_hm();
+    void uccsd_triples_lm();
     void uccsdl_triples_hm();
+    void uccsdl_triples_lm();
     void uccsd_triples_grad_hm();
+    void uccsd_iabc_direct_init();
+    void uccsd_iabc_direct_clear();
+    void uccsd_iabc_block(int fileno, long int i, SharedTensor2d &G);
 
     // Lambda-CCSD(T)
     void ccsdl_canonic_triples_disk();
@@ -729,6 +741,7 @@ class DFOCC : public Wavefunction {
     int mo_maxiter;
     int pcg_maxiter;
     int num_vecs;  // Number of vectors used in diis (diis order)
+    int lbfgs_nvec;  // Number of curvature pairs kept by the L-BFGS orbital step
     int do_diis_;
     int itr_diis;
     int itr_occ;
@@ -754,6 +767,8 @@ class DFOCC : public Wavefunction {
     double cost_5amp;
     double cost_ppl_hm;        // Mem req. for high mem evaluation of 4-virtuals exchange term
     double cost_triples_iabc;  // Mem req. for high mem evaluation of (ia|bc) used in (T)
+    int nQ_iabc;               // # of DF_BASIS_CC functions per batch of (Q|ab) for direct UHF-(T) (ia|bc)
+    int nbatch_iabc;           // # of (Q|ab) batches for direct UHF-(T) (ia|bc)
 
     // Common
     double Enuc;
@@ -930,6 +945,7 @@ class DFOCC : public Wavefunction {
     bool t2_incore;
     bool do_ppl_hm;
     bool do_triples_hm;
+    bool do_triples_direct;  // form UHF-(T) <ia||bc> on the fly rather than reading it from disk
 
     double **C_pitzerA;
     double **C_pitzerB;
@@ -1002,6 +1018,10 @@ class DFOCC : public Wavefunction {
     SharedTensor2d bQiaB;   // b(Q|i a) : active
     SharedTensor2d bQabA;   // b(Q|a b) : active
     SharedTensor2d bQabB;   // b(Q|a b) : active
+    SharedTensor2d biaQA_iabc;  // b(i a|Q) : active, for direct UHF-(T)
+    SharedTensor2d biaQB_iabc;  // b(i a|Q) : active, for direct UHF-(T)
+    SharedTensor2d bQabA_iabc;  // b(Q|a>=b) : active, in core for direct UHF-(T) if it fits
+    SharedTensor2d bQabB_iabc;  // b(Q|a>=b) : active, in core for direct UHF-(T) if it fits
 
     SharedTensor2d cQso;   // c(Q|mu nu) from DF_BASIS_CC (RI)
     SharedTensor2d cQnoA;  // c(Q|mu i)
@@ -1174,6 +1194,13 @@ class DFOCC : public Wavefunction {
     SharedTensor1d kappa_barB;
     SharedTensor1d kappa_newA;
     SharedTensor1d kappa_newB;
+
+    // L-BFGS orbital step history
+    std::vector<SharedTensor1d> lbfgs_s;
+    std::vector<SharedTensor1d> lbfgs_y;
+    SharedTensor1d lbfgs_x;
+    SharedTensor1d lbfgs_g;
+    SharedTensor1d lbfgs_xnext;
     SharedTensor1d zvector;
     SharedTensor1d zvectorA;
     SharedTensor1d zvectorB;
@@ -1214,6 +1241,14 @@ class DFOCC : public Wavefunction {
     SharedTensor1d residualB;
     SharedTensor1d residual;
 
+    // SCF B tensors held in core for the duration of a PCG solve
+    SharedTensor2d bQvoA_pcg;
+    SharedTensor2d bQvoB_pcg;
+    SharedTensor2d bQooA_pcg;
+    SharedTensor2d bQooB_pcg;
+    SharedTensor2d bQvvA_pcg;
+    SharedTensor2d bQvvB_pcg;
+
     // Independent pairs
     SharedTensor1i idprowA;
     SharedTensor1i idprowB;
@@ -128,7 +128,7 @@ void DFOCC::get_moinfo() {
             msd_oo_scale = (FockA->get(noccA, noccA) - FockA->get(noccA - 1, noccA - 1)) /
                            (FockA->get(nfrzc + 1, nfrzc + 1) - FockA->get(nfrzc, nfrzc));
             msd_oo_scale /= 3.0;
-            if (hess_type == "APPROX_DIAG_HF" || hess_type == "APPROX_DIAG_EKT") {
+            if (hess_type == "APPROX_DIAG_HF" || hess_type == "APPROX_DIAG_EKT" || hess_type == "LBFGS") {
                 outfile->Printf("\tOO Scale is changed to: %12.10f\n", msd_oo_scale);
             }
         }
@@ -309,7 +309,7 @@ void DFOCC::get_moinfo() {
             scaleA /= 3.0;
             scaleB /= 3.0;
             msd_oo_scale = 0.5 * (scaleA + scaleB);
-            if (hess_type == "APPROX_DIAG_HF" || hess_type == "APPROX_DIAG_EKT") {
+            if (hess_type == "APPROX_DIAG_HF" || hess_type == "APPROX_DIAG_EKT" || hess_type == "LBFGS") {
                 outfile->Printf("\tOO Scale is changed to: %12.10f\n", msd_oo_scale);
             }
         }
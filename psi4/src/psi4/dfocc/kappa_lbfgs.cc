@@ -0,0 +1,186 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Psi4: an open-source quantum chemistry software package
+ *
+ * Copyright (c) 2007-2023 The Psi4 Developers.
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This file is part of Psi4.
+ *
+ * Psi4 is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * Psi4 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with Psi4; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * @END LICENSE
+ */
+
+#include "defines.h"
+#include "dfocc.h"
+#include "psi4/psi4-dec.h"
+
+#include <cmath>
+
+using namespace psi;
+
+namespace psi {
+namespace dfoccwave {
+
+//=========================
+// kappa_lbfgs
+//=========================
+void DFOCC::kappa_lbfgs() {
+    // Limited-memory BFGS step for the orbital rotations. The inverse Hessian is built from the
+    // previous (kappa_bar, w) pairs on top of the approximate diagonal HF Hessian, so no orbital
+    // response equations are solved. Alpha and beta parameters form a single vector.
+    int ntot = (reference_ == "UNRESTRICTED") ? nidpA + nidpB : nidpA;
+
+    // A new orbital optimization starts with an empty history
+    if (itr_occ == 1) {
+        lbfgs_s.clear();
+        lbfgs_y.clear();
+        lbfgs_x.reset();
+        lbfgs_g.reset();
+        lbfgs_xnext.reset();
+    }
+
+    // Current point and gradient
+    SharedTensor1d xk = std::make_shared<Tensor1d>("L-BFGS kappa_bar", ntot);
+    SharedTensor1d gk = std::make_shared<Tensor1d>("L-BFGS MO grad", ntot);
+    if (lbfgs_xnext)
+        xk->copy(lbfgs_xnext);
+    else {
+        for (int i = 0; i < nidpA; i++) xk->set(i, kappa_barA->get(i));
+        if (reference_ == "UNRESTRICTED") {
+            for (int i = 0; i < nidpB; i++) xk->set(i + nidpA, kappa_barB->get(i));
+        }
+    }
+    for (int i = 0; i < nidpA; i++) gk->set(i, wogA->get(i));
+    if (reference_ == "UNRESTRICTED") {
+        for (int i = 0; i < nidpB; i++) gk->set(i + nidpA, wogB->get(i));
+    }
+
+    // New curvature pair, kept only if it satisfies the curvature condition
+    if (lbfgs_x) {
+        SharedTensor1d s = std::make_shared<Tensor1d>("L-BFGS s", ntot);
+        SharedTensor1d y = std::make_shared<Tensor1d>("L-BFGS y", ntot);
+        s->copy(xk);
+        s->subtract(lbfgs_x);
+        y->copy(gk);
+        y->subtract(lbfgs_g);
+        double sy = s->dot(y);
+        if (sy > 1.0e-10 * std::sqrt(s->dot(s) * y->dot(y))) {
+            lbfgs_s.push_back(s);
+            lbfgs_y.push_back(y);
+            if ((int)lbfgs_s.size() > lbfgs_nvec) {
+                lbfgs_s.erase(lbfgs_s.begin());
+                lbfgs_y.erase(lbfgs_y.begin());
+            }
+        }
+    }
+    lbfgs_x = xk;
+    lbfgs_g = gk;
+
+    // Initial inverse Hessian: approximate diagonal HF MO Hessian
+    approx_diag_hf_mohess_vo();
+    if (nfrzc > 0) approx_diag_hf_mohess_oo();
+    SharedTensor1d h0 = std::make_shared<Tensor1d>("L-BFGS H0 inverse", ntot);
+    for (int x = 0; x < nidpA; x++) {
+        int p = idprowA->get(x);
+        int q = idpcolA->get(x);
+        double value = (p >= noccA) ? AvoA->get(p - noccA, q) : AooA->get(p - nfrzc, q);
+        h0->set(x, 1.0 / value);
+    }
+    if (reference_ == "UNRESTRICTED") {
+        for (int x = 0; x < nidpB; x++) {
+            int p = idprowB->get(x);
+            int q = idpcolB->get(x);
+            double value = (p >= noccB) ? AvoB->get(p - noccB, q) : AooB->get(p - nfrzc, q);
+            h0->set(x + nidpA, 1.0 / value);
+        }
+    }
+
+    // Two-loop recursion: r = H^-1 w
+    int nvec = lbfgs_s.size();
+    std::vector<double> rho(nvec), alpha(nvec);
+    SharedTensor1d r = std::make_shared<Tensor1d>("L-BFGS step", ntot);
+    SharedTensor1d q = std::make_shared<Tensor1d>("L-BFGS q", ntot);
+    q->copy(gk);
+    for (int k = nvec - 1; k >= 0; k--) {
+        rho[k] = 1.0 / lbfgs_y[k]->dot(lbfgs_s[k]);
+        alpha[k] = rho[k] * lbfgs_s[k]->dot(q);
+        q->axpy(lbfgs_y[k], -alpha[k]);
+    }
+    r->dirprd(h0, q);
+    for (int k = 0; k < nvec; k++) {
+        double beta = rho[k] * lbfgs_y[k]->dot(r);
+        r->axpy(lbfgs_s[k], alpha[k] - beta);
+    }
+    q.reset();
+
+    // Fall back to the diagonal step if the update has lost the descent direction
+    if (nvec > 0 && r->dot(gk) <= 0.0) {
+        outfile->Printf("\tL-BFGS step is not a descent direction, the history is reset.\n");
+        lbfgs_s.clear();
+        lbfgs_y.clear();
+        r->dirprd(h0, gk);
+    }
+    h0.reset();
+
+    // Kappa
+    for (int x = 0; x < nidpA; x++) kappaA->set(x, -r->get(x));
+    if (reference_ == "UNRESTRICTED") {
+        for (int x = 0; x < nidpB; x++) kappaB->set(x, -r->get(x + nidpA));
+    }
+    r.reset();
+
+    // find biggest_kappa and scale
+    biggest_kappaA = 0;
+    for (int i = 0; i < nidpA; i++) {
+        if (std::fabs(kappaA->get(i)) > biggest_kappaA) biggest_kappaA = std::fabs(kappaA->get(i));
+    }
+    if (biggest_kappaA > step_max) {
+        for (int i = 0; i < nidpA; i++) kappaA->set(i, kappaA->get(i) * (step_max / biggest_kappaA));
+        biggest_kappaA = step_max;
+    }
+    rms_kappaA = kappaA->rms();
+
+    if (reference_ == "UNRESTRICTED") {
+        biggest_kappaB = 0;
+        for (int i = 0; i < nidpB; i++) {
+            if (std::fabs(kappaB->get(i)) > biggest_kappaB) biggest_kappaB = std::fabs(kappaB->get(i));
+        }
+        if (biggest_kappaB > step_max) {
+            for (int i = 0; i < nidpB; i++) kappaB->set(i, kappaB->get(i) * (step_max / biggest_kappaB));
+            biggest_kappaB = step_max;
+        }
+        rms_kappaB = kappaB->rms();
+    }
+
+    // The next gradient is evaluated at kappa_bar + kappa; kappa_bar may have been moved by orbital DIIS
+    lbfgs_xnext = std::make_shared<Tensor1d>("L-BFGS next kappa_bar", ntot);
+    for (int i = 0; i < nidpA; i++) lbfgs_xnext->set(i, kappa_barA->get(i) + kappaA->get(i));
+    if (reference_ == "UNRESTRICTED") {
+        for (int i = 0; i < nidpB; i++) lbfgs_xnext->set(i + nidpA, kappa_barB->get(i) + kappaB->get(i));
+    }
+
+    // print
+    if (print_ > 2) {
+        kappaA->print();
+        if (reference_ == "UNRESTRICTED") kappaB->print();
+    }
+}  // end kappa_lbfgs
+
+}  // namespace dfoccwave
+}  // namespace psi
@@ -62,9 +62,10 @@ void DFOCC::kappa_orb_resp_pcg() {
             for (int i = 0; i < noccA; i++, ai++) {
                 double value = FockA->get(a + noccA, a + noccA) - FockA->get(i, i);
                 zvectorA->set(ai, -WorbA->get(a + noccA, i) / (2.0 * value));
-                Minv_pcgA->set(ai, 0.5 / value);
             }
         }
+        pcg_ints_init();
+        pcg_precond(Minv_pcgA, true, 0, level_shift == "TRUE" ? lshift_parameter : 0.0);
 
         // Build S = A kappa_0
         sigma_rhf(sigma_pcgA, zvectorA);
@@ -88,6 +89,7 @@ void DFOCC::kappa_orb_resp_pcg() {
 
         // Call Orbital Response Solver
         orb_resp_pcg_rhf();
+        pcg_ints_clear();
 
         // Memfree
         zvec_newA.reset();
@@ -215,7 +217,6 @@ void DFOCC::kappa_orb_resp_pcg() {
             for (int i = 0; i < noccA; i++, ai++) {
                 double value = FockA->get(a + noccA, a + noccA) - FockA->get(i, i);
                 zvectorA->set(ai, -WorbA->get(a + noccA, i) / (2.0 * value));
-                Minv_pcg->set(ai, 0.5 / value);
             }
         }
 
@@ -224,9 +225,11 @@ void DFOCC::kappa_orb_resp_pcg() {
             for (int i = 0; i < noccB; i++, ai++) {
                 double value = FockB->get(a + noccB, a + noccB) - FockB->get(i, i);
                 zvectorB->set(ai, -WorbB->get(a + noccB, i) / (2.0 * value));
-                Minv_pcg->set(ai + nidpA, 0.5 / value);
             }
         }
+        pcg_ints_init();
+        pcg_precond(Minv_pcg, true, 0, level_shift == "TRUE" ? lshift_parameter : 0.0);
+        pcg_precond(Minv_pcg, false, nidpA, level_shift == "TRUE" ? lshift_parameter : 0.0);
 
         // Form initial zvector vector
         for (int ai = 0; ai < nidpA; ai++) zvector->set(ai, zvectorA->get(ai));
@@ -273,6 +276,7 @@ void DFOCC::kappa_orb_resp_pcg() {
 
         // Call Orbital Response Solver
         orb_resp_pcg_uhf();
+        pcg_ints_clear();
 
         // Memfree alpha
         zvec_new.reset();
@@ -1176,6 +1176,30 @@ void DFOCC::ccsd_t_manager() {
         memory_mb = (double)memory / (1024.0 * 1024.0);
         outfile->Printf("\n\tAvailable memory                      : %9.2lf MB \n", memory_mb);
         outfile->Printf("\tMinimum required memory for amplitudes: %9.2lf MB \n", cost_amp);
+
+        // Memory for triples: 5*O^2V^2 + 3*O^3V + 5*V^3 with the larger spin blocks
+        double naocc = MAX0(naoccA, naoccB);
+        double navir = MAX0(navirA, navirB);
+        double cost_amp1 = 5.0 * naocc * naocc * navir * navir;
+        cost_amp1 += 3.0 * naocc * naocc * naocc * navir;
+        cost_amp1 += 5.0 * navir * navir * navir;
+        cost_amp1 /= 1024.0 * 1024.0;
+        cost_amp1 *= sizeof(double);
+        // Memory: the above + V^2N/2 for the disk algorithm of (ia|bc)
+        cost_triples_iabc = 0.5 * nQ * navir * navir;
+        cost_triples_iabc /= 1024.0 * 1024.0;
+        cost_triples_iabc *= sizeof(double);
+        cost_triples_iabc += cost_amp1;
+
+        if (triples_iabc_type_ == "DIRECT" || (cost_triples_iabc > memory_mb && triples_iabc_type_ == "AUTO")) {
+            do_triples_hm = false;
+            outfile->Printf("\n\tI will use a DIRECT algorithm for (ia|bc) in (T)! \n");
+            outfile->Printf("\tMemory requirement for (T) correction : %9.2lf MB \n", cost_amp1);
+        } else {
+            do_triples_hm = true;
+            outfile->Printf("\n\tI will use a DISK algorithm for (ia|bc) in (T)! \n");
+            outfile->Printf("\tMemory requirement for (T) correction : %9.2lf MB \n", cost_triples_iabc);
+        }
     }  // else if (reference_ == "UNRESTRICTED")
 
     // memalloc for density intermediates
@@ -1321,7 +1345,13 @@ void DFOCC::ccsd_t_manager() {
                 ccsd_canonic_triples_disk();
         } // if restricted
         if (reference_ == "UNRESTRICTED") {
-            uccsd_triples_hm();
+            // B(Q|ab) is not needed by (T)
+            bQabA.reset();
+            bQabB.reset();
+            if (do_triples_hm)
+                uccsd_triples_hm();
+            else
+                uccsd_triples_lm();
         } // if unrestricted
     }
     timer_off("(T)");
@@ -1669,6 +1699,30 @@ void DFOCC::ccsdl_t_manager() {
         memory_mb = (double)memory / (1024.0 * 1024.0);
         outfile->Printf("\n\tAvailable memory                      : %9.2lf MB \n", memory_mb);
         outfile->Printf("\tMinimum required memory for amplitudes: %9.2lf MB \n", cost_amp);
+
+        // Memory for triples: 5*O^2V^2 + 3*O^3V + 5*V^3 with the larger spin blocks
+        double naocc = MAX0(naoccA, naoccB);
+        double navir = MAX0(navirA, navirB);
+        double cost_amp1 = 5.0 * naocc * naocc * navir * navir;
+        cost_amp1 += 3.0 * naocc * naocc * naocc * navir;
+        cost_amp1 += 5.0 * navir * navir * navir;
+        cost_amp1 /= 1024.0 * 1024.0;
+        cost_amp1 *= sizeof(double);
+        // Memory: the above + V^2N/2 for the disk algorithm of (ia|bc)
+        cost_triples_iabc = 0.5 * nQ * navir * navir;
+        cost_triples_iabc /= 1024.0 * 1024.0;
+        cost_triples_iabc *= sizeof(double);
+        cost_triples_iabc += cost_amp1;
+
+        if (triples_iabc_type_ == "DIRECT" || (cost_triples_iabc > memory_mb && triples_iabc_type_ == "AUTO")) {
+            do_triples_hm = false;
+            outfile->Printf("\n\tI will use a DIRECT algorithm for (ia|bc) in (T)! \n");
+            outfile->Printf("\tMemory requirement for (T) correction : %9.2lf MB \n", cost_amp1);
+        } else {
+            do_triples_hm = true;
+            outfile->Printf("\n\tI will use a DISK algorithm for (ia|bc) in (T)! \n");
+            outfile->Printf("\tMemory requirement for (T) correction : %9.2lf MB \n", cost_triples_iabc);
+        }
     }  // else if (reference_ == "UNRESTRICTED")
 
     // memalloc for density intermediates
@@ -1792,7 +1846,13 @@ void DFOCC::ccsdl_t_manager() {
         ccsdl_canonic_triples_disk();
     }
     else if (reference_ == "UNRESTRICTED") {
-        uccsdl_triples_hm();
+        // B(Q|ab) is not needed by (AT)
+        bQabA.reset();
+        bQabB.reset();
+        if (do_triples_hm)
+            uccsdl_triples_hm();
+        else
+            uccsdl_triples_lm();
     }
     timer_off("(AT)");
     outfile->Printf("\t(AT) Correction (a.u.)             : %20.14f\n", E_at);
@@ -201,7 +201,9 @@ void DFOCC::occ_iterations() {
                 kappa_orb_resp();
             else if (orb_resp_solver_ == "PCG")
                 kappa_orb_resp_pcg();
-        } else
+        } else if (hess_type == "LBFGS")
+            kappa_lbfgs();
+        else
             kappa_diag_hess();
         timer_off("kappa orb rot");
 
@@ -30,6 +30,7 @@
 #include <cstdio>
 #include <fstream>
 #include <cmath>
+#include <algorithm>
 #include "psi4/libqt/qt.h"
 #include "psi4/libciomr/libciomr.h"
 #include "psi4/libpsio/psio.hpp"
@@ -2573,640 +2574,115 @@ double *Tensor2d::column_vector(int n) {
     return temp;
 }  //
 
-void Tensor2d::sort(int sort_type, const SharedTensor2d &A, double alpha, double beta) {
-    int d1 = A->d1_;
-    int d2 = A->d2_;
-    int d3 = A->d3_;
-    int d4 = A->d4_;
-
-    if (sort_type == 1243) {
-        if (d1_ != d1 || d2_ != d2 || d3_ != d4  || d4_ != d3 ) {
-            outfile->Printf("\tTensor2d::sort dimensions are NOT consistent!\n");
-            throw PSIEXCEPTION("Tensor2d::sort dimensions are NOT consistent!");
-        }
-#pragma omp parallel for
-        for (int p = 0; p < d1; p++) {
-            for (int q = 0; q < d2; q++) {
-                int pq = A->row_idx_[p][q];
-                for (int r = 0; r < d3; r++) {
-                    for (int s = 0; s < d4; s++) {
-                        int rs = A->col_idx_[r][s];
-                        int sr = col_idx_[s][r];
-                        A2d_[pq][sr] = (alpha * A->A2d_[pq][rs]) + (beta * A2d_[pq][sr]);
-                    }
-                }
-            }
-        }
-    }
-
-    else if (sort_type == 1324) {
-        if (d1_ != d1 || d2_ != d3 || d3_ != d2  || d4_ != d4 ) {
-            outfile->Printf("\tTensor2d::sort dimensions are NOT consistent!\n");
-            throw PSIEXCEPTION("Tensor2d::sort dimensions are NOT consistent!");
-        }
-#pragma omp parallel for
-        for (int p = 0; p < d1; p++) {
-            for (int q = 0; q < d2; q++) {
-                int pq = A->row_idx_[p][q];
-                for (int r = 0; r < d3; r++) {
-                    for (int s = 0; s < d4; s++) {
-                        int rs = A->col_idx_[r][s];
-                        int pr = row_idx_[p][r];
-                        int qs = col_idx_[q][s];
-                        A2d_[pr][qs] = (alpha * A->A2d_[pq][rs]) + (beta * A2d_[pr][qs]);
-                    }
-                }
-            }
-        }
-    }
-
-    else if (sort_type == 1342) {
-        if (d1_ != d1 || d2_ != d3 || d3_ != d4  || d4_ != d2 ) {
-            outfile->Printf("\tTensor2d::sort dimensions are NOT consistent!\n");
-            throw PSIEXCEPTION("Tensor2d::sort dimensions are NOT consistent!");
-        }
-#pragma omp parallel for
-        for (int p = 0; p < d1; p++) {
-            for (int q = 0; q < d2; q++) {
-                int pq = A->row_idx_[p][q];
-                for (int r = 0; r < d3; r++) {
-                    for (int s = 0; s < d4; s++) {
-                        int rs = A->col_idx_[r][s];
-                        int pr = row_idx_[p][r];
-                        int sq = col_idx_[s][q];
-                        A2d_[pr][sq] = (alpha * A->A2d_[pq][rs]) + (beta * A2d_[pr][sq]);
-                    }
-                }
-            }
-        }
-    }
-
-    else if (sort_type == 1423) {
-        if (d1_ != d1 || d2_ != d4 || d3_ != d2  || d4_ != d3 ) {
-            outfile->Printf("\tTensor2d::sort dimensions are NOT consistent!\n");
-            throw PSIEXCEPTION("Tensor2d::sort dimensions are NOT consistent!");
-        }
-#pragma omp parallel for
-        for (int p = 0; p < d1; p++) {
-            for (int q = 0; q < d2; q++) {
-                int pq = A->row_idx_[p][q];
-                for (int r = 0; r < d3; r++) {
-                    for (int s = 0; s < d4; s++) {
-                        int rs = A->col_idx_[r][s];
-                        int ps = row_idx_[p][s];
-                        int qr = col_idx_[q][r];
-                        A2d_[ps][qr] = (alpha * A->A2d_[pq][rs]) + (beta * A2d_[ps][qr]);
-                    }
-                }
-            }
-        }
-    }
-
-    else if (sort_type == 1432) {
-        if (d1_ != d1 || d2_ != d4 || d3_ != d3  || d4_ != d2 ) {
-            outfile->Printf("\tTensor2d::sort dimensions are NOT consistent!\n");
-            throw PSIEXCEPTION("Tensor2d::sort dimensions are NOT consistent!");
-        }
-#pragma omp parallel for
-        for (int p = 0; p < d1; p++) {
-            for (int q = 0; q < d2; q++) {
-                int pq = A->row_idx_[p][q];
-                for (int r = 0; r < d3; r++) {
-                    int rq = col_idx_[r][q];
-                    for (int s = 0; s < d4; s++) {
-                        int rs = A->col_idx_[r][s];
-                        int ps = row_idx_[p][s];
-                        A2d_[ps][rq] = (alpha * A->A2d_[pq][rs]) + (beta * A2d_[ps][rq]);
-                    }
-                }
-            }
-        }
-    }
-
-    else if (sort_type == 2134) {
-        if (d1_ != d2 || d2_ != d1 || d3_ != d3  || d4_ != d4 ) {
-            outfile->Printf("\tTensor2d::sort dimensions are NOT consistent!\n");
-            throw PSIEXCEPTION("Tensor2d::sort dimensions are NOT consistent!");
-        }
-#pragma omp parallel for
-        for (int p = 0; p < d1; p++) {
-            for (int q = 0; q < d2; q++) {
-                int pq = A->row_idx_[p][q];
-                for (int r = 0; r < d3; r++) {
-                    for (int s = 0; s < d4; s++) {
-                        int rs = A->col_idx_[r][s];
-                        int qp = row_idx_[q][p];
-                        A2d_[qp][rs] = (alpha * A->A2d_[pq][rs]) + (beta * A2d_[qp][rs]);
-                    }
-                }
-            }
-        }
-    }
-
-    else if (sort_type == 2143) {
-        if (d1_ != d2 || d2_ != d1 || d3_ != d4  || d4_ != d3 ) {
-            outfile->Printf("\tTensor2d::sort dimensions are NOT consistent!\n");
-            throw PSIEXCEPTION("Tensor2d::sort dimensions are NOT consistent!");
-        }
-#pragma omp parallel for
-        for (int p = 0; p < d1; p++) {
-            for (int q = 0; q < d2; q++) {
-                int pq = A->row_idx_[p][q];
-                for (int r = 0; r < d3; r++) {
-                    for (int s = 0; s < d4; s++) {
-                        int rs = A->col_idx_[r][s];
-                        int qp = row_idx_[q][p];
-                        int sr = col_idx_[s][r];
-                        A2d_[qp][sr] = (alpha * A->A2d_[pq][rs]) + (beta * A2d_[qp][sr]);
-                    }
-                }
-            }
-        }
-    }
-
-    else if (sort_type == 2314) {
-        if (d1_ != d2 || d2_ != d3 || d3_ != d1  || d4_ != d4 ) {
-            outfile->Printf("\tTensor2d::sort dimensions are NOT consistent!\n");
-            throw PSIEXCEPTION("Tensor2d::sort dimensions are NOT consistent!");
-        }
-#pragma omp parallel for
-        for (int p = 0; p < d1; p++) {
-            for (int q = 0; q < d2; q++) {
-                int pq = A->row_idx_[p][q];
-                for (int r = 0; r < d3; r++) {
-                    for (int s = 0; s < d4; s++) {
-                        int rs = A->col_idx_[r][s];
-                        int qr = row_idx_[q][r];
-                        int ps = col_idx_[p][s];
-                        A2d_[qr][ps] = (alpha * A->A2d_[pq][rs]) + (beta * A2d_[qr][ps]);
-                    }
-                }
-            }
-        }
-    }
-
-    else if (sort_type == 2341) {
-        if (d1_ != d2 || d2_ != d3 || d3_ != d4  || d4_ != d1 ) {
-            outfile->Printf("\tTensor2d::sort dimensions are NOT consistent!\n");
-            throw PSIEXCEPTION("Tensor2d::sort dimensions are NOT consistent!");
-        }
-#pragma omp parallel for
-        for (int p = 0; p < d1; p++) {
-            for (int q = 0; q < d2; q++) {
-                int pq = A->row_idx_[p][q];
-                for (int r = 0; r < d3; r++) {
-                    for (int s = 0; s < d4; s++) {
-                        int rs = A->col_idx_[r][s];
-                        int qr = row_idx_[q][r];
-                        int sp = col_idx_[s][p];
-                        A2d_[qr][sp] = (alpha * A->A2d_[pq][rs]) + (beta * A2d_[qr][sp]);
-                    }
-                }
-            }
-        }
-    }
-
-    else if (sort_type == 2413) {
-        if (d1_ != d2 || d2_ != d4 || d3_ != d1  || d4_ != d3 ) {
-            outfile->Printf("\tTensor2d::sort dimensions are NOT consistent!\n");
-            throw PSIEXCEPTION("Tensor2d::sort dimensions are NOT consistent!");
-        }
-#pragma omp parallel for
-        for (int p = 0; p < d1; p++) {
-            for (int q = 0; q < d2; q++) {
-                int pq = A->row_idx_[p][q];
-                for (int r = 0; r < d3; r++) {
-                    for (int s = 0; s < d4; s++) {
-                        int rs = A->col_idx_[r][s];
-                        int qs = row_idx_[q][s];
-                        int pr = col_idx_[p][r];
-                        A2d_[qs][pr] = (alpha * A->A2d_[pq][rs]) + (beta * A2d_[qs][pr]);
-                    }
-                }
-            }
-        }
-    }
-
-    else if (sort_type == 2431) {
-        if (d1_ != d2 || d2_ != d4 || d3_ != d3  || d4_ != d1 ) {
-            outfile->Printf("\tTensor2d::sort dimensions are NOT consistent!\n");
-            throw PSIEXCEPTION("Tensor2d::sort dimensions are NOT consistent!");
-        }
-#pragma omp parallel for
-        for (int p = 0; p < d1; p++) {
-            for (int q = 0; q < d2; q++) {
-                int pq = A->row_idx_[p][q];
-                for (int r = 0; r < d3; r++) {
-                    for (int s = 0; s < d4; s++) {
-                        int rs = A->col_idx_[r][s];
-                        int qs = row_idx_[q][s];
-                        int rp = col_idx_[r][p];
-                        A2d_[qs][rp] = (alpha * A->A2d_[pq][rs]) + (beta * A2d_[qs][rp]);
-                    }
-                }
-            }
-        }
-    }
-
-    else if (sort_type == 3124) {
-        if (d1_ != d3 || d2_ != d1 || d3_ != d2  || d4_ != d4 ) {
-            outfile->Printf("\tTensor2d::sort dimensions are NOT consistent!\n");
-            throw PSIEXCEPTION("Tensor2d::sort dimensions are NOT consistent!");
-        }
-#pragma omp parallel for
-        for (int p = 0; p < d1; p++) {
-            for (int q = 0; q < d2; q++) {
-                int pq = A->row_idx_[p][q];
-                for (int r = 0; r < d3; r++) {
-                    for (int s = 0; s < d4; s++) {
-                        int rs = A->col_idx_[r][s];
-                        int rp = row_idx_[r][p];
-                        int qs = col_idx_[q][s];
-                        A2d_[rp][qs] = (alpha * A->A2d_[pq][rs]) + (beta * A2d_[rp][qs]);
-                    }
-                }
-            }
-        }
-    }
-
-    else if (sort_type == 3142) {
-        if (d1_ != d3 || d2_ != d1 || d3_ != d4  || d4_ != d2 ) {
-            outfile->Printf("\tTensor2d::sort dimensions are NOT consistent!\n");
-            throw PSIEXCEPTION("Tensor2d::sort dimensions are NOT consistent!");
-        }
-#pragma omp parallel for
-        for (int p = 0; p < d1; p++) {
-            for (int q = 0; q < d2; q++) {
-                int pq = A->row_idx_[p][q];
-                for (int r = 0; r < d3; r++) {
-                    for (int s = 0; s < d4; s++) {
-                        int rs = A->col_idx_[r][s];
-                        int rp = row_idx_[r][p];
-                        int sq = col_idx_[s][q];
-                        A2d_[rp][sq] = (alpha * A->A2d_[pq][rs]) + (beta * A2d_[rp][sq]);
-                    }
-                }
-            }
-        }
-    }
+namespace {
 
-    else if (sort_type == 3214) {
-        if (d1_ != d3 || d2_ != d2 || d3_ != d1  || d4_ != d4 ) {
-            outfile->Printf("\tTensor2d::sort dimensions are NOT consistent!\n");
-            throw PSIEXCEPTION("Tensor2d::sort dimensions are NOT consistent!");
-        }
-#pragma omp parallel for
-        for (int p = 0; p < d1; p++) {
-            for (int q = 0; q < d2; q++) {
-                int pq = A->row_idx_[p][q];
-                for (int r = 0; r < d3; r++) {
-                    int rq = row_idx_[r][q];
-                    for (int s = 0; s < d4; s++) {
-                        int rs = A->col_idx_[r][s];
-                        int ps = col_idx_[p][s];
-                        A2d_[rq][ps] = (alpha * A->A2d_[pq][rs]) + (beta * A2d_[rq][ps]);
-                    }
-                }
-            }
-        }
-    }
+// Edge of the square tiles used when a sort moves the last index of A
+const int sort_tile = 32;
 
-    else if (sort_type == 3241) {
-        if (d1_ != d3 || d2_ != d2 || d3_ != d4  || d4_ != d1 ) {
-            outfile->Printf("\tTensor2d::sort dimensions are NOT consistent!\n");
-            throw PSIEXCEPTION("Tensor2d::sort dimensions are NOT consistent!");
-        }
-#pragma omp parallel for
-        for (int p = 0; p < d1; p++) {
-            for (int q = 0; q < d2; q++) {
-                int pq = A->row_idx_[p][q];
-                for (int r = 0; r < d3; r++) {
-                    for (int s = 0; s < d4; s++) {
-                        int rs = A->col_idx_[r][s];
-                        int rq = row_idx_[r][q];
-                        int sp = col_idx_[s][p];
-                        A2d_[rq][sp] = (alpha * A->A2d_[pq][rs]) + (beta * A2d_[rq][sp]);
-                    }
-                }
-            }
-        }
-    }
-
-    else if (sort_type == 3412) {
-        if (d1_ != d3 || d2_ != d4 || d3_ != d1  || d4_ != d2 ) {
-            outfile->Printf("\tTensor2d::sort dimensions are NOT consistent!\n");
-            throw PSIEXCEPTION("Tensor2d::sort dimensions are NOT consistent!");
-        }
-#pragma omp parallel for
-        for (int p = 0; p < d1; p++) {
-            for (int q = 0; q < d2; q++) {
-                int pq = A->row_idx_[p][q];
-                for (int r = 0; r < d3; r++) {
-                    for (int s = 0; s < d4; s++) {
-                        int rs = A->col_idx_[r][s];
-                        A2d_[rs][pq] = (alpha * A->A2d_[pq][rs]) + (beta * A2d_[rs][pq]);
-                    }
-                }
-            }
-        }
-    }
-
-    else if (sort_type == 3421) {
-        if (d1_ != d3 || d2_ != d4 || d3_ != d2  || d4_ != d1 ) {
-            outfile->Printf("\tTensor2d::sort dimensions are NOT consistent!\n");
-            throw PSIEXCEPTION("Tensor2d::sort dimensions are NOT consistent!");
-        }
-#pragma omp parallel for
-        for (int p = 0; p < d1; p++) {
-            for (int q = 0; q < d2; q++) {
-                int pq = A->row_idx_[p][q];
-                for (int r = 0; r < d3; r++) {
-                    for (int s = 0; s < d4; s++) {
-                        int rs = A->col_idx_[r][s];
-                        int qp = col_idx_[q][p];
-                        A2d_[rs][qp] = (alpha * A->A2d_[pq][rs]) + (beta * A2d_[rs][qp]);
-                    }
-                }
-            }
-        }
-    }
-
-    else if (sort_type == 4123) {
-        if (d1_ != d4 || d2_ != d1 || d3_ != d2  || d4_ != d3 ) {
-            outfile->Printf("\tTensor2d::sort dimensions are NOT consistent!\n");
-            throw PSIEXCEPTION("Tensor2d::sort dimensions are NOT consistent!");
-        }
-#pragma omp parallel for
-        for (int p = 0; p < d1; p++) {
-            for (int q = 0; q < d2; q++) {
-                int pq = A->row_idx_[p][q];
-                for (int r = 0; r < d3; r++) {
-                    for (int s = 0; s < d4; s++) {
-                        int rs = A->col_idx_[r][s];
-                        int sp = row_idx_[s][p];
-                        int qr = col_idx_[q][r];
-                        A2d_[sp][qr] = (alpha * A->A2d_[pq][rs]) + (beta * A2d_[sp][qr]);
-                    }
-                }
-            }
-        }
-    }
-
-    else if (sort_type == 4132) {
-        if (d1_ != d4 || d2_ != d1 || d3_ != d3  || d4_ != d2 ) {
-            outfile->Printf("\tTensor2d::sort dimensions are NOT consistent!\n");
-            throw PSIEXCEPTION("Tensor2d::sort dimensions are NOT consistent!");
-        }
-#pragma omp parallel for
-        for (int p = 0; p < d1; p++) {
-            for (int q = 0; q < d2; q++) {
-                int pq = A->row_idx_[p][q];
-                for (int r = 0; r < d3; r++) {
-                    for (int s = 0; s < d4; s++) {
-                        int rs = A->col_idx_[r][s];
-                        int sp = row_idx_[s][p];
-                        int rq = col_idx_[r][q];
-                        A2d_[sp][rq] = (alpha * A->A2d_[pq][rs]) + (beta * A2d_[sp][rq]);
-                    }
-                }
-            }
-        }
-    }
-
-    else if (sort_type == 4213) {
-        if (d1_ != d4 || d2_ != d2 || d3_ != d1  || d4_ != d3 ) {
-            outfile->Printf("\tTensor2d::sort dimensions are NOT consistent!\n");
-            throw PSIEXCEPTION("Tensor2d::sort dimensions are NOT consistent!");
-        }
-#pragma omp parallel for
-        for (int p = 0; p < d1; p++) {
-            for (int q = 0; q < d2; q++) {
-                int pq = A->row_idx_[p][q];
-                for (int r = 0; r < d3; r++) {
-                    for (int s = 0; s < d4; s++) {
-                        int rs = A->col_idx_[r][s];
-                        int sq = row_idx_[s][q];
-                        int pr = col_idx_[p][r];
-                        A2d_[sq][pr] = (alpha * A->A2d_[pq][rs]) + (beta * A2d_[sq][pr]);
-                    }
+/*
+** permute4: C(t) = alpha * A(s) + beta * C(t), where the four indices of C are
+** those of A in the order given by perm (1-based, e.g. {1,4,3,2} for a 1432
+** sort) and dims are the dimensions of A. Both tensors are contiguous and
+** row-major.
+*/
+void permute4(const int *perm, const int *dims, const double *A, double *C, double alpha, double beta) {
+    size_t stride[4];
+    stride[3] = 1;
+    for (int k = 2; k >= 0; k--) stride[k] = stride[k + 1] * dims[k + 1];
+
+    // Dimensions of C, and the strides of A and C along each of them
+    int n[4];
+    size_t sa[4], sc[4];
+    for (int k = 0; k < 4; k++) {
+        n[k] = dims[perm[k] - 1];
+        sa[k] = stride[perm[k] - 1];
+    }
+    sc[3] = 1;
+    for (int k = 2; k >= 0; k--) sc[k] = sc[k + 1] * n[k + 1];
+
+    if (perm[3] == 4) {
+        // The last index stays in place: the innermost loop is a unit-stride axpby
+#pragma omp parallel for collapse(3) schedule(static)
+        for (int t0 = 0; t0 < n[0]; t0++) {
+            for (int t1 = 0; t1 < n[1]; t1++) {
+                for (int t2 = 0; t2 < n[2]; t2++) {
+                    const double *a = A + t0 * sa[0] + t1 * sa[1] + t2 * sa[2];
+                    double *c = C + t0 * sc[0] + t1 * sc[1] + t2 * sc[2];
+                    for (int t3 = 0; t3 < n[3]; t3++) c[t3] = (alpha * a[t3]) + (beta * c[t3]);
                 }
             }
         }
-    }
-
-    else if (sort_type == 4231) {
-        if (d1_ != d4 || d2_ != d2 || d3_ != d3  || d4_ != d1 ) {
-            outfile->Printf("\tTensor2d::sort dimensions are NOT consistent!\n");
-            throw PSIEXCEPTION("Tensor2d::sort dimensions are NOT consistent!");
-        }
-#pragma omp parallel for
-        for (int p = 0; p < d1; p++) {
-            for (int q = 0; q < d2; q++) {
-                int pq = A->row_idx_[p][q];
-                for (int r = 0; r < d3; r++) {
-                    for (int s = 0; s < d4; s++) {
-                        int rs = A->col_idx_[r][s];
-                        int sq = row_idx_[s][q];
-                        int rp = col_idx_[r][p];
-                        A2d_[sq][rp] = (alpha * A->A2d_[pq][rs]) + (beta * A2d_[sq][rp]);
+        return;
+    }
+
+    // The last index of A becomes index f of C: transpose the (f, last) planes
+    // tile by tile so that the reads and the writes of a tile stay in cache
+    int f = (perm[0] == 4) ? 0 : ((perm[1] == 4) ? 1 : 2);
+    int u1 = (f == 0) ? 1 : 0;
+    int u2 = (f == 2) ? 1 : 2;
+#pragma omp parallel for collapse(2) schedule(static)
+    for (int x = 0; x < n[u1]; x++) {
+        for (int y = 0; y < n[u2]; y++) {
+            const double *a = A + x * sa[u1] + y * sa[u2];
+            double *c = C + x * sc[u1] + y * sc[u2];
+            for (int kb = 0; kb < n[f]; kb += sort_tile) {
+                int ke = std::min(kb + sort_tile, n[f]);
+                for (int lb = 0; lb < n[3]; lb += sort_tile) {
+                    int le = std::min(lb + sort_tile, n[3]);
+                    for (int k = kb; k < ke; k++) {
+                        double *ck = c + k * sc[f];
+                        for (int l = lb; l < le; l++) ck[l] = (alpha * a[k + l * sa[3]]) + (beta * ck[l]);
                     }
                 }
             }
         }
     }
+}
 
-    else if (sort_type == 4312) {
-        if (d1_ != d4 || d2_ != d3 || d3_ != d1  || d4_ != d2 ) {
-            outfile->Printf("\tTensor2d::sort dimensions are NOT consistent!\n");
-            throw PSIEXCEPTION("Tensor2d::sort dimensions are NOT consistent!");
-        }
-#pragma omp parallel for
-        for (int p = 0; p < d1; p++) {
-            for (int q = 0; q < d2; q++) {
-                int pq = A->row_idx_[p][q];
-                for (int r = 0; r < d3; r++) {
-                    for (int s = 0; s < d4; s++) {
-                        int rs = A->col_idx_[r][s];
-                        int sr = row_idx_[s][r];
-                        A2d_[sr][pq] = (alpha * A->A2d_[pq][rs]) + (beta * A2d_[sr][pq]);
-                    }
-                }
-            }
-        }
-    }
+// Digits of a sort type such as 1432, most significant first; false if they
+// are not a permutation of 1..nidx
+bool sort_digits(int sort_type, int nidx, int *perm) {
+    int seen = 0;
+    for (int k = nidx - 1; k >= 0; k--) {
+        perm[k] = sort_type % 10;
+        sort_type /= 10;
+        if (perm[k] < 1 || perm[k] > nidx || (seen & (1 << perm[k]))) return false;
+        seen |= 1 << perm[k];
+    }
+    return sort_type == 0;
+}
 
-    else if (sort_type == 4321) {
-        if (d1_ != d4 || d2_ != d3 || d3_ != d2  || d4_ != d1 ) {
-            outfile->Printf("\tTensor2d::sort dimensions are NOT consistent!\n");
-            throw PSIEXCEPTION("Tensor2d::sort dimensions are NOT consistent!");
-        }
-#pragma omp parallel for
-        for (int p = 0; p < d1; p++) {
-            for (int q = 0; q < d2; q++) {
-                int pq = A->row_idx_[p][q];
-                for (int r = 0; r < d3; r++) {
-                    for (int s = 0; s < d4; s++) {
-                        int rs = A->col_idx_[r][s];
-                        int sr = row_idx_[s][r];
-                        int qp = col_idx_[q][p];
-                        A2d_[sr][qp] = (alpha * A->A2d_[pq][rs]) + (beta * A2d_[sr][qp]);
-                    }
-                }
-            }
-        }
-    }
+}  // namespace
 
-    else {
+void Tensor2d::sort(int sort_type, const SharedTensor2d &A, double alpha, double beta) {
+    int dims[4] = {A->d1_, A->d2_, A->d3_, A->d4_};
+    int perm[4];
+    if (!sort_digits(sort_type, 4, perm)) {
         outfile->Printf("\tUnrecognized sort type!\n");
         throw PSIEXCEPTION("Unrecognized sort type!");
     }
-
+    if (d1_ != dims[perm[0] - 1] || d2_ != dims[perm[1] - 1] || d3_ != dims[perm[2] - 1] || d4_ != dims[perm[3] - 1]) {
+        outfile->Printf("\tTensor2d::sort dimensions are NOT consistent!\n");
+        throw PSIEXCEPTION("Tensor2d::sort dimensions are NOT consistent!");
+    }
+    permute4(perm, dims, A->A2d_[0], A2d_[0], alpha, beta);
 }  //
 
+// sort3a and sort3b differ only in how the three indices are split into rows
+// and columns, which does not change the contiguous layout
 void Tensor2d::sort3a(int sort_type, int d1, int d2, int d3, const SharedTensor2d &A, double alpha, double beta) {
-    if (sort_type == 132) {
-#pragma omp parallel for
-        for (int p = 0; p < d1; p++) {
-            for (int q = 0; q < d2; q++) {
-                for (int r = 0; r < d3; r++) {
-                    int rq = q + (r * d2);
-                    int qr = r + (q * d3);
-                    A2d_[p][rq] = (alpha * A->A2d_[p][qr]) + (beta * A2d_[p][rq]);
-                }
-            }
-        }
-    }
-
-    else if (sort_type == 231) {
-#pragma omp parallel for
-        for (int p = 0; p < d1; p++) {
-            for (int q = 0; q < d2; q++) {
-                for (int r = 0; r < d3; r++) {
-                    int rp = p + (r * d1);
-                    int qr = r + (q * d3);
-                    A2d_[q][rp] = (alpha * A->A2d_[p][qr]) + (beta * A2d_[q][rp]);
-                }
-            }
-        }
-    }
-
-    else if (sort_type == 213) {
-#pragma omp parallel for
-        for (int p = 0; p < d1; p++) {
-            for (int q = 0; q < d2; q++) {
-                for (int r = 0; r < d3; r++) {
-                    int pr = r + (p * d3);
-                    int qr = r + (q * d3);
-                    A2d_[q][pr] = (alpha * A->A2d_[p][qr]) + (beta * A2d_[q][pr]);
-                }
-            }
-        }
-    }
-
-    else if (sort_type == 312) {
-#pragma omp parallel for
-        for (int p = 0; p < d1; p++) {
-            for (int q = 0; q < d2; q++) {
-                for (int r = 0; r < d3; r++) {
-                    int qr = r + (q * d3);
-                    int pq = q + (p * d2);
-                    A2d_[r][pq] = (alpha * A->A2d_[p][qr]) + (beta * A2d_[r][pq]);
-                }
-            }
-        }
-    }
-
-    else if (sort_type == 321) {
-#pragma omp parallel for
-        for (int p = 0; p < d1; p++) {
-            for (int q = 0; q < d2; q++) {
-                for (int r = 0; r < d3; r++) {
-                    int qr = r + (q * d3);
-                    int qp = p + (q * d1);
-                    A2d_[r][qp] = (alpha * A->A2d_[p][qr]) + (beta * A2d_[r][qp]);
-                }
-            }
-        }
-    }
-
-    else {
+    int dims[4] = {1, d1, d2, d3};
+    int perm[4] = {1, 0, 0, 0};
+    if (sort_type == 123 || !sort_digits(sort_type, 3, perm + 1)) {
         outfile->Printf("\tUnrecognized sort type!\n");
         throw PSIEXCEPTION("Unrecognized sort type!");
     }
-
+    for (int k = 1; k < 4; k++) perm[k]++;
+    permute4(perm, dims, A->A2d_[0], A2d_[0], alpha, beta);
 }  //
 
 void Tensor2d::sort3b(int sort_type, int d1, int d2, int d3, const SharedTensor2d &A, double alpha, double beta) {
-    if (sort_type == 132) {
-#pragma omp parallel for
-        for (int p = 0; p < d1; p++) {
-            for (int q = 0; q < d2; q++) {
-                int pq = q + (p * d2);
-                for (int r = 0; r < d3; r++) {
-                    int pr = r + (p * d3);
-                    A2d_[pr][q] = (alpha * A->A2d_[pq][r]) + (beta * A2d_[pr][q]);
-                }
-            }
-        }
-    }
-
-    else if (sort_type == 213) {
-#pragma omp parallel for
-        for (int p = 0; p < d1; p++) {
-            for (int q = 0; q < d2; q++) {
-                int pq = q + (p * d2);
-                int qp = p + (q * d1);
-                for (int r = 0; r < d3; r++) {
-                    A2d_[qp][r] = (alpha * A->A2d_[pq][r]) + (beta * A2d_[qp][r]);
-                }
-            }
-        }
-    }
-
-    else if (sort_type == 312) {
-#pragma omp parallel for
-        for (int p = 0; p < d1; p++) {
-            for (int q = 0; q < d2; q++) {
-                int pq = q + (p * d2);
-                for (int r = 0; r < d3; r++) {
-                    int rp = p + (r * d1);
-                    A2d_[rp][q] = (alpha * A->A2d_[pq][r]) + (beta * A2d_[rp][q]);
-                }
-            }
-        }
-    }
-
-    else if (sort_type == 231) {
-#pragma omp parallel for
-        for (int p = 0; p < d1; p++) {
-            for (int q = 0; q < d2; q++) {
-                int pq = q + (p * d2);
-                for (int r = 0; r < d3; r++) {
-                    int qr = r + (q * d3);
-                    A2d_[qr][p] = (alpha * A->A2d_[pq][r]) + (beta * A2d_[qr][p]);
-                }
-            }
-        }
-    }
-
-    else if (sort_type == 321) {
-#pragma omp parallel for
-        for (int p = 0; p < d1; p++) {
-            for (int q = 0; q < d2; q++) {
-                int pq = q + (p * d2);
-                for (int r = 0; r < d3; r++) {
-                    int rq = q + (r * d2);
-                    A2d_[rq][p] = (alpha * A->A2d_[pq][r]) + (beta * A2d_[rq][p]);
-                }
-            }
-        }
-    }
-
-    else {
-        outfile->Printf("\tUnrecognized sort type!\n");
-        throw PSIEXCEPTION("Unrecognized sort type!");
-    }
-
+    sort3a(sort_type, d1, d2, d3, A, alpha, beta);
 }  //
 
 void Tensor2d::apply_denom(int frzc, int occ, const SharedTensor2d &fock) {
@@ -3947,143 +3423,48 @@ void Tensor2d::form_ooAB(const SharedTensor2d &A) {
     }
 }  //
 
-void Tensor2d::form_b_ij(int frzc, const SharedTensor2d &A) {
+// The form_b_* slices copy, for every auxiliary index Q, a block of rows of
+// the (Q|pq) pair matrix of A: C(Q,i,j) = A(Q,i+ioff,j+joff). Each row of the
+// block is a contiguous run in both tensors.
+void Tensor2d::form_b_block(int ioff, int joff, const SharedTensor2d &A) {
+    int naux = d1_;
+    int ni = d2_;
+    int nj = d3_;
+    int ncol = A->d3_;
 #pragma omp parallel for
-    for (int Q = 0; Q < d1_; Q++) {
-        for (int i = 0; i < d2_; i++) {
-            for (int j = 0; j < d3_; j++) {
-                int ij = col_idx_[i][j];
-                int oo = A->col_idx_[i + frzc][j + frzc];
-                A2d_[Q][ij] = A->get(Q, oo);
-            }
-        }
+    for (int Q = 0; Q < naux; Q++) {
+        double *a = A->A2d_[Q] + (size_t)ioff * ncol + joff;
+        double *c = A2d_[Q];
+        for (int i = 0; i < ni; i++) C_DCOPY(nj, a + (size_t)i * ncol, 1, c + (size_t)i * nj, 1);
     }
 }  //
 
-void Tensor2d::form_b_ia(int frzc, const SharedTensor2d &A) {
-#pragma omp parallel for
-    for (int Q = 0; Q < d1_; Q++) {
-        for (int i = 0; i < d2_; i++) {
-            for (int a = 0; a < d3_; a++) {
-                int ia = col_idx_[i][a];
-                int ov = A->col_idx_[i + frzc][a];
-                A2d_[Q][ia] = A->get(Q, ov);
-            }
-        }
-    }
-}  //
+void Tensor2d::form_b_ij(int frzc, const SharedTensor2d &A) { form_b_block(frzc, frzc, A); }  //
 
-void Tensor2d::form_b_ab(const SharedTensor2d &A) {
-#pragma omp parallel for
-    for (int Q = 0; Q < d1_; Q++) {
-        for (int a = 0; a < d2_; a++) {
-            for (int b = 0; b < d3_; b++) {
-                int ab = col_idx_[a][b];
-                int vv = A->col_idx_[a][b];
-                A2d_[Q][ab] = A->get(Q, vv);
-            }
-        }
-    }
-}  //
+void Tensor2d::form_b_ia(int frzc, const SharedTensor2d &A) { form_b_block(frzc, 0, A); }  //
+
+void Tensor2d::form_b_ab(const SharedTensor2d &A) { form_b_block(0, 0, A); }  //
 
 void Tensor2d::form_b_kl(const SharedTensor2d &A) {
-    int naux = d1_;
-    int aocc = d2_;
     int frzc = d3_;
-#pragma omp parallel for
-    for (int Q = 0; Q < naux; Q++) {
-        for (int i = 0; i < aocc; i++) {
-            for (int j = 0; j < frzc; j++) {
-                int ij = A->col_idx_[i + frzc][j];
-                int oo = col_idx_[i][j];
-                A2d_[Q][oo] = A->get(Q, ij);
-            }
-        }
-    }
+    form_b_block(frzc, 0, A);
 }  //
 
 void Tensor2d::form_b_ki(const SharedTensor2d &A) {
-    int naux = d1_;
-    int aocc = d2_;
-    int occ = d3_;
-    int frzc = occ - aocc;
-#pragma omp parallel for
-    for (int Q = 0; Q < naux; Q++) {
-        for (int i = 0; i < aocc; i++) {
-            for (int j = 0; j < occ; j++) {
-                int ij = A->col_idx_[i + frzc][j];
-                int oo = col_idx_[i][j];
-                A2d_[Q][oo] = A->get(Q, ij);
-            }
-        }
-    }
+    int frzc = d3_ - d2_;
+    form_b_block(frzc, 0, A);
 }  //
 
 void Tensor2d::form_b_ka(const SharedTensor2d &A) {
-    int naux = d1_;
-    int aocc = d2_;
-    int vir = d3_;
-    int occ = A->d2_;
-    int frzc = occ - aocc;
-#pragma omp parallel for
-    for (int Q = 0; Q < naux; Q++) {
-        for (int i = 0; i < aocc; i++) {
-            for (int j = 0; j < vir; j++) {
-                int ij = A->col_idx_[i + frzc][j];
-                int oo = col_idx_[i][j];
-                A2d_[Q][oo] = A->get(Q, ij);
-            }
-        }
-    }
+    int frzc = A->d2_ - d2_;
+    form_b_block(frzc, 0, A);
 }  //
 
-void Tensor2d::form_b_li(const SharedTensor2d &A) {
-    int naux = d1_;
-    int frzc = d2_;
-    int occ = d3_;
-#pragma omp parallel for
-    for (int Q = 0; Q < naux; Q++) {
-        for (int i = 0; i < frzc; i++) {
-            for (int j = 0; j < occ; j++) {
-                int ij = A->col_idx_[i][j];
-                int oo = col_idx_[i][j];
-                A2d_[Q][oo] = A->get(Q, ij);
-            }
-        }
-    }
-}  //
+void Tensor2d::form_b_li(const SharedTensor2d &A) { form_b_block(0, 0, A); }  //
 
-void Tensor2d::form_b_il(const SharedTensor2d &A) {
-    int naux = d1_;
-    int occ = d2_;
-    int frzc = d3_;
-#pragma omp parallel for
-    for (int Q = 0; Q < naux; Q++) {
-        for (int i = 0; i < occ; i++) {
-            for (int j = 0; j < frzc; j++) {
-                int ij = A->col_idx_[i][j];
-                int oo = col_idx_[i][j];
-                A2d_[Q][oo] = A->get(Q, ij);
-            }
-        }
-    }
-}  //
+void Tensor2d::form_b_il(const SharedTensor2d &A) { form_b_block(0, 0, A); }  //
 
-void Tensor2d::form_b_la(const SharedTensor2d &A) {
-    int naux = d1_;
-    int frzc = d2_;
-    int vir = d3_;
-#pragma omp parallel for
-    for (int Q = 0; Q < naux; Q++) {
-        for (int i = 0; i < frzc; i++) {
-            for (int j = 0; j < vir; j++) {
-                int ij = A->col_idx_[i][j];
-                int oo = col_idx_[i][j];
-                A2d_[Q][oo] = A->get(Q, ij);
-            }
-        }
-    }
-}  //
+void Tensor2d::form_b_la(const SharedTensor2d &A) { form_b_block(0, 0, A); }  //
 
 void Tensor2d::symmetrize() {
     SharedTensor2d temp = std::make_shared<Tensor2d>(dim2_, dim1_);
@@ -6636,7 +6017,12 @@ Tensor3d::~Tensor3d() { release(); }  //
 
 void Tensor3d::memalloc() {
     if (A3d_) release();
-    A3d_ = init_3d_array(dim1_, dim2_, dim3_);
+    size_t nrow = (size_t)dim1_ * dim2_;
+    double *block = new double[nrow * dim3_];
+    double **rows = new double *[nrow];
+    A3d_ = new double **[dim1_];
+    for (size_t n = 0; n < nrow; n++) rows[n] = block + n * dim3_;
+    for (int h = 0; h < dim1_; h++) A3d_[h] = rows + (size_t)h * dim2_;
     zero();
 }  //
 
@@ -6655,7 +6041,9 @@ void Tensor3d::init(std::string name, int d1, int d2, int d3) {
     memalloc();
 }  //
 
-void Tensor3d::zero() { memset(&(A3d_[0][0][0]), 0, sizeof(double) * dim1_ * dim2_ * dim3_); }  //
+void Tensor3d::zero() {
+    if (dim1_ && dim2_) memset(A3d_[0][0], 0, sizeof(double) * dim1_ * dim2_ * dim3_);
+}  //
 
 void Tensor3d::print() {
     if (name_.length()) outfile->Printf("\n ## %s ##\n", name_.c_str());
@@ -6668,7 +6056,11 @@ void Tensor3d::print() {
 
 void Tensor3d::release() {
     if (!A3d_) return;
-    free_3d_array(A3d_, dim1_, dim2_);
+    if (dim1_ && dim2_) {
+        delete[] A3d_[0][0];
+        delete[] A3d_[0];
+    }
+    delete[] A3d_;
     A3d_ = NULL;
 }  //
 
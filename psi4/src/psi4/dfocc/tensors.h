@@ -136,6 +136,7 @@ class Tensor1d {
 
 class Tensor2d {
    private:
+    // A2d_ is a block_matrix: the rows point into one contiguous row-major block
     double **A2d_;
     int dim1_, dim2_, d1_, d2_, d3_, d4_;
     int **row_idx_, **col_idx_;
@@ -356,6 +357,7 @@ class Tensor2d {
 
     // sort (for example 1432 sort): A2d_(ps,rq) = A(pq,rs)
     // A2d_ = alpha*A + beta*A2d_
+    // Threaded; sorts that move the last index are done in cache-sized tiles
     void sort(int sort_type, const SharedTensor2d &A, double alpha, double beta);
     // A2d_[p][qr] = sort(A[p][qr])
     void sort3a(int sort_type, int d1, int d2, int d3, const SharedTensor2d &A, double alpha, double beta);
@@ -432,6 +434,8 @@ class Tensor2d {
     void form_act_ov(int frzc, int occ, const SharedTensor2d &A);
     void form_ooAB(const SharedTensor2d &A);
 
+    // form_b_block: A2d_[Q][ij] = A[Q][(i+ioff)(j+joff)], the kernel behind the form_b_* slices
+    void form_b_block(int ioff, int joff, const SharedTensor2d &A);
     void form_b_ij(int frzc, const SharedTensor2d &A);
     void form_b_ia(int frzc, const SharedTensor2d &A);
     void form_b_ab(const SharedTensor2d &A);
@@ -532,6 +536,7 @@ class Tensor2d {
 
 class Tensor3d {
    private:
+    // A3d_[h] is a block_matrix view into one contiguous dim1_*dim2_*dim3_ block
     double ***A3d_;
     int dim1_, dim2_, dim3_;
     std::string name_;  // Name of the array
@@ -59,7 +59,7 @@ void DFOCC::uccsd_triples_hm()
 {
     pair_index();
 
-    outfile->Printf("\tUsing high-memory disk algorithm...\n\n");
+    if (!do_triples_direct) outfile->Printf("\tUsing high-memory disk algorithm...\n\n");
 
     timer_on("CCSD(T)-HM-AAA");
     //==================================================
@@ -67,49 +67,52 @@ void DFOCC::uccsd_triples_hm()
     //==================================================
     // N1 : beginning of AAA
 
-    // form <IA||BC>
+    // form <IA||BC>, unless it is formed on the fly
     // 'c' letter mean compact
-    SharedTensor2d Jc_I_ABC = std::make_shared<Tensor2d>("J[I] (A|B>=C)", navirA, ntri_abAA);
-    //SharedTensor2d J_I_ABC = std::make_shared<Tensor2d>("J[I] (A|BC)", navirA, navirA, navirA);
-    SharedTensor2d G_I_ABC = std::make_shared<Tensor2d>("G[I] <A||BC>", navirA, navirA, navirA);
-    SharedTensor2d bQabA_c = std::make_shared<Tensor2d>("DF_BASIS_CC B (Q|AB)", nQ, ntri_abAA);
-    bQabA_c->read(psio_, PSIF_DFOCC_INTS);
-    SharedTensor2d biaQA = std::make_shared<Tensor2d>("B (IA|Q)", naoccA * navirA, nQ);
-    biaQA->trans(bQiaA);
-
-    for (long int i = 0; i < naoccA; i++) {
-        bool flag = (i == 0) ? false : true;
-        // [I](A|B>=C) = [I](A|Q) * (Q|A>=B)
-        Jc_I_ABC->contract(false, false, navirA, ntri_abAA, nQ, biaQA, bQabA_c, i * navirA * nQ, 0, 1.0, 0.0);
-
-        // expand [I](A|B>=C) to [I](A|BC)
-        // [I]<B||AC> = [I]<B|AC> - [I]<B|CA>
-        //            = [I](A|BC) - [I](C|BA)
-        for (long int a = 0; a < navirA; a++) {
-            for (long int b = 0; b < navirA; b++) {
-                long int ab = ab_idxAA->get(a, b);
-                long int ba = ab_idxAA->get(b, a);
-                for (int c = 0; c < navirA; c++) {
-                    long int ac = ab_idxAA->get(a, c);
-                    long int ca = ab_idxAA->get(c, a);
-                    long int bc = ab_idxAA->get(b, c);
-                    //double val = Jc_I_ABC->get(a, index2(b, c)); // for only expand
-                    //J_I_ABC->set(a, bc, val); // for only expand
-                    //J_I_ABC->set(b, ac, val); // for only sort
-                    double val = Jc_I_ABC->get(b, index2(a, c)) - Jc_I_ABC->get(c, index2(b, a)); // for expand, sort and subtract (anti-symmetrization)
-                    G_I_ABC->set(a, bc, val); // for expand, sort and subtract (anti-symmetrization)
-                } // c
-            } // b
-        } // a
-
-        // write [I]<A||BC> to disk
-        G_I_ABC->mywrite(psio_, PSIF_DFOCC_IABC_AAAA, flag);
-    } // i
-
-    Jc_I_ABC.reset();
-    G_I_ABC.reset();
-    bQabA_c.reset();
-    //J_I_ABC.reset();
+    SharedTensor2d Jc_I_ABC, G_I_ABC, bQabA_c, biaQA;
+    if (!do_triples_direct) {
+        Jc_I_ABC = std::make_shared<Tensor2d>("J[I] (A|B>=C)", navirA, ntri_abAA);
+        //SharedTensor2d J_I_ABC = std::make_shared<Tensor2d>("J[I] (A|BC)", navirA, navirA, navirA);
+        G_I_ABC = std::make_shared<Tensor2d>("G[I] <A||BC>", navirA, navirA, navirA);
+        bQabA_c = std::make_shared<Tensor2d>("DF_BASIS_CC B (Q|AB)", nQ, ntri_abAA);
+        bQabA_c->read(psio_, PSIF_DFOCC_INTS);
+        biaQA = std::make_shared<Tensor2d>("B (IA|Q)", naoccA * navirA, nQ);
+        biaQA->trans(bQiaA);
+
+        for (long int i = 0; i < naoccA; i++) {
+            bool flag = (i == 0) ? false : true;
+            // [I](A|B>=C) = [I](A|Q) * (Q|A>=B)
+            Jc_I_ABC->contract(false, false, navirA, ntri_abAA, nQ, biaQA, bQabA_c, i * navirA * nQ, 0, 1.0, 0.0);
+
+            // expand [I](A|B>=C) to [I](A|BC)
+            // [I]<B||AC> = [I]<B|AC> - [I]<B|CA>
+            //            = [I](A|BC) - [I](C|BA)
+            for (long int a = 0; a < navirA; a++) {
+                for (long int b = 0; b < navirA; b++) {
+                    long int ab = ab_idxAA->get(a, b);
+                    long int ba = ab_idxAA->get(b, a);
+                    for (int c = 0; c < navirA; c++) {
+                        long int ac = ab_idxAA->get(a, c);
+                        long int ca = ab_idxAA->get(c, a);
+                        long int bc = ab_idxAA->get(b, c);
+                        //double val = Jc_I_ABC->get(a, index2(b, c)); // for only expand
+                        //J_I_ABC->set(a, bc, val); // for only expand
+                        //J_I_ABC->set(b, ac, val); // for only sort
+                        double val = Jc_I_ABC->get(b, index2(a, c)) - Jc_I_ABC->get(c, index2(b, a)); // for expand, sort and subtract (anti-symmetrization)
+                        G_I_ABC->set(a, bc, val); // for expand, sort and subtract (anti-symmetrization)
+                    } // c
+                } // b
+            } // a
+
+            // write [I]<A||BC> to disk
+            G_I_ABC->mywrite(psio_, PSIF_DFOCC_IABC_AAAA, flag);
+        } // i
+
+        Jc_I_ABC.reset();
+        G_I_ABC.reset();
+        bQabA_c.reset();
+        //J_I_ABC.reset();
+    }
 
     // form <IJ||AK>
     // (IA|JK) = bQiaA * bQijA
@@ -164,20 +167,20 @@ void DFOCC::uccsd_triples_hm()
     for (long int i = 0; i < naoccA; i++) {
         double Di = FockA->get(i + nfrzc, i + nfrzc);
 
-        // read G[I](A,BC)
-        G_I_ABC->myread(psio_, PSIF_DFOCC_IABC_AAAA, (size_t)(i * navirA * navir2AA) * sizeof(double));
+        // get G[I](A,BC)
+        uccsd_iabc_block(PSIF_DFOCC_IABC_AAAA, i, G_I_ABC);
         for(long int j = 0; j < i; j++) {
             long int ij = ij_idxAA->get(i, j);
             double Dij = Di + FockA->get(j + nfrzc, j + nfrzc);
 
-            // read G[J](A,BC)
-            G_J_ABC->myread(psio_, PSIF_DFOCC_IABC_AAAA, (size_t)(j * navirA * navir2AA) * sizeof(double));
+            // get G[J](A,BC)
+            uccsd_iabc_block(PSIF_DFOCC_IABC_AAAA, j, G_J_ABC);
             for (long int k = 0; k < j; k++) {
                 long int kj = ij_idxAA->get(k, j);
                 long int ik = ij_idxAA->get(i, k);
 
-                // read G[K](A,BC)
-                G_K_ABC->myread(psio_, PSIF_DFOCC_IABC_AAAA, (size_t)(k * navirA * navir2AA) * sizeof(double));
+                // get G[K](A,BC)
+                uccsd_iabc_block(PSIF_DFOCC_IABC_AAAA, k, G_K_ABC);
 
                 // X_AAA[IJK](A,CB) = \sum(E) t_IJ^AE <KE||CB>          (1)
                 // X_AAA[IJK](A,CB) = \sum(E) T[IJ](A,E) G[K](E,CB)
@@ -287,48 +290,51 @@ void DFOCC::uccsd_triples_hm()
     //==================================================
     // N4 : beginning of BBB
 
-    // form <ia||bc>
+    // form <ia||bc>, unless it is formed on the fly
     // 'c' letter mean compact
-    SharedTensor2d Jc_i_abc = std::make_shared<Tensor2d>("J[i] (a|b>=c)", navirB, ntri_abBB);
-    //SharedTensor2d J_i_abc = std::make_shared<Tensor2d>("J[i] (a|bc)", navirB, navirB, navirB);
-    SharedTensor2d G_i_abc = std::make_shared<Tensor2d>("G[i] <a||bc>", navirB, navirB, navirB);
-    SharedTensor2d bQabB_c = std::make_shared<Tensor2d>("DF_BASIS_CC B (Q|ab)", nQ, ntri_abBB);
-    bQabB_c->read(psio_, PSIF_DFOCC_INTS);
-    SharedTensor2d biaQB = std::make_shared<Tensor2d>("B (ia|Q)", naoccB * navirB, nQ);
-    biaQB->trans(bQiaB);
-
-    for (long int i = 0; i < naoccB; i++) {
-        bool flag = (i == 0) ? false : true;
-        // [i](a|b>=c) = [i](a|Q) * (Q|a>=b)
-        Jc_i_abc->contract(false, false, navirB, ntri_abBB, nQ, biaQB, bQabB_c, i * navirB * nQ, 0, 1.0, 0.0);
-
-        // expand [i](a|b>=c) TO [i](a|bc)
-        // [i]<b||ac> = [i]<b|ac> - [i]<b|ca>
-        //            = [i](a|bc) - [i](c|ba)
-        for (long int a = 0; a < navirB; a++) {
-            for (long int b = 0; b < navirB; b++) {
-                long int ab = ab_idxBB->get(a, b);
-                long int ba = ab_idxBB->get(b, a);
-                for (int c = 0; c < navirB; c++) {
-                    long int ac = ab_idxBB->get(a, c);
-                    long int ca = ab_idxBB->get(c, a);
-                    long int bc = ab_idxBB->get(b, c);
-                    //double val = Jc_i_abc->get(a, index2(b, c)); // for only expand
-                    //J_i_abc->set(a, bc, val); // for only expand
-                    //J_i_abc->set(b, ac, val); // for only sort
-                    double val = Jc_i_abc->get(b, index2(a, c)) - Jc_i_abc->get(c, index2(b, a)); // for expand, sort and subtract (anti-symmetrization)
-                    G_i_abc->set(a, bc, val); // for expand, sort and subtract (anti-symmetrization)
-                } // c
-            } // b
-        } // a
-
-        // write [i]<a||bc> to disk
-        G_i_abc->mywrite(psio_, PSIF_DFOCC_IABC_BBBB, flag);
-    } // i
-
-    G_i_abc.reset();
-    //J_i_abc.reset();
-    Jc_i_abc.reset();
+    SharedTensor2d Jc_i_abc, G_i_abc, bQabB_c, biaQB;
+    if (!do_triples_direct) {
+        Jc_i_abc = std::make_shared<Tensor2d>("J[i] (a|b>=c)", navirB, ntri_abBB);
+        //SharedTensor2d J_i_abc = std::make_shared<Tensor2d>("J[i] (a|bc)", navirB, navirB, navirB);
+        G_i_abc = std::make_shared<Tensor2d>("G[i] <a||bc>", navirB, navirB, navirB);
+        bQabB_c = std::make_shared<Tensor2d>("DF_BASIS_CC B (Q|ab)", nQ, ntri_abBB);
+        bQabB_c->read(psio_, PSIF_DFOCC_INTS);
+        biaQB = std::make_shared<Tensor2d>("B (ia|Q)", naoccB * navirB, nQ);
+        biaQB->trans(bQiaB);
+
+        for (long int i = 0; i < naoccB; i++) {
+            bool flag = (i == 0) ? false : true;
+            // [i](a|b>=c) = [i](a|Q) * (Q|a>=b)
+            Jc_i_abc->contract(false, false, navirB, ntri_abBB, nQ, biaQB, bQabB_c, i * navirB * nQ, 0, 1.0, 0.0);
+
+            // expand [i](a|b>=c) TO [i](a|bc)
+            // [i]<b||ac> = [i]<b|ac> - [i]<b|ca>
+            //            = [i](a|bc) - [i](c|ba)
+            for (long int a = 0; a < navirB; a++) {
+                for (long int b = 0; b < navirB; b++) {
+                    long int ab = ab_idxBB->get(a, b);
+                    long int ba = ab_idxBB->get(b, a);
+                    for (int c = 0; c < navirB; c++) {
+                        long int ac = ab_idxBB->get(a, c);
+                        long int ca = ab_idxBB->get(c, a);
+                        long int bc = ab_idxBB->get(b, c);
+                        //double val = Jc_i_abc->get(a, index2(b, c)); // for only expand
+                        //J_i_abc->set(a, bc, val); // for only expand
+                        //J_i_abc->set(b, ac, val); // for only sort
+                        double val = Jc_i_abc->get(b, index2(a, c)) - Jc_i_abc->get(c, index2(b, a)); // for expand, sort and subtract (anti-symmetrization)
+                        G_i_abc->set(a, bc, val); // for expand, sort and subtract (anti-symmetrization)
+                    } // c
+                } // b
+            } // a
+
+            // write [i]<a||bc> to disk
+            G_i_abc->mywrite(psio_, PSIF_DFOCC_IABC_BBBB, flag);
+        } // i
+
+        G_i_abc.reset();
+        //J_i_abc.reset();
+        Jc_i_abc.reset();
+    }
 
     // form <ij||ak>
     // (ia|jk) = bQiaB * bQijB
@@ -382,20 +388,20 @@ void DFOCC::uccsd_triples_hm()
     for (long int i = 0; i < naoccB; i++) {
         double Di = FockB->get(i + nfrzc, i + nfrzc);
 
-        // read G[i](a,bc)
-        G_i_abc->myread(psio_, PSIF_DFOCC_IABC_BBBB, (size_t)(i * navirB * navir2BB) * sizeof(double));
+        // get G[i](a,bc)
+        uccsd_iabc_block(PSIF_DFOCC_IABC_BBBB, i, G_i_abc);
         for(long int j = 0; j < i; j++) {
             long int ij = ij_idxBB->get(i, j);
             double Dij = Di + FockB->get(j + nfrzc, j + nfrzc);
 
-            // read G[j](a,bc)
-            G_j_abc->myread(psio_, PSIF_DFOCC_IABC_BBBB, (size_t)(j * navirB * navir2BB) * sizeof(double));
+            // get G[j](a,bc)
+            uccsd_iabc_block(PSIF_DFOCC_IABC_BBBB, j, G_j_abc);
             for (long int k = 0; k < j; k++) {
                 long int kj = ij_idxBB->get(k, j);
                 long int ik = ij_idxBB->get(i, k);
 
-                // read G[k](a,bc)
-                G_k_abc->myread(psio_, PSIF_DFOCC_IABC_BBBB, (size_t)(k * navirB * navir2BB) * sizeof(double));
+                // get G[k](a,bc)
+                uccsd_iabc_block(PSIF_DFOCC_IABC_BBBB, k, G_k_abc);
 
                 // X_BBB[ijk](a,cb) = \sum(e) t_ij^ae <ke||cb>          (1)
                 // X_BBB[ijk](a,cb) = \sum(e) T[ij](a,e) G[k](e,cb)
@@ -505,71 +511,75 @@ void DFOCC::uccsd_triples_hm()
     // N7 : beginning of AAB
     timer_on("CCSD(T)-HM-AAB");
 
-    // form <iA|bC>
-    SharedTensor2d Jc_i_aBC = std::make_shared<Tensor2d>("J[i] (a|B>=C)", navirB, ntri_abAA);
-    SharedTensor2d K_i_AbC = std::make_shared<Tensor2d>("K[i] <A|bC>", navirA, navirB, navirA);
-    bQabA_c = std::make_shared<Tensor2d>("DF_BASIS_CC B (Q|AB)", nQ, ntri_abAA);
-    bQabA_c->read(psio_, PSIF_DFOCC_INTS);
-    biaQB->trans(bQiaB);
-    for (long int i = 0; i < naoccB; i++) {
-        bool flag = (i == 0) ? false : true;
-        // [i](a|B>=C) = [i](a|Q) * (Q|A>=B)
-        Jc_i_aBC->contract(false, false, navirB, ntri_abAA, nQ, biaQB, bQabA_c, i * navirB * nQ, 0, 1.0, 0.0);
-
-        // expand [i](a|B>=C) to [i](a|BC)
-        // [i]<A|bC> = sort 213 [i](a|BC)
-        for (long int a = 0; a < navirB; a++) {
-            for (long int b = 0; b < navirA; b++) {
-                for (long int c = 0; c < navirA; c++) {
-                    long int ac = ab_idxBA->get(a, c);
-                    long int bc = ab_idxAA->get(b, c);
-                    double val = Jc_i_aBC->get(a, index2(b, c));
-                    K_i_AbC->set(b, ac, val);
-                } // c
-            } // b
-        } // a
-
-        // write [i]<A|bC> to disk
-        K_i_AbC->mywrite(psio_, PSIF_DFOCC_IABC_BABA, flag);
-    } // i
-
-    K_i_AbC.reset();
-    Jc_i_aBC.reset();
-    bQabA_c.reset();
-    biaQB.reset();
-
-    // form <Ia|Bc>
-    SharedTensor2d K_I_aBc = std::make_shared<Tensor2d>("K[I] <a|Bc>", navirB, navirA, navirB);
-    SharedTensor2d Jc_I_Abc = std::make_shared<Tensor2d>("J[I] (A|b>=c)", navirA, ntri_abBB);
-    bQabB_c->read(psio_, PSIF_DFOCC_INTS);
-    biaQA->trans(bQiaA);
-
-    for (long int i = 0; i < naoccA; i++) {
-        bool flag = (i == 0) ? false : true;
-        // [I](A|b>=c) = [I](A|Q) * (Q|a>=b)
-        Jc_I_Abc->contract(false, false, navirA, ntri_abBB, nQ, biaQA, bQabB_c, i * navirA * nQ, 0, 1.0, 0.0);
-
-        // expand [I](A|b>=c) to [I](A|bc)
-        // [I]<a|Bc> = sort 213 [I](A|bc)
-        for (long int a = 0; a < navirA; a++) {
-            for (long int b = 0; b < navirB; b++) {
-                for (long int c = 0; c < navirB; c++) {
-                    long int ac = ab_idxAB->get(a, c);
-                    long int bc = ab_idxBB->get(b, c);
-                    double val = Jc_I_Abc->get(a, index2(b, c));
-                    K_I_aBc->set(b, ac, val);
-                } // c
-            } // b
-        } // a
-
-        // write [I]<a|Bc> to disk
-        K_I_aBc->mywrite(psio_, PSIF_DFOCC_IABC_ABAB, flag);
-    } // i
-
-    K_I_aBc.reset();
-    Jc_I_Abc.reset();
-    bQabB_c.reset();
-    biaQA.reset();
+    // form <iA|bC> and <Ia|Bc>, unless they are formed on the fly
+    SharedTensor2d Jc_i_aBC, K_i_AbC, K_I_aBc, Jc_I_Abc;
+    if (!do_triples_direct) {
+        // form <iA|bC>
+        Jc_i_aBC = std::make_shared<Tensor2d>("J[i] (a|B>=C)", navirB, ntri_abAA);
+        K_i_AbC = std::make_shared<Tensor2d>("K[i] <A|bC>", navirA, navirB, navirA);
+        bQabA_c = std::make_shared<Tensor2d>("DF_BASIS_CC B (Q|AB)", nQ, ntri_abAA);
+        bQabA_c->read(psio_, PSIF_DFOCC_INTS);
+        biaQB->trans(bQiaB);
+        for (long int i = 0; i < naoccB; i++) {
+            bool flag = (i == 0) ? false : true;
+            // [i](a|B>=C) = [i](a|Q) * (Q|A>=B)
+            Jc_i_aBC->contract(false, false, navirB, ntri_abAA, nQ, biaQB, bQabA_c, i * navirB * nQ, 0, 1.0, 0.0);
+
+            // expand [i](a|B>=C) to [i](a|BC)
+            // [i]<A|bC> = sort 213 [i](a|BC)
+            for (long int a = 0; a < navirB; a++) {
+                for (long int b = 0; b < navirA; b++) {
+                    for (long int c = 0; c < navirA; c++) {
+                        long int ac = ab_idxBA->get(a, c);
+                        long int bc = ab_idxAA->get(b, c);
+                        double val = Jc_i_aBC->get(a, index2(b, c));
+                        K_i_AbC->set(b, ac, val);
+                    } // c
+                } // b
+            } // a
+
+            // write [i]<A|bC> to disk
+            K_i_AbC->mywrite(psio_, PSIF_DFOCC_IABC_BABA, flag);
+        } // i
+
+        K_i_AbC.reset();
+        Jc_i_aBC.reset();
+        bQabA_c.reset();
+        biaQB.reset();
+
+        // form <Ia|Bc>
+        K_I_aBc = std::make_shared<Tensor2d>("K[I] <a|Bc>", navirB, navirA, navirB);
+        Jc_I_Abc = std::make_shared<Tensor2d>("J[I] (A|b>=c)", navirA, ntri_abBB);
+        bQabB_c->read(psio_, PSIF_DFOCC_INTS);
+        biaQA->trans(bQiaA);
+
+        for (long int i = 0; i < naoccA; i++) {
+            bool flag = (i == 0) ? false : true;
+            // [I](A|b>=c) = [I](A|Q) * (Q|a>=b)
+            Jc_I_Abc->contract(false, false, navirA, ntri_abBB, nQ, biaQA, bQabB_c, i * navirA * nQ, 0, 1.0, 0.0);
+
+            // expand [I](A|b>=c) to [I](A|bc)
+            // [I]<a|Bc> = sort 213 [I](A|bc)
+            for (long int a = 0; a < navirA; a++) {
+                for (long int b = 0; b < navirB; b++) {
+                    for (long int c = 0; c < navirB; c++) {
+                        long int ac = ab_idxAB->get(a, c);
+                        long int bc = ab_idxBB->get(b, c);
+                        double val = Jc_I_Abc->get(a, index2(b, c));
+                        K_I_aBc->set(b, ac, val);
+                    } // c
+                } // b
+            } // a
+
+            // write [I]<a|Bc> to disk
+            K_I_aBc->mywrite(psio_, PSIF_DFOCC_IABC_ABAB, flag);
+        } // i
+
+        K_I_aBc.reset();
+        Jc_I_Abc.reset();
+        bQabB_c.reset();
+        biaQA.reset();
+    }
 
     // form <Ij|Ka>
     SharedTensor2d J_IJka = std::make_shared<Tensor2d>("DF_BASIS_CC MO Ints (IJ|ka)", naoccA, naoccA, naoccB, navirB);
@@ -634,9 +644,9 @@ void DFOCC::uccsd_triples_hm()
                 long int ik = ij_idxAB->get(i, k);
                 long int jk = ij_idxAB->get(j, k);
 
-                // read K[k](A,bC)
+                // get K[k](A,bC)
                 K_i_AbC = std::make_shared<Tensor2d>("K[i] <A|bC>", navirA, navirB, navirA);
-                K_i_AbC->myread(psio_, PSIF_DFOCC_IABC_BABA, (size_t)(k * navirB * navir2AA) * sizeof(double));
+                uccsd_iabc_block(PSIF_DFOCC_IABC_BABA, k, K_i_AbC);
 
                 Waux = std::make_shared<Tensor2d>("X[IJk](A, cB)", navirA, navirB, navirA);
                 // Waux[IJk](A,cB) = \sum(E) t_IJ^AE <kE|cB>          (1)
@@ -675,17 +685,17 @@ void DFOCC::uccsd_triples_hm()
                 }
                 Waux.reset();
 
-                // read G[I](A,BC)
+                // get G[I](A,BC)
                 G_I_ABC = std::make_shared<Tensor2d>("G[I] <A||BC>", navirA, navirA, navirA);
-                G_I_ABC->myread(psio_, PSIF_DFOCC_IABC_AAAA, (size_t)(i * navirA * navir2AA) * sizeof(double));
+                uccsd_iabc_block(PSIF_DFOCC_IABC_AAAA, i, G_I_ABC);
 
                 // W_AAB[IJk](AB,c) = \sum(E) t_Jk^Ec <IE||AB>         (3)
                 // W_AAB[IJk](AB,c) = \sum(E) G[I](E,AB) T[Jk](E,c)
                 W_AAB->contract(true, false, navir2AA, navirB, navirA, G_I_ABC, t2AB,
                         0, (j * naoccB * navirA * navirB) + (k * navirA * navirB), 1.0, 1.0);
 
-                // read G[J](A,BC)
-                G_I_ABC->myread(psio_, PSIF_DFOCC_IABC_AAAA, (size_t)(j * navirA * navir2AA) * sizeof(double));
+                // get G[J](A,BC)
+                uccsd_iabc_block(PSIF_DFOCC_IABC_AAAA, j, G_I_ABC);
 
                 // W_AAB[IJk](AB,c) -= \sum(E) t_Ik^Ec <JE||AB>        (4)
                 // W_AAB[IJk](AB,c) -= \sum(E) G[J](E,AB) T[Ik](E,c)
@@ -703,9 +713,9 @@ void DFOCC::uccsd_triples_hm()
                 W_AAB->contract(true, false, navir2AA, navirB, naoccA, t2AA, K_IjKa,
                         (i * naoccA * navir2AA), (j * naoccB * naoccA * navirB) + (k * naoccA * navirB), -1.0, 1.0);
 
-                // read K[J](a,Bc)
+                // get K[J](a,Bc)
                 K_I_aBc = std::make_shared<Tensor2d>("K[I] <a|Bc>", navirB, navirA, navirB);
-                K_I_aBc->myread(psio_, PSIF_DFOCC_IABC_ABAB, (size_t)(j * navirB * navirA * navirB) * sizeof(double));
+                uccsd_iabc_block(PSIF_DFOCC_IABC_ABAB, j, K_I_aBc);
 
                 Waux = std::make_shared<Tensor2d>("X[IJk](A, Bc)", navirA, navirA, navirB);
 
@@ -714,8 +724,8 @@ void DFOCC::uccsd_triples_hm()
                 Waux->contract(false, false, navirA, navirA * navirB, navirB, t2AB, K_I_aBc,
                         (i * naoccB * navirA * navirB) + (k * navirA * navirB), 0, 1.0, 0.0);
 
-                // read K[I](a,Bc)
-                K_I_aBc->myread(psio_, PSIF_DFOCC_IABC_ABAB, (size_t)(i * navirB * navirA * navirB) * sizeof(double));
+                // get K[I](a,Bc)
+                uccsd_iabc_block(PSIF_DFOCC_IABC_ABAB, i, K_I_aBc);
 
                 // Waux[IJk](A,Bc) -= \sum(e) t_Jk^Ae <Ie|Bc>         (8)
                 // Waux[IJk](A,Bc) -= \sum(e) T[Jk](A,e) K[I](e,Bc)
@@ -831,6 +841,12 @@ void DFOCC::uccsd_triples_hm()
     Nijk = naoccA * naoccB * (naoccB - 1) / 2;
     outfile->Printf("\n\tNumber of ijk combinations for ABB: %i \n", Nijk);
 
+    // read <ij||ab> and <Ij|Ab>
+    G_ijab = std::make_shared<Tensor2d>("G <ij||ab>", naoccB, naoccB, navirB, navirB);
+    G_ijab->read(psio_, PSIF_DFOCC_IJAB_BBBB);
+    K_IjAb = std::make_shared<Tensor2d>("K <Ij|Ab>", naoccA, naoccB, navirA, navirB);
+    K_IjAb->read(psio_, PSIF_DFOCC_IJAB_ABAB);
+
     // N11 : main loop of ABB
     double sumABB = 0.0;
     for (long int i = 0; i < naoccA; i++) {
@@ -845,17 +861,17 @@ void DFOCC::uccsd_triples_hm()
                 long int ik = ij_idxAB->get(i, k);
                 long int jk = ij_idxBB->get(j, k);
 
-                // read G[k](a,bc)
+                // get G[k](a,bc)
                 G_i_abc = std::make_shared<Tensor2d>("G[i] <a||bc>", navirB, navirB, navirB);
-                G_i_abc->myread(psio_, PSIF_DFOCC_IABC_BBBB, (size_t)(k * navirB * navir2BB) * sizeof(double));
+                uccsd_iabc_block(PSIF_DFOCC_IABC_BBBB, k, G_i_abc);
 
                 // W_ABB[Ijk](A,cb) = \sum(e) t_Ij^Ae <ke||cb>          (1)
                 // W_ABB[Ijk](A,cb) = T[Ij](A,e) G[k](e,cb)
                 W_ABB->contract(false, false, navirA, navir2BB, navirB, t2AB, G_i_abc,
                         (i * naoccB * navirA * navirB) + (j * navirA * navirB), 0, 1.0, 0.0);
 
-                // read G[j](a,bc)
-                G_i_abc->myread(psio_, PSIF_DFOCC_IABC_BBBB, (size_t)(j * navirB * navir2BB) * sizeof(double));
+                // get G[j](a,bc)
+                uccsd_iabc_block(PSIF_DFOCC_IABC_BBBB, j, G_i_abc);
                 // W_ABB[Ijk](A,cb) = \sum(e) t_Ik^Ae <je||cb>          (2)
                 // W_ABB[Ijk](A,cb) = T[Ik](A,e) G[j](e,cb)
                 W_ABB->contract(false, false, navirA, navir2BB, navirB, t2AB, G_i_abc,
@@ -891,9 +907,9 @@ void DFOCC::uccsd_triples_hm()
                     }
                 }
 
-                // read K[I](a,Bc)
+                // get K[I](a,Bc)
                 K_I_aBc = std::make_shared<Tensor2d>("K[I] <a|Bc>", navirB, navirA, navirB);
-                K_I_aBc->myread(psio_, PSIF_DFOCC_IABC_ABAB, (size_t)(i * navirB * navirA * navirB) * sizeof(double));
+                uccsd_iabc_block(PSIF_DFOCC_IABC_ABAB, i, K_I_aBc);
 
                 // Waux[Ijk](c,Ab) = \sum(e) t_kj^ce <Ie|Ab>        (6)
                 // Waux[Ijk](c,Ab) = T[kj](c,e) K[I](e,Ab)
@@ -915,17 +931,17 @@ void DFOCC::uccsd_triples_hm()
 
                 Waux = std::make_shared<Tensor2d>("X[Ijk](a,bC)", navirB, navirB, navirA);
 
-                // read K[k](A,bC)
+                // get K[k](A,bC)
                 K_i_AbC = std::make_shared<Tensor2d>("K[i] <A|bC>", navirA, navirB, navirA);
-                K_i_AbC->myread(psio_, PSIF_DFOCC_IABC_BABA, (size_t)(k * navirB * navir2AA) * sizeof(double));
+                uccsd_iabc_block(PSIF_DFOCC_IABC_BABA, k, K_i_AbC);
 
                 // Waux[Ijk](b,cA) = \sum(E) t_Ij^Eb <kE|cA>        (7)
                 // Waux[Ijk](b,cA) = T[Ij](E,b) K[k](E,cA)
                 Waux->contract(true, false, navirB, navirB * navirA, navirA, t2AB, K_i_AbC,
                         (i * naoccB * navirA * navirB) + (j * navirA * navirB), 0, 1.0, 0.0);
 
-                // read K[j](A,bC)
-                K_i_AbC->myread(psio_, PSIF_DFOCC_IABC_BABA, (size_t)(j * navirB * navir2AA) * sizeof(double));
+                // get K[j](A,bC)
+                uccsd_iabc_block(PSIF_DFOCC_IABC_BABA, j, K_i_AbC);
 
                 // Waux[Ijk](b,cA) = \sum(E) t_Ik^Eb <jE|cA>        (8)
                 // Waux[Ijk](b,cA) = T[Ik](E,b) K[j](E,cA)
@@ -968,13 +984,6 @@ void DFOCC::uccsd_triples_hm()
 
                 double Dijk = Dij + FockB->get(k + nfrzc, k + nfrzc);
 
-                // read <ij||ab>
-                G_ijab = std::make_shared<Tensor2d>("G <ij||ab>", naoccB, naoccB, navirB, navirB);
-                G_ijab->read(psio_, PSIF_DFOCC_IJAB_BBBB);
-
-                K_IjAb = std::make_shared<Tensor2d>("K <Ij|Ab>", naoccA, naoccB, navirA, navirB);
-                K_IjAb->read(psio_, PSIF_DFOCC_IJAB_ABAB);
-
                 double Wijkabc, Vijkabc;
 #pragma omp parallel for private(Wijkabc, Vijkabc) reduction(+ : sumABB)
                 for (long int a = 0; a < navirA; a++) {
@@ -1011,8 +1020,6 @@ void DFOCC::uccsd_triples_hm()
                         } // c
                     } // b
                 } // a
-                G_ijab.reset();
-                K_IjAb.reset();
 
                 // progress counter
                 ind += 1;
@@ -1034,6 +1041,8 @@ void DFOCC::uccsd_triples_hm()
     Eccsd_t = Eccsd + E_t;
 
     // reset all ABB things
+    G_ijab.reset();
+    K_IjAb.reset();
     W_ABB.reset();
     G_ijak.reset();
     K_IjAk.reset();
@@ -1044,10 +1053,12 @@ void DFOCC::uccsd_triples_hm()
     timer_off("CCSD(T)-HM-ABB");
 
     // remove files
-    remove_binary_file(PSIF_DFOCC_IABC_AAAA);
-    remove_binary_file(PSIF_DFOCC_IABC_BBBB);
-    remove_binary_file(PSIF_DFOCC_IABC_BABA);
-    remove_binary_file(PSIF_DFOCC_IABC_ABAB);
+    if (!do_triples_direct) {
+        remove_binary_file(PSIF_DFOCC_IABC_AAAA);
+        remove_binary_file(PSIF_DFOCC_IABC_BBBB);
+        remove_binary_file(PSIF_DFOCC_IABC_BABA);
+        remove_binary_file(PSIF_DFOCC_IABC_ABAB);
+    }
 
 } // uccsd_triples_hm()
 
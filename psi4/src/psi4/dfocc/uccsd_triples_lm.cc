@@ -0,0 +1,177 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Psi4: an open-source quantum chemistry software package
+ *
+ * Copyright (c) 2007-2023 The Psi4 Developers.
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This file is part of Psi4.
+ *
+ * Psi4 is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * Psi4 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with Psi4; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * @END LICENSE
+ */
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <algorithm>
+#include "dfocc.h"
+#include "defines.h"
+#include "psi4/libqt/qt.h"
+
+namespace psi {
+namespace dfoccwave {
+
+/*
+ * Low-memory UHF-CCSD(T) and UHF-CCSD(AT).
+ * The (ijk) loops are those of the _hm routines; only the source of the <ia||bc> blocks changes.
+ * Rather than writing all O*V^3 of them to disk, each G[i] block is assembled on the fly from
+ * B(ia|Q) and the compact B(Q|a>=b). If both compact B(Q|ab) fit into what is left of the memory
+ * they are kept in core, otherwise they are streamed from PSIF_DFOCC_INTS in batches of Q.
+ */
+
+void DFOCC::uccsd_triples_lm() {
+    uccsd_iabc_direct_init();
+    uccsd_triples_hm();
+    uccsd_iabc_direct_clear();
+}  // uccsd_triples_lm()
+
+void DFOCC::uccsdl_triples_lm() {
+    uccsd_iabc_direct_init();
+    uccsdl_triples_hm();
+    uccsd_iabc_direct_clear();
+}  // uccsdl_triples_lm()
+
+void DFOCC::uccsd_iabc_direct_init() {
+    do_triples_direct = true;
+
+    biaQA_iabc = std::make_shared<Tensor2d>("B (IA|Q)", naoccA * navirA, nQ);
+    biaQA_iabc->trans(bQiaA);
+    biaQB_iabc = std::make_shared<Tensor2d>("B (ia|Q)", naoccB * navirB, nQ);
+    biaQB_iabc->trans(bQiaB);
+
+    // Memory of the (ijk) loops: 5*O^2V^2 + 3*O^3V + 5*V^3 + 2*OVN + O^2N with the larger spin blocks
+    double naocc = MAX0(naoccA, naoccB);
+    double navir = MAX0(navirA, navirB);
+    double cost_loop = 5.0 * naocc * naocc * navir * navir;
+    cost_loop += 3.0 * naocc * naocc * naocc * navir;
+    cost_loop += 5.0 * navir * navir * navir;
+    cost_loop += 2.0 * nQ * ((double)naoccA * navirA + (double)naoccB * navirB);
+    cost_loop += (double)nQ * ((double)naoccA * naoccA + (double)naoccB * naoccB);
+    double avail = memory_mb * 1024.0 * 1024.0 / sizeof(double) - cost_loop;
+
+    // Keep both B(Q|a>=b) in core if possible, otherwise one batch of Q at a time
+    long int ntri_max = MAX0(ntri_abAA, ntri_abBB);
+    if (avail >= (double)nQ * (ntri_abAA + ntri_abBB)) {
+        nQ_iabc = nQ;
+        nbatch_iabc = 1;
+        bQabA_iabc = std::make_shared<Tensor2d>("DF_BASIS_CC B (Q|AB)", nQ, ntri_abAA);
+        bQabA_iabc->read(psio_, PSIF_DFOCC_INTS);
+        bQabB_iabc = std::make_shared<Tensor2d>("DF_BASIS_CC B (Q|ab)", nQ, ntri_abBB);
+        bQabB_iabc->read(psio_, PSIF_DFOCC_INTS);
+    } else {
+        nQ_iabc = (avail > 0.0) ? std::min((double)nQ, avail / ntri_max) : 0;
+        if (nQ_iabc < 1) throw PSIEXCEPTION("There is NOT enough memory for the (T) correction!");
+        nbatch_iabc = (nQ + nQ_iabc - 1) / nQ_iabc;
+    }
+
+    outfile->Printf("\tUsing low-memory direct algorithm...\n");
+    outfile->Printf("\tNumber of B(Q|ab) batches for (ia|bc) : %3d\n\n", nbatch_iabc);
+}  // uccsd_iabc_direct_init()
+
+void DFOCC::uccsd_iabc_direct_clear() {
+    do_triples_direct = false;
+    biaQA_iabc.reset();
+    biaQB_iabc.reset();
+    bQabA_iabc.reset();
+    bQabB_iabc.reset();
+}  // uccsd_iabc_direct_clear()
+
+/*
+ * Provide block i of one of the <ia||bc> files used by the UHF-(T) routines, in the layout the
+ * _hm routines write them:
+ *   PSIF_DFOCC_IABC_AAAA : G[I](A,BC) = <IA||BC>
+ *   PSIF_DFOCC_IABC_BBBB : G[i](a,bc) = <ia||bc>
+ *   PSIF_DFOCC_IABC_BABA : K[i](A,bC) = <iA|bC>
+ *   PSIF_DFOCC_IABC_ABAB : K[I](a,Bc) = <Ia|Bc>
+ */
+void DFOCC::uccsd_iabc_block(int fileno, long int i, SharedTensor2d &G) {
+    bool occ_alpha = (fileno == PSIF_DFOCC_IABC_AAAA || fileno == PSIF_DFOCC_IABC_ABAB);
+    bool vir_alpha = (fileno == PSIF_DFOCC_IABC_AAAA || fileno == PSIF_DFOCC_IABC_BABA);
+    long int nvo = occ_alpha ? navirA : navirB;
+    long int nvv = vir_alpha ? navirA : navirB;
+
+    if (!do_triples_direct) {
+        G->myread(psio_, fileno, (size_t)(i * nvo * nvv * nvv) * sizeof(double));
+        return;
+    }
+
+    SharedTensor2d biaQ = occ_alpha ? biaQA_iabc : biaQB_iabc;
+    SharedTensor2d bQab_c = vir_alpha ? bQabA_iabc : bQabB_iabc;
+    long int ntri = vir_alpha ? ntri_abAA : ntri_abBB;
+
+    // [i](a|b>=c) = \sum(Q) [i](a|Q) * (Q|b>=c)
+    SharedTensor2d Jc = std::make_shared<Tensor2d>("J[i] (a|b>=c)", nvo, ntri);
+    if (nbatch_iabc == 1) {
+        Jc->contract(false, false, nvo, ntri, nQ, biaQ, bQab_c, i * nvo * nQ, 0, 1.0, 0.0);
+    } else {
+        std::string label = vir_alpha ? "DF_BASIS_CC B (Q|AB)" : "DF_BASIS_CC B (Q|ab)";
+        psio_address addr = PSIO_ZERO;
+        for (long int Q0 = 0; Q0 < nQ; Q0 += nQ_iabc) {
+            long int nb = std::min((long int)nQ_iabc, nQ - Q0);
+            SharedTensor2d bQab_batch = std::make_shared<Tensor2d>(label, nb, ntri);
+            bQab_batch->read(psio_, PSIF_DFOCC_INTS, addr, &addr);
+            SharedTensor2d biQ = std::make_shared<Tensor2d>("B[i] (a|Q)", nvo, nb);
+#pragma omp parallel for
+            for (long int a = 0; a < nvo; a++) {
+                for (long int Q = 0; Q < nb; Q++) {
+                    biQ->set(a, Q, biaQ->get(i * nvo + a, Q0 + Q));
+                }
+            }
+            Jc->contract(false, false, nvo, ntri, nb, biQ, bQab_batch, 1.0, (Q0 == 0) ? 0.0 : 1.0);
+        }
+    }
+
+    if (fileno == PSIF_DFOCC_IABC_AAAA || fileno == PSIF_DFOCC_IABC_BBBB) {
+        // [i]<a||bc> = [i](b|ac) - [i](c|ab)
+        SharedTensor2i ab_idx = vir_alpha ? ab_idxAA : ab_idxBB;
+#pragma omp parallel for
+        for (long int a = 0; a < nvv; a++) {
+            for (long int b = 0; b < nvv; b++) {
+                for (long int c = 0; c < nvv; c++) {
+                    G->set(a, ab_idx->get(b, c), Jc->get(b, index2(a, c)) - Jc->get(c, index2(b, a)));
+                }
+            }
+        }
+    } else {
+        // [i]<b|ac> = [i](a|bc), a of the spin of i
+        SharedTensor2i ab_idx = occ_alpha ? ab_idxAB : ab_idxBA;
+#pragma omp parallel for
+        for (long int a = 0; a < nvo; a++) {
+            for (long int b = 0; b < nvv; b++) {
+                for (long int c = 0; c < nvv; c++) {
+                    G->set(b, ab_idx->get(a, c), Jc->get(a, index2(b, c)));
+                }
+            }
+        }
+    }
+}  // uccsd_iabc_block()
+
+}  // namespace dfoccwave
+}  // namespace psi
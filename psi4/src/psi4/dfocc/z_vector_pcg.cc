@@ -65,9 +65,10 @@ void DFOCC::z_vector_pcg() {
                 double value = FockA->get(a + noccA, a + noccA) - FockA->get(i, i);
                 // zvectorA->set(ai, -WorbA->get(a + noccA, i) / (2.0*value));
                 zvectorA->set(ai, -WvoA->get(a, i) / (2.0 * value));
-                Minv_pcgA->set(ai, 0.5 / value);
             }
         }
+        pcg_ints_init();
+        pcg_precond(Minv_pcgA, true, 0, 0.0);
 
         // Build S = A kappa_0
         sigma_rhf(sigma_pcgA, zvectorA);
@@ -88,6 +89,7 @@ void DFOCC::z_vector_pcg() {
 
         // Call Orbital Response Solver
         pcg_solver_rhf();
+        pcg_ints_clear();
 
         // Memfree
         zvec_newA.reset();
@@ -156,7 +158,6 @@ void DFOCC::z_vector_pcg() {
                 double value = FockA->get(a + noccA, a + noccA) - FockA->get(i, i);
                 // zvectorA->set(ai, -WorbA->get(a + noccA, i) / (2.0*value));
                 zvectorA->set(ai, -WvoA->get(a, i) / (2.0 * value));
-                Minv_pcg->set(ai, 0.5 / value);
             }
         }
 
@@ -166,9 +167,11 @@ void DFOCC::z_vector_pcg() {
                 double value = FockB->get(a + noccB, a + noccB) - FockB->get(i, i);
                 // zvectorB->set(ai, -WorbB->get(a + noccB, i) / (2.0*value));
                 zvectorB->set(ai, -WvoB->get(a, i) / (2.0 * value));
-                Minv_pcg->set(ai + nidpA, 0.5 / value);
             }
         }
+        pcg_ints_init();
+        pcg_precond(Minv_pcg, true, 0, 0.0);
+        pcg_precond(Minv_pcg, false, nidpA, 0.0);
 
         // Form initial zvector vector
         for (int ai = 0; ai < nidpA; ai++) zvector->set(ai, zvectorA->get(ai));
@@ -211,6 +214,7 @@ void DFOCC::z_vector_pcg() {
 
         // Call Orbital Response Solver
         pcg_solver_uhf();
+        pcg_ints_clear();
 
         // Memfree alpha
         zvec_new.reset();
@@ -514,6 +518,130 @@ void DFOCC::pcg_solver_uhf() {
 
 }  // end pcg_solver_uhf
 
+//=======================================================
+//          PCG integrals
+//=======================================================
+void DFOCC::pcg_ints_init() {
+    // The SCF B tensors do not change during a linear solve; keep them in core so that
+    // each sigma build is a pass over the same VO/OO/VV blocks instead of a re-read and re-sort.
+    pcg_ints_clear();
+    double cost_pcg = (double)nQ_ref * (2.0 * noccA * nvirA + noccA * noccA + nvirA * nvirA);
+    if (reference_ == "UNRESTRICTED") cost_pcg += (double)nQ_ref * (noccB * nvirB + noccB * noccB + nvirB * nvirB);
+    cost_pcg *= sizeof(double) / (1024.0 * 1024.0);
+    if (cost_pcg > memory_mb) {
+        outfile->Printf("\tPCG: B tensors will be read for each sigma (%9.2lf MB required in core).\n", cost_pcg);
+        return;
+    }
+
+    bQvoA_pcg = pcg_bQvo(true);
+    bQooA_pcg = pcg_bQoo(true);
+    bQvvA_pcg = pcg_bQvv(true);
+    if (reference_ == "UNRESTRICTED") {
+        bQvoB_pcg = pcg_bQvo(false);
+        bQooB_pcg = pcg_bQoo(false);
+        bQvvB_pcg = pcg_bQvv(false);
+    }
+}  // end pcg_ints_init
+
+void DFOCC::pcg_ints_clear() {
+    bQvoA_pcg.reset();
+    bQooA_pcg.reset();
+    bQvvA_pcg.reset();
+    bQvoB_pcg.reset();
+    bQooB_pcg.reset();
+    bQvvB_pcg.reset();
+}  // end pcg_ints_clear
+
+SharedTensor2d DFOCC::pcg_bQvo(bool alpha) {
+    if (alpha && bQvoA_pcg) return bQvoA_pcg;
+    if (!alpha && bQvoB_pcg) return bQvoB_pcg;
+
+    int nocc = alpha ? noccA : noccB;
+    int nvir = alpha ? nvirA : nvirB;
+    SharedTensor2d bQov = std::make_shared<Tensor2d>(alpha ? "DF_BASIS_SCF B (Q|OV)" : "DF_BASIS_SCF B (Q|ov)",
+                                                     nQ_ref, nocc, nvir);
+    bQov->read(psio_, PSIF_DFOCC_INTS);
+    SharedTensor2d bQvo = std::make_shared<Tensor2d>(alpha ? "DF_BASIS_SCF B (Q|VO)" : "DF_BASIS_SCF B (Q|vo)",
+                                                     nQ_ref, nvir, nocc);
+    bQvo->swap_3index_col(bQov);
+    return bQvo;
+}  // end pcg_bQvo
+
+SharedTensor2d DFOCC::pcg_bQoo(bool alpha) {
+    if (alpha && bQooA_pcg) return bQooA_pcg;
+    if (!alpha && bQooB_pcg) return bQooB_pcg;
+
+    int nocc = alpha ? noccA : noccB;
+    SharedTensor2d bQoo = std::make_shared<Tensor2d>(alpha ? "DF_BASIS_SCF B (Q|OO)" : "DF_BASIS_SCF B (Q|oo)",
+                                                     nQ_ref, nocc, nocc);
+    bQoo->read(psio_, PSIF_DFOCC_INTS);
+    return bQoo;
+}  // end pcg_bQoo
+
+SharedTensor2d DFOCC::pcg_bQvv(bool alpha) {
+    if (alpha && bQvvA_pcg) return bQvvA_pcg;
+    if (!alpha && bQvvB_pcg) return bQvvB_pcg;
+
+    int nvir = alpha ? nvirA : nvirB;
+    SharedTensor2d bQvv = std::make_shared<Tensor2d>(alpha ? "DF_BASIS_SCF B (Q|VV)" : "DF_BASIS_SCF B (Q|vv)",
+                                                     nQ_ref, nvir, nvir);
+    bQvv->read(psio_, PSIF_DFOCC_INTS, true, true);
+    return bQvv;
+}  // end pcg_bQvv
+
+//=======================================================
+//          PCG preconditioner
+//=======================================================
+void DFOCC::pcg_precond(SharedTensor1d& Minv, bool alpha, int offset, double shift) {
+    // Diagonal of the operator applied by sigma_rhf/sigma_uhf:
+    // A_ai,ai = 2(f_aa - f_ii) + (c_J - 2) \sum_{Q} (b_ai^Q)^2 - 2 \sum_{Q} b_aa^Q b_ii^Q
+    // with c_J = 8 (RHF) or 4 (UHF). Fall back to the Fock difference if the diagonal is not positive.
+    int nocc = alpha ? noccA : noccB;
+    int nvir = alpha ? nvirA : nvirB;
+    SharedTensor2d Fock = alpha ? FockA : FockB;
+    double cJ = (reference_ == "RESTRICTED") ? 8.0 : 4.0;
+
+    SharedTensor2d Jvo = std::make_shared<Tensor2d>("PCG J <V|O>", nvir, nocc);
+    SharedTensor2d Kvo = std::make_shared<Tensor2d>("PCG K <V|O>", nvir, nocc);
+    SharedTensor2d bQvo = pcg_bQvo(alpha);
+#pragma omp parallel for
+    for (int a = 0; a < nvir; a++) {
+        for (int i = 0; i < nocc; i++) {
+            int ai = i + a * nocc;
+            double sum = 0.0;
+            for (int Q = 0; Q < nQ_ref; Q++) sum += bQvo->get(Q, ai) * bQvo->get(Q, ai);
+            Jvo->set(a, i, sum);
+        }
+    }
+    bQvo.reset();
+
+    SharedTensor2d bQoo = pcg_bQoo(alpha);
+    SharedTensor2d bQvv = pcg_bQvv(alpha);
+#pragma omp parallel for
+    for (int a = 0; a < nvir; a++) {
+        int aa = a + a * nvir;
+        for (int i = 0; i < nocc; i++) {
+            int ii = i + i * nocc;
+            double sum = 0.0;
+            for (int Q = 0; Q < nQ_ref; Q++) sum += bQvv->get(Q, aa) * bQoo->get(Q, ii);
+            Kvo->set(a, i, sum);
+        }
+    }
+    bQoo.reset();
+    bQvv.reset();
+
+    for (int a = 0, ai = 0; a < nvir; a++) {
+        for (int i = 0; i < nocc; i++, ai++) {
+            double fock_diag = 2.0 * (Fock->get(a + nocc, a + nocc) - Fock->get(i, i)) + shift;
+            double value = fock_diag + (cJ - 2.0) * Jvo->get(a, i) - 2.0 * Kvo->get(a, i);
+            if (value <= 0.0) value = fock_diag;
+            Minv->set(ai + offset, 1.0 / value);
+        }
+    }
+    Jvo.reset();
+    Kvo.reset();
+}  // end pcg_precond
+
 //=======================================================
 //          Sigma (RHF)
 //=======================================================
@@ -538,11 +666,7 @@ void DFOCC::sigma_rhf(SharedTensor1d& sigma, SharedTensor1d& p_vec) {
     }
 
     // p_Q = 2\sum_{bj} b_bj^Q p_bj
-    bQovA = std::make_shared<Tensor2d>("DF_BASIS_SCF B (Q|OV)", nQ_ref, noccA, nvirA);
-    bQovA->read(psio_, PSIF_DFOCC_INTS);
-    SharedTensor2d bQvoA = std::make_shared<Tensor2d>("DF_BASIS_SCF B (Q|VO)", nQ_ref, nvirA, noccA);
-    bQvoA->swap_3index_col(bQovA);
-    bQovA.reset();
+    SharedTensor2d bQvoA = pcg_bQvo(true);
     pQ->gemv(false, bQvoA, p_vec, 2.0, 0.0);
 
     // s_ai += 4 \sum_{Q} bai^Q p^Q
@@ -558,15 +682,13 @@ void DFOCC::sigma_rhf(SharedTensor1d& sigma, SharedTensor1d& p_vec) {
     bQvoA.reset();
 
     // p_aj^Q = \sum_{b} b_ba^Q p_bj
-    bQvvA = std::make_shared<Tensor2d>("DF_BASIS_SCF B (Q|VV)", nQ_ref, nvirA, nvirA);
-    bQvvA->read(psio_, PSIF_DFOCC_INTS, true, true);
+    SharedTensor2d bQvvA = pcg_bQvv(true);
     SharedTensor2d pQvoA = std::make_shared<Tensor2d>("PCG P (Q|VO)", nQ_ref, nvirA, noccA);
     pQvoA->contract323(false, false, nvirA, noccA, bQvvA, PvoA, 1.0, 0.0);
     bQvvA.reset();
 
     // s_ai += -2 \sum_{Q} \sum_{j} b_ij^Q p_aj^Q
-    bQooA = std::make_shared<Tensor2d>("DF_BASIS_SCF B (Q|OO)", nQ_ref, noccA, noccA);
-    bQooA->read(psio_, PSIF_DFOCC_INTS);
+    SharedTensor2d bQooA = pcg_bQoo(true);
     SvoA->contract332(false, false, noccA, pQvoA, bQooA, -2.0, 1.0);
     bQooA.reset();
     pQvoA.reset();
@@ -615,20 +737,12 @@ void DFOCC::sigma_uhf(SharedTensor1d& sigma_A, SharedTensor1d& sigma_B, SharedTe
 
     // p_Q = \sum_{BJ} b_BJ^Q p_BJ + \sum_{bj} b_bj^Q p_bj
     // beta contribution
-    bQovB = std::make_shared<Tensor2d>("DF_BASIS_SCF B (Q|ov)", nQ_ref, noccB, nvirB);
-    bQovB->read(psio_, PSIF_DFOCC_INTS);
-    SharedTensor2d bQvoB = std::make_shared<Tensor2d>("DF_BASIS_SCF B (Q|vo)", nQ_ref, nvirB, noccB);
-    bQvoB->swap_3index_col(bQovB);
-    bQovB.reset();
+    SharedTensor2d bQvoB = pcg_bQvo(false);
     pQ->gemv(false, bQvoB, p_vecB, 1.0, 0.0);
     bQvoB.reset();
 
     // alpha contribution
-    bQovA = std::make_shared<Tensor2d>("DF_BASIS_SCF B (Q|OV)", nQ_ref, noccA, nvirA);
-    bQovA->read(psio_, PSIF_DFOCC_INTS);
-    SharedTensor2d bQvoA = std::make_shared<Tensor2d>("DF_BASIS_SCF B (Q|VO)", nQ_ref, nvirA, noccA);
-    bQvoA->swap_3index_col(bQovA);
-    bQovA.reset();
+    SharedTensor2d bQvoA = pcg_bQvo(true);
     pQ->gemv(false, bQvoA, p_vecA, 1.0, 1.0);
 
     // s_AI += 4 \sum_{Q} b_AI^Q p^Q
@@ -644,15 +758,13 @@ void DFOCC::sigma_uhf(SharedTensor1d& sigma_A, SharedTensor1d& sigma_B, SharedTe
     bQvoA.reset();
 
     // p_AJ^Q = \sum_{B} b_BA^Q p_BJ
-    bQvvA = std::make_shared<Tensor2d>("DF_BASIS_SCF B (Q|VV)", nQ_ref, nvirA, nvirA);
-    bQvvA->read(psio_, PSIF_DFOCC_INTS, true, true);
+    SharedTensor2d bQvvA = pcg_bQvv(true);
     SharedTensor2d pQvoA = std::make_shared<Tensor2d>("PCG P (Q|VO)", nQ_ref, nvirA, noccA);
     pQvoA->contract323(false, false, nvirA, noccA, bQvvA, PvoA, 1.0, 0.0);
     bQvvA.reset();
 
     // s_AI += -2 \sum_{Q} \sum_{J} b_IJ^Q p_AJ^Q
-    bQooA = std::make_shared<Tensor2d>("DF_BASIS_SCF B (Q|OO)", nQ_ref, noccA * noccA);
-    bQooA->read(psio_, PSIF_DFOCC_INTS);
+    SharedTensor2d bQooA = pcg_bQoo(true);
     SvoA->contract332(false, false, noccA, pQvoA, bQooA, -2.0, 1.0);
     bQooA.reset();
     pQvoA.reset();
@@ -679,11 +791,7 @@ void DFOCC::sigma_uhf(SharedTensor1d& sigma_A, SharedTensor1d& sigma_B, SharedTe
     }
 
     // s_ai += 4 \sum_{Q} bai^Q p^Q
-    bQovB = std::make_shared<Tensor2d>("DF_BASIS_SCF B (Q|ov)", nQ_ref, noccB, nvirB);
-    bQovB->read(psio_, PSIF_DFOCC_INTS);
-    bQvoB = std::make_shared<Tensor2d>("DF_BASIS_SCF B (Q|vo)", nQ_ref, nvirB, noccB);
-    bQvoB->swap_3index_col(bQovB);
-    bQovB.reset();
+    bQvoB = pcg_bQvo(false);
     SvoB->gemv(true, bQvoB, pQ, 4.0, 1.0);
     pQ.reset();
 
@@ -697,15 +805,13 @@ void DFOCC::sigma_uhf(SharedTensor1d& sigma_A, SharedTensor1d& sigma_B, SharedTe
     bQvoB.reset();
 
     // p_aj^Q = \sum_{b} b_ba^Q p_bj
-    bQvvB = std::make_shared<Tensor2d>("DF_BASIS_SCF B (Q|vv)", nQ_ref, nvirB, nvirB);
-    bQvvB->read(psio_, PSIF_DFOCC_INTS, true, true);
+    SharedTensor2d bQvvB = pcg_bQvv(false);
     SharedTensor2d pQvoB = std::make_shared<Tensor2d>("PCG P (Q|vo)", nQ_ref, nvirB, noccB);
     pQvoB->contract323(false, false, nvirB, noccB, bQvvB, PvoB, 1.0, 0.0);
     bQvvB.reset();
 
     // s_ai += -2 \sum_{Q} \sum_{j} b_ij^Q p_aj^Q
-    bQooB = std::make_shared<Tensor2d>("DF_BASIS_SCF B (Q|oo)", nQ_ref, noccB * noccB);
-    bQooB->read(psio_, PSIF_DFOCC_INTS);
+    SharedTensor2d bQooB = pcg_bQoo(false);
     SvoB->contract332(false, false, noccB, pQvoB, bQooB, -2.0, 1.0);
     bQooB.reset();
     pQvoB.reset();
@@ -0,0 +1,80 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Psi4: an open-source quantum chemistry software package
+ *
+ * Copyright (c) 2007-2023 The Psi4 Developers.
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This file is part of Psi4.
+ *
+ * Psi4 is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * Psi4 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with Psi4; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * @END LICENSE
+ */
+
+#include "arena.h"
+
+#include "psi4/libpsi4util/exception.h"
+#include "psi4/libqt/qt.h"
+
+#include <cstring>
+
+namespace psi {
+namespace dlpno {
+
+PairArena::PairArena() : offsets_(1, 0), data_(std::make_shared<Vector>(0)) {}
+
+PairArena::PairArena(const std::string& name, const std::vector<int>& rows, const std::vector<int>& cols)
+    : rows_(rows), cols_(cols), offsets_(rows.size() + 1, 0) {
+    if (rows.size() != cols.size()) throw PSIEXCEPTION("PairArena: row and column lists differ in length.");
+    for (size_t ij = 0; ij < rows.size(); ++ij) {
+        offsets_[ij + 1] = offsets_[ij] + rows[ij] * (size_t)cols[ij];
+    }
+    data_ = std::make_shared<Vector>(name, (int)offsets_.back());
+}
+
+SharedMatrix PairArena::matrix(int ij) const {
+    auto mat = std::make_shared<Matrix>(data_->name(), rows_[ij], cols_[ij]);
+    if (size(ij)) ::memcpy(mat->pointer()[0], block(ij), sizeof(double) * size(ij));
+    return mat;
+}
+
+void PairArena::set_matrix(int ij, const Matrix& mat) {
+    if (mat.rowspi(0) != rows_[ij] || mat.colspi(0) != cols_[ij]) {
+        throw PSIEXCEPTION("PairArena: matrix shape does not match the pair block.");
+    }
+    if (size(ij)) ::memcpy(block(ij), mat.pointer()[0], sizeof(double) * size(ij));
+}
+
+void PairArena::set_vector(int ij, const Vector& vec) {
+    if (vec.dimpi()[0] != size(ij)) throw PSIEXCEPTION("PairArena: vector length does not match the pair block.");
+    if (size(ij)) ::memcpy(block(ij), vec.pointer(), sizeof(double) * size(ij));
+}
+
+double PairArena::vector_dot(const PairArena& other) const {
+    if (other.offsets_ != offsets_) throw PSIEXCEPTION("PairArena: arenas of different shapes cannot be dotted.");
+    if (size() == 0) return 0.0;
+    return C_DDOT(size(), data_->pointer(), 1, other.data_->pointer(), 1);
+}
+
+double PairArena::vector_dot(int ij, const PairArena& other) const {
+    if (size(ij) == 0) return 0.0;
+    return C_DDOT(size(ij), block(ij), 1, other.block(ij), 1);
+}
+
+}  // namespace dlpno
+}  // namespace psi
@@ -0,0 +1,87 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Psi4: an open-source quantum chemistry software package
+ *
+ * Copyright (c) 2007-2023 The Psi4 Developers.
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This file is part of Psi4.
+ *
+ * Psi4 is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * Psi4 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with Psi4; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * @END LICENSE
+ */
+
+#ifndef PSI4_SRC_DLPNO_ARENA_H_
+#define PSI4_SRC_DLPNO_ARENA_H_
+
+#include "psi4/libmints/matrix.h"
+#include "psi4/libmints/vector.h"
+
+#include <string>
+#include <vector>
+
+namespace psi {
+namespace dlpno {
+
+/* One dense (rows x cols) block per LMO pair, stored back to back in a single
+ * Vector. Replaces a std::vector<SharedMatrix> with one allocation in total,
+ * and lets the whole set be handed to DIIS or dotted without flattening.
+ */
+class PairArena {
+   protected:
+    std::vector<int> rows_;
+    std::vector<int> cols_;
+    /// offset of each pair's block in data_, plus the total size at the end
+    std::vector<size_t> offsets_;
+    SharedVector data_;
+
+   public:
+    PairArena();
+    /// zero-initialized blocks of the given shapes
+    PairArena(const std::string& name, const std::vector<int>& rows, const std::vector<int>& cols);
+
+    int npair() const { return rows_.size(); }
+    int rows(int ij) const { return rows_[ij]; }
+    int cols(int ij) const { return cols_[ij]; }
+    size_t size(int ij) const { return offsets_[ij + 1] - offsets_[ij]; }
+    size_t size() const { return offsets_.back(); }
+
+    /// row-major block of pair ij
+    double* block(int ij) { return data_->pointer() + offsets_[ij]; }
+    const double* block(int ij) const { return data_->pointer() + offsets_[ij]; }
+
+    /// all blocks as one vector (shared, not copied)
+    SharedVector vector() const { return data_; }
+
+    /// copy of pair ij's block as a Matrix
+    SharedMatrix matrix(int ij) const;
+    /// copy a Matrix of matching shape into pair ij's block
+    void set_matrix(int ij, const Matrix& mat);
+    /// copy a Vector of matching length into pair ij's block
+    void set_vector(int ij, const Vector& vec);
+
+    /// sum over all pairs of the elementwise product with an arena of the same shapes
+    double vector_dot(const PairArena& other) const;
+    /// elementwise product of pair ij's blocks
+    double vector_dot(int ij, const PairArena& other) const;
+};
+
+}  // namespace dlpno
+}  // namespace psi
+
+#endif  // PSI4_SRC_DLPNO_ARENA_H_
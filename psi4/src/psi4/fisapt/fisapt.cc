@@ -5703,27 +5703,46 @@ void FISAPT::felst() {
     matrices_["Vlocc0B"] = QbC;
 
     // => Nuclear Part (PITA) <= //
-    auto Vfact2 = std::make_shared<IntegralFactory>(primary_);
-    std::shared_ptr<PotentialInt> Vint2(static_cast<PotentialInt*>(Vfact2->ao_potential().release()));
-    auto Vtemp2 = std::make_shared<Matrix>("Vtemp2", nn, nn);
+    //
+    // Only the diagonal of L^T V_A L is needed per nucleus, so each atom costs one
+    // (nn x nn) x (nn x nocc) product plus a column dot, and atoms run on separate threads.
 
+    auto Vfact2 = std::make_shared<IntegralFactory>(primary_);
+    std::vector<std::shared_ptr<PotentialInt>> Vint2;
+    std::vector<SharedMatrix> Vtemp2, VLtemp2;
+    for (int t = 0; t < nT; t++) {
+        Vint2.push_back(std::shared_ptr<PotentialInt>(static_cast<PotentialInt*>(Vfact2->ao_potential().release())));
+        Vtemp2.push_back(std::make_shared<Matrix>("Vtemp2", nn, nn));
+        VLtemp2.push_back(std::make_shared<Matrix>("VLtemp2", nn, std::max(na, nb)));
+    }
+    double** L0Ap = L0A->pointer();
+    double** L0Bp = L0B->pointer();
 
     // => A <-> b <= //
 
+    double Elst10_Ab = 0.0;
+#pragma omp parallel for schedule(dynamic) num_threads(nT) reduction(+ : Elst10_Ab)
     for (int A = 0; A < nA; A++) {
         if (ZAp[A] == 0.0) continue;
-        Vtemp2->zero();
-        Vint2->set_charge_field({{ZAp[A], {mol->x(A), mol->y(A), mol->z(A)}}});
-        Vint2->compute(Vtemp2);
-        std::shared_ptr<Matrix> Vbb =
-            linalg::triplet(L0B, Vtemp2, L0B, true, false, false);
-        double** Vbbp = Vbb->pointer();
+        int thread = 0;
+#ifdef _OPENMP
+        thread = omp_get_thread_num();
+#endif
+        double** VLp = VLtemp2[thread]->pointer();
+        Vtemp2[thread]->zero();
+        Vint2[thread]->set_charge_field({{ZAp[A], {mol->x(A), mol->y(A), mol->z(A)}}});
+        Vint2[thread]->compute(Vtemp2[thread]);
+        if (nb) {
+            C_DGEMM('N', 'N', nn, nb, nn, 1.0, Vtemp2[thread]->pointer()[0], nn, L0Bp[0], nb, 0.0, VLp[0],
+                    VLtemp2[thread]->colspi()[0]);
+        }
         for (int b = 0; b < nb; b++) {
-            double E = 2.0 * Vbbp[b][b];
-            Elst10_terms[1] += E;
+            double E = 2.0 * C_DDOT(nn, &L0Bp[0][b], nb, &VLp[0][b], VLtemp2[thread]->colspi()[0]);
+            Elst10_Ab += E;
             Ep[A][b + nB] += E;
         }
     }
+    Elst10_terms[1] += Elst10_Ab;
 
     // Add Extern-A - Orbital b interaction
     if (reference_->has_potential_variable("A")) {
@@ -5739,20 +5758,29 @@ void FISAPT::felst() {
 
     // => a <-> B <= //
 
+    double Elst10_aB = 0.0;
+#pragma omp parallel for schedule(dynamic) num_threads(nT) reduction(+ : Elst10_aB)
     for (int B = 0; B < nB; B++) {
         if (ZBp[B] == 0.0) continue;
-        Vtemp2->zero();
-        Vint2->set_charge_field({{ZBp[B], {mol->x(B), mol->y(B), mol->z(B)}}});
-        Vint2->compute(Vtemp2);
-        std::shared_ptr<Matrix> Vaa =
-            linalg::triplet(L0A, Vtemp2, L0A, true, false, false);
-        double** Vaap = Vaa->pointer();
+        int thread = 0;
+#ifdef _OPENMP
+        thread = omp_get_thread_num();
+#endif
+        double** VLp = VLtemp2[thread]->pointer();
+        Vtemp2[thread]->zero();
+        Vint2[thread]->set_charge_field({{ZBp[B], {mol->x(B), mol->y(B), mol->z(B)}}});
+        Vint2[thread]->compute(Vtemp2[thread]);
+        if (na) {
+            C_DGEMM('N', 'N', nn, na, nn, 1.0, Vtemp2[thread]->pointer()[0], nn, L0Ap[0], na, 0.0, VLp[0],
+                    VLtemp2[thread]->colspi()[0]);
+        }
         for (int a = 0; a < na; a++) {
-            double E = 2.0 * Vaap[a][a];
-            Elst10_terms[0] += E;
+            double E = 2.0 * C_DDOT(nn, &L0Ap[0][a], na, &VLp[0][a], VLtemp2[thread]->colspi()[0]);
+            Elst10_aB += E;
             Ep[a + nA][B] += E;
         }
     }
+    Elst10_terms[0] += Elst10_aB;
 
     // Add Extern-B - Orbital a interaction
     if (reference_->has_potential_variable("B")) {
@@ -7233,11 +7261,7 @@ void FISAPT::fdisp() {
         dfh->fill_tensor("Dar", Dar, {rstart, rstart + nrblock});
         dfh->fill_tensor("Ear", Aar, {rstart, rstart + nrblock});
 
-        double* D2p = Darp[0];
-        double* A2p = Aarp[0];
-        for (long int arQ = 0L; arQ < nrblock * naQ; arQ++) {
-            (*D2p++) += (*A2p++);
-        }
+        C_DAXPY(nrblock * naQ, 1.0, Aarp[0], 1, Darp[0], 1);
         dfh->write_disk_tensor("Far", Dar, {rstart, rstart + nrblock});
     }
 
@@ -7249,11 +7273,7 @@ void FISAPT::fdisp() {
         dfh->fill_tensor("Dbs", Dbs, {sstart, sstart + nsblock});
         dfh->fill_tensor("Ebs", Abs, {sstart, sstart + nsblock});
 
-        double* D2p = Dbsp[0];
-        double* A2p = Absp[0];
-        for (long int bsQ = 0L; bsQ < nsblock * nbQ; bsQ++) {
-            (*D2p++) += (*A2p++);
-        }
+        C_DAXPY(nsblock * nbQ, 1.0, Absp[0], 1, Dbsp[0], 1);
         dfh->write_disk_tensor("Fbs", Dbs, {sstart, sstart + nsblock});
     }
 
@@ -7283,7 +7303,8 @@ void FISAPT::fdisp() {
     double** UBp = Uaocc_B->pointer();
 
     double scale = 1.0;
-    if (options_.get_bool("SSAPT0_SCALE")) {
+    bool do_sSAPT0 = options_.get_bool("SSAPT0_SCALE");
+    if (do_sSAPT0) {
         scale = sSAPT0_scale_;
     }
 
@@ -7317,11 +7338,7 @@ void FISAPT::fdisp() {
             dfh->fill_tensor("DXar", DXar, {rstart, rstart + nrblock});
             dfh->fill_tensor("EXar", Aar, {rstart, rstart + nrblock});
 
-            double* DX2p = DXarp[0];
-            double* A2p = Aarp[0];
-            for (long int arQ = 0L; arQ < nrblock * naQ; arQ++) {
-                (*DX2p++) += (*A2p++);
-            }
+            C_DAXPY(nrblock * naQ, 1.0, Aarp[0], 1, DXarp[0], 1);
             dfh->write_disk_tensor("FXar", DXar, {rstart, rstart + nrblock});
         }
 
@@ -7333,11 +7350,7 @@ void FISAPT::fdisp() {
             dfh->fill_tensor("DYbs", DYbs, {sstart, sstart + nsblock});
             dfh->fill_tensor("EYbs", Abs, {sstart, sstart + nsblock});
 
-            double* DY2p = DYbsp[0];
-            double* A2p = Absp[0];
-            for (long int bsQ = 0L; bsQ < nsblock * nbQ; bsQ++) {
-                (*DY2p++) += (*A2p++);
-            }
+            C_DAXPY(nsblock * nbQ, 1.0, Absp[0], 1, DYbsp[0], 1);
             dfh->write_disk_tensor("FYbs", DYbs, {sstart, sstart + nsblock});
         }
     
@@ -7429,7 +7442,7 @@ void FISAPT::fdisp() {
                     for (int a = 0; a < na; a++) {
                         for (int b = 0; b < nb; b++) {
                             E_exch_disp20Tp[a][b] -= 2.0 * T2abp[a][b] * V2abp[a][b];
-                            if (options_.get_bool("SSAPT0_SCALE"))
+                            if (do_sSAPT0)
                                 sE_exch_disp20Tp[a][b] -= scale * 2.0 * T2abp[a][b] * V2abp[a][b];
                             ExchDisp20 -= 2.0 * T2abp[a][b] * V2abp[a][b];
                             sExchDisp20 -= scale * 2.0 * T2abp[a][b] * V2abp[a][b];
@@ -7545,7 +7558,7 @@ void FISAPT::fdisp() {
                     for (int a = 0; a < na; a++) {
                         for (int b = 0; b < nb; b++) {
                             E_exch_disp20Tp[a][b] -= 2.0 * T2abp[a][b] * V2abp[a][b];
-                            if (options_.get_bool("SSAPT0_SCALE"))
+                            if (do_sSAPT0)
                                 sE_exch_disp20Tp[a][b] -= scale * 2.0 * T2abp[a][b] * V2abp[a][b];
                             ExchDisp20 -= 2.0 * T2abp[a][b] * V2abp[a][b];
                             sExchDisp20 -= scale * 2.0 * T2abp[a][b] * V2abp[a][b];
@@ -245,6 +245,7 @@ std::map<std::string, std::shared_ptr<Matrix> > IBOLocalizer2::localize_task(
 
     for (int iter = 1; iter <= maxiter; iter++) {
         double metric = 0.0;
+#pragma omp parallel for reduction(+ : metric)
         for (int i = 0; i < nocc; i++) {
             for (int A = 0; A < minao_inds.size(); A++) {
                 double Lval = 0.0;
@@ -250,6 +250,22 @@ class PSI_API DFCoupledCluster : public CoupledCluster {
     /// workspace buffers.
     double *Abij, *Sbij;
 
+    /// keep the 3-index integrals and the doubles residual in core?
+    bool incore_;
+    /// in-core copies of (Q|mn) (SCF and CC fitting sets), t1-transformed (Q|ai),
+    /// and the doubles residual
+    double *Qso_scf_, *Qso_cc_, *Qvo_, *r2_;
+    /// buffers for the blocked in-core v^4 diagram and their capacities
+    double *Vcdb_, *Vpm_, *Ablock_, *Sblock_;
+    long int vcdb_max_, npair_max_;
+
+    /// decide whether the in-core algorithm fits in memory and allocate its buffers
+    void AllocateInCore(double available_memory);
+    /// v^4 CC diagram, blocked over a so that each GEMM covers many (a,b) pairs
+    void Vabcd1InCore();
+    /// residual += buf.  buf and scratch are clobbered when the residual is on disk
+    void AccumulateResidual(double *buf, double *scratch);
+
     /// check energy
     virtual double CheckEnergy();
 
@@ -131,9 +131,13 @@ void DFCoupledCluster::CCResidual() {
     }
 
     // first contribution to residual
-    psio->open(PSIF_DCC_R2, PSIO_OPEN_NEW);
-    psio->write_entry(PSIF_DCC_R2, "residual", (char*)&tempt[0], o * o * v * v * sizeof(double));
-    psio->close(PSIF_DCC_R2, 1);
+    if (incore_) {
+        C_DCOPY(o * o * v * v, tempt, 1, r2_, 1);
+    } else {
+        psio->open(PSIF_DCC_R2, PSIO_OPEN_NEW);
+        psio->write_entry(PSIF_DCC_R2, "residual", (char*)&tempt[0], o * o * v * v * sizeof(double));
+        psio->close(PSIF_DCC_R2, 1);
+    }
     if (timer) {
         outfile->Printf("\n");
         outfile->Printf("        C2 = -1/2 t(b,c,k,j) [ (ki|ac) - 1/2 t(a,d,l,i) (kd|lc) ]\n");
@@ -174,10 +178,14 @@ void DFCoupledCluster::CCResidual() {
         }
     }
     F_DGEMM('n', 't', o * v, o * v, o * v, 1.0, tempv, o * v, tempt, o * v, 0.0, integrals, o * v);
-    psio->open(PSIF_DCC_QSO, PSIO_OPEN_OLD);
-    psio->read_entry(PSIF_DCC_QSO, "qvo", (char*)&tempv[0], nQ * o * v * sizeof(double));
-    psio->close(PSIF_DCC_QSO, 1);
-    F_DGEMM('n', 't', o * v, o * v, nQ, 2.0, Qov, o * v, tempv, o * v, 1.0, integrals, o * v);
+    double* qvo = Qvo_;
+    if (!incore_) {
+        psio->open(PSIF_DCC_QSO, PSIO_OPEN_OLD);
+        psio->read_entry(PSIF_DCC_QSO, "qvo", (char*)&tempv[0], nQ * o * v * sizeof(double));
+        psio->close(PSIF_DCC_QSO, 1);
+        qvo = tempv;
+    }
+    F_DGEMM('n', 't', o * v, o * v, nQ, 2.0, Qov, o * v, qvo, o * v, 1.0, integrals, o * v);
     F_DGEMM('n', 't', o * o, v * v, nQ, -1.0, Qoo, o * o, Qvv, v * v, 0.0, tempv, o * o);
 #pragma omp parallel for schedule(static)
     for (int a = 0; a < v; a++) {
@@ -217,11 +225,7 @@ void DFCoupledCluster::CCResidual() {
             }
         }
     }
-    psio->open(PSIF_DCC_R2, PSIO_OPEN_OLD);
-    psio->read_entry(PSIF_DCC_R2, "residual", (char*)&tempv[0], o * o * v * v * sizeof(double));
-    C_DAXPY(o * o * v * v, 1.0, tempv, 1, tempt, 1);
-    psio->write_entry(PSIF_DCC_R2, "residual", (char*)&tempt[0], o * o * v * v * sizeof(double));
-    psio->close(PSIF_DCC_R2, 1);
+    AccumulateResidual(tempt, tempv);
     if (timer) {
         outfile->Printf("        D2 =  1/2 U(b,c,j,k) [ L(a,i,k,c) + 1/2 U(a,d,i,l) L(l,d,k,c) ] %6.2lf\n",
                         omp_get_wtime() - start);
@@ -284,11 +288,7 @@ void DFCoupledCluster::CCResidual() {
             }
         }
     }
-    psio->open(PSIF_DCC_R2, PSIO_OPEN_OLD);
-    psio->read_entry(PSIF_DCC_R2, "residual", (char*)&tempv[0], o * o * v * v * sizeof(double));
-    C_DAXPY(o * o * v * v, 1.0, tempv, 1, tempt, 1);
-    psio->write_entry(PSIF_DCC_R2, "residual", (char*)&tempt[0], o * o * v * v * sizeof(double));
-    psio->close(PSIF_DCC_R2, 1);
+    AccumulateResidual(tempt, tempv);
     if (timer) {
         outfile->Printf("        E2 =      t(a,c,i,j) [ F(b,c) - U(b,d,k,l) (ld|kc) ]            %6.2lf\n",
                         omp_get_wtime() - start);
@@ -317,24 +317,32 @@ void DFCoupledCluster::CCResidual() {
     // overwriting Fij here, but it gets rebuilt every iteration anyway.
     F_DGEMM('t', 'n', o, o, o * v * v, 1.0, tempt, o * v * v, integrals, o * v * v, 1.0, Fij, o);
 
-    psio->open(PSIF_DCC_R2, PSIO_OPEN_OLD);
-    psio->read_entry(PSIF_DCC_R2, "residual", (char*)&tempt[0], o * o * v * v * sizeof(double));
-    F_DGEMM('n', 'n', o, o * v * v, o, -1.0, Fij, o, tb, o, 1.0, tempt, o);
+    double* res = r2_;
+    if (!incore_) {
+        psio->open(PSIF_DCC_R2, PSIO_OPEN_OLD);
+        psio->read_entry(PSIF_DCC_R2, "residual", (char*)&tempt[0], o * o * v * v * sizeof(double));
+        res = tempt;
+    }
+    F_DGEMM('n', 'n', o, o * v * v, o, -1.0, Fij, o, tb, o, 1.0, res, o);
 
     // R2 = R2 + P(ia,jb) R2
-    C_DCOPY(o * o * v * v, tempt, 1, integrals, 1);
+    C_DCOPY(o * o * v * v, res, 1, integrals, 1);
 #pragma omp parallel for schedule(static)
     for (int a = 0; a < v; a++) {
         for (int b = 0; b < v; b++) {
             for (int i = 0; i < o; i++) {
                 for (int j = 0; j < o; j++) {
-                    integrals[a * o * o * v + b * o * o + i * o + j] += tempt[b * o * o * v + a * o * o + j * o + i];
+                    integrals[a * o * o * v + b * o * o + i * o + j] += res[b * o * o * v + a * o * o + j * o + i];
                 }
             }
         }
     }
-    psio->write_entry(PSIF_DCC_R2, "residual", (char*)&integrals[0], o * o * v * v * sizeof(double));
-    psio->close(PSIF_DCC_R2, 1);
+    if (incore_) {
+        C_DCOPY(o * o * v * v, integrals, 1, r2_, 1);
+    } else {
+        psio->write_entry(PSIF_DCC_R2, "residual", (char*)&integrals[0], o * o * v * v * sizeof(double));
+        psio->close(PSIF_DCC_R2, 1);
+    }
     if (timer) {
         outfile->Printf("                - t(a,b,i,k) [ F(k,j) - U(c,d,l,j) (kd|lc) ]            %6.2lf\n",
                         omp_get_wtime() - start);
@@ -379,11 +387,7 @@ void DFCoupledCluster::CCResidual() {
     }
     F_DGEMM('n', 'n', o * o, v * v, o * o, 1.0, tempt, o * o, tb, o * o, 0.0, integrals, o * o);
 
-    psio->open(PSIF_DCC_R2, PSIO_OPEN_OLD);
-    psio->read_entry(PSIF_DCC_R2, "residual", (char*)&tempt[0], o * o * v * v * sizeof(double));
-    C_DAXPY(o * o * v * v, 1.0, tempt, 1, integrals, 1);
-    psio->write_entry(PSIF_DCC_R2, "residual", (char*)&integrals[0], o * o * v * v * sizeof(double));
-    psio->close(PSIF_DCC_R2, 1);
+    AccumulateResidual(integrals, tempt);
 
     if (timer) {
         outfile->Printf("        B2 =      t(a,b,k,l) [ (ki|lj) + t(c,d,i,j) (kc|ld) ]           %6.2lf\n",
@@ -493,5 +497,22 @@ void DFCoupledCluster::CCResidual() {
                         omp_get_wtime() - start);
     }
 }
+
+void DFCoupledCluster::AccumulateResidual(double* buf, double* scratch) {
+    long int o = ndoccact;
+    long int v = nvirt;
+
+    if (incore_) {
+        C_DAXPY(o * o * v * v, 1.0, buf, 1, r2_, 1);
+        return;
+    }
+
+    auto psio = std::make_shared<PSIO>();
+    psio->open(PSIF_DCC_R2, PSIO_OPEN_OLD);
+    psio->read_entry(PSIF_DCC_R2, "residual", (char*)&scratch[0], o * o * v * v * sizeof(double));
+    C_DAXPY(o * o * v * v, 1.0, scratch, 1, buf, 1);
+    psio->write_entry(PSIF_DCC_R2, "residual", (char*)&buf[0], o * o * v * v * sizeof(double));
+    psio->close(PSIF_DCC_R2, 1);
+}
 }
 }
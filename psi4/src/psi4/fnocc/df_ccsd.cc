@@ -27,6 +27,7 @@
  */
 
 #include <ctime>
+#include <vector>
 #ifdef _OPENMP
 #include <omp.h>
 #else
@@ -56,7 +57,19 @@ void DefineLinearTasks();
 void DefineQuadraticTasks();
 
 // coupled cluster constructor
-DFCoupledCluster::DFCoupledCluster(SharedWavefunction ref_wfn, Options &options) : CoupledCluster(ref_wfn, options) {
+DFCoupledCluster::DFCoupledCluster(SharedWavefunction ref_wfn, Options &options)
+    : CoupledCluster(ref_wfn, options),
+      incore_(false),
+      Qso_scf_(nullptr),
+      Qso_cc_(nullptr),
+      Qvo_(nullptr),
+      r2_(nullptr),
+      Vcdb_(nullptr),
+      Vpm_(nullptr),
+      Ablock_(nullptr),
+      Sblock_(nullptr),
+      vcdb_max_(0),
+      npair_max_(0) {
     common_init();
 }
 
@@ -83,6 +96,16 @@ double DFCoupledCluster::compute_energy() {
     free(diisvec);
     free(tempt);
     free(tempv);
+    if (incore_) {
+        free(Qso_scf_);
+        free(Qso_cc_);
+        free(Qvo_);
+        free(r2_);
+        free(Vcdb_);
+        free(Vpm_);
+        free(Ablock_);
+        free(Sblock_);
+    }
 
     // tstart in fnocc
     tstop();
@@ -287,10 +310,14 @@ PsiReturnType DFCoupledCluster::CCSDIterations() {
     psio_address addr;
 
     // zero residual
-    psio->open(PSIF_DCC_R2, PSIO_OPEN_NEW);
-    memset((void *)tempt, '\0', o * o * v * v * sizeof(double));
-    psio->write_entry(PSIF_DCC_R2, "residual", (char *)&tempt[0], o * o * v * v * sizeof(double));
-    psio->close(PSIF_DCC_R2, 1);
+    if (incore_) {
+        memset((void *)r2_, '\0', o * o * v * v * sizeof(double));
+    } else {
+        psio->open(PSIF_DCC_R2, PSIO_OPEN_NEW);
+        memset((void *)tempt, '\0', o * o * v * v * sizeof(double));
+        psio->write_entry(PSIF_DCC_R2, "residual", (char *)&tempt[0], o * o * v * v * sizeof(double));
+        psio->close(PSIF_DCC_R2, 1);
+    }
 
     // start timing the iterations
     const long clk_tck = sysconf(_SC_CLK_TCK);
@@ -637,6 +664,9 @@ void DFCoupledCluster::AllocateMemory() {
     outfile->Printf("            3-index integrals:           %9.3lf [GiB]\n", df_memory);
     outfile->Printf("            CCSD intermediates:          %9.3lf [GiB]\n", total_memory - size_of_t2 * t2_on_disk);
 
+    AllocateInCore((available_memory - df_memory - total_memory + size_of_t2 * t2_on_disk) * 1024. * 1024. * 1024. /
+                   8.);
+
     if (options_.get_bool("COMPUTE_TRIPLES")) {
         int nthreads = Process::environment.get_n_threads();
         double mem_t = 8. * (2L * o * o * v * v + 1L * o * o * o * v + o * v + 3L * v * v * v * nthreads);
@@ -746,15 +776,22 @@ void DFCoupledCluster::UpdateT2() {
     auto psio = std::make_shared<PSIO>();
 
     // df (ai|bj)
-    psio->open(PSIF_DCC_QSO, PSIO_OPEN_OLD);
-    psio->read_entry(PSIF_DCC_QSO, "qvo", (char *)&tempv[0], nQ * o * v * sizeof(double));
-    psio->close(PSIF_DCC_QSO, 1);
-    F_DGEMM('n', 't', o * v, o * v, nQ, 1.0, tempv, o * v, tempv, o * v, 0.0, integrals, o * v);
-
-    // we still have the residual in memory in tempv
-    psio->open(PSIF_DCC_R2, PSIO_OPEN_OLD);
-    psio->read_entry(PSIF_DCC_R2, "residual", (char *)&tempv[0], o * o * v * v * sizeof(double));
-    psio->close(PSIF_DCC_R2, 1);
+    double *qvo = Qvo_;
+    if (!incore_) {
+        psio->open(PSIF_DCC_QSO, PSIO_OPEN_OLD);
+        psio->read_entry(PSIF_DCC_QSO, "qvo", (char *)&tempv[0], nQ * o * v * sizeof(double));
+        psio->close(PSIF_DCC_QSO, 1);
+        qvo = tempv;
+    }
+    F_DGEMM('n', 't', o * v, o * v, nQ, 1.0, qvo, o * v, qvo, o * v, 0.0, integrals, o * v);
+
+    double *res = r2_;
+    if (!incore_) {
+        psio->open(PSIF_DCC_R2, PSIO_OPEN_OLD);
+        psio->read_entry(PSIF_DCC_R2, "residual", (char *)&tempv[0], o * o * v * v * sizeof(double));
+        psio->close(PSIF_DCC_R2, 1);
+        res = tempv;
+    }
 
 #pragma omp parallel for schedule(static)
     for (long int a = 0; a < v; a++) {
@@ -769,7 +806,7 @@ void DFCoupledCluster::UpdateT2() {
 
                     double dijab = dabi - eps[j];
 
-                    double tnew = -(integrals[iajb] + tempv[ijab]) / dijab;
+                    double tnew = -(integrals[iajb] + res[ijab]) / dijab;
                     tempt[ijab] = tnew;
                 }
             }
@@ -800,6 +837,11 @@ void DFCoupledCluster::Vabcd1() {
     long int otri = o * (o + 1) / 2;
     long int vtri = v * (v + 1) / 2;
 
+    if (incore_) {
+        Vabcd1InCore();
+        return;
+    }
+
     auto psio = std::make_shared<PSIO>();
 
     if (t2_on_disk) {
@@ -909,6 +951,180 @@ void DFCoupledCluster::Vabcd1() {
     psio->write_entry(PSIF_DCC_R2, "residual", (char *)&tempv[0], o * o * v * v * sizeof(double));
     psio->close(PSIF_DCC_R2, 1);
 
+// qvv un-transpose
+#pragma omp parallel for schedule(static)
+    for (int q = 0; q < nQ; q++) {
+        C_DCOPY(v * v, Qvv + q, nQ, integrals + q * v * v, 1);
+    }
+    C_DCOPY(nQ * v * v, integrals, 1, Qvv, 1);
+}
+
+/*================================================================
+
+   in-core algorithm
+
+================================================================*/
+void DFCoupledCluster::AllocateInCore(double available_words) {
+    incore_ = false;
+    if (!options_.get_bool("DFCC_INCORE")) return;
+
+    long int o = ndoccact;
+    long int v = nvirt;
+    long int otri = o * (o + 1) / 2;
+    long int vtri = v * (v + 1) / 2;
+
+    // (Q|mn) for both fitting sets, (Q|ai), and the residual
+    double fixed = (double)(nQ_scf + nQ) * nso * nso + (double)nQ * o * v + (double)o * o * v * v;
+
+    // buffers for a block of the v^4 diagram that starts at a = 0 and holds na values of a
+    auto block_words = [&](long int na) {
+        long int npair = na * v - na * (na - 1) / 2;
+        return (double)na * v * v * v + (double)npair * (vtri + 2 * otri);
+    };
+
+    if (t2_on_disk || available_words < fixed + block_words(1)) {
+        double needed = fixed + block_words(1) - available_words;
+        if (t2_on_disk) needed += (double)o * o * v * v;
+        outfile->Printf("        Warning: not enough memory for the in-core algorithm.  Increase\n");
+        outfile->Printf("        available memory by %7.2lf GiB to use it.  Intermediates will be\n",
+                        needed * 8. / 1024. / 1024. / 1024.);
+        outfile->Printf("        stored on disk.\n");
+        outfile->Printf("\n");
+        return;
+    }
+
+    long int na = 1;
+    while (na < v && fixed + block_words(na + 1) <= available_words) na++;
+    vcdb_max_ = na * v * v * v;
+    npair_max_ = na * v - na * (na - 1) / 2;
+
+    outfile->Printf("        In-core intermediates:           %9.3lf [GiB]\n",
+                    (fixed + block_words(na)) * 8. / 1024. / 1024. / 1024.);
+    outfile->Printf("            v^4 diagram block size:      %9li\n", na);
+
+    Qso_scf_ = (double *)malloc(nQ_scf * nso * nso * sizeof(double));
+    Qso_cc_ = (double *)malloc(nQ * nso * nso * sizeof(double));
+    Qvo_ = (double *)malloc(nQ * o * v * sizeof(double));
+    r2_ = (double *)malloc(o * o * v * v * sizeof(double));
+    Vcdb_ = (double *)malloc(vcdb_max_ * sizeof(double));
+    Vpm_ = (double *)malloc(npair_max_ * vtri * sizeof(double));
+    Ablock_ = (double *)malloc(npair_max_ * otri * sizeof(double));
+    Sblock_ = (double *)malloc(npair_max_ * otri * sizeof(double));
+
+    // the AO-basis 3-index integrals do not change during the iterations
+    auto psio = std::make_shared<PSIO>();
+    psio->open(PSIF_DCC_QSO, PSIO_OPEN_OLD);
+    psio->read_entry(PSIF_DCC_QSO, "Qso SCF", (char *)&Qso_scf_[0], nQ_scf * nso * nso * sizeof(double));
+    psio->read_entry(PSIF_DCC_QSO, "Qso CC", (char *)&Qso_cc_[0], nQ * nso * nso * sizeof(double));
+    psio->close(PSIF_DCC_QSO, 1);
+
+    incore_ = true;
+}
+
+/**
+ *  v^4 diagram with everything in core.  Instead of one a at a time, a block
+ *  of a is handled by each pair of GEMMs, so the (ac|bd) build and the
+ *  contraction with t2 run over all (a,b>=a) pairs in the block at once.
+ */
+void DFCoupledCluster::Vabcd1InCore() {
+    long int o = ndoccact;
+    long int v = nvirt;
+    long int oov = o * o * v;
+    long int oo = o * o;
+    long int otri = o * (o + 1) / 2;
+    long int vtri = v * (v + 1) / 2;
+
+#pragma omp parallel for schedule(static)
+    for (long int i = 0; i < o; i++) {
+        for (long int j = i; j < o; j++) {
+            long int ij = Position(i, j);
+            for (long int a = 0; a < v; a++) {
+                for (long int b = a; b < v; b++) {
+                    tempt[Position(a, b) * otri + ij] =
+                        (tb[a * oov + b * oo + i * o + j] + tb[b * oov + a * oo + i * o + j]);
+                    tempt[Position(a, b) * otri + ij + vtri * otri] =
+                        (tb[a * oov + b * oo + i * o + j] - tb[b * oov + a * oo + i * o + j]);
+                }
+                tempt[Position(a, a) * otri + ij] = tb[a * oov + a * oo + i * o + j];
+            }
+        }
+    }
+
+// qvv transpose
+#pragma omp parallel for schedule(static)
+    for (int q = 0; q < nQ; q++) {
+        C_DCOPY(v * v, Qvv + q * v * v, 1, integrals + q, nQ);
+    }
+    C_DCOPY(nQ * v * v, integrals, 1, Qvv, 1);
+
+    std::vector<long int> pair_a(npair_max_), pair_b(npair_max_);
+
+    long int a0 = 0;
+    while (a0 < v) {
+        long int nb = v - a0;
+
+        // grow the block [a0,a1) while its buffers fit
+        long int a1 = a0 + 1;
+        long int npair = nb;
+        while (a1 < v && (a1 + 1 - a0) * v * nb * v <= vcdb_max_ && npair + v - a1 <= npair_max_) {
+            npair += v - a1;
+            a1++;
+        }
+        long int na = a1 - a0;
+
+        long int p = 0;
+        for (long int a = a0; a < a1; a++) {
+            for (long int b = a; b < v; b++) {
+                pair_a[p] = a;
+                pair_b[p] = b;
+                p++;
+            }
+        }
+
+        // (ac|bd) for a in [a0,a1) and b >= a0, stored as Vcdb[(b-a0)v+d][(a-a0)v+c]
+        F_DGEMM('t', 'n', na * v, nb * v, nQ, 1.0, Qvv + a0 * v * nQ, nQ, Qvv + a0 * v * nQ, nQ, 0.0, Vcdb_, na * v);
+
+        for (int sign = 1; sign >= -1; sign -= 2) {
+#pragma omp parallel for schedule(static)
+            for (long int pq = 0; pq < npair; pq++) {
+                long int a = pair_a[pq];
+                long int b = pair_b[pq];
+                double *V = Vcdb_ + (b - a0) * v * na * v + (a - a0) * v;
+                double *Vp = Vpm_ + pq * vtri;
+                long int cd = 0;
+                for (long int c = 0; c < v; c++) {
+                    for (long int d = 0; d <= c; d++) {
+                        Vp[cd++] = V[d * na * v + c] + sign * V[c * na * v + d];
+                    }
+                }
+            }
+            if (sign == 1)
+                F_DGEMM('n', 'n', otri, npair, vtri, 0.5, tempt, otri, Vpm_, vtri, 0.0, Ablock_, otri);
+            else
+                F_DGEMM('n', 'n', otri, npair, vtri, 0.5, tempt + otri * vtri, otri, Vpm_, vtri, 0.0, Sblock_, otri);
+        }
+
+        // contribute to residual
+#pragma omp parallel for schedule(static)
+        for (long int pq = 0; pq < npair; pq++) {
+            long int a = pair_a[pq];
+            long int b = pair_b[pq];
+            for (long int i = 0; i < o; i++) {
+                for (long int j = 0; j < o; j++) {
+                    int sg = (i > j) ? 1 : -1;
+                    double A = Ablock_[pq * otri + Position(i, j)];
+                    double S = Sblock_[pq * otri + Position(i, j)];
+                    r2_[a * oov + b * oo + i * o + j] += A + sg * S;
+                    if (a != b) {
+                        r2_[b * oov + a * oo + i * o + j] += A - sg * S;
+                    }
+                }
+            }
+        }
+
+        a0 = a1;
+    }
+
 // qvv un-transpose
 #pragma omp parallel for schedule(static)
     for (int q = 0; q < nQ; q++) {
@@ -105,19 +105,49 @@ void DFCoupledCluster::T1Fock() {
     auto* rowdims = new long int[nrows];
     for (long int i = 0; i < nrows - 1; i++) rowdims[i] = rowsize;
     rowdims[nrows - 1] = lastrowsize;
+
+    double* temp3 = (double*)malloc(full * full * sizeof(double));
+    memset((void*)temp3, '\0', full * full * sizeof(double));
+
+    // Coulomb and exchange contributions of nq rows of (Q|rs) to the Fock matrix
+    auto fock_rows = [&](double* qmo, long int nq) {
+        for (long int q = 0; q < nq; q++) {
+            // sum k (q|rk) (q|ks)
+            F_DGEMM('n', 'n', full, full, ndocc, -1.0, qmo + q * full * full, full, qmo + q * full * full, full, 1.0,
+                    temp3, full);
+
+            // sum k (q|kk) (q|rs)
+            double dum = 0.0;
+            for (long int k = 0; k < ndocc; k++) {
+                dum += qmo[q * full * full + k * full + k];
+            }
+            C_DAXPY(full * full, 2.0 * dum, qmo + q * full * full, 1, temp3, 1);
+        }
+    };
+
     for (long int row = 0; row < nrows; row++) {
-        psio->read(PSIF_DCC_QSO, "Qso SCF", (char*)&integrals[0], rowdims[row] * nso * nso * sizeof(double), addr1,
-                   &addr1);
-        F_DGEMM('n', 'n', full, nso * rowdims[row], nso, 1.0, Ca_L, full, integrals, nso, 0.0, tempv, full);
+        double* qso = integrals;
+        if (incore_) {
+            qso = Qso_scf_ + row * rowdims[0] * nso * nso;
+        } else {
+            psio->read(PSIF_DCC_QSO, "Qso SCF", (char*)&integrals[0], rowdims[row] * nso * nso * sizeof(double), addr1,
+                       &addr1);
+        }
+        F_DGEMM('n', 'n', full, nso * rowdims[row], nso, 1.0, Ca_L, full, qso, nso, 0.0, tempv, full);
         for (long int q = 0; q < rowdims[row]; q++) {
             for (long int mu = 0; mu < nso; mu++) {
                 C_DCOPY(full, tempv + q * nso * full + mu * full, 1, integrals + q * nso * full + mu, nso);
             }
         }
         F_DGEMM('n', 'n', full, full * rowdims[row], nso, 1.0, Ca_R, full, integrals, nso, 0.0, tempv, full);
-        // full Qmo
-        psio->write(PSIF_DCC_QSO, "Qmo SCF", (char*)&tempv[0], rowdims[row] * full * full * sizeof(double), addr2,
-                    &addr2);
+        if (incore_) {
+            // no need to store Qmo; use it right away
+            fock_rows(tempv, rowdims[row]);
+        } else {
+            // full Qmo
+            psio->write(PSIF_DCC_QSO, "Qmo SCF", (char*)&tempv[0], rowdims[row] * full * full * sizeof(double),
+                        addr2, &addr2);
+        }
     }
     delete[] rowdims;
 
@@ -149,40 +179,28 @@ void DFCoupledCluster::T1Fock() {
         }
     }
 
-    double* temp3 = (double*)malloc(full * full * sizeof(double));
-
-    memset((void*)temp3, '\0', full * full * sizeof(double));
-    psio_address addr = PSIO_ZERO;
-
-    nrows = 1;
-    rowsize = nQ_scf;
-    while (rowsize * full * full > o * o * v * v) {
-        nrows++;
-        rowsize = nQ_scf / nrows;
-        if (nrows * rowsize < nQ_scf) rowsize++;
-        if (rowsize == 1) break;
-    }
-    lastrowsize = nQ_scf - (nrows - 1L) * rowsize;
-    rowdims = new long int[nrows];
-    for (long int i = 0; i < nrows - 1; i++) rowdims[i] = rowsize;
-    rowdims[nrows - 1] = lastrowsize;
-    for (long int row = 0; row < nrows; row++) {
-        psio->read(PSIF_DCC_QSO, "Qmo SCF", (char*)&integrals[0], rowdims[row] * full * full * sizeof(double), addr,
-                   &addr);
-        for (long int q = 0; q < rowdims[row]; q++) {
-            // sum k (q|rk) (q|ks)
-            F_DGEMM('n', 'n', full, full, ndocc, -1.0, integrals + q * full * full, full, integrals + q * full * full,
-                    full, 1.0, temp3, full);
+    if (!incore_) {
+        psio_address addr = PSIO_ZERO;
 
-            // sum k (q|kk) (q|rs)
-            double dum = 0.0;
-            for (long int k = 0; k < ndocc; k++) {
-                dum += integrals[q * full * full + k * full + k];
-            }
-            C_DAXPY(full * full, 2.0 * dum, integrals + q * full * full, 1, temp3, 1);
+        nrows = 1;
+        rowsize = nQ_scf;
+        while (rowsize * full * full > o * o * v * v) {
+            nrows++;
+            rowsize = nQ_scf / nrows;
+            if (nrows * rowsize < nQ_scf) rowsize++;
+            if (rowsize == 1) break;
         }
+        lastrowsize = nQ_scf - (nrows - 1L) * rowsize;
+        rowdims = new long int[nrows];
+        for (long int i = 0; i < nrows - 1; i++) rowdims[i] = rowsize;
+        rowdims[nrows - 1] = lastrowsize;
+        for (long int row = 0; row < nrows; row++) {
+            psio->read(PSIF_DCC_QSO, "Qmo SCF", (char*)&integrals[0], rowdims[row] * full * full * sizeof(double),
+                       addr, &addr);
+            fock_rows(integrals, rowdims[row]);
+        }
+        delete[] rowdims;
     }
-    delete[] rowdims;
     psio->close(PSIF_DCC_QSO, 1);
 
     // Fij
@@ -277,9 +295,14 @@ void DFCoupledCluster::T1Integrals() {
     for (long int i = 0; i < nrows - 1; i++) rowdims[i] = rowsize;
     rowdims[nrows - 1] = lastrowsize;
     for (long int row = 0; row < nrows; row++) {
-        psio->read(PSIF_DCC_QSO, "Qso CC", (char*)&integrals[0], rowdims[row] * nso * nso * sizeof(double), addr1,
-                   &addr1);
-        F_DGEMM('n', 'n', full, nso * rowdims[row], nso, 1.0, Ca_L, full, integrals, nso, 0.0, tempv, full);
+        double* qso = integrals;
+        if (incore_) {
+            qso = Qso_cc_ + row * rowdims[0] * nso * nso;
+        } else {
+            psio->read(PSIF_DCC_QSO, "Qso CC", (char*)&integrals[0], rowdims[row] * nso * nso * sizeof(double), addr1,
+                       &addr1);
+        }
+        F_DGEMM('n', 'n', full, nso * rowdims[row], nso, 1.0, Ca_L, full, qso, nso, 0.0, tempv, full);
         for (long int q = 0; q < rowdims[row]; q++) {
             for (long int mu = 0; mu < nso; mu++) {
                 C_DCOPY(full, tempv + q * nso * full + mu * full, 1, integrals + q * nso * full + mu, nso);
@@ -308,15 +331,19 @@ void DFCoupledCluster::T1Integrals() {
             }
         }
 // Qvo
+        double* qvo = incore_ ? Qvo_ + rowdims[0] * row * o * v : integrals;
 #pragma omp parallel for schedule(static)
         for (long int q = 0; q < rowdims[row]; q++) {
             for (long int a = 0; a < v; a++) {
                 for (long int i = 0; i < o; i++) {
-                    integrals[q * o * v + a * o + i] = tempv[q * full * full + (a + ndocc) * full + (i + nfzc)];
+                    qvo[q * o * v + a * o + i] = tempv[q * full * full + (a + ndocc) * full + (i + nfzc)];
                 }
             }
         }
-        psio->write(PSIF_DCC_QSO, "qvo", (char*)&integrals[0], rowdims[row] * o * v * sizeof(double), addrvo, &addrvo);
+        if (!incore_) {
+            psio->write(PSIF_DCC_QSO, "qvo", (char*)&integrals[0], rowdims[row] * o * v * sizeof(double), addrvo,
+                        &addrvo);
+        }
 // Qvv
 #pragma omp parallel for schedule(static)
         for (long int q = 0; q < rowdims[row]; q++) {
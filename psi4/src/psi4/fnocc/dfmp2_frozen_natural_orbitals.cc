@@ -0,0 +1,253 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Psi4: an open-source quantum chemistry software package
+ *
+ * Copyright (c) 2007-2023 The Psi4 Developers.
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This file is part of Psi4.
+ *
+ * Psi4 is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * Psi4 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with Psi4; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * @END LICENSE
+ */
+
+/**
+  * DF-MP2 frozen natural orbitals for any RHF-based correlated module
+  *
+  */
+
+#include "psi4/psi4-dec.h"
+#include "psi4/lib3index/dfhelper.h"
+#include "psi4/libmints/basisset.h"
+#include "psi4/libmints/matrix.h"
+#include "psi4/libmints/vector.h"
+#include "psi4/libmints/wavefunction.h"
+#include "psi4/libpsi4util/PsiOutStream.h"
+#include "psi4/libpsi4util/exception.h"
+#include "psi4/libpsi4util/process.h"
+#include "psi4/libpsi4util/threading.h"
+#include "psi4/libciomr/libciomr.h"
+#include "psi4/libqt/qt.h"
+#include "frozen_natural_orbitals.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <vector>
+
+namespace psi {
+namespace fnocc {
+
+DFMP2FrozenNO::DFMP2FrozenNO(std::shared_ptr<Wavefunction> wfn, Options& options) : FrozenNO(wfn, options) {
+    // the orbitals are rotated in place below, so work on copies
+    Ca_ = wfn->Ca()->clone();
+    Cb_ = Ca_;
+    epsilon_a_ = std::make_shared<Vector>(*wfn->epsilon_a());
+    epsilon_b_ = epsilon_a_;
+}
+DFMP2FrozenNO::~DFMP2FrozenNO() {}
+
+void DFMP2FrozenNO::ComputeNaturalOrbitals() {
+    tstart();
+
+    outfile->Printf("\n\n");
+    outfile->Printf("        *******************************************************\n");
+    outfile->Printf("        *                                                     *\n");
+    outfile->Printf("        *           DF-MP2 Frozen Natural Orbitals            *\n");
+    outfile->Printf("        *                                                     *\n");
+    outfile->Printf("        *******************************************************\n");
+    outfile->Printf("\n\n");
+
+    outfile->Printf("        ==> Build MP2 amplitudes, OPDM, and NOs <==\n");
+    outfile->Printf("\n");
+
+    auto aVirOrbsPI = nmopi_ - nalphapi_ - frzvpi_;
+    auto D = std::make_shared<Matrix>("Dab", nirrep_, aVirOrbsPI, aVirOrbsPI, Ca_->symmetry());
+
+    double emp2_os = 0.0;
+    double emp2_ss = 0.0;
+    DFMP2(emp2_os, emp2_ss, D);
+    emp2 = emp2_os + emp2_ss;
+
+    double escf = reference_wavefunction_->energy();
+    set_scalar_variable("MP2 OPPOSITE-SPIN CORRELATION ENERGY", emp2_os);
+    set_scalar_variable("MP2 SAME-SPIN CORRELATION ENERGY", emp2_ss);
+    set_scalar_variable("MP2 CORRELATION ENERGY", emp2);
+    set_scalar_variable("MP2 TOTAL ENERGY", emp2 + escf);
+
+    outfile->Printf("        OS MP2 correlation energy:       %20.12lf\n", emp2_os);
+    outfile->Printf("        SS MP2 correlation energy:       %20.12lf\n", emp2_ss);
+    outfile->Printf("        MP2 correlation energy:          %20.12lf\n", emp2);
+    outfile->Printf("      * MP2 total energy:                %20.12lf\n", emp2 + escf);
+    outfile->Printf("\n");
+
+    TruncateVirtuals(D);
+
+    // mp2 in the truncated space, for the correction of the discarded virtuals
+    double emp2_os_no = 0.0;
+    double emp2_ss_no = 0.0;
+    DFMP2(emp2_os_no, emp2_ss_no, nullptr);
+
+    double delta_emp2_os = emp2_os - emp2_os_no;
+    double delta_emp2_ss = emp2_ss - emp2_ss_no;
+    set_scalar_variable("MP2 FNO OPPOSITE-SPIN CORRECTION ENERGY", delta_emp2_os);
+    set_scalar_variable("MP2 FNO SAME-SPIN CORRECTION ENERGY", delta_emp2_ss);
+    set_scalar_variable("MP2 FNO CORRECTION ENERGY", delta_emp2_os + delta_emp2_ss);
+
+    outfile->Printf("        OS MP2 FNO correction:           %20.12lf\n", delta_emp2_os);
+    outfile->Printf("        SS MP2 FNO correction:           %20.12lf\n", delta_emp2_ss);
+    outfile->Printf("        MP2 FNO correction:              %20.12lf\n", delta_emp2_os + delta_emp2_ss);
+    outfile->Printf("\n");
+
+    tstop();
+}
+
+void DFMP2FrozenNO::DFMP2(double& emp2_os, double& emp2_ss, SharedMatrix D) {
+    // active orbitals in the AO basis, irreps one after the other
+    auto aOccOrbsPI = nalphapi_ - frzcpi_;
+    auto aVirOrbsPI = nmopi_ - nalphapi_ - frzvpi_;
+    int nao = basisset_->nbf();
+    size_t o = aOccOrbsPI.sum();
+    size_t v = aVirOrbsPI.sum();
+
+    auto Co = std::make_shared<Matrix>("Active occupied orbitals (AO)", nao, o);
+    auto Cv = std::make_shared<Matrix>("Active virtual orbitals (AO)", nao, v);
+    std::vector<double> eo, ev;
+    std::vector<size_t> voff(nirrep_);
+    size_t ocount = 0, vcount = 0;
+    for (int h = 0; h < nirrep_; h++) {
+        voff[h] = vcount;
+        if (nsopi_[h] == 0) continue;
+        double** U = AO2SO_->pointer(h);
+        double** C = Ca_->pointer(h);
+        if (aOccOrbsPI[h])
+            C_DGEMM('n', 'n', nao, aOccOrbsPI[h], nsopi_[h], 1.0, U[0], nsopi_[h], &C[0][frzcpi_[h]], nmopi_[h], 0.0,
+                    &Co->pointer()[0][ocount], o);
+        if (aVirOrbsPI[h])
+            C_DGEMM('n', 'n', nao, aVirOrbsPI[h], nsopi_[h], 1.0, U[0], nsopi_[h], &C[0][nalphapi_[h]], nmopi_[h], 0.0,
+                    &Cv->pointer()[0][vcount], v);
+        for (int i = frzcpi_[h]; i < nalphapi_[h]; i++) eo.push_back(epsilon_a_->get(h, i));
+        for (int a = nalphapi_[h]; a < nmopi_[h] - frzvpi_[h]; a++) ev.push_back(epsilon_a_->get(h, a));
+        ocount += aOccOrbsPI[h];
+        vcount += aVirOrbsPI[h];
+    }
+
+    int nthreads = 1;
+#ifdef _OPENMP
+    nthreads = omp_get_max_threads();
+#endif
+
+    auto auxiliary = get_basisset("DF_BASIS_MP2");
+    size_t nQ = auxiliary->nbf();
+
+    // (ia|Q) is held in core, along with the per-thread pair buffers
+    size_t memory_doubles = memory_ / sizeof(double);
+    size_t core_doubles = o * v * nQ + (size_t)nthreads * (D ? 4 : 2) * v * v;
+    if (core_doubles >= memory_doubles) {
+        throw PsiException("DF-MP2 FNOs need (ia|Q) in core: not enough memory", __FILE__, __LINE__);
+    }
+
+    auto dfh = std::make_shared<DFHelper>(basisset_, auxiliary);
+    dfh->set_method("DIRECT_iaQ");
+    dfh->set_memory(memory_doubles - core_doubles);
+    dfh->set_nthreads(nthreads);
+    dfh->set_print_lvl(0);
+    dfh->initialize();
+    dfh->add_space("i", Co);
+    dfh->add_space("a", Cv);
+    dfh->add_transformation("iaQ", "i", "a", "pqQ");
+    dfh->transform();
+
+    auto Qia = std::make_shared<Matrix>("(ia|Q)", o * v, nQ);
+    dfh->fill_tensor("iaQ", Qia);
+    dfh.reset();
+    double** Qp = Qia->pointer();
+
+    // one task per (i,j) pair. pair energies are summed in order afterwards,
+    // so the result does not depend on the number of threads
+    std::vector<double> pair_os(o * o), pair_ss(o * o);
+    std::vector<std::vector<double>> Iab(nthreads, std::vector<double>(v * v));
+    std::vector<std::vector<double>> Tab(nthreads, std::vector<double>(v * v));
+    std::vector<std::vector<double>> Uab(D ? nthreads : 0, std::vector<double>(v * v));
+    std::vector<std::vector<double>> Dab(D ? nthreads : 0, std::vector<double>(v * v, 0.0));
+
+    parallel_for(o * o, [&](size_t ij, int thread) {
+        size_t i = ij / o;
+        size_t j = ij % o;
+        double* I = Iab[thread].data();
+        double* T = Tab[thread].data();
+
+        // (ia|jb)
+        C_DGEMM('n', 't', v, v, nQ, 1.0, Qp[i * v], nQ, Qp[j * v], nQ, 0.0, I, v);
+
+        double os = 0.0;
+        double ss = 0.0;
+        for (size_t a = 0; a < v; a++) {
+            for (size_t b = 0; b < v; b++) {
+                double t = I[a * v + b] / (eo[i] + eo[j] - ev[a] - ev[b]);
+                T[a * v + b] = t;
+                os += t * I[a * v + b];
+                ss += t * (I[a * v + b] - I[b * v + a]);
+            }
+        }
+        pair_os[ij] = os;
+        pair_ss[ij] = ss;
+
+        if (!D) return;
+
+        // D(ab) += 2 sum(c) t(ij,ca) [ 2 t(ij,cb) - t(ij,bc) ]
+        double* U = Uab[thread].data();
+        for (size_t a = 0; a < v; a++) {
+            for (size_t b = 0; b < v; b++) {
+                U[a * v + b] = 2.0 * T[a * v + b] - T[b * v + a];
+            }
+        }
+        C_DGEMM('t', 'n', v, v, v, 2.0, T, v, U, v, 1.0, Dab[thread].data(), v);
+    }, nthreads);
+
+    emp2_os = 0.0;
+    emp2_ss = 0.0;
+    for (size_t ij = 0; ij < o * o; ij++) {
+        emp2_os += pair_os[ij];
+        emp2_ss += pair_ss[ij];
+    }
+
+    if (!D) return;
+
+    // the OPDM is totally symmetric, so only the irrep blocks are kept
+    for (int thread = 1; thread < nthreads; thread++) {
+        C_DAXPY(v * v, 1.0, Dab[thread].data(), 1, Dab[0].data(), 1);
+    }
+    for (int h = 0; h < nirrep_; h++) {
+        double** Dp = D->pointer(h);
+        for (int a = 0; a < aVirOrbsPI[h]; a++) {
+            for (int b = 0; b < aVirOrbsPI[h]; b++) {
+                Dp[a][b] = Dab[0][(voff[h] + a) * v + voff[h] + b];
+            }
+        }
+    }
+}
+
+SharedWavefunction fno_wavefunction(SharedWavefunction ref_wfn, Options& options) {
+    auto fno = std::make_shared<DFMP2FrozenNO>(ref_wfn, options);
+    fno->ComputeNaturalOrbitals();
+    return fno;
+}
+}
+}  // end of namespaces
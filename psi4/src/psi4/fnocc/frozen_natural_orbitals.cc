@@ -286,6 +286,21 @@ void FrozenNO::ComputeNaturalOrbitals() {
     psio->close(PSIF_LIBTRANS_DPD, 1);
     ints.reset();
 
+    TruncateVirtuals(D);
+
+    tstop();
+}
+
+/*
+ * diagonalize the virtual-virtual block of the MP2 OPDM, D, and replace the
+ * active virtuals by the semicanonicalized NOs that are kept. the discarded
+ * NOs are appended to the frozen virtuals.
+ */
+void FrozenNO::TruncateVirtuals(SharedMatrix D) {
+    int symmetry = Ca_->symmetry();
+    auto aVirOrbsPI = nmopi_ - nalphapi_ - frzvpi_;
+    auto epsA = epsilon_a_;
+
     auto eigvec = std::make_shared<Matrix>("Dab eigenvectors", nirrep_, aVirOrbsPI, aVirOrbsPI, symmetry);
     auto eigval = std::make_shared<Vector>("Dab eigenvalues", aVirOrbsPI);
     D->diagonalize(eigvec, eigval, descending);
@@ -473,8 +488,6 @@ void FrozenNO::ComputeNaturalOrbitals() {
             epsp[nalphapi_[h] + a] = eigp[a];
         }
     }
-
-    tstop();
 }
 
 // DF FNO class members
@@ -49,6 +49,9 @@ class FrozenNO : public Wavefunction {
     long int nso, nmo, ndocc, nvirt, nfzc, nfzv, ndoccact, nvirt_no;
 
     void common_init();
+
+    /// replaces the active virtuals by the retained, semicanonical NOs of the vv OPDM D
+    void TruncateVirtuals(SharedMatrix D);
 };
 
 class PSI_API DFFrozenNO : public FrozenNO {
@@ -73,6 +76,26 @@ class PSI_API DFFrozenNO : public FrozenNO {
     void BuildFock(long int nQ, double* Qso, double* F);
     void TransformQ(long int nQ, double* Qso);
 };
+
+/// DF-MP2 frozen natural orbitals for any RHF-based correlated module.
+/// The three-index integrals come from DFHelper (DF_BASIS_MP2), and the
+/// orbitals of the reference are copied, not modified.
+class PSI_API DFMP2FrozenNO : public FrozenNO {
+   public:
+    DFMP2FrozenNO(std::shared_ptr<Wavefunction> wfn, Options& options);
+    ~DFMP2FrozenNO() override;
+
+    /// truncates the virtual space and sets the MP2 FNO correction variables
+    void ComputeNaturalOrbitals();
+
+   protected:
+    /// DF-MP2 energy over the active occupied and virtual orbitals of Ca_;
+    /// accumulates the vv block of the MP2 OPDM into D when given
+    void DFMP2(double& emp2_os, double& emp2_ss, SharedMatrix D);
+};
+
+/// builds DF-MP2 frozen natural orbitals and returns the truncated wavefunction
+PSI_API SharedWavefunction fno_wavefunction(SharedWavefunction ref_wfn, Options& options);
 }
 }
 
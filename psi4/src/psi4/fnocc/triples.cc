@@ -101,6 +101,11 @@ PsiReturnType CoupledCluster::triples() {
     outfile->Printf("        num_threads:              %9i\n", nthreads);
     outfile->Printf("        available memory:      %9.2lf mb\n", (double)memory / 1024. / 1024.);
     outfile->Printf("        memory requirements:   %9.2lf mb\n", (double)memory_reqd / 1024. / 1024.);
+
+    // if the (ab|ci) integrals fit on top of that, read them once rather than
+    // reading three v^3 slices from disk for every ijk
+    bool abci_incore = (memory_reqd + 8L * o * vvv <= memory);
+    outfile->Printf("        (ab|ci) integrals held:   %9s\n", abci_incore ? "in core" : "on disk");
     outfile->Printf("\n");
 
     long int nijk = 0;
@@ -144,6 +149,14 @@ PsiReturnType CoupledCluster::triples() {
     psio->read_entry(PSIF_DCC_IJAK, "E2ijak", (char *)&E2ijak[0], vooo * sizeof(double));
     psio->close(PSIF_DCC_IJAK, 1);
 
+    double *E2abci_core = nullptr;
+    if (abci_incore) {
+        E2abci_core = (double *)malloc(o * vvv * sizeof(double));
+        psio->open(PSIF_DCC_ABCI, PSIO_OPEN_OLD);
+        psio->read_entry(PSIF_DCC_ABCI, "E2abci", (char *)&E2abci_core[0], o * vvv * sizeof(double));
+        psio->close(PSIF_DCC_ABCI, 1);
+    }
+
     double *tempt = (double *)malloc(vvoo * sizeof(double));
 
     // first-order amplitudes for mp4
@@ -187,17 +200,27 @@ PsiReturnType CoupledCluster::triples() {
         thread = omp_get_thread_num();
 #endif
 
-        auto mypsio = std::make_shared<PSIO>();
-        mypsio->open(PSIF_DCC_ABCI, PSIO_OPEN_OLD);
-
-        psio_address addr = psio_get_address(PSIO_ZERO, k * vvv * sizeof(double));
-        mypsio->read(PSIF_DCC_ABCI, "E2abci", (char *)&E2abci[thread][0], vvv * sizeof(double), addr, &addr);
-        F_DGEMM('t', 't', vv, v, v, 1.0, E2abci[thread], v, tempt + j * vvo + i * vv, v, 0.0, Z[thread], v * v);
+        // the (ab|ci) slice for a given i: a view of the in-core integrals, or
+        // else read into this thread's buffer
+        std::shared_ptr<PSIO> mypsio;
+        if (!abci_incore) {
+            mypsio = std::make_shared<PSIO>();
+            mypsio->open(PSIF_DCC_ABCI, PSIO_OPEN_OLD);
+        }
+        auto abci_slice = [&](long int p) -> double * {
+            if (abci_incore) return E2abci_core + p * vvv;
+            psio_address addr = psio_get_address(PSIO_ZERO, p * vvv * sizeof(double));
+            mypsio->read(PSIF_DCC_ABCI, "E2abci", (char *)&E2abci[thread][0], vvv * sizeof(double), addr, &addr);
+            return E2abci[thread];
+        };
+
+        double *abci = abci_slice(k);
+        F_DGEMM('t', 't', vv, v, v, 1.0, abci, v, tempt + j * vvo + i * vv, v, 0.0, Z[thread], v * v);
         F_DGEMM('n', 't', v, vv, o, -1.0, E2ijak + j * o * o * v + k * o * v, v, tempt + i * vvo, vv, 1.0, Z[thread],
                 v);
 
         //(ab)(ij)
-        F_DGEMM('t', 't', vv, v, v, 1.0, E2abci[thread], v, tempt + i * vvo + j * vv, v, 0.0, Z2[thread], v * v);
+        F_DGEMM('t', 't', vv, v, v, 1.0, abci, v, tempt + i * vvo + j * vv, v, 0.0, Z2[thread], v * v);
         F_DGEMM('n', 't', v, vv, o, -1.0, E2ijak + i * o * o * v + k * o * v, v, tempt + j * vvo, vv, 1.0, Z2[thread],
                 v);
         for (long int a = 0; a < v; a++) {
@@ -207,9 +230,8 @@ PsiReturnType CoupledCluster::triples() {
         }
 
         //(bc)(jk)
-        addr = psio_get_address(PSIO_ZERO, (long int)j * vvv * sizeof(double));
-        mypsio->read(PSIF_DCC_ABCI, "E2abci", (char *)&E2abci[thread][0], vvv * sizeof(double), addr, &addr);
-        F_DGEMM('t', 't', vv, v, v, 1.0, E2abci[thread], v, tempt + k * v * v * o + i * v * v, v, 0.0, Z2[thread],
+        abci = abci_slice(j);
+        F_DGEMM('t', 't', vv, v, v, 1.0, abci, v, tempt + k * v * v * o + i * v * v, v, 0.0, Z2[thread],
                 v * v);
         F_DGEMM('n', 't', v, vv, o, -1.0, E2ijak + k * voo + j * vo, v, tempt + i * vvo, vv, 1.0, Z2[thread], v);
         for (long int a = 0; a < v; a++) {
@@ -219,7 +241,7 @@ PsiReturnType CoupledCluster::triples() {
         }
 
         //(ikj)(acb)
-        F_DGEMM('t', 't', vv, v, v, 1.0, E2abci[thread], v, tempt + i * vvo + k * vv, v, 0.0, Z2[thread], vv);
+        F_DGEMM('t', 't', vv, v, v, 1.0, abci, v, tempt + i * vvo + k * vv, v, 0.0, Z2[thread], vv);
         F_DGEMM('n', 't', v, vv, o, -1.0, E2ijak + i * voo + j * vo, v, tempt + k * vvo, vv, 1.0, Z2[thread], v);
         for (long int a = 0; a < v; a++) {
             for (long int b = 0; b < v; b++) {
@@ -228,9 +250,8 @@ PsiReturnType CoupledCluster::triples() {
         }
 
         //(ac)(ik)
-        addr = psio_get_address(PSIO_ZERO, i * vvv * sizeof(double));
-        mypsio->read(PSIF_DCC_ABCI, "E2abci", (char *)&E2abci[thread][0], vvv * sizeof(double), addr, &addr);
-        F_DGEMM('t', 't', vv, v, v, 1.0, E2abci[thread], v, tempt + j * vvo + k * vv, v, 0.0, Z2[thread], vv);
+        abci = abci_slice(i);
+        F_DGEMM('t', 't', vv, v, v, 1.0, abci, v, tempt + j * vvo + k * vv, v, 0.0, Z2[thread], vv);
         F_DGEMM('n', 't', v, vv, o, -1.0, E2ijak + j * voo + i * vo, v, tempt + k * vvo, vv, 1.0, Z2[thread], v);
         for (long int a = 0; a < v; a++) {
             for (long int b = 0; b < v; b++) {
@@ -239,7 +260,7 @@ PsiReturnType CoupledCluster::triples() {
         }
 
         //(ijk)(abc)
-        F_DGEMM('t', 't', vv, v, v, 1.0, E2abci[thread], v, tempt + k * vvo + j * vv, v, 0.0, Z2[thread], vv);
+        F_DGEMM('t', 't', vv, v, v, 1.0, abci, v, tempt + k * vvo + j * vv, v, 0.0, Z2[thread], vv);
         F_DGEMM('n', 't', v, vv, o, -1.0, E2ijak + k * voo + i * vo, v, tempt + j * vvo, vv, 1.0, Z2[thread], v);
         for (long int a = 0; a < v; a++) {
             for (long int b = 0; b < v; b++) {
@@ -373,8 +394,10 @@ PsiReturnType CoupledCluster::triples() {
                 outfile->Printf("              %3.1lf  %8d s\n", 100.0 * ind / nijk, (int)stop - (int)start);
             }
         }
-        mypsio->close(PSIF_DCC_ABCI, 1);
-        mypsio.reset();
+        if (!abci_incore) {
+            mypsio->close(PSIF_DCC_ABCI, 1);
+            mypsio.reset();
+        }
     }
 
     double myet = 0.0;
@@ -404,6 +427,7 @@ PsiReturnType CoupledCluster::triples() {
     // free memory:
     free(E2ijak);
     free(tempt);
+    if (abci_incore) free(E2abci_core);
     for (int i = 0; i < nthreads; i++) {
         free(E2abci[i]);
         free(Z[i]);
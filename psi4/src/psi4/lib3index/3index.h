@@ -32,5 +32,6 @@
 #include "dftensor.h"
 #include "denominator.h"
 #include "cholesky.h"
+#include "isdf.h"
 
 #endif
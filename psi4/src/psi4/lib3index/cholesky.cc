@@ -34,6 +34,7 @@ PRAGMA_WARNING_POP
 #include "psi4/libqt/qt.h"
 #include <cmath>
 #include <limits>
+#include <map>
 #include <vector>
 #include "cholesky.h"
 #include "psi4/psifiles.h"
@@ -44,6 +45,7 @@ PRAGMA_WARNING_POP
 #include "psi4/libmints/vector.h"
 #include "psi4/libmints/basisset.h"
 #include "psi4/libmints/twobody.h"
+#include "psi4/libpsi4util/process.h"
 #ifdef _OPENMP
 #include <omp.h>
 #endif
@@ -67,13 +69,25 @@ void Cholesky::choleskify() {
     auto* diag = new double[n];
     compute_diagonal(diag);
 
-    // Temporary cholesky factor
-    std::vector<double*> L;
+    // Temporary cholesky factor, in contiguous chunks of rows so batches can be updated by GEMM
+    const size_t chunk_rows = 64;
+    std::vector<std::vector<double>> L;
+    auto L_row = [&L, chunk_rows, n](size_t P) { return L[P / chunk_rows].data() + (P % chunk_rows) * n; };
+
+    // Rows computed ahead of their turn as part of a batch. done counts the Cholesky vectors
+    // already subtracted from the row; the buffer is shared by the whole batch.
+    struct CachedRow {
+        std::shared_ptr<std::vector<double>> buffer;
+        double* row;
+        size_t done;
+    };
+    std::map<int, CachedRow> cache;
 
     // List of selected pivots
     std::vector<int> pivots;
 
-    // Cholesky procedure
+    // Cholesky procedure. The pivot order is that of the one-row-at-a-time algorithm; only the
+    // way rows are obtained differs.
     while (Q_ < n) {
         // Select the pivot
         size_t pivot = 0;
@@ -93,35 +107,65 @@ void Cholesky::choleskify() {
         double L_QQ = sqrt(Dmax);
 
         // Check to see if memory constraints are OK
-        if (Q_ > max_rows) {
+        if (Q_ + cache.size() > max_rows) {
             throw PSIEXCEPTION("Cholesky: Memory constraints exceeded. Fire your theorist.");
         }
 
+        if (!cache.count(pivot)) {
+            // The pivot row, plus its cheap companions that may still become pivots
+            std::vector<int> batch(1, pivot);
+            for (int row : row_batch(pivot)) {
+                if (Q_ + cache.size() + batch.size() > max_rows) break;
+                if (row != (int)pivot && diag[row] >= delta_ && !cache.count(row)) batch.push_back(row);
+            }
+            size_t nbatch = batch.size();
+
+            auto buffer = std::make_shared<std::vector<double>>(nbatch * n);
+            std::vector<double*> targets(nbatch);
+            for (size_t k = 0; k < nbatch; k++) targets[k] = buffer->data() + k * n;
+
+            // (m|Q)
+            compute_rows(batch, targets.data());
+
+            // [(m|Q) - L_m^P L_Q^P] for the whole batch at once
+            std::vector<double> LQP(nbatch * chunk_rows);
+            for (size_t P0 = 0; P0 < Q_; P0 += chunk_rows) {
+                size_t nP = std::min(chunk_rows, Q_ - P0);
+                for (size_t k = 0; k < nbatch; k++)
+                    for (size_t P = 0; P < nP; P++) LQP[k * nP + P] = L_row(P0 + P)[batch[k]];
+                C_DGEMM('N', 'N', nbatch, n, nP, -1.0, LQP.data(), nP, L_row(P0), n, 1.0, buffer->data(), n);
+            }
+
+            for (size_t k = 0; k < nbatch; k++) cache[batch[k]] = CachedRow{buffer, targets[k], Q_};
+        }
+
         // If here, we're really going to add this row
-        L.push_back(new double[n]);
+        if (Q_ % chunk_rows == 0) L.emplace_back(chunk_rows * n);
+        double* LQ = L_row(Q_);
 
-        // (m|Q)
-        compute_row(pivot, L[Q_]);
+        const CachedRow& cached = cache[pivot];
+        ::memcpy(static_cast<void*>(LQ), static_cast<void*>(cached.row), n * sizeof(double));
 
-        // [(m|Q) - L_m^P L_Q^P]
-        for (size_t P = 0; P < Q_; P++) {
-            C_DAXPY(n, -L[P][pivots[Q_]], L[P], 1, L[Q_], 1);
+        // Vectors found since the row was computed
+        for (size_t P = cached.done; P < Q_; P++) {
+            C_DAXPY(n, -L_row(P)[pivot], L_row(P), 1, LQ, 1);
         }
+        cache.erase(pivot);
 
         // 1/L_QQ [(m|Q) - L_m^P L_Q^P]
-        C_DSCAL(n, 1.0 / L_QQ, L[Q_], 1);
+        C_DSCAL(n, 1.0 / L_QQ, LQ, 1);
 
         // Zero the upper triangle
         for (size_t P = 0; P < pivots.size(); P++) {
-            L[Q_][pivots[P]] = 0.0;
+            LQ[pivots[P]] = 0.0;
         }
 
         // Set the pivot factor
-        L[Q_][pivot] = L_QQ;
+        LQ[pivot] = L_QQ;
 
         // Update the Schur complement diagonal
         for (size_t P = 0; P < n; P++) {
-            diag[P] -= L[Q_][P] * L[Q_][P];
+            diag[P] -= LQ[P] * LQ[P];
         }
 
         // Force truly zero elements to zero
@@ -129,16 +173,34 @@ void Cholesky::choleskify() {
             diag[pivots[P]] = 0.0;
         }
 
+        // Diagonals only decrease, so rows that fell below delta can never be pivots
+        for (auto it = cache.begin(); it != cache.end();) {
+            if (diag[it->first] < delta_)
+                it = cache.erase(it);
+            else
+                ++it;
+        }
+
         Q_++;
     }
+    cache.clear();
+    delete[] diag;
+
     // Copy into a more permanant Matrix object
     L_ = std::make_shared<Matrix>("Partial Cholesky", Q_, n);
     double** Lp = L_->pointer();
 
     for (size_t Q = 0; Q < Q_; Q++) {
-        ::memcpy(static_cast<void*>(Lp[Q]), static_cast<void*>(L[Q]), n * sizeof(double));
-        delete[] L[Q];
+        ::memcpy(static_cast<void*>(Lp[Q]), static_cast<void*>(L_row(Q)), n * sizeof(double));
+        if ((Q + 1) % chunk_rows == 0) std::vector<double>().swap(L[Q / chunk_rows]);
     }
+    pivots_ = pivots;
+}
+
+std::vector<int> Cholesky::row_batch(int row) { return std::vector<int>(1, row); }
+
+void Cholesky::compute_rows(const std::vector<int>& rows, double** targets) {
+    for (size_t k = 0; k < rows.size(); k++) compute_row(rows[k], targets[k]);
 }
 
 CholeskyMatrix::CholeskyMatrix(SharedMatrix A, double delta, size_t memory) : A_(A), Cholesky(delta, memory) {
@@ -161,59 +223,115 @@ void CholeskyMatrix::compute_row(int row, double* target) {
 CholeskyERI::CholeskyERI(std::shared_ptr<TwoBodyAOInt> integral, double schwarz, double delta, size_t memory)
     : integral_(integral), schwarz_(schwarz), Cholesky(delta, memory) {
     basisset_ = integral_->basis();
+    ints_.push_back(integral_);
 }
 CholeskyERI::~CholeskyERI() {}
 size_t CholeskyERI::N() { return static_cast<size_t>(basisset_->nbf()) * basisset_->nbf(); }
+int CholeskyERI::prepare_threads() {
+    int nthread = 1;
+#ifdef _OPENMP
+    nthread = Process::environment.get_n_threads();
+#endif
+    while ((int)ints_.size() < nthread) ints_.push_back(std::shared_ptr<TwoBodyAOInt>(integral_->clone()));
+    return nthread;
+}
 void CholeskyERI::compute_diagonal(double* target) {
-    for (size_t M = 0; M < basisset_->nshell(); M++) {
-        for (size_t N = 0; N < basisset_->nshell(); N++) {
-            integral_->compute_shell(M, N, M, N);
-            const double* buffer = integral_->buffer();
-
-            size_t nM = basisset_->shell(M).nfunction();
-            size_t nN = basisset_->shell(N).nfunction();
-            size_t mstart = basisset_->shell(M).function_index();
-            size_t nstart = basisset_->shell(N).function_index();
+    int nthread = prepare_threads();
+    int nshell = basisset_->nshell();
 
-            for (size_t om = 0; om < nM; om++) {
-                for (size_t on = 0; on < nN; on++) {
-                    target[(om + mstart) * basisset_->nbf() + (on + nstart)] =
-                        buffer[om * nN * nM * nN + on * nM * nN + om * nN + on];
-                }
+#pragma omp parallel for schedule(dynamic) num_threads(nthread)
+    for (size_t MN = 0; MN < nshell * (size_t)nshell; MN++) {
+        int thread = 0;
+#ifdef _OPENMP
+        thread = omp_get_thread_num();
+#endif
+        size_t M = MN / nshell;
+        size_t N = MN % nshell;
+        ints_[thread]->compute_shell(M, N, M, N);
+        const double* buffer = ints_[thread]->buffer();
+
+        size_t nM = basisset_->shell(M).nfunction();
+        size_t nN = basisset_->shell(N).nfunction();
+        size_t mstart = basisset_->shell(M).function_index();
+        size_t nstart = basisset_->shell(N).function_index();
+
+        for (size_t om = 0; om < nM; om++) {
+            for (size_t on = 0; on < nN; on++) {
+                target[(om + mstart) * basisset_->nbf() + (on + nstart)] =
+                    buffer[om * nN * nM * nN + on * nM * nN + om * nN + on];
             }
         }
     }
 }
-void CholeskyERI::compute_row(int row, double* target) {
-    size_t r = row / basisset_->nbf();
-    size_t s = row % basisset_->nbf();
-    size_t R = basisset_->function_to_shell(r);
-    size_t S = basisset_->function_to_shell(s);
-
-    size_t nR = basisset_->shell(R).nfunction();
-    size_t nS = basisset_->shell(S).nfunction();
-    size_t rstart = basisset_->shell(R).function_index();
-    size_t sstart = basisset_->shell(S).function_index();
-
-    size_t oR = r - rstart;
-    size_t os = s - sstart;
+void CholeskyERI::compute_row(int row, double* target) { compute_rows(std::vector<int>(1, row), &target); }
+std::vector<int> CholeskyERI::row_batch(int row) {
+    size_t nbf = basisset_->nbf();
+    const GaussianShell& R = basisset_->shell(basisset_->function_to_shell(row / nbf));
+    const GaussianShell& S = basisset_->shell(basisset_->function_to_shell(row % nbf));
+
+    std::vector<int> rows;
+    for (int r = R.function_index(); r < R.function_index() + R.nfunction(); r++) {
+        for (int s = S.function_index(); s < S.function_index() + S.nfunction(); s++) {
+            rows.push_back(r * nbf + s);
+        }
+    }
+    return rows;
+}
+void CholeskyERI::compute_rows(const std::vector<int>& rows, double** targets) {
+    int nthread = prepare_threads();
+    size_t nbf = basisset_->nbf();
     int nshell = basisset_->nshell();
 
-    for (size_t M = 0; M < basisset_->nshell(); M++) {
-        for (size_t N = M; N < basisset_->nshell(); N++) {
-            integral_->compute_shell(M, N, R, S);
-            const double* buffer = integral_->buffer();
+    // Rows sharing a ket shell pair RS come from the same (MN|RS) quartets
+    std::map<std::pair<int, int>, std::vector<size_t>> groups;
+    for (size_t k = 0; k < rows.size(); k++) {
+        int R = basisset_->function_to_shell(rows[k] / nbf);
+        int S = basisset_->function_to_shell(rows[k] % nbf);
+        groups[std::make_pair(R, S)].push_back(k);
+    }
+
+    std::vector<std::pair<int, int>> MN_pairs;
+    for (int M = 0; M < nshell; M++) {
+        for (int N = M; N < nshell; N++) {
+            MN_pairs.emplace_back(M, N);
+        }
+    }
+
+    for (const auto& group : groups) {
+        int R = group.first.first;
+        int S = group.first.second;
+        size_t nR = basisset_->shell(R).nfunction();
+        size_t nS = basisset_->shell(S).nfunction();
+        size_t rstart = basisset_->shell(R).function_index();
+        size_t sstart = basisset_->shell(S).function_index();
+        const std::vector<size_t>& members = group.second;
+
+        // Each MN pair fills its own (mn) and (nm) elements, so the targets are written without races
+#pragma omp parallel for schedule(dynamic) num_threads(nthread)
+        for (size_t MN = 0; MN < MN_pairs.size(); MN++) {
+            int thread = 0;
+#ifdef _OPENMP
+            thread = omp_get_thread_num();
+#endif
+            int M = MN_pairs[MN].first;
+            int N = MN_pairs[MN].second;
+            ints_[thread]->compute_shell(M, N, R, S);
+            const double* buffer = ints_[thread]->buffer();
 
             size_t nM = basisset_->shell(M).nfunction();
             size_t nN = basisset_->shell(N).nfunction();
             size_t mstart = basisset_->shell(M).function_index();
             size_t nstart = basisset_->shell(N).function_index();
 
-            for (size_t om = 0; om < nM; om++) {
-                for (size_t on = 0; on < nN; on++) {
-                    target[(om + mstart) * basisset_->nbf() + (on + nstart)] =
-                        target[(on + nstart) * basisset_->nbf() + (om + mstart)] =
+            for (size_t k : members) {
+                size_t oR = rows[k] / nbf - rstart;
+                size_t os = rows[k] % nbf - sstart;
+                double* target = targets[k];
+                for (size_t om = 0; om < nM; om++) {
+                    for (size_t on = 0; on < nN; on++) {
+                        target[(om + mstart) * nbf + (on + nstart)] = target[(on + nstart) * nbf + (om + mstart)] =
                             buffer[om * nN * nR * nS + on * nR * nS + oR * nS + os];
+                    }
                 }
             }
         }
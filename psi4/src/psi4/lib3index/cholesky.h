@@ -32,6 +32,8 @@
 #include "psi4/pragma.h"
 #include "psi4/libmints/typedefs.h"
 
+#include <vector>
+
 namespace psi {
 
 class Vector;
@@ -48,6 +50,8 @@ class Cholesky {
     SharedMatrix L_;
     /// Number of columns required, if choleskify() called
     size_t Q_;
+    /// Selected pivots in order, if choleskify() called
+    std::vector<int> pivots_;
 
    public:
     /*!
@@ -66,6 +70,8 @@ class Cholesky {
     SharedMatrix L() const { return L_; }
     /// Number of columns required to reach accuracy delta, if choleskify() called
     size_t Q() const { return Q_; }
+    /// Rows of the original square tensor selected as pivots, if choleskify() called
+    const std::vector<int>& pivots() const { return pivots_; }
     /// Dimension of the original square tensor, provided by the subclass
     virtual size_t N() = 0;
     /// Maximum Chebyshev error allowed in the decomposition
@@ -75,6 +81,15 @@ class Cholesky {
     virtual void compute_diagonal(double* target) = 0;
     /// Row row of the original square tensor, provided by the subclass
     virtual void compute_row(int row, double* target) = 0;
+
+    /**
+     * Rows that are cheap to compute alongside row (which is always included).
+     * choleskify() computes such a batch in one compute_rows() call and keeps the
+     * rows that may become later pivots. The default is just row.
+     **/
+    virtual std::vector<int> row_batch(int row);
+    /// Rows rows of the original square tensor, into targets[k]; defaults to compute_row for each
+    virtual void compute_rows(const std::vector<int>& rows, double** targets);
 };
 
 class CholeskyMatrix : public Cholesky {
@@ -95,6 +110,10 @@ class PSI_API CholeskyERI : public Cholesky {
     double schwarz_;
     std::shared_ptr<BasisSet> basisset_;
     std::shared_ptr<TwoBodyAOInt> integral_;
+    /// Per-thread integral objects, the first being integral_
+    std::vector<std::shared_ptr<TwoBodyAOInt>> ints_;
+    /// Make sure there is an integral object per thread, returns the thread count
+    int prepare_threads();
 
    public:
     CholeskyERI(std::shared_ptr<TwoBodyAOInt> integral, double schwarz, double delta, size_t memory);
@@ -103,6 +122,10 @@ class PSI_API CholeskyERI : public Cholesky {
     size_t N() override;
     void compute_diagonal(double* target) override;
     void compute_row(int row, double* target) override;
+    /// All function pairs of the shell pair containing row
+    std::vector<int> row_batch(int row) override;
+    /// Rows grouped by shell pair, so every (MN|RS) quartet is computed once per batch; threaded over MN
+    void compute_rows(const std::vector<int>& rows, double** targets) override;
 };
 
 class CholeskyMP2 : public Cholesky {
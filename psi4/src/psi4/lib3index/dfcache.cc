@@ -0,0 +1,150 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Psi4: an open-source quantum chemistry software package
+ *
+ * Copyright (c) 2007-2023 The Psi4 Developers.
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This file is part of Psi4.
+ *
+ * Psi4 is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * Psi4 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with Psi4; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * @END LICENSE
+ */
+
+#include "dfcache.h"
+
+#include <iomanip>
+#include <sstream>
+
+#include "psi4/libmints/basisset.h"
+#include "psi4/libmints/matrix.h"
+#include "psi4/libmints/molecule.h"
+#include "psi4/libpsi4util/process.h"
+
+namespace psi {
+
+DFIntegralCache& DFIntegralCache::instance() {
+    static DFIntegralCache cache;
+    return cache;
+}
+
+std::string DFIntegralCache::basis_key(std::shared_ptr<BasisSet> basis) {
+    std::stringstream key;
+    key << std::setprecision(12) << basis->name() << "/" << basis->key() << "/" << basis->nbf() << "/"
+        << basis->nshell() << "/" << basis->has_puream();
+
+    // shell structure, in case two different basis sets go by the same name
+    size_t nprim = 0;
+    double expsum = 0.0;
+    for (int P = 0; P < basis->nshell(); P++) {
+        const GaussianShell& shell = basis->shell(P);
+        nprim += shell.nprimitive() * (shell.am() + 1);
+        for (int K = 0; K < shell.nprimitive(); K++) expsum += shell.exp(K);
+    }
+    key << "/" << nprim << "/" << expsum;
+
+    // geometry, including ghosts and dummy charges
+    auto mol = basis->molecule();
+    for (int A = 0; A < mol->natom(); A++) {
+        key << "/" << mol->Z(A) << ":" << mol->x(A) << "," << mol->y(A) << "," << mol->z(A);
+    }
+    return key.str();
+}
+
+size_t DFIntegralCache::max_memory() const {
+    double mib = Process::environment.options.get_double("DF_CACHE_MEMORY");
+    if (mib <= 0.0) return 0;
+    return static_cast<size_t>(mib * 1024.0 * 1024.0 / sizeof(double));
+}
+
+bool DFIntegralCache::enabled() const { return max_memory() > 0; }
+
+size_t DFIntegralCache::memory() const {
+    std::lock_guard<std::mutex> guard(lock_);
+    return memory_;
+}
+
+size_t DFIntegralCache::size() const {
+    std::lock_guard<std::mutex> guard(lock_);
+    return entries_.size();
+}
+
+void DFIntegralCache::touch(Entry& entry) { lru_.splice(lru_.begin(), lru_, entry.lru); }
+
+void DFIntegralCache::erase(std::map<std::string, Entry>::iterator it) {
+    memory_ -= it->second.size;
+    lru_.erase(it->second.lru);
+    entries_.erase(it);
+}
+
+SharedMatrix DFIntegralCache::get_matrix(const std::string& key) {
+    std::lock_guard<std::mutex> guard(lock_);
+    auto it = entries_.find(key);
+    if (it == entries_.end() || !it->second.matrix) return nullptr;
+    touch(it->second);
+    return it->second.matrix;
+}
+
+std::pair<std::shared_ptr<double[]>, size_t> DFIntegralCache::get_buffer(const std::string& key) {
+    std::lock_guard<std::mutex> guard(lock_);
+    auto it = entries_.find(key);
+    if (it == entries_.end() || !it->second.buffer) return {nullptr, 0};
+    touch(it->second);
+    return {it->second.buffer, it->second.size};
+}
+
+bool DFIntegralCache::put_matrix(const std::string& key, SharedMatrix mat) {
+    size_t size = 0;
+    for (int h = 0; h < mat->nirrep(); h++) size += (size_t)mat->rowspi()[h] * mat->colspi()[h ^ mat->symmetry()];
+    return put(key, Entry{mat, nullptr, size, {}});
+}
+
+bool DFIntegralCache::put_buffer(const std::string& key, std::shared_ptr<double[]> buffer, size_t size) {
+    return put(key, Entry{nullptr, buffer, size, {}});
+}
+
+bool DFIntegralCache::put(const std::string& key, Entry&& entry) {
+    std::lock_guard<std::mutex> guard(lock_);
+
+    auto it = entries_.find(key);
+    if (it != entries_.end()) erase(it);
+
+    if (!make_room(entry.size)) return false;
+
+    entry.lru = lru_.insert(lru_.begin(), key);
+    memory_ += entry.size;
+    entries_.emplace(key, std::move(entry));
+    return true;
+}
+
+bool DFIntegralCache::make_room(size_t required) {
+    size_t budget = max_memory();
+    if (required > budget) return false;
+
+    while (memory_ + required > budget) erase(entries_.find(lru_.back()));
+    return true;
+}
+
+void DFIntegralCache::clear() {
+    std::lock_guard<std::mutex> guard(lock_);
+    entries_.clear();
+    lru_.clear();
+    memory_ = 0;
+}
+
+}  // namespace psi
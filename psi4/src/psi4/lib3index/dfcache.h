@@ -0,0 +1,120 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Psi4: an open-source quantum chemistry software package
+ *
+ * Copyright (c) 2007-2023 The Psi4 Developers.
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This file is part of Psi4.
+ *
+ * Psi4 is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * Psi4 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with Psi4; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * @END LICENSE
+ */
+
+#ifndef three_index_dfcache
+#define three_index_dfcache
+
+#include "psi4/libmints/typedefs.h"
+#include "psi4/pragma.h"
+
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace psi {
+
+class BasisSet;
+
+///
+/// Process-wide cache of density-fitting quantities (fitting metrics, in-core (Q|mn))
+/// shared between DF consumers, so that e.g. SCF, DF-MP2 and the DF gradient within one
+/// driver call do not each rebuild them. Entries are keyed on strings built from
+/// basis_key(), which folds in the basis set and the geometry it lives on. The memory
+/// budget is the DF_CACHE_MEMORY option (MiB, on top of the memory keyword); with the
+/// default of 0 the cache is disabled. When full, the least recently used entries are
+/// evicted. Cached data is shared and must be treated as read-only.
+///
+class PSI_API DFIntegralCache {
+   public:
+    static DFIntegralCache& instance();
+
+    /// Key describing a basis set and the geometry it is placed on
+    static std::string basis_key(std::shared_ptr<BasisSet> basis);
+
+    /// Is the memory budget nonzero?
+    bool enabled() const;
+    /// Memory budget in doubles
+    size_t max_memory() const;
+    /// Memory currently held in doubles
+    size_t memory() const;
+    /// Number of cached entries
+    size_t size() const;
+
+    ///
+    /// Cached matrix for key, or nullptr
+    ///
+    SharedMatrix get_matrix(const std::string& key);
+    ///
+    /// Cache a matrix under key. Dropped if it does not fit into the budget.
+    /// @return true if the entry was stored
+    ///
+    bool put_matrix(const std::string& key, SharedMatrix mat);
+
+    ///
+    /// Cached buffer and its length in doubles for key, or (nullptr, 0)
+    ///
+    std::pair<std::shared_ptr<double[]>, size_t> get_buffer(const std::string& key);
+    ///
+    /// Cache a buffer of size doubles under key. Dropped if it does not fit into the budget.
+    /// @return true if the entry was stored
+    ///
+    bool put_buffer(const std::string& key, std::shared_ptr<double[]> buffer, size_t size);
+
+    /// Drop every entry
+    void clear();
+
+   protected:
+    DFIntegralCache() = default;
+
+    struct Entry {
+        SharedMatrix matrix;
+        std::shared_ptr<double[]> buffer;
+        size_t size;
+        /// position of the key in lru_
+        std::list<std::string>::iterator lru;
+    };
+
+    bool put(const std::string& key, Entry&& entry);
+    /// evict least recently used entries until required more doubles fit
+    bool make_room(size_t required);
+    /// mark an entry most recently used
+    void touch(Entry& entry);
+    /// drop an entry and its place in lru_
+    void erase(std::map<std::string, Entry>::iterator it);
+
+    std::map<std::string, Entry> entries_;
+    /// keys of entries_, most recently used first
+    std::list<std::string> lru_;
+    size_t memory_ = 0;
+    mutable std::mutex lock_;
+};
+
+}  // namespace psi
+#endif
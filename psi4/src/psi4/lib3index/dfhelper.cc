@@ -27,14 +27,21 @@
  */
 
 #include "dfhelper.h"
+#include "dfcache.h"
 
 #include <algorithm>
+#include <future>
+#include <iomanip>
+#include <cerrno>
 #include <cstdlib>
 #ifdef _MSC_VER
 #include <process.h>
 #define SYSTEM_GETPID ::_getpid
 #else
 #include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #define SYSTEM_GETPID ::getpid
 #endif
 #ifdef _OPENMP
@@ -53,6 +60,8 @@
 #include "psi4/libmints/twobody.h"
 #include "psi4/libpsi4util/PsiOutStream.h"
 #include "psi4/libqt/qt.h"
+#include "psi4/libpsi4util/huge_pages.h"
+#include "psi4/libpsi4util/memory_governor.h"
 #include "psi4/libpsi4util/process.h"
 #include "psi4/libpsio/psio.hpp"
 #include "psi4/libpsio/psio.h"
@@ -62,18 +71,47 @@
 
 namespace psi {
 
+// Read bytes at an absolute offset of the file behind fp. pread never touches the shared
+// stream position, so any number of threads may read one stream at once.
+static bool read_at(FILE* fp, void* buf, size_t bytes, size_t offset) {
+#ifdef _MSC_VER
+    static std::mutex read_lock;
+    std::lock_guard<std::mutex> lock(read_lock);
+    if (_fseeki64(fp, offset, SEEK_SET)) return false;
+    return fread(buf, 1, bytes, fp) == bytes;
+#else
+    int fd = fileno(fp);
+    char* p = static_cast<char*>(buf);
+    while (bytes) {
+        ssize_t n = ::pread(fd, p, bytes, offset);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        p += n;
+        bytes -= n;
+        offset += n;
+    }
+    return true;
+#endif
+}
+
 DFHelper::DFHelper(std::shared_ptr<BasisSet> primary, std::shared_ptr<BasisSet> aux)
     : primary_(primary), aux_(aux) {
     if(Process::environment.options["SCF_SUBTYPE"].has_changed()) {
         subalgo_ = Process::environment.options.get_str("SCF_SUBTYPE");
     }
+    disk_mmap_ = Process::environment.options.get_bool("DF_DISK_MMAP");
+    disk_compress_ = Process::environment.options.get_bool("DF_DISK_COMPRESS");
+    aux_rank_tolerance_ = Process::environment.options.get_double("DF_AUX_RANK_TOLERANCE");
     
     nbf_ = primary_->nbf();
     naux_ = aux_->nbf();
     prepare_blocking();
 }
 
-DFHelper::~DFHelper() { clear_all(); }
+DFHelper::~DFHelper() {
+    clear_all();
+    MemoryGovernor::instance().release(this);
+}
 
 void DFHelper::prepare_blocking() {
     Qshells_ = aux_->nshell();
@@ -99,6 +137,7 @@ void DFHelper::prepare_blocking() {
 void DFHelper::AO_filename_maker(size_t i) {
     auto name = start_filename("dfh.AO" + std::to_string(i));
     AO_names_.push_back(name);
+    if (disk_compress_) fp32_files_.insert(name);
 }
 
 std::string DFHelper::start_filename(std::string start) {
@@ -157,6 +196,20 @@ void DFHelper::initialize() {
     direct_iaQ_ = (!method_.compare("DIRECT_iaQ") ? true : false);
     direct_ = (!method_.compare("DIRECT") ? true : false);
 
+    // register with the memory governor, which may evict caches of other modules to make room.
+    // if other modules hold on to the rest of the job memory, make do with what is left,
+    // as long as the metric still fits
+    size_t granted = MemoryGovernor::instance().reserve(this, "DFHelper", memory_ * sizeof(double)) / sizeof(double);
+    if (granted < memory_) {
+        size_t memory = std::max(granted, std::min(memory_, naux_ * naux_));
+        if (print_lvl_ > 0) {
+            outfile->Printf("  DFHelper Memory: %.3f GiB requested, %.3f GiB left by other modules, using %.3f GiB.\n",
+                            memory_ * 8 / (1024 * 1024 * 1024.0), granted * 8 / (1024 * 1024 * 1024.0),
+                            memory * 8 / (1024 * 1024 * 1024.0));
+        }
+        memory_ = memory;
+    }
+
     // did we get enough memory for at least the metric?
     if (naux_ * naux_ > memory_) {
         std::stringstream error;
@@ -189,6 +242,9 @@ void DFHelper::initialize() {
             //   coulomb matrix to save memory in case do_wK_ is
             //   is true, but do_K_ is false. This code isn't written
             prepare_AO_core();
+            if (aux_rank_tolerance_ > 0.0 && !direct_ && !direct_iaQ_ && std::fabs(mpower_ + 0.5) < 1e-13) {
+                compress_aux();
+            }
         }
     } else if (!direct_ && !direct_iaQ_) {
         prepare_AO();
@@ -358,6 +414,24 @@ void DFHelper::prepare_sparsity() {
         }
     }
 
+    // => For each aux shell, store the max (P|P) integral for three-center screening. <=
+    std::shared_ptr<BasisSet> zero = BasisSet::zero_ao_basis_set();
+    auto auxfactory = std::make_shared<IntegralFactory>(aux_, zero, aux_, zero);
+    std::shared_ptr<TwoBodyAOInt> aux_eri(auxfactory->eri());
+    aux_shell_max_vals_.assign(Qshells_, 0.0);
+    for (size_t P = 0; P < Qshells_; ++P) {
+        size_t nP = aux_->shell(P).nfunction();
+        aux_eri->compute_shell(P, 0, P, 0);
+        const auto *buffer = aux_eri->buffer();
+        for (size_t p = 0; p < nP; ++p) {
+            aux_shell_max_vals_[P] = std::max(aux_shell_max_vals_[P], fabs(buffer[p * nP + p]));
+        }
+    }
+    schwarz_shell_max_vals_ = shell_max_vals;
+    size_t max_nP = aux_->max_function_per_shell();
+    size_t max_nmu = primary_->max_function_per_shell();
+    screened_Pmn_zeros_.assign(max_nP * max_nmu * max_nmu, 0.0);
+
     // => Prepare screening/indexing data <=
     double tolerance = cutoff_ * cutoff_ / max_val;
 
@@ -501,6 +575,22 @@ void DFHelper::prepare_AO_wK() {
     std::pair<size_t, size_t> plargest = pshell_blocks_for_AO_build(memory_, 0, psteps);
 }
 void DFHelper::prepare_AO_core() {
+    // the metric-contracted integrals may already be around from an earlier DFHelper
+    bool use_cache = (!direct_ && !direct_iaQ_ && DFIntegralCache::instance().enabled());
+    std::string cache_key;
+    if (use_cache) {
+        std::stringstream key;
+        key << std::setprecision(12) << "DFHelper/Ppq/" << DFIntegralCache::basis_key(primary_) << "/"
+            << DFIntegralCache::basis_key(aux_) << "/" << mpower_ << "/" << cutoff_ << "/" << condition_
+            << (metric_solve_ ? "/solve" : "");
+        cache_key = key.str();
+        auto cached = DFIntegralCache::instance().get_buffer(cache_key);
+        if (cached.first && cached.second == big_skips_[nbf_]) {
+            Ppq_ = cached.first;
+            return;
+        }
+    }
+
     // get each thread an eri object
     std::shared_ptr<BasisSet> zero = BasisSet::zero_ao_basis_set();
     auto rifactory = std::make_shared<IntegralFactory>(aux_, zero, primary_, primary_);
@@ -525,6 +615,7 @@ void DFHelper::prepare_AO_core() {
     } else {
         Ppq_ = std::unique_ptr<double[]>(new double[big_skips_[nbf_]]);
     }
+    huge_pages_advise(Ppq_.get(), (direct_iaQ_ ? naux_ * nbf_ * nbf_ : big_skips_[nbf_]) * sizeof(double));
 
     double* ppq = Ppq_.get();
 
@@ -543,15 +634,19 @@ void DFHelper::prepare_AO_core() {
         std::unique_ptr<double[]> Qpq(new double[std::get<0>(plargest)]);
         double* Mp = Qpq.get();
         std::unique_ptr<double[]> metric;
-        double* metp;
-
-        if (!hold_met_) {
-            metric = std::unique_ptr<double[]>(new double[naux_ * naux_]);
-            metp = metric.get();
-            std::string filename = return_metfile(mpower_);
-            get_tensor_(std::get<0>(files_[filename]), metp, 0, naux_ - 1, 0, naux_ - 1);
-        } else
-            metp = metric_prep_core(mpower_);
+        double* metp = nullptr;
+
+        // solving with the factor never forms the metric power
+        double* factorp = (metric_solve_ && !do_wK_) ? metric_factor_prep_core() : nullptr;
+        if (!factorp) {
+            if (!hold_met_) {
+                metric = std::unique_ptr<double[]>(new double[naux_ * naux_]);
+                metp = metric.get();
+                std::string filename = return_metfile(mpower_);
+                get_tensor_(std::get<0>(files_[filename]), metp, 0, naux_ - 1, 0, naux_ - 1);
+            } else
+                metp = metric_prep_core(mpower_);
+        }
 
         for (size_t i = 0; i < psteps.size(); i++) {
             size_t start = std::get<0>(psteps[i]);
@@ -566,14 +661,90 @@ void DFHelper::prepare_AO_core() {
 
             // contract metric
             timer_on("DFH: AO-Met. Contraction");
-            contract_metric_AO_core_symm(Mp, ppq, metp, begin, end);
+            if (factorp)
+                solve_metric_AO_core_symm(Mp, ppq, factorp, begin, end);
+            else
+                contract_metric_AO_core_symm(Mp, ppq, metp, begin, end);
             timer_off("DFH: AO-Met. Contraction");
         }
         // no more need for metrics
         if (hold_met_) metrics_.clear();
+        metric_factor_.reset();
+
+        if (use_cache) DFIntegralCache::instance().put_buffer(cache_key, Ppq_, big_skips_[nbf_]);
     }
     // outfile->Printf("\n    ==> End AO Blocked Construction <==");
 }
+void DFHelper::compress_aux() {
+    timer_on("DFH: aux compression");
+    double* Pp = Ppq_.get();
+
+    // Gram matrix of the fitted integrals, G_PQ = sum_mn (P|mn) (Q|mn)
+    std::vector<SharedMatrix> Gt(nthreads_);
+    for (size_t rank = 0; rank < nthreads_; rank++) Gt[rank] = std::make_shared<Matrix>("G", naux_, naux_);
+#pragma omp parallel for schedule(guided) num_threads(nthreads_)
+    for (size_t p = 0; p < nbf_; p++) {
+        int rank = 0;
+#ifdef _OPENMP
+        rank = omp_get_thread_num();
+#endif
+        size_t sp_size = small_skips_[p];
+        C_DGEMM('N', 'T', naux_, naux_, sp_size, 1.0, &Pp[big_skips_[p]], sp_size, &Pp[big_skips_[p]], sp_size, 1.0,
+                Gt[rank]->pointer()[0], naux_);
+    }
+    for (size_t rank = 1; rank < nthreads_; rank++) Gt[0]->add(Gt[rank]);
+
+    // keep the directions above the tolerance, eigenvalues come in ascending order
+    auto U = std::make_shared<Matrix>("U", naux_, naux_);
+    auto g = std::make_shared<Vector>("g", naux_);
+    Gt[0]->diagonalize(U, g, ascending);
+    size_t first = 0;
+    double discarded = 0.0;
+    while (first < naux_ && g->get(first) < aux_rank_tolerance_) discarded += g->get(first++);
+    size_t nkeep = naux_ - first;
+    if (nkeep == naux_) {
+        timer_off("DFH: aux compression");
+        return;
+    }
+
+    auto UT = std::make_shared<Matrix>("UT", nkeep, naux_);
+    double** Up = U->pointer();
+    double** UTp = UT->pointer();
+    for (size_t P = 0; P < naux_; P++) {
+        for (size_t k = 0; k < nkeep; k++) UTp[k][P] = Up[P][first + k];
+    }
+
+    // (k|mn) = U_Pk (P|mn), into a fresh buffer since Ppq_ may be shared with the integral cache
+    std::vector<size_t> skips(nbf_ + 1, 0);
+    for (size_t p = 0; p < nbf_; p++) skips[p + 1] = skips[p] + nkeep * small_skips_[p];
+    std::shared_ptr<double[]> Cpq(new double[skips[nbf_]]);
+    double* Cp = Cpq.get();
+#pragma omp parallel for schedule(guided) num_threads(nthreads_)
+    for (size_t p = 0; p < nbf_; p++) {
+        size_t sp_size = small_skips_[p];
+        C_DGEMM('N', 'N', nkeep, sp_size, naux_, 1.0, UTp[0], naux_, &Pp[big_skips_[p]], sp_size, 0.0, &Cp[skips[p]],
+                sp_size);
+    }
+
+    if (print_lvl_ > 0) {
+        outfile->Printf("  DFHelper: Compressed the auxiliary space from %zu to %zu functions (discarded %.3E).\n",
+                        naux_, nkeep, discarded);
+    }
+
+    // the compressed directions have no shell structure, block over them one at a time
+    Ppq_ = Cpq;
+    naux_ = nkeep;
+    big_skips_ = skips;
+    for (size_t i = 1; i < nbf_ + 1; i++) {
+        symm_big_skips_[i] = symm_big_skips_[i - 1] + symm_small_skips_[i - 1] * naux_;
+    }
+    Qshells_ = naux_;
+    Qshell_max_ = 1;
+    Qshell_aggs_.resize(Qshells_ + 1);
+    for (size_t i = 0; i < Qshells_ + 1; i++) Qshell_aggs_[i] = i;
+
+    timer_off("DFH: aux compression");
+}
 void DFHelper::prepare_AO_wK_core() {
     // get each thread an eri object
     std::shared_ptr<BasisSet> zero = BasisSet::zero_ao_basis_set();
@@ -748,7 +919,8 @@ std::pair<size_t, size_t> DFHelper::pshell_blocks_for_AO_build(const size_t mem,
     return std::make_pair(largest, block_size);
 }
 std::pair<size_t, size_t> DFHelper::Qshell_blocks_for_transform(const size_t mem, size_t wtmp, size_t wfinal,
-                                                                std::vector<std::pair<size_t, size_t>>& b) {
+                                                                std::vector<std::pair<size_t, size_t>>& b, size_t nAO,
+                                                                size_t nMO) {
     size_t extra = (hold_met_ ? naux_ * naux_ : 0);
     size_t end, begin, current, block_size, tmpbs, total, count, largest;
     block_size = tmpbs = total = count = largest = 0;
@@ -769,7 +941,7 @@ std::pair<size_t, size_t> DFHelper::Qshell_blocks_for_transform(const size_t mem
             total = (AO_core_ ? big_skips_[nbf_] : total);
         }
 
-        size_t constraint = total + (wtmp * nbf_ + 2 * wfinal) * tmpbs + extra;
+        size_t constraint = nAO * total + (wtmp * nbf_ + 2 * nMO * wfinal) * tmpbs + extra;
         // AOs + worst half transformed + worst final
         if (constraint > mem || i == Qshells_ - 1) {
             if (count == 1 && i != Qshells_ - 1) {
@@ -809,6 +981,8 @@ std::tuple<size_t, size_t> DFHelper::Qshell_blocks_for_JK_build(std::vector<std:
 
     // C_buffers
     size_t T3 = std::max(nthreads_ * nbf_ * nbf_, nthreads_ * nbf_ * max_nocc);
+    // K sub-block buffer for the orbital-screened K build
+    if (K_orbital_cutoff_ > 0.0) T3 += nbf_ * nbf_;
 
     // total AO buffer size is max if core alg is used, otherwise init to 0
     size_t total_AO_buffer = (AO_core_ ? big_skips_[nbf_] : 0);
@@ -827,6 +1001,8 @@ std::tuple<size_t, size_t> DFHelper::Qshell_blocks_for_JK_build(std::vector<std:
         // compute total memory used by aggregate block
         size_t constraint = total_AO_buffer + T1 * tmpbs + T3;
         constraint += (lr_symmetric ? T2 : T2 * tmpbs);
+        // FP32 copies of T1, T2 and K (in units of doubles)
+        if (K_low_precision_) constraint += (lr_symmetric ? T1 * tmpbs / 2 : T1 * tmpbs) + nbf_ * nbf_ / 2;
 
         if (constraint > memory_ || i == Qshells_ - 1) {
             if (count == 1 && i != Qshells_ - 1) {
@@ -854,6 +1030,7 @@ std::tuple<size_t, size_t> DFHelper::Qshell_blocks_for_JK_build(std::vector<std:
 }
 
 FILE* DFHelper::stream_check(std::string filename, std::string op) {
+    std::lock_guard<std::mutex> lock(streams_lock_);
     if (file_streams_.count(filename) == 0) {
         file_streams_[filename] = std::make_shared<Stream>(filename, op);
     }
@@ -861,6 +1038,15 @@ FILE* DFHelper::stream_check(std::string filename, std::string op) {
     return file_streams_[filename]->get_stream(op);
 }
 
+void* DFHelper::map_check(std::string filename, size_t bytes, bool write) {
+    std::lock_guard<std::mutex> lock(streams_lock_);
+    if (file_streams_.count(filename) == 0) {
+        file_streams_[filename] = std::make_shared<Stream>(filename, (write ? "wb" : "rb"), false);
+    }
+
+    return file_streams_[filename]->map(bytes, write);
+}
+
 DFHelper::StreamStruct::StreamStruct(std::string filename, std::string op, bool activate) {
     op_ = op;
     filename_ = filename;
@@ -873,12 +1059,18 @@ DFHelper::StreamStruct::StreamStruct(std::string filename, std::string op, bool
 DFHelper::StreamStruct::StreamStruct() {}
 
 DFHelper::StreamStruct::~StreamStruct() {
-    fflush(fp_);
-    fclose(fp_);
+    unmap();
+    if (open_) {
+        fflush(fp_);
+        fclose(fp_);
+    }
     std::remove(filename_.c_str());
 }
 
 FILE* DFHelper::StreamStruct::get_stream(std::string op) {
+    // the stream may truncate the file under a mapping
+    if (map_ != nullptr) unmap();
+
     if (op.compare(op_)) {
         change_stream(op);
     } else {
@@ -904,6 +1096,65 @@ void DFHelper::StreamStruct::close_stream() {
     fclose(fp_);
 }
 
+void* DFHelper::StreamStruct::map(size_t bytes, bool write) {
+    // a writable mapping serves reads as well
+    if (map_ != nullptr && map_size_ == bytes && (map_write_ || !write)) return map_;
+
+    unmap();
+    if (open_) {
+        close_stream();
+        open_ = false;
+    }
+    if (bytes == 0) return nullptr;
+
+#ifdef _MSC_VER
+    throw PSIEXCEPTION("DFHelper:map: memory-mapped disk tensors are not supported on this platform");
+#else
+    int fd = ::open(filename_.c_str(), (write ? O_RDWR | O_CREAT : O_RDONLY), 0644);
+    if (fd < 0) {
+        std::stringstream error;
+        error << "DFHelper:map: unable to open " << filename_;
+        throw PSIEXCEPTION(error.str().c_str());
+    }
+
+    // writable files grow to their full size up front, read-only ones must already have it
+    struct stat st;
+    bool sized = !fstat(fd, &st);
+    if (sized && (size_t)st.st_size < bytes) sized = (write && !ftruncate(fd, bytes));
+    if (!sized) {
+        ::close(fd);
+        std::stringstream error;
+        error << "DFHelper:map: " << (write ? "write" : "read") << " error on " << filename_;
+        throw PSIEXCEPTION(error.str().c_str());
+    }
+
+    void* p = ::mmap(nullptr, bytes, (write ? PROT_READ | PROT_WRITE : PROT_READ), MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (p == MAP_FAILED) {
+        std::stringstream error;
+        error << "DFHelper:map: unable to map " << filename_;
+        throw PSIEXCEPTION(error.str().c_str());
+    }
+
+    // tensors are swept along their leading (usually auxiliary) index
+    ::madvise(p, bytes, MADV_SEQUENTIAL);
+
+    map_ = p;
+    map_size_ = bytes;
+    map_write_ = write;
+    return map_;
+#endif
+}
+
+void DFHelper::StreamStruct::unmap() {
+#ifndef _MSC_VER
+    if (map_ != nullptr) ::munmap(map_, map_size_);
+#endif
+    map_ = nullptr;
+    map_size_ = 0;
+    map_write_ = false;
+}
+
 void DFHelper::put_tensor(std::string file, double* b, std::pair<size_t, size_t> i0, std::pair<size_t, size_t> i1,
                           std::pair<size_t, size_t> i2, std::string op) {
     // collapse to 2D, assume file has form (i1 | i2 i3)
@@ -940,6 +1191,24 @@ void DFHelper::put_tensor(std::string file, double* Mp, const size_t start1, con
     size_t A1 = std::get<1>(sizes_[file]) * std::get<2>(sizes_[file]);
     size_t st = A1 - a1;
 
+    if (fp32_files_.count(file)) {
+        put_tensor_fp32(file, Mp, (st ? a0 : 1), (st ? a1 : a0 * a1), start1 * A1 + start2, A1, A0 * A1, op);
+        return;
+    }
+
+    // mapped files are written in place, row by row if not contiguous
+    if (disk_mmap_) {
+        double* Fp = static_cast<double*>(map_check(file, A0 * A1 * sizeof(double), true));
+        if (st == 0) {
+            C_DCOPY(a0 * a1, Mp, 1, &Fp[start1 * A1 + start2], 1);
+        } else {
+            for (size_t i = 0; i < a0; i++) {
+                C_DCOPY(a1, &Mp[i * a1], 1, &Fp[(start1 + i) * A1 + start2], 1);
+            }
+        }
+        return;
+    }
+
     // begin stream
     FILE* fp = stream_check(file, op);
 
@@ -976,6 +1245,11 @@ void DFHelper::put_tensor(std::string file, double* Mp, const size_t start1, con
     }
 }
 void DFHelper::put_tensor_AO(std::string file, double* Mp, size_t size, size_t start, std::string op) {
+    if (fp32_files_.count(file)) {
+        put_tensor_fp32(file, Mp, 1, size, start, size, big_skips_[nbf_], op);
+        return;
+    }
+
     // begin stream
     FILE* fp = stream_check(file, op);
 
@@ -991,15 +1265,22 @@ void DFHelper::put_tensor_AO(std::string file, double* Mp, size_t size, size_t s
     }
 }
 void DFHelper::get_tensor_AO(std::string file, double* Mp, size_t size, size_t start) {
+    if (fp32_files_.count(file)) {
+        get_tensor_fp32(file, Mp, 1, size, start, size, big_skips_[nbf_]);
+        return;
+    }
+
+    if (disk_mmap_) {
+        double* Fp = static_cast<double*>(map_check(file, big_skips_[nbf_] * sizeof(double), false));
+        C_DCOPY(size, &Fp[start], 1, Mp, 1);
+        return;
+    }
+
     // begin stream
     FILE* fp = stream_check(file, "rb");
 
-    // adjust position
-    fseek(fp, start * sizeof(double), SEEK_SET);
-
     // everything is contiguous
-    size_t s = fread(&Mp[0], sizeof(double), size, fp);
-    if (!s) {
+    if (!read_at(fp, Mp, size * sizeof(double), start * sizeof(double))) {
         std::stringstream error;
         error << "DFHelper:get_tensor_AO: read error";
         throw PSIEXCEPTION(error.str().c_str());
@@ -1009,7 +1290,7 @@ void DFHelper::get_tensor_(std::string file, double* b, std::pair<size_t, size_t
                            std::pair<size_t, size_t> i2) {
     // has this integral been transposed?
     std::tuple<size_t, size_t, size_t> sizes;
-    sizes = (tsizes_.find(file) != tsizes_.end() ? tsizes_[file] : sizes_[file]);
+    sizes = (tsizes_.find(file) != tsizes_.end() ? tsizes_.at(file) : sizes_.at(file));
 
     // collapse to 2D, assume file has form (i1 | i2 i3)
     size_t A2 = std::get<2>(sizes);
@@ -1044,49 +1325,95 @@ void DFHelper::get_tensor_(std::string file, double* b, const size_t start1, con
 
     // has this integral been transposed?
     std::tuple<size_t, size_t, size_t> sizes;
-    sizes = (tsizes_.find(file) != tsizes_.end() ? tsizes_[file] : sizes_[file]);
+    sizes = (tsizes_.find(file) != tsizes_.end() ? tsizes_.at(file) : sizes_.at(file));
 
     size_t A0 = std::get<0>(sizes);
     size_t A1 = std::get<1>(sizes) * std::get<2>(sizes);
     size_t st = A1 - a1;
 
+    if (fp32_files_.count(file)) {
+        get_tensor_fp32(file, b, (st ? a0 : 1), (st ? a1 : a0 * a1), start1 * A1 + start2, A1, A0 * A1);
+        return;
+    }
+
+    if (disk_mmap_) {
+        double* Fp = static_cast<double*>(map_check(file, A0 * A1 * sizeof(double), false));
+        if (st == 0) {
+            C_DCOPY(a0 * a1, &Fp[start1 * A1 + start2], 1, b, 1);
+        } else {
+            for (size_t i = 0; i < a0; i++) {
+                C_DCOPY(a1, &Fp[(start1 + i) * A1 + start2], 1, &b[i * a1], 1);
+            }
+        }
+        return;
+    }
+
     // check stream
     FILE* fp = stream_check(file, "rb");
 
-    // adjust position
-    fseek(fp, (start1 * A1 + start2) * sizeof(double), SEEK_SET);
-
     // is everything contiguous?
-    if (st == 0) {
-        size_t s = fread(&b[0], sizeof(double), a0 * a1, fp);
-        if (!s) {
+    size_t rows = (st == 0 ? 1 : a0);
+    size_t cols = (st == 0 ? a0 * a1 : a1);
+    for (size_t i = 0; i < rows; i++) {
+        if (!read_at(fp, &b[i * cols], cols * sizeof(double), ((start1 + i) * A1 + start2) * sizeof(double))) {
             std::stringstream error;
             error << "DFHelper:get_tensor: read error";
             throw PSIEXCEPTION(error.str().c_str());
         }
-    } else {
-        for (size_t i = 0; i < a0 - 1; i++) {
-            // read
-            size_t s = fread(&b[i * a1], sizeof(double), a1, fp);
-            if (!s) {
+    }
+}
+void DFHelper::put_tensor_fp32(std::string file, double* Mp, size_t a0, size_t a1, size_t offset, size_t ld,
+                               size_t total, std::string op) {
+    if (disk_mmap_) {
+        float* Fp = static_cast<float*>(map_check(file, total * sizeof(float), true));
+        for (size_t i = 0; i < a0; i++) {
+            float* row = &Fp[offset + i * ld];
+            double* Rp = &Mp[i * a1];
+            for (size_t j = 0; j < a1; j++) row[j] = static_cast<float>(Rp[j]);
+        }
+        return;
+    }
+
+    // convert through a bounded buffer, each row is a single contiguous run in the file
+    FILE* fp = stream_check(file, op);
+    std::vector<float> buffer(std::min(a1, (size_t)65536));
+    for (size_t i = 0; i < a0; i++) {
+        fseek(fp, (offset + i * ld) * sizeof(float), SEEK_SET);
+        for (size_t j = 0; j < a1; j += buffer.size()) {
+            size_t n = std::min(buffer.size(), a1 - j);
+            for (size_t k = 0; k < n; k++) buffer[k] = static_cast<float>(Mp[i * a1 + j + k]);
+            size_t s = fwrite(buffer.data(), sizeof(float), n, fp);
+            if (s != n) {
                 std::stringstream error;
-                error << "DFHelper:get_tensor: read error";
+                error << "DFHelper:put_tensor: write error";
                 throw PSIEXCEPTION(error.str().c_str());
             }
-            // advance stream
-            s = fseek(fp, st * sizeof(double), SEEK_CUR);
-            if (s) {
+        }
+    }
+}
+void DFHelper::get_tensor_fp32(std::string file, double* Mp, size_t a0, size_t a1, size_t offset, size_t ld,
+                               size_t total) {
+    if (disk_mmap_) {
+        float* Fp = static_cast<float*>(map_check(file, total * sizeof(float), false));
+        for (size_t i = 0; i < a0; i++) {
+            float* row = &Fp[offset + i * ld];
+            double* Rp = &Mp[i * a1];
+            for (size_t j = 0; j < a1; j++) Rp[j] = static_cast<double>(row[j]);
+        }
+        return;
+    }
+
+    FILE* fp = stream_check(file, "rb");
+    std::vector<float> buffer(std::min(a1, (size_t)65536));
+    for (size_t i = 0; i < a0; i++) {
+        for (size_t j = 0; j < a1; j += buffer.size()) {
+            size_t n = std::min(buffer.size(), a1 - j);
+            if (!read_at(fp, buffer.data(), n * sizeof(float), (offset + i * ld + j) * sizeof(float))) {
                 std::stringstream error;
                 error << "DFHelper:get_tensor: read error";
                 throw PSIEXCEPTION(error.str().c_str());
             }
-        }
-        // manual last one
-        size_t s = fread(&b[(a0 - 1) * a1], sizeof(double), a1, fp);
-        if (!s) {
-            std::stringstream error;
-            error << "DFHelper:get_tensor: read error";
-            throw PSIEXCEPTION(error.str().c_str());
+            for (size_t k = 0; k < n; k++) Mp[i * a1 + j + k] = static_cast<double>(buffer[k]);
         }
     }
 }
@@ -1188,8 +1515,12 @@ void DFHelper::compute_sparse_pQq_blocking_Q(const size_t start, const size_t st
             for (size_t Pshell = start; Pshell <= stop; Pshell++) {
                 size_t PHI = aux_->shell(Pshell).function_index();
                 size_t numP = aux_->shell(Pshell).nfunction();
-                eri[rank]->compute_shell(Pshell, 0, MU, NU);
-                buffer[rank] = eri[rank]->buffer();
+                if (aux_shell_significant(Pshell, MU, NU)) {
+                    eri[rank]->compute_shell(Pshell, 0, MU, NU);
+                    buffer[rank] = eri[rank]->buffer();
+                } else {
+                    buffer[rank] = screened_Pmn_zeros_.data();
+                }
                 for (size_t mu = 0; mu < nummu; mu++) {
                     size_t omu = primary_->shell(MU).function_index() + mu;
                     for (size_t nu = 0; nu < numnu; nu++) {
@@ -1246,8 +1577,12 @@ void DFHelper::compute_sparse_pQq_blocking_p(const size_t start, const size_t st
             for (size_t Pshell = 0; Pshell < Qshells_; Pshell++) {
                 size_t PHI = aux_->shell(Pshell).function_index();
                 size_t numP = aux_->shell(Pshell).nfunction();
-                eri[rank]->compute_shell(Pshell, 0, MU, NU);
-                buffer[rank] = eri[rank]->buffer();
+                if (aux_shell_significant(Pshell, MU, NU)) {
+                    eri[rank]->compute_shell(Pshell, 0, MU, NU);
+                    buffer[rank] = eri[rank]->buffer();
+                } else {
+                    buffer[rank] = screened_Pmn_zeros_.data();
+                }
                 for (size_t mu = 0; mu < nummu; mu++) {
                     size_t omu = primary_->shell(MU).function_index() + mu;
                     for (size_t nu = 0; nu < numnu; nu++) {
@@ -1306,8 +1641,12 @@ void DFHelper::compute_sparse_pQq_blocking_p_symm(const size_t start, const size
             for (size_t Pshell = 0; Pshell < Qshells_; Pshell++) {
                 size_t PHI = aux_->shell(Pshell).function_index();
                 size_t numP = aux_->shell(Pshell).nfunction();
-                eri[rank]->compute_shell(Pshell, 0, MU, NU);
-                buffer[rank] = eri[rank]->buffer();
+                if (aux_shell_significant(Pshell, MU, NU)) {
+                    eri[rank]->compute_shell(Pshell, 0, MU, NU);
+                    buffer[rank] = eri[rank]->buffer();
+                } else {
+                    buffer[rank] = screened_Pmn_zeros_.data();
+                }
 
                 for (size_t mu = 0; mu < nummu; mu++) {
                     size_t omu = primary_->shell(MU).function_index() + mu;
@@ -1412,6 +1751,7 @@ void DFHelper::grab_AO(const size_t start, const size_t stop, double* Mp) {
         size_t size = block_size * small_skips_[i];
         size_t jump = begin * small_skips_[i];
         get_tensor_AO(getf, &Mp[sta], size, big_skips_[i] + jump);
+        JK_disk_bytes_ += size * sizeof(double);
         sta += size;
     }
 }
@@ -1520,6 +1860,65 @@ double* DFHelper::metric_inverse_prep_core() {
 
     return metrics_[power]->pointer()[0];
 }
+double* DFHelper::metric_factor_prep_core() {
+    bool inverse = std::fabs(mpower_ + 1.0) < 1e-13;
+    if (!inverse && std::fabs(mpower_ + 0.5) > 1e-13) return nullptr;
+    if (metric_factor_) return metric_factor_->pointer()[0];
+
+    timer_on("DFH: metric factor");
+    std::string cache_key = "DFHelper/metric_factor/" + DFIntegralCache::basis_key(aux_);
+    if (DFIntegralCache::instance().enabled()) metric_factor_ = DFIntegralCache::instance().get_matrix(cache_key);
+
+    if (!metric_factor_) {
+        FittingMetric J(aux_, true);
+        J.form_fitting_metric();
+        auto U = J.get_metric()->clone();
+        U->set_name("Metric Cholesky factor");
+        // row-major J seen as column-major is J itself; 'L' leaves U = L^T in the row-major upper triangle
+        int info = C_DPOTRF('L', naux_, U->pointer()[0], naux_);
+        if (info != 0) {
+            outfile->Printf("    DFHelper: the metric is not positive definite (DPOTRF info %d), using its power.\n",
+                            info);
+            timer_off("DFH: metric factor");
+            metric_solve_ = false;
+            return nullptr;
+        }
+        if (DFIntegralCache::instance().enabled()) DFIntegralCache::instance().put_matrix(cache_key, U);
+        metric_factor_ = U;
+    }
+    timer_off("DFH: metric factor");
+    return metric_factor_->pointer()[0];
+}
+void DFHelper::solve_metric_AO_core_symm(double* Qpq, double* Ppq, double* Up, size_t begin, size_t end) {
+    bool inverse = std::fabs(mpower_ + 1.0) < 1e-13;
+    size_t startind = symm_big_skips_[begin];
+#pragma omp parallel for num_threads(nthreads_) schedule(guided)
+    for (size_t j = begin; j <= end; j++) {
+        size_t mi = symm_small_skips_[j];
+        size_t si = small_skips_[j];
+        size_t jump = symm_ignored_columns_[j];
+        size_t skip1 = big_skips_[j];
+        size_t skip2 = symm_big_skips_[j] - startind;
+        double* target = &Ppq[skip1 + jump];
+        for (size_t Q = 0; Q < naux_; Q++) C_DCOPY(mi, &Qpq[skip2 + Q * mi], 1, &target[Q * si], 1);
+        // L^-1 (Q|pq), then L^-T for the full inverse
+        C_DTRSM('L', 'U', 'T', 'N', naux_, mi, 1.0, Up, naux_, target, si);
+        if (inverse) C_DTRSM('L', 'U', 'N', 'N', naux_, mi, 1.0, Up, naux_, target, si);
+    }
+// copy upper-to-lower
+#pragma omp parallel for num_threads(nthreads_) schedule(static)
+    for (size_t omu = begin; omu <= end; omu++) {
+        for (size_t Q = 0; Q < naux_; Q++) {
+            for (size_t onu = omu + 1; onu < nbf_; onu++) {
+                if (schwarz_fun_index_[omu * nbf_ + onu]) {
+                    size_t ind1 = big_skips_[onu] + Q * small_skips_[onu] + schwarz_fun_index_[onu * nbf_ + omu] - 1;
+                    size_t ind2 = big_skips_[omu] + Q * small_skips_[omu] + schwarz_fun_index_[omu * nbf_ + onu] - 1;
+                    Ppq[ind1] = Ppq[ind2];
+                }
+            }
+        }
+    }
+}
 void DFHelper::metric_contraction_blocking(std::vector<std::pair<size_t, size_t>>& steps, size_t blocking_index,
                                            size_t block_sizes, size_t total_mem, size_t memory_factor,
                                            size_t memory_bump) {
@@ -1735,6 +2134,10 @@ void DFHelper::add_transformation(std::string name, std::string key1, std::strin
     size_t a1 = std::get<1>(spaces_[key1]);
     size_t a2 = std::get<1>(spaces_[key2]);
     filename_maker(name, naux_, a1, a2, op);
+    if (disk_compress_) {
+        fp32_files_.insert(std::get<0>(files_[name]));
+        fp32_files_.insert(std::get<1>(files_[name]));
+    }
 }
 void DFHelper::clear_spaces() {
     // clear spaces
@@ -1754,6 +2157,7 @@ void DFHelper::clear_transformations() {
 
     transf_.clear();
     transf_core_.clear();
+    transf_core_bytes_.reset(0);
 }
 
 void DFHelper::clear_all() {
@@ -1765,6 +2169,7 @@ void DFHelper::clear_all() {
     files_.clear();
     sizes_.clear();
     tsizes_.clear();
+    fp32_files_.clear();
     clear_transformations();
 }
 
@@ -1856,11 +2261,31 @@ void DFHelper::transform() {
     size_t wfinal = std::get<1>(info_);
 
     // prep AO file stream if STORE + !AO_core_
-    if (!direct_iaQ_ && !direct_ && !AO_core_) stream_check(AO_names_[1], "rb");
+    if (!direct_iaQ_ && !direct_ && !AO_core_) {
+        if (disk_mmap_) {
+            map_check(AO_names_[1], big_skips_[nbf_] * disk_word(AO_names_[1]), false);
+        } else {
+            stream_check(AO_names_[1], "rb");
+        }
+    }
+
+    // overlap disk reads and writes with the contractions?
+    bool prefetch_AO = (overlap_io_ && !direct_iaQ_ && !direct_ && !AO_core_);
+    bool async_MO = (overlap_io_ && !MO_core_);
 
-    // get Q blocking scheme
+    // get Q blocking scheme, making room for the extra I/O buffers if possible
     std::vector<std::pair<size_t, size_t>> Qsteps;
-    std::pair<size_t, size_t> Qlargest = Qshell_blocks_for_transform(memory_, wtmp, wfinal, Qsteps);
+    std::pair<size_t, size_t> Qlargest;
+    if (prefetch_AO || async_MO) {
+        try {
+            Qlargest = Qshell_blocks_for_transform(memory_, wtmp, wfinal, Qsteps, (prefetch_AO ? 2 : 1),
+                                                   (async_MO ? 2 : 1));
+        } catch (const PsiException&) {
+            Qsteps.clear();
+            prefetch_AO = async_MO = false;
+        }
+    }
+    if (!prefetch_AO && !async_MO) Qlargest = Qshell_blocks_for_transform(memory_, wtmp, wfinal, Qsteps);
     size_t max_block = std::get<1>(Qlargest);
 
     // prepare eri and C buffers per thread
@@ -1883,35 +2308,60 @@ void DFHelper::transform() {
 
     // allocate in-core transformed integrals if necessary
     if (MO_core_) {
+        size_t total = 0;
         for (auto& kv : transf_) {
             size_t size = std::get<1>(spaces_[std::get<0>(kv.second)]) * std::get<1>(spaces_[std::get<1>(kv.second)]);
             transf_core_[kv.first] = std::unique_ptr<double[]>(new double[size * naux_]);
+            huge_pages_advise(transf_core_[kv.first].get(), size * naux_ * sizeof(double));
+            total += size * naux_;
         }
+        transf_core_bytes_.reset(total * sizeof(double));
     }
 
     // scope buffer declarations
     {
-        // declare buffers
+        // declare buffers, doubled for the final MO buffers if they are written asynchronously
+        size_t nMO = (async_MO ? 2 : 1);
         std::unique_ptr<double[]> T(new double[max_block * nbf_ * wtmp]);
-        std::unique_ptr<double[]> F(new double[max_block * wfinal]);
-        std::unique_ptr<double[]> N;
+        std::vector<std::unique_ptr<double[]>> F(nMO);
+        std::vector<std::unique_ptr<double[]>> N(nMO);
+        for (size_t b = 0; b < nMO; b++) {
+            F[b] = std::unique_ptr<double[]>(new double[max_block * wfinal]);
+            if (!MO_core_) N[b] = std::unique_ptr<double[]>(new double[max_block * wfinal]);
+        }
         double* Tp = T.get();
-        double* Fp = F.get();
+        double* Fp = F[0].get();
         double* Np;
         if (!MO_core_) {
-            N = std::unique_ptr<double[]>(new double[max_block * wfinal]);
-            Np = N.get();
+            Np = N[0].get();
         }
 
         // AO buffer, allocate if not in-core, else point to in-core
-        std::unique_ptr<double[]> M;
+        size_t nAO = (prefetch_AO ? 2 : 1);
+        std::vector<std::unique_ptr<double[]>> M(nAO);
         double* Mp;
         if (!AO_core_) {
-            M = std::unique_ptr<double[]>(new double[std::get<0>(Qlargest)]);
-            Mp = M.get();
+            for (size_t b = 0; b < nAO; b++) M[b] = std::unique_ptr<double[]>(new double[std::get<0>(Qlargest)]);
+            Mp = M[0].get();
         } else {
             Mp = Ppq_.get();
         }
+        size_t scratch = max_block * nbf_ * wtmp + nMO * max_block * wfinal * (MO_core_ ? 1 : 2);
+        if (!AO_core_) scratch += nAO * std::get<0>(Qlargest);
+        TrackedBytes scratch_bytes(scratch * sizeof(double));
+
+        // the read -> transform -> write pipeline: the next AO block is read and the last MO block
+        // is written while the current one is contracted. one job in flight per stage bounds the memory.
+        // declared after the buffers, so pending jobs finish before the buffers are released.
+        std::future<void> AO_read;
+        std::future<void> MO_write;
+        size_t MO_count = 0;
+        if (prefetch_AO) {
+            size_t start = std::get<0>(Qsteps[0]);
+            size_t stop = std::get<1>(Qsteps[0]);
+            double* Rp = M[0].get();
+            AO_read = std::async(std::launch::async, [this, start, stop, Rp]() { grab_AO(start, stop, Rp); });
+        }
 
         // transform in steps, blocking over the auxiliary basis (Q blocks)
         for (size_t j = 0, bcount = 0, block_size; j < Qsteps.size(); j++, bcount += block_size) {
@@ -1937,6 +2387,19 @@ void DFHelper::transform() {
                 timer_on("DFH: Total Workflow");
                 compute_sparse_pQq_blocking_Q(start, stop, Mp, eri);
                 timer_off("DFH: Total Workflow");
+            } else if (prefetch_AO) {
+                // wait for this block, then start on the next one
+                timer_on("DFH: Grabbing AOs");
+                AO_read.get();
+                timer_off("DFH: Grabbing AOs");
+                Mp = M[j % 2].get();
+                if (j + 1 < Qsteps.size()) {
+                    size_t nstart = std::get<0>(Qsteps[j + 1]);
+                    size_t nstop = std::get<1>(Qsteps[j + 1]);
+                    double* Rp = M[(j + 1) % 2].get();
+                    AO_read =
+                        std::async(std::launch::async, [this, nstart, nstop, Rp]() { grab_AO(nstart, nstop, Rp); });
+                }
             } else {
                 timer_on("DFH: Grabbing AOs");
                 grab_AO(start, stop, Mp);
@@ -1986,6 +2449,10 @@ void DFHelper::transform() {
                         Fp = transf_core_[order_[count + k]].get();
                     } else if (MO_core_) {
                         Np = transf_core_[order_[count + k]].get();
+                    } else if (async_MO) {
+                        // the write that last used this pair has finished
+                        Fp = F[MO_count % 2].get();
+                        Np = N[MO_count % 2].get();
                     }
 
                     // perform final contraction
@@ -2021,7 +2488,20 @@ void DFHelper::transform() {
 
                     // put the transformations away
                     timer_on("DFH: MO to disk, " + transf_name);
-                    if (direct_iaQ_) {
+                    if (async_MO) {
+                        // writes go out in order, one at a time
+                        if (MO_write.valid()) MO_write.get();
+                        size_t ind = count + k;
+                        MO_write = std::async(std::launch::async, [=]() {
+                            if (direct_iaQ_) {
+                                put_transformations_Qpq(begin, end, wsize, bsize, Fp, ind, bleft);
+                            } else {
+                                put_transformations_pQq(begin, end, block_size, bcount, wsize, bsize, Np, Fp, ind,
+                                                        bleft);
+                            }
+                        });
+                        MO_count++;
+                    } else if (direct_iaQ_) {
                         put_transformations_Qpq(begin, end, wsize, bsize, Fp, count + k, bleft);
                     } else {
                         put_transformations_pQq(begin, end, block_size, bcount, wsize, bsize, Np, Fp, count + k, bleft);
@@ -2030,6 +2510,13 @@ void DFHelper::transform() {
                 }
             }
         }
+
+        // drain the last write
+        if (MO_write.valid()) {
+            timer_on("DFH: MO to disk");
+            MO_write.get();
+            timer_off("DFH: MO to disk");
+        }
     }  // buffers destroyed with std housekeeping
 
     // outfile->Printf("\n     ==> DFHelper:--End Transformations (disk)<==\n\n");
@@ -2313,25 +2800,25 @@ void DFHelper::put_transformations_pQq(int begin, int end, int rblock_size, int
 // Fill using a pointer, be cautious of bounds!!
 void DFHelper::fill_tensor(std::string name, double* b) {
     check_file_key(name);
-    std::string filename = std::get<1>(files_[name]);
+    std::string filename = std::get<1>(files_.at(name));
     std::tuple<size_t, size_t, size_t> sizes;
-    sizes = (tsizes_.find(filename) != tsizes_.end() ? tsizes_[filename] : sizes_[filename]);
+    sizes = (tsizes_.find(filename) != tsizes_.end() ? tsizes_.at(filename) : sizes_.at(filename));
 
     fill_tensor(name, b, {0, std::get<0>(sizes)}, {0, std::get<1>(sizes)}, {0, std::get<2>(sizes)});
 }
 void DFHelper::fill_tensor(std::string name, double* b, std::vector<size_t> a1) {
     check_file_key(name);
-    std::string filename = std::get<1>(files_[name]);
+    std::string filename = std::get<1>(files_.at(name));
     std::tuple<size_t, size_t, size_t> sizes;
-    sizes = (tsizes_.find(filename) != tsizes_.end() ? tsizes_[filename] : sizes_[filename]);
+    sizes = (tsizes_.find(filename) != tsizes_.end() ? tsizes_.at(filename) : sizes_.at(filename));
 
     fill_tensor(name, b, a1, {0, std::get<1>(sizes)}, {0, std::get<2>(sizes)});
 }
 void DFHelper::fill_tensor(std::string name, double* b, std::vector<size_t> a1, std::vector<size_t> a2) {
     check_file_key(name);
-    std::string filename = std::get<1>(files_[name]);
+    std::string filename = std::get<1>(files_.at(name));
     std::tuple<size_t, size_t, size_t> sizes;
-    sizes = (tsizes_.find(filename) != tsizes_.end() ? tsizes_[filename] : sizes_[filename]);
+    sizes = (tsizes_.find(filename) != tsizes_.end() ? tsizes_.at(filename) : sizes_.at(filename));
 
     fill_tensor(name, b, a1, a2, {0, std::get<2>(sizes)});
 }
@@ -2354,7 +2841,7 @@ void DFHelper::fill_tensor(std::string name, double* b, std::vector<size_t> a1,
     }
 
     check_file_key(name);
-    std::string filename = std::get<1>(files_[name]);
+    std::string filename = std::get<1>(files_.at(name));
 
     // being pythonic ;)
     std::pair<size_t, size_t> i0 = std::make_pair(a1[0], a1[1] - 1);
@@ -2366,32 +2853,36 @@ void DFHelper::fill_tensor(std::string name, double* b, std::vector<size_t> a1,
 
 // Fill using a pre-allocated SharedMatrix
 void DFHelper::fill_tensor(std::string name, SharedMatrix M) {
-    std::string filename = std::get<1>(files_[name]);
+    check_file_key(name);
+    std::string filename = std::get<1>(files_.at(name));
     std::tuple<size_t, size_t, size_t> sizes;
-    sizes = (tsizes_.find(filename) != tsizes_.end() ? tsizes_[filename] : sizes_[filename]);
+    sizes = (tsizes_.find(filename) != tsizes_.end() ? tsizes_.at(filename) : sizes_.at(filename));
 
     fill_tensor(name, M, {0, std::get<0>(sizes)}, {0, std::get<1>(sizes)}, {0, std::get<2>(sizes)});
 }
 void DFHelper::fill_tensor(std::string name, SharedMatrix M, std::vector<size_t> a1) {
-    std::string filename = std::get<1>(files_[name]);
+    check_file_key(name);
+    std::string filename = std::get<1>(files_.at(name));
     std::tuple<size_t, size_t, size_t> sizes;
-    sizes = (tsizes_.find(filename) != tsizes_.end() ? tsizes_[filename] : sizes_[filename]);
+    sizes = (tsizes_.find(filename) != tsizes_.end() ? tsizes_.at(filename) : sizes_.at(filename));
 
     fill_tensor(name, M, a1, {0, std::get<1>(sizes)}, {0, std::get<2>(sizes)});
 }
 void DFHelper::fill_tensor(std::string name, SharedMatrix M, std::vector<size_t> a1, std::vector<size_t> a2) {
-    std::string filename = std::get<1>(files_[name]);
+    check_file_key(name);
+    std::string filename = std::get<1>(files_.at(name));
     std::tuple<size_t, size_t, size_t> sizes;
-    sizes = (tsizes_.find(filename) != tsizes_.end() ? tsizes_[filename] : sizes_[filename]);
+    sizes = (tsizes_.find(filename) != tsizes_.end() ? tsizes_.at(filename) : sizes_.at(filename));
 
     fill_tensor(name, M, a1, a2, {0, std::get<2>(sizes)});
 }
 void DFHelper::fill_tensor(std::string name, SharedMatrix M, std::vector<size_t> t0, std::vector<size_t> t1,
                            std::vector<size_t> t2) {
-    std::string filename = std::get<1>(files_[name]);
+    check_file_key(name);
+    std::string filename = std::get<1>(files_.at(name));
     // has this integral been transposed?
     std::tuple<size_t, size_t, size_t> sizes;
-    sizes = (tsizes_.find(filename) != tsizes_.end() ? tsizes_[filename] : sizes_[filename]);
+    sizes = (tsizes_.find(filename) != tsizes_.end() ? tsizes_.at(filename) : sizes_.at(filename));
 
     if (t0.size() != 2) {
         std::stringstream error;
@@ -2435,7 +2926,7 @@ void DFHelper::fill_tensor(std::string name, SharedMatrix M, std::vector<size_t>
         size_t a1 = std::get<1>(sizes);
         size_t a2 = std::get<2>(sizes);
 
-        double* Fp = transf_core_[name].get();
+        double* Fp = transf_core_.at(name).get();
 #pragma omp parallel for num_threads(nthreads_)
         for (size_t i = 0; i < A0; i++) {
             for (size_t j = 0; j < A1; j++) {
@@ -2453,32 +2944,36 @@ void DFHelper::fill_tensor(std::string name, SharedMatrix M, std::vector<size_t>
 
 // Return a SharedMatrix
 SharedMatrix DFHelper::get_tensor(std::string name) {
-    std::string filename = std::get<1>(files_[name]);
+    check_file_key(name);
+    std::string filename = std::get<1>(files_.at(name));
     std::tuple<size_t, size_t, size_t> sizes;
-    sizes = (tsizes_.find(filename) != tsizes_.end() ? tsizes_[filename] : sizes_[filename]);
+    sizes = (tsizes_.find(filename) != tsizes_.end() ? tsizes_.at(filename) : sizes_.at(filename));
 
     return get_tensor(name, {0, std::get<0>(sizes)}, {0, std::get<1>(sizes)}, {0, std::get<2>(sizes)});
 }
 SharedMatrix DFHelper::get_tensor(std::string name, std::vector<size_t> a1) {
-    std::string filename = std::get<1>(files_[name]);
+    check_file_key(name);
+    std::string filename = std::get<1>(files_.at(name));
     std::tuple<size_t, size_t, size_t> sizes;
-    sizes = (tsizes_.find(filename) != tsizes_.end() ? tsizes_[filename] : sizes_[filename]);
+    sizes = (tsizes_.find(filename) != tsizes_.end() ? tsizes_.at(filename) : sizes_.at(filename));
 
     return get_tensor(name, a1, {0, std::get<1>(sizes)}, {0, std::get<2>(sizes)});
 }
 SharedMatrix DFHelper::get_tensor(std::string name, std::vector<size_t> a1, std::vector<size_t> a2) {
-    std::string filename = std::get<1>(files_[name]);
+    check_file_key(name);
+    std::string filename = std::get<1>(files_.at(name));
     std::tuple<size_t, size_t, size_t> sizes;
-    sizes = (tsizes_.find(filename) != tsizes_.end() ? tsizes_[filename] : sizes_[filename]);
+    sizes = (tsizes_.find(filename) != tsizes_.end() ? tsizes_.at(filename) : sizes_.at(filename));
 
     return get_tensor(name, a1, a2, {0, std::get<2>(sizes)});
 }
 SharedMatrix DFHelper::get_tensor(std::string name, std::vector<size_t> t0, std::vector<size_t> t1,
                                   std::vector<size_t> t2) {
+    check_file_key(name);
     // has this integral been transposed?
-    std::string filename = std::get<1>(files_[name]);
+    std::string filename = std::get<1>(files_.at(name));
     std::tuple<size_t, size_t, size_t> sizes;
-    sizes = (tsizes_.find(filename) != tsizes_.end() ? tsizes_[filename] : sizes_[filename]);
+    sizes = (tsizes_.find(filename) != tsizes_.end() ? tsizes_.at(filename) : sizes_.at(filename));
 
     if (t0.size() != 2) {
         std::stringstream error;
@@ -2523,7 +3018,7 @@ SharedMatrix DFHelper::get_tensor(std::string name, std::vector<size_t> t0, std:
         size_t a1 = std::get<1>(sizes);
         size_t a2 = std::get<2>(sizes);
 
-        double* Fp = transf_core_[name].get();
+        double* Fp = transf_core_.at(name).get();
 #pragma omp parallel for num_threads(nthreads_)
         for (size_t i = 0; i < A0; i++) {
             for (size_t j = 0; j < A1; j++) {
@@ -2549,6 +3044,10 @@ void DFHelper::add_disk_tensor(std::string key, std::tuple<size_t, size_t, size_
     }
 
     filename_maker(key, std::get<0>(dimensions), std::get<1>(dimensions), std::get<2>(dimensions));
+    if (disk_compress_) {
+        fp32_files_.insert(std::get<0>(files_[key]));
+        fp32_files_.insert(std::get<1>(files_[key]));
+    }
 }
 
 // Write to a disk tensor from Sharedmatrix
@@ -2556,21 +3055,21 @@ void DFHelper::write_disk_tensor(std::string key, SharedMatrix M) {
     check_file_key(key);
     std::string filename = std::get<1>(files_[key]);
     std::tuple<size_t, size_t, size_t> sizes;
-    sizes = (tsizes_.find(filename) != tsizes_.end() ? tsizes_[filename] : sizes_[filename]);
+    sizes = (tsizes_.find(filename) != tsizes_.end() ? tsizes_.at(filename) : sizes_.at(filename));
     write_disk_tensor(key, M, {0, std::get<0>(sizes)}, {0, std::get<1>(sizes)}, {0, std::get<2>(sizes)});
 }
 void DFHelper::write_disk_tensor(std::string key, SharedMatrix M, std::vector<size_t> a1) {
     check_file_key(key);
     std::string filename = std::get<1>(files_[key]);
     std::tuple<size_t, size_t, size_t> sizes;
-    sizes = (tsizes_.find(filename) != tsizes_.end() ? tsizes_[filename] : sizes_[filename]);
+    sizes = (tsizes_.find(filename) != tsizes_.end() ? tsizes_.at(filename) : sizes_.at(filename));
     write_disk_tensor(key, M, a1, {0, std::get<1>(sizes)}, {0, std::get<2>(sizes)});
 }
 void DFHelper::write_disk_tensor(std::string key, SharedMatrix M, std::vector<size_t> a1, std::vector<size_t> a2) {
     check_file_key(key);
     std::string filename = std::get<1>(files_[key]);
     std::tuple<size_t, size_t, size_t> sizes;
-    sizes = (tsizes_.find(filename) != tsizes_.end() ? tsizes_[filename] : sizes_[filename]);
+    sizes = (tsizes_.find(filename) != tsizes_.end() ? tsizes_.at(filename) : sizes_.at(filename));
     write_disk_tensor(key, M, a1, a2, {0, std::get<2>(sizes)});
 }
 void DFHelper::write_disk_tensor(std::string key, SharedMatrix M, std::vector<size_t> a0, std::vector<size_t> a1,
@@ -2595,21 +3094,21 @@ void DFHelper::write_disk_tensor(std::string key, double* b) {
     check_file_key(key);
     std::string filename = std::get<1>(files_[key]);
     std::tuple<size_t, size_t, size_t> sizes;
-    sizes = (tsizes_.find(filename) != tsizes_.end() ? tsizes_[filename] : sizes_[filename]);
+    sizes = (tsizes_.find(filename) != tsizes_.end() ? tsizes_.at(filename) : sizes_.at(filename));
     write_disk_tensor(key, b, {0, std::get<0>(sizes)}, {0, std::get<1>(sizes)}, {0, std::get<2>(sizes)});
 }
 void DFHelper::write_disk_tensor(std::string key, double* b, std::vector<size_t> a0) {
     check_file_key(key);
     std::string filename = std::get<1>(files_[key]);
     std::tuple<size_t, size_t, size_t> sizes;
-    sizes = (tsizes_.find(filename) != tsizes_.end() ? tsizes_[filename] : sizes_[filename]);
+    sizes = (tsizes_.find(filename) != tsizes_.end() ? tsizes_.at(filename) : sizes_.at(filename));
     write_disk_tensor(key, b, a0, {0, std::get<1>(sizes)}, {0, std::get<2>(sizes)});
 }
 void DFHelper::write_disk_tensor(std::string key, double* b, std::vector<size_t> a0, std::vector<size_t> a1) {
     check_file_key(key);
     std::string filename = std::get<1>(files_[key]);
     std::tuple<size_t, size_t, size_t> sizes;
-    sizes = (tsizes_.find(filename) != tsizes_.end() ? tsizes_[filename] : sizes_[filename]);
+    sizes = (tsizes_.find(filename) != tsizes_.end() ? tsizes_.at(filename) : sizes_.at(filename));
     write_disk_tensor(key, b, a0, a1, {0, std::get<2>(sizes)});
 }
 void DFHelper::write_disk_tensor(std::string key, double* b, std::vector<size_t> a0, std::vector<size_t> a1,
@@ -2628,6 +3127,46 @@ void DFHelper::write_disk_tensor(std::string key, double* b, std::vector<size_t>
     put_tensor(std::get<1>(files_[key]), b, i0, i1, i2, op);
 }
 
+// Read-only view into a mapped disk tensor
+const double* DFHelper::disk_tensor_view(std::string name, std::vector<size_t> a1) {
+    if (!disk_mmap_) {
+        throw PSIEXCEPTION("DFHelper:disk_tensor_view: disk tensors are not mapped, call set_disk_mmap(true) first");
+    }
+    if (a1.size() != 2) {
+        std::stringstream error;
+        error << "DFHelper:disk_tensor_view:  axis 0 tensor indexing vector has " << a1.size() << " elements!";
+        throw PSIEXCEPTION(error.str().c_str());
+    }
+
+    check_file_key(name);
+    if (MO_core_ && transf_core_.count(name)) {
+        std::stringstream error;
+        error << "DFHelper:disk_tensor_view: " << name << " is held in core, not on disk.";
+        throw PSIEXCEPTION(error.str().c_str());
+    }
+
+    std::string filename = std::get<1>(files_.at(name));
+    if (fp32_files_.count(filename)) {
+        std::stringstream error;
+        error << "DFHelper:disk_tensor_view: " << name << " is stored in single precision, use fill_tensor.";
+        throw PSIEXCEPTION(error.str().c_str());
+    }
+    std::tuple<size_t, size_t, size_t> sizes;
+    sizes = (tsizes_.find(filename) != tsizes_.end() ? tsizes_.at(filename) : sizes_.at(filename));
+    size_t A0 = std::get<0>(sizes);
+    size_t A1 = std::get<1>(sizes) * std::get<2>(sizes);
+
+    if (a1[0] > a1[1] || a1[1] > A0) {
+        std::stringstream error;
+        error << "DFHelper:disk_tensor_view: your axis 0 slice (" << a1[0] << ", " << a1[1]
+              << ") is out of bounds for the (" << name << ") integral of size: " << A0;
+        throw PSIEXCEPTION(error.str().c_str());
+    }
+
+    double* Fp = static_cast<double*>(map_check(filename, A0 * A1 * sizeof(double), false));
+    return (Fp == nullptr ? nullptr : &Fp[a1[0] * A1]);
+}
+
 void DFHelper::check_file_key(std::string name) {
     if (files_.find(name) == files_.end()) {
         std::stringstream error;
@@ -2660,11 +3199,11 @@ void DFHelper::check_file_tuple(std::string name, std::pair<size_t, size_t> t0,
     size_t sto1 = std::get<1>(t1);
     size_t sta2 = std::get<0>(t2);
     size_t sto2 = std::get<1>(t2);
-    std::string filename = std::get<1>(files_[name]);
+    std::string filename = std::get<1>(files_.at(name));
 
     // has this integral been transposed?
     std::tuple<size_t, size_t, size_t> sizes;
-    sizes = (tsizes_.find(filename) != tsizes_.end() ? tsizes_[filename] : sizes_[filename]);
+    sizes = (tsizes_.find(filename) != tsizes_.end() ? tsizes_.at(filename) : sizes_.at(filename));
 
     if (sta0 > sto0) {
         std::stringstream error;
@@ -2884,6 +3423,7 @@ void DFHelper::transpose_disk(std::string name, std::tuple<size_t, size_t, size_
     std::string new_file = "newfilefortransposition";
     filename_maker(new_file, std::get<0>(sizes), std::get<1>(sizes), std::get<2>(sizes));
     std::string new_filename = std::get<1>(files_[new_file]);
+    if (fp32_files_.count(filename)) fp32_files_.insert(new_filename);
 
     for (size_t m = 0; m < steps.size(); m++) {
         std::string op = (m ? "r+b" : "wb");
@@ -2967,6 +3507,7 @@ void DFHelper::transpose_disk(std::string name, std::tuple<size_t, size_t, size_
 
     // keep tsizes_ separate and do not ovwrt sizes_ in case of STORE directive
     files_.erase(new_file);
+    fp32_files_.erase(new_filename);
     tsizes_[filename] = sizes;
 }
 size_t DFHelper::get_space_size(std::string name) {
@@ -3003,6 +3544,10 @@ void DFHelper::build_JK(std::vector<SharedMatrix> Cleft, std::vector<SharedMatri
     bool store_k = do_K;
     if ( do_wK && wcombine_ ) { do_K = false; } 
 
+    JK_disk_bytes_ = 0;
+    JK_flops_ = 0.0;
+    JK_contraction_time_ = 0.0;
+
     // This was an if-else statement. Presumably, we could manage J construction
     //   to more effectively manage memory, so I think that was what was going on.
     if (do_J || do_K) {
@@ -3039,6 +3584,7 @@ void DFHelper::compute_JK(std::vector<SharedMatrix> Cleft, std::vector<SharedMat
     // 1. we could predict the blocks used, write them to different files, and improve IO, otherwise
     // the strided disk reads for the AOs will result in a definite loss to DiskDFJK in the disk-bound realm
     // 2. we could allocate the buffers only once, instead of every time compute_JK() is called
+    //    (the work buffers are now kept between calls and only grown, see JK_buffer())
 
     // Each element of Qsteps specifies the endpoints of a batch of auxiliary shells.
     // We'll treat all (PN|Q) for Q in this batch at once.
@@ -3048,31 +3594,22 @@ void DFHelper::compute_JK(std::vector<SharedMatrix> Cleft, std::vector<SharedMat
     size_t totsb = std::get<1>(info);
 
     // prep stream, blocking
-    if (!direct_ && !AO_core_) stream_check(AO_names_[1], "rb");
-
-    std::vector<std::vector<double>> C_buffers(nthreads_);
-
-// prepare C buffers
-#pragma omp parallel num_threads(nthreads_)
-    {
-        int rank = 0;
-#ifdef _OPENMP
-        rank = omp_get_thread_num();
-#endif
-        C_buffers[rank] = std::vector<double>(nbf_ * std::max(max_nocc, nbf_));
+    if (!direct_ && !AO_core_) {
+        if (disk_mmap_) {
+            map_check(AO_names_[1], big_skips_[nbf_] * disk_word(AO_names_[1]), false);
+        } else {
+            stream_check(AO_names_[1], "rb");
+        }
     }
 
-    // declare bufs
-    std::unique_ptr<double[]> M;   // AOs
-    std::unique_ptr<double[]> T1;  // Ktmp1
-    std::unique_ptr<double[]> T2;  // Ktmp2
+    // prepare C buffers
+    std::vector<std::vector<double>>& C_buffers = JK_C_buffers(max_nocc);
 
     // allocate first Ktmp
     size_t Ktmp_size = (!max_nocc ? totsb * 1 : totsb * max_nocc);
     Ktmp_size = std::max(Ktmp_size * nbf_, nthreads_ * naux_);  // max necessary
     Ktmp_size = std::max(Ktmp_size, nbf_ * nbf_); 
-    T1 = std::make_unique<double[]>(Ktmp_size);
-    double* T1p = T1.get();
+    double* T1p = JK_buffer(JK_T1_, JK_T1_size_, Ktmp_size);
 
     // if lr_symmetric, we can be more clever with mem usage. T2 is used for both the
     // second tmp in the K build, as well as the completed, pruned J build.
@@ -3086,13 +3623,11 @@ void DFHelper::compute_JK(std::vector<SharedMatrix> Cleft, std::vector<SharedMat
     Ktmp_size = std::max(Ktmp_size, nbf_ * nbf_); 
     Ktmp_size = std::max(Ktmp_size, nthreads_ * naux_);
 
-    T2 = std::make_unique<double[]>(Ktmp_size);
-    double* T2p = T2.get();
+    double* T2p = JK_buffer(JK_T2_, JK_T2_size_, Ktmp_size);
 
     double* Mp;
     if (!AO_core_) {
-        M = std::make_unique<double[]>(tots);
-        Mp = M.get();
+        Mp = JK_buffer(JK_M_, JK_M_size_, tots);
     } else
         if (!wcombine_) {Mp = Ppq_.get();}
 
@@ -3101,6 +3636,13 @@ void DFHelper::compute_JK(std::vector<SharedMatrix> Cleft, std::vector<SharedMat
         M1p = m1Ppq_.get();
     }
 
+    // Pick out which rows of the half-transformed integrals survive orbital screening
+    if (do_K && K_orbital_cutoff_ > 0.0) {
+        timer_on("DFH: sparse K prep");
+        prepare_sparse_K(Cleft, Cright, lr_symmetric);
+        timer_off("DFH: sparse K prep");
+    }
+
     // Transform a single batch of integrals
     size_t bcount = 0;
     for (const auto& Qstep :Qsteps) {
@@ -3117,6 +3659,8 @@ void DFHelper::compute_JK(std::vector<SharedMatrix> Cleft, std::vector<SharedMat
             grab_AO(start, stop, Mp);
         }
         timer_off("DFH: Grabbing AOs");
+
+        double contraction_start = JKStats::wall_time();
         if (do_J) {
             timer_on("DFH: compute_J");
             if (wcombine_ && do_wK_) {
@@ -3129,18 +3673,69 @@ void DFHelper::compute_JK(std::vector<SharedMatrix> Cleft, std::vector<SharedMat
                 }
             }
             timer_off("DFH: compute_J");
+            JK_flops_ += 4.0 * block_size * small_skips_[nbf_] * D.size();
         }
 
         if (do_K) {
             timer_on("DFH: compute_K");
-            compute_K(Cleft, Cright, K, T1p, T2p, Mp, bcount, block_size, C_buffers, lr_symmetric);
+            if (K_orbital_cutoff_ > 0.0) {
+                compute_sparse_K(Cleft, Cright, K, T1p, T2p, Mp, bcount, block_size, C_buffers, lr_symmetric);
+            } else {
+                compute_K(Cleft, Cright, K, T1p, T2p, Mp, bcount, block_size, C_buffers, lr_symmetric);
+            }
             timer_off("DFH: compute_K");
         }
+        JK_contraction_time_ += JKStats::wall_time() - contraction_start;
 
         bcount += block_size;
     }
     // outfile->Printf("\n     ==> DFHelper:--End J/K Builds (disk)<==\n\n");
 }
+double* DFHelper::JK_buffer(std::unique_ptr<double[]>& buffer, size_t& current, size_t required) {
+    if (required > current) {
+        buffer = std::make_unique<double[]>(required);
+        current = required;
+    }
+    return buffer.get();
+}
+std::vector<std::vector<double>>& DFHelper::JK_C_buffers(size_t max_nocc) {
+    size_t required = nbf_ * std::max(max_nocc, nbf_);
+    if (JK_C_buffers_.size() != nthreads_ || JK_C_buffers_size_ < required) {
+        JK_C_buffers_.resize(nthreads_);
+// first touch by the thread that will use the buffer
+#pragma omp parallel num_threads(nthreads_)
+        {
+            int rank = 0;
+#ifdef _OPENMP
+            rank = omp_get_thread_num();
+#endif
+            JK_C_buffers_[rank] = std::vector<double>(required);
+        }
+        JK_C_buffers_size_ = required;
+    }
+    return JK_C_buffers_;
+}
+size_t DFHelper::get_JK_scratch_bytes() const {
+    size_t bytes = (JK_T1_size_ + JK_T2_size_ + JK_M_size_ + JK_Ksub_size_) * sizeof(double);
+    bytes += JK_C_buffers_.size() * JK_C_buffers_size_ * sizeof(double);
+    bytes += (K_sp_T1_.size() + K_sp_T2_.size() + K_sp_K_.size()) * sizeof(float);
+    return bytes;
+}
+void DFHelper::clear_JK_buffers() {
+    JK_C_buffers_.clear();
+    JK_C_buffers_size_ = 0;
+    JK_T1_.reset();
+    JK_T1_size_ = 0;
+    JK_T2_.reset();
+    JK_T2_size_ = 0;
+    JK_M_.reset();
+    JK_M_size_ = 0;
+    JK_Ksub_.reset();
+    JK_Ksub_size_ = 0;
+    std::vector<float>().swap(K_sp_T1_);
+    std::vector<float>().swap(K_sp_T2_);
+    std::vector<float>().swap(K_sp_K_);
+}
 void DFHelper::compute_J_symm(std::vector<SharedMatrix> D, std::vector<SharedMatrix> J, double* Mp, double* T1p,
                               double* T2p, std::vector<std::vector<double>>& D_buffers, size_t bcount,
                               size_t block_size) {
@@ -3352,9 +3947,171 @@ void DFHelper::compute_K(std::vector<SharedMatrix> Cleft, std::vector<SharedMatr
             first_transform_pQq(nocc, bcount, block_size, Mp, T2p, Crp, C_buffers);
         }
 
+        JK_flops_ += (lr_symmetric ? 2.0 : 4.0) * block_size * nocc * small_skips_[nbf_] +
+                     2.0 * nbf_ * nbf_ * nocc * block_size;
+
         // compute K
-        C_DGEMM('N', 'T', nbf_, nbf_, nocc * block_size, 1.0, T1p, nocc * block_size, T2p, nocc * block_size, 1.0, Kp,
-                nbf_);
+        if (K_low_precision_) {
+            sp_contract_K(nocc * block_size, T1p, (lr_symmetric ? nullptr : T2p), Kp, nbf_);
+        } else {
+            C_DGEMM('N', 'T', nbf_, nbf_, nocc * block_size, 1.0, T1p, nocc * block_size, T2p, nocc * block_size, 1.0,
+                    Kp, nbf_);
+        }
+    }
+}
+void DFHelper::sp_contract_K(size_t ncol, double* T1p, double* T2p, double* Kp, size_t ldk) {
+    // T2p == nullptr means the left and right operands are the same
+    size_t tsize = nbf_ * ncol;
+    if (K_sp_T1_.size() < tsize) K_sp_T1_.resize(tsize);
+    if (T2p && K_sp_T2_.size() < tsize) K_sp_T2_.resize(tsize);
+    if (K_sp_K_.size() < nbf_ * nbf_) K_sp_K_.resize(nbf_ * nbf_);
+
+    float* T1f = K_sp_T1_.data();
+    float* T2f = (T2p ? K_sp_T2_.data() : T1f);
+    float* Kf = K_sp_K_.data();
+
+#pragma omp parallel for simd num_threads(nthreads_)
+    for (size_t i = 0; i < tsize; i++) T1f[i] = static_cast<float>(T1p[i]);
+    if (T2p) {
+#pragma omp parallel for simd num_threads(nthreads_)
+        for (size_t i = 0; i < tsize; i++) T2f[i] = static_cast<float>(T2p[i]);
+    }
+
+    C_SGEMM('N', 'T', nbf_, nbf_, ncol, 1.0f, T1f, ncol, T2f, ncol, 0.0f, Kf, nbf_);
+
+    // accumulate in double
+#pragma omp parallel for num_threads(nthreads_)
+    for (size_t m = 0; m < nbf_; m++) {
+        for (size_t n = 0; n < nbf_; n++) Kp[m * ldk + n] += static_cast<double>(Kf[m * nbf_ + n]);
+    }
+}
+void DFHelper::prepare_sparse_K(std::vector<SharedMatrix> Cleft, std::vector<SharedMatrix> Cright, bool lr_symmetric) {
+    // For each occupied block b and basis function k, the half-transformed row (k|Q)(Q|m)C_mi, i in b,
+    // is negligible if every Schwarz partner m of k has negligible coefficients in b.
+    auto significant_functions = [&](SharedMatrix C, std::vector<std::vector<size_t>>& funcs) {
+        size_t nocc = C->colspi()[0];
+        size_t nblocks = (nocc + K_occ_block_ - 1) / K_occ_block_;
+        double* Cp = (nocc ? C->pointer()[0] : nullptr);
+
+        // largest coefficient of each function within each occupied block
+        std::vector<double> cmax(nbf_ * nblocks, 0.0);
+#pragma omp parallel for schedule(static) num_threads(nthreads_)
+        for (size_t m = 0; m < nbf_; m++) {
+            for (size_t i = 0; i < nocc; i++) {
+                double val = std::fabs(Cp[m * nocc + i]);
+                double& bmax = cmax[m * nblocks + i / K_occ_block_];
+                bmax = std::max(bmax, val);
+            }
+        }
+
+        std::vector<std::vector<bool>> sig(nblocks, std::vector<bool>(nbf_, false));
+#pragma omp parallel for schedule(guided) num_threads(nthreads_)
+        for (size_t k = 0; k < nbf_; k++) {
+            std::vector<double> kmax(nblocks, 0.0);
+            for (size_t m = 0; m < nbf_; m++) {
+                if (schwarz_fun_index_[k * nbf_ + m]) {
+                    for (size_t b = 0; b < nblocks; b++) kmax[b] = std::max(kmax[b], cmax[m * nblocks + b]);
+                }
+            }
+            for (size_t b = 0; b < nblocks; b++) sig[b][k] = (kmax[b] > K_orbital_cutoff_);
+        }
+
+        funcs.assign(nblocks, std::vector<size_t>());
+        for (size_t b = 0; b < nblocks; b++) {
+            for (size_t k = 0; k < nbf_; k++) {
+                if (sig[b][k]) funcs[b].push_back(k);
+            }
+        }
+    };
+
+    K_left_funcs_.resize(Cleft.size());
+    K_right_funcs_.resize(Cleft.size());
+    for (size_t i = 0; i < Cleft.size(); i++) {
+        significant_functions(Cleft[i], K_left_funcs_[i]);
+        if (lr_symmetric) {
+            K_right_funcs_[i] = K_left_funcs_[i];
+        } else {
+            significant_functions(Cright[i], K_right_funcs_[i]);
+        }
+    }
+}
+void DFHelper::sparse_transform_pQq(const std::vector<size_t>& funcs, size_t nocc, size_t ostart, size_t osize,
+                                    size_t bcount, size_t block_size, double* Mp, double* Tp, double* Bp,
+                                    std::vector<std::vector<double>>& C_buffers) {
+// first contraction on pQq for the significant functions only, restricted to occupied columns
+// [ostart, ostart + osize). Row a of Tp belongs to funcs[a].
+#pragma omp parallel for schedule(guided) num_threads(nthreads_)
+    for (size_t a = 0; a < funcs.size(); a++) {
+        size_t k = funcs[a];
+        size_t sp_size = small_skips_[k];
+        size_t jump = (AO_core_ ? big_skips_[k] + bcount * sp_size : (big_skips_[k] * block_size) / naux_);
+
+        int rank = 0;
+#ifdef _OPENMP
+        rank = omp_get_thread_num();
+#endif
+        for (size_t m = 0, sp_count = -1; m < nbf_; m++) {
+            if (schwarz_fun_index_[k * nbf_ + m]) {
+                sp_count++;
+                C_DCOPY(osize, &Bp[m * nocc + ostart], 1, &C_buffers[rank][sp_count * osize], 1);
+            }
+        }
+
+        // (Qm)(mb)->(Qb)
+        C_DGEMM('N', 'N', block_size, osize, sp_size, 1.0, &Mp[jump], sp_size, &C_buffers[rank][0], osize, 0.0,
+                &Tp[a * block_size * osize], osize);
+    }
+}
+void DFHelper::compute_sparse_K(std::vector<SharedMatrix> Cleft, std::vector<SharedMatrix> Cright,
+                                std::vector<SharedMatrix> K, double* T1p, double* T2p, double* Mp, size_t bcount,
+                                size_t block_size, std::vector<std::vector<double>>& C_buffers, bool lr_symmetric) {
+    double* Ksp = JK_buffer(JK_Ksub_, JK_Ksub_size_, nbf_ * nbf_);
+
+    for (size_t i = 0; i < K.size(); i++) {
+        size_t nocc = Cleft[i]->colspi()[0];
+        if (!nocc) {
+            continue;
+        }
+
+        double* Clp = Cleft[i]->pointer()[0];
+        double* Crp = Cright[i]->pointer()[0];
+        double* Kp = K[i]->pointer()[0];
+
+        for (size_t b = 0, ostart = 0; ostart < nocc; b++, ostart += K_occ_block_) {
+            size_t osize = std::min(K_occ_block_, nocc - ostart);
+            const auto& lfuncs = K_left_funcs_[i][b];
+            const auto& rfuncs = K_right_funcs_[i][b];
+            size_t nl = lfuncs.size();
+            size_t nr = rfuncs.size();
+            if (!nl || !nr) continue;
+
+            // half-transform only the significant rows
+            sparse_transform_pQq(lfuncs, nocc, ostart, osize, bcount, block_size, Mp, T1p, Clp, C_buffers);
+            double* TRp = T1p;
+            if (!lr_symmetric) {
+                sparse_transform_pQq(rfuncs, nocc, ostart, osize, bcount, block_size, Mp, T2p, Crp, C_buffers);
+                TRp = T2p;
+            }
+
+            // K sub-block over the significant functions, then scatter
+            C_DGEMM('N', 'T', nl, nr, osize * block_size, 1.0, T1p, osize * block_size, TRp, osize * block_size, 0.0,
+                    Ksp, nr);
+
+            size_t skips = 0;
+            for (const size_t k : lfuncs) skips += small_skips_[k];
+            if (!lr_symmetric) {
+                for (const size_t k : rfuncs) skips += small_skips_[k];
+            }
+            JK_flops_ += 2.0 * block_size * osize * skips + 2.0 * nl * nr * osize * block_size;
+
+#pragma omp parallel for schedule(static) num_threads(nthreads_)
+            for (size_t a = 0; a < nl; a++) {
+                double* Krow = &Kp[lfuncs[a] * nbf_];
+                for (size_t c = 0; c < nr; c++) {
+                    Krow[rfuncs[c]] += Ksp[a * nr + c];
+                }
+            }
+        }
     }
 }
 void DFHelper::compute_wK(std::vector<SharedMatrix> Cleft, std::vector<SharedMatrix> Cright,
@@ -3366,28 +4123,14 @@ void DFHelper::compute_wK(std::vector<SharedMatrix> Cleft, std::vector<SharedMat
 
     double* wMp = wPpq_.get();
     double* M1p = m1Ppq_.get();
-    std::vector<std::vector<double>> C_buffers(nthreads_);
-// prepare C buffers
-#pragma omp parallel num_threads(nthreads_)
-    {
-        int rank = 0;
-#ifdef _OPENMP
-        rank = omp_get_thread_num();
-#endif
-        C_buffers[rank] = std::vector<double>(nbf_ * std::max(max_nocc, nbf_));
-    }
-
-    // declare bufs
-    std::unique_ptr<double[]> T1;  // Ktmp1
-    std::unique_ptr<double[]> T2;  // Ktmp2
+    // prepare C buffers
+    std::vector<std::vector<double>>& C_buffers = JK_C_buffers(max_nocc);
 
     // allocate first Ktmp
     size_t Ktmp_size = (!max_nocc ? totsb * 1 : totsb * max_nocc);
     Ktmp_size = std::max(Ktmp_size * nbf_, nthreads_ * naux_);  // max necessary
-    T1 = std::make_unique<double[]>(Ktmp_size);
-    double* T1p = T1.get();
-    T2 = std::make_unique<double[]>(Ktmp_size);
-    double* T2p = T2.get();
+    double* T1p = JK_buffer(JK_T1_, JK_T1_size_, Ktmp_size);
+    double* T2p = JK_buffer(JK_T2_, JK_T2_size_, Ktmp_size);
 
     /* The rest of the file would usually be in compute_K */
     /* */
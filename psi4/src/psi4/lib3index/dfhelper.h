@@ -32,9 +32,12 @@
 #include "psi4/psi4-dec.h"
 #include <psi4/libmints/typedefs.h>
 #include "psi4/libpsi4util/exception.h"
+#include "psi4/libpsi4util/memory_tracker.h"
 
 #include <map>
 #include <list>
+#include <mutex>
+#include <set>
 #include <vector>
 #include <tuple>
 #include <string>
@@ -126,6 +129,33 @@ class PSI_API DFHelper {
     void set_MO_core(bool core) { MO_core_ = core; }
     bool get_MO_core() { return MO_core_; }
 
+    ///
+    /// Memory-map disk tensors instead of streaming them. (Defaults to FALSE)
+    /// @param mmap True to map the files of disk tensors and on-disk AOs
+    /// Reads and writes become copies to and from the page cache,
+    /// and disk_tensor_view() can hand out zero-copy slices.
+    ///
+    void set_disk_mmap(bool mmap) { disk_mmap_ = mmap; }
+    bool get_disk_mmap() { return disk_mmap_; }
+
+    ///
+    /// Overlap disk I/O with the GEMMs of an out-of-core transform(). (Defaults to TRUE)
+    /// @param overlap True to prefetch AO blocks and write MO blocks on separate threads
+    /// Costs one more AO block and one more pair of MO blocks of memory,
+    /// silently falls back to a single timeline if the blocking does not fit.
+    ///
+    void set_overlap_io(bool overlap) { overlap_io_ = overlap; }
+    bool get_overlap_io() { return overlap_io_; }
+
+    ///
+    /// Store on-disk AOs, transformations and disk tensors in single precision. (Defaults to FALSE)
+    /// @param compress True to halve the scratch volume of tensors added after this call
+    /// Introduces errors of roughly 1.0E-7 relative in the stored integrals,
+    /// the fitting metric is always kept in double precision.
+    ///
+    void set_disk_compress(bool compress) { disk_compress_ = compress; }
+    bool get_disk_compress() { return disk_compress_; }
+
     /// schwarz screening cutoff (defaults to 1e-12)
     void set_schwarz_cutoff(double cutoff) { cutoff_ = cutoff; }
     double get_schwarz_cutoff() { return cutoff_; }
@@ -148,6 +178,17 @@ class PSI_API DFHelper {
     void hold_met(bool hold) { hold_met_ = hold; }
     bool get_hold_met() { return hold_met_; }
 
+    ///
+    /// Apply the metric by triangular solves with its Cholesky factor J = L L^T instead of
+    /// forming J^pow (defaults to FALSE). Used by the in-core STORE build without wK.
+    /// A power of -1.0 is reproduced exactly. A power of -0.5 becomes L^-1, which differs
+    /// from J^-1/2 by a rotation of the auxiliary index: contractions over that index
+    /// (J and K) are unchanged, the fitted tensor itself is not.
+    /// Falls back to the power if the metric is not numerically positive definite.
+    ///
+    void set_metric_solve(bool solve) { metric_solve_ = solve; }
+    bool get_metric_solve() { return metric_solve_; }
+
     ///
     /// Sets the fitting metric condition
     /// @param condition: tolerrence for metric^pow
@@ -155,6 +196,16 @@ class PSI_API DFHelper {
     void set_fitting_condition(double condition) { condition_ = condition; }
     bool get_fitting_condition() { return condition_; }
 
+    ///
+    /// Compress the auxiliary space of in-core STORE integrals. (Defaults to 0.0, off)
+    /// @param tol Gram matrix eigenvalue of the fitted (Q|mn) below which an auxiliary
+    ///        direction is dropped during initialize(), before any transformation.
+    /// Needs the symmetric (-0.5) metric power and no wK. get_naux() then returns the
+    /// compressed rank, and transformations must be added after initialize().
+    ///
+    void set_aux_rank_tolerance(double tol) { aux_rank_tolerance_ = tol; }
+    double get_aux_rank_tolerance() { return aux_rank_tolerance_; }
+
 
     ///
     /// Do we calculate omega exchange and regular hf exchange together?
@@ -197,6 +248,33 @@ class PSI_API DFHelper {
     void set_omega_beta(double beta) { omega_beta_ = beta; }
     double get_omega_beta() { return omega_beta_; }
 
+    ///
+    /// Screens the K build on the occupied orbitals: for each block of occupied columns, only
+    /// basis functions with a Schwarz partner carrying a coefficient above cutoff are
+    /// half-transformed and contracted. Pays off for localized or otherwise sparse C.
+    /// @param cutoff coefficient cutoff, 0.0 (the default) uses the dense K build
+    ///
+    void set_K_orbital_cutoff(double cutoff) { K_orbital_cutoff_ = cutoff; }
+    double get_K_orbital_cutoff() { return K_orbital_cutoff_; }
+
+    ///
+    /// Contracts the half-transformed integrals into K in single precision. The
+    /// conversion error (~1e-7 relative) is acceptable in early SCF iterations only.
+    /// @param lowp use the FP32 K contraction
+    ///
+    void set_K_low_precision(bool lowp) { K_low_precision_ = lowp; }
+    bool get_K_low_precision() { return K_low_precision_; }
+
+    ///
+    /// Counters of the last build_JK call: integral data read from disk [bytes],
+    /// BLAS FLOPs, and time spent in the J/K contractions [s]
+    ///
+    size_t get_JK_disk_bytes() const { return JK_disk_bytes_; }
+    double get_JK_flops() const { return JK_flops_; }
+    double get_JK_contraction_time() const { return JK_contraction_time_; }
+    /// Size of the resident JK work buffers [bytes]
+    size_t get_JK_scratch_bytes() const;
+
     ///
     /// set the printing verbosity parameter
     /// @param print_lvl indicating verbosity
@@ -234,6 +312,12 @@ class PSI_API DFHelper {
 
     // => Tensor IO <=
     // many ways to access the 3-index tensors.
+    //
+    // Parallel access: once transform() (or the write_disk_tensor calls filling a tensor) has
+    // returned, fill_tensor and get_tensor may be called concurrently from any number of threads,
+    // on the same or different tensors. Disk reads are positionless (pread), so threads never share
+    // a file offset, and the in-core and memory-mapped paths only read. Writing a tensor while it
+    // is being read, or calling transform() / clear_*() concurrently with reads, is not supported.
 
     ///
     /// Fill a SharedMatrix with three index pairs.  Slice the same way you do in python.
@@ -307,6 +391,16 @@ class PSI_API DFHelper {
     void write_disk_tensor(std::string name, double* b, std::vector<size_t> a1);
     void write_disk_tensor(std::string name, double* b);
 
+    ///
+    /// Zero-copy, read-only view of a contiguous slice of a disk tensor.
+    /// Requires set_disk_mmap(true) and that the tensor is on disk.
+    /// @param name name of tensor
+    /// @param a1 [start, stop) of the first index
+    /// Returns a pointer to the rows a1[0]..a1[1]-1, which stays valid
+    /// until the tensor is written, transposed or cleared.
+    ///
+    const double* disk_tensor_view(std::string name, std::vector<size_t> a1);
+
     /// tranpose a tensor *after* it has been written
     void transpose(std::string name, std::tuple<size_t, size_t, size_t> order);
 
@@ -330,6 +424,12 @@ class PSI_API DFHelper {
                   std::vector<SharedMatrix> J, std::vector<SharedMatrix> K, std::vector<SharedMatrix> wK,
                   size_t max_nocc, bool do_J, bool do_K, bool do_wK, bool lr_symmetric);
 
+    ///
+    /// Release the work buffers kept alive between build_JK calls.
+    /// They are rebuilt on the next call to build_JK.
+    ///
+    void clear_JK_buffers();
+
    protected:
     // => basis sets <=
     std::shared_ptr<BasisSet> primary_;
@@ -350,12 +450,17 @@ class PSI_API DFHelper {
     bool AO_core_ = true;
     bool MO_core_ = false;
     bool release_core_AO_before_metric_ = false;
+    bool disk_mmap_ = false;
+    bool overlap_io_ = true;
+    bool disk_compress_ = false;
+    double aux_rank_tolerance_ = 0.0;
     size_t nthreads_ = 1;
     double cutoff_ = 1e-12;
     double condition_ = 1e-12;
     double mpower_ = -0.5;
     double wmpower_ = -1.0;
     bool hold_met_ = false;
+    bool metric_solve_ = false;
     bool built_ = false;
     bool transformed_ = false;
     std::pair<size_t, size_t> info_;
@@ -377,7 +482,10 @@ class PSI_API DFHelper {
 
     // => in-core machinery <=
     void AO_core(bool set_AO_core);
-    std::unique_ptr<double[]> Ppq_;
+    // rotate Ppq_ onto the dominant eigenvectors of its auxiliary Gram matrix, reducing naux_
+    void compress_aux();
+    // shared, so it can live on in the DFIntegralCache
+    std::shared_ptr<double[]> Ppq_;
     // Maps x -> (P|Q) ^ x.
     std::map<double, SharedMatrix> metrics_;
 
@@ -453,8 +561,10 @@ class PSI_API DFHelper {
     std::pair<size_t, size_t> pshell_blocks_for_AO_build(const size_t mem, size_t symm,
                                                          std::vector<std::pair<size_t, size_t>>& b);
     // returns pair(largest buffer size, largest block size)
+    // nAO and nMO are the number of AO and (final, scratch) MO buffers held at once
     std::pair<size_t, size_t> Qshell_blocks_for_transform(const size_t mem, size_t wtmp, size_t wfinal,
-                                                          std::vector<std::pair<size_t, size_t>>& b);
+                                                          std::vector<std::pair<size_t, size_t>>& b,
+                                                          size_t nAO = 1, size_t nMO = 1);
     void metric_contraction_blocking(std::vector<std::pair<size_t, size_t>>& steps, size_t blocking_index,
                                      size_t block_sizes, size_t total_mem, size_t memory_factor, size_t memory_bump);
 
@@ -464,6 +574,16 @@ class PSI_API DFHelper {
     // What is the index of ij in significant basis function interactions for i? 0 = not significant. 2 means 1 before, 3 means 2 before, ect. Size nbf_ ** 2.
     // Ordering is based on the natural ordering of basis functions, not ordering of significance.
     std::vector<size_t> schwarz_fun_index_;
+    // Largest (mn|mn)-type integral for each shell pair. Size pshells_ ** 2
+    std::vector<double> schwarz_shell_max_vals_;
+    // Largest (P|P) integral for each aux shell. Size Qshells_
+    std::vector<double> aux_shell_max_vals_;
+    // Can (P|mn) survive the three-center bound (P|P)^{1/2} (mn|mn)^{1/2} >= cutoff_?
+    bool aux_shell_significant(size_t Pshell, size_t MU, size_t NU) const {
+        return aux_shell_max_vals_[Pshell] * schwarz_shell_max_vals_[MU * pshells_ + NU] >= cutoff_ * cutoff_;
+    }
+    // Zeros standing in for the integrals of a screened (P|mn) block, so the sparse writers need no special case
+    std::vector<double> screened_Pmn_zeros_;
 
     // => Coulomb metric handling <=
     std::vector<std::pair<double, std::string>> metric_keys_;
@@ -476,6 +596,10 @@ class PSI_API DFHelper {
     std::string compute_metric(double m_pow);
 
     double* metric_inverse_prep_core();
+    // Cholesky factor of J (row-major upper triangle U = L^T), shared through the DFIntegralCache
+    // when that is enabled; nullptr if J is not positive definite
+    SharedMatrix metric_factor_;
+    double* metric_factor_prep_core();
 
     // => metric operations <=
     void contract_metric_Qpq(std::string file, double* metp, double* Mp, double* Fp, const size_t tots);
@@ -483,11 +607,14 @@ class PSI_API DFHelper {
     void contract_metric_core(std::string file);
     void contract_metric_AO(double* Mp);
     void contract_metric_AO_core(double* Qpq, double* metp);
+    // as contract_metric_AO_core_symm, but applying mpower_ through solves with the factor U
+    void solve_metric_AO_core_symm(double* Qpq, double* Ppq, double* Up, size_t begin, size_t end);
 
     // => spaces and transformation maps <=
     std::map<std::string, std::tuple<SharedMatrix, size_t>> spaces_;
     std::map<std::string, std::tuple<std::string, std::string, size_t>> transf_;
     std::map<std::string, std::unique_ptr<double[]>> transf_core_;
+    TrackedBytes transf_core_bytes_;
 
     // => transformation machinery <=
     std::pair<size_t, size_t> identify_order();
@@ -510,15 +637,27 @@ class PSI_API DFHelper {
         void change_stream(std::string op);
         void close_stream();
 
+        // map the first bytes of the file, growing it if writable
+        void* map(size_t bytes, bool write);
+        void unmap();
+
         FILE* fp_;
         std::string op_;
         bool open_ = false;
         std::string filename_;
 
+        void* map_ = nullptr;
+        size_t map_size_ = 0;
+        bool map_write_ = false;
+
     } Stream;
 
     std::map<std::string, std::shared_ptr<Stream>> file_streams_;
+    // guards file_streams_ while transform() does I/O on separate threads
+    std::mutex streams_lock_;
     FILE* stream_check(std::string filename, std::string op);
+    // mmap counterpart of stream_check, maps the whole file (disk_mmap_ only)
+    void* map_check(std::string filename, size_t bytes, bool write);
 
     // => FILE IO machinery <=
     void put_tensor(std::string file, double* b, std::pair<size_t, size_t> a1, std::pair<size_t, size_t> a2,
@@ -536,6 +675,19 @@ class PSI_API DFHelper {
     // Read from `file` into `Mp`, starting at position `start` in `file` and reading length `size`
     void get_tensor_AO(std::string file, double* Mp, size_t size, size_t start);
 
+    // => single precision FILE IO <=
+    // Full filenames of the tensors stored as floats (disk_compress_)
+    std::set<std::string> fp32_files_;
+    // Bytes per element of `file`
+    size_t disk_word(const std::string& file) { return (fp32_files_.count(file) ? sizeof(float) : sizeof(double)); }
+    // Write `a0` rows of length `a1` from `Mp` to the float `file` of `total` elements,
+    // starting at element `offset` with a stride of `ld` elements between rows.
+    void put_tensor_fp32(std::string file, double* Mp, size_t a0, size_t a1, size_t offset, size_t ld, size_t total,
+                         std::string op);
+    // Read counterpart of put_tensor_fp32
+    void get_tensor_fp32(std::string file, double* Mp, size_t a0, size_t a1, size_t offset, size_t ld,
+                         size_t total);
+
     // => internal handlers for FILE IO <=
     // Map a base filename to the fullname of the p variant and then the original tensor.
     std::map<std::string, std::tuple<std::string, std::string>> files_;
@@ -590,6 +742,54 @@ class PSI_API DFHelper {
     void compute_wK(std::vector<SharedMatrix> Cleft, std::vector<SharedMatrix> Cright, std::vector<SharedMatrix> wK,
                     size_t max_nocc, bool do_J, bool do_K, bool do_wK);
 
+    // => persistent JK work buffers <=
+    // The in-core AOs stay resident for the life of the object, so keep the JK
+    // temporaries resident as well. They only grow (e.g., if max_nocc grows),
+    // which leaves C and D as the only per-iteration traffic in build_JK.
+    std::vector<std::vector<double>> JK_C_buffers_;
+    size_t JK_C_buffers_size_ = 0;
+    std::unique_ptr<double[]> JK_T1_;
+    size_t JK_T1_size_ = 0;
+    std::unique_ptr<double[]> JK_T2_;
+    size_t JK_T2_size_ = 0;
+    std::unique_ptr<double[]> JK_M_;
+    size_t JK_M_size_ = 0;
+    std::unique_ptr<double[]> JK_Ksub_;
+    size_t JK_Ksub_size_ = 0;
+
+    // => orbital-screened K <=
+    double K_orbital_cutoff_ = 0.0;
+    // contract K in single precision
+    bool K_low_precision_ = false;
+    // build_JK counters
+    size_t JK_disk_bytes_ = 0;
+    double JK_flops_ = 0.0;
+    double JK_contraction_time_ = 0.0;
+
+    // FP32 copies of the K contraction operands and result
+    std::vector<float> K_sp_T1_;
+    std::vector<float> K_sp_T2_;
+    std::vector<float> K_sp_K_;
+    // accumulate T1 T2^T (nbf x ncol each) into K with SGEMM
+    void sp_contract_K(size_t ncol, double* T1p, double* T2p, double* Kp, size_t ldk);
+    // number of occupied columns screened together
+    size_t K_occ_block_ = 32;
+    // For each K matrix and occupied block, the basis functions that survive screening
+    std::vector<std::vector<std::vector<size_t>>> K_left_funcs_;
+    std::vector<std::vector<std::vector<size_t>>> K_right_funcs_;
+    void prepare_sparse_K(std::vector<SharedMatrix> Cleft, std::vector<SharedMatrix> Cright, bool lr_symmetric);
+    void sparse_transform_pQq(const std::vector<size_t>& funcs, size_t nocc, size_t ostart, size_t osize,
+                              size_t bcount, size_t block_size, double* Mp, double* Tp, double* Bp,
+                              std::vector<std::vector<double>>& C_buffers);
+    void compute_sparse_K(std::vector<SharedMatrix> Cleft, std::vector<SharedMatrix> Cright,
+                          std::vector<SharedMatrix> K, double* T1p, double* T2p, double* Mp, size_t bcount,
+                          size_t block_size, std::vector<std::vector<double>>& C_buffers, bool lr_symmetric);
+
+    // Return buffer, reallocating it if it holds fewer than required doubles
+    double* JK_buffer(std::unique_ptr<double[]>& buffer, size_t& current, size_t required);
+    // Return per-thread C buffers large enough for max_nocc
+    std::vector<std::vector<double>>& JK_C_buffers(size_t max_nocc);
+
     // => misc <=
     // Utility function to fill double* with zero in parallel
     void fill(double* b, size_t count, double value);
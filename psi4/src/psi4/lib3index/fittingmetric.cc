@@ -27,6 +27,7 @@
  */
 
 #include "3index.h"
+#include "dfcache.h"
 
 #include <cstdlib>
 #include <cstdio>
@@ -34,6 +35,7 @@
 #include <algorithm>
 #include <vector>
 #include <utility>
+#include <sstream>
 
 #include "psi4/psifiles.h"
 #include "psi4/libpsio/psio.h"
@@ -83,6 +85,31 @@ void FittingMetric::form_fitting_metric() {
         poispet = std::make_shared<PetiteList>(pois_, poisfact);
     }
 
+    // The plain C1 Coulomb-type metric can be shared between consumers
+    bool use_cache = (!is_poisson_ && (auxpet->nirrep() == 1 || force_C1_) && DFIntegralCache::instance().enabled());
+    std::string cache_key;
+    if (use_cache) {
+        std::stringstream key;
+        key << "FittingMetric/" << DFIntegralCache::basis_key(aux_) << "/" << omega_;
+        cache_key = key.str();
+        SharedMatrix cached = DFIntegralCache::instance().get_matrix(cache_key);
+        if (cached) {
+            // callers invert metric_ in place
+            metric_ = cached->clone();
+            metric_->set_name("SO Basis Fitting Metric");
+            int naux = metric_->rowspi()[0];
+            pivots_ = std::make_shared<IntVector>(naux);
+            rev_pivots_ = std::make_shared<IntVector>(naux);
+            int* piv = pivots_->pointer();
+            int* rpiv = pivots_->pointer();
+            for (int Q = 0; Q < naux; Q++) {
+                piv[Q] = Q;
+                rpiv[Q] = Q;
+            }
+            return;
+        }
+    }
+
     int naux = 0;
     int ngaussian = 0;
     int npoisson = 0;
@@ -235,6 +262,7 @@ void FittingMetric::form_fitting_metric() {
     if (auxpet->nirrep() == 1 || force_C1_ == true) {
         metric_ = AOmetric;
         metric_->set_name("SO Basis Fitting Metric");
+        if (use_cache) DFIntegralCache::instance().put_matrix(cache_key, metric_->clone());
         pivots_ = std::make_shared<IntVector>(naux);
         rev_pivots_ = std::make_shared<IntVector>(naux);
         int* piv = pivots_->pointer();
@@ -0,0 +1,255 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Psi4: an open-source quantum chemistry software package
+ *
+ * Copyright (c) 2007-2023 The Psi4 Developers.
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This file is part of Psi4.
+ *
+ * Psi4 is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * Psi4 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with Psi4; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * @END LICENSE
+ */
+
+#include "isdf.h"
+#include "dftensor.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "psi4/libfock/cubature.h"
+#include "psi4/libfock/points.h"
+#include "psi4/libmints/basisset.h"
+#include "psi4/libmints/integral.h"
+#include "psi4/libmints/matrix.h"
+#include "psi4/libmints/twobody.h"
+#include "psi4/libpsi4util/PsiOutStream.h"
+#include "psi4/libpsi4util/process.h"
+#include "psi4/libqt/qt.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace psi {
+
+CholeskyISDF::CholeskyISDF(SharedMatrix X, double delta, size_t memory) : Cholesky(delta, memory), X_(X) {}
+CholeskyISDF::~CholeskyISDF() {}
+size_t CholeskyISDF::N() { return X_->rowspi()[0]; }
+void CholeskyISDF::compute_diagonal(double* target) {
+    size_t n = N();
+    size_t nbf = X_->colspi()[0];
+    double** Xp = X_->pointer();
+    for (size_t g = 0; g < n; g++) {
+        double val = C_DDOT(nbf, Xp[g], 1, Xp[g], 1);
+        target[g] = val * val;
+    }
+}
+void CholeskyISDF::compute_row(int row, double* target) {
+    size_t n = N();
+    size_t nbf = X_->colspi()[0];
+    double** Xp = X_->pointer();
+    C_DGEMV('N', n, nbf, 1.0, Xp[0], nbf, Xp[row], 1, 0.0, target, 1);
+    for (size_t g = 0; g < n; g++) target[g] *= target[g];
+}
+
+ISDF::ISDF(std::shared_ptr<BasisSet> primary, std::shared_ptr<BasisSet> auxiliary, std::shared_ptr<DFTGrid> grid)
+    : primary_(primary), auxiliary_(auxiliary), grid_(grid) {
+    nthreads_ = Process::environment.get_n_threads();
+}
+ISDF::~ISDF() {}
+
+void ISDF::print_header() const {
+    if (!print_) return;
+    outfile->Printf("  ==> ISDF: Interpolative Separable Density Fitting <==\n\n");
+    outfile->Printf("    Primary Basis:     %11s\n", primary_->name().c_str());
+    outfile->Printf("    Auxiliary Basis:   %11s\n", auxiliary_->name().c_str());
+    outfile->Printf("    Grid Points:       %11zu\n", grid_->npoints());
+    outfile->Printf("    Point Tolerance:   %11.3E\n", tolerance_);
+    outfile->Printf("    Fit Condition:     %11.3E\n", condition_);
+    outfile->Printf("    OpenMP threads:    %11zu\n", nthreads_);
+    if (!points_.empty()) outfile->Printf("    Interp. Points:    %11zu\n", points_.size());
+    outfile->Printf("\n");
+}
+
+SharedMatrix ISDF::grid_collocation() const {
+    const auto& blocks = grid_->blocks();
+    size_t nbf = primary_->nbf();
+
+    // grid points are numbered by block
+    std::vector<size_t> offsets(blocks.size() + 1, 0);
+    for (size_t Q = 0; Q < blocks.size(); Q++) offsets[Q + 1] = offsets[Q] + blocks[Q]->npoints();
+
+    auto X = std::make_shared<Matrix>("Grid Collocation", offsets.back(), nbf);
+    double** Xp = X->pointer();
+
+    std::vector<std::shared_ptr<BasisFunctions>> workers;
+    for (size_t i = 0; i < nthreads_; i++) {
+        workers.push_back(std::make_shared<BasisFunctions>(primary_, grid_->max_points(), grid_->max_functions()));
+    }
+
+#pragma omp parallel for schedule(dynamic) num_threads(nthreads_)
+    for (size_t Q = 0; Q < blocks.size(); Q++) {
+        int rank = 0;
+#ifdef _OPENMP
+        rank = omp_get_thread_num();
+#endif
+        auto block = blocks[Q];
+        workers[rank]->compute_functions(block);
+        double** phip = workers[rank]->basis_value("PHI")->pointer();
+        const std::vector<int>& function_map = block->functions_local_to_global();
+        double* w = block->w();
+
+        for (size_t p = 0; p < block->npoints(); p++) {
+            double scale = std::pow(std::fabs(w[p]), 0.25);
+            double* row = Xp[offsets[Q] + p];
+            for (size_t ml = 0; ml < function_map.size(); ml++) row[function_map[ml]] = scale * phip[p][ml];
+        }
+    }
+
+    return X;
+}
+
+SharedMatrix ISDF::fitted_projection() const {
+    size_t nbf = primary_->nbf();
+    size_t naux = auxiliary_->nbf();
+    size_t npoint = points_.size();
+    double** Xp = X_->pointer();
+
+    std::shared_ptr<BasisSet> zero = BasisSet::zero_ao_basis_set();
+    auto factory = std::make_shared<IntegralFactory>(auxiliary_, zero, primary_, primary_);
+    std::vector<std::shared_ptr<TwoBodyAOInt>> eri(nthreads_);
+    eri[0] = std::shared_ptr<TwoBodyAOInt>(factory->eri());
+    for (size_t i = 1; i < nthreads_; i++) eri[i] = std::shared_ptr<TwoBodyAOInt>(eri[0]->clone());
+
+    // (A|mn) for one auxiliary shell and its contraction with the points, per thread
+    size_t max_nA = auxiliary_->max_function_per_shell();
+    std::vector<std::vector<double>> Amn(nthreads_, std::vector<double>(max_nA * nbf * nbf));
+    std::vector<std::vector<double>> T(nthreads_, std::vector<double>(nbf * npoint));
+
+    // V_AP = sum_mn (A|mn) X_mP X_nP
+    auto V = std::make_shared<Matrix>("V", naux, npoint);
+    double** Vp = V->pointer();
+
+#pragma omp parallel for schedule(dynamic) num_threads(nthreads_)
+    for (size_t A = 0; A < auxiliary_->nshell(); A++) {
+        int rank = 0;
+#ifdef _OPENMP
+        rank = omp_get_thread_num();
+#endif
+        size_t nA = auxiliary_->shell(A).nfunction();
+        size_t oA = auxiliary_->shell(A).function_index();
+        double* Ap = Amn[rank].data();
+        double* Tp = T[rank].data();
+
+        for (size_t M = 0; M < primary_->nshell(); M++) {
+            size_t nM = primary_->shell(M).nfunction();
+            size_t oM = primary_->shell(M).function_index();
+            for (size_t N = 0; N <= M; N++) {
+                size_t nN = primary_->shell(N).nfunction();
+                size_t oN = primary_->shell(N).function_index();
+                eri[rank]->compute_shell(A, 0, M, N);
+                const double* buffer = eri[rank]->buffer();
+                for (size_t a = 0; a < nA; a++) {
+                    for (size_t m = 0; m < nM; m++) {
+                        for (size_t n = 0; n < nN; n++) {
+                            double val = buffer[a * nM * nN + m * nN + n];
+                            Ap[a * nbf * nbf + (oM + m) * nbf + (oN + n)] = val;
+                            Ap[a * nbf * nbf + (oN + n) * nbf + (oM + m)] = val;
+                        }
+                    }
+                }
+            }
+        }
+
+        for (size_t a = 0; a < nA; a++) {
+            // T_mP = sum_n (a|mn) X_nP, then V_aP = sum_m X_mP T_mP
+            C_DGEMM('N', 'N', nbf, npoint, nbf, 1.0, &Ap[a * nbf * nbf], nbf, Xp[0], npoint, 0.0, Tp, npoint);
+            double* Vrow = Vp[oA + a];
+            for (size_t P = 0; P < npoint; P++) Vrow[P] = 0.0;
+            for (size_t m = 0; m < nbf; m++) {
+                for (size_t P = 0; P < npoint; P++) Vrow[P] += Xp[m][P] * Tp[m * npoint + P];
+            }
+        }
+    }
+
+    // fit with the symmetric metric, J^-1/2 V
+    FittingMetric J(auxiliary_, true);
+    J.form_eig_inverse(condition_);
+    SharedMatrix Jm12 = J.get_metric();
+    auto JV = std::make_shared<Matrix>("J^-1/2 V", naux, npoint);
+    JV->gemm(false, false, 1.0, Jm12, V, 0.0);
+    return JV;
+}
+
+void ISDF::compute() {
+    timer_on("ISDF: compute");
+    size_t nbf = primary_->nbf();
+
+    // => Interpolation points <= //
+    timer_on("ISDF: point selection");
+    SharedMatrix Xg = grid_collocation();
+    double** Xgp = Xg->pointer();
+    size_t ngrid = Xg->rowspi()[0];
+
+    double Dmax = 0.0;
+    for (size_t g = 0; g < ngrid; g++) {
+        double val = C_DDOT(nbf, Xgp[g], 1, Xgp[g], 1);
+        Dmax = std::max(Dmax, val * val);
+    }
+    CholeskyISDF chol(Xg, tolerance_ * Dmax, memory_);
+    chol.choleskify();
+    points_ = chol.pivots();
+    size_t npoint = points_.size();
+    timer_off("ISDF: point selection");
+
+    // basis functions at the points, the weights drop out of the least-squares fit
+    X_ = std::make_shared<Matrix>("ISDF X", nbf, npoint);
+    double** Xp = X_->pointer();
+    for (size_t P = 0; P < npoint; P++) {
+        for (size_t m = 0; m < nbf; m++) Xp[m][P] = Xgp[points_[P]][m];
+    }
+    Xg.reset();
+
+    // => Least-squares fit <= //
+    // Y = V S^-1 with the point metric S_PQ = (sum_m X_mP X_mQ)^2
+    timer_on("ISDF: fit");
+    auto S = std::make_shared<Matrix>("S", npoint, npoint);
+    S->gemm(true, false, 1.0, X_, X_, 0.0);
+    double** Sp = S->pointer();
+    for (size_t P = 0; P < npoint; P++) {
+        for (size_t Q = 0; Q < npoint; Q++) Sp[P][Q] *= Sp[P][Q];
+    }
+    S->power(-1.0, condition_);
+
+    SharedMatrix V = fitted_projection();
+    Y_ = std::make_shared<Matrix>("ISDF Y", auxiliary_->nbf(), npoint);
+    Y_->gemm(false, false, 1.0, V, S, 0.0);
+    timer_off("ISDF: fit");
+
+    print_header();
+    timer_off("ISDF: compute");
+}
+
+SharedMatrix ISDF::Z() const {
+    if (!Y_) throw PSIEXCEPTION("ISDF: call compute() before asking for Z.");
+    auto Z = std::make_shared<Matrix>("ISDF Z", Y_->colspi()[0], Y_->colspi()[0]);
+    Z->gemm(true, false, 1.0, Y_, Y_, 0.0);
+    return Z;
+}
+
+}  // namespace psi
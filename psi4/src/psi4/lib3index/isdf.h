@@ -0,0 +1,126 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Psi4: an open-source quantum chemistry software package
+ *
+ * Copyright (c) 2007-2023 The Psi4 Developers.
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This file is part of Psi4.
+ *
+ * Psi4 is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * Psi4 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with Psi4; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * @END LICENSE
+ */
+
+#ifndef THREE_INDEX_ISDF
+#define THREE_INDEX_ISDF
+
+#include "psi4/pragma.h"
+#include "psi4/libmints/typedefs.h"
+#include "cholesky.h"
+
+#include <vector>
+
+namespace psi {
+
+class BasisSet;
+class DFTGrid;
+
+/*!
+ * Pivoted Cholesky of the pair-density overlap between grid points,
+ * S_gh = (sum_m X_gm X_hm)^2, used to select ISDF interpolation points.
+ * The collocation X (ngrid x nbf) carries the quarter power of the weights.
+ **/
+class CholeskyISDF : public Cholesky {
+   protected:
+    SharedMatrix X_;
+
+   public:
+    CholeskyISDF(SharedMatrix X, double delta, size_t memory);
+    ~CholeskyISDF() override;
+
+    size_t N() override;
+    void compute_diagonal(double* target) override;
+    void compute_row(int row, double* target) override;
+};
+
+/*!
+ * Interpolative separable density fitting (least-squares tensor hypercontraction)
+ * of the density-fitted ERIs,
+ *
+ *   (mn|ls) ~ sum_PQ X_mP X_nP Z_PQ X_lQ X_sQ,  Z = Y^T Y,
+ *
+ * where X holds the basis functions at interpolation points selected from a DFTGrid
+ * and Y (naux x npoint) is the least-squares fit of the metric-fitted (A|mn).
+ * Building costs O(naux nbf^2 npoint), after which correlated methods and exchange
+ * builds can work with X and Y alone.
+ **/
+class PSI_API ISDF {
+   protected:
+    std::shared_ptr<BasisSet> primary_;
+    std::shared_ptr<BasisSet> auxiliary_;
+    std::shared_ptr<DFTGrid> grid_;
+
+    /// Point selection stops when the largest residual diagonal drops below this fraction of the first
+    double tolerance_ = 1.0E-6;
+    /// Eigenvalue cutoff for the pseudoinverses of the metrics
+    double condition_ = 1.0E-10;
+    /// Memory for the point selection, in doubles
+    size_t memory_ = 256000000L;
+    size_t nthreads_ = 1;
+    int print_ = 1;
+
+    /// Selected grid points, in the order they were pivoted
+    std::vector<int> points_;
+    /// Basis functions at the interpolation points (nbf x npoint)
+    SharedMatrix X_;
+    /// Fitted auxiliary factor (naux x npoint)
+    SharedMatrix Y_;
+
+    /// Weighted basis function values on every grid point (ngrid x nbf)
+    SharedMatrix grid_collocation() const;
+    /// Fitted (A|mn) contracted with the interpolation points, J^-1/2_AB sum_mn (B|mn) X_mP X_nP
+    SharedMatrix fitted_projection() const;
+
+   public:
+    ISDF(std::shared_ptr<BasisSet> primary, std::shared_ptr<BasisSet> auxiliary, std::shared_ptr<DFTGrid> grid);
+    ~ISDF();
+
+    /// Select the interpolation points and fit Y
+    void compute();
+    void print_header() const;
+
+    void set_tolerance(double tolerance) { tolerance_ = tolerance; }
+    void set_condition(double condition) { condition_ = condition; }
+    void set_memory(size_t doubles) { memory_ = doubles; }
+    void set_nthreads(size_t nthreads) { nthreads_ = nthreads; }
+    void set_print(int print) { print_ = print; }
+
+    /// Number of interpolation points, after compute()
+    size_t npoints() const { return points_.size(); }
+    /// Indices of the interpolation points in the grid, after compute()
+    const std::vector<int>& points() const { return points_; }
+    /// Basis functions at the interpolation points (nbf x npoint), after compute()
+    SharedMatrix X() const { return X_; }
+    /// Auxiliary factor (naux x npoint), after compute()
+    SharedMatrix Y() const { return Y_; }
+    /// THC core matrix Z = Y^T Y (npoint x npoint), after compute()
+    SharedMatrix Z() const;
+};
+
+}  // namespace psi
+#endif
@@ -37,6 +37,7 @@
 #include <cstring>
 #include "psi4/psifiles.h"
 #include "psi4/libpsi4util/PsiOutStream.h"
+#include "psi4/libpsi4util/huge_pages.h"
 #include "psi4/libpsi4util/process.h"
 #ifdef _POSIX_MEMLOCK
 #include <sys/mman.h>
@@ -93,6 +94,7 @@ PSI_API double **block_matrix(size_t n, size_t m, bool memlock) {
         outfile->Printf("m = %ld\n", m);
         exit(PSI_RETURN_FAILURE);
     }
+    huge_pages_advise(B, m * n * sizeof(double));
     memset(static_cast<void *>(B), 0, m * n * sizeof(double));
 
     for (i = 0; i < n; i++) {
@@ -198,6 +198,23 @@ void CubicScalarGrid::populate_grid() {
 
     points_ = std::make_shared<RKSFunctions>(primary_, max_points, max_functions);
     points_->set_ansatz(0);
+
+    block_offsets_.resize(blocks_.size());
+    offset = 0L;
+    for (int ind = 0; ind < blocks_.size(); ind++) {
+        block_offsets_[ind] = offset;
+        offset += blocks_[ind]->npoints();
+    }
+
+    int nthreads = 1;
+#ifdef _OPENMP
+    nthreads = Process::environment.get_n_threads();
+#endif
+    point_workers_.clear();
+    for (int thread = 0; thread < nthreads; thread++) {
+        point_workers_.push_back(std::make_shared<RKSFunctions>(primary_, max_points, max_functions));
+        point_workers_[thread]->set_ansatz(0);
+    }
 }
 void CubicScalarGrid::print_header() {
     outfile->Printf("  ==> CubicScalarGrid <==\n\n");
@@ -230,31 +247,6 @@ void CubicScalarGrid::write_gen_file(double* v, const std::string& name, const s
     }
 }
 void CubicScalarGrid::write_cube_file(double* v, const std::string& name, const std::string& comment) {
-    // => Reorder the grid <= //
-
-    auto v2 = std::vector<double>(npoints_);
-    size_t offset = 0L;
-    for (int istart = 0L; istart <= N_[0]; istart += nxyz_) {
-        int ni = (istart + nxyz_ > N_[0] ? (N_[0] + 1) - istart : nxyz_);
-        for (int jstart = 0L; jstart <= N_[1]; jstart += nxyz_) {
-            int nj = (jstart + nxyz_ > N_[1] ? (N_[1] + 1) - jstart : nxyz_);
-            for (int kstart = 0L; kstart <= N_[2]; kstart += nxyz_) {
-                int nk = (kstart + nxyz_ > N_[2] ? (N_[2] + 1) - kstart : nxyz_);
-                for (int i = istart; i < istart + ni; i++) {
-                    for (int j = jstart; j < jstart + nj; j++) {
-                        for (int k = kstart; k < kstart + nk; k++) {
-                            size_t index = i * (N_[1] + 1L) * (N_[2] + 1L) + j * (N_[2] + 1L) + k;
-                            v2[index] = v[offset];
-                            offset++;
-                        }
-                    }
-                }
-            }
-        }
-    }
-
-    // => Drop the grid out <= //
-
     std::stringstream ss;
     ss << filepath_ << "/" << name << ".cube";
 
@@ -284,25 +276,58 @@ void CubicScalarGrid::write_cube_file(double* v, const std::string& name, const
                 mol_->z(A));
     }
 
-    // Data, striped (x, y, z)
-    for (size_t ind = 0; ind < npoints_; ind++) {
-        fprintf(fh, "%12.5E ", v2[ind]);
-        if (ind % 6 == 5) fprintf(fh, "\n");
+    // => Reorder and drop the grid one x slab at a time <= //
+
+    // Blocks are laid out with x outermost, so each slab of nxyz_ x planes is contiguous in v
+    size_t nyz = (N_[1] + 1L) * (N_[2] + 1L);
+    auto v2 = std::vector<double>(nxyz_ * nyz);
+    size_t offset = 0L;
+    size_t written = 0L;
+    for (int istart = 0L; istart <= N_[0]; istart += nxyz_) {
+        int ni = (istart + nxyz_ > N_[0] ? (N_[0] + 1) - istart : nxyz_);
+        for (int jstart = 0L; jstart <= N_[1]; jstart += nxyz_) {
+            int nj = (jstart + nxyz_ > N_[1] ? (N_[1] + 1) - jstart : nxyz_);
+            for (int kstart = 0L; kstart <= N_[2]; kstart += nxyz_) {
+                int nk = (kstart + nxyz_ > N_[2] ? (N_[2] + 1) - kstart : nxyz_);
+                for (int i = 0; i < ni; i++) {
+                    for (int j = jstart; j < jstart + nj; j++) {
+                        for (int k = kstart; k < kstart + nk; k++) {
+                            size_t index = i * nyz + j * (N_[2] + 1L) + k;
+                            v2[index] = v[offset];
+                            offset++;
+                        }
+                    }
+                }
+            }
+        }
+
+        // Data, striped (x, y, z)
+        size_t nslab = ni * nyz;
+        for (size_t ind = 0; ind < nslab; ind++, written++) {
+            fprintf(fh, "%12.5E ", v2[ind]);
+            if (written % 6 == 5) fprintf(fh, "\n");
+        }
     }
 
     fclose(fh);
 }
 void CubicScalarGrid::add_density(double* v, std::shared_ptr<Matrix> D) {
-    points_->set_pointers(D);
-    std::shared_ptr<Vector> rho = points_->point_value("RHO_A");
-    double* rhop = rho->pointer();
+    for (auto& worker : point_workers_) {
+        worker->set_pointers(D);
+    }
 
-    size_t offset = 0L;
+    // Blocks write disjoint ranges of v, so they can be computed independently
+#pragma omp parallel for schedule(dynamic) num_threads(point_workers_.size())
     for (int ind = 0; ind < blocks_.size(); ind++) {
-        points_->compute_points(blocks_[ind]);
+        int thread = 0;
+#ifdef _OPENMP
+        thread = omp_get_thread_num();
+#endif
+        std::shared_ptr<RKSFunctions> worker = point_workers_[thread];
+        worker->compute_points(blocks_[ind]);
+        double* rhop = worker->point_value("RHO_A")->pointer();
         size_t npoints = blocks_[ind]->npoints();
-        C_DAXPY(npoints, 0.5, rhop, 1, &v[offset], 1);
-        offset += npoints;
+        C_DAXPY(npoints, 0.5, rhop, 1, &v[block_offsets_[ind]], 1);
     }
 }
 void CubicScalarGrid::add_esp(double* v, std::shared_ptr<Matrix> D, const std::vector<double>& nuc_weights) {
@@ -474,46 +499,56 @@ void CubicScalarGrid::add_esp(double* v, std::shared_ptr<Matrix> D, const std::v
     }
 }
 void CubicScalarGrid::add_basis_functions(double** v, const std::vector<int>& indices) {
-    std::shared_ptr<Matrix> phi = points_->basis_value("PHI");
-    double** phip = phi->pointer();
-
-    size_t offset = 0L;
+    // Blocks write disjoint ranges of v, so each block's collocation serves all requested functions at once
+#pragma omp parallel for schedule(dynamic) num_threads(point_workers_.size())
     for (int ind = 0; ind < blocks_.size(); ind++) {
-        points_->compute_functions(blocks_[ind]);
+        int thread = 0;
+#ifdef _OPENMP
+        thread = omp_get_thread_num();
+#endif
+        std::shared_ptr<RKSFunctions> worker = point_workers_[thread];
+        worker->compute_functions(blocks_[ind]);
+        double** phip = worker->basis_value("PHI")->pointer();
 
         size_t npoints = blocks_[ind]->npoints();
+        size_t offset = block_offsets_[ind];
         const std::vector<int>& function_map = blocks_[ind]->functions_local_to_global();
-        int nlocal = function_map.size();
-        int nglobal = points_->max_functions();
+        int nglobal = worker->max_functions();
 
+        std::vector<int> global_to_local(primary_->nbf(), -1);
+        for (int ind2 = 0; ind2 < function_map.size(); ind2++) {
+            global_to_local[function_map[ind2]] = ind2;
+        }
         for (int ind1 = 0; ind1 < indices.size(); ind1++) {
-            for (int ind2 = 0; ind2 < function_map.size(); ind2++) {
-                if (indices[ind1] == function_map[ind2]) {
-                    C_DAXPY(npoints, 1.0, &phip[0][ind2], nglobal, &v[ind1][offset], 1);
-                }
+            int ind2 = global_to_local[indices[ind1]];
+            if (ind2 >= 0) {
+                C_DAXPY(npoints, 1.0, &phip[0][ind2], nglobal, &v[ind1][offset], 1);
             }
         }
-
-        offset += npoints;
     }
 }
 void CubicScalarGrid::add_orbitals(double** v, std::shared_ptr<Matrix> C) {
     int na = C->colspi()[0];
 
-    points_->set_Cs(C);
-    std::shared_ptr<Matrix> psi = points_->orbital_value("PSI_A");
-    double** psip = psi->pointer();
+    for (auto& worker : point_workers_) {
+        worker->set_Cs(C);
+    }
 
-    size_t offset = 0L;
+#pragma omp parallel for schedule(dynamic) num_threads(point_workers_.size())
     for (int ind = 0; ind < blocks_.size(); ind++) {
-        points_->compute_orbitals(blocks_[ind]);
+        int thread = 0;
+#ifdef _OPENMP
+        thread = omp_get_thread_num();
+#endif
+        std::shared_ptr<RKSFunctions> worker = point_workers_[thread];
+        worker->compute_orbitals(blocks_[ind]);
+        double** psip = worker->orbital_value("PSI_A")->pointer();
 
         size_t npoints = blocks_[ind]->npoints();
+        size_t offset = block_offsets_[ind];
         for (int a = 0; a < na; a++) {
             C_DAXPY(npoints, 1.0, psip[a], 1, &v[a][offset], 1);
         }
-
-        offset += npoints;
     }
 }
 void CubicScalarGrid::add_LOL(double* v, std::shared_ptr<Matrix> D) {
@@ -606,26 +641,52 @@ void CubicScalarGrid::compute_basis_functions(const std::vector<int>& indices, c
 void CubicScalarGrid::compute_orbitals(std::shared_ptr<Matrix> C, const std::vector<int>& indices,
                                        const std::vector<std::string>& labels, const std::string& name,
                                        const std::string& type) {
-    auto C2 = std::make_shared<Matrix>(primary_->nbf(), indices.size());
-    double** Cp = C->pointer();
-    double** C2p = C2->pointer();
-    for (int k = 0; k < indices.size(); k++) {
-        C_DCOPY(primary_->nbf(), &Cp[0][indices[k]], C->colspi()[0], &C2p[0][k], C2->colspi()[0]);
+    compute_orbitals(std::vector<std::shared_ptr<Matrix> >{C}, std::vector<std::vector<int> >{indices},
+                     std::vector<std::vector<std::string> >{labels}, std::vector<std::string>{name}, type);
+}
+void CubicScalarGrid::compute_orbitals(const std::vector<std::shared_ptr<Matrix> >& Cs,
+                                       const std::vector<std::vector<int> >& indices,
+                                       const std::vector<std::vector<std::string> >& labels,
+                                       const std::vector<std::string>& names, const std::string& type) {
+    // Flatten the requests to (coefficient matrix, position) pairs so they share the collocation
+    std::vector<std::pair<size_t, size_t> > orbs;
+    for (size_t set = 0; set < Cs.size(); set++) {
+        for (size_t k = 0; k < indices[set].size(); k++) {
+            orbs.emplace_back(set, k);
+        }
     }
-    auto v = Matrix(indices.size(), npoints_);
-    auto vp = v.pointer();
-    add_orbitals(vp, C2);
-    for (int k = 0; k < indices.size(); k++) {
-        // Get adaptive isocountour range
-        std::pair<double, double> isocontour_range = compute_isocontour_range(vp[k], 2.0);
-        double density_percent = 100.0 * options_.get_double("CUBEPROP_ISOCONTOUR_THRESHOLD");
-        std::stringstream comment;
-        comment << ". Isocontour range for " << density_percent << "% of the density: (" << isocontour_range.first
-                << "," << isocontour_range.second << ")";
-        // Write to disk
-        std::stringstream ss;
-        ss << name << "_" << (indices[k] + 1) << "_" << labels[k];
-        write_gen_file(vp[k], ss.str(), type, comment.str());
+    if (orbs.empty()) return;
+
+    // Only hold as many orbital fields on the grid as half the memory allows
+    size_t max_orbs = Process::environment.get_memory() / (2L * sizeof(double) * npoints_);
+    max_orbs = std::max<size_t>(1L, std::min<size_t>(max_orbs, orbs.size()));
+
+    for (size_t start = 0L; start < orbs.size(); start += max_orbs) {
+        size_t norbs = std::min(max_orbs, orbs.size() - start);
+        auto C2 = std::make_shared<Matrix>(primary_->nbf(), norbs);
+        double** C2p = C2->pointer();
+        for (int k = 0; k < norbs; k++) {
+            const auto& C = Cs[orbs[start + k].first];
+            int index = indices[orbs[start + k].first][orbs[start + k].second];
+            C_DCOPY(primary_->nbf(), &C->pointer()[0][index], C->colspi()[0], &C2p[0][k], C2->colspi()[0]);
+        }
+        auto v = Matrix(norbs, npoints_);
+        auto vp = v.pointer();
+        add_orbitals(vp, C2);
+        for (int k = 0; k < norbs; k++) {
+            // Get adaptive isocountour range
+            std::pair<double, double> isocontour_range = compute_isocontour_range(vp[k], 2.0);
+            double density_percent = 100.0 * options_.get_double("CUBEPROP_ISOCONTOUR_THRESHOLD");
+            std::stringstream comment;
+            comment << ". Isocontour range for " << density_percent << "% of the density: (" << isocontour_range.first
+                    << "," << isocontour_range.second << ")";
+            // Write to disk
+            size_t set = orbs[start + k].first;
+            size_t pos = orbs[start + k].second;
+            std::stringstream ss;
+            ss << names[set] << "_" << (indices[set][pos] + 1) << "_" << labels[set][pos];
+            write_gen_file(vp[k], ss.str(), type, comment.str());
+        }
     }
 }
 void CubicScalarGrid::compute_difference(std::shared_ptr<Matrix> C, const std::vector<int>& indices,
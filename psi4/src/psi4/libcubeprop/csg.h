@@ -91,6 +91,10 @@ class CubicScalarGrid {
     std::shared_ptr<BasisExtents> extents_;
     /// RKS points object
     std::shared_ptr<RKSFunctions> points_;
+    /// Per-thread RKS points objects for the threaded density and orbital computers
+    std::vector<std::shared_ptr<RKSFunctions> > point_workers_;
+    /// Offset of each block into the blocked grid ordering
+    std::vector<size_t> block_offsets_;
 
     // => Helper Routines <= //
 
@@ -185,6 +189,12 @@ class CubicScalarGrid {
     void compute_orbitals(std::shared_ptr<Matrix> C, const std::vector<int>& indices,
                           const std::vector<std::string>& labels, const std::string& name,
                           const std::string& type = "CUBE");
+    /// Compute orbital-type properties from several coefficient matrices (e.g. alpha and beta) with one basis
+    /// function evaluation per grid block; indices, labels, and names are given per coefficient matrix
+    void compute_orbitals(const std::vector<std::shared_ptr<Matrix> >& Cs,
+                          const std::vector<std::vector<int> >& indices,
+                          const std::vector<std::vector<std::string> >& labels, const std::vector<std::string>& names,
+                          const std::string& type = "CUBE");
     /// Compute a set of orbital-type properties and drop files corresponding to name, index, symmetry label, and type
     void compute_difference(std::shared_ptr<Matrix> C, const std::vector<int>& indices,
                           const std::string& label, bool square = false, const std::string& type = "CUBE");
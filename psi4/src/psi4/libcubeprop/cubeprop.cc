@@ -156,8 +156,7 @@ void CubeProperties::raw_compute_properties() {
                 int h = std::get<2>(info_b_[indsb0[ind]]);
                 labelsb.push_back(std::to_string(i + 1) + "-" + ct.gamma(h).symbol());
             }
-            if (indsa0.size()) compute_orbitals(Ca_, indsa0, labelsa, "Psi_a");
-            if (indsb0.size()) compute_orbitals(Cb_, indsb0, labelsb, "Psi_b");
+            grid_->compute_orbitals({Ca_, Cb_}, {indsa0, indsb0}, {labelsa, labelsb}, {"Psi_a", "Psi_b"});
         } else if (task == "FRONTIER_ORBITALS") {
             std::vector<int> indsa0;
             std::vector<int> indsb0;
@@ -194,8 +193,7 @@ void CubeProperties::raw_compute_properties() {
                 labelsb.push_back(std::to_string(std::get<1>(info_b_[orb_index]) + 1) + "-" +
                                   ct.gamma(std::get<2>(info_b_[orb_index])).symbol() + "_DOMO");
             }
-            if (indsa0.size()) compute_orbitals(Ca_, indsa0, labelsa, "Psi_a");
-            if (indsb0.size()) compute_orbitals(Cb_, indsb0, labelsb, "Psi_b");
+            grid_->compute_orbitals({Ca_, Cb_}, {indsa0, indsb0}, {labelsa, labelsb}, {"Psi_a", "Psi_b"});
         } else if (task == "DUAL_DESCRIPTOR") {
             // Calculates the dual descriptor from frontier molecular orbitals.
             // The dual descriptor is a good measure of electro-/nucleophilicity:
@@ -321,47 +321,87 @@ double Dispersion::compute_energy(std::shared_ptr<Molecule> m) {
             }
         }
     } else {
-        std::shared_ptr<Vector> atom_list = set_atom_list(m);
-        double *atom_list_p = atom_list->pointer();
-        for (int i = 0; i < m->natom(); i++) {
-            for (int j = 0; j < i; j++) {
-                double C6, Rm6, f;
+        std::vector<double> xyz;
+        std::vector<int> types;
+        pair_setup(m, xyz, types);
+        int natom = m->natom();
 
-                double dx = m->x(j) - m->x(i);
-                double dy = m->y(j) - m->y(i);
-                double dz = m->z(j) - m->z(i);
+#pragma omp parallel for schedule(dynamic) reduction(+ : E)
+        for (int i = 0; i < natom; i++) {
+            for (int j = 0; j < i; j++) {
+                double dx = xyz[3 * j + 0] - xyz[3 * i + 0];
+                double dy = xyz[3 * j + 1] - xyz[3 * i + 1];
+                double dz = xyz[3 * j + 2] - xyz[3 * i + 2];
+                double R = sqrt(dx * dx + dy * dy + dz * dz);
+
+                double e, e_R, e_RR;
+                pair_terms(types[i], types[j], R, 0, e, e_R, e_RR);
+                E += e;
+            }
+        }
+    }
+    E *= -s6_;
 
-                double R2 = dx * dx + dy * dy + dz * dz;
-                double R = sqrt(R2);
-                double R6 = R2 * R2 * R2;
-                Rm6 = 1.0 / R6;
+    return E;
+}
 
-                if (C6_type_ == C6_arit) {
-                    C6 = 2.0 * C6_[(int)atom_list_p[i]] * C6_[(int)atom_list_p[j]] /
-                         (C6_[(int)atom_list_p[i]] + C6_[(int)atom_list_p[j]]);
-                } else if (C6_type_ == C6_geom) {
-                    C6 = sqrt(C6_[(int)atom_list_p[i]] * C6_[(int)atom_list_p[j]]);
-                } else {
-                    throw PSIEXCEPTION("Unrecognized C6 Type");
-                }
+void Dispersion::pair_setup(std::shared_ptr<Molecule> m, std::vector<double> &xyz, std::vector<int> &types) {
+    int natom = m->natom();
+    std::shared_ptr<Vector> atom_list = set_atom_list(m);
+    xyz.resize(3 * natom);
+    types.resize(natom);
+    for (int i = 0; i < natom; i++) {
+        xyz[3 * i + 0] = m->x(i);
+        xyz[3 * i + 1] = m->y(i);
+        xyz[3 * i + 2] = m->z(i);
+        types[i] = (int)atom_list->get(i);
+    }
+}
 
-                if (Damping_type_ == Damping_D1) {
-                    double RvdW = (RvdW_[(int) atom_list_p[i]] + RvdW_[(int) atom_list_p[j]]) / 1.1;
-                    f = 1.0 / (1.0 + exp(-d_ * (R / (sr6_ * RvdW) - 1)));
-                } else if (Damping_type_ == Damping_CHG) {
-                    double RvdW = RvdW_[(int)atom_list_p[i]] + RvdW_[(int)atom_list_p[j]];
-                    f = 1.0 / (1.0 + d_ * pow((R / RvdW), -12.0));
-                } else {
-                    throw PSIEXCEPTION("Unrecognized Damping Function");
-                }
+void Dispersion::pair_terms(int ti, int tj, double R, int deriv, double &e, double &e_R, double &e_RR) const {
+    double C6;
+    if (C6_type_ == C6_arit) {
+        C6 = 2.0 * C6_[ti] * C6_[tj] / (C6_[ti] + C6_[tj]);
+    } else if (C6_type_ == C6_geom) {
+        C6 = sqrt(C6_[ti] * C6_[tj]);
+    } else {
+        throw PSIEXCEPTION("Unrecognized C6 Type");
+    }
 
-                E += C6 * Rm6 * f;
-            }
+    double Rm1 = 1.0 / R;
+    double Rm6 = Rm1 * Rm1 * Rm1 * Rm1 * Rm1 * Rm1;
+    double Rm6_R = -6.0 * Rm6 * Rm1;
+    double Rm6_RR = 42.0 * Rm6 * Rm1 * Rm1;
+
+    double f, f_R = 0.0, f_RR = 0.0;
+    if (Damping_type_ == Damping_D1) {
+        double RvdW = sr6_ * (RvdW_[ti] + RvdW_[tj]) / 1.1;
+        double a = d_ / RvdW;
+        double x = exp(-d_ * (R / RvdW - 1.0));
+        f = 1.0 / (1.0 + x);
+        if (deriv > 0) {
+            f_R = a * x * f * f;
+            f_RR = f_R * a * (2.0 * x * f - 1.0);
+        }
+    } else if (Damping_type_ == Damping_CHG) {
+        double RvdW = RvdW_[ti] + RvdW_[tj];
+        double y = d_ * pow((R / RvdW), -12.0);
+        f = 1.0 / (1.0 + y);
+        if (deriv > 0) {
+            double y_R = -12.0 * y * Rm1;
+            double y_RR = 156.0 * y * Rm1 * Rm1;
+            f_R = -y_R * f * f;
+            f_RR = -y_RR * f * f + 2.0 * y_R * y_R * f * f * f;
         }
+    } else if (Damping_type_ == Damping_TT) {
+        throw PSIEXCEPTION("+Das Gradients not yet implemented");
+    } else {
+        throw PSIEXCEPTION("Unrecognized Damping Function");
     }
-    E *= -s6_;
 
-    return E;
+    e = C6 * Rm6 * f;
+    e_R = C6 * (Rm6_R * f + Rm6 * f_R);
+    e_RR = C6 * (Rm6_RR * f + 2.0 * Rm6_R * f_R + Rm6 * f_RR);
 }
 
 SharedMatrix Dispersion::compute_gradient(std::shared_ptr<Molecule> m) {
@@ -372,64 +412,27 @@ SharedMatrix Dispersion::compute_gradient(std::shared_ptr<Molecule> m) {
         throw PSIEXCEPTION("+Das Gradients not yet implemented");
     }
 
-    for (int i = 0; i < m->natom(); i++) {
-        for (int j = 0; j < i; j++) {
-            double C6, Rm6, f;
-            double C6_R, Rm6_R, f_R;
-
-            double R;
-            double R_xi, R_yi, R_zi;
-            double R_xj, R_yj, R_zj;
-
-            double dx = m->x(j) - m->x(i);
-            double dy = m->y(j) - m->y(i);
-            double dz = m->z(j) - m->z(i);
-
-            double R2 = dx * dx + dy * dy + dz * dz;
-            R = sqrt(R2);
-
-            R_xi = -dx / R;
-            R_xj = dx / R;
-            R_yi = -dy / R;
-            R_yj = dy / R;
-            R_zi = -dz / R;
-            R_zj = dz / R;
-
-            double R6 = R2 * R2 * R2;
-            Rm6 = 1.0 / R6;
-            Rm6_R = -6.0 * Rm6 / R;
-
-            double RvdW = RvdW_[(int)m->Z(i)] + RvdW_[(int)m->Z(j)];
-
-            if (C6_type_ == C6_arit) {
-                C6 = 2.0 * C6_[(int)m->Z(i)] * C6_[(int)m->Z(j)] / (C6_[(int)m->Z(i)] + C6_[(int)m->Z(j)]);
-                C6_R = 0.0;
-            } else if (C6_type_ == C6_geom) {
-                C6 = sqrt(C6_[(int)m->Z(i)] * C6_[(int)m->Z(j)]);
-                C6_R = 0.0;
-            } else {
-                throw PSIEXCEPTION("Unrecognized C6 Type");
-            }
-            if (Damping_type_ == Damping_D1) {
-                f = 1.0 / (1.0 + exp(-d_ * (R / RvdW - 1.0)));
-                f_R = -f * f * exp(-d_ * (R / RvdW - 1.0)) * (-d_ / RvdW);
-            } else if (Damping_type_ == Damping_CHG) {
-                f = 1.0 / (1.0 + d_ * pow((R / RvdW), -12.0));
-                f_R = -f * f * d_ * (-12.0) * pow((R / RvdW), -13.0) * (1.0 / RvdW);
-            } else if (Damping_type_ == Damping_TT) {
-                throw PSIEXCEPTION("+Das Gradients not yet implemented");
-            } else {
-                throw PSIEXCEPTION("Unrecognized Damping Function");
-            }
-
-            double E_R = C6_R * Rm6 * f + C6 * Rm6_R * f + C6 * Rm6 * f_R;
-
-            Gp[i][0] += E_R * R_xi;
-            Gp[i][1] += E_R * R_yi;
-            Gp[i][2] += E_R * R_zi;
-            Gp[j][0] += E_R * R_xj;
-            Gp[j][1] += E_R * R_yj;
-            Gp[j][2] += E_R * R_zj;
+    std::vector<double> xyz;
+    std::vector<int> types;
+    pair_setup(m, xyz, types);
+    int natom = m->natom();
+
+    // Each thread owns whole rows of G, so every pair is visited from both ends
+#pragma omp parallel for schedule(dynamic)
+    for (int i = 0; i < natom; i++) {
+        for (int j = 0; j < natom; j++) {
+            if (i == j) continue;
+            double dx = xyz[3 * j + 0] - xyz[3 * i + 0];
+            double dy = xyz[3 * j + 1] - xyz[3 * i + 1];
+            double dz = xyz[3 * j + 2] - xyz[3 * i + 2];
+            double R = sqrt(dx * dx + dy * dy + dz * dz);
+
+            double e, e_R, e_RR;
+            pair_terms(types[i], types[j], R, 1, e, e_R, e_RR);
+
+            Gp[i][0] -= e_R * dx / R;
+            Gp[i][1] -= e_R * dy / R;
+            Gp[i][2] -= e_R * dz / R;
         }
     }
 
@@ -438,7 +441,44 @@ SharedMatrix Dispersion::compute_gradient(std::shared_ptr<Molecule> m) {
 }
 
 SharedMatrix Dispersion::compute_hessian(std::shared_ptr<Molecule> m) {
-    throw PSIEXCEPTION("Dispersion: Hessians not implemented");
+    if (Damping_type_ == Damping_TT) {
+        throw PSIEXCEPTION("+Das Hessians not yet implemented");
+    }
+
+    int natom = m->natom();
+    auto H = std::make_shared<Matrix>("Dispersion Hessian", 3 * natom, 3 * natom);
+    double **Hp = H->pointer();
+
+    std::vector<double> xyz;
+    std::vector<int> types;
+    pair_setup(m, xyz, types);
+
+    // For a pair energy E(R), the (j,j) block is E'' u u^T + E'/R (1 - u u^T) with u the unit
+    // separation; (i,i) is the same, and (i,j) = (j,i) is its negative. Threads own rows of H.
+#pragma omp parallel for schedule(dynamic)
+    for (int i = 0; i < natom; i++) {
+        for (int j = 0; j < natom; j++) {
+            if (i == j) continue;
+            double r[3];
+            for (int a = 0; a < 3; a++) r[a] = xyz[3 * j + a] - xyz[3 * i + a];
+            double R = sqrt(r[0] * r[0] + r[1] * r[1] + r[2] * r[2]);
+
+            double e, e_R, e_RR;
+            pair_terms(types[i], types[j], R, 2, e, e_R, e_RR);
+
+            for (int a = 0; a < 3; a++) {
+                for (int b = 0; b < 3; b++) {
+                    double uu = r[a] * r[b] / (R * R);
+                    double block = e_RR * uu + e_R / R * ((a == b ? 1.0 : 0.0) - uu);
+                    Hp[3 * i + a][3 * i + b] += block;
+                    Hp[3 * i + a][3 * j + b] -= block;
+                }
+            }
+        }
+    }
+
+    H->scale(-s6_);
+    return H;
 }
 
 std::shared_ptr<Vector> Dispersion::set_atom_list(std::shared_ptr<Molecule> mol) {
@@ -37,6 +37,7 @@
 ***********************************************************/
 #include "psi4/psi4-dec.h"
 #include <string>
+#include <vector>
 
 namespace psi {
 
@@ -72,6 +73,12 @@ class Dispersion {
     const double *A_;
     const double *Beta_;
 
+    /// Cartesian coordinates and parameter-table types of every atom in m
+    void pair_setup(std::shared_ptr<Molecule> m, std::vector<double> &xyz, std::vector<int> &types);
+    /// Pair energy (before the -s6 scaling) and, up to deriv, its first and second derivatives in R,
+    /// for the -D1/-D2/-CHG damping forms
+    void pair_terms(int ti, int tj, double R, int deriv, double &e, double &e_R, double &e_RR) const;
+
    public:
     Dispersion();
     virtual ~Dispersion();
@@ -81,6 +81,9 @@
 **
 **   double omega: constant to add to denominators - needed for EOM CC3
 **
+**   double ***FI, ***FJ: Optional rows of F for I and for J, as returned
+**   by T3_RHF_F_rows(); read from disk when null.
+**
 ** TDC, July 2004
 ** -modified for RHF, RAK 2004
 ** -omega argument added, RAK 2006
@@ -98,7 +101,7 @@ namespace psi {
 
 void DPD::T3_RHF(double ***W1, int nirreps, int I, int Gi, int J, int Gj, int K, int Gk, dpdbuf4 *T2, dpdbuf4 *F,
                  dpdbuf4 *E, dpdfile2 *fIJ, dpdfile2 *fAB, int *occpi, int *occ_off, int *virtpi, int *vir_off,
-                 double omega) {
+                 double omega, double ***FI, double ***FJ) {
     int h;
     int i, j, k;
     int ij, ji, ik, ki, jk, kj;
@@ -169,8 +172,12 @@ void DPD::T3_RHF(double ***W1, int nirreps, int I, int Gi, int J, int Gj, int K,
         cd = T2->col_offset[Gjk][Gc];
         id = F->row_offset[Gid][I];
 
-        F->matrix[Gid] = dpd_block_matrix(virtpi[Gd], F->params->coltot[Gid ^ GF]);
-        buf4_mat_irrep_rd_block(F, Gid, id, virtpi[Gd]);
+        if (FI)
+            F->matrix[Gid] = FI[Gd];
+        else {
+            F->matrix[Gid] = dpd_block_matrix(virtpi[Gd], F->params->coltot[Gid ^ GF]);
+            buf4_mat_irrep_rd_block(F, Gid, id, virtpi[Gd]);
+        }
 
         nrows = F->params->coltot[Gid ^ GF];
         ncols = virtpi[Gc];
@@ -180,7 +187,7 @@ void DPD::T3_RHF(double ***W1, int nirreps, int I, int Gi, int J, int Gj, int K,
             C_DGEMM('t', 't', nrows, ncols, nlinks, 1.0, F->matrix[Gid][0], nrows, &(T2->matrix[Gjk][kj][cd]), nlinks,
                     1.0, W1[Gab][0], ncols);
 
-        free_dpd_block(F->matrix[Gid], virtpi[Gd], F->params->coltot[Gid ^ GF]);
+        if (!FI) free_dpd_block(F->matrix[Gid], virtpi[Gd], F->params->coltot[Gid ^ GF]);
     }
 
     for (Gl = 0; Gl < nirreps; Gl++) {
@@ -222,8 +229,12 @@ void DPD::T3_RHF(double ***W1, int nirreps, int I, int Gi, int J, int Gj, int K,
         cd = T2->col_offset[Gik][Gc];
         jd = F->row_offset[Gjd][J];
 
-        F->matrix[Gjd] = dpd_block_matrix(virtpi[Gd], F->params->coltot[Gjd ^ GF]);
-        buf4_mat_irrep_rd_block(F, Gjd, jd, virtpi[Gd]);
+        if (FJ)
+            F->matrix[Gjd] = FJ[Gd];
+        else {
+            F->matrix[Gjd] = dpd_block_matrix(virtpi[Gd], F->params->coltot[Gjd ^ GF]);
+            buf4_mat_irrep_rd_block(F, Gjd, jd, virtpi[Gd]);
+        }
 
         nrows = F->params->coltot[Gjd ^ GF];
         ncols = virtpi[Gc];
@@ -233,7 +244,7 @@ void DPD::T3_RHF(double ***W1, int nirreps, int I, int Gi, int J, int Gj, int K,
             C_DGEMM('t', 't', nrows, ncols, nlinks, 1.0, F->matrix[Gjd][0], nrows, &(T2->matrix[Gik][ki][cd]), nlinks,
                     1.0, W2[Gab][0], ncols);
 
-        free_dpd_block(F->matrix[Gjd], virtpi[Gd], F->params->coltot[Gjd ^ GF]);
+        if (!FJ) free_dpd_block(F->matrix[Gjd], virtpi[Gd], F->params->coltot[Gjd ^ GF]);
     }
 
     for (Gl = 0; Gl < nirreps; Gl++) {
@@ -278,8 +289,12 @@ void DPD::T3_RHF(double ***W1, int nirreps, int I, int Gi, int J, int Gj, int K,
         bd = T2->col_offset[Gjk][Gb];
         id = F->row_offset[Gid][I];
 
-        F->matrix[Gid] = dpd_block_matrix(virtpi[Gd], F->params->coltot[Gid ^ GF]);
-        buf4_mat_irrep_rd_block(F, Gid, id, virtpi[Gd]);
+        if (FI)
+            F->matrix[Gid] = FI[Gd];
+        else {
+            F->matrix[Gid] = dpd_block_matrix(virtpi[Gd], F->params->coltot[Gid ^ GF]);
+            buf4_mat_irrep_rd_block(F, Gid, id, virtpi[Gd]);
+        }
 
         nrows = F->params->coltot[Gid ^ GF];
         ncols = virtpi[Gb];
@@ -289,7 +304,7 @@ void DPD::T3_RHF(double ***W1, int nirreps, int I, int Gi, int J, int Gj, int K,
             C_DGEMM('t', 't', nrows, ncols, nlinks, 1.0, F->matrix[Gid][0], nrows, &(T2->matrix[Gjk][jk][bd]), nlinks,
                     1.0, W2[Gca][0], ncols);
 
-        free_dpd_block(F->matrix[Gid], virtpi[Gd], F->params->coltot[Gid ^ GF]);
+        if (!FI) free_dpd_block(F->matrix[Gid], virtpi[Gd], F->params->coltot[Gid ^ GF]);
     }
 
     for (Gl = 0; Gl < nirreps; Gl++) {
@@ -444,8 +459,12 @@ void DPD::T3_RHF(double ***W1, int nirreps, int I, int Gi, int J, int Gj, int K,
         ad = T2->col_offset[Gik][Ga];
         jd = F->row_offset[Gjd][J];
 
-        F->matrix[Gjd] = dpd_block_matrix(virtpi[Gd], F->params->coltot[Gjd ^ GF]);
-        buf4_mat_irrep_rd_block(F, Gjd, jd, virtpi[Gd]);
+        if (FJ)
+            F->matrix[Gjd] = FJ[Gd];
+        else {
+            F->matrix[Gjd] = dpd_block_matrix(virtpi[Gd], F->params->coltot[Gjd ^ GF]);
+            buf4_mat_irrep_rd_block(F, Gjd, jd, virtpi[Gd]);
+        }
 
         nrows = F->params->coltot[Gjd ^ GF];
         ncols = virtpi[Ga];
@@ -455,7 +474,7 @@ void DPD::T3_RHF(double ***W1, int nirreps, int I, int Gi, int J, int Gj, int K,
             C_DGEMM('t', 't', nrows, ncols, nlinks, 1.0, F->matrix[Gjd][0], nrows, &(T2->matrix[Gik][ik][ad]), nlinks,
                     1.0, W2[Gcb][0], ncols);
 
-        free_dpd_block(F->matrix[Gjd], virtpi[Gd], F->params->coltot[Gjd ^ GF]);
+        if (!FJ) free_dpd_block(F->matrix[Gjd], virtpi[Gd], F->params->coltot[Gjd ^ GF]);
     }
 
     for (Gl = 0; Gl < nirreps; Gl++) {
@@ -512,4 +531,33 @@ void DPD::T3_RHF(double ***W1, int nirreps, int I, int Gi, int J, int Gj, int K,
     free(W2);
 }
 
+/*
+** T3_RHF_F_rows(): Reads the rows F(Xd,bc) of the three-virtual-index
+** intermediate for one occupied index X and every irrep of d. T3_RHF() takes
+** them as FI/FJ so that a caller looping over (ijk) can read the rows of I
+** and J once per i and once per j, rather than once per (ijk).
+**
+** Returns rows[Gd], a virtpi[Gd] x coltot block, to be released with
+** T3_RHF_F_rows_free().
+*/
+double ***DPD::T3_RHF_F_rows(dpdbuf4 *F, int X, int Gx, int *virtpi) {
+    int nirreps = F->params->nirreps;
+    int GF = F->file.my_irrep;
+    auto ***rows = (double ***)malloc(nirreps * sizeof(double **));
+    for (int Gd = 0; Gd < nirreps; Gd++) {
+        int Gxd = Gx ^ Gd;
+        F->matrix[Gxd] = dpd_block_matrix(virtpi[Gd], F->params->coltot[Gxd ^ GF]);
+        buf4_mat_irrep_rd_block(F, Gxd, F->row_offset[Gxd][X], virtpi[Gd]);
+        rows[Gd] = F->matrix[Gxd];
+    }
+    return rows;
+}
+
+void DPD::T3_RHF_F_rows_free(double ***rows, dpdbuf4 *F, int Gx, int *virtpi) {
+    int nirreps = F->params->nirreps;
+    int GF = F->file.my_irrep;
+    for (int Gd = 0; Gd < nirreps; Gd++) free_dpd_block(rows[Gd], virtpi[Gd], F->params->coltot[(Gx ^ Gd) ^ GF]);
+    free(rows);
+}
+
 }  // namespace psi
@@ -63,6 +63,8 @@
 
 #include "psi4/libqt/qt.h"
 #include "psi4/libpsi4util/PsiOutStream.h"
+#include "psi4/libpsi4util/huge_pages.h"
+#include "psi4/libpsi4util/memory_tracker.h"
 #include "psi4/psi4-dec.h"
 
 #include <cstdio>
@@ -106,6 +108,15 @@ double **DPD::dpd_block_matrix(size_t n, size_t m) {
             }
         }
 
+        /* Adaptive cost-benefit cache */
+        else if (dpd_main.cachetype == 2) {
+            if (file4_cache_del_cost()) {
+                file4_cache_print("outfile");
+                outfile->Printf("dpd_block_matrix: n = %zd  m = %zd\n", n, m);
+                dpd_error("dpd_block_matrix: No memory left.", "outfile");
+            }
+        }
+
         else
             dpd_error("LIBDPD Error: invalid cachetype.", "outfile");
     }
@@ -148,16 +159,28 @@ double **DPD::dpd_block_matrix(size_t n, size_t m) {
                 dpd_error("dpd_block_matrix: No memory left.", "outfile");
             }
         }
+
+        /* Adaptive cost-benefit cache */
+        else if (dpd_main.cachetype == 2) {
+            if (file4_cache_del_cost()) {
+                file4_cache_print("outfile");
+                outfile->Printf("dpd_block_matrix: n = %zd  m = %zd\n", n, m);
+                dpd_error("dpd_block_matrix: No memory left.", "outfile");
+            }
+        }
     }
 
     /*  memset((void *) B, 0, m*n*sizeof(double)); */
     // bzero(B, m*n*sizeof(double));
+    huge_pages_advise(B, m * n * sizeof(double));
     ::memset(B, '\0', m * n * sizeof(double));
 
     for (i = 0; i < n; i++) A[i] = &(B[i * m]);
 
-    /* Increment the global memory counter */
+    /* Increment the global memory counter; the threaded CC3 kernels allocate blocks concurrently */
+#pragma omp atomic
     dpd_main.memused += n * m;
+    memory_tracker_add(n * m * sizeof(double));
 
 #ifdef DPD_TIMER
     timer_off("block_mat");
@@ -177,7 +200,9 @@ void DPD::free_dpd_block(double **array, size_t n, size_t m) {
     //#endif
     free(array);
     /* Decrement the global memory counter */
+#pragma omp atomic
     dpd_main.memused -= size;
+    memory_tracker_remove(size * sizeof(double));
 }
 
 }  // namespace psi
@@ -531,4 +531,30 @@ int DPD::buf4_mat_irrep_rd_block(dpdbuf4 *Buf, int irrep, int start_pq, int num_
     return 0;
 }
 
+/* dpd_buf4_mat_irrep_rd_block_async(): Starts buf4_mat_irrep_rd_block()
+** on a background thread so that the next block of rows can be read while
+** the caller works on the current one.
+**
+** Arguments:
+**   dpdbuf4 *Buf: A pointer to the input dpdbuf.
+**   int irrep: The irrep number to be read.
+**   int start_pq: The first row to be read.
+**   int num_pq: The number of rows to be read.
+**   double **block: Storage for at least num_pq rows, typically from
+**                   dpd_block_matrix().  Buf->matrix[irrep] is pointed at
+**                   this block before the read starts.
+**
+** The read goes through PSIO, which is not thread-safe, so the caller must
+** not touch Buf or issue any other DPD/PSIO request until the returned
+** future has been waited on.
+*/
+
+std::future<int> DPD::buf4_mat_irrep_rd_block_async(dpdbuf4 *Buf, int irrep, int start_pq, int num_pq,
+                                                    double **block) {
+    Buf->matrix[irrep] = block;
+    return std::async(std::launch::async, [this, Buf, irrep, start_pq, num_pq]() {
+        return buf4_mat_irrep_rd_block(Buf, irrep, start_pq, num_pq);
+    });
+}
+
 }  // namespace psi
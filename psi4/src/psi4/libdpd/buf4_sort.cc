@@ -44,6 +44,12 @@
 using std::string;
 namespace psi {
 
+/* In-core sorts with fewer elements than this are not worth threading */
+#define DPD_SORT_MIN_THREADED 262144
+/* The index variables are shared by all cases, so every threaded loop privatizes all of them */
+#define DPD_SORT_PRIVATE \
+    private(p, q, r, s, P, Q, R, S, pq, rs, sr, pr, qs, qp, rq, qr, ps, sp, rp, sq, row, col)
+
 /*
 ** dpd_buf4_sort(): A general DPD buffer sorting function that will
 ** (eventually) handle all 24 possible permutations of four-index
@@ -99,20 +105,14 @@ namespace psi {
 **
 ** -TDC, April 2005
 **
+** All out-of-core cases other than pqsr, whose permutation is local to
+** each row, now go through the general multipass buf4_sort_ooc(), which
+** also handles sqpr.
+**
 ** the enum-argument labelling is used in this list
 ** IC=in-core capable; OOC=out-of-core capable
 ** pqrs: error  ** pqsr: IC/OOC
-** prqs: IC/OOC ** prsq: IC/OOC
-** psqr: IC     ** psrq: IC
-** qprs: IC/OOC ** qpsr: IC/OOC
-** qrps: IC     ** qrsp: IC
-** qspr: IC     ** qsrp: IC
-** rqps: IC     ** rqsp: IC
-** rpqs: IC     ** rpsq: IC
-** rsqp: IC     ** rspq: IC/OOC
-** sqrp: IC     ** sqpr: none
-** srqp: IC     ** srpq: IC
-** spqr: IC     ** sprq: IC
+** sqpr: OOC    ** all others: IC/OOC
 ** -RAK, Nov. 2005*/
 
 int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index, int pqnum, int rsnum, const std::string& label) {
@@ -123,10 +123,8 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index, int pqnum
     dpdbuf4 OutBuf;
     int incore;
     long int rowtot, coltot, core_total, maxrows;
-    int Grow, Gcol;
-    int out_rows_per_bucket, out_nbuckets, out_rows_left, out_row_start, n;
-    int in_rows_per_bucket, in_nbuckets, in_rows_left, in_row_start, m;
-    int rows_per_bucket, nbuckets, rows_left;
+    int rows_per_bucket, nbuckets, rows_left, n;
+    int threaded;
 
     nirreps = InBuf->params->nirreps;
     my_irrep = InBuf->file.my_irrep;
@@ -161,6 +159,7 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index, int pqnum
         core_total += 2 * rowtot * coltot;
     }
     if (core_total > dpd_memfree()) incore = 0;
+    threaded = (core_total / 2 > DPD_SORT_MIN_THREADED);
 
 #ifdef DPD_DEBUG
     if (incore == 0) {
@@ -216,6 +215,16 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index, int pqnum
     }
 #endif
 
+    /* Apart from the row-local pqsr case below, out-of-core sorts (and
+       sqpr, which has no in-core code) use the general multipass sort */
+    if ((!incore && index != pqsr) || index == sqpr) {
+        buf4_close(&OutBuf);
+#ifdef DPD_TIMER
+        timer_off("buf4_sort");
+#endif
+        return buf4_sort_ooc(InBuf, outfilenum, index, pqnum, rsnum, label.c_str());
+    }
+
     /* Init input and output buffers and read in all blocks of the input */
     if (incore) {
         for (h = 0; h < nirreps; h++) {
@@ -242,6 +251,7 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index, int pqnum
                 for (h = 0; h < nirreps; h++) {
                     r_irrep = h ^ my_irrep;
 
+#pragma omp parallel for DPD_SORT_PRIVATE if (threaded)
                     for (pq = 0; pq < OutBuf.params->rowtot[h]; pq++) {
                         p = OutBuf.params->roworb[h][pq][0];
                         q = OutBuf.params->roworb[h][pq][1];
@@ -339,6 +349,7 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index, int pqnum
                             Gpr = Gp ^ Gr;
                             Gqs = Gq ^ Gs;
 
+#pragma omp parallel for DPD_SORT_PRIVATE if (threaded)
                             for (p = 0; p < OutBuf.params->ppi[Gp]; p++) {
                                 P = OutBuf.params->poff[Gp] + p;
                                 for (q = 0; q < OutBuf.params->qpi[Gq]; q++) {
@@ -362,185 +373,6 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index, int pqnum
                         }
                     }
                 }
-            } else { /* pqrs <- prqs */
-
-                for (Gpq = 0; Gpq < nirreps; Gpq++) {
-                    Grs = Gpq ^ my_irrep;
-
-                    out_rows_per_bucket = dpd_memfree() / (2 * OutBuf.params->coltot[Grs]);
-                    if (out_rows_per_bucket > OutBuf.params->rowtot[Gpq])
-                        out_rows_per_bucket = OutBuf.params->rowtot[Gpq];
-                    out_nbuckets = (int)ceil((double)OutBuf.params->rowtot[Gpq] / (double)out_rows_per_bucket);
-                    if (out_nbuckets == 1)
-                        out_rows_left = out_rows_per_bucket;
-                    else
-                        out_rows_left = OutBuf.params->rowtot[Gpq] % out_rows_per_bucket;
-
-                    /* allocate space for the bucket of rows */
-                    buf4_mat_irrep_init_block(&OutBuf, Gpq, out_rows_per_bucket);
-
-                    for (n = 0; n < (out_rows_left ? out_nbuckets - 1 : out_nbuckets); n++) {
-                        out_row_start = n * out_rows_per_bucket;
-
-                        for (Grow = 0; Grow < nirreps; Grow++) { /*Grow = Gpr*/
-                            Gcol = Grow ^ my_irrep;              /*Gcol = Gqs*/
-
-                            /* determine how many rows of InBuf we can store in the other half of the core */
-                            in_rows_per_bucket = dpd_memfree() / (2 * InBuf->params->coltot[Gcol]);
-                            if (in_rows_per_bucket > InBuf->params->rowtot[Grow])
-                                in_rows_per_bucket = InBuf->params->rowtot[Grow];
-                            in_nbuckets = (int)ceil((double)InBuf->params->rowtot[Grow] / (double)in_rows_per_bucket);
-                            if (in_nbuckets == 1)
-                                in_rows_left = in_rows_per_bucket;
-                            else
-                                in_rows_left = InBuf->params->rowtot[Grow] % in_rows_per_bucket;
-
-                            /* allocate space for the bucket of rows */
-                            buf4_mat_irrep_init_block(InBuf, Grow, in_rows_per_bucket);
-
-                            /* pqrs <- prqs */
-                            for (m = 0; m < (in_rows_left ? in_nbuckets - 1 : in_nbuckets); m++) {
-                                in_row_start = m * in_rows_per_bucket;
-                                buf4_mat_irrep_rd_block(InBuf, Grow, in_row_start, in_rows_per_bucket);
-
-                                for (pq = 0; pq < out_rows_per_bucket; pq++) {
-                                    p = OutBuf.params->roworb[Gpq][pq + out_row_start][0];
-                                    q = OutBuf.params->roworb[Gpq][pq + out_row_start][1];
-                                    Gp = OutBuf.params->psym[p];
-                                    Gq = Gpq ^ Gp;
-                                    for (rs = 0; rs < OutBuf.params->coltot[Grs]; rs++) {
-                                        r = OutBuf.params->colorb[Grs][rs][0];
-                                        s = OutBuf.params->colorb[Grs][rs][1];
-                                        Gr = OutBuf.params->rsym[r];
-                                        Gs = Grs ^ Gr;
-                                        Gpr = Gp ^ Gr;
-
-                                        if (Gpr == Grow) {
-                                            pr = InBuf->params->rowidx[p][r] - in_row_start;
-                                            /* check if the current value is in the current in_bucket or not */
-                                            if (pr >= 0 && pr < in_rows_per_bucket) {
-                                                qs = InBuf->params->colidx[q][s];
-                                                OutBuf.matrix[Gpq][pq][rs] = InBuf->matrix[Grow][pr][qs];
-                                            }
-                                        }
-                                    }
-                                }
-                            }
-                            if (in_rows_left) {
-                                in_row_start = m * in_rows_per_bucket;
-                                buf4_mat_irrep_rd_block(InBuf, Grow, in_row_start, in_rows_left);
-
-                                /* pqrs <- prqs */
-                                for (pq = 0; pq < out_rows_per_bucket; pq++) {
-                                    p = OutBuf.params->roworb[Gpq][pq + out_row_start][0];
-                                    q = OutBuf.params->roworb[Gpq][pq + out_row_start][1];
-                                    Gp = OutBuf.params->psym[p];
-                                    Gq = Gpq ^ Gp;
-                                    for (rs = 0; rs < OutBuf.params->coltot[Grs]; rs++) {
-                                        r = OutBuf.params->colorb[Grs][rs][0];
-                                        s = OutBuf.params->colorb[Grs][rs][1];
-                                        Gr = OutBuf.params->rsym[r];
-                                        Gs = Grs ^ Gr;
-                                        Gpr = Gp ^ Gr;
-
-                                        if (Gpr == Grow) {
-                                            pr = InBuf->params->rowidx[p][r] - in_row_start;
-                                            /* check if the current value is in core or not */
-                                            if (pr >= 0 && pr < in_rows_left) {
-                                                qs = InBuf->params->colidx[q][s];
-                                                OutBuf.matrix[Gpq][pq][rs] = InBuf->matrix[Grow][pr][qs];
-                                            }
-                                        }
-                                    }
-                                }
-                            }
-                            buf4_mat_irrep_close_block(InBuf, Grow, in_rows_per_bucket);
-                        }
-                        buf4_mat_irrep_wrt_block(&OutBuf, Gpq, out_row_start, out_rows_per_bucket);
-                    }
-                    if (out_rows_left) {
-                        out_row_start = n * out_rows_per_bucket;
-
-                        for (Grow = 0; Grow < nirreps; Grow++) {
-                            Gcol = Grow ^ my_irrep;
-
-                            /* determine how many rows of InBuf we can store in the other half of the core */
-                            in_rows_per_bucket = dpd_memfree() / (2 * InBuf->params->coltot[Gcol]);
-                            if (in_rows_per_bucket > InBuf->params->rowtot[Grow])
-                                in_rows_per_bucket = InBuf->params->rowtot[Grow];
-                            in_nbuckets = (int)ceil((double)InBuf->params->rowtot[Grow] / (double)in_rows_per_bucket);
-                            if (in_nbuckets == 1)
-                                in_rows_left = in_rows_per_bucket;
-                            else
-                                in_rows_left = InBuf->params->rowtot[Grow] % in_rows_per_bucket;
-
-                            /* allocate space for the bucket of rows */
-                            buf4_mat_irrep_init_block(InBuf, Grow, in_rows_per_bucket);
-
-                            /* pqrs <- prqs */
-                            for (m = 0; m < (in_rows_left ? in_nbuckets - 1 : in_nbuckets); m++) {
-                                in_row_start = m * in_rows_per_bucket;
-                                buf4_mat_irrep_rd_block(InBuf, Grow, in_row_start, in_rows_per_bucket);
-
-                                for (pq = 0; pq < out_rows_left; pq++) {
-                                    p = OutBuf.params->roworb[Gpq][pq + out_row_start][0];
-                                    q = OutBuf.params->roworb[Gpq][pq + out_row_start][1];
-                                    Gp = OutBuf.params->psym[p];
-                                    Gq = Gpq ^ Gp;
-                                    for (rs = 0; rs < OutBuf.params->coltot[Grs]; rs++) {
-                                        r = OutBuf.params->colorb[Grs][rs][0];
-                                        s = OutBuf.params->colorb[Grs][rs][1];
-                                        Gr = OutBuf.params->rsym[r];
-                                        Gs = Grs ^ Gr;
-                                        Gpr = Gp ^ Gr;
-
-                                        if (Gpr == Grow) {
-                                            pr = InBuf->params->rowidx[p][r] - in_row_start;
-                                            /* check if the current value is in the current in_bucket or not */
-                                            if (pr >= 0 && pr < in_rows_per_bucket) {
-                                                qs = InBuf->params->colidx[q][s];
-                                                OutBuf.matrix[Gpq][pq][rs] = InBuf->matrix[Grow][pr][qs];
-                                            }
-                                        }
-                                    }
-                                }
-                            }
-                            if (in_rows_left) {
-                                in_row_start = m * in_rows_per_bucket;
-                                buf4_mat_irrep_rd_block(InBuf, Grow, in_row_start, in_rows_left);
-
-                                for (pq = 0; pq < out_rows_left; pq++) {
-                                    p = OutBuf.params->roworb[Gpq][pq + out_row_start][0];
-                                    q = OutBuf.params->roworb[Gpq][pq + out_row_start][1];
-                                    Gp = OutBuf.params->psym[p];
-                                    Gq = Gpq ^ Gp;
-                                    for (rs = 0; rs < OutBuf.params->coltot[Grs]; rs++) {
-                                        r = OutBuf.params->colorb[Grs][rs][0];
-                                        s = OutBuf.params->colorb[Grs][rs][1];
-                                        Gr = OutBuf.params->rsym[r];
-                                        Gs = Grs ^ Gr;
-                                        Gpr = Gp ^ Gr;
-
-                                        if (Gpr == Grow) {
-                                            pr = InBuf->params->rowidx[p][r] - in_row_start;
-                                            /* check if the current value is in core or not */
-                                            if (pr >= 0 && pr < in_rows_left) {
-                                                qs = InBuf->params->colidx[q][s];
-                                                OutBuf.matrix[Gpq][pq][rs] = InBuf->matrix[Grow][pr][qs];
-                                            }
-                                        }
-                                    }
-                                }
-                            }
-
-                            buf4_mat_irrep_close_block(InBuf, Grow, in_rows_per_bucket);
-                        }
-
-                        buf4_mat_irrep_wrt_block(&OutBuf, Gpq, out_row_start, out_rows_left);
-                    }
-
-                    buf4_mat_irrep_close_block(&OutBuf, Gpq, out_rows_per_bucket);
-                }
             }
 
 #ifdef DPD_TIMER
@@ -568,6 +400,7 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index, int pqnum
                             Gps = Gp ^ Gs;
                             Gqr = Gq ^ Gr;
 
+#pragma omp parallel for DPD_SORT_PRIVATE if (threaded)
                             for (p = 0; p < OutBuf.params->ppi[Gp]; p++) {
                                 P = OutBuf.params->poff[Gp] + p;
                                 for (q = 0; q < OutBuf.params->qpi[Gq]; q++) {
@@ -591,186 +424,6 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index, int pqnum
                         }
                     }
                 }
-            } else {
-                for (Gpq = 0; Gpq < nirreps; Gpq++) {
-                    Grs = Gpq ^ my_irrep;
-
-                    /* determine how many rows of OutBuf we can store in half of the core */
-                    out_rows_per_bucket = dpd_memfree() / (2 * OutBuf.params->coltot[Grs]);
-                    if (out_rows_per_bucket > OutBuf.params->rowtot[Gpq])
-                        out_rows_per_bucket = OutBuf.params->rowtot[Gpq];
-                    out_nbuckets = (int)ceil((double)OutBuf.params->rowtot[Gpq] / (double)out_rows_per_bucket);
-                    if (out_nbuckets == 1)
-                        out_rows_left = out_rows_per_bucket;
-                    else
-                        out_rows_left = OutBuf.params->rowtot[Gpq] % out_rows_per_bucket;
-
-                    /* allocate space for the bucket of rows */
-                    buf4_mat_irrep_init_block(&OutBuf, Gpq, out_rows_per_bucket);
-
-                    for (n = 0; n < (out_rows_left ? out_nbuckets - 1 : out_nbuckets); n++) {
-                        out_row_start = n * out_rows_per_bucket;
-
-                        for (Grow = 0; Grow < nirreps; Grow++) {
-                            Gcol = Grow ^ my_irrep;
-
-                            /* determine how many rows of InBuf we can store in the other half of the core */
-                            in_rows_per_bucket = dpd_memfree() / (2 * InBuf->params->coltot[Gcol]);
-                            if (in_rows_per_bucket > InBuf->params->rowtot[Grow])
-                                in_rows_per_bucket = InBuf->params->rowtot[Grow];
-                            in_nbuckets = (int)ceil((double)InBuf->params->rowtot[Grow] / (double)in_rows_per_bucket);
-                            if (in_nbuckets == 1)
-                                in_rows_left = in_rows_per_bucket;
-                            else
-                                in_rows_left = InBuf->params->rowtot[Grow] % in_rows_per_bucket;
-
-                            /* allocate space for the bucket of rows */
-                            buf4_mat_irrep_init_block(InBuf, Grow, in_rows_per_bucket);
-
-                            for (m = 0; m < (in_rows_left ? in_nbuckets - 1 : in_nbuckets); m++) {
-                                in_row_start = m * in_rows_per_bucket;
-                                buf4_mat_irrep_rd_block(InBuf, Grow, in_row_start, in_rows_per_bucket);
-
-                                for (pq = 0; pq < out_rows_per_bucket; pq++) {
-                                    p = OutBuf.params->roworb[Gpq][pq + out_row_start][0];
-                                    q = OutBuf.params->roworb[Gpq][pq + out_row_start][1];
-                                    Gp = OutBuf.params->psym[p];
-                                    Gq = Gpq ^ Gp;
-                                    for (rs = 0; rs < OutBuf.params->coltot[Grs]; rs++) {
-                                        r = OutBuf.params->colorb[Grs][rs][0];
-                                        s = OutBuf.params->colorb[Grs][rs][1];
-                                        Gr = OutBuf.params->rsym[r];
-                                        Gs = Grs ^ Gr;
-
-                                        Gps = Gp ^ Gs;
-
-                                        if (Gps == Grow) {
-                                            ps = InBuf->params->rowidx[p][s] - in_row_start;
-                                            /* check if the current value is in the current in_bucket or not */
-                                            if (ps >= 0 && ps < in_rows_per_bucket) {
-                                                qr = InBuf->params->colidx[q][r];
-                                                OutBuf.matrix[Gpq][pq][rs] = InBuf->matrix[Grow][ps][qr];
-                                            }
-                                        }
-                                    }
-                                }
-                            }
-                            if (in_rows_left) {
-                                in_row_start = m * in_rows_per_bucket;
-                                buf4_mat_irrep_rd_block(InBuf, Grow, in_row_start, in_rows_left);
-
-                                for (pq = 0; pq < out_rows_per_bucket; pq++) {
-                                    p = OutBuf.params->roworb[Gpq][pq + out_row_start][0];
-                                    q = OutBuf.params->roworb[Gpq][pq + out_row_start][1];
-                                    Gp = OutBuf.params->psym[p];
-                                    Gq = Gpq ^ Gp;
-                                    for (rs = 0; rs < OutBuf.params->coltot[Grs]; rs++) {
-                                        r = OutBuf.params->colorb[Grs][rs][0];
-                                        s = OutBuf.params->colorb[Grs][rs][1];
-                                        Gr = OutBuf.params->rsym[r];
-                                        Gs = Grs ^ Gr;
-
-                                        Gps = Gp ^ Gs;
-
-                                        if (Gps == Grow) {
-                                            ps = InBuf->params->rowidx[p][s] - in_row_start;
-                                            /* check if the current value is in core or not */
-                                            if (ps >= 0 && ps < in_rows_left) {
-                                                qr = InBuf->params->colidx[q][r];
-                                                OutBuf.matrix[Gpq][pq][rs] = InBuf->matrix[Grow][ps][qr];
-                                            }
-                                        }
-                                    }
-                                }
-                            }
-                            buf4_mat_irrep_close_block(InBuf, Grow, in_rows_per_bucket);
-                        }
-                        buf4_mat_irrep_wrt_block(&OutBuf, Gpq, out_row_start, out_rows_per_bucket);
-                    }
-                    if (out_rows_left) {
-                        out_row_start = n * out_rows_per_bucket;
-
-                        for (Grow = 0; Grow < nirreps; Grow++) {
-                            Gcol = Grow ^ my_irrep;
-
-                            /* determine how many rows of InBuf we can store in the other half of the core */
-                            in_rows_per_bucket = dpd_memfree() / (2 * InBuf->params->coltot[Gcol]);
-                            if (in_rows_per_bucket > InBuf->params->rowtot[Grow])
-                                in_rows_per_bucket = InBuf->params->rowtot[Grow];
-                            in_nbuckets = (int)ceil((double)InBuf->params->rowtot[Grow] / (double)in_rows_per_bucket);
-                            if (in_nbuckets == 1)
-                                in_rows_left = in_rows_per_bucket;
-                            else
-                                in_rows_left = InBuf->params->rowtot[Grow] % in_rows_per_bucket;
-
-                            /* allocate space for the bucket of rows */
-                            buf4_mat_irrep_init_block(InBuf, Grow, in_rows_per_bucket);
-
-                            for (m = 0; m < (in_rows_left ? in_nbuckets - 1 : in_nbuckets); m++) {
-                                in_row_start = m * in_rows_per_bucket;
-                                buf4_mat_irrep_rd_block(InBuf, Grow, in_row_start, in_rows_per_bucket);
-
-                                for (pq = 0; pq < out_rows_left; pq++) {
-                                    p = OutBuf.params->roworb[Gpq][pq + out_row_start][0];
-                                    q = OutBuf.params->roworb[Gpq][pq + out_row_start][1];
-                                    Gp = OutBuf.params->psym[p];
-                                    Gq = Gpq ^ Gp;
-                                    for (rs = 0; rs < OutBuf.params->coltot[Grs]; rs++) {
-                                        r = OutBuf.params->colorb[Grs][rs][0];
-                                        s = OutBuf.params->colorb[Grs][rs][1];
-                                        Gr = OutBuf.params->rsym[r];
-                                        Gs = Grs ^ Gr;
-
-                                        Gps = Gp ^ Gs;
-
-                                        if (Gps == Grow) {
-                                            ps = InBuf->params->rowidx[p][s] - in_row_start;
-                                            /* check if the current value is in the current in_bucket or not */
-                                            if (ps >= 0 && ps < in_rows_per_bucket) {
-                                                qr = InBuf->params->colidx[q][r];
-                                                OutBuf.matrix[Gpq][pq][rs] = InBuf->matrix[Grow][ps][qr];
-                                            }
-                                        }
-                                    }
-                                }
-                            }
-                            if (in_rows_left) {
-                                in_row_start = m * in_rows_per_bucket;
-                                buf4_mat_irrep_rd_block(InBuf, Grow, in_row_start, in_rows_left);
-
-                                for (pq = 0; pq < out_rows_left; pq++) {
-                                    p = OutBuf.params->roworb[Gpq][pq + out_row_start][0];
-                                    q = OutBuf.params->roworb[Gpq][pq + out_row_start][1];
-                                    Gp = OutBuf.params->psym[p];
-                                    Gq = Gpq ^ Gp;
-                                    for (rs = 0; rs < OutBuf.params->coltot[Grs]; rs++) {
-                                        r = OutBuf.params->colorb[Grs][rs][0];
-                                        s = OutBuf.params->colorb[Grs][rs][1];
-                                        Gr = OutBuf.params->rsym[r];
-                                        Gs = Grs ^ Gr;
-
-                                        Gps = Gp ^ Gs;
-
-                                        if (Gps == Grow) {
-                                            ps = InBuf->params->rowidx[p][s] - in_row_start;
-                                            /* check if the current value is in core or not */
-                                            if (ps >= 0 && ps < in_rows_left) {
-                                                qr = InBuf->params->colidx[q][r];
-                                                OutBuf.matrix[Gpq][pq][rs] = InBuf->matrix[Grow][ps][qr];
-                                            }
-                                        }
-                                    }
-                                }
-                            }
-
-                            buf4_mat_irrep_close_block(InBuf, Grow, in_rows_per_bucket);
-                        }
-
-                        buf4_mat_irrep_wrt_block(&OutBuf, Gpq, out_row_start, out_rows_left);
-                    }
-
-                    buf4_mat_irrep_close_block(&OutBuf, Gpq, out_rows_per_bucket);
-                }
             }
 
 #ifdef DPD_TIMER
@@ -798,6 +451,7 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index, int pqnum
                             Gpr = Gp ^ Gr;
                             Gsq = Gs ^ Gq;
 
+#pragma omp parallel for DPD_SORT_PRIVATE if (threaded)
                             for (p = 0; p < OutBuf.params->ppi[Gp]; p++) {
                                 P = OutBuf.params->poff[Gp] + p;
                                 for (q = 0; q < OutBuf.params->qpi[Gq]; q++) {
@@ -821,9 +475,6 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index, int pqnum
                         }
                     }
                 }
-            } else {
-                outfile->Printf("LIBDPD: Out-of-core algorithm not yet coded for psqr sort.\n");
-                dpd_error("buf4_sort", "outfile");
             }
 
 #ifdef DPD_TIMER
@@ -851,6 +502,7 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index, int pqnum
                             Gps = Gp ^ Gs;
                             Grq = Gr ^ Gq;
 
+#pragma omp parallel for DPD_SORT_PRIVATE if (threaded)
                             for (p = 0; p < OutBuf.params->ppi[Gp]; p++) {
                                 P = OutBuf.params->poff[Gp] + p;
                                 for (q = 0; q < OutBuf.params->qpi[Gq]; q++) {
@@ -874,9 +526,6 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index, int pqnum
                         }
                     }
                 }
-            } else {
-                outfile->Printf("LIBDPD: Out-of-core algorithm not yet coded for psrq sort.\n");
-                dpd_error("buf4_sort", "outfile");
             }
 
 #ifdef DPD_TIMER
@@ -896,6 +545,7 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index, int pqnum
                 for (h = 0; h < nirreps; h++) {
                     r_irrep = h ^ my_irrep;
 
+#pragma omp parallel for DPD_SORT_PRIVATE if (threaded)
                     for (pq = 0; pq < OutBuf.params->rowtot[h]; pq++) {
                         p = OutBuf.params->roworb[h][pq][0];
                         q = OutBuf.params->roworb[h][pq][1];
@@ -911,97 +561,6 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index, int pqnum
                         }
                     }
                 }
-            } else {
-                for (Gpq = 0; Gpq < nirreps; Gpq++) {
-                    Grs = Gpq ^ my_irrep;
-
-                    /* determine how many rows of OutBuf/InBuf we can store in half the core */
-                    rows_per_bucket = dpd_memfree() / (2 * OutBuf.params->coltot[Grs]);
-                    if (rows_per_bucket > OutBuf.params->rowtot[Gpq]) rows_per_bucket = OutBuf.params->rowtot[Gpq];
-                    nbuckets = (int)ceil((double)OutBuf.params->rowtot[Gpq] / (double)rows_per_bucket);
-                    if (nbuckets == 1)
-                        rows_left = rows_per_bucket;
-                    else
-                        rows_left = OutBuf.params->rowtot[Gpq] % rows_per_bucket;
-
-                    /* allocate space for the bucket of rows */
-                    buf4_mat_irrep_init_block(&OutBuf, Gpq, rows_per_bucket);
-                    buf4_mat_irrep_init_block(InBuf, Gpq, rows_per_bucket);
-
-                    for (n = 0; n < (rows_left ? nbuckets - 1 : nbuckets); n++) {
-                        out_row_start = n * rows_per_bucket;
-
-                        for (m = 0; m < (rows_left ? nbuckets - 1 : nbuckets); m++) {
-                            in_row_start = m * rows_per_bucket;
-                            buf4_mat_irrep_rd_block(InBuf, Gpq, in_row_start, rows_per_bucket);
-                            for (pq = 0; pq < rows_per_bucket; pq++) {
-                                /* check to see if this row is contained in the current input-bucket */
-                                p = OutBuf.params->roworb[Gpq][pq + out_row_start][0];
-                                q = OutBuf.params->roworb[Gpq][pq + out_row_start][1];
-                                qp = InBuf->params->rowidx[q][p] - in_row_start;
-                                if (qp >= 0 && qp < rows_per_bucket) {
-                                    C_DCOPY(OutBuf.params->coltot[Grs], InBuf->matrix[Gpq][qp], 1,
-                                            OutBuf.matrix[Gpq][pq], 1);
-                                }
-                            }
-                        }
-
-                        if (rows_left) {
-                            in_row_start = m * rows_per_bucket;
-                            buf4_mat_irrep_rd_block(InBuf, Gpq, in_row_start, rows_left);
-                            for (pq = 0; pq < rows_per_bucket; pq++) {
-                                /* check to see if this row is contained in the current input-bucket */
-                                p = OutBuf.params->roworb[Gpq][pq + out_row_start][0];
-                                q = OutBuf.params->roworb[Gpq][pq + out_row_start][1];
-                                qp = InBuf->params->rowidx[q][p] - in_row_start;
-                                if (qp >= 0 && qp < rows_left) {
-                                    C_DCOPY(OutBuf.params->coltot[Grs], InBuf->matrix[Gpq][qp], 1,
-                                            OutBuf.matrix[Gpq][pq], 1);
-                                }
-                            }
-                        }
-
-                        buf4_mat_irrep_wrt_block(&OutBuf, Gpq, out_row_start, rows_per_bucket);
-
-                    } /* n */
-                    if (rows_left) {
-                        out_row_start = n * rows_per_bucket;
-
-                        for (m = 0; m < (rows_left ? nbuckets - 1 : nbuckets); m++) {
-                            in_row_start = m * rows_per_bucket;
-                            buf4_mat_irrep_rd_block(InBuf, Gpq, in_row_start, rows_per_bucket);
-                            for (pq = 0; pq < rows_left; pq++) {
-                                /* check to see if this row is contained in the current input-bucket */
-                                p = OutBuf.params->roworb[Gpq][pq + out_row_start][0];
-                                q = OutBuf.params->roworb[Gpq][pq + out_row_start][1];
-                                qp = InBuf->params->rowidx[q][p] - in_row_start;
-                                if (qp >= 0 && qp < rows_per_bucket) {
-                                    C_DCOPY(OutBuf.params->coltot[Grs], InBuf->matrix[Gpq][qp], 1,
-                                            OutBuf.matrix[Gpq][pq], 1);
-                                }
-                            }
-                        }
-
-                        if (rows_left) {
-                            in_row_start = m * rows_per_bucket;
-                            buf4_mat_irrep_rd_block(InBuf, Gpq, in_row_start, rows_left);
-                            for (pq = 0; pq < rows_left; pq++) {
-                                /* check to see if this row is contained in the current input-bucket */
-                                p = OutBuf.params->roworb[Gpq][pq + out_row_start][0];
-                                q = OutBuf.params->roworb[Gpq][pq + out_row_start][1];
-                                qp = InBuf->params->rowidx[q][p] - in_row_start;
-                                if (qp >= 0 && qp < rows_left) {
-                                    C_DCOPY(OutBuf.params->coltot[Grs], InBuf->matrix[Gpq][qp], 1,
-                                            OutBuf.matrix[Gpq][pq], 1);
-                                }
-                            }
-                        }
-                    }
-
-                    buf4_mat_irrep_wrt_block(&OutBuf, Gpq, out_row_start, rows_left);
-                    buf4_mat_irrep_close_block(InBuf, Gpq, rows_per_bucket);
-                    buf4_mat_irrep_close_block(&OutBuf, Gpq, rows_per_bucket);
-                } /* Gpq */
             }
 #ifdef DPD_TIMER
             timer_off("qprs");
@@ -1020,6 +579,7 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index, int pqnum
                 for (h = 0; h < nirreps; h++) {
                     r_irrep = h ^ my_irrep;
 
+#pragma omp parallel for DPD_SORT_PRIVATE if (threaded)
                     for (pq = 0; pq < OutBuf.params->rowtot[h]; pq++) {
                         p = OutBuf.params->roworb[h][pq][0];
                         q = OutBuf.params->roworb[h][pq][1];
@@ -1034,117 +594,6 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index, int pqnum
                         }
                     }
                 }
-            } else {
-                for (Gpq = 0; Gpq < nirreps; Gpq++) {
-                    Grs = Gpq ^ my_irrep;
-
-                    /* determine how many rows of OutBuf/InBuf we can store in half the core */
-                    rows_per_bucket = dpd_memfree() / (2 * OutBuf.params->coltot[Grs]);
-                    if (rows_per_bucket > OutBuf.params->rowtot[Gpq]) rows_per_bucket = OutBuf.params->rowtot[Gpq];
-                    nbuckets = (int)ceil((double)OutBuf.params->rowtot[Gpq] / (double)rows_per_bucket);
-                    if (nbuckets == 1)
-                        rows_left = rows_per_bucket;
-                    else
-                        rows_left = OutBuf.params->rowtot[Gpq] % rows_per_bucket;
-
-                    /* allocate space for the bucket of rows */
-                    buf4_mat_irrep_init_block(&OutBuf, Gpq, rows_per_bucket);
-                    buf4_mat_irrep_init_block(InBuf, Gpq, rows_per_bucket);
-
-                    for (n = 0; n < (rows_left ? nbuckets - 1 : nbuckets); n++) {
-                        out_row_start = n * rows_per_bucket;
-
-                        for (m = 0; m < (rows_left ? nbuckets - 1 : nbuckets); m++) {
-                            in_row_start = m * rows_per_bucket;
-                            buf4_mat_irrep_rd_block(InBuf, Gpq, in_row_start, rows_per_bucket);
-
-                            for (pq = 0; pq < rows_per_bucket; pq++) {
-                                /* check to see if this row is contained in the current input-bucket */
-                                p = OutBuf.params->roworb[Gpq][pq + out_row_start][0];
-                                q = OutBuf.params->roworb[Gpq][pq + out_row_start][1];
-                                qp = InBuf->params->rowidx[q][p] - in_row_start;
-                                if (qp >= 0 && qp < rows_per_bucket) {
-                                    for (rs = 0; rs < OutBuf.params->coltot[Grs]; rs++) {
-                                        r = OutBuf.params->colorb[Grs][rs][0];
-                                        s = OutBuf.params->colorb[Grs][rs][1];
-                                        sr = InBuf->params->colidx[s][r];
-                                        OutBuf.matrix[Gpq][pq][rs] = InBuf->matrix[Gpq][qp][sr];
-                                    }
-                                }
-                            }
-                        }
-                        if (rows_left) {
-                            in_row_start = m * rows_per_bucket;
-                            buf4_mat_irrep_rd_block(InBuf, Gpq, in_row_start, rows_left);
-
-                            for (pq = 0; pq < rows_per_bucket; pq++) {
-                                /* check to see if this row is contained in the current input-bucket */
-                                p = OutBuf.params->roworb[Gpq][pq + out_row_start][0];
-                                q = OutBuf.params->roworb[Gpq][pq + out_row_start][1];
-                                qp = InBuf->params->rowidx[q][p] - in_row_start;
-                                if (qp >= 0 && qp < rows_left) {
-                                    for (rs = 0; rs < OutBuf.params->coltot[Grs]; rs++) {
-                                        r = OutBuf.params->colorb[Grs][rs][0];
-                                        s = OutBuf.params->colorb[Grs][rs][1];
-                                        sr = InBuf->params->colidx[s][r];
-                                        OutBuf.matrix[Gpq][pq][rs] = InBuf->matrix[Gpq][qp][sr];
-                                    }
-                                }
-                            }
-                        }
-
-                        buf4_mat_irrep_wrt_block(&OutBuf, Gpq, out_row_start, rows_per_bucket);
-
-                    } /* n */
-                    if (rows_left) {
-                        out_row_start = n * rows_per_bucket;
-
-                        for (m = 0; m < (rows_left ? nbuckets - 1 : nbuckets); m++) {
-                            in_row_start = m * rows_per_bucket;
-                            buf4_mat_irrep_rd_block(InBuf, Gpq, in_row_start, rows_per_bucket);
-
-                            for (pq = 0; pq < rows_left; pq++) {
-                                /* check to see if this row is contained in the current input-bucket */
-                                p = OutBuf.params->roworb[Gpq][pq + out_row_start][0];
-                                q = OutBuf.params->roworb[Gpq][pq + out_row_start][1];
-                                qp = InBuf->params->rowidx[q][p] - in_row_start;
-                                if (qp >= 0 && qp < rows_per_bucket) {
-                                    for (rs = 0; rs < OutBuf.params->coltot[Grs]; rs++) {
-                                        r = OutBuf.params->colorb[Grs][rs][0];
-                                        s = OutBuf.params->colorb[Grs][rs][1];
-                                        sr = InBuf->params->colidx[s][r];
-                                        OutBuf.matrix[Gpq][pq][rs] = InBuf->matrix[Gpq][qp][sr];
-                                    }
-                                }
-                            }
-                        }
-                        if (rows_left) {
-                            in_row_start = m * rows_per_bucket;
-                            buf4_mat_irrep_rd_block(InBuf, Gpq, in_row_start, rows_left);
-
-                            for (pq = 0; pq < rows_left; pq++) {
-                                /* check to see if this row is contained in the current input-bucket */
-                                p = OutBuf.params->roworb[Gpq][pq + out_row_start][0];
-                                q = OutBuf.params->roworb[Gpq][pq + out_row_start][1];
-                                qp = InBuf->params->rowidx[q][p] - in_row_start;
-                                if (qp >= 0 && qp < rows_left) {
-                                    for (rs = 0; rs < OutBuf.params->coltot[Grs]; rs++) {
-                                        r = OutBuf.params->colorb[Grs][rs][0];
-                                        s = OutBuf.params->colorb[Grs][rs][1];
-                                        sr = InBuf->params->colidx[s][r];
-                                        OutBuf.matrix[Gpq][pq][rs] = InBuf->matrix[Gpq][qp][sr];
-                                    }
-                                }
-                            }
-                        }
-                    }
-
-                    buf4_mat_irrep_wrt_block(&OutBuf, Gpq, out_row_start, rows_left);
-
-                    buf4_mat_irrep_close_block(InBuf, Gpq, rows_per_bucket);
-                    buf4_mat_irrep_close_block(&OutBuf, Gpq, rows_per_bucket);
-
-                } /* Gpq */
             }
 
 #ifdef DPD_TIMER
@@ -1171,6 +620,7 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index, int pqnum
                             Grp = Gr ^ Gp;
                             Gqs = Gq ^ Gs;
 
+#pragma omp parallel for DPD_SORT_PRIVATE if (threaded)
                             for (p = 0; p < OutBuf.params->ppi[Gp]; p++) {
                                 P = OutBuf.params->poff[Gp] + p;
                                 for (q = 0; q < OutBuf.params->qpi[Gq]; q++) {
@@ -1194,9 +644,6 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index, int pqnum
                         }
                     }
                 }
-            } else {
-                outfile->Printf("LIBDPD: Out-of-core algorithm not yet coded for qrps sort.\n");
-                dpd_error("buf4_sort", "outfile");
             }
 
 #ifdef DPD_TIMER
@@ -1224,6 +671,7 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index, int pqnum
                             Gsp = Gs ^ Gp;
                             Gqr = Gq ^ Gr;
 
+#pragma omp parallel for DPD_SORT_PRIVATE if (threaded)
                             for (p = 0; p < OutBuf.params->ppi[Gp]; p++) {
                                 P = OutBuf.params->poff[Gp] + p;
                                 for (q = 0; q < OutBuf.params->qpi[Gq]; q++) {
@@ -1247,9 +695,6 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index, int pqnum
                         }
                     }
                 }
-            } else {
-                outfile->Printf("LIBDPD: Out-of-core algorithm not yet coded for qrsp sort.\n");
-                dpd_error("buf4_sort", "outfile");
             }
 
 #ifdef DPD_TIMER
@@ -1276,6 +721,7 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index, int pqnum
                             Grp = Gr ^ Gp;
                             Gsq = Gs ^ Gq;
 
+#pragma omp parallel for DPD_SORT_PRIVATE if (threaded)
                             for (p = 0; p < OutBuf.params->ppi[Gp]; p++) {
                                 P = OutBuf.params->poff[Gp] + p;
                                 for (q = 0; q < OutBuf.params->qpi[Gq]; q++) {
@@ -1299,9 +745,6 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index, int pqnum
                         }
                     }
                 }
-            } else {
-                outfile->Printf("LIBDPD: Out-of-core algorithm not yet coded for qspr sort.\n");
-                dpd_error("buf4_sort", "outfile");
             }
 
 #ifdef DPD_TIMER
@@ -1328,6 +771,7 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index, int pqnum
                             Gsp = Gs ^ Gp;
                             Grq = Gr ^ Gq;
 
+#pragma omp parallel for DPD_SORT_PRIVATE if (threaded)
                             for (p = 0; p < OutBuf.params->ppi[Gp]; p++) {
                                 P = OutBuf.params->poff[Gp] + p;
                                 for (q = 0; q < OutBuf.params->qpi[Gq]; q++) {
@@ -1351,9 +795,6 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index, int pqnum
                         }
                     }
                 }
-            } else {
-                outfile->Printf("LIBDPD: Out-of-core algorithm not yet coded for qsrp sort.\n");
-                dpd_error("buf4_sort", "outfile");
             }
 
 #ifdef DPD_TIMER
@@ -1381,6 +822,7 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index, int pqnum
                             Grq = Gr ^ Gq;
                             Gps = Gp ^ Gs;
 
+#pragma omp parallel for DPD_SORT_PRIVATE if (threaded)
                             for (p = 0; p < OutBuf.params->ppi[Gp]; p++) {
                                 P = OutBuf.params->poff[Gp] + p;
                                 for (q = 0; q < OutBuf.params->qpi[Gq]; q++) {
@@ -1404,9 +846,6 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index, int pqnum
                         }
                     }
                 }
-            } else {
-                outfile->Printf("LIBDPD: Out-of-core algorithm not yet coded for rqps sort.\n");
-                dpd_error("buf4_sort", "outfile");
             }
 
 #ifdef DPD_TIMER
@@ -1434,6 +873,7 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index, int pqnum
                             Gsq = Gs ^ Gq;
                             Gpr = Gp ^ Gr;
 
+#pragma omp parallel for DPD_SORT_PRIVATE if (threaded)
                             for (p = 0; p < OutBuf.params->ppi[Gp]; p++) {
                                 P = OutBuf.params->poff[Gp] + p;
                                 for (q = 0; q < OutBuf.params->qpi[Gq]; q++) {
@@ -1457,9 +897,6 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index, int pqnum
                         }
                     }
                 }
-            } else {
-                outfile->Printf("LIBDPD: Out-of-core algorithm not yet coded for rqsp sort.\n");
-                dpd_error("buf4_sort", "outfile");
             }
 
 #ifdef DPD_TIMER
@@ -1487,6 +924,7 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index, int pqnum
                             Gqr = Gq ^ Gr;
                             Gps = Gp ^ Gs;
 
+#pragma omp parallel for DPD_SORT_PRIVATE if (threaded)
                             for (p = 0; p < OutBuf.params->ppi[Gp]; p++) {
                                 P = OutBuf.params->poff[Gp] + p;
                                 for (q = 0; q < OutBuf.params->qpi[Gq]; q++) {
@@ -1510,9 +948,6 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index, int pqnum
                         }
                     }
                 }
-            } else {
-                outfile->Printf("LIBDPD: Out-of-core algorithm not yet coded for rpqs sort.\n");
-                dpd_error("buf4_sort", "outfile");
             }
 
 #ifdef DPD_TIMER
@@ -1540,6 +975,7 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index, int pqnum
                             Gqs = Gq ^ Gs;
                             Gpr = Gp ^ Gr;
 
+#pragma omp parallel for DPD_SORT_PRIVATE if (threaded)
                             for (p = 0; p < OutBuf.params->ppi[Gp]; p++) {
                                 P = OutBuf.params->poff[Gp] + p;
                                 for (q = 0; q < OutBuf.params->qpi[Gq]; q++) {
@@ -1563,9 +999,6 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index, int pqnum
                         }
                     }
                 }
-            } else {
-                outfile->Printf("LIBDPD: Out-of-core algorithm not yet coded for rpsq sort.\n");
-                dpd_error("buf4_sort", "outfile");
             }
 
 #ifdef DPD_TIMER
@@ -1585,6 +1018,7 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index, int pqnum
                 for (h = 0; h < nirreps; h++) {
                     r_irrep = h ^ my_irrep;
 
+#pragma omp parallel for DPD_SORT_PRIVATE if (threaded)
                     for (pq = 0; pq < OutBuf.params->rowtot[h]; pq++) {
                         p = OutBuf.params->roworb[h][pq][0];
                         q = OutBuf.params->roworb[h][pq][1];
@@ -1601,9 +1035,6 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index, int pqnum
                         }
                     }
                 }
-            } else {
-                outfile->Printf("LIBDPD: Out-of-core algorithm not yet coded for rsqp sort.\n");
-                dpd_error("buf4_sort", "outfile");
             }
 
 #ifdef DPD_TIMER
@@ -1623,6 +1054,7 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index, int pqnum
                 for (h = 0; h < nirreps; h++) {
                     r_irrep = h ^ my_irrep;
 
+#pragma omp parallel for DPD_SORT_PRIVATE if (threaded)
                     for (pq = 0; pq < OutBuf.params->rowtot[h]; pq++) {
                         p = OutBuf.params->roworb[h][pq][0];
                         q = OutBuf.params->roworb[h][pq][1];
@@ -1639,73 +1071,6 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index, int pqnum
                         }
                     }
                 }
-            } else {
-                for (Gpq = 0; Gpq < nirreps; Gpq++) {
-                    Grs = Gpq ^ my_irrep;
-
-                    out_rows_per_bucket =
-                        (dpd_memfree() - OutBuf.params->coltot[Grs]) / (2 * OutBuf.params->coltot[Grs]);
-                    if (out_rows_per_bucket > OutBuf.params->rowtot[Gpq])
-                        out_rows_per_bucket = OutBuf.params->rowtot[Gpq];
-                    out_nbuckets = (int)ceil((double)OutBuf.params->rowtot[Gpq] / (double)out_rows_per_bucket);
-                    if (out_nbuckets == 1)
-                        out_rows_left = out_rows_per_bucket;
-                    else
-                        out_rows_left = OutBuf.params->rowtot[Gpq] % out_rows_per_bucket;
-
-                    in_rows_per_bucket =
-                        (dpd_memfree() - InBuf->params->coltot[Gpq]) / (2 * InBuf->params->coltot[Gpq]);
-                    if (in_rows_per_bucket > InBuf->params->rowtot[Grs])
-                        in_rows_per_bucket = InBuf->params->rowtot[Grs];
-                    in_nbuckets = (int)ceil((double)InBuf->params->rowtot[Grs] / (double)in_rows_per_bucket);
-                    if (in_nbuckets == 1)
-                        in_rows_left = in_rows_per_bucket;
-                    else
-                        in_rows_left = InBuf->params->rowtot[Grs] % in_rows_per_bucket;
-
-#ifdef DPD_DEBUG
-                    outfile->Printf(stdout, "Gpq = %d\n", Gpq);
-                    outfile->Printf(stdout, "OutBuf.rowtot[Gpq]  = %d\n", OutBuf.params->rowtot[Gpq]);
-                    outfile->Printf(stdout, "OutBuf.coltot[Grs]  = %d\n", OutBuf.params->coltot[Grs]);
-                    outfile->Printf(stdout, "out_nbuckets        = %d\n", out_nbuckets);
-                    outfile->Printf(stdout, "out_rows_per_bucket = %d\n", out_rows_per_bucket);
-                    outfile->Printf(stdout, "out_rows_left       = %d\n", out_rows_left);
-                    outfile->Printf(stdout, "InBuf.rowtot[Grs]   = %d\n", InBuf->params->rowtot[Grs]);
-                    outfile->Printf(stdout, "InBuf.coltot[Gpq]   = %d\n", InBuf->params->coltot[Gpq]);
-                    outfile->Printf(stdout, "in_nbuckets         = %d\n", in_nbuckets);
-                    outfile->Printf(stdout, "in_rows_per_bucket  = %d\n", in_rows_per_bucket);
-                    outfile->Printf(stdout, "in_rows_left        = %d\n", in_rows_left);
-                    fflush(stdout);
-#endif
-
-                    buf4_mat_irrep_init_block(&OutBuf, Gpq, out_rows_per_bucket);
-                    buf4_mat_irrep_init_block(InBuf, Grs, in_rows_per_bucket);
-
-                    for (n = 0; n < out_nbuckets; n++) {
-                        out_row_start = n * out_rows_per_bucket;
-
-                        for (m = 0; m < in_nbuckets; m++) {
-                            in_row_start = m * in_rows_per_bucket;
-                            buf4_mat_irrep_rd_block(InBuf, Grs, in_row_start,
-                                                    (m == in_nbuckets - 1 ? in_rows_left : in_rows_per_bucket));
-
-                            for (pq = 0; pq < (n == out_nbuckets - 1 ? out_rows_left : out_rows_per_bucket); pq++) {
-                                PQ = pq + n * out_rows_per_bucket;
-                                for (RS = 0; RS < (m == in_nbuckets - 1 ? in_rows_left : in_rows_per_bucket); RS++) {
-                                    rs = RS + m * in_rows_per_bucket;
-                                    OutBuf.matrix[Gpq][pq][rs] = InBuf->matrix[Grs][RS][PQ];
-                                }
-                            }
-                        }
-
-                        buf4_mat_irrep_wrt_block(&OutBuf, Gpq, out_row_start,
-                                                 (n == out_nbuckets - 1 ? out_rows_left : out_rows_per_bucket));
-                    }
-
-                    buf4_mat_irrep_close_block(&OutBuf, Gpq, out_rows_per_bucket);
-                    buf4_mat_irrep_close_block(InBuf, Grs, in_rows_per_bucket);
-
-                } /* Gpq */
             }
 
 #ifdef DPD_TIMER
@@ -1733,6 +1098,7 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index, int pqnum
                             Gsq = Gs ^ Gq;
                             Grp = Gr ^ Gp;
 
+#pragma omp parallel for DPD_SORT_PRIVATE if (threaded)
                             for (p = 0; p < OutBuf.params->ppi[Gp]; p++) {
                                 P = OutBuf.params->poff[Gp] + p;
                                 for (q = 0; q < OutBuf.params->qpi[Gq]; q++) {
@@ -1756,9 +1122,6 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index, int pqnum
                         }
                     }
                 }
-            } else {
-                outfile->Printf("LIBDPD: Out-of-core algorithm not yet coded for sqrp sort.\n");
-                dpd_error("buf4_sort", "outfile");
             }
 
 #ifdef DPD_TIMER
@@ -1766,11 +1129,6 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index, int pqnum
 #endif
             break;
 
-        case sqpr:
-            outfile->Printf("\nDPD sort error: sqpr index ordering not yet coded.\n");
-            dpd_error("buf_sort", "outfile");
-            break;
-
         case srqp:
 
 #ifdef DPD_TIMER
@@ -1783,6 +1141,7 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index, int pqnum
                 for (h = 0; h < nirreps; h++) {
                     r_irrep = h ^ my_irrep;
 
+#pragma omp parallel for DPD_SORT_PRIVATE if (threaded)
                     for (pq = 0; pq < OutBuf.params->rowtot[h]; pq++) {
                         p = OutBuf.params->roworb[h][pq][0];
                         q = OutBuf.params->roworb[h][pq][1];
@@ -1799,9 +1158,6 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index, int pqnum
                         }
                     }
                 }
-            } else {
-                outfile->Printf("LIBDPD: Out-of-core algorithm not yet coded for srqp sort.\n");
-                dpd_error("buf4_sort", "outfile");
             }
 
 #ifdef DPD_TIMER
@@ -1820,6 +1176,7 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index, int pqnum
                 for (h = 0; h < nirreps; h++) {
                     r_irrep = h ^ my_irrep;
 
+#pragma omp parallel for DPD_SORT_PRIVATE if (threaded)
                     for (pq = 0; pq < OutBuf.params->rowtot[h]; pq++) {
                         p = OutBuf.params->roworb[h][pq][0];
                         q = OutBuf.params->roworb[h][pq][1];
@@ -1836,9 +1193,6 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index, int pqnum
                         }
                     }
                 }
-            } else {
-                outfile->Printf("LIBDPD: Out-of-core algorithm not yet coded for srpq sort.\n");
-                dpd_error("buf4_sort", "outfile");
             }
 
 #ifdef DPD_TIMER
@@ -1866,6 +1220,7 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index, int pqnum
                             Gqr = Gq ^ Gr;
                             Gsp = Gs ^ Gp;
 
+#pragma omp parallel for DPD_SORT_PRIVATE if (threaded)
                             for (p = 0; p < OutBuf.params->ppi[Gp]; p++) {
                                 P = OutBuf.params->poff[Gp] + p;
                                 for (q = 0; q < OutBuf.params->qpi[Gq]; q++) {
@@ -1889,9 +1244,6 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index, int pqnum
                         }
                     }
                 }
-            } else {
-                outfile->Printf("LIBDPD: Out-of-core algorithm not yet coded for spqr sort.\n");
-                dpd_error("buf4_sort", "outfile");
             }
 
 #ifdef DPD_TIMER
@@ -1919,6 +1271,7 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index, int pqnum
                             Gqs = Gq ^ Gs;
                             Grp = Gr ^ Gp;
 
+#pragma omp parallel for DPD_SORT_PRIVATE if (threaded)
                             for (p = 0; p < OutBuf.params->ppi[Gp]; p++) {
                                 P = OutBuf.params->poff[Gp] + p;
                                 for (q = 0; q < OutBuf.params->qpi[Gq]; q++) {
@@ -1942,9 +1295,6 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index, int pqnum
                         }
                     }
                 }
-            } else {
-                outfile->Printf("LIBDPD: Out-of-core algorithm not yet coded for sprq sort.\n");
-                dpd_error("buf4_sort", "outfile");
             }
 
 #ifdef DPD_TIMER
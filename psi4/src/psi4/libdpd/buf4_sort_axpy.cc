@@ -43,6 +43,11 @@
 
 namespace psi {
 
+/* Threshold (in elements) and private index list for the threaded in-core loops, as in buf4_sort() */
+#define DPD_SORT_AXPY_MIN_THREADED 262144
+#define DPD_SORT_AXPY_PRIVATE \
+    private(p, q, r, s, P, Q, R, S, pq, rs, sr, pr, qs, qp, rq, qr, ps, sp, rp, sq, row, col)
+
 /*
 ** dpd_buf4_sort_axpy(): A general DPD buffer sorting function that also adds
 ** the result to a target dpdbuf4 that already exists.  Like buf4_sort(), this will
@@ -101,7 +106,7 @@ int DPD::buf4_sort_axpy(dpdbuf4 *InBuf, int outfilenum, enum indices index, int
     int Gp, Gq, Gr, Gs, Gpq, Grs, Gsr, Gpr, Gqs, Grq, Gqr, Gps, Gsp, Grp, Gsq;
     dpdbuf4 OutBuf;
     long int rowtot, coltot, core_total, maxrows;
-    int incore;
+    int incore, threaded;
     int Grow, Gcol;
     int out_rows_per_bucket, out_nbuckets, out_rows_left, out_row_start, n;
     int in_rows_per_bucket, in_nbuckets, in_rows_left, in_row_start, m;
@@ -140,6 +145,7 @@ int DPD::buf4_sort_axpy(dpdbuf4 *InBuf, int outfilenum, enum indices index, int
         core_total += 2 * rowtot * coltot;
     }
     if (core_total > dpd_memfree()) incore = 0;
+    threaded = (core_total / 2 > DPD_SORT_AXPY_MIN_THREADED);
 
 /* Init input and output buffers and read in all blocks of both */
 #ifdef DPD_TIMER
@@ -176,6 +182,7 @@ int DPD::buf4_sort_axpy(dpdbuf4 *InBuf, int outfilenum, enum indices index, int
 
                     /* p->p; q->q; s->r; r->s = pqsr */
 
+#pragma omp parallel for DPD_SORT_AXPY_PRIVATE if (threaded)
                     for (pq = 0; pq < OutBuf.params->rowtot[h]; pq++) {
                         p = OutBuf.params->roworb[h][pq][0];
                         q = OutBuf.params->roworb[h][pq][1];
@@ -269,6 +276,7 @@ int DPD::buf4_sort_axpy(dpdbuf4 *InBuf, int outfilenum, enum indices index, int
                             Gpr = Gp ^ Gr;
                             Gqs = Gq ^ Gs;
 
+#pragma omp parallel for DPD_SORT_AXPY_PRIVATE if (threaded)
                             for (p = 0; p < OutBuf.params->ppi[Gp]; p++) {
                                 P = OutBuf.params->poff[Gp] + p;
                                 for (q = 0; q < OutBuf.params->qpi[Gq]; q++) {
@@ -494,6 +502,7 @@ int DPD::buf4_sort_axpy(dpdbuf4 *InBuf, int outfilenum, enum indices index, int
                             Gps = Gp ^ Gs;
                             Gqr = Gq ^ Gr;
 
+#pragma omp parallel for DPD_SORT_AXPY_PRIVATE if (threaded)
                             for (p = 0; p < OutBuf.params->ppi[Gp]; p++) {
                                 P = OutBuf.params->poff[Gp] + p;
                                 for (q = 0; q < OutBuf.params->qpi[Gq]; q++) {
@@ -719,6 +728,7 @@ int DPD::buf4_sort_axpy(dpdbuf4 *InBuf, int outfilenum, enum indices index, int
                             Gpr = Gp ^ Gr;
                             Gsq = Gs ^ Gq;
 
+#pragma omp parallel for DPD_SORT_AXPY_PRIVATE if (threaded)
                             for (p = 0; p < OutBuf.params->ppi[Gp]; p++) {
                                 P = OutBuf.params->poff[Gp] + p;
                                 for (q = 0; q < OutBuf.params->qpi[Gq]; q++) {
@@ -772,6 +782,7 @@ int DPD::buf4_sort_axpy(dpdbuf4 *InBuf, int outfilenum, enum indices index, int
                             Gps = Gp ^ Gs;
                             Grq = Gr ^ Gq;
 
+#pragma omp parallel for DPD_SORT_AXPY_PRIVATE if (threaded)
                             for (p = 0; p < OutBuf.params->ppi[Gp]; p++) {
                                 P = OutBuf.params->poff[Gp] + p;
                                 for (q = 0; q < OutBuf.params->qpi[Gq]; q++) {
@@ -817,6 +828,7 @@ int DPD::buf4_sort_axpy(dpdbuf4 *InBuf, int outfilenum, enum indices index, int
                 for (h = 0; h < nirreps; h++) {
                     r_irrep = h ^ my_irrep;
 
+#pragma omp parallel for DPD_SORT_AXPY_PRIVATE if (threaded)
                     for (pq = 0; pq < OutBuf.params->rowtot[h]; pq++) {
                         p = OutBuf.params->roworb[h][pq][0];
                         q = OutBuf.params->roworb[h][pq][1];
@@ -854,6 +866,7 @@ int DPD::buf4_sort_axpy(dpdbuf4 *InBuf, int outfilenum, enum indices index, int
                 for (h = 0; h < nirreps; h++) {
                     r_irrep = h ^ my_irrep;
 
+#pragma omp parallel for DPD_SORT_AXPY_PRIVATE if (threaded)
                     for (pq = 0; pq < OutBuf.params->rowtot[h]; pq++) {
                         p = OutBuf.params->roworb[h][pq][0];
                         q = OutBuf.params->roworb[h][pq][1];
@@ -897,6 +910,7 @@ int DPD::buf4_sort_axpy(dpdbuf4 *InBuf, int outfilenum, enum indices index, int
                             Grp = Gr ^ Gp;
                             Gqs = Gq ^ Gs;
 
+#pragma omp parallel for DPD_SORT_AXPY_PRIVATE if (threaded)
                             for (p = 0; p < OutBuf.params->ppi[Gp]; p++) {
                                 P = OutBuf.params->poff[Gp] + p;
                                 for (q = 0; q < OutBuf.params->qpi[Gq]; q++) {
@@ -950,6 +964,7 @@ int DPD::buf4_sort_axpy(dpdbuf4 *InBuf, int outfilenum, enum indices index, int
                             Gsp = Gs ^ Gp;
                             Gqr = Gq ^ Gr;
 
+#pragma omp parallel for DPD_SORT_AXPY_PRIVATE if (threaded)
                             for (p = 0; p < OutBuf.params->ppi[Gp]; p++) {
                                 P = OutBuf.params->poff[Gp] + p;
                                 for (q = 0; q < OutBuf.params->qpi[Gq]; q++) {
@@ -1013,6 +1028,7 @@ int DPD::buf4_sort_axpy(dpdbuf4 *InBuf, int outfilenum, enum indices index, int
                             Grq = Gr ^ Gq;
                             Gps = Gp ^ Gs;
 
+#pragma omp parallel for DPD_SORT_AXPY_PRIVATE if (threaded)
                             for (p = 0; p < OutBuf.params->ppi[Gp]; p++) {
                                 P = OutBuf.params->poff[Gp] + p;
                                 for (q = 0; q < OutBuf.params->qpi[Gq]; q++) {
@@ -1066,6 +1082,7 @@ int DPD::buf4_sort_axpy(dpdbuf4 *InBuf, int outfilenum, enum indices index, int
                             Gsq = Gs ^ Gq;
                             Gpr = Gp ^ Gr;
 
+#pragma omp parallel for DPD_SORT_AXPY_PRIVATE if (threaded)
                             for (p = 0; p < OutBuf.params->ppi[Gp]; p++) {
                                 P = OutBuf.params->poff[Gp] + p;
                                 for (q = 0; q < OutBuf.params->qpi[Gq]; q++) {
@@ -1119,6 +1136,7 @@ int DPD::buf4_sort_axpy(dpdbuf4 *InBuf, int outfilenum, enum indices index, int
                             Gqr = Gq ^ Gr;
                             Gps = Gp ^ Gs;
 
+#pragma omp parallel for DPD_SORT_AXPY_PRIVATE if (threaded)
                             for (p = 0; p < OutBuf.params->ppi[Gp]; p++) {
                                 P = OutBuf.params->poff[Gp] + p;
                                 for (q = 0; q < OutBuf.params->qpi[Gq]; q++) {
@@ -1344,6 +1362,7 @@ int DPD::buf4_sort_axpy(dpdbuf4 *InBuf, int outfilenum, enum indices index, int
                             Gqs = Gq ^ Gs;
                             Gpr = Gp ^ Gr;
 
+#pragma omp parallel for DPD_SORT_AXPY_PRIVATE if (threaded)
                             for (p = 0; p < OutBuf.params->ppi[Gp]; p++) {
                                 P = OutBuf.params->poff[Gp] + p;
                                 for (q = 0; q < OutBuf.params->qpi[Gq]; q++) {
@@ -1561,6 +1580,7 @@ int DPD::buf4_sort_axpy(dpdbuf4 *InBuf, int outfilenum, enum indices index, int
                 for (h = 0; h < nirreps; h++) {
                     r_irrep = h ^ my_irrep;
 
+#pragma omp parallel for DPD_SORT_AXPY_PRIVATE if (threaded)
                     for (pq = 0; pq < OutBuf.params->rowtot[h]; pq++) {
                         p = OutBuf.params->roworb[h][pq][0];
                         q = OutBuf.params->roworb[h][pq][1];
@@ -1603,6 +1623,7 @@ int DPD::buf4_sort_axpy(dpdbuf4 *InBuf, int outfilenum, enum indices index, int
                 for (h = 0; h < nirreps; h++) {
                     r_irrep = h ^ my_irrep;
 
+#pragma omp parallel for DPD_SORT_AXPY_PRIVATE if (threaded)
                     for (pq = 0; pq < OutBuf.params->rowtot[h]; pq++) {
                         p = OutBuf.params->roworb[h][pq][0];
                         q = OutBuf.params->roworb[h][pq][1];
@@ -1745,6 +1766,7 @@ int DPD::buf4_sort_axpy(dpdbuf4 *InBuf, int outfilenum, enum indices index, int
                             Gsq = Gs ^ Gq;
                             Grp = Gr ^ Gp;
 
+#pragma omp parallel for DPD_SORT_AXPY_PRIVATE if (threaded)
                             for (p = 0; p < OutBuf.params->ppi[Gp]; p++) {
                                 P = OutBuf.params->poff[Gp] + p;
                                 for (q = 0; q < OutBuf.params->qpi[Gq]; q++) {
@@ -1793,6 +1815,7 @@ int DPD::buf4_sort_axpy(dpdbuf4 *InBuf, int outfilenum, enum indices index, int
                 for (h = 0; h < nirreps; h++) {
                     r_irrep = h ^ my_irrep;
 
+#pragma omp parallel for DPD_SORT_AXPY_PRIVATE if (threaded)
                     for (pq = 0; pq < OutBuf.params->rowtot[h]; pq++) {
                         p = OutBuf.params->roworb[h][pq][0];
                         q = OutBuf.params->roworb[h][pq][1];
@@ -1950,6 +1973,7 @@ int DPD::buf4_sort_axpy(dpdbuf4 *InBuf, int outfilenum, enum indices index, int
                 for (h = 0; h < nirreps; h++) {
                     r_irrep = h ^ my_irrep;
 
+#pragma omp parallel for DPD_SORT_AXPY_PRIVATE if (threaded)
                     for (pq = 0; pq < OutBuf.params->rowtot[h]; pq++) {
                         p = OutBuf.params->roworb[h][pq][0];
                         q = OutBuf.params->roworb[h][pq][1];
@@ -1994,6 +2018,7 @@ int DPD::buf4_sort_axpy(dpdbuf4 *InBuf, int outfilenum, enum indices index, int
                             Gqr = Gq ^ Gr;
                             Gsp = Gs ^ Gp;
 
+#pragma omp parallel for DPD_SORT_AXPY_PRIVATE if (threaded)
                             for (p = 0; p < OutBuf.params->ppi[Gp]; p++) {
                                 P = OutBuf.params->poff[Gp] + p;
                                 for (q = 0; q < OutBuf.params->qpi[Gq]; q++) {
@@ -2045,6 +2070,7 @@ int DPD::buf4_sort_axpy(dpdbuf4 *InBuf, int outfilenum, enum indices index, int
                             Gqs = Gq ^ Gs;
                             Grp = Gr ^ Gp;
 
+#pragma omp parallel for DPD_SORT_AXPY_PRIVATE if (threaded)
                             for (p = 0; p < OutBuf.params->ppi[Gp]; p++) {
                                 P = OutBuf.params->poff[Gp] + p;
                                 for (q = 0; q < OutBuf.params->qpi[Gq]; q++) {
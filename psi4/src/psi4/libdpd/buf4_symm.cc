@@ -56,8 +56,10 @@ int DPD::buf4_symm(dpdbuf4 *Buf) {
         buf4_mat_irrep_init(Buf, h);
         buf4_mat_irrep_rd(Buf, h);
 
+        /* Each (row,col) pair is visited once, so the rows can be handed out to threads */
+#pragma omp parallel for private(col, value) schedule(dynamic)
         for (row = 0; row < Buf->params->rowtot[h]; row++)
-            for (col = 0; col < Buf->params->coltot[h ^ all_buf_irrep]; col++) {
+            for (col = row + 1; col < Buf->params->coltot[h ^ all_buf_irrep]; col++) {
                 value = 0.5 * (Buf->matrix[h][row][col] + Buf->matrix[h][col][row]);
                 Buf->matrix[h][row][col] = Buf->matrix[h][col][row] = value;
             }
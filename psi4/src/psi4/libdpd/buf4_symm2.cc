@@ -60,6 +60,7 @@ int DPD::buf4_symm2(dpdbuf4 *Buf1, dpdbuf4 *Buf2) {
         buf4_mat_irrep_init(Buf2, h);
         buf4_mat_irrep_rd(Buf2, h);
 
+#pragma omp parallel for private(col, value)
         for (row = 0; row < Buf1->params->rowtot[h]; row++)
             for (col = 0; col < Buf1->params->coltot[h ^ all_buf_irrep]; col++) {
                 value = 0.5 * (Buf1->matrix[h][row][col] + Buf2->matrix[h][col][row]);
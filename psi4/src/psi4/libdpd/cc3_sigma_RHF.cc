@@ -79,6 +79,7 @@ void DPD::cc3_sigma_RHF(dpdbuf4 *CIjAb, dpdbuf4 *WAbEi, dpdbuf4 *WMbIj, int do_s
     dpdbuf4 SIjAb_inc, buf4_tmp;
     double ***W3, ***W3a;
     double ***W, ***V, ***Wa, ***Va;
+    double ***FI, ***FJ;
 
     nirreps = CIjAb->params->nirreps;
 
@@ -169,8 +170,10 @@ void DPD::cc3_sigma_RHF(dpdbuf4 *CIjAb, dpdbuf4 *WAbEi, dpdbuf4 *WMbIj, int do_s
 
                 for (i = 0; i < occpi[Gi]; i++) {
                     I = occ_off[Gi] + i;
+                    FI = T3_RHF_F_rows(WAbEi, I, Gi, virtpi);
                     for (j = 0; j < occpi[Gj]; j++) {
                         J = occ_off[Gj] + j;
+                        FJ = T3_RHF_F_rows(WAbEi, J, Gj, virtpi);
                         for (k = 0; k < occpi[Gk]; k++) {
                             K = occ_off[Gk] + k;
 
@@ -184,7 +187,7 @@ void DPD::cc3_sigma_RHF(dpdbuf4 *CIjAb, dpdbuf4 *WAbEi, dpdbuf4 *WMbIj, int do_s
                             timer_on("T3_RHF");
 #endif
                             T3_RHF(W3, nirreps, I, Gi, J, Gj, K, Gk, CIjAb, WAbEi, WMbIj, &fIJ2, &fAB2, occpi, occ_off,
-                                   virtpi, vir_off, omega);
+                                   virtpi, vir_off, omega, FI, FJ);
 #ifdef T3_TIMER_ON
                             timer_off("T3_RHF");
 #endif
@@ -671,8 +674,10 @@ void DPD::cc3_sigma_RHF(dpdbuf4 *CIjAb, dpdbuf4 *WAbEi, dpdbuf4 *WMbIj, int do_s
 #endif
                             } /* end Wamef*X3->Sijab contributions */
                         }     /* k */
-                    }         /* j */
-                }             /* i */
+                        T3_RHF_F_rows_free(FJ, WAbEi, Gj, virtpi);
+                    } /* j */
+                    T3_RHF_F_rows_free(FI, WAbEi, Gi, virtpi);
+                } /* i */
 
                 for (Gab = 0; Gab < nirreps; Gab++) {
                     Gc = Gab ^ Gijk ^ GX3;
@@ -34,6 +34,8 @@
 #include <cstdlib>
 #include <cstring>
 #include <cmath>
+#include <array>
+#include <vector>
 #ifdef _OPENMP
 #include <omp.h>
 #endif
@@ -44,10 +46,7 @@
 #include "dpd.h"
 #include "psi4/psi4-dec.h"
 #include "psi4/libpsi4util/PsiOutStream.h"
-// MKL Header
-#ifdef USING_LAPACK_MKL
-#include <mkl.h>
-#endif
+#include "psi4/libpsi4util/threading.h"
 
 namespace psi {
 
@@ -70,7 +69,7 @@ void DPD::cc3_sigma_RHF_ic(dpdbuf4 *CIjAb, dpdbuf4 *WAbEi, dpdbuf4 *WMbIj, int d
                            int *occpi, int *occ_off, int *virtpi, int *vir_off, double omega, std::string out,
                            int nthreads, int newtrips) {
     std::shared_ptr<psi::PsiOutStream> printer = (out == "outfile" ? outfile : std::make_shared<PsiOutStream>(out));
-    int h, nirreps, thread, nijk, *ijk_part;
+    int h, nirreps, thread;
     int Gi, Gj, Gk, Gl, Ga, Gb, Gc, Gd;
     int i, j, k, l, a, b, c, d, row, col;
     int I, J, K, L, A, B, C, D;
@@ -93,11 +92,6 @@ void DPD::cc3_sigma_RHF_ic(dpdbuf4 *CIjAb, dpdbuf4 *WAbEi, dpdbuf4 *WMbIj, int d
 
     std::vector<thread_data> thread_data_array(nthreads);
 
-#ifdef USING_LAPACK_MKL
-    int old_threads = mkl_get_max_threads();
-    mkl_set_num_threads(1);
-#endif
-
     nirreps = CIjAb->params->nirreps;
     /* these are sent to T3 function */
     file2_init(&fIJ, PSIF_CC_OEI, 0, 0, 0, "fIJ");
@@ -191,74 +185,67 @@ void DPD::cc3_sigma_RHF_ic(dpdbuf4 *CIjAb, dpdbuf4 *WAbEi, dpdbuf4 *WMbIj, int d
         thread_data_array[thread].newtrips = newtrips;
     }
 
-    ijk_part = new int[nthreads];
+    /* zero the per-thread S's; they are summed into S once, after all (ijk) */
+    for (thread = 0; thread < nthreads; ++thread) {
+        if (do_singles) {
+            for (h = 0; h < nirreps; ++h)
+                zero_mat(SIA_local[thread].matrix[h], SIA_local[thread].params->rowtot[h],
+                         SIA_local[thread].params->coltot[h ^ GS]);
+        }
+        if (do_doubles) {
+            for (h = 0; h < nirreps; ++h)
+                zero_mat(SIjAb_local[thread].matrix[h], SIjAb_local[thread].params->rowtot[h],
+                         SIjAb_local[thread].params->coltot[h ^ GS]);
+        }
+    }
 
-    for (Gi = 0; Gi < nirreps; Gi++) {
-        for (Gj = 0; Gj < nirreps; Gj++) {
-            Gij = Gji = Gi ^ Gj;
+    /* one task per (Gi,Gj,Gk,i): the block of all (jk) for a given i, dealt out dynamically */
+    std::vector<std::array<int, 4>> ijk_blocks;
+    for (Gi = 0; Gi < nirreps; Gi++)
+        for (Gj = 0; Gj < nirreps; Gj++)
             for (Gk = 0; Gk < nirreps; Gk++) {
-                Gkj = Gjk = Gk ^ Gj;
-                Gik = Gki = Gi ^ Gk;
-                Gijk = Gi ^ Gj ^ Gk;
-
-                nijk = occpi[Gi] * occpi[Gj] * occpi[Gk];
-                if (nijk == 0) continue;
-
-                for (thread = 0; thread < nthreads; ++thread) {
-                    thread_data_array[thread].Gi = Gi;
-                    thread_data_array[thread].Gj = Gj;
-                    thread_data_array[thread].Gk = Gk;
-                    ijk_part[thread] = nijk / nthreads;
-                    if (thread < (nijk % nthreads)) ++ijk_part[thread];
-                    if (do_singles) { /* zero S's */
-                        for (h = 0; h < nirreps; ++h)
-                            zero_mat(SIA_local[thread].matrix[h], SIA_local[thread].params->rowtot[h],
-                                     SIA_local[thread].params->coltot[h ^ GS]);
-                    }
-                    if (do_doubles) {
-                        for (h = 0; h < nirreps; ++h)
-                            zero_mat(SIjAb_local[thread].matrix[h], SIjAb_local[thread].params->rowtot[h],
-                                     SIjAb_local[thread].params->coltot[h ^ GS]);
-                    }
-                }
-
-                cnt = 0;
-                for (thread = 0; thread < nthreads; ++thread) {
-                    if (!ijk_part[thread]) continue;  // there are more threads than nijk
-                    thread_data_array[thread].first_ijk = cnt;
-                    cnt += ijk_part[thread];
-                    thread_data_array[thread].last_ijk = cnt - 1;
-                }
+                if (!occpi[Gj] || !occpi[Gk]) continue;
+                for (i = 0; i < occpi[Gi]; i++) ijk_blocks.push_back({Gi, Gj, Gk, i});
+            }
 
 /* execute threads */
 #pragma omp parallel num_threads(nthreads)
-                {
-                    int ithread = 0;
+    {
+        // Don't parallelize BLAS if explicit threads are used
+        BlasThreadsGuard blas_threads(1);
+        int ithread = 0;
 #ifdef _OPENMP
-                    ithread = omp_get_thread_num();
+        ithread = omp_get_thread_num();
 #endif
-                    if (ijk_part[ithread]) cc3_sigma_RHF_ic_thread(thread_data_array[ithread]);
-                }
+        thread_data &data = thread_data_array[ithread];
+
+#pragma omp for schedule(dynamic)
+        for (size_t block = 0; block < ijk_blocks.size(); ++block) {
+            int njk = occpi[ijk_blocks[block][1]] * occpi[ijk_blocks[block][2]];
+            data.Gi = ijk_blocks[block][0];
+            data.Gj = ijk_blocks[block][1];
+            data.Gk = ijk_blocks[block][2];
+            data.first_ijk = ijk_blocks[block][3] * njk;
+            data.last_ijk = data.first_ijk + njk - 1;
+            cc3_sigma_RHF_ic_thread(data);
+        }
+    }
 
-                for (thread = 0; thread < nthreads; ++thread) {
-                    if (do_singles) {
-                        for (h = 0; h < nirreps; ++h)
-                            for (row = 0; row < SIA->params->rowtot[h]; row++)
-                                for (col = 0; col < SIA->params->coltot[h ^ GS]; col++)
-                                    SIA->matrix[h][row][col] += SIA_local[thread].matrix[h][row][col];
-                    }
-                    if (do_doubles) {
-                        for (h = 0; h < nirreps; ++h) {
-                            length = ((long)SIjAb->params->rowtot[h]) * ((long)SIjAb->params->coltot[h ^ GS]);
-                            if (length)
-                                C_DAXPY(length, 1.0, &(SIjAb_local[thread].matrix[h][0][0]), 1,
-                                        &(SIjAb->matrix[h][0][0]), 1);
-                        }
-                    }
-                } /* end adding up S's */
-            }     /* Gk */
-        }         /* Gj */
-    }             /* Gi */
+    for (thread = 0; thread < nthreads; ++thread) {
+        if (do_singles) {
+            for (h = 0; h < nirreps; ++h)
+                for (row = 0; row < SIA->params->rowtot[h]; row++)
+                    for (col = 0; col < SIA->params->coltot[h ^ GS]; col++)
+                        SIA->matrix[h][row][col] += SIA_local[thread].matrix[h][row][col];
+        }
+        if (do_doubles) {
+            for (h = 0; h < nirreps; ++h) {
+                length = ((long)SIjAb->params->rowtot[h]) * ((long)SIjAb->params->coltot[h ^ GS]);
+                if (length)
+                    C_DAXPY(length, 1.0, &(SIjAb_local[thread].matrix[h][0][0]), 1, &(SIjAb->matrix[h][0][0]), 1);
+            }
+        }
+    } /* end adding up S's */
 
     /* close up files and update sigma vectors */
     file2_mat_close(&fIJ);
@@ -279,7 +266,6 @@ void DPD::cc3_sigma_RHF_ic(dpdbuf4 *CIjAb, dpdbuf4 *WAbEi, dpdbuf4 *WMbIj, int d
             buf4_close(&(SIjAb_local[i]));
         }
     }
-    delete[] ijk_part;
 
     for (h = 0; h < nirreps; h++) {
         buf4_mat_irrep_close(WAbEi, h);
@@ -300,9 +286,6 @@ void DPD::cc3_sigma_RHF_ic(dpdbuf4 *CIjAb, dpdbuf4 *WAbEi, dpdbuf4 *WMbIj, int d
         }
     }
 
-#ifdef USING_LAPACK_MKL
-    mkl_set_num_threads(old_threads);
-#endif
 }
 
 void cc3_sigma_RHF_ic_thread(thread_data &data) {
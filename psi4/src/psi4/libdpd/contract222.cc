@@ -33,6 +33,7 @@
 #include <cstdio>
 #include <cstdlib>
 #include <cmath>
+#include <vector>
 #include "psi4/libqt/qt.h"
 #include "dpd.h"
 #include "psi4/psi4-dec.h"
@@ -125,6 +126,10 @@ int DPD::contract222(dpdfile2 *X, dpdfile2 *Y, dpdfile2 *Z, int target_X, int ta
     }
 #endif
 
+    /* the irrep blocks are independent, they go to BLAS as one batch */
+    std::vector<int> ms, ns, ks, ldxs, ldys, ldzs;
+    std::vector<double *> xs, ys, zs;
+
     /* loop over row irreps of X */
     for (Hx = 0; Hx < nirreps; Hx++) {
         if ((!Xtrans) && (!Ytrans)) {
@@ -142,10 +147,15 @@ int DPD::contract222(dpdfile2 *X, dpdfile2 *Y, dpdfile2 *Z, int target_X, int ta
         }
 
         if (Z->params->rowtot[Hz] && Z->params->coltot[Hz ^ GZ] && numlinks[Hx ^ symlink]) {
-            C_DGEMM(Xtrans ? 't' : 'n', Ytrans ? 't' : 'n', Z->params->rowtot[Hz], Z->params->coltot[Hz ^ GZ],
-                    numlinks[Hx ^ symlink], alpha, &(X->matrix[Hx][0][0]), X->params->coltot[Hx ^ GX],
-                    &(Y->matrix[Hy][0][0]), Y->params->coltot[Hy ^ GY], beta, &(Z->matrix[Hz][0][0]),
-                    Z->params->coltot[Hz ^ GZ]);
+            ms.push_back(Z->params->rowtot[Hz]);
+            ns.push_back(Z->params->coltot[Hz ^ GZ]);
+            ks.push_back(numlinks[Hx ^ symlink]);
+            xs.push_back(&(X->matrix[Hx][0][0]));
+            ys.push_back(&(Y->matrix[Hy][0][0]));
+            zs.push_back(&(Z->matrix[Hz][0][0]));
+            ldxs.push_back(X->params->coltot[Hx ^ GX]);
+            ldys.push_back(Y->params->coltot[Hy ^ GY]);
+            ldzs.push_back(Z->params->coltot[Hz ^ GZ]);
         }
         /*
     newmm(X->matrix[Hx], Xtrans, Y->matrix[Hy], Ytrans, Z->matrix[Hz],
@@ -154,6 +164,9 @@ int DPD::contract222(dpdfile2 *X, dpdfile2 *Y, dpdfile2 *Z, int target_X, int ta
     */
     }
 
+    C_DGEMM_BATCH(Xtrans ? 't' : 'n', Ytrans ? 't' : 'n', ms.size(), ms.data(), ns.data(), ks.data(), alpha,
+                  xs.data(), ldxs.data(), ys.data(), ldys.data(), beta, zs.data(), ldzs.data());
+
     file2_mat_wrt(Z);
     file2_mat_close(X);
     file2_mat_close(Y);
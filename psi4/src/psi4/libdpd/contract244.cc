@@ -299,7 +299,8 @@ int DPD::contract244(dpdfile2 *X, dpdbuf4 *Y, dpdbuf4 *Z, int sum_X, int sum_Y,
                     newmm_rking(X->matrix[Hx], Xtrans, Ymat[Hy], Ytrans, Zmat[Hz], numrows[Hz], numlinks[Hx ^ symlink],
                                 numcols[Hz], alpha, 1.0);
                 }
-            else
+            else {
+                std::vector<dpd_gemm_task> tasks;
                 for (Hz = 0; Hz < nirreps; Hz++) {
                     if (!Xtrans && !Ytrans) {
                         Hx = Hz;
@@ -327,21 +328,21 @@ int DPD::contract244(dpdfile2 *X, dpdbuf4 *Y, dpdbuf4 *Z, int sum_X, int sum_Y,
 
                     if (numrows[Hz] && numcols[Hz] && numlinks[Hx ^ symlink]) {
                         if (!Xtrans && !Ytrans) {
-                            C_DGEMM('n', 'n', numrows[Hz], numcols[Hz], numlinks[Hx ^ symlink], alpha,
-                                    &(X->matrix[Hx][0][0]), numlinks[Hz ^ symlink], &(Ymat[Hy][0][0]), numcols[Hz], 1.0,
-                                    &(Zmat[Hz][0][0]), numcols[Hz]);
+                            tasks.push_back({'n', 'n', numrows[Hz], numcols[Hz], numlinks[Hx ^ symlink], alpha,
+                                             &(X->matrix[Hx][0][0]), numlinks[Hz ^ symlink], &(Ymat[Hy][0][0]),
+                                             numcols[Hz], 1.0, &(Zmat[Hz][0][0]), numcols[Hz]});
                         } else if (Xtrans && !Ytrans) {
-                            C_DGEMM('t', 'n', numrows[Hz], numcols[Hz], numlinks[Hx ^ symlink], alpha,
-                                    &(X->matrix[Hx][0][0]), numrows[Hz], &(Ymat[Hy][0][0]), numcols[Hz], 1.0,
-                                    &(Zmat[Hz][0][0]), numcols[Hz]);
+                            tasks.push_back({'t', 'n', numrows[Hz], numcols[Hz], numlinks[Hx ^ symlink], alpha,
+                                             &(X->matrix[Hx][0][0]), numrows[Hz], &(Ymat[Hy][0][0]), numcols[Hz], 1.0,
+                                             &(Zmat[Hz][0][0]), numcols[Hz]});
                         } else if (!Xtrans && Ytrans) {
-                            C_DGEMM('n', 't', numrows[Hz], numcols[Hz], numlinks[Hx ^ symlink], alpha,
-                                    &(X->matrix[Hx][0][0]), numlinks[Hx ^ symlink], &(Ymat[Hy][0][0]),
-                                    numlinks[Hx ^ symlink], 1.0, &(Zmat[Hz][0][0]), numcols[Hz]);
+                            tasks.push_back({'n', 't', numrows[Hz], numcols[Hz], numlinks[Hx ^ symlink], alpha,
+                                             &(X->matrix[Hx][0][0]), numlinks[Hx ^ symlink], &(Ymat[Hy][0][0]),
+                                             numlinks[Hx ^ symlink], 1.0, &(Zmat[Hz][0][0]), numcols[Hz]});
                         } else {
-                            C_DGEMM('t', 't', numrows[Hz], numcols[Hz], numlinks[Hx ^ symlink], alpha,
-                                    &(X->matrix[Hx][0][0]), numrows[Hz], &(Ymat[Hy][0][0]), numlinks[Hx ^ symlink], 1.0,
-                                    &(Zmat[Hz][0][0]), numcols[Hz]);
+                            tasks.push_back({'t', 't', numrows[Hz], numcols[Hz], numlinks[Hx ^ symlink], alpha,
+                                             &(X->matrix[Hx][0][0]), numrows[Hz], &(Ymat[Hy][0][0]),
+                                             numlinks[Hx ^ symlink], 1.0, &(Zmat[Hz][0][0]), numcols[Hz]});
                         }
                     }
 
@@ -351,6 +352,8 @@ int DPD::contract244(dpdfile2 *X, dpdbuf4 *Y, dpdbuf4 *Z, int sum_X, int sum_Y,
         numcols[Hz], alpha, 1.0);
       */
                 }
+                dpd_gemm_batch(tasks);
+            }
 
             if (sum_Y == 0)
                 buf4_mat_irrep_close(Y, hybuf);
@@ -285,7 +285,8 @@ int DPD::contract424(dpdbuf4 *X, dpdfile2 *Y, dpdbuf4 *Z, int sum_X, int sum_Y,
                     newmm_rking(Xmat[Hx], Xtrans, Y->matrix[Hy], Ytrans, Zmat[Hz], numrows[Hz], numlinks[Hy ^ symlink],
                                 numcols[Hz], alpha, 1.0);
                 }
-            else
+            else {
+                std::vector<dpd_gemm_task> tasks;
                 for (Hz = 0; Hz < nirreps; Hz++) {
                     if (!Xtrans && !Ytrans) {
                         Hx = Hz;
@@ -309,24 +310,26 @@ int DPD::contract424(dpdbuf4 *X, dpdfile2 *Y, dpdbuf4 *Z, int sum_X, int sum_Y,
 #endif
                     if (numrows[Hz] && numcols[Hz] && numlinks[Hy ^ symlink]) {
                         if (!Xtrans && !Ytrans) {
-                            C_DGEMM('n', 'n', numrows[Hz], numcols[Hz], numlinks[Hy ^ symlink], alpha,
-                                    &(Xmat[Hz][0][0]), numlinks[Hy ^ symlink], &(Y->matrix[Hy][0][0]), numcols[Hz], 1.0,
-                                    &(Zmat[Hz][0][0]), numcols[Hz]);
+                            tasks.push_back({'n', 'n', numrows[Hz], numcols[Hz], numlinks[Hy ^ symlink], alpha,
+                                             &(Xmat[Hz][0][0]), numlinks[Hy ^ symlink], &(Y->matrix[Hy][0][0]),
+                                             numcols[Hz], 1.0, &(Zmat[Hz][0][0]), numcols[Hz]});
                         } else if (Xtrans && !Ytrans) {
-                            C_DGEMM('t', 'n', numrows[Hz], numcols[Hz], numlinks[Hy ^ symlink], alpha,
-                                    &(Xmat[Hz][0][0]), numrows[Hz], &(Y->matrix[Hy][0][0]), numcols[Hz], 1.0,
-                                    &(Zmat[Hz][0][0]), numcols[Hz]);
+                            tasks.push_back({'t', 'n', numrows[Hz], numcols[Hz], numlinks[Hy ^ symlink], alpha,
+                                             &(Xmat[Hz][0][0]), numrows[Hz], &(Y->matrix[Hy][0][0]), numcols[Hz], 1.0,
+                                             &(Zmat[Hz][0][0]), numcols[Hz]});
                         } else if (!Xtrans && Ytrans) {
-                            C_DGEMM('n', 't', numrows[Hz], numcols[Hz], numlinks[Hy ^ symlink], alpha,
-                                    &(Xmat[Hz][0][0]), numlinks[Hy ^ symlink], &(Y->matrix[Hy][0][0]),
-                                    numlinks[Hy ^ symlink], 1.0, &(Zmat[Hz][0][0]), numcols[Hz]);
+                            tasks.push_back({'n', 't', numrows[Hz], numcols[Hz], numlinks[Hy ^ symlink], alpha,
+                                             &(Xmat[Hz][0][0]), numlinks[Hy ^ symlink], &(Y->matrix[Hy][0][0]),
+                                             numlinks[Hy ^ symlink], 1.0, &(Zmat[Hz][0][0]), numcols[Hz]});
                         } else {
-                            C_DGEMM('t', 't', numrows[Hz], numcols[Hz], numlinks[Hy ^ symlink], alpha,
-                                    &(Xmat[Hz][0][0]), numrows[Hz], &(Y->matrix[Hy][0][0]), numlinks[Hy ^ symlink], 1.0,
-                                    &(Zmat[Hz][0][0]), numcols[Hz]);
+                            tasks.push_back({'t', 't', numrows[Hz], numcols[Hz], numlinks[Hy ^ symlink], alpha,
+                                             &(Xmat[Hz][0][0]), numrows[Hz], &(Y->matrix[Hy][0][0]),
+                                             numlinks[Hy ^ symlink], 1.0, &(Zmat[Hz][0][0]), numcols[Hz]});
                         }
                     }
                 }
+                dpd_gemm_batch(tasks);
+            }
 
             if (sum_X == 0)
                 buf4_mat_irrep_close(X, hxbuf);
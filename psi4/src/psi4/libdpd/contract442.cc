@@ -251,7 +251,8 @@ int DPD::contract442(dpdbuf4 *X, dpdbuf4 *Y, dpdfile2 *Z, int target_X, int targ
                 newmm_rking(Xmat[Hx], Xtrans, Ymat[Hy], Ytrans, Z->matrix[Hz], Z->params->rowtot[Hz], numlinks[Hx],
                             Z->params->coltot[Hz ^ GZ], alpha, 1.0);
             }
-        else
+        else {
+            std::vector<dpd_gemm_task> tasks;
             for (Hx = 0; Hx < nirreps; Hx++) {
 #ifdef DPD_DEBUG
                 if ((xrow[Hx] != zrow[Hx]) || (ycol[Hx] != zcol[Hx]) || (xcol[Hx] != yrow[Hx])) {
@@ -273,35 +274,32 @@ int DPD::contract442(dpdbuf4 *X, dpdbuf4 *Y, dpdfile2 *Z, int target_X, int targ
                     Hy = Hx ^ GY;
                     Hz = Hx ^ GX;
                 }
-                /* outfile->Printf(stdout,"rows %d links %d cols %d\n",
-       Z->params->rowtot[Hz], numlinks[Hx], Z->params->coltot[Hz]); */
 
+                /* Each Hx feeds a different block Hz of Z, so the products are independent */
                 if (Z->params->rowtot[Hz] && Z->params->coltot[Hz ^ GZ] && numlinks[Hx]) {
                     if (!Xtrans && !Ytrans) {
-                        C_DGEMM('n', 'n', Z->params->rowtot[Hz], Z->params->coltot[Hz ^ GZ], numlinks[Hx], alpha,
-                                &(Xmat[Hx][0][0]), numlinks[Hx], &(Ymat[Hy][0][0]), Z->params->coltot[Hz ^ GZ], 1.0,
-                                &(Z->matrix[Hz][0][0]), Z->params->coltot[Hz ^ GZ]);
+                        tasks.push_back({'n', 'n', Z->params->rowtot[Hz], Z->params->coltot[Hz ^ GZ], numlinks[Hx],
+                                         alpha, &(Xmat[Hx][0][0]), numlinks[Hx], &(Ymat[Hy][0][0]),
+                                         Z->params->coltot[Hz ^ GZ], 1.0, &(Z->matrix[Hz][0][0]),
+                                         Z->params->coltot[Hz ^ GZ]});
                     } else if (Xtrans && !Ytrans) {
-                        C_DGEMM('t', 'n', Z->params->rowtot[Hz], Z->params->coltot[Hz ^ GZ], numlinks[Hx], alpha,
-                                &(Xmat[Hx][0][0]), Z->params->rowtot[Hz], &(Ymat[Hy][0][0]), Z->params->coltot[Hz ^ GZ],
-                                1.0, &(Z->matrix[Hz][0][0]), Z->params->coltot[Hz ^ GZ]);
+                        tasks.push_back({'t', 'n', Z->params->rowtot[Hz], Z->params->coltot[Hz ^ GZ], numlinks[Hx],
+                                         alpha, &(Xmat[Hx][0][0]), Z->params->rowtot[Hz], &(Ymat[Hy][0][0]),
+                                         Z->params->coltot[Hz ^ GZ], 1.0, &(Z->matrix[Hz][0][0]),
+                                         Z->params->coltot[Hz ^ GZ]});
                     } else if (!Xtrans && Ytrans) {
-                        C_DGEMM('n', 't', Z->params->rowtot[Hz], Z->params->coltot[Hz ^ GZ], numlinks[Hx], alpha,
-                                &(Xmat[Hx][0][0]), numlinks[Hx], &(Ymat[Hy][0][0]), numlinks[Hx], 1.0,
-                                &(Z->matrix[Hz][0][0]), Z->params->coltot[Hz ^ GZ]);
+                        tasks.push_back({'n', 't', Z->params->rowtot[Hz], Z->params->coltot[Hz ^ GZ], numlinks[Hx],
+                                         alpha, &(Xmat[Hx][0][0]), numlinks[Hx], &(Ymat[Hy][0][0]), numlinks[Hx], 1.0,
+                                         &(Z->matrix[Hz][0][0]), Z->params->coltot[Hz ^ GZ]});
                     } else {
-                        C_DGEMM('t', 't', Z->params->rowtot[Hz], Z->params->coltot[Hz ^ GZ], numlinks[Hx], alpha,
-                                &(Xmat[Hx][0][0]), Z->params->rowtot[Hz], &(Ymat[Hy][0][0]), numlinks[Hx], 1.0,
-                                &(Z->matrix[Hz][0][0]), Z->params->coltot[Hz ^ GZ]);
+                        tasks.push_back({'t', 't', Z->params->rowtot[Hz], Z->params->coltot[Hz ^ GZ], numlinks[Hx],
+                                         alpha, &(Xmat[Hx][0][0]), Z->params->rowtot[Hz], &(Ymat[Hy][0][0]),
+                                         numlinks[Hx], 1.0, &(Z->matrix[Hz][0][0]), Z->params->coltot[Hz ^ GZ]});
                     }
                 }
-                /*
-        newmm(Xmat[Hx], Xtrans, Ymat[Hy], Ytrans,
-            Z->matrix[Hz], Z->params->rowtot[Hz],
-            numlinks[Hx], Z->params->coltot[Hz^GZ],
-            alpha, 1.0);
-        */
             }
+            dpd_gemm_batch(tasks);
+        }
 
         if (target_X == 0)
             buf4_mat_irrep_close(X, hxbuf);
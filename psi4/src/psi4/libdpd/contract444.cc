@@ -30,6 +30,7 @@
     \ingroup DPD
     \brief Enter brief description of file here
 */
+#include <algorithm>
 #include <cstdio>
 #include <cmath>
 #include "psi4/libqt/qt.h"
@@ -61,9 +62,11 @@ namespace psi {
 int DPD::contract444(dpdbuf4 *X, dpdbuf4 *Y, dpdbuf4 *Z, int target_X, int target_Y, double alpha, double beta) {
     int n, Hx, Hy, Hz, GX, GY, GZ, nirreps, Xtrans, Ytrans, *numlinks, symlink;
     long int size_Y, size_Z, size_file_X_row;
-    int incore, nbuckets;
+    int incore, nbuckets, prefetch;
     long int memoryd, core, rows_per_bucket, rows_left, memtotal;
     int nrows, ncols, nlinks;
+    double **Xblock[2], **Xcur;
+    std::future<int> Xnext;
 #if DPD_DEBUG
     int *xrow, *xcol, *yrow, *ycol, *zrow, *zcol;
     double byte_conv;
@@ -144,7 +147,11 @@ int DPD::contract444(dpdbuf4 *X, dpdbuf4 *Y, dpdbuf4 *Z, int target_X, int targe
 
             if (rows_per_bucket > X->params->rowtot[Hx]) rows_per_bucket = X->params->rowtot[Hx];
 
-            if (!rows_per_bucket) dpd_error("contract444: Not enough memory for one row", "outfile");
+            /* Y and Z leave no room for a row of X: stream all three in row panels */
+            if (rows_per_bucket < 1) {
+                contract444_tiled(X, Y, Z, Hx, Hy, Hz, Xtrans, Ytrans, alpha, beta);
+                continue;
+            }
 
             nbuckets = (int)ceil((double)X->params->rowtot[Hx] / (double)rows_per_bucket);
 
@@ -152,6 +159,17 @@ int DPD::contract444(dpdbuf4 *X, dpdbuf4 *Y, dpdbuf4 *Z, int target_X, int targe
 
             incore = 1;
             if (nbuckets > 1) incore = 0;
+
+            /* Out of core, split the memory between two X buffers if it
+               holds at least a row each, so that the next bucket can be read
+               while the current one is being contracted. */
+            prefetch = 0;
+            if (!incore && memoryd / (2 * (long)X->params->coltot[Hx ^ GX])) {
+                prefetch = 1;
+                rows_per_bucket = memoryd / (2 * (long)X->params->coltot[Hx ^ GX]);
+                nbuckets = (int)ceil((double)X->params->rowtot[Hx] / (double)rows_per_bucket);
+                rows_left = X->params->rowtot[Hx] % rows_per_bucket;
+            }
         } else
             incore = 1;
 
@@ -191,10 +209,10 @@ int DPD::contract444(dpdbuf4 *X, dpdbuf4 *Y, dpdbuf4 *Z, int target_X, int targe
             if (std::fabs(beta) > 0.0) buf4_mat_irrep_rd(Z, Hz);
 
             if (Z->params->rowtot[Hz] && Z->params->coltot[Hz ^ GZ] && numlinks[Hx ^ symlink]) {
-                C_DGEMM(Xtrans ? 't' : 'n', Ytrans ? 't' : 'n', Z->params->rowtot[Hz], Z->params->coltot[Hz ^ GZ],
-                        numlinks[Hx ^ symlink], alpha, &(X->matrix[Hx][0][0]), X->params->coltot[Hx ^ GX],
-                        &(Y->matrix[Hy][0][0]), Y->params->coltot[Hy ^ GY], beta, &(Z->matrix[Hz][0][0]),
-                        Z->params->coltot[Hz ^ GZ]);
+                dpd_gemm_batch({{Xtrans ? 't' : 'n', Ytrans ? 't' : 'n', Z->params->rowtot[Hz],
+                                 Z->params->coltot[Hz ^ GZ], numlinks[Hx ^ symlink], alpha, &(X->matrix[Hx][0][0]),
+                                 X->params->coltot[Hx ^ GX], &(Y->matrix[Hy][0][0]), Y->params->coltot[Hy ^ GY], beta,
+                                 &(Z->matrix[Hz][0][0]), Z->params->coltot[Hz ^ GZ]}});
             }
 
             buf4_mat_irrep_close(X, Hx);
@@ -210,24 +228,39 @@ int DPD::contract444(dpdbuf4 *X, dpdbuf4 *Y, dpdbuf4 *Z, int target_X, int targe
             }
 
             buf4_mat_irrep_init_block(X, Hx, rows_per_bucket);
+            Xblock[0] = X->matrix[Hx];
+            Xblock[1] = prefetch ? dpd_block_matrix(rows_per_bucket, X->params->coltot[Hx ^ GX]) : nullptr;
 
             buf4_mat_irrep_init(Y, Hy);
             buf4_mat_irrep_rd(Y, Hy);
             buf4_mat_irrep_init(Z, Hz);
             if (std::fabs(beta) > 0.0) buf4_mat_irrep_rd(Z, Hz);
 
+            /* Rows of X in bucket n; the last bucket holds whatever is left */
+            auto bucket_rows = [&](int n) {
+                return (int)std::min(rows_per_bucket, (long)X->params->rowtot[Hx] - n * rows_per_bucket);
+            };
+
+            if (prefetch) Xnext = buf4_mat_irrep_rd_block_async(X, Hx, 0, bucket_rows(0), Xblock[0]);
+
             for (n = 0; n < nbuckets; n++) {
-                if (n < (nbuckets - 1))
-                    buf4_mat_irrep_rd_block(X, Hx, n * rows_per_bucket, rows_per_bucket);
-                else
-                    buf4_mat_irrep_rd_block(X, Hx, n * rows_per_bucket, rows_left);
+                if (prefetch) {
+                    Xnext.get();
+                    Xcur = Xblock[n % 2];
+                    if (n + 1 < nbuckets)
+                        Xnext = buf4_mat_irrep_rd_block_async(X, Hx, (n + 1) * rows_per_bucket, bucket_rows(n + 1),
+                                                              Xblock[(n + 1) % 2]);
+                } else {
+                    buf4_mat_irrep_rd_block(X, Hx, n * rows_per_bucket, bucket_rows(n));
+                    Xcur = X->matrix[Hx];
+                }
 
                 if (!Xtrans && Ytrans) {
-                    nrows = n < (nbuckets - 1) ? rows_per_bucket : rows_left;
+                    nrows = bucket_rows(n);
                     ncols = Z->params->coltot[Hz ^ GZ];
                     nlinks = numlinks[Hx ^ symlink];
                     if (nrows && ncols && nlinks)
-                        C_DGEMM('n', 't', nrows, ncols, nlinks, alpha, &(X->matrix[Hx][0][0]), numlinks[Hx ^ symlink],
+                        C_DGEMM('n', 't', nrows, ncols, nlinks, alpha, &(Xcur[0][0]), numlinks[Hx ^ symlink],
                                 &(Y->matrix[Hy][0][0]), numlinks[Hx ^ symlink], beta,
                                 &(Z->matrix[Hz][n * rows_per_bucket][0]), Z->params->coltot[Hz ^ GZ]);
                 } else if (Xtrans && !Ytrans) {
@@ -237,16 +270,17 @@ int DPD::contract444(dpdbuf4 *X, dpdbuf4 *Y, dpdbuf4 *Z, int target_X, int targe
           thereafter. */
                     nrows = Z->params->rowtot[Hz];
                     ncols = Z->params->coltot[Hz ^ GZ];
-                    nlinks = n < (nbuckets - 1) ? rows_per_bucket : rows_left;
+                    nlinks = bucket_rows(n);
                     if (nrows && ncols && nlinks)
-                        C_DGEMM('t', 'n', nrows, ncols, nlinks, alpha, &(X->matrix[Hx][0][0]),
-                                X->params->coltot[Hx ^ GX], &(Y->matrix[Hy][n * rows_per_bucket][0]),
-                                Y->params->coltot[Hy ^ GY], (n == 0 ? beta : 1.0), &(Z->matrix[Hz][0][0]),
-                                Z->params->coltot[Hz ^ GZ]);
+                        C_DGEMM('t', 'n', nrows, ncols, nlinks, alpha, &(Xcur[0][0]), X->params->coltot[Hx ^ GX],
+                                &(Y->matrix[Hy][n * rows_per_bucket][0]), Y->params->coltot[Hy ^ GY],
+                                (n == 0 ? beta : 1.0), &(Z->matrix[Hz][0][0]), Z->params->coltot[Hz ^ GZ]);
                 }
             }
 
+            X->matrix[Hx] = Xblock[0];
             buf4_mat_irrep_close_block(X, Hx, rows_per_bucket);
+            if (prefetch) free_dpd_block(Xblock[1], rows_per_bucket, X->params->coltot[Hx ^ GX]);
 
             buf4_mat_irrep_close(Y, Hy);
             buf4_mat_irrep_wrt(Z, Hz);
@@ -0,0 +1,148 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Psi4: an open-source quantum chemistry software package
+ *
+ * Copyright (c) 2007-2023 The Psi4 Developers.
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This file is part of Psi4.
+ *
+ * Psi4 is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * Psi4 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with Psi4; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * @END LICENSE
+ */
+
+/*! \file
+    \ingroup DPD
+    \brief Row-panel contract444 for irrep blocks whose Y and Z do not fit in core
+*/
+#include <algorithm>
+#include <cstdio>
+#include <cmath>
+#include "psi4/libqt/qt.h"
+#include "dpd.h"
+#include "psi4/libpsi4util/PsiOutStream.h"
+
+namespace psi {
+
+/* dpd_contract444_tiled(): Contracts one irrep block of a pair of
+** four-index quantities when the standard out-of-core contract444,
+** which keeps all of Y and Z in core, cannot hold a single row of X.
+** Every buffer is partitioned into row panels that are read from and
+** written back to disk, in the manner of a SUMMA product:
+**
+**   NT: Z(x,y) = alpha X(x,l) Y(y,l) + beta Z(x,y). X and Z are walked
+**       in panels of rows; for each panel, Y is streamed in panels of
+**       rows and each product fills a column strip of the Z panel.
+**   TN: Z(x,y) = alpha X(l,x) Y(l,y) + beta Z(x,y). Z is held in core
+**       and X and Y are streamed together in panels over the link
+**       index l.
+**
+** Arguments:
+**   dpdbuf4 *X, *Y, *Z: The buffers passed to contract444().
+**   int Hx, Hy, Hz: The irreps of the X, Y and Z blocks.
+**   int Xtrans, Ytrans: DGEMM arrangement, only NT and TN are coded.
+**   double alpha, beta: As for contract444().
+*/
+
+int DPD::contract444_tiled(dpdbuf4 *X, dpdbuf4 *Y, dpdbuf4 *Z, int Hx, int Hy, int Hz, int Xtrans, int Ytrans,
+                           double alpha, double beta) {
+    int GX = X->file.my_irrep;
+    int GY = Y->file.my_irrep;
+    int GZ = Z->file.my_irrep;
+    long int xrows = X->params->rowtot[Hx];
+    long int xcols = X->params->coltot[Hx ^ GX];
+    long int yrows = Y->params->rowtot[Hy];
+    long int ycols = Y->params->coltot[Hy ^ GY];
+    long int zrows = Z->params->rowtot[Hz];
+    long int zcols = Z->params->coltot[Hz ^ GZ];
+    if (!zrows || !zcols) return 0;
+
+    /* room for a row of each file, used when a buffer is sorted on read */
+    long int file_rows = (long)X->file.params->coltot[0] + (long)Y->file.params->coltot[0] +
+                         (long)Z->file.params->coltot[0];
+    long int memoryd = dpd_memfree() - file_rows;
+
+    if (!Xtrans && Ytrans) {
+        /* Half of the memory for the Y panel, the rest for matching X and Z panels */
+        long int ypanel = std::min(yrows, memoryd / (2 * xcols));
+        long int xpanel = ypanel > 0 ? std::min(xrows, (memoryd - ypanel * xcols) / (xcols + zcols)) : 0;
+        if (ypanel < 1 || xpanel < 1) dpd_error("contract444: Not enough memory for one row", "outfile");
+
+#if DPD_DEBUG
+        outfile->Printf("Contract444 (tiled NT): h = %d, X panel = %ld rows, Y panel = %ld rows\n", Hx, xpanel,
+                        ypanel);
+#endif
+
+        buf4_mat_irrep_init_block(X, Hx, xpanel);
+        buf4_mat_irrep_init_block(Y, Hy, ypanel);
+        buf4_mat_irrep_init_block(Z, Hz, xpanel);
+
+        for (long int x0 = 0; x0 < xrows; x0 += xpanel) {
+            int nx = (int)std::min(xpanel, xrows - x0);
+            buf4_mat_irrep_rd_block(X, Hx, x0, nx);
+            if (std::fabs(beta) > 0.0) buf4_mat_irrep_rd_block(Z, Hz, x0, nx);
+
+            for (long int y0 = 0; y0 < yrows; y0 += ypanel) {
+                int ny = (int)std::min(ypanel, yrows - y0);
+                buf4_mat_irrep_rd_block(Y, Hy, y0, ny);
+                C_DGEMM('n', 't', nx, ny, xcols, alpha, &(X->matrix[Hx][0][0]), xcols, &(Y->matrix[Hy][0][0]), ycols,
+                        beta, &(Z->matrix[Hz][0][y0]), zcols);
+            }
+
+            buf4_mat_irrep_wrt_block(Z, Hz, x0, nx);
+        }
+
+        buf4_mat_irrep_close_block(X, Hx, xpanel);
+        buf4_mat_irrep_close_block(Y, Hy, ypanel);
+        buf4_mat_irrep_close_block(Z, Hz, xpanel);
+    } else if (Xtrans && !Ytrans) {
+        /* Z stays in core; X and Y share the link panel */
+        long int lpanel = std::min(xrows, (memoryd - zrows * zcols) / (xcols + ycols));
+        if (lpanel < 1) dpd_error("contract444: Not enough memory for one row", "outfile");
+
+#if DPD_DEBUG
+        outfile->Printf("Contract444 (tiled TN): h = %d, link panel = %ld rows\n", Hx, lpanel);
+#endif
+
+        buf4_mat_irrep_init(Z, Hz);
+        if (std::fabs(beta) > 0.0) buf4_mat_irrep_rd(Z, Hz);
+        buf4_mat_irrep_init_block(X, Hx, lpanel);
+        buf4_mat_irrep_init_block(Y, Hy, lpanel);
+
+        for (long int l0 = 0; l0 < xrows; l0 += lpanel) {
+            int nl = (int)std::min(lpanel, xrows - l0);
+            buf4_mat_irrep_rd_block(X, Hx, l0, nl);
+            buf4_mat_irrep_rd_block(Y, Hy, l0, nl);
+            /* beta is applied with the first panel only, later panels accumulate */
+            C_DGEMM('t', 'n', zrows, zcols, nl, alpha, &(X->matrix[Hx][0][0]), xcols, &(Y->matrix[Hy][0][0]), ycols,
+                    (l0 == 0 ? beta : 1.0), &(Z->matrix[Hz][0][0]), zcols);
+        }
+
+        buf4_mat_irrep_close_block(X, Hx, lpanel);
+        buf4_mat_irrep_close_block(Y, Hy, lpanel);
+        buf4_mat_irrep_wrt(Z, Hz);
+        buf4_mat_irrep_close(Z, Hz);
+    } else {
+        outfile->Printf("Out-of-core algorithm not yet coded for NN or TT DGEMM.\n");
+        dpd_error("contract444", "outfile");
+    }
+
+    return 0;
+}
+
+}  // namespace psi
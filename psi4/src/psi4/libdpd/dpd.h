@@ -42,6 +42,7 @@ PRAGMA_WARNING_PUSH
 PRAGMA_WARNING_IGNORE_DEPRECATED_DECLARATIONS
 #include <memory>
 PRAGMA_WARNING_POP
+#include <future>
 #include <vector>
 #include "psi4/psi4-dec.h"
 
@@ -169,6 +170,7 @@ struct dpd_file4_cache_entry {
     size_t access;               /* access time */
     size_t usage;                /* number of accesses */
     size_t priority;             /* priority level */
+    double cost;                 /* wall time to re-read from disk (s) */
     int lock;                    /* auto-deletion allowed? */
     int clean;                   /* has this file4 changed? */
     dpd_file4_cache_entry *next; /* pointer to next cache entry */
@@ -191,6 +193,23 @@ struct dpd_file2_cache_entry {
     dpd_file2_cache_entry *last; /* pointer to previous cache entry */
 };
 
+/* One independent DGEMM, C = alpha op(A) op(B) + beta C, for dpd_gemm_batch() */
+struct dpd_gemm_task {
+    char transa;
+    char transb;
+    int m;
+    int n;
+    int k;
+    double alpha;
+    double *A;
+    int lda;
+    double *B;
+    int ldb;
+    double beta;
+    double *C;
+    int ldc;
+};
+
 /* DPD global parameter set */
 struct dpd_data {
     int nirreps;
@@ -253,13 +272,25 @@ struct dpd_gbl {
           file4_cache_most_recent(0),
           file4_cache_least_recent(1),
           file4_cache_lru_del(0),
-          file4_cache_low_del(0) {}
+          file4_cache_low_del(0),
+          file4_cache_cost_del(0),
+          file4_cache_stats(nullptr),
+          file4_cache_adapted(0),
+          file4_cache_read_bytes(0.0),
+          file4_cache_read_time(0.0) {}
     dpd_file2_cache_entry *file2_cache;
     dpd_file4_cache_entry *file4_cache;
     size_t file4_cache_most_recent;
     size_t file4_cache_least_recent;
     size_t file4_cache_lru_del;
     size_t file4_cache_low_del;
+    size_t file4_cache_cost_del;
+    /* Access/re-read history for the adaptive (cachetype 2) policy.  Unlike
+       the cache itself, these records persist when an entry is evicted. */
+    dpd_file4_cache_entry *file4_cache_stats;
+    int file4_cache_adapted;
+    double file4_cache_read_bytes;
+    double file4_cache_read_time;
     int cachetype;
     int *cachefiles;
     int **cachelist;
@@ -342,6 +373,8 @@ class PSI_API DPD {
     int contract424(dpdbuf4 *X, dpdfile2 *Y, dpdbuf4 *Z, int sum_X, int sum_Y, int trans_Z, double alpha, double beta);
     int contract444(dpdbuf4 *X, dpdbuf4 *Y, dpdbuf4 *Z, int target_X, int target_Y, double alpha, double beta);
     int contract444_df(dpdbuf4 *B, dpdbuf4 *tau_in, dpdbuf4 *tau_out, double alpha, double beta);
+    int contract444_tiled(dpdbuf4 *X, dpdbuf4 *Y, dpdbuf4 *Z, int Hx, int Hy, int Hz, int Xtrans, int Ytrans,
+                          double alpha, double beta);
 
     /* Need to consolidate these routines into one general function */
     int dot23(dpdfile2 *T, dpdbuf4 *I, dpdfile2 *Z, int transt, int transz, double alpha, double beta);
@@ -423,6 +456,8 @@ class PSI_API DPD {
     int buf4_mat_irrep_init_block(dpdbuf4 *Buf, int irrep, int num_pq);
     int buf4_mat_irrep_close_block(dpdbuf4 *Buf, int irrep, int num_pq);
     int buf4_mat_irrep_rd_block(dpdbuf4 *Buf, int irrep, int start_pq, int num_pq);
+    std::future<int> buf4_mat_irrep_rd_block_async(dpdbuf4 *Buf, int irrep, int start_pq, int num_pq,
+                                                   double **block);
     int buf4_mat_irrep_wrt_block(dpdbuf4 *Buf, int irrep, int start_pq, int num_pq);
     int buf4_dump(dpdbuf4 *DPDBuf, struct iwlbuf *IWLBuf, int *prel, int *qrel, int *rrel, int *srel, int bk_pack,
                   int swap23);
@@ -445,6 +480,7 @@ class PSI_API DPD {
     int file2_cache_add(dpdfile2 *File);
     int file2_cache_del(dpdfile2 *File);
     int file4_cache_del_low();
+    int file4_cache_del_cost();
     void file2_cache_dirty(dpdfile2 *File);
 
     void file4_cache_init();
@@ -452,6 +488,10 @@ class PSI_API DPD {
     void file4_cache_print(std::string out_fname);
     void file4_cache_print_screen();
     int file4_cache_get_priority(dpdfile4 *File);
+    dpd_file4_cache_entry *file4_cache_stats_scan(int filenum, int irrep, int pqnum, int rsnum, const char *label,
+                                                  int dpdnum);
+    dpd_file4_cache_entry *file4_cache_find_cost();
+    void file4_cache_adapt();
 
     dpd_file4_cache_entry *file4_cache_scan(int filenum, int irrep, int pqnum, int rsnum, const char *label,
                                             int dpdnum);
@@ -478,7 +518,9 @@ class PSI_API DPD {
 
     void T3_RHF(double ***W1, int nirreps, int I, int Gi, int J, int Gj, int K, int Gk, dpdbuf4 *T2, dpdbuf4 *F,
                 dpdbuf4 *E, dpdfile2 *fIJ, dpdfile2 *fAB, int *occpi, int *occ_off, int *virtpi, int *vir_off,
-                double omega);
+                double omega, double ***FI = nullptr, double ***FJ = nullptr);
+    double ***T3_RHF_F_rows(dpdbuf4 *F, int X, int Gx, int *virtpi);
+    void T3_RHF_F_rows_free(double ***rows, dpdbuf4 *F, int Gx, int *virtpi);
 
     void T3_RHF_ic(double ***W1, int nirreps, int I, int Gi, int J, int Gj, int K, int Gk, dpdbuf4 *T2, dpdbuf4 *F,
                    dpdbuf4 *E, dpdfile2 *fIJ, dpdfile2 *fAB, int *occpi, int *occ_off, int *virtpi, int *vir_off,
@@ -532,6 +574,7 @@ extern int dpd_init(int dpd_num, int nirreps, long int memory, int cachetype, in
                     dpd_file4_cache_entry *priority, int num_subspaces, std::vector<int *> &spaceArrays);
 extern int dpd_close(int dpd_num);
 extern long int PSI_API dpd_memfree();
+extern void PSI_API dpd_gemm_batch(const std::vector<dpd_gemm_task> &tasks);
 extern void dpd_memset(long int memory);
 
 }  // Namespace psi
@@ -30,6 +30,8 @@
     \ingroup DPD
     \brief Enter brief description of file here
 */
+#include <algorithm>
+#include <chrono>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
@@ -44,6 +46,11 @@ void DPD::file4_cache_init() {
     dpd_main.file4_cache_least_recent = 1;
     dpd_main.file4_cache_lru_del = 0;
     dpd_main.file4_cache_low_del = 0;
+    dpd_main.file4_cache_cost_del = 0;
+    dpd_main.file4_cache_stats = nullptr;
+    dpd_main.file4_cache_adapted = 0;
+    dpd_main.file4_cache_read_bytes = 0.0;
+    dpd_main.file4_cache_read_time = 0.0;
 }
 
 void DPD::file4_cache_close() {
@@ -73,6 +80,16 @@ void DPD::file4_cache_close() {
 
     /* return the dpd_default to its original value */
     dpd_set_default(dpdnum);
+
+    /* Drop the access history of the adaptive policy */
+    this_entry = dpd_main.file4_cache_stats;
+    while (this_entry != nullptr) {
+        next_entry = this_entry->next;
+        free(this_entry);
+        this_entry = next_entry;
+    }
+    dpd_main.file4_cache_stats = nullptr;
+    dpd_main.file4_cache_adapted = 0;
 }
 
 dpd_file4_cache_entry *DPD::file4_cache_scan(int filenum, int irrep, int pqnum, int rsnum, const char *label,
@@ -125,11 +142,17 @@ dpd_file4_cache_entry *DPD::file4_cache_last() {
 
 int DPD::file4_cache_add(dpdfile4 *File, size_t priority) {
     int h, dpdnum;
-    dpd_file4_cache_entry *this_entry;
+    double read_time;
+    dpd_file4_cache_entry *this_entry, *stats;
 
     this_entry = file4_cache_scan(File->filenum, File->my_irrep, File->params->pqnum, File->params->rsnum, File->label,
                                   File->dpdnum);
 
+    /* Count the access for the adaptive policy, whether or not it hits */
+    stats = file4_cache_stats_scan(File->filenum, File->my_irrep, File->params->pqnum, File->params->rsnum,
+                                   File->label, File->dpdnum);
+    stats->usage++;
+
     if ((this_entry != nullptr && !(File->incore)) || (this_entry == nullptr && (File->incore))) {
         /* Either the file4 appears in the cache but incore is not set,
      or incore is set and the file4 isn't in the cache */
@@ -146,13 +169,22 @@ int DPD::file4_cache_add(dpdfile4 *File, size_t priority) {
         dpdnum = dpd_default;
         dpd_set_default(File->dpdnum);
 
-        /* Read all data into core */
+        /* Read all data into core.  Allocation may evict other entries, so
+           only the reads themselves are timed. */
         this_entry->size = 0;
         for (h = 0; h < File->params->nirreps; h++) {
             this_entry->size += File->params->rowtot[h] * File->params->coltot[h ^ (File->my_irrep)];
             file4_mat_irrep_init(File, h);
-            file4_mat_irrep_rd(File, h);
         }
+        auto read_start = std::chrono::steady_clock::now();
+        for (h = 0; h < File->params->nirreps; h++) file4_mat_irrep_rd(File, h);
+        read_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - read_start).count();
+
+        dpd_main.file4_cache_read_bytes += this_entry->size * sizeof(double);
+        dpd_main.file4_cache_read_time += read_time;
+        stats->size = this_entry->size;
+        stats->cost = read_time;
+        this_entry->cost = read_time;
 
         this_entry->dpdnum = File->dpdnum;
         this_entry->filenum = File->filenum;
@@ -269,6 +301,7 @@ void DPD::file4_cache_print_screen() {
                     dpd_main.file4_cache_most_recent, dpd_main.file4_cache_least_recent);
     outfile->Printf("#LRU deletions = %6zu; #Low-priority deletions = %6zu\n", dpd_main.file4_cache_lru_del,
                     dpd_main.file4_cache_low_del);
+    outfile->Printf("#Cost-based deletions = %6zu\n", dpd_main.file4_cache_cost_del);
     outfile->Printf("Core max size:  %9.1f kB\n", (dpd_main.memory) * sizeof(double) / 1e3);
     outfile->Printf("Core used:      %9.1f kB\n", (dpd_main.memused) * sizeof(double) / 1e3);
     outfile->Printf("Core available: %9.1f kB\n", dpd_memfree() * sizeof(double) / 1e3);
@@ -301,6 +334,7 @@ void DPD::file4_cache_print(std::string out) {
                     dpd_main.file4_cache_most_recent, dpd_main.file4_cache_least_recent);
     printer->Printf("#LRU deletions = %6zu; #Low-priority deletions = %6zu\n", dpd_main.file4_cache_lru_del,
                     dpd_main.file4_cache_low_del);
+    printer->Printf("#Cost-based deletions = %6zu\n", dpd_main.file4_cache_cost_del);
     printer->Printf("Core max size:  %9.1f kB\n", (dpd_main.memory) * sizeof(double) / 1e3);
     printer->Printf("Core used:      %9.1f kB\n", (dpd_main.memused) * sizeof(double) / 1e3);
     printer->Printf("Core available: %9.1f kB\n", dpd_memfree() * sizeof(double) / 1e3);
@@ -492,6 +526,123 @@ int DPD::file4_cache_del_low() {
     }
 }
 
+/* file4_cache_stats_scan(): Returns the access history record of a
+** file4, creating an empty one on first use.  The records outlive cache
+** entries, so an evicted file4 keeps its usage count and re-read cost.
+*/
+dpd_file4_cache_entry *DPD::file4_cache_stats_scan(int filenum, int irrep, int pqnum, int rsnum, const char *label,
+                                                   int dpdnum) {
+    dpd_file4_cache_entry *this_entry;
+
+    this_entry = dpd_main.file4_cache_stats;
+
+    while (this_entry != nullptr) {
+        if (this_entry->filenum == filenum && this_entry->irrep == irrep && this_entry->pqnum == pqnum &&
+            this_entry->rsnum == rsnum && this_entry->dpdnum == dpdnum && !strcmp(this_entry->label, label))
+            return (this_entry);
+        this_entry = this_entry->next;
+    }
+
+    this_entry = (dpd_file4_cache_entry *)malloc(sizeof(dpd_file4_cache_entry));
+    this_entry->dpdnum = dpdnum;
+    this_entry->filenum = filenum;
+    this_entry->irrep = irrep;
+    this_entry->pqnum = pqnum;
+    this_entry->rsnum = rsnum;
+    strcpy(this_entry->label, label);
+    this_entry->matrix = nullptr;
+    this_entry->size = 0;
+    this_entry->access = 0;
+    this_entry->usage = 0;
+    this_entry->priority = 0;
+    this_entry->cost = 0.0;
+    this_entry->lock = 0;
+    this_entry->clean = 1;
+    this_entry->last = nullptr;
+    this_entry->next = dpd_main.file4_cache_stats;
+    if (this_entry->next != nullptr) this_entry->next->last = this_entry;
+    dpd_main.file4_cache_stats = this_entry;
+
+    return (this_entry);
+}
+
+/* file4_cache_score(): Disk time saved per cached double by keeping an
+** entry: every recorded access would otherwise re-read it, and a dirty
+** entry must also be written out on eviction.  The re-read cost is the
+** measured read time, or the size over the average bandwidth seen so far
+** if that is larger (e.g. the first read of a file4 not yet on disk).
+*/
+static double file4_cache_score(const dpd_file4_cache_entry *entry, const dpd_file4_cache_entry *stats) {
+    double cost, bandwidth;
+
+    if (!entry->size) return 0.0;
+
+    cost = stats->cost;
+    if (dpd_main.file4_cache_read_time > 0.0) {
+        bandwidth = dpd_main.file4_cache_read_bytes / dpd_main.file4_cache_read_time;
+        cost = std::max(cost, entry->size * sizeof(double) / bandwidth);
+    }
+
+    return (stats->usage + (entry->clean ? 0 : 1)) * cost / entry->size;
+}
+
+dpd_file4_cache_entry *DPD::file4_cache_find_cost() {
+    dpd_file4_cache_entry *this_entry, *low_entry;
+    double score, low_score;
+
+    low_entry = nullptr;
+    low_score = 0.0;
+
+    for (this_entry = dpd_main.file4_cache; this_entry != nullptr; this_entry = this_entry->next) {
+        if (this_entry->lock) continue;
+        score = file4_cache_score(this_entry,
+                                  file4_cache_stats_scan(this_entry->filenum, this_entry->irrep, this_entry->pqnum,
+                                                         this_entry->rsnum, this_entry->label, this_entry->dpdnum));
+        if (low_entry == nullptr || score < low_score) {
+            low_entry = this_entry;
+            low_score = score;
+        }
+    }
+
+    return low_entry;
+}
+
+/* file4_cache_del_cost(): Eviction for the adaptive cache (cachetype 2).
+** Until file4_cache_adapt() is called the access history is still being
+** collected and entries are evicted in LRU order; afterwards the entry with
+** the lowest file4_cache_score() goes first.
+*/
+int DPD::file4_cache_del_cost() {
+    int dpdnum;
+    dpdfile4 File;
+    dpd_file4_cache_entry *this_entry;
+
+    if (!dpd_main.file4_cache_adapted) return file4_cache_del_lru();
+
+    this_entry = file4_cache_find_cost();
+
+    if (this_entry == nullptr) return 1; /* there is no cache or everything is locked */
+
+    dpd_main.file4_cache_cost_del++;
+
+    dpdnum = dpd_default;
+    dpd_set_default(this_entry->dpdnum);
+
+    file4_init(&File, this_entry->filenum, this_entry->irrep, this_entry->pqnum, this_entry->rsnum, this_entry->label);
+    file4_cache_del(&File);
+    file4_close(&File);
+
+    dpd_set_default(dpdnum);
+
+    return 0;
+}
+
+/* file4_cache_adapt(): Ends the profiling phase of the adaptive cache.
+** Callers invoke this once a representative pass (e.g. the first CC
+** iteration) has been recorded; later evictions use the cost model.
+*/
+void DPD::file4_cache_adapt() { dpd_main.file4_cache_adapted = 1; }
+
 void DPD::file4_cache_lock(dpdfile4 *File) {
     int h;
     dpd_file4_cache_entry *this_entry;
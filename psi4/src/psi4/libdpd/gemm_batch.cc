@@ -0,0 +1,101 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Psi4: an open-source quantum chemistry software package
+ *
+ * Copyright (c) 2007-2023 The Psi4 Developers.
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This file is part of Psi4.
+ *
+ * Psi4 is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * Psi4 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with Psi4; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * @END LICENSE
+ */
+
+/*! \file
+    \ingroup DPD
+    \brief Thread-tiled execution of independent irrep-block DGEMMs
+*/
+#include <algorithm>
+#include <cmath>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#include "psi4/libqt/qt.h"
+#include "dpd.h"
+
+namespace psi {
+
+/* Below this many flops in the whole batch, threading costs more than it saves */
+#define DPD_GEMM_BATCH_MIN_FLOPS 2.0e6
+/* No tile gets fewer rows of C than this */
+#define DPD_GEMM_BATCH_MIN_ROWS 8
+
+/* dpd_gemm_batch(): Runs a list of independent DGEMMs, typically the
+** per-irrep blocks of one contraction.  Each product is cut into tiles
+** of rows of C, and all tiles of all irreps are handed out dynamically
+** to the OpenMP threads.  Within the parallel region the BLAS call in
+** each tile runs single-threaded, which keeps many small irrep blocks
+** from each being spread thinly over every core.
+**
+** Arguments:
+**   tasks: The products to form.  No two may share rows of C.
+*/
+void dpd_gemm_batch(const std::vector<dpd_gemm_task> &tasks) {
+    int nthreads = 1;
+#ifdef _OPENMP
+    nthreads = omp_get_max_threads();
+#endif
+
+    double total_flops = 0.0;
+    for (const auto &task : tasks) total_flops += 2.0 * task.m * (double)task.n * task.k;
+
+    if (nthreads == 1 || total_flops < DPD_GEMM_BATCH_MIN_FLOPS) {
+        for (const auto &task : tasks) {
+            if (task.m && task.n && task.k)
+                C_DGEMM(task.transa, task.transb, task.m, task.n, task.k, task.alpha, task.A, task.lda, task.B,
+                        task.ldb, task.beta, task.C, task.ldc);
+        }
+        return;
+    }
+
+    /* Roughly four tiles per thread over the batch, shared out by cost */
+    std::vector<dpd_gemm_task> tiles;
+    for (const auto &task : tasks) {
+        if (!(task.m && task.n && task.k)) continue;
+        double flops = 2.0 * task.m * (double)task.n * task.k;
+        int ntiles = (int)std::ceil(4.0 * nthreads * flops / total_flops);
+        ntiles = std::min(ntiles, std::max(1, task.m / DPD_GEMM_BATCH_MIN_ROWS));
+        int rows_per_tile = (task.m + ntiles - 1) / ntiles;
+        for (int row = 0; row < task.m; row += rows_per_tile) {
+            dpd_gemm_task tile = task;
+            tile.m = std::min(rows_per_tile, task.m - row);
+            tile.A = (task.transa == 'n' || task.transa == 'N') ? task.A + (long)row * task.lda : task.A + row;
+            tile.C = task.C + (long)row * task.ldc;
+            tiles.push_back(tile);
+        }
+    }
+
+#pragma omp parallel for schedule(dynamic, 1) num_threads(nthreads)
+    for (long int t = 0; t < (long int)tiles.size(); t++) {
+        const dpd_gemm_task &tile = tiles[t];
+        C_DGEMM(tile.transa, tile.transb, tile.m, tile.n, tile.k, tile.alpha, tile.A, tile.lda, tile.B, tile.ldb,
+                tile.beta, tile.C, tile.ldc);
+    }
+}
+
+}  // namespace psi
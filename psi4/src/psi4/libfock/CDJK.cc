@@ -120,6 +120,9 @@ void CDJK::initialize_JK_core() {
         psio_->open(unit_, PSIO_OPEN_NEW);
         psio_->write_entry(unit_, "length", (char*)&ncholesky_, sizeof(long int));
         psio_->write_entry(unit_, "(Q|mn) Integrals", (char*)Qmnp[0], sizeof(double) * ntri * ncholesky_);
+        // What the vectors were built for, so a later consumer (dfocc) can tell if they still apply
+        double signature[3] = {cholesky_tolerance_, (double)nbf, (double)ntri};
+        psio_->write_entry(unit_, "Cholesky Signature", (char*)signature, sizeof(signature));
         psio_->close(unit_, 1);
         // stick ncholesky in process environment for other codes that may use the integrals
         // Not sure if this should really be here.  It is here because Ugur uses this option to get the number of
@@ -36,6 +36,8 @@
 #include "psi4/libmints/mintshelper.h"
 #include "psi4/libmints/molecule.h"
 #include "psi4/libmints/integral.h"
+#include "psi4/libmints/onebody.h"
+#include "psi4/libmints/vector3.h"
 #include "psi4/liboptions/liboptions.h"
 #include "psi4/lib3index/dftensor.h"
 
@@ -43,6 +45,7 @@
 #include <vector>
 #include <map>
 #include <algorithm>
+#include <limits>
 #ifdef _OPENMP
 #include <omp.h>
 #endif
@@ -161,6 +164,93 @@ Matrix compute_esp_bound(const BasisSet &primary) {
     return esp_bound;
 
 }
+
+// Single-precision analogue of linalg::doublet for C1 matrices, used by the
+// low-precision (early iteration) COSX build
+SharedMatrix sp_doublet(const SharedMatrix& A, const SharedMatrix& B, bool transA, bool transB) {
+    int m = (transA ? A->coldim() : A->rowdim());
+    int k = (transA ? A->rowdim() : A->coldim());
+    int n = (transB ? B->rowdim() : B->coldim());
+    int kB = (transB ? B->coldim() : B->rowdim());
+    if (k != kB) throw PSIEXCEPTION("sp_doublet: Dimension mismatch");
+
+    auto C = std::make_shared<Matrix>(m, n);
+    if (m == 0 || n == 0 || k == 0) return C;
+
+    std::vector<float> Af(A->rowdim() * A->coldim());
+    std::vector<float> Bf(B->rowdim() * B->coldim());
+    std::vector<float> Cf(m * n);
+    double* Ap = A->pointer()[0];
+    double* Bp = B->pointer()[0];
+    std::transform(Ap, Ap + Af.size(), Af.begin(), [](double x) { return static_cast<float>(x); });
+    std::transform(Bp, Bp + Bf.size(), Bf.begin(), [](double x) { return static_cast<float>(x); });
+
+    C_SGEMM(transA ? 'T' : 'N', transB ? 'T' : 'N', m, n, k, 1.0f, Af.data(), A->coldim(), Bf.data(), B->coldim(),
+            0.0f, Cf.data(), n);
+
+    double* Cp = C->pointer()[0];
+    std::copy(Cf.begin(), Cf.end(), Cp);
+    return C;
+}
+
+// x such that erfc(x) = y, for 0 < y < 1
+double erfc_inverse(double y) {
+    double lo = 0.0, hi = 30.0;
+    for (int iter = 0; iter < 100; iter++) {
+        double mid = 0.5 * (lo + hi);
+        if (std::erfc(mid) > y) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+    return 0.5 * (lo + hi);
+}
+
+// Cartesian derivatives d^(t+u+v) / dX^t dY^u dZ^v of 1/|R| for t + u + v <= N, stored at (t * (N+1) + u) * (N+1) + v.
+// These are the McMurchie-Davidson R_tuv in the point-charge limit, where R_000^(n) = (-1)^n (2n-1)!! / |R|^(2n+1)
+void coulomb_derivatives(int N, const std::array<double, 3>& R, std::vector<double>& T, std::vector<double>& work) {
+    int dim = N + 1;
+    size_t size = (size_t)dim * dim * dim;
+    T.resize(size);
+    work.resize(size);
+
+    double R2 = R[0] * R[0] + R[1] * R[1] + R[2] * R[2];
+    double Rinv = 1.0 / std::sqrt(R2);
+    std::vector<double> base(dim);
+    base[0] = Rinv;
+    for (int n = 1; n <= N; n++) base[n] = -(2 * n - 1) * base[n - 1] * Rinv * Rinv;
+
+    auto index = [dim](int t, int u, int v) { return ((size_t)t * dim + u) * dim + v; };
+
+    // work holds level n + 1, T receives level n
+    for (int n = N; n >= 0; n--) {
+        const double* prev = work.data();
+        double* curr = T.data();
+        for (int t = 0; t <= N - n; t++) {
+            for (int u = 0; u <= N - n - t; u++) {
+                for (int v = 0; v <= N - n - t - u; v++) {
+                    double val;
+                    if (t > 0) {
+                        val = R[0] * prev[index(t - 1, u, v)];
+                        if (t > 1) val += (t - 1) * prev[index(t - 2, u, v)];
+                    } else if (u > 0) {
+                        val = R[1] * prev[index(t, u - 1, v)];
+                        if (u > 1) val += (u - 1) * prev[index(t, u - 2, v)];
+                    } else if (v > 0) {
+                        val = R[2] * prev[index(t, u, v - 1)];
+                        if (v > 1) val += (v - 1) * prev[index(t, u, v - 2)];
+                    } else {
+                        val = base[n];
+                    }
+                    curr[index(t, u, v)] = val;
+                }
+            }
+        }
+        if (n > 0) T.swap(work);
+    }
+}
+
 CompositeJK::CompositeJK(std::shared_ptr<BasisSet> primary, std::shared_ptr<BasisSet> auxiliary, Options& options) : JK(primary), auxiliary_(auxiliary), options_(options) {
     timer_on("CompositeJK: Setup");
     common_init(); 
@@ -216,17 +306,22 @@ void CompositeJK::common_init() {
     IntegralFactory factory(primary_, primary_, primary_, primary_);
     eri_computers_["4-Center"][0] = std::shared_ptr<TwoBodyAOInt>(factory.eri());
 
-    // initialize 3-Center ERIs
-    eri_computers_["3-Center"].emplace({});
-    eri_computers_["3-Center"].resize(nthreads_);
+    // initialize 3-Center ERIs (only Direct DF-J fits the density)
+    bool do_3center = (j_type_ == "DFDIRJ");
+    if (do_3center) {
+        eri_computers_["3-Center"].emplace({});
+        eri_computers_["3-Center"].resize(nthreads_);
 
-    IntegralFactory rifactory(auxiliary_, zero, primary_, primary_);
-    eri_computers_["3-Center"][0] = std::shared_ptr<TwoBodyAOInt>(rifactory.eri());
+        IntegralFactory rifactory(auxiliary_, zero, primary_, primary_);
+        eri_computers_["3-Center"][0] = std::shared_ptr<TwoBodyAOInt>(rifactory.eri());
+    }
 
     // create each threads' ERI computers
     for(int rank = 1; rank < nthreads_; rank++) {
         eri_computers_["4-Center"][rank] = std::shared_ptr<TwoBodyAOInt>(eri_computers_["4-Center"].front()->clone());
-        eri_computers_["3-Center"][rank] = std::shared_ptr<TwoBodyAOInt>(eri_computers_["3-Center"].front()->clone());
+        if (do_3center) {
+            eri_computers_["3-Center"][rank] = std::shared_ptr<TwoBodyAOInt>(eri_computers_["3-Center"].front()->clone());
+        }
     }
 
     timer_off("CompositeJK: ERI Computers");
@@ -245,6 +340,23 @@ void CompositeJK::common_init() {
         computed_shells_per_iter_["Triplets"] = {};
         
         timer_off("CompositeJK: DFDIRJ Coulomb Metric");
+
+    // Continuous Fast Multipole Method
+    } else if (j_type_ == "CFMM") {
+        timer_on("CompositeJK: CFMM Setup");
+
+        cfmm_order_ = options_.get_int("CFMM_ORDER");
+        cfmm_box_length_ = options_.get_double("CFMM_BOX_LENGTH");
+        cfmm_separation_ = options_.get_double("CFMM_SEPARATION");
+        if (cfmm_order_ < 1) throw PSIEXCEPTION("Invalid input for option CFMM_ORDER (< 1)");
+        if (cfmm_box_length_ <= 0.0) throw PSIEXCEPTION("Invalid input for option CFMM_BOX_LENGTH (<= 0.0)");
+        if (cfmm_separation_ <= 1.0) throw PSIEXCEPTION("Invalid input for option CFMM_SEPARATION (<= 1.0)");
+
+        setup_CFMM();
+
+        computed_shells_per_iter_["CFMM Quartets"] = {};
+
+        timer_off("CompositeJK: CFMM Setup");
     } else {
         throw PSIEXCEPTION("Invalid Composite J algorithm selected!");
     }
@@ -441,6 +553,7 @@ void CompositeJK::print_header() const {
 
         if (do_J_) {
             if (j_type_ == "DFDIRJ") { print_DirectDFJ_header(); }
+            else if (j_type_ == "CFMM") { print_CFMM_header(); }
         }
         if (do_K_) {
             if (k_type_ == "LINK") { print_linK_header(); }
@@ -459,6 +572,23 @@ void CompositeJK::print_DirectDFJ_header() const {
     }
 }
 
+void CompositeJK::print_CFMM_header() const {
+    if (print_) {
+        size_t nfar = 0;
+        for (const auto& far : cfmm_far_cells_) nfar += far.size();
+        outfile->Printf("\n");
+        outfile->Printf("  ==> CFMM: Continuous Fast Multipole J <==\n\n");
+
+        outfile->Printf("    J Screening Cutoff:%11.0E\n", cutoff_);
+        outfile->Printf("    Multipole Order:   %11d\n", cfmm_order_);
+        outfile->Printf("    Box Length [au]:   %11.2f\n", cfmm_box_length_);
+        outfile->Printf("    Separation Ratio:  %11.2f\n", cfmm_separation_);
+        outfile->Printf("    Cells:             %11zu\n", cfmm_cell_pairs_.size());
+        outfile->Printf("    Near Cell Pairs:   %11zu\n", cfmm_near_cells_.size());
+        outfile->Printf("    Far Cell Pairs:    %11zu\n", nfar / 2);
+    }
+}
+
 void CompositeJK::print_linK_header() const {
     if (print_) {
         outfile->Printf("\n");
@@ -553,6 +683,9 @@ void CompositeJK::compute_JK() {
         // Direct DF-J
         if (j_type_ == "DFDIRJ") {
             build_DirectDFJ(D_ref_, J_ao_);
+        // CFMM
+        } else if (j_type_ == "CFMM") {
+            build_CFMMJ(D_ref_, J_ao_);
         }
 
         timer_off("CompositeJK: J");
@@ -814,6 +947,8 @@ void CompositeJK::build_DirectDFJ(std::vector<std::shared_ptr<Matrix>>& D, std::
     timer_off("ERI2");
 
     num_computed_shells_ = computed_triplets1 + computed_triplets2;
+    stats_.shells_computed += num_computed_shells_;
+    stats_.shells_screened += 2 * nshelltriplet - num_computed_shells_;
     if (get_bench()) {
         computed_shells_per_iter_["Triplets"].push_back(num_computed_shells());
     }
@@ -827,84 +962,469 @@ void CompositeJK::build_DirectDFJ(std::vector<std::shared_ptr<Matrix>>& D, std::
 
 }
 
-// build the K matrix using Ochsenfelds's Linear Exchange (LinK) algorithm 
-// To follow this code, compare with figure 1 of DOI: 10.1063/1.476741
-void CompositeJK::build_linK(std::vector<SharedMatrix>& D, std::vector<SharedMatrix>& K) {
+void CompositeJK::setup_CFMM() {
+    int nshell = primary_->nshell();
+    const auto& shell_pairs = eri_computers_["4-Center"][0]->shell_pairs();
+    size_t npair = shell_pairs.size();
+
+    // => Shell-Pair Centers and Extents <= //
+
+    // A primitive product of exponent zeta acts as a point charge, to within cutoff_,
+    // beyond sqrt(2 / zeta) erfc^-1(cutoff_) of its center (White and Head-Gordon)
+    double erfc_cutoff = erfc_inverse(std::min(cutoff_, 0.5));
+
+    std::vector<std::array<double, 3>> centers(npair);
+    std::vector<double> extents(npair, 0.0);
+
+#pragma omp parallel for num_threads(nthreads_)
+    for (size_t PQ = 0; PQ < npair; PQ++) {
+        const auto& sP = primary_->shell(shell_pairs[PQ].first);
+        const auto& sQ = primary_->shell(shell_pairs[PQ].second);
+        const double* A = sP.center();
+        const double* B = sQ.center();
+
+        // primitive product centers, expanded about the most diffuse one
+        double zeta_min = std::numeric_limits<double>::max();
+        for (int p = 0; p < sP.nprimitive(); p++) {
+            for (int q = 0; q < sQ.nprimitive(); q++) {
+                double a = sP.exp(p), b = sQ.exp(q);
+                if (a + b < zeta_min) {
+                    zeta_min = a + b;
+                    for (int x = 0; x < 3; x++) centers[PQ][x] = (a * A[x] + b * B[x]) / (a + b);
+                }
+            }
+        }
+        for (int p = 0; p < sP.nprimitive(); p++) {
+            for (int q = 0; q < sQ.nprimitive(); q++) {
+                double a = sP.exp(p), b = sQ.exp(q);
+                double dist2 = 0.0;
+                for (int x = 0; x < 3; x++) {
+                    double dx = (a * A[x] + b * B[x]) / (a + b) - centers[PQ][x];
+                    dist2 += dx * dx;
+                }
+                extents[PQ] = std::max(extents[PQ], std::sqrt(dist2) + std::sqrt(2.0 / (a + b)) * erfc_cutoff);
+            }
+        }
+    }
 
-    if (!lr_symmetric_) {
-        throw PSIEXCEPTION("Non-symmetric K matrix builds are currently not supported in the LinK algorithm.");
+    // => Cells <= //
+
+    // Pairs are sorted into cubic boxes by center and into branches by extent,
+    // so that compact pairs are not held back by diffuse ones sharing their box
+    std::array<double, 3> origin = {std::numeric_limits<double>::max(), std::numeric_limits<double>::max(),
+                                    std::numeric_limits<double>::max()};
+    for (const auto& C : centers) {
+        for (int x = 0; x < 3; x++) origin[x] = std::min(origin[x], C[x]);
     }
 
-    // ==> Prep Auxiliary Quantities <== //
+    std::map<std::array<int, 4>, int> cell_index;
+    std::vector<std::array<int, 4>> cell_keys;
+    cfmm_cell_pairs_.clear();
+    for (size_t PQ = 0; PQ < npair; PQ++) {
+        std::array<int, 4> key;
+        for (int x = 0; x < 3; x++) key[x] = (int)std::floor((centers[PQ][x] - origin[x]) / cfmm_box_length_);
+        key[3] = (int)std::floor(extents[PQ] / cfmm_box_length_);
+
+        auto it = cell_index.find(key);
+        if (it == cell_index.end()) {
+            it = cell_index.emplace(key, cell_keys.size()).first;
+            cell_keys.push_back(key);
+            cfmm_cell_pairs_.emplace_back();
+        }
+        cfmm_cell_pairs_[it->second].push_back(shell_pairs[PQ]);
+    }
+    size_t ncell = cell_keys.size();
+
+    // expansion center (box center) and radius enclosing every distribution of each cell
+    cfmm_cell_centers_.resize(ncell);
+    std::vector<double> radii(ncell, 0.0);
+    for (size_t A = 0; A < ncell; A++) {
+        for (int x = 0; x < 3; x++) cfmm_cell_centers_[A][x] = origin[x] + (cell_keys[A][x] + 0.5) * cfmm_box_length_;
+    }
+    for (size_t PQ = 0; PQ < npair; PQ++) {
+        std::array<int, 4> key;
+        for (int x = 0; x < 3; x++) key[x] = (int)std::floor((centers[PQ][x] - origin[x]) / cfmm_box_length_);
+        key[3] = (int)std::floor(extents[PQ] / cfmm_box_length_);
+        int A = cell_index[key];
+        double dist2 = 0.0;
+        for (int x = 0; x < 3; x++) {
+            double dx = centers[PQ][x] - cfmm_cell_centers_[A][x];
+            dist2 += dx * dx;
+        }
+        radii[A] = std::max(radii[A], std::sqrt(dist2) + extents[PQ]);
+    }
+
+    // => Cell Pairs <= //
+
+    cfmm_near_cells_.clear();
+    cfmm_far_cells_.assign(ncell, std::vector<int>());
+    for (int A = 0; A < ncell; A++) {
+        for (int B = A; B < ncell; B++) {
+            double dist2 = 0.0;
+            for (int x = 0; x < 3; x++) {
+                double dx = cfmm_cell_centers_[A][x] - cfmm_cell_centers_[B][x];
+                dist2 += dx * dx;
+            }
+            if (A != B && std::sqrt(dist2) >= cfmm_separation_ * (radii[A] + radii[B])) {
+                cfmm_far_cells_[A].push_back(B);
+                cfmm_far_cells_[B].push_back(A);
+            } else {
+                cfmm_near_cells_.emplace_back(A, B);
+            }
+        }
+    }
+
+    // => Multipole Machinery <= //
+
+    cfmm_comps_.clear();
+    for (int l = 0; l <= cfmm_order_; l++) {
+        for (int ii = 0; ii <= l; ii++) {
+            int lx = l - ii;
+            for (int lz = 0; lz <= ii; lz++) {
+                int ly = ii - lz;
+                cfmm_comps_.push_back({lx, ly, lz});
+            }
+        }
+    }
+
+    IntegralFactory factory(primary_);
+    cfmm_mpole_ints_.resize(nthreads_);
+    cfmm_overlap_ints_.resize(nthreads_);
+    for (int rank = 0; rank < nthreads_; rank++) {
+        cfmm_mpole_ints_[rank] = std::shared_ptr<OneBodyAOInt>(factory.ao_multipoles(cfmm_order_));
+        cfmm_overlap_ints_[rank] = std::shared_ptr<OneBodyAOInt>(factory.ao_overlap());
+    }
+
+    if (debug_) {
+        outfile->Printf("  ==> CFMM: Cells <==\n\n");
+        for (size_t A = 0; A < ncell; A++) {
+            outfile->Printf("  Cell %6zu: Box (%4d,%4d,%4d), Branch %3d, Pairs %6zu, Radius %8.3f, Far Cells %6zu\n", A,
+                            cell_keys[A][0], cell_keys[A][1], cell_keys[A][2], cell_keys[A][3],
+                            cfmm_cell_pairs_[A].size(), radii[A], cfmm_far_cells_[A].size());
+        }
+        outfile->Printf("\n");
+    }
+}
+
+// build the J matrix using the continuous fast multipole method of White, Johnson, Gill, and Head-Gordon
+// (pq|rs) = sum_ab M_a^pq / a! (-1)^|b| M_b^rs / b! d^(a+b) |R_AB|^-1, for pq and rs in well-separated cells A and B
+void CompositeJK::build_CFMMJ(std::vector<std::shared_ptr<Matrix>>& D, std::vector<std::shared_ptr<Matrix>>& J) {
+
+    timer_on("Setup");
 
     // => Sizing <= //
-    int nshell = primary_->nshell();
+    int njk = D.size();
     int nbf = primary_->nbf();
-    int nthread = nthreads_;
+    size_t ncell = cfmm_cell_pairs_.size();
+    size_t ncomp = cfmm_comps_.size();
+    int tdim = 2 * cfmm_order_ + 1;
+
+    // 1 / a! and (-1)^|a| for each multipole component
+    std::vector<double> inv_fact(ncomp), parity(ncomp);
+    for (size_t a = 0; a < ncomp; a++) {
+        double fact = 1.0;
+        for (int x = 0; x < 3; x++) {
+            for (int k = 2; k <= cfmm_comps_[a][x]; k++) fact *= k;
+        }
+        inv_fact[a] = 1.0 / fact;
+        parity[a] = ((cfmm_comps_[a][0] + cfmm_comps_[a][1] + cfmm_comps_[a][2]) % 2 ? -1.0 : 1.0);
+    }
 
-    // => Atom Blocking <= //
-    std::vector<int> shell_endpoints_for_atom;
-    std::vector<int> basis_endpoints_for_shell;
+    // one shared J per density, so memory does not grow with the thread count
+    // only the P >= Q shell blocks are accumulated, the rest follows by symmetry
+    std::vector<SharedMatrix> JS(njk);
+    for (size_t jki = 0; jki < njk; jki++) {
+        JS[jki] = std::make_shared<Matrix>(nbf, nbf);
+    }
 
-    int atomic_ind = -1;
-    for (int P = 0; P < nshell; P++) {
-        if (primary_->shell(P).ncenter() > atomic_ind) {
-            shell_endpoints_for_atom.push_back(P);
-            atomic_ind++;
+    // offsets of the shell pair blocks of each cell within the cell-local tiles
+    std::vector<std::vector<size_t>> pair_offset(ncell);
+    std::vector<size_t> cell_size(ncell, 0);
+    size_t max_cell_size = 0;
+    for (size_t A = 0; A < ncell; A++) {
+        for (const auto& [P, Q] : cfmm_cell_pairs_[A]) {
+            pair_offset[A].push_back(cell_size[A]);
+            cell_size[A] += (size_t)primary_->shell(P).nfunction() * primary_->shell(Q).nfunction();
+        }
+        max_cell_size = std::max(max_cell_size, cell_size[A]);
+    }
+
+    // per-thread tiles for the bra and ket cells of the current near-field task,
+    // flushed into JS with atomic adds once the task is done
+    std::vector<std::vector<double>> Jbra(nthreads_), Jket(nthreads_);
+    auto flush_tile = [&](size_t A, const double* tile) {
+        const auto& pairs = cfmm_cell_pairs_[A];
+        for (size_t jki = 0; jki < njk; jki++) {
+            auto JSp = JS[jki]->pointer();
+            const double* tile_jk = tile + jki * cell_size[A];
+            for (size_t i = 0; i < pairs.size(); i++) {
+                int np = primary_->shell(pairs[i].first).nfunction();
+                int pstart = primary_->shell(pairs[i].first).function_index();
+                int nq = primary_->shell(pairs[i].second).nfunction();
+                int qstart = primary_->shell(pairs[i].second).function_index();
+                const double* block = tile_jk + pair_offset[A][i];
+                for (int p = 0; p < np; p++) {
+                    for (int q = 0; q < nq; q++) {
+#pragma omp atomic
+                        JSp[pstart + p][qstart + q] += block[p * nq + q];
+                    }
+                }
+            }
+        }
+    };
+
+    // Multipoles (about the cell center) of shell pair PQ: -MultipoleInt gives the electronic moments,
+    // stored as moments[a * nP * nQ + pq] for component a
+    auto pair_moments = [&](int rank, int P, int Q, const std::array<double, 3>& center, std::vector<double>& moments) {
+        size_t npq = (size_t)primary_->shell(P).nfunction() * primary_->shell(Q).nfunction();
+        moments.resize(ncomp * npq);
+
+        cfmm_overlap_ints_[rank]->compute_shell(P, Q);
+        const double* Sbuf = cfmm_overlap_ints_[rank]->buffers()[0];
+        std::copy(Sbuf, Sbuf + npq, moments.begin());
+
+        cfmm_mpole_ints_[rank]->set_origin(Vector3(center[0], center[1], center[2]));
+        cfmm_mpole_ints_[rank]->compute_shell(P, Q);
+        const auto& buffers = cfmm_mpole_ints_[rank]->buffers();
+        for (size_t a = 1; a < ncomp; a++) {
+            const double* Mbuf = buffers[a - 1];
+            for (size_t pq = 0; pq < npq; pq++) moments[a * npq + pq] = -Mbuf[pq];
+        }
+    };
+
+    // D_rs + D_sr for R != S (both orders of an off-diagonal shell pair appear once), D_rs otherwise
+    auto Deff = [](double** Dp, int R, int S, int r, int s) { return (R == S ? Dp[r][s] : Dp[r][s] + Dp[s][r]); };
+
+    timer_off("Setup");
+
+    // => Near Field <= //
+
+    // four-center ERIs between non-separated cells, one bra-ket order per shell quartet
+    timer_on("Near Field");
+
+    size_t computed_shells = 0L;
+
+#pragma omp parallel for schedule(dynamic) num_threads(nthreads_) reduction(+ : computed_shells)
+    for (size_t AB = 0; AB < cfmm_near_cells_.size(); AB++) {
+        int rank = 0;
+#ifdef _OPENMP
+        rank = omp_get_thread_num();
+#endif
+        int A = cfmm_near_cells_[AB].first;
+        int B = cfmm_near_cells_[AB].second;
+        const auto& bra_pairs = cfmm_cell_pairs_[A];
+        const auto& ket_pairs = cfmm_cell_pairs_[B];
+
+        auto& bra_tile = Jbra[rank];
+        auto& ket_tile = Jket[rank];
+        if (bra_tile.size() < njk * max_cell_size) {
+            bra_tile.resize(njk * max_cell_size);
+            ket_tile.resize(njk * max_cell_size);
         }
-        basis_endpoints_for_shell.push_back(primary_->shell_to_basis_function(P));
+        std::fill(bra_tile.begin(), bra_tile.begin() + njk * cell_size[A], 0.0);
+        std::fill(ket_tile.begin(), ket_tile.begin() + njk * cell_size[B], 0.0);
+
+        for (size_t i = 0; i < bra_pairs.size(); i++) {
+            int P = bra_pairs[i].first;
+            int Q = bra_pairs[i].second;
+            size_t jmax = (A == B ? i + 1 : ket_pairs.size());
+            for (size_t j = 0; j < jmax; j++) {
+                int R = ket_pairs[j].first;
+                int S = ket_pairs[j].second;
+                bool same_pair = (A == B && i == j);
+
+                if (!eri_computers_["4-Center"][rank]->shell_significant(P, Q, R, S)) continue;
+                if (eri_computers_["4-Center"][rank]->compute_shell(P, Q, R, S) == 0) continue;
+                computed_shells++;
+
+                const double* buffer = eri_computers_["4-Center"][rank]->buffer();
+
+                int np = primary_->shell(P).nfunction();
+                int pstart = primary_->shell(P).function_index();
+                int nq = primary_->shell(Q).nfunction();
+                int qstart = primary_->shell(Q).function_index();
+                int nr = primary_->shell(R).nfunction();
+                int rstart = primary_->shell(R).function_index();
+                int ns = primary_->shell(S).nfunction();
+                int sstart = primary_->shell(S).function_index();
+
+                for (size_t jki = 0; jki < njk; jki++) {
+                    double* JPQ = bra_tile.data() + jki * cell_size[A] + pair_offset[A][i];
+                    double* JRS = ket_tile.data() + jki * cell_size[B] + pair_offset[B][j];
+                    auto Dp = D[jki]->pointer();
+
+                    for (int p = pstart, index = 0; p < pstart + np; p++) {
+                        for (int q = qstart; q < qstart + nq; q++) {
+                            double Dpq = Deff(Dp, P, Q, p, q);
+                            double Jpq = 0.0;
+                            for (int r = 0; r < nr; r++) {
+                                for (int s = 0; s < ns; s++, index++) {
+                                    Jpq += buffer[index] * Deff(Dp, R, S, rstart + r, sstart + s);
+                                    if (!same_pair) JRS[r * ns + s] += buffer[index] * Dpq;
+                                }
+                            }
+                            JPQ[(p - pstart) * nq + q - qstart] += Jpq;
+                        }
+                    }
+                }
+            }
+        }
+
+        flush_tile(A, bra_tile.data());
+        flush_tile(B, ket_tile.data());
     }
-    shell_endpoints_for_atom.push_back(nshell);
-    basis_endpoints_for_shell.push_back(nbf);
 
-    size_t natom = shell_endpoints_for_atom.size() - 1;
+    timer_off("Near Field");
+
+    // => Far Field <= //
 
-    size_t max_functions_per_atom = 0L;
-    for (size_t atom = 0; atom < natom; atom++) {
-        size_t size = 0L;
-        for (int P = shell_endpoints_for_atom[atom]; P < shell_endpoints_for_atom[atom + 1]; P++) {
-            size += primary_->shell(P).nfunction();
+    timer_on("Far Field");
+
+    // scaled density multipoles of each cell, Q_a = sum_rs D_rs M_a^rs / a!
+    std::vector<std::vector<std::vector<double>>> Qcell(njk, std::vector<std::vector<double>>(ncell));
+    for (size_t jki = 0; jki < njk; jki++) {
+        for (size_t A = 0; A < ncell; A++) {
+            if (!cfmm_far_cells_[A].empty()) Qcell[jki][A].assign(ncomp, 0.0);
         }
-        max_functions_per_atom = std::max(max_functions_per_atom, size);
     }
 
-    if (debug_) {
-        outfile->Printf("  ==> LinK: Atom Blocking <==\n\n");
-        for (size_t atom = 0; atom < natom; atom++) {
-            outfile->Printf("  Atom: %3d, Atom Start: %4d, Atom End: %4d\n", atom, shell_endpoints_for_atom[atom],
-                            shell_endpoints_for_atom[atom + 1]);
-            for (int P = shell_endpoints_for_atom[atom]; P < shell_endpoints_for_atom[atom + 1]; P++) {
-                int size = primary_->shell(P).nfunction();
-                int off = primary_->shell(P).function_index();
-                int off2 = basis_endpoints_for_shell[P];
-                outfile->Printf("    Shell: %4d, Size: %4d, Offset: %4d, Offset2: %4d\n", P, size, off,
-                                off2);
+#pragma omp parallel for schedule(dynamic) num_threads(nthreads_)
+    for (size_t A = 0; A < ncell; A++) {
+        if (cfmm_far_cells_[A].empty()) continue;
+        int rank = 0;
+#ifdef _OPENMP
+        rank = omp_get_thread_num();
+#endif
+        std::vector<double> moments;
+        for (const auto& [P, Q] : cfmm_cell_pairs_[A]) {
+            pair_moments(rank, P, Q, cfmm_cell_centers_[A], moments);
+            int np = primary_->shell(P).nfunction();
+            int pstart = primary_->shell(P).function_index();
+            int nq = primary_->shell(Q).nfunction();
+            int qstart = primary_->shell(Q).function_index();
+            size_t npq = (size_t)np * nq;
+
+            for (size_t jki = 0; jki < njk; jki++) {
+                auto Dp = D[jki]->pointer();
+                std::vector<double> Dpq(npq);
+                for (int p = 0; p < np; p++) {
+                    for (int q = 0; q < nq; q++) Dpq[p * nq + q] = Deff(Dp, P, Q, pstart + p, qstart + q);
+                }
+                auto& QA = Qcell[jki][A];
+                for (size_t a = 0; a < ncomp; a++) {
+                    QA[a] += C_DDOT(npq, &moments[a * npq], 1, Dpq.data(), 1) * inv_fact[a];
+                }
             }
         }
-        outfile->Printf("\n");
     }
 
-    // ==> Prep Atom Pairs <== //
-    // Atom-pair blocking inherited from DirectJK code
-    // TODO: Test shell-pair blocking
-
-    std::vector<std::pair<int, int>> atom_pairs;
-    for (size_t Patom = 0; Patom < natom; Patom++) {
-        for (size_t Qatom = 0; Qatom <= Patom; Qatom++) {
-            bool found = false;
-            for (int P = shell_endpoints_for_atom[Patom]; P < shell_endpoints_for_atom[Patom + 1]; P++) {
-                for (int Q = shell_endpoints_for_atom[Qatom]; Q < shell_endpoints_for_atom[Qatom + 1]; Q++) {
-                    if (eri_computers_["4-Center"][0]->shell_pair_significant(P, Q)) {
-                        found = true;
-                        atom_pairs.emplace_back(Patom, Qatom);
-                        break;
+    // expansion coefficients of the far-field potential in each cell,
+    // V_a = sum_B sum_b (-1)^|b| Q_b^B d^(a+b) |R_AB|^-1
+    std::vector<std::vector<std::vector<double>>> Vcell(njk, std::vector<std::vector<double>>(ncell));
+
+#pragma omp parallel for schedule(dynamic) num_threads(nthreads_)
+    for (size_t A = 0; A < ncell; A++) {
+        if (cfmm_far_cells_[A].empty()) continue;
+        std::vector<double> T, work;
+        for (size_t jki = 0; jki < njk; jki++) Vcell[jki][A].assign(ncomp, 0.0);
+
+        for (const int B : cfmm_far_cells_[A]) {
+            std::array<double, 3> RAB;
+            for (int x = 0; x < 3; x++) RAB[x] = cfmm_cell_centers_[A][x] - cfmm_cell_centers_[B][x];
+            coulomb_derivatives(2 * cfmm_order_, RAB, T, work);
+
+            for (size_t jki = 0; jki < njk; jki++) {
+                const auto& QB = Qcell[jki][B];
+                auto& VA = Vcell[jki][A];
+                for (size_t a = 0; a < ncomp; a++) {
+                    const auto& ca = cfmm_comps_[a];
+                    double val = 0.0;
+                    for (size_t b = 0; b < ncomp; b++) {
+                        const auto& cb = cfmm_comps_[b];
+                        size_t index = ((size_t)(ca[0] + cb[0]) * tdim + ca[1] + cb[1]) * tdim + ca[2] + cb[2];
+                        val += parity[b] * QB[b] * T[index];
+                    }
+                    VA[a] += val;
+                }
+            }
+        }
+    }
+
+    // J_pq += sum_a M_a^pq / a! V_a; each shell pair belongs to exactly one cell,
+    // so the threads write disjoint blocks of JS
+#pragma omp parallel for schedule(dynamic) num_threads(nthreads_)
+    for (size_t A = 0; A < ncell; A++) {
+        if (cfmm_far_cells_[A].empty()) continue;
+        int rank = 0;
+#ifdef _OPENMP
+        rank = omp_get_thread_num();
+#endif
+        std::vector<double> moments;
+        for (const auto& [P, Q] : cfmm_cell_pairs_[A]) {
+            pair_moments(rank, P, Q, cfmm_cell_centers_[A], moments);
+            int np = primary_->shell(P).nfunction();
+            int pstart = primary_->shell(P).function_index();
+            int nq = primary_->shell(Q).nfunction();
+            int qstart = primary_->shell(Q).function_index();
+            size_t npq = (size_t)np * nq;
+
+            for (size_t jki = 0; jki < njk; jki++) {
+                auto JSp = JS[jki]->pointer();
+                const auto& VA = Vcell[jki][A];
+                for (size_t a = 0; a < ncomp; a++) {
+                    double coef = VA[a] * inv_fact[a];
+                    for (int p = 0; p < np; p++) {
+                        for (int q = 0; q < nq; q++) JSp[pstart + p][qstart + q] += coef * moments[a * npq + p * nq + q];
                     }
                 }
-                if (found) break;
             }
         }
     }
 
+    timer_off("Far Field");
+
+    num_computed_shells_ = computed_shells;
+    stats_.shells_computed += num_computed_shells_;
+    if (get_bench()) {
+        computed_shells_per_iter_["CFMM Quartets"].push_back(num_computed_shells());
+    }
+
+    // => Reduction and Symmetrization <= //
+
+    int nshell = primary_->nshell();
+    for (size_t jki = 0; jki < njk; jki++) {
+        auto Jsum = JS[jki];
+        auto Jsump = Jsum->pointer();
+        for (int P = 0; P < nshell; P++) {
+            int np = primary_->shell(P).nfunction();
+            int pstart = primary_->shell(P).function_index();
+            for (int Q = 0; Q < P; Q++) {
+                int nq = primary_->shell(Q).nfunction();
+                int qstart = primary_->shell(Q).function_index();
+                for (int p = pstart; p < pstart + np; p++) {
+                    for (int q = qstart; q < qstart + nq; q++) Jsump[q][p] = Jsump[p][q];
+                }
+            }
+        }
+        J[jki]->add(Jsum);
+    }
+}
+
+// build the K matrix using Ochsenfelds's Linear Exchange (LinK) algorithm 
+// To follow this code, compare with figure 1 of DOI: 10.1063/1.476741
+void CompositeJK::build_linK(std::vector<SharedMatrix>& D, std::vector<SharedMatrix>& K) {
+
+    if (!lr_symmetric_) {
+        throw PSIEXCEPTION("Non-symmetric K matrix builds are currently not supported in the LinK algorithm.");
+    }
+
+    // ==> Prep Auxiliary Quantities <== //
+
+    // => Sizing <= //
+    int nshell = primary_->nshell();
+    int nbf = primary_->nbf();
+    int nthread = nthreads_;
+
     // ==> Start "Pre-ordering and pre-selection to find significant elements in P_uv" in Fig. 1 of paper <== //
     
     // ==> Prep Bra-Bra Shell Pairs <== //
@@ -969,24 +1489,47 @@ void CompositeJK::build_linK(std::vector<SharedMatrix>& D, std::vector<SharedMat
         }
     }
 
-    size_t natom_pair = atom_pairs.size();
-
     // ==> End "Pre-ordering and pre-selection to find significant elements in P_uv" in Fig. 1 of paper <== //
-    
-    // ==> Intermediate Buffers <== //
 
-    // Temporary buffers used during the K contraction process to
-    // Take full advantage of permutational symmetry of ERIs
-    std::vector<std::vector<SharedMatrix>> KT;
+    // ==> Prep Bra Shell Pair Tasks <== //
+
+    // Every significant bra shell pair PQ is one task. The cost of a task scales with the size of the
+    // shell pair and the length of its ket mini-lists, which varies widely in heterogeneous systems,
+    // so the tasks are handed out to the threads from the most expensive one down.
+    std::vector<std::pair<int, int>> bra_pairs;
+    std::vector<std::pair<int, double>> bra_pair_costs;
+    for (int P = 0; P < nshell; P++) {
+        for (int Q = 0; Q <= P; Q++) {
+            if (!eri_computers_["4-Center"][0]->shell_pair_significant(P, Q)) continue;
+            double cost = primary_->shell(P).nfunction() * primary_->shell(Q).nfunction() *
+                          static_cast<double>(significant_kets[P].size() + significant_kets[Q].size());
+            bra_pair_costs.emplace_back(bra_pairs.size(), cost);
+            bra_pairs.emplace_back(P, Q);
+        }
+    }
+    std::stable_sort(bra_pair_costs.begin(), bra_pair_costs.end(), screen_compare);
+
+    size_t ntask = bra_pairs.size();
+
+    if (debug_) {
+        outfile->Printf("  ==> LinK: Bra Shell Pair Tasks <==\n\n");
+        outfile->Printf("    Number of tasks: %zu\n", ntask);
+        if (ntask) {
+            outfile->Printf("    Largest cost:    %.3e\n", bra_pair_costs.front().second);
+            outfile->Printf("    Smallest cost:   %.3e\n", bra_pair_costs.back().second);
+        }
+        outfile->Printf("\n");
+    }
 
-    // To prevent race conditions, give every thread a buffer
+    // ==> Intermediate Buffers <== //
+
+    // Every thread accumulates its contributions to K in a K tile of its own,
+    // the tiles are reduced into K once all tasks are done
+    std::vector<std::vector<SharedMatrix>> KT(nthread);
     for (int thread = 0; thread < nthread; thread++) {
-        std::vector<SharedMatrix> K2;
         for (size_t ind = 0; ind < D.size(); ind++) {
-            // (pq|rs) can be contracted into Kpr, Kps, Kqr, Kqs (hence the 4)
-            K2.push_back(std::make_shared<Matrix>("KT (linK)", 4 * max_functions_per_atom, nbf));
+            KT[thread].push_back(std::make_shared<Matrix>("KT (linK)", nbf, nbf));
         }
-        KT.push_back(K2);
     }
 
     // ==> Start "Loop over significant 'bra'-shell pairs uh" in Fig. 1 of paper <== //
@@ -998,236 +1541,123 @@ void CompositeJK::build_linK(std::vector<SharedMatrix>& D, std::vector<SharedMat
     // ==> Integral Formation Loop <== //
 
 #pragma omp parallel for num_threads(nthread) schedule(dynamic) reduction(+ : computed_shells)
-    for (size_t ipair = 0L; ipair < natom_pair; ipair++) { // O(N) shell-pairs in asymptotic limit
-        int Patom = atom_pairs[ipair].first;
-        int Qatom = atom_pairs[ipair].second;
-
-        // Number of shells per atom
-        int nPshell = shell_endpoints_for_atom[Patom + 1] - shell_endpoints_for_atom[Patom];
-        int nQshell = shell_endpoints_for_atom[Qatom + 1] - shell_endpoints_for_atom[Qatom];
-
-        // First shell per atom
-        int Pstart = shell_endpoints_for_atom[Patom];
-        int Qstart = shell_endpoints_for_atom[Qatom];
-
-        // Number of basis functions per atom
-        int nPbasis = basis_endpoints_for_shell[Pstart + nPshell] - basis_endpoints_for_shell[Pstart];
-        int nQbasis = basis_endpoints_for_shell[Qstart + nQshell] - basis_endpoints_for_shell[Qstart];
+    for (size_t task = 0L; task < ntask; task++) { // O(N) shell-pairs in asymptotic limit
+        int P = bra_pairs[bra_pair_costs[task].first].first;
+        int Q = bra_pairs[bra_pair_costs[task].first].second;
 
         int thread = 0;
 #ifdef _OPENMP
         thread = omp_get_thread_num();
 #endif
 
-        // Keep track of contraction indices for stripeout (Towards end of this function)
-        std::vector<std::unordered_set<int>> P_stripeout_list(nPshell);
-        std::vector<std::unordered_set<int>> Q_stripeout_list(nQshell);
-
-        bool touched = false;
-        for (int P = Pstart; P < Pstart + nPshell; P++) {
-            for (int Q = Qstart; Q < Qstart + nQshell; Q++) {
-
-                if (Q > P) continue;
-                if (!eri_computers_["4-Center"][0]->shell_pair_significant(P, Q)) continue;
-
-                int dP = P - Pstart;
-                int dQ = Q - Qstart;
-
-                // => Start "Formation of Significant Shell Pair List ML" in Fig. 1 of Paper <= //
-
-                // Significant ket shell pairs RS for bra shell pair PQ
-                // represents the merge of ML_P and ML_Q (mini-lists) as defined in Oschenfeld
-                // Unordered set structure allows for automatic merging as new elements are added
-                std::unordered_set<int> ML_PQ;
-
-                // Form ML_P as part of ML_PQ
-                for (const int R : significant_kets[P]) {
-                    bool is_significant = false;
-                    for (const int S : significant_bras[R]) {
-                        double screen_val = eri_computers_["4-Center"][0]->shell_pair_max_density(P, R) * std::sqrt(eri_computers_["4-Center"][0]->shell_ceiling2(P, Q, R, S));
-
-                        if (screen_val >= linK_ints_cutoff_) {
-                            if (!is_significant) is_significant = true;
-                            int RS = (R >= S) ? (R * nshell + S) : (S * nshell + R);
-                            if (RS > P * nshell + Q) continue;
-                            ML_PQ.emplace(RS);
-                            Q_stripeout_list[dQ].emplace(S);
-                        }
-                        else break;
-                    }
-                    if (!is_significant) break;
-                }
-
-                // Form ML_Q as part of ML_PQ
-                for (const int R : significant_kets[Q]) {
-                    bool is_significant = false;
-                    for (const int S : significant_bras[R]) {
-                        double screen_val = eri_computers_["4-Center"][0]->shell_pair_max_density(Q, R) * std::sqrt(eri_computers_["4-Center"][0]->shell_ceiling2(P, Q, R, S));
-
-                        if (screen_val >= linK_ints_cutoff_) {
-                            if (!is_significant) is_significant = true;
-                            int RS = (R >= S) ? (R * nshell + S) : (S * nshell + R);
-                            if (RS > P * nshell + Q) continue;
-                            ML_PQ.emplace(RS);
-                            P_stripeout_list[dP].emplace(S);
-                        }
-                        else break;
+        // => Start "Formation of Significant Shell Pair List ML" in Fig. 1 of Paper <= //
+
+        // Significant ket shell pairs RS for bra shell pair PQ
+        // represents the merge of ML_P and ML_Q (mini-lists) as defined in Oschenfeld
+        // The ket lists are sorted by magnitude, so each mini-list ends at the first insignificant entry
+        std::vector<int> ML_PQ;
+
+        // Form ML_P and ML_Q as parts of ML_PQ
+        for (const int B : {P, Q}) {
+            for (const int R : significant_kets[B]) {
+                bool is_significant = false;
+                for (const int S : significant_bras[R]) {
+                    double screen_val = eri_computers_["4-Center"][0]->shell_pair_max_density(B, R) * std::sqrt(eri_computers_["4-Center"][0]->shell_ceiling2(P, Q, R, S));
+
+                    if (screen_val >= linK_ints_cutoff_) {
+                        if (!is_significant) is_significant = true;
+                        int RS = (R >= S) ? (R * nshell + S) : (S * nshell + R);
+                        if (RS > P * nshell + Q) continue;
+                        ML_PQ.push_back(RS);
                     }
-                    if (!is_significant) break;
+                    else break;
                 }
+                if (!is_significant) break;
+            }
+        }
+        std::sort(ML_PQ.begin(), ML_PQ.end());
+        ML_PQ.erase(std::unique(ML_PQ.begin(), ML_PQ.end()), ML_PQ.end());
 
-                // Loop over significant RS pairs
-                for (const int RS : ML_PQ) {
+        // Number of basis functions in shells P, Q and their starting indices
+        int shell_P_nfunc = primary_->shell(P).nfunction();
+        int shell_Q_nfunc = primary_->shell(Q).nfunction();
+        int shell_P_start = primary_->shell(P).function_index();
+        int shell_Q_start = primary_->shell(Q).function_index();
 
-                    int R = RS / nshell;
-                    int S = RS % nshell;
+        // Loop over significant RS pairs
+        for (const int RS : ML_PQ) {
 
-                    if (!eri_computers_["4-Center"][0]->shell_pair_significant(R, S)) continue;
-                    if (!eri_computers_["4-Center"][0]->shell_significant(P, Q, R, S)) continue;
+            int R = RS / nshell;
+            int S = RS % nshell;
 
-                    if (eri_computers_["4-Center"][thread]->compute_shell(P, Q, R, S) == 0)
-                        continue;
-                    computed_shells++;
+            if (!eri_computers_["4-Center"][0]->shell_pair_significant(R, S)) continue;
+            if (!eri_computers_["4-Center"][0]->shell_significant(P, Q, R, S)) continue;
 
-                    const double* buffer = eri_computers_["4-Center"][thread]->buffer();
+            if (eri_computers_["4-Center"][thread]->compute_shell(P, Q, R, S) == 0)
+                continue;
+            computed_shells++;
 
-                    // Number of basis functions in shells P, Q, R, S
-                    int shell_P_nfunc = primary_->shell(P).nfunction();
-                    int shell_Q_nfunc = primary_->shell(Q).nfunction();
-                    int shell_R_nfunc = primary_->shell(R).nfunction();
-                    int shell_S_nfunc = primary_->shell(S).nfunction();
+            const double* buffer = eri_computers_["4-Center"][thread]->buffer();
 
-                    // Basis Function Starting index for shell
-                    int shell_P_start = primary_->shell(P).function_index();
-                    int shell_Q_start = primary_->shell(Q).function_index();
-                    int shell_R_start = primary_->shell(R).function_index();
-                    int shell_S_start = primary_->shell(S).function_index();
+            // Number of basis functions in shells R, S
+            int shell_R_nfunc = primary_->shell(R).nfunction();
+            int shell_S_nfunc = primary_->shell(S).nfunction();
 
-                    // Basis Function offset from first basis function in the atom
-                    int shell_P_offset = basis_endpoints_for_shell[P] - basis_endpoints_for_shell[Pstart];
-                    int shell_Q_offset = basis_endpoints_for_shell[Q] - basis_endpoints_for_shell[Qstart];
+            // Basis Function Starting index for shell
+            int shell_R_start = primary_->shell(R).function_index();
+            int shell_S_start = primary_->shell(S).function_index();
 
-                    for (size_t ind = 0; ind < D.size(); ind++) {
-                        double** Kp = K[ind]->pointer();
-                        double** Dp = D[ind]->pointer();
-                        double** KTp = KT[thread][ind]->pointer();
-                        const double* buffer2 = buffer;
+            double prefactor = 1.0;
+            if (P == Q) prefactor *= 0.5;
+            if (R == S) prefactor *= 0.5;
+            if (P == R && Q == S) prefactor *= 0.5;
 
-                        if (!touched) {
-                            ::memset((void*)KTp[0L * max_functions_per_atom], '\0', nPbasis * nbf * sizeof(double));
-                            ::memset((void*)KTp[1L * max_functions_per_atom], '\0', nPbasis * nbf * sizeof(double));
-                            ::memset((void*)KTp[2L * max_functions_per_atom], '\0', nQbasis * nbf * sizeof(double));
-                            ::memset((void*)KTp[3L * max_functions_per_atom], '\0', nQbasis * nbf * sizeof(double));
-                        }
+            for (size_t ind = 0; ind < D.size(); ind++) {
+                double** Dp = D[ind]->pointer();
+                double** KTp = KT[thread][ind]->pointer();
+                const double* buffer2 = buffer;
 
-                        // Four pointers needed for PR, PS, QR, QS
-                        double* K1p = KTp[0L * max_functions_per_atom];
-                        double* K2p = KTp[1L * max_functions_per_atom];
-                        double* K3p = KTp[2L * max_functions_per_atom];
-                        double* K4p = KTp[3L * max_functions_per_atom];
-
-                        double prefactor = 1.0;
-                        if (P == Q) prefactor *= 0.5;
-                        if (R == S) prefactor *= 0.5;
-                        if (P == R && Q == S) prefactor *= 0.5;
-
-                        // => Computing integral contractions to K buffers <= //
-                        for (int p = 0; p < shell_P_nfunc; p++) {
-                            for (int q = 0; q < shell_Q_nfunc; q++) {
-                                for (int r = 0; r < shell_R_nfunc; r++) {
-                                    for (int s = 0; s < shell_S_nfunc; s++) {
-
-                                        K1p[(p + shell_P_offset) * nbf + r + shell_R_start] +=
-                                            prefactor * (Dp[q + shell_Q_start][s + shell_S_start]) * (*buffer2);
-                                        K2p[(p + shell_P_offset) * nbf + s + shell_S_start] +=
-                                            prefactor * (Dp[q + shell_Q_start][r + shell_R_start]) * (*buffer2);
-                                        K3p[(q + shell_Q_offset) * nbf + r + shell_R_start] +=
-                                            prefactor * (Dp[p + shell_P_start][s + shell_S_start]) * (*buffer2);
-                                        K4p[(q + shell_Q_offset) * nbf + s + shell_S_start] +=
-                                            prefactor * (Dp[p + shell_P_start][r + shell_R_start]) * (*buffer2);
-
-                                        buffer2++;
-                                    }
-                                }
+                // => Computing integral contractions to K tiles (PR, PS, QR, QS) <= //
+                for (int p = 0; p < shell_P_nfunc; p++) {
+                    for (int q = 0; q < shell_Q_nfunc; q++) {
+                        for (int r = 0; r < shell_R_nfunc; r++) {
+                            for (int s = 0; s < shell_S_nfunc; s++) {
+
+                                KTp[p + shell_P_start][r + shell_R_start] +=
+                                    prefactor * (Dp[q + shell_Q_start][s + shell_S_start]) * (*buffer2);
+                                KTp[p + shell_P_start][s + shell_S_start] +=
+                                    prefactor * (Dp[q + shell_Q_start][r + shell_R_start]) * (*buffer2);
+                                KTp[q + shell_Q_start][r + shell_R_start] +=
+                                    prefactor * (Dp[p + shell_P_start][s + shell_S_start]) * (*buffer2);
+                                KTp[q + shell_Q_start][s + shell_S_start] +=
+                                    prefactor * (Dp[p + shell_P_start][r + shell_R_start]) * (*buffer2);
+
+                                buffer2++;
                             }
                         }
                     }
-                    touched = true;
                 }
             }
         }
 
-        // => Master shell quartet loops <= //
-
-        if (!touched) continue;
+    }  // End master task list
 
-        // => Stripe out (Writing to K matrix) <= //
-        for (auto& KTmat : KT[thread]) {
-            KTmat->scale(2.0);
+    // => Reduce the per-thread K tiles <= //
+    for (size_t ind = 0; ind < D.size(); ind++) {
+        for (int thread = 0; thread < nthread; thread++) {
+            K[ind]->axpy(2.0, KT[thread][ind]);
         }
-
-        for (size_t ind = 0; ind < D.size(); ind++) {
-            double** KTp = KT[thread][ind]->pointer();
-            double** Kp = K[ind]->pointer();
-
-            double* K1p = KTp[0L * max_functions_per_atom];
-            double* K2p = KTp[1L * max_functions_per_atom];
-            double* K3p = KTp[2L * max_functions_per_atom];
-            double* K4p = KTp[3L * max_functions_per_atom];
-
-            // K_PR and K_PS
-            for (int P = Pstart; P < Pstart + nPshell; P++) {
-                int dP = P - Pstart;
-                int shell_P_start = primary_->shell(P).function_index();
-                int shell_P_nfunc = primary_->shell(P).nfunction();
-                int shell_P_offset = basis_endpoints_for_shell[P] - basis_endpoints_for_shell[Pstart];
-                for (const int S : P_stripeout_list[dP]) {
-                    int shell_S_start = primary_->shell(S).function_index();
-                    int shell_S_nfunc = primary_->shell(S).nfunction();
-
-                    for (int p = 0; p < shell_P_nfunc; p++) {
-                        for (int s = 0; s < shell_S_nfunc; s++) {
-#pragma omp atomic
-                            Kp[shell_P_start + p][shell_S_start + s] += K1p[(p + shell_P_offset) * nbf + s + shell_S_start];
-#pragma omp atomic
-                            Kp[shell_P_start + p][shell_S_start + s] += K2p[(p + shell_P_offset) * nbf + s + shell_S_start];
-                        }
-                    }
-
-                }
-            }
-
-            // K_QR and K_QS
-            for (int Q = Qstart; Q < Qstart + nQshell; Q++) {
-                int dQ = Q - Qstart;
-                int shell_Q_start = primary_->shell(Q).function_index();
-                int shell_Q_nfunc = primary_->shell(Q).nfunction();
-                int shell_Q_offset = basis_endpoints_for_shell[Q] - basis_endpoints_for_shell[Qstart];
-                for (const int S : Q_stripeout_list[dQ]) {
-                    int shell_S_start = primary_->shell(S).function_index();
-                    int shell_S_nfunc = primary_->shell(S).nfunction();
-
-                    for (int q = 0; q < shell_Q_nfunc; q++) {
-                        for (int s = 0; s < shell_S_nfunc; s++) {
-#pragma omp atomic
-                            Kp[shell_Q_start + q][shell_S_start + s] += K3p[(q + shell_Q_offset) * nbf + s + shell_S_start];
-#pragma omp atomic
-                            Kp[shell_Q_start + q][shell_S_start + s] += K4p[(q + shell_Q_offset) * nbf + s + shell_S_start];
-                        }
-                    }
-
-                }
-            }
-
-        }  // End stripe out
-
-    }  // End master task list
+    }
 
     for (auto& Kmat : K) {
         Kmat->hermitivitize();
     }
 
     num_computed_shells_ = computed_shells;
+    size_t nshellpair = nshell * (nshell + 1) / 2;
+    size_t nshellquartet = nshellpair * (nshellpair + 1) / 2;
+    stats_.shells_computed += num_computed_shells_;
+    stats_.shells_screened += nshellquartet - std::min(num_computed_shells_, nshellquartet);
     if (get_bench()) {
         computed_shells_per_iter_["Quartets"].push_back(num_computed_shells());
     }
@@ -1305,6 +1735,44 @@ void CompositeJK::build_COSK(std::vector<std::shared_ptr<Matrix>>& D, std::vecto
         }
     }
 
+    // shell-pair maxima of the densities, and for each shell the shells it couples to through them
+    // this turns the KAPPA -> TAU sparsity below into a walk over significant pairs only
+    std::vector<std::vector<int>> shell_density_map(nshell);
+    {
+        Matrix D_shell(nshell, nshell);
+        auto D_shellp = D_shell.pointer();
+        for (size_t jki = 0; jki < njk; jki++) {
+            auto Dp = D[jki]->pointer();
+            for (size_t s1 = 0; s1 < nshell; s1++) {
+                size_t start1 = primary_->shell(s1).function_index();
+                size_t num1 = primary_->shell(s1).nfunction();
+                for (size_t s2 = 0; s2 < nshell; s2++) {
+                    size_t start2 = primary_->shell(s2).function_index();
+                    size_t num2 = primary_->shell(s2).nfunction();
+                    for (size_t bf1 = start1; bf1 < start1 + num1; bf1++) {
+                        for (size_t bf2 = start2; bf2 < start2 + num2; bf2++) {
+                            D_shellp[s1][s2] = std::max(D_shellp[s1][s2], std::abs(Dp[bf1][bf2]));
+                        }
+                    }
+                }
+            }
+        }
+        for (size_t s1 = 0; s1 < nshell; s1++) {
+            for (size_t s2 = 0; s2 < nshell; s2++) {
+                if (D_shellp[s2][s1] > dscreen) shell_density_map[s1].push_back(s2);
+            }
+        }
+    }
+
+    // largest ESP bound, for screening whole grid blocks
+    double esp_bound_max = esp_bound.absmax();
+
+    // per-thread maps from global shell index to the first function of that shell in the
+    // TAU (density-coupled) and NU (integral-coupled) function lists of the current block
+    // entries are -1 outside of the current block, so that building the lists stays local
+    std::vector<std::vector<int>> tau_offsets(nthreads_, std::vector<int>(nshell, -1));
+    std::vector<std::vector<int>> nu_offsets(nthreads_, std::vector<int>(nshell, -1));
+
     // => Integral Computation <= //
 
     // benchmarking statistics
@@ -1336,61 +1804,76 @@ void CompositeJK::build_COSK(std::vector<std::shared_ptr<Matrix>>& D, std::vecto
         const auto &bf_map = block->functions_local_to_global();
         const auto &shell_map = block->shells_local_to_global();
         int nbf_block = bf_map.size();
-        int ns_block = shell_map.size();
-
-        // lists of all basis functions and shells
-        //
-        // The use of these "all" lists adds O(N^2) cost to the COSK grid loop (w/ small prefactor)
-        // This cost is negligible relative to the esp integral computation, which is O(N) (w/ a much larger prefactor),
-        // but future COSK work could remove this potential bottleneck
-        std::vector<int> bf_map_all;
-        std::vector<int> shell_map_all;
-        for (size_t bf = 0; bf < nbf; bf++) bf_map_all.push_back(bf);
-        for (size_t s = 0; s < nshell; s++) shell_map_all.push_back(s);
-        int nbf_block_all = bf_map_all.size();
-        int ns_block_all = shell_map_all.size();
-
-        // => Bookkeeping <= //
-
-        // map index in shell_map_all to first index in bf_map_all
-        std::vector<int> shell_map_all_to_bf_map_all;
-        if (shell_map_all.size() > 0) {
-            shell_map_all_to_bf_map_all.push_back(0);
-            for(size_t shell_map_ind = 0; (shell_map_ind + 1) < shell_map_all.size(); shell_map_ind++) {
-                size_t MU = shell_map_all[shell_map_ind];
-                shell_map_all_to_bf_map_all.push_back(primary_->shell(MU).nfunction() + shell_map_all_to_bf_map_all.back());
+
+        // => Sparsity <= //
+
+        auto &tau_offset = tau_offsets[rank];
+        auto &nu_offset = nu_offsets[rank];
+
+        // significant TAU shells determined from sparsity of the density matrix
+        // i.e. KAPPA -> TAU sparsity. Refered to by Neese as a "p-junction"
+        // as discussed in section 3.1 of DOI 10.1016/j.chemphys.2008.10.036
+        std::vector<int> shell_map_tau;
+        for (int KAPPA : shell_map) {
+            for (int TAU : shell_density_map[KAPPA]) {
+                if (tau_offset[TAU] < 0) {
+                    tau_offset[TAU] = 0;
+                    shell_map_tau.push_back(TAU);
+                }
             }
         }
+        std::sort(shell_map_tau.begin(), shell_map_tau.end());
+
+        std::vector<int> bf_map_tau;
+        for (int TAU : shell_map_tau) {
+            tau_offset[TAU] = bf_map_tau.size();
+            size_t tau_start = primary_->shell(TAU).function_index();
+            for (size_t tau = 0; tau < primary_->shell(TAU).nfunction(); tau++) bf_map_tau.push_back(tau_start + tau);
+        }
 
-        // map index in shell_map to first index in bf_map
-        std::vector<int> shell_map_to_bf_map;
-        if (shell_map.size() > 0) {
-            shell_map_to_bf_map.push_back(0);
-            for(size_t shell_map_ind = 0; (shell_map_ind + 1) < shell_map.size(); shell_map_ind++) {
-                size_t MU = shell_map[shell_map_ind];
-                shell_map_to_bf_map.push_back(primary_->shell(MU).nfunction() + shell_map_to_bf_map.back());
+        // NU shells reached from the TAU shells through overlapping extents
+        // every TAU shell is also a NU shell, which the permutational symmetry below relies on
+        std::vector<int> shell_map_nu;
+        for (int TAU : shell_map_tau) {
+            for (int NU : shell_extent_map[TAU]) {
+                if (nu_offset[NU] < 0) {
+                    nu_offset[NU] = 0;
+                    shell_map_nu.push_back(NU);
+                }
             }
         }
+        std::sort(shell_map_nu.begin(), shell_map_nu.end());
 
-        // map back from global shell index to local shell index
-        std::map<size_t, size_t> shell_map_inv;
-        for (size_t shell_ind = 0; shell_ind < shell_map.size(); shell_ind++) {
-            shell_map_inv[shell_map[shell_ind]] = shell_ind;
+        std::vector<int> bf_map_nu;
+        for (int NU : shell_map_nu) {
+            nu_offset[NU] = bf_map_nu.size();
+            size_t nu_start = primary_->shell(NU).function_index();
+            for (size_t nu = 0; nu < primary_->shell(NU).nfunction(); nu++) bf_map_nu.push_back(nu_start + nu);
         }
+        int nbf_block_tau = bf_map_tau.size();
+        int nbf_block_nu = bf_map_nu.size();
 
-        // => Process Density Matrix <= //
+        // leaves the per-thread maps clean for the next block
+        auto release_offsets = [&]() {
+            for (int TAU : shell_map_tau) tau_offset[TAU] = -1;
+            for (int NU : shell_map_nu) nu_offset[NU] = -1;
+        };
 
-        // significant cols of D for this grid block
-        std::vector<SharedMatrix> D_block(njk);
-        for(size_t jki = 0; jki < njk; jki++) {
-            D_block[jki] = std::make_shared<Matrix>(nbf_block_all, nbf_block);
+        if (nbf_block == 0 || nbf_block_tau == 0) {
+            release_offsets();
+            continue;
         }
 
+        // => Process Density Matrix <= //
+
+        // significant rows and cols of D for this grid block
+        std::vector<SharedMatrix> D_block(njk);
         for(size_t jki = 0; jki < njk; jki++) {
+            D_block[jki] = std::make_shared<Matrix>(nbf_block_tau, nbf_block);
             auto Dp = D[jki]->pointer();
             auto D_blockp = D_block[jki]->pointer();
-            for (size_t tau_ind = 0; tau_ind < nbf_block_all; tau_ind++) {
-                size_t tau = bf_map_all[tau_ind];
+            for (size_t tau_ind = 0; tau_ind < nbf_block_tau; tau_ind++) {
+                size_t tau = bf_map_tau[tau_ind];
                 for (size_t kappa_ind = 0; kappa_ind < nbf_block; kappa_ind++) {
                     size_t kappa = bf_map[kappa_ind];
                     D_blockp[tau_ind][kappa_ind] = Dp[tau][kappa];
@@ -1398,44 +1881,6 @@ void CompositeJK::build_COSK(std::vector<std::shared_ptr<Matrix>>& D, std::vecto
             }
         }
 
-        // shell-pair maxima of D_block
-        auto D_block_shell = std::make_shared<Matrix>(ns_block_all, ns_block);
-        auto D_block_shellp = D_block_shell->pointer();
-
-        for (size_t TAU_ind = 0; TAU_ind < ns_block_all; TAU_ind++) {
-            size_t TAU = shell_map_all[TAU_ind];
-            size_t tau_start = shell_map_all_to_bf_map_all[TAU_ind];
-            size_t num_tau = primary_->shell(TAU).nfunction();
-            for (size_t KAPPA_ind = 0; KAPPA_ind < ns_block; KAPPA_ind++) {
-                size_t KAPPA = shell_map[KAPPA_ind];
-                size_t kappa_start = shell_map_to_bf_map[KAPPA_ind];
-                size_t num_kappa = primary_->shell(KAPPA).nfunction();
-                for(size_t jki = 0; jki < njk; jki++) {
-                    auto D_blockp = D_block[jki]->pointer();
-                    for (size_t bf1 = tau_start; bf1 < tau_start + num_tau; bf1++) {
-                        for (size_t bf2 = kappa_start; bf2 < kappa_start + num_kappa; bf2++) {
-                            D_block_shellp[TAU_ind][KAPPA_ind] = std::max(D_block_shellp[TAU_ind][KAPPA_ind], std::abs(D_blockp[bf1][bf2]));
-                        }
-                    }
-                }
-            }
-        }
-
-        // significant TAU shells determined from sparsity of the density matrix
-        // i.e. KAPPA -> TAU sparsity. Refered to by Neese as a "p-junction"
-        // as discussed in section 3.1 of DOI 10.1016/j.chemphys.2008.10.036
-        std::vector<int> shell_map_tau;
-
-        for(size_t TAU = 0; TAU < ns_block_all; TAU++) {
-            for(size_t KAPPA_ind = 0; KAPPA_ind < ns_block; KAPPA_ind++) {
-                size_t KAPPA = shell_map[KAPPA_ind];
-                if (D_block_shellp[TAU][KAPPA_ind] > dscreen) {
-                    shell_map_tau.push_back(TAU);
-                    break;
-                }
-            }
-        }
-
         // => X Matrix <= //
 
         // DOI 10.1016/j.chemphys.2008.10.036, EQ. 4
@@ -1444,7 +1889,7 @@ void CompositeJK::build_COSK(std::vector<std::shared_ptr<Matrix>>& D, std::vecto
         // to account for the possibility of negative grid weights
         // here, we define X using sqrt(abs(w)) instead of sqrt(w)
 
-	// compute basis functions at these grid points
+        // compute basis functions at these grid points
         bf_computers[rank]->compute_functions(block);
         auto point_values = bf_computers[rank]->basis_values()["PHI"];
 
@@ -1476,22 +1921,23 @@ void CompositeJK::build_COSK(std::vector<std::shared_ptr<Matrix>>& D, std::vecto
         // contract density with basis functions values at these grid points
         std::vector<SharedMatrix> F_block(njk);
         for(size_t jki = 0; jki < njk; jki++) {
-            F_block[jki] = linalg::doublet(X_block, D_block[jki], false, true);
+            F_block[jki] = (low_precision_ ? sp_doublet(X_block, D_block[jki], false, true)
+                                           : linalg::doublet(X_block, D_block[jki], false, true));
         }
-        
+
         // shell maxima of F_block
-        auto F_block_shell = std::make_shared<Matrix>(npoints_block, nshell);
+        auto F_block_shell = std::make_shared<Matrix>(npoints_block, shell_map_tau.size());
         auto F_block_shellp = F_block_shell->pointer();
 
-        // grid point maxima of F_block_gmax
-        auto F_block_gmax = std::make_shared<Vector>(nshell);
+        // grid point maxima of F_block_shell
+        auto F_block_gmax = std::make_shared<Vector>(shell_map_tau.size());
         auto F_block_gmaxp = F_block_gmax->pointer();
 
         for (size_t p = 0; p < npoints_block; p++) {
-            for (size_t TAU_local = 0; TAU_local < shell_map_all.size(); TAU_local++) {
-                size_t TAU = shell_map_all[TAU_local];
+            for (size_t TAU_local = 0; TAU_local < shell_map_tau.size(); TAU_local++) {
+                size_t TAU = shell_map_tau[TAU_local];
                 size_t num_tau = primary_->shell(TAU).nfunction();
-                size_t tau_start = shell_map_all_to_bf_map_all[TAU_local];
+                size_t tau_start = tau_offset[TAU];
                 for(size_t jki = 0; jki < njk; jki++) {
                     auto F_blockp = F_block[jki]->pointer();
                     for (size_t tau = tau_start; tau < tau_start + num_tau; tau++) {
@@ -1502,22 +1948,32 @@ void CompositeJK::build_COSK(std::vector<std::shared_ptr<Matrix>>& D, std::vecto
             }
         }
 
+        // can we screen the whole block over K_uv = (X_ug (A_vtg (F_tg)) upper bound?
+        double F_block_max = *std::max_element(F_block_gmaxp, F_block_gmaxp + shell_map_tau.size());
+        if (X_block_max * esp_bound_max * F_block_max < kscreen) {
+            release_offsets();
+            continue;
+        }
+
         // => Q Matrix <= //
 
         // DOI 10.1063/1.3646921, EQ. 18
 
-        // slice of overlap metric (Q) made up of significant basis functions at this grid point
-        auto Q_block = std::make_shared<Matrix>(nbf_block, nbf_block);
-        for(size_t mu_local = 0; mu_local < nbf_block; mu_local++) {
-            size_t mu = bf_map[mu_local];
-            for(size_t nu_local = 0; nu_local < nbf_block; nu_local++) {
-                size_t nu = bf_map[nu_local];
-                Q_block->set(mu_local, nu_local, Q->get(mu, nu));
+        SharedMatrix Q_block;
+        if (overlap_fitted) {
+            // slice of overlap metric (Q) made up of significant basis functions at this grid point
+            Q_block = std::make_shared<Matrix>(nbf_block, nbf_block);
+            for(size_t mu_local = 0; mu_local < nbf_block; mu_local++) {
+                size_t mu = bf_map[mu_local];
+                for(size_t nu_local = 0; nu_local < nbf_block; nu_local++) {
+                    size_t nu = bf_map[nu_local];
+                    Q_block->set(mu_local, nu_local, Q->get(mu, nu));
+                }
             }
-        }
 
-        // now Q_block agrees with EQ. 18 (see note about Q_init_ and Q_final_ in common_init())
-        Q_block = linalg::doublet(X_block, Q_block, false, true);
+            // now Q_block agrees with EQ. 18 (see note about Q_init_ and Q_final_ in common_init())
+            Q_block = linalg::doublet(X_block, Q_block, false, true);
+        }
 
         // => G Matrix <= //
 
@@ -1525,24 +1981,24 @@ void CompositeJK::build_COSK(std::vector<std::shared_ptr<Matrix>>& D, std::vecto
         // algorithm can be found in Scheme 1 of DOI 10.1016/j.chemphys.2008.10.036
         std::vector<SharedMatrix> G_block(njk);
         for(size_t jki = 0; jki < njk; jki++) {
-            G_block[jki] = std::make_shared<Matrix>(nbf_block_all, npoints_block);
+            G_block[jki] = std::make_shared<Matrix>(nbf_block_nu, npoints_block);
         }
 
         if(rank == 0) timer_on("ESP Integrals");
 
         const auto & int_buff = int_computers[rank]->buffers()[0];
 
-        // lambda for returning sign of double
-        // needed for formation of G
-        auto sign = [ ](double val) {
-            return (val >= 0.0) ? 1.0 : -1.0;
-        };
+        // grid points of this block surviving the screening of one shell pair,
+        // and the integrals of that shell pair at those points (points x nu x tau)
+        std::vector<size_t> points;
+        std::vector<double> esp_batch;
 
         // calculate A_NU_TAU at all grid points in this block
         // contract A_NU_TAU with F_TAU to get G_NU
-        for (size_t TAU : shell_map_tau) {
+        for (size_t TAU_local = 0; TAU_local < shell_map_tau.size(); TAU_local++) {
+            const size_t TAU = shell_map_tau[TAU_local];
             const size_t num_tau = primary_->shell(TAU).nfunction();
-            const size_t tau_start = shell_map_all_to_bf_map_all[TAU];
+            const size_t tau_start = tau_offset[TAU];
             const size_t center_TAU = primary_->shell_to_center(TAU);
             const double x_TAU = primary_->molecule()->x(center_TAU);
             const double y_TAU = primary_->molecule()->y(center_TAU);
@@ -1551,7 +2007,7 @@ void CompositeJK::build_COSK(std::vector<std::shared_ptr<Matrix>>& D, std::vecto
             // TAU -> NU sparity determined by shell extents
             for (size_t NU : shell_extent_map[TAU]) {
                 const size_t num_nu = primary_->shell(NU).nfunction();
-                const size_t nu_start = shell_map_all_to_bf_map_all[NU];
+                const size_t nu_start = nu_offset[NU];
                 const size_t center_NU = primary_->shell_to_center(NU);
                 const double x_NU = primary_->molecule()->x(center_NU);
                 const double y_NU = primary_->molecule()->y(center_NU);
@@ -1559,19 +2015,24 @@ void CompositeJK::build_COSK(std::vector<std::shared_ptr<Matrix>>& D, std::vecto
 
                 // is this value of NU also a possible value of TAU for this grid block?
                 // i.e. can we use permutational symmetry of this (NU|TAU) integral shell pair?
-                bool symm = (NU != TAU) && std::binary_search(shell_map_tau.begin(), shell_map_tau.end(), NU);
+                bool symm = (NU != TAU) && (tau_offset[NU] >= 0);
 
                 // we've already done these integrals
                 if (symm && TAU > NU) continue;
 
+                // position of NU among the TAU shells, for the symmetric contribution
+                size_t NU_local = 0;
+                if (symm) NU_local = std::lower_bound(shell_map_tau.begin(), shell_map_tau.end(), NU) - shell_map_tau.begin();
+
                 // benchmarking
                 int_shells_total += npoints_block;
 
                 // can we screen the whole block over K_uv = (X_ug (A_vtg (F_tg)) upper bound?
-                double k_bound = X_block_max * esp_boundp[NU][TAU] * F_block_gmaxp[TAU];
-                if (symm) k_bound = std::max(k_bound, X_block_max * esp_boundp[TAU][NU] * F_block_gmaxp[NU]);
+                double k_bound = X_block_max * esp_boundp[NU][TAU] * F_block_gmaxp[TAU_local];
+                if (symm) k_bound = std::max(k_bound, X_block_max * esp_boundp[TAU][NU] * F_block_gmaxp[NU_local]);
                 if (k_bound < kscreen) continue;
 
+                points.clear();
                 for (size_t g = 0; g < npoints_block; g++) {
 
                     // grid-point specific screening
@@ -1582,32 +2043,56 @@ void CompositeJK::build_COSK(std::vector<std::shared_ptr<Matrix>>& D, std::vecto
                     double dist_decay = 1.0 / std::max(1.0, dist_NUTAU_g);
 
                     // can we screen this single point over K_uv = (X_ug (A_vtg (F_tg))) upper bound?
-                    k_bound = X_block_bfmaxp[g] * esp_boundp[NU][TAU] * dist_decay * F_block_shellp[g][TAU];
-                    if (symm) k_bound = std::max(k_bound, X_block_bfmaxp[g] * esp_boundp[TAU][NU] * dist_decay * F_block_shellp[g][NU]);
-                    if (k_bound < kscreen) continue;
+                    k_bound = X_block_bfmaxp[g] * esp_boundp[NU][TAU] * dist_decay * F_block_shellp[g][TAU_local];
+                    if (symm) k_bound = std::max(k_bound, X_block_bfmaxp[g] * esp_boundp[TAU][NU] * dist_decay * F_block_shellp[g][NU_local]);
+                    if (k_bound >= kscreen) points.push_back(g);
+                }
+                if (points.empty()) continue;
 
-                    // calculate pseudospectral integral shell pair (A_NU_TAU) at gridpoint g
+                // calculate pseudospectral integral shell pair (A_NU_TAU) at the surviving grid points
+                const size_t npair = num_nu * num_tau;
+                esp_batch.resize(points.size() * npair);
+                for (size_t i = 0; i < points.size(); i++) {
+                    size_t g = points[i];
                     int_computers[rank]->set_origin({x[g], y[g], z[g]});
                     int_computers[rank]->compute_shell(NU, TAU);
+                    std::copy(int_buff, int_buff + npair, esp_batch.data() + i * npair);
+                }
 
-                    // benchmarking
-                    int_shells_computed++;
-
-                    // contract A_nu_tau with F_tau to get contribution to G_nu
-                    // symmetry permitting, also contract A_nu_tau with F_nu to get contribution to G_tau
-                    // we fold sign(w) into the formation of G to correct for the modified definition of X
-                    for(size_t jki = 0; jki < njk; jki++) {
-                        auto F_blockp = F_block[jki]->pointer();
-                        auto G_blockp = G_block[jki]->pointer();
-                        for (size_t nu = nu_start, index = 0; nu < (nu_start + num_nu); ++nu) {
-                            for (size_t tau = tau_start; tau < (tau_start + num_tau); ++tau, index++) {
-                                G_blockp[nu][g] += sign(w[g]) * int_buff[index] * F_blockp[g][tau];
-                                if (symm) G_blockp[tau][g] += sign(w[g]) * int_buff[index] * F_blockp[g][nu];
+                // benchmarking
+                int_shells_computed += points.size();
+
+                // contract A_nu_tau with F_tau to get contribution to G_nu
+                // symmetry permitting, also contract A_nu_tau with F_nu to get contribution to G_tau
+                // we fold sign(w) into the formation of G to correct for the modified definition of X
+                const size_t tau_row = nu_offset[TAU];
+                const size_t nu_col = symm ? tau_offset[NU] : 0;
+                for(size_t jki = 0; jki < njk; jki++) {
+                    auto F_blockp = F_block[jki]->pointer();
+                    auto G_blockp = G_block[jki]->pointer();
+                    for (size_t i = 0; i < points.size(); i++) {
+                        const size_t g = points[i];
+                        const double sign_w = (w[g] >= 0.0) ? 1.0 : -1.0;
+                        const double *A = esp_batch.data() + i * npair;
+                        const double *F_tau = F_blockp[g] + tau_start;
+                        for (size_t nu = 0, index = 0; nu < num_nu; ++nu) {
+                            double G_nu = 0.0;
+                            for (size_t tau = 0; tau < num_tau; ++tau, ++index) {
+                                G_nu += A[index] * F_tau[tau];
+                            }
+                            G_blockp[nu_start + nu][g] += sign_w * G_nu;
+                        }
+                        if (symm) {
+                            const double *F_nu = F_blockp[g] + nu_col;
+                            for (size_t nu = 0, index = 0; nu < num_nu; ++nu) {
+                                for (size_t tau = 0; tau < num_tau; ++tau, ++index) {
+                                    G_blockp[tau_row + tau][g] += sign_w * A[index] * F_nu[nu];
+                                }
                             }
                         }
                     }
-
                 }
+
             }
 
         }
@@ -1618,21 +2103,24 @@ void CompositeJK::build_COSK(std::vector<std::shared_ptr<Matrix>>& D, std::vecto
         for(size_t jki = 0; jki < njk; jki++) {
             SharedMatrix KT_block;
             if (overlap_fitted) {
-                KT_block = linalg::doublet(Q_block, G_block[jki], true, true);
+                KT_block = (low_precision_ ? sp_doublet(Q_block, G_block[jki], true, true)
+                                            : linalg::doublet(Q_block, G_block[jki], true, true));
             } else {
-                KT_block = linalg::doublet(X_block, G_block[jki], true, true);
+                KT_block = (low_precision_ ? sp_doublet(X_block, G_block[jki], true, true)
+                                            : linalg::doublet(X_block, G_block[jki], true, true));
             }
             auto KT_blockp = KT_block->pointer();
             auto KTp = KT[jki][rank]->pointer();
-            for(size_t mu_ind = 0; mu_ind < bf_map.size(); mu_ind++) {
+            for(size_t mu_ind = 0; mu_ind < nbf_block; mu_ind++) {
                 size_t mu = bf_map[mu_ind];
-                for(size_t nu_ind = 0; nu_ind < bf_map_all.size(); nu_ind++) {
-                    size_t nu = bf_map_all[nu_ind];
+                for(size_t nu_ind = 0; nu_ind < nbf_block_nu; nu_ind++) {
+                    size_t nu = bf_map_nu[nu_ind];
                     KTp[mu][nu] += KT_blockp[mu_ind][nu_ind];
                 }
             }
         }
 
+        release_offsets();
     }
 
     timer_off("Grid Loop");
@@ -1648,6 +2136,7 @@ void CompositeJK::build_COSK(std::vector<std::shared_ptr<Matrix>>& D, std::vecto
     }
 
     num_computed_shells_ = int_shells_computed;
+    stats_.shells_computed += num_computed_shells_;
     if (get_bench()) {
         computed_shells_per_iter_["Quartets"].push_back(num_computed_shells());
     }
@@ -91,12 +91,32 @@ void DirectJK::common_init() {
     if (options_.get_int("INCFOCK_FULL_FOCK_EVERY") <= 0) {
         throw PSIEXCEPTION("Invalid input for option INCFOCK_FULL_FOCK_EVERY (<= 0)");
     }
-    density_screening_ = options_.get_str("SCREENING") == "DENSITY";
+    // QQR bounds are multiplied by the density (the density change, for incremental builds) just like DENSITY
+    density_screening_ = options_.get_str("SCREENING") == "DENSITY" || options_.get_str("SCREENING") == "QQR";
+
+    numa_domains_ = options_.get_int("NUMA_DOMAINS");
+    if (numa_domains_ < 0) {
+        throw PSIEXCEPTION("Invalid input for option NUMA_DOMAINS (< 0)");
+    }
+    numa_domains_ = std::min(numa_domains_, df_ints_num_threads_);
 
     computed_shells_per_iter_["Quartets"] = {};
     
     set_cutoff(options_.get_double("INTS_TOLERANCE"));
 }
+int DirectJK::numa_domain(int thread, int nthread) const {
+    if (numa_domains_ <= 1) return 0;
+#ifdef _OPENMP
+    // With bound threads, the places tell us where we really are
+    int nplace = omp_get_num_places();
+    int place = omp_get_place_num();
+    if (omp_get_proc_bind() != omp_proc_bind_false && nplace > 0 && place >= 0) {
+        return (place * numa_domains_) / nplace;
+    }
+#endif
+    // Otherwise assume consecutive threads share a domain, as with OMP_PROC_BIND=close
+    return (thread * numa_domains_) / nthread;
+}
 size_t DirectJK::num_computed_shells() { 
     return num_computed_shells_; 
 }
@@ -118,7 +138,14 @@ void DirectJK::print_header() const {
         outfile->Printf("    Screening Type:    %11s\n", screen_type.c_str());
         outfile->Printf("    Screening Cutoff:  %11.0E\n", cutoff_);
         outfile->Printf("    Incremental Fock:  %11s\n", incfock_ ? "Yes" : "No");
+        if (numa_domains_) outfile->Printf("    NUMA Domains:      %11d\n", numa_domains_);
         outfile->Printf("\n");
+#ifdef _OPENMP
+        if (numa_domains_ && omp_get_proc_bind() == omp_proc_bind_false) {
+            outfile->Printf("    Warning: OpenMP threads are not bound, so first-touch placement may not stick.\n");
+            outfile->Printf("             Set OMP_PROC_BIND=close and OMP_PLACES=cores before starting Psi4.\n\n");
+        }
+#endif
     }
 }
 void DirectJK::preiterations() {
@@ -350,16 +377,16 @@ void DirectJK::compute_JK() {
     // Passed in as a dummy when J (and/or K) is not built
     std::vector<SharedMatrix> temp;
 
+    // Range-separated integrals for wK. When J or K are needed too, both kernels
+    // are evaluated in the same shell quartet traversal below.
+    std::vector<std::shared_ptr<TwoBodyAOInt>> wints;
     if (do_wK_) {
-        std::vector<std::shared_ptr<TwoBodyAOInt>> ints;
         for (int thread = 0; thread < df_ints_num_threads_; thread++) {
-            ints.push_back(std::shared_ptr<TwoBodyAOInt>(factory->erf_eri(omega_)));
-            if (density_screening_) ints[thread]->update_density(D_ref_);
+            wints.push_back(std::shared_ptr<TwoBodyAOInt>(factory->erf_eri(omega_)));
+            if (density_screening_) wints[thread]->update_density(D_ref_);
         }
-        if (do_J_) {
-            build_JK_matrices(ints, D_ref_, J_ao_, wK_ao_);
-        } else {
-            build_JK_matrices(ints, D_ref_, temp, wK_ao_);
+        if (!do_J_ && !do_K_) {
+            build_JK_matrices(wints, D_ref_, temp, wK_ao_);
         }
     }
 
@@ -367,15 +394,30 @@ void DirectJK::compute_JK() {
         std::vector<std::shared_ptr<TwoBodyAOInt>> ints;
         ints.push_back(std::shared_ptr<TwoBodyAOInt>(factory->eri()));
         if (density_screening_) ints[0]->update_density(D_ref_);
-        for (int thread = 1; thread < df_ints_num_threads_; thread++) {
-            ints.push_back(std::shared_ptr<TwoBodyAOInt>(ints[0]->clone()));
+        if (numa_domains_) {
+            // each thread clones its own engine, so its buffers are local to that thread
+            ints.resize(df_ints_num_threads_);
+#pragma omp parallel num_threads(df_ints_num_threads_)
+            {
+                int thread = 0;
+#ifdef _OPENMP
+                thread = omp_get_thread_num();
+#endif
+                if (thread) ints[thread] = std::shared_ptr<TwoBodyAOInt>(ints[0]->clone());
+            }
+        } else {
+            for (int thread = 1; thread < df_ints_num_threads_; thread++) {
+                ints.push_back(std::shared_ptr<TwoBodyAOInt>(ints[0]->clone()));
+            }
         }
+        std::vector<std::shared_ptr<TwoBodyAOInt>>* wK_ints = (do_wK_ ? &wints : nullptr);
+        std::vector<SharedMatrix>* wK = (do_wK_ ? &wK_ao_ : nullptr);
         if (do_J_ && do_K_) {
-            build_JK_matrices(ints, D_ref_, J_ao_, K_ao_);
+            build_JK_matrices(ints, D_ref_, J_ao_, K_ao_, wK_ints, wK);
         } else if (do_J_) {
-            build_JK_matrices(ints, D_ref_, J_ao_, temp);
+            build_JK_matrices(ints, D_ref_, J_ao_, temp, wK_ints, wK);
         } else {
-            build_JK_matrices(ints, D_ref_, temp, K_ao_);
+            build_JK_matrices(ints, D_ref_, temp, K_ao_, wK_ints, wK);
         }
     }
 
@@ -390,12 +432,19 @@ void DirectJK::compute_JK() {
 void DirectJK::postiterations() {}
 
 void DirectJK::build_JK_matrices(std::vector<std::shared_ptr<TwoBodyAOInt>>& ints, const std::vector<SharedMatrix>& D,
-                        std::vector<SharedMatrix>& J, std::vector<SharedMatrix>& K) {
+                        std::vector<SharedMatrix>& J, std::vector<SharedMatrix>& K,
+                        std::vector<std::shared_ptr<TwoBodyAOInt>>* wints, std::vector<SharedMatrix>* wK) {
 
     bool build_J = (!J.empty());
     bool build_K = (!K.empty());
+    // wK rides along as extra exchange buffers, contracted with the erf integrals
+    bool build_wK = (wK != nullptr && !wK->empty());
 
     if (!build_J && !build_K) return;
+
+    size_t nK = (build_K ? D.size() : 0);
+    // Contractions per quartet: J/K for each density, then wK for each density
+    size_t njob = D.size() + (build_wK ? D.size() : 0);
     
     timer_on("build_JK_matrices()");
 
@@ -413,6 +462,12 @@ void DirectJK::build_JK_matrices(std::vector<std::shared_ptr<TwoBodyAOInt>>& int
         for (auto& Kmat : K) {
             Kmat->zero();
         }
+
+        if (build_wK) {
+            for (auto& wKmat : *wK) {
+                wKmat->zero();
+            }
+        }
     }
 
     // => Sizing <= //
@@ -499,29 +554,72 @@ void DirectJK::build_JK_matrices(std::vector<std::shared_ptr<TwoBodyAOInt>>& int
 
     // => Intermediate Buffers <= //
 
-    // Intermediate J buffer per thread
-    std::vector<std::vector<SharedMatrix>> JT;
-    if (build_J) {
-        for (int thread = 0; thread < nthread; thread++) {
-            std::vector<SharedMatrix> J2;
-            for (size_t ind = 0; ind < D.size(); ind++) {
-                // The factor of 2 comes from exploiting ERI permutational symmetry
-                J2.push_back(std::make_shared<Matrix>("JT", 2 * max_task, max_task));
-            }
-            JT.push_back(J2);
+    // Intermediate J and K buffers per thread
+    std::vector<std::vector<SharedMatrix>> JT(build_J ? nthread : 0);
+    std::vector<std::vector<SharedMatrix>> KT((build_K || build_wK) ? nthread : 0);
+    auto allocate_thread_buffers = [&](int thread) {
+        for (size_t ind = 0; ind < D.size(); ind++) {
+            // The factor of 2 comes from exploiting ERI permutational symmetry
+            if (build_J) JT[thread].push_back(std::make_shared<Matrix>("JT", 2 * max_task, max_task));
+            // The factor of 4 or 8 comes from exploiting ERI permutational symmetry
+            if (build_K) KT[thread].push_back(std::make_shared<Matrix>("KT", (lr_symmetric_ ? 4 : 8) * max_task, max_task));
+        }
+        for (size_t ind = 0; build_wK && ind < D.size(); ind++) {
+            KT[thread].push_back(std::make_shared<Matrix>("wKT", (lr_symmetric_ ? 4 : 8) * max_task, max_task));
+        }
+    };
+
+    // Partial J and K per NUMA domain, which the threads of that domain accumulate into.
+    // A distributed build needs at least one partial to reduce over the ranks.
+    int npartial = (numa_domains_ > 1 ? numa_domains_ : (task_nranks_ > 1 ? 1 : 0));
+    std::vector<std::vector<SharedMatrix>> JD(build_J ? npartial : 0);
+    std::vector<std::vector<SharedMatrix>> KD((build_K || build_wK) ? npartial : 0);
+    std::vector<int> thread_domain(nthread, 0);
+
+    if (numa_domains_) {
+        // First touch happens on the owning thread (and, for the partials, on one thread of the domain)
+#pragma omp parallel num_threads(nthread)
+        {
+            int thread = 0;
+#ifdef _OPENMP
+            thread = omp_get_thread_num();
+#endif
+            allocate_thread_buffers(thread);
+            thread_domain[thread] = numa_domain(thread, nthread);
         }
-    }
 
-    // Intermediate K buffer per thread
-    std::vector<std::vector<SharedMatrix>> KT;
-    if (build_K) {
-        for (int thread = 0; thread < nthread; thread++) {
-            std::vector<SharedMatrix > K2;
+        // the lowest thread of each domain owns its partials
+        std::vector<int> domain_owner(std::max(JD.size(), KD.size()), 0);
+        for (int thread = nthread - 1; thread >= 0; thread--) {
+            if (thread_domain[thread] < (int)domain_owner.size()) domain_owner[thread_domain[thread]] = thread;
+        }
+#pragma omp parallel num_threads(nthread)
+        {
+            int thread = 0;
+#ifdef _OPENMP
+            thread = omp_get_thread_num();
+#endif
+            for (size_t domain = 0; domain < domain_owner.size(); domain++) {
+                if (domain_owner[domain] != thread) continue;
+                for (size_t ind = 0; ind < D.size(); ind++) {
+                    if (build_J) JD[domain].push_back(std::make_shared<Matrix>("JD", primary_->nbf(), primary_->nbf()));
+                    if (build_K) KD[domain].push_back(std::make_shared<Matrix>("KD", primary_->nbf(), primary_->nbf()));
+                }
+                for (size_t ind = 0; build_wK && ind < D.size(); ind++) {
+                    KD[domain].push_back(std::make_shared<Matrix>("wKD", primary_->nbf(), primary_->nbf()));
+                }
+            }
+        }
+    } else {
+        for (int thread = 0; thread < nthread; thread++) allocate_thread_buffers(thread);
+        for (int domain = 0; domain < npartial; domain++) {
             for (size_t ind = 0; ind < D.size(); ind++) {
-                // The factor of 4 or 8 comes from exploiting ERI permutational symmetry
-                K2.push_back(std::make_shared<Matrix>("KT", (lr_symmetric_ ? 4 : 8) * max_task, max_task));
+                if (build_J) JD[domain].push_back(std::make_shared<Matrix>("JD", primary_->nbf(), primary_->nbf()));
+                if (build_K) KD[domain].push_back(std::make_shared<Matrix>("KD", primary_->nbf(), primary_->nbf()));
+            }
+            for (size_t ind = 0; build_wK && ind < D.size(); ind++) {
+                KD[domain].push_back(std::make_shared<Matrix>("wKD", primary_->nbf(), primary_->nbf()));
             }
-            KT.push_back(K2);
         }
     }
     
@@ -529,11 +627,22 @@ void DirectJK::build_JK_matrices(std::vector<std::shared_ptr<TwoBodyAOInt>>& int
 
     num_computed_shells_ = 0L;
     size_t computed_shells = 0L;
+    double integral_time = 0.0, contraction_time = 0.0;
+    // Per-task spans and quartet counts on the timer trace, to expose thread imbalance
+    const bool trace = timer_trace_enabled();
+
+    // Per-thread batches of the (RS) kets that survive screening for one (PQ) bra
+    std::vector<std::vector<std::array<int, 4>>> batch_quartets(nthread);
+    std::vector<std::vector<std::pair<int, int>>> batch_tasks(nthread);
+    std::vector<std::vector<double>> batch_buffers(nthread);
+    std::vector<std::vector<double>> wbatch_buffers(nthread);
 
 // ==> Master Task Loop <== //
 
-#pragma omp parallel for num_threads(nthread) schedule(dynamic) reduction(+ : computed_shells)
+#pragma omp parallel for num_threads(nthread) schedule(dynamic) reduction(+ : computed_shells, integral_time, contraction_time)
     for (size_t task = 0L; task < ntask_pair2; task++) {
+        if (task % task_nranks_ != (size_t)task_rank_) continue;
+
         size_t task1 = task / ntask_pair;
         size_t task2 = task % ntask_pair;
 
@@ -571,6 +680,11 @@ void DirectJK::build_JK_matrices(std::vector<std::shared_ptr<TwoBodyAOInt>>& int
         thread = omp_get_thread_num();
 #endif
 
+        double task_start = JKStats::wall_time();
+        double task_integral_time = 0.0;
+        size_t task_quartets = 0L;
+        if (trace) timer_trace_begin("DirectJK: Task", thread);
+
         // => Master shell quartet loops <= //
 
         bool touched = false;
@@ -580,6 +694,16 @@ void DirectJK::build_JK_matrices(std::vector<std::shared_ptr<TwoBodyAOInt>>& int
                 int P = task_shells[P2];
                 int Q = task_shells[Q2];
                 if (!ints[0]->shell_pair_significant(P, Q)) continue;
+
+                int Psize = primary_->shell(P).nfunction();
+                int Qsize = primary_->shell(Q).nfunction();
+
+                // Gather the significant kets of this bra so the engine can batch them
+                auto& quartets = batch_quartets[thread];
+                auto& ket_tasks = batch_tasks[thread];
+                quartets.clear();
+                ket_tasks.clear();
+                size_t batch_size = 0;
                 for (int R2 = R2start; R2 < R2start + nRtask; R2++) {
                     for (int S2 = S2start; S2 < S2start + nStask; S2++) {
                         if (S2 > R2) continue;
@@ -588,143 +712,188 @@ void DirectJK::build_JK_matrices(std::vector<std::shared_ptr<TwoBodyAOInt>>& int
                         if (R2 * nshell + S2 > P2 * nshell + Q2) continue;
                         if (!ints[0]->shell_pair_significant(R, S)) continue;
                         if (!ints[0]->shell_significant(P, Q, R, S)) continue;
+                        ket_tasks.emplace_back(R2, S2);
+                    }
+                }
+                if (ket_tasks.empty()) continue;
+
+                // Group the kets by AM class so that consecutive quartets share an integral kernel
+                auto ket_class = [&](const std::pair<int, int>& RS2) {
+                    return std::make_pair(primary_->shell(task_shells[RS2.first]).am(),
+                                          primary_->shell(task_shells[RS2.second]).am());
+                };
+                std::stable_sort(ket_tasks.begin(), ket_tasks.end(),
+                                 [&](const std::pair<int, int>& a, const std::pair<int, int>& b) {
+                                     return ket_class(a) < ket_class(b);
+                                 });
+                for (const auto& RS2 : ket_tasks) {
+                    int R = task_shells[RS2.first];
+                    int S = task_shells[RS2.second];
+                    quartets.push_back({P, Q, R, S});
+                    batch_size += (size_t)Psize * Qsize * primary_->shell(R).nfunction() *
+                                  primary_->shell(S).nfunction();
+                }
 
-                        // printf("Quartet: %2d %2d %2d %2d\n", P, Q, R, S);
-                        // if (thread == 0) timer_on("JK: Ints");
-                        if (ints[thread]->compute_shell(P, Q, R, S) == 0)
-                            continue;  // No integrals in this shell quartet
-                        computed_shells++;
-                        // if (thread == 0) timer_off("JK: Ints");
-
-                        const double* buffer = ints[thread]->buffer();
-
-                        int Psize = primary_->shell(P).nfunction();
-                        int Qsize = primary_->shell(Q).nfunction();
-                        int Rsize = primary_->shell(R).nfunction();
-                        int Ssize = primary_->shell(S).nfunction();
-
-                        int Poff = primary_->shell(P).function_index();
-                        int Qoff = primary_->shell(Q).function_index();
-                        int Roff = primary_->shell(R).function_index();
-                        int Soff = primary_->shell(S).function_index();
-
-                        int Poff2 = task_offsets[P2] - task_offsets[P2start];
-                        int Qoff2 = task_offsets[Q2] - task_offsets[Q2start];
-                        int Roff2 = task_offsets[R2] - task_offsets[R2start];
-                        int Soff2 = task_offsets[S2] - task_offsets[S2start];
-
-                        // if (thread == 0) timer_on("JK: GEMV");
-                        for (size_t ind = 0; ind < D.size(); ind++) {
-                            double** Dp = D[ind]->pointer();
-                            double** JTp; 
-                            if (build_J) JTp = JT[thread][ind]->pointer();
-                            double** KTp;
-                            if (build_K) KTp = KT[thread][ind]->pointer();
-                            const double* buffer2 = buffer;
-
-                            if (!touched) {
-                                if (build_J) {
-                                    ::memset((void*)JTp[0L * max_task], '\0', dPsize * dQsize * sizeof(double));
-                                    ::memset((void*)JTp[1L * max_task], '\0', dRsize * dSsize * sizeof(double));
-                                }
+                auto& batch_buffer = batch_buffers[thread];
+                if (batch_buffer.size() < batch_size) batch_buffer.resize(batch_size);
+
+                double integral_start = JKStats::wall_time();
+                size_t nbatch = ints[thread]->compute_shell_batch(quartets, batch_buffer.data());
+                // The erf kernel is bounded by the Coulomb one, so the screening above covers it too
+                size_t nwbatch = 0;
+                auto& wbatch_buffer = wbatch_buffers[thread];
+                if (build_wK) {
+                    if (wbatch_buffer.size() < batch_size) wbatch_buffer.resize(batch_size);
+                    nwbatch = (*wints)[thread]->compute_shell_batch(quartets, wbatch_buffer.data());
+                }
+                task_integral_time += JKStats::wall_time() - integral_start;
+                if (nbatch == 0 && nwbatch == 0) continue;  // No integrals in this batch
+                computed_shells += nbatch;
+                task_quartets += nbatch;
+
+                const double* buffer = batch_buffer.data();
+                const double* wbuffer = wbatch_buffer.data();
+                for (size_t ket = 0; ket < quartets.size(); ket++) {
+                    int R2 = ket_tasks[ket].first;
+                    int S2 = ket_tasks[ket].second;
+                    int R = quartets[ket][2];
+                    int S = quartets[ket][3];
+
+                    int Rsize = primary_->shell(R).nfunction();
+                    int Ssize = primary_->shell(S).nfunction();
+
+                    int Poff = primary_->shell(P).function_index();
+                    int Qoff = primary_->shell(Q).function_index();
+                    int Roff = primary_->shell(R).function_index();
+                    int Soff = primary_->shell(S).function_index();
+
+                    int Poff2 = task_offsets[P2] - task_offsets[P2start];
+                    int Qoff2 = task_offsets[Q2] - task_offsets[Q2start];
+                    int Roff2 = task_offsets[R2] - task_offsets[R2start];
+                    int Soff2 = task_offsets[S2] - task_offsets[S2start];
+
+                    // if (thread == 0) timer_on("JK: GEMV");
+                    for (size_t job = 0; job < njob; job++) {
+                        // The range-separated jobs only build wK, from the erf integrals
+                        bool lr = (job >= D.size());
+                        size_t ind = (lr ? job - D.size() : job);
+                        bool job_J = (build_J && !lr);
+                        bool job_K = (build_K || lr);
+                        double** Dp = D[ind]->pointer();
+                        double** JTp; 
+                        if (job_J) JTp = JT[thread][ind]->pointer();
+                        double** KTp;
+                        if (job_K) KTp = KT[thread][lr ? nK + ind : ind]->pointer();
+                        const double* buffer2 = (lr ? wbuffer : buffer);
+
+                        if (!touched) {
+                            if (job_J) {
+                                ::memset((void*)JTp[0L * max_task], '\0', dPsize * dQsize * sizeof(double));
+                                ::memset((void*)JTp[1L * max_task], '\0', dRsize * dSsize * sizeof(double));
+                            }
 
-                                if (build_K) {
-                                    ::memset((void*)KTp[0L * max_task], '\0', dPsize * dRsize * sizeof(double));
-                                    ::memset((void*)KTp[1L * max_task], '\0', dPsize * dSsize * sizeof(double));
-                                    ::memset((void*)KTp[2L * max_task], '\0', dQsize * dRsize * sizeof(double));
-                                    ::memset((void*)KTp[3L * max_task], '\0', dQsize * dSsize * sizeof(double));
-                                    if (!lr_symmetric_) {
-                                        ::memset((void*)KTp[4L * max_task], '\0', dRsize * dPsize * sizeof(double));
-                                        ::memset((void*)KTp[5L * max_task], '\0', dSsize * dPsize * sizeof(double));
-                                        ::memset((void*)KTp[6L * max_task], '\0', dRsize * dQsize * sizeof(double));
-                                        ::memset((void*)KTp[7L * max_task], '\0', dSsize * dQsize * sizeof(double));
-                                    }
+                            if (job_K) {
+                                ::memset((void*)KTp[0L * max_task], '\0', dPsize * dRsize * sizeof(double));
+                                ::memset((void*)KTp[1L * max_task], '\0', dPsize * dSsize * sizeof(double));
+                                ::memset((void*)KTp[2L * max_task], '\0', dQsize * dRsize * sizeof(double));
+                                ::memset((void*)KTp[3L * max_task], '\0', dQsize * dSsize * sizeof(double));
+                                if (!lr_symmetric_) {
+                                    ::memset((void*)KTp[4L * max_task], '\0', dRsize * dPsize * sizeof(double));
+                                    ::memset((void*)KTp[5L * max_task], '\0', dSsize * dPsize * sizeof(double));
+                                    ::memset((void*)KTp[6L * max_task], '\0', dRsize * dQsize * sizeof(double));
+                                    ::memset((void*)KTp[7L * max_task], '\0', dSsize * dQsize * sizeof(double));
                                 }
                             }
+                        }
 
-                            // Intermediate Contraction Pointers
-                            double* J1p;
-                            double* J2p;
-                            double* K1p;
-                            double* K2p;
-                            double* K3p;
-                            double* K4p;
-                            double* K5p;
-                            double* K6p;
-                            double* K7p;
-                            double* K8p;
-
-                            if (build_J) {
-                                J1p = JTp[0L * max_task];
-                                J2p = JTp[1L * max_task];
-                            }
+                        // Intermediate Contraction Pointers
+                        double* J1p;
+                        double* J2p;
+                        double* K1p;
+                        double* K2p;
+                        double* K3p;
+                        double* K4p;
+                        double* K5p;
+                        double* K6p;
+                        double* K7p;
+                        double* K8p;
+
+                        if (job_J) {
+                            J1p = JTp[0L * max_task];
+                            J2p = JTp[1L * max_task];
+                        }
 
-                            if (build_K) {
-                                K1p = KTp[0L * max_task];
-                                K2p = KTp[1L * max_task];
-                                K3p = KTp[2L * max_task];
-                                K4p = KTp[3L * max_task];
-                                if (!lr_symmetric_) {
-                                    K5p = KTp[4L * max_task];
-                                    K6p = KTp[5L * max_task];
-                                    K7p = KTp[6L * max_task];
-                                    K8p = KTp[7L * max_task];
-                                }
+                        if (job_K) {
+                            K1p = KTp[0L * max_task];
+                            K2p = KTp[1L * max_task];
+                            K3p = KTp[2L * max_task];
+                            K4p = KTp[3L * max_task];
+                            if (!lr_symmetric_) {
+                                K5p = KTp[4L * max_task];
+                                K6p = KTp[5L * max_task];
+                                K7p = KTp[6L * max_task];
+                                K8p = KTp[7L * max_task];
                             }
+                        }
 
-                            double prefactor = 1.0;
-                            if (P == Q) prefactor *= 0.5;
-                            if (R == S) prefactor *= 0.5;
-                            if (P == R && Q == S) prefactor *= 0.5;
-
-                            for (int p = 0; p < Psize; p++) {
-                                for (int q = 0; q < Qsize; q++) {
-                                    for (int r = 0; r < Rsize; r++) {
-                                        for (int s = 0; s < Ssize; s++) {
-                                            if (build_J) {
-                                                J1p[(p + Poff2) * dQsize + q + Qoff2] +=
-                                                    prefactor * (Dp[r + Roff][s + Soff] + Dp[s + Soff][r + Roff]) *
-                                                    (*buffer2);
-                                                J2p[(r + Roff2) * dSsize + s + Soff2] +=
-                                                    prefactor * (Dp[p + Poff][q + Qoff] + Dp[q + Qoff][p + Poff]) *
-                                                    (*buffer2);
-                                            }
-                                            
-                                            if (build_K) {
-                                                K1p[(p + Poff2) * dRsize + r + Roff2] +=
-                                                    prefactor * (Dp[q + Qoff][s + Soff]) * (*buffer2);
-                                                K2p[(p + Poff2) * dSsize + s + Soff2] +=
-                                                    prefactor * (Dp[q + Qoff][r + Roff]) * (*buffer2);
-                                                K3p[(q + Qoff2) * dRsize + r + Roff2] +=
-                                                    prefactor * (Dp[p + Poff][s + Soff]) * (*buffer2);
-                                                K4p[(q + Qoff2) * dSsize + s + Soff2] +=
-                                                    prefactor * (Dp[p + Poff][r + Roff]) * (*buffer2);
-                                                if (!lr_symmetric_) {
-                                                    K5p[(r + Roff2) * dPsize + p + Poff2] +=
-                                                        prefactor * (Dp[s + Soff][q + Qoff]) * (*buffer2);
-                                                    K6p[(s + Soff2) * dPsize + p + Poff2] +=
-                                                        prefactor * (Dp[r + Roff][q + Qoff]) * (*buffer2);
-                                                    K7p[(r + Roff2) * dQsize + q + Qoff2] +=
-                                                        prefactor * (Dp[s + Soff][p + Poff]) * (*buffer2);
-                                                    K8p[(s + Soff2) * dQsize + q + Qoff2] +=
-                                                        prefactor * (Dp[r + Roff][p + Poff]) * (*buffer2);
-                                                }
+                        double prefactor = 1.0;
+                        if (P == Q) prefactor *= 0.5;
+                        if (R == S) prefactor *= 0.5;
+                        if (P == R && Q == S) prefactor *= 0.5;
+
+                        for (int p = 0; p < Psize; p++) {
+                            for (int q = 0; q < Qsize; q++) {
+                                for (int r = 0; r < Rsize; r++) {
+                                    for (int s = 0; s < Ssize; s++) {
+                                        if (job_J) {
+                                            J1p[(p + Poff2) * dQsize + q + Qoff2] +=
+                                                prefactor * (Dp[r + Roff][s + Soff] + Dp[s + Soff][r + Roff]) *
+                                                (*buffer2);
+                                            J2p[(r + Roff2) * dSsize + s + Soff2] +=
+                                                prefactor * (Dp[p + Poff][q + Qoff] + Dp[q + Qoff][p + Poff]) *
+                                                (*buffer2);
+                                        }
+                                        
+                                        if (job_K) {
+                                            K1p[(p + Poff2) * dRsize + r + Roff2] +=
+                                                prefactor * (Dp[q + Qoff][s + Soff]) * (*buffer2);
+                                            K2p[(p + Poff2) * dSsize + s + Soff2] +=
+                                                prefactor * (Dp[q + Qoff][r + Roff]) * (*buffer2);
+                                            K3p[(q + Qoff2) * dRsize + r + Roff2] +=
+                                                prefactor * (Dp[p + Poff][s + Soff]) * (*buffer2);
+                                            K4p[(q + Qoff2) * dSsize + s + Soff2] +=
+                                                prefactor * (Dp[p + Poff][r + Roff]) * (*buffer2);
+                                            if (!lr_symmetric_) {
+                                                K5p[(r + Roff2) * dPsize + p + Poff2] +=
+                                                    prefactor * (Dp[s + Soff][q + Qoff]) * (*buffer2);
+                                                K6p[(s + Soff2) * dPsize + p + Poff2] +=
+                                                    prefactor * (Dp[r + Roff][q + Qoff]) * (*buffer2);
+                                                K7p[(r + Roff2) * dQsize + q + Qoff2] +=
+                                                    prefactor * (Dp[s + Soff][p + Poff]) * (*buffer2);
+                                                K8p[(s + Soff2) * dQsize + q + Qoff2] +=
+                                                    prefactor * (Dp[r + Roff][p + Poff]) * (*buffer2);
                                             }
-                                            
-                                            buffer2++;
                                         }
+                                        
+                                        buffer2++;
                                     }
                                 }
                             }
                         }
-                        touched = true;
-                        // if (thread == 0) timer_off("JK: GEMV");
                     }
+                    buffer += (size_t)Psize * Qsize * Rsize * Ssize;
+                    wbuffer += (size_t)Psize * Qsize * Rsize * Ssize;
+                    touched = true;
+                    // if (thread == 0) timer_off("JK: GEMV");
                 }
             }
         }  // End Shell Quartets
 
-        if (!touched) continue;
+        if (!touched) {
+            integral_time += task_integral_time;
+            if (trace) timer_trace_end("DirectJK: Task", thread);
+            continue;
+        }
 
         // => Stripe out <= //
         if (build_J) {
@@ -733,27 +902,32 @@ void DirectJK::build_JK_matrices(std::vector<std::shared_ptr<TwoBodyAOInt>>& int
 	    }
         }
         
-        if (build_K && lr_symmetric_) {
+        if ((build_K || build_wK) && lr_symmetric_) {
 	    for (auto& KTmat : KT[thread]) {
                 KTmat->scale(2.0);
 	    }
         }
 
         // if (thread == 0) timer_on("JK: Atomic");
-        for (size_t ind = 0; ind < D.size(); ind++) {
+        for (size_t job = 0; job < njob; job++) {
+            bool lr = (job >= D.size());
+            size_t ind = (lr ? job - D.size() : job);
+            bool job_J = (build_J && !lr);
+            bool job_K = (build_K || lr);
             double** JTp;
             double** KTp;
             double** Jp;
             double** Kp;
 
-            if (build_J) {
+            if (job_J) {
                 JTp = JT[thread][ind]->pointer();
-                Jp = J[ind]->pointer();
+                Jp = (JD.empty() ? J[ind] : JD[thread_domain[thread]][ind])->pointer();
             }
             
-            if (build_K) {
-                KTp = KT[thread][ind]->pointer();
-                Kp = K[ind]->pointer();
+            if (job_K) {
+                size_t kind = (lr ? nK + ind : ind);
+                KTp = KT[thread][kind]->pointer();
+                Kp = (KD.empty() ? (lr ? (*wK)[ind] : K[ind]) : KD[thread_domain[thread]][kind])->pointer();
             }
 
             double* J1p;
@@ -767,12 +941,12 @@ void DirectJK::build_JK_matrices(std::vector<std::shared_ptr<TwoBodyAOInt>>& int
             double* K7p;
             double* K8p;
 
-            if (build_J) {
+            if (job_J) {
                 J1p = JTp[0L * max_task];
                 J2p = JTp[1L * max_task];
             }
 
-            if (build_K) {
+            if (job_K) {
                 K1p = KTp[0L * max_task];
                 K2p = KTp[1L * max_task];
                 K3p = KTp[2L * max_task];
@@ -785,7 +959,7 @@ void DirectJK::build_JK_matrices(std::vector<std::shared_ptr<TwoBodyAOInt>>& int
                 }
             }
 
-            if (build_J) {
+            if (job_J) {
 
                 // > J_PQ < //
 
@@ -830,7 +1004,7 @@ void DirectJK::build_JK_matrices(std::vector<std::shared_ptr<TwoBodyAOInt>>& int
                 }
             }
 
-            if (build_K) {
+            if (job_K) {
 
                 // > K_PR < //
 
@@ -936,8 +1110,42 @@ void DirectJK::build_JK_matrices(std::vector<std::shared_ptr<TwoBodyAOInt>>& int
         }  // End stripe out
         // if (thread == 0) timer_off("JK: Atomic");
 
+        integral_time += task_integral_time;
+        contraction_time += JKStats::wall_time() - task_start - task_integral_time;
+        if (trace) {
+            timer_trace_counter("DirectJK: Quartets", task_quartets, thread);
+            timer_trace_end("DirectJK: Task", thread);
+        }
     }  // End master task list
 
+    // => Reduce the per-domain partials, one row stripe per thread, then over ranks <= //
+    if (!JD.empty() || !KD.empty()) {
+        int nbf = primary_->nbf();
+        // the partials of X start at entry offset of each domain
+        auto reduce = [&](std::vector<SharedMatrix>& X, std::vector<std::vector<SharedMatrix>>& XD, size_t offset) {
+            for (size_t ind = 0; ind < X.size(); ind++) {
+                double** Xp = X[ind]->pointer();
+                double** X0p = XD[0][offset + ind]->pointer();
+#pragma omp parallel for schedule(static) num_threads(nthread)
+                for (int m = 0; m < nbf; m++) {
+                    for (size_t domain = 1; domain < XD.size(); domain++) {
+                        C_DAXPY(nbf, 1.0, XD[domain][offset + ind]->pointer()[m], 1, X0p[m], 1);
+                    }
+                }
+
+                reduce_partial(XD[0][offset + ind]);
+
+#pragma omp parallel for schedule(static) num_threads(nthread)
+                for (int m = 0; m < nbf; m++) {
+                    C_DAXPY(nbf, 1.0, X0p[m], 1, Xp[m], 1);
+                }
+            }
+        };
+        if (!JD.empty()) reduce(J, JD, 0);
+        if (!KD.empty()) reduce(K, KD, 0);
+        if (!KD.empty() && build_wK) reduce(*wK, KD, nK);
+    }
+
     for (auto& Jmat : J) {
         Jmat->hermitivitize();
     }
@@ -946,6 +1154,9 @@ void DirectJK::build_JK_matrices(std::vector<std::shared_ptr<TwoBodyAOInt>>& int
         for (auto& Kmat : K) {
             Kmat->hermitivitize();
         }
+        for (size_t ind = 0; build_wK && ind < wK->size(); ind++) {
+            (*wK)[ind]->hermitivitize();
+        }
     }
 
     num_computed_shells_ = computed_shells;
@@ -953,6 +1164,26 @@ void DirectJK::build_JK_matrices(std::vector<std::shared_ptr<TwoBodyAOInt>>& int
         computed_shells_per_iter_["Quartets"].push_back(num_computed_shells());
     }
 
+    // => Performance counters <= //
+    // (this process's share of the unique quartets, for distributed builds)
+    size_t npair = nshell * (nshell + 1L) / 2;
+    size_t nquartet = npair * (npair + 1L) / 2 / task_nranks_;
+    stats_.shells_computed += computed_shells;
+    stats_.shells_screened += (nquartet > computed_shells ? nquartet - computed_shells : 0);
+    stats_.integral_time += integral_time;
+    stats_.contraction_time += contraction_time;
+    size_t scratch = 0;
+    auto tally = [&scratch](const std::vector<std::vector<SharedMatrix>>& buffers) {
+        for (const auto& thread_buffers : buffers) {
+            for (const auto& M : thread_buffers) scratch += M->rowdim() * (size_t)M->coldim() * sizeof(double);
+        }
+    };
+    tally(JT);
+    tally(KT);
+    tally(JD);
+    tally(KD);
+    stats_.peak_scratch_bytes = std::max(stats_.peak_scratch_bytes, scratch);
+
     timer_off("build_JK_matrices()");
 }
 
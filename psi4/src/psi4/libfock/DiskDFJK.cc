@@ -42,11 +42,12 @@
 
 #include "jk.h"
 
+#include <algorithm>
 #include <sstream>
 #include "psi4/libpsi4util/PsiOutStream.h"
+#include "psi4/libpsi4util/process.h"
 #ifdef _OPENMP
 #include <omp.h>
-#include "psi4/libpsi4util/process.h"
 #endif
 
 using namespace psi;
@@ -75,6 +76,16 @@ void DiskDFJK::common_init() {
         std::make_shared<IntegralFactory>(auxiliary_, zero, primary_, primary_);
     auto tmperi = std::shared_ptr<TwoBodyAOInt>(rifactory->eri());
     n_function_pairs_ = tmperi->function_pairs().size();
+
+    incfock_ = options_.exists("INCFOCK") && options_.get_bool("INCFOCK");
+    incfock_count_ = 0;
+    do_incfock_iter_ = false;
+    if (incfock_) {
+        if (options_.get_int("INCFOCK_FULL_FOCK_EVERY") <= 0) {
+            throw PSIEXCEPTION("Invalid input for option INCFOCK_FULL_FOCK_EVERY (<= 0)");
+        }
+        incfock_df_tolerance_ = options_.get_double("INCFOCK_DF_TOLERANCE");
+    }
 }
 size_t DiskDFJK::memory_estimate() {
     size_t three_memory = ((size_t)auxiliary_->nbf()) * n_function_pairs_;
@@ -279,6 +290,7 @@ void DiskDFJK::print_header() const {
         outfile->Printf("    Memory [MiB]:      %11ld\n", (memory_ * 8L) / (1024L * 1024L));
         outfile->Printf("    Algorithm:         %11s\n", (is_core_ ? "Core" : "Disk"));
         outfile->Printf("    Integral Cache:    %11s\n", df_ints_io_.c_str());
+        outfile->Printf("    Incremental Fock:  %11s\n", (incfock_ ? "Yes" : "No"));
         outfile->Printf("    Schwarz Cutoff:    %11.0E\n", cutoff_);
         outfile->Printf("    Fitting Condition: %11.0E\n\n", condition_);
 
@@ -340,8 +352,8 @@ int DiskDFJK::max_rows() const {
     size_t row_cost = 0L;
     // Copies of E tensor
     row_cost += (lr_symmetric_ ? 1L : 2L) * max_nocc() * primary_->nbf();
-    // Slices of Qmn tensor, including AIO buffer (NOTE: AIO not implemented yet)
-    row_cost += (is_core_ ? 1L : 1L) * n_function_pairs_;
+    // Slices of Qmn tensor, including AIO buffer
+    row_cost += (is_core_ ? 1L : 2L) * n_function_pairs_;
 
     size_t max_rows = mem / row_cost;
 
@@ -467,9 +479,59 @@ void DiskDFJK::preiterations() {
 
 void DiskDFJK::compute_JK() {
 
-    // zero out J, K, and wK matrices
-    zero();
+    if (incfock_) {
+        timer_on("DiskDFJK: INCFOCK Preprocessing");
+        do_incfock_iter_ = incfock_df_setup(options_, true, initial_iteration_, incfock_count_, incfock_df_tolerance_,
+                                            max_nocc(), D_prev_, C_incfock_, D_incfock_);
+        timer_off("DiskDFJK: INCFOCK Preprocessing");
+    } else {
+        // zero out J, K, and wK matrices
+        zero();
+    }
+
+    if (do_incfock_iter_) {
+        // The block_J/block_K machinery works off of the member C/D/J/K vectors, so swap
+        // the factored density change in for the duration of the build
+        std::vector<SharedMatrix> J_incr, K_incr, wK_incr;
+        incfock_df_buffers(C_incfock_.size(), J_incr, K_incr, wK_incr);
+
+        std::swap(C_left_, C_incfock_);
+        std::swap(J_ao_, J_incr);
+        std::swap(K_ao_, K_incr);
+        std::swap(wK_ao_, wK_incr);
+        std::swap(D_ao_, D_incfock_);
+        std::vector<SharedMatrix> C_left_ao = C_left_ao_;
+        std::vector<SharedMatrix> C_right_ao = C_right_ao_;
+        std::vector<SharedMatrix> C_right = C_right_;
+        C_left_ao_ = C_left_;
+        C_right_ao_ = C_left_;
+        C_right_ = C_left_;
+
+        build_JK_matrices();
+
+        std::swap(C_left_, C_incfock_);
+        std::swap(J_ao_, J_incr);
+        std::swap(K_ao_, K_incr);
+        std::swap(wK_ao_, wK_incr);
+        std::swap(D_ao_, D_incfock_);
+        C_left_ao_ = C_left_ao;
+        C_right_ao_ = C_right_ao;
+        C_right_ = C_right;
+
+        incfock_df_accumulate(J_incr, K_incr, wK_incr);
+    } else {
+        build_JK_matrices();
+    }
+
+    if (incfock_) {
+        timer_on("DiskDFJK: INCFOCK Postprocessing");
+        incfock_df_postiter(D_prev_);
+        timer_off("DiskDFJK: INCFOCK Postprocessing");
+    }
 
+    if (initial_iteration_) initial_iteration_ = false;
+}
+void DiskDFJK::build_JK_matrices() {
     max_nocc_ = max_nocc();
     max_rows_ = max_rows();
 
@@ -1654,6 +1716,7 @@ void DiskDFJK::rebuild_wK_disk() {
     // No need to close
 }
 void DiskDFJK::manage_JK_core() {
+    double start = JKStats::wall_time();
     for (int Q = 0; Q < auxiliary_->nbf(); Q += max_rows_) {
         int naux = (auxiliary_->nbf() - Q <= max_rows_ ? auxiliary_->nbf() - Q : max_rows_);
         if (do_J_) {
@@ -1667,18 +1730,38 @@ void DiskDFJK::manage_JK_core() {
             timer_off("JK: K");
         }
     }
+    stats_.contraction_time += JKStats::wall_time() - start;
+    stats_.peak_scratch_bytes = std::max(stats_.peak_scratch_bytes, memory_temp() * sizeof(double));
 }
 void DiskDFJK::manage_JK_disk() {
+    int naux_total = auxiliary_->nbf();
     Qmn_ = std::make_shared<Matrix>("(Q|mn) Block", max_rows_, n_function_pairs_);
+    if (max_rows_ < naux_total) Qmn_next_ = std::make_shared<Matrix>("(Q|mn) Block", max_rows_, n_function_pairs_);
     psio_->open(unit_, PSIO_OPEN_OLD);
-    for (int Q = 0; Q < auxiliary_->nbf(); Q += max_rows_) {
-        int naux = (auxiliary_->nbf() - Q <= max_rows_ ? auxiliary_->nbf() - Q : max_rows_);
+
+    // Double buffering: the read of the next block is in flight while the current one is contracted
+    auto aio = std::make_shared<AIOHandler>(psio_);
+    psio_address end[2];
+    auto read_block = [&](int Q, SharedMatrix block, psio_address* endp) {
+        int naux = (naux_total - Q <= max_rows_ ? naux_total - Q : max_rows_);
         psio_address addr = psio_get_address(PSIO_ZERO, (Q * (size_t)n_function_pairs_) * sizeof(double));
+        stats_.disk_bytes_read += sizeof(double) * naux * n_function_pairs_;
+        return aio->read(unit_, "(Q|mn) Integrals", (char*)(block->pointer()[0]),
+                         sizeof(double) * naux * n_function_pairs_, addr, endp);
+    };
 
+    size_t job = read_block(0, Qmn_, &end[0]);
+    for (int Q = 0, block = 0; Q < naux_total; Q += max_rows_, block++) {
+        int naux = (naux_total - Q <= max_rows_ ? naux_total - Q : max_rows_);
+
+        // only the time not hidden behind the previous contraction is counted here
         timer_on("JK: (Q|mn) Read");
-        psio_->read(unit_, "(Q|mn) Integrals", (char*)(Qmn_->pointer()[0]), sizeof(double) * naux * n_function_pairs_, addr, &addr);
+        aio->wait_for_job(job);
         timer_off("JK: (Q|mn) Read");
 
+        if (Q + max_rows_ < naux_total) job = read_block(Q + max_rows_, Qmn_next_, &end[(block + 1) % 2]);
+
+        double start = JKStats::wall_time();
         if (do_J_) {
             timer_on("JK: J");
             block_J(&Qmn_->pointer()[0], naux);
@@ -1689,9 +1772,17 @@ void DiskDFJK::manage_JK_disk() {
             block_K(&Qmn_->pointer()[0], naux);
             timer_off("JK: K");
         }
+        stats_.contraction_time += JKStats::wall_time() - start;
+
+        std::swap(Qmn_, Qmn_next_);
     }
+    aio->synchronize();
+    size_t block_bytes = sizeof(double) * max_rows_ * n_function_pairs_;
+    stats_.peak_scratch_bytes = std::max(stats_.peak_scratch_bytes, memory_temp() * sizeof(double) +
+                                                                        (Qmn_next_ ? 2 : 1) * block_bytes);
     psio_->close(unit_, 1);
     Qmn_.reset();
+    Qmn_next_.reset();
 }
 void DiskDFJK::manage_wK_core() {
     int max_rows_w = max_rows_ / 2;
@@ -1699,9 +1790,11 @@ void DiskDFJK::manage_wK_core() {
     for (int Q = 0; Q < auxiliary_->nbf(); Q += max_rows_w) {
         int naux = (auxiliary_->nbf() - Q <= max_rows_w ? auxiliary_->nbf() - Q : max_rows_w);
 
+        double start = JKStats::wall_time();
         timer_on("JK: wK");
         block_wK(&Qlmn_->pointer()[Q], &Qrmn_->pointer()[Q], naux);
         timer_off("JK: wK");
+        stats_.contraction_time += JKStats::wall_time() - start;
     }
 }
 void DiskDFJK::manage_wK_disk() {
@@ -1725,10 +1818,13 @@ void DiskDFJK::manage_wK_disk() {
         psio_->read(unit_, "Right (Q|w|mn) Integrals", (char*)(Qrmn_->pointer()[0]), sizeof(double) * naux * n_function_pairs_, addr,
                     &addr);
         timer_off("JK: (Q|mn)^R Read");
+        stats_.disk_bytes_read += 2 * sizeof(double) * naux * n_function_pairs_;
 
+        double start = JKStats::wall_time();
         timer_on("JK: wK");
         block_wK(&Qlmn_->pointer()[0], &Qrmn_->pointer()[0], naux);
         timer_off("JK: wK");
+        stats_.contraction_time += JKStats::wall_time() - start;
     }
     psio_->close(unit_, 1);
     Qlmn_.reset();
@@ -1750,6 +1846,8 @@ void DiskDFJK::block_J(double** Qmnp, int naux) {
             D2p[mn] = (m == n ? Dp[m][n] : Dp[m][n] + Dp[n][m]);
         }
 
+        stats_.gemm_flops += 4.0 * naux * num_nm;
+
         timer_on("JK: J1");
         C_DGEMV('N', naux, num_nm, 1.0, Qmnp[0], num_nm, D2p, 1, 0.0, dp, 1);
         timer_off("JK: J1");
@@ -1769,6 +1867,9 @@ void DiskDFJK::block_K(double** Qmnp, int naux) {
     const std::vector<std::pair<int, int> >& function_pairs = eri_.front()->function_pairs();
     const std::vector<long int>& function_pairs_to_dense = eri_.front()->function_pairs_to_dense();
     size_t num_nm = function_pairs.size();
+    // the half-transform GEMMs run over the significant partners of each function
+    size_t npartners = 0;
+    for (const auto& partners : eri_.front()->significant_partners_per_function()) npartners += partners.size();
 
     for (size_t N = 0; N < K_ao_.size(); N++) {
         int nbf = C_left_ao_[N]->rowspi()[0];
@@ -1810,6 +1911,7 @@ void DiskDFJK::block_K(double** Qmnp, int naux) {
             }
 
             timer_off("JK: K1");
+            stats_.gemm_flops += 2.0 * nocc * naux * npartners;
         }
 
         if (!lr_symmetric_ && (N == 0 || C_right_[N].get() != C_right_[N - 1].get())) {
@@ -1844,18 +1946,23 @@ void DiskDFJK::block_K(double** Qmnp, int naux) {
                 }
 
                 timer_off("JK: K1");
+                stats_.gemm_flops += 2.0 * nocc * naux * npartners;
             }
         }
 
         timer_on("JK: K2");
         C_DGEMM('N', 'T', nbf, nbf, naux * nocc, 1.0, Elp[0], naux * nocc, Erp[0], naux * nocc, 1.0, Kp[0], nbf);
         timer_off("JK: K2");
+        stats_.gemm_flops += 2.0 * nbf * nbf * naux * nocc;
     }
 }
 void DiskDFJK::block_wK(double** Qlmnp, double** Qrmnp, int naux) {
     const std::vector<std::pair<int, int> >& function_pairs = eri_.front()->function_pairs();
     const std::vector<long int>& function_pairs_to_dense = eri_.front()->function_pairs_to_dense();
     size_t num_nm = function_pairs.size();
+    // the half-transform GEMMs run over the significant partners of each function
+    size_t npartners = 0;
+    for (const auto& partners : eri_.front()->significant_partners_per_function()) npartners += partners.size();
 
     for (size_t N = 0; N < wK_ao_.size(); N++) {
         int nbf = C_left_ao_[N]->rowspi()[0];
@@ -1897,6 +2004,7 @@ void DiskDFJK::block_wK(double** Qlmnp, double** Qrmnp, int naux) {
             }
 
             timer_off("JK: wK1");
+            stats_.gemm_flops += 2.0 * nocc * naux * npartners;
         }
 
         timer_on("JK: wK1");
@@ -1926,9 +2034,11 @@ void DiskDFJK::block_wK(double** Qlmnp, double** Qrmnp, int naux) {
         }
 
         timer_off("JK: wK1");
+        stats_.gemm_flops += 2.0 * nocc * naux * npartners;
 
         timer_on("JK: wK2");
         C_DGEMM('N', 'T', nbf, nbf, naux * nocc, 1.0, Elp[0], naux * nocc, Erp[0], naux * nocc, 1.0, wKp[0], nbf);
+        stats_.gemm_flops += 2.0 * nbf * nbf * naux * nocc;
         timer_off("JK: wK2");
     }
 }
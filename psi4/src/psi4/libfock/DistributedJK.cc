@@ -0,0 +1,107 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Psi4: an open-source quantum chemistry software package
+ *
+ * Copyright (c) 2007-2023 The Psi4 Developers.
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This file is part of Psi4.
+ *
+ * Psi4 is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * Psi4 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with Psi4; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * @END LICENSE
+ */
+
+#include "jk.h"
+
+#include <cstdlib>
+
+#include "psi4/libmints/basisset.h"
+#include "psi4/libmints/matrix.h"
+#include "psi4/libpsi4util/PsiOutStream.h"
+#include "psi4/libpsi4util/exception.h"
+#include "psi4/libqt/qt.h"
+
+#ifdef USING_MPI
+#include <mpi.h>
+#endif
+
+namespace psi {
+
+#ifdef USING_MPI
+namespace {
+void initialize_mpi() {
+    int initialized = 0;
+    MPI_Initialized(&initialized);
+    if (initialized) return;
+
+    // all MPI calls are made from the master thread, outside of OpenMP regions
+    int provided = 0;
+    MPI_Init_thread(nullptr, nullptr, MPI_THREAD_FUNNELED, &provided);
+    if (provided < MPI_THREAD_FUNNELED) {
+        throw PSIEXCEPTION("DistributedJK: MPI library does not provide MPI_THREAD_FUNNELED");
+    }
+    std::atexit([]() {
+        int finalized = 0;
+        MPI_Finalized(&finalized);
+        if (!finalized) MPI_Finalize();
+    });
+}
+}  // namespace
+#endif
+
+int DistributedJK::mpi_size() {
+    int size = 1;
+#ifdef USING_MPI
+    initialize_mpi();
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+#endif
+    return size;
+}
+int DistributedJK::mpi_rank() {
+    int rank = 0;
+#ifdef USING_MPI
+    initialize_mpi();
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+#endif
+    return rank;
+}
+
+DistributedJK::DistributedJK(std::shared_ptr<BasisSet> primary, Options& options) : DirectJK(primary, options) {
+    task_rank_ = mpi_rank();
+    task_nranks_ = mpi_size();
+}
+DistributedJK::~DistributedJK() {}
+
+void DistributedJK::reduce_partial(SharedMatrix partial) {
+#ifdef USING_MPI
+    timer_on("JK: MPI Allreduce");
+    size_t size = (size_t)partial->rowspi()[0] * partial->colspi()[0];
+    MPI_Allreduce(MPI_IN_PLACE, partial->pointer()[0], (int)size, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+    timer_off("JK: MPI Allreduce");
+#endif
+}
+
+void DistributedJK::print_header() const {
+    DirectJK::print_header();
+    if (print_) {
+        outfile->Printf("    MPI Ranks:         %11d\n", task_nranks_);
+        outfile->Printf("    This Rank:         %11d\n\n", task_rank_);
+    }
+}
+
+}  // namespace psi
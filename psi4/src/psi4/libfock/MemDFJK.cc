@@ -42,11 +42,13 @@
 
 #include "jk.h"
 
+#include <algorithm>
 #include <sstream>
 #include "psi4/libpsi4util/PsiOutStream.h"
+#include "psi4/libpsi4util/process.h"
+#include "psi4/liboptions/liboptions.h"
 #ifdef _OPENMP
 #include <omp.h>
-#include "psi4/libpsi4util/process.h"
 #endif
 
 using namespace psi;
@@ -61,7 +63,26 @@ MemDFJK::MemDFJK(std::shared_ptr<BasisSet> primary, std::shared_ptr<BasisSet> au
 
 MemDFJK::~MemDFJK() {}
 
-void MemDFJK::common_init() { dfh_ = std::make_shared<DFHelper>(primary_, auxiliary_); }
+void MemDFJK::common_init() {
+    dfh_ = std::make_shared<DFHelper>(primary_, auxiliary_);
+
+    if (options_.exists("DF_K_ORBITAL_TOLERANCE")) {
+        dfh_->set_K_orbital_cutoff(options_.get_double("DF_K_ORBITAL_TOLERANCE"));
+    }
+    if (options_.exists("DF_METRIC_SOLVE")) {
+        dfh_->set_metric_solve(options_.get_bool("DF_METRIC_SOLVE"));
+    }
+
+    incfock_ = options_.exists("INCFOCK") && options_.get_bool("INCFOCK");
+    incfock_count_ = 0;
+    do_incfock_iter_ = false;
+    if (incfock_) {
+        if (options_.get_int("INCFOCK_FULL_FOCK_EVERY") <= 0) {
+            throw PSIEXCEPTION("Invalid input for option INCFOCK_FULL_FOCK_EVERY (<= 0)");
+        }
+        incfock_df_tolerance_ = options_.get_double("INCFOCK_DF_TOLERANCE");
+    }
+}
 size_t MemDFJK::memory_estimate() {
     dfh_->set_nthreads(omp_nthread_);
     dfh_->set_schwarz_cutoff(cutoff_);
@@ -95,12 +116,50 @@ void MemDFJK::preiterations() {
     dfh_->initialize();
 }
 void MemDFJK::compute_JK() {
+    // A precision switch spoils the previous K, so rebuild it in full
+    bool precision_changed = (dfh_->get_K_low_precision() != low_precision_);
+    dfh_->set_K_low_precision(low_precision_);
+
+    if (incfock_) {
+        timer_on("MemDFJK: INCFOCK Preprocessing");
+        do_incfock_iter_ = incfock_df_setup(options_, !precision_changed, initial_iteration_, incfock_count_,
+                                            incfock_df_tolerance_, max_nocc(), D_prev_, C_incfock_, D_incfock_);
+        timer_off("MemDFJK: INCFOCK Preprocessing");
+    } else {
+        // zero out J, K, and wK matrices
+        zero();
+    }
 
-    // zero out J, K, and wK matrices
-    zero();
+    if (do_incfock_iter_) {
+        // Contract the factored density change and add it onto last iteration's J/K/wK
+        size_t max_nocc_incr = 0;
+        for (const auto& C : C_incfock_) max_nocc_incr = std::max(max_nocc_incr, (size_t)C->colspi()[0]);
+
+        std::vector<SharedMatrix> J_incr, K_incr, wK_incr;
+        incfock_df_buffers(C_incfock_.size(), J_incr, K_incr, wK_incr);
+
+        dfh_->build_JK(C_incfock_, C_incfock_, D_incfock_, J_incr, K_incr, wK_incr, max_nocc_incr, do_J_, do_K_,
+                       do_wK_, true);
+
+        incfock_df_accumulate(J_incr, K_incr, wK_incr);
+    } else {
+        dfh_->build_JK(C_left_ao_, C_right_ao_, D_ao_, J_ao_, K_ao_, wK_ao_, max_nocc(), do_J_, do_K_, do_wK_,
+                       lr_symmetric_);
+    }
+
+    stats_.disk_bytes_read += dfh_->get_JK_disk_bytes();
+    stats_.gemm_flops += dfh_->get_JK_flops();
+    stats_.contraction_time += dfh_->get_JK_contraction_time();
+    stats_.peak_scratch_bytes = std::max(stats_.peak_scratch_bytes, dfh_->get_JK_scratch_bytes());
+
+    if (incfock_) {
+        timer_on("MemDFJK: INCFOCK Postprocessing");
+        incfock_df_postiter(D_prev_);
+        timer_off("MemDFJK: INCFOCK Postprocessing");
+    }
+
+    if (initial_iteration_) initial_iteration_ = false;
 
-    dfh_->build_JK(C_left_ao_, C_right_ao_, D_ao_, J_ao_, K_ao_, wK_ao_, max_nocc(), do_J_, do_K_, do_wK_,
-                   lr_symmetric_);
     if (lr_symmetric_) {
         if (do_wK_) {
             for (size_t N = 0; N < wK_ao_.size(); N++) {
@@ -109,7 +168,7 @@ void MemDFJK::compute_JK() {
         }
     }
 }
-void MemDFJK::postiterations() {}
+void MemDFJK::postiterations() { dfh_->clear_JK_buffers(); }
 void MemDFJK::print_header() const {
     // dfh_->print_header();
     if (print_) {
@@ -124,6 +183,10 @@ void MemDFJK::print_header() const {
         outfile->Printf("    Algorithm:          %11s\n", (dfh_->get_AO_core() ? "Core" : "Disk"));
         outfile->Printf("    Schwarz Cutoff:     %11.0E\n", cutoff_);
         outfile->Printf("    Mask sparsity (%%):  %11.4f\n", 100. * dfh_->ao_sparsity());
+        outfile->Printf("    Incremental Fock:   %11s\n", (incfock_ ? "Yes" : "No"));
+        if (dfh_->get_K_orbital_cutoff() > 0.0) {
+            outfile->Printf("    K Orbital Cutoff:   %11.0E\n", dfh_->get_K_orbital_cutoff());
+        }
         outfile->Printf("    Fitting Condition:  %11.0E\n\n", condition_);
 
         outfile->Printf("   => Auxiliary Basis Set <=\n\n");
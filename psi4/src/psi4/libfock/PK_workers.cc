@@ -35,6 +35,8 @@
 #include "psi4/libiwl/config.h"
 #include "PK_workers.h"
 
+#include <algorithm>
+
 namespace psi {
 
 namespace pk {
@@ -845,6 +847,91 @@ void PKWrkrInCore::finalize_ints_wK(size_t pk_pairs) {
     }
 }
 
+PKWrkrCompressed::PKWrkrCompressed(std::shared_ptr<BasisSet> primary, SharedInt eri, size_t buf_size, size_t pk_size)
+    : PKWorker(primary, eri, std::shared_ptr<AIOHandler>(), 0, buf_size), pk_size_(pk_size) {
+    J_buf_.resize(buf_size);
+    K_buf_.resize(buf_size);
+}
+
+void PKWrkrCompressed::initialize_task() {
+    set_max_idx(std::min(offset() + buf_size(), pk_size_) - 1);
+    if (do_wK()) {
+        std::fill(wK_buf_.begin(), wK_buf_.end(), 0.0);
+    } else {
+        std::fill(J_buf_.begin(), J_buf_.end(), 0.0);
+        std::fill(K_buf_.begin(), K_buf_.end(), 0.0);
+    }
+}
+
+void PKWrkrCompressed::allocate_wK(size_t buf_size, size_t buf_per_thread) {
+    std::vector<double>().swap(J_buf_);
+    std::vector<double>().swap(K_buf_);
+    set_bufsize(buf_size);
+    wK_buf_.resize(buf_size);
+}
+
+void PKWrkrCompressed::fill_values(double val, size_t i, size_t j, size_t k, size_t l) {
+    size_t ijkl = INDEX4(i, j, k, l);
+    size_t ikjl = INDEX4(i, k, j, l);
+
+    if (ijkl >= offset() && ijkl <= max_idx()) {
+        J_buf_[ijkl - offset()] += val;
+    }
+    if (ikjl >= offset() && ikjl <= max_idx()) {
+        if (i == k || j == l) {
+            K_buf_[ikjl - offset()] += val;
+        } else {
+            K_buf_[ikjl - offset()] += 0.5 * val;
+        }
+    }
+
+    if (i != j && k != l) {
+        size_t iljk = INDEX4(i, l, j, k);
+        if (iljk >= offset() && iljk <= max_idx()) {
+            if (i == l || j == k) {
+                K_buf_[iljk - offset()] += val;
+            } else {
+                K_buf_[iljk - offset()] += 0.5 * val;
+            }
+        }
+    }
+}
+
+void PKWrkrCompressed::fill_values_wK(double val, size_t i, size_t j, size_t k, size_t l) {
+    size_t ijkl = INDEX4(i, j, k, l);
+
+    if (ijkl >= offset() && ijkl <= max_idx()) {
+        wK_buf_[ijkl - offset()] += val;
+    }
+}
+
+void PKWrkrCompressed::finalize_ints(size_t pk_pairs) {
+    for (size_t pq = 0; pq < pk_pairs; ++pq) {
+        size_t pqpq = INDEX2(pq, pq);
+        if (pqpq >= offset() && pqpq <= max_idx()) {
+            J_buf_[pqpq - offset()] *= 0.5;
+            K_buf_[pqpq - offset()] *= 0.5;
+        }
+    }
+}
+
+void PKWrkrCompressed::finalize_ints_wK(size_t pk_pairs) {
+    for (size_t pq = 0; pq < pk_pairs; ++pq) {
+        size_t pqpq = INDEX2(pq, pq);
+        if (pqpq >= offset() && pqpq <= max_idx()) {
+            wK_buf_[pqpq - offset()] *= 0.5;
+        }
+    }
+}
+
+void PKWrkrCompressed::write(std::vector<size_t> min_ind, std::vector<size_t> max_ind, size_t pk_pairs) {
+    finalize_ints(pk_pairs);
+}
+
+void PKWrkrCompressed::write_wK(std::vector<size_t> min_ind, std::vector<size_t> max_ind, size_t pk_pairs) {
+    finalize_ints_wK(pk_pairs);
+}
+
 PKWrkrIWL::PKWrkrIWL(std::shared_ptr<BasisSet> primary, SharedInt eri, std::shared_ptr<AIOHandler> AIOp,
                      int targetfile, int K_file, size_t buf_size, std::vector<int> &bufforpq,
                      std::shared_ptr<std::vector<size_t>> pos)
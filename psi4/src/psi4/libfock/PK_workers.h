@@ -462,6 +462,51 @@ class PKWrkrInCore : public PKWorker {
     }
 };
 
+/** class PKWrkrCompressed: Computes one batch of canonical indices of the PK
+ * supermatrix into buffers private to the thread. The compressed in-core
+ * manager packs each batch into its block store once the task is done.
+ */
+
+class PKWrkrCompressed : public PKWorker {
+   private:
+    /// Size of the whole supermatrix, to shorten the last batch
+    size_t pk_size_;
+    /// Buffers for the current batch
+    std::vector<double> J_buf_;
+    std::vector<double> K_buf_;
+    std::vector<double> wK_buf_;
+
+    void initialize_task() override;
+
+   public:
+    PKWrkrCompressed(std::shared_ptr<BasisSet> primary, SharedInt eri, size_t buf_size, size_t pk_size);
+
+    /// Batch buffers, indexed relative to offset()
+    double* J_buf() { return J_buf_.data(); }
+    double* K_buf() { return K_buf_.data(); }
+    double* wK_buf() { return wK_buf_.data(); }
+    /// Number of integrals in the current batch
+    size_t batch_size() const { return max_idx() + 1 - offset(); }
+
+    /// Drop the J/K buffers and allocate the wK one
+    void allocate_wK(size_t buf_size, size_t buf_per_thread) override;
+
+    /// Filling values in the batch buffers
+    void fill_values(double val, size_t i, size_t j, size_t k, size_t l) override;
+    /// Filling values in the batch buffer for wK
+    void fill_values_wK(double val, size_t i, size_t j, size_t k, size_t l) override;
+
+    /// Finalize the batch: divide by two diagonal elements
+    void finalize_ints(size_t pk_pairs) override;
+    /// Finalize the wK batch: divide by two diagonal elements
+    void finalize_ints_wK(size_t pk_pairs) override;
+
+    /// Nothing goes to disk: finalize the batch, the manager packs it in core
+    void write(std::vector<size_t> min_ind, std::vector<size_t> max_ind, size_t pk_pairs) override;
+    /// Finalize the wK batch, the manager packs it in core
+    void write_wK(std::vector<size_t> min_ind, std::vector<size_t> max_ind, size_t pk_pairs) override;
+};
+
 /** Class for Yoshimine pre-sorting to obtain the PK supermatrix.
  * This class uses little buckets to pre-sort the integrals for each
  * thread. No communication between threads and asynchronous writing
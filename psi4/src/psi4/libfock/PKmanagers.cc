@@ -47,6 +47,9 @@
 #ifdef _OPENMP
 #include <omp.h>
 #include "psi4/libpsi4util/process.h"
+
+#include <algorithm>
+#include <cmath>
 #endif
 
 namespace psi {
@@ -113,6 +116,7 @@ std::shared_ptr<PKManager> PKManager::build_PKManager(std::shared_ptr<PSIO> psio
     bool do_reord = false;
     bool do_yosh = false;
     bool do_incore = false;
+    bool do_compressed = false;
 
     // specify particular out-of-core subalgorithm...
     if (subalgo == "REORDER_OUT_OF_CORE") {
@@ -137,6 +141,10 @@ std::shared_ptr<PKManager> PKManager::build_PKManager(std::shared_ptr<PSIO> psio
             do_incore = true;
         }
 
+    // ...or the compressed in-core algorithm...
+    } else if (subalgo == "INCORE_COMPRESSED") {
+        do_compressed = true;
+
     // ...or just let psi4 pick any subalgorithm
     } else if (subalgo == "AUTO") {
         if (ncorebuf * pk_size < memory) {
@@ -149,7 +157,7 @@ std::shared_ptr<PKManager> PKManager::build_PKManager(std::shared_ptr<PSIO> psio
 
     // throw an exception on an invalid SCF_SUBTYPE
     } else {
-        throw PSIEXCEPTION("Invalid SCF_SUBTYPE option! The valid choices of SCF_SUBTYPE for SCF_TYPE=PK are AUTO, INCORE, OUT_OF_CORE, YOSHIMINE_OUT_OF_CORE, and REORDER_OUT_OF_CORE.");
+        throw PSIEXCEPTION("Invalid SCF_SUBTYPE option! The valid choices of SCF_SUBTYPE for SCF_TYPE=PK are AUTO, INCORE, INCORE_COMPRESSED, OUT_OF_CORE, YOSHIMINE_OUT_OF_CORE, and REORDER_OUT_OF_CORE.");
     }
 
     std::shared_ptr<PKManager> pkmgr;
@@ -157,6 +165,9 @@ std::shared_ptr<PKManager> PKManager::build_PKManager(std::shared_ptr<PSIO> psio
     if (do_incore) {
         outfile->Printf("  Using in-core PK algorithm.\n");
         pkmgr = std::make_shared<PKMgrInCore>(primary, memory, options);
+    } else if (do_compressed) {
+        outfile->Printf("  Using compressed in-core PK algorithm.\n");
+        pkmgr = std::make_shared<PKMgrInCoreCompressed>(primary, memory, options);
         // Estimate that we'll need less than 40 buffers: do integral reorder
     } else if (do_reord) {
         outfile->Printf("  Using integral reordering PK algorithm.\n");
@@ -1541,40 +1552,363 @@ void PKMgrInCore::prepare_JK(std::vector<SharedMatrix> D, std::vector<SharedMatr
 void PKMgrInCore::form_J(std::vector<SharedMatrix> J, std::string exch, std::vector<SharedMatrix> K) {
     make_J_vec(J);
 
+    std::vector<int> sym_dens;
+    std::vector<int> nonsym_dens;
     for (int N = 0; N < J.size(); ++N) {
-        double* j_ptr;
-        if (exch == "K") {
-            j_ptr = K_ints_.get();
+        if (is_sym(N) && exch != "wK") {
+            sym_dens.push_back(N);
+        } else if (exch == "" || exch == "wK") {
+            nonsym_dens.push_back(N);
+        }
+    }
+
+    if (sym_dens.size()) {
+        form_J_sym((exch == "K") ? K_ints_.get() : J_ints_.get(), sym_dens);
+    }
+    if (nonsym_dens.size()) {
+        form_JK_nonsym(J, K, exch, nonsym_dens);
+    }
+
+    get_results(J, exch);
+}
+
+void PKMgrInCore::form_J_sym(const double* ints, const std::vector<int>& dens) {
+    size_t ndens = dens.size();
+    size_t npairs = pk_pairs();
+
+    // Densities interleaved so that each integral is applied to all of them in the inner loop
+    std::vector<double> D_all(ndens * npairs);
+    for (size_t n = 0; n < ndens; ++n) {
+        double* D_vec = D_glob_vecs(dens[n]);
+        for (size_t pq = 0; pq < npairs; ++pq) {
+            D_all[pq * ndens + n] = D_vec[pq];
+        }
+    }
+
+    // Rows of the supermatrix are distributed over threads, each with its own J buffer
+    std::vector<std::vector<double>> J_thread(nthreads());
+#pragma omp parallel num_threads(nthreads())
+    {
+        int thread = 0;
+#ifdef _OPENMP
+        thread = omp_get_thread_num();
+#endif
+        J_thread[thread].assign(ndens * npairs, 0.0);
+        double* J_t = J_thread[thread].data();
+        std::vector<double> J_pq(ndens);
+
+        // Longest rows first for load balance
+#pragma omp for schedule(dynamic)
+        for (size_t row = 0; row < npairs; ++row) {
+            size_t pq = npairs - 1 - row;
+            const double* j_ptr = ints + pq * (pq + 1) / 2;
+            const double* D_pq = D_all.data() + pq * ndens;
+            std::fill(J_pq.begin(), J_pq.end(), 0.0);
+            for (size_t rs = 0; rs <= pq; ++rs) {
+                double val = j_ptr[rs];
+                const double* D_rs = D_all.data() + rs * ndens;
+                double* J_rs = J_t + rs * ndens;
+                for (size_t n = 0; n < ndens; ++n) {
+                    J_pq[n] += val * D_rs[n];
+                    J_rs[n] += val * D_pq[n];
+                }
+            }
+            for (size_t n = 0; n < ndens; ++n) {
+                J_t[pq * ndens + n] += J_pq[n];
+            }
+        }
+    }
+
+    for (size_t n = 0; n < ndens; ++n) {
+        double* J_vec = JK_glob_vecs(dens[n]);
+#pragma omp parallel for num_threads(nthreads())
+        for (size_t pq = 0; pq < npairs; ++pq) {
+            for (int t = 0; t < nthreads(); ++t) {
+                J_vec[pq] += J_thread[t][pq * ndens + n];
+            }
+        }
+    }
+}
+
+void PKMgrInCore::form_JK_nonsym(std::vector<SharedMatrix> J, std::vector<SharedMatrix> K, const std::string& exch,
+                                 const std::vector<int>& dens) {
+    // J and K are built in the same sweep: K needs every unique integral, which
+    // the J supermatrix holds (the K one has summed some of them)
+    bool do_J = (exch == "");
+    bool do_K = (K.size() || exch == "wK");
+    const double* ints = (exch == "wK") ? wK_ints_.get() : J_ints_.get();
+    size_t ndens = dens.size();
+    int n_bf = nbf();
+    size_t nbf2 = (size_t)n_bf * n_bf;
+
+    std::vector<double*> D_vec(ndens);
+    std::vector<double**> Dmat(ndens);
+    for (size_t n = 0; n < ndens; ++n) {
+        D_vec[n] = D_glob_vecs(dens[n]);
+        Dmat[n] = original_D(dens[n])->pointer();
+    }
+
+    std::vector<std::vector<double>> J_thread(nthreads());
+    std::vector<std::vector<double>> K_thread(nthreads());
+#pragma omp parallel num_threads(nthreads())
+    {
+        int thread = 0;
+#ifdef _OPENMP
+        thread = omp_get_thread_num();
+#endif
+        if (do_J) J_thread[thread].assign(ndens * nbf2, 0.0);
+        if (do_K) K_thread[thread].assign(ndens * nbf2, 0.0);
+
+        // Longest rows first for load balance
+#pragma omp for schedule(dynamic)
+        for (int row = 0; row < n_bf; ++row) {
+            int p = n_bf - 1 - row;
+            int poffs = p * n_bf;
+            for (int q = 0; q <= p; ++q) {
+                int qoffs = q * n_bf;
+                size_t pq = INDEX2(p, q);
+                const double* j_ptr = ints + pq * (pq + 1) / 2;
+                for (int r = 0; r <= p; ++r) {
+                    int roffs = r * n_bf;
+                    int maxs = (r == p) ? q : r;
+                    for (int s = 0; s <= maxs; ++s) {
+                        double val = *j_ptr++;
+                        if (do_J) {
+                            for (size_t n = 0; n < ndens; ++n) {
+                                double* J_n = J_thread[thread].data() + n * nbf2;
+                                double D_rs = D_vec[n][roffs + s] + D_vec[n][s * n_bf + r];
+                                double D_pq = D_vec[n][poffs + q] + D_vec[n][qoffs + p];
+                                J_n[poffs + q] += val * D_rs;
+                                J_n[qoffs + p] += val * D_rs;
+                                J_n[roffs + s] += val * D_pq;
+                                J_n[s * n_bf + r] += val * D_pq;
+                            }
+                        }
+                        if (do_K) {
+                            // Need ugly factors for now. A better solution would be great.
+                            double fac = 1.0;
+                            if (p == q && r == s && p == r) {
+                                fac = 0.25;  // Divide only be 4, PK stores integral with a
+                                // factor 0.5 on the (pq|pq) diagonal.
+                            } else if ((p == q && q == r) || (q == r && r == s)) {
+                                fac = 0.5;
+                            } else if (p == q && r == s) {
+                                fac = 0.25;
+                            } else if (p == q || r == s) {
+                                fac = 0.5;
+                            }
+                            double kval = val * fac;
+                            int soffs = s * n_bf;
+                            for (size_t n = 0; n < ndens; ++n) {
+                                double* K_n = K_thread[thread].data() + n * nbf2;
+                                double** D = Dmat[n];
+                                K_n[poffs + r] += kval * D[q][s];
+                                K_n[roffs + p] += kval * D[s][q];
+                                K_n[qoffs + r] += kval * D[p][s];
+                                K_n[poffs + s] += kval * D[q][r];
+                                K_n[soffs + p] += kval * D[r][q];
+                                K_n[roffs + q] += kval * D[s][p];
+                                K_n[soffs + q] += kval * D[r][p];
+                                K_n[qoffs + s] += kval * D[p][r];
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    // wK is returned in the J slot
+    for (size_t n = 0; n < ndens; ++n) {
+        int N = dens[n];
+        if (do_J) {
+            double* J_p = J[N]->pointer()[0];
+#pragma omp parallel for num_threads(nthreads())
+            for (size_t pq = 0; pq < nbf2; ++pq) {
+                for (int t = 0; t < nthreads(); ++t) {
+                    J_p[pq] += J_thread[t][n * nbf2 + pq];
+                }
+            }
+        }
+        if (do_K) {
+            double* K_p = (exch == "wK") ? J[N]->pointer()[0] : K[N]->pointer()[0];
+#pragma omp parallel for num_threads(nthreads())
+            for (size_t pq = 0; pq < nbf2; ++pq) {
+                for (int t = 0; t < nthreads(); ++t) {
+                    K_p[pq] += K_thread[t][n * nbf2 + pq];
+                }
+            }
+        }
+    }
+}
+
+void PKMgrInCore::finalize_JK() { finalize_D(); }
+
+PKMgrInCoreCompressed::BlockReader::BlockReader(const BlockStore& store, size_t block_size)
+    : store_(store), block_size_(block_size), buf_(block_size) {
+    load(0);
+}
+
+void PKMgrInCoreCompressed::BlockReader::load(size_t block) {
+    block_ = block;
+    pos_ = 0;
+    const auto& dp = store_.dp[block];
+    const auto& sp = store_.sp[block];
+    if (!dp.empty()) {
+        std::copy(dp.begin(), dp.end(), buf_.begin());
+    } else if (!sp.empty()) {
+        std::copy(sp.begin(), sp.end(), buf_.begin());
+    } else {
+        std::fill(buf_.begin(), buf_.end(), 0.0);
+    }
+}
+
+PKMgrInCoreCompressed::PKMgrInCoreCompressed(std::shared_ptr<BasisSet> primary, size_t memory, Options& options)
+    : PKManager(primary, memory, options), block_size_(4096), batch_size_(0) {}
+
+void PKMgrInCoreCompressed::initialize() {
+    allocate_buffers();
+    print_batches();
+}
+
+void PKMgrInCoreCompressed::initialize_wK() {
+    print_batches_wK();
+    size_t nblocks = (pk_size() + block_size_ - 1) / block_size_;
+    wK_ints_.sp.resize(nblocks);
+    wK_ints_.dp.resize(nblocks);
+    // The J/K batch buffers are not needed anymore, wK uses one buffer per thread
+    for (int i = 0; i < nthreads(); ++i) {
+        buffer(i)->allocate_wK(batch_size_, 1);
+    }
+}
+
+void PKMgrInCoreCompressed::print_batches() {
+    PKManager::print_batches();
+    outfile->Printf("  Performing compressed in-core PK\n");
+    outfile->Printf("  Task number: %lu\n", ntasks());
+    outfile->Printf("  Batch size: %lu\n", batch_size_);
+    outfile->Printf("  Block size: %lu\n", block_size_);
+}
+
+void PKMgrInCoreCompressed::allocate_buffers() {
+    // Two batch buffers (J and K) per thread; keep at least half of the memory for the store
+    size_t max_batch = memory() / (4 * nthreads());
+    size_t batch = std::min(max_batch, pk_size() / nthreads() + 1);
+    batch_size_ = std::max((batch / block_size_) * block_size_, block_size_);
+    set_ntasks((pk_size() + batch_size_ - 1) / batch_size_);
+
+    size_t nblocks = (pk_size() + block_size_ - 1) / block_size_;
+    J_ints_.sp.resize(nblocks);
+    J_ints_.dp.resize(nblocks);
+    K_ints_.sp.resize(nblocks);
+    K_ints_.dp.resize(nblocks);
+
+    for (int i = 0; i < nthreads(); ++i) {
+        fill_buffer(std::make_shared<PKWrkrCompressed>(primary(), eri(), batch_size_, pk_size()));
+    }
+}
+
+void PKMgrInCoreCompressed::pack(BlockStore& store, const double* batch, size_t offset, size_t len) {
+    // Single precision keeps a relative error of 2^-24, below the cutoff for these blocks
+    const double sp_limit = cutoff() * 16777216.0;
+    for (size_t start = 0; start < len; start += block_size_) {
+        size_t n = std::min(block_size_, len - start);
+        size_t block = (offset + start) / block_size_;
+        double maxval = 0.0;
+        for (size_t i = 0; i < n; ++i) {
+            maxval = std::max(maxval, std::fabs(batch[start + i]));
+        }
+        if (maxval < cutoff()) {
+            continue;
+        } else if (maxval < sp_limit) {
+            store.sp[block].assign(batch + start, batch + start + n);
         } else {
-            j_ptr = J_ints_.get();
+            store.dp[block].assign(batch + start, batch + start + n);
         }
-        // TODO We should totally parallelize this loop now.
+    }
+}
+
+void PKMgrInCoreCompressed::print_compression(const BlockStore& store, const std::string& label) const {
+    size_t nsp = 0, ndp = 0;
+    for (size_t block = 0; block < store.dp.size(); ++block) {
+        if (!store.dp[block].empty()) {
+            ++ndp;
+        } else if (!store.sp[block].empty()) {
+            ++nsp;
+        }
+    }
+    size_t nblocks = store.dp.size();
+    double mib = (ndp * block_size_ * sizeof(double) + nsp * block_size_ * sizeof(float)) / (1024.0 * 1024.0);
+    double full = pk_size() * sizeof(double) / (1024.0 * 1024.0);
+    outfile->Printf("  %s supermatrix: %lu double, %lu single precision and %lu dropped blocks.\n", label.c_str(), ndp,
+                    nsp, nblocks - ndp - nsp);
+    outfile->Printf("  %s supermatrix: %.1f MiB stored, %.1f MiB uncompressed.\n", label.c_str(), mib, full);
+}
+
+void PKMgrInCoreCompressed::form_PK() {
+    compute_integrals();
+    print_compression(J_ints_, "J");
+    print_compression(K_ints_, "K");
+    if (!do_wk()) {
+        finalize_PK();
+    }
+}
+
+void PKMgrInCoreCompressed::form_PK_wK() {
+    compute_integrals_wK();
+    print_compression(wK_ints_, "wK");
+    finalize_PK();
+}
+
+void PKMgrInCoreCompressed::write() {
+    auto buf = std::static_pointer_cast<PKWrkrCompressed>(get_buffer());
+    buf->write({}, {}, pk_pairs());
+    pack(J_ints_, buf->J_buf(), buf->offset(), buf->batch_size());
+    pack(K_ints_, buf->K_buf(), buf->offset(), buf->batch_size());
+}
+
+void PKMgrInCoreCompressed::write_wK() {
+    auto buf = std::static_pointer_cast<PKWrkrCompressed>(get_buffer());
+    buf->write_wK({}, {}, pk_pairs());
+    pack(wK_ints_, buf->wK_buf(), buf->offset(), buf->batch_size());
+}
+
+void PKMgrInCoreCompressed::finalize_PK() {
+    for (int i = 0; i < nthreads(); ++i) {
+        buffer(i).reset();
+    }
+}
+
+void PKMgrInCoreCompressed::prepare_JK(std::vector<SharedMatrix> D, std::vector<SharedMatrix> Cl,
+                                       std::vector<SharedMatrix> Cr) {
+    form_D_vec(D, Cl, Cr);
+}
+
+void PKMgrInCoreCompressed::form_J(std::vector<SharedMatrix> J, std::string exch, std::vector<SharedMatrix> K) {
+    // Same contractions as PKMgrInCore::form_J, reading the supermatrices block by block
+    make_J_vec(J);
+
+    for (int N = 0; N < J.size(); ++N) {
         // Symmetric density matrix case
         if (is_sym(N) && exch != "wK") {
+            BlockReader ints((exch == "K") ? K_ints_ : J_ints_, block_size_);
             double* J_vec = JK_glob_vecs(N);
             double* D_vec = D_glob_vecs(N);
             for (size_t pq = 0; pq < pk_pairs(); ++pq) {
                 double D_pq = D_vec[pq];
-                double* D_rs = D_vec;
                 double J_pq = 0.0;
-                double* J_rs = J_vec;
                 for (size_t rs = 0; rs <= pq; ++rs) {
-                    // DEBUG               if(!exch && rs == 0) {
-                    // DEBUG                 outfile->Printf("PK int (%lu|%lu) = %20.16f\n",pq,rs,*j_ptr);
-                    // DEBUG               }
-                    J_pq += *j_ptr * (*D_rs);
-                    *J_rs += *j_ptr * D_pq;
-                    ++D_rs;
-                    ++J_rs;
-                    ++j_ptr;
+                    double val = ints.next();
+                    J_pq += val * D_vec[rs];
+                    J_vec[rs] += val * D_pq;
                 }
                 J_vec[pq] += J_pq;
             }
 
-            // TODO ? Fuse J and K loops ?
             // Non-symmetric density matrix
         } else if (exch == "" || exch == "wK") {
             if (exch == "") {
+                BlockReader ints(J_ints_, block_size_);
                 double* D_vec = D_glob_vecs(N);
                 double** J_vec = J[N]->pointer();
                 for (int p = 0; p < nbf(); ++p) {
@@ -1585,46 +1919,29 @@ void PKMgrInCore::form_J(std::vector<SharedMatrix> J, std::string exch, std::vec
                             int roffs = r * nbf();
                             int maxs = (r == p) ? q : r;
                             for (int s = 0; s <= maxs; ++s) {
-                                J_vec[p][q] += *j_ptr * (D_vec[roffs + s] + D_vec[s * nbf() + r]);
-                                J_vec[q][p] += *j_ptr * (D_vec[roffs + s] + D_vec[s * nbf() + r]);
-                                J_vec[r][s] += *j_ptr * (D_vec[poffs + q] + D_vec[qoffs + p]);
-                                J_vec[s][r] += *j_ptr * (D_vec[poffs + q] + D_vec[qoffs + p]);
-                                ++j_ptr;
+                                double val = ints.next();
+                                J_vec[p][q] += val * (D_vec[roffs + s] + D_vec[s * nbf() + r]);
+                                J_vec[q][p] += val * (D_vec[roffs + s] + D_vec[s * nbf() + r]);
+                                J_vec[r][s] += val * (D_vec[poffs + q] + D_vec[qoffs + p]);
+                                J_vec[s][r] += val * (D_vec[poffs + q] + D_vec[qoffs + p]);
                             }
                         }
                     }
                 }
             }
-            // Since we just read a batch, might as well compute K
-            // Primitive algorithm, just contract integrals with appropriate
-            // element on the fly. Might be faster than reading/writing the appropriate
-            // PK supermatrix
             if (K.size() || exch == "wK") {
                 double** Dmat = original_D(N)->pointer();
-                double** K_vec;
-                if (exch == "wK") {
-                    K_vec = J[N]->pointer();
-                    j_ptr = wK_ints_.get();
-                } else {
-                    K_vec = K[N]->pointer();
-                    // We use J supermatrix because it contains every unique integral
-                    // K supermatrix has summed some integrals that we need separately
-                    j_ptr = J_ints_.get();
-                }
+                double** K_vec = (exch == "wK") ? J[N]->pointer() : K[N]->pointer();
+                // The J supermatrix contains every unique integral
+                BlockReader ints((exch == "wK") ? wK_ints_ : J_ints_, block_size_);
                 for (int p = 0; p < nbf(); ++p) {
-                    //        int poffs = p * nbf();
                     for (int q = 0; q <= p; ++q) {
-                        //          int qoffs = q * nbf();
                         for (int r = 0; r <= p; ++r) {
-                            //            int roffs = r * nbf();
                             int maxs = (r == p) ? q : r;
                             for (int s = 0; s <= maxs; ++s) {
-                                // Need ugly factors for now. A better solution would be great.
                                 double fac = 1.0;
-                                //              int soffs = s * nbf();
                                 if (p == q && r == s && p == r) {
-                                    fac = 0.25;  // Divide only be 4, PK stores integral with a
-                                    // factor 0.5 on the (pq|pq) diagonal.
+                                    fac = 0.25;
                                 } else if ((p == q && q == r) || (q == r && r == s)) {
                                     fac = 0.5;
                                 } else if (p == q && r == s) {
@@ -1632,34 +1949,27 @@ void PKMgrInCore::form_J(std::vector<SharedMatrix> J, std::string exch, std::vec
                                 } else if (p == q || r == s) {
                                     fac = 0.5;
                                 }
-                                // DEBUG                       bool prt = (p == 0 && r == 0) || (q == 0 && r == 0) || (p
-                                // == 0 && s == 0) || (s == 0 && q == 0);
-                                // DEBUG                       if(exch == "wK" && prt) {
-                                // DEBUG                         outfile->Printf("PK int (%d %d|%d %d) =
-                                // %20.16f\n",p,q,r,s,*j_ptr);
-                                // DEBUG                       }
-                                K_vec[p][r] += (*j_ptr) * fac * Dmat[q][s];
-                                K_vec[r][p] += (*j_ptr) * fac * Dmat[s][q];
-                                K_vec[q][r] += (*j_ptr) * fac * Dmat[p][s];
-                                K_vec[p][s] += (*j_ptr) * fac * Dmat[q][r];
-                                K_vec[s][p] += (*j_ptr) * fac * Dmat[r][q];
-                                K_vec[r][q] += (*j_ptr) * fac * Dmat[s][p];
-                                K_vec[s][q] += (*j_ptr) * fac * Dmat[r][p];
-                                K_vec[q][s] += (*j_ptr) * fac * Dmat[p][r];
-                                ++j_ptr;
+                                double val = ints.next() * fac;
+                                K_vec[p][r] += val * Dmat[q][s];
+                                K_vec[r][p] += val * Dmat[s][q];
+                                K_vec[q][r] += val * Dmat[p][s];
+                                K_vec[p][s] += val * Dmat[q][r];
+                                K_vec[s][p] += val * Dmat[r][q];
+                                K_vec[r][q] += val * Dmat[s][p];
+                                K_vec[s][q] += val * Dmat[r][p];
+                                K_vec[q][s] += val * Dmat[p][r];
                             }
                         }
                     }
                 }
             }
-
         }  // End of non-symmetric condition
     }      // End of loop over J/K matrices
 
     get_results(J, exch);
 }
 
-void PKMgrInCore::finalize_JK() { finalize_D(); }
+void PKMgrInCoreCompressed::finalize_JK() { finalize_D(); }
 
 }  // namespace pk
 }  // namespace psi
@@ -32,6 +32,7 @@
 // TODO Const correctness of everything
 #include "psi4/libmints/typedefs.h"
 #include <psi4/libpsio/psio.hpp>
+#include <string>
 #include <vector>
 
 namespace psi {
@@ -471,6 +472,12 @@ class PKMgrInCore : public PKManager {
     std::unique_ptr<double[]> K_ints_;
     std::unique_ptr<double[]> wK_ints_;
 
+    /// J (or K) from the symmetric densities dens, all applied in one threaded sweep of ints
+    void form_J_sym(const double* ints, const std::vector<int>& dens);
+    /// J and K (or wK) from the non-symmetric densities dens, all applied in one threaded sweep
+    void form_JK_nonsym(std::vector<SharedMatrix> J, std::vector<SharedMatrix> K, const std::string& exch,
+                        const std::vector<int>& dens);
+
    public:
     /// Constructor for in-core class
     PKMgrInCore(std::shared_ptr<BasisSet> primary, size_t memory, Options& options)
@@ -508,6 +515,93 @@ class PKMgrInCore : public PKManager {
     /// Finalize PK, i.e. deallocate buffers
     void finalize_PK() override;
 };
+
+/* PKMgrInCoreCompressed: Class to manage the compressed in-core PK algorithm */
+
+/** The supermatrices are computed in batches of canonical indices, as for
+ * the reordering algorithm, but each batch is packed in core instead of being
+ * written to disk. The store is cut into blocks of consecutive integrals:
+ * blocks with no integral above the cutoff are dropped, blocks whose largest
+ * integral is small enough for the single-precision rounding error to stay
+ * below the cutoff are kept in single precision, and the others in double precision.
+ */
+
+class PKMgrInCoreCompressed : public PKManager {
+   private:
+    /// Compressed supermatrix, one entry per block. A block is stored in
+    /// at most one of the two precisions, none if it was dropped.
+    struct BlockStore {
+        std::vector<std::vector<float>> sp;
+        std::vector<std::vector<double>> dp;
+    };
+
+    /// Sequential access to a store in canonical order
+    class BlockReader {
+       private:
+        const BlockStore& store_;
+        size_t block_size_;
+        size_t block_;
+        size_t pos_;
+        std::vector<double> buf_;
+        void load(size_t block);
+
+       public:
+        BlockReader(const BlockStore& store, size_t block_size);
+        double next() {
+            if (pos_ == block_size_) load(block_ + 1);
+            return buf_[pos_++];
+        }
+    };
+
+    BlockStore J_ints_;
+    BlockStore K_ints_;
+    BlockStore wK_ints_;
+    /// Number of integrals per block
+    size_t block_size_;
+    /// Number of integrals per batch, a multiple of the block size
+    size_t batch_size_;
+
+    /// Pack the current batch of the calling thread into a store
+    void pack(BlockStore& store, const double* batch, size_t offset, size_t len);
+    /// Print how the store was compressed
+    void print_compression(const BlockStore& store, const std::string& label) const;
+
+   public:
+    /// Constructor for compressed in-core class
+    PKMgrInCoreCompressed(std::shared_ptr<BasisSet> primary, size_t memory, Options& options);
+    /// Destructor for compressed in-core class
+    ~PKMgrInCoreCompressed() override {}
+
+    /// Initialize sequence for compressed in-core algorithm
+    void initialize() override;
+    /// Initialize the wK integrals
+    void initialize_wK() override;
+    /// Sequence of steps to form PK matrix
+    void form_PK() override;
+    /// Sequence of steps to form wK PK matrix
+    void form_PK_wK() override;
+    /// Steps to prepare JK formation
+    void prepare_JK(std::vector<SharedMatrix> D, std::vector<SharedMatrix> Cl, std::vector<SharedMatrix> Cr) override;
+
+    /// Form J matrix, shared_ptr() initializes to null
+    void form_J(std::vector<SharedMatrix> J, std::string exch = "",
+                std::vector<SharedMatrix> K = std::vector<SharedMatrix>()) override;
+    /// Finalize JK formation
+    void finalize_JK() override;
+
+    /// Pack the batch of the calling thread
+    void write() override;
+    /// Pack the wK batch of the calling thread
+    void write_wK() override;
+
+    /// Printing the algorithm header
+    void print_batches() override;
+
+    /// Allocate the buffer threads
+    void allocate_buffers() override;
+    /// Finalize PK, i.e. deallocate buffers
+    void finalize_PK() override;
+};
 }
 }
 
@@ -40,6 +40,8 @@
 #include "psi4/libmints/molecule.h"
 #include "psi4/libmints/matrix.h"
 
+#include <algorithm>
+#include <cmath>
 #include <vector>
 #include <string>
 #include <sstream>
@@ -47,6 +49,8 @@
 #include <limits>
 #include <cctype>
 #include <cassert>
+#include <mutex>
+#include <tuple>
 
 #ifdef _OPENMP
 #include <omp.h>
@@ -2778,6 +2782,12 @@ class NuclearWeightMgr {
     std::shared_ptr<Molecule> molecule_;
     double **inv_dist_;
     double **amatrix_;
+    // Cell list of the atoms, for the schemes whose step functions reach exactly 0 and 1
+    bool screened_;
+    double cell_size_;
+    double cell_origin_[3];
+    int ncell_[3];
+    std::vector<std::vector<int>> cells_;
     ////
 
     inline double distToAtom(MassPoint mp, int A) const {
@@ -2798,6 +2808,13 @@ class NuclearWeightMgr {
         return (a < -0.5) ? -0.5 : (a > 0.5) ? 0.5 : a;
     }
 
+    // Distance from a point beyond which an atom j always has s(i,j) == 1 for an atom i at distance r,
+    // and atom i always has s(i,j) == 0 for an atom j at distance r (screened schemes only)
+    double reach(double r) const;
+    // Indices (ascending) and distances of all atoms within R of the point
+    void atomsNear(MassPoint mp, double R, std::vector<int> &atoms, std::vector<double> &dist) const;
+    double screenedNuclearWeight(MassPoint mp, int A) const;
+
    public:
     static int WhichScheme(const char *schemename);
     static const char *SchemeName(int which) { return nuclearschemenames[which]; }
@@ -2844,6 +2861,33 @@ NuclearWeightMgr::NuclearWeightMgr(std::shared_ptr<Molecule> mol, int scheme) {
     } else {
         throw PSIEXCEPTION("Unrecognized weighting scheme!");
     }
+
+    // With the Stratmann step function (and a == 0), or the distance cutoff of SBECKE, far atoms
+    // drop out of the weights exactly, so only atoms near the point need to be visited
+    screened_ = (scheme == STRATMANN || scheme == SBECKE) && natom > 1;
+    cell_size_ = 5.0;
+    if (screened_) {
+        double lo[3] = {mol->x(0), mol->y(0), mol->z(0)};
+        double hi[3] = {lo[0], lo[1], lo[2]};
+        for (int A = 1; A < natom; A++) {
+            double xyz[3] = {mol->x(A), mol->y(A), mol->z(A)};
+            for (int k = 0; k < 3; k++) {
+                lo[k] = std::min(lo[k], xyz[k]);
+                hi[k] = std::max(hi[k], xyz[k]);
+            }
+        }
+        for (int k = 0; k < 3; k++) {
+            cell_origin_[k] = lo[k];
+            ncell_[k] = (int)((hi[k] - lo[k]) / cell_size_) + 1;
+        }
+        cells_.resize((size_t)ncell_[0] * ncell_[1] * ncell_[2]);
+        for (int A = 0; A < natom; A++) {
+            double xyz[3] = {mol->x(A), mol->y(A), mol->z(A)};
+            int c[3];
+            for (int k = 0; k < 3; k++) c[k] = std::min((int)((xyz[k] - cell_origin_[k]) / cell_size_), ncell_[k] - 1);
+            cells_[((size_t)c[0] * ncell_[1] + c[1]) * ncell_[2] + c[2]].push_back(A);
+        }
+    }
 }
 
 NuclearWeightMgr::~NuclearWeightMgr() {
@@ -2949,10 +2993,81 @@ double NuclearWeightMgr::GetStratmannCutoff(int A) const {
     return distToNearestAtom * (1 + mucutoff) / 2;
 }
 
+double NuclearWeightMgr::reach(double r) const {
+    // Stratmann: s == 1 once mu < -0.64, and mu(i,j) <= (r_i - r_j) / (r_i + r_j) by the triangle inequality.
+    // SBECKE: mu is clipped to -1 (s == 1) once r_j - r_i >= RCut = 5.
+    // The small margin keeps rounding from dropping an atom that still contributes.
+    double d = (scheme_ == STRATMANN) ? r * (1.0 + 0.64) / (1.0 - 0.64) : r + 5.0;
+    return d * (1.0 + 1.0E-10) + 1.0E-10;
+}
+
+void NuclearWeightMgr::atomsNear(MassPoint mp, double R, std::vector<int> &atoms, std::vector<double> &dist) const {
+    atoms.clear();
+    dist.clear();
+    double xyz[3] = {mp.x, mp.y, mp.z};
+    int lo[3], hi[3];
+    for (int k = 0; k < 3; k++) {
+        lo[k] = std::max(0, (int)std::floor((xyz[k] - R - cell_origin_[k]) / cell_size_));
+        hi[k] = std::min(ncell_[k] - 1, (int)std::floor((xyz[k] + R - cell_origin_[k]) / cell_size_));
+    }
+    for (int cx = lo[0]; cx <= hi[0]; cx++) {
+        for (int cy = lo[1]; cy <= hi[1]; cy++) {
+            for (int cz = lo[2]; cz <= hi[2]; cz++) {
+                for (int B : cells_[((size_t)cx * ncell_[1] + cy) * ncell_[2] + cz]) {
+                    double r = distToAtom(mp, B);
+                    if (r <= R) atoms.push_back(B);
+                }
+            }
+        }
+    }
+    // Same order as the unscreened loops, so the products are formed identically
+    std::sort(atoms.begin(), atoms.end());
+    for (int B : atoms) dist.push_back(distToAtom(mp, B));
+}
+
+double NuclearWeightMgr::screenedNuclearWeight(MassPoint mp, int A) const {
+    // Every atom i with P_i != 0 lies within reach(r_min) of the point, and every atom j that can
+    // give s(i,j) != 1 for such an i lies within reach(r_i); the parent atom bounds r_min from above.
+    double rA = distToAtom(mp, A);
+    std::vector<int> atoms;
+    std::vector<double> dist;
+    atomsNear(mp, reach(reach(rA)), atoms, dist);
+
+    double rmin = rA;
+    for (double r : dist) rmin = std::min(rmin, r);
+    double imax = reach(rmin);
+
+    double (*stepFunction)(double) = (scheme_ == STRATMANN) ? StratmannStepFunction : BeckeStepFunction;
+    double (*muFunction)(double, double, double) = (scheme_ == SBECKE) ? SmoothBeckeMu : BeckeMu;
+
+    double numerator = 0;
+    double denominator = 0;
+    for (size_t ii = 0; ii < atoms.size(); ii++) {
+        if (dist[ii] > imax) continue;  // P_i == 0
+        int i = atoms[ii];
+        double jmax = reach(dist[ii]);
+        double prod = 1;
+        for (size_t jj = 0; jj < atoms.size(); jj++) {
+            if (jj == ii || dist[jj] > jmax) continue;  // s == 1
+            int j = atoms[jj];
+            double mu = muFunction(dist[ii], dist[jj], inv_dist_[i][j]);
+            double nu = mu + amatrix_[i][j] * (1 - mu * mu);
+            double s = stepFunction(nu);
+            prod *= s;
+            if (prod == 0) break;
+        }
+        if (i == A) numerator = prod;
+        denominator += prod;
+    }
+    return numerator / denominator;
+}
+
 double NuclearWeightMgr::computeNuclearWeight(MassPoint mp, int A, double stratmannCutoff) const {
     // Stratmann's step function gives us this handy check
     if (scheme_ == STRATMANN && distToAtom(mp, A) <= stratmannCutoff) return 1;
 
+    if (screened_) return screenedNuclearWeight(mp, A);
+
     int natom = molecule_->natom();
     // Find the distance from point mp to each atom in the molecule.
     std::vector<double> dist(natom);
@@ -3757,7 +3872,7 @@ void MolecularGrid::buildGridFromOptions(MolecularGridOptions const &opt) {
     }
 
 // Iterate over atoms
-#pragma omp parallel for schedule(static)
+#pragma omp parallel for schedule(dynamic)
     for (int A = 0; A < molecule_->natom(); A++) {
         int Z = molecule_->true_atomic_number(A);
         double stratmannCutoff = nuc.GetStratmannCutoff(A);
@@ -3953,7 +4068,7 @@ void MolecularGrid::buildGridFromOptions(MolecularGridOptions const &opt, const
     spherical_grids_.resize(molecule_->natom());
 
 // Iterate over atoms
-#pragma omp parallel for schedule(static)
+#pragma omp parallel for schedule(dynamic)
     for (int A = 0; A < molecule_->natom(); A++) {
         int Z = molecule_->true_atomic_number(A);
         double stratmannCutoff = nuc.GetStratmannCutoff(A);
@@ -4391,12 +4506,29 @@ void DFTGrid::buildGridFromOptions(std::map<std::string, int> int_opts_map,
     double max_radius = full_float_options["DFT_BLOCK_MAX_RADIUS"];
     double epsilon = full_float_options["DFT_BASIS_TOLERANCE"];
     auto extents = std::make_shared<BasisExtents>(primary_, epsilon);
+
+    // => Reuse a grid from a nearby geometry if requested <= //
+    double reuse_tolerance = options_.get_double("DFT_GRID_REUSE_TOLERANCE");
+    std::stringstream key;
+    if (reuse_tolerance > 0.0) {
+        for (const auto &kv : full_str_options) key << kv.second << " ";
+        for (const auto &kv : full_int_options) key << kv.second << " ";
+        for (const auto &kv : full_float_options) key << kv.second << " ";
+        key << opt.remove_distant_points << " " << primary_->name() << " " << primary_->nbf();
+        timer_on("reuse grid");
+        bool reused = reuse_grid(key.str(), reuse_tolerance, opt, extents);
+        timer_off("reuse grid");
+        if (reused) return;
+    }
+
     timer_on("build grid");
     MolecularGrid::buildGridFromOptions(opt);
     timer_off("build grid");
     timer_on("post-process grid");
     postProcess(extents, max_points, min_points, max_radius);
     timer_off("post-process grid");
+
+    if (reuse_tolerance > 0.0) store_grid(key.str());
 }
 
 // REFACTOR NOTE: PS grids are not used. Not all possible MolecularGridOptions are being set.
@@ -4452,6 +4584,8 @@ void MolecularGrid::block(int max_points, int min_points, double max_radius) {
         blocker = std::make_shared<NaiveGridBlocker>(npoints_, x_, y_, z_, w_, max_points, min_points, max_radius, extents_);
     } else if (options_.blockscheme == "OCTREE") {
         blocker = std::make_shared<OctreeGridBlocker>(npoints_, x_, y_, z_, w_, max_points, min_points, max_radius, extents_);
+    } else if (options_.blockscheme == "BALANCED") {
+        blocker = std::make_shared<BalancedGridBlocker>(npoints_, x_, y_, z_, w_, max_points, min_points, max_radius, extents_);
     } else if (options_.blockscheme == "ATOMIC") {
         blocker = std::make_shared<AtomicGridBlocker>(npoints_, x_, y_, z_, w_, max_points, min_points, max_radius, extents_, molecule_, atomic_grids_);
     }
@@ -4537,6 +4671,164 @@ void MolecularGrid::postProcess(std::shared_ptr<BasisExtents> extents, int max_p
     block(max_points, min_points, max_radius);
 }
 
+namespace {
+
+// A grid kept for reuse at nearby geometries. Points are stored in the final (blocked) order as unrotated offsets
+// from their owning nucleus, with the radial times angular weight, so that moving the grid to a new geometry only
+// needs the standard orientation and the nuclear weights.
+struct StoredGrid {
+    std::vector<int> Z;
+    std::vector<Vector3> geometry;
+    std::vector<int> atom;
+    std::vector<MassPoint> local;
+    std::vector<size_t> block_npoints;
+    std::vector<std::shared_ptr<RadialGrid>> radial_grids;
+    std::vector<std::vector<std::shared_ptr<SphericalGrid>>> spherical_grids;
+    int max_points;
+};
+
+std::mutex stored_grids_mutex;
+std::map<std::string, StoredGrid> stored_grids;
+
+}  // namespace
+
+bool MolecularGrid::reuse_grid(const std::string &key, double tolerance, MolecularGridOptions const &opt,
+                               std::shared_ptr<BasisExtents> extents) {
+#ifdef USING_BrianQC
+    // BrianQC receives the grid while it is built, so it always needs the full build
+    if (brianEnable and brianEnableDFT) return false;
+#endif
+    std::lock_guard<std::mutex> lock(stored_grids_mutex);
+    auto it = stored_grids.find(key);
+    if (it == stored_grids.end()) return false;
+    const StoredGrid &stored = it->second;
+
+    int natom = molecule_->natom();
+    if (stored.Z.size() != natom) return false;
+    double max_shift = 0.0;
+    for (int A = 0; A < natom; A++) {
+        if (stored.Z[A] != molecule_->true_atomic_number(A)) return false;
+        max_shift = std::max(max_shift, stored.geometry[A].distance(molecule_->xyz(A)));
+    }
+    if (max_shift > tolerance) return false;
+
+    options_ = opt;
+    extents_ = extents;
+    primary_ = extents_->basis();
+
+    OrientationMgr std_orientation(molecule_);
+    NuclearWeightMgr nuc(molecule_, opt.nucscheme);
+    orientation_ = std_orientation.orientation();
+    radial_grids_ = stored.radial_grids;
+    spherical_grids_ = stored.spherical_grids;
+
+    std::vector<double> stratmannCutoff(natom);
+    for (int A = 0; A < natom; A++) {
+        stratmannCutoff[A] = nuc.GetStratmannCutoff(A);
+    }
+
+    npoints_ = stored.local.size();
+    x_ = new double[npoints_];
+    y_ = new double[npoints_];
+    z_ = new double[npoints_];
+    w_ = new double[npoints_];
+
+#pragma omp parallel for schedule(static)
+    for (int P = 0; P < npoints_; P++) {
+        int A = stored.atom[P];
+        MassPoint mp = std_orientation.MoveIntoPosition(stored.local[P], A);
+        mp.w *= nuc.computeNuclearWeight(mp, A, stratmannCutoff[A]);
+        x_[P] = mp.x;
+        y_[P] = mp.y;
+        z_[P] = mp.z;
+        w_[P] = mp.w;
+    }
+
+    atomic_grids_.clear();
+    atomic_grids_.resize(natom);
+    for (int P = 0; P < npoints_; P++) {
+        atomic_grids_[stored.atom[P]].push_back({x_[P], y_[P], z_[P], w_[P]});
+    }
+
+    // Same blocking, but the significant functions of each block follow the new basis positions
+    blocks_.clear();
+    size_t offset = 0;
+    for (size_t b = 0; b < stored.block_npoints.size(); b++) {
+        size_t n = stored.block_npoints[b];
+        blocks_.push_back(std::make_shared<BlockOPoints>(b, n, &x_[offset], &y_[offset], &z_[offset], &w_[offset],
+                                                         extents_));
+        offset += n;
+    }
+
+    max_points_ = stored.max_points;
+    max_functions_ = 0;
+    collocation_size_ = 0;
+    for (const auto &block : blocks_) {
+        collocation_size_ += block->local_nbf() * block->npoints();
+        max_functions_ = std::max<int>(max_functions_, block->local_nbf());
+    }
+
+    if (opt.print > 1) {
+        outfile->Printf("  Reusing the DFT grid of a geometry within %.2E [au].\n\n", max_shift);
+    }
+    return true;
+}
+
+void MolecularGrid::store_grid(const std::string &key) const {
+    // The ATOMIC blocker also keeps per-atom blocks, which are not worth tracking here
+    if (options_.blockscheme == "ATOMIC") return;
+
+    // The blockers copy points verbatim, so the exact coordinates identify the atom each point belongs to
+    std::map<std::tuple<double, double, double>, int> owner;
+    for (int A = 0; A < atomic_grids_.size(); A++) {
+        for (const auto &P : atomic_grids_[A]) {
+            if (!owner.emplace(std::make_tuple(P.x, P.y, P.z), A).second) return;
+        }
+    }
+
+    int natom = molecule_->natom();
+    NuclearWeightMgr nuc(molecule_, options_.nucscheme);
+    double **Op = orientation_->pointer();
+
+    StoredGrid stored;
+    stored.Z.resize(natom);
+    stored.geometry.resize(natom);
+    for (int A = 0; A < natom; A++) {
+        stored.Z[A] = molecule_->true_atomic_number(A);
+        stored.geometry[A] = molecule_->xyz(A);
+    }
+    stored.atom.resize(npoints_);
+    stored.local.resize(npoints_);
+    for (int P = 0; P < npoints_; P++) {
+        auto it = owner.find(std::make_tuple(x_[P], y_[P], z_[P]));
+        if (it == owner.end()) return;
+        int A = it->second;
+        MassPoint mp = {x_[P], y_[P], z_[P], w_[P]};
+        double wnuc = nuc.computeNuclearWeight(mp, A, nuc.GetStratmannCutoff(A));
+        if (wnuc == 0.0) return;
+
+        // Undo the orientation: the rows of O are the standard axes
+        double d[3] = {x_[P] - stored.geometry[A][0], y_[P] - stored.geometry[A][1], z_[P] - stored.geometry[A][2]};
+        MassPoint local = {0.0, 0.0, 0.0, w_[P] / wnuc};
+        for (int k = 0; k < 3; k++) {
+            local.x += Op[k][0] * d[k];
+            local.y += Op[k][1] * d[k];
+            local.z += Op[k][2] * d[k];
+        }
+        stored.atom[P] = A;
+        stored.local[P] = local;
+    }
+    for (const auto &block : blocks_) {
+        stored.block_npoints.push_back(block->npoints());
+    }
+    stored.radial_grids = radial_grids_;
+    stored.spherical_grids = spherical_grids_;
+    stored.max_points = max_points_;
+
+    std::lock_guard<std::mutex> lock(stored_grids_mutex);
+    stored_grids[key] = std::move(stored);
+}
+
 void MolecularGrid::print(std::string out, int /*print*/) const {
     std::shared_ptr<psi::PsiOutStream> printer = (out == "outfile" ? outfile : std::make_shared<PsiOutStream>(out));
     printer->Printf("   => Molecular Quadrature <=\n\n");
@@ -4955,6 +5247,188 @@ void OctreeGridBlocker::block() {
     }
 }
 
+BalancedGridBlocker::BalancedGridBlocker(const int npoints_ref, double const *x_ref, double const *y_ref,
+                                         double const *z_ref, double const *w_ref, const int max_points,
+                                         const int min_points, const double max_radius,
+                                         std::shared_ptr<BasisExtents> extents)
+    : GridBlocker(npoints_ref, x_ref, y_ref, z_ref, w_ref, max_points, min_points, max_radius, extents) {}
+BalancedGridBlocker::~BalancedGridBlocker() {}
+double BalancedGridBlocker::block_radius2(const std::vector<int> &points) const {
+    double XC[3] = {0.0, 0.0, 0.0};
+    for (int P : points) {
+        XC[0] += x_ref_[P];
+        XC[1] += y_ref_[P];
+        XC[2] += z_ref_[P];
+    }
+    for (int k = 0; k < 3; k++) XC[k] /= points.size();
+
+    double RC2 = 0.0;
+    for (int P : points) {
+        double dx = x_ref_[P] - XC[0];
+        double dy = y_ref_[P] - XC[1];
+        double dz = z_ref_[P] - XC[2];
+        RC2 = std::max(RC2, dx * dx + dy * dy + dz * dz);
+    }
+    return RC2;
+}
+double BalancedGridBlocker::block_cost(const std::vector<int> &points) const {
+    double XC[3] = {0.0, 0.0, 0.0};
+    for (int P : points) {
+        XC[0] += x_ref_[P];
+        XC[1] += y_ref_[P];
+        XC[2] += z_ref_[P];
+    }
+    for (int k = 0; k < 3; k++) XC[k] /= points.size();
+    double RC = std::sqrt(block_radius2(points));
+
+    // Shells whose extent reaches the bounding sphere, as BlockOPoints would find them
+    std::shared_ptr<BasisSet> basis = extents_->basis();
+    std::shared_ptr<Vector> Rc = extents_->shell_extents();
+    size_t nbf = 0;
+    for (int Q = 0; Q < basis->nshell(); Q++) {
+        Vector3 v = basis->shell(Q).center();
+        double dx = v[0] - XC[0];
+        double dy = v[1] - XC[1];
+        double dz = v[2] - XC[2];
+        double R = std::sqrt(dx * dx + dy * dy + dz * dz);
+        if (R <= RC + Rc->get(0, Q)) nbf += basis->shell(Q).nfunction();
+    }
+    return (double)points.size() * nbf;
+}
+void BalancedGridBlocker::bisect(const std::vector<int> &points, std::vector<int> &left,
+                                 std::vector<int> &right) const {
+    double const *dims[3] = {x_ref_, y_ref_, z_ref_};
+    double lo[3] = {std::numeric_limits<double>::max(), std::numeric_limits<double>::max(),
+                    std::numeric_limits<double>::max()};
+    double hi[3] = {std::numeric_limits<double>::lowest(), std::numeric_limits<double>::lowest(),
+                    std::numeric_limits<double>::lowest()};
+    for (int P : points) {
+        for (int k = 0; k < 3; k++) {
+            lo[k] = std::min(lo[k], dims[k][P]);
+            hi[k] = std::max(hi[k], dims[k][P]);
+        }
+    }
+    int axis = 0;
+    for (int k = 1; k < 3; k++) {
+        if (hi[k] - lo[k] > hi[axis] - lo[axis]) axis = k;
+    }
+
+    double const *X = dims[axis];
+    std::vector<int> sorted = points;
+    auto mid = sorted.begin() + sorted.size() / 2;
+    std::nth_element(sorted.begin(), mid, sorted.end(), [X](int a, int b) { return X[a] < X[b]; });
+    left.assign(sorted.begin(), mid);
+    right.assign(mid, sorted.end());
+}
+void BalancedGridBlocker::block() {
+    npoints_ = npoints_ref_;
+
+    double T2 = tol_max_radius_ * tol_max_radius_;
+
+    // => Median bisection to the point count and radius limits <= //
+    std::vector<std::vector<int>> active(1);
+    std::vector<std::vector<int>> leaves;
+    for (int Q = 0; Q < npoints_; Q++) active[0].push_back(Q);
+    while (!active.empty()) {
+        std::vector<std::vector<int>> next;
+        for (auto &points : active) {
+            bool too_big = points.size() > tol_max_points_;
+            bool too_wide = points.size() > 2 * tol_min_points_ && block_radius2(points) > T2;
+            if (too_big || too_wide) {
+                std::vector<int> left, right;
+                bisect(points, left, right);
+                next.push_back(left);
+                next.push_back(right);
+            } else if (points.size()) {
+                leaves.push_back(points);
+            }
+        }
+        active = next;
+    }
+
+    // => Split blocks that cost well above average, as long as the halves keep min_points <= //
+    std::vector<double> costs(leaves.size());
+    double total_cost = 0.0;
+    for (size_t A = 0; A < leaves.size(); A++) {
+        costs[A] = block_cost(leaves[A]);
+        total_cost += costs[A];
+    }
+    double target_cost = 2.0 * total_cost / std::max<size_t>(leaves.size(), 1);
+    std::vector<std::vector<int>> balanced;
+    while (!leaves.empty()) {
+        std::vector<std::vector<int>> next;
+        std::vector<double> next_costs;
+        for (size_t A = 0; A < leaves.size(); A++) {
+            if (costs[A] > target_cost && leaves[A].size() >= 2 * tol_min_points_) {
+                std::vector<int> left, right;
+                bisect(leaves[A], left, right);
+                next_costs.push_back(block_cost(left));
+                next_costs.push_back(block_cost(right));
+                next.push_back(left);
+                next.push_back(right);
+            } else {
+                balanced.push_back(leaves[A]);
+            }
+        }
+        leaves = next;
+        costs = next_costs;
+    }
+
+    // => Move stuff over <= //
+    x_ = new double[npoints_];
+    y_ = new double[npoints_];
+    z_ = new double[npoints_];
+    w_ = new double[npoints_];
+
+    blocks_.clear();
+    max_points_ = 0;
+    size_t index = 0;
+    for (size_t A = 0; A < balanced.size(); A++) {
+        const std::vector<int> &points = balanced[A];
+        for (size_t Q = 0; Q < points.size(); Q++) {
+            x_[index + Q] = x_ref_[points[Q]];
+            y_[index + Q] = y_ref_[points[Q]];
+            z_[index + Q] = z_ref_[points[Q]];
+            w_[index + Q] = w_ref_[points[Q]];
+        }
+        auto bop = std::make_shared<BlockOPoints>(A, points.size(), &x_[index], &y_[index], &z_[index], &w_[index],
+                                                  extents_);
+        // BlockOPoints construction performs additional pruning. Need to test if any points remain.
+        if (bop->local_nbf()) {
+            blocks_.push_back(bop);
+            max_points_ = std::max<int>(max_points_, points.size());
+        }
+        index += points.size();
+    }
+
+    // Most expensive blocks first, by the actual significant functions of each block
+    std::stable_sort(blocks_.begin(), blocks_.end(),
+                     [](const std::shared_ptr<BlockOPoints> &a, const std::shared_ptr<BlockOPoints> &b) {
+                         return a->npoints() * a->local_nbf() > b->npoints() * b->local_nbf();
+                     });
+
+    max_functions_ = 0;
+    collocation_size_ = 0;
+    for (size_t A = 0; A < blocks_.size(); A++) {
+        collocation_size_ += blocks_[A]->local_nbf() * blocks_[A]->npoints();
+        if ((size_t)max_functions_ < blocks_[A]->local_nbf()) {
+            max_functions_ = blocks_[A]->local_nbf();
+        }
+    }
+
+    if (print_ > 1) {
+        double max_cost = 0.0;
+        double sum_cost = 0.0;
+        for (const auto &bop : blocks_) {
+            double cost = (double)bop->npoints() * bop->local_nbf();
+            max_cost = std::max(max_cost, cost);
+            sum_cost += cost;
+        }
+        outfile->Printf("    Balanced blocking: %zu blocks, max/mean cost = %8.3f\n\n", blocks_.size(),
+                        (blocks_.empty() ? 0.0 : max_cost * blocks_.size() / sum_cost));
+    }
+}
+
 RadialGrid::RadialGrid() : npoints_(0) {}
 RadialGrid::~RadialGrid() {
     if (npoints_) {
@@ -137,6 +137,12 @@ class MolecularGrid {
     /// A copy of the options used, for printing purposes.
     MolecularGridOptions options_;
 
+    /// Rebuild from a stored grid under key if no atom moved more than tolerance from it, else return false
+    bool reuse_grid(const std::string& key, double tolerance, MolecularGridOptions const& opt,
+                    std::shared_ptr<BasisExtents> extents);
+    /// Store this grid under key for later reuse_grid calls
+    void store_grid(const std::string& key) const;
+
    public:
     MolecularGrid(std::shared_ptr<Molecule> molecule);
     virtual ~MolecularGrid();
@@ -444,6 +450,8 @@ class BlockOPoints {
     double* w() const { return w_; }
     /// The center of the block
     Vector3 center() const { return xc_; }
+    /// The bounding radius of the block
+    double R() const { return R_; }
 
     /// Relevant shells, local -> global
     const std::vector<int>& shells_local_to_global() const { return shells_local_to_global_; }
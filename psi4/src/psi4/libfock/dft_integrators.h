@@ -41,7 +41,9 @@
 #include "psi4/libmints/matrix.h"
 #include "psi4/libmints/vector.h"
 
+#include <array>
 #include <cstdlib>
+#include <vector>
 
 #ifdef _OPENMP
 #include <omp.h>
@@ -213,14 +215,25 @@ inline void rks_integrator(std::shared_ptr<BlockOPoints> block, std::shared_ptr<
     }
 }
 
+// Adds per-function gradient contributions to the atoms owning the functions. G may be shared across threads.
+inline void scatter_gradient(std::shared_ptr<BasisSet> primary, const std::vector<int>& function_map,
+                             const std::vector<std::array<double, 3>>& Gf, SharedMatrix G) {
+    auto Gp = G->pointer();
+    for (size_t ml = 0; ml < function_map.size(); ml++) {
+        auto A = primary->function_to_center(function_map[ml]);
+        for (int c = 0; c < 3; c++) {
+#pragma omp atomic
+            Gp[A][c] += Gf[ml][c];
+        }
+    }
+}
+
 inline void rks_gradient_integrator(std::shared_ptr<BasisSet> primary, std::shared_ptr<BlockOPoints> block,
                                     std::shared_ptr<SuperFunctional> fworker, std::shared_ptr<PointFunctions> pworker,
                                     SharedMatrix G, SharedMatrix U, int ansatz = -1) {
     ansatz = (ansatz == -1 ? fworker->ansatz() : ansatz);
 
     // => Setup scratch pointers, and associated variables <= //
-    auto Gp = G->pointer();
-
     auto Up = U->pointer();
     auto Tp = pworker->scratch()[0]->pointer();
     auto Dp = pworker->D_scratch()[0]->pointer();
@@ -234,6 +247,9 @@ inline void rks_gradient_integrator(std::shared_ptr<BasisSet> primary, std::shar
     const auto& function_map = block->functions_local_to_global();
     auto nlocal = function_map.size();
 
+    // Per-function contributions, scattered onto the shared G once the block is done
+    std::vector<std::array<double, 3>> Gf(nlocal, {0.0, 0.0, 0.0});
+
     // => Setup accessors to computed values <= //
     auto phi = pworker->basis_value("PHI")->pointer();
     auto phi_x = pworker->basis_value("PHI_X")->pointer();
@@ -276,10 +292,9 @@ inline void rks_gradient_integrator(std::shared_ptr<BasisSet> primary, std::shar
     // dE += einsum("pn, pnx, ni -> ix", U, -- φ, δ)
     //                                      ∂x
     for (int ml = 0; ml < nlocal; ml++) {
-        auto A = primary->function_to_center(function_map[ml]);
-        Gp[A][0] += C_DDOT(npoints, &Up[0][ml], max_functions, &phi_x[0][ml], coll_funcs);
-        Gp[A][1] += C_DDOT(npoints, &Up[0][ml], max_functions, &phi_y[0][ml], coll_funcs);
-        Gp[A][2] += C_DDOT(npoints, &Up[0][ml], max_functions, &phi_z[0][ml], coll_funcs);
+        Gf[ml][0] += C_DDOT(npoints, &Up[0][ml], max_functions, &phi_x[0][ml], coll_funcs);
+        Gf[ml][1] += C_DDOT(npoints, &Up[0][ml], max_functions, &phi_y[0][ml], coll_funcs);
+        Gf[ml][2] += C_DDOT(npoints, &Up[0][ml], max_functions, &phi_z[0][ml], coll_funcs);
     }
 
     // => GGA Contribution (Term 2) <= //
@@ -304,10 +319,9 @@ inline void rks_gradient_integrator(std::shared_ptr<BasisSet> primary, std::shar
             C_DAXPY(nlocal, -2.0 * w[P] * (2.0 * v_gamma_aa[P] * rho_ax[P]), Up[P], 1, Tp[P], 1);
         }
         for (int ml = 0; ml < nlocal; ml++) {
-            int A = primary->function_to_center(function_map[ml]);
-            Gp[A][0] += C_DDOT(npoints, &Tp[0][ml], max_functions, &phi_xx[0][ml], coll_funcs);
-            Gp[A][1] += C_DDOT(npoints, &Tp[0][ml], max_functions, &phi_xy[0][ml], coll_funcs);
-            Gp[A][2] += C_DDOT(npoints, &Tp[0][ml], max_functions, &phi_xz[0][ml], coll_funcs);
+            Gf[ml][0] += C_DDOT(npoints, &Tp[0][ml], max_functions, &phi_xx[0][ml], coll_funcs);
+            Gf[ml][1] += C_DDOT(npoints, &Tp[0][ml], max_functions, &phi_xy[0][ml], coll_funcs);
+            Gf[ml][2] += C_DDOT(npoints, &Tp[0][ml], max_functions, &phi_xz[0][ml], coll_funcs);
         }
 
         // y
@@ -316,10 +330,9 @@ inline void rks_gradient_integrator(std::shared_ptr<BasisSet> primary, std::shar
             C_DAXPY(nlocal, -2.0 * w[P] * (2.0 * v_gamma_aa[P] * rho_ay[P]), Up[P], 1, Tp[P], 1);
         }
         for (int ml = 0; ml < nlocal; ml++) {
-            int A = primary->function_to_center(function_map[ml]);
-            Gp[A][0] += C_DDOT(npoints, &Tp[0][ml], max_functions, &phi_xy[0][ml], coll_funcs);
-            Gp[A][1] += C_DDOT(npoints, &Tp[0][ml], max_functions, &phi_yy[0][ml], coll_funcs);
-            Gp[A][2] += C_DDOT(npoints, &Tp[0][ml], max_functions, &phi_yz[0][ml], coll_funcs);
+            Gf[ml][0] += C_DDOT(npoints, &Tp[0][ml], max_functions, &phi_xy[0][ml], coll_funcs);
+            Gf[ml][1] += C_DDOT(npoints, &Tp[0][ml], max_functions, &phi_yy[0][ml], coll_funcs);
+            Gf[ml][2] += C_DDOT(npoints, &Tp[0][ml], max_functions, &phi_yz[0][ml], coll_funcs);
         }
 
         // z
@@ -328,10 +341,9 @@ inline void rks_gradient_integrator(std::shared_ptr<BasisSet> primary, std::shar
             C_DAXPY(nlocal, -2.0 * w[P] * (2.0 * v_gamma_aa[P] * rho_az[P]), Up[P], 1, Tp[P], 1);
         }
         for (int ml = 0; ml < nlocal; ml++) {
-            int A = primary->function_to_center(function_map[ml]);
-            Gp[A][0] += C_DDOT(npoints, &Tp[0][ml], max_functions, &phi_xz[0][ml], coll_funcs);
-            Gp[A][1] += C_DDOT(npoints, &Tp[0][ml], max_functions, &phi_yz[0][ml], coll_funcs);
-            Gp[A][2] += C_DDOT(npoints, &Tp[0][ml], max_functions, &phi_zz[0][ml], coll_funcs);
+            Gf[ml][0] += C_DDOT(npoints, &Tp[0][ml], max_functions, &phi_xz[0][ml], coll_funcs);
+            Gf[ml][1] += C_DDOT(npoints, &Tp[0][ml], max_functions, &phi_yz[0][ml], coll_funcs);
+            Gf[ml][2] += C_DDOT(npoints, &Tp[0][ml], max_functions, &phi_zz[0][ml], coll_funcs);
         }
     }
 
@@ -370,13 +382,14 @@ inline void rks_gradient_integrator(std::shared_ptr<BasisSet> primary, std::shar
                 C_DAXPY(nlocal, -2.0 * w[P] * (v_tau_a[P]), Up[P], 1, Tp[P], 1);
             }
             for (int ml = 0; ml < nlocal; ml++) {
-                int A = primary->function_to_center(function_map[ml]);
-                Gp[A][0] += C_DDOT(npoints, &Tp[0][ml], max_functions, &phi_j[0][0][ml], coll_funcs);
-                Gp[A][1] += C_DDOT(npoints, &Tp[0][ml], max_functions, &phi_j[1][0][ml], coll_funcs);
-                Gp[A][2] += C_DDOT(npoints, &Tp[0][ml], max_functions, &phi_j[2][0][ml], coll_funcs);
+                Gf[ml][0] += C_DDOT(npoints, &Tp[0][ml], max_functions, &phi_j[0][0][ml], coll_funcs);
+                Gf[ml][1] += C_DDOT(npoints, &Tp[0][ml], max_functions, &phi_j[1][0][ml], coll_funcs);
+                Gf[ml][2] += C_DDOT(npoints, &Tp[0][ml], max_functions, &phi_j[2][0][ml], coll_funcs);
             }
         }
     }
+
+    scatter_gradient(primary, function_map, Gf, G);
 }
 
 }  // namespace dft_integrators
@@ -142,5 +142,29 @@ class OctreeGridBlocker : public GridBlocker {
 
     void block() override;
 };
+
+/**
+ * Cost-balanced blocking: median bisection along the longest axis, then further splits of
+ * blocks whose estimated cost (points x significant basis functions) is well above the
+ * average. Blocks are returned in order of decreasing cost, so a dynamic OpenMP schedule
+ * over them hands out the expensive work first.
+ */
+class BalancedGridBlocker : public GridBlocker {
+   protected:
+    /// Estimated cost of the points of a candidate block
+    double block_cost(const std::vector<int>& points) const;
+    /// Bounding sphere radius (squared) of the points about their centroid
+    double block_radius2(const std::vector<int>& points) const;
+    /// Split points at the median of their longest axis
+    void bisect(const std::vector<int>& points, std::vector<int>& left, std::vector<int>& right) const;
+
+   public:
+    BalancedGridBlocker(const int npoints_ref, double const* x_ref, double const* y_ref, double const* z_ref,
+                        double const* w_ref, const int max_points, const int min_points, const double max_radius,
+                        std::shared_ptr<BasisExtents> extents);
+    ~BalancedGridBlocker() override;
+
+    void block() override;
+};
 }  // namespace psi
 #endif
@@ -37,14 +37,20 @@
 #include "psi4/psifiles.h"
 #include "psi4/libiwl/iwl.hpp"
 #include "psi4/libmints/matrix.h"
+#include "psi4/libmints/vector.h"
 #include "psi4/libmints/basisset.h"
 #include "psi4/lib3index/cholesky.h"
 #include "psi4/lib3index/dfhelper.h"
 #include "psi4/libmints/petitelist.h"
 #include "psi4/libmints/integral.h"
+#include "psi4/libmints/twobody.h"
 #include "psi4/libpsi4util/PsiOutStream.h"
 #include "psi4/libpsi4util/process.h"
 
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <mutex>
 #include <sstream>
 #include <vector>
 #ifdef _OPENMP
@@ -71,8 +77,12 @@ JK::~JK() {}
 std::shared_ptr<JK> JK::build_JK(std::shared_ptr<BasisSet> primary, std::shared_ptr<BasisSet> auxiliary,
                                  Options& options, std::string jk_type) {
 
+    if (jk_type == "AUTO") {
+        jk_type = select_JK_type(primary, options, false, Process::environment.get_memory() / sizeof(double));
+    }
+
     // check if algorithm is composite
-    std::array<std::string, 3> composite_algos = { "DFDIRJ", "COSX", "LINK" };
+    std::array<std::string, 4> composite_algos = { "DFDIRJ", "CFMM", "COSX", "LINK" };
     bool is_composite = std::any_of(
       composite_algos.cbegin(),
       composite_algos.cend(),
@@ -82,7 +92,8 @@ std::shared_ptr<JK> JK::build_JK(std::shared_ptr<BasisSet> primary, std::shared_
     bool do_density_screen = options.get_str("SCREENING") == "DENSITY";
     bool do_df_scf_guess = options.get_bool("DF_SCF_GUESS");
     
-    bool can_do_density_screen = (jk_type == "DIRECT" || jk_type == "DFDIRJ+LINK" || jk_type == "DFDIRJ");
+    bool can_do_density_screen = (jk_type == "DIRECT" || jk_type == "DFDIRJ+LINK" || jk_type == "DFDIRJ" ||
+                                  jk_type == "CFMM+LINK" || jk_type == "CFMM");
 
     if (do_density_screen && !(can_do_density_screen || do_df_scf_guess)) {
         throw PSIEXCEPTION("Density screening has not been implemented for non-Direct SCF algorithms.");
@@ -148,7 +159,9 @@ std::shared_ptr<JK> JK::build_JK(std::shared_ptr<BasisSet> primary, std::shared_
         return std::shared_ptr<JK>(jk);
 
     } else if (jk_type == "DIRECT") {
-        DirectJK* jk = new DirectJK(primary, options);
+        // Launched on several MPI ranks, the direct build is shared between them
+        DirectJK* jk = (DistributedJK::mpi_size() > 1 ? new DistributedJK(primary, options)
+                                                       : new DirectJK(primary, options));
 
         if (options["INTS_TOLERANCE"].has_changed()) jk->set_cutoff(options.get_double("INTS_TOLERANCE"));
         if (options["SCREENING"].has_changed()) jk->set_csam(options.get_str("SCREENING") == "CSAM");
@@ -204,6 +217,9 @@ std::shared_ptr<JK> JK::build_JK(std::shared_ptr<BasisSet> primary, std::shared_
             return build_JK(primary, auxiliary, options, "DISK_DF");
         }
 
+    } else if (jk_type == "AUTO") {
+        return build_JK(primary, auxiliary, options, select_JK_type(primary, options, do_wK, doubles));
+
     } else {  // otherwise it has already been set
         return build_JK(primary, auxiliary, options, options.get_str("SCF_TYPE"));
     }
@@ -212,10 +228,118 @@ std::shared_ptr<JK> JK::build_JK(std::shared_ptr<BasisSet> primary, std::shared_
     // instead, I will let the already existing sets do their job
     // this requires do_wK and doubles to be passed here and set
 }
+namespace {
+// Significant function pairs of primary without computing integrals: a pair of shells counts if the
+// overlap prefactor of their most diffuse primitives, exp(-ab/(a+b) R^2), is above the cutoff
+size_t overlap_pair_estimate(std::shared_ptr<BasisSet> primary, double cutoff) {
+    int nshell = primary->nshell();
+    std::vector<double> diffuse(nshell);
+    for (int P = 0; P < nshell; P++) {
+        const GaussianShell& shell = primary->shell(P);
+        diffuse[P] = shell.exp(0);
+        for (int k = 1; k < shell.nprimitive(); k++) diffuse[P] = std::min(diffuse[P], shell.exp(k));
+    }
+    double log_cutoff = std::log(cutoff);
+
+    size_t npair = 0;
+    for (int P = 0; P < nshell; P++) {
+        const GaussianShell& sP = primary->shell(P);
+        const double* A = sP.center();
+        size_t nP = sP.nfunction();
+        for (int Q = 0; Q <= P; Q++) {
+            const GaussianShell& sQ = primary->shell(Q);
+            const double* B = sQ.center();
+            size_t nQ = sQ.nfunction();
+            double R2 = (A[0] - B[0]) * (A[0] - B[0]) + (A[1] - B[1]) * (A[1] - B[1]) + (A[2] - B[2]) * (A[2] - B[2]);
+            if (-diffuse[P] * diffuse[Q] / (diffuse[P] + diffuse[Q]) * R2 < log_cutoff) continue;
+            npair += (P == Q ? nP * (nP + 1) / 2 : nP * nQ);
+        }
+    }
+    return npair;
+}
+}  // namespace
+
+std::string JK::select_JK_type(std::shared_ptr<BasisSet> primary, Options& options, bool do_wK, size_t doubles,
+                               std::shared_ptr<TwoBodyAOInt> eri) {
+    // Rough per-element wall times [ns]: one ERI on one core, and streaming one PK supermatrix
+    // element through the contraction, which is bandwidth bound beyond a few threads
+    const double t_eri = 10.0;
+    const double t_pk = 1.0;
+    const int bandwidth_threads = 4;
+    // Typical SCF length, and the share of the quartets an incremental direct build still computes
+    const double niter = 15.0;
+    const double incfock_share = 0.5;
+
+    int nthread = Process::environment.get_n_threads();
+    size_t nbf = primary->nbf();
+    size_t npair = nbf * (nbf + 1) / 2;
+    size_t pk_size = npair * (npair + 1) / 2;
+    size_t ncorebuf = (do_wK ? 3 : 2);
+
+    // Sparsity: the function pairs that survive screening bound the quartets either builder computes.
+    // Prefer a sieve that already exists over building an integral object just to count.
+    std::string sieve = "Schwarz";
+    size_t nsig = 0;
+    if (eri) {
+        nsig = eri->function_pairs().size();
+    } else {
+        nsig = TwoBodyAOInt::shared_function_pair_count(primary, "coulomb");
+    }
+    if (nsig == 0) {
+        sieve = "overlap";
+        nsig = overlap_pair_estimate(primary, options.get_double("INTS_TOLERANCE"));
+    }
+    double nint = 0.5 * nsig * (nsig + 1.0);
+
+    // PK only pays off in core (same 9/10 safety factor as PKManager), out of core every iteration rereads disk
+    bool pk_incore = ncorebuf * pk_size < doubles / 10 * 9;
+    bool incfock = options.exists("INCFOCK") && options.get_bool("INCFOCK");
+    // Every SCF_SUBTYPE but AUTO is a PK sub-algorithm, which the user asked for by name
+    std::string subtype = (options.exists("SCF_SUBTYPE") ? options.get_str("SCF_SUBTYPE") : "AUTO");
+
+    double cost_pk = nint * t_eri / nthread + niter * ncorebuf * pk_size * t_pk / std::min(nthread, bandwidth_threads);
+    double cost_direct = niter * (incfock ? incfock_share : 1.0) * nint * t_eri / nthread;
+
+    std::string jk_type;
+    if (subtype != "AUTO") {
+        jk_type = "PK";
+    } else {
+        jk_type = (pk_incore && cost_pk < cost_direct ? "PK" : "DIRECT");
+    }
+
+    // Callers rebuild JK objects for the same system (SCF, then the response of a gradient), report each choice once
+    std::stringstream report;
+    report << "  ==> SCF_TYPE AUTO <==\n\n";
+    report << "    Basis functions:   " << std::setw(11) << nbf << "\n";
+    report << "    Significant pairs: " << std::setw(11) << nsig << " of " << npair << " (" << sieve << ")\n";
+    report << "    OpenMP threads:    " << std::setw(11) << nthread << "\n";
+    report << "    PK in core:        " << std::setw(11) << (pk_incore ? "Yes" : "No") << "\n";
+    report << std::scientific << std::setprecision(3);
+    if (pk_incore) report << "    Est. PK [s]:       " << std::setw(11) << cost_pk * 1.0E-9 << "\n";
+    report << "    Est. DIRECT [s]:   " << std::setw(11) << cost_direct * 1.0E-9 << "\n";
+    if (subtype != "AUTO") report << "    SCF_SUBTYPE:       " << std::setw(11) << subtype << "\n";
+    report << "    Selected:          " << std::setw(11) << jk_type << "\n\n";
+
+    static std::mutex report_mutex;
+    static std::string last_report;
+    int print = (options.exists("PRINT") ? options.get_int("PRINT") : 1);
+    std::lock_guard<std::mutex> lock(report_mutex);
+    if (print >= 1 && report.str() != last_report) {
+        outfile->Printf("%s", report.str().c_str());
+        last_report = report.str();
+    }
+
+    return jk_type;
+}
+
 SharedVector JK::iaia(SharedMatrix /*Ci*/, SharedMatrix /*Ca*/) {
     throw PSIEXCEPTION("JK: (ia|ia) integrals not implemented");
 }
 
+double JKStats::wall_time() {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
 const std::unordered_map<std::string, std::vector<size_t> >& JK::computed_shells_per_iter() {
     return computed_shells_per_iter_;
 }
@@ -247,6 +371,7 @@ void JK::common_init() {
     omega_alpha_ = 1.0;
     omega_beta_ = 0.0;
     early_screening_ = false;
+    low_precision_ = false;
 
     num_computed_shells_ = 0L;
     computed_shells_per_iter_ = {};
@@ -255,6 +380,25 @@ void JK::common_init() {
         std::make_shared<IntegralFactory>(primary_, primary_, primary_, primary_);
     auto pet = std::make_shared<PetiteList>(primary_, integral);
     AO2USO_ = SharedMatrix(pet->aotoso());
+
+    // Each SO mixes at most (group order) AOs, so the SO <-> AO transforms below work on the
+    // nonzero pattern of AO2USO_ instead of multiplying by it densely
+    int nao = AO2USO_->rowspi()[0];
+    uso_aos_.assign(AO2USO_->nirrep(), {});
+    ao_usos_.assign(nao, {});
+    for (int h = 0; h < AO2USO_->nirrep(); h++) {
+        int nso = AO2USO_->colspi()[h];
+        uso_aos_[h].resize(nso);
+        if (!nso) continue;
+        double** Up = AO2USO_->pointer(h);
+        for (int mu = 0; mu < nao; mu++) {
+            for (int i = 0; i < nso; i++) {
+                if (Up[mu][i] == 0.0) continue;
+                uso_aos_[h][i].emplace_back(mu, Up[mu][i]);
+                ao_usos_[mu].emplace_back(h, i, Up[mu][i]);
+            }
+        }
+    }
 }
 size_t JK::memory_overhead() const {
     size_t mem = 0L;
@@ -431,8 +575,8 @@ void JK::USO2AO() {
         C_right_ao_ = C_left_ao_;
     }
 
-    // Transform D
-    double* temp = new double[AO2USO_->max_ncol() * AO2USO_->max_nrow()];
+    // Transform D, one AO row per thread: D_mn = U_mi D_ij U_nj over the nonzero U only
+    int nao = AO2USO_->rowspi()[0];
     for (size_t N = 0; N < D_.size(); ++N) {
         // Input is already C1
         if (!input_symmetry_cast_map_[N]) {
@@ -445,20 +589,22 @@ void JK::USO2AO() {
         }
         D_ao_[N]->zero();
         int symm = D_[N]->symmetry();
-        for (int h = 0; h < AO2USO_->nirrep(); ++h) {
-            int nao = AO2USO_->rowspi()[0];
-            int nsol = AO2USO_->colspi()[h];
-            int nsor = AO2USO_->colspi()[h ^ symm];
-            if (!nsol || !nsor) continue;
-            double** Ulp = AO2USO_->pointer(h);
-            double** Urp = AO2USO_->pointer(h ^ symm);
-            double** DSOp = D_[N]->pointer(h ^ symm);
-            double** DAOp = D_ao_[N]->pointer();
-            C_DGEMM('N', 'T', nsol, nao, nsor, 1.0, DSOp[0], nsor, Urp[0], nsor, 0.0, temp, nao);
-            C_DGEMM('N', 'N', nao, nao, nsol, 1.0, Ulp[0], nsol, temp, nao, 1.0, DAOp[0], nao);
+        double** DAOp = D_ao_[N]->pointer();
+#pragma omp parallel for schedule(dynamic) num_threads(omp_nthread_)
+        for (int mu = 0; mu < nao; mu++) {
+            for (const auto& l : ao_usos_[mu]) {
+                int h = std::get<0>(l);
+                double cl = std::get<2>(l);
+                int nsor = AO2USO_->colspi()[h ^ symm];
+                double* Dip = D_[N]->pointer(h ^ symm)[0] + (size_t)std::get<1>(l) * nsor;
+                for (int j = 0; j < nsor; j++) {
+                    double val = cl * Dip[j];
+                    if (val == 0.0) continue;
+                    for (const auto& r : uso_aos_[h ^ symm][j]) DAOp[mu][r.first] += val * r.second;
+                }
+            }
         }
     }
-    delete[] temp;
 
     // Transform the left-index of all C matrices from SO basis to AO basis.
 
@@ -470,18 +616,18 @@ void JK::USO2AO() {
             continue;
         }
 
-        int offset = 0;
-        for (int h = 0; h < AO2USO_->nirrep(); ++h) {
-            int nao = AO2USO_->rowspi()[0];
-            int nso = AO2USO_->colspi()[h];
-            int ncol = C_left_ao_[N]->colspi()[0];
-            int ncolspi = C_left_[N]->colspi()[h];
-            if (nso == 0 || ncolspi == 0) continue;
-            double** Up = AO2USO_->pointer(h);
-            double** CAOp = C_left_ao_[N]->pointer();
-            double** CSOp = C_left_[N]->pointer(h);
-            C_DGEMM('N', 'N', nao, ncolspi, nso, 1.0, Up[0], nso, CSOp[0], ncolspi, 0.0, &CAOp[0][offset], ncol);
-            offset += ncolspi;
+        std::vector<int> offset(AO2USO_->nirrep() + 1, 0);
+        for (int h = 0; h < AO2USO_->nirrep(); ++h) offset[h + 1] = offset[h] + C_left_[N]->colspi()[h];
+        double** CAOp = C_left_ao_[N]->pointer();
+#pragma omp parallel for schedule(dynamic) num_threads(omp_nthread_)
+        for (int mu = 0; mu < nao; mu++) {
+            for (const auto& l : ao_usos_[mu]) {
+                int h = std::get<0>(l);
+                int ncolspi = C_left_[N]->colspi()[h];
+                if (ncolspi == 0) continue;
+                double* CSOp = C_left_[N]->pointer(h)[std::get<1>(l)];
+                C_DAXPY(ncolspi, std::get<2>(l), CSOp, 1, &CAOp[mu][offset[h]], 1);
+            }
         }
     }
 
@@ -493,22 +639,22 @@ void JK::USO2AO() {
             continue;
         }
 
-        int offset = 0;
+        // We MUST pack columns in the order in which they appear for totally symmetric C_left.
+        // This means SO block h ^ symm lands at the offset of h, not of h ^ symm.
+        // Remember: colspi_[h] describes not the orbitals of block h, but the orbitals that transform as h.
         int symm = D_[N]->symmetry();
-        for (int h = 0; h < AO2USO_->nirrep(); ++h) {
-            // We MUST pack columns in the order in which they appear for totally symmetric C_left.
-            // This means we transform in order of h ^ symm, not in order of h.
-            int nao = AO2USO_->rowspi()[0];
-            int nso = AO2USO_->colspi()[h ^ symm];
-            int ncol = C_right_ao_[N]->colspi()[0];
-            // Remember: colspi_[h] describes not the orbitals of block h, but the orbitals that transform as h.
-            int ncolspi = C_right_[N]->colspi()[h];
-            if (nso == 0 || ncolspi == 0) continue;
-            double** Up = AO2USO_->pointer(h ^ symm);
-            double** CAOp = C_right_ao_[N]->pointer();
-            double** CSOp = C_right_[N]->pointer(h ^ symm);
-            C_DGEMM('N', 'N', nao, ncolspi, nso, 1.0, Up[0], nso, CSOp[0], ncolspi, 0.0, &CAOp[0][offset], ncol);
-            offset += ncolspi;
+        std::vector<int> offset(AO2USO_->nirrep() + 1, 0);
+        for (int h = 0; h < AO2USO_->nirrep(); ++h) offset[h + 1] = offset[h] + C_right_[N]->colspi()[h];
+        double** CAOp = C_right_ao_[N]->pointer();
+#pragma omp parallel for schedule(dynamic) num_threads(omp_nthread_)
+        for (int mu = 0; mu < nao; mu++) {
+            for (const auto& l : ao_usos_[mu]) {
+                int h = std::get<0>(l) ^ symm;
+                int ncolspi = C_right_[N]->colspi()[h];
+                if (ncolspi == 0) continue;
+                double* CSOp = C_right_[N]->pointer(h ^ symm)[std::get<1>(l)];
+                C_DAXPY(ncolspi, std::get<2>(l), CSOp, 1, &CAOp[mu][offset[h]], 1);
+            }
         }
     }
 
@@ -521,8 +667,11 @@ void JK::AO2USO() {
 
     // If not C1, J/K/wK are already allocated
 
-    // Transform
-    double* temp = new double[AO2USO_->max_ncol() * AO2USO_->max_nrow()];
+    // Transform, gathering each SO element from the few AOs it mixes: J_ij = U_mi J_mn U_nj
+    std::vector<std::pair<int, int>> rows;
+    for (int h = 0; h < AO2USO_->nirrep(); ++h) {
+        for (int i = 0; i < AO2USO_->colspi()[h]; ++i) rows.emplace_back(h, i);
+    }
     for (size_t N = 0; N < D_.size(); ++N) {
         // Input was desymmetrized, return as same
         if (!input_symmetry_cast_map_[N]) {
@@ -539,37 +688,31 @@ void JK::AO2USO() {
         }
 
         int symm = D_[N]->symmetry();
-        for (int h = 0; h < AO2USO_->nirrep(); ++h) {
-            int nao = AO2USO_->rowspi()[0];
-            int nsol = AO2USO_->colspi()[h];
+        std::vector<std::pair<SharedMatrix, SharedMatrix>> mats;
+        if (do_J_) mats.emplace_back(J_ao_[N], J_[N]);
+        if (do_K_) mats.emplace_back(K_ao_[N], K_[N]);
+        if (do_wK_) mats.emplace_back(wK_ao_[N], wK_[N]);
+
+#pragma omp parallel for schedule(dynamic) num_threads(omp_nthread_)
+        for (size_t ind = 0; ind < rows.size(); ++ind) {
+            int h = rows[ind].first;
+            int i = rows[ind].second;
             int nsor = AO2USO_->colspi()[h ^ symm];
-
-            if (!nsol || !nsor) continue;
-
-            double** Ulp = AO2USO_->pointer(h);
-            double** Urp = AO2USO_->pointer(h ^ symm);
-
-            if (do_J_) {
-                double** JAOp = J_ao_[N]->pointer();
-                double** JSOp = J_[N]->pointer(h);
-                C_DGEMM('N', 'N', nao, nsor, nao, 1.0, JAOp[0], nao, Urp[0], nsor, 0.0, temp, nsor);
-                C_DGEMM('T', 'N', nsol, nsor, nao, 1.0, Ulp[0], nsol, temp, nsor, 0.0, JSOp[0], nsor);
-            }
-            if (do_K_) {
-                double** KAOp = K_ao_[N]->pointer();
-                double** KSOp = K_[N]->pointer(h);
-                C_DGEMM('N', 'N', nao, nsor, nao, 1.0, KAOp[0], nao, Urp[0], nsor, 0.0, temp, nsor);
-                C_DGEMM('T', 'N', nsol, nsor, nao, 1.0, Ulp[0], nsol, temp, nsor, 0.0, KSOp[0], nsor);
-            }
-            if (do_wK_) {
-                double** wKAOp = wK_ao_[N]->pointer();
-                double** wKSOp = wK_[N]->pointer(h);
-                C_DGEMM('N', 'N', nao, nsor, nao, 1.0, wKAOp[0], nao, Urp[0], nsor, 0.0, temp, nsor);
-                C_DGEMM('T', 'N', nsol, nsor, nao, 1.0, Ulp[0], nsol, temp, nsor, 0.0, wKSOp[0], nsor);
+            for (const auto& mat : mats) {
+                double** AOp = mat.first->pointer();
+                double* SOp = mat.second->pointer(h)[i];
+                for (int j = 0; j < nsor; ++j) {
+                    double val = 0.0;
+                    for (const auto& l : uso_aos_[h][i]) {
+                        double partial = 0.0;
+                        for (const auto& r : uso_aos_[h ^ symm][j]) partial += AOp[l.first][r.first] * r.second;
+                        val += l.second * partial;
+                    }
+                    SOp[j] = val;
+                }
             }
         }
     }
-    delete[] temp;
 }
 void JK::initialize() { preiterations(); }
 
@@ -629,7 +772,11 @@ void JK::compute() {
     }
 
     timer_on("JK: JK");
+    stats_ = JKStats();
+    double start = JKStats::wall_time();
     compute_JK();
+    stats_.total_time = JKStats::wall_time() - start;
+    stats_per_iter_.push_back(stats_);
     timer_off("JK: JK");
 
     if (C1()) {
@@ -683,6 +830,122 @@ void JK::zero() {
     }
 }
 
+size_t JK::factor_density_change(SharedMatrix dD, double cutoff, SharedMatrix& Cp, SharedMatrix& Cm) const {
+    int nbf = dD->rowspi()[0];
+
+    auto U = std::make_shared<Matrix>("dD Eigenvectors", nbf, nbf);
+    auto lambda = std::make_shared<Vector>("dD Eigenvalues", nbf);
+    auto dDsym = dD->clone();
+    dDsym->hermitivitize();
+    dDsym->diagonalize(U, lambda, descending);
+
+    double* lp = lambda->pointer();
+    int np = 0;
+    int nm = 0;
+    for (int i = 0; i < nbf; i++) {
+        if (lp[i] > cutoff) np++;
+        if (lp[i] < -cutoff) nm++;
+    }
+
+    // Eigenvalues are descending, so the positive part leads and the negative part trails
+    Cp = std::make_shared<Matrix>("dC+ (AO)", nbf, np);
+    Cm = std::make_shared<Matrix>("dC- (AO)", nbf, nm);
+    double** Up = U->pointer();
+    double** Cpp = Cp->pointer();
+    double** Cmp = Cm->pointer();
+    for (int i = 0; i < np; i++) {
+        double scale = std::sqrt(lp[i]);
+        for (int m = 0; m < nbf; m++) Cpp[m][i] = scale * Up[m][i];
+    }
+    for (int i = 0; i < nm; i++) {
+        int ind = nbf - nm + i;
+        double scale = std::sqrt(-lp[ind]);
+        for (int m = 0; m < nbf; m++) Cmp[m][i] = scale * Up[m][ind];
+    }
+
+    return (size_t)(np + nm);
+}
+
+bool JK::incfock_df_setup(Options& options, bool allowed, bool initial_iteration, int& count, double tolerance,
+                          size_t nocc, const std::vector<SharedMatrix>& D_prev, std::vector<SharedMatrix>& C_incr,
+                          std::vector<SharedMatrix>& D_incr) {
+    int reset = options.get_int("INCFOCK_FULL_FOCK_EVERY");
+    double incfock_conv = options.get_double("INCFOCK_CONVERGENCE");
+    double Dnorm = Process::environment.globals["SCF D NORM"];
+    // Do IFB on this iteration?
+    bool incremental = allowed && lr_symmetric_ && (Dnorm >= incfock_conv) && !initial_iteration &&
+                       (count % reset != reset - 1);
+
+    if (!initial_iteration && (Dnorm >= incfock_conv)) count += 1;
+
+    C_incr.clear();
+    D_incr.clear();
+    size_t njk = D_ao_.size();
+    if (incremental && D_prev.size() == njk) {
+        // Factor each density change into a (+, -) pair of pseudo-occupied orbitals
+        size_t rank = 0;
+        for (size_t jki = 0; jki < njk; jki++) {
+            auto dD = D_ao_[jki]->clone();
+            dD->subtract(D_prev[jki]);
+            SharedMatrix Cp, Cm;
+            rank = std::max(rank, factor_density_change(dD, tolerance, Cp, Cm));
+            C_incr.push_back(Cp);
+            C_incr.push_back(Cm);
+        }
+        // The K build scales with the number of orbital columns; only go incremental if that is a saving
+        incremental = (rank < nocc);
+    } else {
+        incremental = false;
+    }
+
+    if (incremental) {
+        for (const auto& C : C_incr) {
+            D_incr.push_back(linalg::doublet(C, C, false, true));
+        }
+    } else {
+        C_incr.clear();
+        zero();
+    }
+    return incremental;
+}
+
+void JK::incfock_df_buffers(size_t n, std::vector<SharedMatrix>& J_incr, std::vector<SharedMatrix>& K_incr,
+                            std::vector<SharedMatrix>& wK_incr) const {
+    int nbf = primary_->nbf();
+    J_incr.clear();
+    K_incr.clear();
+    wK_incr.clear();
+    for (size_t N = 0; N < n && do_J_; N++) J_incr.push_back(std::make_shared<Matrix>("dJ (AO)", nbf, nbf));
+    for (size_t N = 0; N < n && do_K_; N++) K_incr.push_back(std::make_shared<Matrix>("dK (AO)", nbf, nbf));
+    for (size_t N = 0; N < n && do_wK_; N++) wK_incr.push_back(std::make_shared<Matrix>("dwK (AO)", nbf, nbf));
+}
+
+void JK::incfock_df_accumulate(const std::vector<SharedMatrix>& J_incr, const std::vector<SharedMatrix>& K_incr,
+                               const std::vector<SharedMatrix>& wK_incr) {
+    for (size_t N = 0; N < D_ao_.size(); N++) {
+        if (do_J_) {
+            J_ao_[N]->add(J_incr[2 * N]);
+            J_ao_[N]->subtract(J_incr[2 * N + 1]);
+        }
+        if (do_K_) {
+            K_ao_[N]->add(K_incr[2 * N]);
+            K_ao_[N]->subtract(K_incr[2 * N + 1]);
+        }
+        if (do_wK_) {
+            wK_ao_[N]->add(wK_incr[2 * N]);
+            wK_ao_[N]->subtract(wK_incr[2 * N + 1]);
+        }
+    }
+}
+
+void JK::incfock_df_postiter(std::vector<SharedMatrix>& D_prev) const {
+    // Save a copy of the density for the next iteration
+    D_prev.clear();
+    for (auto const& Di : D_ao_) {
+        D_prev.push_back(Di->clone());
+    }
+}
+
 size_t JK::num_computed_shells() {
     outfile->Printf("WARNING: JK::num_computed_shells() was called, but benchmarking is disabled for the chosen JK algorithm.");
     outfile->Printf(" Returning 0 as computed shells count.\n");
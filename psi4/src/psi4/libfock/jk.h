@@ -29,13 +29,16 @@
 #ifndef JK_H
 #define JK_H
 
+#include <array>
 #include <vector>
 
 #include "psi4/pragma.h"
 PRAGMA_WARNING_PUSH
 PRAGMA_WARNING_IGNORE_DEPRECATED_DECLARATIONS
 #include <memory>
+#include <tuple>
 #include <unordered_map>
+#include <utility>
 PRAGMA_WARNING_POP
 #include "psi4/libmints/typedefs.h"
 #include "psi4/libmints/dimension.h"
@@ -45,6 +48,7 @@ class MinimalInterface;
 class BasisSet;
 class Matrix;
 class TwoBodyAOInt;
+class OneBodyAOInt;
 class Options;
 class PSIO;
 class DFHelper;
@@ -54,6 +58,35 @@ namespace pk {
 class PKManager;
 }
 
+/**
+ * Struct JKStats
+ *
+ * Performance counters for a single JK::compute() call. Each algorithm
+ * fills in the counters it can measure; the others stay zero. Times in
+ * the breakdown are summed over threads, total_time is wall time.
+ */
+struct JKStats {
+    /// ERI shell n-lets (triplets, quartets) computed
+    size_t shells_computed = 0;
+    /// ERI shell n-lets skipped (screened out, or handled without ERIs)
+    size_t shells_screened = 0;
+    /// Wall time of the compute() call [s]
+    double total_time = 0.0;
+    /// Time spent computing integrals [s]
+    double integral_time = 0.0;
+    /// Time spent contracting integrals with densities or orbitals [s]
+    double contraction_time = 0.0;
+    /// Integral data read from disk [bytes]
+    size_t disk_bytes_read = 0;
+    /// Floating point operations issued through BLAS contractions
+    double gemm_flops = 0.0;
+    /// Largest scratch footprint of the build [bytes]
+    size_t peak_scratch_bytes = 0;
+
+    /// Monotonic wall clock [s], for timing the counters above
+    static double wall_time();
+};
+
 // => BASE CLASS <= //
 
 /**
@@ -248,10 +281,16 @@ class PSI_API JK {
     std::vector<bool> input_symmetry_cast_map_;
     /// Use severe screening techniques? Useful in early SCF iterations (defaults to false)
     bool early_screening_;
+    /// Use single precision kernels where supported? Useful in early SCF iterations (defaults to false)
+    bool low_precision_;
     /// Number of ERI shell quartets computed, i.e., not screened out
     size_t num_computed_shells_;
     /// Tally of ERI shell n-lets (triplets, quartets) computed per SCF iteration 
     std::unordered_map<std::string, std::vector<size_t> > computed_shells_per_iter_;
+    /// Performance counters of the compute() call in progress (or the last one)
+    JKStats stats_;
+    /// Performance counters of every compute() call since the last clear_stats()
+    std::vector<JKStats> stats_per_iter_;
 
     // => Tasks <= //
 
@@ -298,6 +337,10 @@ class PSI_API JK {
     std::shared_ptr<BasisSet> primary_;
     /// AO2USO transformation matrix
     SharedMatrix AO2USO_;
+    /// Nonzero AO2USO_ elements by SO, [h][so] -> (ao, coefficient)
+    std::vector<std::vector<std::vector<std::pair<int, double>>>> uso_aos_;
+    /// Nonzero AO2USO_ elements by AO, [ao] -> (h, so, coefficient)
+    std::vector<std::vector<std::tuple<int, int, double>>> ao_usos_;
     /// Pseudo-occupied C matrices, left side
     std::vector<SharedMatrix> C_left_ao_;
     /// Pseudo-occupied C matrices, right side
@@ -349,6 +392,35 @@ class PSI_API JK {
     size_t memory_overhead() const;
     /// Zero out all J, K, and wK matrices
     void zero();
+    /**
+     * Factor a symmetric AO matrix as dD = Cp Cp^T - Cm Cm^T by eigendecomposition,
+     * dropping eigenvalues smaller than cutoff in magnitude. This lets the
+     * orbital-driven (DF/CD) algorithms contract a density difference in
+     * incremental Fock builds.
+     * @return number of columns in Cp plus number of columns in Cm
+     */
+    size_t factor_density_change(SharedMatrix dD, double cutoff, SharedMatrix& Cp, SharedMatrix& Cm) const;
+    /**
+     * INCFOCK for the orbital-driven (DF/CD) builders. Decides whether this iteration goes
+     * incremental, advancing count: never on the first iteration, for non-symmetric densities,
+     * below INCFOCK_CONVERGENCE, on every INCFOCK_FULL_FOCK_EVERY-th step, or if allowed is
+     * false. If it does, each D_ao_ - D_prev is factored into a (+, -) pair of pseudo-occupied
+     * orbitals in C_incr, with their pseudo-densities in D_incr, and the iteration only stays
+     * incremental if the factored rank is below nocc. Otherwise C_incr and D_incr are cleared
+     * and J/K/wK are zeroed for a full build.
+     * @return whether to build J/K/wK increments from C_incr and D_incr
+     */
+    bool incfock_df_setup(Options& options, bool allowed, bool initial_iteration, int& count, double tolerance,
+                          size_t nocc, const std::vector<SharedMatrix>& D_prev, std::vector<SharedMatrix>& C_incr,
+                          std::vector<SharedMatrix>& D_incr);
+    /// Allocate the J/K/wK increments for n factored densities of incfock_df_setup
+    void incfock_df_buffers(size_t n, std::vector<SharedMatrix>& J_incr, std::vector<SharedMatrix>& K_incr,
+                            std::vector<SharedMatrix>& wK_incr) const;
+    /// Add the (+) and subtract the (-) increments of each density onto J/K/wK
+    void incfock_df_accumulate(const std::vector<SharedMatrix>& J_incr, const std::vector<SharedMatrix>& K_incr,
+                               const std::vector<SharedMatrix>& wK_incr);
+    /// Save D_ao_ in D_prev for the next incfock_df_setup
+    void incfock_df_postiter(std::vector<SharedMatrix>& D_prev) const;
     /**
     * Return number of ERI shell quartets computed during the JK build process.
     */
@@ -389,6 +461,19 @@ class PSI_API JK {
     static std::shared_ptr<JK> build_JK(std::shared_ptr<BasisSet> primary, std::shared_ptr<BasisSet> auxiliary,
                                         Options& options, bool do_wK, size_t doubles);
 
+    /**
+    * Cost model behind SCF_TYPE AUTO: picks the faster of the exact-integral builders, in-core PK
+    * or DIRECT, for this basis, memory and thread count. Never picks an approximate (DF, CD, COSX)
+    * builder, so AUTO does not change the result beyond the integral screening. An explicit
+    * SCF_SUBTYPE names a PK sub-algorithm and selects PK.
+    * @param doubles memory available to the JK object
+    * @param eri an ERI object the caller already owns, whose sieve gives the significant pairs; if
+    *        null, the sieve shared through the basis set is used, or a primitive overlap estimate
+    * @return the selected SCF_TYPE
+    */
+    static std::string select_JK_type(std::shared_ptr<BasisSet> primary, Options& options, bool do_wK,
+                                      size_t doubles, std::shared_ptr<TwoBodyAOInt> eri = nullptr);
+
     /// Do we need to backtransform to C1 under the hood?
     virtual bool C1() const = 0;
     virtual std::string name() = 0;
@@ -492,6 +577,15 @@ class PSI_API JK {
     void set_early_screening(bool early_screening) { early_screening_ = early_screening; }
     bool get_early_screening() { return early_screening_; }
 
+    /**
+    * Run the dominant contractions in single precision where the algorithm
+    *       supports it (MemDFJK exchange, COSX grid contractions).
+    *       Intended for early SCF iterations only.
+    * @param low_precision low precision status (defaults to false)
+    */
+    void set_low_precision(bool low_precision) { low_precision_ = low_precision; }
+    bool get_low_precision() { return low_precision_; }
+
     // => Computers <= //
 
     /**
@@ -586,6 +680,16 @@ class PSI_API JK {
     const std::unordered_map<std::string, std::vector<size_t> >& computed_shells_per_iter();
     const std::vector<size_t>& computed_shells_per_iter(const std::string& n_let);
 
+    /**
+    * Performance counters of the last compute() call
+    */
+    const JKStats& stats() const { return stats_; }
+    /**
+    * Performance counters of every compute() call since construction or the last clear_stats()
+    */
+    const std::vector<JKStats>& stats_per_iter() const { return stats_per_iter_; }
+    void clear_stats() { stats_per_iter_.clear(); }
+
     /**
     * Print header information regarding JK
     * type on output file
@@ -741,6 +845,16 @@ class PSI_API DirectJK : public JK {
     // Perform Density matrix-based integral screening?
     bool density_screening_;
 
+    /// Number of NUMA domains to spread per-thread work over (0 disables NUMA-aware mode)
+    int numa_domains_;
+    /// This process takes the master tasks with task % task_nranks_ == task_rank_
+    int task_rank_ = 0;
+    int task_nranks_ = 1;
+    /// Sum a partial J/K matrix over all processes sharing the tasks (no-op here)
+    virtual void reduce_partial(SharedMatrix partial) {}
+    /// NUMA domain of an OpenMP thread (call from inside the parallel region)
+    int numa_domain(int thread, int nthread) const;
+
     // => Incremental Fock build variables <= //
     
     /// Perform Incremental Fock Build for J and K Matrices? (default false)
@@ -784,9 +898,13 @@ class PSI_API DirectJK : public JK {
      * @param D The list of AO density matrices to contract to form J and K (1 for RHF, 2 for UHF/ROHF)
      * @param J The list of AO J matrices to build (Same size as D, 0 if no matrices are to be built)
      * @param K The list of AO K matrices to build (Same size as D, 0 if no matrices are to be built)
+     * @param wints Optional list of range-separated TwoBodyAOInt objects (one per thread)
+     * @param wK Optional list of AO wK matrices, built from wints in the same shell quartet traversal
      */
     void build_JK_matrices(std::vector<std::shared_ptr<TwoBodyAOInt>>& ints, const std::vector<SharedMatrix>& D,
-                  std::vector<SharedMatrix>& J, std::vector<SharedMatrix>& K);
+                  std::vector<SharedMatrix>& J, std::vector<SharedMatrix>& K,
+                  std::vector<std::shared_ptr<TwoBodyAOInt>>* wints = nullptr,
+                  std::vector<SharedMatrix>* wK = nullptr);
 
     /// Common initialization
     void common_init();
@@ -828,6 +946,31 @@ class PSI_API DirectJK : public JK {
     void print_header() const override;
 };
 
+/**
+ * Class DistributedJK
+ *
+ * DirectJK spread over MPI ranks: every rank runs the same SCF, computes
+ * the master tasks it owns with the threaded DirectJK kernel, and the
+ * partial J/K matrices are all-reduced. Built in place of DirectJK when
+ * Psi4 is compiled with ENABLE_MPI and launched on more than one rank.
+ */
+class PSI_API DistributedJK : public DirectJK {
+   protected:
+    std::string name() override { return "DistributedJK"; }
+    void reduce_partial(SharedMatrix partial) override;
+
+   public:
+    DistributedJK(std::shared_ptr<BasisSet> primary, Options& options);
+    ~DistributedJK() override;
+
+    /// Number of MPI ranks (1 without MPI support); initializes MPI on first use
+    static int mpi_size();
+    /// Rank of this process (0 without MPI support)
+    static int mpi_rank();
+
+    void print_header() const override;
+};
+
 /** \brief Derived class extending the JK object to GTFock
  *
  *   Unfortunately GTFock needs to know the number of density
@@ -932,6 +1075,8 @@ class PSI_API DiskDFJK : public JK {
 
     /// Main (Q|mn) Tensor (or chunk for disk-based)
     SharedMatrix Qmn_;
+    /// Next (Q|mn) chunk for disk-based, read asynchronously while Qmn_ is contracted
+    SharedMatrix Qmn_next_;
     /// (Q|P)^-1 (P|mn) for wK (or chunk for disk-based)
     SharedMatrix Qlmn_;
     /// (Q|w|mn) for wK (or chunk for disk-based)
@@ -947,6 +1092,26 @@ class PSI_API DiskDFJK : public JK {
     std::vector<SharedMatrix> C_temp_;
     std::vector<SharedMatrix> Q_temp_;
 
+    // => Incremental Fock build variables <= //
+
+    /// Perform Incremental Fock Build for J and K Matrices? (default false)
+    bool incfock_;
+    /// The number of times INCFOCK has been performed (includes resets)
+    int incfock_count_;
+    bool do_incfock_iter_;
+    /// Eigenvalue cutoff for the low-rank factorization of the density change
+    double incfock_df_tolerance_;
+
+    /// Previous iteration pseudo-density matrix
+    std::vector<SharedMatrix> D_prev_;
+    /// Factored density change, (+, -) pair for each density
+    std::vector<SharedMatrix> C_incfock_;
+    /// Pseudo-densities of C_incfock_
+    std::vector<SharedMatrix> D_incfock_;
+
+    // Is the JK currently on the first SCF iteration of this SCF cycle?
+    bool initial_iteration_ = true;
+
     // => Required Algorithm-Specific Methods <= //
 
     /// Do we need to backtransform to C1 under the hood?
@@ -970,6 +1135,9 @@ class PSI_API DiskDFJK : public JK {
     void initialize_w_temps();
     void free_w_temps();
 
+    /// Build J/K/wK for the current C_left_ao_/C_right_ao_/D_ao_
+    void build_JK_matrices();
+
     // => J <= //
     virtual void initialize_JK_core();
     virtual void initialize_JK_disk();
@@ -1044,6 +1212,7 @@ class PSI_API DiskDFJK : public JK {
     void set_subalgo(std::string subalgo) { subalgo_ = subalgo; }
 
     // => Accessors <= //
+    bool do_incfock_iter() { return do_incfock_iter_; }
 
     /**
     * Print header information regarding JK
@@ -1132,6 +1301,26 @@ class PSI_API MemDFJK : public JK {
     /// Condition cutoff in fitting metric, defaults to 1.0E-12
     double condition_ = 1.0E-12;
 
+    // => Incremental Fock build variables <= //
+
+    /// Perform Incremental Fock Build for J and K Matrices? (default false)
+    bool incfock_;
+    /// The number of times INCFOCK has been performed (includes resets)
+    int incfock_count_;
+    bool do_incfock_iter_;
+    /// Eigenvalue cutoff for the low-rank factorization of the density change
+    double incfock_df_tolerance_;
+
+    /// Previous iteration pseudo-density matrix
+    std::vector<SharedMatrix> D_prev_;
+    /// Factored density change, (+, -) pair for each density
+    std::vector<SharedMatrix> C_incfock_;
+    /// Pseudo-densities of C_incfock_
+    std::vector<SharedMatrix> D_incfock_;
+
+    // Is the JK currently on the first SCF iteration of this SCF cycle?
+    bool initial_iteration_ = true;
+
     // => Required Algorithm-Specific Methods <= //
 
     int max_nocc() const;
@@ -1195,6 +1384,8 @@ class PSI_API MemDFJK : public JK {
     void set_omega_beta(double beta) override;
     void set_wcombine(bool wcombine) override;
 
+    bool do_incfock_iter() { return do_incfock_iter_; }
+
     /**
      * Returns the DFHelper object
      */
@@ -1207,7 +1398,7 @@ class PSI_API MemDFJK : public JK {
  * JK implementation framework enabling arbitrary mixing and matching
  * of separate J and K construction algorithms.
  * Current algorithms in place:
- * J: Direct DF-J
+ * J: Direct DF-J, CFMM
  * K: COSX, LinK
  *
  * TODO: Implement SplitJK companion framework for truly arbitrary mixing and matching
@@ -1269,6 +1460,28 @@ class PSI_API CompositeJK : public JK {
     // Density-based ERI Screening tolerance to use in the LinK algorithm
     double linK_ints_cutoff_;
 
+    // => CFMM variables <= //
+
+    /// Order of the multipole expansions
+    int cfmm_order_;
+    /// Edge length of the CFMM boxes (bohr)
+    double cfmm_box_length_;
+    /// Cells A and B interact through multipoles if |R_AB| >= cfmm_separation_ * (r_A + r_B)
+    double cfmm_separation_;
+    /// Significant shell pairs (P >= Q) of each cell; a cell is a box plus an extent branch
+    std::vector<std::vector<std::pair<int, int>>> cfmm_cell_pairs_;
+    /// Expansion center of each cell
+    std::vector<std::array<double, 3>> cfmm_cell_centers_;
+    /// Non-separated cell pairs (A <= B), handled with four-center ERIs
+    std::vector<std::pair<int, int>> cfmm_near_cells_;
+    /// Well-separated partners of each cell, handled with multipoles
+    std::vector<std::vector<int>> cfmm_far_cells_;
+    /// Cartesian components (lx, ly, lz) of the multipoles in CCA order, up to cfmm_order_
+    std::vector<std::array<int, 3>> cfmm_comps_;
+    /// per-thread multipole and overlap integral objects
+    std::vector<std::shared_ptr<OneBodyAOInt>> cfmm_mpole_ints_;
+    std::vector<std::shared_ptr<OneBodyAOInt>> cfmm_overlap_ints_;
+
     std::string name() override { return "CompositeJK"; }
     size_t memory_estimate() override;
 
@@ -1293,6 +1506,14 @@ class PSI_API CompositeJK : public JK {
     void build_DirectDFJ(std::vector<std::shared_ptr<Matrix> >& D,
                  std::vector<std::shared_ptr<Matrix> >& J);
 
+    /// Sort the shell pairs into CFMM cells and classify the cell pairs
+    void setup_CFMM();
+    /// Build the coulomb (J) matrix using the continuous fast multipole method
+    /// Near-field cell pairs use four-center ERIs, well-separated ones use multipoles
+    /// Reference is https://doi.org/10.1016/0009-2614(94)00398-X
+    void build_CFMMJ(std::vector<std::shared_ptr<Matrix> >& D,
+                 std::vector<std::shared_ptr<Matrix> >& J);
+
     /**
      * @author Andy Jiang, Georgia Tech, December 2021
      * 
@@ -1357,6 +1578,7 @@ class PSI_API CompositeJK : public JK {
     void print_header() const override;
 
     void print_DirectDFJ_header() const;
+    void print_CFMM_header() const;
     void print_linK_header() const;
     void print_COSX_header() const;
 };
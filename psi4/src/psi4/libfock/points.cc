@@ -40,9 +40,25 @@
 #include <libint2/config.h>
 
 #include <cmath>
+#include <cstdio>
 
 namespace psi {
 
+namespace {
+
+// Dot product of two collocation rows. The rows are short (local functions of a block),
+// so an inlined vector loop beats a BLAS call per point.
+inline double row_dot(int n, const double* restrict a, const double* restrict b) {
+    double val = 0.0;
+#pragma omp simd reduction(+ : val)
+    for (int m = 0; m < n; m++) {
+        val += a[m] * b[m];
+    }
+    return val;
+}
+
+}  // namespace
+
 SAPFunctions::SAPFunctions(std::shared_ptr<BasisSet> primary, int max_points, int max_functions)
     : PointFunctions(primary, max_points, max_functions) {
     current_basis_map_ = &basis_values_;
@@ -61,13 +77,7 @@ void SAPFunctions::allocate() {
 }
 void SAPFunctions::compute_points(std::shared_ptr<BlockOPoints> block, bool force_compute) {
     // => Build basis function values <= //
-    block_index_ = block->index();
-    if (!force_compute && cache_map_ && (cache_map_->find(block->index()) != cache_map_->end())) {
-        current_basis_map_ = &(*cache_map_)[block->index()];
-    } else {
-        current_basis_map_ = &basis_values_;
-        BasisFunctions::compute_functions(block);
-    }
+    load_basis_values(block, force_compute);
 }
 void SAPFunctions::print(std::string out, int print) const {
     std::shared_ptr<psi::PsiOutStream> printer = (out == "outfile" ? outfile : std::make_shared<PsiOutStream>(out));
@@ -154,13 +164,7 @@ void RKSFunctions::compute_points(std::shared_ptr<BlockOPoints> block, bool forc
     if (!D_AO_) throw PSIEXCEPTION("RKSFunctions: call set_pointers.");
 
     // => Build basis function values <= //
-    block_index_ = block->index();
-    if (!force_compute && cache_map_ && (cache_map_->find(block->index()) != cache_map_->end())) {
-        current_basis_map_ = &(*cache_map_)[block->index()];
-    } else {
-        current_basis_map_ = &basis_values_;
-        BasisFunctions::compute_functions(block);
-    }
+    load_basis_values(block, force_compute);
 
     // => Global information <= //
     int npoints = block->npoints();
@@ -193,12 +197,14 @@ void RKSFunctions::compute_points(std::shared_ptr<BlockOPoints> block, bool forc
 
     // Rho_a = 2.0 * D_xy phi_xa phi_ya
     C_DGEMM('N', 'N', npoints, nlocal, nlocal, 2.0, phip[0], coll_funcs, D2p[0], nglobal, 0.0, Tp[0], nglobal);
-    for (int P = 0; P < npoints; P++) {
-        rhoap[P] = C_DDOT(nlocal, phip[P], 1, Tp[P], 1);
+    if (ansatz_ == 0) {
+        for (int P = 0; P < npoints; P++) {
+            rhoap[P] = row_dot(nlocal, phip[P], Tp[P]);
+        }
     }
 
     // => Build GGA quantities <= //
-    // Rho^l_a = D_xy phi_xa phi^l_ya
+    // Rho^l_a = D_xy phi_xa phi^l_ya, fused with rho so each T row is read once
     if (ansatz_ >= 1) {
         double** phixp = basis_value("PHI_X")->pointer();
         double** phiyp = basis_value("PHI_Y")->pointer();
@@ -209,10 +215,27 @@ void RKSFunctions::compute_points(std::shared_ptr<BlockOPoints> block, bool forc
         double* gammaaap = point_value("GAMMA_AA")->pointer();
 
         for (int P = 0; P < npoints; P++) {
+            const double* restrict phi_P = phip[P];
+            const double* restrict phix_P = phixp[P];
+            const double* restrict phiy_P = phiyp[P];
+            const double* restrict phiz_P = phizp[P];
+            const double* restrict T_P = Tp[P];
+            double rho = 0.0;
+            double rho_x = 0.0;
+            double rho_y = 0.0;
+            double rho_z = 0.0;
+#pragma omp simd reduction(+ : rho, rho_x, rho_y, rho_z)
+            for (int m = 0; m < nlocal; m++) {
+                rho += phi_P[m] * T_P[m];
+                rho_x += phix_P[m] * T_P[m];
+                rho_y += phiy_P[m] * T_P[m];
+                rho_z += phiz_P[m] * T_P[m];
+            }
             // 2.0 for Px D P + P D Px
-            double rho_x = 2.0 * C_DDOT(nlocal, phixp[P], 1, Tp[P], 1);
-            double rho_y = 2.0 * C_DDOT(nlocal, phiyp[P], 1, Tp[P], 1);
-            double rho_z = 2.0 * C_DDOT(nlocal, phizp[P], 1, Tp[P], 1);
+            rho_x *= 2.0;
+            rho_y *= 2.0;
+            rho_z *= 2.0;
+            rhoap[P] = rho;
             rhoaxp[P] = rho_x;
             rhoayp[P] = rho_y;
             rhoazp[P] = rho_z;
@@ -238,7 +261,7 @@ void RKSFunctions::compute_points(std::shared_ptr<BlockOPoints> block, bool forc
             double** phic = phi[x];
             C_DGEMM('N', 'N', npoints, nlocal, nlocal, 1.0, phic[0], coll_funcs, D2p[0], nglobal, 0.0, Tp[0], nglobal);
             for (int P = 0; P < npoints; P++) {
-                taup[P] += C_DDOT(nlocal, phic[P], 1, Tp[P], 1);
+                taup[P] += row_dot(nlocal, phic[P], Tp[P]);
             }
         }
 
@@ -299,13 +322,7 @@ void RKSFunctions::set_Cs(SharedMatrix /*Ca_AO*/, SharedMatrix /*Cb_AO*/) {
 }
 void RKSFunctions::compute_orbitals(std::shared_ptr<BlockOPoints> block, bool force_compute) {
     // => Build basis function values <= //
-    block_index_ = block->index();
-    if (!force_compute && cache_map_ && (cache_map_->find(block->index()) != cache_map_->end())) {
-        current_basis_map_ = &(*cache_map_)[block->index()];
-    } else {
-        current_basis_map_ = &basis_values_;
-        BasisFunctions::compute_functions(block);
-    }
+    load_basis_values(block, force_compute);
     // timer_off("Functions: Points");
 
     // => Global information <= //
@@ -423,13 +440,7 @@ void UKSFunctions::compute_points(std::shared_ptr<BlockOPoints> block, bool forc
     if (!Da_AO_) throw PSIEXCEPTION("UKSFunctions: call set_pointers.");
 
     // => Build basis function values <= //
-    block_index_ = block->index();
-    if (!force_compute && cache_map_ && (cache_map_->find(block->index()) != cache_map_->end())) {
-        current_basis_map_ = &(*cache_map_)[block->index()];
-    } else {
-        current_basis_map_ = &basis_values_;
-        BasisFunctions::compute_functions(block);
-    }
+    load_basis_values(block, force_compute);
 
     // => Global information <= //
     int npoints = block->npoints();
@@ -468,16 +479,26 @@ void UKSFunctions::compute_points(std::shared_ptr<BlockOPoints> block, bool forc
     size_t coll_funcs = basis_value("PHI")->ncol();
 
     C_DGEMM('N', 'N', npoints, nlocal, nlocal, 1.0, phip[0], coll_funcs, Da2p[0], nglobal, 0.0, Tap[0], nglobal);
-    for (int P = 0; P < npoints; P++) {
-        rhoap[P] = C_DDOT(nlocal, phip[P], 1, Tap[P], 1);
-    }
-
     C_DGEMM('N', 'N', npoints, nlocal, nlocal, 1.0, phip[0], coll_funcs, Db2p[0], nglobal, 0.0, Tbp[0], nglobal);
-    for (int P = 0; P < npoints; P++) {
-        rhobp[P] = C_DDOT(nlocal, phip[P], 1, Tbp[P], 1);
+    if (ansatz_ == 0) {
+        for (int P = 0; P < npoints; P++) {
+            const double* restrict phi_P = phip[P];
+            const double* restrict Ta_P = Tap[P];
+            const double* restrict Tb_P = Tbp[P];
+            double rhoa = 0.0;
+            double rhob = 0.0;
+#pragma omp simd reduction(+ : rhoa, rhob)
+            for (int m = 0; m < nlocal; m++) {
+                rhoa += phi_P[m] * Ta_P[m];
+                rhob += phi_P[m] * Tb_P[m];
+            }
+            rhoap[P] = rhoa;
+            rhobp[P] = rhob;
+        }
     }
 
     // => Build GGA quantities <= //
+    // Fused with rho so each phi and T row is read once
     if (ansatz_ >= 1) {
         double** phixp = basis_value("PHI_X")->pointer();
         double** phiyp = basis_value("PHI_Y")->pointer();
@@ -493,13 +514,40 @@ void UKSFunctions::compute_points(std::shared_ptr<BlockOPoints> block, bool forc
         double* gammabbp = point_value("GAMMA_BB")->pointer();
 
         for (int P = 0; P < npoints; P++) {
+            const double* restrict phi_P = phip[P];
+            const double* restrict phix_P = phixp[P];
+            const double* restrict phiy_P = phiyp[P];
+            const double* restrict phiz_P = phizp[P];
+            const double* restrict Ta_P = Tap[P];
+            const double* restrict Tb_P = Tbp[P];
+            double rhoa = 0.0;
+            double rhob = 0.0;
+            double rhoa_x = 0.0;
+            double rhoa_y = 0.0;
+            double rhoa_z = 0.0;
+            double rhob_x = 0.0;
+            double rhob_y = 0.0;
+            double rhob_z = 0.0;
+#pragma omp simd reduction(+ : rhoa, rhob, rhoa_x, rhoa_y, rhoa_z, rhob_x, rhob_y, rhob_z)
+            for (int m = 0; m < nlocal; m++) {
+                rhoa += phi_P[m] * Ta_P[m];
+                rhob += phi_P[m] * Tb_P[m];
+                rhoa_x += phix_P[m] * Ta_P[m];
+                rhoa_y += phiy_P[m] * Ta_P[m];
+                rhoa_z += phiz_P[m] * Ta_P[m];
+                rhob_x += phix_P[m] * Tb_P[m];
+                rhob_y += phiy_P[m] * Tb_P[m];
+                rhob_z += phiz_P[m] * Tb_P[m];
+            }
             // 2.0 for Px D P + P D Px
-            double rhoa_x = 2.0 * C_DDOT(nlocal, phixp[P], 1, Tap[P], 1);
-            double rhoa_y = 2.0 * C_DDOT(nlocal, phiyp[P], 1, Tap[P], 1);
-            double rhoa_z = 2.0 * C_DDOT(nlocal, phizp[P], 1, Tap[P], 1);
-            double rhob_x = 2.0 * C_DDOT(nlocal, phixp[P], 1, Tbp[P], 1);
-            double rhob_y = 2.0 * C_DDOT(nlocal, phiyp[P], 1, Tbp[P], 1);
-            double rhob_z = 2.0 * C_DDOT(nlocal, phizp[P], 1, Tbp[P], 1);
+            rhoa_x *= 2.0;
+            rhoa_y *= 2.0;
+            rhoa_z *= 2.0;
+            rhob_x *= 2.0;
+            rhob_y *= 2.0;
+            rhob_z *= 2.0;
+            rhoap[P] = rhoa;
+            rhobp[P] = rhob;
             rhoaxp[P] = rhoa_x;
             rhoayp[P] = rhoa_y;
             rhoazp[P] = rhoa_z;
@@ -549,7 +597,7 @@ void UKSFunctions::compute_points(std::shared_ptr<BlockOPoints> block, bool forc
                 C_DGEMM('N', 'N', npoints, nlocal, nlocal, 1.0, phic[0], coll_funcs, Dc[0], nglobal, 0.0, Tc[0],
                         nglobal);
                 for (int P = 0; P < npoints; P++) {
-                    tauc[P] += 0.5 * C_DDOT(nlocal, phic[P], 1, Tc[P], 1);
+                    tauc[P] += 0.5 * row_dot(nlocal, phic[P], Tc[P]);
                 }
             }
         }
@@ -569,13 +617,7 @@ void UKSFunctions::set_Cs(SharedMatrix Ca_AO, SharedMatrix Cb_AO) {
 }
 void UKSFunctions::compute_orbitals(std::shared_ptr<BlockOPoints> block, bool force_compute) {
     // => Build basis function values <= //
-    block_index_ = block->index();
-    if (!force_compute && cache_map_ && (cache_map_->find(block->index()) != cache_map_->end())) {
-        current_basis_map_ = &(*cache_map_)[block->index()];
-    } else {
-        current_basis_map_ = &basis_values_;
-        BasisFunctions::compute_functions(block);
-    }
+    load_basis_values(block, force_compute);
 
     // => Global information <= //
 
@@ -644,10 +686,151 @@ PointFunctions::PointFunctions(std::shared_ptr<BasisSet> primary, int max_points
     set_ansatz(0);
 }
 PointFunctions::~PointFunctions() {}
+void PointFunctions::load_basis_values(std::shared_ptr<BlockOPoints> block, bool force_compute) {
+    block_index_ = block->index();
+    current_basis_map_ = &basis_values_;
+    if (!force_compute && cache_map_) {
+        auto* full = cache_map_->full_block(block_index_);
+        if (full) {
+            current_basis_map_ = full;
+            return;
+        }
+        if (cache_map_->unpack(block_index_, basis_values_)) return;
+    }
+    BasisFunctions::compute_functions(block);
+}
 SharedVector PointFunctions::point_value(const std::string& key) { return point_values_[key]; }
 
 SharedMatrix PointFunctions::orbital_value(const std::string& key) { return orbital_values_[key]; }
 
+CollocationCache::~CollocationCache() { clear(); }
+void CollocationCache::clear() {
+    full_.clear();
+    packed_.clear();
+    if (disk_file_) {
+        std::fclose(disk_file_);
+        std::remove(disk_filename_.c_str());
+        disk_file_ = nullptr;
+    }
+}
+void CollocationCache::open_disk(const std::string& filename, bool single) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (disk_file_) throw PSIEXCEPTION("CollocationCache: scratch file is already open.");
+    disk_filename_ = filename;
+    disk_single_ = single;
+    disk_file_ = std::fopen(disk_filename_.c_str(), "wb+");
+    if (!disk_file_) throw PSIEXCEPTION("CollocationCache: unable to open scratch file " + disk_filename_);
+}
+void CollocationCache::store(size_t index, Tier tier, const std::map<std::string, SharedMatrix>& values,
+                             size_t npoints, size_t nbf, size_t disk_offset) {
+    if (tier == Tier::Full) {
+        std::map<std::string, SharedMatrix> block;
+        for (const auto& kv : values) {
+            auto coll = std::make_shared<Matrix>(kv.second->name(), npoints, nbf);
+            double** sourcep = kv.second->pointer();
+            double** collp = coll->pointer();
+            // Matrices are packed in a upper left rectangle, cannot use pure DCOPY
+            for (size_t i = 0; i < npoints; i++) {
+                C_DCOPY(nbf, sourcep[i], 1, collp[i], 1);
+            }
+            block[kv.first] = coll;
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        full_[index] = block;
+        return;
+    }
+
+    PackedBlock block;
+    block.tier = tier;
+    block.npoints = npoints;
+    block.nbf = nbf;
+    block.disk_offset = disk_offset;
+    for (const auto& kv : values) block.keys.push_back(kv.first);
+
+    size_t nvalues = values.size() * npoints * nbf;
+    if (tier == Tier::Compressed || disk_single_) {
+        block.values.resize(nvalues);
+        float* valp = block.values.data();
+        for (const auto& kv : values) {
+            double** sourcep = kv.second->pointer();
+            for (size_t i = 0; i < npoints; i++) {
+                for (size_t j = 0; j < nbf; j++) *valp++ = (float)sourcep[i][j];
+            }
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (tier == Tier::Disk) {
+        if (!disk_file_) throw PSIEXCEPTION("CollocationCache: no scratch file open for the disk tier.");
+        size_t ndata = disk_single_ ? sizeof(float) : sizeof(double);
+        std::fseek(disk_file_, disk_offset * ndata, SEEK_SET);
+        if (disk_single_) {
+            std::fwrite(block.values.data(), sizeof(float), nvalues, disk_file_);
+        } else {
+            for (const auto& kv : values) {
+                double** sourcep = kv.second->pointer();
+                for (size_t i = 0; i < npoints; i++) std::fwrite(sourcep[i], sizeof(double), nbf, disk_file_);
+            }
+        }
+        block.values.clear();
+        block.values.shrink_to_fit();
+    }
+    packed_[index] = std::move(block);
+}
+std::map<std::string, SharedMatrix>* CollocationCache::full_block(size_t index) {
+    auto it = full_.find(index);
+    return (it == full_.end() ? nullptr : &it->second);
+}
+bool CollocationCache::unpack(size_t index, std::map<std::string, SharedMatrix>& values) {
+    auto it = packed_.find(index);
+    if (it == packed_.end()) return false;
+    const PackedBlock& block = it->second;
+    size_t npoints = block.npoints;
+    size_t nbf = block.nbf;
+
+    if (block.tier == Tier::Compressed) {
+        const float* valp = block.values.data();
+        for (const auto& key : block.keys) {
+            // The cache may hold higher derivatives than this worker computes
+            auto target = values.find(key);
+            if (target == values.end()) {
+                valp += npoints * nbf;
+                continue;
+            }
+            double** targetp = target->second->pointer();
+            for (size_t i = 0; i < npoints; i++) {
+                for (size_t j = 0; j < nbf; j++) targetp[i][j] = (double)*valp++;
+            }
+        }
+        return true;
+    }
+
+    // Disk tier, reads are serialized on the one file handle
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t ndata = disk_single_ ? sizeof(float) : sizeof(double);
+    std::fseek(disk_file_, block.disk_offset * ndata, SEEK_SET);
+    std::vector<float> buffer(disk_single_ ? nbf : 0);
+    for (const auto& key : block.keys) {
+        auto target = values.find(key);
+        if (target == values.end()) {
+            std::fseek(disk_file_, npoints * nbf * ndata, SEEK_CUR);
+            continue;
+        }
+        double** targetp = target->second->pointer();
+        for (size_t i = 0; i < npoints; i++) {
+            size_t nread = 0;
+            if (disk_single_) {
+                nread = std::fread(buffer.data(), sizeof(float), nbf, disk_file_);
+                for (size_t j = 0; j < nbf; j++) targetp[i][j] = (double)buffer[j];
+            } else {
+                nread = std::fread(targetp[i], sizeof(double), nbf, disk_file_);
+            }
+            if (nread != nbf) throw PSIEXCEPTION("CollocationCache: short read from scratch file " + disk_filename_);
+        }
+    }
+    return true;
+}
+
 BasisFunctions::BasisFunctions(std::shared_ptr<BasisSet> primary, int max_points, int max_functions)
     : primary_(primary), max_points_(max_points), max_functions_(max_functions) {
     
@@ -691,7 +874,30 @@ void BasisFunctions::allocate() {
         basis_temps_["PHI_ZZ"] = std::make_shared<Matrix>("PHI_ZZ", max_points_, max_functions_);
     }
 
-    if (deriv_ >= 3) throw PSIEXCEPTION("BasisFunctions: Only up to Hessians are currently supported");
+    if (deriv_ >= 3) {
+        basis_values_["PHI_XXX"] = std::make_shared<Matrix>("PHI_XXX", max_points_, max_functions_);
+        basis_values_["PHI_XXY"] = std::make_shared<Matrix>("PHI_XXY", max_points_, max_functions_);
+        basis_values_["PHI_XXZ"] = std::make_shared<Matrix>("PHI_XXZ", max_points_, max_functions_);
+        basis_values_["PHI_XYY"] = std::make_shared<Matrix>("PHI_XYY", max_points_, max_functions_);
+        basis_values_["PHI_XYZ"] = std::make_shared<Matrix>("PHI_XYZ", max_points_, max_functions_);
+        basis_values_["PHI_XZZ"] = std::make_shared<Matrix>("PHI_XZZ", max_points_, max_functions_);
+        basis_values_["PHI_YYY"] = std::make_shared<Matrix>("PHI_YYY", max_points_, max_functions_);
+        basis_values_["PHI_YYZ"] = std::make_shared<Matrix>("PHI_YYZ", max_points_, max_functions_);
+        basis_values_["PHI_YZZ"] = std::make_shared<Matrix>("PHI_YZZ", max_points_, max_functions_);
+        basis_values_["PHI_ZZZ"] = std::make_shared<Matrix>("PHI_ZZZ", max_points_, max_functions_);
+        basis_temps_["PHI_XXX"] = std::make_shared<Matrix>("PHI_XXX", max_points_, max_functions_);
+        basis_temps_["PHI_XXY"] = std::make_shared<Matrix>("PHI_XXY", max_points_, max_functions_);
+        basis_temps_["PHI_XXZ"] = std::make_shared<Matrix>("PHI_XXZ", max_points_, max_functions_);
+        basis_temps_["PHI_XYY"] = std::make_shared<Matrix>("PHI_XYY", max_points_, max_functions_);
+        basis_temps_["PHI_XYZ"] = std::make_shared<Matrix>("PHI_XYZ", max_points_, max_functions_);
+        basis_temps_["PHI_XZZ"] = std::make_shared<Matrix>("PHI_XZZ", max_points_, max_functions_);
+        basis_temps_["PHI_YYY"] = std::make_shared<Matrix>("PHI_YYY", max_points_, max_functions_);
+        basis_temps_["PHI_YYZ"] = std::make_shared<Matrix>("PHI_YYZ", max_points_, max_functions_);
+        basis_temps_["PHI_YZZ"] = std::make_shared<Matrix>("PHI_YZZ", max_points_, max_functions_);
+        basis_temps_["PHI_ZZZ"] = std::make_shared<Matrix>("PHI_ZZZ", max_points_, max_functions_);
+    }
+
+    if (deriv_ >= 4) throw PSIEXCEPTION("BasisFunctions: Only up to third derivatives are currently supported");
 }
 void BasisFunctions::compute_functions(std::shared_ptr<BlockOPoints> block) {
     // Pull out data
@@ -714,6 +920,9 @@ void BasisFunctions::compute_functions(std::shared_ptr<BlockOPoints> block) {
     double *tmp_xxp, *tmp_xyp, *tmp_xzp, *tmp_yyp, *tmp_yzp, *tmp_zzp;
     double *valuesp, *values_xp, *values_yp, *values_zp;
     double *values_xxp, *values_xyp, *values_xzp, *values_yyp, *values_yzp, *values_zzp;
+    double *tmp_xxxp, *tmp_xxyp, *tmp_xxzp, *tmp_xyyp, *tmp_xyzp, *tmp_xzzp, *tmp_yyyp, *tmp_yyzp, *tmp_yzzp, *tmp_zzzp;
+    double *values_xxxp, *values_xxyp, *values_xxzp, *values_xyyp, *values_xyzp, *values_xzzp, *values_yyyp,
+        *values_yyzp, *values_yzzp, *values_zzzp;
 
     if (deriv_ >= 0) {
         tmpp = basis_temps_["PHI"]->pointer()[0];
@@ -741,6 +950,28 @@ void BasisFunctions::compute_functions(std::shared_ptr<BlockOPoints> block) {
         values_yzp = basis_values_["PHI_YZ"]->pointer()[0];
         values_zzp = basis_values_["PHI_ZZ"]->pointer()[0];
     }
+    if (deriv_ >= 3) {
+        tmp_xxxp = basis_temps_["PHI_XXX"]->pointer()[0];
+        tmp_xxyp = basis_temps_["PHI_XXY"]->pointer()[0];
+        tmp_xxzp = basis_temps_["PHI_XXZ"]->pointer()[0];
+        tmp_xyyp = basis_temps_["PHI_XYY"]->pointer()[0];
+        tmp_xyzp = basis_temps_["PHI_XYZ"]->pointer()[0];
+        tmp_xzzp = basis_temps_["PHI_XZZ"]->pointer()[0];
+        tmp_yyyp = basis_temps_["PHI_YYY"]->pointer()[0];
+        tmp_yyzp = basis_temps_["PHI_YYZ"]->pointer()[0];
+        tmp_yzzp = basis_temps_["PHI_YZZ"]->pointer()[0];
+        tmp_zzzp = basis_temps_["PHI_ZZZ"]->pointer()[0];
+        values_xxxp = basis_values_["PHI_XXX"]->pointer()[0];
+        values_xxyp = basis_values_["PHI_XXY"]->pointer()[0];
+        values_xxzp = basis_values_["PHI_XXZ"]->pointer()[0];
+        values_xyyp = basis_values_["PHI_XYY"]->pointer()[0];
+        values_xyzp = basis_values_["PHI_XYZ"]->pointer()[0];
+        values_xzzp = basis_values_["PHI_XZZ"]->pointer()[0];
+        values_yyyp = basis_values_["PHI_YYY"]->pointer()[0];
+        values_yyzp = basis_values_["PHI_YYZ"]->pointer()[0];
+        values_yzzp = basis_values_["PHI_YZZ"]->pointer()[0];
+        values_zzzp = basis_values_["PHI_ZZZ"]->pointer()[0];
+    }
 
     int nvals = 0;
     for (size_t Qlocal = 0; Qlocal < shells.size(); Qlocal++) {
@@ -792,6 +1023,15 @@ void BasisFunctions::compute_functions(std::shared_ptr<BlockOPoints> block) {
             gg_collocation_deriv2(L, npoints, xyz.data(), 1, nprim, norm, alpha, center.data(), order, phi_start,
                                   phi_x_start, phi_y_start, phi_z_start, phi_xx_start, phi_xy_start, phi_xz_start,
                                   phi_yy_start, phi_yz_start, phi_zz_start);
+        } else if (deriv_ == 3) {
+            gg_collocation_deriv3(L, npoints, xyz.data(), 1, nprim, norm, alpha, center.data(), order, phi_start,
+                                  tmp_xp + row_shift, tmp_yp + row_shift, tmp_zp + row_shift,
+                                  tmp_xxp + row_shift, tmp_xyp + row_shift, tmp_xzp + row_shift,
+                                  tmp_yyp + row_shift, tmp_yzp + row_shift, tmp_zzp + row_shift,
+                                  tmp_xxxp + row_shift, tmp_xxyp + row_shift, tmp_xxzp + row_shift,
+                                  tmp_xyyp + row_shift, tmp_xyzp + row_shift, tmp_xzzp + row_shift,
+                                  tmp_yyyp + row_shift, tmp_yyzp + row_shift, tmp_yzzp + row_shift,
+                                  tmp_zzzp + row_shift);
         }
 
         if (puream_) {
@@ -817,6 +1057,18 @@ void BasisFunctions::compute_functions(std::shared_ptr<BlockOPoints> block) {
         gg_fast_transpose(nso, npoints, tmp_yzp, values_yzp);
         gg_fast_transpose(nso, npoints, tmp_zzp, values_zzp);
     }
+    if (deriv_ >= 3) {
+        gg_fast_transpose(nso, npoints, tmp_xxxp, values_xxxp);
+        gg_fast_transpose(nso, npoints, tmp_xxyp, values_xxyp);
+        gg_fast_transpose(nso, npoints, tmp_xxzp, values_xxzp);
+        gg_fast_transpose(nso, npoints, tmp_xyyp, values_xyyp);
+        gg_fast_transpose(nso, npoints, tmp_xyzp, values_xyzp);
+        gg_fast_transpose(nso, npoints, tmp_xzzp, values_xzzp);
+        gg_fast_transpose(nso, npoints, tmp_yyyp, values_yyyp);
+        gg_fast_transpose(nso, npoints, tmp_yyzp, values_yyzp);
+        gg_fast_transpose(nso, npoints, tmp_yzzp, values_yzzp);
+        gg_fast_transpose(nso, npoints, tmp_zzzp, values_zzzp);
+    }
 }
 void BasisFunctions::print(std::string out, int print) const {
     std::shared_ptr<psi::PsiOutStream> printer = (out == "outfile" ? outfile : std::make_shared<PsiOutStream>(out));
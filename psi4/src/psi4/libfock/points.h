@@ -34,6 +34,7 @@
 
 #include <cstdio>
 #include <map>
+#include <mutex>
 #include <unordered_map>
 #include <tuple>
 #include <vector>
@@ -103,6 +104,59 @@ class PSI_API BasisFunctions {
     }
 };
 
+/**
+ * Collocation blocks (basis function values and derivatives) kept across SCF iterations.
+ *
+ * Blocks are held in one of three tiers: full precision in memory, single precision in
+ * memory, or in a scratch file (in the precision of the in-memory tier). Full precision
+ * blocks are used in place; the other tiers are unpacked into the caller's buffers.
+ **/
+class PSI_API CollocationCache {
+   public:
+    enum class Tier { Full, Compressed, Disk };
+
+   protected:
+    struct PackedBlock {
+        Tier tier;
+        size_t npoints;
+        size_t nbf;
+        std::vector<std::string> keys;
+        std::vector<float> values;
+        size_t disk_offset;
+    };
+    /// Full precision blocks, by block index
+    std::unordered_map<size_t, std::map<std::string, SharedMatrix>> full_;
+    /// Single precision and disk blocks, by block index
+    std::unordered_map<size_t, PackedBlock> packed_;
+    /// Store the disk tier in single precision?
+    bool disk_single_ = false;
+    /// Scratch file for the disk tier
+    std::string disk_filename_;
+    std::FILE* disk_file_ = nullptr;
+    /// Guards the maps while storing and the scratch file
+    std::mutex mutex_;
+
+   public:
+    CollocationCache() = default;
+    ~CollocationCache();
+
+    /// Drops every block and removes the scratch file
+    void clear();
+    size_t nblocks() const { return full_.size() + packed_.size(); }
+
+    /// Opens the scratch file used by the disk tier
+    void open_disk(const std::string& filename, bool single);
+
+    /// Stores the leading npoints x nbf block of values under block index
+    void store(size_t index, Tier tier, const std::map<std::string, SharedMatrix>& values, size_t npoints,
+               size_t nbf, size_t disk_offset = 0);
+
+    /// Full precision block index, or nullptr
+    std::map<std::string, SharedMatrix>* full_block(size_t index);
+    /// Unpacks a compressed or disk block into values. Returns false if the block is not held in those tiers.
+    bool unpack(size_t index, std::map<std::string, SharedMatrix>& values);
+};
+
 class PointFunctions : public BasisFunctions {
    protected:
     // => Indices <= //
@@ -111,7 +165,7 @@ class PointFunctions : public BasisFunctions {
     size_t block_index_;
 
     // Contains a map to the cache the global basis_values
-    std::unordered_map<size_t, std::map<std::string, SharedMatrix>>* cache_map_ = nullptr;
+    CollocationCache* cache_map_ = nullptr;
 
     // Contains a pointer to the current map to use for basis_values
     std::map<std::string, SharedMatrix>* current_basis_map_ = nullptr;
@@ -126,6 +180,9 @@ class PointFunctions : public BasisFunctions {
     /// Map of value names to Matrices containing values
     std::map<std::string, std::shared_ptr<Matrix>> orbital_values_;
 
+    /// Point current_basis_map_ at the basis function values of block, from the cache if allowed
+    void load_basis_values(std::shared_ptr<BlockOPoints> block, bool force_compute);
+
    public:
     // => Constructors <= //
 
@@ -133,9 +190,7 @@ class PointFunctions : public BasisFunctions {
     ~PointFunctions() override;
 
     // => Setters <= //
-    void set_cache_map(std::unordered_map<size_t, std::map<std::string, SharedMatrix>>* cache_map) {
-        cache_map_ = cache_map;
-    }
+    void set_cache_map(CollocationCache* cache_map) { cache_map_ = cache_map; }
 
     // => Computers <= //
     /// Compute needed DFT intermediates, e.g. rho, gamma, at the points in block.
@@ -296,9 +351,7 @@ class UKSFunctions : public PointFunctions {
 
     void set_pointers(SharedMatrix Da_occ_AO) override;
     void set_pointers(SharedMatrix Da_occ_AO, SharedMatrix Db_occ_AO) override;
-    void set_cache_map(std::unordered_map<size_t, std::map<std::string, SharedMatrix>>* cache_map) {
-        cache_map_ = cache_map;
-    }
+    void set_cache_map(CollocationCache* cache_map) { cache_map_ = cache_map; }
 
     /// Compute the needed DFT intermediates at the points in the block.
     /// "Which DFT intermediates are needed?" is determined from ansatz_.
@@ -30,6 +30,8 @@
 #include "sap.h"
 #include <stddef.h>
 
+#include <vector>
+
 /* Number of elements supported by the implementation + 1 */
 #define SAP_NELEM 119
 /* Radial points in the table */
@@ -42,9 +44,8 @@ order schemes may result in instabilities */
 /* Returns the cutoff radius in bohr */
 double sap_cutoff_radius() { return 3.99999995751228e+01; }
 
-/* Return the effective charge at radius x */
-double sap_effective_charge(int Z, double x) {
-    static const double Zeff[SAP_NELEM][SAP_NRAD] = {
+/* Effective charges of the elements, the first row holds the radial grid */
+static const double Zeff[SAP_NELEM][SAP_NRAD] = {
         {0.00000000000000e+00, 7.74564534039568e-10, 2.47256327461087e-08, 1.86997862087340e-07, 7.83531011839395e-07,
          2.37369448442132e-06, 5.85385578447464e-06, 1.25192693640128e-05, 2.41120079015646e-05, 4.28530598081574e-05,
          7.14571735608571e-05, 1.13129528705579e-04, 1.71543841230856e-04, 2.50802052874775e-04, 3.55376294767219e-04,
@@ -18976,6 +18977,9 @@ double sap_effective_charge(int Z, double x) {
          5.68434188608080e-14, 7.10542735760100e-14, 5.68434188608080e-14, 5.68434188608080e-14, 5.68434188608080e-14,
          5.68434188608080e-14, 5.68434188608080e-14, 4.26325641456060e-14, 7.10542735760100e-14, 5.68434188608080e-14,
          5.68434188608080e-14}};
+
+/* Return the effective charge at radius x */
+double sap_effective_charge(int Z, double x) {
     /* Array lookup */
     {
         /* Table lookup helpers */
@@ -19042,3 +19046,50 @@ double sap_effective_charge(int Z, double x) {
         }
     }
 }
+
+/* Number of equal slices of the radial grid in the lookup index */
+#define SAP_NBUCKET 4096
+
+void sap_effective_charges(int Z, size_t n, const double *x, double *Zeff_x) {
+    /* Last radial grid point below the start of every slice, built once */
+    static const std::vector<size_t> bucket_start = [] {
+        std::vector<size_t> start(SAP_NBUCKET);
+        size_t pos = 0;
+        for (size_t b = 0; b < SAP_NBUCKET; b++) {
+            double xb = b * (Zeff[0][SAP_NRAD - 1] / SAP_NBUCKET);
+            while (pos + 2 < SAP_NRAD && Zeff[0][pos + 1] < xb) pos++;
+            start[b] = pos;
+        }
+        return start;
+    }();
+    const double xmax = Zeff[0][SAP_NRAD - 1];
+
+    /* Sanity check nucleus */
+    if (Z < 1 || Z >= SAP_NELEM) {
+        for (size_t ip = 0; ip < n; ip++) Zeff_x[ip] = 0.0;
+        return;
+    }
+
+    for (size_t ip = 0; ip < n; ip++) {
+        double xp = x[ip];
+        /* Sanity check for radius */
+        if (xp <= 0.0) {
+            Zeff_x[ip] = Zeff[Z][0];
+            continue;
+        }
+        if (xp >= xmax) {
+            Zeff_x[ip] = Zeff[Z][SAP_NRAD - 1];
+            continue;
+        }
+
+        /* Start from the slice of the grid and scan to the interval holding xp */
+        size_t b = (size_t)(xp * (SAP_NBUCKET / xmax));
+        if (b >= SAP_NBUCKET) b = SAP_NBUCKET - 1;
+        size_t pos = bucket_start[b];
+        while (pos + 2 < SAP_NRAD && Zeff[0][pos + 1] < xp) pos++;
+
+        /* Linear Lagrange interpolation, as in sap_effective_charge */
+        double x0 = Zeff[0][pos], x1 = Zeff[0][pos + 1];
+        Zeff_x[ip] = Zeff[Z][pos] * (xp - x1) / (x0 - x1) + Zeff[Z][pos + 1] * (xp - x0) / (x1 - x0);
+    }
+}
@@ -29,6 +29,9 @@
 
 #ifndef SAP_POTENTIAL
 #define SAP_POTENTIAL
+
+#include <stddef.h>
+
 /*
   Routines for the implementation of the superposition of atomic
   potentials guess for electronic structure calculations, see
@@ -49,4 +52,11 @@
   DOI: 10.1002/qua.25945
 */
 double sap_effective_charge(int Z, double r);
+
+/*
+  Evaluates sap_effective_charge(Z, r[i]) for n radii into Zeff. The
+  interval of the radial grid is found through a precomputed index over
+  equal slices of the grid instead of a binary search per radius.
+*/
+void sap_effective_charges(int Z, size_t n, const double* r, double* Zeff);
 #endif
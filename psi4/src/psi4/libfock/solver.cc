@@ -71,6 +71,7 @@ RSolver::~RSolver() {}
 
 CGRSolver::CGRSolver(std::shared_ptr<RHamiltonian> H) : RSolver(H) {
     nguess_ = 0;
+    block_ = false;
     name_ = "CGR";
 }
 CGRSolver::~CGRSolver() {}
@@ -104,6 +105,9 @@ std::shared_ptr<CGRSolver> CGRSolver::build_solver(Options& options, std::shared
     if (options["SOLVER_N_GUESS"].has_changed()) {
         solver->set_nguess(options.get_int("SOLVER_N_GUESS"));
     }
+    if (options["SOLVER_BLOCK_CG"].has_changed()) {
+        solver->set_block(options.get_bool("SOLVER_BLOCK_CG"));
+    }
 
     return solver;
 }
@@ -112,6 +116,7 @@ void CGRSolver::print_header() const {
         outfile->Printf("  ==> CGRSolver (by Rob Parrish) <==\n\n");
         outfile->Printf("   Number of roots    = %9zu\n", b_.size());
         outfile->Printf("   Preconditioning    = %9s\n", precondition_.c_str());
+        outfile->Printf("   Block CG           = %9s\n", (block_ ? "YES" : "NO"));
         outfile->Printf("   Convergence cutoff = %9.0E\n", criteria_);
         outfile->Printf("   Maximum iterations = %9d\n\n", maxiter_);
     }
@@ -122,7 +127,7 @@ size_t CGRSolver::memory_estimate() {
     for (int h = 0; h < diag_->nirrep(); h++) {
         dimension += diag_->dimpi()[h];
     }
-    return (6L * b_.size()) * dimension;
+    return ((block_ ? 7L : 6L) * b_.size()) * dimension;
 }
 void CGRSolver::initialize() {
     finalize();
@@ -175,17 +180,25 @@ void CGRSolver::solve() {
         iteration_++;
 
         products_p();
-        alpha();
-        update_x();
-        update_r();
+        if (block_) {
+            block_update_xr();
+        } else {
+            alpha();
+            update_x();
+            update_r();
+        }
         check_convergence();
         if (print_) {
             outfile->Printf("  %-10s %4d %10d %10zu %11.3E\n", name_.c_str(), iteration_, nconverged_,
                             b_.size() - nconverged_, convergence_);
         }
         update_z();
-        beta();
-        update_p();
+        if (block_) {
+            block_update_p();
+        } else {
+            beta();
+            update_p();
+        }
 
     } while (iteration_ < maxiter_ && !converged_);
 
@@ -208,6 +221,8 @@ void CGRSolver::finalize() {
     r_nrm2_.clear();
     z_r_.clear();
     r_converged_.clear();
+    block_inds_.clear();
+    block_PAP_inv_.reset();
     diag_.reset();
 }
 void CGRSolver::setup() {
@@ -218,15 +233,31 @@ void CGRSolver::setup() {
         }
     }
 
+    // Mixing right-hand sides is only valid if they share one operator (H - m I) in each irrep
+    if (block_) {
+        for (int h = 0; h < diag_->nirrep(); h++) {
+            for (size_t N = 1; N < b_.size(); N++) {
+                if (shifts_[h][N] != shifts_[h][0]) block_ = false;
+            }
+        }
+        if (!block_ && print_) {
+            outfile->Printf("  Block CG requires equal shifts within each irrep, falling back to CG.\n\n");
+        }
+    }
+
+    block_inds_.clear();
+    for (size_t N = 0; N < b_.size(); N++) {
+        block_inds_.push_back(N);
+    }
 }
 void CGRSolver::guess() {
     for (size_t N = 0; N < b_.size(); ++N) {
         for (int h = 0; h < b_[N]->nirrep(); ++h) {
             int n = b_[N]->dimpi()[h];
             if (!n) continue;
-            auto bp = b_[N]->pointer();
-            auto xp = x_[N]->pointer();
-            auto dp = diag_->pointer();
+            auto bp = b_[N]->pointer(h);
+            auto xp = x_[N]->pointer(h);
+            auto dp = diag_->pointer(h);
             if (precondition_ == "JACOBI") {
                 double lambda = shifts_[h][N];
                 for (int i = 0; i < n; ++i) {
@@ -406,9 +437,9 @@ void CGRSolver::update_z() {
         for (int h = 0; h < b_[N]->nirrep(); ++h) {
             int n = b_[N]->dimpi()[h];
             if (!n) continue;
-            double* zp = z_[N]->pointer();
-            double* rp = r_[N]->pointer();
-            double* dp = diag_->pointer();
+            double* zp = z_[N]->pointer(h);
+            double* rp = r_[N]->pointer(h);
+            double* dp = diag_->pointer(h);
             if (precondition_ == "JACOBI") {
                 double lambda = shifts_[h][N];
                 for (int i = 0; i < n; ++i) {
@@ -436,8 +467,8 @@ void CGRSolver::beta() {
         for (int h = 0; h < b_[N]->nirrep(); ++h) {
             int n = b_[N]->dimpi()[h];
             if (!n) continue;
-            double* rp = r_[N]->pointer();
-            double* zp = z_[N]->pointer();
+            double* rp = r_[N]->pointer(h);
+            double* zp = z_[N]->pointer(h);
             zr += C_DDOT(n, rp, 1, zp, 1);
         }
         beta_[N] = zr / z_r_[N];
@@ -464,4 +495,125 @@ void CGRSolver::update_p() {
         }
     }
 }
+void CGRSolver::block_update_xr() {
+    // The operator is block diagonal in the irreps, so the Galerkin conditions
+    // P'(b - Ax) = 0 are solved independently in each irrep:
+    //  alpha = (P'AP)^-1 P'r, x += P alpha, r -= AP alpha
+    int nirrep = diag_->nirrep();
+    int nblock = block_inds_.size();
+    Dimension blockpi(nirrep);
+    for (int h = 0; h < nirrep; h++) blockpi[h] = nblock;
+
+    block_PAP_inv_ = std::make_shared<Matrix>("(P'AP)^-1", blockpi, blockpi);
+    auto Pr = std::make_shared<Matrix>("P'r", blockpi, blockpi);
+
+    for (int h = 0; h < nirrep; h++) {
+        int n = diag_->dimpi()[h];
+        if (!n) continue;
+        double** Gp = block_PAP_inv_->pointer(h);
+        double** Prp = Pr->pointer(h);
+        for (int M = 0; M < nblock; M++) {
+            double* pp = p_[block_inds_[M]]->pointer(h);
+            for (int K = 0; K < nblock; K++) {
+                Gp[M][K] = C_DDOT(n, pp, 1, Ap_[block_inds_[K]]->pointer(h), 1);
+                Prp[M][K] = C_DDOT(n, pp, 1, r_[block_inds_[K]]->pointer(h), 1);
+            }
+        }
+        // Symmetrize, P'AP is only symmetric up to roundoff
+        for (int M = 0; M < nblock; M++) {
+            for (int K = 0; K < M; K++) {
+                Gp[M][K] = Gp[K][M] = 0.5 * (Gp[M][K] + Gp[K][M]);
+            }
+        }
+    }
+
+    // Right-hand sides of another symmetry leave zero rows/columns, the pseudoinverse drops them
+    block_PAP_inv_->power(-1.0, 1.0E-12);
+    auto alpha = linalg::doublet(block_PAP_inv_, Pr, false, false);
+
+    for (int h = 0; h < nirrep; h++) {
+        int n = diag_->dimpi()[h];
+        if (!n) continue;
+        double** ap = alpha->pointer(h);
+        for (int N = 0; N < nblock; N++) {
+            double* xp = x_[block_inds_[N]]->pointer(h);
+            double* rp = r_[block_inds_[N]]->pointer(h);
+            for (int M = 0; M < nblock; M++) {
+                if (ap[M][N] == 0.0) continue;
+                C_DAXPY(n, ap[M][N], p_[block_inds_[M]]->pointer(h), 1, xp, 1);
+                C_DAXPY(n, -ap[M][N], Ap_[block_inds_[M]]->pointer(h), 1, rp, 1);
+            }
+        }
+    }
+
+    if (debug_) {
+        outfile->Printf("  > Block update x/r <\n\n");
+        alpha->print();
+    }
+}
+void CGRSolver::block_update_p() {
+    // Converged right-hand sides leave the block, so they cost no further products:
+    //  beta = -(P'AP)^-1 (AP)'z, p_new = z + P beta
+    int nirrep = diag_->nirrep();
+    int nold = block_inds_.size();
+
+    std::vector<size_t> active;
+    for (size_t N = 0; N < b_.size(); ++N) {
+        if (!r_converged_[N]) active.push_back(N);
+    }
+    int nnew = active.size();
+    if (!nnew) {
+        block_inds_.clear();
+        return;
+    }
+
+    Dimension oldpi(nirrep);
+    Dimension newpi(nirrep);
+    for (int h = 0; h < nirrep; h++) {
+        oldpi[h] = nold;
+        newpi[h] = nnew;
+    }
+
+    auto APz = std::make_shared<Matrix>("(AP)'z", oldpi, newpi);
+    for (int h = 0; h < nirrep; h++) {
+        int n = diag_->dimpi()[h];
+        if (!n) continue;
+        double** APzp = APz->pointer(h);
+        for (int M = 0; M < nold; M++) {
+            double* App = Ap_[block_inds_[M]]->pointer(h);
+            for (int N = 0; N < nnew; N++) {
+                APzp[M][N] = C_DDOT(n, App, 1, z_[active[N]]->pointer(h), 1);
+            }
+        }
+    }
+    auto beta = linalg::doublet(block_PAP_inv_, APz, false, false);
+    beta->scale(-1.0);
+
+    // The old directions are still needed while the new ones are formed
+    std::vector<SharedVector> p_old;
+    for (int M = 0; M < nold; M++) {
+        p_old.push_back(std::make_shared<Vector>(*p_[block_inds_[M]]));
+    }
+
+    for (int N = 0; N < nnew; N++) {
+        auto pN = p_[active[N]];
+        pN->copy(*z_[active[N]]);
+        for (int h = 0; h < nirrep; h++) {
+            int n = diag_->dimpi()[h];
+            if (!n) continue;
+            double** bp = beta->pointer(h);
+            double* pp = pN->pointer(h);
+            for (int M = 0; M < nold; M++) {
+                if (bp[M][N] == 0.0) continue;
+                C_DAXPY(n, bp[M][N], p_old[M]->pointer(h), 1, pp, 1);
+            }
+        }
+    }
+    block_inds_ = active;
+
+    if (debug_) {
+        outfile->Printf("  > Block update p <\n\n");
+        beta->print();
+    }
+}
 }  // namespace psi
@@ -198,6 +198,13 @@ class CGRSolver : public RSolver {
     /// Number of guess vectors to use for subspace preconditioner
     int nguess_;
 
+    /// Block CG: couple all unconverged right-hand sides through one search space
+    bool block_;
+    /// Right-hand sides whose conjugate directions make up the current block
+    std::vector<size_t> block_inds_;
+    /// (P'AP)^-1 of the current block, per irrep
+    SharedMatrix block_PAP_inv_;
+
     /// Initializes shifts_ to 0
     void setup();
     void guess();
@@ -212,6 +219,9 @@ class CGRSolver : public RSolver {
     void update_z();
     void beta();
     void update_p();
+    /// Block CG counterparts of alpha/update_x/update_r and beta/update_p
+    void block_update_xr();
+    void block_update_p();
 
    public:
     CGRSolver(std::shared_ptr<RHamiltonian> H);
@@ -235,6 +245,8 @@ class CGRSolver : public RSolver {
         A_inds_ = inds;
     }
     void set_nguess(int nguess) { nguess_ = nguess; }
+    /// Use block CG over all right-hand sides (requires equal shifts within each irrep, defaults to false)
+    void set_block(bool block) { block_ = block; }
 };
 }
 #endif
@@ -56,6 +56,7 @@ SOMCSCF::SOMCSCF(std::shared_ptr<JK> jk, SharedMatrix AOTOSO, SharedMatrix H) :
     casscf_ = true;
     has_fzc_ = false;
     compute_IFock_ = true;
+    approx_hk_ = false;
     energy_drc_ = 0.0;
     energy_ci_ = 0.0;
 }
@@ -526,144 +527,197 @@ SharedMatrix SOMCSCF::compute_AFock(SharedMatrix OPDM) {
     AFock->set_name("AFock");
     return AFock;
 }
-SharedMatrix SOMCSCF::Hk(SharedMatrix x) {
+SharedMatrix SOMCSCF::Hk(SharedMatrix x) { return Hk(std::vector<SharedMatrix>{x})[0]; }
+std::vector<SharedMatrix> SOMCSCF::Hk(const std::vector<SharedMatrix>& x) {
     timer_on("SOMCSCF: Rotated fock");
+    size_t nvec = x.size();
 
-    // => Antisymmetric rotation matrix <= //
-    auto U = std::make_shared<Matrix>("U", nirrep_, nmopi_, nmopi_);
-    auto Uocc = std::make_shared<Matrix>("Uocc", nirrep_, noccpi_, nmopi_);
-    auto Uact = std::make_shared<Matrix>("Uact", nirrep_, nactpi_, nmopi_);
-    for (int h = 0; h < nirrep_; h++) {
-        if (!noapi_[h] || !navpi_[h]) continue;
-        double** Up = U->pointer(h);
-        double** xp = x->pointer(h);
-
-        for (int i = 0; i < noapi_[h]; i++) {
-            for (int a = 0; a < navpi_[h]; a++) {
-                int offa = noccpi_[h] + a;
-                Up[i][offa] = xp[i][a];
-                Up[offa][i] = -1.0 * xp[i][a];
+    // => Antisymmetric rotation matrices <= //
+    std::vector<SharedMatrix> U, Uact;
+    std::shared_ptr<JK> jk = (approx_hk_ && approx_jk_) ? approx_jk_ : jk_;
+    std::vector<SharedMatrix>& Cl = jk->C_left();
+    std::vector<SharedMatrix>& Cr = jk->C_right();
+    Cl.clear();
+    Cr.clear();
+    for (size_t n = 0; n < nvec; n++) {
+        U.push_back(std::make_shared<Matrix>("U", nirrep_, nmopi_, nmopi_));
+        auto Uocc = std::make_shared<Matrix>("Uocc", nirrep_, noccpi_, nmopi_);
+        Uact.push_back(std::make_shared<Matrix>("Uact", nirrep_, nactpi_, nmopi_));
+        for (int h = 0; h < nirrep_; h++) {
+            if (!noapi_[h] || !navpi_[h]) continue;
+            double** Up = U[n]->pointer(h);
+            double** xp = x[n]->pointer(h);
+
+            for (int i = 0; i < noapi_[h]; i++) {
+                for (int a = 0; a < navpi_[h]; a++) {
+                    int offa = noccpi_[h] + a;
+                    Up[i][offa] = xp[i][a];
+                    Up[offa][i] = -1.0 * xp[i][a];
+                }
             }
-        }
-        // Fill Uocc
-        if (noccpi_[h]) {
-            double** Uoccp = Uocc->pointer(h);
-            for (int i = 0; i < noccpi_[h]; i++) {
-                for (int j = 0; j < nmopi_[h]; j++) {
-                    Uoccp[i][j] = Up[i][j];
+            // Fill Uocc
+            if (noccpi_[h]) {
+                double** Uoccp = Uocc->pointer(h);
+                for (int i = 0; i < noccpi_[h]; i++) {
+                    for (int j = 0; j < nmopi_[h]; j++) {
+                        Uoccp[i][j] = Up[i][j];
+                    }
                 }
             }
-        }
-        // Fill Ua
-        if (nactpi_[h]) {
-            double** Uactp = Uact->pointer(h);
-            for (int i = 0; i < nactpi_[h]; i++) {
-                for (int j = 0; j < nmopi_[h]; j++) {
-                    Uactp[i][j] = Up[i + noccpi_[h]][j];
+            // Fill Ua
+            if (nactpi_[h]) {
+                double** Uactp = Uact[n]->pointer(h);
+                for (int i = 0; i < nactpi_[h]; i++) {
+                    for (int j = 0; j < nmopi_[h]; j++) {
+                        Uactp[i][j] = Up[i + noccpi_[h]][j];
+                    }
                 }
             }
         }
-    }
 
-    // => Rotated inactive and active Fock matrices <= //
-    std::vector<SharedMatrix>& Cl = jk_->C_left();
-    std::vector<SharedMatrix>& Cr = jk_->C_right();
-    Cl.clear();
-    Cr.clear();
-
-    // For inactive Fock
+        // => Rotated inactive and active Fock matrices, two densities per vector <= //
 
-    SharedMatrix CLUocc = linalg::doublet(matrices_["C"], Uocc, false, true);
-    Cl.push_back(CLUocc);
-    Cr.push_back(matrices_["Cocc"]);
+        // For inactive Fock
+        SharedMatrix CLUocc = linalg::doublet(matrices_["C"], Uocc, false, true);
+        Cl.push_back(CLUocc);
+        Cr.push_back(matrices_["Cocc"]);
 
-    // For active Fock
-    SharedMatrix CLUact = linalg::triplet(matrices_["C"], Uact, matrices_["OPDM"], false, true, true);
-    Cr.push_back(CLUact);
-    Cl.push_back(matrices_["Cact"]);
+        // For active Fock
+        SharedMatrix CLUact = linalg::triplet(matrices_["C"], Uact[n], matrices_["OPDM"], false, true, true);
+        Cr.push_back(CLUact);
+        Cl.push_back(matrices_["Cact"]);
+    }
 
-    jk_->compute();
+    jk->compute();
     Cl.clear();
     Cr.clear();
 
-    const std::vector<SharedMatrix>& J = jk_->J();
-    const std::vector<SharedMatrix>& K = jk_->K();
-
-    // Rotated inactive fock
-    SharedMatrix IFk = linalg::doublet(matrices_["IFock"], U, false, true);
-    IFk->gemm(false, false, 1.0, U, matrices_["IFock"], 1.0);
-
-    J[0]->scale(4.0);
-    J[0]->subtract(K[0]);
-    J[0]->subtract(K[0]->transpose());
-    SharedMatrix trans_half = linalg::doublet(J[0], matrices_["C"]);
-    IFk->gemm(true, false, 1.0, matrices_["C"], trans_half, 1.0);
-
-    // Rotated active fock
-    SharedMatrix ret = linalg::doublet(matrices_["AFock"], U, false, true);
-    ret->gemm(false, false, 1.0, U, matrices_["AFock"], 1.0);
-
-    J[1]->scale(2.0);
-    K[1]->scale(0.5);
-    J[1]->subtract(K[1]);
-    J[1]->subtract(K[1]->transpose());
-    trans_half = linalg::doublet(J[1], matrices_["C"]);
-    ret->gemm(true, false, 1.0, matrices_["C"], trans_half, 1.0);
-
-    trans_half.reset();
-    ret->add(IFk);
-    ret->scale(2.0);
-
-    /// Build Qk
-    matrices_["Qk"] = compute_Qk(matrices_["TPDM"], U, Uact);
-    // outfile->Printf("Active Fock\n");
-    // matrices_["Qk"]->print();
+    const std::vector<SharedMatrix>& J = jk->J();
+    const std::vector<SharedMatrix>& K = jk->K();
+
+    std::vector<SharedMatrix> hessx;
+    for (size_t n = 0; n < nvec; n++) {
+        const SharedMatrix& Jocc = J[2 * n];
+        const SharedMatrix& Kocc = K[2 * n];
+        const SharedMatrix& Jact = J[2 * n + 1];
+        const SharedMatrix& Kact = K[2 * n + 1];
+
+        // Rotated inactive fock
+        SharedMatrix IFk = linalg::doublet(matrices_["IFock"], U[n], false, true);
+        IFk->gemm(false, false, 1.0, U[n], matrices_["IFock"], 1.0);
+
+        Jocc->scale(4.0);
+        Jocc->subtract(Kocc);
+        Jocc->subtract(Kocc->transpose());
+        SharedMatrix trans_half = linalg::doublet(Jocc, matrices_["C"]);
+        IFk->gemm(true, false, 1.0, matrices_["C"], trans_half, 1.0);
+
+        // Rotated active fock
+        SharedMatrix ret = linalg::doublet(matrices_["AFock"], U[n], false, true);
+        ret->gemm(false, false, 1.0, U[n], matrices_["AFock"], 1.0);
+
+        Jact->scale(2.0);
+        Kact->scale(0.5);
+        Jact->subtract(Kact);
+        Jact->subtract(Kact->transpose());
+        trans_half = linalg::doublet(Jact, matrices_["C"]);
+        ret->gemm(true, false, 1.0, matrices_["C"], trans_half, 1.0);
+
+        trans_half.reset();
+        ret->add(IFk);
+        ret->scale(2.0);
+
+        /// Build Qk
+        matrices_["Qk"] = compute_Qk(matrices_["TPDM"], U[n], Uact[n]);
+        // outfile->Printf("Active Fock\n");
+        // matrices_["Qk"]->print();
+
+        // Add in Q and zero out virtual
+        for (int h = 0; h < nirrep_; h++) {
+            if (nactpi_[h]) {
+                double** Fkp = ret->pointer(h);
+                double** Qkp = matrices_["Qk"]->pointer(h);
+
+                // OPDM_vw IF_wn->vn
+                C_DGEMM('N', 'N', nactpi_[h], nmopi_[h], nactpi_[h], 1.0, matrices_["OPDM"]->pointer(h)[0],
+                        nactpi_[h], IFk->pointer(h)[noccpi_[h]], nmopi_[h], 0.0, Fkp[noccpi_[h]], nmopi_[h]);
+
+                // OPDM_vw += Qk
+                C_DAXPY(static_cast<size_t>(nmopi_[h]) * nactpi_[h], 1.0, Qkp[0], 1, Fkp[noccpi_[h]], 1);
+            }
 
-    // Add in Q and zero out virtual
-    for (int h = 0; h < nirrep_; h++) {
-        if (nactpi_[h]) {
-            double** Fkp = ret->pointer(h);
-            double** Qkp = matrices_["Qk"]->pointer(h);
+            if (nvirpi_[h]) {
+                double** Fkp = ret->pointer(h);
+                // Zero out the Fk[a,n] part
+                for (int i = noapi_[h]; i < nmopi_[h]; i++) {
+                    for (int j = 0; j < nmopi_[h]; j++) {
+                        Fkp[i][j] = 0.0;
+                    }
+                }
+            }
+        }
 
-            // OPDM_vw IF_wn->vn
-            C_DGEMM('N', 'N', nactpi_[h], nmopi_[h], nactpi_[h], 1.0, matrices_["OPDM"]->pointer(h)[0], nactpi_[h],
-                    IFk->pointer(h)[noccpi_[h]], nmopi_[h], 0.0, Fkp[noccpi_[h]], nmopi_[h]);
+        // => Hessian <= //
+        auto Hx = std::make_shared<Matrix>("Hessian x", nirrep_, noapi_, navpi_);
 
-            // OPDM_vw += Qk
-            C_DAXPY( static_cast<size_t>(nmopi_[h]) * nactpi_[h], 1.0, Qkp[0], 1, Fkp[noccpi_[h]], 1);
-        }
+        for (int h = 0; h < nirrep_; h++) {
+            if (!noapi_[h] || !navpi_[h]) continue;
 
-        if (nvirpi_[h]) {
+            double** Hxp = Hx->pointer(h);
             double** Fkp = ret->pointer(h);
-            // Zero out the Fk[a,n] part
-            for (int i = noapi_[h]; i < nmopi_[h]; i++) {
-                for (int j = 0; j < nmopi_[h]; j++) {
-                    Fkp[i][j] = 0.0;
+
+            for (int i = 0; i < noapi_[h]; i++) {
+                for (int j = 0; j < navpi_[h]; j++) {
+                    int nj = noccpi_[h] + j;
+                    Hxp[i][j] = 2.0 * (Fkp[i][nj] - Fkp[nj][i]);
                 }
             }
         }
+
+        zero_redundant(Hx);
+        hessx.push_back(Hx);
     }
+    timer_off("SOMCSCF: Rotated fock");
+    return hessx;
+}
+SharedMatrix SOMCSCF::compute_dense_Q(SharedMatrix TPDM, SharedMatrix aaar) {
+    timer_on("SOMCSCF: Q matrix");
 
-    // => Hessian <= //
-    auto hessx = std::make_shared<Matrix>("Hessian x", nirrep_, noapi_, navpi_);
+    // G_mwxy TPDM_vwxy -> Q_mv
+    auto denQ = std::make_shared<Matrix>("Dense Qvn", nact_, nmo_);
+    double** denQp = denQ->pointer();
 
-    for (int h = 0; h < nirrep_; h++) {
-        if (!noapi_[h] || !navpi_[h]) continue;
+    int nact3 = nact_ * nact_ * nact_;
+    double** TPDMp = TPDM->pointer();
+    double** aaaRp = aaar->pointer();
+    /// KPH found that this didn't work for my purpose.  Not sure if it works for anyone else.  No test cases for this.
+    // C_DGEMM('N','N',nact_,nmo_,nact3,1.0,TPDMp[0],nact3,aaaRp[0],nact3,1.0,denQp[0],nmo_);
+    /// TPDM_vwxy G_mwxy -> Q_vm
+    C_DGEMM('N', 'T', nact_, nmo_, nact3, 1.0, TPDMp[0], nact3, aaaRp[0], nact3, 1.0, denQp[0], nmo_);
 
-        double** Hxp = hessx->pointer(h);
-        double** Fkp = ret->pointer(h);
+    // Symmetry block Q
+    auto Q = std::make_shared<Matrix>("Qvn", nirrep_, nactpi_, nmopi_);
 
-        for (int i = 0; i < noapi_[h]; i++) {
-            for (int j = 0; j < navpi_[h]; j++) {
-                int nj = noccpi_[h] + j;
-                Hxp[i][j] = 2.0 * (Fkp[i][nj] - Fkp[nj][i]);
+    int offset_act = 0;
+    int offset_nmo = 0;
+    for (int h = 0; h < nirrep_; h++) {
+        if (!nactpi_[h] || !nmopi_[h]) {
+            offset_nmo += nmopi_[h];
+            continue;
+        }
+
+        double* Qp = Q->pointer(h)[0];
+        for (int i = 0, target = 0; i < nactpi_[h]; i++) {
+            for (int j = 0; j < nmopi_[h]; j++) {
+                Qp[target++] = denQp[offset_act + i][offset_nmo + j];
             }
         }
+        offset_act += nactpi_[h];
+        offset_nmo += nmopi_[h];
     }
 
-    zero_redundant(hessx);
-    timer_off("SOMCSCF: Rotated fock");
-    return hessx;
+    timer_off("SOMCSCF: Q matrix");
+    return Q;
 }
 SharedMatrix SOMCSCF::approx_solve() {
     // outfile->Printf("In approx solve\n");
@@ -1108,7 +1162,16 @@ DiskSOMCSCF::~DiskSOMCSCF() {}
 void DiskSOMCSCF::transform(bool approx_only) {
     throw PSIEXCEPTION("DiskSOMCSCF::transform is not supported for Disk integrals.");
 }
+void DiskSOMCSCF::set_eri_tensors(SharedMatrix aaaa, SharedMatrix aaar) {
+    mo_aaaa_ = aaaa;
+    mo_aaar_ = aaar;
+}
 void DiskSOMCSCF::set_act_MO() {
+    if (mo_aaaa_) {
+        matrices_["actMO"] = mo_aaaa_;
+        return;
+    }
+
     dpdbuf4 I;
 
     // => Read dense active MO <= //
@@ -1168,6 +1231,8 @@ void DiskSOMCSCF::set_act_MO() {
     psio_->close(PSIF_LIBTRANS_DPD, 1);
 }
 SharedMatrix DiskSOMCSCF::compute_Q(SharedMatrix TPDMmat) {
+    if (mo_aaar_) return compute_dense_Q(TPDMmat, mo_aaar_);
+
     timer_on("SOMCSCF: Q matrix");
 
     // => Write active TPDM <= //
@@ -1385,44 +1450,7 @@ SharedMatrix IncoreSOMCSCF::compute_Q(SharedMatrix TPDM) {
     if (!eri_tensor_set_) {
         throw PSIEXCEPTION("IncoreSOMCSCF: Eri tensors were not set!");
     }
-
-    timer_on("SOMCSCF: Q matrix");
-
-    // G_mwxy TPDM_vwxy -> Q_mv
-    auto denQ = std::make_shared<Matrix>("Dense Qvn", nact_, nmo_);
-    double** denQp = denQ->pointer();
-
-    int nact3 = nact_ * nact_ * nact_;
-    double** TPDMp = TPDM->pointer();
-    double** aaaRp = mo_aaar_->pointer();
-    /// KPH found that this didn't work for my purpose.  Not sure if it works for anyone else.  No test cases for this.
-    // C_DGEMM('N','N',nact_,nmo_,nact3,1.0,TPDMp[0],nact3,aaaRp[0],nact3,1.0,denQp[0],nmo_);
-    /// TPDM_vwxy G_mwxy -> Q_vm
-    C_DGEMM('N', 'T', nact_, nmo_, nact3, 1.0, TPDMp[0], nact3, aaaRp[0], nact3, 1.0, denQp[0], nmo_);
-
-    // Symmetry block Q
-    auto Q = std::make_shared<Matrix>("Qvn", nirrep_, nactpi_, nmopi_);
-
-    int offset_act = 0;
-    int offset_nmo = 0;
-    for (int h = 0; h < nirrep_; h++) {
-        if (!nactpi_[h] || !nmopi_[h]) {
-            offset_nmo += nmopi_[h];
-            continue;
-        }
-
-        double* Qp = Q->pointer(h)[0];
-        for (int i = 0, target = 0; i < nactpi_[h]; i++) {
-            for (int j = 0; j < nmopi_[h]; j++) {
-                Qp[target++] = denQp[offset_act + i][offset_nmo + j];
-            }
-        }
-        offset_act += nactpi_[h];
-        offset_nmo += nmopi_[h];
-    }
-
-    timer_off("SOMCSCF: Q matrix");
-    return Q;
+    return compute_dense_Q(TPDM, mo_aaar_);
 }
 void IncoreSOMCSCF::set_act_MO(void) {
     if (eri_tensor_set_) {
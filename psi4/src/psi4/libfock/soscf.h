@@ -147,6 +147,27 @@ class SOMCSCF {
      */
     SharedMatrix Hk(SharedMatrix x);
 
+    /**
+     * Returns the hessian times several trial vectors. All of the rotated densities
+     * go through a single JK call.
+     * @param  x  The [oa, av] matrices of non-redundant orbital rotations.
+     * @return Hx The [oa, av] blocks of the rotated Fock matrices.
+     */
+    std::vector<SharedMatrix> Hk(const std::vector<SharedMatrix>& x);
+
+    /**
+     * Sets a cheaper JK object that Hk may use in place of the exact one, the
+     * gradient is always built with the exact JK object.
+     * @param jk Initialized JK object, must support non-symmetric densities
+     */
+    void set_approx_jk(std::shared_ptr<JK> jk) { approx_jk_ = jk; }
+
+    /**
+     * Switches the hessian vector products onto the approximate JK object, if one is set.
+     * @param approx Use the approximate JK object for Hk
+     */
+    void set_approx_hk(bool approx) { approx_hk_ = approx; }
+
     /**
      * Uses the approximate H diagonal hessian for an update.
      * @return x         The [oa, av] matrix of non-redundant orbital rotation parameters.
@@ -210,6 +231,7 @@ class SOMCSCF {
     bool casscf_;
     bool has_fzc_;
     bool compute_IFock_;
+    bool approx_hk_;
     size_t memory_;
 
     /// Doubles
@@ -237,6 +259,7 @@ class SOMCSCF {
 
     /// Integral objects
     std::shared_ptr<JK> jk_;
+    std::shared_ptr<JK> approx_jk_;
 
     /// Map of matrices
     std::map<std::string, SharedMatrix> matrices_;
@@ -255,6 +278,9 @@ class SOMCSCF {
     // Grab actMO (dense)
     virtual void set_act_MO();
 
+    // Q from a dense (aaaR) tensor
+    SharedMatrix compute_dense_Q(SharedMatrix TPDM, SharedMatrix aaar);
+
 };  // SOMCSCF class
 
 /**
@@ -299,9 +325,17 @@ class DiskSOMCSCF : public SOMCSCF {
 
     ~DiskSOMCSCF() override;
 
+    /**
+     * Hands over in-core (aa|aa) and (aR|aa) tensors, used by update() in place of the
+     * DPD files until cleared with null matrices.
+     */
+    void set_eri_tensors(SharedMatrix aaaa, SharedMatrix aaar) override;
+
    protected:
     std::shared_ptr<IntegralTransform> ints_;
     std::shared_ptr<PSIO> psio_;
+    SharedMatrix mo_aaaa_;
+    SharedMatrix mo_aaar_;
     void transform(bool approx_only) override;
     void set_act_MO() override;
     SharedMatrix compute_Q(SharedMatrix TPDM) override;
@@ -45,13 +45,24 @@
 #include "psi4/libmints/petitelist.h"
 #include "psi4/libmints/vector.h"
 #include "psi4/libpsi4util/PsiOutStream.h"
+#include "psi4/libpsi4util/memory_governor.h"
 #include "psi4/libpsi4util/process.h"
+#include "psi4/libpsio/psio.hpp"
 
 #include <cstdlib>
 #include <numeric>
 #include <sstream>
 #include <string>
 #include <algorithm>
+#include <chrono>
+#include <limits>
+#ifdef _MSC_VER
+#include <process.h>
+#define SYSTEM_GETPID ::_getpid
+#else
+#include <unistd.h>
+#define SYSTEM_GETPID ::getpid
+#endif
 
 #ifdef _OPENMP
 #include <omp.h>
@@ -96,7 +107,7 @@ VBase::VBase(std::shared_ptr<SuperFunctional> functional, std::shared_ptr<BasisS
     : options_(options), primary_(primary), functional_(functional) {
     common_init();
 }
-VBase::~VBase() {}
+VBase::~VBase() { MemoryGovernor::instance().release(this); }
 void VBase::common_init() {
     print_ = options_.get_int("PRINT");
     debug_ = options_.get_int("DEBUG");
@@ -109,12 +120,168 @@ void VBase::common_init() {
         v2_rho_cutoff_ = functional_->density_tolerance();
     }
     vv10_rho_cutoff_ = options_.get_double("DFT_VV10_RHO_CUTOFF");
+    vv10_radius_ = options_.get_double("DFT_VV10_CUTOFF_RADIUS");
     grac_initialized_ = false;
+    cache_map_ = std::make_shared<CollocationCache>();
     cache_map_deriv_ = -1;
+    collocation_deriv_ = -1;
     num_threads_ = 1;
 #ifdef _OPENMP
     num_threads_ = omp_get_max_threads();
 #endif
+    numa_first_touch_ = (options_.get_int("NUMA_DOMAINS") > 0);
+    block_batch_ = (size_t)std::max(1, options_.get_int("DFT_BLOCK_BATCH"));
+    vx_batch_ = (size_t)std::max(1, options_.get_int("DFT_VX_BATCH"));
+    block_rho_cutoff_ = options_.get_double("DFT_BLOCK_SCREENING_CUTOFF");
+    block_screening_ = (block_rho_cutoff_ > 0.0);
+    incremental_xc_cutoff_ = options_.get_double("DFT_INCREMENTAL_XC_CUTOFF");
+    incremental_xc_ = (incremental_xc_cutoff_ > 0.0);
+}
+void VBase::build_thread_workers(const std::function<void(size_t)>& build) {
+    if (!numa_first_touch_) {
+        for (size_t i = 0; i < num_threads_; i++) build(i);
+        return;
+    }
+// Serialized, since worker construction touches shared state, but each runs on its own thread
+#pragma omp parallel num_threads(num_threads_)
+    {
+        size_t rank = 0;
+#ifdef _OPENMP
+        rank = omp_get_thread_num();
+#endif
+#pragma omp critical
+        build(rank);
+    }
+}
+void VBase::build_batch_functional_workers() {
+    if (block_batch_ == 1) return;
+    batch_functional_workers_.resize(num_threads_);
+    batch_point_values_.resize(num_threads_);
+    build_thread_workers([&](size_t i) {
+        auto fworker = functional_workers_[i]->build_worker();
+        fworker->set_max_points(block_batch_ * grid_->max_points());
+        fworker->allocate();
+        batch_functional_workers_[i] = fworker;
+    });
+}
+std::shared_ptr<PointFunctions> VBase::batch_point_worker(size_t rank, size_t b) {
+    return (b == 0 ? point_workers_[rank] : batch_point_workers_[rank * (block_batch_ - 1) + b - 1]);
+}
+void VBase::compute_functional_batch(size_t rank, const std::vector<size_t>& blocks, size_t Qstart, size_t Qstop) {
+    auto& batch_vals = batch_point_values_[rank];
+    size_t offset = 0;
+    for (size_t Q = Qstart; Q < Qstop; Q++) {
+        size_t npoints = grid_->blocks()[blocks[Q]]->npoints();
+        for (const auto& kv : batch_point_worker(rank, Q - Qstart)->point_values()) {
+            auto& target = batch_vals[kv.first];
+            if (!target) target = std::make_shared<Vector>(kv.first, block_batch_ * grid_->max_points());
+            C_DCOPY(npoints, kv.second->pointer(), 1, target->pointer() + offset, 1);
+        }
+        offset += npoints;
+    }
+    batch_functional_workers_[rank]->compute_functional(batch_vals, offset);
+}
+void VBase::scatter_functional_batch(size_t rank, const std::vector<size_t>& blocks, size_t Qstart, size_t Q) {
+    size_t offset = 0;
+    for (size_t R = Qstart; R < Q; R++) offset += grid_->blocks()[blocks[R]]->npoints();
+    size_t npoints = grid_->blocks()[blocks[Q]]->npoints();
+    auto& values = functional_workers_[rank]->values();
+    for (const auto& kv : batch_functional_workers_[rank]->values()) {
+        auto it = values.find(kv.first);
+        if (it == values.end()) continue;
+        C_DCOPY(npoints, kv.second->pointer() + offset, 1, it->second->pointer(), 1);
+    }
+}
+std::vector<size_t> VBase::screen_blocks() {
+    size_t nblocks = grid_->blocks().size();
+    if (block_max_rho_.size() != nblocks) block_max_rho_.assign(nblocks, -1.0);
+
+    std::vector<size_t> blocks;
+    for (size_t Q = 0; Q < nblocks; Q++) {
+        // Blocks never evaluated have a negative maximum and are always kept
+        if (block_screening_ && block_max_rho_[Q] >= 0.0 && block_max_rho_[Q] < block_rho_cutoff_) continue;
+        blocks.push_back(Q);
+    }
+    if (debug_ && block_screening_) {
+        outfile->Printf("    Density screening skipped %zu of %zu grid blocks.\n", nblocks - blocks.size(), nblocks);
+    }
+    if (incremental_xc_ && block_xc_rho_.size() != nblocks) {
+        block_xc_rho_.assign(nblocks, std::vector<double>());
+        block_xc_V_.assign(nblocks, std::vector<double>());
+        block_xc_q_.assign(nblocks, std::vector<double>());
+    }
+    return blocks;
+}
+void VBase::record_block_density(size_t Q, std::shared_ptr<PointFunctions> pworker) {
+    if (block_rho_cutoff_ <= 0.0) return;
+    size_t npoints = grid_->blocks()[Q]->npoints();
+    double max_rho = 0.0;
+    for (const auto& key : {"RHO_A", "RHO_B"}) {
+        auto it = pworker->point_values().find(key);
+        if (it == pworker->point_values().end()) continue;
+        double* rhop = it->second->pointer();
+        for (size_t P = 0; P < npoints; P++) max_rho = std::max(max_rho, std::fabs(rhop[P]));
+    }
+    block_max_rho_[Q] = max_rho;
+}
+// Point values whose change decides if a stored block contribution is still valid
+static const std::vector<std::string> incremental_xc_keys = {"RHO_A",  "RHO_B",  "RHO_AX", "RHO_AY", "RHO_AZ",
+                                                             "RHO_BX", "RHO_BY", "RHO_BZ", "TAU_A",  "TAU_B"};
+bool VBase::block_xc_unchanged(size_t Q, std::shared_ptr<PointFunctions> pworker) {
+    if (!incremental_xc_ || block_xc_rho_[Q].empty()) return false;
+    size_t npoints = grid_->blocks()[Q]->npoints();
+    const double* refp = block_xc_rho_[Q].data();
+    for (const auto& key : incremental_xc_keys) {
+        auto it = pworker->point_values().find(key);
+        if (it == pworker->point_values().end()) continue;
+        double* valp = it->second->pointer();
+        for (size_t P = 0; P < npoints; P++) {
+            if (std::fabs(valp[P] - refp[P]) > incremental_xc_cutoff_) return false;
+        }
+        refp += npoints;
+    }
+    return true;
+}
+void VBase::store_block_xc(size_t Q, std::shared_ptr<PointFunctions> pworker, const std::vector<SharedMatrix>& V,
+                           const std::vector<double>& qvals) {
+    if (!incremental_xc_) return;
+    size_t npoints = grid_->blocks()[Q]->npoints();
+    size_t nlocal = grid_->blocks()[Q]->local_nbf();
+
+    auto& rho = block_xc_rho_[Q];
+    rho.clear();
+    for (const auto& key : incremental_xc_keys) {
+        auto it = pworker->point_values().find(key);
+        if (it == pworker->point_values().end()) continue;
+        double* valp = it->second->pointer();
+        rho.insert(rho.end(), valp, valp + npoints);
+    }
+
+    auto& Vstore = block_xc_V_[Q];
+    Vstore.resize(V.size() * nlocal * nlocal);
+    double* Vsp = Vstore.data();
+    for (const auto& Vs : V) {
+        double** V2p = Vs->pointer();
+        for (size_t ml = 0; ml < nlocal; ml++, Vsp += nlocal) std::copy(V2p[ml], V2p[ml] + nlocal, Vsp);
+    }
+    block_xc_q_[Q] = qvals;
+}
+const std::vector<double>& VBase::restore_block_xc(size_t Q, const std::vector<SharedMatrix>& V) {
+    size_t nlocal = grid_->blocks()[Q]->local_nbf();
+    const double* Vsp = block_xc_V_[Q].data();
+    for (const auto& Vs : V) {
+        double** V2p = Vs->pointer();
+        for (size_t ml = 0; ml < nlocal; ml++, Vsp += nlocal) std::copy(Vsp, Vsp + nlocal, V2p[ml]);
+    }
+    return block_xc_q_[Q];
+}
+void VBase::set_incremental_xc(bool incremental) {
+    incremental_xc_ = incremental && (incremental_xc_cutoff_ > 0.0);
+    if (!incremental_xc_) {
+        block_xc_rho_.clear();
+        block_xc_V_.clear();
+        block_xc_q_.clear();
+    }
 }
 std::shared_ptr<VBase> VBase::build_V(std::shared_ptr<BasisSet> primary, std::shared_ptr<SuperFunctional> functional,
                                       Options& options, const std::string& type) {
@@ -174,14 +341,17 @@ void VBase::set_D(std::vector<SharedMatrix> Dvec) {
     }
 }
 void VBase::initialize() {
-    timer_on("V: Grid");
-    grid_ = std::make_shared<DFTGrid>(primary_->molecule(), primary_, options_);
-    timer_off("V: Grid");
-
-    for (size_t i = 0; i < num_threads_; i++) {
-        // Need a functional worker per thread
-        functional_workers_.push_back(functional_->build_worker());
+    // A grid handed in through set_grid is used as is
+    if (!grid_) {
+        timer_on("V: Grid");
+        grid_ = std::make_shared<DFTGrid>(primary_->molecule(), primary_, options_);
+        timer_off("V: Grid");
     }
+
+    // Need a functional worker per thread
+    size_t offset = functional_workers_.size();
+    functional_workers_.resize(offset + num_threads_);
+    build_thread_workers([&](size_t i) { functional_workers_[offset + i] = functional_->build_worker(); });
     
 #ifdef USING_BrianQC
     if (brianEnable and brianEnableDFT)
@@ -735,37 +905,90 @@ std::shared_ptr<BlockOPoints> VBase::get_block(int block) { return grid_->blocks
 size_t VBase::nblocks() { return grid_->blocks().size(); }
 void VBase::finalize() { grid_.reset(); }
 void VBase::build_collocation_cache(size_t memory) {
-    // Figure out many blocks to skip
+    cache_map_->clear();
+    cache_map_deriv_ = -1;
+    MemoryGovernor::instance().release(this);
+    const auto& blocks = grid_->blocks();
+
+    // Single precision halves the footprint of the in-memory and disk tiers
+    bool compress = options_.get_bool("DFT_COLLOCATION_COMPRESS");
+    size_t disk_memory = (size_t)options_.get_int("DFT_COLLOCATION_DISK") * 1024L * 1024L / sizeof(double);
+    double packed_fraction = (compress ? 0.5 : 1.0);
 
-    size_t collocation_size = grid_->collocation_size();
-    if (functional_->ansatz() == 1) {
-        collocation_size *= 4;  // For gradients
+    // Hold the derivatives of a following gradient or Hessian too, but only if the whole grid still fits in memory
+    int old_deriv = point_workers_[0]->deriv();
+    int deriv = old_deriv;
+    if (collocation_deriv_ > old_deriv) {
+        size_t ncomponents = (collocation_deriv_ + 1) * (collocation_deriv_ + 2) * (collocation_deriv_ + 3) / 6;
+        if (packed_fraction * ncomponents * grid_->collocation_size() <= memory) deriv = collocation_deriv_;
     }
-    if (functional_->ansatz() == 2) {
-        collocation_size *= 10;  // For gradients and Hessians
+    if (deriv != old_deriv) {
+        for (size_t i = 0; i < num_threads_; i++) point_workers_[i]->set_deriv(deriv);
+    }
+    size_t ncomponents = point_workers_[0]->basis_values().size();
+
+    // => Assign blocks to tiers, in order, while the memory and then the disk budgets last <= //
+    std::vector<int> block_tier(blocks.size(), -1);
+    std::vector<size_t> disk_offsets(blocks.size(), 0L);
+    // The cache is the first thing to go when another module runs short of memory
+    auto& governor = MemoryGovernor::instance();
+    auto shrinker = [this](size_t) {
+        size_t held = MemoryGovernor::instance().reserved(this);
+        clear_collocation_cache();
+        return held;
+    };
+    memory = std::min(memory, governor.reserve(this, "DFT collocation cache", memory * sizeof(double)) / sizeof(double));
+    size_t memory_left = memory;
+    size_t disk_left = disk_memory;
+    size_t disk_offset = 0L;
+    std::vector<size_t> ntier(3, 0L);
+    std::vector<double> tier_size(3, 0.0);
+    for (size_t Q = 0; Q < blocks.size(); Q++) {
+        size_t nvalues = ncomponents * blocks[Q]->npoints() * blocks[Q]->local_nbf();
+        size_t cost = (size_t)std::ceil(packed_fraction * nvalues);
+        CollocationCache::Tier tier;
+        if (cost <= memory_left) {
+            tier = (compress ? CollocationCache::Tier::Compressed : CollocationCache::Tier::Full);
+            memory_left -= cost;
+        } else if (cost <= disk_left) {
+            tier = CollocationCache::Tier::Disk;
+            disk_left -= cost;
+            disk_offsets[Q] = disk_offset;
+            disk_offset += nvalues;
+        } else {
+            continue;
+        }
+        block_tier[Q] = (int)tier;
+        ntier[(int)tier]++;
+        tier_size[(int)tier] += 8.0 * cost;
     }
 
-    // Figure out stride as closest whole number to amount we need
-    size_t stride = (size_t)(std::ceil(collocation_size / (double)memory));
-
-    // More memory than needed
-    if (stride == 0) {
-        stride = 1;
+    // Keep only what the in-memory tiers use
+    if (memory > memory_left) {
+        governor.reserve(this, "DFT collocation cache", (memory - memory_left) * sizeof(double), shrinker);
+    } else {
+        governor.release(this);
     }
-    cache_map_.clear();
 
-    // Effectively zero blocks saved.
-    if (stride > grid_->blocks().size()) {
+    // Nothing to save
+    if (std::accumulate(ntier.begin(), ntier.end(), 0L) == 0) {
+        for (size_t i = 0; i < num_threads_; i++) point_workers_[i]->set_deriv(old_deriv);
         return;
     }
 
-    cache_map_deriv_ = point_workers_[0]->deriv();
-    auto saved_size_rank = std::vector<size_t>(num_threads_, 0);
-    auto ncomputed_rank = std::vector<size_t>(num_threads_, 0);
+    if (ntier[(int)CollocationCache::Tier::Disk]) {
+        std::string filename = PSIOManager::shared_object()->get_default_path() + "psi." +
+                               std::to_string(SYSTEM_GETPID()) + ".collocation." + std::to_string(rand()) + ".dat";
+        cache_map_->open_disk(filename, compress);
+    }
+
+    cache_map_deriv_ = deriv;
 
 // Loop over the blocks
-#pragma omp parallel for schedule(guided) num_threads(num_threads_)
-    for (size_t Q = 0; Q < grid_->blocks().size(); Q += stride) {
+#pragma omp parallel for schedule(dynamic) num_threads(num_threads_)
+    for (size_t Q = 0; Q < blocks.size(); Q++) {
+        if (block_tier[Q] < 0) continue;
+
         // Get thread info
         int rank = 0;
 #ifdef _OPENMP
@@ -773,43 +996,116 @@ void VBase::build_collocation_cache(size_t memory) {
 #endif
 
         // Compute a collocation block
-        std::shared_ptr<BlockOPoints> block = grid_->blocks()[Q];
+        std::shared_ptr<BlockOPoints> block = blocks[Q];
         std::shared_ptr<PointFunctions> pworker = point_workers_[rank];
         pworker->compute_functions(block);
 
-        // Build temps
-        size_t nrows = block->npoints();
-        size_t ncols = block->local_nbf();
-        std::map<std::string, SharedMatrix> collocation_map;
+        cache_map_->store(block->index(), (CollocationCache::Tier)block_tier[Q], pworker->basis_values(),
+                          block->npoints(), block->local_nbf(), disk_offsets[Q]);
+    }
 
-        // Loop over components PHI, PHI_X, PHI_Y, ...
-        for (auto& kv : pworker->basis_values()) {
-            auto coll = std::make_shared<Matrix>(kv.second->name(), nrows, ncols);
+    if (deriv != old_deriv) {
+        for (size_t i = 0; i < num_threads_; i++) point_workers_[i]->set_deriv(old_deriv);
+    }
 
-            double** sourcep = kv.second->pointer();
-            double** collp = coll->pointer();
+    if (print_) {
+        const char* tier_names[] = {"in memory", "in memory (single precision)", "on disk"};
+        for (int tier = 0; tier < 3; tier++) {
+            if (!ntier[tier]) continue;
+            double fraction = (double)ntier[tier] / blocks.size() * 100;
+            double gib_saved = tier_size[tier] / 1024.0 / 1024.0 / 1024.0;
+            outfile->Printf("  Cached %.1lf%% of DFT collocation blocks %s in %.3lf [GiB].\n", fraction,
+                            tier_names[tier], gib_saved);
+        }
+        outfile->Printf("\n");
+    }
+}
+void VBase::clear_collocation_cache() {
+    cache_map_->clear();
+    cache_map_deriv_ = -1;
+    MemoryGovernor::instance().release(this);
+}
+std::map<std::string, SharedVector> VBase::profile_grid(std::shared_ptr<DFTGrid> grid) {
+    if (D_AO_.empty()) {
+        throw PSIEXCEPTION("V: profile_grid needs a density, call set_D first.");
+    }
+    if (functional_->needs_vv10()) {
+        throw PSIEXCEPTION("V: profile_grid does not integrate the VV10 term.");
+    }
+    const auto& atomic_blocks = grid->atomic_blocks();
+    const size_t natom = atomic_blocks.size();
+    const bool unrestricted = (D_AO_.size() == 2);
+
+    // Workers sized for this grid, without the collocation cache of the production grid
+    std::vector<std::shared_ptr<SuperFunctional>> fworkers(num_threads_);
+    std::vector<std::shared_ptr<PointFunctions>> pworkers(num_threads_);
+    build_thread_workers([&](size_t i) {
+        fworkers[i] = functional_->build_worker();
+        fworkers[i]->set_deriv(0);
+        fworkers[i]->set_max_points(grid->max_points());
+        fworkers[i]->allocate();
+        if (unrestricted) {
+            auto pworker = std::make_shared<UKSFunctions>(primary_, grid->max_points(), grid->max_functions());
+            pworker->set_pointers(D_AO_[0], D_AO_[1]);
+            pworkers[i] = pworker;
+        } else {
+            auto pworker = std::make_shared<RKSFunctions>(primary_, grid->max_points(), grid->max_functions());
+            pworker->set_pointers(D_AO_[0]);
+            pworkers[i] = pworker;
+        }
+        pworkers[i]->set_ansatz(functional_->ansatz());
+    });
+
+    // Flatten the blocks, remembering their atom
+    std::vector<std::pair<size_t, std::shared_ptr<BlockOPoints>>> blocks;
+    for (size_t A = 0; A < natom; A++) {
+        for (const auto& block : atomic_blocks[A]) {
+            blocks.emplace_back(A, block);
+        }
+    }
 
-            // Matrices are packed in a upper left rectangle, cannot use pure DCOPY
-            for (size_t i = 0; i < nrows; i++) {
-                C_DCOPY(ncols, sourcep[i], 1, collp[i], 1);
-            }
-            collocation_map[kv.first] = coll;
+    // Per-thread, per-atom sums
+    std::vector<std::vector<double>> rhoq(num_threads_, std::vector<double>(natom, 0.0));
+    std::vector<std::vector<double>> functionalq(num_threads_, std::vector<double>(natom, 0.0));
+    std::vector<std::vector<double>> timeq(num_threads_, std::vector<double>(natom, 0.0));
 
-            saved_size_rank[rank] += nrows * ncols;
+    int rank = 0;
+#pragma omp parallel for private(rank) schedule(dynamic) num_threads(num_threads_)
+    for (size_t Q = 0; Q < blocks.size(); Q++) {
+#ifdef _OPENMP
+        rank = omp_get_thread_num();
+#endif
+        auto start = std::chrono::steady_clock::now();
+        size_t A = blocks[Q].first;
+        auto block = blocks[Q].second;
+        auto pworker = pworkers[rank];
+        auto fworker = fworkers[rank];
+        int npoints = block->npoints();
+        double* w = block->w();
+
+        pworker->compute_points(block);
+        auto& vals = fworker->compute_functional(pworker->point_values(), npoints);
+
+        functionalq[rank][A] += C_DDOT(npoints, w, 1, vals["V"]->pointer(), 1);
+        rhoq[rank][A] += C_DDOT(npoints, w, 1, pworker->point_value("RHO_A")->pointer(), 1);
+        if (unrestricted) {
+            rhoq[rank][A] += C_DDOT(npoints, w, 1, pworker->point_value("RHO_B")->pointer(), 1);
         }
-        ncomputed_rank[rank]++;
-#pragma omp critical
-        cache_map_[block->index()] = collocation_map;
+        timeq[rank][A] += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
     }
 
-    size_t saved_size = std::accumulate(saved_size_rank.begin(), saved_size_rank.end(), 0.0);
-    size_t ncomputed = std::accumulate(ncomputed_rank.begin(), ncomputed_rank.end(), 0.0);
-
-    double gib_saved = 8.0 * (double)saved_size / 1024.0 / 1024.0 / 1024.0;
-    double fraction = (double)ncomputed / grid_->blocks().size() * 100;
-    if (print_) {
-        outfile->Printf("  Cached %.1lf%% of DFT collocation blocks in %.3lf [GiB].\n\n", fraction, gib_saved);
+    std::map<std::string, SharedVector> ret;
+    ret["RHO"] = std::make_shared<Vector>("Atomic densities", natom);
+    ret["FUNCTIONAL"] = std::make_shared<Vector>("Atomic functional values", natom);
+    ret["TIME"] = std::make_shared<Vector>("Atomic integration times", natom);
+    for (size_t i = 0; i < num_threads_; i++) {
+        for (size_t A = 0; A < natom; A++) {
+            ret["RHO"]->add(A, rhoq[i][A]);
+            ret["FUNCTIONAL"]->add(A, functionalq[i][A]);
+            ret["TIME"]->add(A, timeq[i][A]);
+        }
     }
+    return ret;
 }
 void VBase::prepare_vv10_cache(DFTGrid& nlgrid, SharedMatrix D,
                                std::vector<std::map<std::string, SharedVector>>& vv10_cache,
@@ -833,7 +1129,7 @@ void VBase::prepare_vv10_cache(DFTGrid& nlgrid, SharedMatrix D,
     std::vector<std::map<std::string, SharedVector>> vv10_tmp_cache;
     vv10_tmp_cache.resize(nlgrid.blocks().size());
 
-#pragma omp parallel for private(rank) schedule(guided) num_threads(num_threads_)
+#pragma omp parallel for private(rank) schedule(dynamic) num_threads(num_threads_)
     for (size_t Q = 0; Q < nlgrid.blocks().size(); Q++) {
 // Get thread info
 #ifdef _OPENMP
@@ -851,44 +1147,113 @@ void VBase::prepare_vv10_cache(DFTGrid& nlgrid, SharedMatrix D,
             fworker->compute_vv10_cache(pworker->point_values(), block, vv10_rho_cutoff_, block->npoints(), false);
     }
 
-    // Stitch the cache together to make a single contiguous cache
+    // Stitch the cache together in the order of the spatial cells (a single cell without a cutoff radius)
     size_t total_size = 0;
-    for (auto cache : vv10_tmp_cache) {
+    for (auto& cache : vv10_tmp_cache) {
         total_size += cache["W"]->dimpi()[0];
     }
 
     // printf("VV10 NL Total size %zu\n", total_size);
 
-    // Leave this as a vector of maps in case we ever revisit the on-the fly manipulation
-    vv10_cache.resize(1);
-    vv10_cache[0]["W"] = std::make_shared<Vector>("W Grid points", total_size);
-    vv10_cache[0]["X"] = std::make_shared<Vector>("X Grid points", total_size);
-    vv10_cache[0]["Y"] = std::make_shared<Vector>("Y Grid points", total_size);
-    vv10_cache[0]["Z"] = std::make_shared<Vector>("Z Grid points", total_size);
-    vv10_cache[0]["RHO"] = std::make_shared<Vector>("RHO Grid points", total_size);
-    vv10_cache[0]["W0"] = std::make_shared<Vector>("W0 Grid points", total_size);
-    vv10_cache[0]["KAPPA"] = std::make_shared<Vector>("KAPPA Grid points", total_size);
-
-    double* w_vecp = vv10_cache[0]["W"]->pointer();
-    double* x_vecp = vv10_cache[0]["X"]->pointer();
-    double* y_vecp = vv10_cache[0]["Y"]->pointer();
-    double* z_vecp = vv10_cache[0]["Z"]->pointer();
-    double* rho_vecp = vv10_cache[0]["RHO"]->pointer();
-    double* w0_vecp = vv10_cache[0]["W0"]->pointer();
-    double* kappa_vecp = vv10_cache[0]["KAPPA"]->pointer();
+    double xmin[3] = {std::numeric_limits<double>::max(), std::numeric_limits<double>::max(),
+                      std::numeric_limits<double>::max()};
+    double xmax[3] = {std::numeric_limits<double>::lowest(), std::numeric_limits<double>::lowest(),
+                      std::numeric_limits<double>::lowest()};
+    for (auto& cache : vv10_tmp_cache) {
+        const char* keys[3] = {"X", "Y", "Z"};
+        size_t csize = cache["W"]->dimpi()[0];
+        for (int k = 0; k < 3; k++) {
+            double* xp = cache[keys[k]]->pointer();
+            for (size_t P = 0; P < csize; P++) {
+                xmin[k] = std::min(xmin[k], xp[P]);
+                xmax[k] = std::max(xmax[k], xp[P]);
+            }
+        }
+    }
 
-    size_t offset = 0;
-    for (auto cache : vv10_tmp_cache) {
+    size_t ncell[3] = {1, 1, 1};
+    if (vv10_radius_ > 0.0 && total_size) {
+        for (int k = 0; k < 3; k++) {
+            ncell[k] = static_cast<size_t>((xmax[k] - xmin[k]) / vv10_radius_) + 1;
+        }
+    }
+    auto cell_of = [&](double x, double y, double z) {
+        if (ncell[0] * ncell[1] * ncell[2] == 1) return size_t(0);
+        size_t ix = std::min(ncell[0] - 1, static_cast<size_t>((x - xmin[0]) / vv10_radius_));
+        size_t iy = std::min(ncell[1] - 1, static_cast<size_t>((y - xmin[1]) / vv10_radius_));
+        size_t iz = std::min(ncell[2] - 1, static_cast<size_t>((z - xmin[2]) / vv10_radius_));
+        return (ix * ncell[1] + iy) * ncell[2] + iz;
+    };
+
+    // Counting sort of the points into cells
+    std::vector<size_t> cell_start(ncell[0] * ncell[1] * ncell[2] + 1, 0);
+    for (auto& cache : vv10_tmp_cache) {
+        size_t csize = cache["W"]->dimpi()[0];
+        double* xp = cache["X"]->pointer();
+        double* yp = cache["Y"]->pointer();
+        double* zp = cache["Z"]->pointer();
+        for (size_t P = 0; P < csize; P++) {
+            cell_start[cell_of(xp[P], yp[P], zp[P]) + 1]++;
+        }
+    }
+    for (size_t c = 1; c < cell_start.size(); c++) {
+        cell_start[c] += cell_start[c - 1];
+    }
+
+    // Leave this as a vector of maps, one per non-empty cell
+    const std::vector<std::string> fields = {"W", "X", "Y", "Z", "RHO", "W0", "KAPPA"};
+    for (size_t c = 0; c + 1 < cell_start.size(); c++) {
+        size_t csize = cell_start[c + 1] - cell_start[c];
+        if (!csize) continue;
+        std::map<std::string, SharedVector> cell;
+        for (const auto& field : fields) {
+            cell[field] = std::make_shared<Vector>(field + " Grid points", csize);
+        }
+        vv10_cache.push_back(cell);
+    }
+
+    // Map the cells to their cache entry and scatter the points
+    std::vector<size_t> cell_entry(cell_start.size() - 1, 0);
+    std::vector<size_t> cell_fill(cell_start.size() - 1, 0);
+    for (size_t c = 0, entry = 0; c + 1 < cell_start.size(); c++) {
+        if (cell_start[c + 1] > cell_start[c]) cell_entry[c] = entry++;
+    }
+    for (auto& cache : vv10_tmp_cache) {
         size_t csize = cache["W"]->dimpi()[0];
-        C_DCOPY(csize, cache["W"]->pointer(), 1, (w_vecp + offset), 1);
-        C_DCOPY(csize, cache["X"]->pointer(), 1, (x_vecp + offset), 1);
-        C_DCOPY(csize, cache["Y"]->pointer(), 1, (y_vecp + offset), 1);
-        C_DCOPY(csize, cache["Z"]->pointer(), 1, (z_vecp + offset), 1);
-        C_DCOPY(csize, cache["RHO"]->pointer(), 1, (rho_vecp + offset), 1);
-        C_DCOPY(csize, cache["W0"]->pointer(), 1, (w0_vecp + offset), 1);
-        C_DCOPY(csize, cache["KAPPA"]->pointer(), 1, (kappa_vecp + offset), 1);
+        double* xp = cache["X"]->pointer();
+        double* yp = cache["Y"]->pointer();
+        double* zp = cache["Z"]->pointer();
+        for (size_t P = 0; P < csize; P++) {
+            size_t c = cell_of(xp[P], yp[P], zp[P]);
+            auto& cell = vv10_cache[cell_entry[c]];
+            size_t pos = cell_fill[c]++;
+            for (const auto& field : fields) {
+                cell[field]->pointer()[pos] = cache[field]->pointer()[P];
+            }
+        }
+    }
 
-        offset += csize;
+    // Bounding sphere of every cell, used by the kernel to skip distant cells
+    if (vv10_radius_ > 0.0) {
+        for (auto& cell : vv10_cache) {
+            size_t csize = cell["W"]->dimpi()[0];
+            double* xp = cell["X"]->pointer();
+            double* yp = cell["Y"]->pointer();
+            double* zp = cell["Z"]->pointer();
+            auto bound = std::make_shared<Vector>("Cell bound", 4);
+            double* bp = bound->pointer();
+            for (size_t P = 0; P < csize; P++) {
+                bp[0] += xp[P] / csize;
+                bp[1] += yp[P] / csize;
+                bp[2] += zp[P] / csize;
+            }
+            for (size_t P = 0; P < csize; P++) {
+                double R2 = (xp[P] - bp[0]) * (xp[P] - bp[0]) + (yp[P] - bp[1]) * (yp[P] - bp[1]) +
+                            (zp[P] - bp[2]) * (zp[P] - bp[2]);
+                bp[3] = std::max(bp[3], std::sqrt(R2));
+            }
+            cell["BOUND"] = bound;
+        }
     }
 }
 double VBase::vv10_nlc(SharedMatrix D, SharedMatrix ret) {
@@ -926,7 +1291,7 @@ double VBase::vv10_nlc(SharedMatrix D, SharedMatrix ret) {
 
 // => Compute the kernel <=
 // -11.948063
-#pragma omp parallel for private(rank) schedule(guided) num_threads(num_threads_)
+#pragma omp parallel for private(rank) schedule(dynamic) num_threads(num_threads_)
     for (size_t Q = 0; Q < nlgrid.blocks().size(); Q++) {
 // Get thread info
 #ifdef _OPENMP
@@ -945,7 +1310,8 @@ double VBase::vv10_nlc(SharedMatrix D, SharedMatrix ret) {
         std::map<std::string, SharedVector> vals = fworker->values();
 
         parallel_timer_on("Kernel", rank);
-        vv10_exc[rank] += fworker->compute_vv10_kernel(pworker->point_values(), vv10_cache, block);
+        vv10_exc[rank] +=
+            fworker->compute_vv10_kernel(pworker->point_values(), vv10_cache, block, -1, false, vv10_radius_);
         parallel_timer_off("Kernel", rank);
 
         parallel_timer_on("VV10 Fock", rank);
@@ -1017,7 +1383,7 @@ SharedMatrix VBase::vv10_nlc_gradient(SharedMatrix D) {
     }
 
 // => Compute the kernel <=
-#pragma omp parallel for private(rank) schedule(guided) num_threads(num_threads_)
+#pragma omp parallel for private(rank) schedule(dynamic) num_threads(num_threads_)
     for (size_t Q = 0; Q < nlgrid.blocks().size(); Q++) {
 // Get thread info
 #ifdef _OPENMP
@@ -1040,7 +1406,8 @@ SharedMatrix VBase::vv10_nlc_gradient(SharedMatrix D) {
         std::map<std::string, SharedVector> vals = fworker->values();
 
         parallel_timer_on("Kernel", rank);
-        vv10_exc[rank] += fworker->compute_vv10_kernel(pworker->point_values(), vv10_cache, block, npoints, true);
+        vv10_exc[rank] +=
+            fworker->compute_vv10_kernel(pworker->point_values(), vv10_cache, block, npoints, true, vv10_radius_);
         parallel_timer_off("Kernel", rank);
 
         parallel_timer_on("V_xc gradient", rank);
@@ -1098,14 +1465,16 @@ void SAP::initialize() {
     VBase::initialize();
     int max_points = grid_->max_points();
     int max_functions = grid_->max_functions();
-    for (size_t i = 0; i < num_threads_; i++) {
-        // Need a points worker per thread
+    // Need a points worker per thread
+    size_t offset = point_workers_.size();
+    point_workers_.resize(offset + num_threads_);
+    build_thread_workers([&](size_t i) {
         auto point_tmp = std::make_shared<SAPFunctions>(primary_, max_points, max_functions);
         // This is like LDA
         point_tmp->set_ansatz(0);
-        point_tmp->set_cache_map(&cache_map_);
-        point_workers_.push_back(point_tmp);
-    }
+        point_tmp->set_cache_map(cache_map_.get());
+        point_workers_[offset + i] = point_tmp;
+    });
 
     // Initialize symmetry
     auto integral = std::make_shared<IntegralFactory>(primary_);
@@ -1157,7 +1526,7 @@ void SAP::compute_V(std::vector<SharedMatrix> ret) {
     }
 
 // Traverse the blocks of points
-#pragma omp parallel for private(rank) schedule(guided) num_threads(num_threads_)
+#pragma omp parallel for private(rank) schedule(dynamic) num_threads(num_threads_)
     for (size_t Q = 0; Q < grid_->blocks().size(); Q++) {
 // Get thread info
 #ifdef _OPENMP
@@ -1176,28 +1545,26 @@ void SAP::compute_V(std::vector<SharedMatrix> ret) {
 
         // Compute the SAP potential
         parallel_timer_on("Functional", rank);
-        SharedVector sap_potential = std::make_shared<Vector>("sappot", block->npoints());
-        for (int ip = 0; ip < block->npoints(); ip++) {
-            // Coordinates of the point
-            double xi = block->x()[ip];
-            double yi = block->y()[ip];
-            double zi = block->z()[ip];
-            // and its potential
-            double V = 0.0;
-
-            // Loop over nuclei
-            for (size_t iatom = 0; iatom < nucx.size(); iatom++) {
-                // Distance to nucleus is
-                double dx = xi - nucx[iatom];
-                double dy = yi - nucy[iatom];
-                double dz = zi - nucz[iatom];
-                double r = sqrt(dx * dx + dy * dy + dz * dz);
-                // and the SAP potential at this point is
-                V -= ::sap_effective_charge(nucZ[iatom], r) / r;
+        int npoints = block->npoints();
+        SharedVector sap_potential = std::make_shared<Vector>("sappot", npoints);
+        double* sap_potentialp = sap_potential->pointer();
+        const double* xp = block->x();
+        const double* yp = block->y();
+        const double* zp = block->z();
+        std::vector<double> r(npoints), Zeff(npoints);
+
+        // Loop over nuclei, evaluating the effective charge of each at all points of the block at once
+        for (size_t iatom = 0; iatom < nucx.size(); iatom++) {
+            // Distance of the points to the nucleus
+            for (int ip = 0; ip < npoints; ip++) {
+                double dx = xp[ip] - nucx[iatom];
+                double dy = yp[ip] - nucy[iatom];
+                double dz = zp[ip] - nucz[iatom];
+                r[ip] = std::sqrt(dx * dx + dy * dy + dz * dz);
             }
-
-            // Store
-            (*sap_potential)[ip] = V;
+            // and the SAP potential at these points is
+            ::sap_effective_charges(nucZ[iatom], npoints, r.data(), Zeff.data());
+            for (int ip = 0; ip < npoints; ip++) sap_potentialp[ip] -= Zeff[ip] / r[ip];
         }
 
         parallel_timer_off("Functional", rank);
@@ -1248,13 +1615,26 @@ void RV::initialize() {
     VBase::initialize();
     int max_points = grid_->max_points();
     int max_functions = grid_->max_functions();
-    for (size_t i = 0; i < num_threads_; i++) {
-        // Need a points worker per thread
+    // Need a points worker per thread
+    size_t offset = point_workers_.size();
+    point_workers_.resize(offset + num_threads_);
+    build_thread_workers([&](size_t i) {
         auto point_tmp = std::make_shared<RKSFunctions>(primary_, max_points, max_functions);
         point_tmp->set_ansatz(functional_->ansatz());
-        point_tmp->set_cache_map(&cache_map_);
-        point_workers_.push_back(point_tmp);
-    }
+        point_tmp->set_cache_map(cache_map_.get());
+        point_workers_[offset + i] = point_tmp;
+    });
+
+    // Extra workers holding the remaining blocks of each thread's batch
+    batch_point_workers_.resize(num_threads_ * (block_batch_ - 1));
+    build_thread_workers([&](size_t i) {
+        for (size_t b = 1; b < block_batch_; b++) {
+            auto point_tmp = std::make_shared<RKSFunctions>(primary_, max_points, max_functions);
+            point_tmp->set_ansatz(functional_->ansatz());
+            point_tmp->set_cache_map(cache_map_.get());
+            batch_point_workers_[i * (block_batch_ - 1) + b - 1] = point_tmp;
+        }
+    });
 }
 void RV::finalize() { VBase::finalize(); }
 void RV::print_header() const { VBase::print_header(); }
@@ -1310,6 +1690,12 @@ void RV::compute_V(std::vector<SharedMatrix> ret) {
     for (size_t i = 0; i < num_threads_; i++) {
         point_workers_[i]->set_pointers(D_AO_[0]);
     }
+    for (auto& pworker : batch_point_workers_) {
+        pworker->set_pointers(D_AO_[0]);
+    }
+    build_batch_functional_workers();
+    auto active_blocks = screen_blocks();
+    size_t nbatch = (active_blocks.size() + block_batch_ - 1) / block_batch_;
 
     // Per thread temporaries
     std::vector<SharedMatrix> V_local;
@@ -1330,64 +1716,91 @@ void RV::compute_V(std::vector<SharedMatrix> ret) {
 
     // => Compute V <=
 // Traverse the blocks of points
-#pragma omp parallel for private(rank) schedule(guided) num_threads(num_threads_)
-    for (size_t Q = 0; Q < grid_->blocks().size(); Q++) {
-        // ==> Define block/thread-specific variables <==
+#pragma omp parallel for private(rank) schedule(dynamic) num_threads(num_threads_)
+    for (size_t batch = 0; batch < nbatch; batch++) {
+        // ==> Define batch/thread-specific variables <==
 #ifdef _OPENMP
         rank = omp_get_thread_num();
 #endif
+        size_t Qstart = batch * block_batch_;
+        size_t Qstop = std::min(Qstart + block_batch_, active_blocks.size());
 
         // Get per-rank workers
-        auto block = grid_->blocks()[Q];
         auto fworker = functional_workers_[rank];
-        auto pworker = point_workers_[rank];
 
-        // ==> Compute rho, gamma, etc. for block <==
+        // ==> Compute rho, gamma, etc. for each block of the batch <==
         parallel_timer_on("Properties", rank);
-        pworker->compute_points(block, false);
+        std::vector<bool> reuse(Qstop - Qstart);
+        for (size_t Q = Qstart; Q < Qstop; Q++) {
+            auto pworker = batch_point_worker(rank, Q - Qstart);
+            pworker->compute_points(grid_->blocks()[active_blocks[Q]], false);
+            record_block_density(active_blocks[Q], pworker);
+            reuse[Q - Qstart] = block_xc_unchanged(active_blocks[Q], pworker);
+        }
+        bool batch_reused = std::all_of(reuse.begin(), reuse.end(), [](bool r) { return r; });
         parallel_timer_off("Properties", rank);
 
-        // ==> Compute functional values for block <==
+        // ==> Compute functional values for the batch <==
         parallel_timer_on("Functional", rank);
-        fworker->compute_functional(pworker->point_values());
+        if (batch_reused) {
+            // Every block of the batch keeps its stored contribution
+        } else if (Qstop - Qstart == 1) {
+            fworker->compute_functional(point_workers_[rank]->point_values());
+        } else {
+            compute_functional_batch(rank, active_blocks, Qstart, Qstop);
+        }
         parallel_timer_off("Functional", rank);
 
-        if (debug_ > 4) {
-            block->print("outfile", debug_);
-            pworker->print("outfile", debug_);
-        }
+        for (size_t Q = Qstart; Q < Qstop; Q++) {
+            auto block = grid_->blocks()[active_blocks[Q]];
+            auto pworker = batch_point_worker(rank, Q - Qstart);
 
-        parallel_timer_on("V_xc", rank);
+            if (debug_ > 4) {
+                block->print("outfile", debug_);
+                pworker->print("outfile", debug_);
+            }
 
-        // ==> Compute quadrature values <== //
-        auto qvals = dft_integrators::rks_quadrature_integrate(block, fworker, pworker);
-        functionalq[rank] += qvals[0];
-        rhoaq[rank] += qvals[1];
-        rhoaxq[rank] += qvals[2];
-        rhoayq[rank] += qvals[3];
-        rhoazq[rank] += qvals[4];
+            parallel_timer_on("V_xc", rank);
 
-        // ==> LSDA, GGA, and meta contribution (symmetrized) <== //
-        dft_integrators::rks_integrator(block, fworker, pworker, V_local[rank]);
+            std::vector<double> qvals;
+            if (reuse[Q - Qstart]) {
+                // ==> Density unchanged since the stored contribution was built <== //
+                qvals = restore_block_xc(active_blocks[Q], {V_local[rank]});
+            } else {
+                if (Qstop - Qstart > 1) scatter_functional_batch(rank, active_blocks, Qstart, Q);
 
-        // ==> Unpacking <== //
-        auto V2p = V_local[rank]->pointer();
-        const auto& function_map = block->functions_local_to_global();
-        int nlocal = function_map.size();
+                // ==> Compute quadrature values <== //
+                qvals = dft_integrators::rks_quadrature_integrate(block, fworker, pworker);
 
-        for (int ml = 0; ml < nlocal; ml++) {
-            int mg = function_map[ml];
-            for (int nl = 0; nl < ml; nl++) {
-                int ng = function_map[nl];
-#pragma omp atomic update
-                Vp[mg][ng] += V2p[ml][nl];
-#pragma omp atomic update
-                Vp[ng][mg] += V2p[ml][nl];
+                // ==> LSDA, GGA, and meta contribution (symmetrized) <== //
+                dft_integrators::rks_integrator(block, fworker, pworker, V_local[rank]);
+                store_block_xc(active_blocks[Q], pworker, {V_local[rank]}, qvals);
             }
-#pragma omp atomic update
-            Vp[mg][mg] += V2p[ml][ml];
+            functionalq[rank] += qvals[0];
+            rhoaq[rank] += qvals[1];
+            rhoaxq[rank] += qvals[2];
+            rhoayq[rank] += qvals[3];
+            rhoazq[rank] += qvals[4];
+
+            // ==> Unpacking <== //
+            auto V2p = V_local[rank]->pointer();
+            const auto& function_map = block->functions_local_to_global();
+            int nlocal = function_map.size();
+
+            for (int ml = 0; ml < nlocal; ml++) {
+                int mg = function_map[ml];
+                for (int nl = 0; nl < ml; nl++) {
+                    int ng = function_map[nl];
+    #pragma omp atomic update
+                    Vp[mg][ng] += V2p[ml][nl];
+    #pragma omp atomic update
+                    Vp[ng][mg] += V2p[ml][nl];
+                }
+    #pragma omp atomic update
+                Vp[mg][mg] += V2p[ml][ml];
+            }
+            parallel_timer_off("V_xc", rank);
         }
-        parallel_timer_off("V_xc", rank);
     }
 
     // Do we need VV10?
@@ -1484,7 +1897,7 @@ std::vector<SharedMatrix> RV::compute_fock_derivatives() {
     }
 
 // Traverse the blocks of points
-#pragma omp parallel for private(rank) schedule(guided) num_threads(num_threads_)
+#pragma omp parallel for private(rank) schedule(dynamic) num_threads(num_threads_)
     for (size_t Q = 0; Q < grid_->blocks().size(); Q++) {
 // Get thread info
 #ifdef _OPENMP
@@ -1722,11 +2135,16 @@ void RV::compute_Vx_full(std::vector<SharedMatrix> Dx, std::vector<SharedMatrix>
     }
 
     // Per [R]ank quantities
-    std::vector<SharedMatrix> R_Vx_local, R_Dx_local;
+    // The rotated densities of a batch and, afterwards, its Vx blocks share R_DVx_local, each stored side by side
+    const size_t vx_batch = std::min(vx_batch_, Dx.size());
+    std::vector<SharedMatrix> R_DVx_local, R_T_local;
+    std::vector<std::vector<double*>> R_T_rows, R_Vx_rows;
     std::vector<std::shared_ptr<Vector>> R_rho_k, R_rho_k_x, R_rho_k_y, R_rho_k_z, R_gamma_k;
     for (size_t i = 0; i < num_threads_; i++) {
-        R_Vx_local.push_back(std::make_shared<Matrix>("Vx Temp", max_functions, max_functions));
-        R_Dx_local.push_back(std::make_shared<Matrix>("Dk Temp", max_functions, max_functions));
+        R_DVx_local.push_back(std::make_shared<Matrix>("DVx Temp", max_functions, vx_batch * max_functions));
+        R_T_local.push_back(std::make_shared<Matrix>("T Temp", max_points, vx_batch * max_functions));
+        R_T_rows.emplace_back(max_points);
+        R_Vx_rows.emplace_back(max_functions);
 
         R_rho_k.push_back(std::make_shared<Vector>("Rho K Temp", max_points));
 
@@ -1749,7 +2167,7 @@ void RV::compute_Vx_full(std::vector<SharedMatrix> Dx, std::vector<SharedMatrix>
 
     // => Compute Vx <=
     // Remember that this function computes the α block of the output, divided by 2.
-#pragma omp parallel for private(rank) schedule(guided) num_threads(num_threads_)
+#pragma omp parallel for private(rank) schedule(dynamic) num_threads(num_threads_)
     for (size_t Q = 0; Q < grid_->blocks().size(); Q++) {
         // ==> Define block/thread-specific variables <==
 #ifdef _OPENMP
@@ -1759,11 +2177,8 @@ void RV::compute_Vx_full(std::vector<SharedMatrix> Dx, std::vector<SharedMatrix>
         // => Setup <= //
         auto fworker = functional_workers_[rank];
         auto pworker = point_workers_[rank];
-        auto Vx_localp = R_Vx_local[rank]->pointer();
-        auto Dx_localp = R_Dx_local[rank]->pointer();
-
-        // => Compute blocks <= //
-        auto Tp = pworker->scratch()[0]->pointer();
+        auto DVwp = R_DVx_local[rank]->pointer()[0];
+        auto Twp = R_T_local[rank]->pointer()[0];
 
         auto block = grid_->blocks()[Q];
         auto npoints = block->npoints();
@@ -1816,133 +2231,153 @@ void RV::compute_Vx_full(std::vector<SharedMatrix> Dx, std::vector<SharedMatrix>
         // Meta
         // Forget that!
 
-        // ==> Compute Vx contribution for each x <==
-        for (size_t dindex = 0; dindex < Dx_vec.size(); dindex++) {
-            auto Dxp = Dx_vec[dindex]->pointer();
-
-            // ===> Build Rotated Densities <=== //
-            for (int ml = 0; ml < nlocal; ml++) {
-                int mg = function_map[ml];
-                for (int nl = 0; nl < nlocal; nl++) {
-                    int ng = function_map[nl];
-                    Dx_localp[ml][nl] = Dxp[mg][ng];
+        // ==> Compute Vx contribution for each x, a batch of x at a time <==
+        for (size_t dstart = 0; dstart < Dx_vec.size(); dstart += vx_batch) {
+            const size_t nbatch = std::min(vx_batch, Dx_vec.size() - dstart);
+            const int ldw = nbatch * nlocal;
+
+            // ===> Build Rotated Densities, symmetrized and side by side <=== //
+            for (size_t k = 0; k < nbatch; k++) {
+                auto Dxp = Dx_vec[dstart + k]->pointer();
+                for (int ml = 0; ml < nlocal; ml++) {
+                    int mg = function_map[ml];
+                    for (int nl = 0; nl < nlocal; nl++) {
+                        int ng = function_map[nl];
+                        DVwp[ml * ldw + k * nlocal + nl] = Dxp[mg][ng] + Dxp[ng][mg];
+                    }
                 }
             }
 
-            // ===> Compute quantities using effective densities <===
-            // N.B. We spin-sum over true density spin-indices, never effective density spin-indices. 
-            // T := einsum("pm, mn -> pn", φ, add_trans(Dk, (1, 0, 2)))
+            // T := einsum("pm, mn -> pn", φ, add_trans(Dk, (1, 0, 2))) for the whole batch
             parallel_timer_on("Derivative Properties", rank);
-            C_DGEMM('N', 'N', npoints, nlocal, nlocal, 1.0, phi[0], coll_funcs, Dx_localp[0], max_functions, 0.0, Tp[0],
-                    max_functions);
-            C_DGEMM('N', 'T', npoints, nlocal, nlocal, 1.0, phi[0], coll_funcs, Dx_localp[0], max_functions, 1.0, Tp[0],
-                    max_functions);
-
-            // ρk = einsum("mn, pm, pn -> pσ", Dk, φ, φ)
-            // ρk = 1/2 * add_trans(ρκ, (1, 0, 2))
-            for (int P = 0; P < npoints; P++) {
-                rho_k[P] = 0.5 * C_DDOT(nlocal, phi[P], 1, Tp[P], 1);
-            }
+            C_DGEMM('N', 'N', npoints, ldw, nlocal, 1.0, phi[0], coll_funcs, DVwp, ldw, 0.0, Twp, ldw);
+            parallel_timer_off("Derivative Properties", rank);
 
-            // ∇ρk = einsum("mn, pm, pn -> p", add_trans(Dk, (1, 0, 2)), ∇φ, φ)
-            //  Γk = add_trans(einsum("xp, xp -> p", ∇ρk, ∇ρ), (0, 2, 1))
-            //      ...2x the size of UKS alpha-spin counterpart thanks to spin-summing of ∇ρ
-            if (ansatz >= 1) {
+            for (size_t k = 0; k < nbatch; k++) {
+                auto Tp = R_T_rows[rank].data();
                 for (int P = 0; P < npoints; P++) {
-                    rho_k_x[P] = C_DDOT(nlocal, phi_x[P], 1, Tp[P], 1);
-                    rho_k_y[P] = C_DDOT(nlocal, phi_y[P], 1, Tp[P], 1);
-                    rho_k_z[P] = C_DDOT(nlocal, phi_z[P], 1, Tp[P], 1);
-                    gamma_k[P] = rho_k_x[P] * rho_x[P];
-                    gamma_k[P] += rho_k_y[P] * rho_y[P];
-                    gamma_k[P] += rho_k_z[P] * rho_z[P];
-                    gamma_k[P] *= 2;
+                    Tp[P] = Twp + P * ldw + k * nlocal;
                 }
-            }
-            parallel_timer_off("Derivative Properties", rank);
 
-            // ===> LSDA contribution <=== //
-            //                                         ∂^2
-            // T := 1/2 einsum("p, p, pm, p -> pm", w, ---- f , ρk, φ)
-            //                                         ∂ρ^2
-            parallel_timer_on("V_XCd", rank);
-            for (int P = 0; P < npoints; P++) {
-                std::fill(Tp[P], Tp[P] + nlocal, 0.0);
-                // Do a simple screen: ignore contributions where rho is too small.
-                if (rho_a[P] < v2_rho_cutoff_) continue;
-                C_DAXPY(nlocal, 0.5 * v2_rho2[P] * w[P] * rho_k[P], phi[P], 1, Tp[P], 1);
-            }
+                // ===> Compute quantities using effective densities <===
+                // N.B. We spin-sum over true density spin-indices, never effective density spin-indices. 
+                parallel_timer_on("Derivative Properties", rank);
 
-            // ===> GGA contribution <=== //
-            if (ansatz >= 1) {
-                // ====> Define pointers for future use <====
-                auto v_gamma = vals["V_GAMMA_AA"]->pointer();
-                auto v2_gamma_gamma = vals["V_GAMMA_AA_GAMMA_AA"]->pointer();
-                auto v2_rho_gamma = vals["V_RHO_A_GAMMA_AA"]->pointer();
-                double tmp_val = 0.0, v2_val = 0.0;
+                // ρk = einsum("mn, pm, pn -> pσ", Dk, φ, φ)
+                // ρk = 1/2 * add_trans(ρκ, (1, 0, 2))
+                for (int P = 0; P < npoints; P++) {
+                    rho_k[P] = 0.5 * C_DDOT(nlocal, phi[P], 1, Tp[P], 1);
+                }
+
+                // ∇ρk = einsum("mn, pm, pn -> p", add_trans(Dk, (1, 0, 2)), ∇φ, φ)
+                //  Γk = add_trans(einsum("xp, xp -> p", ∇ρk, ∇ρ), (0, 2, 1))
+                //      ...2x the size of UKS alpha-spin counterpart thanks to spin-summing of ∇ρ
+                if (ansatz >= 1) {
+                    for (int P = 0; P < npoints; P++) {
+                        rho_k_x[P] = C_DDOT(nlocal, phi_x[P], 1, Tp[P], 1);
+                        rho_k_y[P] = C_DDOT(nlocal, phi_y[P], 1, Tp[P], 1);
+                        rho_k_z[P] = C_DDOT(nlocal, phi_z[P], 1, Tp[P], 1);
+                        gamma_k[P] = rho_k_x[P] * rho_x[P];
+                        gamma_k[P] += rho_k_y[P] * rho_y[P];
+                        gamma_k[P] += rho_k_z[P] * rho_z[P];
+                        gamma_k[P] *= 2;
+                    }
+                }
+                parallel_timer_off("Derivative Properties", rank);
 
-                // There are lots of GGA terms.
+                // ===> LSDA contribution <=== //
+                //                                         ∂^2
+                // T := 1/2 einsum("p, p, pm, p -> pm", w, ---- f , ρk, φ)
+                //                                         ∂ρ^2
+                parallel_timer_on("V_XCd", rank);
                 for (int P = 0; P < npoints; P++) {
+                    std::fill(Tp[P], Tp[P] + nlocal, 0.0);
+                    // Do a simple screen: ignore contributions where rho is too small.
                     if (rho_a[P] < v2_rho_cutoff_) continue;
+                    C_DAXPY(nlocal, 0.5 * v2_rho2[P] * w[P] * rho_k[P], phi[P], 1, Tp[P], 1);
+                }
+
+                // ===> GGA contribution <=== //
+                if (ansatz >= 1) {
+                    // ====> Define pointers for future use <====
+                    auto v_gamma = vals["V_GAMMA_AA"]->pointer();
+                    auto v2_gamma_gamma = vals["V_GAMMA_AA_GAMMA_AA"]->pointer();
+                    auto v2_rho_gamma = vals["V_RHO_A_GAMMA_AA"]->pointer();
+                    double tmp_val = 0.0, v2_val = 0.0;
 
-                    // ====> Term 2b, V in DOI: 10.1063/1.466887 <====
-                    //                                         ∂^2
-                    // T += 1/2 einsum("p, p, p, pr -> pr", w, ---- f, Γk, φ)
-                    //                                         ∂ρ∂γ
-                    // V contributions
-                    C_DAXPY(nlocal, (0.5 * w[P] * v2_rho_gamma[P] * gamma_k[P]), phi[P], 1, Tp[P], 1);
-
-                    // ====> All other terms, W in above DOI  <==== //
-                    //                            ∂^2
-                    // temp = einsum("p, p -> p", ---- f, ρk)
-                    //                            ∂ρ∂γ
-                    //                             ∂^2
-                    // temp += einsum("p, p -> p", ---- f, Γk)
-                    //                             ∂γ∂γ
+                    // There are lots of GGA terms.
+                    for (int P = 0; P < npoints; P++) {
+                        if (rho_a[P] < v2_rho_cutoff_) continue;
+
+                        // ====> Term 2b, V in DOI: 10.1063/1.466887 <====
+                        //                                         ∂^2
+                        // T += 1/2 einsum("p, p, p, pr -> pr", w, ---- f, Γk, φ)
+                        //                                         ∂ρ∂γ
+                        // V contributions
+                        C_DAXPY(nlocal, (0.5 * w[P] * v2_rho_gamma[P] * gamma_k[P]), phi[P], 1, Tp[P], 1);
+
+                        // ====> All other terms, W in above DOI  <==== //
+                        //                            ∂^2
+                        // temp = einsum("p, p -> p", ---- f, ρk)
+                        //                            ∂ρ∂γ
+                        //                             ∂^2
+                        // temp += einsum("p, p -> p", ---- f, Γk)
+                        //                             ∂γ∂γ
                     
-                    // Define Γk terms in 3 intermediate
-                    v2_val = (v2_rho_gamma[P] * rho_k[P] + v2_gamma_gamma[P] * gamma_k[P]);
+                        // Define Γk terms in 3 intermediate
+                        v2_val = (v2_rho_gamma[P] * rho_k[P] + v2_gamma_gamma[P] * gamma_k[P]);
 
-                    //                                      ∂
-                    // temp2 = einsum("p, p, xp -> xpσ", w, -- f, ∇ρk)
-                    //                                      ∂Γ
-                    // temp2 += einsum("p, p, x -> xp", w, temp, ∇ρ)
-                    // T += einsum("xp, xpm -> pm", temp2, ∇φ)
+                        //                                      ∂
+                        // temp2 = einsum("p, p, xp -> xpσ", w, -- f, ∇ρk)
+                        //                                      ∂Γ
+                        // temp2 += einsum("p, p, x -> xp", w, temp, ∇ρ)
+                        // T += einsum("xp, xpm -> pm", temp2, ∇φ)
 
-                    tmp_val = 2.0 * w[P] * (v_gamma[P] * rho_k_x[P] + v2_val * rho_x[P]);
-                    C_DAXPY(nlocal, tmp_val, phi_x[P], 1, Tp[P], 1);
+                        tmp_val = 2.0 * w[P] * (v_gamma[P] * rho_k_x[P] + v2_val * rho_x[P]);
+                        C_DAXPY(nlocal, tmp_val, phi_x[P], 1, Tp[P], 1);
 
-                    tmp_val = 2.0 * w[P] * (v_gamma[P] * rho_k_y[P] + v2_val * rho_y[P]);
-                    C_DAXPY(nlocal, tmp_val, phi_y[P], 1, Tp[P], 1);
+                        tmp_val = 2.0 * w[P] * (v_gamma[P] * rho_k_y[P] + v2_val * rho_y[P]);
+                        C_DAXPY(nlocal, tmp_val, phi_y[P], 1, Tp[P], 1);
 
-                    tmp_val = 2.0 * w[P] * (v_gamma[P] * rho_k_z[P] + v2_val * rho_z[P]);
-                    C_DAXPY(nlocal, tmp_val, phi_z[P], 1, Tp[P], 1);
+                        tmp_val = 2.0 * w[P] * (v_gamma[P] * rho_k_z[P] + v2_val * rho_z[P]);
+                        C_DAXPY(nlocal, tmp_val, phi_z[P], 1, Tp[P], 1);
+                    }
                 }
+
+                parallel_timer_off("V_XCd", rank);
             }
 
-            // ===> Contract Ta and Tb aginst φ, replacing a point index with  an AO index <===
-            C_DGEMM('T', 'N', nlocal, nlocal, npoints, 1.0, phi[0], coll_funcs, Tp[0], max_functions, 0.0, Vx_localp[0],
-                    max_functions);
+            // ===> Contract T aginst φ, replacing a point index with an AO index, for the whole batch <===
+            parallel_timer_on("V_XCd", rank);
+            C_DGEMM('T', 'N', nlocal, ldw, npoints, 1.0, phi[0], coll_funcs, Twp, ldw, 0.0, DVwp, ldw);
 
-            // ===> Add the adjoint to complete the LDA and GGA contributions  <===
-            for (int m = 0; m < nlocal; m++) {
-                for (int n = 0; n <= m; n++) {
-                    Vx_localp[m][n] = Vx_localp[n][m] = Vx_localp[m][n] + Vx_localp[n][m];
+            for (size_t k = 0; k < nbatch; k++) {
+                auto Vx_localp = R_Vx_rows[rank].data();
+                for (int m = 0; m < nlocal; m++) {
+                    Vx_localp[m] = DVwp + m * ldw + k * nlocal;
                 }
-            }
 
-            // => Unpacking <= //
-            auto Vxp = Vx_AO[dindex]->pointer();
-            for (int ml = 0; ml < nlocal; ml++) {
-                int mg = function_map[ml];
-                for (int nl = 0; nl < ml; nl++) {
-                    int ng = function_map[nl];
+                // ===> Add the adjoint to complete the LDA and GGA contributions  <===
+                for (int m = 0; m < nlocal; m++) {
+                    for (int n = 0; n <= m; n++) {
+                        Vx_localp[m][n] = Vx_localp[n][m] = Vx_localp[m][n] + Vx_localp[n][m];
+                    }
+                }
+
+                // => Unpacking <= //
+                auto Vxp = Vx_AO[dstart + k]->pointer();
+                for (int ml = 0; ml < nlocal; ml++) {
+                    int mg = function_map[ml];
+                    for (int nl = 0; nl < ml; nl++) {
+                        int ng = function_map[nl];
 #pragma omp atomic update
-                    Vxp[mg][ng] += Vx_localp[ml][nl];
+                        Vxp[mg][ng] += Vx_localp[ml][nl];
 #pragma omp atomic update
-                    Vxp[ng][mg] += Vx_localp[ml][nl];
-                }
+                        Vxp[ng][mg] += Vx_localp[ml][nl];
+                    }
 #pragma omp atomic update
-                Vxp[mg][mg] += Vx_localp[ml][ml];
+                    Vxp[mg][mg] += Vx_localp[ml][ml];
+                }
             }
             parallel_timer_off("V_XCd", rank);
         }
@@ -1989,15 +2424,17 @@ SharedMatrix RV::compute_gradient() {
     int max_points = grid_->max_points();
 
     // Setup the pointers
+    int deriv = (functional_->is_gga() || functional_->is_meta() ? 2 : 1);
     for (size_t i = 0; i < num_threads_; i++) {
         point_workers_[i]->set_pointers(D_AO_[0]);
-        point_workers_[i]->set_deriv((functional_->is_gga() || functional_->is_meta() ? 2 : 1));
+        point_workers_[i]->set_deriv(deriv);
     }
+    bool use_cache = collocation_cache_covers(deriv);
 
-    // Per thread temporaries
-    std::vector<SharedMatrix> G_local, U_local;
+    // Per thread temporaries, the blocks scatter straight into G
+    auto G = std::make_shared<Matrix>("XC Gradient", natom, 3);
+    std::vector<SharedMatrix> U_local;
     for (size_t i = 0; i < num_threads_; i++) {
-        G_local.push_back(std::make_shared<Matrix>("G Temp", natom, 3));
         U_local.push_back(std::make_shared<Matrix>("U Temp", max_points, max_functions));
     }
 
@@ -2022,7 +2459,7 @@ SharedMatrix RV::compute_gradient() {
 
         // ==> Compute rho, gamma, etc. for block <== //
         parallel_timer_on("Properties", rank);
-        pworker->compute_points(block);
+        pworker->compute_points(block, !use_cache);
         parallel_timer_off("Properties", rank);
 
         // ==> Compute functional values for block <== //
@@ -2041,17 +2478,11 @@ SharedMatrix RV::compute_gradient() {
         rhoazq[rank] += qvals[4];
 
         // => Integrate all contributions into G <= //
-        dft_integrators::rks_gradient_integrator(primary_, block, fworker, pworker, G_local[rank], U_local[rank]);
+        dft_integrators::rks_gradient_integrator(primary_, block, fworker, pworker, G, U_local[rank]);
 
         parallel_timer_off("V_xc gradient", rank);
     }
 
-    // Sum up the matrix
-    auto G = std::make_shared<Matrix>("XC Gradient", natom, 3);
-    for (auto const& val : G_local) {
-        G->add(val);
-    }
-
     quad_values_["FUNCTIONAL"] = std::accumulate(functionalq.begin(), functionalq.end(), 0.0);
     quad_values_["RHO_A"] = std::accumulate(rhoaq.begin(), rhoaq.end(), 0.0);
     quad_values_["RHO_AX"] = std::accumulate(rhoaxq.begin(), rhoaxq.end(), 0.0);
@@ -2128,6 +2559,7 @@ SharedMatrix RV::compute_hessian() {
         functional_workers_[i]->set_deriv(derivlev);
         functional_workers_[i]->allocate();
     }
+    bool use_cache = collocation_cache_covers(derivlev);
 
     // ==> Per thread temporaries <==
     std::vector<SharedMatrix> V_local;
@@ -2195,7 +2627,7 @@ SharedMatrix RV::compute_hessian() {
         int nlocal = function_map.size();
 
         // ==> Compute values at points <==
-        pworker->compute_points(block);
+        pworker->compute_points(block, !use_cache);
         auto& vals = fworker->compute_functional(pworker->point_values(), npoints);
 
         auto phi = pworker->basis_value("PHI")->pointer();
@@ -2582,13 +3014,26 @@ void UV::initialize() {
     VBase::initialize();
     int max_points = grid_->max_points();
     int max_functions = grid_->max_functions();
-    for (size_t i = 0; i < num_threads_; i++) {
-        // Need a points worker per thread
+    // Need a points worker per thread
+    size_t offset = point_workers_.size();
+    point_workers_.resize(offset + num_threads_);
+    build_thread_workers([&](size_t i) {
         std::shared_ptr<PointFunctions> point_tmp = std::make_shared<UKSFunctions>(primary_, max_points, max_functions);
         point_tmp->set_ansatz(functional_->ansatz());
-        point_tmp->set_cache_map(&cache_map_);
-        point_workers_.push_back(point_tmp);
-    }
+        point_tmp->set_cache_map(cache_map_.get());
+        point_workers_[offset + i] = point_tmp;
+    });
+
+    // Extra workers holding the remaining blocks of each thread's batch
+    batch_point_workers_.resize(num_threads_ * (block_batch_ - 1));
+    build_thread_workers([&](size_t i) {
+        for (size_t b = 1; b < block_batch_; b++) {
+            auto point_tmp = std::make_shared<UKSFunctions>(primary_, max_points, max_functions);
+            point_tmp->set_ansatz(functional_->ansatz());
+            point_tmp->set_cache_map(cache_map_.get());
+            batch_point_workers_[i * (block_batch_ - 1) + b - 1] = point_tmp;
+        }
+    });
 }
 void UV::finalize() { VBase::finalize(); }
 void UV::print_header() const { VBase::print_header(); }
@@ -2646,6 +3091,12 @@ void UV::compute_V(std::vector<SharedMatrix> ret) {
     for (size_t i = 0; i < num_threads_; i++) {
         point_workers_[i]->set_pointers(D_AO_[0], D_AO_[1]);
     }
+    for (auto& pworker : batch_point_workers_) {
+        pworker->set_pointers(D_AO_[0], D_AO_[1]);
+    }
+    build_batch_functional_workers();
+    auto active_blocks = screen_blocks();
+    size_t nbatch = (active_blocks.size() + block_batch_ - 1) / block_batch_;
 
     // Per thread temporaries
     std::vector<SharedMatrix> Va_local, Vb_local;
@@ -2673,197 +3124,227 @@ void UV::compute_V(std::vector<SharedMatrix> ret) {
     std::vector<double> rhobzq(num_threads_);
 
     // => Compute V <=
-#pragma omp parallel for private(rank) schedule(guided) num_threads(num_threads_)
-    for (size_t Q = 0; Q < grid_->blocks().size(); Q++) {
-        // ==> Define block/thread-specific variables <==
+#pragma omp parallel for private(rank) schedule(dynamic) num_threads(num_threads_)
+    for (size_t batch = 0; batch < nbatch; batch++) {
+        // ==> Define batch/thread-specific variables <==
 #ifdef _OPENMP
         rank = omp_get_thread_num();
 #endif
+        size_t Qstart = batch * block_batch_;
+        size_t Qstop = std::min(Qstart + block_batch_, active_blocks.size());
 
         auto fworker = functional_workers_[rank];
-        auto pworker = point_workers_[rank];
-        auto Va2p = Va_local[rank]->pointer();
-        auto Vb2p = Vb_local[rank]->pointer();
-        auto QTap = Qa_temp[rank]->pointer();
-        auto QTbp = Qb_temp[rank]->pointer();
-
-        // Scratch
-        auto Tap = pworker->scratch()[0]->pointer();
-        auto Tbp = pworker->scratch()[1]->pointer();
-
-        auto block = grid_->blocks()[Q];
-        auto npoints = block->npoints();
-        auto x = block->x();
-        auto y = block->y();
-        auto z = block->z();
-        auto w = block->w();
-        const auto& function_map = block->functions_local_to_global();
-        auto nlocal = function_map.size();
 
-        // ==> Compute rho, gamma, etc. for block <==
+        // ==> Compute rho, gamma, etc. for each block of the batch <==
         parallel_timer_on("Properties", rank);
-        pworker->compute_points(block, false);
+        std::vector<bool> reuse(Qstop - Qstart);
+        for (size_t Q = Qstart; Q < Qstop; Q++) {
+            auto pworker = batch_point_worker(rank, Q - Qstart);
+            pworker->compute_points(grid_->blocks()[active_blocks[Q]], false);
+            record_block_density(active_blocks[Q], pworker);
+            reuse[Q - Qstart] = block_xc_unchanged(active_blocks[Q], pworker);
+        }
+        bool batch_reused = std::all_of(reuse.begin(), reuse.end(), [](bool r) { return r; });
         parallel_timer_off("Properties", rank);
 
-        // ==> Compute functional values for block <==
+        // ==> Compute functional values for the batch <==
         parallel_timer_on("Functional", rank);
-        auto& vals = fworker->compute_functional(pworker->point_values(), npoints);
-        parallel_timer_off("Functional", rank);
-
-        if (debug_ > 3) {
-            block->print("outfile", debug_);
-            pworker->print("outfile", debug_);
-        }
-
-        // ==> Define pointers to intermediates <==
-        parallel_timer_on("V_xc", rank);
-        auto phi = pworker->basis_value("PHI")->pointer();
-        auto rho_a = pworker->point_value("RHO_A")->pointer();
-        auto rho_b = pworker->point_value("RHO_B")->pointer();
-        auto zk = vals["V"]->pointer();
-        auto v_rho_a = vals["V_RHO_A"]->pointer();
-        auto v_rho_b = vals["V_RHO_B"]->pointer();
-        auto coll_funcs = pworker->basis_value("PHI")->ncol();
-
-        // ==> Compute quadrature values <== //
-        functionalq[rank] += C_DDOT(npoints, w, 1, zk, 1);
-        for (int P = 0; P < npoints; P++) {
-            QTap[P] = w[P] * rho_a[P];
-            QTbp[P] = w[P] * rho_b[P];
-        }
-        rhoaq[rank] += C_DDOT(npoints, w, 1, rho_a, 1);
-        rhoaxq[rank] += C_DDOT(npoints, QTap, 1, x, 1);
-        rhoayq[rank] += C_DDOT(npoints, QTap, 1, y, 1);
-        rhoazq[rank] += C_DDOT(npoints, QTap, 1, z, 1);
-        rhobq[rank] += C_DDOT(npoints, w, 1, rho_b, 1);
-        rhobxq[rank] += C_DDOT(npoints, QTbp, 1, x, 1);
-        rhobyq[rank] += C_DDOT(npoints, QTbp, 1, y, 1);
-        rhobzq[rank] += C_DDOT(npoints, QTbp, 1, z, 1);
-
-        // ==> LSDA contribution <== //
-        //                                               ∂
-        // Ta, Tb := 1/2 einsum("p, p, pn -> pnσ", w, φ, -- f)[σ = α, β]
-        //                                               ∂ρ
-        // timer_on("V: LSDA");
-        for (int P = 0; P < npoints; P++) {
-            std::fill(Tap[P], Tap[P] + nlocal, 0.0);
-            std::fill(Tbp[P], Tbp[P] + nlocal, 0.0);
-            C_DAXPY(nlocal, 0.5 * v_rho_a[P] * w[P], phi[P], 1, Tap[P], 1);
-            C_DAXPY(nlocal, 0.5 * v_rho_b[P] * w[P], phi[P], 1, Tbp[P], 1);
+        if (batch_reused) {
+            // Every block of the batch keeps its stored contribution
+        } else if (Qstop - Qstart == 1) {
+            fworker->compute_functional(point_workers_[rank]->point_values(), grid_->blocks()[active_blocks[Qstart]]->npoints());
+        } else {
+            compute_functional_batch(rank, active_blocks, Qstart, Qstop);
         }
-        // timer_off("V: LSDA");
-
-        // ==> GGA contribution <== //
-        if (ansatz >= 1) {
-            //                                                                      ∂
-            // Ta, Tb += einsum("p, στ, pστ, xpτ, xpn -> pnσ", w, (σ == τ) ? 2 : 1, -- f, ∇ρ, ∇φ)[σ = α, β]
-            //                                                                      ∂γ
-            // timer_on("V: GGA");
-            auto phix = pworker->basis_value("PHI_X")->pointer();
-            auto phiy = pworker->basis_value("PHI_Y")->pointer();
-            auto phiz = pworker->basis_value("PHI_Z")->pointer();
-            auto rho_ax = pworker->point_value("RHO_AX")->pointer();
-            auto rho_ay = pworker->point_value("RHO_AY")->pointer();
-            auto rho_az = pworker->point_value("RHO_AZ")->pointer();
-            auto rho_bx = pworker->point_value("RHO_BX")->pointer();
-            auto rho_by = pworker->point_value("RHO_BY")->pointer();
-            auto rho_bz = pworker->point_value("RHO_BZ")->pointer();
-            auto v_gamma_aa = vals["V_GAMMA_AA"]->pointer();
-            auto v_gamma_ab = vals["V_GAMMA_AB"]->pointer();
-            auto v_gamma_bb = vals["V_GAMMA_BB"]->pointer();
+        parallel_timer_off("Functional", rank);
 
-            for (int P = 0; P < npoints; P++) {
-                C_DAXPY(nlocal, w[P] * (2.0 * v_gamma_aa[P] * rho_ax[P] + v_gamma_ab[P] * rho_bx[P]), phix[P], 1,
-                        Tap[P], 1);
-                C_DAXPY(nlocal, w[P] * (2.0 * v_gamma_aa[P] * rho_ay[P] + v_gamma_ab[P] * rho_by[P]), phiy[P], 1,
-                        Tap[P], 1);
-                C_DAXPY(nlocal, w[P] * (2.0 * v_gamma_aa[P] * rho_az[P] + v_gamma_ab[P] * rho_bz[P]), phiz[P], 1,
-                        Tap[P], 1);
-                C_DAXPY(nlocal, w[P] * (2.0 * v_gamma_bb[P] * rho_bx[P] + v_gamma_ab[P] * rho_ax[P]), phix[P], 1,
-                        Tbp[P], 1);
-                C_DAXPY(nlocal, w[P] * (2.0 * v_gamma_bb[P] * rho_by[P] + v_gamma_ab[P] * rho_ay[P]), phiy[P], 1,
-                        Tbp[P], 1);
-                C_DAXPY(nlocal, w[P] * (2.0 * v_gamma_bb[P] * rho_bz[P] + v_gamma_ab[P] * rho_az[P]), phiz[P], 1,
-                        Tbp[P], 1);
+        for (size_t Q = Qstart; Q < Qstop; Q++) {
+            auto pworker = batch_point_worker(rank, Q - Qstart);
+            if (Qstop - Qstart > 1 && !reuse[Q - Qstart]) scatter_functional_batch(rank, active_blocks, Qstart, Q);
+            auto& vals = fworker->values();
+            auto Va2p = Va_local[rank]->pointer();
+            auto Vb2p = Vb_local[rank]->pointer();
+            auto QTap = Qa_temp[rank]->pointer();
+            auto QTbp = Qb_temp[rank]->pointer();
+
+            // Scratch
+            auto Tap = pworker->scratch()[0]->pointer();
+            auto Tbp = pworker->scratch()[1]->pointer();
+
+            auto block = grid_->blocks()[active_blocks[Q]];
+            auto npoints = block->npoints();
+            auto x = block->x();
+            auto y = block->y();
+            auto z = block->z();
+            auto w = block->w();
+            const auto& function_map = block->functions_local_to_global();
+            auto nlocal = function_map.size();
+
+            if (debug_ > 3) {
+                block->print("outfile", debug_);
+                pworker->print("outfile", debug_);
             }
-            // timer_off("V: GGA");
-        }
 
-        // timer_on("V: LSDA");
-        // ==> Contract Ta and Tba aginst φ, replacing a point index with  an AO index <==
-        C_DGEMM('T', 'N', nlocal, nlocal, npoints, 1.0, phi[0], coll_funcs, Tap[0], max_functions, 0.0, Va2p[0],
-                max_functions);
-        C_DGEMM('T', 'N', nlocal, nlocal, npoints, 1.0, phi[0], coll_funcs, Tbp[0], max_functions, 0.0, Vb2p[0],
-                max_functions);
-
-        // ==> Add the adjoint to complete the LDA and GGA contributions  <==
-        for (int m = 0; m < nlocal; m++) {
-            for (int n = 0; n <= m; n++) {
-                Va2p[m][n] = Va2p[n][m] = Va2p[m][n] + Va2p[n][m];
-                Vb2p[m][n] = Vb2p[n][m] = Vb2p[m][n] + Vb2p[n][m];
-            }
-        }
-        // timer_off("V: LSDA");
-
-        // ==> Meta contribution <== //
-        if (ansatz >= 2) {
-            // timer_on("V: Meta");
-            auto phix = pworker->basis_value("PHI_X")->pointer();
-            auto phiy = pworker->basis_value("PHI_Y")->pointer();
-            auto phiz = pworker->basis_value("PHI_Z")->pointer();
-            auto v_tau_a = vals["V_TAU_A"]->pointer();
-            auto v_tau_b = vals["V_TAU_B"]->pointer();
-
-            double** phi[3];
-            phi[0] = phix;
-            phi[1] = phiy;
-            phi[2] = phiz;
-
-            double* v_tau[2];
-            v_tau[0] = v_tau_a;
-            v_tau[1] = v_tau_b;
-
-            double** V_val[2];
-            V_val[0] = Va2p;
-            V_val[1] = Vb2p;
+            // ==> Define pointers to intermediates <==
+            parallel_timer_on("V_xc", rank);
+            std::vector<double> qvals;
+            if (reuse[Q - Qstart]) {
+                // ==> Density unchanged since the stored contribution was built <== //
+                qvals = restore_block_xc(active_blocks[Q], {Va_local[rank], Vb_local[rank]});
+            } else {
+                auto phi = pworker->basis_value("PHI")->pointer();
+                auto rho_a = pworker->point_value("RHO_A")->pointer();
+                auto rho_b = pworker->point_value("RHO_B")->pointer();
+                auto zk = vals["V"]->pointer();
+                auto v_rho_a = vals["V_RHO_A"]->pointer();
+                auto v_rho_b = vals["V_RHO_B"]->pointer();
+                auto coll_funcs = pworker->basis_value("PHI")->ncol();
+
+                // ==> Compute quadrature values <== //
+                for (int P = 0; P < npoints; P++) {
+                    QTap[P] = w[P] * rho_a[P];
+                    QTbp[P] = w[P] * rho_b[P];
+                }
+                qvals = {C_DDOT(npoints, w, 1, zk, 1),   C_DDOT(npoints, w, 1, rho_a, 1), C_DDOT(npoints, QTap, 1, x, 1),
+                         C_DDOT(npoints, QTap, 1, y, 1), C_DDOT(npoints, QTap, 1, z, 1),  C_DDOT(npoints, w, 1, rho_b, 1),
+                         C_DDOT(npoints, QTbp, 1, x, 1), C_DDOT(npoints, QTbp, 1, y, 1),  C_DDOT(npoints, QTbp, 1, z, 1)};
+
+                // ==> LSDA contribution <== //
+                //                                               ∂
+                // Ta, Tb := 1/2 einsum("p, p, pn -> pnσ", w, φ, -- f)[σ = α, β]
+                //                                               ∂ρ
+                // timer_on("V: LSDA");
+                for (int P = 0; P < npoints; P++) {
+                    std::fill(Tap[P], Tap[P] + nlocal, 0.0);
+                    std::fill(Tbp[P], Tbp[P] + nlocal, 0.0);
+                    C_DAXPY(nlocal, 0.5 * v_rho_a[P] * w[P], phi[P], 1, Tap[P], 1);
+                    C_DAXPY(nlocal, 0.5 * v_rho_b[P] * w[P], phi[P], 1, Tbp[P], 1);
+                }
+                // timer_off("V: LSDA");
+
+                // ==> GGA contribution <== //
+                if (ansatz >= 1) {
+                    //                                                                      ∂
+                    // Ta, Tb += einsum("p, στ, pστ, xpτ, xpn -> pnσ", w, (σ == τ) ? 2 : 1, -- f, ∇ρ, ∇φ)[σ = α, β]
+                    //                                                                      ∂γ
+                    // timer_on("V: GGA");
+                    auto phix = pworker->basis_value("PHI_X")->pointer();
+                    auto phiy = pworker->basis_value("PHI_Y")->pointer();
+                    auto phiz = pworker->basis_value("PHI_Z")->pointer();
+                    auto rho_ax = pworker->point_value("RHO_AX")->pointer();
+                    auto rho_ay = pworker->point_value("RHO_AY")->pointer();
+                    auto rho_az = pworker->point_value("RHO_AZ")->pointer();
+                    auto rho_bx = pworker->point_value("RHO_BX")->pointer();
+                    auto rho_by = pworker->point_value("RHO_BY")->pointer();
+                    auto rho_bz = pworker->point_value("RHO_BZ")->pointer();
+                    auto v_gamma_aa = vals["V_GAMMA_AA"]->pointer();
+                    auto v_gamma_ab = vals["V_GAMMA_AB"]->pointer();
+                    auto v_gamma_bb = vals["V_GAMMA_BB"]->pointer();
 
-            for (int s = 0; s < 2; s++) {
-                double** V2p = V_val[s];
-                double* v_taup = v_tau[s];
-                for (int i = 0; i < 3; i++) {
-                    double** phiw = phi[i];
                     for (int P = 0; P < npoints; P++) {
-                        std::fill(Tap[P], Tap[P] + nlocal, 0.0);
-                        C_DAXPY(nlocal, v_taup[P] * w[P], phiw[P], 1, Tap[P], 1);
+                        C_DAXPY(nlocal, w[P] * (2.0 * v_gamma_aa[P] * rho_ax[P] + v_gamma_ab[P] * rho_bx[P]),
+                                phix[P], 1, Tap[P], 1);
+                        C_DAXPY(nlocal, w[P] * (2.0 * v_gamma_aa[P] * rho_ay[P] + v_gamma_ab[P] * rho_by[P]),
+                                phiy[P], 1, Tap[P], 1);
+                        C_DAXPY(nlocal, w[P] * (2.0 * v_gamma_aa[P] * rho_az[P] + v_gamma_ab[P] * rho_bz[P]),
+                                phiz[P], 1, Tap[P], 1);
+                        C_DAXPY(nlocal, w[P] * (2.0 * v_gamma_bb[P] * rho_bx[P] + v_gamma_ab[P] * rho_ax[P]),
+                                phix[P], 1, Tbp[P], 1);
+                        C_DAXPY(nlocal, w[P] * (2.0 * v_gamma_bb[P] * rho_by[P] + v_gamma_ab[P] * rho_ay[P]),
+                                phiy[P], 1, Tbp[P], 1);
+                        C_DAXPY(nlocal, w[P] * (2.0 * v_gamma_bb[P] * rho_bz[P] + v_gamma_ab[P] * rho_az[P]),
+                                phiz[P], 1, Tbp[P], 1);
                     }
-                    C_DGEMM('T', 'N', nlocal, nlocal, npoints, 1.0, phiw[0], coll_funcs, Tap[0], max_functions, 1.0,
-                            V2p[0], max_functions);
+                    // timer_off("V: GGA");
                 }
-            }
 
-            // timer_off("V: Meta");
-        }
+                // timer_on("V: LSDA");
+                // ==> Contract Ta and Tba aginst φ, replacing a point index with  an AO index <==
+                C_DGEMM('T', 'N', nlocal, nlocal, npoints, 1.0, phi[0], coll_funcs, Tap[0], max_functions, 0.0, Va2p[0],
+                        max_functions);
+                C_DGEMM('T', 'N', nlocal, nlocal, npoints, 1.0, phi[0], coll_funcs, Tbp[0], max_functions, 0.0, Vb2p[0],
+                        max_functions);
+
+                // ==> Add the adjoint to complete the LDA and GGA contributions  <==
+                for (int m = 0; m < nlocal; m++) {
+                    for (int n = 0; n <= m; n++) {
+                        Va2p[m][n] = Va2p[n][m] = Va2p[m][n] + Va2p[n][m];
+                        Vb2p[m][n] = Vb2p[n][m] = Vb2p[m][n] + Vb2p[n][m];
+                    }
+                }
+                // timer_off("V: LSDA");
+
+                // ==> Meta contribution <== //
+                if (ansatz >= 2) {
+                    // timer_on("V: Meta");
+                    auto phix = pworker->basis_value("PHI_X")->pointer();
+                    auto phiy = pworker->basis_value("PHI_Y")->pointer();
+                    auto phiz = pworker->basis_value("PHI_Z")->pointer();
+                    auto v_tau_a = vals["V_TAU_A"]->pointer();
+                    auto v_tau_b = vals["V_TAU_B"]->pointer();
+
+                    double** phi[3];
+                    phi[0] = phix;
+                    phi[1] = phiy;
+                    phi[2] = phiz;
+
+                    double* v_tau[2];
+                    v_tau[0] = v_tau_a;
+                    v_tau[1] = v_tau_b;
+
+                    double** V_val[2];
+                    V_val[0] = Va2p;
+                    V_val[1] = Vb2p;
+
+                    for (int s = 0; s < 2; s++) {
+                        double** V2p = V_val[s];
+                        double* v_taup = v_tau[s];
+                        for (int i = 0; i < 3; i++) {
+                            double** phiw = phi[i];
+                            for (int P = 0; P < npoints; P++) {
+                                std::fill(Tap[P], Tap[P] + nlocal, 0.0);
+                                C_DAXPY(nlocal, v_taup[P] * w[P], phiw[P], 1, Tap[P], 1);
+                            }
+                            C_DGEMM('T', 'N', nlocal, nlocal, npoints, 1.0, phiw[0], coll_funcs, Tap[0], max_functions,
+                                    1.0, V2p[0], max_functions);
+                        }
+                    }
 
-        // ==> Unpacking <== //
-        for (int ml = 0; ml < nlocal; ml++) {
-            int mg = function_map[ml];
-            for (int nl = 0; nl < ml; nl++) {
-                int ng = function_map[nl];
-#pragma omp atomic update
-                Vap[mg][ng] += Va2p[ml][nl];
-#pragma omp atomic update
-                Vap[ng][mg] += Va2p[ml][nl];
-#pragma omp atomic update
-                Vbp[mg][ng] += Vb2p[ml][nl];
-#pragma omp atomic update
-                Vbp[ng][mg] += Vb2p[ml][nl];
+                    // timer_off("V: Meta");
+                }
+                store_block_xc(active_blocks[Q], pworker, {Va_local[rank], Vb_local[rank]}, qvals);
             }
-#pragma omp atomic update
-            Vap[mg][mg] += Va2p[ml][ml];
-#pragma omp atomic update
-            Vbp[mg][mg] += Vb2p[ml][ml];
+            functionalq[rank] += qvals[0];
+            rhoaq[rank] += qvals[1];
+            rhoaxq[rank] += qvals[2];
+            rhoayq[rank] += qvals[3];
+            rhoazq[rank] += qvals[4];
+            rhobq[rank] += qvals[5];
+            rhobxq[rank] += qvals[6];
+            rhobyq[rank] += qvals[7];
+            rhobzq[rank] += qvals[8];
+
+            // ==> Unpacking <== //
+            for (int ml = 0; ml < nlocal; ml++) {
+                int mg = function_map[ml];
+                for (int nl = 0; nl < ml; nl++) {
+                    int ng = function_map[nl];
+    #pragma omp atomic update
+                    Vap[mg][ng] += Va2p[ml][nl];
+    #pragma omp atomic update
+                    Vap[ng][mg] += Va2p[ml][nl];
+    #pragma omp atomic update
+                    Vbp[mg][ng] += Vb2p[ml][nl];
+    #pragma omp atomic update
+                    Vbp[ng][mg] += Vb2p[ml][nl];
+                }
+    #pragma omp atomic update
+                Vap[mg][mg] += Va2p[ml][ml];
+    #pragma omp atomic update
+                Vbp[mg][mg] += Vb2p[ml][ml];
+            }
+            parallel_timer_off("V_xc", rank);
         }
-        parallel_timer_off("V_xc", rank);
     }
 
     // Do we need VV10?
@@ -2973,7 +3454,7 @@ std::vector<SharedMatrix> UV::compute_fock_derivatives() {
     }
 
 // Traverse the blocks of points
-#pragma omp parallel for private(rank) schedule(guided) num_threads(num_threads_)
+#pragma omp parallel for private(rank) schedule(dynamic) num_threads(num_threads_)
     for (size_t Q = 0; Q < grid_->blocks().size(); Q++) {
 // Get thread info
 #ifdef _OPENMP
@@ -3280,16 +3761,21 @@ void UV::compute_Vx(std::vector<SharedMatrix> Dx, std::vector<SharedMatrix> ret)
     }
 
     // Per [R]ank quantities
-    std::vector<SharedMatrix> R_Vax_local, R_Dax_local;
-    std::vector<SharedMatrix> R_Vbx_local, R_Dbx_local;
+    // The rotated densities of a batch of α/β pairs and, afterwards, their Vx blocks share R_DVx_local,
+    // each stored side by side in α, β order
+    const size_t vx_batch = std::min(vx_batch_, Dx.size() / 2);
+    std::vector<SharedMatrix> R_DVx_local, R_T_local;
+    std::vector<std::vector<double*>> R_Ta_rows, R_Tb_rows, R_Vax_rows, R_Vbx_rows;
     std::vector<std::shared_ptr<Vector>> R_rho_ak, R_rho_ak_x, R_rho_ak_y, R_rho_ak_z, R_gamma_ak;
     std::vector<std::shared_ptr<Vector>> R_rho_bk, R_rho_bk_x, R_rho_bk_y, R_rho_bk_z, R_gamma_bk;
     std::vector<std::shared_ptr<Vector>> R_gamma_abk;
     for (size_t i = 0; i < num_threads_; i++) {
-        R_Vax_local.push_back(std::make_shared<Matrix>("Vax Temp", max_functions, max_functions));
-        R_Vbx_local.push_back(std::make_shared<Matrix>("Vbx Temp", max_functions, max_functions));
-        R_Dax_local.push_back(std::make_shared<Matrix>("Dak Temp", max_functions, max_functions));
-        R_Dbx_local.push_back(std::make_shared<Matrix>("Dbk Temp", max_functions, max_functions));
+        R_DVx_local.push_back(std::make_shared<Matrix>("DVx Temp", max_functions, 2 * vx_batch * max_functions));
+        R_T_local.push_back(std::make_shared<Matrix>("T Temp", max_points, 2 * vx_batch * max_functions));
+        R_Ta_rows.emplace_back(max_points);
+        R_Tb_rows.emplace_back(max_points);
+        R_Vax_rows.emplace_back(max_functions);
+        R_Vbx_rows.emplace_back(max_functions);
 
         R_rho_ak.push_back(std::make_shared<Vector>("Rho aK Temp", max_points));
         R_rho_bk.push_back(std::make_shared<Vector>("Rho bK Temp", max_points));
@@ -3321,7 +3807,7 @@ void UV::compute_Vx(std::vector<SharedMatrix> Dx, std::vector<SharedMatrix> ret)
     }
 
     // => Compute Vx <=
-#pragma omp parallel for private(rank) schedule(guided) num_threads(num_threads_)
+#pragma omp parallel for private(rank) schedule(dynamic) num_threads(num_threads_)
     for (size_t Q = 0; Q < grid_->blocks().size(); Q++) {
         // ==> Define block/thread-specific variables <==
 #ifdef _OPENMP
@@ -3331,14 +3817,8 @@ void UV::compute_Vx(std::vector<SharedMatrix> Dx, std::vector<SharedMatrix> ret)
         // => Setup <= //
         auto fworker = functional_workers_[rank];
         auto pworker = point_workers_[rank];
-        auto Vax_localp = R_Vax_local[rank]->pointer();
-        auto Vbx_localp = R_Vbx_local[rank]->pointer();
-        auto Dax_localp = R_Dax_local[rank]->pointer();
-        auto Dbx_localp = R_Dbx_local[rank]->pointer();
-
-        // => Compute blocks <= //
-        auto Tap = pworker->scratch()[0]->pointer();
-        auto Tbp = pworker->scratch()[1]->pointer();
+        auto DVwp = R_DVx_local[rank]->pointer()[0];
+        auto Twp = R_T_local[rank]->pointer()[0];
 
         auto block = grid_->blocks()[Q];
         auto npoints = block->npoints();
@@ -3412,310 +3892,323 @@ void UV::compute_Vx(std::vector<SharedMatrix> Dx, std::vector<SharedMatrix> ret)
         // Meta
         // Forget that!
 
-        // ==> Compute Vx contribution for each x <==
-        for (size_t dindex = 0; dindex < (Dx_vec.size() / 2); dindex++) {
-            auto Daxp = Dx_vec[2 * dindex]->pointer();
-            auto Dbxp = Dx_vec[2 * dindex + 1]->pointer();
-
-            // ===> Build Rotated Densities <=== //
-            for (int ml = 0; ml < nlocal; ml++) {
-                int mg = function_map[ml];
-                for (int nl = 0; nl < nlocal; nl++) {
-                    int ng = function_map[nl];
-                    Dax_localp[ml][nl] = Daxp[mg][ng];
-                    Dbx_localp[ml][nl] = Dbxp[mg][ng];
+        // ==> Compute Vx contribution for each x, a batch of α/β pairs at a time <==
+        const size_t npairs = Dx_vec.size() / 2;
+        for (size_t dstart = 0; dstart < npairs; dstart += vx_batch) {
+            const size_t nbatch = std::min(vx_batch, npairs - dstart);
+            const int ldw = 2 * nbatch * nlocal;
+
+            // ===> Build Rotated Densities, symmetrized and side by side <=== //
+            for (size_t k = 0; k < 2 * nbatch; k++) {
+                auto Dxp = Dx_vec[2 * dstart + k]->pointer();
+                for (int ml = 0; ml < nlocal; ml++) {
+                    int mg = function_map[ml];
+                    for (int nl = 0; nl < nlocal; nl++) {
+                        int ng = function_map[nl];
+                        DVwp[ml * ldw + k * nlocal + nl] = Dxp[mg][ng] + Dxp[ng][mg];
+                    }
                 }
             }
 
-            // ===> Compute quantities using effective densities <===
-            // Ta, Tb := einsum("pm, mnσ -> pnσ", φ, add_trans(Dk, (1, 0, 2)))[σ = α, β]
-            // Alpha
+            // Ta, Tb := einsum("pm, mnσ -> pnσ", φ, add_trans(Dk, (1, 0, 2)))[σ = α, β] for the whole batch
             parallel_timer_on("Derivative Properties", rank);
-            C_DGEMM('N', 'N', npoints, nlocal, nlocal, 1.0, phi[0], coll_funcs, Dax_localp[0], max_functions, 0.0,
-                    Tap[0], max_functions);
-            C_DGEMM('N', 'T', npoints, nlocal, nlocal, 1.0, phi[0], coll_funcs, Dax_localp[0], max_functions, 1.0,
-                    Tap[0], max_functions);
-
-            // Beta
-            C_DGEMM('N', 'N', npoints, nlocal, nlocal, 1.0, phi[0], coll_funcs, Dbx_localp[0], max_functions, 0.0,
-                    Tbp[0], max_functions);
-            C_DGEMM('N', 'T', npoints, nlocal, nlocal, 1.0, phi[0], coll_funcs, Dbx_localp[0], max_functions, 1.0,
-                    Tbp[0], max_functions);
-
-            // ρk = einsum("mnσ, pm, pn -> pσ", Dk, φ, φ)
-            // ρk = 1/2 * add_trans(ρκ, (1, 0, 2))
-            for (int P = 0; P < npoints; P++) {
-                rho_ak[P] = 0.5 * C_DDOT(nlocal, phi[P], 1, Tap[P], 1);
-                rho_bk[P] = 0.5 * C_DDOT(nlocal, phi[P], 1, Tbp[P], 1);
-            }
+            C_DGEMM('N', 'N', npoints, ldw, nlocal, 1.0, phi[0], coll_funcs, DVwp, ldw, 0.0, Twp, ldw);
+            parallel_timer_off("Derivative Properties", rank);
 
-            // ∇ρk = einsum("mnσ, pm, pn -> pσ", add_trans(Dk, (1, 0, 2)), ∇φ, φ)
-            //  Γk = add_trans(einsum("xpσ, xpτ -> pστ", ∇ρk, ∇ρ), (0, 2, 1))
-            if (ansatz >= 1) {
+            for (size_t k = 0; k < nbatch; k++) {
+                auto Tap = R_Ta_rows[rank].data();
+                auto Tbp = R_Tb_rows[rank].data();
                 for (int P = 0; P < npoints; P++) {
-                    // Alpha
-                    rho_ak_x[P] = C_DDOT(nlocal, phi_x[P], 1, Tap[P], 1);
-                    rho_ak_y[P] = C_DDOT(nlocal, phi_y[P], 1, Tap[P], 1);
-                    rho_ak_z[P] = C_DDOT(nlocal, phi_z[P], 1, Tap[P], 1);
-                    gamma_aak[P] = rho_ak_x[P] * rho_ax[P];
-                    gamma_aak[P] += rho_ak_y[P] * rho_ay[P];
-                    gamma_aak[P] += rho_ak_z[P] * rho_az[P];
-                    gamma_aak[P] *= 2.0;
-
-                    // Beta
-                    rho_bk_x[P] = C_DDOT(nlocal, phi_x[P], 1, Tbp[P], 1);
-                    rho_bk_y[P] = C_DDOT(nlocal, phi_y[P], 1, Tbp[P], 1);
-                    rho_bk_z[P] = C_DDOT(nlocal, phi_z[P], 1, Tbp[P], 1);
-                    gamma_bbk[P] = rho_bk_x[P] * rho_bx[P];
-                    gamma_bbk[P] += rho_bk_y[P] * rho_by[P];
-                    gamma_bbk[P] += rho_bk_z[P] * rho_bz[P];
-                    gamma_bbk[P] *= 2.0;
-
-                    // Alpha-Beta
-                    gamma_abk[P] = rho_ak_x[P] * rho_bx[P] + rho_bk_x[P] * rho_ax[P];
-                    gamma_abk[P] += rho_ak_y[P] * rho_by[P] + rho_bk_y[P] * rho_ay[P];
-                    gamma_abk[P] += rho_ak_z[P] * rho_bz[P] + rho_bk_z[P] * rho_az[P];
+                    Tap[P] = Twp + P * ldw + (2 * k) * nlocal;
+                    Tbp[P] = Twp + P * ldw + (2 * k + 1) * nlocal;
                 }
-            }
-            parallel_timer_off("Derivative Properties", rank);
 
-            parallel_timer_on("V_XCd", rank);
-            // ===> LSDA contribution (symmetrized) <=== //
-            //                                                  ∂^2
-            // Ta, Tb := 1/2 einsum("p, pστ, pm, pτ -> pmσ", w, ---- f , ρk, φ)
-            //                                                  ∂ρ^2
-            double tmp_val = 0.0, tmp_ab_val = 0.0;
-            for (int P = 0; P < npoints; P++) {
-                std::fill(Tap[P], Tap[P] + nlocal, 0.0);
-                std::fill(Tbp[P], Tbp[P] + nlocal, 0.0);
+                parallel_timer_on("Derivative Properties", rank);
 
-                // Do a simple screen: ignore contributions where rho is too small.
-                if (rho_a[P] + rho_b[P] > v2_rho_cutoff_) {
-                    tmp_val = v2_rho2_aa[P] * rho_ak[P];
-                    tmp_val += v2_rho2_ab[P] * rho_bk[P];
-                    tmp_val *= 0.5 * w[P];
-                    C_DAXPY(nlocal, tmp_val, phi[P], 1, Tap[P], 1);
-
-                    tmp_val = v2_rho2_bb[P] * rho_bk[P];
-                    tmp_val += v2_rho2_ab[P] * rho_ak[P];
-                    tmp_val *= 0.5 * w[P];
-                    C_DAXPY(nlocal, tmp_val, phi[P], 1, Tbp[P], 1);
+                // ρk = einsum("mnσ, pm, pn -> pσ", Dk, φ, φ)
+                // ρk = 1/2 * add_trans(ρκ, (1, 0, 2))
+                for (int P = 0; P < npoints; P++) {
+                    rho_ak[P] = 0.5 * C_DDOT(nlocal, phi[P], 1, Tap[P], 1);
+                    rho_bk[P] = 0.5 * C_DDOT(nlocal, phi[P], 1, Tbp[P], 1);
                 }
-            }
 
-            // ===> GGA contribution <=== //
-            if (ansatz >= 1) {
-                // ====> Define pointers for future use <====
-                auto gamma_aa = pworker->point_value("GAMMA_AA")->pointer();
-                auto gamma_ab = pworker->point_value("GAMMA_AB")->pointer();
-                auto gamma_bb = pworker->point_value("GAMMA_BB")->pointer();
-
-                auto v_gamma_aa = vals["V_GAMMA_AA"]->pointer();
-                auto v_gamma_ab = vals["V_GAMMA_AB"]->pointer();
-                auto v_gamma_bb = vals["V_GAMMA_BB"]->pointer();
-
-                auto v2_gamma_aa_gamma_aa = vals["V_GAMMA_AA_GAMMA_AA"]->pointer();
-                auto v2_gamma_aa_gamma_ab = vals["V_GAMMA_AA_GAMMA_AB"]->pointer();
-                auto v2_gamma_aa_gamma_bb = vals["V_GAMMA_AA_GAMMA_BB"]->pointer();
-                auto v2_gamma_ab_gamma_ab = vals["V_GAMMA_AB_GAMMA_AB"]->pointer();
-                auto v2_gamma_ab_gamma_bb = vals["V_GAMMA_AB_GAMMA_BB"]->pointer();
-                auto v2_gamma_bb_gamma_bb = vals["V_GAMMA_BB_GAMMA_BB"]->pointer();
-
-                auto v2_rho_a_gamma_aa = vals["V_RHO_A_GAMMA_AA"]->pointer();
-                auto v2_rho_a_gamma_ab = vals["V_RHO_A_GAMMA_AB"]->pointer();
-                auto v2_rho_a_gamma_bb = vals["V_RHO_A_GAMMA_BB"]->pointer();
-                auto v2_rho_b_gamma_aa = vals["V_RHO_B_GAMMA_AA"]->pointer();
-                auto v2_rho_b_gamma_ab = vals["V_RHO_B_GAMMA_AB"]->pointer();
-                auto v2_rho_b_gamma_bb = vals["V_RHO_B_GAMMA_BB"]->pointer();
-
-                double tmp_val = 0.0, v2_val_aa = 0.0, v2_val_ab = 0.0, v2_val_bb = 0.0;
-
-                // There are lots of GGA terms.
+                // ∇ρk = einsum("mnσ, pm, pn -> pσ", add_trans(Dk, (1, 0, 2)), ∇φ, φ)
+                //  Γk = add_trans(einsum("xpσ, xpτ -> pστ", ∇ρk, ∇ρ), (0, 2, 1))
+                if (ansatz >= 1) {
+                    for (int P = 0; P < npoints; P++) {
+                        // Alpha
+                        rho_ak_x[P] = C_DDOT(nlocal, phi_x[P], 1, Tap[P], 1);
+                        rho_ak_y[P] = C_DDOT(nlocal, phi_y[P], 1, Tap[P], 1);
+                        rho_ak_z[P] = C_DDOT(nlocal, phi_z[P], 1, Tap[P], 1);
+                        gamma_aak[P] = rho_ak_x[P] * rho_ax[P];
+                        gamma_aak[P] += rho_ak_y[P] * rho_ay[P];
+                        gamma_aak[P] += rho_ak_z[P] * rho_az[P];
+                        gamma_aak[P] *= 2.0;
+
+                        // Beta
+                        rho_bk_x[P] = C_DDOT(nlocal, phi_x[P], 1, Tbp[P], 1);
+                        rho_bk_y[P] = C_DDOT(nlocal, phi_y[P], 1, Tbp[P], 1);
+                        rho_bk_z[P] = C_DDOT(nlocal, phi_z[P], 1, Tbp[P], 1);
+                        gamma_bbk[P] = rho_bk_x[P] * rho_bx[P];
+                        gamma_bbk[P] += rho_bk_y[P] * rho_by[P];
+                        gamma_bbk[P] += rho_bk_z[P] * rho_bz[P];
+                        gamma_bbk[P] *= 2.0;
+
+                        // Alpha-Beta
+                        gamma_abk[P] = rho_ak_x[P] * rho_bx[P] + rho_bk_x[P] * rho_ax[P];
+                        gamma_abk[P] += rho_ak_y[P] * rho_by[P] + rho_bk_y[P] * rho_ay[P];
+                        gamma_abk[P] += rho_ak_z[P] * rho_bz[P] + rho_bk_z[P] * rho_az[P];
+                    }
+                }
+                parallel_timer_off("Derivative Properties", rank);
+
+                parallel_timer_on("V_XCd", rank);
+                // ===> LSDA contribution (symmetrized) <=== //
+                //                                                  ∂^2
+                // Ta, Tb := 1/2 einsum("p, pστ, pm, pτ -> pmσ", w, ---- f , ρk, φ)
+                //                                                  ∂ρ^2
+                double tmp_val = 0.0, tmp_ab_val = 0.0;
                 for (int P = 0; P < npoints; P++) {
-                    if (rho_a[P] + rho_b[P] < v2_rho_cutoff_) continue;
-                    // ====> Term 2b, V in DOI: 10.1063/1.466887 <====
-                    //                                                    ∂^2
-                    // Ta, Tb += 1/2 einsum("p, pτσυ, pσυ, pr -> prτ", w, ---- f, Γk, φ)[τ = α, β]
-                    //                                                    ∂ρ∂γ
-                    // V alpha contributions
-                    tmp_val = v2_rho_a_gamma_aa[P] * gamma_aak[P];
-                    tmp_val += v2_rho_a_gamma_ab[P] * gamma_abk[P];
-                    tmp_val += v2_rho_a_gamma_bb[P] * gamma_bbk[P];
-                    C_DAXPY(nlocal, (0.5 * w[P] * tmp_val), phi[P], 1, Tap[P], 1);
-
-                    // V beta contributions
-                    tmp_val = v2_rho_b_gamma_aa[P] * gamma_aak[P];
-                    tmp_val += v2_rho_b_gamma_ab[P] * gamma_abk[P];
-                    tmp_val += v2_rho_b_gamma_bb[P] * gamma_bbk[P];
-                    C_DAXPY(nlocal, (0.5 * w[P] * tmp_val), phi[P], 1, Tbp[P], 1);
-
-                    // ====> All other terms, W in above DOI  <==== //
-                    // Compute α block of final result.
-
-                    //                                  ∂^2
-                    // temp = einsum("pτσυ, pτ -> pσυ", ---- f, ρk)[συ = αα, αβ]
-                    //                                  ∂ρ∂γ
-
-                    // Define ρk[τ=α] terms in 2a intermediate
-                    v2_val_aa = v2_rho_a_gamma_aa[P] * rho_ak[P];
-                    v2_val_ab = v2_rho_a_gamma_ab[P] * rho_ak[P];
-
-                    // Define ρk[τ=β] terms in 2a intermediate
-                    v2_val_aa += v2_rho_b_gamma_aa[P] * rho_bk[P];
-                    v2_val_ab += v2_rho_b_gamma_ab[P] * rho_bk[P];
+                    std::fill(Tap[P], Tap[P] + nlocal, 0.0);
+                    std::fill(Tbp[P], Tbp[P] + nlocal, 0.0);
+
+                    // Do a simple screen: ignore contributions where rho is too small.
+                    if (rho_a[P] + rho_b[P] > v2_rho_cutoff_) {
+                        tmp_val = v2_rho2_aa[P] * rho_ak[P];
+                        tmp_val += v2_rho2_ab[P] * rho_bk[P];
+                        tmp_val *= 0.5 * w[P];
+                        C_DAXPY(nlocal, tmp_val, phi[P], 1, Tap[P], 1);
+
+                        tmp_val = v2_rho2_bb[P] * rho_bk[P];
+                        tmp_val += v2_rho2_ab[P] * rho_ak[P];
+                        tmp_val *= 0.5 * w[P];
+                        C_DAXPY(nlocal, tmp_val, phi[P], 1, Tbp[P], 1);
+                    }
+                }
+
+                // ===> GGA contribution <=== //
+                if (ansatz >= 1) {
+                    // ====> Define pointers for future use <====
+                    auto gamma_aa = pworker->point_value("GAMMA_AA")->pointer();
+                    auto gamma_ab = pworker->point_value("GAMMA_AB")->pointer();
+                    auto gamma_bb = pworker->point_value("GAMMA_BB")->pointer();
+
+                    auto v_gamma_aa = vals["V_GAMMA_AA"]->pointer();
+                    auto v_gamma_ab = vals["V_GAMMA_AB"]->pointer();
+                    auto v_gamma_bb = vals["V_GAMMA_BB"]->pointer();
+
+                    auto v2_gamma_aa_gamma_aa = vals["V_GAMMA_AA_GAMMA_AA"]->pointer();
+                    auto v2_gamma_aa_gamma_ab = vals["V_GAMMA_AA_GAMMA_AB"]->pointer();
+                    auto v2_gamma_aa_gamma_bb = vals["V_GAMMA_AA_GAMMA_BB"]->pointer();
+                    auto v2_gamma_ab_gamma_ab = vals["V_GAMMA_AB_GAMMA_AB"]->pointer();
+                    auto v2_gamma_ab_gamma_bb = vals["V_GAMMA_AB_GAMMA_BB"]->pointer();
+                    auto v2_gamma_bb_gamma_bb = vals["V_GAMMA_BB_GAMMA_BB"]->pointer();
+
+                    auto v2_rho_a_gamma_aa = vals["V_RHO_A_GAMMA_AA"]->pointer();
+                    auto v2_rho_a_gamma_ab = vals["V_RHO_A_GAMMA_AB"]->pointer();
+                    auto v2_rho_a_gamma_bb = vals["V_RHO_A_GAMMA_BB"]->pointer();
+                    auto v2_rho_b_gamma_aa = vals["V_RHO_B_GAMMA_AA"]->pointer();
+                    auto v2_rho_b_gamma_ab = vals["V_RHO_B_GAMMA_AB"]->pointer();
+                    auto v2_rho_b_gamma_bb = vals["V_RHO_B_GAMMA_BB"]->pointer();
+
+                    double tmp_val = 0.0, v2_val_aa = 0.0, v2_val_ab = 0.0, v2_val_bb = 0.0;
+
+                    // There are lots of GGA terms.
+                    for (int P = 0; P < npoints; P++) {
+                        if (rho_a[P] + rho_b[P] < v2_rho_cutoff_) continue;
+                        // ====> Term 2b, V in DOI: 10.1063/1.466887 <====
+                        //                                                    ∂^2
+                        // Ta, Tb += 1/2 einsum("p, pτσυ, pσυ, pr -> prτ", w, ---- f, Γk, φ)[τ = α, β]
+                        //                                                    ∂ρ∂γ
+                        // V alpha contributions
+                        tmp_val = v2_rho_a_gamma_aa[P] * gamma_aak[P];
+                        tmp_val += v2_rho_a_gamma_ab[P] * gamma_abk[P];
+                        tmp_val += v2_rho_a_gamma_bb[P] * gamma_bbk[P];
+                        C_DAXPY(nlocal, (0.5 * w[P] * tmp_val), phi[P], 1, Tap[P], 1);
+
+                        // V beta contributions
+                        tmp_val = v2_rho_b_gamma_aa[P] * gamma_aak[P];
+                        tmp_val += v2_rho_b_gamma_ab[P] * gamma_abk[P];
+                        tmp_val += v2_rho_b_gamma_bb[P] * gamma_bbk[P];
+                        C_DAXPY(nlocal, (0.5 * w[P] * tmp_val), phi[P], 1, Tbp[P], 1);
+
+                        // ====> All other terms, W in above DOI  <==== //
+                        // Compute α block of final result.
+
+                        //                                  ∂^2
+                        // temp = einsum("pτσυ, pτ -> pσυ", ---- f, ρk)[συ = αα, αβ]
+                        //                                  ∂ρ∂γ
+
+                        // Define ρk[τ=α] terms in 2a intermediate
+                        v2_val_aa = v2_rho_a_gamma_aa[P] * rho_ak[P];
+                        v2_val_ab = v2_rho_a_gamma_ab[P] * rho_ak[P];
+
+                        // Define ρk[τ=β] terms in 2a intermediate
+                        v2_val_aa += v2_rho_b_gamma_aa[P] * rho_bk[P];
+                        v2_val_ab += v2_rho_b_gamma_ab[P] * rho_bk[P];
                     
-                    //                                     ∂^2
-                    // temp += einsum("pσυτχ, pτχ -> pσυ", ---- f, Γk)[συ = αα, αβ]
-                    //                                     ∂γ∂γ
+                        //                                     ∂^2
+                        // temp += einsum("pσυτχ, pτχ -> pσυ", ---- f, Γk)[συ = αα, αβ]
+                        //                                     ∂γ∂γ
 
-                    // Define Γk[τχ=αα] terms in 3 intermediate
-                    v2_val_aa += v2_gamma_aa_gamma_aa[P] * gamma_aak[P];
-                    v2_val_ab += v2_gamma_aa_gamma_ab[P] * gamma_aak[P];
+                        // Define Γk[τχ=αα] terms in 3 intermediate
+                        v2_val_aa += v2_gamma_aa_gamma_aa[P] * gamma_aak[P];
+                        v2_val_ab += v2_gamma_aa_gamma_ab[P] * gamma_aak[P];
 
-                    // Define Γk[τχ=αβ] terms in 3 intermediate
-                    v2_val_aa += v2_gamma_aa_gamma_ab[P] * gamma_abk[P];
-                    v2_val_ab += v2_gamma_ab_gamma_ab[P] * gamma_abk[P];
+                        // Define Γk[τχ=αβ] terms in 3 intermediate
+                        v2_val_aa += v2_gamma_aa_gamma_ab[P] * gamma_abk[P];
+                        v2_val_ab += v2_gamma_ab_gamma_ab[P] * gamma_abk[P];
 
-                    // Define Γk[τχ=ββ] terms in 3 intermediate
-                    v2_val_aa += v2_gamma_aa_gamma_bb[P] * gamma_bbk[P];
-                    v2_val_ab += v2_gamma_ab_gamma_bb[P] * gamma_bbk[P];
+                        // Define Γk[τχ=ββ] terms in 3 intermediate
+                        v2_val_aa += v2_gamma_aa_gamma_bb[P] * gamma_bbk[P];
+                        v2_val_ab += v2_gamma_ab_gamma_bb[P] * gamma_bbk[P];
 
-                    // Compute W terms, first 1 and then 2a and 3 at once
+                        // Compute W terms, first 1 and then 2a and 3 at once
        
-                    //                                         ∂
-                    // temp2 = einsum("p, pστ, xpτ -> xpσ", w, -- f, ∇ρk)[σ = α]
-                    //                                         ∂Γ
-                    // temp2 += einsum("p, pσυ, xpυ -> xpσ", w, temp, ∇ρ)[σ = α]
-                    //   N.B. A prefactor of 2 on the same-spin terms accounts for using γ rather than Γ in defining temp.
-                    // Ta += einsum("xpσ, xpm -> pmσ", temp2, ∇φ)[σ = α]
-
-                    // Wx
-                    tmp_val = 2.0 * v_gamma_aa[P] * rho_ak_x[P];
-                    tmp_val += v_gamma_ab[P] * rho_bk_x[P];
-                    tmp_val += 2.0 * v2_val_aa * rho_ax[P];
-                    tmp_val += v2_val_ab * rho_bx[P];
-                    tmp_val *= w[P];
-
-                    C_DAXPY(nlocal, tmp_val, phi_x[P], 1, Tap[P], 1);
-
-                    // Wy
-                    tmp_val = 2.0 * v_gamma_aa[P] * rho_ak_y[P];
-                    tmp_val += v_gamma_ab[P] * rho_bk_y[P];
-                    tmp_val += 2.0 * v2_val_aa * rho_ay[P];
-                    tmp_val += v2_val_ab * rho_by[P];
-                    tmp_val *= w[P];
-
-                    C_DAXPY(nlocal, tmp_val, phi_y[P], 1, Tap[P], 1);
-
-                    // Wz
-                    tmp_val = 2.0 * v_gamma_aa[P] * rho_ak_z[P];
-                    tmp_val += v_gamma_ab[P] * rho_bk_z[P];
-                    tmp_val += 2.0 * v2_val_aa * rho_az[P];
-                    tmp_val += v2_val_ab * rho_bz[P];
-                    tmp_val *= w[P];
-
-                    C_DAXPY(nlocal, tmp_val, phi_z[P], 1, Tap[P], 1);
-
-                    // Compute β block of final result.
+                        //                                         ∂
+                        // temp2 = einsum("p, pστ, xpτ -> xpσ", w, -- f, ∇ρk)[σ = α]
+                        //                                         ∂Γ
+                        // temp2 += einsum("p, pσυ, xpυ -> xpσ", w, temp, ∇ρ)[σ = α]
+                        //   N.B. A prefactor of 2 on the same-spin terms accounts for using γ rather than Γ in defining temp.
+                        // Ta += einsum("xpσ, xpm -> pmσ", temp2, ∇φ)[σ = α]
+
+                        // Wx
+                        tmp_val = 2.0 * v_gamma_aa[P] * rho_ak_x[P];
+                        tmp_val += v_gamma_ab[P] * rho_bk_x[P];
+                        tmp_val += 2.0 * v2_val_aa * rho_ax[P];
+                        tmp_val += v2_val_ab * rho_bx[P];
+                        tmp_val *= w[P];
+
+                        C_DAXPY(nlocal, tmp_val, phi_x[P], 1, Tap[P], 1);
+
+                        // Wy
+                        tmp_val = 2.0 * v_gamma_aa[P] * rho_ak_y[P];
+                        tmp_val += v_gamma_ab[P] * rho_bk_y[P];
+                        tmp_val += 2.0 * v2_val_aa * rho_ay[P];
+                        tmp_val += v2_val_ab * rho_by[P];
+                        tmp_val *= w[P];
+
+                        C_DAXPY(nlocal, tmp_val, phi_y[P], 1, Tap[P], 1);
+
+                        // Wz
+                        tmp_val = 2.0 * v_gamma_aa[P] * rho_ak_z[P];
+                        tmp_val += v_gamma_ab[P] * rho_bk_z[P];
+                        tmp_val += 2.0 * v2_val_aa * rho_az[P];
+                        tmp_val += v2_val_ab * rho_bz[P];
+                        tmp_val *= w[P];
+
+                        C_DAXPY(nlocal, tmp_val, phi_z[P], 1, Tap[P], 1);
+
+                        // Compute β block of final result.
                     
-                    //                                  ∂^2
-                    // temp = einsum("pτσυ, pτ -> pσυ", ---- f, ρk)[συ = ββ, αβ]
-                    //                                  ∂ρ∂γ
+                        //                                  ∂^2
+                        // temp = einsum("pτσυ, pτ -> pσυ", ---- f, ρk)[συ = ββ, αβ]
+                        //                                  ∂ρ∂γ
 
-                    // Define ρk[τ=α] terms in 2a intermediate
-                    v2_val_bb = v2_rho_a_gamma_bb[P] * rho_ak[P];
-                    v2_val_ab = v2_rho_a_gamma_ab[P] * rho_ak[P];
+                        // Define ρk[τ=α] terms in 2a intermediate
+                        v2_val_bb = v2_rho_a_gamma_bb[P] * rho_ak[P];
+                        v2_val_ab = v2_rho_a_gamma_ab[P] * rho_ak[P];
 
-                    // Define ρk[τ=β] terms in 2a intermediate
-                    v2_val_bb += v2_rho_b_gamma_bb[P] * rho_bk[P];
-                    v2_val_ab += v2_rho_b_gamma_ab[P] * rho_bk[P];
+                        // Define ρk[τ=β] terms in 2a intermediate
+                        v2_val_bb += v2_rho_b_gamma_bb[P] * rho_bk[P];
+                        v2_val_ab += v2_rho_b_gamma_ab[P] * rho_bk[P];
 
-                    // Define Γk[τχ=ββ] terms in 3 intermediate
-                    v2_val_bb += v2_gamma_bb_gamma_bb[P] * gamma_bbk[P];
-                    v2_val_ab += v2_gamma_ab_gamma_bb[P] * gamma_bbk[P];
+                        // Define Γk[τχ=ββ] terms in 3 intermediate
+                        v2_val_bb += v2_gamma_bb_gamma_bb[P] * gamma_bbk[P];
+                        v2_val_ab += v2_gamma_ab_gamma_bb[P] * gamma_bbk[P];
 
-                    // Define Γk[τχ=αβ] terms in 3 intermediate
-                    v2_val_bb += v2_gamma_ab_gamma_bb[P] * gamma_abk[P];
-                    v2_val_ab += v2_gamma_ab_gamma_ab[P] * gamma_abk[P];
+                        // Define Γk[τχ=αβ] terms in 3 intermediate
+                        v2_val_bb += v2_gamma_ab_gamma_bb[P] * gamma_abk[P];
+                        v2_val_ab += v2_gamma_ab_gamma_ab[P] * gamma_abk[P];
 
-                    // Define Γk[τχ=αα] terms in 3 intermediate
-                    v2_val_bb += v2_gamma_aa_gamma_bb[P] * gamma_aak[P];
-                    v2_val_ab += v2_gamma_aa_gamma_ab[P] * gamma_aak[P];
+                        // Define Γk[τχ=αα] terms in 3 intermediate
+                        v2_val_bb += v2_gamma_aa_gamma_bb[P] * gamma_aak[P];
+                        v2_val_ab += v2_gamma_aa_gamma_ab[P] * gamma_aak[P];
 
-                    // Compute W terms, first 1 and then 2a and 3 at once
+                        // Compute W terms, first 1 and then 2a and 3 at once
        
-                    //                                         ∂
-                    // temp2 = einsum("p, pστ, xpτ -> xpσ", w, -- f, ∇ρk)[σ = β]
-                    //                                         ∂Γ
-                    // temp2 += einsum("p, pσυ, xpυ -> xpσ", w, temp, ∇ρ)[σ = β]
-                    //   N.B. That a prefactor of 2 on the same-spin terms accounts for using γ rather than Γ in defining temp.
-                    // Tb += einsum("xpσ, xpm -> pmσ", temp2, ∇φ)[σ = β]
-
-                    // Wx
-                    tmp_val = 2.0 * v_gamma_bb[P] * rho_bk_x[P];
-                    tmp_val += v_gamma_ab[P] * rho_ak_x[P];
-                    tmp_val += 2.0 * v2_val_bb * rho_bx[P];
-                    tmp_val += v2_val_ab * rho_ax[P];
-                    tmp_val *= w[P];
-
-                    C_DAXPY(nlocal, tmp_val, phi_x[P], 1, Tbp[P], 1);
-
-                    // Wy
-                    tmp_val = 2.0 * v_gamma_bb[P] * rho_bk_y[P];
-                    tmp_val += v_gamma_ab[P] * rho_ak_y[P];
-                    tmp_val += 2.0 * v2_val_bb * rho_by[P];
-                    tmp_val += v2_val_ab * rho_ay[P];
-                    tmp_val *= w[P];
-
-                    C_DAXPY(nlocal, tmp_val, phi_y[P], 1, Tbp[P], 1);
-
-                    // Wz
-                    tmp_val = 2.0 * v_gamma_bb[P] * rho_bk_z[P];
-                    tmp_val += v_gamma_ab[P] * rho_ak_z[P];
-                    tmp_val += 2.0 * v2_val_bb * rho_bz[P];
-                    tmp_val += v2_val_ab * rho_az[P];
-                    tmp_val *= w[P];
-
-                    C_DAXPY(nlocal, tmp_val, phi_z[P], 1, Tbp[P], 1);
+                        //                                         ∂
+                        // temp2 = einsum("p, pστ, xpτ -> xpσ", w, -- f, ∇ρk)[σ = β]
+                        //                                         ∂Γ
+                        // temp2 += einsum("p, pσυ, xpυ -> xpσ", w, temp, ∇ρ)[σ = β]
+                        //   N.B. That a prefactor of 2 on the same-spin terms accounts for using γ rather than Γ in defining temp.
+                        // Tb += einsum("xpσ, xpm -> pmσ", temp2, ∇φ)[σ = β]
+
+                        // Wx
+                        tmp_val = 2.0 * v_gamma_bb[P] * rho_bk_x[P];
+                        tmp_val += v_gamma_ab[P] * rho_ak_x[P];
+                        tmp_val += 2.0 * v2_val_bb * rho_bx[P];
+                        tmp_val += v2_val_ab * rho_ax[P];
+                        tmp_val *= w[P];
+
+                        C_DAXPY(nlocal, tmp_val, phi_x[P], 1, Tbp[P], 1);
+
+                        // Wy
+                        tmp_val = 2.0 * v_gamma_bb[P] * rho_bk_y[P];
+                        tmp_val += v_gamma_ab[P] * rho_ak_y[P];
+                        tmp_val += 2.0 * v2_val_bb * rho_by[P];
+                        tmp_val += v2_val_ab * rho_ay[P];
+                        tmp_val *= w[P];
+
+                        C_DAXPY(nlocal, tmp_val, phi_y[P], 1, Tbp[P], 1);
+
+                        // Wz
+                        tmp_val = 2.0 * v_gamma_bb[P] * rho_bk_z[P];
+                        tmp_val += v_gamma_ab[P] * rho_ak_z[P];
+                        tmp_val += 2.0 * v2_val_bb * rho_bz[P];
+                        tmp_val += v2_val_ab * rho_az[P];
+                        tmp_val *= w[P];
+
+                        C_DAXPY(nlocal, tmp_val, phi_z[P], 1, Tbp[P], 1);
+                    }
                 }
+
+                parallel_timer_off("V_XCd", rank);
             }
 
-            // ===> Contract Ta and Tb aginst φ, replacing a point index with  an AO index <===
-            C_DGEMM('T', 'N', nlocal, nlocal, npoints, 1.0, phi[0], coll_funcs, Tap[0], max_functions, 0.0,
-                    Vax_localp[0], max_functions);
-            C_DGEMM('T', 'N', nlocal, nlocal, npoints, 1.0, phi[0], coll_funcs, Tbp[0], max_functions, 0.0,
-                    Vbx_localp[0], max_functions);
-
-            // ===> Add the adjoint to complete the LDA and GGA contributions  <===
-            for (int m = 0; m < nlocal; m++) {
-                for (int n = 0; n <= m; n++) {
-                    Vax_localp[m][n] = Vax_localp[n][m] = Vax_localp[m][n] + Vax_localp[n][m];
-                    Vbx_localp[m][n] = Vbx_localp[n][m] = Vbx_localp[m][n] + Vbx_localp[n][m];
+            // ===> Contract Ta and Tb aginst φ, replacing a point index with an AO index, for the whole batch <===
+            parallel_timer_on("V_XCd", rank);
+            C_DGEMM('T', 'N', nlocal, ldw, npoints, 1.0, phi[0], coll_funcs, Twp, ldw, 0.0, DVwp, ldw);
+
+            for (size_t k = 0; k < nbatch; k++) {
+                auto Vax_localp = R_Vax_rows[rank].data();
+                auto Vbx_localp = R_Vbx_rows[rank].data();
+                for (int m = 0; m < nlocal; m++) {
+                    Vax_localp[m] = DVwp + m * ldw + (2 * k) * nlocal;
+                    Vbx_localp[m] = DVwp + m * ldw + (2 * k + 1) * nlocal;
                 }
-            }
 
-            // => Unpacking <= //
-            auto Vaxp = Vax_AO[dindex]->pointer();
-            auto Vbxp = Vbx_AO[dindex]->pointer();
-            for (int ml = 0; ml < nlocal; ml++) {
-                int mg = function_map[ml];
-                for (int nl = 0; nl < ml; nl++) {
-                    int ng = function_map[nl];
+                // ===> Add the adjoint to complete the LDA and GGA contributions  <===
+                for (int m = 0; m < nlocal; m++) {
+                    for (int n = 0; n <= m; n++) {
+                        Vax_localp[m][n] = Vax_localp[n][m] = Vax_localp[m][n] + Vax_localp[n][m];
+                        Vbx_localp[m][n] = Vbx_localp[n][m] = Vbx_localp[m][n] + Vbx_localp[n][m];
+                    }
+                }
+
+                // => Unpacking <= //
+                auto Vaxp = Vax_AO[dstart + k]->pointer();
+                auto Vbxp = Vbx_AO[dstart + k]->pointer();
+                for (int ml = 0; ml < nlocal; ml++) {
+                    int mg = function_map[ml];
+                    for (int nl = 0; nl < ml; nl++) {
+                        int ng = function_map[nl];
 
 #pragma omp atomic update
-                    Vaxp[mg][ng] += Vax_localp[ml][nl];
+                        Vaxp[mg][ng] += Vax_localp[ml][nl];
 #pragma omp atomic update
-                    Vaxp[ng][mg] += Vax_localp[ml][nl];
+                        Vaxp[ng][mg] += Vax_localp[ml][nl];
 
 #pragma omp atomic update
-                    Vbxp[mg][ng] += Vbx_localp[ml][nl];
+                        Vbxp[mg][ng] += Vbx_localp[ml][nl];
 #pragma omp atomic update
-                    Vbxp[ng][mg] += Vbx_localp[ml][nl];
-                }
+                        Vbxp[ng][mg] += Vbx_localp[ml][nl];
+                    }
 #pragma omp atomic update
-                Vaxp[mg][mg] += Vax_localp[ml][ml];
+                    Vaxp[mg][mg] += Vax_localp[ml][ml];
 #pragma omp atomic update
-                Vbxp[mg][mg] += Vbx_localp[ml][ml];
+                    Vbxp[mg][mg] += Vbx_localp[ml][ml];
+                }
             }
             parallel_timer_off("V_XCd", rank);
         }
@@ -3765,17 +4258,18 @@ SharedMatrix UV::compute_gradient() {
     auto old_deriv = point_workers_[0]->deriv();
 
     // Setup the pointers
+    int deriv = (functional_->is_gga() || functional_->is_meta() ? 2 : 1);
     for (size_t i = 0; i < num_threads_; i++) {
         point_workers_[i]->set_pointers(D_AO_[0], D_AO_[1]);
-        point_workers_[i]->set_deriv((functional_->is_gga() || functional_->is_meta() ? 2 : 1));
+        point_workers_[i]->set_deriv(deriv);
     }
+    bool use_cache = collocation_cache_covers(deriv);
 
-    // Thread scratch
+    // Thread scratch, the blocks scatter straight into G
+    auto G = std::make_shared<Matrix>("XC Gradient", natom, 3);
     std::vector<std::shared_ptr<Vector>> Q_temp;
-    std::vector<SharedMatrix> G_local;
     for (size_t i = 0; i < num_threads_; i++) {
         Q_temp.push_back(std::make_shared<Vector>("Quadrature Temp", max_points));
-        G_local.push_back(std::make_shared<Matrix>("G Temp", natom, 3));
     }
 
     std::vector<double> functionalq(num_threads_);
@@ -3810,7 +4304,6 @@ SharedMatrix UV::compute_gradient() {
         auto Uap = Ua_local->pointer();
         auto Ub_local = pworker->scratch()[1]->clone();
         auto Ubp = Ub_local->pointer();
-        auto Gp = G_local[rank]->pointer();
 
         // ==> Per-block setup <== //
         auto block = grid_->blocks()[Q];
@@ -3821,10 +4314,11 @@ SharedMatrix UV::compute_gradient() {
         auto w = block->w();
         const auto& function_map = block->functions_local_to_global();
         auto nlocal = function_map.size();
+        std::vector<std::array<double, 3>> Gf(nlocal, {0.0, 0.0, 0.0});
 
         // ==> Compute rho, gamma, etc. for block <== //
         parallel_timer_on("Properties", rank);
-        pworker->compute_points(block);
+        pworker->compute_points(block, !use_cache);
         parallel_timer_off("Properties", rank);
 
         // ==> Compute functional values for block <== //
@@ -3913,13 +4407,12 @@ SharedMatrix UV::compute_gradient() {
         // dE += einsum("pnσ, pnx, ni -> ix", U, -- φ, δ)
         //                                       ∂x
         for (int ml = 0; ml < nlocal; ml++) {
-            auto A = primary_->function_to_center(function_map[ml]);
-            Gp[A][0] += C_DDOT(npoints, &Uap[0][ml], max_functions, &phi_x[0][ml], coll_funcs);
-            Gp[A][1] += C_DDOT(npoints, &Uap[0][ml], max_functions, &phi_y[0][ml], coll_funcs);
-            Gp[A][2] += C_DDOT(npoints, &Uap[0][ml], max_functions, &phi_z[0][ml], coll_funcs);
-            Gp[A][0] += C_DDOT(npoints, &Ubp[0][ml], max_functions, &phi_x[0][ml], coll_funcs);
-            Gp[A][1] += C_DDOT(npoints, &Ubp[0][ml], max_functions, &phi_y[0][ml], coll_funcs);
-            Gp[A][2] += C_DDOT(npoints, &Ubp[0][ml], max_functions, &phi_z[0][ml], coll_funcs);
+            Gf[ml][0] += C_DDOT(npoints, &Uap[0][ml], max_functions, &phi_x[0][ml], coll_funcs);
+            Gf[ml][1] += C_DDOT(npoints, &Uap[0][ml], max_functions, &phi_y[0][ml], coll_funcs);
+            Gf[ml][2] += C_DDOT(npoints, &Uap[0][ml], max_functions, &phi_z[0][ml], coll_funcs);
+            Gf[ml][0] += C_DDOT(npoints, &Ubp[0][ml], max_functions, &phi_x[0][ml], coll_funcs);
+            Gf[ml][1] += C_DDOT(npoints, &Ubp[0][ml], max_functions, &phi_y[0][ml], coll_funcs);
+            Gf[ml][2] += C_DDOT(npoints, &Ubp[0][ml], max_functions, &phi_z[0][ml], coll_funcs);
         }
 
         // => GGA Contribution (Term 2) <= //
@@ -3955,13 +4448,12 @@ SharedMatrix UV::compute_gradient() {
                         Tbp[P], 1);
             }
             for (int ml = 0; ml < nlocal; ml++) {
-                int A = primary_->function_to_center(function_map[ml]);
-                Gp[A][0] += C_DDOT(npoints, &Tap[0][ml], max_functions, &phi_xx[0][ml], coll_funcs);
-                Gp[A][1] += C_DDOT(npoints, &Tap[0][ml], max_functions, &phi_xy[0][ml], coll_funcs);
-                Gp[A][2] += C_DDOT(npoints, &Tap[0][ml], max_functions, &phi_xz[0][ml], coll_funcs);
-                Gp[A][0] += C_DDOT(npoints, &Tbp[0][ml], max_functions, &phi_xx[0][ml], coll_funcs);
-                Gp[A][1] += C_DDOT(npoints, &Tbp[0][ml], max_functions, &phi_xy[0][ml], coll_funcs);
-                Gp[A][2] += C_DDOT(npoints, &Tbp[0][ml], max_functions, &phi_xz[0][ml], coll_funcs);
+                Gf[ml][0] += C_DDOT(npoints, &Tap[0][ml], max_functions, &phi_xx[0][ml], coll_funcs);
+                Gf[ml][1] += C_DDOT(npoints, &Tap[0][ml], max_functions, &phi_xy[0][ml], coll_funcs);
+                Gf[ml][2] += C_DDOT(npoints, &Tap[0][ml], max_functions, &phi_xz[0][ml], coll_funcs);
+                Gf[ml][0] += C_DDOT(npoints, &Tbp[0][ml], max_functions, &phi_xx[0][ml], coll_funcs);
+                Gf[ml][1] += C_DDOT(npoints, &Tbp[0][ml], max_functions, &phi_xy[0][ml], coll_funcs);
+                Gf[ml][2] += C_DDOT(npoints, &Tbp[0][ml], max_functions, &phi_xz[0][ml], coll_funcs);
             }
 
             // y
@@ -3974,13 +4466,12 @@ SharedMatrix UV::compute_gradient() {
                         Tbp[P], 1);
             }
             for (int ml = 0; ml < nlocal; ml++) {
-                int A = primary_->function_to_center(function_map[ml]);
-                Gp[A][0] += C_DDOT(npoints, &Tap[0][ml], max_functions, &phi_xy[0][ml], coll_funcs);
-                Gp[A][1] += C_DDOT(npoints, &Tap[0][ml], max_functions, &phi_yy[0][ml], coll_funcs);
-                Gp[A][2] += C_DDOT(npoints, &Tap[0][ml], max_functions, &phi_yz[0][ml], coll_funcs);
-                Gp[A][0] += C_DDOT(npoints, &Tbp[0][ml], max_functions, &phi_xy[0][ml], coll_funcs);
-                Gp[A][1] += C_DDOT(npoints, &Tbp[0][ml], max_functions, &phi_yy[0][ml], coll_funcs);
-                Gp[A][2] += C_DDOT(npoints, &Tbp[0][ml], max_functions, &phi_yz[0][ml], coll_funcs);
+                Gf[ml][0] += C_DDOT(npoints, &Tap[0][ml], max_functions, &phi_xy[0][ml], coll_funcs);
+                Gf[ml][1] += C_DDOT(npoints, &Tap[0][ml], max_functions, &phi_yy[0][ml], coll_funcs);
+                Gf[ml][2] += C_DDOT(npoints, &Tap[0][ml], max_functions, &phi_yz[0][ml], coll_funcs);
+                Gf[ml][0] += C_DDOT(npoints, &Tbp[0][ml], max_functions, &phi_xy[0][ml], coll_funcs);
+                Gf[ml][1] += C_DDOT(npoints, &Tbp[0][ml], max_functions, &phi_yy[0][ml], coll_funcs);
+                Gf[ml][2] += C_DDOT(npoints, &Tbp[0][ml], max_functions, &phi_yz[0][ml], coll_funcs);
             }
 
             // z
@@ -3993,13 +4484,12 @@ SharedMatrix UV::compute_gradient() {
                         Tbp[P], 1);
             }
             for (int ml = 0; ml < nlocal; ml++) {
-                int A = primary_->function_to_center(function_map[ml]);
-                Gp[A][0] += C_DDOT(npoints, &Tap[0][ml], max_functions, &phi_xz[0][ml], coll_funcs);
-                Gp[A][1] += C_DDOT(npoints, &Tap[0][ml], max_functions, &phi_yz[0][ml], coll_funcs);
-                Gp[A][2] += C_DDOT(npoints, &Tap[0][ml], max_functions, &phi_zz[0][ml], coll_funcs);
-                Gp[A][0] += C_DDOT(npoints, &Tbp[0][ml], max_functions, &phi_xz[0][ml], coll_funcs);
-                Gp[A][1] += C_DDOT(npoints, &Tbp[0][ml], max_functions, &phi_yz[0][ml], coll_funcs);
-                Gp[A][2] += C_DDOT(npoints, &Tbp[0][ml], max_functions, &phi_zz[0][ml], coll_funcs);
+                Gf[ml][0] += C_DDOT(npoints, &Tap[0][ml], max_functions, &phi_xz[0][ml], coll_funcs);
+                Gf[ml][1] += C_DDOT(npoints, &Tap[0][ml], max_functions, &phi_yz[0][ml], coll_funcs);
+                Gf[ml][2] += C_DDOT(npoints, &Tap[0][ml], max_functions, &phi_zz[0][ml], coll_funcs);
+                Gf[ml][0] += C_DDOT(npoints, &Tbp[0][ml], max_functions, &phi_xz[0][ml], coll_funcs);
+                Gf[ml][1] += C_DDOT(npoints, &Tbp[0][ml], max_functions, &phi_yz[0][ml], coll_funcs);
+                Gf[ml][2] += C_DDOT(npoints, &Tbp[0][ml], max_functions, &phi_zz[0][ml], coll_funcs);
             }
         }
 
@@ -4049,25 +4539,20 @@ SharedMatrix UV::compute_gradient() {
                         C_DAXPY(nlocal, -2.0 * w[P] * (v_tau[P]), Uap[P], 1, Tap[P], 1);
                     }
                     for (int ml = 0; ml < nlocal; ml++) {
-                        int A = primary_->function_to_center(function_map[ml]);
-                        Gp[A][0] += C_DDOT(npoints, &Tap[0][ml], max_functions, &phi_j[0][0][ml], coll_funcs);
-                        Gp[A][1] += C_DDOT(npoints, &Tap[0][ml], max_functions, &phi_j[1][0][ml], coll_funcs);
-                        Gp[A][2] += C_DDOT(npoints, &Tap[0][ml], max_functions, &phi_j[2][0][ml], coll_funcs);
+                        Gf[ml][0] += C_DDOT(npoints, &Tap[0][ml], max_functions, &phi_j[0][0][ml], coll_funcs);
+                        Gf[ml][1] += C_DDOT(npoints, &Tap[0][ml], max_functions, &phi_j[1][0][ml], coll_funcs);
+                        Gf[ml][2] += C_DDOT(npoints, &Tap[0][ml], max_functions, &phi_j[2][0][ml], coll_funcs);
                     }
                 }
             }
         }
+        dft_integrators::scatter_gradient(primary_, function_map, Gf, G);
         Ua_local.reset();
         Ub_local.reset();
         parallel_timer_off("V_xc gradient", rank);
     }
     // timer_off("V: V_XC");
 
-    auto G = std::make_shared<Matrix>("XC Gradient", natom, 3);
-    for (auto const& val : G_local) {
-        G->add(val);
-    }
-
     quad_values_["FUNCTIONAL"] = std::accumulate(functionalq.begin(), functionalq.end(), 0.0);
     quad_values_["RHO_A"] = std::accumulate(rhoaq.begin(), rhoaq.end(), 0.0);
     quad_values_["RHO_AX"] = std::accumulate(rhoaxq.begin(), rhoaxq.end(), 0.0);
@@ -4137,6 +4622,7 @@ SharedMatrix UV::compute_hessian() {
         functional_workers_[i]->set_deriv(derivlev);
         functional_workers_[i]->allocate();
     }
+    bool use_cache = collocation_cache_covers(derivlev);
 
     // ==> Per thread temporaries <==
     std::vector<SharedMatrix> V_local;
@@ -4215,7 +4701,7 @@ SharedMatrix UV::compute_hessian() {
         int nlocal = function_map.size();
 
         // ==> Compute values at points <==
-        pworker->compute_points(block);
+        pworker->compute_points(block, !use_cache);
         auto& vals = fworker->compute_functional(pworker->point_values(), npoints);
 
         auto phi = pworker->basis_value("PHI")->pointer();
@@ -30,6 +30,7 @@
 #define LIBFOCK_DFT_H
 #include "psi4/libmints/typedefs.h"
 #include "psi4/pragma.h"
+#include <functional>
 #include <vector>
 #include <map>
 #include <unordered_map>
@@ -40,6 +41,7 @@ class BasisSet;
 class Options;
 class DFTGrid;
 class PointFunctions;
+class CollocationCache;
 class SuperFunctional;
 class BlockOPoints;
 
@@ -60,12 +62,16 @@ class PSI_API VBase {
     int print_;
     /// Number of threads
     int num_threads_;
+    /// Build per-thread workers on their own thread, so their memory is first touched there?
+    bool numa_first_touch_;
     /// Number of basis functions;
     int nbf_;
     /// Rho threshold for the second derivative;
     double v2_rho_cutoff_;
     /// VV10 interior kernel threshold
     double vv10_rho_cutoff_;
+    /// Interaction radius of the VV10 kernel, zero for all pairs
+    double vv10_radius_;
     /// Options object, used to build grid
     Options& options_;
     /// Basis set used in the integration
@@ -76,13 +82,43 @@ class PSI_API VBase {
     std::vector<std::shared_ptr<SuperFunctional>> functional_workers_;
     /// Point function computer (densities, gammas, basis values)
     std::vector<std::shared_ptr<PointFunctions>> point_workers_;
+    /// Number of grid blocks whose points are handed to the functional in one call (DFT_BLOCK_BATCH)
+    size_t block_batch_;
+    /// Functional workers sized for a batch of blocks, rebuilt from functional_workers_ on each use
+    std::vector<std::shared_ptr<SuperFunctional>> batch_functional_workers_;
+    /// Point workers for blocks 1..block_batch_-1 of each thread's batch, block 0 uses point_workers_
+    std::vector<std::shared_ptr<PointFunctions>> batch_point_workers_;
+    /// Per-thread gathered point values of a batch
+    std::vector<std::map<std::string, SharedVector>> batch_point_values_;
+    /// Number of trial densities contracted together per block in compute_Vx (DFT_VX_BATCH)
+    size_t vx_batch_;
+    /// Skip blocks whose largest density fell below this in the last evaluation (DFT_BLOCK_SCREENING_CUTOFF)
+    double block_rho_cutoff_;
+    /// Is density screening of blocks currently active?
+    bool block_screening_;
+    /// Largest density of each block the last time it was evaluated, negative if never evaluated
+    std::vector<double> block_max_rho_;
+    /// Reuse the V contribution of blocks whose density moved less than this since it was built
+    double incremental_xc_cutoff_;
+    /// Are stored block contributions currently reused?
+    bool incremental_xc_;
+    /// Density, gradient and tau of each block when its stored contribution was built, empty if none
+    std::vector<std::vector<double>> block_xc_rho_;
+    /// Stored V contribution of each block, one nlocal x nlocal matrix per spin
+    std::vector<std::vector<double>> block_xc_V_;
+    /// Stored quadrature values of each block
+    std::vector<std::vector<double>> block_xc_q_;
     /// Integration grid, built by KSPotential
     std::shared_ptr<DFTGrid> grid_;
     /// Quadrature values obtained during integration
     std::map<std::string, double> quad_values_;
     // Caches collocation grids
-    std::unordered_map<size_t, std::map<std::string, SharedMatrix>> cache_map_;
+    std::shared_ptr<CollocationCache> cache_map_;
     int cache_map_deriv_;
+    /// Derivative order to cache for a later gradient or Hessian, -1 to cache only what the energy needs
+    int collocation_deriv_;
+    /// Does the collocation cache hold the basis function derivatives up to deriv?
+    bool collocation_cache_covers(int deriv) const { return cache_map_deriv_ >= deriv; }
 
     /// AO2USO matrix (if not C1)
     SharedMatrix AO2USO_;
@@ -103,6 +139,33 @@ class PSI_API VBase {
 
     /// Set things up
     void common_init();
+    /// Call build(i) for every thread i; in NUMA-aware mode on thread i itself
+    void build_thread_workers(const std::function<void(size_t)>& build);
+
+    // => Batched functional evaluation over several blocks <= //
+    /// (Re)build batch_functional_workers_ from functional_workers_, if batching
+    void build_batch_functional_workers();
+    /// Point worker holding block b of the current batch of thread rank
+    std::shared_ptr<PointFunctions> batch_point_worker(size_t rank, size_t b);
+    /// Gather the point values of blocks[Qstart, Qstop) and evaluate the functional on all of them at once
+    void compute_functional_batch(size_t rank, const std::vector<size_t>& blocks, size_t Qstart, size_t Qstop);
+    /// Copy the functional values of block Q of the batch starting at Qstart into functional_workers_[rank]
+    void scatter_functional_batch(size_t rank, const std::vector<size_t>& blocks, size_t Qstart, size_t Q);
+
+    // => Density screening of blocks <= //
+    /// Blocks to evaluate in this Fock build, dropping those screened by the previous density
+    std::vector<size_t> screen_blocks();
+    /// Record the largest density of block Q from the point values of pworker
+    void record_block_density(size_t Q, std::shared_ptr<PointFunctions> pworker);
+
+    // => Incremental XC builds <= //
+    /// Has the density of block Q in pworker moved less than the cutoff since its stored contribution was built?
+    bool block_xc_unchanged(size_t Q, std::shared_ptr<PointFunctions> pworker);
+    /// Store the V contribution (one matrix per spin) and quadrature values of block Q for later builds
+    void store_block_xc(size_t Q, std::shared_ptr<PointFunctions> pworker, const std::vector<SharedMatrix>& V,
+                        const std::vector<double>& qvals);
+    /// Copy the stored V contribution of block Q back into V and return its quadrature values
+    const std::vector<double>& restore_block_xc(size_t Q, const std::vector<SharedMatrix>& V);
 
    public:
     VBase(std::shared_ptr<SuperFunctional> functional, std::shared_ptr<BasisSet> primary, Options& options);
@@ -116,13 +179,30 @@ class PSI_API VBase {
     std::shared_ptr<SuperFunctional> functional() const { return functional_; }
     std::vector<std::shared_ptr<PointFunctions>> properties() const { return point_workers_; }
     std::shared_ptr<DFTGrid> grid() const { return grid_; }
+    /// Use grid instead of building one in initialize(); it must come from the same molecule, basis and options
+    void set_grid(std::shared_ptr<DFTGrid> grid) { grid_ = grid; }
     std::shared_ptr<BlockOPoints> get_block(int block);
     size_t nblocks();
     std::map<std::string, double>& quadrature_values() { return quad_values_; }
 
-    // Creates a collocation cache map based on stride
+    // Creates a collocation cache of up to memory doubles, compressed and spilled to disk as the options allow
     void build_collocation_cache(size_t memory);
-    void clear_collocation_cache() { cache_map_.clear(); }
+    void clear_collocation_cache();
+    // Derivative order a following gradient (1 LDA, 2 GGA) or Hessian needs, cached with the energy if memory allows
+    void set_collocation_deriv(int deriv) { collocation_deriv_ = deriv; }
+    int collocation_deriv() const { return collocation_deriv_; }
+
+    // Integrates the current density and functional on another grid, which must use ATOMIC blocking.
+    // Returns per-atom "RHO", "FUNCTIONAL" and "TIME" [s] vectors, used to profile grid quality
+    std::map<std::string, SharedVector> profile_grid(std::shared_ptr<DFTGrid> grid);
+
+    // Density screening of grid blocks, disabled for a final full pass once the SCF has converged
+    void set_block_screening(bool screen) { block_screening_ = screen && (block_rho_cutoff_ > 0.0); }
+    bool block_screening() const { return block_screening_; }
+
+    // Reuse of block contributions whose density has settled, disabled for a final full pass once the SCF has converged
+    void set_incremental_xc(bool incremental);
+    bool incremental_xc() const { return incremental_xc_; }
 
     // Set the D matrix, get it back if needed
     void set_D(std::vector<SharedMatrix> Dvec);
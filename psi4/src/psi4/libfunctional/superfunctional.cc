@@ -922,7 +922,8 @@ std::map<std::string, SharedVector> SuperFunctional::compute_vv10_cache(const st
 }
 double SuperFunctional::compute_vv10_kernel(const std::map<std::string, SharedVector>& vals,
                                             const std::vector<std::map<std::string, SharedVector>>& vv10_cache,
-                                            std::shared_ptr<BlockOPoints> block, int npoints, bool do_grad) {
+                                            std::shared_ptr<BlockOPoints> block, int npoints, bool do_grad,
+                                            double cutoff) {
     // Kernel between left (*this) and right (vv10_cache) grids
 
     // Compute the vv10 cache in place
@@ -954,6 +955,32 @@ double SuperFunctional::compute_vv10_kernel(const std::map<std::string, SharedVe
     const double* l_W0 = vv_values_["W0"]->pointer();
     const double* l_kappa = vv_values_["KAPPA"]->pointer();
 
+    // Right blocks within reach of this block, unpacked once rather than per point
+    struct RightBlock {
+        const double *x, *y, *z, *w, *rho, *W0, *kappa;
+        size_t npoints;
+    };
+    std::vector<RightBlock> r_blocks;
+    const Vector3 l_center = block->center();
+    for (const auto& r_block : vv10_cache) {
+        auto bound = r_block.find("BOUND");
+        if (cutoff > 0.0 && bound != r_block.end()) {
+            const double* bp = bound->second->pointer();
+            const Vector3 r_center(bp[0], bp[1], bp[2]);
+            if (l_center.distance(r_center) - block->R() - bp[3] > cutoff) continue;
+        }
+        RightBlock rb;
+        rb.x = r_block.at("X")->pointer();
+        rb.y = r_block.at("Y")->pointer();
+        rb.z = r_block.at("Z")->pointer();
+        rb.w = r_block.at("W")->pointer();
+        rb.rho = r_block.at("RHO")->pointer();
+        rb.W0 = r_block.at("W0")->pointer();
+        rb.kappa = r_block.at("KAPPA")->pointer();
+        rb.npoints = r_block.at("KAPPA")->dimpi()[0];
+        r_blocks.push_back(rb);
+    }
+
     for (size_t i = 0; i < l_npoints; i++) {
         // Add Phi agnostic quantities
         vv10_e += l_w[i] * l_rho[i] * vv10_beta;
@@ -969,17 +996,17 @@ double SuperFunctional::compute_vv10_kernel(const std::map<std::string, SharedVe
         double xc = 0.0;
         double yc = 0.0;
         double zc = 0.0;
-        for (auto r_block : vv10_cache) {
+        for (const auto& r_block : r_blocks) {
             // Get right points
-            const double* r_x = r_block["X"]->pointer();
-            const double* r_y = r_block["Y"]->pointer();
-            const double* r_z = r_block["Z"]->pointer();
-            const double* r_w = r_block["W"]->pointer();
-            const double* r_rho = r_block["RHO"]->pointer();
-            const double* r_W0 = r_block["W0"]->pointer();
-            const double* r_kappa = r_block["KAPPA"]->pointer();
-
-            const size_t r_npoints = r_block["KAPPA"]->dimpi()[0];
+            const double* r_x = r_block.x;
+            const double* r_y = r_block.y;
+            const double* r_z = r_block.z;
+            const double* r_w = r_block.w;
+            const double* r_rho = r_block.rho;
+            const double* r_W0 = r_block.W0;
+            const double* r_kappa = r_block.kappa;
+
+            const size_t r_npoints = r_block.npoints;
 
             // Interior Kernel
             if (do_grad) {
@@ -0,0 +1,144 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Psi4: an open-source quantum chemistry software package
+ *
+ * Copyright (c) 2007-2023 The Psi4 Developers.
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This file is part of Psi4.
+ *
+ * Psi4 is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * Psi4 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with Psi4; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * @END LICENSE
+ */
+
+/*!
+  \file
+  \ingroup IWL
+*/
+#include <algorithm>
+#include <cstring>
+#include "psi4/libpsio/psio.h"
+#include "psi4/libpsi4util/exception.h"
+#include "iwl.hpp"
+
+namespace psi {
+
+int IWL::fetch_block(std::vector<char> &block, int nbuf) {
+    psio_tocentry *entry = psio_->tocscan(itap_, IWL_KEY_BUF);
+    if (entry == nullptr) throw PSIEXCEPTION("IWL::fetch_block: no IWL buffers on this file.");
+
+    // Never ask for more than is left in the entry; the final block is usually short
+    size_t tocentry_size = sizeof(psio_tocentry) - 2 * sizeof(psio_tocentry *);
+    psio_address start = psio_get_global_address(psio_get_address(entry->sadd, tocentry_size), bufpos_);
+    size_t remaining =
+        (entry->eadd.page * PSIO_PAGELEN + entry->eadd.offset) - (start.page * PSIO_PAGELEN + start.offset);
+    int navail = std::min<size_t>(nbuf, remaining / bufszc_);
+    if (navail < 1) throw PSIEXCEPTION("IWL::fetch_block: attempt to read past the last IWL buffer.");
+
+    block.resize((size_t)navail * bufszc_);
+    psio_address next;
+    psio_->read(itap_, IWL_KEY_BUF, block.data(), block.size(), bufpos_, &next);
+
+    int nread = 0;
+    do {
+        lastbuf_ = raw_last_buffer(raw_buffer(block.data(), nread++));
+    } while (!lastbuf_ && nread < navail);
+
+    block.resize((size_t)nread * bufszc_);
+    bufpos_ = psio_get_address(bufpos_, (size_t)nread * bufszc_);
+    return nread;
+}
+
+void IWL::put_block(const char *block, int nbuf) {
+    if (nbuf < 1) return;
+    psio_->write(itap_, IWL_KEY_BUF, const_cast<char *>(block), (size_t)nbuf * bufszc_, bufpos_, &bufpos_);
+    lastbuf_ = raw_last_buffer(raw_buffer(const_cast<char *>(block), nbuf - 1));
+}
+
+IWLBlockWriter::IWLBlockWriter(IWL &iwl, int nthread, int bufs_per_block)
+    : iwl_(iwl), bufs_per_block_(bufs_per_block), nfull_(nthread, 0), count_(nthread, 0) {
+    if (nthread < 1 || bufs_per_block < 1)
+        throw PSIEXCEPTION("IWLBlockWriter: need at least one thread and one buffer per block.");
+    blocks_.resize(nthread);
+    for (auto &block : blocks_) {
+        block.resize((size_t)bufs_per_block_ * iwl_.buffer_size());
+        IWL::raw_buffer_count(block.data()) = 0;
+    }
+}
+
+void IWLBlockWriter::write_block(int thread, int nbuf, bool last) {
+    char *block = blocks_[thread].data();
+    for (int n = 0; n < nbuf; ++n) IWL::raw_last_buffer(iwl_.raw_buffer(block, n)) = 0;
+    if (last) IWL::raw_last_buffer(iwl_.raw_buffer(block, nbuf - 1)) = 1;
+    std::lock_guard<std::mutex> lock(write_mutex_);
+    iwl_.put_block(block, nbuf);
+}
+
+void IWLBlockWriter::write_value(int thread, int p, int q, int r, int s, double value) {
+    char *buf = iwl_.raw_buffer(blocks_[thread].data(), nfull_[thread]);
+    int &inbuf = IWL::raw_buffer_count(buf);
+
+    Label *labels = IWL::raw_labels(buf) + 4 * inbuf;
+    labels[0] = p;
+    labels[1] = q;
+    labels[2] = r;
+    labels[3] = s;
+    iwl_.raw_values(buf)[inbuf] = value;
+    ++count_[thread];
+
+    if (++inbuf < iwl_.ints_per_buffer()) return;
+
+    // This buffer is full; ship the block once every buffer in it is
+    if (++nfull_[thread] == bufs_per_block_) {
+        write_block(thread, bufs_per_block_, false);
+        nfull_[thread] = 0;
+    }
+    IWL::raw_buffer_count(iwl_.raw_buffer(blocks_[thread].data(), nfull_[thread])) = 0;
+}
+
+void IWLBlockWriter::flush() {
+    // Everything still staged, per thread, including a trailing partial buffer
+    std::vector<int> nstaged(blocks_.size());
+    int last = -1;
+    for (size_t t = 0; t < blocks_.size(); ++t) {
+        char *partial = iwl_.raw_buffer(blocks_[t].data(), nfull_[t]);
+        nstaged[t] = nfull_[t] + (IWL::raw_buffer_count(partial) ? 1 : 0);
+        if (nstaged[t]) last = t;
+    }
+
+    // Readers expect at least one buffer, so an empty file still gets one
+    if (last < 0) {
+        last = 0;
+        nstaged[0] = 1;
+    }
+
+    for (int t = 0; t <= last; ++t) {
+        if (!nstaged[t]) continue;
+        write_block(t, nstaged[t], t == last);
+        nfull_[t] = 0;
+        IWL::raw_buffer_count(blocks_[t].data()) = 0;
+    }
+}
+
+size_t IWLBlockWriter::count() const {
+    size_t total = 0;
+    for (size_t c : count_) total += c;
+    return total;
+}
+
+}  // namespace psi
@@ -38,6 +38,8 @@ typedef double Value;
 #define IWL_KEY_ONEL "IWL One-electron matrix elements"
 
 #define IWL_INTS_PER_BUF 2980
+/* Number of buffers moved per PSIO request by the bulk readers and writers */
+#define IWL_BUFS_PER_BLOCK 64
 }
 
 #endif
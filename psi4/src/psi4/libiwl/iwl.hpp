@@ -30,6 +30,8 @@
 #define _psi_src_lib_libiwl_iwl_hpp_
 
 #include <cstdio>
+#include <mutex>
+#include <vector>
 #include "psi4/libpsio/psio.hpp"
 #include "config.h"
 
@@ -77,6 +79,26 @@ class PSI_API IWL {
     void fetch();
     void put();
 
+    /*
+     * Bulk access to the buffer stream.  A block holds whole buffers back to
+     * back, exactly as they are laid out on disk; use the raw_* helpers below
+     * to get at the contents of buffer n of a block.  These calls bypass the
+     * in-core buffer (labels()/values()) but keep the file position and the
+     * last buffer flag in step, so they can be mixed with fetch() and put().
+     */
+    /// Read up to nbuf buffers with a single request, stopping after the last buffer; returns how many were read
+    int fetch_block(std::vector<char> &block, int nbuf);
+    /// Write nbuf buffers from block with a single request
+    void put_block(const char *block, int nbuf);
+
+    char *raw_buffer(char *block, int n) const { return block + (size_t)n * bufszc_; }
+    static int &raw_last_buffer(char *buf) { return reinterpret_cast<int *>(buf)[0]; }
+    static int &raw_buffer_count(char *buf) { return reinterpret_cast<int *>(buf)[1]; }
+    static Label *raw_labels(char *buf) { return reinterpret_cast<Label *>(buf + 2 * sizeof(int)); }
+    Value *raw_values(char *buf) const {
+        return reinterpret_cast<Value *>(buf + 2 * sizeof(int) + ints_per_buf_ * 4 * sizeof(Label));
+    }
+
     static void read_one(PSIO *psio, int itap, const char *label, double *ints, int ntri, int erase, int printflg,
                          std::string OutFileRMR);
     static void write_one(PSIO *psio, int itap, const char *label, int ntri, double *onel_ints);
@@ -92,6 +114,36 @@ class PSI_API IWL {
     void flush(int lastbuf);
     void to_end();
 };
+
+/*
+ * Lets several threads write integrals to one IWL file.  Every thread fills
+ * its own block of buffers, and only whole blocks are handed to PSIO, one
+ * writer at a time.  The order of the integrals on disk is therefore not
+ * deterministic, which none of the IWL readers rely on.
+ */
+class PSI_API IWLBlockWriter {
+    IWL &iwl_;
+    int bufs_per_block_;
+    /// Per-thread staging blocks
+    std::vector<std::vector<char>> blocks_;
+    /// Number of completely filled buffers in each staging block
+    std::vector<int> nfull_;
+    /// Number of integrals written by each thread
+    std::vector<size_t> count_;
+    std::mutex write_mutex_;
+
+    void write_block(int thread, int nbuf, bool last);
+
+   public:
+    IWLBlockWriter(IWL &iwl, int nthread, int bufs_per_block = IWL_BUFS_PER_BLOCK);
+
+    /// Stage one integral; thread must be distinct for every concurrent caller
+    void write_value(int thread, int p, int q, int r, int s, double value);
+    /// Write out all partially filled buffers and mark the last one; call once, after all threads are done
+    void flush();
+
+    size_t count() const;
+};
 }
 
 #endif
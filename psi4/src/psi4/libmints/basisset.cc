@@ -50,8 +50,11 @@
 #include "pointgrp.h"
 #include "wavefunction.h"
 #include "coordentry.h"
+#include "shellpair.h"
 #include "psi4/libpsi4util/process.h"
 
+#include "gau2grid/gau2grid.h"
+
 #include <memory>
 #include <regex>
 #include <stdexcept>
@@ -120,6 +123,8 @@ BasisSet::BasisSet() {
     target_ = "(Empty Basis Set)";
     shells_[0] = GaussianShell(Gaussian, 0, nprimitive_, uoriginal_coefficients_.data(), ucoefficients_.data(),
                                uerd_coefficients_.data(), uexponents_.data(), GaussianType(0), 0, xyz_.data(), 0);
+    shell_pair_cache_ = std::make_shared<ShellPairCache>();
+    sieve_cache_ = std::make_shared<SieveCache>();
 }
 
 BasisSet::~BasisSet() {}
@@ -900,6 +905,9 @@ void BasisSet::update_l2_shells(bool embed_normalization) {
         auto l2e = libint2::svector<double>(&uexponents_[offset], &uexponents_[offset + nprim]);
         l2_shells_[ishell] = libint2::Shell{l2e, {{am, puream_, l2c}}, {{xyz[0], xyz[1], xyz[2]}}, embed_normalization};
     }
+    // Pair and screening data built from the old shells must not be handed out again
+    shell_pair_cache_ = std::make_shared<ShellPairCache>();
+    sieve_cache_ = std::make_shared<SieveCache>();
 }
 
 std::string BasisSet::make_filename(const std::string &name) {
@@ -1222,53 +1230,23 @@ void BasisSet::move_atom(int atom, const Vector3 &trans) {
 }
 
 void BasisSet::compute_phi(double *phi_ao, double x, double y, double z) {
-    zero_arr(phi_ao, nbf());
+    // gau2grid contracts the primitives and applies the spherical transformation in its
+    // per-AM kernels, the same path the DFT collocation takes
+#if psi4_SHGSHELL_ORDERING == LIBINT_SHGSHELL_ORDERING_STANDARD
+    const int order = puream_ ? GG_SPHERICAL_CCA : GG_CARTESIAN_CCA;
+#elif psi4_SHGSHELL_ORDERING == LIBINT_SHGSHELL_ORDERING_GAUSSIAN
+    const int order = puream_ ? GG_SPHERICAL_GAUSSIAN : GG_CARTESIAN_CCA;
+#else
+#  error "unknown value of macro psi4_SHGSHELL_ORDERING"
+#endif
+    const double xyz[3] = {x, y, z};
 
     int ao = 0;
     for (int ns = 0; ns < nshell(); ns++) {
         const GaussianShell &shell = shells_[ns];
         int am = shell.am();
-        int nprim = shell.nprimitive();
-        const double *a = shell.exps();
-        const double *c = shell.coefs();
-
-        const double *xyz = shell.center();
-        double dx = x - xyz[0];
-        double dy = y - xyz[1];
-        double dz = z - xyz[2];
-        double rr = dx * dx + dy * dy + dz * dz;
-
-        double cexpr = 0;
-        for (int np = 0; np < nprim; np++) cexpr += c[np] * exp(-a[np] * rr);
-
-        if (puream_) {
-            const auto s_transform = SphericalTransform(am);
-            std::vector<double> cart_buffer(INT_NCART(am), 0.0);
-
-            for (int l = 0; l < INT_NCART(am); l++) {
-                Vector3 &components = exp_ao[am][l];
-                cart_buffer[l] += pow(dx, static_cast<double>(components[0])) *
-                                  pow(dy, static_cast<double>(components[1])) *
-                                  pow(dz, static_cast<double>(components[2])) * cexpr;
-            }
-
-            for (int ind = 0; ind < s_transform.n(); ind++) {
-                int lcart = s_transform.cartindex(ind);
-                int lpure = s_transform.pureindex(ind);
-                double coef = s_transform.coef(ind);
-
-                phi_ao[ao + lpure] += coef * cart_buffer[lcart];
-            }
-
-        } else {
-            for (int l = 0; l < INT_NCART(am); l++) {
-                Vector3 &components = exp_ao[am][l];
-                phi_ao[ao + l] += pow(dx, static_cast<double>(components[0])) *
-                                  pow(dy, static_cast<double>(components[1])) *
-                                  pow(dz, static_cast<double>(components[2])) * cexpr;
-            }
-        }
-
+        gg_collocation(am, 1, xyz, 1, shell.nprimitive(), shell.coefs(), shell.exps(), shell.center(), order,
+                       phi_ao + ao);
         ao += INT_NFUNC(puream_, am);
     }  // nshell
 }
@@ -58,6 +58,8 @@ class GaussianShell;
 class BasisSetParser;
 class SOBasisSet;
 class IntegralFactory;
+class ShellPairCache;
+class SieveCache;
 
 /*! \ingroup MINTS */
 
@@ -168,6 +170,11 @@ class PSI_API BasisSet {
     /// The flattened list of Cartesian coordinates for each atom
     std::vector<double> xyz_;
 
+    /// libint2 primitive pair data against partner basis sets; replaced whenever the Libint2 shells change
+    std::shared_ptr<ShellPairCache> shell_pair_cache_;
+    /// Two-electron screening data of this basis set; replaced whenever the Libint2 shells change
+    std::shared_ptr<SieveCache> sieve_cache_;
+
     /// Update Libint2 shells
     void update_l2_shells(bool embed_normalization = true);
 
@@ -288,6 +295,10 @@ class PSI_API BasisSet {
      *  @return A shared pointer to the libint2::Shell object for the i'th shell.
      */
     const libint2::Shell &l2_shell(int si) const;
+    /// Cache of libint2 primitive pair data shared by all integral objects built on this basis set
+    std::shared_ptr<ShellPairCache> shell_pair_cache() const { return shell_pair_cache_; }
+    /// Cache of two-electron screening data shared by all integral objects built on this basis set
+    std::shared_ptr<SieveCache> sieve_cache() const { return sieve_cache_; }
 
     /** Return the i'th Gaussian shell on center
      *  @param center atomic center
@@ -30,6 +30,8 @@
 #include "psi4/libmints/molecule.h"
 #include "psi4/libmints/integral.h"
 #include "psi4/libmints/3coverlap.h"
+#include "psi4/libmints/onebody.h"
+#include "psi4/libmints/twobody.h"
 
 #include "psi4/libqt/qt.h"
 #include "psi4/libciomr/libciomr.h"
@@ -37,14 +39,21 @@
 #include "psi4/libpsio/psio.h"
 #include "psi4/psi4-dec.h"
 #include "psi4/libpsi4util/libpsi4util.h"
+#include "psi4/libpsi4util/process.h"
 #include "psi4/libpsi4util/PsiOutStream.h"
 
+#include <array>
+#include <functional>
 #include <map>
 #include <string>
 #include <cmath>
 #include <cstdlib>
 #include <vector>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #ifdef USING_LAPACK_MKL
 #include <mkl.h>
 #endif
@@ -1284,7 +1293,7 @@ void benchmark_blas3(int N, double min_time, int max_threads) {
         outfile->Printf("\n");
     }
 }
-void benchmark_disk(int N, double min_time) {
+std::map<std::string, double> benchmark_disk(int N, double min_time) {
     outfile->Printf("\n");
     outfile->Printf("                              ------------------------------ \n");
     outfile->Printf("                              ======> PSIO BENCHMARKS <===== \n");
@@ -1521,6 +1530,17 @@ void benchmark_disk(int N, double min_time) {
         outfile->Printf("\n");
     }
     outfile->Printf("\n");
+
+    std::map<std::string, double> results;
+    for (size_t s = 0; s < ops.size(); s++) {
+        dim = 1;
+        for (int k = 0; k < N; k++) {
+            dim *= 2;
+            size_t full_dim = dim * (size_t)dim;
+            results[ops[s] + " " + std::to_string(dim)] = sizeof(double) * full_dim / timings[ops[s]][k];
+        }
+    }
+    return results;
 }
 void benchmark_math(double min_time) {
     double T;
@@ -2558,4 +2578,267 @@ void benchmark_integrals(int max_am, double min_time) {
     }
 }
 
+namespace {
+
+const char* am_letters = "spdfghiklmnoqrtuvwxyz";
+
+// A sample of the shell pairs (or quartets) of one angular momentum class
+struct AMClass {
+    std::string label;
+    std::vector<std::array<int, 4>> shells;
+};
+
+// Up to max_sample entries of v, spread evenly over v
+template <typename T>
+std::vector<T> spread_sample(const std::vector<T>& v, size_t max_sample) {
+    if (v.size() <= max_sample) return v;
+    std::vector<T> sample;
+    for (size_t i = 0; i < max_sample; i++) sample.push_back(v[(i * v.size()) / max_sample]);
+    return sample;
+}
+
+// Runs work(), which returns the number of integrals it produced, until min_time has passed.
+// Returns the integrals produced per second.
+double integral_throughput(const std::function<size_t()>& work, double min_time) {
+    size_t nints = 0L;
+    double T = 0.0;
+    Timer timer;
+    do {
+        nints += work();
+        T = timer.get();
+    } while (T < min_time);
+    return nints / T;
+}
+
+void print_class_table(const std::string& type, const std::vector<AMClass>& classes, const std::vector<double>& rates,
+                       std::map<std::string, double>& results) {
+    outfile->Printf("  Integral Type: %s\n\n", type.c_str());
+    outfile->Printf("    %-12s %8s %12s %12s\n", "Class", "Sampled", "Ints/s", "GiB/s");
+    for (size_t i = 0; i < classes.size(); i++) {
+        outfile->Printf("    %-12s %8zu %12.3E %12.3E\n", classes[i].label.c_str(), classes[i].shells.size(), rates[i],
+                        rates[i] * 8.0 / (1024.0 * 1024.0 * 1024.0));
+        results[type + " " + classes[i].label] = rates[i];
+    }
+    outfile->Printf("\n");
+}
+
+}  // namespace
+
+std::map<std::string, double> benchmark_integral_engines(std::shared_ptr<BasisSet> basis,
+                                                         std::shared_ptr<BasisSet> aux, double min_time, int nthread) {
+    const size_t max_sample = 64;
+    std::map<std::string, double> results;
+    std::shared_ptr<BasisSet> zero = BasisSet::zero_ao_basis_set();
+    auto factory = std::make_shared<IntegralFactory>(basis, basis, basis, basis);
+    int nshell = basis->nshell();
+
+    // => Shell pairs and quartets, sorted into angular momentum classes, higher am first <= //
+    std::map<std::pair<int, int>, std::vector<std::pair<int, int>>> pairs_by_class;
+    for (int M = 0; M < nshell; M++) {
+        for (int N = 0; N <= M; N++) {
+            int P = M, Q = N;
+            if (basis->shell(P).am() < basis->shell(Q).am()) std::swap(P, Q);
+            pairs_by_class[std::make_pair(basis->shell(P).am(), basis->shell(Q).am())].emplace_back(P, Q);
+        }
+    }
+
+    std::vector<AMClass> pair_classes;
+    for (const auto& kv : pairs_by_class) {
+        AMClass cls;
+        cls.label = std::string("(") + am_letters[kv.first.first] + "|" + am_letters[kv.first.second] + ")";
+        for (const auto& PQ : spread_sample(kv.second, max_sample)) cls.shells.push_back({PQ.first, PQ.second, 0, 0});
+        pair_classes.push_back(cls);
+    }
+
+    std::vector<AMClass> quartet_classes;
+    std::vector<std::array<int, 4>> all_quartets;
+    for (auto bra = pairs_by_class.begin(); bra != pairs_by_class.end(); ++bra) {
+        for (auto ket = pairs_by_class.begin(); ket != std::next(bra); ++ket) {
+            const auto& bra_pairs = bra->second;
+            const auto& ket_pairs = ket->second;
+            AMClass cls;
+            cls.label = std::string("(") + am_letters[bra->first.first] + am_letters[bra->first.second] + "|" +
+                        am_letters[ket->first.first] + am_letters[ket->first.second] + ")";
+            size_t nquartet = std::min(max_sample, bra_pairs.size() * ket_pairs.size());
+            for (size_t i = 0; i < nquartet; i++) {
+                const auto& PQ = bra_pairs[i % bra_pairs.size()];
+                const auto& RS = ket_pairs[(i / bra_pairs.size() + i) % ket_pairs.size()];
+                cls.shells.push_back({PQ.first, PQ.second, RS.first, RS.second});
+            }
+            all_quartets.insert(all_quartets.end(), cls.shells.begin(), cls.shells.end());
+            quartet_classes.push_back(cls);
+        }
+    }
+
+    outfile->Printf("\n");
+    outfile->Printf("                              ------------------------------------------ \n");
+    outfile->Printf("                              ======> INTEGRAL ENGINE BENCHMARKS <===== \n");
+    outfile->Printf("                              ------------------------------------------ \n");
+    outfile->Printf("\n");
+    outfile->Printf("  Parameters:\n");
+    outfile->Printf("   -Basis set: %s (%d shells, %d functions)\n", basis->name().c_str(), nshell, basis->nbf());
+    if (aux) outfile->Printf("   -Auxiliary basis set: %s\n", aux->name().c_str());
+    outfile->Printf("   -Minimum runtime (per class): %14.10f [s].\n", min_time);
+    outfile->Printf("   -Up to %zu shell pairs or quartets are sampled per class.\n", max_sample);
+    outfile->Printf("\n");
+    outfile->Printf("  Notes:\n");
+    outfile->Printf("   -Rates count every integral written to the buffer, including those of screened quartets.\n");
+    outfile->Printf("   -GiB/s is the rate at which doubles are produced.\n");
+    outfile->Printf("\n");
+
+    // => Two-electron, four-center operators <= //
+    std::string eri_label =
+        Process::environment.options.get_str("INTEGRAL_PACKAGE") == "SIMINT" ? "4C ERI (Simint)" : "4C ERI (Libint2)";
+    std::vector<std::pair<double, double>> geminal = {{1.0, 1.0}};
+    std::vector<std::pair<std::string, std::shared_ptr<TwoBodyAOInt>>> two_body;
+    two_body.emplace_back(eri_label, factory->eri());
+    two_body.emplace_back("4C Erf ERI", factory->erf_eri(0.4));
+    two_body.emplace_back("4C F12", factory->f12(geminal));
+    two_body.emplace_back("4C F12 Squared", factory->f12_squared(geminal));
+    two_body.emplace_back("4C F12G12", factory->f12g12(geminal));
+    two_body.emplace_back("4C F12 Double Commutator", factory->f12_double_commutator(geminal));
+
+    for (auto& type_ints : two_body) {
+        auto& ints = type_ints.second;
+        std::vector<double> rates;
+        for (const auto& cls : quartet_classes) {
+            rates.push_back(integral_throughput(
+                [&]() {
+                    size_t nints = 0L;
+                    for (const auto& q : cls.shells) {
+                        ints->compute_shell(q[0], q[1], q[2], q[3]);
+                        nints += (size_t)basis->shell(q[0]).nfunction() * basis->shell(q[1]).nfunction() *
+                                 basis->shell(q[2]).nfunction() * basis->shell(q[3]).nfunction();
+                    }
+                    return nints;
+                },
+                min_time));
+        }
+        print_class_table(type_ints.first, quartet_classes, rates, results);
+    }
+
+    // => Three-center ERIs (P|mn) <= //
+    if (aux) {
+        auto rifactory = std::make_shared<IntegralFactory>(aux, zero, basis, basis);
+        std::shared_ptr<TwoBodyAOInt> ints(rifactory->eri());
+        std::map<int, std::vector<int>> aux_by_am;
+        for (int P = 0; P < aux->nshell(); P++) aux_by_am[aux->shell(P).am()].push_back(P);
+        std::vector<AMClass> classes;
+        for (const auto& Pkv : aux_by_am) {
+            for (const auto& pair_cls : pair_classes) {
+                AMClass cls;
+                cls.label = std::string("(") + am_letters[Pkv.first] + "|" + pair_cls.label.substr(1, 1) +
+                            pair_cls.label.substr(3, 1) + ")";
+                for (size_t i = 0; i < pair_cls.shells.size(); i++) {
+                    const auto& s = pair_cls.shells[i];
+                    cls.shells.push_back({Pkv.second[i % Pkv.second.size()], 0, s[0], s[1]});
+                }
+                classes.push_back(cls);
+            }
+        }
+        std::vector<double> rates;
+        for (const auto& cls : classes) {
+            rates.push_back(integral_throughput(
+                [&]() {
+                    size_t nints = 0L;
+                    for (const auto& q : cls.shells) {
+                        ints->compute_shell(q[0], 0, q[2], q[3]);
+                        nints += (size_t)aux->shell(q[0]).nfunction() * basis->shell(q[2]).nfunction() *
+                                 basis->shell(q[3]).nfunction();
+                    }
+                    return nints;
+                },
+                min_time));
+        }
+        print_class_table("3C ERI", classes, rates, results);
+    }
+
+    // => One-electron operators <= //
+    std::vector<std::pair<std::string, std::shared_ptr<OneBodyAOInt>>> one_body;
+    one_body.emplace_back("2C Overlap", factory->ao_overlap());
+    one_body.emplace_back("2C Kinetic", factory->ao_kinetic());
+    one_body.emplace_back("2C Potential", factory->ao_potential());
+    one_body.emplace_back("2C Dipole", factory->ao_dipole());
+    one_body.emplace_back("2C Quadrupole", factory->ao_quadrupole());
+    for (auto& type_ints : one_body) {
+        auto& ints = type_ints.second;
+        std::vector<double> rates;
+        for (const auto& cls : pair_classes) {
+            rates.push_back(integral_throughput(
+                [&]() {
+                    size_t nints = 0L;
+                    for (const auto& q : cls.shells) {
+                        ints->compute_shell(q[0], q[1]);
+                        nints += (size_t)ints->nchunk() * basis->shell(q[0]).nfunction() *
+                                 basis->shell(q[1]).nfunction();
+                    }
+                    return nints;
+                },
+                min_time));
+        }
+        print_class_table(type_ints.first, pair_classes, rates, results);
+    }
+
+    // => Screening overhead <= //
+    {
+        auto& ints = two_body.front().second;
+        size_t nkept = 0L;
+        for (const auto& q : all_quartets) nkept += ints->shell_significant(q[0], q[1], q[2], q[3]);
+        double tests_per_second = integral_throughput(
+            [&]() {
+                size_t nsig = 0L;
+                for (const auto& q : all_quartets) nsig += ints->shell_significant(q[0], q[1], q[2], q[3]);
+                // Keep the tests from being optimized away
+                if (nsig != nkept) throw PSIEXCEPTION("benchmark_integral_engines: screening is not deterministic");
+                return all_quartets.size();
+            },
+            min_time);
+        outfile->Printf("  Screening (%s):\n\n", Process::environment.options.get_str("SCREENING").c_str());
+        outfile->Printf("    Time per quartet test:    %12.3E [s]\n", 1.0 / tests_per_second);
+        outfile->Printf("    Sampled quartets kept:    %12zu of %zu\n\n", nkept, all_quartets.size());
+        results["Screening tests/s"] = tests_per_second;
+        results["Screening kept fraction"] = all_quartets.empty() ? 0.0 : nkept / (double)all_quartets.size();
+    }
+
+    // => Thread scaling of the four-center ERI over all sampled quartets <= //
+    {
+        std::vector<std::shared_ptr<TwoBodyAOInt>> ints(nthread);
+        ints[0] = two_body.front().second;
+        for (int thread = 1; thread < nthread; thread++) ints[thread] = std::shared_ptr<TwoBodyAOInt>(ints[0]->clone());
+
+        std::vector<int> thread_counts;
+        for (int t = 1; t < nthread; t *= 2) thread_counts.push_back(t);
+        thread_counts.push_back(nthread);
+
+        outfile->Printf("  Thread Scaling: %s\n\n", two_body.front().first.c_str());
+        outfile->Printf("    %8s %12s %10s %10s\n", "Threads", "Ints/s", "Speedup", "Efficiency");
+        double serial_rate = 0.0;
+        for (int t : thread_counts) {
+            double rate = integral_throughput(
+                [&]() {
+                    size_t nints = 0L;
+#pragma omp parallel for schedule(dynamic) num_threads(t) reduction(+ : nints)
+                    for (size_t i = 0; i < all_quartets.size(); i++) {
+                        int rank = 0;
+#ifdef _OPENMP
+                        rank = omp_get_thread_num();
+#endif
+                        const auto& q = all_quartets[i];
+                        ints[rank]->compute_shell(q[0], q[1], q[2], q[3]);
+                        nints += (size_t)basis->shell(q[0]).nfunction() * basis->shell(q[1]).nfunction() *
+                                 basis->shell(q[2]).nfunction() * basis->shell(q[3]).nfunction();
+                    }
+                    return nints;
+                },
+                min_time);
+            if (t == 1) serial_rate = rate;
+            outfile->Printf("    %8d %12.3E %10.2f %10.2f\n", t, rate, rate / serial_rate, rate / (serial_rate * t));
+            results["Thread scaling " + std::to_string(t)] = rate;
+        }
+        outfile->Printf("\n");
+    }
+
+    return results;
+}
+
 }  // namespace psi
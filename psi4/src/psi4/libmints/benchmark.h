@@ -29,8 +29,14 @@
 #ifndef _psi_src_lib_libmints_bench_h
 #define _psi_src_lib_libmints_bench_h
 
+#include <map>
+#include <memory>
+#include <string>
+
 namespace psi {
 
+class BasisSet;
+
 /**
  * Perform a benchmark traverse of BLAS 1 routines on
  * the current hardware
@@ -64,8 +70,9 @@ void benchmark_blas3(int N, double min_time, int nthread = 1);
  * \param N maximum dimension exponent (requires 1 (2^N x 2^N)
  * double matrices
  * \param min_time minimum amount of time to run each routine [s]
+ * \return throughput in bytes per second, keyed by "<operation> <D>"
  **/
-void benchmark_disk(int N, double min_time);
+std::map<std::string, double> benchmark_disk(int N, double min_time);
 /**
  * Perform a benchmark of psi integrals (of libmints type)
  * on the current hardware
@@ -75,6 +82,21 @@ void benchmark_disk(int N, double min_time);
  * each integral type
  **/
 void benchmark_integrals(int max_am, double min_time);
+/**
+ * Benchmark the integral engines on a real basis set. Shell quartets (and pairs) are
+ * sorted into angular momentum classes and sampled; for each class the throughput of every
+ * four-center operator (ERI from the active INTEGRAL_PACKAGE, erf-attenuated ERI and the F12
+ * family), three-center ERIs and the one-electron operators is measured. The cost of the
+ * active SCREENING test and the thread scaling of the ERI are reported as well.
+ * \param basis orbital basis set to benchmark
+ * \param aux auxiliary basis set for the three-center ERIs; skipped if null
+ * \param min_time minimum time to run each class [s]
+ * \param nthread largest number of threads for the scaling test
+ * \return integrals per second, keyed by "<type> <class>", plus screening and scaling entries
+ **/
+std::map<std::string, double> benchmark_integral_engines(std::shared_ptr<BasisSet> basis,
+                                                         std::shared_ptr<BasisSet> aux, double min_time,
+                                                         int nthread = 1);
 /**
  * Perform a benchmark of common double floating
  * point operations, including most of cmath
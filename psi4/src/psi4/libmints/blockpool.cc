@@ -0,0 +1,149 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Psi4: an open-source quantum chemistry software package
+ *
+ * Copyright (c) 2007-2023 The Psi4 Developers.
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This file is part of Psi4.
+ *
+ * Psi4 is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * Psi4 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with Psi4; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * @END LICENSE
+ */
+
+#include "blockpool.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#include "psi4/libpsi4util/huge_pages.h"
+#include "psi4/libpsi4util/memory_governor.h"
+#include "psi4/libpsi4util/memory_tracker.h"
+
+namespace psi {
+
+namespace {
+// The size class of a block is kept in front of it, one alignment unit wide
+constexpr size_t header = BlockPool::alignment;
+}  // namespace
+
+BlockPool& BlockPool::shared() {
+    // Never destroyed: Matrix objects held by Python may be released after static destruction
+    static BlockPool* pool = new BlockPool();
+    return *pool;
+}
+
+size_t BlockPool::size_class(size_t bytes) {
+    size_t cls = (bytes + alignment - 1) / alignment * alignment;
+    if (cls <= 65536) return cls;
+    size_t step = 1;
+    while ((step << 4) <= cls) step <<= 1;
+    return (cls + step - 1) / step * step;
+}
+
+void* BlockPool::allocate(size_t bytes, bool zero) {
+    if (bytes == 0) bytes = 1;
+    size_t cls = size_class(bytes);
+
+    void* base = nullptr;
+    if (limit() != 0) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = free_.find(cls);
+        if (it != free_.end() && !it->second.empty()) {
+            base = it->second.back();
+            it->second.pop_back();
+            cached_ -= cls + header;
+        }
+    }
+    if (base == nullptr) {
+        base = ::operator new(cls + header, std::align_val_t(alignment));
+        huge_pages_advise(base, cls + header);
+        *static_cast<size_t*>(base) = cls;
+    }
+
+    memory_tracker_add(cls);
+
+    void* ptr = static_cast<char*>(base) + header;
+    if (zero) std::memset(ptr, 0, bytes);
+    return ptr;
+}
+
+void BlockPool::deallocate(void* ptr) {
+    if (ptr == nullptr) return;
+    void* base = static_cast<char*>(ptr) - header;
+    size_t cls = *static_cast<size_t*>(base);
+    memory_tracker_remove(cls);
+
+    // Keep the block while the cache stays within the limit
+    if (limit() != 0) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (cached_ + cls + header <= limit()) {
+            free_[cls].push_back(base);
+            cached_ += cls + header;
+            return;
+        }
+    }
+    ::operator delete(base, std::align_val_t(alignment));
+}
+
+size_t BlockPool::trim() {
+    std::map<size_t, std::vector<void*>> blocks;
+    size_t freed = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::swap(blocks, free_);
+        freed = cached_;
+        cached_ = 0;
+    }
+    for (auto& kv : blocks) {
+        for (void* base : kv.second) ::operator delete(base, std::align_val_t(alignment));
+    }
+    return freed;
+}
+
+size_t BlockPool::shrink(size_t bytes) {
+    // Called by the governor with its lock held, so it must not call back into it
+    size_t limit = limit_.load();
+    size_t lowered = std::min(bytes, limit);
+    limit_.store(limit - lowered);
+    trim();
+    return lowered;
+}
+
+size_t BlockPool::set_limit(size_t bytes) {
+    // Stop caching before the blocks are dropped, the governor is never called with mutex_ held
+    limit_.store(0);
+    trim();
+    auto& governor = MemoryGovernor::instance();
+    if (bytes == 0) {
+        governor.release(this);
+        return 0;
+    }
+    size_t granted =
+        governor.reserve(this, "Matrix/Vector block pool", bytes, [this](size_t wanted) { return shrink(wanted); });
+    limit_.store(granted);
+    return granted;
+}
+
+size_t BlockPool::cached_bytes() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return cached_;
+}
+
+}  // namespace psi
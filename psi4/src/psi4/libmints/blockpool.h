@@ -0,0 +1,121 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Psi4: an open-source quantum chemistry software package
+ *
+ * Copyright (c) 2007-2023 The Psi4 Developers.
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This file is part of Psi4.
+ *
+ * Psi4 is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * Psi4 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with Psi4; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * @END LICENSE
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <new>
+#include <vector>
+
+#include "psi4/pragma.h"
+
+namespace psi {
+
+/*! \ingroup MINTS
+ *  \class BlockPool
+ *  \brief Cache-line aligned, size-class pooled storage for Matrix and Vector data.
+ *
+ * Pooling is off by default: blocks go straight back to the system when freed.
+ * With a limit set, freed blocks are kept on per size-class free lists, up to
+ * the limit, and handed out again to the next request of the same class, so
+ * repeated same-sized temporaries (doublet, triplet, clone, ...) neither go back
+ * to malloc nor page-fault fresh memory. The limit is reserved with the
+ * MemoryGovernor when it is set, as a shrinkable reservation; modules that size
+ * themselves from the job memory alone do not see it, so it should be counted
+ * out of the memory given to the job.
+ */
+class PSI_API BlockPool {
+   public:
+    /// Alignment of every block [bytes]: a cache line, and the widest SIMD register
+    static constexpr size_t alignment = 64;
+
+    static BlockPool& shared();
+
+    /// Return at least bytes of aligned storage, zeroed if zero is set
+    void* allocate(size_t bytes, bool zero = true);
+    /// Return storage obtained from allocate() to the pool
+    void deallocate(void* ptr);
+    /// Free all cached blocks, returns the bytes released. The limit is kept.
+    size_t trim();
+
+    /// Cache up to bytes of freed blocks, 0 (the default) disables pooling.
+    /// Returns the limit granted by the MemoryGovernor.
+    size_t set_limit(size_t bytes);
+    size_t limit() const { return limit_.load(std::memory_order_relaxed); }
+
+    size_t cached_bytes() const;
+
+   private:
+    BlockPool() = default;
+    BlockPool(const BlockPool&) = delete;
+    BlockPool& operator=(const BlockPool&) = delete;
+
+    /// Blocks are rounded up to size classes at most 1/8 apart
+    static size_t size_class(size_t bytes);
+
+    /// Shrinker registered with the MemoryGovernor, lowers the limit
+    size_t shrink(size_t bytes);
+
+    mutable std::mutex mutex_;
+    std::map<size_t, std::vector<void*>> free_;
+    size_t cached_ = 0;
+    std::atomic<size_t> limit_{0};
+};
+
+/*! \ingroup MINTS
+ *  \brief std::allocator replacement that draws from the BlockPool
+ */
+template <typename T>
+struct BlockAllocator {
+    using value_type = T;
+
+    BlockAllocator() noexcept = default;
+    template <typename U>
+    BlockAllocator(const BlockAllocator<U>&) noexcept {}
+
+    T* allocate(size_t n) {
+        if (n > std::numeric_limits<size_t>::max() / sizeof(T)) throw std::bad_alloc();
+        return static_cast<T*>(BlockPool::shared().allocate(n * sizeof(T), false));
+    }
+    void deallocate(T* ptr, size_t) noexcept { BlockPool::shared().deallocate(ptr); }
+};
+
+template <typename T, typename U>
+bool operator==(const BlockAllocator<T>&, const BlockAllocator<U>&) noexcept {
+    return true;
+}
+template <typename T, typename U>
+bool operator!=(const BlockAllocator<T>&, const BlockAllocator<U>&) noexcept {
+    return false;
+}
+
+}  // namespace psi
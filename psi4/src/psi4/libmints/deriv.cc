@@ -52,20 +52,34 @@
 #include <memory>
 #include <array>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 namespace psi {
 
 size_t counter;
 
 class PSI_API CorrelatedFunctor {
-    /// The buffer to hold the TPDM
-    double *tpdm_buffer_;
-    /// Pointer to the current TPDM element
-    double *tpdm_ptr_;
+    /// Supplies the TPDM of each shell pair; if empty, the TPDM is read from PSIF_AO_TPDM
+    Deriv::TPDMPairProvider provider_;
+    /// The buffers holding the TPDM of the current shell pair, one per thread
+    std::vector<std::vector<double>> tpdm_buffer_;
+    /// Pointer to the current TPDM element, one per thread
+    std::vector<const double *> tpdm_ptr_;
     /// How large the buffer is, for each shell pair
-    size_t *buffer_sizes_;
+    std::vector<size_t> buffer_sizes_;
     /// The PSIO object to use for disk I/O
     std::shared_ptr<PSIO> psio_;
 
+    static int thread_id() {
+#ifdef _OPENMP
+        return omp_get_thread_num();
+#else
+        return 0;
+#endif
+    }
+
    public:
     int nthread;
     std::vector<SharedVector> result;
@@ -73,18 +87,20 @@ class PSI_API CorrelatedFunctor {
     CorrelatedFunctor() {
         throw PSIEXCEPTION("CorrelatedRestrictedFunctor(): Default constructor called. This shouldn't happen.");
     }
-    CorrelatedFunctor(SharedVector results) : psio_(_default_psio_lib_) {
+    CorrelatedFunctor(SharedVector results, Deriv::TPDMPairProvider provider = nullptr)
+        : provider_(std::move(provider)), psio_(_default_psio_lib_) {
         nthread = Process::environment.get_n_threads();
         result.push_back(results);
         for (int i = 1; i < nthread; ++i) result.push_back(std::make_shared<Vector>(std::move(result[0]->clone())));
-        size_t num_pairs = 0;
-        psio_->read_entry(PSIF_AO_TPDM, "Num. Pairs", (char *)&num_pairs, sizeof(size_t));
-        buffer_sizes_ = new size_t[num_pairs];
-        psio_->read_entry(PSIF_AO_TPDM, "TPDM Buffer Sizes", (char *)buffer_sizes_, num_pairs * sizeof(size_t));
-        size_t max_size = 0;
-        for (size_t i = 0; i < num_pairs; ++i) max_size = max_size > buffer_sizes_[i] ? max_size : buffer_sizes_[i];
-        tpdm_buffer_ = new double[max_size];
-        tpdm_ptr_ = tpdm_buffer_;
+        tpdm_buffer_.resize(nthread);
+        tpdm_ptr_.assign(nthread, nullptr);
+        if (!provider_) {
+            size_t num_pairs = 0;
+            psio_->read_entry(PSIF_AO_TPDM, "Num. Pairs", (char *)&num_pairs, sizeof(size_t));
+            buffer_sizes_.resize(num_pairs);
+            psio_->read_entry(PSIF_AO_TPDM, "TPDM Buffer Sizes", (char *)buffer_sizes_.data(),
+                              num_pairs * sizeof(size_t));
+        }
     }
 
     void finalize() {
@@ -92,33 +108,37 @@ class PSI_API CorrelatedFunctor {
         for (int i = 1; i < nthread; ++i) {
             result[0]->add(*result[i]);
         }
-        delete[] tpdm_buffer_;
-        delete[] buffer_sizes_;
+        tpdm_buffer_.clear();
     }
 
-    void load_tpdm(size_t id) {
-        // TODO, make this work with threads (each thread needs its own buffer)
-        auto *toc = new char[40];
-        sprintf(toc, "SO_TPDM_FOR_PAIR_%zd", id);
-        size_t buffer_size = buffer_sizes_[id];
-        psio_->read_entry(PSIF_AO_TPDM, toc, (char *)tpdm_buffer_, buffer_size * sizeof(double));
-        delete[] toc;
-        tpdm_ptr_ = tpdm_buffer_;
+    void load_tpdm(int p, int q, size_t id) {
+        int thread = thread_id();
+        std::vector<double> &buffer = tpdm_buffer_[thread];
+        if (provider_) {
+            provider_(p, q, id, buffer);
+        } else {
+            auto *toc = new char[40];
+            sprintf(toc, "SO_TPDM_FOR_PAIR_%zd", id);
+            buffer.resize(buffer_sizes_[id]);
+            // PSIO is not thread safe
+#pragma omp critical(CorrelatedFunctor_load_tpdm)
+            psio_->read_entry(PSIF_AO_TPDM, toc, (char *)buffer.data(), buffer.size() * sizeof(double));
+            delete[] toc;
+        }
+        tpdm_ptr_[thread] = buffer.data();
     }
 
-    void next_tpdm_element() { ++tpdm_ptr_; }
+    void next_tpdm_element() { ++tpdm_ptr_[thread_id()]; }
 
     void operator()(int salc, int pabs, int qabs, int rabs, int sabs, int /*pirrep*/, int /*pso*/, int /*qirrep*/,
                     int /*qso*/, int /*rirrep*/, int /*rso*/, int /*sirrep*/, int /*sso*/, double value) {
-        int thread = 0;
-        // This was the old line, but it always returned 0 anyways...
-        // WorldComm->thread_id(pthread_self());
+        int thread = thread_id();
 
         double prefactor = 8.0;
         if (pabs == qabs) prefactor *= 0.5;
         if (rabs == sabs) prefactor *= 0.5;
         if (pabs == rabs && qabs == sabs) prefactor *= 0.5;
-        result[thread]->add(salc, prefactor * (*tpdm_ptr_) * value);
+        result[thread]->add(salc, prefactor * (*tpdm_ptr_[thread]) * value);
     }
 };
 
@@ -348,11 +368,15 @@ SharedMatrix Deriv::compute(DerivCalcType deriv_calc_type) {
         // terms below are computed correctly.  The two-particle terms are computed the same in both cases
         // as all spin cases have been collapsed into the a single SO TPDM.
 
+        // Where the SO TPDM is streamed from; PSIF_AO_TPDM is read if there is no provider
+        TPDMPairProvider provider = tpdm_provider_;
+        std::shared_ptr<IntegralTransform> ints_transform;
+
         if (!deriv_density_backtransformed_) {
             // Dial up an integral transformation object to backtransform the OPDM, TPDM and Lagrangian
             std::vector<std::shared_ptr<MOSpace> > spaces;
             spaces.push_back(MOSpace::all);
-            std::shared_ptr<IntegralTransform> ints_transform =
+            ints_transform =
                 std::shared_ptr<IntegralTransform>(new IntegralTransform(
                     wfn_, spaces,
                     wfn_->same_a_b_orbs() ? IntegralTransform::TransformationType::Restricted
@@ -365,8 +389,17 @@ SharedMatrix Deriv::compute(DerivCalcType deriv_calc_type) {
             // Some codes already presort the tpdm, do not follow this as an example
             if (tpdm_presorted_) ints_transform->set_tpdm_already_presorted(true);
 
+            // If the SO TPDM fits in core, hand it straight to the derivative integrals
+            if (!provider) ints_transform->set_keep_so_tpdm_incore(true);
+
             ints_transform->backtransform_density(reset_oneel);
 
+            if (ints_transform->so_tpdm_incore()) {
+                provider = [ints_transform](int, int, size_t pair, std::vector<double> &buffer) {
+                    ints_transform->so_tpdm_pair(pair, buffer);
+                };
+            }
+
             if (reset_oneel) {
                 Da = factory_->create_shared_matrix("SO-basis OPDM");
                 Db = factory_->create_shared_matrix("nullptr");
@@ -378,11 +411,12 @@ SharedMatrix Deriv::compute(DerivCalcType deriv_calc_type) {
                 }
         }
 
-        _default_psio_lib_->open(PSIF_AO_TPDM, PSIO_OPEN_OLD);
-        CorrelatedFunctor functor(TPDMcont_vector);
+        if (!provider) _default_psio_lib_->open(PSIF_AO_TPDM, PSIO_OPEN_OLD);
+        CorrelatedFunctor functor(TPDMcont_vector, provider);
         so_eri.compute_integrals_deriv1(functor);
         functor.finalize();
-        _default_psio_lib_->close(PSIF_AO_TPDM, 1);
+        if (!provider) _default_psio_lib_->close(PSIF_AO_TPDM, 1);
+        if (ints_transform) ints_transform->free_so_tpdm();
 
         for (size_t cd = 0; cd < cdsalcs_.ncd(); ++cd) TPDMcont[cd] = TPDMcont_vector->get(cd);
     }
@@ -36,6 +36,7 @@
 #ifndef _psi_src_lib_libmints_deriv_h_
 #define _psi_src_lib_libmints_deriv_h_
 
+#include <functional>
 #include <vector>
 #include "matrix.h"
 #include "psi4/libmints/cdsalclist.h"
@@ -56,6 +57,16 @@ enum class DerivCalcType { Default,
     Correlated };
 
 class PSI_API Deriv {
+   public:
+    /*!
+     * Supplies the SO basis TPDM of one (PQ| shell pair to the correlated gradient.
+     * The arguments are the shells P and Q, the position of the pair in SO_PQ_Iterator order, and the
+     * buffer to fill. The elements are laid out as IntegralTransform writes the SO_TPDM_FOR_PAIR_ entries
+     * of PSIF_AO_TPDM. It is called concurrently from several threads.
+     */
+    using TPDMPairProvider = std::function<void(int, int, size_t, std::vector<double>&)>;
+
+   private:
     const std::shared_ptr<Wavefunction> wfn_;
     std::shared_ptr<IntegralFactory> integral_;
     std::shared_ptr<BasisSet> basis_;
@@ -69,6 +80,7 @@ class PSI_API Deriv {
     bool tpdm_presorted_;
     bool deriv_density_backtransformed_;
     bool ignore_reference_;
+    TPDMPairProvider tpdm_provider_;
 
     // Results go here.
     /// Reference overlap contribution to the gradient
@@ -101,6 +113,9 @@ class PSI_API Deriv {
     // Is the deriv_density already backtransformed? Default: False
     void set_deriv_density_backtransformed(bool val) { deriv_density_backtransformed_ = val; }
 
+    // Stream the SO TPDM from a callback rather than PSIF_AO_TPDM. Default: read from disk
+    void set_tpdm_provider(TPDMPairProvider provider) { tpdm_provider_ = std::move(provider); }
+
     SharedMatrix compute(DerivCalcType deriv_calc_type = DerivCalcType::Default);
 
     /*!
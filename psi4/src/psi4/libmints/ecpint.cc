@@ -47,14 +47,30 @@
 #include <algorithm>
 #include <functional>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
 #include <vector>
 
 namespace psi {
 
+namespace {
+// The angular integral tables and radial quadrature grids built by the LibECP engine depend only on the angular
+// momentum limits and derivative level, so they are built once per process and copied into every ECPInt.  This
+// matters because MintsHelper makes one ECPInt per thread, and geometry optimizations rebuild them every step.
+const libecpint::ECPIntegral &cached_ecp_engine(int max_am, int max_ecp_am, int deriv) {
+    static std::mutex engine_mutex;
+    static std::map<std::tuple<int, int, int>, std::unique_ptr<libecpint::ECPIntegral>> engines;
+    std::lock_guard<std::mutex> lock(engine_mutex);
+    auto &engine = engines[std::make_tuple(max_am, max_ecp_am, deriv)];
+    if (!engine) engine = std::make_unique<libecpint::ECPIntegral>(max_am, max_ecp_am, deriv);
+    return *engine;
+}
+}  // namespace
 
 ECPInt::ECPInt(std::vector<SphericalTransform> &st, std::shared_ptr<BasisSet> bs1, std::shared_ptr<BasisSet> bs2,
                int deriv)
-    : OneBodyAOInt(st, bs1, bs2, deriv), engine_(bs1->max_am(), bs1->max_ecp_am(), deriv) {
+    : OneBodyAOInt(st, bs1, bs2, deriv), engine_(cached_ecp_engine(bs1->max_am(), bs1->max_ecp_am(), deriv)) {
     int maxam1 = bs1->max_am();
     int maxam2 = bs2->max_am();
 
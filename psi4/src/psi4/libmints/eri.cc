@@ -32,6 +32,9 @@
 #include "psi4/libmints/fjt.h"
 #include "psi4/libqt/qt.h"
 
+#include <iomanip>
+#include <sstream>
+
 #include <libint2/shell.h>
 #include <libint2/engine.h>
 using namespace psi;
@@ -207,6 +210,7 @@ Libint2ERI::Libint2ERI(const IntegralFactory *integral, double screening_thresho
     schwarz_engine_ =
         libint2::Engine(libint2::Operator::coulomb, max_nprim, max_am, 0, max_precision,
                         libint2::operator_traits<libint2::Operator::coulomb>::default_params(), libint2::BraKet::xx_xx);
+    sieve_key_ = "coulomb";
     common_init();
     timer_off("Libint2ERI::Libint2ERI");
 }
@@ -309,6 +313,9 @@ Libint2ErfERI::Libint2ErfERI(double omega, const IntegralFactory *integral, doub
     max_am = bra_same_ ? basis1()->max_am() : ket_same_ ? basis3()->max_am() : 0;
     schwarz_engine_ = libint2::Engine(libint2::Operator::erf_coulomb, max_nprim, max_am, 0, max_precision, omega,
                                       libint2::BraKet::xx_xx);
+    std::stringstream key;
+    key << "erf_coulomb " << std::setprecision(17) << omega;
+    sieve_key_ = key.str();
     common_init();
     timer_off("Libint2ErfERI::Libint2ErfERI");
 }
@@ -423,6 +430,9 @@ Libint2ErfComplementERI::Libint2ErfComplementERI(double omega, const IntegralFac
     max_am = bra_same_ ? basis1()->max_am() : ket_same_ ? basis3()->max_am() : 0;
     schwarz_engine_ = libint2::Engine(libint2::Operator::erfc_coulomb, max_nprim, max_am, 0, max_precision, omega,
                                       libint2::BraKet::xx_xx);
+    std::stringstream key;
+    key << "erfc_coulomb " << std::setprecision(17) << omega;
+    sieve_key_ = key.str();
     common_init();
     timer_off("Libint2ErfComplementERI::Libint2ErfComplementERI");
 }
@@ -249,6 +249,11 @@ class Libint2TwoElectronInt : public TwoBodyAOInt {
     std::vector<double> zero_vec_;
     bool use_shell_pairs_;
 
+    /// Index of shell pair (s1, s2) in pairs12_ (s1 * nshell2 + s2), or -1 if it was not kept
+    std::vector<int> pair_index12_;
+    /// Index of shell pair (s3, s4) in pairs34_ (s3 * nshell4 + s4), or -1 if it was not kept
+    std::vector<int> pair_index34_;
+
     //! Setup metadata and screening info
     void common_init();
 
@@ -288,6 +293,9 @@ class Libint2TwoElectronInt : public TwoBodyAOInt {
                                   const libint2::ShellPair *sp34 = nullptr) = 0;
 
     void compute_shell_blocks(int shellpair12, int shellpair34, int npair12 = -1, int npair34 = -1) override;
+
+    /// Compute ERIs for a batch of quartets, reusing the precomputed shell pair data
+    size_t compute_shell_batch(const std::vector<std::array<int, 4>> &quartets, double *target) override;
 };
 
 class Libint2ERI : public Libint2TwoElectronInt {
@@ -3091,6 +3091,8 @@ Libint2TwoElectronInt::Libint2TwoElectronInt(const Libint2TwoElectronInt &rhs)
 {
     pairs12_ = rhs.pairs12_;
     pairs34_ = rhs.pairs34_;
+    pair_index12_ = rhs.pair_index12_;
+    pair_index34_ = rhs.pair_index34_;
     zero_vec_ = rhs.zero_vec_;
     for (const auto &e : rhs.engines_) engines_.emplace_back(e);
 }
@@ -3140,23 +3142,19 @@ void Libint2TwoElectronInt::common_init() {
     create_blocks();
     const auto max_engine_precision = std::numeric_limits<double>::epsilon() * screening_threshold_;
 
-    size_t npairs = shell_pairs_bra_.size();
-    pairs12_.resize(npairs);
-//#pragma omp parallel for
-    for (int pair = 0; pair < npairs; ++pair) {
-        auto s1 = shell_pairs_bra_[pair].first;
-        auto s2 = shell_pairs_bra_[pair].second;
-        pairs12_[pair] = std::make_shared<libint2::ShellPair>(basis1()->l2_shell(s1), basis2()->l2_shell(s2),
-                                                              std::log(max_engine_precision));
+    // The pair data is shared with every other integral object on the same basis set pair
+    pairs12_ = basis1()->shell_pair_cache()->get(*basis1(), basis2(), shell_pairs_bra_, std::log(max_engine_precision));
+    pairs34_ = basis3()->shell_pair_cache()->get(*basis3(), basis4(), shell_pairs_ket_, std::log(max_engine_precision));
+
+    size_t nshell2 = basis2()->nshell();
+    size_t nshell4 = basis4()->nshell();
+    pair_index12_.assign(basis1()->nshell() * nshell2, -1);
+    for (int pair = 0; pair < shell_pairs_bra_.size(); ++pair) {
+        pair_index12_[shell_pairs_bra_[pair].first * nshell2 + shell_pairs_bra_[pair].second] = pair;
     }
-    npairs = shell_pairs_ket_.size();
-    pairs34_.resize(npairs);
-//#pragma omp parallel for
-    for (int pair = 0; pair < npairs; ++pair) {
-        auto s3 = shell_pairs_ket_[pair].first;
-        auto s4 = shell_pairs_ket_[pair].second;
-        pairs34_[pair] = std::make_shared<libint2::ShellPair>(basis3()->l2_shell(s3), basis4()->l2_shell(s4),
-                                                              std::log(max_engine_precision));
+    pair_index34_.assign(basis3()->nshell() * nshell4, -1);
+    for (int pair = 0; pair < shell_pairs_ket_.size(); ++pair) {
+        pair_index34_[shell_pairs_ket_[pair].first * nshell4 + shell_pairs_ket_[pair].second] = pair;
     }
 }
 
@@ -3319,3 +3317,45 @@ void Libint2TwoElectronInt::compute_shell_blocks(int shellpair12, int shellpair3
     timer_off("Libint2ERI::compute_shell_blocks");
 #endif
 }
+
+size_t Libint2TwoElectronInt::compute_shell_batch(const std::vector<std::array<int, 4>> &quartets, double *target) {
+#ifdef MINTS_TIMER
+    timer_on("Libint2ERI::compute_shell_batch");
+#endif
+    size_t nshell2 = bs2_->nshell();
+    size_t nshell4 = bs4_->nshell();
+
+    size_t ncomputed = 0;
+    for (const auto &quartet : quartets) {
+        const auto &sh1 = bs1_->l2_shell(quartet[0]);
+        const auto &sh2 = bs2_->l2_shell(quartet[1]);
+        const auto &sh3 = bs3_->l2_shell(quartet[2]);
+        const auto &sh4 = bs4_->l2_shell(quartet[3]);
+
+        // The primitive pair data only exists for pairs that survived the sieve, in the
+        // order they were stored; anything else is handled by the engine on the fly
+        int pair12 = pair_index12_[quartet[0] * nshell2 + quartet[1]];
+        int pair34 = pair_index34_[quartet[2] * nshell4 + quartet[3]];
+        const auto *sp12 = pair12 < 0 ? nullptr : pairs12_[pair12].get();
+        const auto *sp34 = pair34 < 0 ? nullptr : pairs34_[pair34].get();
+        libint2_wrapper0(sh1, sh2, sh3, sh4, sp12, sp34);
+
+        size_t n1234 = sh1.size() * sh2.size() * sh3.size() * sh4.size();
+        const double *result = engines_[0].results()[0];
+        if (result) {
+            std::copy(result, result + n1234, target);
+            ncomputed++;
+        } else {
+            std::fill(target, target + n1234, 0.0);
+        }
+        target += n1234;
+    }
+
+    // Leave the single-quartet buffer in a valid state for the caller
+    buffers_[0] = target_full_ = zero_vec_.data();
+
+#ifdef MINTS_TIMER
+    timer_off("Libint2ERI::compute_shell_batch");
+#endif
+    return ncomputed;
+}
@@ -32,19 +32,26 @@
 #include "psi4/libmints/matrix.h"
 #include "psi4/libmints/integral.h"
 #include "psi4/libmints/potential.h"
+#include "psi4/libmints/mcmurchiedavidson.h"
+#include "psi4/libmints/vector3.h"
 #include "psi4/libciomr/libciomr.h"
 #include "psi4/libqt/qt.h"
 #include "psi4/physconst.h"
 #include "psi4/libpsi4util/PsiOutStream.h"
 #include "psi4/libpsi4util/process.h"
 
+#include <cmath>
+#include <limits>
+#include <map>
+
 #ifdef _OPENMP
 #include <omp.h>
 #endif
 
 namespace psi {
 
-ExternalPotential::ExternalPotential() : debug_(0), print_(1) {}
+ExternalPotential::ExternalPotential()
+    : debug_(0), print_(1), far_field_order_(-1), far_field_box_length_(10.0), far_field_separation_(4.0) {}
 
 ExternalPotential::~ExternalPotential() {}
 
@@ -57,6 +64,90 @@ void ExternalPotential::addCharge(double Z, double x, double y, double z) {
     charges_.push_back(std::make_tuple(Z, x, y, z));
 }
 
+void ExternalPotential::set_far_field(int order, double box_length, double separation) {
+    if (order < 0) throw PSIEXCEPTION("ExternalPotential: the far field multipole order must be non-negative.");
+    if (box_length <= 0.0) throw PSIEXCEPTION("ExternalPotential: the far field box length must be positive.");
+    if (separation <= 1.0) throw PSIEXCEPTION("ExternalPotential: the far field separation must be larger than 1.");
+    far_field_order_ = order;
+    far_field_box_length_ = box_length;
+    far_field_separation_ = separation;
+}
+
+void ExternalPotential::partition_charges(std::shared_ptr<Molecule> mol,
+                                          std::vector<std::pair<double, std::array<double, 3>>>& near,
+                                          std::vector<std::array<double, 3>>& far_centers,
+                                          std::vector<std::vector<double>>& far_moments) const {
+    near.clear();
+    far_centers.clear();
+    far_moments.clear();
+
+    auto position = [&](size_t i) {
+        return std::array<double, 3>{{std::get<1>(charges_[i]), std::get<2>(charges_[i]), std::get<3>(charges_[i])}};
+    };
+
+    if (far_field_order_ < 0) {
+        for (size_t i = 0; i < charges_.size(); ++i) near.push_back({std::get<0>(charges_[i]), position(i)});
+        return;
+    }
+
+    // Bin the charges into cubic cells anchored at the lower corner of their bounding box
+    std::array<double, 3> lower;
+    lower.fill(std::numeric_limits<double>::max());
+    for (size_t i = 0; i < charges_.size(); ++i) {
+        auto R = position(i);
+        for (int k = 0; k < 3; ++k) lower[k] = std::min(lower[k], R[k]);
+    }
+    std::map<std::array<long, 3>, std::vector<size_t>> cells;
+    for (size_t i = 0; i < charges_.size(); ++i) {
+        auto R = position(i);
+        std::array<long, 3> key;
+        for (int k = 0; k < 3; ++k) key[k] = static_cast<long>(std::floor((R[k] - lower[k]) / far_field_box_length_));
+        cells[key].push_back(i);
+    }
+
+    std::vector<std::array<int, 3>> comps;
+    for (int l = 0; l <= far_field_order_; ++l) {
+        auto comps_l = mdintegrals::generate_am_components_cca(l);
+        comps.insert(comps.end(), comps_l.begin(), comps_l.end());
+    }
+    std::vector<double> inv_fact(far_field_order_ + 1, 1.0);
+    for (int l = 1; l <= far_field_order_; ++l) inv_fact[l] = inv_fact[l - 1] / l;
+
+    for (const auto& cell : cells) {
+        std::array<double, 3> C;
+        for (int k = 0; k < 3; ++k) C[k] = lower[k] + (cell.first[k] + 0.5) * far_field_box_length_;
+
+        // The expansion is only used if every atom sits well outside the cell
+        double radius = 0.5 * far_field_box_length_;
+        for (size_t i : cell.second) {
+            auto R = position(i);
+            radius = std::max(radius, std::sqrt((R[0] - C[0]) * (R[0] - C[0]) + (R[1] - C[1]) * (R[1] - C[1]) +
+                                                (R[2] - C[2]) * (R[2] - C[2])));
+        }
+        double closest = std::numeric_limits<double>::max();
+        for (int A = 0; A < mol->natom(); ++A) {
+            closest = std::min(closest, mol->xyz(A).distance(Vector3(C[0], C[1], C[2])));
+        }
+        if (closest < far_field_separation_ * radius) {
+            for (size_t i : cell.second) near.push_back({std::get<0>(charges_[i]), position(i)});
+            continue;
+        }
+
+        std::vector<double> moments(comps.size(), 0.0);
+        for (size_t i : cell.second) {
+            double Z = std::get<0>(charges_[i]);
+            auto R = position(i);
+            for (size_t a = 0; a < comps.size(); ++a) {
+                const auto& c = comps[a];
+                moments[a] += Z * std::pow(R[0] - C[0], c[0]) * std::pow(R[1] - C[1], c[1]) *
+                              std::pow(R[2] - C[2], c[2]) * inv_fact[c[0]] * inv_fact[c[1]] * inv_fact[c[2]];
+            }
+        }
+        far_centers.push_back(C);
+        far_moments.push_back(moments);
+    }
+}
+
 void ExternalPotential::addBasis(std::shared_ptr<BasisSet> basis, SharedVector coefs) {
     bases_.push_back(std::make_pair(basis, coefs));
 }
@@ -65,6 +156,12 @@ void ExternalPotential::print(const std::string& out) const {
     std::shared_ptr<psi::PsiOutStream> printer = (out == "outfile" ? outfile : std::make_shared<PsiOutStream>(out));
     printer->Printf("   => External Potential Field: %s <= \n\n", name_.c_str());
 
+    if (far_field_order_ >= 0) {
+        printer->Printf("    Far field multipole order:  %d\n", far_field_order_);
+        printer->Printf("    Far field box length [a0]:  %.2f\n", far_field_box_length_);
+        printer->Printf("    Far field separation:       %.2f\n\n", far_field_separation_);
+    }
+
     // Charges
     if (charges_.size()) {
         printer->Printf("    > Charges [e] [a0] < \n\n");
@@ -103,21 +200,28 @@ SharedMatrix ExternalPotential::computePotentialMatrix(std::shared_ptr<BasisSet>
     nthreads = Process::environment.get_n_threads();
 #endif
 
-    // Monopoles
+    // Monopoles; with a far field, distant cells of charges are replaced by their multipoles
     std::vector<std::pair<double, std::array<double, 3>>> Zxyz;
-    for (size_t i=0; i< charges_.size(); ++i) {
-        Zxyz.push_back({std::get<0>(charges_[i]),{{std::get<1>(charges_[i]),
-                                                   std::get<2>(charges_[i]),
-                                                   std::get<3>(charges_[i])}}});
+    std::vector<std::array<double, 3>> far_centers;
+    std::vector<std::vector<double>> far_moments;
+    partition_charges(basis->molecule(), Zxyz, far_centers, far_moments);
+
+    if (print_ > 1 && far_field_order_ >= 0) {
+        outfile->Printf("    External potential: %zu of %zu charges in %zu far field cells (order %d)\n\n",
+                        charges_.size() - Zxyz.size(), charges_.size(), far_centers.size(), far_field_order_);
     }
 
     std::vector<SharedMatrix> V_charge;
     std::vector<std::shared_ptr<PotentialInt> > pot;
+    std::vector<std::shared_ptr<OneBodyAOInt> > mpole;
     for (size_t t = 0; t < nthreads; ++t) {
         V_charge.push_back(std::make_shared<Matrix>("External Potential (Charges)", n, n));
         V_charge[t]->zero();
         pot.push_back(std::shared_ptr<PotentialInt>(static_cast<PotentialInt *>(fact->ao_potential().release())));
         pot[t]->set_charge_field(Zxyz);
+        if (!far_centers.empty()) {
+            mpole.push_back(std::shared_ptr<OneBodyAOInt>(fact->ao_multipole_potential(far_field_order_)));
+        }
     }
 
     // Monopole potential is symmetric, so generate unique pairs of shells
@@ -139,13 +243,30 @@ SharedMatrix ExternalPotential::computePotentialMatrix(std::shared_ptr<BasisSet>
 #endif
 
         double **Vp = V_charge[rank]->pointer();
-        pot[rank]->compute_shell(i, j);
-        const auto* buffer = pot[rank]->buffers()[0];
+        std::vector<double> block(ni * nj, 0.0);
+        if (!Zxyz.empty()) {
+            pot[rank]->compute_shell(i, j);
+            const auto* buffer = pot[rank]->buffers()[0];
+            for (size_t index = 0; index < ni * nj; ++index) block[index] = buffer[index];
+        }
+
+        // Far field: -sum_a W_a <i| d^a/dC^a 1/|r - C| |j> for each cell center C
+        for (size_t c = 0; c < far_centers.size(); ++c) {
+            const auto& C = far_centers[c];
+            const auto& W = far_moments[c];
+            mpole[rank]->set_origin(Vector3(C[0], C[1], C[2]));
+            mpole[rank]->compute_shell(i, j);
+            const auto& mbuffers = mpole[rank]->buffers();
+            for (size_t a = 0; a < W.size(); ++a) {
+                const double* mbuffer = mbuffers[a];
+                for (size_t index = 0; index < ni * nj; ++index) block[index] -= W[a] * mbuffer[index];
+            }
+        }
 
         size_t index = 0;
         for (size_t ii = index_i; ii < (index_i + ni); ++ii) {
             for (size_t jj = index_j; jj < (index_j + nj); ++jj) {
-                Vp[ii][jj] = Vp[jj][ii] = buffer[index++];
+                Vp[ii][jj] = Vp[jj][ii] = block[index++];
             }
         }
     } // p
@@ -155,6 +276,7 @@ SharedMatrix ExternalPotential::computePotentialMatrix(std::shared_ptr<BasisSet>
         V_charge[t].reset();
         pot[t].reset();
     }
+    mpole.clear();
 
     // Diffuse Bases
     for (size_t ind = 0; ind < bases_.size(); ind++) {
@@ -29,6 +29,7 @@
 #ifndef _psi_src_lib_libmints_extern_potential_h_
 #define _psi_src_lib_libmints_extern_potential_h_
 
+#include <array>
 #include <vector>
 #include <utility>
 #include <string>
@@ -62,6 +63,19 @@ class PSI_API ExternalPotential {
     /// Auxiliary basis sets (with accompanying molecules and coefs) of diffuse charges
     std::vector<std::pair<std::shared_ptr<BasisSet>, SharedVector> > bases_;
 
+    /// Highest multipole order of the charge far field, or -1 to treat all charges exactly
+    int far_field_order_;
+    /// Edge of the cubic cells the charges are grouped into [a0]
+    double far_field_box_length_;
+    /// A cell is far if all atoms are at least this many cell radii from its center
+    double far_field_separation_;
+
+    /// Splits the charges into those treated exactly and the far cells (center and scaled Cartesian
+    /// moments sum_q Z_q d^a / a!, CCA order through far_field_order_) as seen from the atoms of mol
+    void partition_charges(std::shared_ptr<Molecule> mol, std::vector<std::pair<double, std::array<double, 3>>>& near,
+                           std::vector<std::array<double, 3>>& far_centers,
+                           std::vector<std::vector<double>>& far_moments) const;
+
    public:
     /// Constructur, does nothing
     ExternalPotential();
@@ -91,6 +105,12 @@ class PSI_API ExternalPotential {
     /// Reset the field to zero (eliminates all entries)
     void clear();
 
+    /// Group the charges into cubic cells of edge box_length [a0] and replace cells that are at least
+    /// separation cell radii away from every atom by their multipole expansion through the given order
+    void set_far_field(int order, double box_length, double separation);
+    /// Treat every charge exactly (the default)
+    void unset_far_field() { far_field_order_ = -1; }
+
     /// Compute the external potential matrix in the given basis set
     SharedMatrix computePotentialMatrix(std::shared_ptr<BasisSet> basis);
     /// Compute the gradients due to the external potential
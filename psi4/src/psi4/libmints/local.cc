@@ -29,6 +29,8 @@
 #include "local.h"
 
 #include <algorithm>
+#include <utility>
+#include <vector>
 
 #include "psi4/libqt/qt.h"
 #include "psi4/libmints/matrix.h"
@@ -44,6 +46,31 @@ using namespace psi;
 
 namespace psi {
 
+namespace {
+
+/// Round-robin (circle method) schedule over n indices: every pair appears exactly once, and the
+/// pairs within a round are disjoint, so their Jacobi rotations commute and can run concurrently
+std::vector<std::vector<std::pair<int, int> > > tournament_rounds(int n) {
+    int nplayer = n + (n % 2);
+    std::vector<int> ring(nplayer);
+    for (int k = 0; k < nplayer; k++) ring[k] = k;
+
+    std::vector<std::vector<std::pair<int, int> > > rounds(nplayer - 1);
+    for (int r = 0; r < nplayer - 1; r++) {
+        for (int k = 0; k < nplayer / 2; k++) {
+            int i = ring[k];
+            int j = ring[nplayer - 1 - k];
+            // The padding index n is a bye
+            if (i < n && j < n) rounds[r].push_back(std::make_pair(std::min(i, j), std::max(i, j)));
+        }
+        // Hold ring[0] fixed and rotate the rest
+        std::rotate(ring.begin() + 1, ring.end() - 1, ring.end());
+    }
+    return rounds;
+}
+
+}  // namespace
+
 Localizer::Localizer(std::shared_ptr<BasisSet> primary, std::shared_ptr<Matrix> C) : primary_(primary), C_(C) {
     if (C->nirrep() != 1) {
         throw PSIEXCEPTION("Localizer: C matrix is not C1");
@@ -61,6 +88,7 @@ void Localizer::common_init() {
     convergence_ = 1.0E-8;
     maxiter_ = 50;
     converged_ = false;
+    parallel_sweep_ = false;
 }
 std::shared_ptr<Localizer> Localizer::build(const std::string& type, std::shared_ptr<BasisSet> primary,
                                             std::shared_ptr<Matrix> C, Options& options) {
@@ -79,6 +107,7 @@ std::shared_ptr<Localizer> Localizer::build(const std::string& type, std::shared
     local->set_bench(options.get_int("BENCH"));
     local->set_convergence(options.get_double("LOCAL_CONVERGENCE"));
     local->set_maxiter(options.get_int("LOCAL_MAXITER"));
+    if (options.exists("LOCAL_PARALLEL_SWEEP")) local->set_parallel_sweep(options.get_bool("LOCAL_PARALLEL_SWEEP"));
 
     return local;
 }
@@ -143,6 +172,7 @@ void BoysLocalizer::print_header() const {
     outfile->Printf("  ==> Boys Localizer <==\n\n");
     outfile->Printf("    Convergence = %11.3E\n", convergence_);
     outfile->Printf("    Maxiter     = %11d\n", maxiter_);
+    outfile->Printf("    Sweep       = %11s\n", (parallel_sweep_ ? "PARALLEL" : "SEQUENTIAL"));
     outfile->Printf("\n");
 }
 void BoysLocalizer::localize() {
@@ -215,7 +245,51 @@ void BoysLocalizer::localize() {
 
     // ==> Master Loop <== //
 
-    double Ad, Ao, a, b, c, Hd, Ho, theta, cc, ss;
+    // Givens angle for the (i,j) pair of the current dipole matrices
+    auto boys_rotation = [&](int i, int j, double& cc, double& ss) {
+        double Ad, Ao, a, b, c, Hd, Ho, theta;
+
+        // H elements
+        a = 0.0;
+        b = 0.0;
+        c = 0.0;
+        for (int xyz = 0; xyz < 3; xyz++) {
+            double** Ak = Dp[xyz];
+            Ad = (Ak[i][i] - Ak[j][j]);
+            Ao = 2.0 * Ak[i][j];
+            a += Ad * Ad;
+            b += Ao * Ao;
+            c += Ad * Ao;
+        }
+
+        // Theta
+        Hd = a - b;
+        Ho = 2.0 * c;
+        theta = 0.5 * atan2(Ho, Hd + sqrt(Hd * Hd + Ho * Ho));
+
+        // Check for trivial (maximal) rotation, which might be better with theta = pi/4
+        if (std::fabs(theta) < 1.0E-8) {
+            double O0 = 0.0;
+            double O1 = 0.0;
+            for (int xyz = 0; xyz < 3; xyz++) {
+                double** Ak = Dp[xyz];
+                O0 += Ak[i][j] * Ak[i][j];
+                O1 += 0.25 * (Ak[j][j] - Ak[i][i]) * (Ak[j][j] - Ak[i][i]);
+            }
+            if (O1 < O0) {
+                theta = M_PI / 4.0;
+            }
+        }
+
+        // Givens rotation
+        cc = cos(theta);
+        ss = sin(theta);
+
+        return theta;
+    };
+
+    std::vector<std::vector<std::pair<int, int> > > rounds;
+    if (parallel_sweep_) rounds = tournament_rounds(nmo);
 
     for (int iter = 1; iter <= maxiter_; iter++) {
         // => Random Permutation <= //
@@ -234,69 +308,64 @@ void BoysLocalizer::localize() {
 
         // => Jacobi sweep <= //
 
-        for (int i2 = 0; i2 < nmo - 1; i2++) {
-            for (int j2 = i2 + 1; j2 < nmo; j2++) {
-                int i = order2[i2];
-                int j = order2[j2];
-
-                // > Compute the rotation < //
-
-                // H elements
-                a = 0.0;
-                b = 0.0;
-                c = 0.0;
-                for (int xyz = 0; xyz < 3; xyz++) {
-                    double** Ak = Dp[xyz];
-                    Ad = (Ak[i][i] - Ak[j][j]);
-                    Ao = 2.0 * Ak[i][j];
-                    a += Ad * Ad;
-                    b += Ao * Ao;
-                    c += Ad * Ao;
-                }
+        if (parallel_sweep_) {
+            // Disjoint pairs leave each other's (ii, jj, ij) elements untouched, so a whole round is
+            // equivalent to applying its rotations one after another
+            for (const auto& round : rounds) {
+                int npair = round.size();
+                std::vector<double> cs(npair), sn(npair);
 
-                // Theta
-                Hd = a - b;
-                Ho = 2.0 * c;
-                theta = 0.5 * atan2(Ho, Hd + sqrt(Hd * Hd + Ho * Ho));
+#pragma omp parallel for schedule(static)
+                for (int p = 0; p < npair; p++) {
+                    boys_rotation(order2[round[p].first], order2[round[p].second], cs[p], sn[p]);
+                }
 
-                // Check for trivial (maximal) rotation, which might be better with theta = pi/4
-                if (std::fabs(theta) < 1.0E-8) {
-                    double O0 = 0.0;
-                    double O1 = 0.0;
-                    ;
+                // rows of A^k and Q, then columns of A^k once every row update is in
+#pragma omp parallel for schedule(static)
+                for (int p = 0; p < npair; p++) {
+                    int i = order2[round[p].first];
+                    int j = order2[round[p].second];
                     for (int xyz = 0; xyz < 3; xyz++) {
-                        double** Ak = Dp[xyz];
-                        O0 += Ak[i][j] * Ak[i][j];
-                        O1 += 0.25 * (Ak[j][j] - Ak[i][i]) * (Ak[j][j] - Ak[i][i]);
+                        C_DROT(nmo, &Dp[xyz][i][0], 1, &Dp[xyz][j][0], 1, cs[p], sn[p]);
                     }
-                    if (O1 < O0) {
-                        theta = M_PI / 4.0;
-                        if (debug_ > 3) {
-                            outfile->Printf("@Break\n");
-                        }
+                    C_DROT(nmo, Up[i], 1, Up[j], 1, cs[p], sn[p]);
+                }
+#pragma omp parallel for schedule(static)
+                for (int p = 0; p < npair; p++) {
+                    int i = order2[round[p].first];
+                    int j = order2[round[p].second];
+                    for (int xyz = 0; xyz < 3; xyz++) {
+                        C_DROT(nmo, &Dp[xyz][0][i], nmo, &Dp[xyz][0][j], nmo, cs[p], sn[p]);
                     }
                 }
+            }
+        } else {
+            for (int i2 = 0; i2 < nmo - 1; i2++) {
+                for (int j2 = i2 + 1; j2 < nmo; j2++) {
+                    int i = order2[i2];
+                    int j = order2[j2];
 
-                // Givens rotation
-                cc = cos(theta);
-                ss = sin(theta);
+                    // > Compute the rotation < //
 
-                if (debug_ > 3) {
-                    outfile->Printf("@Rotation, i = %4d, j = %4d, Theta = %24.16E\n", i, j, theta);
-                    outfile->Printf("@Info, a = %24.16E, b = %24.16E, c = %24.16E\n", a, b, c);
-                }
+                    double cc, ss;
+                    double theta = boys_rotation(i, j, cc, ss);
 
-                // > Apply the rotation < //
+                    if (debug_ > 3) {
+                        outfile->Printf("@Rotation, i = %4d, j = %4d, Theta = %24.16E\n", i, j, theta);
+                    }
 
-                // rows and columns of A^k
-                for (int xyz = 0; xyz < 3; xyz++) {
-                    double** Ak = Dp[xyz];
-                    C_DROT(nmo, &Ak[i][0], 1, &Ak[j][0], 1, cc, ss);
-                    C_DROT(nmo, &Ak[0][i], nmo, &Ak[0][j], nmo, cc, ss);
-                }
+                    // > Apply the rotation < //
+
+                    // rows and columns of A^k
+                    for (int xyz = 0; xyz < 3; xyz++) {
+                        double** Ak = Dp[xyz];
+                        C_DROT(nmo, &Ak[i][0], 1, &Ak[j][0], 1, cc, ss);
+                        C_DROT(nmo, &Ak[0][i], nmo, &Ak[0][j], nmo, cc, ss);
+                    }
 
-                // Q
-                C_DROT(nmo, Up[i], 1, Up[j], 1, cc, ss);
+                    // Q
+                    C_DROT(nmo, Up[i], 1, Up[j], 1, cc, ss);
+                }
             }
         }
 
@@ -342,6 +411,7 @@ void PMLocalizer::print_header() const {
     outfile->Printf("  ==> Pipek-Mezey Localizer <==\n\n");
     outfile->Printf("    Convergence = %11.3E\n", convergence_);
     outfile->Printf("    Maxiter     = %11d\n", maxiter_);
+    outfile->Printf("    Sweep       = %11s\n", (parallel_sweep_ ? "PARALLEL" : "SEQUENTIAL"));
     outfile->Printf("\n");
 }
 void PMLocalizer::localize() {
@@ -419,7 +489,69 @@ void PMLocalizer::localize() {
 
     // ==> Master Loop <== //
 
-    double Aii, Ajj, Aij, Ad, Ao, a, b, c, Hd, Ho, theta, cc, ss;
+    // Givens angle for the (i,j) pair; reads only columns i and j of LS and L
+    auto pm_rotation = [&](int i, int j, double& cc, double& ss) {
+        double Aii, Ajj, Aij, Ad, Ao, a, b, c, Hd, Ho, theta;
+
+        // H elements
+        a = 0.0;
+        b = 0.0;
+        c = 0.0;
+        for (int A = 0; A < nA; A++) {
+            int nm = Astarts[A + 1] - Astarts[A];
+            int off = Astarts[A];
+            Aii = C_DDOT(nm, &LSp[off][i], nmo, &Lp[off][i], nmo);
+            Ajj = C_DDOT(nm, &LSp[off][j], nmo, &Lp[off][j], nmo);
+            Aij = 0.5 * C_DDOT(nm, &LSp[off][i], nmo, &Lp[off][j], nmo) +
+                  0.5 * C_DDOT(nm, &LSp[off][j], nmo, &Lp[off][i], nmo);
+
+            Ad = (Aii - Ajj);
+            Ao = 2.0 * Aij;
+            a += Ad * Ad;
+            b += Ao * Ao;
+            c += Ad * Ao;
+        }
+
+        // Theta
+        Hd = a - b;
+        Ho = 2.0 * c;
+        theta = 0.5 * atan2(Ho, Hd + sqrt(Hd * Hd + Ho * Ho));
+
+        // Check for trivial (maximal) rotation, which might be better with theta = pi/4
+        if (std::fabs(theta) < 1.0E-8) {
+            double O0 = 0.0;
+            double O1 = 0.0;
+            for (int A = 0; A < nA; A++) {
+                int nm = Astarts[A + 1] - Astarts[A];
+                int off = Astarts[A];
+                Aii = C_DDOT(nm, &LSp[off][i], nmo, &Lp[off][i], nmo);
+                Ajj = C_DDOT(nm, &LSp[off][j], nmo, &Lp[off][j], nmo);
+                Aij = 0.5 * C_DDOT(nm, &LSp[off][i], nmo, &Lp[off][j], nmo) +
+                      0.5 * C_DDOT(nm, &LSp[off][j], nmo, &Lp[off][i], nmo);
+                O0 += Aij * Aij;
+                O1 += 0.25 * (Ajj - Aii) * (Ajj - Aii);
+            }
+            if (O1 < O0) {
+                theta = M_PI / 4.0;
+            }
+        }
+
+        // Givens rotation
+        cc = cos(theta);
+        ss = sin(theta);
+
+        return theta;
+    };
+
+    // columns of LS and L, rows of Q
+    auto pm_apply = [&](int i, int j, double cc, double ss) {
+        C_DROT(nso, &LSp[0][i], nmo, &LSp[0][j], nmo, cc, ss);
+        C_DROT(nso, &Lp[0][i], nmo, &Lp[0][j], nmo, cc, ss);
+        C_DROT(nmo, Up[i], 1, Up[j], 1, cc, ss);
+    };
+
+    std::vector<std::vector<std::pair<int, int> > > rounds;
+    if (parallel_sweep_) rounds = tournament_rounds(nmo);
 
     for (int iter = 1; iter <= maxiter_; iter++) {
         // => Random Permutation <= //
@@ -438,77 +570,33 @@ void PMLocalizer::localize() {
 
         // => Jacobi sweep <= //
 
-        for (int i2 = 0; i2 < nmo - 1; i2++) {
-            for (int j2 = i2 + 1; j2 < nmo; j2++) {
-                int i = order2[i2];
-                int j = order2[j2];
-
-                // > Compute the rotation < //
-
-                // H elements
-                a = 0.0;
-                b = 0.0;
-                c = 0.0;
-                for (int A = 0; A < nA; A++) {
-                    int nm = Astarts[A + 1] - Astarts[A];
-                    int off = Astarts[A];
-                    Aii = C_DDOT(nm, &LSp[off][i], nmo, &Lp[off][i], nmo);
-                    Ajj = C_DDOT(nm, &LSp[off][j], nmo, &Lp[off][j], nmo);
-                    Aij = 0.5 * C_DDOT(nm, &LSp[off][i], nmo, &Lp[off][j], nmo) +
-                          0.5 * C_DDOT(nm, &LSp[off][j], nmo, &Lp[off][i], nmo);
-
-                    Ad = (Aii - Ajj);
-                    Ao = 2.0 * Aij;
-                    a += Ad * Ad;
-                    b += Ao * Ao;
-                    c += Ad * Ao;
+        if (parallel_sweep_) {
+            // Each rotation reads and writes only its own two columns, so disjoint pairs are independent
+            for (const auto& round : rounds) {
+#pragma omp parallel for schedule(dynamic)
+                for (int p = 0; p < round.size(); p++) {
+                    int i = order2[round[p].first];
+                    int j = order2[round[p].second];
+                    double cc, ss;
+                    pm_rotation(i, j, cc, ss);
+                    pm_apply(i, j, cc, ss);
                 }
+            }
+        } else {
+            for (int i2 = 0; i2 < nmo - 1; i2++) {
+                for (int j2 = i2 + 1; j2 < nmo; j2++) {
+                    int i = order2[i2];
+                    int j = order2[j2];
 
-                // Theta
-                Hd = a - b;
-                Ho = 2.0 * c;
-                theta = 0.5 * atan2(Ho, Hd + sqrt(Hd * Hd + Ho * Ho));
-
-                // Check for trivial (maximal) rotation, which might be better with theta = pi/4
-                if (std::fabs(theta) < 1.0E-8) {
-                    double O0 = 0.0;
-                    double O1 = 0.0;
-                    ;
-                    for (int A = 0; A < nA; A++) {
-                        int nm = Astarts[A + 1] - Astarts[A];
-                        int off = Astarts[A];
-                        Aii = C_DDOT(nm, &LSp[off][i], nmo, &Lp[off][i], nmo);
-                        Ajj = C_DDOT(nm, &LSp[off][j], nmo, &Lp[off][j], nmo);
-                        Aij = 0.5 * C_DDOT(nm, &LSp[off][i], nmo, &Lp[off][j], nmo) +
-                              0.5 * C_DDOT(nm, &LSp[off][j], nmo, &Lp[off][i], nmo);
-                        O0 += Aij * Aij;
-                        O1 += 0.25 * (Ajj - Aii) * (Ajj - Aii);
-                    }
-                    if (O1 < O0) {
-                        theta = M_PI / 4.0;
-                        if (debug_ > 3) {
-                            outfile->Printf("@Break\n");
-                        }
-                    }
-                }
+                    double cc, ss;
+                    double theta = pm_rotation(i, j, cc, ss);
 
-                // Givens rotation
-                cc = cos(theta);
-                ss = sin(theta);
+                    if (debug_ > 3) {
+                        outfile->Printf("@Rotation, i = %4d, j = %4d, Theta = %24.16E\n", i, j, theta);
+                    }
 
-                if (debug_ > 3) {
-                    outfile->Printf("@Rotation, i = %4d, j = %4d, Theta = %24.16E\n", i, j, theta);
-                    outfile->Printf("@Info, a = %24.16E, b = %24.16E, c = %24.16E\n", a, b, c);
+                    pm_apply(i, j, cc, ss);
                 }
-
-                // > Apply the rotation < //
-
-                // columns of LS and L
-                C_DROT(nso, &LSp[0][i], nmo, &LSp[0][j], nmo, cc, ss);
-                C_DROT(nso, &Lp[0][i], nmo, &Lp[0][j], nmo, cc, ss);
-
-                // Q
-                C_DROT(nmo, Up[i], 1, Up[j], 1, cc, ss);
             }
         }
 
@@ -57,6 +57,8 @@ class PSI_API Localizer {
     double convergence_;
     /// Maximum number of iterations
     int maxiter_;
+    /// Run each Jacobi sweep as rounds of disjoint pairs, threaded within a round?
+    bool parallel_sweep_;
 
     /// Primary orbital basis set
     std::shared_ptr<BasisSet> primary_;
@@ -122,6 +124,8 @@ class PSI_API Localizer {
     void set_convergence(double convergence) { convergence_ = convergence; }
 
     void set_maxiter(int maxiter) { maxiter_ = maxiter; }
+
+    void set_parallel_sweep(bool parallel_sweep) { parallel_sweep_ = parallel_sweep; }
 };
 
 class PSI_API BoysLocalizer : public Localizer {
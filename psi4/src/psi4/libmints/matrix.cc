@@ -46,6 +46,7 @@
 #include "psi4/libpsi4util/PsiOutStream.h"
 #include "psi4/libpsi4util/process.h"
 
+#include "blockpool.h"
 #include "factory.h"
 #include "wavefunction.h"
 #include "dimension.h"
@@ -1360,6 +1361,10 @@ void Matrix::gemm(bool transa, bool transb, double alpha, const Matrix *const a,
     int symlink = (!transa ? a->symmetry() : 0);
     auto nlink = (!transa ? a->colspi() : a->rowspi());
 
+    // The irrep blocks are independent, hand them to BLAS as one batch
+    std::vector<int> ms, ns, ks, ldas, ldbs, ldcs;
+    std::vector<double *> as, bs, cs;
+
     for (int Ha = 0; Ha < nirrep_; ++Ha) {
         int Hb = Ha ^ (transa ? 0 : a->symmetry()) ^ (transb ? b->symmetry() : 0);
         int Hc = Ha ^ (transa ? a->symmetry() : 0);
@@ -1387,10 +1392,20 @@ void Matrix::gemm(bool transa, bool transb, double alpha, const Matrix *const a,
             throw PSIEXCEPTION("Matrix::gemm error: Number of rows and columns do not match.");
         }
         if (m && n && k) {
-            C_DGEMM(ta, tb, m, n, k, alpha, &(a->matrix_[Ha][0][0]), lda, &(b->matrix_[Hb][0][0]), ldb, beta,
-                    &(matrix_[Hc][0][0]), ldc);
+            ms.push_back(m);
+            ns.push_back(n);
+            ks.push_back(k);
+            as.push_back(&(a->matrix_[Ha][0][0]));
+            bs.push_back(&(b->matrix_[Hb][0][0]));
+            cs.push_back(&(matrix_[Hc][0][0]));
+            ldas.push_back(lda);
+            ldbs.push_back(ldb);
+            ldcs.push_back(ldc);
         }
     }
+
+    C_DGEMM_BATCH(ta, tb, ms.size(), ms.data(), ns.data(), ks.data(), alpha, as.data(), ldas.data(), bs.data(),
+                  ldbs.data(), beta, cs.data(), ldcs.data());
 }
 
 void Matrix::gemm(bool transa, bool transb, double alpha, const SharedMatrix &a, const SharedMatrix &b, double beta) {
@@ -1427,6 +1442,22 @@ void Matrix::axpy(double a, SharedMatrix X) {
     }
 }
 
+void Matrix::axpby(double a, const Matrix &X, double b) {
+    if (nirrep_ != X.nirrep()) {
+        throw PSIEXCEPTION("Matrix::axpby: Matrices do not have the same nirreps");
+    }
+    for (int h = 0; h < nirrep_; h++) {
+        size_t size = colspi_[h ^ symmetry()] * (size_t)rowspi_[h];
+        size_t size_X = X.colspi()[h ^ X.symmetry()] * (size_t)X.rowspi()[h];
+        if (size != size_X) {
+            throw PSIEXCEPTION("Matrix::axpby: Matrices sizes do not match.");
+        }
+        if (size) C_DAXPBY(size, a, X.pointer(h)[0], 1, b, matrix_[h][0], 1);
+    }
+}
+
+void Matrix::axpby(double a, const SharedMatrix &X, double b) { axpby(a, *X, b); }
+
 SharedVector Matrix::gemv(bool transa, double alpha, const Vector& A) {
     auto return_vec = std::make_shared<Vector>(transa ? colspi_ : rowspi_);
     return_vec->gemv(transa, alpha, *this, A, 0);
@@ -1690,7 +1721,54 @@ double Matrix::vector_dot(const Matrix *const rhs) {
 
 double Matrix::vector_dot(const SharedMatrix &rhs) { return vector_dot(rhs.get()); }
 
-void Matrix::diagonalize(Matrix &eigvectors, Vector &eigvalues, diagonalize_order nMatz /* = ascending*/) {
+namespace {
+/// Ascending eigenpairs of the symmetric n x n block A with dsyevd (il = iu = 0, full spectrum)
+/// or dsyevr (eigenvalues il..iu, 1-based, or those in (vl, vu] when il = 0 and vl < vu).
+/// Eigenvectors, if V is given, land in its first m columns. Returns the LAPACK info.
+int dsyev_driver(diagonalize_algorithm algorithm, int n, double **A, double *w, double **V, int &m, int il = 0,
+                 int iu = 0, double vl = 0.0, double vu = 0.0) {
+    // Symmetric, so the row-major block is its own column-major image; LAPACK destroys the copy
+    std::vector<double> a((size_t)n * n);
+    ::memcpy(a.data(), A[0], sizeof(double) * n * n);
+    const char jobz = (V != nullptr) ? 'V' : 'N';
+    int info;
+
+    if (algorithm == diag_dsyevd) {
+        double lwork_tmp;
+        int liwork_tmp;
+        C_DSYEVD(jobz, 'U', n, a.data(), n, w, &lwork_tmp, -1, &liwork_tmp, -1);
+        std::vector<double> work((size_t)lwork_tmp);
+        std::vector<int> iwork(liwork_tmp);
+        info = C_DSYEVD(jobz, 'U', n, a.data(), n, w, work.data(), (int)lwork_tmp, iwork.data(), liwork_tmp);
+        m = n;
+        if (info == 0 && V != nullptr) {
+            for (int j = 0; j < n; j++)
+                for (int i = 0; i < n; i++) V[i][j] = a[(size_t)j * n + i];
+        }
+    } else {
+        char range = (il > 0) ? 'I' : ((vl < vu) ? 'V' : 'A');
+        int ncols = (range == 'I') ? iu - il + 1 : n;
+        std::vector<double> z((V != nullptr) ? (size_t)n * ncols : 1);
+        std::vector<int> isuppz(2 * std::max(1, ncols));
+        double lwork_tmp;
+        int liwork_tmp;
+        C_DSYEVR(jobz, range, 'U', n, a.data(), n, vl, vu, il, iu, 0.0, &m, w, z.data(), n, isuppz.data(), &lwork_tmp,
+                 -1, &liwork_tmp, -1);
+        std::vector<double> work((size_t)lwork_tmp);
+        std::vector<int> iwork(liwork_tmp);
+        info = C_DSYEVR(jobz, range, 'U', n, a.data(), n, vl, vu, il, iu, 0.0, &m, w, z.data(), n, isuppz.data(),
+                        work.data(), (int)lwork_tmp, iwork.data(), liwork_tmp);
+        if (info == 0 && V != nullptr) {
+            for (int j = 0; j < m; j++)
+                for (int i = 0; i < n; i++) V[i][j] = z[(size_t)j * n + i];
+        }
+    }
+    return info;
+}
+}  // namespace
+
+void Matrix::diagonalize(Matrix &eigvectors, Vector &eigvalues, diagonalize_order nMatz /* = ascending*/,
+                         diagonalize_algorithm algorithm /* = diag_dsyev*/) {
     if (symmetry_) {
         throw PSIEXCEPTION("Matrix::diagonalize: Matrix is non-totally symmetric.");
     }
@@ -1699,7 +1777,21 @@ void Matrix::diagonalize(Matrix &eigvectors, Vector &eigvalues, diagonalize_orde
             if (rowspi_[h] != colspi_[h]) throw PSIEXCEPTION("Matrix::diagonalize: non-square irrep!");
 
             int info = -1;
-            if(nMatz == evals_only_ascending){
+            if (algorithm != diag_dsyev) {
+                int n = rowspi_[h];
+                int m;
+                bool vectors = (nMatz == ascending || nMatz == descending);
+                if (!vectors && nMatz != evals_only_ascending && nMatz != evals_only_descending)
+                    throw PSIEXCEPTION("Matrix::diagonalize: illegal diagonalize_order!");
+                double *w = eigvalues.pointer(h);
+                double **V = vectors ? eigvectors.matrix_[h] : nullptr;
+                info = dsyev_driver(algorithm, n, matrix_[h], w, V, m);
+                if (info == 0 && (nMatz == descending || nMatz == evals_only_descending)) {
+                    std::reverse(w, w + n);
+                    if (vectors)
+                        for (int i = 0; i < n; i++) std::reverse(V[i], V[i] + n);
+                }
+            } else if(nMatz == evals_only_ascending){
                 info = DSYEV_ascending(rowspi_[h], matrix_[h], eigvalues.pointer(h));
             }else if(nMatz == ascending){
                 info = DSYEV_ascending(rowspi_[h], matrix_[h], eigvalues.pointer(h), eigvectors.matrix_[h]);
@@ -1716,8 +1808,59 @@ void Matrix::diagonalize(Matrix &eigvectors, Vector &eigvalues, diagonalize_orde
 }
 
 void Matrix::diagonalize(SharedMatrix &eigvectors, std::shared_ptr<Vector> &eigvalues,
-                         diagonalize_order nMatz /* = ascending*/) {
-    diagonalize(*eigvectors, *eigvalues, nMatz);
+                         diagonalize_order nMatz /* = ascending*/, diagonalize_algorithm algorithm /* = diag_dsyev*/) {
+    diagonalize(*eigvectors, *eigvalues, nMatz, algorithm);
+}
+
+std::tuple<SharedMatrix, SharedVector> Matrix::diagonalize_lowest(const Dimension &nroots) {
+    if (symmetry_) {
+        throw PSIEXCEPTION("Matrix::diagonalize_lowest: Matrix is non-totally symmetric.");
+    }
+    auto evecs = std::make_shared<Matrix>(name_ + " Eigenvectors", rowspi_, nroots);
+    auto evals = std::make_shared<Vector>(name_ + " Eigenvalues", nroots);
+    for (int h = 0; h < nirrep_; ++h) {
+        if (!nroots[h]) continue;
+        if (rowspi_[h] != colspi_[h]) throw PSIEXCEPTION("Matrix::diagonalize_lowest: non-square irrep!");
+        if (nroots[h] > rowspi_[h]) throw PSIEXCEPTION("Matrix::diagonalize_lowest: more roots than rows!");
+        int m;
+        int info = dsyev_driver(diag_dsyevr, rowspi_[h], matrix_[h], evals->pointer(h), evecs->pointer(h), m, 1,
+                                nroots[h]);
+        if (info != 0 || m != nroots[h]) throw PSIEXCEPTION("Matrix::diagonalize_lowest: DSYEVR failed!");
+    }
+    return std::make_tuple(evecs, evals);
+}
+
+std::tuple<SharedMatrix, SharedVector> Matrix::diagonalize_range(double vl, double vu) {
+    if (symmetry_) {
+        throw PSIEXCEPTION("Matrix::diagonalize_range: Matrix is non-totally symmetric.");
+    }
+    if (!(vl < vu)) throw PSIEXCEPTION("Matrix::diagonalize_range: empty eigenvalue window!");
+
+    // The number of eigenvalues in the window is only known afterwards, so solve into full-size buffers
+    Dimension nroots(nirrep_);
+    std::vector<std::vector<double>> w(nirrep_);
+    std::vector<SharedMatrix> V(nirrep_);
+    for (int h = 0; h < nirrep_; ++h) {
+        int n = rowspi_[h];
+        if (!n) continue;
+        if (n != colspi_[h]) throw PSIEXCEPTION("Matrix::diagonalize_range: non-square irrep!");
+        w[h].resize(n);
+        V[h] = std::make_shared<Matrix>(n, n);
+        int m;
+        int info = dsyev_driver(diag_dsyevr, n, matrix_[h], w[h].data(), V[h]->pointer(), m, 0, 0, vl, vu);
+        if (info != 0) throw PSIEXCEPTION("Matrix::diagonalize_range: DSYEVR failed!");
+        nroots[h] = m;
+    }
+
+    auto evecs = std::make_shared<Matrix>(name_ + " Eigenvectors", rowspi_, nroots);
+    auto evals = std::make_shared<Vector>(name_ + " Eigenvalues", nroots);
+    for (int h = 0; h < nirrep_; ++h) {
+        for (int k = 0; k < nroots[h]; k++) {
+            evals->set(h, k, w[h][k]);
+            for (int i = 0; i < rowspi_[h]; i++) evecs->set(h, i, k, V[h]->get(i, k));
+        }
+    }
+    return std::make_tuple(evecs, evals);
 }
 
 std::tuple<SharedMatrix, SharedVector, SharedMatrix> Matrix::svd_temps() {
@@ -2605,6 +2748,30 @@ void Matrix::hermitivitize() {
     }
 }
 
+void Matrix::antisymmetrize() {
+    if (symmetry_) {
+        throw PSIEXCEPTION("Antisymmetrize: matrix is not totally symmetric");
+    }
+
+    for (int h = 0; h < nirrep_; h++) {
+        if (rowspi_[h] != colspi_[h]) {
+            throw PSIEXCEPTION("Antisymmetrize: matrix is not square");
+        }
+        int n = rowspi_[h];
+        if (!n) continue;
+        double **M = matrix_[h];
+
+        for (int row = 0; row < n; row++) {
+            M[row][row] = 0.0;
+            for (int col = row + 1; col < n; col++) {
+                double val = M[row][col] - M[col][row];
+                M[row][col] = val;
+                M[col][row] = -val;
+            }
+        }
+    }
+}
+
 // Reference versions of the above functions:
 
 void Matrix::transform(const Matrix &a, const Matrix &transformer) {
@@ -2875,7 +3042,7 @@ void Matrix::save(const std::string &filename, bool append, bool saveLowerTriang
                 }
             }
         }
-        linalg::detail::free(fullblock);
+        free_block(fullblock);
     } else {
         if (saveLowerTriangle) {
             // Count the number of non-zero elements
@@ -2929,6 +3096,32 @@ void Matrix::save(std::shared_ptr<psi::PSIO> &psio, size_t fileno, SaveType save
     save(psio.get(), fileno, savetype);
 }
 
+namespace {
+
+/// Doubles staged per PSIO call when a matrix goes to or from disk in a packed or dense layout (1 MiB)
+const size_t psio_stage_doubles = 131072;
+
+/// Offset of the first column of each irrep's block in the dense matrix
+std::vector<int> dense_col_offsets(const Dimension &colspi) {
+    std::vector<int> offset(colspi.n(), 0);
+    for (int h = 1; h < colspi.n(); ++h) offset[h] = offset[h - 1] + colspi[h - 1];
+    return offset;
+}
+
+/// Irrep and in-irrep index of each element of a dimension, in dense order
+void dense_indices(const Dimension &dim, std::vector<int> &irrep, std::vector<int> &index) {
+    irrep.clear();
+    index.clear();
+    for (int h = 0; h < dim.n(); ++h) {
+        for (int i = 0; i < dim[h]; ++i) {
+            irrep.push_back(h);
+            index.push_back(i);
+        }
+    }
+}
+
+}  // namespace
+
 void Matrix::save(psi::PSIO *const psio, size_t fileno, SaveType st) {
     // Check to see if the file is open
     bool already_open = false;
@@ -2956,20 +3149,49 @@ void Matrix::save(psi::PSIO *const psio, size_t fileno, SaveType st) {
                                   sizeof(double) * colspi_[h ^ symmetry_] * rowspi_[h]);
         }
     } else if (st == Full) {
-        double **fullblock = to_block_matrix();
-
-        // Write the full block
-        if (sizer > 0 && sizec > 0)
-            psio->write_entry(fileno, const_cast<char *>(name_.c_str()), (char *)fullblock[0],
-                              sizeof(double) * sizer * sizec);
-
-        linalg::detail::free(fullblock);
+        if (sizer > 0 && sizec > 0) {
+            if (nirrep_ == 1) {
+                // The block is the full matrix: write it in place
+                psio->write_entry(fileno, const_cast<char *>(name_.c_str()), (char *)matrix_[0][0],
+                                  sizeof(double) * sizer * sizec);
+            } else {
+                // Stream the dense matrix a row at a time instead of building it whole
+                std::vector<int> col_offset = dense_col_offsets(colspi_);
+                std::vector<double> row(sizec);
+                psio_address next = PSIO_ZERO;
+                for (int h = 0; h < nirrep_; ++h) {
+                    const int g = h ^ symmetry_;
+                    for (int i = 0; i < rowspi_[h]; ++i) {
+                        std::fill(row.begin(), row.end(), 0.0);
+                        std::copy(matrix_[h][i], matrix_[h][i] + colspi_[g], row.begin() + col_offset[g]);
+                        psio->write(fileno, name_.c_str(), (char *)row.data(), sizeof(double) * sizec, next, &next);
+                    }
+                }
+            }
+        }
     } else if (st == LowerTriangle) {
-        double *lower = to_lower_triangle();
-
-        if (sizer > 0)
-            psio->write_entry(fileno, const_cast<char *>(name_.c_str()), (char *)lower, sizeof(double) * ioff[sizer]);
-        delete[] lower;
+        if (sizer != sizec) {
+            throw PSIEXCEPTION("Matrix::save: LowerTriangle only applies to square matrices.\n");
+        }
+        // Pack the lower triangle a bounded number of rows at a time instead of building it whole
+        std::vector<int> col_offset = dense_col_offsets(colspi_);
+        std::vector<double> packed;
+        psio_address next = PSIO_ZERO;
+        int r = 0;
+        for (int h = 0; h < nirrep_; ++h) {
+            const int g = h ^ symmetry_;
+            for (int i = 0; i < rowspi_[h]; ++i, ++r) {
+                const size_t start = packed.size();
+                packed.resize(start + r + 1, 0.0);
+                for (int j = 0; j < colspi_[g] && col_offset[g] + j <= r; ++j)
+                    packed[start + col_offset[g] + j] = matrix_[h][i][j];
+                if (packed.size() >= psio_stage_doubles || r == sizer - 1) {
+                    psio->write(fileno, name_.c_str(), (char *)packed.data(), sizeof(double) * packed.size(), next,
+                                &next);
+                    packed.clear();
+                }
+            }
+        }
     } else if (st == ThreeIndexLowerTriangle) {
         if (nirrep_ != 1) {
             throw PSIEXCEPTION("Matrix::save: ThreeIndexLowerTriangle only applies to matrices without symmetry. This will be changing soon!\n");
@@ -2980,18 +3202,23 @@ void Matrix::save(psi::PSIO *const psio, size_t fileno, SaveType st) {
             throw PSIEXCEPTION("Matrix::save: ThreeIndexLowerTriangle columns must be indexed by pairs of the same vector.\n");
         }
         auto ntri = np * (np + 1) / 2;
-        std::vector<double> temp(nP * ntri, 0);
-        auto data = temp.data();
-        int count = 0;
         if (nP > 0 && ntri > 0) {
-            for (int aux = 0; aux < nP; ++aux) {
-                for (int i = 0; i < np; ++i) {
-                    for (int j = 0; j <= i; ++j, ++count) {
-                        temp[count] = matrix_[0][aux][i * np + j];
+            // Pack a bounded number of auxiliary rows at a time
+            const int block = std::max<int>(1, psio_stage_doubles / ntri);
+            std::vector<double> temp(std::min(block, nP) * ntri, 0);
+            psio_address next = PSIO_ZERO;
+            for (int aux0 = 0; aux0 < nP; aux0 += block) {
+                const int naux = std::min(block, nP - aux0);
+                int count = 0;
+                for (int aux = aux0; aux < aux0 + naux; ++aux) {
+                    for (int i = 0; i < np; ++i) {
+                        for (int j = 0; j <= i; ++j, ++count) {
+                            temp[count] = matrix_[0][aux][i * np + j];
+                        }
                     }
                 }
+                psio->write(fileno, name_.c_str(), (char *)temp.data(), sizeof(double) * count, next, &next);
             }
-            psio->write_entry(fileno, const_cast<char *>(name_.c_str()), (char *)data, sizeof(double) * temp.size());
         }
     } else {
         throw PSIEXCEPTION("Matrix::save: Unknown SaveType\n");
@@ -3046,26 +3273,60 @@ void Matrix::load(psi::PSIO *const psio, size_t fileno, SaveType st) {
             str += " Symmetry " + to_string(symmetry_) + " Irrep " + to_string(h);
 
             // Read the sub-blocks
-            if (colspi_[h] > 0 && rowspi_[h] > 0)
+            if (colspi_[h ^ symmetry_] > 0 && rowspi_[h] > 0)
                 psio->read_entry(fileno, str.c_str(), (char *)matrix_[h][0],
                                  sizeof(double) * colspi_[h ^ symmetry_] * rowspi_[h]);
         }
     } else if (st == Full) {
-        double **fullblock = to_block_matrix();
-
-        // Read the full block
-        if (sizer > 0 && sizec > 0)
-            psio->read_entry(fileno, name_.c_str(), (char *)fullblock[0], sizeof(double) * sizer * sizec);
-
-        set(fullblock);
-        free_block(fullblock);
+        if (sizer > 0 && sizec > 0) {
+            if (nirrep_ == 1) {
+                // The block is the full matrix: read it in place
+                psio->read_entry(fileno, name_.c_str(), (char *)matrix_[0][0], sizeof(double) * sizer * sizec);
+            } else {
+                // Stream the dense matrix a row at a time, keeping the symmetry blocks
+                std::vector<int> col_offset = dense_col_offsets(colspi_);
+                std::vector<double> row(sizec);
+                psio_address next = PSIO_ZERO;
+                for (int h = 0; h < nirrep_; ++h) {
+                    const int g = h ^ symmetry_;
+                    for (int i = 0; i < rowspi_[h]; ++i) {
+                        psio->read(fileno, name_.c_str(), (char *)row.data(), sizeof(double) * sizec, next, &next);
+                        std::copy(row.begin() + col_offset[g], row.begin() + col_offset[g] + colspi_[g],
+                                  matrix_[h][i]);
+                    }
+                }
+            }
+        }
     } else if (st == LowerTriangle) {
-        double *lower = to_lower_triangle();
-
-        if (sizer > 0) psio->read_entry(fileno, name_.c_str(), (char *)lower, sizeof(double) * ioff[sizer]);
-
-        set(lower);
-        delete[] lower;
+        if (sizer != sizec) {
+            throw PSIEXCEPTION("Matrix::load: LowerTriangle only applies to square matrices.\n");
+        }
+        // Read the packed lower triangle a bounded number of rows at a time, filling both
+        // (r, c) and (c, r) from each element
+        std::vector<int> row_irrep, row_index, col_irrep, col_index;
+        dense_indices(rowspi_, row_irrep, row_index);
+        dense_indices(colspi_, col_irrep, col_index);
+        std::vector<double> packed;
+        psio_address next = PSIO_ZERO;
+        int r0 = 0;
+        while (r0 < sizer) {
+            int r1 = r0;
+            size_t n = 0;
+            while (r1 < sizer && (n == 0 || n + r1 + 1 <= psio_stage_doubles)) n += ++r1;
+            packed.resize(n);
+            psio->read(fileno, name_.c_str(), (char *)packed.data(), sizeof(double) * n, next, &next);
+
+            const double *val = packed.data();
+            for (int r = r0; r < r1; ++r) {
+                for (int c = 0; c <= r; ++c, ++val) {
+                    if ((row_irrep[r] ^ symmetry_) == col_irrep[c])
+                        matrix_[row_irrep[r]][row_index[r]][col_index[c]] = *val;
+                    if ((row_irrep[c] ^ symmetry_) == col_irrep[r])
+                        matrix_[row_irrep[c]][row_index[c]][col_index[r]] = *val;
+                }
+            }
+            r0 = r1;
+        }
     } else if (st == ThreeIndexLowerTriangle) {
         if (nirrep_ != 1) {
             throw PSIEXCEPTION("Matrix::load: ThreeIndexLowerTriangle only applies to matrices without symmetry. This will be changing soon!\n");
@@ -3076,16 +3337,22 @@ void Matrix::load(psi::PSIO *const psio, size_t fileno, SaveType st) {
             throw PSIEXCEPTION("Matrix::load: ThreeIndexLowerTriangle columns must be indexed by pairs of the same vector.\n");
         }
         auto ntri = np * (np + 1) / 2;
-        std::vector<double> temp(nP * ntri, 0);
-        auto data = temp.data();
         if (nP * ntri > 0) {
-            psio->read_entry(fileno, name_.c_str(), (char *)data, sizeof(double) * temp.size());
-            for (int aux = 0; aux < nP; aux++) {
-                for (int i = 0; i < np; i++) {
-                    for (int j = 0; j <= i; j++) {
-                        matrix_[0][aux][i * np + j] = *data;
-                        matrix_[0][aux][j * np + i] = *data;
-                        data++;
+            // Unpack a bounded number of auxiliary rows at a time
+            const int block = std::max<int>(1, psio_stage_doubles / ntri);
+            std::vector<double> temp(std::min(block, nP) * ntri, 0);
+            psio_address next = PSIO_ZERO;
+            for (int aux0 = 0; aux0 < nP; aux0 += block) {
+                const int naux = std::min(block, nP - aux0);
+                psio->read(fileno, name_.c_str(), (char *)temp.data(), sizeof(double) * naux * ntri, next, &next);
+                auto data = temp.data();
+                for (int aux = aux0; aux < aux0 + naux; aux++) {
+                    for (int i = 0; i < np; i++) {
+                        for (int j = 0; j <= i; j++) {
+                            matrix_[0][aux][i * np + j] = *data;
+                            matrix_[0][aux][j * np + i] = *data;
+                            data++;
+                        }
                     }
                 }
             }
@@ -3451,15 +3718,23 @@ SharedMatrix doublet(const SharedMatrix &A, const SharedMatrix &B, bool transA,
 }
 
 Matrix triplet(const Matrix &A, const Matrix &B, const Matrix &C, bool transA, bool transB, bool transC) {
-    bool same_symmetry = (A.symmetry() == B.symmetry() && A.symmetry() == C.symmetry());
+    Dimension m = (transA ? A.colspi() : A.rowspi());
+    Dimension n = (transC ? C.rowspi() : C.colspi());
 
-    Matrix T;
-    Matrix S;
+    auto S = Matrix("T", m, n, A.symmetry() ^ B.symmetry() ^ C.symmetry());
+    triplet_into(S, A, B, C, transA, transB, transC);
+
+    return S;
+}
+
+void triplet_into(Matrix &result, const Matrix &A, const Matrix &B, const Matrix &C, bool transA, bool transB,
+                  bool transC, double alpha, double beta) {
+    bool same_symmetry = (A.symmetry() == B.symmetry() && A.symmetry() == C.symmetry());
 
     if (!same_symmetry) {
-        T = doublet(A, B, transA, transB);
-        S = doublet(T, C, false, transC);
-        return S;
+        auto T = doublet(A, B, transA, transB);
+        result.gemm(false, transC, alpha, T, C, beta);
+        return;
     }
 
     // cost1 = cost of (AB)C
@@ -3490,14 +3765,12 @@ Matrix triplet(const Matrix &A, const Matrix &B, const Matrix &C, bool transA, b
     }
 
     if (cost1 <= cost2) {
-        T = doublet(A, B, transA, transB);
-        S = doublet(T, C, false, transC);
+        auto T = doublet(A, B, transA, transB);
+        result.gemm(false, transC, alpha, T, C, beta);
     } else {
-        T = doublet(B, C, transB, transC);
-        S = doublet(A, T, transA, false);
+        auto T = doublet(B, C, transB, transC);
+        result.gemm(transA, false, alpha, A, T, beta);
     }
-
-    return S;
 }
 
 SharedMatrix triplet(const SharedMatrix &A, const SharedMatrix &B, const SharedMatrix &C, bool transA, bool transB,
@@ -3510,15 +3783,15 @@ namespace detail {
 double **matrix(int nrow, int ncol) {
     double **mat = (double **)malloc(sizeof(double *) * nrow);
     const size_t size = sizeof(double) * nrow * (size_t)ncol;
-    mat[0] = (double *)malloc(size);
-    ::memset((void *)mat[0], 0, size);
+    // Aligned, and recycled from the last block of the same size class
+    mat[0] = static_cast<double *>(BlockPool::shared().allocate(size));
     for (int r = 1; r < nrow; ++r) mat[r] = mat[r - 1] + ncol;
     return mat;
 }
 
 /// free a (block) matrix -- analogous to libciomr's free_block
 void free(double **Block) {
-    ::free(Block[0]);
+    BlockPool::shared().deallocate(Block[0]);
     ::free(Block);
 }
 }  // namespace detail
@@ -52,6 +52,8 @@ class Matrix;
 using SharedMatrix = std::shared_ptr<Matrix>;
 
 enum diagonalize_order { evals_only_ascending = 0, ascending = 1, evals_only_descending = 2, descending = 3 };
+/// LAPACK driver behind Matrix::diagonalize: QR iteration, divide-and-conquer, or MRRR
+enum diagonalize_algorithm { diag_dsyev = 0, diag_dsyevd = 1, diag_dsyevr = 2 };
 
 namespace linalg {
 /**
@@ -94,6 +96,22 @@ SharedMatrix triplet(const SharedMatrix& A, const SharedMatrix& B, const SharedM
 
 Matrix triplet(const Matrix&A, const Matrix& B, const Matrix& C, bool transA = false, bool transB = false, bool transC = false);
 
+/** Triplet GEMM into an existing matrix, result = alpha * op(A) op(B) op(C) + beta * result
+ *  The product is associated in the cheaper order, only the intermediate is allocated.
+ * \param result The target, must already have the shape and symmetry of the product
+ * \param A The first matrix
+ * \param B The second matrix
+ * \param C The third matrix
+ * \param transA Transpose the first matrix
+ * \param transB Transpose the second matrix
+ * \param transC Transpose the third matrix
+ * \param alpha Prefactor for the product
+ * \param beta Prefactor for the existing contents of result
+ */
+PSI_API
+void triplet_into(Matrix& result, const Matrix& A, const Matrix& B, const Matrix& C, bool transA = false,
+                  bool transB = false, bool transC = false, double alpha = 1.0, double beta = 0.0);
+
 namespace detail {
 /*!
  * allocate a block matrix -- analogous to libciomr's block_matrix
@@ -843,6 +861,15 @@ class PSI_API Matrix : public std::enable_shared_from_this<Matrix> {
      */
     void axpy(double a, SharedMatrix X);
 
+    /**
+     * Scaled add in one pass, Y = a * X + b * Y
+     * @param a Scaling parameter of X
+     * @param X Matrix to be be added
+     * @param b Scaling parameter of this
+     */
+    void axpby(double a, const Matrix& X, double b);
+    void axpby(double a, const SharedMatrix& X, double b);
+
     /**
      * General matrix vector multiplication into this, alpha * AX + beta Y -> Y
      *
@@ -864,8 +891,20 @@ class PSI_API Matrix : public std::enable_shared_from_this<Matrix> {
 
     /// @{
     /// Diagonalizes this, eigvectors and eigvalues must be created by caller.  Only for symmetric matrices.
-    void diagonalize(Matrix& eigvectors, Vector& eigvalues, diagonalize_order nMatz = ascending);
-    void diagonalize(SharedMatrix& eigvectors, std::shared_ptr<Vector>& eigvalues, diagonalize_order nMatz = ascending);
+    /// For large matrices with eigenvectors, diag_dsyevd or diag_dsyevr are usually several times faster.
+    void diagonalize(Matrix& eigvectors, Vector& eigvalues, diagonalize_order nMatz = ascending,
+                     diagonalize_algorithm algorithm = diag_dsyev);
+    void diagonalize(SharedMatrix& eigvectors, std::shared_ptr<Vector>& eigvalues, diagonalize_order nMatz = ascending,
+                     diagonalize_algorithm algorithm = diag_dsyev);
+    /// @}
+
+    /// @{
+    /// Partial diagonalization of a symmetric matrix with MRRR (dsyevr); only the requested eigenpairs
+    /// are computed. Eigenvalues are ascending, eigenvectors are the columns of the returned matrix.
+    /// The nroots[h] lowest eigenpairs of each irrep
+    std::tuple<SharedMatrix, SharedVector> diagonalize_lowest(const Dimension& nroots);
+    /// All eigenpairs with eigenvalues in (vl, vu]
+    std::tuple<SharedMatrix, SharedVector> diagonalize_range(double vl, double vu);
     /// @}
 
     /// @{
@@ -1015,6 +1054,8 @@ class PSI_API Matrix : public std::enable_shared_from_this<Matrix> {
 
     /*! Average off-diagonal elements */
     void hermitivitize();
+    /*! Replace by the antisymmetric part times two, M - M^T, in place */
+    void antisymmetrize();
     /*! Copy lower triangle to upper triangle */
     void copy_lower_to_upper();
     /*! Copy upper triangle to lower triangle */
@@ -26,11 +26,85 @@
  * @END LICENSE
  */
 #include "psi4/libmints/mcmurchiedavidson.h"
+#include "psi4/libpsi4util/exception.h"
 
 #include <libint2/boys.h>
 
+#include <mutex>
+
 namespace mdintegrals {
 
+namespace {
+// Taylor grid: spacing, interpolation order, and the switch to the asymptotic formula
+constexpr double boys_delta = 0.05;
+constexpr int boys_order = 6;
+constexpr double boys_T_crit = 117.0;
+
+// F_m(T) for 0 <= m <= mmax at a single T, from the power series of the highest order and downward recursion;
+// only used to build the table
+void boys_reference(int mmax, double T, double* F) {
+    double term = 1.0 / (2 * mmax + 1);
+    double sum = term;
+    for (int k = 1; term > 1.0e-17 * sum; ++k) {
+        term *= 2.0 * T / (2 * mmax + 2 * k + 1);
+        sum += term;
+    }
+    double emt = std::exp(-T);
+    F[mmax] = emt * sum;
+    for (int m = mmax - 1; m >= 0; --m) F[m] = (2.0 * T * F[m + 1] + emt) / (2 * m + 1);
+}
+}  // namespace
+
+std::shared_ptr<const BoysBatch> BoysBatch::instance(int mmax) {
+    static std::mutex mutex;
+    static std::shared_ptr<const BoysBatch> shared;
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!shared || shared->max_m() < mmax) shared = std::make_shared<const BoysBatch>(mmax);
+    return shared;
+}
+
+BoysBatch::BoysBatch(int mmax) : mmax_(mmax), ncol_(mmax + boys_order + 1) {
+    int npoint = static_cast<int>(boys_T_crit / boys_delta) + 2;
+    grid_.resize((size_t)npoint * ncol_);
+    for (int k = 0; k < npoint; ++k) boys_reference(ncol_ - 1, k * boys_delta, &grid_[(size_t)k * ncol_]);
+}
+
+void BoysBatch::eval(double* F, const double* T, size_t n, int mmax) const {
+    if (mmax > mmax_) throw PSIEXCEPTION("BoysBatch::eval: requested order exceeds the tabulated range");
+
+    const double* grid = grid_.data();
+    const int ncol = ncol_;
+    const int stride = mmax + 1;
+    const double oodelta = 1.0 / boys_delta;
+
+#pragma omp simd
+    for (size_t i = 0; i < n; ++i) {
+        double t = T[i];
+        double fm;
+        if (t < boys_T_crit) {
+            // F_m(t) = sum_k F_{m+k}(t0) (t0 - t)^k / k!
+            int k = static_cast<int>(t * oodelta + 0.5);
+            double d = k * boys_delta - t;
+            const double* g = grid + (size_t)k * ncol + mmax;
+            fm = g[0] +
+                 d * (g[1] + d * (1.0 / 2.0) *
+                                 (g[2] + d * (1.0 / 3.0) *
+                                             (g[3] + d * (1.0 / 4.0) *
+                                                         (g[4] + d * (1.0 / 5.0) * (g[5] + d * (1.0 / 6.0) * g[6])))));
+        } else {
+            // F_m(t) = (2m-1)!! / (2t)^m * sqrt(pi / t) / 2, exp(-t) being negligible
+            fm = 0.5 * std::sqrt(M_PI / t);
+            for (int m = 0; m < mmax; ++m) fm *= (2 * m + 1) / (2.0 * t);
+        }
+        double emt = std::exp(-t);
+        F[i * stride + mmax] = fm;
+        for (int m = mmax - 1; m >= 0; --m) {
+            fm = (2.0 * t * fm + emt) / (2 * m + 1);
+            F[i * stride + m] = fm;
+        }
+    }
+}
+
 std::vector<std::array<int, 3>> generate_am_components_cca(int am) {
     std::vector<std::array<int, 3>> ret;
     for (int l = am; l > -1; --l) {
@@ -162,8 +236,6 @@ void fill_M_matrix(int maxam, int maxpow, const Point& PC, double a, double b, s
 
 void fill_R_matrix(int maxam, double p, const Point& P, const Point& C, std::vector<double>& R,
                    std::shared_ptr<const libint2::FmEval_Chebyshev7<double>> fm_eval) {
-    // Generates the auxiliary integrals for Coulomb-type integrals using eq 9.9.13
-    // from Molecular Electronic-Structure Theory (10.1002/9781119019572)
     auto PC = point_diff(P, C);
     auto RPC = point_norm(PC);
     double T = p * RPC * RPC;
@@ -173,6 +245,14 @@ void fill_R_matrix(int maxam, double p, const Point& P, const Point& C, std::vec
     // evaluate Boys function
     fm_eval->eval(fmvals.data(), T, maxam);
 
+    fill_R_matrix(maxam, p, P, C, R, fmvals.data());
+}
+
+void fill_R_matrix(int maxam, double p, const Point& P, const Point& C, std::vector<double>& R, const double* fmvals) {
+    // Generates the auxiliary integrals for Coulomb-type integrals using eq 9.9.13
+    // from Molecular Electronic-Structure Theory (10.1002/9781119019572)
+    auto PC = point_diff(P, C);
+
     int dim1 = maxam + 1;
     int dim2 = dim1 * dim1 * dim1;
     // R matrix buffer size needs to be at least dim1 * dim2,
@@ -49,6 +49,36 @@ void fill_M_matrix(int maxam, int maxpow, const Point& PC, double a, double b, s
                    std::vector<double>& My, std::vector<double>& Mz);
 void fill_R_matrix(int maxam, double p, const Point& P, const Point& C, std::vector<double>& R,
                    std::shared_ptr<const libint2::FmEval_Chebyshev7<double>> fm_eval);
+/// Same as above, with the Boys function values F_0(T)..F_maxam(T), T = p |P - C|^2, supplied by the caller
+void fill_R_matrix(int maxam, double p, const Point& P, const Point& C, std::vector<double>& R, const double* fmvals);
+
+/*! Boys function evaluator for arrays of arguments
+ *
+ *  F_mmax(T) comes from 6th-order Taylor interpolation on a tabulated grid (or the
+ *  asymptotic form for large T) and the lower orders from downward recursion. The
+ *  loops run over the arguments so the compiler vectorizes them for the target
+ *  instruction set (AVX2, AVX-512, NEON, ...).
+ */
+class BoysBatch {
+   public:
+    /// Shared evaluator covering orders up to at least mmax
+    static std::shared_ptr<const BoysBatch> instance(int mmax);
+
+    explicit BoysBatch(int mmax);
+
+    /// Highest order available
+    int max_m() const { return mmax_; }
+
+    /// F[i * (mmax + 1) + m] = F_m(T[i]) for 0 <= m <= mmax and 0 <= i < n
+    void eval(double* F, const double* T, size_t n, int mmax) const;
+
+   private:
+    int mmax_;
+    /// Number of orders tabulated per grid point (mmax_ + interpolation order + 1)
+    int ncol_;
+    /// F_m(k * delta) for all tabulated orders, row-major over the grid points k
+    std::vector<double> grid_;
+};
 
 std::vector<std::array<int, 3>> generate_am_components_cca(int am);
 
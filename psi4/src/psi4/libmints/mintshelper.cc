@@ -139,6 +139,43 @@ class PSI_API IWLWriter {
     size_t count() const { return count_; }
 };
 
+/**
+ * IWLBlockWriter functor for use with SO TEIs computed by several threads
+ **/
+class IWLBlockWriterFunctor {
+    IWLBlockWriter &writeto_;
+
+   public:
+    IWLBlockWriterFunctor(IWLBlockWriter &writeto) : writeto_(writeto) {}
+
+    void operator()(int i, int j, int k, int l, int, int, int, int, int, int, int, int, double value) {
+        int thread = 0;
+#ifdef _OPENMP
+        thread = omp_get_thread_num();
+#endif
+        writeto_.write_value(thread, i, j, k, l, value);
+    }
+};
+
+/**
+ * Computes all unique SO TEIs of ints into out, returns the number of integrals written.
+ * Several threads write through per-thread IWL blocks.
+ **/
+static size_t write_so_tei(TwoBodySOInt &ints, IWL &out, int nthread) {
+    if (nthread == 1) {
+        IWLWriter writer(out);
+        ints.compute_integrals(writer);
+        out.flush(1);
+        return writer.count();
+    }
+
+    IWLBlockWriter blockwriter(out, nthread);
+    IWLBlockWriterFunctor blockfunctor(blockwriter);
+    ints.compute_integrals(blockfunctor);
+    blockwriter.flush();
+    return blockwriter.count();
+}
+
 MintsHelper::MintsHelper(std::shared_ptr<BasisSet> basis, Options &options, int print)
     : options_(options), print_(print) {
     init_helper(basis);
@@ -298,20 +335,13 @@ void MintsHelper::integrals() {
 
     // Open the IWL buffer where we will store the integrals.
     IWL ERIOUT(psio_.get(), PSIF_SO_TEI, cutoff_, 0, 0);
-    IWLWriter writer(ERIOUT);
 
     // Let the user know what we're doing.
     if (print_) {
         outfile->Printf("      Computing two-electron integrals...");
     }
 
-    SOShellCombinationsIterator shellIter(sobasis_, sobasis_, sobasis_, sobasis_);
-    for (shellIter.first(); shellIter.is_done() == false; shellIter.next()) {
-        eri->compute_shell(shellIter, writer);
-    }
-
-    // Flush out buffers.
-    ERIOUT.flush(1);
+    size_t count = write_so_tei(*eri, ERIOUT, nthread_);
 
     // We just did all this work to create the file, let's keep it around
     ERIOUT.set_keep_flag(true);
@@ -322,7 +352,7 @@ void MintsHelper::integrals() {
         outfile->Printf(
             "      Computed %lu non-zero two-electron integrals.\n"
             "        Stored in file %d.\n\n",
-            writer.count(), PSIF_SO_TEI);
+            count, PSIF_SO_TEI);
     }
 }
 
@@ -330,7 +360,6 @@ void MintsHelper::integrals_erf(double w) {
     double omega = (w == -1.0 ? options_.get_double("OMEGA_ERF") : w);
 
     IWL ERIOUT(psio_.get(), PSIF_SO_ERF_TEI, cutoff_, 0, 0);
-    IWLWriter writer(ERIOUT);
 
     // Get ERI object
     std::vector<std::shared_ptr<TwoBodyAOInt>> tb(nthread_);
@@ -341,11 +370,7 @@ void MintsHelper::integrals_erf(double w) {
     // Let the user know what we're doing.
     outfile->Printf("      Computing non-zero ERF integrals (omega = %.3f)...", omega);
 
-    SOShellCombinationsIterator shellIter(sobasis_, sobasis_, sobasis_, sobasis_);
-    for (shellIter.first(); shellIter.is_done() == false; shellIter.next()) erf->compute_shell(shellIter, writer);
-
-    // Flush the buffers
-    ERIOUT.flush(1);
+    size_t count = write_so_tei(*erf, ERIOUT, nthread_);
 
     // Keep the integrals around
     ERIOUT.set_keep_flag(true);
@@ -355,14 +380,13 @@ void MintsHelper::integrals_erf(double w) {
     outfile->Printf(
         "      Computed %lu non-zero ERF integrals.\n"
         "        Stored in file %d.\n\n",
-        writer.count(), PSIF_SO_ERF_TEI);
+        count, PSIF_SO_ERF_TEI);
 }
 
 void MintsHelper::integrals_erfc(double w) {
     double omega = (w == -1.0 ? options_.get_double("OMEGA_ERF") : w);
 
     IWL ERIOUT(psio_.get(), PSIF_SO_ERFC_TEI, cutoff_, 0, 0);
-    IWLWriter writer(ERIOUT);
 
     // Get ERI object
     std::vector<std::shared_ptr<TwoBodyAOInt>> tb(nthread_);
@@ -374,11 +398,7 @@ void MintsHelper::integrals_erfc(double w) {
     // Let the user know what we're doing.
     outfile->Printf("      Computing non-zero ERFComplement integrals...");
 
-    SOShellCombinationsIterator shellIter(sobasis_, sobasis_, sobasis_, sobasis_);
-    for (shellIter.first(); shellIter.is_done() == false; shellIter.next()) erf->compute_shell(shellIter, writer);
-
-    // Flush the buffers
-    ERIOUT.flush(1);
+    size_t count = write_so_tei(*erf, ERIOUT, nthread_);
 
     // Keep the integrals around
     ERIOUT.set_keep_flag(true);
@@ -388,7 +408,7 @@ void MintsHelper::integrals_erfc(double w) {
     outfile->Printf(
         "      Computed %lu non-zero ERFComplement integrals.\n"
         "        Stored in file %d.\n\n",
-        writer.count(), PSIF_SO_ERFC_TEI);
+        count, PSIF_SO_ERFC_TEI);
 }
 
 void MintsHelper::one_electron_integrals() {
@@ -470,6 +490,61 @@ void MintsHelper::one_body_ao_computer(std::vector<std::shared_ptr<OneBodyAOInt>
     }
 }
 
+void MintsHelper::one_body_ao_computer(std::vector<std::shared_ptr<OneBodyAOInt>> ints,
+                                       std::vector<SharedMatrix> &out) {
+    // Grab basis info
+    std::shared_ptr<BasisSet> bs1 = ints[0]->basis1();
+    std::shared_ptr<BasisSet> bs2 = ints[0]->basis2();
+    const bool symm = (bs1 == bs2);
+    const double sign = ints[0]->is_antisymmetric() ? -1.0 : 1.0;
+
+    if (out.size() != (size_t)ints[0]->nchunk()) {
+        throw PSIEXCEPTION("MintsHelper::one_body_ao_computer: result length does not match the integral chunks.");
+    }
+
+    // Limit to the number of incoming onebody ints
+    size_t nthread = nthread_;
+    if (nthread > ints.size()) {
+        nthread = ints.size();
+    }
+
+    std::vector<double **> outp;
+    for (auto &mat : out) outp.push_back(mat->pointer());
+
+    const auto &shell_pairs = ints[0]->shellpairs();
+    size_t n_pairs = shell_pairs.size();
+
+    // Each unique shell pair owns its block and the transposed one, so threads never write the same element
+#pragma omp parallel for schedule(guided) num_threads(nthread)
+    for (size_t p = 0; p < n_pairs; ++p) {
+        size_t rank = 0;
+#ifdef _OPENMP
+        rank = omp_get_thread_num();
+#endif
+        auto P = shell_pairs[p].first;
+        auto Q = shell_pairs[p].second;
+        const size_t num_mu = bs1->shell(P).nfunction();
+        const size_t index_mu = bs1->shell(P).function_index();
+        const size_t num_nu = bs2->shell(Q).nfunction();
+        const size_t index_nu = bs2->shell(Q).function_index();
+
+        ints[rank]->compute_shell(P, Q);
+        const auto &buffers = ints[rank]->buffers();
+
+        for (size_t chunk = 0; chunk < out.size(); ++chunk) {
+            const double *ints_buff = buffers[chunk];
+            double **Op = outp[chunk];
+            for (size_t mu = index_mu; mu < (index_mu + num_mu); ++mu) {
+                for (size_t nu = index_nu; nu < (index_nu + num_nu); ++nu) {
+                    Op[mu][nu] += *ints_buff;
+                    if (symm && P != Q) Op[nu][mu] += sign * (*ints_buff);
+                    ints_buff++;
+                }
+            }
+        }
+    }
+}
+
 void MintsHelper::grad_two_center_computer(std::vector<std::shared_ptr<OneBodyAOInt>> ints, SharedMatrix D,
                                            SharedMatrix out) {
     // Grab basis info
@@ -1481,6 +1556,7 @@ void MintsHelper::compute_so_x2c_ints(bool include_perturbations) {
     }
 
     X2CInt x2cint;
+    x2cint.set_local_unitary(options_.get_bool("X2C_LOCAL_UNITARY"));
     x2cint.compute(molecule_, basisset_, get_basisset("BASIS_RELATIVISTIC"), so_overlap_x2c, so_kinetic_x2c,
                    so_potential_x2c, lambda);
 
@@ -1558,8 +1634,11 @@ std::vector<SharedMatrix> MintsHelper::ao_angular_momentum() {
     angmom.push_back(std::make_shared<Matrix>("AO Ly", basisset_->nbf(), basisset_->nbf()));
     angmom.push_back(std::make_shared<Matrix>("AO Lz", basisset_->nbf(), basisset_->nbf()));
 
-    std::shared_ptr<OneBodyAOInt> ints(integral_->ao_angular_momentum());
-    ints->compute(angmom);
+    std::vector<std::shared_ptr<OneBodyAOInt>> ints_vec;
+    for (size_t i = 0; i < nthread_; i++) {
+        ints_vec.push_back(std::shared_ptr<OneBodyAOInt>(integral_->ao_angular_momentum()));
+    }
+    one_body_ao_computer(ints_vec, angmom);
 
     return angmom;
 }
@@ -1572,8 +1651,11 @@ std::vector<SharedMatrix> MintsHelper::ao_dipole() {
     dipole.push_back(std::make_shared<Matrix>("AO Muy", basisset_->nbf(), basisset_->nbf()));
     dipole.push_back(std::make_shared<Matrix>("AO Muz", basisset_->nbf(), basisset_->nbf()));
 
-    std::shared_ptr<OneBodyAOInt> ints(integral_->ao_dipole());
-    ints->compute(dipole);
+    std::vector<std::shared_ptr<OneBodyAOInt>> ints_vec;
+    for (size_t i = 0; i < nthread_; i++) {
+        ints_vec.push_back(std::shared_ptr<OneBodyAOInt>(integral_->ao_dipole()));
+    }
+    one_body_ao_computer(ints_vec, dipole);
 
     return dipole;
 }
@@ -1589,8 +1671,11 @@ std::vector<SharedMatrix> MintsHelper::ao_quadrupole() {
     quadrupole.push_back(std::make_shared<Matrix>("AO Quadrupole YZ", basisset_->nbf(), basisset_->nbf()));
     quadrupole.push_back(std::make_shared<Matrix>("AO Quadrupole ZZ", basisset_->nbf(), basisset_->nbf()));
 
-    std::shared_ptr<OneBodyAOInt> ints(integral_->ao_quadrupole());
-    ints->compute(quadrupole);
+    std::vector<std::shared_ptr<OneBodyAOInt>> ints_vec;
+    for (size_t i = 0; i < nthread_; i++) {
+        ints_vec.push_back(std::shared_ptr<OneBodyAOInt>(integral_->ao_quadrupole()));
+    }
+    one_body_ao_computer(ints_vec, quadrupole);
 
     return quadrupole;
 }
@@ -1606,8 +1691,11 @@ std::vector<SharedMatrix> MintsHelper::ao_traceless_quadrupole() {
     quadrupole.push_back(std::make_shared<Matrix>("AO Traceless Quadrupole YZ", basisset_->nbf(), basisset_->nbf()));
     quadrupole.push_back(std::make_shared<Matrix>("AO Traceless Quadrupole ZZ", basisset_->nbf(), basisset_->nbf()));
 
-    std::shared_ptr<OneBodyAOInt> ints(integral_->ao_traceless_quadrupole());
-    ints->compute(quadrupole);
+    std::vector<std::shared_ptr<OneBodyAOInt>> ints_vec;
+    for (size_t i = 0; i < nthread_; i++) {
+        ints_vec.push_back(std::shared_ptr<OneBodyAOInt>(integral_->ao_traceless_quadrupole()));
+    }
+    one_body_ao_computer(ints_vec, quadrupole);
 
     return quadrupole;
 }
@@ -1643,9 +1731,12 @@ std::vector<SharedMatrix> MintsHelper::ao_multipoles(int order, const std::vecto
             }
         }
     }
-    std::shared_ptr<OneBodyAOInt> multipole_int(integral_->ao_multipoles(order));
-    multipole_int->set_origin(v3origin);
-    multipole_int->compute(ret);
+    std::vector<std::shared_ptr<OneBodyAOInt>> ints_vec;
+    for (size_t i = 0; i < nthread_; i++) {
+        ints_vec.push_back(std::shared_ptr<OneBodyAOInt>(integral_->ao_multipoles(order)));
+        ints_vec.back()->set_origin(v3origin);
+    }
+    one_body_ao_computer(ints_vec, ret);
     return ret;
 }
 
@@ -1761,8 +1852,11 @@ std::vector<SharedMatrix> MintsHelper::ao_nabla() {
     nabla.push_back(std::make_shared<Matrix>("AO Py", basisset_->nbf(), basisset_->nbf()));
     nabla.push_back(std::make_shared<Matrix>("AO Pz", basisset_->nbf(), basisset_->nbf()));
 
-    std::shared_ptr<OneBodyAOInt> ints(integral_->ao_nabla());
-    ints->compute(nabla);
+    std::vector<std::shared_ptr<OneBodyAOInt>> ints_vec;
+    for (size_t i = 0; i < nthread_; i++) {
+        ints_vec.push_back(std::shared_ptr<OneBodyAOInt>(integral_->ao_nabla()));
+    }
+    one_body_ao_computer(ints_vec, nabla);
 
     return nabla;
 }
@@ -2228,21 +2322,32 @@ SharedMatrix MintsHelper::multipole_grad(SharedMatrix D, int order, const std::v
     int natom = molecule_->natom();
     int nmult = (order + 1) * (order + 2) * (order + 3) / 6 - 1;
     auto ret = std::make_shared<Matrix>("Multipole dervatives (pert*component, i.e. 3NxN_mult)", 3 * natom, nmult);
-    double **Pp = ret->pointer();
 
-    std::shared_ptr<OneBodyAOInt> Mint(integral_->ao_multipoles(order, 1));
+    // Per-thread integral objects and accumulators
     Vector3 v3origin(origin[0], origin[1], origin[2]);
-    Mint->set_origin(v3origin);
+    std::vector<std::shared_ptr<OneBodyAOInt>> Mints;
+    std::vector<SharedMatrix> rettemps;
+    for (size_t i = 0; i < nthread_; i++) {
+        Mints.push_back(std::shared_ptr<OneBodyAOInt>(integral_->ao_multipoles(order, 1)));
+        Mints.back()->set_origin(v3origin);
+        rettemps.push_back(ret->clone());
+    }
 
-    const auto &shell_pairs = Mint->shellpairs();
+    const auto &shell_pairs = Mints[0]->shellpairs();
     size_t n_pairs = shell_pairs.size();
 
+#pragma omp parallel for schedule(dynamic) num_threads(nthread_)
     for (size_t p = 0; p < n_pairs; ++p) {
+        size_t rank = 0;
+#ifdef _OPENMP
+        rank = omp_get_thread_num();
+#endif
         auto P = shell_pairs[p].first;
         auto Q = shell_pairs[p].second;
 
-        Mint->compute_shell_deriv1(P, Q);
-        const auto &buffers = Mint->buffers();
+        Mints[rank]->compute_shell_deriv1(P, Q);
+        const auto &buffers = Mints[rank]->buffers();
+        double **Pp = rettemps[rank]->pointer();
 
         const auto &shellP = basisset_->shell(P);
         const auto &shellQ = basisset_->shell(Q);
@@ -2275,6 +2380,10 @@ SharedMatrix MintsHelper::multipole_grad(SharedMatrix D, int order, const std::v
             }
         }
     }
+
+    for (const auto &temp : rettemps) {
+        ret->add(temp);
+    }
     return ret;
 }
 
@@ -2584,18 +2693,17 @@ void MintsHelper::play() {}
 std::vector<SharedMatrix> MintsHelper::ao_overlap_kinetic_deriv1_helper(const std::string &type, int atom) {
     std::array<std::string, 3> cartcomp{{"X", "Y", "Z"}};
 
-    std::shared_ptr<OneBodyAOInt> GInt;
-
-    if (type == "OVERLAP") {
-        std::shared_ptr<OneBodyAOInt> Int(integral_->ao_overlap(1));
-        GInt = Int;
-    } else {
-        std::shared_ptr<OneBodyAOInt> Int(integral_->ao_kinetic(1));
-        GInt = Int;
+    std::vector<std::shared_ptr<OneBodyAOInt>> GInts;
+    for (size_t i = 0; i < nthread_; i++) {
+        if (type == "OVERLAP") {
+            GInts.push_back(std::shared_ptr<OneBodyAOInt>(integral_->ao_overlap(1)));
+        } else {
+            GInts.push_back(std::shared_ptr<OneBodyAOInt>(integral_->ao_kinetic(1)));
+        }
     }
 
-    std::shared_ptr<BasisSet> bs1 = GInt->basis1();
-    std::shared_ptr<BasisSet> bs2 = GInt->basis2();
+    std::shared_ptr<BasisSet> bs1 = GInts[0]->basis1();
+    std::shared_ptr<BasisSet> bs2 = GInts[0]->basis2();
 
     int nbf1 = bs1->nbf();
     int nbf2 = bs2->nbf();
@@ -2607,11 +2715,16 @@ std::vector<SharedMatrix> MintsHelper::ao_overlap_kinetic_deriv1_helper(const st
         grad.push_back(std::make_shared<Matrix>(sstream.str(), nbf1, nbf2));
     }
 
-    const auto &shell_pairs = GInt->shellpairs();
+    const auto &shell_pairs = GInts[0]->shellpairs();
     size_t n_pairs = shell_pairs.size();
 
-    // Loop it
+    // Loop it; each unique shell pair owns its block and the transposed one, so threads never collide
+#pragma omp parallel for schedule(dynamic) num_threads(nthread_)
     for (size_t p = 0; p < n_pairs; ++p) {
+        size_t rank = 0;
+#ifdef _OPENMP
+        rank = omp_get_thread_num();
+#endif
         auto P = shell_pairs[p].first;
         auto Q = shell_pairs[p].second;
         const auto &shellP = basisset_->shell(P);
@@ -2627,8 +2740,8 @@ std::vector<SharedMatrix> MintsHelper::ao_overlap_kinetic_deriv1_helper(const st
 
         if (aP != atom && aQ != atom) continue;
 
-        GInt->compute_shell_deriv1(P, Q);
-        const auto &buffers = GInt->buffers();
+        GInts[rank]->compute_shell_deriv1(P, Q);
+        const auto &buffers = GInts[rank]->buffers();
         double scale = P == Q ? 0.5 : 1.0;
 
         if (aP == atom) {
@@ -2690,9 +2803,12 @@ std::vector<SharedMatrix> MintsHelper::ao_overlap_kinetic_deriv1_helper(const st
 std::vector<SharedMatrix> MintsHelper::ao_potential_deriv1_helper(int atom) {
     std::array<std::string, 3> cartcomp{{"X", "Y", "Z"}};
 
-    std::shared_ptr<OneBodyAOInt> Vint(integral_->ao_potential(1));
-    std::shared_ptr<BasisSet> bs1 = Vint->basis1();
-    std::shared_ptr<BasisSet> bs2 = Vint->basis2();
+    std::vector<std::shared_ptr<OneBodyAOInt>> Vints;
+    for (size_t i = 0; i < nthread_; i++) {
+        Vints.push_back(std::shared_ptr<OneBodyAOInt>(integral_->ao_potential(1)));
+    }
+    std::shared_ptr<BasisSet> bs1 = Vints[0]->basis1();
+    std::shared_ptr<BasisSet> bs2 = Vints[0]->basis2();
 
     int nbf1 = bs1->nbf();
     int nbf2 = bs2->nbf();
@@ -2706,11 +2822,16 @@ std::vector<SharedMatrix> MintsHelper::ao_potential_deriv1_helper(int atom) {
         grad.push_back(std::make_shared<Matrix>(sstream.str(), nbf1, nbf2));
     }
 
-    const auto &shell_pairs = Vint->shellpairs();
+    const auto &shell_pairs = Vints[0]->shellpairs();
     size_t n_pairs = shell_pairs.size();
 
-    // Loop it
+    // Loop it; each unique shell pair owns its block and the transposed one, so threads never collide
+#pragma omp parallel for schedule(dynamic) num_threads(nthread_)
     for (size_t p = 0; p < n_pairs; ++p) {
+        size_t rank = 0;
+#ifdef _OPENMP
+        rank = omp_get_thread_num();
+#endif
         auto P = shell_pairs[p].first;
         auto Q = shell_pairs[p].second;
         const auto &shellP = bs1->shell(P);
@@ -2724,8 +2845,8 @@ std::vector<SharedMatrix> MintsHelper::ao_potential_deriv1_helper(int atom) {
         int oQ = shellQ.function_index();
         int aQ = shellQ.ncenter();
 
-        Vint->compute_shell_deriv1(P, Q);
-        const auto &buffers = Vint->buffers();
+        Vints[rank]->compute_shell_deriv1(P, Q);
+        const auto &buffers = Vints[rank]->buffers();
 
         double scale = P == Q ? 0.5 : 1.0;
 
@@ -100,6 +100,15 @@ class PSI_API MintsHelper {
      * @param[in] symm Use symmetry flag
      */
     void one_body_ao_computer(std::vector<std::shared_ptr<OneBodyAOInt>> ints, SharedMatrix out, bool symm);
+    /**
+     * Multi-component version of the above for operators such as dipoles and multipoles, with one matrix per
+     * chunk of the integral object. Like OneBodyAOInt::compute, it accumulates into out and fills the transposed
+     * block (with a sign flip for antisymmetric operators) when the two basis sets are the same.
+     *
+     * @param[in] ints Vector of OneBodyAOInt integrals, all set up identically (e.g. same origin)
+     * @param[out] out Matrices containing the operator components
+     */
+    void one_body_ao_computer(std::vector<std::shared_ptr<OneBodyAOInt>> ints, std::vector<SharedMatrix> &out);
     void grad_two_center_computer(std::vector<std::shared_ptr<OneBodyAOInt>> ints, SharedMatrix D, SharedMatrix out);
     /// Helper function to convert ao integrals to so and cache them
     void cache_ao_to_so_ints(SharedMatrix ao_ints, const std::string& label, bool include_perturbation);
@@ -385,6 +385,50 @@ int Molecule::atom_at_position3(const std::array<double, 3> &coord, const double
     return atom_at_position2(Vector3(coord), tol);
 }
 
+AtomPositionLookup::AtomPositionLookup(const Molecule &mol, double tol) : tol_(tol), width_(tol > 0.0 ? tol : 1.0) {
+    xyz_.reserve(mol.natom());
+    for (int i = 0; i < mol.natom(); ++i) {
+        xyz_.push_back(mol.xyz(i));
+        cells_[cell(xyz_.back())].push_back(i);
+    }
+}
+
+AtomPositionLookup::CellKey AtomPositionLookup::cell(const Vector3 &r) const {
+    // Cells as wide as the tolerance, any atom within tol of a point is in one of its 27 neighboring cells
+    return CellKey{(long)std::floor(r[0] / width_), (long)std::floor(r[1] / width_), (long)std::floor(r[2] / width_)};
+}
+
+int AtomPositionLookup::atom_at_position(const Vector3 &b) const {
+    const CellKey c = cell(b);
+    int num_near = 0;
+    int nearest = -1;
+    double nearest_dist = 0.0;
+    for (long dx = -1; dx <= 1; ++dx) {
+        for (long dy = -1; dy <= 1; ++dy) {
+            for (long dz = -1; dz <= 1; ++dz) {
+                auto it = cells_.find(CellKey{c.x + dx, c.y + dy, c.z + dz});
+                if (it == cells_.end()) continue;
+                for (int i : it->second) {
+                    double dist = b.distance(xyz_[i]);
+                    if (dist < tol_) {
+                        num_near++;
+                        if (nearest < 0 || dist < nearest_dist) {
+                            nearest = i;
+                            nearest_dist = dist;
+                        }
+                    }
+                }
+            }
+        }
+    }
+    if (num_near > 1) {
+        throw PSIEXCEPTION(
+            "More than one atom within tolerance distance! The geometry either has one or more atoms extremely close "
+            "to each other, or the tolerance distance has been set too large.");
+    }
+    return nearest;
+}
+
 Vector3 Molecule::nuclear_dipole() const {
     Vector3 origin(0.0, 0.0, 0.0);
     return nuclear_dipole(origin);
@@ -1449,9 +1493,10 @@ RotorType Molecule::rotor_type(double zero_tol) const {
 // Symmetry
 //
 bool Molecule::has_inversion(Vector3 &origin, double tol) const {
+    AtomPositionLookup lookup(*this, tol);
     for (int i = 0; i < natom(); ++i) {
         Vector3 inverted = origin - (xyz(i) - origin);
-        int atom = atom_at_position2(inverted, tol);
+        int atom = lookup.atom_at_position(inverted);
         if (atom < 0 || !atoms_[atom]->is_equivalent_to(atoms_[i])) {
             return false;
         }
@@ -1460,12 +1505,13 @@ bool Molecule::has_inversion(Vector3 &origin, double tol) const {
 }
 
 bool Molecule::is_plane(Vector3 &origin, Vector3 &uperp, double tol) const {
+    AtomPositionLookup lookup(*this, tol);
     for (int i = 0; i < natom(); ++i) {
         Vector3 A = xyz(i) - origin;
         Vector3 Apar = uperp.dot(A) * uperp;
         Vector3 Aperp = A - Apar;
         A = (Aperp - Apar) + origin;
-        int atom = atom_at_position2(A, tol);
+        int atom = lookup.atom_at_position(A);
         if (atom < 0 || !atoms_[atom]->is_equivalent_to(atoms_[i])) {
             return false;
         }
@@ -1474,13 +1520,14 @@ bool Molecule::is_plane(Vector3 &origin, Vector3 &uperp, double tol) const {
 }
 
 bool Molecule::is_axis(Vector3 &origin, Vector3 &axis, int order, double tol) const {
+    AtomPositionLookup lookup(*this, tol);
     for (int i = 0; i < natom(); ++i) {
         Vector3 A = xyz(i) - origin;
         for (int j = 1; j < order; ++j) {
             Vector3 R = A;
             R.rotate(j * 2.0 * M_PI / order, axis);
             R += origin;
-            int atom = atom_at_position2(R, tol);
+            int atom = lookup.atom_at_position(R);
             if (atom < 0 || !atoms_[atom]->is_equivalent_to(atoms_[i])) {
                 return false;
             }
@@ -1904,6 +1951,7 @@ std::shared_ptr<PointGroup> Molecule::find_highest_point_group(double tol) const
                         &SymmetryOperation::sigma_yz};
 
     SymmetryOperation symop;
+    AtomPositionLookup lookup(*this, tol);
 
     int matching_atom = -1;
     // Only needs to detect the 8 symmetry operations
@@ -1919,7 +1967,7 @@ std::shared_ptr<PointGroup> Molecule::find_highest_point_group(double tol) const
             Vector3 op(symop(0, 0), symop(1, 1), symop(2, 2));
             Vector3 pos = xyz(i) * op;
 
-            if ((matching_atom = atom_at_position2(pos, tol)) >= 0) {
+            if ((matching_atom = lookup.atom_at_position(pos)) >= 0) {
                 if (atoms_[i]->is_equivalent_to(atoms_[matching_atom]) == false) {
                     found = false;
                     break;
@@ -2032,9 +2080,10 @@ void Molecule::set_point_group(std::shared_ptr<PointGroup> pg) {
 }
 
 bool Molecule::has_symmetry_element(Vector3 &op, double tol) const {
+    AtomPositionLookup lookup(*this, tol);
     for (int i = 0; i < natom(); ++i) {
         Vector3 result = xyz(i) * op;
-        int atom = atom_at_position2(result, tol);
+        int atom = lookup.atom_at_position(result);
 
         if (atom != -1) {
             if (!atoms_[atom]->is_equivalent_to(atoms_[i])) return false;
@@ -2431,6 +2480,7 @@ bool Molecule::valid_atom_map(double tol) const {
     double np[3];
     SymmetryOperation so;
     CharacterTable ct = point_group()->char_table();
+    AtomPositionLookup lookup(*this, tol);
 
     // loop over all centers
     for (int i = 0; i < natom(); i++) {
@@ -2446,7 +2496,7 @@ bool Molecule::valid_atom_map(double tol) const {
                 for (int jj = 0; jj < 3; jj++) np[ii] += so(ii, jj) * ac[jj];
             }
 
-            if (atom_at_position1(np, tol) < 0) return false;
+            if (lookup.atom_at_position(Vector3(np)) < 0) return false;
         }
     }
     return true;
@@ -34,6 +34,7 @@
 #include <cstdio>
 #include <map>
 #include <memory>
+#include <unordered_map>
 
 #define LINEAR_A_TOL 1.0E-2  // When sin(a) is below this, we consider the angle to be linear
 #define DEFAULT_SYM_TOL 1.0E-8
@@ -687,6 +688,40 @@ class PSI_API Molecule {
     void update_geometry();
 };
 
+/*! \ingroup MINTS
+ *  \class AtomPositionLookup
+ *  \brief Spatial hash of the atom positions of a Molecule.
+ *
+ *  Answers the same question as Molecule::atom_at_position2, but only the atoms
+ *  in the cells around the query point are visited, so checking a symmetry
+ *  operation against every atom costs O(natom) instead of O(natom^2).
+ *  The lookup is a snapshot of the geometry at construction.
+ */
+class PSI_API AtomPositionLookup {
+    struct CellKey {
+        long x, y, z;
+        bool operator==(const CellKey& other) const { return x == other.x && y == other.y && z == other.z; }
+    };
+    struct CellKeyHash {
+        size_t operator()(const CellKey& k) const {
+            return (size_t)(k.x * 73856093L) ^ (size_t)(k.y * 19349663L) ^ (size_t)(k.z * 83492791L);
+        }
+    };
+
+    double tol_;
+    double width_;
+    std::vector<Vector3> xyz_;
+    std::unordered_map<CellKey, std::vector<int>, CellKeyHash> cells_;
+
+    CellKey cell(const Vector3& r) const;
+
+   public:
+    AtomPositionLookup(const Molecule& mol, double tol = 0.05);
+
+    /// Index of the atom within tol of b, or -1. Throws if more than one atom is that close.
+    int atom_at_position(const Vector3& b) const;
+};
+
 }  // namespace psi
 
 #endif
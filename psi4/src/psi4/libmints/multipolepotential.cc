@@ -31,7 +31,6 @@
 #include "psi4/libmints/integral.h"
 
 #include <libint2/shell.h>
-#include <libint2/boys.h>
 
 using namespace psi;
 using namespace mdintegrals;
@@ -54,7 +53,7 @@ MultipolePotentialInt::MultipolePotentialInt(std::vector<SphericalTransform>& sp
     R = std::vector<double>(rdim1 * rdim2);
 
     // set up Boys function evaluator
-    fm_eval_ = libint2::FmEval_Chebyshev7<double>::instance(am + order_);
+    boys_ = BoysBatch::instance(am + order_);
 
     comps_der_ = std::vector<std::vector<std::array<int, 3>>>(order_ + 1);
     for (int d = 0; d < order_ + 1; ++d) {
@@ -100,6 +99,20 @@ void MultipolePotentialInt::compute_pair(const libint2::Shell& s1, const libint2
     int edim2 = am2 + 1;
     int edim3 = am1 + am2 + 2;
 
+    // evaluate the Boys function for all primitive pairs at once
+    T_.resize(nprim1 * nprim2);
+    fmvals_.resize(nprim1 * nprim2 * rdim1);
+    for (int p1 = 0; p1 < nprim1; ++p1) {
+        double a = s1.alpha[p1];
+        for (int p2 = 0; p2 < nprim2; ++p2) {
+            double b = s2.alpha[p2];
+            double p = a + b;
+            Point PC{(a * A[0] + b * B[0]) / p - Cx, (a * A[1] + b * B[1]) / p - Cy, (a * A[2] + b * B[2]) / p - Cz};
+            T_[p1 * nprim2 + p2] = p * (PC[0] * PC[0] + PC[1] * PC[1] + PC[2] * PC[2]);
+        }
+    }
+    boys_->eval(fmvals_.data(), T_.data(), nprim1 * nprim2, r_am);
+
     int ao12 = 0;
     for (int p1 = 0; p1 < nprim1; ++p1) {
         double a = s1.alpha[p1];
@@ -113,7 +126,7 @@ void MultipolePotentialInt::compute_pair(const libint2::Shell& s1, const libint2
             double prefac = 2.0 * M_PI * ca * cb / p;
 
             fill_E_matrix(am1, am2, P, A, B, a, b, Ex, Ey, Ez);
-            fill_R_matrix(r_am, p, P, C, R, fm_eval_);
+            fill_R_matrix(r_am, p, P, C, R, &fmvals_[(p1 * nprim2 + p2) * rdim1]);
 
             int der_count = 0;
             double sign_prefac = prefac;
@@ -51,8 +51,12 @@ class MultipolePotentialInt : public OneBodyAOInt, public mdintegrals::MDHelper
     //! CCA-ordered Cartesian components for the multipoles
     std::vector<std::vector<std::array<int, 3>>> comps_der_;
 
-    //! Boys function evaluator from Libint2
-    std::shared_ptr<const libint2::FmEval_Chebyshev7<double>> fm_eval_;
+    //! Batched Boys function evaluator
+    std::shared_ptr<const mdintegrals::BoysBatch> boys_;
+
+    //! Boys function arguments and values for all primitive pairs of a shell pair
+    std::vector<double> T_;
+    std::vector<double> fmvals_;
 
     //! R matrix (9.5.31)
     std::vector<double> R;
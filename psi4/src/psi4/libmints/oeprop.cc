@@ -1044,42 +1044,30 @@ ESPPropCalc::~ESPPropCalc() {}
 void OEProp::compute_esp_over_grid() { epc_.compute_esp_over_grid(true); }
 
 void ESPPropCalc::compute_esp_over_grid(bool print_output) {
-    auto mol = basisset_->molecule();
-
-    std::shared_ptr<ElectrostaticInt> epot(dynamic_cast<ElectrostaticInt*>(integral_->electrostatic().release()));
-
     if (print_output) {
         outfile->Printf("\n Electrostatic potential to be computed on the grid and written to grid_esp.dat\n");
     }
-    SharedMatrix Dtot = wfn_->matrix_subset_helper(Da_so_, Ca_so_, "AO", "D");
-    if (same_dens_) {
-        Dtot->scale(2.0);
-    } else {
-        Dtot->add(wfn_->matrix_subset_helper(Db_so_, Cb_so_, "AO", "D beta"));
+
+    // Read the whole grid up front so the points can be evaluated in parallel
+    std::vector<Vector3> points;
+    GridIterator griditer("grid.dat");
+    for (griditer.first(); !griditer.last(); griditer.next()) {
+        points.push_back(griditer.gridpoints());
     }
 
-    int nbf = basisset_->nbf();
-    auto ints = std::make_shared<Matrix>("Ex integrals", nbf, nbf);
+    auto grid = std::make_shared<Matrix>("Grid", points.size(), 3);
+    for (size_t i = 0; i < points.size(); i++) {
+        for (int k = 0; k < 3; k++) grid->set(i, k, points[i][k]);
+    }
+
+    SharedVector esp = compute_esp_over_grid_in_memory(grid);
 
     Vvals_.clear();
     FILE* gridout = fopen("grid_esp.dat", "w");
     if (!gridout) throw PSIEXCEPTION("Unable to write to grid_esp.dat");
-    GridIterator griditer("grid.dat");
-    for (griditer.first(); !griditer.last(); griditer.next()) {
-        Vector3 origin(griditer.gridpoints());
-        if (mol->units() == Molecule::Angstrom) origin /= pc_bohr2angstroms;
-        ints->zero();
-        epot->compute(ints, origin);
-        double Velec = Dtot->vector_dot(ints);
-        double Vnuc = 0.0;
-        int natom = mol->natom();
-        for (int i = 0; i < natom; i++) {
-            Vector3 dR = origin - mol->xyz(i);
-            double r = dR.norm();
-            if (r > 1.0E-8) Vnuc += mol->Z(i) / r;
-        }
-        Vvals_.push_back(Velec + Vnuc);
-        fprintf(gridout, "%16.10f\n", Velec + Vnuc);
+    for (size_t i = 0; i < points.size(); i++) {
+        Vvals_.push_back(esp->get(i));
+        fprintf(gridout, "%16.10f\n", esp->get(i));
     }
     fclose(gridout);
 }
@@ -1778,20 +1766,35 @@ std::tuple<SharedMatrix, SharedMatrix, SharedMatrix, SharedMatrix> PopulationAna
     size_t total_points = grid->npoints();
 
     SharedMatrix Da = wfn_->Da_subset("AO");
-    SharedMatrix Db;
-    auto point_func = (std::shared_ptr<PointFunctions>)(std::make_shared<RKSFunctions>(basisset_, total_points, nbf));
+    SharedMatrix Db = same_dens_ ? Da : wfn_->Db_subset("AO");
 
-    if (same_dens_) {
-        Db = Da->clone();
-        point_func->set_pointers(Da);
-    } else {
-        Db = wfn_->Db_subset("AO");
-        point_func = (std::shared_ptr<PointFunctions>)(std::make_shared<UKSFunctions>(basisset_, total_points, nbf));
-        point_func->set_pointers(Da, Db);
+    std::vector<std::shared_ptr<BlockOPoints>> blocks = grid->blocks();
+
+    int nthreads = 1;
+#ifdef _OPENMP
+    nthreads = Process::environment.get_n_threads();
+#endif
+
+    // One points worker per thread, sized to the largest block rather than the whole grid
+    std::vector<std::shared_ptr<PointFunctions>> point_workers;
+    for (int thread = 0; thread < nthreads; thread++) {
+        if (same_dens_) {
+            auto point_func = std::make_shared<RKSFunctions>(basisset_, grid->max_points(), grid->max_functions());
+            point_func->set_pointers(Da);
+            point_workers.push_back(point_func);
+        } else {
+            auto point_func = std::make_shared<UKSFunctions>(basisset_, grid->max_points(), grid->max_functions());
+            point_func->set_pointers(Da, Db);
+            point_workers.push_back(point_func);
+        }
     }
 
-    std::vector<std::shared_ptr<BlockOPoints>> blocks = grid->blocks();
+    std::vector<size_t> block_offsets(blocks.size());
     size_t running_points = 0;
+    for (int b = 0; b < blocks.size(); b++) {
+        block_offsets[b] = running_points;
+        running_points += blocks[b]->npoints();
+    }
 
     // Coordinates, weights, and rho (molecular electron density) at each grid point
     std::vector<double> x_points(total_points, 0.0);
@@ -1800,19 +1803,20 @@ std::tuple<SharedMatrix, SharedMatrix, SharedMatrix, SharedMatrix> PopulationAna
     std::vector<double> weights(total_points, 0.0);
     std::vector<double> rho(total_points, 0.0);
 
+#pragma omp parallel for schedule(dynamic) num_threads(nthreads)
     for (int b = 0; b < blocks.size(); b++) {
+        int thread = 0;
+#ifdef _OPENMP
+        thread = omp_get_thread_num();
+#endif
         std::shared_ptr<BlockOPoints> block = blocks[b];
-        SharedVector rho_block;
+        std::shared_ptr<PointFunctions> point_func = point_workers[thread];
         size_t num_points = block->npoints();
+        size_t offset = block_offsets[b];
 
-        point_func->set_max_functions(block->local_nbf());
-        point_func->set_max_points(num_points);
         point_func->compute_points(block);
-        rho_block = point_func->point_values()["RHO_A"];
-
-        if (!same_dens_) {
-            rho_block->add(*point_func->point_values()["RHO_B"]);
-        }
+        double* rho_a = point_func->point_values()["RHO_A"]->pointer();
+        double* rho_b = (same_dens_ ? nullptr : point_func->point_values()["RHO_B"]->pointer());
 
         auto x = block->x();
         auto y = block->y();
@@ -1820,14 +1824,12 @@ std::tuple<SharedMatrix, SharedMatrix, SharedMatrix, SharedMatrix> PopulationAna
         auto w = block->w();
 
         for (size_t p = 0; p < num_points; p++) {
-            x_points[running_points + p] = x[p];
-            y_points[running_points + p] = y[p];
-            z_points[running_points + p] = z[p];
-            weights[running_points + p] = w[p];
-            rho[running_points + p] = rho_block->get(p);
+            x_points[offset + p] = x[p];
+            y_points[offset + p] = y[p];
+            z_points[offset + p] = z[p];
+            weights[offset + p] = w[p];
+            rho[offset + p] = rho_a[p] + (same_dens_ ? 0.0 : rho_b[p]);
         }
-
-        running_points += num_points;
     }
 
     // Electron count via numerical interagration
@@ -1954,21 +1956,31 @@ std::tuple<SharedMatrix, SharedMatrix, SharedMatrix, SharedMatrix> PopulationAna
     bool is_converged = false;
     double delta_rho_max_0;
 
+    std::vector<double> w_ratio(total_points, 0.0);
+
     if (print_output && debug >= 1) outfile->Printf("                     Delta D\n");
     while (iter < max_iter) {
-// Self-consistent update of population and density
+        // Quadrature weight times the stockholder ratio, shared by every atom and shell
 #pragma omp parallel for
+        for (size_t point = 0; point < total_points; point++) {
+            w_ratio[point] = weights[point] * rho[point] / rho_0_points[point];
+        }
+
+// Self-consistent update of population and density; threaded over grid points, since there
+// are far more of those than atoms and shells
         for (int atom = 0; atom < num_atoms; atom++) {
+            const double* dist_a = &distances[atom * total_points];
             for (int m = 0; m < mA[atom]; m++) {
+                const double N_am = Nai[atom][m];
+                const double S_am = Sai[atom][m];
                 double sum_n = 0.0;
                 double sum_s = 0.0;
 
-                for (int point = 0; point < total_points; point++) {
-                    double rho_ai_0_point =
-                        rho_ai_0(Nai[atom][m], Sai[atom][m], distances[atom * total_points + point]);
-                    sum_n += weights[point] * rho[point] * rho_ai_0_point / rho_0_points[point];
-                    sum_s += weights[point] * distances[atom * total_points + point] * rho[point] * rho_ai_0_point /
-                             rho_0_points[point];
+#pragma omp parallel for reduction(+ : sum_n, sum_s)
+                for (size_t point = 0; point < total_points; point++) {
+                    double val = w_ratio[point] * rho_ai_0(N_am, S_am, dist_a[point]);
+                    sum_n += val;
+                    sum_s += dist_a[point] * val;
                 }
 
                 Nai_next[atom][m] = sum_n;
@@ -1993,14 +2005,15 @@ std::tuple<SharedMatrix, SharedMatrix, SharedMatrix, SharedMatrix> PopulationAna
         // Convergence check (Equation 20 in Verstraelen et al.) and update of pro-densities
         std::vector<double> delta_rho_atoms_0(num_atoms, 0.0);
 
-#pragma omp parallel for
         for (int atom = 0; atom < num_atoms; atom++) {
-            double delta;
+            double sum = 0.0;
+#pragma omp parallel for reduction(+ : sum)
             for (size_t point = 0; point < total_points; point++) {
-                delta = rho_a_0_points_next[atom * total_points + point] - rho_a_0_points[atom * total_points + point];
-                delta_rho_atoms_0[atom] += weights[point] * delta * delta;
+                double delta =
+                    rho_a_0_points_next[atom * total_points + point] - rho_a_0_points[atom * total_points + point];
+                sum += weights[point] * delta * delta;
             }
-            delta_rho_atoms_0[atom] = sqrt(delta_rho_atoms_0[atom]);
+            delta_rho_atoms_0[atom] = sqrt(sum);
         }
 
         delta_rho_max_0 = 0.0;
@@ -2011,8 +2024,8 @@ std::tuple<SharedMatrix, SharedMatrix, SharedMatrix, SharedMatrix> PopulationAna
         // Update populations, widths, and densities
         Nai = Nai_next;
         Sai = Sai_next;
-        rho_0_points = rho_0_points_next;
-        rho_a_0_points = rho_a_0_points_next;
+        rho_0_points.swap(rho_0_points_next);
+        rho_a_0_points.swap(rho_a_0_points_next);
 
         if (print_output && debug >= 1) outfile->Printf("   @MBIS iter %3d:  %.3e\n", iter, delta_rho_max_0);
 
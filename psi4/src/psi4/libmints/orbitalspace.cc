@@ -45,6 +45,9 @@
 #include "psi4/libpsi4util/process.h"
 
 #include <tuple>
+#include <vector>
+#include <algorithm>
+#include <cmath>
 
 namespace psi {
 
@@ -168,31 +171,67 @@ OrbitalSpace orthogonalize(const std::string &id, const std::string &name, const
                            double lindep_tol) {
     outfile->Printf("    Orthogonalizing basis for space %s.\n", name.c_str());
 
+    // Canonical orthogonalization keeps only the eigenvectors above lindep_tol, so the
+    // linearly dependent combinations are dropped rather than carried as null columns
     SharedMatrix overlap = OrbitalSpace::overlap(bs, bs);
-    Dimension SODIM = overlap->rowspi();
-    auto evecs = std::make_shared<Matrix>("evecs", SODIM, SODIM);
-    auto sqrtm = std::make_shared<Matrix>("evecs", SODIM, SODIM);
-    auto evals = std::make_shared<Vector>("evals", SODIM);
-
-    int nlindep = 0;
-    overlap->diagonalize(evecs, evals);
-    for (int h = 0; h < SODIM.n(); h++) {
-        for (int i = 0; i < SODIM[h]; i++) {
-            if (std::fabs(evals->get(h, i)) > lindep_tol) {
-                sqrtm->set(h, i, i, 1.0 / sqrt(evals->get(h, i)));
-            } else {
-                sqrtm->set(h, i, i, 0.0);
-                nlindep++;
-            }
-        }
-    }
-
-    sqrtm->back_transform(evecs);
+    BasisSetOrthogonalization orthog(BasisSetOrthogonalization::Canonical, overlap, lindep_tol, 0.0);
+    SharedMatrix X = orthog.basis_to_orthog_basis();
 
-    outfile->Printf("    %d linear dependencies will be \'removed\'.\n", nlindep);
+    outfile->Printf("    %d linear dependencies will be \'removed\'.\n", orthog.nlindep());
 
     auto localfactory = std::make_shared<IntegralFactory>(bs);
-    return OrbitalSpace(id, name, sqrtm, bs, localfactory);
+    return OrbitalSpace(id, name, X, bs, localfactory);
+}
+
+/// Null space of the rows of M (nrow x ncol) from a full QR factorization of M^T. Returns false
+/// if M is numerically rank deficient, in which case the caller should fall back to an SVD.
+bool qr_null_space(const SharedMatrix &M, double lindep_tol, SharedMatrix &N) {
+    const Dimension &nrow = M->rowspi();
+    const Dimension &ncol = M->colspi();
+    Dimension nnull(ncol - nrow);
+    for (int h = 0; h < M->nirrep(); h++) {
+        if (nnull[h] < 0) return false;
+    }
+
+    N = std::make_shared<Matrix>("Null space", ncol, nnull);
+    for (int h = 0; h < M->nirrep(); h++) {
+        int m = nrow[h];
+        int n = ncol[h];
+        if (n == 0 || nnull[h] == 0) continue;
+
+        // Row-major M is column-major M^T; pad it out to a square n x n Q
+        std::vector<double> Q((size_t)n * n, 0.0);
+        if (m) C_DCOPY((size_t)m * n, M->pointer(h)[0], 1, Q.data(), 1);
+        std::vector<double> tau(std::max(m, 1));
+
+        if (m) {
+            double lwork_tmp;
+            C_DGEQRF(n, m, Q.data(), n, tau.data(), &lwork_tmp, -1);
+            std::vector<double> work((size_t)lwork_tmp);
+            int info = C_DGEQRF(n, m, Q.data(), n, tau.data(), work.data(), (int)lwork_tmp);
+            if (info != 0) throw PSIEXCEPTION("OrbitalSpace: QR factorization failed.");
+
+            // Columns of M^T are unit vectors projected onto space 2, so |R_ii| ~ 1 unless
+            // an orbital of space 1 lies (nearly) outside space 2
+            for (int k = 0; k < m; k++) {
+                if (std::fabs(Q[(size_t)k * n + k]) < lindep_tol) return false;
+            }
+        }
+
+        double lwork_tmp;
+        C_DORGQR(n, n, m, Q.data(), n, tau.data(), &lwork_tmp, -1);
+        std::vector<double> work((size_t)lwork_tmp);
+        int info = C_DORGQR(n, n, m, Q.data(), n, tau.data(), work.data(), (int)lwork_tmp);
+        if (info != 0) throw PSIEXCEPTION("OrbitalSpace: forming Q failed.");
+
+        // The trailing n - m columns of Q span the null space of M
+        double **Np = N->pointer(h);
+        for (int c = 0; c < nnull[h]; c++) {
+            const double *Qc = Q.data() + (size_t)(m + c) * n;
+            for (int i = 0; i < n; i++) Np[i][c] = Qc[i];
+        }
+    }
+    return true;
 }
 
 OrbitalSpace orthogonal_complement(const OrbitalSpace &space1, const OrbitalSpace &space2, const std::string &id,
@@ -213,6 +252,21 @@ OrbitalSpace orthogonal_complement(const OrbitalSpace &space1, const OrbitalSpac
     auto C12 = std::make_shared<Matrix>("C12", space1.C()->colspi(), space2.C()->colspi());
     C12->gemm(false, false, 1.0, O12, space2.C(), 0.0);
 
+    // The complement only needs the null space of C12, which a QR of C12^T gives at a fraction
+    // of the cost of the full SVD; the SVD is kept for spaces that are not nested
+    SharedMatrix V_N;
+    if (qr_null_space(C12, lindep_tol, V_N)) {
+        outfile->Printf("        Orbital space before projecting out: ");
+        space2.dim().print();
+        outfile->Printf("        Orbital space after projecting out:  ");
+        V_N->colspi().print();
+        outfile->Printf("\n");
+
+        auto newC = std::make_shared<Matrix>("Transformation matrix", space2.C()->rowspi(), V_N->colspi());
+        newC->gemm(false, false, 1.0, space2.C(), V_N, 0.0);
+        return OrbitalSpace(id, name, newC, space2.basisset(), space2.integral());
+    }
+
     // SVD of MO overlap matrix
     auto [U, S, Vt] = C12->svd_a_temps();
     C12->svd_a(U, S, Vt);
@@ -227,7 +281,7 @@ OrbitalSpace orthogonal_complement(const OrbitalSpace &space1, const OrbitalSpac
     Dimension dim_zero(space1.nirrep());
     Dimension Np(S->dimpi() - nlindep);
     auto V_Nt = Vt->get_block({Np, Vt->rowspi()},{dim_zero, Vt->colspi()});
-    auto V_N = V_Nt->transpose();
+    V_N = V_Nt->transpose();
 
     outfile->Printf("    %d linear dependencies will be \'removed\'.\n", nlindep[0]);
     outfile->Printf("        Orbital space before projecting out: ");
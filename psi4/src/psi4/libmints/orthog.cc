@@ -97,7 +97,7 @@ void BasisSetOrthogonalization::compute_overlap_eig() {
     eigvec_ = std::make_shared<Matrix>("U", normalized_overlap_->rowspi(), normalized_overlap_->colspi());
     // Eigenvalues
     eigval_ = std::make_shared<Vector>(normalized_overlap_->colspi());
-    normalized_overlap_->diagonalize(eigvec_, eigval_);
+    normalized_overlap_->diagonalize(eigvec_, eigval_, ascending, diag_dsyevd);
 
     // Find minimum eigenvalue
     bool min_S_initialized = false;
@@ -195,6 +195,7 @@ struct lin_comb {
 
     double np[3];
     SymmetryOperation so;
+    AtomPositionLookup lookup(mol, tol);
 
     // loop over all centers
     for (int i = 0; i < natom; i++) {
@@ -210,7 +211,7 @@ struct lin_comb {
                 for (int jj = 0; jj < 3; jj++) np[ii] += so(ii, jj) * ac[jj];
             }
 
-            atom_map[i][g] = mol.atom_at_position1(np, tol);
+            atom_map[i][g] = lookup.atom_at_position(Vector3(np));
             if (atom_map[i][g] < 0) {
                 outfile->Printf("\tERROR: Symmetry operation %d did not map atom %d to another atom:\n", g, i + 1);
                 if (!suppress_mol_print_in_exc) {
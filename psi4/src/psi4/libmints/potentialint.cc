@@ -88,6 +88,7 @@ void PCMPotentialInt::compute(PCMPotentialIntFunctor &functor) {
 template void PCMPotentialInt::compute(ContractOverChargesFunctor&);
 template void PCMPotentialInt::compute(PrintIntegralsFunctor&);
 template void PCMPotentialInt::compute(ContractOverDensityFunctor&);
+template void PCMPotentialInt::compute(StoreIntegralsFunctor&);
 
 PCMPotentialInt::~PCMPotentialInt() = default;
 
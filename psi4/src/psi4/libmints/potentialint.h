@@ -129,4 +129,22 @@ class ContractOverChargesFunctor {
     }
 };
 
+class StoreIntegralsFunctor {
+    /**
+     * A functor, to be used with PCMPotentialInt, that stores the lower triangle of the integrals for each
+     * center, so that later contractions with densities or charges reduce to matrix-vector products
+     */
+   protected:
+    /// Row pointers of the (ncenters x nbf(nbf+1)/2) integral store
+    double **pV_;
+
+   public:
+    void initialize(int num_threads) {}
+    void finalize(int num_threads) {}
+    StoreIntegralsFunctor(SharedMatrix V) : pV_(V->pointer()) {}
+    void operator()(int bf1, int bf2, int center, double integral, int thread) {
+        if (bf1 >= bf2) pV_[center][bf1 * (bf1 + 1L) / 2 + bf2] = integral;
+    }
+};
+
 }  // namespace psi
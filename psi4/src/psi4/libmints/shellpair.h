@@ -3,6 +3,11 @@
 
 // This should be included from libint2 itself eventually, but a workaround is to include it here
 #include <system_error>
+#include <algorithm>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
 #include "psi4/libmints/basisset.h"
 #include "libint2/shell.h"
 #include "libint2/engine.h"
@@ -12,6 +17,104 @@ namespace psi {
     typedef std::vector<std::pair<int, int>> ShellPairBlock;
     using ShellPairData = std::vector<std::shared_ptr<libint2::ShellPair>>;
 
+    /*! Primitive pair data of one basis set against its partner basis sets
+     *
+     * Owned by the first basis set of the pair (see BasisSet::shell_pair_cache()).
+     * Entries are built on first request and never modified afterwards, so the same
+     * libint2::ShellPair objects are handed to every engine, clone, and integral
+     * factory that works on the same basis set pair at the same precision.
+     */
+    class ShellPairCache {
+       public:
+        /// Returns the pair data for \p pairs of (shell in \p bs1, shell in \p bs2), building any that are missing
+        ShellPairData get(const BasisSet &bs1, const std::shared_ptr<BasisSet> &bs2,
+                          const std::vector<std::pair<int, int>> &pairs, double ln_precision) {
+            std::lock_guard<std::mutex> lock(mutex_);
+
+            // partners that went away cannot be asked for again, and their address may be reused
+            entries_.erase(std::remove_if(entries_.begin(), entries_.end(),
+                                          [](const Entry &e) { return e.partner.expired(); }),
+                           entries_.end());
+
+            Entry *entry = nullptr;
+            for (auto &e : entries_) {
+                if (e.partner.lock() == bs2 && e.ln_precision == ln_precision) entry = &e;
+            }
+            if (entry == nullptr) {
+                entries_.push_back({bs2, ln_precision, {}});
+                entry = &entries_.back();
+            }
+
+            ShellPairData ret(pairs.size());
+            for (size_t pair = 0; pair < pairs.size(); ++pair) {
+                auto s1 = pairs[pair].first;
+                auto s2 = pairs[pair].second;
+                auto &data = entry->pairs[s1 * (size_t)bs2->nshell() + s2];
+                if (!data) data = std::make_shared<libint2::ShellPair>(bs1.l2_shell(s1), bs2->l2_shell(s2), ln_precision);
+                ret[pair] = data;
+            }
+            return ret;
+        }
+
+       private:
+        struct Entry {
+            std::weak_ptr<BasisSet> partner;
+            double ln_precision;
+            std::unordered_map<size_t, std::shared_ptr<libint2::ShellPair>> pairs;
+        };
+        std::vector<Entry> entries_;
+        std::mutex mutex_;
+    };
+
+    /*! Screening data of one basis set against itself, for one operator and threshold
+     *
+     * Holds the (mn|mn) diagonal bounds and the significant pair lists that TwoBodyAOInt derives
+     * from them. Never modified once built.
+     */
+    struct SieveData {
+        int nshell;
+        int nbf;
+        double max_integral;
+        std::vector<double> function_pair_values;
+        std::vector<double> shell_pair_values;
+        std::vector<double> shell_pair_exchange_values;
+        std::vector<double> function_sqrt;
+        std::vector<std::pair<int, int>> function_pairs;
+        std::vector<std::pair<int, int>> shell_pairs;
+        std::vector<long int> function_pairs_reverse;
+        std::vector<long int> shell_pairs_reverse;
+        std::vector<std::vector<int>> shell_to_shell;
+        std::vector<std::vector<int>> function_to_function;
+    };
+
+    /*! Screening data of one basis set, keyed by operator, screening type, and threshold
+     *
+     * Owned by the basis set (see BasisSet::sieve_cache()) and replaced with the shells whenever the
+     * geometry changes, so every integral object, clone, and factory on the same basis set and operator
+     * shares one diagonal pass.
+     */
+    class SieveCache {
+       public:
+        /// Returns the data stored under \p key, calling \p build to make it on first request
+        std::shared_ptr<const SieveData> get(const std::string &key,
+                                             const std::function<std::shared_ptr<const SieveData>()> &build) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto &entry = entries_[key];
+            if (!entry) entry = build();
+            return entry;
+        }
+        /// Returns the data stored under \p key, or null if nothing has built it yet
+        std::shared_ptr<const SieveData> find(const std::string &key) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = entries_.find(key);
+            return (it == entries_.end() ? nullptr : it->second);
+        }
+
+       private:
+        std::unordered_map<std::string, std::shared_ptr<const SieveData>> entries_;
+        std::mutex mutex_;
+    };
+
     class ShellPair {
 
     public:
@@ -90,23 +193,10 @@ namespace psi {
         const auto max_engine_precision = std::numeric_limits<double>::epsilon() / 1e10;
 
         // compute shellpair data assuming that we are computing to default_epsilon
-        size_t npairs = blocks.size();
-        ShellPairData spdata(npairs);
-#pragma omp parallel
-        {
-            int thread_id = 0;
-#ifdef _OPENMP
-            thread_id = omp_get_thread_num();
-#endif
-            for (int pair = 0; pair < npairs; ++pair) {
-                if (pair % nthreads == thread_id) {
-                    auto s1 = blocks[pair][0].first;
-                    auto s2 = blocks[pair][0].second;
-                    spdata[pair] = std::make_shared<libint2::ShellPair>(bs1->l2_shell(s1), bs2->l2_shell(s2),
-                                                                        std::log(max_engine_precision));
-                }
-            }
-        }
+        std::vector<std::pair<int, int>> pairs;
+        pairs.reserve(blocks.size());
+        for (const auto& block : blocks) pairs.push_back(block[0]);
+        ShellPairData spdata = bs1->shell_pair_cache()->get(*bs1, bs2, pairs, std::log(max_engine_precision));
         return std::make_tuple(blocks, spdata);
     }
     };
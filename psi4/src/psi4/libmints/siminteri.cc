@@ -419,6 +419,71 @@ void SimintTwoElectronInt::compute_shell_blocks(int shellpair1, int shellpair2,
     }
 }
 
+size_t SimintTwoElectronInt::compute_shell_batch(const std::vector<std::array<int, 4>> &quartets, double *target) {
+    const auto nsh2 = original_bs2_->nshell();
+
+    size_t ncomputed = 0;
+    size_t start = 0;
+    while (start < quartets.size()) {
+        const auto &first = quartets[start];
+        const auto &shell1 = original_bs1_->shell(first[0]);
+        const auto &shell2 = original_bs2_->shell(first[1]);
+        const auto &shell3 = original_bs3_->shell(first[2]);
+        const auto &shell4 = original_bs4_->shell(first[3]);
+
+        // extend the run while the bra pair and the ket AM class stay the same
+        size_t stop = start + 1;
+        while (stop < quartets.size() && stop - start < batchsize_) {
+            const auto &next = quartets[stop];
+            if (next[0] != first[0] || next[1] != first[1]) break;
+            if (original_bs3_->shell(next[2]).am() != shell3.am() || original_bs4_->shell(next[3]).am() != shell4.am())
+                break;
+            stop++;
+        }
+        size_t nket = stop - start;
+
+        const int ncart1234 = shell1.ncartesian() * shell2.ncartesian() * shell3.ncartesian() * shell4.ncartesian();
+        const int n1234 = shell1.nfunction() * shell2.nfunction() * shell3.nfunction() * shell4.nfunction();
+        bool do_cart = n1234 == 1 || (shell1.is_cartesian() && shell2.is_cartesian() && shell3.is_cartesian() &&
+                                      shell4.is_cartesian());
+
+        std::vector<simint_shell> ket_shells;
+        ket_shells.reserve(2 * nket);
+        for (size_t q = start; q < stop; q++) {
+            ket_shells.push_back((*shells3_)[quartets[q][2]]);
+            ket_shells.push_back((*shells4_)[quartets[q][3]]);
+        }
+        simint_multi_shellpair Q;
+        simint_initialize_multi_shellpair(&Q);
+        simint_create_multi_shellpair2(nket, ket_shells.data(), &Q, SIMINT_SCREEN);
+        const simint_multi_shellpair *P = &(*single_spairs_bra_)[first[0] * nsh2 + first[1]];
+
+        // screened quartets are not written by simint, so start from zeros
+        target_ = target_full_;
+        source_ = source_full_;
+        double *raw = do_cart ? target_ : source_;
+        std::fill(raw, raw + nket * ncart1234, 0.0);
+        ncomputed += simint_compute_eri(P, &Q, SIMINT_SCREEN_TOL, sharedwork_, raw);
+        simint_free_multi_shellpair(&Q);
+
+        if (!do_cart) {
+            for (size_t q = start; q < stop; q++) {
+                pure_transform(quartets[q][0], quartets[q][1], quartets[q][2], quartets[q][3], 1, false);
+                source_ += ncart1234;
+                target_ += n1234;
+            }
+        }
+        std::copy(target_full_, target_full_ + nket * n1234, target);
+        target += nket * n1234;
+        start = stop;
+    }
+
+    target_ = target_full_;
+    source_ = source_full_;
+    buffers_[0] = target_full_;
+    return ncomputed;
+}
+
 void SimintTwoElectronInt::compute_shell_blocks_deriv1(int shellpair1, int shellpair2, int npair1, int npair2) {
     throw PSIEXCEPTION("Simint gradients are not implemented yet!");
 }
@@ -50,6 +50,9 @@ class SimintTwoElectronInt : public TwoBodyAOInt {
     void compute_shell_blocks(int shellpair1, int shellpair2, int npair1 = -1, int npair2 = -1) override;
     void compute_shell_blocks_deriv1(int shellpair1, int shellpair2, int npair1 = -1, int npair2 = -1) override;
 
+    /// Compute ERIs for a batch of quartets, vectorizing over runs of kets that share a bra pair and AM class
+    size_t compute_shell_batch(const std::vector<std::array<int, 4>>& quartets, double* target) override;
+
     size_t compute_shell_deriv1(int, int, int, int) override;
 
     size_t compute_shell_deriv2(int, int, int, int) override;
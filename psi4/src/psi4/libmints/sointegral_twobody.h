@@ -45,6 +45,8 @@
 #include "psi4/libqt/qt.h"
 #include "psi4/libpsi4util/process.h"
 
+#include <algorithm>
+#include <utility>
 #include <vector>
 
 //#define DebugPrint 1
@@ -164,7 +166,8 @@ class PSI_API TwoBodySOInt {
         }
     }
 
-    // Compute integrals in parallel
+    // Compute integrals in parallel, the unique (PQ| pairs are dealt out to the threads.
+    // With more than one thread the functor is called concurrently and must be thread safe.
     template <typename TwoBodySOIntFunctor>
     void compute_integrals(TwoBodySOIntFunctor &functor);
 
@@ -185,13 +188,14 @@ class PSI_API TwoBodySOInt {
     template <typename TwoBodySOIntFunctor>
     void compute_shell_deriv1(int, int, int, int, TwoBodySOIntFunctor &body);
 
-    // Compute integrals in parallel
+    // Compute integrals in parallel, the unique (PQ| pairs are dealt out to the threads.
+    // The functor loads the TPDM block of each pair and must keep it per thread.
     template <typename TwoBodySOIntFunctor>
     void compute_integrals_deriv1(TwoBodySOIntFunctor &functor);
 
     template <typename TwoBodySOIntFunctor>
     int compute_pq_pair_deriv1(const int &p, const int &q, const size_t &pair_number, const TwoBodySOIntFunctor &body) {
-        const_cast<TwoBodySOIntFunctor &>(body).load_tpdm(pair_number);
+        const_cast<TwoBodySOIntFunctor &>(body).load_tpdm(p, q, pair_number);
         auto shellIter = std::make_shared<SO_RS_Iterator>(p, q, b1_, b2_, b3_, b4_);
 
         compute_quartets_deriv1(shellIter, const_cast<TwoBodySOIntFunctor &>(body));
@@ -1092,9 +1096,25 @@ void TwoBodySOInt::compute_integrals(TwoBodySOIntFunctor &functor) {
             "change your COMMUNICATOR "
             "environment variable to MPI or LOCAL.\n");
     } else {
-        std::shared_ptr<SOShellCombinationsIterator> shellIter =
-            std::make_shared<SOShellCombinationsIterator>(b1_, b2_, b3_, b4_);
-        this->compute_quartets(shellIter, functor);
+        int nthread = std::min(nthread_, (int)tb_.size());
+        if (nthread == 1) {
+            std::shared_ptr<SOShellCombinationsIterator> shellIter =
+                std::make_shared<SOShellCombinationsIterator>(b1_, b2_, b3_, b4_);
+            this->compute_quartets(shellIter, functor);
+        } else {
+            // Same quartets as SOShellCombinationsIterator, grouped by (PQ| pair
+            std::vector<std::pair<int, int>> PQ_pairs;
+            SO_PQ_Iterator PQIter(b1_);
+            for (PQIter.first(); PQIter.is_done() == false; PQIter.next()) PQ_pairs.emplace_back(PQIter.p(), PQIter.q());
+
+#pragma omp parallel for schedule(dynamic) num_threads(nthread)
+            for (size_t PQ = 0; PQ < PQ_pairs.size(); ++PQ) {
+                SO_RS_Iterator RSIter(PQ_pairs[PQ].first, PQ_pairs[PQ].second, b1_, b2_, b3_, b4_);
+                for (RSIter.first(); RSIter.is_done() == false; RSIter.next()) {
+                    this->compute_shell(RSIter.p(), RSIter.q(), RSIter.r(), RSIter.s(), functor);
+                }
+            }
+        }
     }
 }
 
@@ -1107,11 +1127,15 @@ void TwoBodySOInt::compute_integrals_deriv1(TwoBodySOIntFunctor &functor) {
 
     if (comm_ == "MADNESS") {
     } else {
-        auto PQIter = std::make_shared<SO_PQ_Iterator>(b1_);
-        size_t pair_number = 0;
-        for (PQIter->first(); PQIter->is_done() == false; PQIter->next()) {
-            compute_pq_pair_deriv1<TwoBodySOIntFunctor>(PQIter->p(), PQIter->q(), pair_number, functor);
-            pair_number++;
+        // The pair number is the position of (PQ| in SO_PQ_Iterator order, which keys the TPDM blocks
+        std::vector<std::pair<int, int>> PQ_pairs;
+        SO_PQ_Iterator PQIter(b1_);
+        for (PQIter.first(); PQIter.is_done() == false; PQIter.next()) PQ_pairs.emplace_back(PQIter.p(), PQIter.q());
+
+        int nthread = std::min(nthread_, (int)tb_.size());
+#pragma omp parallel for schedule(dynamic) num_threads(nthread)
+        for (size_t PQ = 0; PQ < PQ_pairs.size(); ++PQ) {
+            compute_pq_pair_deriv1<TwoBodySOIntFunctor>(PQ_pairs[PQ].first, PQ_pairs[PQ].second, PQ, functor);
         }
     }
 }
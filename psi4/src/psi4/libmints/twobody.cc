@@ -27,12 +27,17 @@
  */
 
 #include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <limits>
+#include <sstream>
 #include <stdexcept>
 #include "psi4/libqt/qt.h"
 #include "psi4/libmints/twobody.h"
 #include "psi4/libmints/integral.h"
 #include "psi4/libmints/basisset.h"
 #include "psi4/libmints/molecule.h"
+#include "psi4/libmints/shellpair.h"
 #include "psi4/libpsi4util/process.h"
 
 #include "libint2/shell.h"
@@ -76,6 +81,8 @@ TwoBodyAOInt::TwoBodyAOInt(const IntegralFactory *intsfactory, int deriv)
         screening_type_ = ScreeningType::Schwarz;
     else if (screentype == "CSAM")
         screening_type_ = ScreeningType::CSAM;
+    else if (screentype == "QQR")
+        screening_type_ = ScreeningType::QQR;
     else if (screentype == "DENSITY")
         screening_type_ = ScreeningType::Density;
     else if (screentype == "NONE")
@@ -104,6 +111,8 @@ TwoBodyAOInt::TwoBodyAOInt(const TwoBodyAOInt &rhs) : TwoBodyAOInt(rhs.integral_
     max_dens_shell_pair_ = rhs.max_dens_shell_pair_;
     shell_pair_exchange_values_ = rhs.shell_pair_exchange_values_;
     function_sqrt_ = rhs.function_sqrt_;
+    shell_pair_centers_ = rhs.shell_pair_centers_;
+    shell_pair_extents_ = rhs.shell_pair_extents_;
     function_pairs_ = rhs.function_pairs_;
     shell_pairs_ = rhs.shell_pairs_;
     shell_pairs_bra_ = rhs.shell_pairs_bra_;
@@ -113,7 +122,10 @@ TwoBodyAOInt::TwoBodyAOInt(const TwoBodyAOInt &rhs) : TwoBodyAOInt(rhs.integral_
     shell_pairs_reverse_ = rhs.shell_pairs_reverse_;
     shell_to_shell_ = rhs.shell_to_shell_;
     function_to_function_ = rhs.function_to_function_;
+    shell_pairs_by_am_class_ = rhs.shell_pairs_by_am_class_;
+    shell_pair_am_class_starts_ = rhs.shell_pair_am_class_starts_;
     sieve_impl_ = rhs.sieve_impl_;
+    sieve_key_ = rhs.sieve_key_;
 }
 
 TwoBodyAOInt::~TwoBodyAOInt() {}
@@ -169,7 +181,7 @@ double TwoBodyAOInt::shell_pair_max_density(int M, int N) const {
 }
 
 // Haser 1989 Equations 6 to 14
-bool TwoBodyAOInt::shell_significant_density(int M, int N, int R, int S) {
+double TwoBodyAOInt::shell_quartet_max_density(int M, int N, int R, int S) const {
 
     // Maximum density matrix equation
     double max_density = 0.0;
@@ -193,6 +205,12 @@ bool TwoBodyAOInt::shell_significant_density(int M, int N, int R, int S) {
         max_density = std::max({2.0 * D_MN, 2.0 * D_RS, D_MR, D_MS, D_NR, D_NS});
     }
 
+    return max_density;
+}
+
+bool TwoBodyAOInt::shell_significant_density(int M, int N, int R, int S) {
+    double max_density = shell_quartet_max_density(M, N, R, S);
+
     // Square of Cauchy-Schwarz Q_MN terms (Eq. 13)
     double mn_mn = shell_pair_values_[N * nshell_ + M];
     double rs_rs = shell_pair_values_[S * nshell_ + R];
@@ -201,6 +219,27 @@ bool TwoBodyAOInt::shell_significant_density(int M, int N, int R, int S) {
     return (mn_mn * rs_rs * max_density * max_density >= screening_threshold_squared_);
 }
 
+// Maurer, Lambrecht, Flaig, Ochsenfeld, J. Chem. Phys. 136, 144107 (2012)
+bool TwoBodyAOInt::shell_significant_qqr(int M, int N, int R, int S) {
+    // Square of the Schwarz estimate Q_MN Q_RS
+    double mnrs_2 = shell_pair_values_[N * nshell_ + M] * shell_pair_values_[S * nshell_ + R];
+
+    // Once the two charge distributions no longer overlap, (MN|RS) decays as 1/R
+    const double *P = &shell_pair_centers_[3 * (M * nshell_ + N)];
+    const double *Q = &shell_pair_centers_[3 * (R * nshell_ + S)];
+    double PQ = std::sqrt((P[0] - Q[0]) * (P[0] - Q[0]) + (P[1] - Q[1]) * (P[1] - Q[1]) + (P[2] - Q[2]) * (P[2] - Q[2]));
+    double R_eff = PQ - shell_pair_extents_[M * nshell_ + N] - shell_pair_extents_[R * nshell_ + S];
+    if (R_eff > 1.0) mnrs_2 /= R_eff * R_eff;
+
+    // If a density (or a density difference, for incremental builds) was supplied, fold it in as in Haser 1989
+    if (!max_dens_shell_pair_.empty()) {
+        double max_density = shell_quartet_max_density(M, N, R, S);
+        mnrs_2 *= max_density * max_density;
+    }
+
+    return mnrs_2 >= screening_threshold_squared_;
+}
+
 bool TwoBodyAOInt::shell_significant_csam(int M, int N, int R, int S) { 
     // Square of standard Cauchy-Schwarz Q_mu_nu terms (Eq. 1)
     double mn_mn = shell_pair_values_[N * nshell_ + M];
@@ -247,6 +286,10 @@ void TwoBodyAOInt::setup_sieve() {
         case ScreeningType::Density:
             sieve_impl_ = [=](int M, int N, int R, int S) { return this->shell_significant_density(M, N, R, S); };
             break;
+        case ScreeningType::QQR:
+            // Pair centers are only meaningful for four-center integrals; others fall back to Schwarz below
+            sieve_impl_ = [=](int M, int N, int R, int S) { return this->shell_significant_qqr(M, N, R, S); };
+            break;
         case ScreeningType::None:   
             sieve_impl_ = [=](int M, int N, int R, int S) { return this->shell_significant_none(M, N, R, S); };
             return;
@@ -282,9 +325,175 @@ void TwoBodyAOInt::setup_sieve() {
                throw PSIEXCEPTION("If different basis sets exist in the ket, basis4 is expected to be dummy in setup_sieve()");
         for(int shell = 0; shell < basis3()->nshell(); ++shell) shell_pairs_ket_.emplace_back(shell,0);
     }
+
+    if (screening_type_ == ScreeningType::QQR) {
+        if (bra_same_ && braket_same_) {
+            create_qqr_pair_info(basis1());
+        } else {
+            sieve_impl_ = [=](int M, int N, int R, int S) { return this->shell_significant_schwarz(M, N, R, S); };
+        }
+    }
+
+    create_am_class_pairs(bra_same_ ? basis1() : basis3());
+}
+
+void TwoBodyAOInt::create_qqr_pair_info(const std::shared_ptr<BasisSet> bs) {
+    // A normalized s-type distribution exp(-zeta r^2) holds a fraction erfc(sqrt(zeta) r) of its charge outside
+    // radius r (to leading order), so solve erfc(x) = threshold once by bisection and scale by 1/sqrt(zeta)
+    double lo = 0.0, hi = 10.0;
+    for (int iter = 0; iter < 60; iter++) {
+        double mid = 0.5 * (lo + hi);
+        if (std::erfc(mid) > screening_threshold_)
+            lo = mid;
+        else
+            hi = mid;
+    }
+    const double erfc_inv = hi;
+
+    shell_pair_centers_.assign(3L * nshell_ * nshell_, 0.0);
+    shell_pair_extents_.assign((size_t)nshell_ * nshell_, 0.0);
+
+    for (int P = 0; P < nshell_; P++) {
+        const auto &sP = bs->shell(P);
+        const double *A = sP.center();
+        for (int Q = 0; Q <= P; Q++) {
+            const auto &sQ = bs->shell(Q);
+            const double *B = sQ.center();
+            double AB2 = (A[0] - B[0]) * (A[0] - B[0]) + (A[1] - B[1]) * (A[1] - B[1]) + (A[2] - B[2]) * (A[2] - B[2]);
+
+            // Center the pair on its most diffuse primitive product
+            double min_zeta = std::numeric_limits<double>::max();
+            double center[3] = {A[0], A[1], A[2]};
+            for (int i = 0; i < sP.nprimitive(); i++) {
+                for (int j = 0; j < sQ.nprimitive(); j++) {
+                    double a = sP.exp(i), b = sQ.exp(j), zeta = a + b;
+                    if (zeta < min_zeta) {
+                        min_zeta = zeta;
+                        for (int x = 0; x < 3; x++) center[x] = (a * A[x] + b * B[x]) / zeta;
+                    }
+                }
+            }
+
+            // The extent must enclose every product that survives its Gaussian overlap prefactor
+            double extent = erfc_inv / std::sqrt(min_zeta);
+            for (int i = 0; i < sP.nprimitive(); i++) {
+                for (int j = 0; j < sQ.nprimitive(); j++) {
+                    double a = sP.exp(i), b = sQ.exp(j), zeta = a + b;
+                    if (std::exp(-a * b / zeta * AB2) < screening_threshold_) continue;
+                    double d2 = 0.0;
+                    for (int x = 0; x < 3; x++) {
+                        double Px = (a * A[x] + b * B[x]) / zeta;
+                        d2 += (Px - center[x]) * (Px - center[x]);
+                    }
+                    extent = std::max(extent, std::sqrt(d2) + erfc_inv / std::sqrt(zeta));
+                }
+            }
+
+            for (int x = 0; x < 3; x++) {
+                shell_pair_centers_[3 * (P * nshell_ + Q) + x] = center[x];
+                shell_pair_centers_[3 * (Q * nshell_ + P) + x] = center[x];
+            }
+            shell_pair_extents_[P * nshell_ + Q] = shell_pair_extents_[Q * nshell_ + P] = extent;
+        }
+    }
+}
+
+void TwoBodyAOInt::create_am_class_pairs(const std::shared_ptr<BasisSet> bs) {
+    shell_pairs_by_am_class_ = shell_pairs_;
+    shell_pair_am_class_starts_.clear();
+    if (shell_pairs_.empty()) {
+        shell_pair_am_class_starts_.push_back(0);
+        return;
+    }
+
+    std::vector<double> diffuse_exp(bs->nshell());
+    for (int P = 0; P < bs->nshell(); P++) {
+        const auto &shell = bs->shell(P);
+        double min_exp = shell.exp(0);
+        for (int K = 1; K < shell.nprimitive(); K++) min_exp = std::min(min_exp, shell.exp(K));
+        diffuse_exp[P] = min_exp;
+    }
+
+    // Sort by (l_M, l_N), then by the exponent of the most diffuse primitive product; ties keep the
+    // shell index order of shell_pairs_
+    auto key = [&](const std::pair<int, int> &pair) {
+        return std::make_tuple(bs->shell(pair.first).am(), bs->shell(pair.second).am(),
+                               diffuse_exp[pair.first] + diffuse_exp[pair.second]);
+    };
+    std::stable_sort(shell_pairs_by_am_class_.begin(), shell_pairs_by_am_class_.end(),
+                     [&](const std::pair<int, int> &a, const std::pair<int, int> &b) { return key(a) < key(b); });
+
+    for (size_t i = 0; i < shell_pairs_by_am_class_.size(); i++) {
+        const auto &pair = shell_pairs_by_am_class_[i];
+        if (i == 0 || bs->shell(pair.first).am() != bs->shell(shell_pairs_by_am_class_[i - 1].first).am() ||
+            bs->shell(pair.second).am() != bs->shell(shell_pairs_by_am_class_[i - 1].second).am()) {
+            shell_pair_am_class_starts_.push_back(i);
+        }
+    }
+    shell_pair_am_class_starts_.push_back(shell_pairs_by_am_class_.size());
+}
+
+std::string TwoBodyAOInt::sieve_cache_key(const std::string &op, ScreeningType type, double threshold) {
+    std::stringstream key;
+    key << op << (type == ScreeningType::CSAM ? " CSAM " : " ") << std::setprecision(17) << threshold;
+    return key.str();
+}
+
+size_t TwoBodyAOInt::shared_function_pair_count(std::shared_ptr<BasisSet> bs, const std::string &sieve_key) {
+    // Only CSAM changes the sieve data, every other screening type (and a zero threshold) builds the Schwarz one
+    double threshold = Process::environment.options.get_double("INTS_TOLERANCE");
+    auto type = (Process::environment.options.get_str("SCREENING") == "CSAM" && threshold != 0.0)
+                    ? ScreeningType::CSAM
+                    : ScreeningType::Schwarz;
+    auto data = bs->sieve_cache()->find(sieve_cache_key(sieve_key, type, threshold));
+    return (data ? data->function_pairs.size() : 0);
 }
 
 void TwoBodyAOInt::create_sieve_pair_info(const std::shared_ptr<BasisSet> bs, PairList &shell_pairs, bool is_bra) {
+    if (sieve_key_.empty()) {
+        compute_sieve_pair_info(bs, shell_pairs, is_bra);
+        return;
+    }
+
+    // The diagonal pass depends only on the basis set, the operator, and the screening settings, so it is done
+    // once per basis set and shared by every integral object (and clone) that asks for the same key
+    auto key = sieve_cache_key(sieve_key_, screening_type_, screening_threshold_);
+    auto data = bs->sieve_cache()->get(key, [&]() {
+        compute_sieve_pair_info(bs, shell_pairs, is_bra);
+        auto built = std::make_shared<SieveData>();
+        built->nshell = nshell_;
+        built->nbf = nbf_;
+        built->max_integral = max_integral_;
+        built->function_pair_values = function_pair_values_;
+        built->shell_pair_values = shell_pair_values_;
+        built->shell_pair_exchange_values = shell_pair_exchange_values_;
+        built->function_sqrt = function_sqrt_;
+        built->function_pairs = function_pairs_;
+        built->shell_pairs = shell_pairs;
+        built->function_pairs_reverse = function_pairs_reverse_;
+        built->shell_pairs_reverse = shell_pairs_reverse_;
+        built->shell_to_shell = shell_to_shell_;
+        built->function_to_function = function_to_function_;
+        return std::shared_ptr<const SieveData>(built);
+    });
+
+    nshell_ = data->nshell;
+    nbf_ = data->nbf;
+    max_integral_ = data->max_integral;
+    screening_threshold_squared_ = screening_threshold_ * screening_threshold_;
+    function_pair_values_ = data->function_pair_values;
+    shell_pair_values_ = data->shell_pair_values;
+    shell_pair_exchange_values_ = data->shell_pair_exchange_values;
+    function_sqrt_ = data->function_sqrt;
+    function_pairs_ = data->function_pairs;
+    shell_pairs = data->shell_pairs;
+    function_pairs_reverse_ = data->function_pairs_reverse;
+    shell_pairs_reverse_ = data->shell_pairs_reverse;
+    shell_to_shell_ = data->shell_to_shell;
+    function_to_function_ = data->function_to_function;
+}
+
+void TwoBodyAOInt::compute_sieve_pair_info(const std::shared_ptr<BasisSet> bs, PairList &shell_pairs, bool is_bra) {
 
     nshell_ = bs->nshell();
     nbf_ = bs->nbf();
@@ -522,6 +731,24 @@ void TwoBodyAOInt::compute_shell_blocks(int shellpair12, int shellpair34, int np
     }
 }
 
+size_t TwoBodyAOInt::compute_shell_batch(const std::vector<std::array<int, 4>> &quartets, double *target) {
+    // Default implementation - compute each quartet and copy it out
+    size_t ncomputed = 0;
+    for (const auto &quartet : quartets) {
+        size_t n1234 = (size_t)original_bs1_->shell(quartet[0]).nfunction() *
+                       original_bs2_->shell(quartet[1]).nfunction() * original_bs3_->shell(quartet[2]).nfunction() *
+                       original_bs4_->shell(quartet[3]).nfunction();
+        if (compute_shell(quartet[0], quartet[1], quartet[2], quartet[3])) {
+            std::copy(buffer(), buffer() + n1234, target);
+            ncomputed++;
+        } else {
+            std::fill(target, target + n1234, 0.0);
+        }
+        target += n1234;
+    }
+    return ncomputed;
+}
+
 void TwoBodyAOInt::compute_shell_blocks_deriv1(int shellpair12, int shellpair34, int npair12, int npair34) {
     // Default implementation - go through the blocks and do each quartet
     // one at a time
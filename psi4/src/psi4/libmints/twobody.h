@@ -31,8 +31,10 @@
 
 #include "psi4/pragma.h"
 
+#include <array>
 #include <functional>
 #include <memory>
+#include <string>
 #include <tuple>
 #include <vector>
 
@@ -130,6 +132,10 @@ class PSI_API TwoBodyAOInt {
     std::vector<double> shell_pair_exchange_values_;
     /// sqrt|(mm|mm)| values (nshell)
     std::vector<double> function_sqrt_;
+    /// Centers of the most diffuse charge distribution of each shell pair (3 * nshell * nshell), for QQR
+    std::vector<double> shell_pair_centers_;
+    /// Radii beyond which each shell pair charge distribution is negligible (nshell * nshell), for QQR
+    std::vector<double> shell_pair_extents_;
     /// Max density per matrix (Outer loop over density matrices, inner loop over shell pairs)
     std::vector<std::vector<double>> max_dens_shell_pair_;
     /// Significant unique function pairs, in row-major, lower triangular indexing
@@ -146,10 +152,28 @@ class PSI_API TwoBodyAOInt {
     std::vector<std::vector<int>> shell_to_shell_;
     /// Significant shell pairs, indexes by shell
     std::vector<std::vector<int>> function_to_function_;
+    /// shell_pairs_, reordered by angular momentum class and exponent
+    PairList shell_pairs_by_am_class_;
+    /// Start of each angular momentum class in shell_pairs_by_am_class_, plus the list size
+    std::vector<size_t> shell_pair_am_class_starts_;
     std::function<bool(int, int, int, int)> sieve_impl_;
+    /// Identifies the operator whose (mn|mn) values build the sieve, so the screening data can be shared
+    /// through BasisSet::sieve_cache(); empty (the default) computes it privately for this object
+    std::string sieve_key_;
+
+    /// Key of the sieve data of operator op in BasisSet::sieve_cache()
+    static std::string sieve_cache_key(const std::string& op, ScreeningType type, double threshold);
 
     void setup_sieve();
     void create_sieve_pair_info(const std::shared_ptr<BasisSet> bs, PairList &shell_pairs, bool is_bra);
+    /// Computes the sieve data of bs into this object, the work behind create_sieve_pair_info
+    void compute_sieve_pair_info(const std::shared_ptr<BasisSet> bs, PairList &shell_pairs, bool is_bra);
+    /// Builds shell_pairs_by_am_class_ from shell_pairs_
+    void create_am_class_pairs(const std::shared_ptr<BasisSet> bs);
+    /// Builds the shell pair centers and extents needed by QQR screening
+    void create_qqr_pair_info(const std::shared_ptr<BasisSet> bs);
+    /// Largest density element that can multiply (MN|RS) in a J or K build (Haser 1989, Eq. 6)
+    double shell_quartet_max_density(int M, int N, int R, int S) const;
 
     /// Implements CSAM screening of a shell quartet
     bool shell_significant_csam(int M, int N, int R, int S);
@@ -157,6 +181,8 @@ class PSI_API TwoBodyAOInt {
     bool shell_significant_schwarz(int M, int N, int R, int S);
     /// Asks whether this shell quartet contributes by the density test (Haser 1989)
     bool shell_significant_density(int M, int N, int R, int S);
+    /// Implements distance-dependent QQR screening (Maurer 2012), times the density test if a density is set
+    bool shell_significant_qqr(int M, int N, int R, int S);
     /// Implements the null screening of a shell quartet - always true
     bool shell_significant_none(int M, int N, int R, int S);
 
@@ -241,8 +267,18 @@ class PSI_API TwoBodyAOInt {
 
     /// Significant unique function pair list, with only m>=n elements listed
     const std::vector<std::pair<int, int> >& function_pairs() const { return function_pairs_; }
+    /// Number of significant unique function pairs of bs for the operator sieve_key (e.g. "coulomb") under the
+    /// current INTS_TOLERANCE and SCREENING, if an integral object already shared its sieve through
+    /// BasisSet::sieve_cache(); 0 otherwise. Computes no integrals.
+    static size_t shared_function_pair_count(std::shared_ptr<BasisSet> bs, const std::string& sieve_key);
     /// Significant unique shell pair pair list, with only M>=N elements listed
     const std::vector<std::pair<int, int> >& shell_pairs() const { return shell_pairs_; }
+    /// The shell_pairs() list grouped by angular momentum class (l_M, l_N) and, within a class, ordered by
+    /// the most diffuse exponent of the pair, so that consecutive pairs share an integral kernel
+    const std::vector<std::pair<int, int> >& shell_pairs_by_am_class() const { return shell_pairs_by_am_class_; }
+    /// Offsets into shell_pairs_by_am_class() where each angular momentum class starts; the last element is
+    /// the total number of pairs
+    const std::vector<size_t>& shell_pair_am_class_starts() const { return shell_pair_am_class_starts_; }
     /// Unique function pair indexing, element m*(m+1)/2 + n (where m>=n) gives the dense index or
     /// -1 if the function pair does not contribute
     const std::vector<long int> function_pairs_to_dense() const { return function_pairs_reverse_; }
@@ -296,6 +332,17 @@ class PSI_API TwoBodyAOInt {
     /*! Compute derivative integrals for two blocks */
     virtual void compute_shell_blocks_deriv2(int shellpair12, int shellpair34, int npair12 = -1, int npair34 = -1);
 
+    /*! Compute integrals for a batch of shell quartets
+     *
+     * The integrals of the quartets (s1, s2, s3, s4) in \p quartets are
+     * written back to back to \p target, in the order given, so the caller
+     * must provide room for the sum of the quartet sizes.  Quartets that the
+     * engine screens out are zero-filled.  Engines batch most efficiently
+     * when consecutive quartets share the bra pair and the angular momentum
+     * class of the ket.  Returns the number of quartets with integrals.
+     */
+    virtual size_t compute_shell_batch(const std::vector<std::array<int, 4>> &quartets, double *target);
+
     /// Is the shell zero?
     virtual int shell_is_zero(int, int, int, int) { return 0; }
 
@@ -37,6 +37,7 @@
 #include "psi4/libpsi4util/exception.h"
 #include "psi4/libpsi4util/PsiOutStream.h"
 #include "psi4/libqt/qt.h"
+#include "blockpool.h"
 #include "dimension.h"
 
 namespace psi {
@@ -85,8 +86,8 @@ T get_block(const T& self, const Slice& slice) {
 template <class T>
 class IrreppedVector {
    protected:
-    /// Actual data, of size dimpi_.sum()
-    std::vector<T> v_;
+    /// Actual data, of size dimpi_.sum(), aligned and drawn from the BlockPool
+    std::vector<T, BlockAllocator<T>> v_;
     /// Pointer offsets into v_, of size dimpi_.n()
     std::vector<T*> vector_;
     /// Dimensions per irrep
@@ -273,8 +273,9 @@ void Wavefunction::deep_copy(const Wavefunction *other) {
     sobasisset_ = std::make_shared<SOBasisSet>(basisset_, integral_);
     factory_ = std::make_shared<MatrixFactory>();
     factory_->init_with(other->nsopi_, other->nsopi_);
-    AO2SO_ = other->AO2SO_->clone();
-    S_ = other->S_->clone();
+    // AO2SO and S depend only on the basis set, which is shared above, so they are shared too
+    AO2SO_ = other->AO2SO_;
+    S_ = other->S_;
 
     psio_ = other->psio_;  // We dont actually copy psio
     memory_ = other->memory_;
@@ -346,25 +347,12 @@ std::shared_ptr<Wavefunction> Wavefunction::c1_deep_copy(std::shared_ptr<BasisSe
         throw PSIEXCEPTION("Wavefunction::c1_deep_copy must copy an initialized wavefunction.");
     }
 
+    // The constructor already builds the integral factory, MintsHelper, SO basis, matrix factory, AO2SO,
+    // and overlap matrix for the C1 basis, so only the state of this wavefunction is carried over below
     auto wfn = std::make_shared<Wavefunction>(basis->molecule(), basis, options_);
 
-    /// From typical constructor
-    /// Some member data is not clone-able so we will copy
     wfn->name_ = name_;
     wfn->module_ = module_;
-    wfn->integral_ = std::make_shared<IntegralFactory>(wfn->basisset_, wfn->basisset_, wfn->basisset_, wfn->basisset_);
-    wfn->mintshelper_ = std::make_shared<MintsHelper>(wfn->basisset_, wfn->options_);
-    wfn->sobasisset_ = std::make_shared<SOBasisSet>(wfn->basisset_, wfn->integral_);
-    wfn->factory_ = std::make_shared<MatrixFactory>();
-
-    Dimension c1_nsopi = Dimension(1);
-    c1_nsopi[0] = nsopi_.sum();
-    wfn->factory_->init_with(c1_nsopi, c1_nsopi);
-
-    // Need to re-generate AO2SO_ because the new SO basis is different
-    // than the old one (lower symmetry)
-    auto pet = std::make_shared<PetiteList>(wfn->basisset_, wfn->integral_);
-    wfn->AO2SO_ = pet->aotoso();
 
     wfn->psio_ = psio_;  // We dont actually copy psio
     wfn->memory_ = memory_;
@@ -402,9 +390,6 @@ std::shared_ptr<Wavefunction> Wavefunction::c1_deep_copy(std::shared_ptr<BasisSe
     /// Need the SO2AO matrix for remove_symmetry(), have the AO2SO matrix
     SharedMatrix SO2AO = aotoso()->transpose();
 
-    wfn->S_ = wfn->factory_->create_shared_matrix("S");
-    wfn->S_->remove_symmetry(S_, SO2AO);
-
     /// Below is not set in the typical constructor
 
     wfn->H_ = wfn->factory_->create_shared_matrix("One-electron Hamiltonian");
@@ -1088,38 +1073,25 @@ SharedMatrix Wavefunction::basis_projection(SharedMatrix C_A, Dimension noccpi,
         int CholError = C_DPOTRF('L', nb, Sbb[0], nb);
         if (CholError != 0) throw std::domain_error("S_BB Matrix Cholesky failed!");
 
-        // Inversion (in place)
-        int IError = C_DPOTRI('L', nb, Sbb[0], nb);
-        if (IError != 0) throw std::domain_error("S_BB Inversion Failed!");
-
-        // LAPACK is smart and all, only uses half of the thing
-        for (int m = 0; m < nb; m++)
-            for (int n = 0; n < m; n++) Sbb[m][n] = Sbb[n][m];
-
-        // Form T
+        // Form S_AB^T C_A
         double **Temp1 = block_matrix(nb, nocc);
         C_DGEMM('T', 'N', nb, nocc, na, 1.0, Sab[0], nb, Ca[0], nc, 0.0, Temp1[0], nocc);
 
-        // outfile->Printf(" Temp1:\n");
-        // print_mat(Temp1,nb,nocc,"outfile");
-
+        // Temp2 = S_BB^-1 Temp1 by back substitution with the Cholesky factor rather than an
+        // explicit inverse; LAPACK wants the right-hand sides as contiguous columns
         double **Temp2 = block_matrix(nb, nocc);
-        C_DGEMM('N', 'N', nb, nocc, nb, 1.0, Sbb[0], nb, Temp1[0], nocc, 0.0, Temp2[0], nocc);
-
-        // outfile->Printf(" Temp2:\n");
-        // print_mat(Temp2,nb,nocc,outfile);
-
-        double **Temp3 = block_matrix(na, nocc);
-        C_DGEMM('N', 'N', na, nocc, nb, 1.0, Sab[0], nb, Temp2[0], nocc, 0.0, Temp3[0], nocc);
-
-        // outfile->Printf(" Temp3:\n");
-        // print_mat(Temp3,na,nocc,outfile);
+        double **Temp2t = block_matrix(nocc, nb);
+        for (int m = 0; m < nb; m++)
+            for (int i = 0; i < nocc; i++) Temp2t[i][m] = Temp1[m][i];
+        int SolveError = C_DPOTRS('L', nb, nocc, Sbb[0], nb, Temp2t[0], nb);
+        if (SolveError != 0) throw std::domain_error("S_BB Solve Failed!");
+        for (int m = 0; m < nb; m++)
+            for (int i = 0; i < nocc; i++) Temp2[m][i] = Temp2t[i][m];
+        free_block(Temp2t);
 
+        // T = C_A^T S_AB S_BB^-1 S_AB^T C_A = Temp1^T Temp2
         double **T = block_matrix(nocc, nocc);
-        C_DGEMM('T', 'N', nocc, nocc, na, 1.0, Ca[0], nc, Temp3[0], nocc, 0.0, T[0], nocc);
-
-        // outfile->Printf(" T:\n");
-        // print_mat(T,nocc,nocc,"outfile");
+        C_DGEMM('T', 'N', nocc, nocc, nb, 1.0, Temp1[0], nocc, Temp2[0], nocc, 0.0, T[0], nocc);
 
         // Find T^-1/2
         // First, diagonalize T
@@ -1162,7 +1134,6 @@ SharedMatrix Wavefunction::basis_projection(SharedMatrix C_A, Dimension noccpi,
 
         free_block(Temp1);
         free_block(Temp2);
-        free_block(Temp3);
         free_block(T);
         free_block(T_copy);
         free_block(T_mhalf);
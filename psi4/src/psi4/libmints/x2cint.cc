@@ -41,11 +41,86 @@
 #include "psi4/libmints/factory.h"
 #include "psi4/libmints/sobasis.h"
 #include "psi4/libmints/basisset.h"
+#include "psi4/libmints/molecule.h"
+#include "psi4/libmints/petitelist.h"
 #include "psi4/libpsi4util/PsiOutStream.h"
+#include "psi4/libpsi4util/process.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 namespace psi {
 
-X2CInt::X2CInt() {}
+namespace {
+
+/// Solve the modified Dirac equation in the C1 block spanned by S, T, V, and W, and return the
+/// decoupling matrix X and the renormalization R (the steps of form_dirac_h through form_R)
+void x2c_decouple_block(SharedMatrix S, SharedMatrix T, SharedMatrix V, SharedMatrix W, SharedMatrix X,
+                        SharedMatrix R) {
+    int n = S->rowdim(0);
+    double c2 = pc_c_au * pc_c_au;
+
+    auto D = std::make_shared<Matrix>("Dirac Hamiltonian", 2 * n, 2 * n);
+    auto SX = std::make_shared<Matrix>("SX Hamiltonian", 2 * n, 2 * n);
+    double** Dp = D->pointer();
+    double** SXp = SX->pointer();
+    double** Sp = S->pointer();
+    double** Tp = T->pointer();
+    double** Vp = V->pointer();
+    double** Wp = W->pointer();
+    for (int p = 0; p < n; ++p) {
+        for (int q = 0; q < n; ++q) {
+            SXp[p][q] = Sp[p][q];
+            SXp[p + n][q + n] = 0.5 * Tp[p][q] / c2;
+            Dp[p][q] = Vp[p][q];
+            Dp[p + n][q] = Tp[p][q];
+            Dp[p][q + n] = Tp[p][q];
+            Dp[p + n][q + n] = 0.25 * Wp[p][q] / c2 - Tp[p][q];
+        }
+    }
+
+    SX->power(-1.0 / 2.0);
+    D->transform(SX);
+    auto Dvec = std::make_shared<Matrix>("Dirac tmp Hamiltonian", 2 * n, 2 * n);
+    auto Dval = std::make_shared<Vector>("Dirac EigenValues", 2 * n);
+    D->diagonalize(Dvec, Dval);
+    auto C = std::make_shared<Matrix>("Dirac EigenVectors", 2 * n, 2 * n);
+    C->gemm(false, false, 1.0, SX, Dvec, 0.0);
+
+    // X = C_small (C_large)^{-1} over the positive energy states
+    auto CL = std::make_shared<Matrix>("Large EigenVectors", n, n);
+    auto CS = std::make_shared<Matrix>("Small EigenVectors", n, n);
+    double** Cp = C->pointer();
+    for (int p = 0; p < n; ++p) {
+        for (int q = 0; q < n; ++q) {
+            CL->set(p, q, Cp[p][q + n]);
+            CS->set(p, q, Cp[p + n][q + n]);
+        }
+    }
+    CL->general_invert();
+    X->gemm(false, false, 1.0, CS, CL, 0.0);
+
+    // R = S^{-1/2} (S^{-1/2} S_tilde S^{-1/2})^{-1/2} S^{1/2}, S_tilde = S + X^ T X / 2c**2
+    auto S_tilde = std::make_shared<Matrix>("S tilde matrix", n, n);
+    S_tilde->transform(X, T, X);
+    S_tilde->scale(1.0 / (2.0 * c2));
+    S_tilde->add(S);
+
+    auto S_inv_half = S->clone();
+    S_inv_half->power(-1.0 / 2.0);
+    auto sTmp1 = std::make_shared<Matrix>("S tmp1 matrix", n, n);
+    sTmp1->transform(S_tilde, S_inv_half);
+    sTmp1->power(-1.0 / 2.0);
+    auto sTmp2 = std::make_shared<Matrix>("S tmp2 matrix", n, n);
+    sTmp2->gemm(false, false, 1.0, S_inv_half, sTmp1, 0.0);
+    S_inv_half->general_invert();
+    R->gemm(false, false, 1.0, sTmp2, S_inv_half, 0.0);
+}
+
+}  // namespace
+
+X2CInt::X2CInt() : local_unitary_(false) {}
 
 X2CInt::~X2CInt() {}
 
@@ -57,17 +132,22 @@ void X2CInt::compute(std::shared_ptr<Molecule> molecule, std::shared_ptr<BasisSe
     lambda_ = lambda;
     setup(basis, x2c_basis);
     compute_integrals();
-    form_dirac_h();
-    diagonalize_dirac_h();
-    form_X();
-    form_R();
+    if (local_unitary_) {
+        form_X_R_local();
+    } else {
+        form_dirac_h();
+        diagonalize_dirac_h();
+        form_X();
+        form_R();
+    }
     form_h_FW_plus();
 
     if (do_project_) {
         project();
     }
 
-    test_h_FW_plus();
+    // The atom-local decoupling never solves the full Dirac equation, so there is nothing to compare against
+    if (!local_unitary_) test_h_FW_plus();
 
     S->copy(S_x2c_);
     T->copy(T_x2c_);
@@ -97,6 +177,9 @@ void X2CInt::setup(std::shared_ptr<BasisSet> basis, std::shared_ptr<BasisSet> x2
     outfile->Printf("\n    Computational Basis: %s", basis_.c_str());
     outfile->Printf("\n    X2C Basis: %s", x2c_basis_.c_str());
     outfile->Printf("\n    The X2C Hamiltonian will be computed in the X2C Basis\n");
+    if (local_unitary_) {
+        outfile->Printf("    Decoupling with atom-diagonal blocks (local unitary transformation, DLU-X2C)\n");
+    }
 
     // The integral factory oversees the creation of integral objects
     integral_ = std::make_shared<IntegralFactory>(aoBasis_, aoBasis_, aoBasis_, aoBasis_);
@@ -365,6 +448,90 @@ void X2CInt::form_R() {
 #endif
 }
 
+void X2CInt::form_X_R_local() {
+    /*
+     * DLU-X2C: X and R are taken block diagonal over atoms, each block decoupled from the atom-diagonal
+     * blocks of the molecular S, T, V, and W in the C1 AO basis. The full molecular matrices still enter
+     * the FW Hamiltonian in form_h_FW_plus, so only the 2N x 2N Dirac diagonalization is localized.
+     */
+    auto pet = std::make_shared<PetiteList>(aoBasis_, integral_);
+    SharedMatrix AO2SO = pet->aotoso();
+    SharedMatrix SO2AO = pet->sotoao();
+    int nao = aoBasis_->nbf();
+
+    // Back to the AO basis; any dipole perturbation is already folded into vMat
+    auto sAO = std::make_shared<Matrix>("AO Overlap", nao, nao);
+    auto tAO = std::make_shared<Matrix>("AO Kinetic", nao, nao);
+    auto vAO = std::make_shared<Matrix>("AO Potential", nao, nao);
+    auto wAO = std::make_shared<Matrix>("AO Relativistic Potential", nao, nao);
+    sAO->remove_symmetry(sMat, SO2AO);
+    tAO->remove_symmetry(tMat, SO2AO);
+    vAO->remove_symmetry(vMat, SO2AO);
+    wAO->remove_symmetry(wMat, SO2AO);
+
+    // Functions are ordered by center, so each atom owns a contiguous range
+    int natom = molecule_->natom();
+    std::vector<int> astart(natom + 1, 0);
+    for (int m = 0; m < nao; m++) {
+        astart[aoBasis_->function_to_center(m) + 1]++;
+    }
+    for (int A = 0; A < natom; A++) {
+        astart[A + 1] += astart[A];
+    }
+
+    auto xAO = std::make_shared<Matrix>("AO X matrix", nao, nao);
+    auto rAO = std::make_shared<Matrix>("AO R matrix", nao, nao);
+    double** xAOp = xAO->pointer();
+    double** rAOp = rAO->pointer();
+
+    int nthreads = 1;
+#ifdef _OPENMP
+    nthreads = Process::environment.get_n_threads();
+#endif
+
+#pragma omp parallel for schedule(dynamic) num_threads(nthreads)
+    for (int A = 0; A < natom; A++) {
+        int off = astart[A];
+        int n = astart[A + 1] - off;
+        if (n == 0) continue;
+
+        auto S = std::make_shared<Matrix>("S", n, n);
+        auto T = std::make_shared<Matrix>("T", n, n);
+        auto V = std::make_shared<Matrix>("V", n, n);
+        auto W = std::make_shared<Matrix>("W", n, n);
+        for (int p = 0; p < n; p++) {
+            for (int q = 0; q < n; q++) {
+                S->set(p, q, sAO->get(off + p, off + q));
+                T->set(p, q, tAO->get(off + p, off + q));
+                V->set(p, q, vAO->get(off + p, off + q));
+                W->set(p, q, wAO->get(off + p, off + q));
+            }
+        }
+
+        auto X = std::make_shared<Matrix>("X", n, n);
+        auto R = std::make_shared<Matrix>("R", n, n);
+        x2c_decouple_block(S, T, V, W, X, R);
+
+        double** Xp = X->pointer();
+        double** Rp = R->pointer();
+        for (int p = 0; p < n; p++) {
+            for (int q = 0; q < n; q++) {
+                xAOp[off + p][off + q] = Xp[p][q];
+                rAOp[off + p][off + q] = Rp[p][q];
+            }
+        }
+    }
+
+    // Symmetry-equivalent atoms see symmetry-equivalent blocks, so X and R are totally symmetric
+    xMat = SharedMatrix(soFactory_->create_matrix("X matrix"));
+    rMat = SharedMatrix(soFactory_->create_matrix("R matrix"));
+    xMat->apply_symmetry(xAO, AO2SO);
+    rMat->apply_symmetry(rAO, AO2SO);
+
+    xrMat = SharedMatrix(soFactory_->create_matrix("XR matrix"));
+    xrMat->gemm(false, false, 1.0, xMat, rMat, 0.0);  // XR = X R matrix
+}
+
 void X2CInt::form_h_FW_plus() {
     // Check if the matrices are allocated and have the correct size
     S_x2c_ = SharedMatrix(soFactory_->create_matrix(PSIF_SO_S));
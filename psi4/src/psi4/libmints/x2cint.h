@@ -63,6 +63,9 @@ class PSI_API X2CInt {
                  const std::vector<double> lambda);
     /*! @} */
 
+    /// Decouple with atom-diagonal blocks (DLU-X2C) instead of the full-molecule Dirac equation?
+    void set_local_unitary(bool local_unitary) { local_unitary_ = local_unitary; }
+
    private:
     /// The name of the basis set
     std::string basis_;
@@ -70,6 +73,8 @@ class PSI_API X2CInt {
     std::string x2c_basis_;
     /// Do basis set projection?
     bool do_project_;
+    /// Use the atom-local (DLU) decoupling?
+    bool local_unitary_;
 
     /// The molecule object
     std::shared_ptr<Molecule> molecule_;
@@ -137,6 +142,8 @@ class PSI_API X2CInt {
     void form_X();
     /// Form the matrices R and XR
     void form_R();
+    /// Form the matrices X, R, and XR from atom-diagonal blocks (DLU-X2C)
+    void form_X_R_local();
     /// Form the FW Hamiltonian for positive energy states
     void form_h_FW_plus();
     /// Write the FW Hamiltonian for positive energy states
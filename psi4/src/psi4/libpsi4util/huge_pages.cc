@@ -0,0 +1,70 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Psi4: an open-source quantum chemistry software package
+ *
+ * Copyright (c) 2007-2023 The Psi4 Developers.
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This file is part of Psi4.
+ *
+ * Psi4 is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * Psi4 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with Psi4; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * @END LICENSE
+ */
+
+#include "huge_pages.h"
+
+#include <atomic>
+#include <cstdint>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+namespace psi {
+
+namespace {
+
+std::atomic<size_t> threshold_bytes{0};
+
+// Size of a transparent huge page with 4 KB base pages (x86-64, aarch64)
+constexpr uintptr_t huge_page = 2 * 1024 * 1024;
+
+}  // namespace
+
+void set_huge_page_threshold(size_t bytes) { threshold_bytes.store(bytes, std::memory_order_relaxed); }
+
+size_t huge_page_threshold() { return threshold_bytes.load(std::memory_order_relaxed); }
+
+bool huge_pages_advise(void* ptr, size_t bytes) {
+    size_t threshold = huge_page_threshold();
+    if (!threshold || bytes < threshold) return false;
+
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+    // Only whole huge pages inside the buffer can be advised
+    uintptr_t begin = (reinterpret_cast<uintptr_t>(ptr) + huge_page - 1) & ~(huge_page - 1);
+    uintptr_t end = (reinterpret_cast<uintptr_t>(ptr) + bytes) & ~(huge_page - 1);
+    if (end <= begin) return false;
+
+    // Fails with EINVAL on kernels built without transparent huge pages, which leaves 4 KB pages
+    return !madvise(reinterpret_cast<void*>(begin), end - begin, MADV_HUGEPAGE);
+#else
+    return false;
+#endif
+}
+
+}  // namespace psi
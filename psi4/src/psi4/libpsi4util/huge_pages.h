@@ -0,0 +1,60 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Psi4: an open-source quantum chemistry software package
+ *
+ * Copyright (c) 2007-2023 The Psi4 Developers.
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This file is part of Psi4.
+ *
+ * Psi4 is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * Psi4 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with Psi4; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * @END LICENSE
+ */
+
+#ifndef _psi_src_lib_libpsi4util_huge_pages_h_
+#define _psi_src_lib_libpsi4util_huge_pages_h_
+
+#include <cstddef>
+
+#include "psi4/pragma.h"
+
+namespace psi {
+
+/*
+ * Transparent huge page policy for the large allocators.
+ *
+ * huge_pages_advise() is called on a freshly allocated buffer before it is first touched.
+ * If the buffer is at least the threshold in size, it asks the kernel to back the 2 MB
+ * aligned interior of the buffer with transparent huge pages (madvise(MADV_HUGEPAGE)).
+ * The memory still comes from, and goes back to, the usual allocator, so nothing changes
+ * for the caller. Without transparent huge pages (other platforms, or a kernel where they
+ * are "never") the advice does nothing.
+ *
+ * The threshold is process-wide and in bytes; 0, the default, disables the advice.
+ */
+
+// Set the smallest buffer that is backed with huge pages, 0 disables
+PSI_API void set_huge_page_threshold(size_t bytes);
+PSI_API size_t huge_page_threshold();
+
+// Advise the kernel to back [ptr, ptr + bytes) with huge pages, returns whether any range was advised
+PSI_API bool huge_pages_advise(void* ptr, size_t bytes);
+
+}  // namespace psi
+
+#endif
@@ -0,0 +1,137 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Psi4: an open-source quantum chemistry software package
+ *
+ * Copyright (c) 2007-2023 The Psi4 Developers.
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This file is part of Psi4.
+ *
+ * Psi4 is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * Psi4 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with Psi4; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * @END LICENSE
+ */
+
+#include "memory_governor.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "psi4/libpsi4util/PsiOutStream.h"
+#include "psi4/libpsi4util/process.h"
+
+namespace psi {
+
+MemoryGovernor& MemoryGovernor::instance() {
+    // Never destroyed: owners may release their reservations during static destruction
+    static MemoryGovernor* governor = new MemoryGovernor();
+    return *governor;
+}
+
+size_t MemoryGovernor::total() const { return Process::environment.get_memory(); }
+
+size_t MemoryGovernor::reserved_locked() const {
+    size_t sum = 0;
+    for (const auto& kv : reservations_) sum += kv.second.bytes;
+    return sum;
+}
+
+size_t MemoryGovernor::reserved() const {
+    std::lock_guard<std::recursive_mutex> guard(mutex_);
+    return reserved_locked();
+}
+
+size_t MemoryGovernor::reserved(const void* owner) const {
+    std::lock_guard<std::recursive_mutex> guard(mutex_);
+    auto it = reservations_.find(owner);
+    return (it == reservations_.end() ? 0 : it->second.bytes);
+}
+
+size_t MemoryGovernor::available() const {
+    std::lock_guard<std::recursive_mutex> guard(mutex_);
+    size_t used = reserved_locked();
+    size_t mem = total();
+    return (used < mem ? mem - used : 0);
+}
+
+size_t MemoryGovernor::shrink(size_t bytes, const void* except) {
+    std::lock_guard<std::recursive_mutex> guard(mutex_);
+
+    // Largest caches first, so that as few owners as possible lose their cache
+    std::vector<std::pair<size_t, const void*>> candidates;
+    for (const auto& kv : reservations_) {
+        if (kv.first != except && kv.second.shrinker && kv.second.bytes) {
+            candidates.emplace_back(kv.second.bytes, kv.first);
+        }
+    }
+    std::sort(candidates.begin(), candidates.end(), std::greater<std::pair<size_t, const void*>>());
+
+    size_t freed = 0;
+    for (const auto& candidate : candidates) {
+        if (freed >= bytes) break;
+        auto it = reservations_.find(candidate.second);
+        if (it == reservations_.end()) continue;
+        // Copy, the shrinker may release (and so erase) its own reservation
+        Shrinker shrinker = it->second.shrinker;
+        size_t released = std::min(shrinker(bytes - freed), candidate.first);
+        it = reservations_.find(candidate.second);
+        if (it != reservations_.end()) {
+            it->second.bytes -= std::min(released, it->second.bytes);
+        }
+        freed += released;
+    }
+    return freed;
+}
+
+size_t MemoryGovernor::reserve(const void* owner, const std::string& label, size_t bytes, Shrinker shrinker) {
+    std::lock_guard<std::recursive_mutex> guard(mutex_);
+    reservations_.erase(owner);
+
+    size_t used = reserved_locked();
+    size_t mem = total();
+    size_t free = (used < mem ? mem - used : 0);
+    if (bytes > free) {
+        shrink(bytes - free, owner);
+        used = reserved_locked();
+        free = (used < mem ? mem - used : 0);
+    }
+
+    size_t granted = std::min(bytes, free);
+    reservations_[owner] = Reservation{label, granted, std::move(shrinker)};
+    return granted;
+}
+
+void MemoryGovernor::release(const void* owner) {
+    std::lock_guard<std::recursive_mutex> guard(mutex_);
+    reservations_.erase(owner);
+}
+
+void MemoryGovernor::print(std::shared_ptr<PsiOutStream> printer) const {
+    std::lock_guard<std::recursive_mutex> guard(mutex_);
+    const double GiB = 1024.0 * 1024.0 * 1024.0;
+    printer->Printf("  ==> Memory Reservations <==\n\n");
+    printer->Printf("    %-40s %12s %10s\n", "Owner", "Size [GiB]", "Shrinkable");
+    for (const auto& kv : reservations_) {
+        printer->Printf("    %-40s %12.3f %10s\n", kv.second.label.c_str(), kv.second.bytes / GiB,
+                        (kv.second.shrinker ? "yes" : "no"));
+    }
+    printer->Printf("    %-40s %12.3f\n", "Reserved", reserved_locked() / GiB);
+    printer->Printf("    %-40s %12.3f\n\n", "Total", total() / GiB);
+}
+
+}  // namespace psi
@@ -0,0 +1,99 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Psi4: an open-source quantum chemistry software package
+ *
+ * Copyright (c) 2007-2023 The Psi4 Developers.
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This file is part of Psi4.
+ *
+ * Psi4 is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * Psi4 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with Psi4; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * @END LICENSE
+ */
+
+#ifndef _psi_src_lib_libpsi4util_memory_governor_h_
+#define _psi_src_lib_libpsi4util_memory_governor_h_
+
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "psi4/pragma.h"
+
+namespace psi {
+
+class PsiOutStream;
+
+/*
+ * Process-wide bookkeeping of the job memory (Process::environment.get_memory()).
+ *
+ * Modules that hold on to large buffers reserve them here under an owner pointer
+ * (usually `this`) and release them when the buffers go away. A reservation that
+ * only holds a cache may register a shrinker: when a later reservation does not fit,
+ * the governor asks the shrinkable reservations of other owners, largest first,
+ * to give memory back before granting what is left.
+ *
+ * The governor never allocates; it only tells the modules how much they may use.
+ * All amounts are in bytes.
+ */
+class PSI_API MemoryGovernor {
+   public:
+    // Called with the number of bytes wanted back, returns the number of bytes released
+    typedef std::function<size_t(size_t)> Shrinker;
+
+    static MemoryGovernor& instance();
+
+    // Reserve up to bytes for owner, replacing its previous reservation.
+    // Returns the granted amount, which is smaller than bytes if the job memory runs out.
+    size_t reserve(const void* owner, const std::string& label, size_t bytes, Shrinker shrinker = nullptr);
+    // Drop the reservation of owner, if any
+    void release(const void* owner);
+    // Ask the shrinkable reservations of owners other than except to free bytes, returns the bytes freed
+    size_t shrink(size_t bytes, const void* except = nullptr);
+
+    size_t total() const;
+    size_t reserved() const;
+    size_t reserved(const void* owner) const;
+    size_t available() const;
+
+    void print(std::shared_ptr<PsiOutStream> printer) const;
+
+   private:
+    struct Reservation {
+        std::string label;
+        size_t bytes;
+        Shrinker shrinker;
+    };
+
+    MemoryGovernor() = default;
+    MemoryGovernor(const MemoryGovernor&) = delete;
+    MemoryGovernor& operator=(const MemoryGovernor&) = delete;
+
+    size_t reserved_locked() const;
+
+    // Shrinkers may call back into release() or reserve()
+    mutable std::recursive_mutex mutex_;
+    std::map<const void*, Reservation> reservations_;
+};
+
+}  // namespace psi
+
+#endif  // _psi_src_lib_libpsi4util_memory_governor_h_
@@ -26,17 +26,23 @@
  * @END LICENSE
  */
 
+#include <algorithm>
+#include <cstddef>
 #include <map>
 #include <vector>
 #include <string>
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
 
 #include "psi4/liboptions/liboptions.h"
 #include "psi4/libciomr/libciomr.h"
 #include "psi4/psi4-dec.h"
+#include "huge_pages.h"
 #include "memory_manager.h"
+#include "memory_tracker.h"
 #include "psi4/libpsi4util/PsiOutStream.h"
+#include "psi4/libpsi4util/exception.h"
 namespace psi {
 
 double bytes_to_MiB(size_t n) {
@@ -44,7 +50,51 @@ double bytes_to_MiB(size_t n) {
     return (static_cast<double>(n) / static_cast<double>(1048576));
 }
 
-MemoryManager::MemoryManager(size_t maxcor) {
+MemoryArena::MemoryArena(size_t chunk_size) : chunk_size_(chunk_size), bytes_(0) {}
+
+MemoryArena::~MemoryArena() {
+    for (Chunk &chunk : chunks_) delete[] chunk.data;
+}
+
+void *MemoryArena::allocate(size_t n) {
+    // Keep every block aligned as operator new would
+    const size_t alignment = alignof(std::max_align_t);
+    n = (n + alignment - 1) / alignment * alignment;
+    if (chunks_.empty() || chunks_.back().size - chunks_.back().used < n) {
+        size_t size = std::max(chunk_size_, n);
+        chunks_.push_back({new char[size], size, 0});
+        huge_pages_advise(chunks_.back().data, size);
+    }
+    Chunk &chunk = chunks_.back();
+    void *mem = chunk.data + chunk.used;
+    chunk.used += n;
+    bytes_ += n;
+    std::memset(mem, 0, n);
+    return mem;
+}
+
+bool MemoryArena::owns(const void *p) const {
+    const char *c = static_cast<const char *>(p);
+    for (const Chunk &chunk : chunks_) {
+        if (c >= chunk.data && c < chunk.data + chunk.used) return true;
+    }
+    return false;
+}
+
+void MemoryArena::reset() {
+    if (chunks_.empty()) return;
+    auto largest = std::max_element(chunks_.begin(), chunks_.end(),
+                                    [](const Chunk &a, const Chunk &b) { return a.size < b.size; });
+    Chunk kept = *largest;
+    for (Chunk &chunk : chunks_) {
+        if (chunk.data != kept.data) delete[] chunk.data;
+    }
+    kept.used = 0;
+    chunks_.assign(1, kept);
+    bytes_ = 0;
+}
+
+MemoryManager::MemoryManager(size_t maxcor) : active_arenas_(0) {
     CurrentAllocated = 0;
     MaximumAllocated = 0;
     MaximumAllowed = maxcor;
@@ -52,10 +102,38 @@ MemoryManager::MemoryManager(size_t maxcor) {
 
 MemoryManager::~MemoryManager() {}
 
+void MemoryManager::push_arena() {
+    if (active_arenas_ == arenas_.size()) arenas_.push_back(std::make_unique<MemoryArena>());
+    active_arenas_++;
+}
+
+void MemoryManager::pop_arena() {
+    if (active_arenas_ == 0) throw PSIEXCEPTION("MemoryManager::pop_arena(): no arena is active");
+    MemoryArena *arena = active_arena();
+    CurrentAllocated -= arena->get_BytesAllocated();
+    memory_tracker_remove(arena->get_BytesAllocated());
+    arena->reset();
+    active_arenas_--;
+}
+
+bool MemoryManager::in_arena(const void *mem) const {
+    for (size_t n = 0; n < active_arenas_; ++n) {
+        if (arenas_[n]->owns(mem)) return true;
+    }
+    return false;
+}
+
+void MemoryManager::add_bytes(size_t size) {
+    size_t current = (CurrentAllocated += size);
+    memory_tracker_add(size);
+    size_t maximum = MaximumAllocated.load();
+    while (current > maximum && !MaximumAllocated.compare_exchange_weak(maximum, current)) {
+    }
+}
+
 void MemoryManager::RegisterMemory(void *mem, AllocationEntry &entry, size_t size) {
     AllocationTable[mem] = entry;
-    CurrentAllocated += size;
-    if (CurrentAllocated > MaximumAllocated) MaximumAllocated = CurrentAllocated;
+    add_bytes(size);
     //  if(options_get_int("DEBUG") > 1){
     //    outfile->Printf( "\n  ==============================================================================");
     //    outfile->Printf( "\n  MemoryManager Allocated   %12ld bytes (%8.1f Mb)",size,double(size)/1048576.0);
@@ -70,6 +148,7 @@ void MemoryManager::RegisterMemory(void *mem, AllocationEntry &entry, size_t siz
 
 void MemoryManager::UnregisterMemory(void *mem, size_t size, const char *fileName, size_t lineNumber) {
     CurrentAllocated -= size;
+    memory_tracker_remove(size);
     //  AllocationEntry& entry = AllocationTable[mem];
     //  if(options_get_int("DEBUG") > 1){
     //    outfile->Printf( "\n  ==============================================================================");
@@ -92,9 +171,9 @@ void MemoryManager::MemCheck(std::string out) {
     printer->Printf("\n\n");
     printer->Printf("  ==============================================================================\n");
     printer->Printf("  Memory Usage Report\n\n");
-    printer->Printf("  Maximum memory used: %8.1f Mb \n", double(MaximumAllocated) / 1048576.0);
+    printer->Printf("  Maximum memory used: %8.1f Mb \n", double(MaximumAllocated.load()) / 1048576.0);
     printer->Printf("  Number of objects still in memory: %-6lu  Current bytes used: %-14lu",
-                    (long unsigned)CurrentAllocated, (long unsigned)AllocationTable.size());
+                    (long unsigned)AllocationTable.size(), (long unsigned)CurrentAllocated.load());
 
     if (AllocationTable.size() > 0) {
         if (alreadyChecked == false)
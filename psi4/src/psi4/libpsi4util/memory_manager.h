@@ -29,9 +29,12 @@
 #ifndef _psi_src_bin_psimrccmemory_managerh_
 #define _psi_src_bin_psimrccmemory_managerh_
 
+#include <atomic>
 #include <map>
+#include <memory>
 #include <vector>
 #include <string>
+#include <type_traits>
 
 namespace psi {
 
@@ -59,6 +62,37 @@ typedef struct {
     std::vector<size_t> argumentList;
 } AllocationEntry;
 
+/*
+ * A bump allocator that serves all the allocations of one phase of a computation.
+ * Memory is handed out zeroed, is not tracked per object, and is returned in bulk by reset().
+ */
+class MemoryArena {
+   public:
+    MemoryArena(size_t chunk_size = 1048576);
+    ~MemoryArena();
+    MemoryArena(const MemoryArena &) = delete;
+    MemoryArena &operator=(const MemoryArena &) = delete;
+
+    // Return n zeroed bytes suitably aligned for any fundamental type
+    void *allocate(size_t n);
+    // Is p part of the memory handed out by this arena?
+    bool owns(const void *p) const;
+    // Release everything handed out, the largest chunk is kept for the next phase
+    void reset();
+
+    size_t get_BytesAllocated() const { return (bytes_); }
+
+   private:
+    struct Chunk {
+        char *data;
+        size_t size;
+        size_t used;
+    };
+    std::vector<Chunk> chunks_;
+    size_t chunk_size_;
+    size_t bytes_;
+};
+
 class MemoryManager {
    public:
     MemoryManager(size_t maxcor = 256000000);
@@ -66,6 +100,11 @@ class MemoryManager {
 
     void MemCheck(std::string output);
 
+    // Serve the following allocations from an arena instead of the allocation table
+    void push_arena();
+    // Release in bulk all the memory allocated since the matching push_arena()
+    void pop_arena();
+
     size_t get_FreeMemory() const { return (MaximumAllowed - CurrentAllocated); }
     size_t get_CurrentAllocated() const { return (CurrentAllocated); }
     size_t get_MaximumAllowedMemory() const { return (MaximumAllowed); }
@@ -92,12 +131,30 @@ class MemoryManager {
     void RegisterMemory(void *mem, AllocationEntry &entry, size_t size);
     void UnregisterMemory(void *mem, size_t size, const char *fileName, size_t lineNumber);
 
-    size_t CurrentAllocated;
-    size_t MaximumAllocated;
+    template <typename T>
+    T *arena_allocate(size_t size);
+    MemoryArena *active_arena() { return (active_arenas_ > 0 ? arenas_[active_arenas_ - 1].get() : nullptr); }
+    bool in_arena(const void *mem) const;
+    void add_bytes(size_t size);
+
+    std::atomic<size_t> CurrentAllocated;
+    std::atomic<size_t> MaximumAllocated;
     size_t MaximumAllowed;
     std::map<void *, AllocationEntry> AllocationTable;
+    // Arena stack, the arenas past active_arenas_ are kept around to be reused
+    std::vector<std::unique_ptr<MemoryArena>> arenas_;
+    size_t active_arenas_;
 };
 
+template <typename T>
+T *MemoryManager::arena_allocate(size_t size) {
+    MemoryArena *arena = active_arena();
+    size_t before = arena->get_BytesAllocated();
+    T *mem = static_cast<T *>(arena->allocate(size * sizeof(T)));
+    add_bytes(arena->get_BytesAllocated() - before);
+    return mem;
+}
+
 template <typename T>
 void MemoryManager::allocate(const char *type, T *&matrix, size_t size, const char *variableName, const char *fileName,
                              size_t lineNumber) {
@@ -105,6 +162,8 @@ void MemoryManager::allocate(const char *type, T *&matrix, size_t size, const ch
 
     if (size <= 0) {
         matrix = nullptr;
+    } else if (std::is_trivial<T>::value && active_arena() != nullptr) {
+        matrix = arena_allocate<T>(size);
     } else {
         matrix = new T[size];
         for (size_t i = 0; i < size; i++) matrix[i] = static_cast<T>(0);  // Zero all the elements
@@ -122,6 +181,10 @@ void MemoryManager::allocate(const char *type, T *&matrix, size_t size, const ch
 template <typename T>
 void MemoryManager::release_one(T *&matrix, const char *fileName, size_t lineNumber) {
     if (matrix == nullptr) return;
+    if (in_arena(matrix)) {
+        matrix = nullptr;
+        return;
+    }
 
     size_t size = AllocationTable[static_cast<void *>(matrix)].argumentList[0];
 
@@ -140,6 +203,10 @@ void MemoryManager::allocate(const char *type, T **&matrix, size_t size1, size_t
     if (size <= 0) {
         matrix = nullptr;
         return;
+    } else if (std::is_trivial<T>::value && active_arena() != nullptr) {
+        matrix = arena_allocate<T *>(size1);
+        auto *vector = arena_allocate<T>(size);
+        for (size_t i = 0; i < size1; i++) matrix[i] = &(vector[i * size2]);  // Assign the rows pointers
     } else {
         matrix = new T *[size1];
         auto *vector = new T[size];
@@ -160,6 +227,10 @@ void MemoryManager::allocate(const char *type, T **&matrix, size_t size1, size_t
 template <typename T>
 void MemoryManager::release_two(T **&matrix, const char *fileName, size_t lineNumber) {
     if (matrix == nullptr) return;
+    if (in_arena(matrix)) {
+        matrix = nullptr;
+        return;
+    }
 
     size_t size = AllocationTable[static_cast<void *>(matrix)].argumentList[0] *
                   AllocationTable[static_cast<void *>(matrix)].argumentList[1];
@@ -179,6 +250,15 @@ void MemoryManager::allocate(const char *type, T ***&matrix, size_t size1, size_
     if (size <= 0) {
         matrix = nullptr;
         return;
+    } else if (std::is_trivial<T>::value && active_arena() != nullptr) {
+        matrix = arena_allocate<T **>(size1);
+        auto **rows = arena_allocate<T *>(size1 * size2);
+        auto *vector = arena_allocate<T>(size);
+        for (size_t i = 0; i < size1; i++) {
+            matrix[i] = &(rows[i * size2]);
+            for (size_t j = 0; j < size2; j++)
+                matrix[i][j] = &(vector[i * size2 * size3 + j * size3]);  // Assign the rows pointers
+        }
     } else {
         matrix = new T **[size1];
         for (size_t i = 0; i < size1; i++) matrix[i] = new T *[size2];
@@ -202,6 +282,10 @@ void MemoryManager::allocate(const char *type, T ***&matrix, size_t size1, size_
 template <typename T>
 void MemoryManager::release_three(T ***&matrix, const char *fileName, size_t lineNumber) {
     if (matrix == nullptr) return;
+    if (in_arena(matrix)) {
+        matrix = nullptr;
+        return;
+    }
 
     size_t size1 = AllocationTable[static_cast<void *>(matrix)].argumentList[0];
     size_t size = AllocationTable[static_cast<void *>(matrix)].argumentList[0] *
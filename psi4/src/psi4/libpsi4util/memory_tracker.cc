@@ -0,0 +1,81 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Psi4: an open-source quantum chemistry software package
+ *
+ * Copyright (c) 2007-2023 The Psi4 Developers.
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This file is part of Psi4.
+ *
+ * Psi4 is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * Psi4 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with Psi4; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * @END LICENSE
+ */
+
+#include "memory_tracker.h"
+
+#include <atomic>
+
+namespace psi {
+
+namespace {
+
+std::atomic<size_t> current_bytes{0};
+std::atomic<size_t> peak_bytes{0};
+std::atomic<size_t> window_bytes{0};
+std::atomic<size_t> n_allocations{0};
+std::atomic<size_t> allocated_bytes{0};
+
+void raise_to(std::atomic<size_t>& maximum, size_t value) {
+    size_t old = maximum.load(std::memory_order_relaxed);
+    while (value > old && !maximum.compare_exchange_weak(old, value, std::memory_order_relaxed)) {
+    }
+}
+
+}  // namespace
+
+void memory_tracker_add(size_t bytes) {
+    size_t current = current_bytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+    n_allocations.fetch_add(1, std::memory_order_relaxed);
+    allocated_bytes.fetch_add(bytes, std::memory_order_relaxed);
+    raise_to(window_bytes, current);
+    raise_to(peak_bytes, current);
+}
+
+void memory_tracker_remove(size_t bytes) { current_bytes.fetch_sub(bytes, std::memory_order_relaxed); }
+
+size_t memory_tracker_current() { return current_bytes.load(std::memory_order_relaxed); }
+
+size_t memory_tracker_peak() { return peak_bytes.load(std::memory_order_relaxed); }
+
+size_t memory_tracker_allocations() { return n_allocations.load(std::memory_order_relaxed); }
+
+size_t memory_tracker_allocated() { return allocated_bytes.load(std::memory_order_relaxed); }
+
+size_t memory_tracker_take_window() {
+    size_t current = current_bytes.load(std::memory_order_relaxed);
+    size_t window = window_bytes.exchange(current, std::memory_order_relaxed);
+    return window > current ? window : current;
+}
+
+void TrackedBytes::reset(size_t bytes) {
+    if (bytes_) memory_tracker_remove(bytes_);
+    if (bytes) memory_tracker_add(bytes);
+    bytes_ = bytes;
+}
+
+}  // namespace psi
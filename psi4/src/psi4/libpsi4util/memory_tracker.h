@@ -0,0 +1,84 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Psi4: an open-source quantum chemistry software package
+ *
+ * Copyright (c) 2007-2023 The Psi4 Developers.
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This file is part of Psi4.
+ *
+ * Psi4 is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * Psi4 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with Psi4; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * @END LICENSE
+ */
+
+#ifndef _psi_src_lib_libpsi4util_memory_tracker_h_
+#define _psi_src_lib_libpsi4util_memory_tracker_h_
+
+#include <cstddef>
+
+#include "psi4/pragma.h"
+
+namespace psi {
+
+/*
+ * Process-wide count of the bytes held by the large allocators: the Matrix/Vector
+ * block pool, DPD blocks and MemoryManager allocations. Unlike the MemoryGovernor,
+ * which only knows what modules intend to use, these are the bytes actually live.
+ *
+ * The serial timers read the tracker whenever one is turned on or off, so every
+ * timer can report the high-water mark and the allocations made while it was on.
+ * The counters are lock-free atomics; all amounts are in bytes.
+ */
+
+// Record an allocation of bytes
+PSI_API void memory_tracker_add(size_t bytes);
+// Record that bytes were given back
+PSI_API void memory_tracker_remove(size_t bytes);
+
+// Bytes live right now
+PSI_API size_t memory_tracker_current();
+// Highest value of memory_tracker_current() since the start of the process
+PSI_API size_t memory_tracker_peak();
+// Number and total size of all allocations since the start of the process
+PSI_API size_t memory_tracker_allocations();
+PSI_API size_t memory_tracker_allocated();
+
+// Returns the highest value of memory_tracker_current() since the previous call
+// and starts a new window at the current value
+PSI_API size_t memory_tracker_take_window();
+
+// Accounts a buffer that is not allocated through one of the tracked allocators
+// for as long as the object lives, e.g. TrackedBytes scratch(n * sizeof(double));
+class PSI_API TrackedBytes {
+   public:
+    explicit TrackedBytes(size_t bytes = 0) { reset(bytes); }
+    ~TrackedBytes() { reset(0); }
+    TrackedBytes(const TrackedBytes&) = delete;
+    TrackedBytes& operator=(const TrackedBytes&) = delete;
+
+    // Replace the accounted size
+    void reset(size_t bytes);
+    size_t bytes() const { return bytes_; }
+
+   private:
+    size_t bytes_ = 0;
+};
+
+}  // namespace psi
+
+#endif
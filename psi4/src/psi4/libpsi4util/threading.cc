@@ -0,0 +1,71 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Psi4: an open-source quantum chemistry software package
+ *
+ * Copyright (c) 2007-2023 The Psi4 Developers.
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This file is part of Psi4.
+ *
+ * Psi4 is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * Psi4 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with Psi4; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * @END LICENSE
+ */
+
+#include "threading.h"
+
+#include "psi4/libpsi4util/process.h"
+
+#ifdef USING_LAPACK_MKL
+#include <mkl.h>
+#endif
+
+namespace psi {
+
+int num_threads() {
+    int nthread = Process::environment.get_n_threads();
+    return nthread > 0 ? nthread : 1;
+}
+
+int blas_get_num_threads() {
+#ifdef USING_LAPACK_MKL
+    return mkl_get_max_threads();
+#else
+    return num_threads();
+#endif
+}
+
+void blas_set_num_threads(int nthread) {
+#ifdef USING_LAPACK_MKL
+    mkl_set_num_threads(nthread);
+#endif
+}
+
+BlasThreadsGuard::BlasThreadsGuard(int nthread) : previous_(0) {
+#ifdef USING_LAPACK_MKL
+    // Returns the previous thread-local setting, 0 meaning "follow the global one"
+    previous_ = mkl_set_num_threads_local(nthread);
+#endif
+}
+
+BlasThreadsGuard::~BlasThreadsGuard() {
+#ifdef USING_LAPACK_MKL
+    mkl_set_num_threads_local(previous_);
+#endif
+}
+
+}  // namespace psi
@@ -0,0 +1,122 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Psi4: an open-source quantum chemistry software package
+ *
+ * Copyright (c) 2007-2023 The Psi4 Developers.
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This file is part of Psi4.
+ *
+ * Psi4 is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * Psi4 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with Psi4; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * @END LICENSE
+ */
+
+#ifndef _psi_src_lib_libpsi4util_threading_h_
+#define _psi_src_lib_libpsi4util_threading_h_
+
+#include <cstddef>
+#include <exception>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "psi4/pragma.h"
+
+namespace psi {
+
+/*
+ * Coordination of the OpenMP and BLAS thread counts.
+ *
+ * core.set_num_threads goes through Process::Environment::set_n_threads, which sets both
+ * the OpenMP and the BLAS pool to the job thread count. Code that spreads its own work
+ * over threads should keep BLAS single threaded inside that work, so that the job never
+ * runs more than nthread threads at once. BlasThreadsGuard does this for the calling
+ * thread only (mkl_set_num_threads_local), so other regions are not affected.
+ */
+
+// Number of threads the job runs with (core.set_num_threads)
+PSI_API int num_threads();
+
+// Number of threads BLAS calls from this thread may use
+PSI_API int blas_get_num_threads();
+
+// Sets the process-wide BLAS thread count; a no-op for libraries we cannot steer
+PSI_API void blas_set_num_threads(int nthread);
+
+// Limits BLAS calls from the calling thread to nthread threads until destruction
+class PSI_API BlasThreadsGuard {
+   public:
+    explicit BlasThreadsGuard(int nthread);
+    ~BlasThreadsGuard();
+
+    BlasThreadsGuard(const BlasThreadsGuard&) = delete;
+    BlasThreadsGuard& operator=(const BlasThreadsGuard&) = delete;
+
+   private:
+    int previous_;
+};
+
+/*
+ * Runs body(task, thread) for task = 0 .. ntask-1 on at most nthread threads
+ * (default: the job thread count), handing tasks out dynamically. BLAS is single
+ * threaded inside body. The first exception thrown by a task is rethrown on the
+ * calling thread once all threads have finished; remaining tasks are skipped.
+ */
+template <typename Body>
+void parallel_for(size_t ntask, Body&& body, int nthread = 0) {
+    if (nthread <= 0) nthread = num_threads();
+    if (static_cast<size_t>(nthread) > ntask) nthread = static_cast<int>(ntask);
+    if (nthread <= 1) {
+        for (size_t task = 0; task < ntask; task++) body(task, 0);
+        return;
+    }
+
+    std::exception_ptr error;
+    bool failed = false;
+#pragma omp parallel num_threads(nthread)
+    {
+        BlasThreadsGuard guard(1);
+        int thread = 0;
+#ifdef _OPENMP
+        thread = omp_get_thread_num();
+#endif
+#pragma omp for schedule(dynamic)
+        for (long int task = 0; task < static_cast<long int>(ntask); task++) {
+            bool skip;
+#pragma omp atomic read
+            skip = failed;
+            if (skip) continue;
+            try {
+                body(static_cast<size_t>(task), thread);
+            } catch (...) {
+#pragma omp critical(psi_parallel_for_error)
+                {
+                    if (!error) error = std::current_exception();
+                }
+#pragma omp atomic write
+                failed = true;
+            }
+        }
+    }
+    if (error) std::rethrow_exception(error);
+}
+
+}  // namespace psi
+
+#endif
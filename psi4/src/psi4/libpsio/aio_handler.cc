@@ -38,30 +38,46 @@
 #include "psi4/libpsio/psio.hpp"
 
 #include <cstdio>
+#include <cstring>
 #include <memory>
 #include <algorithm>
 #include <functional>
+#include <iterator>
 
 namespace psi {
 
-AIOHandler::AIOHandler(std::shared_ptr<PSIO> psio) : psio_(psio) {
+AIOHandler::AIOHandler(std::shared_ptr<PSIO> psio, size_t io_threads) : psio_(psio), stop_(false) {
     locked_ = new std::mutex();
     uniqueID_ = 0;
+#ifndef _MSC_VER
+    // Concurrent transfers need the positioned I/O of PSIO::rw_positioned()
+    for (size_t i = 0; i < io_threads; i++) io_threads_.emplace_back(std::bind(&AIOHandler::io_worker, this));
+#endif
 }
 AIOHandler::~AIOHandler() {
     synchronize();
+    {
+        std::unique_lock<std::mutex> lock(*locked_);
+        stop_ = true;
+    }
+    io_condition_.notify_all();
+    for (auto &t : io_threads_) t.join();
     delete locked_;
 }
-void AIOHandler::synchronize() {
+void AIOHandler::join_dispatcher() {
     // Joining a thread twice is an error. Thus, we check whether
     // the thread is joinable before joining. Non-joinable threads
     // have either been joined, detached (no synchronization possible)
     // or have been moved from, and another thread object controls its execution.
-    //    std::unique_lock<std::mutex> lock(*locked_);
-    //    lock.unlock();
     if (thread_)
         if (thread_->joinable()) thread_->join();
 }
+void AIOHandler::synchronize() {
+    join_dispatcher();
+    // The dispatcher is done, but its last transfers may still be in flight
+    std::unique_lock<std::mutex> lock(*locked_);
+    while (!transfers_.empty()) condition_.wait(lock);
+}
 size_t AIOHandler::read(size_t unit, const char *key, char *buffer, size_t size, psio_address start,
                         psio_address *end) {
     std::unique_lock<std::mutex> lock(*locked_);
@@ -75,12 +91,13 @@ size_t AIOHandler::read(size_t unit, const char *key, char *buffer, size_t size,
     start_.push(start);
     end_.push(end);
     jobID_.push_back(uniqueID_);
+    dispatchID_.push(uniqueID_);
 
     if (job_.size() > 1) return uniqueID_;
 
     // In C++11, destructors of threads that are still joinable call terminate()
     // Make sure current thread is joined before proceeding with next thread.
-    synchronize();
+    join_dispatcher();
 
     // thread start
     thread_ = std::make_shared<std::thread>(std::bind(&AIOHandler::call_aio, this));
@@ -99,6 +116,7 @@ size_t AIOHandler::write(size_t unit, const char *key, char *buffer, size_t size
     start_.push(start);
     end_.push(end);
     jobID_.push_back(uniqueID_);
+    dispatchID_.push(uniqueID_);
 
     // printf("Adding a write to the queue\n");
 
@@ -109,7 +127,7 @@ size_t AIOHandler::write(size_t unit, const char *key, char *buffer, size_t size
 
     // In C++11, destructors of threads that are still joinable call terminate()
     // Make sure current thread is joined before proceeding with next thread.
-    synchronize();
+    join_dispatcher();
 
     thread_ = std::make_shared<std::thread>(std::bind(&AIOHandler::call_aio, this));
     return uniqueID_;
@@ -124,12 +142,13 @@ size_t AIOHandler::read_entry(size_t unit, const char *key, char *buffer, size_t
     buffer_.push(buffer);
     size_.push(size);
     jobID_.push_back(uniqueID_);
+    dispatchID_.push(uniqueID_);
 
     if (job_.size() > 1) return uniqueID_;
 
     // In C++11, destructors of threads that are still joinable call terminate()
     // Make sure current thread is joined before proceeding with next thread.
-    synchronize();
+    join_dispatcher();
 
     // thread start
     thread_ = std::make_shared<std::thread>(std::bind(&AIOHandler::call_aio, this));
@@ -145,12 +164,13 @@ size_t AIOHandler::write_entry(size_t unit, const char *key, char *buffer, size_
     buffer_.push(buffer);
     size_.push(size);
     jobID_.push_back(uniqueID_);
+    dispatchID_.push(uniqueID_);
 
     if (job_.size() > 1) return uniqueID_;
 
     // In C++11, destructors of threads that are still joinable call terminate()
     // Make sure current thread is joined before proceeding with next thread.
-    synchronize();
+    join_dispatcher();
 
     // thread start
     thread_ = std::make_shared<std::thread>(std::bind(&AIOHandler::call_aio, this));
@@ -170,12 +190,13 @@ size_t AIOHandler::read_discont(size_t unit, const char *key, double **matrix, s
     col_skip_.push(col_skip);
     start_.push(start);
     jobID_.push_back(uniqueID_);
+    dispatchID_.push(uniqueID_);
 
     if (job_.size() > 1) return uniqueID_;
 
     // In C++11, destructors of threads that are still joinable call terminate()
     // Make sure current thread is joined before proceeding with next thread.
-    synchronize();
+    join_dispatcher();
 
     // thread start
     thread_ = std::make_shared<std::thread>(std::bind(&AIOHandler::call_aio, this));
@@ -195,12 +216,13 @@ size_t AIOHandler::write_discont(size_t unit, const char *key, double **matrix,
     col_skip_.push(col_skip);
     start_.push(start);
     jobID_.push_back(uniqueID_);
+    dispatchID_.push(uniqueID_);
 
     if (job_.size() > 1) return uniqueID_;
 
     // In C++11, destructors of threads that are still joinable call terminate()
     // Make sure current thread is joined before proceeding with next thread.
-    synchronize();
+    join_dispatcher();
 
     // thread start
     thread_ = std::make_shared<std::thread>(std::bind(&AIOHandler::call_aio, this));
@@ -216,12 +238,13 @@ size_t AIOHandler::zero_disk(size_t unit, const char *key, size_t rows, size_t c
     row_length_.push(rows);
     col_length_.push(cols);
     jobID_.push_back(uniqueID_);
+    dispatchID_.push(uniqueID_);
 
     if (job_.size() > 1) return uniqueID_;
 
     // In C++11, destructors of threads that are still joinable call terminate()
     // Make sure current thread is joined before proceeding with next thread.
-    synchronize();
+    join_dispatcher();
 
     // thread start
     thread_ = std::make_shared<std::thread>(std::bind(&AIOHandler::call_aio, this));
@@ -243,23 +266,90 @@ size_t AIOHandler::write_iwl(size_t unit, const char *key, size_t nints, int las
     lastbuf_.push(lastbuf);
     address_.push(address);
     jobID_.push_back(uniqueID_);
+    dispatchID_.push(uniqueID_);
 
     if (job_.size() > 1) return uniqueID_;
 
     // In C++11, destructors of threads that are still joinable call terminate()
     // Make sure current thread is joined before proceeding with next thread.
-    synchronize();
+    join_dispatcher();
 
     // thread start
     thread_ = std::make_shared<std::thread>(std::bind(&AIOHandler::call_aio, this));
     return uniqueID_;
 }
 
+void AIOHandler::submit(std::unique_lock<std::mutex> &lock, size_t jobid, size_t unit, const char *key, char *buffer,
+                        psio_address address, size_t size, int wrt, std::shared_ptr<std::vector<char>> storage) {
+    const size_t begin = address.page * PSIO_PAGELEN + address.offset;
+    const size_t end = begin + size;
+
+    // Units held in memory grow their image in place, so they never share it with a transfer in flight
+    const bool direct = io_threads_.empty() || psio_->ram_unit(unit);
+
+    auto conflicts = [&]() {
+        for (const Transfer &t : transfers_) {
+            if (t.unit != unit) continue;
+            if (direct) return true;
+            if ((wrt || t.wrt) && t.begin < end && begin < t.end) return true;
+        }
+        return false;
+    };
+    while (conflicts()) condition_.wait(lock);
+
+    if (direct) {
+        lock.unlock();
+        psio_->rw_traced(unit, key, buffer, address, size, wrt);
+        lock.lock();
+        return;
+    }
+
+    ++remaining_[jobid];
+    transfers_.push_back({jobid, unit, key, buffer, address, size, wrt, begin, end, storage});
+    ready_.push_back(std::prev(transfers_.end()));
+    io_condition_.notify_one();
+}
+
+void AIOHandler::finish(size_t jobid) {
+    auto it = remaining_.find(jobid);
+    if (--(it->second)) return;
+    remaining_.erase(it);
+    // Jobs may complete out of order, so the jobID is removed wherever it is
+    jobID_.erase(std::find(jobID_.begin(), jobID_.end(), jobid));
+    // Once it is removed, notify waiting threads to check again for their jobid.
+    condition_.notify_all();
+}
+
+void AIOHandler::io_worker() {
+    std::unique_lock<std::mutex> lock(*locked_);
+
+    while (true) {
+        while (!stop_ && ready_.empty()) io_condition_.wait(lock);
+        if (ready_.empty()) return;
+
+        std::list<Transfer>::iterator t = ready_.front();
+        ready_.pop_front();
+        lock.unlock();
+
+        psio_->rw_traced(t->unit, t->key.c_str(), t->buffer, t->address, t->size, t->wrt);
+
+        lock.lock();
+        const size_t jobid = t->jobid;
+        transfers_.erase(t);
+        finish(jobid);
+        // Held-back transfers and synchronize() wait on the set of transfers in flight
+        condition_.notify_all();
+    }
+}
+
 void AIOHandler::call_aio() {
     std::unique_lock<std::mutex> lock(*locked_);
 
     while (job_.size() > 0) {
         int jobtype = job_.front();
+        size_t jobid = dispatchID_.front();
+        // The job stays incomplete until it is fully dispatched, even if its transfers finish first
+        remaining_[jobid] = 1;
         lock.unlock();
 
         if (jobtype == 1) {
@@ -281,7 +371,10 @@ void AIOHandler::call_aio() {
 
             lock.unlock();
 
-            psio_->read(unit, key, buffer, size, start, end);
+            psio_address address = psio_->read_address(unit, key, size, start, end);
+            lock.lock();
+            submit(lock, jobid, unit, key, buffer, address, size, 0);
+            lock.unlock();
         } else if (jobtype == 2) {
             lock.lock();
 
@@ -299,17 +392,12 @@ void AIOHandler::call_aio() {
             start_.pop();
             end_.pop();
 
-            // printf("Actually doing the psio_write from thread\n");
-            // printf("Unit is %d, key is %s, size is %d\n", unit, key, size);
             lock.unlock();
 
-            // printf("Printing number %d now\n", *((int *) buffer));
-            // std::stringstream ss;
-            // ss << thread_->get_id();
-            // fprintf(stderr,"Printing from thread %s\n", ss.str().c_str());
-            // fprintf(stderr,"Starting address is %lu, %lu\n",start.page, start.offset);
-            psio_->write(unit, key, buffer, size, start, end);
-            // fprintf(stderr,"End address is %lu, %lu\n",end->page, end->offset);
+            psio_address address = psio_->write_address(unit, key, size, start, end);
+            lock.lock();
+            submit(lock, jobid, unit, key, buffer, address, size, 1);
+            lock.unlock();
         } else if (jobtype == 3) {
             lock.lock();
 
@@ -325,7 +413,11 @@ void AIOHandler::call_aio() {
 
             lock.unlock();
 
-            psio_->read_entry(unit, key, buffer, size);
+            psio_address end;
+            psio_address address = psio_->read_address(unit, key, size, PSIO_ZERO, &end);
+            lock.lock();
+            submit(lock, jobid, unit, key, buffer, address, size, 0);
+            lock.unlock();
         } else if (jobtype == 4) {
             lock.lock();
 
@@ -341,33 +433,13 @@ void AIOHandler::call_aio() {
 
             lock.unlock();
 
-            psio_->write_entry(unit, key, buffer, size);
-        } else if (jobtype == 5) {
+            psio_address end;
+            psio_address address = psio_->write_address(unit, key, size, PSIO_ZERO, &end);
             lock.lock();
-
-            size_t unit = unit_.front();
-            const char *key = key_.front();
-            double **matrix = matrix_.front();
-            size_t row_length = row_length_.front();
-            size_t col_length = col_length_.front();
-            size_t col_skip = col_skip_.front();
-            psio_address start = start_.front();
-
-            unit_.pop();
-            key_.pop();
-            matrix_.pop();
-            row_length_.pop();
-            col_length_.pop();
-            col_skip_.pop();
-            start_.pop();
-
+            submit(lock, jobid, unit, key, buffer, address, size, 1);
             lock.unlock();
-
-            for (int i = 0; i < row_length; i++) {
-                psio_->read(unit, key, (char *)&(matrix[i][0]), sizeof(double) * col_length, start, &start);
-                start = psio_get_address(start, sizeof(double) * col_skip);
-            }
-        } else if (jobtype == 6) {
+        } else if (jobtype == 5 || jobtype == 6) {
+            const int wrt = (jobtype == 6);
             lock.lock();
 
             size_t unit = unit_.front();
@@ -389,7 +461,12 @@ void AIOHandler::call_aio() {
             lock.unlock();
 
             for (int i = 0; i < row_length; i++) {
-                psio_->write(unit, key, (char *)&(matrix[i][0]), sizeof(double) * col_length, start, &start);
+                const size_t size = sizeof(double) * col_length;
+                psio_address address = wrt ? psio_->write_address(unit, key, size, start, &start)
+                                           : psio_->read_address(unit, key, size, start, &start);
+                lock.lock();
+                submit(lock, jobid, unit, key, (char *)&(matrix[i][0]), address, size, wrt);
+                lock.unlock();
                 start = psio_get_address(start, sizeof(double) * col_skip);
             }
         } else if (jobtype == 7) {
@@ -407,15 +484,17 @@ void AIOHandler::call_aio() {
 
             lock.unlock();
 
-            double *buf = new double[col_length];
-            memset(static_cast<void *>(buf), '\0', col_length * sizeof(double));
+            // One row of zeros, shared by all the row writes until the last of them is done
+            auto buf = std::make_shared<std::vector<char>>(col_length * sizeof(double), '\0');
 
             psio_address next_psio = PSIO_ZERO;
             for (int i = 0; i < row_length; i++) {
-                psio_->write(unit, key, (char *)(buf), sizeof(double) * col_length, next_psio, &next_psio);
+                const size_t size = sizeof(double) * col_length;
+                psio_address address = psio_->write_address(unit, key, size, next_psio, &next_psio);
+                lock.lock();
+                submit(lock, jobid, unit, key, buf->data(), address, size, 1, buf);
+                lock.unlock();
             }
-
-            delete[] buf;
         } else if (jobtype == 8) {
             lock.lock();
 
@@ -444,25 +523,32 @@ void AIOHandler::call_aio() {
 
             lock.unlock();
 
-            psio_->write(unit, key, (char *)&(lastbuf), sizeof(int), start, &start);
-            psio_->write(unit, key, (char *)&(nints), sizeof(int), start, &start);
-            psio_->write(unit, key, labels, lab_size, start, &start);
-            psio_->write(unit, key, values, val_size, start, &start);
+            // The buffer header must outlive this call, so the job keeps its own copy
+            auto header = std::make_shared<std::vector<char>>(2 * sizeof(int));
+            std::memcpy(header->data(), &lastbuf, sizeof(int));
+            std::memcpy(header->data() + sizeof(int), &nints, sizeof(int));
 
+            psio_address header_address = psio_->write_address(unit, key, 2 * sizeof(int), start, &start);
+            psio_address labels_address = psio_->write_address(unit, key, lab_size, start, &start);
+            psio_address values_address = psio_->write_address(unit, key, val_size, start, &start);
+
+            lock.lock();
+            submit(lock, jobid, unit, key, header->data(), header_address, 2 * sizeof(int), 1, header);
+            submit(lock, jobid, unit, key, labels, labels_address, lab_size, 1);
+            submit(lock, jobid, unit, key, values, values_address, val_size, 1);
+            lock.unlock();
         } else {
             throw PsiException("Error in AIO: Unknown job type", __FILE__, __LINE__);
         }
 
         lock.lock();
-        // Only pop the job once the work is actually done and we are gonna leave the loop.
-        // This way, job_.size() == 0 indicates there is no active thread.
+        // Only pop the job once it is fully dispatched and we are gonna leave the loop.
+        // This way, job_.size() == 0 indicates there is no active dispatcher thread.
         job_.pop();
-        // We also pop the jobID so that external threads may check that the job completed
-        jobID_.pop_front();
-        // Once it is popped, notify waiting threads to check again for their jobid.
-        condition_.notify_all();
+        dispatchID_.pop();
+        // Drop the dispatch hold; the last transfer to finish completes the job
+        finish(jobid);
     }
-    // printf("End of function call_aio\n");
 }
 
 void AIOHandler::wait_for_job(size_t jobid) {
@@ -30,9 +30,15 @@
 #define AIOHANDLER_H
 
 #include <condition_variable>
+#include <deque>
+#include <list>
+#include <map>
+#include <memory>
 #include <mutex>
 #include <queue>
+#include <string>
 #include <thread>
+#include <vector>
 
 #include "config.h"
 
@@ -40,12 +46,52 @@ namespace psi {
 
 class PSIO;
 
+/*!
+ * AIOHandler runs PSIO requests in the background.  Jobs are taken in order by a
+ * dispatcher thread, which does the TOC bookkeeping of each request and hands the
+ * data transfers to a pool of I/O threads, so that many reads and writes can be
+ * outstanding at once.  A transfer is held back until no earlier transfer in
+ * flight overlaps the same bytes of the same unit with either of them a write, so
+ * jobs still see each other's data in submission order.  With no I/O threads, or
+ * for units held in memory, the dispatcher performs the transfers itself.
+ */
 class AIOHandler {
    private:
+    /// One data transfer of a job, in flight on the I/O threads
+    struct Transfer {
+        size_t jobid;
+        size_t unit;
+        /// TOC entry, kept for I/O tracing
+        std::string key;
+        char *buffer;
+        psio_address address;
+        size_t size;
+        int wrt;
+        /// Byte range [begin, end) of the unit touched by the transfer
+        size_t begin;
+        size_t end;
+        /// Data owned by the job rather than the caller (zeros, IWL buffer headers)
+        std::shared_ptr<std::vector<char>> storage;
+    };
+
     /// What is the job type?
     std::queue<size_t> job_;
-    /// Unique job ID to check for job completion. Should NEVER be 0.
+    /// Job IDs in dispatch order, alongside job_
+    std::queue<size_t> dispatchID_;
+    /// Unique job ID to check for job completion. Should NEVER be 0. Holds every job not yet completed.
     std::deque<size_t> jobID_;
+    /// Per job, the number of transfers still in flight, plus one while the job is being dispatched
+    std::map<size_t, size_t> remaining_;
+    /// Transfers queued or running on the I/O threads
+    std::list<Transfer> transfers_;
+    /// Transfers waiting for an I/O thread
+    std::deque<std::list<Transfer>::iterator> ready_;
+    /// The I/O threads
+    std::vector<std::thread> io_threads_;
+    /// Tells the I/O threads to exit
+    bool stop_;
+    /// condition variable to wake I/O threads when transfers are queued
+    std::condition_variable io_condition_;
     /// Unit number argument
     std::queue<size_t> unit_;
     /// Entry Key (80-char) argument
@@ -72,9 +118,9 @@ class AIOHandler {
     std::queue<int> lastbuf_;
     /// For IWL: pointer to current position in file
     std::queue<size_t *> address_;
-    /// PSIO object this AIO_Handler is built on
+    /// PSIO object this AIOHandler is built on
     std::shared_ptr<PSIO> psio_;
-    /// Thread this AIO_Handler is currently running on
+    /// Dispatcher thread this AIOHandler is currently running on
     std::shared_ptr<std::thread> thread_;
     /// Lock variable
     std::mutex *locked_;
@@ -83,9 +129,21 @@ class AIOHandler {
     /// condition variable to wait for a specific job to finish
     std::condition_variable condition_;
 
+    /// Join the dispatcher thread once it has run out of jobs
+    void join_dispatcher();
+    /// Queue one data transfer of job jobid, or perform it directly; called with lock held
+    void submit(std::unique_lock<std::mutex> &lock, size_t jobid, size_t unit, const char *key, char *buffer,
+                psio_address address, size_t size, int wrt, std::shared_ptr<std::vector<char>> storage = nullptr);
+    /// Count one part of job jobid as done, completing the job with its last part; called with lock held
+    void finish(size_t jobid);
+    /// Loop run by each I/O thread
+    void io_worker();
+
    public:
-    /// AIO_Handlers are constructed around a synchronous PSIO object
-    AIOHandler(std::shared_ptr<PSIO> psio);
+    /// AIOHandlers are constructed around a synchronous PSIO object. io_threads is the
+    /// number of data transfers that may be in flight at once; 0 runs them one by one
+    /// on the dispatcher thread.
+    AIOHandler(std::shared_ptr<PSIO> psio, size_t io_threads = 4);
     /// Destructor
     ~AIOHandler();
     /// When called, synchronize will not return until all requested data has been read or written
@@ -133,7 +191,7 @@ class AIOHandler {
     /// counting the number of integrals in the current buffer
     size_t write_iwl(size_t unit, const char *key, size_t nints, int lastbuf, char *labels, char *values,
                      size_t labsize, size_t valsize, size_t *address);
-    /// Generic function bound to thread internally
+    /// Generic function bound to the dispatcher thread internally
     void call_aio();
 
     /// Function that checks if a job has been completed using the JobID.
@@ -52,6 +52,12 @@ void PSIO::close(size_t unit, int keep) {
     /* Dump the current TOC back out to disk */
     tocwrite(unit);
 
+    /* An in-memory unit only reaches the disk if it is being kept */
+    if (keep)
+        ram_flush(unit);
+    else
+        ram_drop(unit);
+
     /* Free the TOC */
     this_entry = this_unit->toc;
     for (i = 0; i < this_unit->toclen; i++) {
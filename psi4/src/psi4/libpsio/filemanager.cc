@@ -38,7 +38,7 @@
 
 namespace psi {
 
-PSIOManager::PSIOManager() {
+PSIOManager::PSIOManager() : memory_limit_(0), io_tracing_(false) {
     pid_ = psio_getpid();
 #ifdef _MSC_VER
     if (const char* path = std::getenv("TEMP"))
@@ -90,6 +90,15 @@ void PSIOManager::set_specific_retention(int fileno, bool retain) {
     mirror_to_disk();
 }
 
+void PSIOManager::set_specific_memory(int fileno, bool in_memory) {
+    if (in_memory)
+        specific_memory_.insert(fileno);
+    else
+        specific_memory_.erase(fileno);
+}
+
+bool PSIOManager::get_specific_memory(int fileno) { return specific_memory_.count(fileno) != 0; }
+
 bool PSIOManager::get_specific_retention(int fileno) {
     bool retaining = false;
 
@@ -215,6 +224,11 @@ void PSIOManager::mark_file_for_retention(const std::string& file, bool retain)
     mirror_to_disk();
 }
 void PSIOManager::psiclean() {
+    if (io_tracing_ && !io_trace_.empty()) {
+        print_io_trace();
+        reset_io_trace();
+    }
+
     std::map<std::string, bool> temp;
     for (std::map<std::string, bool>::iterator it = files_.begin(); it != files_.end(); it++) {
         if (retained_files_.count((*it).first) == 0) {
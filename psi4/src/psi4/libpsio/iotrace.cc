@@ -0,0 +1,158 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Psi4: an open-source quantum chemistry software package
+ *
+ * Copyright (c) 2007-2023 The Psi4 Developers.
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This file is part of Psi4.
+ *
+ * Psi4 is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * Psi4 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with Psi4; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * @END LICENSE
+ */
+
+
+/*!
+ \file
+ \ingroup PSIO
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iterator>
+#include <string>
+
+#include "psi4/libpsio/psio.h"
+#include "psi4/libpsio/psio.hpp"
+#include "psi4/psi4-dec.h"
+#include "psi4/libpsi4util/PsiOutStream.h"
+
+namespace psi {
+
+namespace {
+
+/// The latency below which a fraction q of a histogram's calls fall, in us (upper bin edge)
+double latency_percentile(const size_t *latency, double q) {
+    size_t total = 0;
+    for (int b = 0; b < PSIO_TRACE_BINS; b++) total += latency[b];
+    if (!total) return 0.0;
+    size_t seen = 0;
+    for (int b = 0; b < PSIO_TRACE_BINS; b++) {
+        seen += latency[b];
+        if (seen >= q * total) return std::ldexp(1.0, b);
+    }
+    return std::ldexp(1.0, PSIO_TRACE_BINS - 1);
+}
+
+void add_trace(psio_io_trace &sum, const psio_io_trace &t) {
+    sum.reads += t.reads;
+    sum.writes += t.writes;
+    sum.bytes_read += t.bytes_read;
+    sum.bytes_written += t.bytes_written;
+    sum.read_time += t.read_time;
+    sum.write_time += t.write_time;
+    for (int b = 0; b < PSIO_TRACE_BINS; b++) sum.latency[b] += t.latency[b];
+}
+
+void print_trace_line(std::shared_ptr<PsiOutStream> printer, const std::string &unit, const std::string &key,
+                      const psio_io_trace &t) {
+    const double mib = 1024.0 * 1024.0;
+    const double time = t.read_time + t.write_time;
+    const double bandwidth = time > 0.0 ? (t.bytes_read + t.bytes_written) / mib / time : 0.0;
+    printer->Printf("  %5s  %-32.32s %9zu %10.1f %9zu %10.1f %9.3f %9.1f %9.0f %9.0f\n", unit.c_str(), key.c_str(),
+                    t.reads, t.bytes_read / mib, t.writes, t.bytes_written / mib, time, bandwidth,
+                    latency_percentile(t.latency, 0.50), latency_percentile(t.latency, 0.99));
+}
+
+}  // namespace
+
+/*!
+ ** PSIO::rw_traced(): rw() for the data of TOC entry key.  While PSIOManager I/O
+ ** tracing is on, the transfer is timed and recorded against its unit and entry.
+ **
+ ** \ingroup PSIO
+ */
+void PSIO::rw_traced(size_t unit, const char *key, char *buffer, psio_address address, size_t size, int wrt) {
+    auto manager = PSIOManager::shared_object();
+    if (!manager->get_io_tracing()) {
+        rw(unit, buffer, address, size, wrt);
+        return;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    rw(unit, buffer, address, size, wrt);
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    manager->record_io(unit, key, size, wrt, elapsed.count());
+}
+
+void PSIOManager::record_io(size_t unit, const std::string &key, size_t bytes, int wrt, double seconds) {
+    const double us = seconds * 1.0e6;
+    int bin = 0;
+    if (us >= 1.0) bin = std::min(PSIO_TRACE_BINS - 1, 1 + (int)std::floor(std::log2(us)));
+
+    std::lock_guard<std::mutex> lock(io_trace_mutex_);
+    psio_io_trace &t = io_trace_[std::make_pair(unit, key)];
+    if (wrt) {
+        t.writes++;
+        t.bytes_written += bytes;
+        t.write_time += seconds;
+    } else {
+        t.reads++;
+        t.bytes_read += bytes;
+        t.read_time += seconds;
+    }
+    t.latency[bin]++;
+}
+
+void PSIOManager::print_io_trace(std::string out) {
+    std::shared_ptr<psi::PsiOutStream> printer = (out == "outfile" ? outfile : std::make_shared<PsiOutStream>(out));
+    std::lock_guard<std::mutex> lock(io_trace_mutex_);
+
+    printer->Printf("                    -----------------------------\n");
+    printer->Printf("                    ==> Psi4 PSIO Traffic <==\n");
+    printer->Printf("                    -----------------------------\n");
+    printer->Printf("\n");
+    printer->Printf("  %5s  %-32s %9s %10s %9s %10s %9s %9s %9s %9s\n", "Unit", "Entry", "Reads", "Read MiB", "Writes",
+                    "Write MiB", "Time [s]", "MiB/s", "p50 [us]", "p99 [us]");
+    printer->Printf("  %s\n", std::string(128, '-').c_str());
+
+    psio_io_trace unit_total, total;
+    for (auto it = io_trace_.begin(); it != io_trace_.end(); ++it) {
+        const size_t unit = it->first.first;
+        print_trace_line(printer, std::to_string(unit), it->first.second, it->second);
+        add_trace(unit_total, it->second);
+        add_trace(total, it->second);
+
+        auto next = std::next(it);
+        if (next == io_trace_.end() || next->first.first != unit) {
+            print_trace_line(printer, std::to_string(unit), "(unit total)", unit_total);
+            printer->Printf("\n");
+            unit_total = psio_io_trace();
+        }
+    }
+    print_trace_line(printer, "", "(total)", total);
+    printer->Printf("\n");
+}
+
+void PSIOManager::reset_io_trace() {
+    std::lock_guard<std::mutex> lock(io_trace_mutex_);
+    io_trace_.clear();
+}
+
+}  // namespace psi
@@ -89,8 +89,10 @@ void PSIO::open(size_t unit, int status) {
         char* fullpath;
         get_volpath(unit, i, &path);
 
-        // A bit of a hack in psio open at the moment, breaks volumes and some error checking
-        std::string spath2 = PSIOManager::shared_object()->get_file_path(unit);
+        // PSIOManager paths (set_specific_path / scratch) apply to single-volume units; a striped
+        // unit must place each volume at its own VOLUMEn path
+        std::string spath2 =
+            (this_unit->numvols > 1) ? std::string(path) : PSIOManager::shared_object()->get_file_path(unit);
         const char* path2 = spath2.c_str();
 
         fullpath = (char*)malloc((strlen(path2) + strlen(name) + 80) * sizeof(char));
@@ -114,6 +116,9 @@ void PSIO::open(size_t unit, int status) {
         free(path);
     }
 
+    /* Units requested in memory work on an image of the file from here on */
+    ram_load(unit);
+
     if (status == PSIO_OPEN_OLD)
         tocread(unit);
     else if (status == PSIO_OPEN_NEW) {
@@ -180,8 +185,10 @@ bool PSIO::exists(size_t unit) {
         int stream;
         get_volpath(unit, i, &path);
 
-        // A bit of a hack in psio open at the moment, breaks volumes and some error checking
-        std::string spath2 = PSIOManager::shared_object()->get_file_path(unit);
+        // PSIOManager paths (set_specific_path / scratch) apply to single-volume units; a striped
+        // unit must place each volume at its own VOLUMEn path
+        std::string spath2 =
+            (this_unit->numvols > 1) ? std::string(path) : PSIOManager::shared_object()->get_file_path(unit);
         const char* path2 = spath2.c_str();
 
         fullpath = (char*)malloc((strlen(path2) + strlen(name) + 80) * sizeof(char));
@@ -29,11 +29,14 @@
 #ifndef _psi_src_lib_libpsio_psio_hpp_
 #define _psi_src_lib_libpsio_psio_hpp_
 
+#include <atomic>
 #include <string>
 #include <map>
+#include <mutex>
 #include <set>
 #include <queue>
 #include <memory>
+#include <vector>
 
 #include "psi4/libpsio/config.h"
 
@@ -44,6 +47,21 @@ class PSIOManager;
 extern PSI_API std::shared_ptr<PSIO> _default_psio_lib_;
 extern PSI_API std::shared_ptr<PSIOManager> _default_psio_manager_;
 
+/// Number of latency bins in a psio_io_trace: bin 0 counts calls under 1 us, bin b
+/// calls of [2^(b-1), 2^b) us, and the last bin everything slower
+#define PSIO_TRACE_BINS 24
+
+/// Traffic recorded for one TOC entry of one unit while I/O tracing is on
+struct psio_io_trace {
+    size_t reads = 0;
+    size_t writes = 0;
+    size_t bytes_read = 0;
+    size_t bytes_written = 0;
+    double read_time = 0.0;
+    double write_time = 0.0;
+    size_t latency[PSIO_TRACE_BINS] = {};
+};
+
 /**
     PSIOManager is a class designed to be used as a static object to track all
     PSIO operations in a given PSI4 computation
@@ -59,12 +77,23 @@ private:
     std::map<int, std::string> specific_paths_;
     /// Default retained files
     std::set<int> specific_retains_;
+    /// File numbers held in memory rather than on disk
+    std::set<int> specific_memory_;
+    /// Total bytes of in-memory files before they spill to disk (0 = no limit)
+    size_t memory_limit_;
 
     /// Map of files, bool denotes open or closed
     std::map<std::string, bool> files_;
     /// Set of files to retain after psiclean
     std::set<std::string> retained_files_;
 
+    /// Record I/O traffic per unit and TOC key?
+    std::atomic<bool> io_tracing_;
+    /// Recorded I/O traffic, keyed by unit and TOC key
+    std::map<std::pair<size_t, std::string>, psio_io_trace> io_trace_;
+    /// Guards io_trace_, which AIOHandler threads also record into
+    std::mutex io_trace_mutex_;
+
     std::string pid_;
 public:
     /// Default constructor (does nothing)
@@ -104,6 +133,28 @@ public:
             * \return keeping or not?
             */
     bool get_specific_retention(int fileno);
+    /**
+            * Keep a specific file number in memory instead of on disk.  The
+            * file is loaded when opened and, if retained, written back when
+            * closed.  Takes effect the next time the unit is opened.
+            * \param fileno PSI4 file number
+            * \param in_memory hold in memory or not? (Allows override)
+            */
+    void set_specific_memory(int fileno, bool in_memory);
+    /**
+            * Inquire whether a specific file number is held in memory
+            * \param fileno PSI4 file number
+            * \return in memory or not?
+            */
+    bool get_specific_memory(int fileno);
+    /**
+            * Cap the total size of all in-memory files.  A file whose growth
+            * would exceed the cap is written out and continues on disk.
+            * \param bytes limit in bytes, 0 for no limit
+            */
+    void set_memory_limit(size_t bytes) { memory_limit_ = bytes; }
+    /// The total size allowed for in-memory files, 0 for no limit
+    size_t get_memory_limit() const { return memory_limit_; }
 
     /**
             * Get the path for a specific file number
@@ -161,6 +212,32 @@ public:
             * Print the current status of PSI4 files
             */
     void print_out() { print("outfile"); }
+    /**
+            * Turn recording of the bytes, calls, time and latency of every
+            * PSIO read and write, per unit and TOC entry, on or off.  The
+            * record is printed and cleared at each psiclean.
+            * \param trace record or not?
+            */
+    void set_io_tracing(bool trace) { io_tracing_ = trace; }
+    /// Is I/O being recorded?
+    bool get_io_tracing() const { return io_tracing_; }
+    /**
+            * Record one transfer while I/O tracing is on
+            * \param unit PSI4 file number
+            * \param key TOC entry the data belongs to
+            * \param bytes size of the transfer
+            * \param wrt write (1) or read (0)
+            * \param seconds time the transfer took
+            */
+    void record_io(size_t unit, const std::string& key, size_t bytes, int wrt, double seconds);
+    /**
+            * Print the recorded I/O traffic: per entry and unit, the calls and
+            * bytes read and written, effective bandwidth and latency percentiles
+            * \param out file to print to
+            */
+    void print_io_trace(std::string out = "outfile");
+    /// Forget all recorded I/O traffic
+    void reset_io_trace();
     /**
             * Execute the psiclean protocol, deleting all recorded files
             * except for those currently marked for retention.
@@ -358,7 +435,36 @@ private:
     /// Read the table of contents for file number 'unit'.
     void tocread(size_t unit);
 
-    friend class AIO_Handler;
+    /// In-memory images of units selected with PSIOManager::set_specific_memory()
+    std::map<size_t, std::vector<char>> ram_image_;
+    /// Guards ram_image_, which the AIOHandler worker threads reach through rw()
+    mutable std::mutex ram_mutex_;
+    /// Is unit held in memory?
+    bool ram_unit(size_t unit) const;
+    /// Load a unit into memory as it is opened, if requested
+    void ram_load(size_t unit);
+    /// Write an in-memory unit back to its file and return it to disk I/O
+    void ram_flush(size_t unit);
+    /// Drop the in-memory image of a unit without writing it
+    void ram_drop(size_t unit);
+    /// ram_flush() with ram_mutex_ held
+    void ram_flush_locked(size_t unit);
+    /// rw() on an in-memory unit; returns false if the unit is on disk
+    bool ram_rw(size_t unit, char *buffer, psio_address address, size_t size, int wrt);
+    /// rw() through positioned I/O, safe for concurrent disjoint requests on one unit and
+    /// issued to all volumes of a striped unit at once; returns false if left to the serial path
+    bool rw_positioned(size_t unit, char *buffer, psio_address address, size_t size, int wrt);
+    /// rw() for data of TOC entry key, timed and recorded if PSIOManager I/O tracing is on
+    void rw_traced(size_t unit, const char *key, char *buffer, psio_address address, size_t size, int wrt);
+
+    /// The TOC bookkeeping of read(): checks the request against the entry and returns the
+    /// global address of its first byte, without transferring any data
+    psio_address read_address(size_t unit, const char *key, size_t size, psio_address start, psio_address *end);
+    /// The TOC bookkeeping of write(): creates or extends the entry (writing its TOC header if
+    /// needed) and returns the global address of the first data byte, without writing the data
+    psio_address write_address(size_t unit, const char *key, size_t size, psio_address start, psio_address *end);
+
+    friend class AIOHandler;
 
 public:
     void set_pid(const std::string &pid) { pid_ = pid; }
@@ -0,0 +1,184 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Psi4: an open-source quantum chemistry software package
+ *
+ * Copyright (c) 2007-2023 The Psi4 Developers.
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This file is part of Psi4.
+ *
+ * Psi4 is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * Psi4 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with Psi4; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * @END LICENSE
+ */
+
+/*!
+ \file
+ \ingroup PSIO
+ */
+
+#include <cerrno>
+#include <cstring>
+#include <utility>
+#include "psi4/libpsio/psio.h"
+#include "psi4/libpsio/psio.hpp"
+#include "psi4/psi4-dec.h"
+
+namespace psi {
+
+bool PSIO::ram_unit(size_t unit) const {
+    std::lock_guard<std::mutex> lock(ram_mutex_);
+    return ram_image_.count(unit);
+}
+
+void PSIO::ram_drop(size_t unit) {
+    std::lock_guard<std::mutex> lock(ram_mutex_);
+    ram_image_.erase(unit);
+}
+
+/*!
+ ** PSIO::ram_load(): Pull a unit selected with PSIOManager::set_specific_memory()
+ ** into memory as it is opened.  The whole file becomes the in-memory image and
+ ** all subsequent reads and writes of the unit go to that image.  Units striped
+ ** over more than one volume stay on disk.
+ **
+ ** \param unit = The PSI unit number.
+ **
+ ** \ingroup PSIO
+ */
+void PSIO::ram_load(size_t unit) {
+    psio_ud *this_unit = &(psio_unit[unit]);
+
+    if (!PSIOManager::shared_object()->get_specific_memory(unit) || this_unit->numvols != 1) return;
+
+    const int stream = this_unit->vol[0].stream;
+    const auto end = SYSTEM_LSEEK(stream, 0L, SEEK_END);
+    const int lseek_errno = errno;
+    if (end == -1) {
+        const std::string errmsg =
+            psio_compose_err_msg("LSEEK failed.", "Cannot size the file to load", unit, lseek_errno);
+        psio_error(unit, PSIO_ERROR_LSEEK, errmsg);
+    }
+
+    std::vector<char> image(end, 0);
+
+    rewind_toclen(unit);
+    size_t done = 0;
+    while (done < image.size()) {
+        const auto errcod = SYSTEM_READ(stream, image.data() + done, image.size() - done);
+        const int saved_errno = errno;
+        if (errcod <= 0) {
+            const std::string errmsg =
+                psio_compose_err_msg("READ failed.", "Error loading the file into memory", unit, saved_errno);
+            psio_error(unit, PSIO_ERROR_READ, errmsg);
+        }
+        done += errcod;
+    }
+
+    std::lock_guard<std::mutex> lock(ram_mutex_);
+    ram_image_[unit] = std::move(image);
+}
+
+/*!
+ ** PSIO::ram_flush(): Write the in-memory image of a unit back to its file and
+ ** return the unit to ordinary disk I/O.  Used when a retained unit is closed
+ ** and when a unit outgrows PSIOManager::get_memory_limit().
+ **
+ ** \param unit = The PSI unit number.
+ **
+ ** \ingroup PSIO
+ */
+void PSIO::ram_flush(size_t unit) {
+    std::lock_guard<std::mutex> lock(ram_mutex_);
+    ram_flush_locked(unit);
+}
+
+void PSIO::ram_flush_locked(size_t unit) {
+    // Held across the write, so no rw() on the unit reaches the disk before its image does
+    auto it = ram_image_.find(unit);
+    if (it == ram_image_.end()) return;
+
+    const std::vector<char> &image = it->second;
+    const int stream = psio_unit[unit].vol[0].stream;
+
+    rewind_toclen(unit);
+    size_t done = 0;
+    while (done < image.size()) {
+        const auto errcod = SYSTEM_WRITE(stream, image.data() + done, image.size() - done);
+        const int saved_errno = errno;
+        if (errcod <= 0) {
+            const std::string errmsg =
+                psio_compose_err_msg("WRITE failed.", "Error writing the in-memory file to disk", unit, saved_errno);
+            psio_error(unit, PSIO_ERROR_WRITE, errmsg);
+        }
+        done += errcod;
+    }
+
+    ram_image_.erase(it);
+}
+
+/*!
+ ** PSIO::ram_rw(): The in-memory counterpart of PSIO::rw().  A write that would
+ ** push the images of all units past PSIOManager::get_memory_limit() spills this
+ ** unit to disk instead, after which the caller falls back to disk I/O.
+ **
+ ** \param unit    = The PSI unit number.
+ ** \param buffer  = The buffer containing the bytes for the read/write event.
+ ** \param address = the PSIO global address for the start of the read/write.
+ ** \param size    = The number of bytes to read/write.
+ ** \param wrt     = Indicates if the call is to read (0) or write (1) the input data.
+ **
+ ** Returns false if the unit is not (or no longer) held in memory.
+ **
+ ** \ingroup PSIO
+ */
+bool PSIO::ram_rw(size_t unit, char *buffer, psio_address address, size_t size, int wrt) {
+    std::lock_guard<std::mutex> lock(ram_mutex_);
+    auto it = ram_image_.find(unit);
+    if (it == ram_image_.end()) return false;
+
+    std::vector<char> &image = it->second;
+    const size_t start = address.page * PSIO_PAGELEN + address.offset;
+
+    if (wrt) {
+        if (start + size > image.size()) {
+            const size_t limit = PSIOManager::shared_object()->get_memory_limit();
+            if (limit) {
+                size_t total = start + size;
+                for (const auto &kv : ram_image_)
+                    if (kv.first != unit) total += kv.second.size();
+                if (total > limit) {
+                    ram_flush_locked(unit);
+                    return false;
+                }
+            }
+            image.resize(start + size);
+        }
+        std::memcpy(image.data() + start, buffer, size);
+    } else {
+        if (start + size > image.size()) {
+            const std::string errmsg = "READ failed. Only some of the bytes were read!\nError reading unit " +
+                                       std::to_string(unit) + " from memory";
+            psio_error(unit, PSIO_ERROR_READ, errmsg);
+        }
+        std::memcpy(buffer, image.data() + start, size);
+    }
+
+    return true;
+}
+
+}  // namespace psi
@@ -43,7 +43,7 @@ PRAGMA_WARNING_POP
 
 namespace psi {
 
-void PSIO::read(size_t unit, const char *key, char *buffer, size_t size, psio_address start, psio_address *end) {
+psio_address PSIO::read_address(size_t unit, const char *key, size_t size, psio_address start, psio_address *end) {
     psio_ud *this_unit;
     psio_tocentry *this_entry;
     psio_address start_toc, start_data, end_data; /* global addresses */
@@ -91,8 +91,12 @@ void PSIO::read(size_t unit, const char *key, char *buffer, size_t size, psio_ad
         *end = psio_get_address(start, size);
     }
 
+    return start_data;
+}
+
+void PSIO::read(size_t unit, const char *key, char *buffer, size_t size, psio_address start, psio_address *end) {
     /* Now read the actual data from the unit */
-    rw(unit, buffer, start_data, size, 0);
+    rw_traced(unit, key, buffer, read_address(unit, key, size, start, end), size, 0);
 
 #ifdef PSIO_STATS
     psio_readlen[unit] += size;
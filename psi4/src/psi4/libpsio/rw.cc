@@ -60,6 +60,9 @@ void PSIO::rw(size_t unit, char *buffer, psio_address address, size_t size, int
     size_t bytes_left, num_full_pages;
     psio_ud *this_unit;
 
+    if (ram_rw(unit, buffer, address, size, wrt)) return;
+    if (rw_positioned(unit, buffer, address, size, wrt)) return;
+
     this_unit = &(psio_unit[unit]);
     numvols = this_unit->numvols;
     page = address.page;
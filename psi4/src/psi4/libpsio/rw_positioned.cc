@@ -0,0 +1,154 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Psi4: an open-source quantum chemistry software package
+ *
+ * Copyright (c) 2007-2023 The Psi4 Developers.
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This file is part of Psi4.
+ *
+ * Psi4 is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * Psi4 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with Psi4; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * @END LICENSE
+ */
+
+
+/*!
+ \file
+ \ingroup PSIO
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <thread>
+#include <vector>
+#include "psi4/libpsio/psio.h"
+#include "psi4/libpsio/psio.hpp"
+#include "psi4/psi4-dec.h"
+
+#ifndef _MSC_VER
+#include <sys/uio.h>
+#endif
+
+#ifndef IOV_MAX
+#define IOV_MAX 1024
+#endif
+
+namespace psi {
+
+/*!
+ ** PSIO::rw_positioned(): Counterpart of PSIO::rw() built on positioned I/O
+ ** (preadv()/pwritev()), so it neither depends on nor moves the file offsets of
+ ** the unit's volumes.  Concurrent requests on the same unit are therefore safe
+ ** as long as they touch disjoint bytes, which is what AIOHandler relies on to
+ ** keep several transfers in flight at once.
+ **
+ ** Page p of a unit lives on volume p % numvols, so the pages a request touches
+ ** on any one volume are contiguous in that volume's file and only strided in
+ ** the caller's buffer.  Each volume therefore gets a single vectored read or
+ ** write.  When a request spans several volumes they are serviced concurrently,
+ ** one thread apiece.  I/O errors are collected and reported from the calling
+ ** thread once all volumes are done.
+ **
+ ** Returns false, leaving the request to the serial path in rw(), on platforms
+ ** without preadv()/pwritev().
+ **
+ ** \ingroup PSIO
+ */
+bool PSIO::rw_positioned(size_t unit, char *buffer, psio_address address, size_t size, int wrt) {
+#ifdef _MSC_VER
+    return false;
+#else
+    psio_ud *this_unit = &(psio_unit[unit]);
+    const size_t numvols = this_unit->numvols;
+    const size_t npages = size ? (address.offset + size - 1) / PSIO_PAGELEN + 1 : 0;
+    const size_t busy_vols = std::min(numvols, npages);
+
+    struct vol_status {
+        size_t wanted = 0;
+        size_t done = 0;
+        bool failed = false;
+        int saved_errno = 0;
+    };
+    std::vector<vol_status> status(numvols);
+
+    auto transfer = [&](size_t v) {
+        vol_status &st = status[v];
+        std::vector<struct iovec> iov;
+        off_t vol_offset = -1;
+
+        // Gather this volume's share of the request: the first page is the only one that
+        // may start mid-page, and the last may end early
+        size_t p = address.page + (v + numvols - address.page % numvols) % numvols;
+        for (;; p += numvols) {
+            const size_t page_offset = (p == address.page) ? address.offset : 0;
+            const size_t buf_offset =
+                (p == address.page) ? 0 : (PSIO_PAGELEN - address.offset) + (p - address.page - 1) * PSIO_PAGELEN;
+            if (buf_offset >= size) break;
+            const size_t len = std::min<size_t>(PSIO_PAGELEN - page_offset, size - buf_offset);
+            if (vol_offset < 0) vol_offset = (off_t)((p / numvols) * PSIO_PAGELEN + page_offset);
+            struct iovec chunk;
+            chunk.iov_base = buffer + buf_offset;
+            chunk.iov_len = len;
+            iov.push_back(chunk);
+            st.wanted += len;
+        }
+
+        for (size_t first = 0; first < iov.size(); first += IOV_MAX) {
+            const int count = (int)std::min<size_t>(IOV_MAX, iov.size() - first);
+            size_t expected = 0;
+            for (int i = 0; i < count; i++) expected += iov[first + i].iov_len;
+            const ssize_t n = wrt ? ::pwritev(this_unit->vol[v].stream, &iov[first], count, vol_offset)
+                                  : ::preadv(this_unit->vol[v].stream, &iov[first], count, vol_offset);
+            if (n < 0) {
+                st.failed = true;
+                st.saved_errno = errno;
+                return;
+            }
+            st.done += n;
+            if ((size_t)n != expected) return;
+            vol_offset += n;
+        }
+    };
+
+    // The volumes holding the request's pages, starting with that of its first page
+    const size_t first_vol = address.page % numvols;
+    std::vector<std::thread> workers;
+    if (busy_vols > 1) workers.reserve(busy_vols - 1);
+    for (size_t i = 1; i < busy_vols; i++) workers.emplace_back(transfer, (first_vol + i) % numvols);
+    if (busy_vols) transfer(first_vol);
+    for (auto &w : workers) w.join();
+
+    for (size_t v = 0; v < numvols; v++) {
+        const vol_status &st = status[v];
+        if (!st.failed && st.done == st.wanted) continue;
+        const std::string context = wrt ? "Error writing a volume" : "Error reading a volume";
+        std::string beginning;
+        if (wrt)
+            beginning = st.failed ? "WRITE failed." : "WRITE failed. Only some of the bytes were written!";
+        else
+            beginning = st.failed ? "READ failed." : "READ failed. Only some of the bytes were read!";
+        const std::string errmsg = st.failed ? psio_compose_err_msg(beginning, context, unit, st.saved_errno)
+                                             : psio_compose_err_msg(beginning, context, unit);
+        psio_error(unit, wrt ? PSIO_ERROR_WRITE : PSIO_ERROR_READ, errmsg);
+    }
+    return true;
+#endif
+}
+
+}  // namespace psi
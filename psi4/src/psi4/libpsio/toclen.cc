@@ -34,6 +34,7 @@
 #include <cstdio>
 #include <cstdlib>
 #include <cerrno>
+#include <cstring>
 #include "psi4/libpsi4util/exception.h"
 #include "psi4/libpsio/psio.h"
 #include "psi4/libpsio/psio.hpp"
@@ -77,10 +78,21 @@ void PSIO::rewind_toclen(const size_t unit) {
 /// @return length of the TOC for a given unit
 size_t PSIO::rd_toclen(const size_t unit) {
     if (!open_check(unit)) psio_error(unit, PSIO_ERROR_UNOPENED);
+    size_t len;
+    // In-memory units keep the length at the start of their image
+    {
+        std::lock_guard<std::mutex> lock(ram_mutex_);
+        auto it = ram_image_.find(unit);
+        if (it != ram_image_.end()) {
+            const std::vector<char> &image = it->second;
+            if (image.size() < sizeof(size_t)) return (0);
+            std::memcpy(&len, image.data(), sizeof(size_t));
+            return (len);
+        }
+    }
     // Seek to the beginning
     rewind_toclen(unit);
     // Read the value
-    size_t len;
     const auto stream = psio_unit[unit].vol[0].stream;
     const auto errcod = SYSTEM_READ(stream, (char *)&len, sizeof(size_t));
     const int saved_errno = errno;
@@ -100,6 +112,16 @@ size_t PSIO::rd_toclen(const size_t unit) {
 /// @param len  : length value to write
 void PSIO::wt_toclen(const size_t unit, const size_t len) {
     if (!open_check(unit)) psio_error(unit, PSIO_ERROR_UNOPENED);
+    {
+        std::lock_guard<std::mutex> lock(ram_mutex_);
+        auto it = ram_image_.find(unit);
+        if (it != ram_image_.end()) {
+            std::vector<char> &image = it->second;
+            if (image.size() < sizeof(size_t)) image.resize(sizeof(size_t));
+            std::memcpy(image.data(), &len, sizeof(size_t));
+            return;
+        }
+    }
     // Seek to the beginning
     rewind_toclen(unit);
     // Write the value
@@ -43,7 +43,7 @@ PRAGMA_WARNING_POP
 
 namespace psi {
 
-void PSIO::write(size_t unit, const char *key, char *buffer, size_t size, psio_address start, psio_address *end) {
+psio_address PSIO::write_address(size_t unit, const char *key, size_t size, psio_address start, psio_address *end) {
     psio_ud *this_unit;
     psio_tocentry *this_entry, *last_entry;
     psio_address start_toc, start_data, end_data; /* global addresses */
@@ -133,8 +133,12 @@ void PSIO::write(size_t unit, const char *key, char *buffer, size_t size, psio_a
     if (dirty) /* Need to first write/update the TOC header for this record */
         rw(unit, (char *)this_entry, start_toc, tocentry_size, 1);
 
+    return start_data;
+}
+
+void PSIO::write(size_t unit, const char *key, char *buffer, size_t size, psio_address start, psio_address *end) {
     /* Now write the actual data to the unit */
-    rw(unit, buffer, start_data, size, 1);
+    rw_traced(unit, key, buffer, write_address(unit, key, size, start, end), size, 1);
 
 #ifdef PSIO_STATS
     psio_writlen[unit] += size;
@@ -40,6 +40,8 @@
 #include "psi4/libmints/potentialint.h"
 #include "psi4/libmints/vector.h"
 #include "psi4/libpsi4util/PsiOutStream.h"
+#include "psi4/libpsi4util/process.h"
+#include "psi4/libqt/qt.h"
 
 #include <PCMSolver/PCMInput.h>
 
@@ -183,6 +185,8 @@ PCM::PCM(const std::string &pcmsolver_parsed_fname, int print_level, std::shared
         }
     }
 
+    build_tessera_integrals();
+
     // Compute the nuclear charges, since they don't change
     std::string MEP_n_label("NucMEP");
     std::string ASC_n_label("NucASC");
@@ -211,11 +215,13 @@ PCM::PCM(const PCM *other) {
     basisset_ = other->basisset_;
     my_aotoso_ = other->my_aotoso_->clone();
     potential_int_ = other->potential_int_;
+    tess_ints_ = other->tess_ints_;
     context_ = detail::init_PCMSolver(other->pcmsolver_parsed_fname_, basisset_->molecule());
     pcm_print_ = other->pcm_print_;
 }
 
-SharedVector PCM::compute_electronic_MEP(const SharedMatrix &D) const {
+void PCM::build_tessera_integrals() {
+    // The cavity is fixed for the lifetime of this object, so the unit charge field is set once
     double **pZxyz = tess_Zxyz_->pointer();
     std::vector<std::pair<double, std::array<double, 3>>> field;
     for (int tess = 0; tess < ntess_; ++tess) {
@@ -223,10 +229,42 @@ SharedVector PCM::compute_electronic_MEP(const SharedMatrix &D) const {
     }
     potential_int_->set_charge_field(field);
 
+    size_t nbf = basisset_->nbf();
+    size_t npair = nbf * (nbf + 1) / 2;
+    size_t required = sizeof(double) * npair * ntess_;
+    if (required > Process::environment.get_memory() / 4) {
+        outfile->Printf("  PCM tessera integrals (%.1f MiB) are recomputed every iteration.\n\n",
+                        required / (1024.0 * 1024.0));
+        return;
+    }
+
+    tess_ints_ = std::make_shared<Matrix>("PCM tessera integrals", ntess_, npair);
+    StoreIntegralsFunctor store_functor(tess_ints_);
+    potential_int_->compute(store_functor);
+    outfile->Printf("  PCM tessera integrals (%.1f MiB) are cached for the SCF.\n\n", required / (1024.0 * 1024.0));
+}
+
+SharedVector PCM::compute_electronic_MEP(const SharedMatrix &D) const {
     auto MEP = std::make_shared<Vector>(tesspi_);
-    ContractOverDensityFunctor contract_density_functor(ntess_, MEP->pointer(0), D);
-    // Add in the electronic contribution to the potential at each tessera
-    potential_int_->compute(contract_density_functor);
+
+    if (tess_ints_) {
+        // MEP_t = sum_{mu >= nu} V_{mu nu, t} (D_{mu nu} + D_{nu mu}), diagonal counted once
+        int nbf = basisset_->nbf();
+        double **Dp = D->pointer();
+        std::vector<double> Dtri(tess_ints_->colspi()[0]);
+        for (int mu = 0; mu < nbf; ++mu) {
+            for (int nu = 0; nu < mu; ++nu) {
+                Dtri[mu * (mu + 1L) / 2 + nu] = Dp[mu][nu] + Dp[nu][mu];
+            }
+            Dtri[mu * (mu + 1L) / 2 + mu] = Dp[mu][mu];
+        }
+        C_DGEMV('N', ntess_, Dtri.size(), 1.0, tess_ints_->pointer()[0], Dtri.size(), Dtri.data(), 1, 0.0,
+                MEP->pointer(0), 1);
+    } else {
+        ContractOverDensityFunctor contract_density_functor(ntess_, MEP->pointer(0), D);
+        // Add in the electronic contribution to the potential at each tessera
+        potential_int_->compute(contract_density_functor);
+    }
 
     // A little debug info
     if (pcm_print_ > 2) {
@@ -370,9 +408,23 @@ double PCM::compute_E_electronic(const SharedVector &MEP_e) const {
 }
 
 SharedMatrix PCM::compute_Vpcm(const SharedVector &ASC) const {
-    auto V_pcm = std::make_shared<Matrix>("PCM potential cart", basisset_->nbf(), basisset_->nbf());
-    ContractOverChargesFunctor contract_charges_functor(ASC->pointer(0), V_pcm);
-    potential_int_->compute(contract_charges_functor);
+    int nbf = basisset_->nbf();
+    auto V_pcm = std::make_shared<Matrix>("PCM potential cart", nbf, nbf);
+    if (tess_ints_) {
+        // V_{mu nu} = sum_t q_t V_{mu nu, t}
+        std::vector<double> Vtri(tess_ints_->colspi()[0]);
+        C_DGEMV('T', ntess_, Vtri.size(), 1.0, tess_ints_->pointer()[0], Vtri.size(), ASC->pointer(0), 1, 0.0,
+                Vtri.data(), 1);
+        double **Vp = V_pcm->pointer();
+        for (int mu = 0; mu < nbf; ++mu) {
+            for (int nu = 0; nu <= mu; ++nu) {
+                Vp[mu][nu] = Vp[nu][mu] = Vtri[mu * (mu + 1L) / 2 + nu];
+            }
+        }
+    } else {
+        ContractOverChargesFunctor contract_charges_functor(ASC->pointer(0), V_pcm);
+        potential_int_->compute(contract_charges_functor);
+    }
     return V_pcm;
 }
 }  // namespace psi
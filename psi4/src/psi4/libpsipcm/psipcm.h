@@ -93,6 +93,12 @@ class PCM final {
     /// Factory for the electrostatic integrals
     PCMPotentialInt *potential_int_;
 
+    /// Lower-triangle potential integrals at each tessera (ntess x nbf(nbf+1)/2), computed once
+    /// when they fit in a quarter of the memory; null otherwise, and the integrals are recomputed
+    SharedMatrix tess_ints_;
+    /// Set the unit charge field at the tesserae and, if memory allows, fill tess_ints_
+    void build_tessera_integrals();
+
     /// Handle to stuff provided by PCMSolver
     std::shared_ptr<pcmsolver_context_t> context_;
 
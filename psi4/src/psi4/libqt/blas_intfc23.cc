@@ -35,7 +35,16 @@
 **
 */
 
+#include <algorithm>
 #include <stdexcept>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#ifdef USING_LAPACK_MKL
+#include <mkl.h>
+#endif
 
 #include "psi4/pragma.h"
 #include "psi4/libqt/blas_intfc23_mangle.h"
@@ -44,6 +53,7 @@
 extern "C" {
 extern void F_DGBMV(char*, int*, int*, int*, int*, double*, double*, int*, double*, int*, double*, double*, int*);
 extern void F_DGEMM(char*, char*, int*, int*, int*, double*, double*, int*, double*, int*, double*, double*, int*);
+extern void F_SGEMM(char*, char*, int*, int*, int*, float*, float*, int*, float*, int*, float*, float*, int*);
 extern void F_DGEMV(char*, int*, int*, double*, double*, int*, double*, int*, double*, double*, int*);
 extern void F_DGER(int*, int*, double*, double*, int*, double*, int*, double*, int*);
 extern void F_DSBMV(char*, int*, int*, double*, double*, int*, double*, int*, double*, double*, int*);
@@ -327,6 +337,84 @@ PSI_API void C_DGEMM(char transa, char transb, int m, int n, int k, double alpha
     ::F_DGEMM(&transb, &transa, &n, &m, &k, &alpha, b, &ldb, a, &lda, &beta, c, &ldc);
 }
 
+/**
+ *  Batched C_DGEMM, same (row-major) conventions: the count independent products
+ *  c[i] = alpha * op(a[i]) op(b[i]) + beta * c[i], sharing transposes and prefactors,
+ *  as they arise from a loop over the irrep blocks of a symmetry-blocked matrix.
+ *  The c[i] must not overlap. Empty products are skipped, as in C_DGEMM.
+ *
+ *  With MKL this maps onto cblas_dgemm_batch. Otherwise, when the largest product is
+ *  too small to keep a threaded BLAS busy, the products are spread over OpenMP threads.
+ **/
+PSI_API void C_DGEMM_BATCH(char transa, char transb, int count, const int* m, const int* n, const int* k,
+                           double alpha, double* const* a, const int* lda, double* const* b, const int* ldb,
+                           double beta, double* const* c, const int* ldc) {
+    std::vector<int> live;
+    double max_flops = 0.0;
+    for (int i = 0; i < count; i++) {
+        if (m[i] == 0 || n[i] == 0 || k[i] == 0) continue;
+        live.push_back(i);
+        max_flops = std::max(max_flops, 2.0 * m[i] * n[i] * k[i]);
+    }
+    if (live.empty()) return;
+    if (live.size() == 1) {
+        int i = live[0];
+        C_DGEMM(transa, transb, m[i], n[i], k[i], alpha, a[i], lda[i], b[i], ldb[i], beta, c[i], ldc[i]);
+        return;
+    }
+
+#ifdef USING_LAPACK_MKL
+    // One group per product, the shapes differ between irreps
+    size_t ngroup = live.size();
+    CBLAS_TRANSPOSE ta = ((transa == 't' || transa == 'T') ? CblasTrans : CblasNoTrans);
+    CBLAS_TRANSPOSE tb = ((transb == 't' || transb == 'T') ? CblasTrans : CblasNoTrans);
+    std::vector<CBLAS_TRANSPOSE> ta_array(ngroup, ta), tb_array(ngroup, tb);
+    std::vector<MKL_INT> m_array(ngroup), n_array(ngroup), k_array(ngroup), lda_array(ngroup), ldb_array(ngroup),
+        ldc_array(ngroup), group_size(ngroup, 1);
+    std::vector<double> alpha_array(ngroup, alpha), beta_array(ngroup, beta);
+    std::vector<const double*> a_array(ngroup), b_array(ngroup);
+    std::vector<double*> c_array(ngroup);
+    for (size_t g = 0; g < ngroup; g++) {
+        int i = live[g];
+        m_array[g] = m[i];
+        n_array[g] = n[i];
+        k_array[g] = k[i];
+        lda_array[g] = lda[i];
+        ldb_array[g] = ldb[i];
+        ldc_array[g] = ldc[i];
+        a_array[g] = a[i];
+        b_array[g] = b[i];
+        c_array[g] = c[i];
+    }
+    cblas_dgemm_batch(CblasRowMajor, ta_array.data(), tb_array.data(), m_array.data(), n_array.data(),
+                      k_array.data(), alpha_array.data(), a_array.data(), lda_array.data(), b_array.data(),
+                      ldb_array.data(), beta_array.data(), c_array.data(), ldc_array.data(), (MKL_INT)ngroup,
+                      group_size.data());
+#else
+    // Below about 64^3 multiply-adds a threaded BLAS spends more time forking than computing
+    bool spread = (max_flops < 2.0 * 64 * 64 * 64);
+#ifdef _OPENMP
+    spread = spread && !omp_in_parallel() && omp_get_max_threads() > 1;
+#endif
+    int nlive = live.size();
+#pragma omp parallel for schedule(dynamic) if (spread)
+    for (int g = 0; g < nlive; g++) {
+        int i = live[g];
+        C_DGEMM(transa, transb, m[i], n[i], k[i], alpha, a[i], lda[i], b[i], ldb[i], beta, c[i], ldc[i]);
+    }
+#endif
+}
+
+/**
+ *  Single precision counterpart of C_DGEMM, same (row-major) conventions.
+ *  Used for reduced-precision intermediates where FP32 accuracy suffices.
+ **/
+PSI_API void C_SGEMM(char transa, char transb, int m, int n, int k, float alpha, float* a, int lda, float* b, int ldb,
+                     float beta, float* c, int ldc) {
+    if (m == 0 || n == 0 || k == 0) return;
+    ::F_SGEMM(&transb, &transa, &n, &m, &k, &alpha, b, &ldb, a, &lda, &beta, c, &ldc);
+}
+
 /**
  *  Purpose
  *  =======
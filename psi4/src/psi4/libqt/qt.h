@@ -39,6 +39,8 @@
 #pragma once
 
 #include <string>
+#include <tuple>
+#include <vector>
 
 #include "psi4/pragma.h"
 #include "psi4/psi4-dec.h"
@@ -79,6 +81,14 @@ void parallel_timer_off(const std::string& key, int thread_rank);
 void start_skip_timers();
 void stop_skip_timers();
 void clean_timers();
+void timer_trace_start();
+void timer_trace_stop();
+bool timer_trace_enabled();
+void timer_trace_begin(const std::string& key, int thread_rank);
+void timer_trace_end(const std::string& key, int thread_rank);
+void timer_trace_counter(const std::string& key, double value, int thread_rank);
+std::vector<std::tuple<std::string, std::string, int, double, double>> timer_trace_events();
+void timer_trace_dump(const std::string& filename);
 
 int cc_excited(const char* wfn);
 int cc_excited(std::string wfn);
@@ -127,6 +137,13 @@ void C_DTRSM(char side, char uplo, char transa, char diag, int m, int n, double
 PSI_API
 void C_DGEMM(char transa, char transb, int m, int n, int k, double alpha, double* a, int lda, double* b, int ldb,
              double beta, double* c, int ldc);
+PSI_API
+void C_DGEMM_BATCH(char transa, char transb, int count, const int* m, const int* n, const int* k, double alpha,
+                   double* const* a, const int* lda, double* const* b, const int* ldb, double beta, double* const* c,
+                   const int* ldc);
+PSI_API
+void C_SGEMM(char transa, char transb, int m, int n, int k, float alpha, float* a, int lda, float* b, int ldb,
+             float beta, float* c, int ldc);
 void C_DSYMM(char side, char uplo, int m, int n, double alpha, double* a, int lda, double* b, int ldb, double beta,
              double* c, int ldc);
 void C_DTRMM(char side, char uplo, char transa, char diag, int m, int n, double alpha, double* a, int lda, double* b,
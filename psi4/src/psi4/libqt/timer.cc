@@ -72,17 +72,32 @@
 ** Implemented timer for OpenMP parallism.
 **
 ** Tianyuan Zhang, June 2017
+**
+** Added an optional per-thread event trace on top of the timer tree.
+** While tracing is on (timer_trace_start()), every timer_on/off and
+** parallel_timer_on/off also records a begin/end event stamped with
+** the thread rank, and timer_trace_counter() records running counters
+** (e.g. FLOPs or bytes). timer_trace_dump() writes the events in the
+** Chrome trace event format (chrome://tracing, ui.perfetto.dev), which
+** makes load imbalance between OpenMP threads directly visible.
+**
+** Every serial timer also records the memory high-water mark and the
+** allocations made while it was on, as counted by the memory tracker
+** (libpsi4util/memory_tracker.h). timer_done() lists them per module
+** below the timings, together with the peak resident set of the process.
 */
 
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
 #include <ctime>
+#include <fstream>
 
 #ifdef _MSC_VER
 #include <Winsock2.h>
 #include <winsock.h>
 #else
+#include <sys/resource.h>
 #include <unistd.h>
 #endif
 
@@ -90,7 +105,9 @@
 #include <chrono>
 #include <list>
 #include <map>
+#include <set>
 #include <string>
+#include <tuple>
 #include <utility>
 #include <vector>
 #ifdef _OPENMP
@@ -118,6 +135,7 @@ typedef int omp_lock_t;
 #include "psi4/libciomr/libciomr.h"
 #include "psi4/libpsi4util/PsiOutStream.h"
 #include "psi4/libpsi4util/exception.h"
+#include "psi4/libpsi4util/memory_tracker.h"
 
 /* guess for HZ, if missing */
 #ifndef HZ
@@ -935,6 +953,68 @@ std::time_t timer_start, timer_end;
 bool skip_timers;
 static omp_lock_t lock_timer;
 
+struct Trace_Event {
+    std::string name;
+    char phase;  // 'B'egin, 'E'nd or 'C'ounter
+    int thread;
+    double ts;  // microseconds since timer_trace_start()
+    double value;
+};
+
+static bool trace_on = false;
+static clock::time_point trace_origin;
+static std::vector<Trace_Event> trace_events;
+static std::map<std::pair<std::string, int>, double> trace_counters;
+
+struct Timer_Memory {
+    size_t peak = 0;
+    size_t n_allocations = 0;
+    size_t allocated = 0;
+};
+
+static std::map<std::string, Timer_Memory> timer_memory;
+static size_t memory_last_allocations = 0, memory_last_allocated = 0;
+
+// Callers must hold lock_timer. Charges the memory tracker activity since the previous
+// serial timer event to every serial timer that is on; keys on the stack twice count once.
+static void memory_record() {
+    size_t window = memory_tracker_take_window();
+    size_t n_allocations = memory_tracker_allocations();
+    size_t allocated = memory_tracker_allocated();
+    std::set<std::string> charged;
+    for (const Timer_Structure *timer : ser_on_timers) {
+        const std::string &key = timer->get_key();
+        if (key.empty() || !charged.insert(key).second) continue;
+        Timer_Memory &memory = timer_memory[key];
+        memory.peak = std::max(memory.peak, window);
+        memory.n_allocations += n_allocations - memory_last_allocations;
+        memory.allocated += allocated - memory_last_allocated;
+    }
+    memory_last_allocations = n_allocations;
+    memory_last_allocated = allocated;
+}
+
+// Peak resident set size of the process in bytes, 0 if unknown
+static size_t peak_resident_bytes() {
+#ifdef _MSC_VER
+    return 0;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage)) return 0;
+#ifdef __APPLE__
+    return static_cast<size_t>(usage.ru_maxrss);
+#else
+    return static_cast<size_t>(usage.ru_maxrss) * 1024;
+#endif
+#endif
+}
+
+// Callers must hold lock_timer
+static void trace_record(const std::string &name, char phase, int thread, double value = 0.0) {
+    double ts = std::chrono::duration<double, std::micro>(clock::now() - trace_origin).count();
+    trace_events.push_back({name, phase, thread, ts, value});
+}
+
 void print_timer(const Timer_Structure &timer, std::shared_ptr<PsiOutStream> printer, int align_key_width) {
     std::string key = timer.get_key();
     if (key.length() < align_key_width) {
@@ -992,6 +1072,10 @@ void timer_init() {
     ser_on_timers.push_back(&root_timer);
     extern bool skip_timers;
     skip_timers = false;
+    timer_memory.clear();
+    memory_tracker_take_window();
+    memory_last_allocations = memory_tracker_allocations();
+    memory_last_allocated = memory_tracker_allocated();
     omp_unset_lock(&lock_timer);
 }
 
@@ -1033,6 +1117,21 @@ void timer_done() {
         print_timer(*timer_iter, printer, 36);
     }
 
+    if (!timer_memory.empty()) {
+        const double MiB = 1024.0 * 1024.0;
+        printer->Printf("\n                                                       Memory (MiB)\n");
+        printer->Printf("Module                               %12s%12s%13s\n", "Peak", "Allocated", "Allocations");
+        for (const auto &kv : timer_memory) {
+            std::string key = kv.first;
+            if (key.length() < 36) key.resize(36, ' ');
+            printer->Printf("%s: %10.1f  %10.1f  %11zu\n", key.c_str(), kv.second.peak / MiB,
+                            kv.second.allocated / MiB, kv.second.n_allocations);
+        }
+        printer->Printf("\nPeak tracked memory:  %10.1f MiB\n", memory_tracker_peak() / MiB);
+        size_t resident = peak_resident_bytes();
+        if (resident) printer->Printf("Peak resident memory: %10.1f MiB\n", resident / MiB);
+    }
+
     printer->Printf("\n--------------------------------------------------------------------------------------\n");
 
     print_nested_timer(root_timer, printer, "");
@@ -1090,6 +1189,7 @@ PSI_API void timer_on(const std::string &key) {
         throw PsiException(str, __FILE__, __LINE__);
     }
     extern std::list<Timer_Structure *> ser_on_timers;
+    memory_record();
     Timer_Structure *top_timer_ptr = nullptr;
     Timer_Structure *top_timer = ser_on_timers.back();
     if (key == top_timer->get_key()) {
@@ -1099,6 +1199,7 @@ PSI_API void timer_on(const std::string &key) {
         ser_on_timers.push_back(top_timer_ptr);
         top_timer_ptr->turn_on();
     }
+    if (trace_on) trace_record(key, 'B', 0);
     omp_unset_lock(&lock_timer);
 }
 
@@ -1126,6 +1227,7 @@ PSI_API void timer_off(const std::string &key) {
         str += " when parallel timers are not all off.";
         throw PsiException(str, __FILE__, __LINE__);
     }
+    memory_record();
     Timer_Structure *timer_ptr = nullptr;
     timer_ptr = ser_on_timers.back();
     if (key == timer_ptr->get_key()) {
@@ -1170,6 +1272,7 @@ PSI_API void timer_off(const std::string &key) {
             parent_ptr = on_child_ptr;
         }
     }
+    if (trace_on) trace_record(key, 'E', 0);
     omp_unset_lock(&lock_timer);
 }
 
@@ -1213,6 +1316,7 @@ void parallel_timer_on(const std::string &key, int thread_rank) {
             top_timer_ptr->turn_on(thread_rank);
         }
     }
+    if (trace_on) trace_record(key, 'B', thread_rank);
     omp_unset_lock(&lock_timer);
 }
 
@@ -1292,6 +1396,150 @@ void parallel_timer_off(const std::string &key, int thread_rank) {
         parallel_timer.get_parent()->merge_move_all(&parallel_timer);
         parallel_timer.set_parent(nullptr);
     }
+    if (trace_on) trace_record(key, 'E', thread_rank);
+    omp_unset_lock(&lock_timer);
+}
+
+/*!
+** timer_trace_start(): Discard any previous trace and start recording
+** timer events and counters.
+**
+** \ingroup QT
+*/
+void timer_trace_start() {
+    omp_set_lock(&lock_timer);
+    trace_events.clear();
+    trace_counters.clear();
+    trace_origin = clock::now();
+    trace_on = true;
+    omp_unset_lock(&lock_timer);
+}
+
+/*!
+** timer_trace_stop(): Stop recording. Recorded events are kept until the
+** next timer_trace_start().
+**
+** \ingroup QT
+*/
+void timer_trace_stop() {
+    omp_set_lock(&lock_timer);
+    trace_on = false;
+    omp_unset_lock(&lock_timer);
+}
+
+bool timer_trace_enabled() { return trace_on; }
+
+/*!
+** timer_trace_begin()/timer_trace_end(): Record a span on the trace only,
+** without touching the timer tree. Meant for fine-grained work items
+** (e.g. one task of a dynamic OpenMP loop) that would clutter timer.dat.
+** Both are no-ops unless tracing is on.
+**
+** \param key         = Name of the span
+** \param thread_rank = OpenMP thread number
+**
+** \ingroup QT
+*/
+void timer_trace_begin(const std::string &key, int thread_rank) {
+    if (!trace_on) return;
+    omp_set_lock(&lock_timer);
+    if (trace_on) trace_record(key, 'B', thread_rank);
+    omp_unset_lock(&lock_timer);
+}
+
+void timer_trace_end(const std::string &key, int thread_rank) {
+    if (!trace_on) return;
+    omp_set_lock(&lock_timer);
+    if (trace_on) trace_record(key, 'E', thread_rank);
+    omp_unset_lock(&lock_timer);
+}
+
+/*!
+** timer_trace_counter(): Add to the running counter with the given name on
+** one thread (e.g. FLOPs or bytes moved) and record its new value.
+** No-op unless tracing is on.
+**
+** \param key         = Name of the counter
+** \param value       = Increment
+** \param thread_rank = OpenMP thread number
+**
+** \ingroup QT
+*/
+void timer_trace_counter(const std::string &key, double value, int thread_rank) {
+    if (!trace_on) return;
+    omp_set_lock(&lock_timer);
+    if (trace_on) {
+        double &total = trace_counters[std::make_pair(key, thread_rank)];
+        total += value;
+        trace_record(key, 'C', thread_rank, total);
+    }
+    omp_unset_lock(&lock_timer);
+}
+
+/*!
+** timer_trace_events(): Copy of the recorded events as
+** (name, phase, thread, time [us], counter value) tuples.
+**
+** \ingroup QT
+*/
+std::vector<std::tuple<std::string, std::string, int, double, double>> timer_trace_events() {
+    std::vector<std::tuple<std::string, std::string, int, double, double>> events;
+    omp_set_lock(&lock_timer);
+    events.reserve(trace_events.size());
+    for (const auto &ev : trace_events) {
+        events.emplace_back(ev.name, std::string(1, ev.phase), ev.thread, ev.ts, ev.value);
+    }
+    omp_unset_lock(&lock_timer);
+    return events;
+}
+
+static std::string trace_escape(const std::string &str) {
+    std::string out;
+    out.reserve(str.size());
+    for (char c : str) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            out += ' ';
+        } else {
+            out += c;
+        }
+    }
+    return out;
+}
+
+/*!
+** timer_trace_dump(): Write the recorded events to a Chrome trace event
+** JSON file. Each OpenMP thread is shown as its own track.
+**
+** \param filename = Name of the JSON file
+**
+** \ingroup QT
+*/
+void timer_trace_dump(const std::string &filename) {
+    omp_set_lock(&lock_timer);
+    std::ofstream out(filename);
+    if (!out) {
+        omp_unset_lock(&lock_timer);
+        throw PsiException("Unable to open trace file " + filename, __FILE__, __LINE__);
+    }
+    std::vector<char> buf(64);
+    out << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+    bool first = true;
+    for (const auto &ev : trace_events) {
+        out << (first ? "\n" : ",\n");
+        first = false;
+        std::snprintf(buf.data(), buf.size(), "%.3f", ev.ts);
+        out << "{\"name\": \"" << trace_escape(ev.name) << "\", \"ph\": \"" << ev.phase
+            << "\", \"pid\": 0, \"tid\": " << ev.thread << ", \"ts\": " << buf.data();
+        if (ev.phase == 'C') {
+            std::snprintf(buf.data(), buf.size(), "%.17g", ev.value);
+            out << ", \"args\": {\"value\": " << buf.data() << "}";
+        }
+        out << "}";
+    }
+    out << "\n]}\n";
     omp_unset_lock(&lock_timer);
 }
 }  // namespace psi
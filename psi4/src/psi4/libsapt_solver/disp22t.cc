@@ -27,6 +27,7 @@
  */
 
 #include <ctime>
+#include <future>
 
 #include "sapt2p.h"
 #include "psi4/libciomr/libciomr.h"
@@ -276,7 +277,7 @@ double SAPT2p::disp220t(int AAfile, const char *AAlabel, const char *ARlabel, co
     double **B_p_AA = get_DF_ints(AAfile, AAlabel, foccA, noccA, foccA, noccA);
     double **B_p_AR = get_DF_ints(AAfile, ARlabel, foccA, noccA, 0, nvirA);
     double **B_p_RR = get_DF_ints(AAfile, RRlabel, 0, nvirA, 0, nvirA);
-    double *B_p_bs = init_array(ndf_ + 3);
+    double **B_p_BS = get_DF_ints(BBfile, BSlabel, foccB, noccB, 0, nvirB);
 
     double **C_p_AR = block_matrix(aoccA * nvirA, ndf_ + 3);
 
@@ -288,9 +289,7 @@ double SAPT2p::disp220t(int AAfile, const char *AAlabel, const char *ARlabel, co
 
     for (size_t b = 0, bs = 0; b < aoccB; b++) {
         for (int s = 0; s < nvirB; s++, bs++) {
-            psio_address next_DF_BS = psio_get_address(
-                PSIO_ZERO, sizeof(double) * (b + foccB) * nvirB * (ndf_ + 3) + sizeof(double) * s * (ndf_ + 3));
-            psio_->read(BBfile, BSlabel, (char *)&(B_p_bs[0]), sizeof(double) * (ndf_ + 3), next_DF_BS, &next_DF_BS);
+            double *B_p_bs = B_p_BS[bs];
 
             C_DGEMV('n', aoccA * nvirA, ndf_ + 3, 1.0, B_p_AR[0], ndf_ + 3, B_p_bs, 1, 0.0, tbsAR[0], 1);
 
@@ -315,18 +314,19 @@ double SAPT2p::disp220t(int AAfile, const char *AAlabel, const char *ARlabel, co
             C_DGEMM('N', 'T', aoccA * nvirA, aoccA * nvirA, ndf_ + 3, 1.0, &(B_p_AR[0][0]), ndf_ + 3, &(C_p_AR[0][0]),
                     ndf_ + 3, 1.0, &(wARAR[0][0]), aoccA * nvirA);
 
-            for (int a = 0, ar = 0; a < aoccA; a++) {
-                for (int r = 0; r < nvirA; r++, ar++) {
-                    for (int a1 = 0, a1r1 = 0; a1 < aoccA; a1++) {
-                        for (int r1 = 0; r1 < nvirA; r1++, a1r1++) {
-                            int a1r = a1 * nvirA + r;
-                            int ar1 = a * nvirA + r1;
-                            double tval1 = wARAR[ar][a1r1] + wARAR[a1r1][ar];
-                            double tval2 = wARAR[a1r][ar1] + wARAR[ar1][a1r];
-                            double denom = evalsA[a + foccA] + evalsA[a1 + foccA] + evalsB[b + foccB] -
-                                           evalsA[r + noccA] - evalsA[r1 + noccA] - evalsB[s + noccB];
-                            energy += ((4.0 * tval1 - 2.0 * tval2) * tval1) / denom;
-                        }
+#pragma omp parallel for schedule(static) reduction(+ : energy)
+            for (int ar = 0; ar < (int)(aoccA * nvirA); ar++) {
+                int a = ar / nvirA;
+                int r = ar % nvirA;
+                for (int a1 = 0, a1r1 = 0; a1 < aoccA; a1++) {
+                    for (int r1 = 0; r1 < nvirA; r1++, a1r1++) {
+                        int a1r = a1 * nvirA + r;
+                        int ar1 = a * nvirA + r1;
+                        double tval1 = wARAR[ar][a1r1] + wARAR[a1r1][ar];
+                        double tval2 = wARAR[a1r][ar1] + wARAR[ar1][a1r];
+                        double denom = evalsA[a + foccA] + evalsA[a1 + foccA] + evalsB[b + foccB] -
+                                       evalsA[r + noccA] - evalsA[r1 + noccA] - evalsB[s + noccB];
+                        energy += ((4.0 * tval1 - 2.0 * tval2) * tval1) / denom;
                     }
                 }
             }
@@ -337,7 +337,7 @@ double SAPT2p::disp220t(int AAfile, const char *AAlabel, const char *ARlabel, co
         }
     }
 
-    free(B_p_bs);
+    free_block(B_p_BS);
     free_block(wARAR);
     free_block(vbsAA);
     free_block(vbsRR);
@@ -370,9 +370,14 @@ double SAPT2p::disp220tccd(int AAnum, const char *AA_label, int Rnum, const char
     double **B_p_AA = get_DF_ints_nongimp(AAnum, AA_label, foccA, noccA + foccA, foccA, noccA + foccA);
     double **B_p_AR = get_DF_ints_nongimp(Rnum, AR_label, foccA, noccA + foccA, 0, nvirA);
     double **B_p_RR = get_DF_ints_nongimp(Rnum, RR_label, 0, nvirA, 0, nvirA);
-    double *B_p_bs = init_array(ndf_);
-
-    double **t_bsAR = block_matrix(noccA, nvirA);
+    double **B_p_BS = get_DF_ints(BBnum, BS_label, foccB, noccB + foccB, 0, nvirB);
+
+    // Amplitude rows t_bs(AR) on disk are double-buffered: the row for the next bs is read
+    // while the current one is contracted. This is the only disk access inside the bs loop.
+    double **t_bsAR_buf[2];
+    t_bsAR_buf[0] = block_matrix(noccA, nvirA);
+    t_bsAR_buf[1] = ampnum ? block_matrix(noccA, nvirA) : nullptr;
+    double **t_bsAR = t_bsAR_buf[0];
     double **t_ARAR;
 
     psio_address next_ARAR;
@@ -413,24 +418,31 @@ double SAPT2p::disp220tccd(int AAnum, const char *AA_label, int Rnum, const char
     C_DGEMM('N', 'T', noccA * nvirA, noccA * noccA, ndf_, 1.0, &(B_p_AR[0][0]), ndf_, &(B_p_AA[0][0]), ndf_, 0.0,
             &(v_ARAA[0][0]), noccA * noccA);
 
-    psio_address next_BSAR;
+    auto read_t_bsAR = [&](size_t bs, double **t) {
+        psio_address next_BSAR;
+        if (ampnum == PSIF_SAPT_CCD) {
+            next_BSAR = psio_get_address(PSIO_ZERO, bs * noccA * nvirA * sizeof(double));
+        } else {
+            next_BSAR = psio_get_address(
+                PSIO_ZERO, ((foccB * nvirB + bs) * (noccA + foccA) * nvirA + foccA * nvirA) * sizeof(double));
+        }
+        psio_->read(ampnum, tbsar, (char *)t[0], sizeof(double) * noccA * nvirA, next_BSAR, &next_BSAR);
+    };
+    std::future<void> t_next;
+    if (ampnum) t_next = std::async(std::launch::async, read_t_bsAR, 0, t_bsAR_buf[0]);
 
     std::time_t start = std::time(nullptr);
     std::time_t stop;
 
     for (size_t b = 0, bs = 0; b < noccB; b++) {
         for (int s = 0; s < nvirB; s++, bs++) {
-            psio_address next_DF_BS =
-                psio_get_address(PSIO_ZERO, ((foccB + b) * nvirB + s) * (ndf_ + 3) * (size_t)sizeof(double));
-            psio_->read(BBnum, BS_label, (char *)&(B_p_bs[0]), sizeof(double) * ndf_, next_DF_BS, &next_DF_BS);
-
-            if (ampnum == PSIF_SAPT_CCD) {
-                next_BSAR = psio_get_address(PSIO_ZERO, bs * noccA * nvirA * sizeof(double));
-                psio_->read(ampnum, tbsar, (char *)t_bsAR[0], sizeof(double) * noccA * nvirA, next_BSAR, &next_BSAR);
-            } else if (ampnum) {
-                next_BSAR = psio_get_address(
-                    PSIO_ZERO, ((foccB * nvirB + bs) * (noccA + foccA) * nvirA + foccA * nvirA) * sizeof(double));
-                psio_->read(ampnum, tbsar, (char *)t_bsAR[0], sizeof(double) * noccA * nvirA, next_BSAR, &next_BSAR);
+            double *B_p_bs = B_p_BS[bs];
+
+            if (ampnum) {
+                t_next.get();
+                t_bsAR = t_bsAR_buf[bs % 2];
+                if (bs + 1 < noccB * nvirB)
+                    t_next = std::async(std::launch::async, read_t_bsAR, bs + 1, t_bsAR_buf[(bs + 1) % 2]);
             } else {
                 C_DGEMV('n', noccA * nvirA, ndf_, 1.0, B_p_AR[0], ndf_, B_p_bs, 1, 0.0, t_bsAR[0], 1);
 
@@ -457,19 +469,20 @@ double SAPT2p::disp220tccd(int AAnum, const char *AA_label, int Rnum, const char
             C_DGEMM('N', 'T', noccA * nvirA, noccA * nvirA, ndf_, 1.0, &(B_p_AR[0][0]), ndf_, &(C_p_AR[0][0]), ndf_,
                     1.0, &(w_ARAR[0][0]), noccA * nvirA);
 
-            for (int a = 0, ar = 0; a < noccA; a++) {
-                for (int r = 0; r < nvirA; r++, ar++) {
-                    for (int a1 = 0, a1r1 = 0; a1 < noccA; a1++) {
-                        for (int r1 = 0; r1 < nvirA; r1++, a1r1++) {
-                            int a1r = a1 * nvirA + r;
-                            int ar1 = a * nvirA + r1;
-                            double tval1 = w_ARAR[ar][a1r1] + w_ARAR[a1r1][ar];
-                            double tval2 = w_ARAR[a1r][ar1] + w_ARAR[ar1][a1r];
-                            double denom = evalsA[a + foccA] + evalsA[a1 + foccA] + evalsB[b + foccB] -
-                                           evalsA[r + noccA + foccA] - evalsA[r1 + noccA + foccA] -
-                                           evalsB[s + noccB + foccB];
-                            energy += ((4.0 * tval1 - 2.0 * tval2) * tval1) / denom;
-                        }
+#pragma omp parallel for schedule(static) reduction(+ : energy)
+            for (int ar = 0; ar < (int)(noccA * nvirA); ar++) {
+                int a = ar / nvirA;
+                int r = ar % nvirA;
+                for (int a1 = 0, a1r1 = 0; a1 < noccA; a1++) {
+                    for (int r1 = 0; r1 < nvirA; r1++, a1r1++) {
+                        int a1r = a1 * nvirA + r;
+                        int ar1 = a * nvirA + r1;
+                        double tval1 = w_ARAR[ar][a1r1] + w_ARAR[a1r1][ar];
+                        double tval2 = w_ARAR[a1r][ar1] + w_ARAR[ar1][a1r];
+                        double denom = evalsA[a + foccA] + evalsA[a1 + foccA] + evalsB[b + foccB] -
+                                       evalsA[r + noccA + foccA] - evalsA[r1 + noccA + foccA] -
+                                       evalsB[s + noccB + foccB];
+                        energy += ((4.0 * tval1 - 2.0 * tval2) * tval1) / denom;
                     }
                 }
             }
@@ -478,13 +491,14 @@ double SAPT2p::disp220tccd(int AAnum, const char *AA_label, int Rnum, const char
         outfile->Printf("    (i = %3zu of %3zu) %10ld seconds\n", b + 1, noccB, stop - start);
     }
 
-    free(B_p_bs);
+    free_block(B_p_BS);
     free_block(w_ARAR);
     free_block(v_bsAA);
     free_block(v_bsRR);
     free_block(v_ARAA);
     free_block(t_ARAR);
-    free_block(t_bsAR);
+    free_block(t_bsAR_buf[0]);
+    if (ampnum) free_block(t_bsAR_buf[1]);
     free_block(B_p_AA);
     free_block(B_p_AR);
     free_block(B_p_RR);
@@ -103,22 +103,19 @@ double SAPT2p3::disp30_1(int ampfile, const char *amplabel, int AAintfile, const
     double **B_p_RR = block_matrix(nvirA * (nvirA + 1) / 2, ndf_ + 3);
     double **B_p_SS = block_matrix(nvirB * (nvirB + 1) / 2, ndf_ + 3);
 
-    for (int r1 = 0, r1r2 = 0; r1 < nvirA; r1++) {
-        for (int r2 = 0; r2 <= r1; r2++, r1r2++) {
-            next_DF_RR = psio_get_address(PSIO_ZERO, sizeof(double) * (r1 * nvirA + r2) * (ndf_ + 3));
-            psio_->read(AAintfile, RRlabel, (char *)&(B_p_RR[r1r2][0]), sizeof(double) * (ndf_ + 3), next_DF_RR,
-                        &next_DF_RR);
-            if (r1 != r2) C_DSCAL(ndf_ + 3, 2.0, B_p_RR[r1r2], 1);
-        }
+    // The r2 <= r1 rows of each r1 are contiguous on disk, so read them in one go
+    for (int r1 = 0; r1 < nvirA; r1++) {
+        next_DF_RR = psio_get_address(PSIO_ZERO, sizeof(double) * r1 * nvirA * (ndf_ + 3));
+        psio_->read(AAintfile, RRlabel, (char *)&(B_p_RR[ioff_[r1]][0]), sizeof(double) * (r1 + 1) * (ndf_ + 3),
+                    next_DF_RR, &next_DF_RR);
+        C_DSCAL(r1 * (ndf_ + 3), 2.0, B_p_RR[ioff_[r1]], 1);
     }
 
-    for (int s1 = 0, s1s2 = 0; s1 < nvirB; s1++) {
-        for (int s2 = 0; s2 <= s1; s2++, s1s2++) {
-            next_DF_SS = psio_get_address(PSIO_ZERO, sizeof(double) * (s1 * nvirB + s2) * (ndf_ + 3));
-            psio_->read(BBintfile, SSlabel, (char *)&(B_p_SS[s1s2][0]), sizeof(double) * (ndf_ + 3), next_DF_SS,
-                        &next_DF_SS);
-            if (s1 != s2) C_DSCAL(ndf_ + 3, 2.0, B_p_SS[s1s2], 1);
-        }
+    for (int s1 = 0; s1 < nvirB; s1++) {
+        next_DF_SS = psio_get_address(PSIO_ZERO, sizeof(double) * s1 * nvirB * (ndf_ + 3));
+        psio_->read(BBintfile, SSlabel, (char *)&(B_p_SS[ioff_[s1]][0]), sizeof(double) * (s1 + 1) * (ndf_ + 3),
+                    next_DF_SS, &next_DF_SS);
+        C_DSCAL(s1 * (ndf_ + 3), 2.0, B_p_SS[ioff_[s1]], 1);
     }
 
     double **xRS = block_matrix(nvirA, nvirB * nvirB);
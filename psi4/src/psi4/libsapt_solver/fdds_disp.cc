@@ -547,6 +547,120 @@ SharedMatrix FDDS_Dispersion::form_unc_amplitude(std::string monomer, double ome
     return ret;
 }
 
+std::vector<SharedMatrix> FDDS_Dispersion::form_unc_amplitudes(std::string monomer, std::vector<double> omegas) {
+    // ==> Configuration <==
+    SharedVector eps_occ, eps_vir;
+    std::string ovQ_tensor_name;
+
+    if (monomer == "A") {
+        eps_occ = vector_cache_["eps_occ_A"];
+        eps_vir = vector_cache_["eps_vir_A"];
+        ovQ_tensor_name = "arQ";
+    } else if (monomer == "B") {
+        eps_occ = vector_cache_["eps_occ_B"];
+        eps_vir = vector_cache_["eps_vir_B"];
+        ovQ_tensor_name = "bsQ";
+    } else {
+        throw PSIEXCEPTION("FDDS_Dispersion::form_unc_amplitudes: Monomer must be A or B!");
+    }
+
+    // Sizes
+    size_t nocc = eps_occ->dim(0);
+    size_t nvir = eps_vir->dim(0);
+    size_t naux = auxiliary_->nbf();
+    size_t nomega = omegas.size();
+
+    // Every frequency keeps its PQ result and ov amplitudes resident, and each (ar|Q) block is
+    // staged once and rescaled per frequency, so we need room for two blocks on top of that
+    size_t doubles = Process::environment.get_memory() * 0.8 / sizeof(double);
+    size_t fixed = nomega * (naux * naux + nvir * nocc);
+    size_t mem_size = fixed + 2 * naux * nvir;
+    if (mem_size > doubles) {
+        std::stringstream message;
+        double mem_gb = ((double)(mem_size) / 0.8 * sizeof(double));
+        message << "FDDS Dispersion requires at least nomega * (naux * naux + nocc * nvir) + 2 * naux * nvir of memory."
+                << std::endl;
+        message << "       After taxes this is " << std::setprecision(2) << mem_gb << " GB of memory.";
+        throw PSIEXCEPTION(message.str());
+    }
+
+    // ==> Uncoupled Amplitudes <==
+    auto eoccp = eps_occ->pointer();
+    auto evirp = eps_vir->pointer();
+
+    std::vector<SharedMatrix> amps(nomega);
+    for (size_t w = 0; w < nomega; w++) {
+        amps[w] = std::make_shared<Matrix>(nocc, nvir);
+        double** ampp = amps[w]->pointer();
+        double omega = omegas[w];
+
+#pragma omp parallel for
+        for (size_t i = 0; i < nocc; i++) {
+            for (size_t a = 0; a < nvir; a++) {
+                double val = -1.0 * (eoccp[i] - evirp[a]);
+                double tmp = 4.0 * val / (val * val + omega * omega);
+                if (tmp < 1.e-14) {
+                    ampp[i][a] = 0.0;
+                } else {
+                    ampp[i][a] = std::pow(tmp, 0.5);
+                }
+            }
+        }
+    }
+
+    // ==> Contract <==
+
+    size_t bsize = (doubles - fixed) / (2 * naux * nvir);
+    if (bsize > nocc) {
+        bsize = nocc;
+    }
+    size_t nblocks = 1 + ((nocc - 1) / bsize);
+
+    std::vector<SharedMatrix> ret(nomega);
+    for (size_t w = 0; w < nomega; w++) {
+        ret[w] = std::make_shared<Matrix>("UNC Amplitude", naux, naux);
+    }
+    auto raw = std::make_shared<Matrix>("arQ", bsize * nvir, naux);
+    auto tmp = std::make_shared<Matrix>("arQ tmp", bsize * nvir, naux);
+
+    double** rawp = raw->pointer();
+    double** tmpp = tmp->pointer();
+
+    size_t osize;
+    for (size_t block = 0, bcount = 0; block < nblocks; block++) {
+        if (((block + 1) * bsize) > nocc) {
+            osize = nocc - block * bsize;
+        } else {
+            osize = bsize;
+        }
+
+        raw->zero();
+        dfh_->fill_tensor(ovQ_tensor_name, raw, {bcount, bcount + osize});
+        size_t shift_i = block * bsize;
+
+        for (size_t w = 0; w < nomega; w++) {
+            double** ampp = amps[w]->pointer();
+            tmp->zero();
+
+#pragma omp parallel for collapse(2)
+            for (size_t i = 0; i < osize; i++) {
+                for (size_t a = 0; a < nvir; a++) {
+                    double val = ampp[i + shift_i][a];
+#pragma omp simd
+                    for (size_t Q = 0; Q < naux; Q++) {
+                        tmpp[i * nvir + a][Q] = val * rawp[i * nvir + a][Q];
+                    }
+                }
+            }
+
+            ret[w]->gemm(true, false, 1.0, tmp, tmp, 1.0);
+        }
+        bcount += osize;
+    }
+
+    return ret;
+}
+
 std::map<std::string, SharedMatrix> FDDS_Dispersion::form_aux_matrices(std::string monomer, double omega){
 
     // => Configuration <= //
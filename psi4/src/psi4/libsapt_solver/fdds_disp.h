@@ -99,6 +99,15 @@ class FDDS_Dispersion {
      */
     SharedMatrix form_unc_amplitude(std::string monomer, double omega);
 
+    /**
+     * Forms the uncoupled amplitudes for several frequencies at once, reading each
+     * Qia block a single time and contracting it for every frequency
+     * @param  monomer Monomer "A" or "B"
+     * @param  omegas  Time dependent values
+     * @return         "PQ" amplitude for each omega, in order
+     */
+    std::vector<SharedMatrix> form_unc_amplitudes(std::string monomer, std::vector<double> omegas);
+
     /**
      * Forms the uncoupled amplitude and other PQ matrices in hybrid FDDS dispersion
      * @param  monomer Monomer "A" or "B"
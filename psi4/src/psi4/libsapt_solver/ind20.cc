@@ -89,7 +89,7 @@ void SAPT0::ind20() {
 }
 
 void SAPT0::ind20r() {
-    if (aio_cphf_) {
+    if (aio_cphf_ && df_cache_.empty()) {
         ind20rA_B_aio();
         ind20rB_A_aio();
     } else {
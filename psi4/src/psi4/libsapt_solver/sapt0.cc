@@ -71,6 +71,7 @@ SAPT0::SAPT0(SharedWavefunction Dimer, SharedWavefunction MonomerA, SharedWavefu
     no_response_ = !options_.get_bool("COUPLED_INDUCTION");
     aio_cphf_ = options_.get_bool("AIO_CPHF");
     aio_dfints_ = options_.get_bool("AIO_DF_INTS");
+    incore_dfints_ = options_.get_bool("INCORE_DF_INTS");
     do_e10_ = options_.get_bool("SAPT0_E10");
     do_e20ind_ = options_.get_bool("SAPT0_E20IND");
     do_e20disp_ = options_.get_bool("SAPT0_E20DISP");
@@ -108,6 +109,7 @@ double SAPT0::compute_energy() {
         df_integrals_aio();
     else
         df_integrals();
+    if (incore_dfints_) cache_df_ints();
     timer_off("SAPT0: DF Integrals");
     timer_on("SAPT0: W Integrals");
     w_integrals();
@@ -34,6 +34,11 @@
 #include "psi4/libpsio/config.h"
 #include "psi4/libmints/matrix.h"
 
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
 namespace psi {
 namespace sapt {
 
@@ -93,6 +98,9 @@ class SAPT0 : public SAPT {
     Iterator get_iterator(long int, SAPTDFInts *, SAPTDFInts *, bool alloc = true);
     Iterator set_iterator(long int, SAPTDFInts *, SAPTDFInts *, bool alloc = true);
 
+    void cache_df_ints();
+    void read_df(SAPTDFInts *, double *, size_t);
+
     void read_all(SAPTDFInts *);
     void read_block(Iterator *, SAPTDFInts *);
     void read_block(Iterator *, SAPTDFInts *, SAPTDFInts *);
@@ -130,6 +138,7 @@ class SAPT0 : public SAPT {
     bool no_response_;
     bool aio_cphf_;
     bool aio_dfints_;
+    bool incore_dfints_;
     bool do_e10_;
     bool do_e20ind_;
     bool do_e20disp_;
@@ -157,6 +166,9 @@ class SAPT0 : public SAPT {
     double **wBAR_;
     double **wABS_;
 
+    /// DF integral entries held in core, keyed by (PSIO unit, TOC label)
+    std::map<std::pair<int, std::string>, std::vector<double>> df_cache_;
+
    public:
     SAPT0(SharedWavefunction Dimer, SharedWavefunction MonomerA, SharedWavefunction MonomerB, Options &options,
           std::shared_ptr<PSIO> psio);
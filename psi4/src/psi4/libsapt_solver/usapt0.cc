@@ -1747,6 +1747,7 @@ void CPKS_USAPT0::preconditioner(std::shared_ptr<Matrix> r, std::shared_ptr<Matr
     double* op = o->pointer();
     double* vp = v->pointer();
 
+#pragma omp parallel for
     for (int i = 0; i < no; i++) {
         for (int a = 0; a < nv; a++) {
             zp[i][a] = rp[i][a] / (vp[a] - op[i]);
@@ -1862,14 +1863,16 @@ std::map<std::string, std::shared_ptr<Matrix> > CPKS_USAPT0::product(
             }
         }
         if (alpha_A) {
+            // K + K^T, symmetrized in place rather than through a transposed copy
+            Kva->hermitivitize();
             Jva->copy(T);
-            Jva->subtract(Kva);
-            Jva->subtract(Kva->transpose());
+            Jva->axpy(-2.0, Kva);
         }
         if (beta_A) {
+            // K + K^T, symmetrized in place rather than through a transposed copy
+            Kvb->hermitivitize();
             Jvb->copy(T);
-            Jvb->subtract(Kvb);
-            Jvb->subtract(Kvb->transpose());
+            Jvb->axpy(-2.0, Kvb);
         }
 
         int no = b["Aa"]->nrow();
@@ -1889,6 +1892,7 @@ std::map<std::string, std::shared_ptr<Matrix> > CPKS_USAPT0::product(
             double** bp = b["Aa"]->pointer();
             double* op = eps_occa_A_->pointer();
             double* vp = eps_vira_A_->pointer();
+#pragma omp parallel for
             for (int i = 0; i < no; i++) {
                 for (int a = 0; a < nv; a++) {
                     Sp[i][a] += bp[i][a] * (vp[a] - op[i]);
@@ -1914,6 +1918,7 @@ std::map<std::string, std::shared_ptr<Matrix> > CPKS_USAPT0::product(
             double** bp = b["Ab"]->pointer();
             double* op = eps_occb_A_->pointer();
             double* vp = eps_virb_A_->pointer();
+#pragma omp parallel for
             for (int i = 0; i < no; i++) {
                 for (int a = 0; a < nv; a++) {
                     Sp[i][a] += bp[i][a] * (vp[a] - op[i]);
@@ -1946,14 +1951,16 @@ std::map<std::string, std::shared_ptr<Matrix> > CPKS_USAPT0::product(
             }
         }
         if (alpha_B) {
+            // K + K^T, symmetrized in place rather than through a transposed copy
+            Kva->hermitivitize();
             Jva->copy(T);
-            Jva->subtract(Kva);
-            Jva->subtract(Kva->transpose());
+            Jva->axpy(-2.0, Kva);
         }
         if (beta_B) {
+            // K + K^T, symmetrized in place rather than through a transposed copy
+            Kvb->hermitivitize();
             Jvb->copy(T);
-            Jvb->subtract(Kvb);
-            Jvb->subtract(Kvb->transpose());
+            Jvb->axpy(-2.0, Kvb);
         }
 
         int no = b["Ba"]->nrow();
@@ -1973,6 +1980,7 @@ std::map<std::string, std::shared_ptr<Matrix> > CPKS_USAPT0::product(
             double** bp = b["Ba"]->pointer();
             double* op = eps_occa_B_->pointer();
             double* vp = eps_vira_B_->pointer();
+#pragma omp parallel for
             for (int i = 0; i < no; i++) {
                 for (int a = 0; a < nv; a++) {
                     Sp[i][a] += bp[i][a] * (vp[a] - op[i]);
@@ -1999,6 +2007,7 @@ std::map<std::string, std::shared_ptr<Matrix> > CPKS_USAPT0::product(
             double** bp = b["Bb"]->pointer();
             double* op = eps_occb_B_->pointer();
             double* vp = eps_virb_B_->pointer();
+#pragma omp parallel for
             for (int i = 0; i < no; i++) {
                 for (int a = 0; a < nv; a++) {
                     Sp[i][a] += bp[i][a] * (vp[a] - op[i]);
@@ -33,8 +33,10 @@
 #include "psi4/libpsio/psio.hpp"
 #include "psi4/libpsio/psio.h"
 #include "psi4/libqt/qt.h"
+#include "psi4/libpsi4util/PsiOutStream.h"
 
 #include <cmath>
+#include <tuple>
 
 namespace psi {
 namespace sapt {
@@ -49,6 +51,68 @@ void SAPT::zero_disk(int file, const char *array, int rows, int columns) {
     free(zero);
 }
 
+/*
+ * Copies every (P|ij) entry of the AA, BB and AB DF files into core once they
+ * are formed, so that read_all and read_block are served by memory copies for
+ * the rest of the computation. The files themselves are kept for the direct
+ * readers (AIO CPHF, exch-disp intermediates). If the entries need more than
+ * half of the SAPT memory the integrals stay on disk; otherwise their size
+ * comes off mem_ so that the blocking downstream stays within the budget.
+ */
+void SAPT0::cache_df_ints() {
+    const std::vector<std::tuple<int, std::string, size_t>> entries = {
+        std::make_tuple(PSIF_SAPT_AA_DF_INTS, "AA RI Integrals", (size_t)noccA_ * noccA_),
+        std::make_tuple(PSIF_SAPT_AA_DF_INTS, "AR RI Integrals", (size_t)noccA_ * nvirA_),
+        std::make_tuple(PSIF_SAPT_AA_DF_INTS, "RR RI Integrals", (size_t)nvirA_ * (nvirA_ + 1) / 2),
+        std::make_tuple(PSIF_SAPT_BB_DF_INTS, "BB RI Integrals", (size_t)noccB_ * noccB_),
+        std::make_tuple(PSIF_SAPT_BB_DF_INTS, "BS RI Integrals", (size_t)noccB_ * nvirB_),
+        std::make_tuple(PSIF_SAPT_BB_DF_INTS, "SS RI Integrals", (size_t)nvirB_ * (nvirB_ + 1) / 2),
+        std::make_tuple(PSIF_SAPT_AB_DF_INTS, "AB RI Integrals", (size_t)noccA_ * noccB_),
+        std::make_tuple(PSIF_SAPT_AB_DF_INTS, "AS RI Integrals", (size_t)noccA_ * nvirB_),
+        std::make_tuple(PSIF_SAPT_AB_DF_INTS, "RB RI Integrals", (size_t)nvirA_ * noccB_)};
+
+    size_t total = 0;
+    for (const auto &entry : entries) total += (size_t)ndf_ * std::get<2>(entry);
+
+    if (total > (size_t)(mem_ / 2)) {
+        if (print_) {
+            outfile->Printf("    DF integrals need %.1lf MB, over half the memory; keeping them on disk.\n\n",
+                            8.0 * total / 1000000.0);
+        }
+        return;
+    }
+
+    for (const auto &entry : entries) {
+        auto &data = df_cache_[std::make_pair(std::get<0>(entry), std::get<1>(entry))];
+        data.resize((size_t)ndf_ * std::get<2>(entry));
+        psio_->read_entry(std::get<0>(entry), std::get<1>(entry).c_str(), (char *)data.data(),
+                          sizeof(double) * data.size());
+    }
+    mem_ -= (long int)total;
+
+    if (print_) {
+        outfile->Printf("    Holding %.1lf MB of DF integrals in core\n\n", 8.0 * total / 1000000.0);
+    }
+}
+
+/*
+ * Drop-in for psio_->read at the integral's current address: copies from the
+ * in-core entry when there is one and advances next_DF_ exactly as the disk
+ * read would.
+ */
+void SAPT0::read_df(SAPTDFInts *ints, double *dest, size_t length) {
+    auto cached = df_cache_.find(std::make_pair(ints->filenum_, std::string(ints->label_)));
+    if (cached == df_cache_.end()) {
+        psio_->read(ints->filenum_, ints->label_, (char *)dest, sizeof(double) * length, ints->next_DF_,
+                    &ints->next_DF_);
+        return;
+    }
+
+    size_t start = (ints->next_DF_.page * PSIO_PAGELEN + ints->next_DF_.offset) / sizeof(double);
+    C_DCOPY(length, &(cached->second[start]), 1, dest, 1);
+    ints->next_DF_ = psio_get_address(ints->next_DF_, sizeof(double) * length);
+}
+
 void SAPT0::read_all(SAPTDFInts *ints) {
     long int nri = ndf_;
     if (ints->dress_) nri += 3L;
@@ -58,7 +122,11 @@ void SAPT0::read_all(SAPTDFInts *ints) {
 
     long int tot_i = ints->i_length_ + ints->i_start_;
 
-    if (!ints->active_ && !ints->dress_disk_) {
+    auto cached = df_cache_.find(std::make_pair(ints->filenum_, std::string(ints->label_)));
+
+    if (!ints->active_ && cached != df_cache_.end()) {
+        C_DCOPY((size_t)ndf_ * ints->ij_length_, cached->second.data(), 1, &(ints->B_p_[0][0]), 1);
+    } else if (!ints->active_ && !ints->dress_disk_) {
         psio_->read_entry(ints->filenum_, ints->label_, (char *)&(ints->B_p_[0][0]),
                           sizeof(double) * ndf_ * ints->ij_length_);
     } else if (!ints->active_ && ints->dress_disk_) {
@@ -67,8 +135,7 @@ void SAPT0::read_all(SAPTDFInts *ints) {
     } else {
         for (int p = 0; p < ndf_; p++) {
             ints->next_DF_ = psio_get_address(ints->next_DF_, sizeof(double) * ints->i_start_ * ints->j_length_);
-            psio_->read(ints->filenum_, ints->label_, (char *)&(ints->B_p_[p][0]), sizeof(double) * ints->ij_length_,
-                        ints->next_DF_, &ints->next_DF_);
+            read_df(ints, &(ints->B_p_[p][0]), ints->ij_length_);
         }
     }
 
@@ -91,16 +158,13 @@ void SAPT0::read_block(Iterator *iter, SAPTDFInts *intA) {
     if (last_block && dress) block_length -= 3;
 
     if (!intA->active_ && (!intA->dress_disk_ || !last_block)) {
-        psio_->read(intA->filenum_, intA->label_, (char *)&(intA->B_p_[0][0]),
-                    sizeof(double) * block_length * intA->ij_length_, intA->next_DF_, &intA->next_DF_);
+        read_df(intA, &(intA->B_p_[0][0]), block_length * intA->ij_length_);
     } else if (!intA->active_) {
-        psio_->read(intA->filenum_, intA->label_, (char *)&(intA->B_p_[0][0]),
-                    sizeof(double) * (block_length + 3L) * intA->ij_length_, intA->next_DF_, &intA->next_DF_);
+        read_df(intA, &(intA->B_p_[0][0]), (block_length + 3L) * intA->ij_length_);
     } else {
         for (int p = 0; p < block_length; p++) {
             intA->next_DF_ = psio_get_address(intA->next_DF_, sizeof(double) * intA->i_start_ * intA->j_length_);
-            psio_->read(intA->filenum_, intA->label_, (char *)&(intA->B_p_[p][0]), sizeof(double) * intA->ij_length_,
-                        intA->next_DF_, &intA->next_DF_);
+            read_df(intA, &(intA->B_p_[p][0]), intA->ij_length_);
         }
     }
 
@@ -128,30 +192,24 @@ void SAPT0::read_block(Iterator *iter, SAPTDFInts *intA, SAPTDFInts *intB) {
     if (last_block && dress) block_length -= 3;
 
     if (!intA->active_ && (!intA->dress_disk_ || !last_block)) {
-        psio_->read(intA->filenum_, intA->label_, (char *)&(intA->B_p_[0][0]),
-                    sizeof(double) * block_length * intA->ij_length_, intA->next_DF_, &intA->next_DF_);
+        read_df(intA, &(intA->B_p_[0][0]), block_length * intA->ij_length_);
     } else if (!intA->active_) {
-        psio_->read(intA->filenum_, intA->label_, (char *)&(intA->B_p_[0][0]),
-                    sizeof(double) * (block_length + 3L) * intA->ij_length_, intA->next_DF_, &intA->next_DF_);
+        read_df(intA, &(intA->B_p_[0][0]), (block_length + 3L) * intA->ij_length_);
     } else {
         for (int p = 0; p < block_length; p++) {
             intA->next_DF_ = psio_get_address(intA->next_DF_, sizeof(double) * intA->i_start_ * intA->j_length_);
-            psio_->read(intA->filenum_, intA->label_, (char *)&(intA->B_p_[p][0]), sizeof(double) * intA->ij_length_,
-                        intA->next_DF_, &intA->next_DF_);
+            read_df(intA, &(intA->B_p_[p][0]), intA->ij_length_);
         }
     }
 
     if (!intB->active_ && (!intB->dress_disk_ || !last_block)) {
-        psio_->read(intB->filenum_, intB->label_, (char *)&(intB->B_p_[0][0]),
-                    sizeof(double) * block_length * intB->ij_length_, intB->next_DF_, &intB->next_DF_);
+        read_df(intB, &(intB->B_p_[0][0]), block_length * intB->ij_length_);
     } else if (!intB->active_) {
-        psio_->read(intB->filenum_, intB->label_, (char *)&(intB->B_p_[0][0]),
-                    sizeof(double) * (block_length + 3L) * intB->ij_length_, intB->next_DF_, &intB->next_DF_);
+        read_df(intB, &(intB->B_p_[0][0]), (block_length + 3L) * intB->ij_length_);
     } else {
         for (int p = 0; p < block_length; p++) {
             intB->next_DF_ = psio_get_address(intB->next_DF_, sizeof(double) * intB->i_start_ * intB->j_length_);
-            psio_->read(intB->filenum_, intB->label_, (char *)&(intB->B_p_[p][0]), sizeof(double) * intB->ij_length_,
-                        intB->next_DF_, &intB->next_DF_);
+            read_df(intB, &(intB->B_p_[p][0]), intB->ij_length_);
         }
     }
 
@@ -121,6 +121,10 @@ void HF::common_init() {
 
     energies_["Total Energy"] = 0.0;
 
+    soscf_trust_radius_ = options_.get_double("SOSCF_TRUST_RADIUS");
+    soscf_last_energy_ = 0.0;
+    soscf_step_capped_ = false;
+
     // Read in DOCC and SOCC from memory
     input_docc_ = false;
     Dimension docc(nirrep_);
@@ -310,6 +314,35 @@ std::vector<SharedMatrix> HF::twoel_Hx(std::vector<SharedMatrix> x, bool combine
 std::vector<SharedMatrix> HF::cphf_Hx(std::vector<SharedMatrix> x) {
     throw PSIEXCEPTION("Sorry, the base HF wavefunction cannot construct cphf_Hx products.");
 }
+void HF::soscf_restrict_step(const std::vector<SharedMatrix>& x) {
+    const double energy = get_energies("Total Energy");
+    const double max_radius = options_.get_double("SOSCF_TRUST_RADIUS");
+
+    // Judge the previous step by the energy it led to: shrink the region if the energy rose,
+    // and widen it again when a shortened step was successful.
+    if (soscf_last_energy_ != 0.0) {
+        if (energy > soscf_last_energy_) {
+            soscf_trust_radius_ *= 0.5;
+        } else if (soscf_step_capped_) {
+            soscf_trust_radius_ = std::min(2.0 * soscf_trust_radius_, max_radius);
+        }
+    }
+
+    double norm = 0.0;
+    for (const auto& xi : x) norm += xi->sum_of_squares();
+    norm = std::sqrt(norm);
+
+    soscf_step_capped_ = (norm > soscf_trust_radius_);
+    if (soscf_step_capped_) {
+        for (const auto& xi : x) xi->scale(soscf_trust_radius_ / norm);
+        if (print_ > 1) {
+            outfile->Printf("    SOSCF step of norm %.3E restricted to trust radius %.3E.\n", norm,
+                            soscf_trust_radius_);
+        }
+    }
+    soscf_last_energy_ = energy;
+}
+
 std::vector<SharedMatrix> HF::cphf_solve(std::vector<SharedMatrix> x_vec, double conv_tol, int max_iter,
                                          int print_lvl) {
     throw PSIEXCEPTION("Sorry, the base HF wavefunction cannot solve CPHF equations.");
@@ -652,6 +685,13 @@ void HF::form_H() {
         if (options_.get_bool("EXTERNAL_POTENTIAL_SYMMETRY") == false && H_->nirrep() != 1)
             throw PSIEXCEPTION("SCF: External Fields are not consistent with symmetry. Set symmetry c1.");
 
+        if (options_.get_int("EXTERNAL_POTENTIAL_FAR_FIELD_ORDER") >= 0) {
+            external_pot_->set_far_field(options_.get_int("EXTERNAL_POTENTIAL_FAR_FIELD_ORDER"),
+                                         options_.get_double("EXTERNAL_POTENTIAL_FAR_FIELD_BOX_LENGTH"),
+                                         options_.get_double("EXTERNAL_POTENTIAL_FAR_FIELD_SEPARATION"));
+        } else {
+            external_pot_->unset_far_field();
+        }
         auto Vprime = external_pot_->computePotentialMatrix(basisset_);
 
         if (options_.get_bool("EXTERNAL_POTENTIAL_SYMMETRY")) {
@@ -1182,6 +1222,8 @@ void HF::guess() {
             outfile->Printf("  SCF Guess: Superposition of Atomic Potentials (doi:10.1021/acs.jctc.8b01089).\n\n");
 
         auto builder = VBase::build_V(basisset_, functional_, options_, "SAP");
+        // The grid of a DFT potential is built from the same options, so it is reused as is
+        if (V_potential() && V_potential()->grid()) builder->set_grid(V_potential()->grid());
         builder->initialize();
 
         // Print info on the integration grid
@@ -1337,7 +1379,7 @@ void HF::diagonalize_F(const SharedMatrix& Fm, SharedMatrix& Cm, std::shared_ptr
 
     // Form C' = eig(F')
     auto diag_C_temp = std::make_shared<Matrix>(nirrep_, nmopi_, nmopi_);
-    diag_F_temp->diagonalize(diag_C_temp, epsm);
+    diag_F_temp->diagonalize(diag_C_temp, epsm, ascending, diag_dsyevd);
 
     // Form C = XC'
     Cm->gemm(false, false, 1.0, X_, diag_C_temp, 0.0);
@@ -1400,11 +1442,9 @@ SharedMatrix HF::form_Fia(SharedMatrix Fso, SharedMatrix Cso, int* noccpi) {
     return Fia;
 }
 SharedMatrix HF::form_FDSmSDF(SharedMatrix Fso, SharedMatrix Dso) {
+    // SDF is the transpose of FDS, subtract it in place instead of forming it
     auto FDSmSDF = linalg::triplet(Fso, Dso, S_, false, false, false);
-    auto SDF = FDSmSDF->transpose();
-    FDSmSDF->subtract(SDF);
-
-    SDF.reset();
+    FDSmSDF->antisymmetrize();
 
     FDSmSDF->transform(X_);
 
@@ -325,6 +325,15 @@ class HF : public Wavefunction {
     /** Applies second-order convergence acceleration */
     virtual int soscf_update(double soscf_conv, int soscf_min_iter, int soscf_max_iter, int soscf_print);
 
+    /// Trust radius, as the norm of the orbital rotation, for SOSCF steps
+    double soscf_trust_radius_;
+    /// Energy before the last SOSCF step; zero if the last iteration took none
+    double soscf_last_energy_;
+    /// Was the last SOSCF step shortened to the trust radius?
+    bool soscf_step_capped_;
+    /** Adapt the trust radius to the outcome of the last SOSCF step and scale the rotations x into it */
+    void soscf_restrict_step(const std::vector<SharedMatrix>& x);
+
     /// Figure out how to occupy the orbitals in the absence of DOCC and SOCC
     void find_occupation();
 
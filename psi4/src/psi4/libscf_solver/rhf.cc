@@ -262,8 +262,8 @@ void RHF::form_C(double shift) {
 
         auto SCvir = std::make_shared<Matrix>(nirrep_, S_->rowspi(), Cvir->colspi());
         SCvir->gemm(false, false, 1.0, S_, Cvir, 0.0);
-        shifted_F->gemm(false, true, shift, SCvir, SCvir, 0.0);
-        shifted_F->add(Fa_);
+        shifted_F->copy(Fa_);
+        shifted_F->gemm(false, true, shift, SCvir, SCvir, 1.0);
         diagonalize_F(shifted_F, Ca_, epsilon_a_);
     }
     find_occupation();
@@ -869,12 +869,14 @@ int RHF::soscf_update(double soscf_conv, int soscf_min_iter, int soscf_max_iter,
         if (print_ > 1) {
             outfile->Printf("    Gradient element too large for SOSCF, using DIIS.\n");
         }
+        soscf_last_energy_ = 0.0;
         return 0;
     }
 
     std::vector<SharedMatrix> ret_x = cphf_solve({Gradient}, soscf_conv, soscf_max_iter, soscf_print ? 2 : 0);
 
     // => Rotate orbitals <= //
+    soscf_restrict_step(ret_x);
     rotate_orbitals(Ca_, ret_x[0]);
 
     return cphf_nfock_builds_;
@@ -341,8 +341,7 @@ void ROHF::form_F() {
      *  virtual |    Fc       2Fo       Fc
      */
     moFeff_->copy(moFa_);
-    moFeff_->add(moFb_);
-    moFeff_->scale(0.5);
+    moFeff_->axpby(0.5, moFb_, 0.5);
     for (int h = 0; h < nirrep_; ++h) {
         for (int i = nbetapi_[h]; i < nalphapi_[h]; ++i) {
             // Set the open/closed portion
@@ -829,6 +828,7 @@ int ROHF::soscf_update(double soscf_conv, int soscf_min_iter, int soscf_max_iter
         if (print_ > 1) {
             outfile->Printf("    Gradient element too large for SOSCF, using DIIS.\n");
         }
+        soscf_last_energy_ = 0.0;
         return 0;
     }
 
@@ -918,6 +918,7 @@ int ROHF::soscf_update(double soscf_conv, int soscf_min_iter, int soscf_max_iter
     }
 
     // => Rotate orbitals <= //
+    soscf_restrict_step({x});
     rotate_orbitals(Ca_, x);
     rotate_orbitals(Ct_, x);
 
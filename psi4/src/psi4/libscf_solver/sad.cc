@@ -38,8 +38,13 @@
 #include <cstdio>
 #include <cmath>
 #include <algorithm>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <sstream>
 #include <vector>
 #include <utility>
+#include <unistd.h>
 
 #include "psi4/psifiles.h"
 #include "psi4/libciomr/libciomr.h"
@@ -83,6 +88,77 @@ static bool SAD_use_fitting(const Options& opt) {
     throw PSIEXCEPTION("SAD_SCF_TYPE " + opt.get_str("SAD_SCF_TYPE") + " not implemented.\n");
 }
 
+// Append everything that determines the shape and values of a basis set's functions.
+static void SAD_describe_basis(std::ostringstream& desc, const std::shared_ptr<BasisSet>& bas) {
+    desc << " nshell " << bas->nshell();
+    for (int P = 0; P < bas->nshell(); P++) {
+        const GaussianShell& shell = bas->shell(P);
+        desc << " [" << shell.am() << (shell.is_pure() ? "p" : "c");
+        for (int K = 0; K < shell.nprimitive(); K++) desc << " " << shell.exp(K) << ":" << shell.original_coef(K);
+        desc << "]";
+    }
+    desc << " necp " << bas->n_ecp_core();
+}
+
+// The SAD cache stores each converged atomic density, plus its Huckel orbitals, in a file of its own.
+// The file name is a hash of the descriptor; the full descriptor is stored too, so collisions are harmless.
+static std::string SAD_cache_file(const std::string& dir, const std::string& descriptor) {
+    std::ostringstream name;
+    name << dir << "/psi4.sad." << std::hex << std::hash<std::string>{}(descriptor) << ".bin";
+    return name.str();
+}
+
+static bool SAD_read_cache(const std::string& filename, const std::string& descriptor, SharedMatrix D,
+                           SharedMatrix Chuckel, SharedVector Ehuckel) {
+    std::ifstream in(filename, std::ios::binary);
+    if (!in) return false;
+
+    size_t len = 0;
+    in.read(reinterpret_cast<char*>(&len), sizeof(size_t));
+    if (!in || len != descriptor.size()) return false;
+    std::string stored(len, ' ');
+    in.read(&stored[0], len);
+    if (!in || stored != descriptor) return false;
+
+    int nbf = 0, nhu = 0;
+    in.read(reinterpret_cast<char*>(&nbf), sizeof(int));
+    in.read(reinterpret_cast<char*>(&nhu), sizeof(int));
+    if (!in || nbf != D->rowdim() || nhu != Ehuckel->dim()) return false;
+
+    in.read(reinterpret_cast<char*>(D->pointer()[0]), sizeof(double) * nbf * nbf);
+    if (nhu) {
+        in.read(reinterpret_cast<char*>(Chuckel->pointer()[0]), sizeof(double) * nbf * nhu);
+        in.read(reinterpret_cast<char*>(Ehuckel->pointer()), sizeof(double) * nhu);
+    }
+    return static_cast<bool>(in);
+}
+
+static void SAD_write_cache(const std::string& filename, const std::string& descriptor, SharedMatrix D,
+                            SharedMatrix Chuckel, SharedVector Ehuckel) {
+    // Write to a scratch name and rename, so that concurrent jobs sharing the cache never read a partial file.
+    std::string scratch = filename + "." + std::to_string(getpid());
+    {
+        std::ofstream out(scratch, std::ios::binary);
+        if (!out) {
+            outfile->Printf("  SAD: Unable to write atomic density cache file %s.\n", filename.c_str());
+            return;
+        }
+        size_t len = descriptor.size();
+        int nbf = D->rowdim();
+        int nhu = Ehuckel->dim();
+        out.write(reinterpret_cast<const char*>(&len), sizeof(size_t));
+        out.write(descriptor.data(), len);
+        out.write(reinterpret_cast<const char*>(&nbf), sizeof(int));
+        out.write(reinterpret_cast<const char*>(&nhu), sizeof(int));
+        out.write(reinterpret_cast<const char*>(D->pointer()[0]), sizeof(double) * nbf * nbf);
+        if (nhu) {
+            out.write(reinterpret_cast<const char*>(Chuckel->pointer()[0]), sizeof(double) * nbf * nhu);
+            out.write(reinterpret_cast<const char*>(Ehuckel->pointer()), sizeof(double) * nhu);
+        }
+    }
+    std::rename(scratch.c_str(), filename.c_str());
+}
+
 SADGuess::SADGuess(std::shared_ptr<BasisSet> basis, std::vector<std::shared_ptr<BasisSet>> atomic_bases,
                    Options& options)
     : basis_(basis), atomic_bases_(atomic_bases), options_(options) {
@@ -242,6 +318,9 @@ void SADGuess::run_atomic_calculations(SharedMatrix& DAO, SharedMatrix& HuckelC,
     // Atomic orbital energies for Huckel
     std::vector<SharedVector> atomic_Ehu(nunique);
 
+    // Converged atomic densities may be reused from earlier computations
+    const std::string cache_dir = options_.get_str("SAD_CACHE_DIR");
+
     if (print_ > 1) outfile->Printf("\n  Performing Atomic UHF Computations:\n");
     for (int uniA = 0; uniA < nunique; uniA++) {
         int index = atomic_indices[uniA];
@@ -332,6 +411,31 @@ void SADGuess::run_atomic_calculations(SharedMatrix& DAO, SharedMatrix& HuckelC,
         atomic_Chu[uniA] = std::make_shared<Matrix>("Atomic Huckel C", nbf, nhu);
         atomic_Ehu[uniA] = std::make_shared<Vector>("Atomic Huckel E", nhu);
 
+        std::string cache_file, descriptor;
+        if (!cache_dir.empty()) {
+            std::ostringstream desc;
+            desc << std::setprecision(17) << "Z " << Z << " ECP " << basis_->n_ecp_core(molecule_->label(index));
+            desc << " occ_a";
+            for (int x = 0; x < occ_a->dim(); x++) desc << " " << occ_a->get(x);
+            desc << " occ_b";
+            for (int x = 0; x < occ_b->dim(); x++) desc << " " << occ_b->get(x);
+            desc << " type " << options_.get_str("SAD_SCF_TYPE") << " E " << options_.get_double("SAD_E_CONVERGENCE")
+                 << " D " << options_.get_double("SAD_D_CONVERGENCE") << " maxiter " << options_.get_int("SAD_MAXITER");
+            desc << " basis";
+            SAD_describe_basis(desc, atomic_bases_[index]);
+            if (SAD_use_fitting(options_)) {
+                desc << " fit";
+                SAD_describe_basis(desc, atomic_fit_bases_[index]);
+            }
+            descriptor = desc.str();
+            cache_file = SAD_cache_file(cache_dir, descriptor);
+
+            if (SAD_read_cache(cache_file, descriptor, atomic_D[uniA], atomic_Chu[uniA], atomic_Ehu[uniA])) {
+                if (print_ > 1) outfile->Printf("  Read atomic density from %s\n", cache_file.c_str());
+                continue;
+            }
+        }
+
         if (SAD_use_fitting(options_)) {
             get_uhf_atomic_density(atomic_bases_[index], atomic_fit_bases_[index], occ_a, occ_b, atomic_D[uniA],
                                    atomic_Chu[uniA], atomic_Ehu[uniA]);
@@ -341,6 +445,8 @@ void SADGuess::run_atomic_calculations(SharedMatrix& DAO, SharedMatrix& HuckelC,
                                    atomic_Ehu[uniA]);
         }
         if (print_ > 1) outfile->Printf("Finished UHF Computation!\n");
+
+        if (!cache_file.empty()) SAD_write_cache(cache_file, descriptor, atomic_D[uniA], atomic_Chu[uniA], atomic_Ehu[uniA]);
     }
     if (print_) outfile->Printf("\n");
 
@@ -272,15 +272,15 @@ void UHF::form_C(double shift) {
         auto Cvir = Ca_subset("SO", "VIR");
         auto SCvir = std::make_shared<Matrix>(nirrep_, S_->rowspi(), Cvir->colspi());
         SCvir->gemm(false, false, 1.0, S_, Cvir, 0.0);
-        shifted_F->gemm(false, true, shift, SCvir, SCvir, 0.0);
-        shifted_F->add(Fa_);
+        shifted_F->copy(Fa_);
+        shifted_F->gemm(false, true, shift, SCvir, SCvir, 1.0);
         diagonalize_F(shifted_F, Ca_, epsilon_a_);
 
         Cvir = Cb_subset("SO", "VIR");
         SCvir = std::make_shared<Matrix>(nirrep_, S_->rowspi(), Cvir->colspi());
         SCvir->gemm(false, false, 1.0, S_, Cvir, 0.0);
-        shifted_F->gemm(false, true, shift, SCvir, SCvir, 0.0);
-        shifted_F->add(Fb_);
+        shifted_F->copy(Fb_);
+        shifted_F->gemm(false, true, shift, SCvir, SCvir, 1.0);
         diagonalize_F(shifted_F, Cb_, epsilon_b_);
     }
     if (options_.get_bool("GUESS_MIX") && !mix_performed_) {
@@ -1074,12 +1074,14 @@ int UHF::soscf_update(double soscf_conv, int soscf_min_iter, int soscf_max_iter,
         if (print_ > 1) {
             outfile->Printf("    Gradient element too large for SOSCF, using DIIS.\n");
         }
+        soscf_last_energy_ = 0.0;
         return 0;
     }
     auto ret_x =
         cphf_solve({Gradient_a, Gradient_b}, soscf_conv, soscf_max_iter, soscf_print ? 2 : 0);
 
     // => Rotate orbitals <= //
+    soscf_restrict_step(ret_x);
     rotate_orbitals(Ca_, ret_x[0]);
     rotate_orbitals(Cb_, ret_x[1]);
 
@@ -28,11 +28,17 @@
 
 #include "fcidump_helper.h"
 
+#include <algorithm>
 #include <cmath>
+#include <cstdint>
 #include <cstdio>
 #include <map>
 #include <memory>
 #include <string>
+#include <vector>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 #include "psi4/psi4-dec.h"
 #include "psi4/psifiles.h"
@@ -49,10 +55,11 @@
 namespace psi {
 namespace fcidump {
 void fcidump_tei_helper(int nirrep, bool restricted, std::map<std::string, int> DPD_info, double ints_tolerance,
-                        std::string fname) {
-    outfile->Printf("Writing TEI integrals in FCIDUMP format to " + fname + "\n");
+                        std::string fname, bool binary) {
+    outfile->Printf("Writing TEI integrals in %s FCIDUMP format to %s\n", (binary ? "binary" : "text"), fname.c_str());
     // Append to the file created by the fcidump function Python-side
     auto mode = std::ostream::app;
+    if (binary) mode |= std::ostream::binary;
     auto intdump = std::make_shared<PsiOutStream>(fname.c_str(), mode);
 
     // Use the IntegralTransform object's DPD instance, for convenience
@@ -69,7 +76,7 @@ void fcidump_tei_helper(int nirrep, bool restricted, std::map<std::string, int>
         // DPD_info["alpha_MO"] is DPD_ID("[A>=A]+")
         global_dpd_->buf4_init(&K, PSIF_LIBTRANS_DPD, 0, DPD_info["alpha_MO"], DPD_info["alpha_MO"],
                                DPD_info["alpha_MO"], DPD_info["alpha_MO"], 0, "MO Ints (AA|AA)");
-        detail::write_tei_to_disk(intdump, nirrep, K, ints_tolerance, mo_index, mo_index);
+        detail::write_tei_to_disk(intdump, nirrep, K, ints_tolerance, mo_index, mo_index, binary);
         global_dpd_->buf4_close(&K);
     } else {
         /* Convert an alpha spin-orbital index [0,1,...] to [1,3,...] (i.e. from
@@ -85,17 +92,17 @@ void fcidump_tei_helper(int nirrep, bool restricted, std::map<std::string, int>
         // alpha-alpha
         global_dpd_->buf4_init(&K, PSIF_LIBTRANS_DPD, 0, DPD_info["alpha_MO"], DPD_info["alpha_MO"],
                                DPD_info["alpha_MO"], DPD_info["alpha_MO"], 0, "MO Ints (AA|AA)");
-        detail::write_tei_to_disk(intdump, nirrep, K, ints_tolerance, alpha_index, alpha_index);
+        detail::write_tei_to_disk(intdump, nirrep, K, ints_tolerance, alpha_index, alpha_index, binary);
         global_dpd_->buf4_close(&K);
         // beta-beta
         global_dpd_->buf4_init(&K, PSIF_LIBTRANS_DPD, 0, DPD_info["beta_MO"], DPD_info["beta_MO"], DPD_info["beta_MO"],
                                DPD_info["beta_MO"], 0, "MO Ints (aa|aa)");
-        detail::write_tei_to_disk(intdump, nirrep, K, ints_tolerance, beta_index, beta_index);
+        detail::write_tei_to_disk(intdump, nirrep, K, ints_tolerance, beta_index, beta_index, binary);
         global_dpd_->buf4_close(&K);
         // alpha-beta
         global_dpd_->buf4_init(&K, PSIF_LIBTRANS_DPD, 0, DPD_info["alpha_MO"], DPD_info["beta_MO"],
                                DPD_info["alpha_MO"], DPD_info["beta_MO"], 0, "MO Ints (AA|aa)");
-        detail::write_tei_to_disk(intdump, nirrep, K, ints_tolerance, alpha_index, beta_index);
+        detail::write_tei_to_disk(intdump, nirrep, K, ints_tolerance, alpha_index, beta_index, binary);
         global_dpd_->buf4_close(&K);
     }
     _default_psio_lib_->close(PSIF_LIBTRANS_DPD, 1);
@@ -103,24 +110,66 @@ void fcidump_tei_helper(int nirrep, bool restricted, std::map<std::string, int>
 
 namespace detail {
 void write_tei_to_disk(std::shared_ptr<PsiOutStream> intdump, int nirrep, dpdbuf4& K, double ints_tolerance,
-                       OrbitalIndexing indx1, OrbitalIndexing indx2) {
+                       OrbitalIndexing indx1, OrbitalIndexing indx2, bool binary) {
+    int nthreads = 1;
+#ifdef _OPENMP
+    nthreads = omp_get_max_threads();
+#endif
+    // Per-thread output buffers; each thread formats a contiguous range of rows so the file order is unchanged
+    std::vector<std::string> text(nthreads);
+    std::vector<std::vector<BinaryRecord>> records(nthreads);
+    // Rows formatted per pass, so the text buffers stay around a couple of million integrals
+    const size_t max_ints = 2000000L;
+
     for (int h = 0; h < nirrep; ++h) {
         global_dpd_->buf4_mat_irrep_init(&K, h);
         global_dpd_->buf4_mat_irrep_rd(&K, h);
-        for (int pq = 0; pq < K.params->rowtot[h]; ++pq) {
-            int p = K.params->roworb[h][pq][0];
-            int q = K.params->roworb[h][pq][1];
-            for (int rs = 0; rs < K.params->coltot[h]; ++rs) {
-                int r = K.params->colorb[h][rs][0];
-                int s = K.params->colorb[h][rs][1];
-
-                if (std::abs(K.matrix[h][pq][rs]) > ints_tolerance)
-                    intdump->Printf("%28.20E%4d%4d%4d%4d\n", K.matrix[h][pq][rs], indx1(p), indx1(q), indx2(r),
-                                    indx2(s));
+        size_t nrow = K.params->rowtot[h];
+        size_t ncol = K.params->coltot[h];
+        size_t panel = std::max<size_t>(nthreads, max_ints / std::max<size_t>(1L, ncol));
+        for (size_t start = 0L; start < nrow; start += panel) {
+            size_t stop = std::min(nrow, start + panel);
+#pragma omp parallel num_threads(nthreads)
+            {
+                int thread = 0;
+#ifdef _OPENMP
+                thread = omp_get_thread_num();
+#endif
+                size_t chunk = (stop - start + nthreads - 1) / nthreads;
+                size_t first = std::min(stop, start + thread * chunk);
+                size_t last = std::min(stop, first + chunk);
+                char line[64];
+                for (size_t pq = first; pq < last; ++pq) {
+                    int p = indx1(K.params->roworb[h][pq][0]);
+                    int q = indx1(K.params->roworb[h][pq][1]);
+                    for (size_t rs = 0; rs < ncol; ++rs) {
+                        double val = K.matrix[h][pq][rs];
+                        if (std::abs(val) <= ints_tolerance) continue;
+                        int r = indx2(K.params->colorb[h][rs][0]);
+                        int s = indx2(K.params->colorb[h][rs][1]);
+                        if (binary) {
+                            records[thread].push_back({val, {p, q, r, s}});
+                        } else {
+                            int len = std::snprintf(line, sizeof(line), "%28.20E%4d%4d%4d%4d\n", val, p, q, r, s);
+                            text[thread].append(line, len);
+                        }
+                    }
+                }
+            }
+            for (int thread = 0; thread < nthreads; ++thread) {
+                if (binary) {
+                    intdump->stream()->write(reinterpret_cast<const char*>(records[thread].data()),
+                                             sizeof(BinaryRecord) * records[thread].size());
+                    records[thread].clear();
+                } else {
+                    intdump->stream()->write(text[thread].data(), text[thread].size());
+                    text[thread].clear();
+                }
             }
         }
         global_dpd_->buf4_mat_irrep_close(&K, h);
     }
+    intdump->stream()->flush();
 }
 }  // End namespace detail
 }  // End namespace fcidump
@@ -28,6 +28,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <functional>
 #include <map>
 #include <memory>
@@ -42,22 +43,29 @@ struct dpdbuf4;
 namespace fcidump {
 /*!  \fn void fcidump_tei_helper(int nirrep, bool restricted, std::map<std::string, int> DPD_info, double
  * ints_tolerance,
- *                  std::string fname = "INTDUMP")
+ *                  std::string fname = "INTDUMP", bool binary = false)
  *  \brief Write integrals to file in FCIDUMP format
  *  \param[in] nirrep number of irreps
  *  \param[in] bool whether RHF or UHF
  *  \param[in] DPD_info DPD instance and MO spaces IDs
  *  \param[in] ints_tolerance tolerance for integrals to be written to file
  *  \param[in] fname name of the FCIDUMP file
+ *  \param[in] binary write packed (value, i, j, k, l) records instead of text lines
  */
 void fcidump_tei_helper(int nirrep, bool restricted, std::map<std::string, int> DPD_info, double ints_tolerance,
-                        std::string fname = "INTDUMP");
+                        std::string fname = "INTDUMP", bool binary = false);
 
 namespace detail {
 using OrbitalIndexing = std::function<int(const int)>;
 
+/// One binary FCIDUMP entry: a float64 value followed by four one-based int32 indices, 24 bytes unpadded
+struct BinaryRecord {
+    double value;
+    int32_t index[4];
+};
+
 void write_tei_to_disk(std::shared_ptr<PsiOutStream> intdump, int nirrep, dpdbuf4& K, double ints_tolerance,
-                       OrbitalIndexing indx1, OrbitalIndexing indx2);
+                       OrbitalIndexing indx1, OrbitalIndexing indx2, bool binary = false);
 }  // End namespace detail
 }  // End namespace fcidump
 }  // End namespace psi
@@ -205,6 +205,9 @@ void IntegralTransform::initialize() {
     iwlBBIntFile_ = transformationType_ == TransformationType::Restricted ? PSIF_MO_TEI : PSIF_MO_BB_TEI;
 
     tpdm_buffer_ = nullptr;
+    tpdm_incore_ = nullptr;
+    tpdm_incore_size_ = 0;
+    keep_so_tpdm_incore_ = false;
 
     aQT_ = init_int_array(nmo_);
     if (transformationType_ == TransformationType::Restricted) {
@@ -295,6 +298,7 @@ std::shared_ptr<PSIO> IntegralTransform::get_psio() const { return psio_; }
 void IntegralTransform::set_psio(std::shared_ptr<PSIO> psio) { psio_ = psio; }
 
 IntegralTransform::~IntegralTransform() {
+    free_so_tpdm();
     if (initialized_) {
         dpd_close(myDPDNum_);
         free_int_matrix(cacheList_);
@@ -33,6 +33,7 @@
 #include <map>
 #include <vector>
 #include <string>
+#include <utility>
 #include "psi4/libmints/dimension.h"
 #include "psi4/libmints/typedefs.h"
 #include "mospace.h"
@@ -155,6 +156,8 @@ class PSI_API IntegralTransform {
     void transform_tei_first_half(const std::shared_ptr<MOSpace> s1, const std::shared_ptr<MOSpace> s2);
     void transform_tei_second_half(const std::shared_ptr<MOSpace> s1, const std::shared_ptr<MOSpace> s2,
                                    const std::shared_ptr<MOSpace> s3, const std::shared_ptr<MOSpace> s4);
+    SharedMatrix transform_tei_incore(const std::shared_ptr<MOSpace> s1, const std::shared_ptr<MOSpace> s2,
+                                      const std::shared_ptr<MOSpace> s3, const std::shared_ptr<MOSpace> s4);
     // WARNING! reset_oneel is set to true for backwards compatibility. Soon, this option will be removed
     // and only the reset_oneel = false logic will be available.
     void backtransform_density(bool reset_oneel = true);
@@ -175,6 +178,16 @@ class PSI_API IntegralTransform {
     void set_so_tei_file(int so_tei_file) { soIntTEIFile_ = so_tei_file; }
     /// Set whether to write a DPD formatted SO basis TPDM to disk after density transformations
     void set_write_dpd_so_tpdm(bool t_f) { write_dpd_so_tpdm_ = t_f; }
+    /// Set whether the SO basis TPDM is kept in core after density transformations, rather than written
+    /// to PSIF_AO_TPDM, when it fits; see so_tpdm_incore()
+    void set_keep_so_tpdm_incore(bool t_f) { keep_so_tpdm_incore_ = t_f; }
+    /// Whether the last density transformation left the SO basis TPDM in core
+    bool so_tpdm_incore() const { return tpdm_incore_ != nullptr; }
+    /// Copies the in-core SO basis TPDM elements of the pair-th (PQ| shell pair, in SO_PQ_Iterator order,
+    /// into buffer. They are laid out as the SO_TPDM_FOR_PAIR_ entries of PSIF_AO_TPDM. Thread safe.
+    void so_tpdm_pair(size_t pair, std::vector<double> &buffer) const;
+    /// Releases the in-core SO basis TPDM
+    void free_so_tpdm();
     /// Set the level of printing used during transformations (0 -> 6)
     void set_print(int n) { print_ = n; }
     /// Sets the orbitals to the given C matrix. This is a hack for MCSCF wavefunctions.
@@ -253,7 +266,11 @@ class PSI_API IntegralTransform {
     void presort_mo_tpdm_restricted();
     void presort_mo_tpdm_unrestricted();
     void setup_tpdm_buffer(const dpdbuf4 *D);
+    void init_so_tpdm_sort(const dpdbuf4 *D);
     void sort_so_tpdm(const dpdbuf4 *B, int irrep, size_t first_row, size_t num_rows, bool first_run);
+    void sort_so_tpdm_pair(const dpdbuf4 *D, int irrep, size_t first_row, size_t last_row, int p, int q,
+                           double *buffer) const;
+    void flush_so_tpdm();
 
     void trans_one(int m, int n, double *input, double *output, double **C, int soOffset, int *order,
                    bool backtransform = false, double scale = 0.0);
@@ -265,6 +282,15 @@ class PSI_API IntegralTransform {
     std::vector<size_t> tpdm_buffer_sizes_;
     // The buffer used in sorting the SO basis tpdm
     double *tpdm_buffer_;
+    // The SO shell pairs of the sorted tpdm, in the order they are written to disk
+    std::vector<std::pair<int, int>> tpdm_pairs_;
+    // The offset of each shell pair's elements within the in-core SO tpdm
+    std::vector<size_t> tpdm_pair_offsets_;
+    // The SO basis tpdm, held in core across all buckets when it fits; nullptr otherwise
+    double **tpdm_incore_;
+    size_t tpdm_incore_size_;
+    // Whether the in-core SO basis tpdm is kept for the caller instead of being written to disk
+    bool keep_so_tpdm_incore_;
     // Energy due solely to frozen core orbitals. Some modules request libtrans compute this so
     // that they don't have to concern themselves with core orbitals at all. In those cases,
     // contributions due to the valence orbitals feeling the electric field of the core orbitals
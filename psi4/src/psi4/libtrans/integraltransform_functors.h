@@ -31,12 +31,18 @@
 
 #include "integraltransform.h"
 
+#include <vector>
+
 #include "psi4/libdpd/dpd.h"
 #include "psi4/libiwl/iwl.hpp"
 #include "psi4/libpsio/psio.hpp"
 #include "psi4/libpsi4util/PsiOutStream.h"
 #include "psi4/libpsi4util/exception.h"
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 namespace psi {
 
 class FrozenCoreRestrictedFunctor {
@@ -405,6 +411,9 @@ class DPDFillerFunctor {
     int **bucket_offset_;
     bool symmetrize_;
     bool have_bra_ket_sym_;
+    /// Only rows whose owner() is part_ are written; see set_partition()
+    int nparts_;
+    int part_;
 
    public:
     DPDFillerFunctor(dpdfile4 *file, int this_bucket, int **bucket_map, int **bucket_offset, bool symmetrize,
@@ -414,9 +423,22 @@ class DPDFillerFunctor {
           bucket_map_(bucket_map),
           bucket_offset_(bucket_offset),
           symmetrize_(symmetrize),
-          have_bra_ket_sym_(have_bra_ket_sym) {
+          have_bra_ket_sym_(have_bra_ket_sym),
+          nparts_(1),
+          part_(0) {
         params_ = file_->params;
     }
+
+    /// Which of nparts partitions the matrix row of the (p,q) pair belongs to
+    int owner(int p, int q, int nparts) const { return params_->rowidx[p][q] % nparts; }
+    /*
+     * Restrict this functor to the rows of one partition, so that copies given
+     * different parts can fill the same file from different threads.
+     */
+    void set_partition(int nparts, int part) {
+        nparts_ = nparts;
+        part_ = part;
+    }
     void operator()(int p, int q, int r, int s, double value) {
         if (symmetrize_) {
             // Symmetrize the quantity (used in density matrix processing)
@@ -435,7 +457,7 @@ class DPDFillerFunctor {
         int rs_sym = r_sym ^ s_sym;
 
         /* The allowed (Mulliken) permutations are very simple in this case */
-        if (bucket_map_[p][q] == this_bucket_) {
+        if (bucket_map_[p][q] == this_bucket_ && (nparts_ == 1 || owner(p, q, nparts_) == part_)) {
             /* Get the row and column indices and assign the value */
             int pq = params_->rowidx[p][q];
             int rs = params_->colidx[r][s];
@@ -451,7 +473,8 @@ class DPDFillerFunctor {
          * We don't do this if the quantity does not have bra-ket symmetry, like
          * in the Alpha-Beta TPDM.
          */
-        if (bucket_map_[r][s] == this_bucket_ && bra_ket_different && have_bra_ket_sym_) {
+        if (bucket_map_[r][s] == this_bucket_ && bra_ket_different && have_bra_ket_sym_ &&
+            (nparts_ == 1 || owner(r, s, nparts_) == part_)) {
             int rs = params_->rowidx[r][s];
             int pq = params_->colidx[p][q];
             int offset = bucket_offset_[this_bucket_][rs_sym];
@@ -487,21 +510,101 @@ void iwl_integrals(IWL *iwl, DPDFunctor &dpd, FockFunctor &fock) {
     auto valptr = iwl->values();
     int labelIndex, p, q, r, s;
     double value;
-    bool lastBuffer;
-    do {
-        lastBuffer = iwl->last_buffer();
-        for (int index = 0; index < iwl->buffer_count(); ++index) {
-            labelIndex = 4 * index;
-            p = std::abs((int)lblptr[labelIndex++]);
-            q = (int)lblptr[labelIndex++];
-            r = (int)lblptr[labelIndex++];
-            s = (int)lblptr[labelIndex++];
-            value = (double)valptr[index];
-            dpd(p, q, r, s, value);
-            fock(p, q, r, s, 0, 0, 0, 0, 0, 0, 0, 0, value);
-        } /* end loop through current buffer */
-        if (!lastBuffer) iwl->fetch();
-    } while (!lastBuffer);
+
+    // The first buffer has already been fetched into core by the IWL constructor
+    for (int index = 0; index < iwl->buffer_count(); ++index) {
+        labelIndex = 4 * index;
+        p = std::abs((int)lblptr[labelIndex++]);
+        q = (int)lblptr[labelIndex++];
+        r = (int)lblptr[labelIndex++];
+        s = (int)lblptr[labelIndex++];
+        value = (double)valptr[index];
+        dpd(p, q, r, s, value);
+        fock(p, q, r, s, 0, 0, 0, 0, 0, 0, 0, 0, value);
+    }
+
+    int nthread = 1;
+#ifdef _OPENMP
+    nthread = omp_get_max_threads();
+#endif
+
+    /*
+     * The rest of the file is read IWL_BUFS_PER_BLOCK buffers at a time.  With
+     * more than one thread, the buffers of a block are decoded concurrently and
+     * every integral is binned by the thread that owns the rows it lands in;
+     * then each thread applies its own bins, so no two threads ever touch the
+     * same row.  The bins are drained in file order, so every element sees the
+     * same sequence of additions as in the serial loop.
+     */
+    struct Integral {
+        int p, q, r, s;
+        double value;
+    };
+    std::vector<char> block;
+    std::vector<std::vector<std::vector<Integral>>> bins(nthread, std::vector<std::vector<Integral>>(nthread));
+    while (!iwl->last_buffer()) {
+        int nbuf = iwl->fetch_block(block, IWL_BUFS_PER_BLOCK);
+
+        if (nthread == 1) {
+            for (int buf = 0; buf < nbuf; ++buf) {
+                char *raw = iwl->raw_buffer(block.data(), buf);
+                const Label *labels = IWL::raw_labels(raw);
+                const Value *values = iwl->raw_values(raw);
+                for (int index = 0; index < IWL::raw_buffer_count(raw); ++index) {
+                    p = std::abs((int)labels[4 * index]);
+                    q = (int)labels[4 * index + 1];
+                    r = (int)labels[4 * index + 2];
+                    s = (int)labels[4 * index + 3];
+                    dpd(p, q, r, s, (double)values[index]);
+                    fock(p, q, r, s, 0, 0, 0, 0, 0, 0, 0, 0, (double)values[index]);
+                }
+            }
+            continue;
+        }
+
+#pragma omp parallel num_threads(nthread)
+        {
+            int thread = 0;
+#ifdef _OPENMP
+            thread = omp_get_thread_num();
+#endif
+            auto &mybins = bins[thread];
+            for (auto &bin : mybins) bin.clear();
+
+#pragma omp for schedule(static)
+            for (int buf = 0; buf < nbuf; ++buf) {
+                char *raw = iwl->raw_buffer(block.data(), buf);
+                const Label *labels = IWL::raw_labels(raw);
+                const Value *values = iwl->raw_values(raw);
+                for (int index = 0; index < IWL::raw_buffer_count(raw); ++index) {
+                    Integral integral{std::abs((int)labels[4 * index]), (int)labels[4 * index + 1],
+                                      (int)labels[4 * index + 2], (int)labels[4 * index + 3], (double)values[index]};
+                    int pq_owner = dpd.owner(integral.p, integral.q, nthread);
+                    int rs_owner = dpd.owner(integral.r, integral.s, nthread);
+                    mybins[pq_owner].push_back(integral);
+                    if (rs_owner != pq_owner) mybins[rs_owner].push_back(integral);
+                }
+            }
+            // Implicit barrier: all bins are complete
+
+            // The Fock functors accumulate into a single array, so one thread takes them all
+#pragma omp single nowait
+            for (int buf = 0; buf < nbuf; ++buf) {
+                char *raw = iwl->raw_buffer(block.data(), buf);
+                const Label *labels = IWL::raw_labels(raw);
+                const Value *values = iwl->raw_values(raw);
+                for (int index = 0; index < IWL::raw_buffer_count(raw); ++index)
+                    fock(std::abs((int)labels[4 * index]), (int)labels[4 * index + 1], (int)labels[4 * index + 2],
+                         (int)labels[4 * index + 3], 0, 0, 0, 0, 0, 0, 0, 0, (double)values[index]);
+            }
+
+            DPDFunctor mydpd(dpd);
+            mydpd.set_partition(nthread, thread);
+            for (int decoder = 0; decoder < nthread; ++decoder)
+                for (const Integral &integral : bins[decoder][thread])
+                    mydpd(integral.p, integral.q, integral.r, integral.s, integral.value);
+        }
+    }
     iwl->set_keep_flag(true);
 }
 
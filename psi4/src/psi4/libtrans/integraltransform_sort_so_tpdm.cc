@@ -34,6 +34,7 @@
 #include "psi4/libmints/sobasis.h"
 #include "psi4/libpsio/psio.hpp"
 #include "psi4/libmints/integral.h"
+#include "psi4/libpsi4util/PsiOutStream.h"
 #ifdef INDEX2
 #undef INDEX2
 #endif
@@ -44,10 +45,13 @@ namespace psi {
 void IntegralTransform::setup_tpdm_buffer(const dpdbuf4 *D) {
     auto PQIter = std::make_shared<SO_PQ_Iterator>(sobasis_);
     tpdm_buffer_sizes_.clear();
+    tpdm_pairs_.clear();
+    tpdm_pair_offsets_.assign(1, 0);
     size_t max_size = 0;
     for (PQIter->first(); PQIter->is_done() == false; PQIter->next()) {
         int p = PQIter->p();
         int q = PQIter->q();
+        tpdm_pairs_.emplace_back(p, q);
         std::shared_ptr<SO_RS_Iterator> RSIter =
             std::make_shared<SO_RS_Iterator>(p, q, sobasis_, sobasis_, sobasis_, sobasis_);
         size_t count = 0;
@@ -112,6 +116,7 @@ void IntegralTransform::setup_tpdm_buffer(const dpdbuf4 *D) {
         }  // End rs iterator
         max_size = count > max_size ? count : max_size;
         tpdm_buffer_sizes_.push_back(count);
+        tpdm_pair_offsets_.push_back(tpdm_pair_offsets_.back() + count);
     }  // End pq iterator
     size_t num_pairs = tpdm_buffer_sizes_.size();
     psio_->write_entry(PSIF_AO_TPDM, "Num. Pairs", (char *)&num_pairs, sizeof(size_t));
@@ -122,147 +127,207 @@ void IntegralTransform::setup_tpdm_buffer(const dpdbuf4 *D) {
     delete[] temp;
 }
 
+void IntegralTransform::init_so_tpdm_sort(const dpdbuf4 *D) {
+    // The buffer needs to be set up if the pointer is still null
+    if (tpdm_buffer_ == nullptr) setup_tpdm_buffer(D);
+    // Drop any tpdm kept in core from a previous backtransformation
+    free_so_tpdm();
+
+    // Every bucket of every irrep touches every shell pair, so hold the whole SO tpdm in core if it fits
+    // alongside the DPD buckets; it is then written to disk once, rather than read and rewritten per bucket
+    size_t total = tpdm_pair_offsets_.back();
+    if (total && total <= static_cast<size_t>(dpd_memfree()) / 2) {
+        tpdm_incore_size_ = total;
+        tpdm_incore_ = global_dpd_->dpd_block_matrix(1, total);
+        ::memset((void *)tpdm_incore_[0], '\0', total * sizeof(double));
+    }
+    if (print_) {
+        outfile->Printf("\tSorting the SO basis TPDM %s.\n", tpdm_incore_ ? "in core" : "out of core");
+    }
+}
+
 void IntegralTransform::sort_so_tpdm(const dpdbuf4 *D, int irrep, size_t first_row, size_t num_rows, bool first_run) {
     // The buffer needs to be set up if the pointer is still null
     if (tpdm_buffer_ == nullptr) setup_tpdm_buffer(D);
 
     size_t last_row = first_row + num_rows;
-    size_t pq_pair_count = 0;
-    auto PQIter = std::make_shared<SO_PQ_Iterator>(sobasis_);
-    for (PQIter->first(); PQIter->is_done() == false; PQIter->next()) {
-        int p = PQIter->p();
-        int q = PQIter->q();
+    size_t num_pairs = tpdm_pairs_.size();
+
+    if (tpdm_incore_) {
+        // Each shell pair owns a disjoint slice of the in-core tpdm
+#pragma omp parallel for schedule(dynamic)
+        for (size_t pair = 0; pair < num_pairs; ++pair) {
+            sort_so_tpdm_pair(D, irrep, first_row, last_row, tpdm_pairs_[pair].first, tpdm_pairs_[pair].second,
+                              tpdm_incore_[0] + tpdm_pair_offsets_[pair]);
+        }
+        return;
+    }
+
+    for (size_t pair = 0; pair < num_pairs; ++pair) {
         char *toc = new char[40];
-        sprintf(toc, "SO_TPDM_FOR_PAIR_%zd", pq_pair_count);
-        size_t buffer_size = tpdm_buffer_sizes_[pq_pair_count];
+        sprintf(toc, "SO_TPDM_FOR_PAIR_%zd", pair);
+        size_t buffer_size = tpdm_buffer_sizes_[pair];
         if (first_run)
             ::memset((void *)tpdm_buffer_, '\0', buffer_size * sizeof(double));
         else
             psio_->read_entry(PSIF_AO_TPDM, toc, (char *)tpdm_buffer_, buffer_size * sizeof(double));
-        ++pq_pair_count;
-        size_t index = 0;
+        sort_so_tpdm_pair(D, irrep, first_row, last_row, tpdm_pairs_[pair].first, tpdm_pairs_[pair].second,
+                          tpdm_buffer_);
+        psio_->write_entry(PSIF_AO_TPDM, toc, (char *)tpdm_buffer_, buffer_size * sizeof(double));
+        delete[] toc;
+    }
+}
 
-        std::shared_ptr<SO_RS_Iterator> RSIter =
-            std::make_shared<SO_RS_Iterator>(p, q, sobasis_, sobasis_, sobasis_, sobasis_);
-        for (RSIter->first(); RSIter->is_done() == false; RSIter->next()) {
-            int ish = RSIter->p();
-            int jsh = RSIter->q();
-            int ksh = RSIter->r();
-            int lsh = RSIter->s();
+void IntegralTransform::flush_so_tpdm() {
+    if (tpdm_incore_ == nullptr || keep_so_tpdm_incore_) return;
 
-            int n1 = sobasis_->nfunction(ish);
-            int n2 = sobasis_->nfunction(jsh);
-            int n3 = sobasis_->nfunction(ksh);
-            int n4 = sobasis_->nfunction(lsh);
+    size_t num_pairs = tpdm_pairs_.size();
+    for (size_t pair = 0; pair < num_pairs; ++pair) {
+        char *toc = new char[40];
+        sprintf(toc, "SO_TPDM_FOR_PAIR_%zd", pair);
+        psio_->write_entry(PSIF_AO_TPDM, toc, (char *)(tpdm_incore_[0] + tpdm_pair_offsets_[pair]),
+                           tpdm_buffer_sizes_[pair] * sizeof(double));
+        delete[] toc;
+    }
+    free_so_tpdm();
+}
 
-            // The starting orbital for each irrep can be grabbed from DPD
-            int *sym_offsets = D->params->poff;
+void IntegralTransform::free_so_tpdm() {
+    if (tpdm_incore_ == nullptr) return;
+    global_dpd_->free_dpd_block(tpdm_incore_, 1, tpdm_incore_size_);
+    tpdm_incore_ = nullptr;
+    tpdm_incore_size_ = 0;
+}
 
-            for (int itr = 0; itr < n1; itr++) {
-                int ifunc = sobasis_->function(ish) + itr;
-                int isym = sobasis_->irrep(ifunc);
-                int irel = sobasis_->function_within_irrep(ifunc);
-                int iabs = sym_offsets[isym] + irel;
-                for (int jtr = 0; jtr < n2; jtr++) {
-                    int jfunc = sobasis_->function(jsh) + jtr;
-                    int jsym = sobasis_->irrep(jfunc);
-                    int jrel = sobasis_->function_within_irrep(jfunc);
-                    int jabs = sym_offsets[jsym] + jrel;
-                    for (int ktr = 0; ktr < n3; ktr++) {
-                        int kfunc = sobasis_->function(ksh) + ktr;
-                        int ksym = sobasis_->irrep(kfunc);
-                        int krel = sobasis_->function_within_irrep(kfunc);
-                        int kabs = sym_offsets[ksym] + krel;
-                        for (int ltr = 0; ltr < n4; ltr++) {
-                            int lfunc = sobasis_->function(lsh) + ltr;
-                            int lsym = sobasis_->irrep(lfunc);
-                            if (isym ^ jsym ^ ksym ^ lsym) continue;  // Not totally symmetric
-                            int lrel = sobasis_->function_within_irrep(lfunc);
-                            int labs = sym_offsets[lsym] + lrel;
-                            int iiabs = iabs;
-                            int jjabs = jabs;
-                            int kkabs = kabs;
-                            int llabs = labs;
+void IntegralTransform::so_tpdm_pair(size_t pair, std::vector<double> &buffer) const {
+    if (tpdm_incore_ == nullptr)
+        throw PSIEXCEPTION("IntegralTransform::so_tpdm_pair: The SO basis TPDM is not held in core.");
+    const double *start = tpdm_incore_[0] + tpdm_pair_offsets_[pair];
+    buffer.assign(start, start + tpdm_buffer_sizes_[pair]);
+}
 
-                            int iiirrep = isym;
-                            int jjirrep = jsym;
-                            int kkirrep = ksym;
-                            int llirrep = lsym;
+void IntegralTransform::sort_so_tpdm_pair(const dpdbuf4 *D, int irrep, size_t first_row, size_t last_row, int p,
+                                          int q, double *buffer) const {
+    size_t index = 0;
 
-                            int iirel = irel;
-                            int jjrel = jrel;
-                            int kkrel = krel;
-                            int llrel = lrel;
+    std::shared_ptr<SO_RS_Iterator> RSIter =
+        std::make_shared<SO_RS_Iterator>(p, q, sobasis_, sobasis_, sobasis_, sobasis_);
+    for (RSIter->first(); RSIter->is_done() == false; RSIter->next()) {
+        int ish = RSIter->p();
+        int jsh = RSIter->q();
+        int ksh = RSIter->r();
+        int lsh = RSIter->s();
 
-                            if (ish == jsh) {
-                                if (iabs < jabs) continue;
+        int n1 = sobasis_->nfunction(ish);
+        int n2 = sobasis_->nfunction(jsh);
+        int n3 = sobasis_->nfunction(ksh);
+        int n4 = sobasis_->nfunction(lsh);
 
-                                if (ksh == lsh) {
-                                    if (kabs < labs) continue;
-                                    if (INDEX2(iabs, jabs) < INDEX2(kabs, labs)) {
-                                        if (ish == ksh)  // IIII case
-                                            continue;
-                                        else {  // IIJJ case
-                                            SWAP_INDEX(ii, kk);
-                                            SWAP_INDEX(jj, ll);
-                                        }
-                                    }
-                                } else {  // IIJK case
-                                    if (labs > kabs) {
-                                        SWAP_INDEX(kk, ll);
-                                    }
-                                    if (INDEX2(iabs, jabs) < INDEX2(kabs, labs)) {
+        // The starting orbital for each irrep can be grabbed from DPD
+        int *sym_offsets = D->params->poff;
+
+        for (int itr = 0; itr < n1; itr++) {
+            int ifunc = sobasis_->function(ish) + itr;
+            int isym = sobasis_->irrep(ifunc);
+            int irel = sobasis_->function_within_irrep(ifunc);
+            int iabs = sym_offsets[isym] + irel;
+            for (int jtr = 0; jtr < n2; jtr++) {
+                int jfunc = sobasis_->function(jsh) + jtr;
+                int jsym = sobasis_->irrep(jfunc);
+                int jrel = sobasis_->function_within_irrep(jfunc);
+                int jabs = sym_offsets[jsym] + jrel;
+                for (int ktr = 0; ktr < n3; ktr++) {
+                    int kfunc = sobasis_->function(ksh) + ktr;
+                    int ksym = sobasis_->irrep(kfunc);
+                    int krel = sobasis_->function_within_irrep(kfunc);
+                    int kabs = sym_offsets[ksym] + krel;
+                    for (int ltr = 0; ltr < n4; ltr++) {
+                        int lfunc = sobasis_->function(lsh) + ltr;
+                        int lsym = sobasis_->irrep(lfunc);
+                        if (isym ^ jsym ^ ksym ^ lsym) continue;  // Not totally symmetric
+                        int lrel = sobasis_->function_within_irrep(lfunc);
+                        int labs = sym_offsets[lsym] + lrel;
+                        int iiabs = iabs;
+                        int jjabs = jabs;
+                        int kkabs = kabs;
+                        int llabs = labs;
+
+                        int iiirrep = isym;
+                        int jjirrep = jsym;
+                        int kkirrep = ksym;
+                        int llirrep = lsym;
+
+                        int iirel = irel;
+                        int jjrel = jrel;
+                        int kkrel = krel;
+                        int llrel = lrel;
+
+                        if (ish == jsh) {
+                            if (iabs < jabs) continue;
+
+                            if (ksh == lsh) {
+                                if (kabs < labs) continue;
+                                if (INDEX2(iabs, jabs) < INDEX2(kabs, labs)) {
+                                    if (ish == ksh)  // IIII case
+                                        continue;
+                                    else {  // IIJJ case
                                         SWAP_INDEX(ii, kk);
                                         SWAP_INDEX(jj, ll);
                                     }
                                 }
-                            } else {
-                                if (ksh == lsh) {  // IJKK case
-                                    if (kabs < labs) continue;
-                                    if (iabs < jabs) {
-                                        SWAP_INDEX(ii, jj);
-                                    }
-                                    if (INDEX2(iabs, jabs) < INDEX2(kabs, labs)) {
-                                        SWAP_INDEX(ii, kk);
-                                        SWAP_INDEX(jj, ll);
-                                    }
-                                } else {  // IJIJ case
-                                    if (ish == ksh && jsh == lsh && INDEX2(iabs, jabs) < INDEX2(kabs, labs)) continue;
-                                    // IJKL case
-                                    if (iabs < jabs) {
-                                        SWAP_INDEX(ii, jj);
-                                    }
-                                    if (kabs < labs) {
-                                        SWAP_INDEX(kk, ll);
-                                    }
-                                    if (INDEX2(iabs, jabs) < INDEX2(kabs, labs)) {
-                                        SWAP_INDEX(ii, kk);
-                                        SWAP_INDEX(jj, ll);
-                                    }
+                            } else {  // IIJK case
+                                if (labs > kabs) {
+                                    SWAP_INDEX(kk, ll);
+                                }
+                                if (INDEX2(iabs, jabs) < INDEX2(kabs, labs)) {
+                                    SWAP_INDEX(ii, kk);
+                                    SWAP_INDEX(jj, ll);
                                 }
                             }
-
-                            int ijsym = iiirrep ^ jjirrep;
-                            size_t ijrow = D->params->rowidx[iiabs][jjabs];
-                            size_t ijcol = D->params->colidx[iiabs][jjabs];
-                            size_t klrow = D->params->rowidx[kkabs][llabs];
-                            size_t klcol = D->params->colidx[kkabs][llabs];
-                            // We know that ijkl is totally symmetric, so klsym
-                            // must be the same as ijsym
-                            if ((ijsym == irrep) && (ijrow >= first_row) && (ijrow < last_row)) {
-                                tpdm_buffer_[index] += 0.5 * D->matrix[ijsym][ijrow - first_row][klcol];
-                            }
-                            if ((ijsym == irrep) && (klrow >= first_row) && (klrow < last_row)) {
-                                tpdm_buffer_[index] += 0.5 * D->matrix[ijsym][klrow - first_row][ijcol];
+                        } else {
+                            if (ksh == lsh) {  // IJKK case
+                                if (kabs < labs) continue;
+                                if (iabs < jabs) {
+                                    SWAP_INDEX(ii, jj);
+                                }
+                                if (INDEX2(iabs, jabs) < INDEX2(kabs, labs)) {
+                                    SWAP_INDEX(ii, kk);
+                                    SWAP_INDEX(jj, ll);
+                                }
+                            } else {  // IJIJ case
+                                if (ish == ksh && jsh == lsh && INDEX2(iabs, jabs) < INDEX2(kabs, labs)) continue;
+                                // IJKL case
+                                if (iabs < jabs) {
+                                    SWAP_INDEX(ii, jj);
+                                }
+                                if (kabs < labs) {
+                                    SWAP_INDEX(kk, ll);
+                                }
+                                if (INDEX2(iabs, jabs) < INDEX2(kabs, labs)) {
+                                    SWAP_INDEX(ii, kk);
+                                    SWAP_INDEX(jj, ll);
+                                }
                             }
-                            ++index;
                         }
+
+                        int ijsym = iiirrep ^ jjirrep;
+                        size_t ijrow = D->params->rowidx[iiabs][jjabs];
+                        size_t ijcol = D->params->colidx[iiabs][jjabs];
+                        size_t klrow = D->params->rowidx[kkabs][llabs];
+                        size_t klcol = D->params->colidx[kkabs][llabs];
+                        // We know that ijkl is totally symmetric, so klsym
+                        // must be the same as ijsym
+                        if ((ijsym == irrep) && (ijrow >= first_row) && (ijrow < last_row)) {
+                            buffer[index] += 0.5 * D->matrix[ijsym][ijrow - first_row][klcol];
+                        }
+                        if ((ijsym == irrep) && (klrow >= first_row) && (klrow < last_row)) {
+                            buffer[index] += 0.5 * D->matrix[ijsym][klrow - first_row][ijcol];
+                        }
+                        ++index;
                     }
                 }
             }
-        }  // End rs iterator
-        psio_->write_entry(PSIF_AO_TPDM, toc, (char *)tpdm_buffer_, buffer_size * sizeof(double));
-        delete[] toc;
-    }  // End pq iterator
+        }
+    }  // End rs iterator
 }
 }  // namespace psi
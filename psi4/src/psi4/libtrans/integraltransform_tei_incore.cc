@@ -0,0 +1,225 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Psi4: an open-source quantum chemistry software package
+ *
+ * Copyright (c) 2007-2023 The Psi4 Developers.
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This file is part of Psi4.
+ *
+ * Psi4 is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * Psi4 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with Psi4; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * @END LICENSE
+ */
+
+#include "mospace.h"
+#include "integraltransform.h"
+
+#include "psi4/libpsio/psio.hpp"
+#include "psi4/libciomr/libciomr.h"
+#include "psi4/libmints/matrix.h"
+#include "psi4/libqt/qt.h"
+#include "psi4/libpsi4util/exception.h"
+#include "psi4/libpsi4util/PsiOutStream.h"
+#include "psi4/psifiles.h"
+#include "psi4/libdpd/dpd.h"
+
+#include <algorithm>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using namespace psi;
+
+/**
+ * Transform the two-electron integrals from the SO to the MO basis in the spaces specified,
+ * holding the half-transformed and the final integrals in core. Nothing but the presorted
+ * SO integrals touches the disk, so this is meant for small target spaces, e.g. the active
+ * orbitals of an MCSCF. Only restricted transformations are supported.
+ *
+ * @param s1 - the MO space for the first index
+ * @param s2 - the MO space for the second index
+ * @param s3 - the MO space for the third index
+ * @param s4 - the MO space for the fourth index
+ * @return (s1 s2|s3 s4) as a dense n1 n2 by n3 n4 matrix, each space running over its
+ *         orbitals irrep by irrep
+ */
+SharedMatrix IntegralTransform::transform_tei_incore(const std::shared_ptr<MOSpace> s1,
+                                                     const std::shared_ptr<MOSpace> s2,
+                                                     const std::shared_ptr<MOSpace> s3,
+                                                     const std::shared_ptr<MOSpace> s4) {
+    check_initialized();
+    if (transformationType_ != TransformationType::Restricted)
+        throw PSIEXCEPTION("IntegralTransform::transform_tei_incore: only restricted transformations are supported.");
+
+    // This can be safely called - it returns immediately if the SO ints are already sorted
+    presort_so_tei();
+
+    std::vector<SharedMatrix> C = {aMOCoefficients_[s1->label()], aMOCoefficients_[s2->label()],
+                                   aMOCoefficients_[s3->label()], aMOCoefficients_[s4->label()]};
+    std::vector<int *> orbspi = {aOrbsPI_[s1->label()], aOrbsPI_[s2->label()], aOrbsPI_[s3->label()],
+                                 aOrbsPI_[s4->label()]};
+
+    // Offsets of each irrep within the dense index of each space
+    std::vector<std::vector<int>> offset(4, std::vector<int>(nirreps_, 0));
+    std::vector<int> norb(4, 0);
+    for (int n = 0; n < 4; n++) {
+        for (int h = 0; h < nirreps_; h++) {
+            offset[n][h] = norb[n];
+            norb[n] += orbspi[n][h];
+        }
+    }
+
+    // Offsets of the (Gr, Gs) blocks within the half-transformed ket of each irrep
+    std::vector<std::vector<size_t>> ketoff(nirreps_, std::vector<size_t>(nirreps_, 0));
+    std::vector<size_t> ketpi(nirreps_, 0);
+    for (int h = 0; h < nirreps_; h++) {
+        for (int Gr = 0; Gr < nirreps_; Gr++) {
+            ketoff[h][Gr] = ketpi[h];
+            ketpi[h] += static_cast<size_t>(orbspi[2][Gr]) * orbspi[3][h ^ Gr];
+        }
+    }
+
+    auto ints = std::make_shared<Matrix>("MO Ints", norb[0] * norb[1], norb[2] * norb[3]);
+    double **intsp = ints->pointer();
+
+    int nthreads = 1;
+#ifdef _OPENMP
+    nthreads = omp_get_max_threads();
+#endif
+
+    // Grab control of DPD for now, but store the active number to restore it later
+    int currentActiveDPD = psi::dpd_default;
+    dpd_set_default(myDPDNum_);
+
+    if (print_) {
+        outfile->Printf("\tStarting in-core transformation.\n");
+    }
+
+    psio_->open(PSIF_SO_PRESORT, PSIO_OPEN_OLD);
+
+    dpdbuf4 J;
+    global_dpd_->buf4_init(&J, PSIF_SO_PRESORT, 0, DPD_ID("[n>=n]+"), DPD_ID("[n,n]"), DPD_ID("[n>=n]+"),
+                           DPD_ID("[n>=n]+"), 0, "SO Ints (nn|nn)");
+
+    for (int h = 0; h < nirreps_; h++) {
+        size_t rowtot = J.params->rowtot[h];
+        size_t coltot = J.params->coltot[h];
+        if (!rowtot || !coltot || !ketpi[h]) continue;
+
+        // ( n n | n n ) -> ( n n | S3 S4 ), the SO rows are read in buckets
+        std::vector<double> half(rowtot * ketpi[h], 0.0);
+        size_t halfsize = half.size();
+        long int memFree = dpd_memfree() - static_cast<long int>(halfsize);
+        if (memFree < static_cast<long int>(coltot))
+            throw PSIEXCEPTION("IntegralTransform::transform_tei_incore: not enough memory for the SO integrals.");
+        size_t rowsPerBucket = static_cast<size_t>(memFree) / coltot;
+        if (rowsPerBucket > rowtot) rowsPerBucket = rowtot;
+
+        global_dpd_->buf4_mat_irrep_init_block(&J, h, rowsPerBucket);
+        for (size_t first = 0; first < rowtot; first += rowsPerBucket) {
+            size_t nrows = std::min(rowsPerBucket, rowtot - first);
+            global_dpd_->buf4_mat_irrep_rd_block(&J, h, first, nrows);
+
+#pragma omp parallel num_threads(nthreads)
+            {
+                std::vector<double> TMP(static_cast<size_t>(nso_) * nso_);
+#pragma omp for schedule(dynamic)
+                for (size_t pq = 0; pq < nrows; pq++) {
+                    double *halfp = half.data() + (first + pq) * ketpi[h];
+                    for (int Gr = 0; Gr < nirreps_; Gr++) {
+                        int Gs = h ^ Gr;
+                        int nr = sopi_[Gr];
+                        int ns = sopi_[Gs];
+                        int n3 = orbspi[2][Gr];
+                        int n4 = orbspi[3][Gs];
+                        if (!nr || !ns || !n3 || !n4) continue;
+                        C_DGEMM('n', 'n', nr, n4, ns, 1.0, &J.matrix[h][pq][J.col_offset[h][Gr]], ns,
+                                C[3]->pointer(Gs)[0], n4, 0.0, TMP.data(), n4);
+                        C_DGEMM('t', 'n', n3, n4, nr, 1.0, C[2]->pointer(Gr)[0], n3, TMP.data(), n4, 0.0,
+                                halfp + ketoff[h][Gr], n4);
+                    }
+                }
+            }
+        }
+        global_dpd_->buf4_mat_irrep_close_block(&J, h, rowsPerBucket);
+
+        // ( n n | S3 S4 ) -> ( S1 S2 | S3 S4 ), one ket pair at a time
+#pragma omp parallel num_threads(nthreads)
+        {
+            std::vector<SharedMatrix> X(nirreps_);
+            for (int Gp = 0; Gp < nirreps_; Gp++) X[Gp] = std::make_shared<Matrix>(sopi_[Gp], sopi_[h ^ Gp]);
+            std::vector<double> TMP(static_cast<size_t>(nso_) * nso_);
+            std::vector<double> OUT(static_cast<size_t>(nso_) * nso_);
+
+#pragma omp for schedule(dynamic)
+            for (size_t rs = 0; rs < ketpi[h]; rs++) {
+                // Locate the dense column of this ket pair
+                int Gr = 0;
+                while (Gr < nirreps_ - 1 && ketoff[h][Gr + 1] <= rs) Gr++;
+                int Gs = h ^ Gr;
+                size_t r = (rs - ketoff[h][Gr]) / orbspi[3][Gs];
+                size_t s = (rs - ketoff[h][Gr]) % orbspi[3][Gs];
+                size_t col = (offset[2][Gr] + r) * norb[3] + offset[3][Gs] + s;
+
+                // Unpack the p >= q rows into full symmetry blocks
+                for (size_t pq = 0; pq < rowtot; pq++) {
+                    int p = J.params->roworb[h][pq][0];
+                    int q = J.params->roworb[h][pq][1];
+                    int Gp = J.params->psym[p];
+                    int Gq = J.params->qsym[q];
+                    p -= J.params->poff[Gp];
+                    q -= J.params->qoff[Gq];
+                    double value = half[pq * ketpi[h] + rs];
+                    X[Gp]->pointer()[p][q] = value;
+                    X[Gq]->pointer()[q][p] = value;
+                }
+
+                for (int Gp = 0; Gp < nirreps_; Gp++) {
+                    int Gq = h ^ Gp;
+                    int np = sopi_[Gp];
+                    int nq = sopi_[Gq];
+                    int n1 = orbspi[0][Gp];
+                    int n2 = orbspi[1][Gq];
+                    if (!np || !nq || !n1 || !n2) continue;
+                    C_DGEMM('n', 'n', np, n2, nq, 1.0, X[Gp]->pointer()[0], nq, C[1]->pointer(Gq)[0], n2, 0.0,
+                            TMP.data(), n2);
+                    C_DGEMM('t', 'n', n1, n2, np, 1.0, C[0]->pointer(Gp)[0], n1, TMP.data(), n2, 0.0, OUT.data(),
+                            n2);
+                    for (int i = 0; i < n1; i++) {
+                        for (int j = 0; j < n2; j++) {
+                            intsp[(offset[0][Gp] + i) * norb[1] + offset[1][Gq] + j][col] = OUT[i * n2 + j];
+                        }
+                    }
+                }
+            }
+        }
+    }
+    global_dpd_->buf4_close(&J);
+    psio_->close(PSIF_SO_PRESORT, keepDpdSoInts_);
+
+    if (print_) {
+        outfile->Printf("\tIn-core transformation complete.\n");
+    }
+
+    // Hand DPD control back to the user
+    dpd_set_default(currentActiveDPD);
+
+    return ints;
+}
@@ -41,6 +41,11 @@
 #include <cmath>
 #include <cctype>
 #include <cstdio>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 using namespace psi;
 
@@ -63,7 +68,10 @@ void IntegralTransform::backtransform_tpdm_restricted() {
     size_t rowsLeft;
     size_t memFree;
 
-    double **TMP = block_matrix(nso_, nso_);
+    int nthreads = 1;
+#ifdef _OPENMP
+    nthreads = omp_get_max_threads();
+#endif
 
     /*** first half transformation ***/
 
@@ -111,30 +119,35 @@ void IntegralTransform::backtransform_tpdm_restricted() {
             else
                 thisBucketRows = (n < nBuckets - 1) ? rowsPerBucket : rowsLeft;
             global_dpd_->buf4_mat_irrep_rd_block(&J, h, n * rowsPerBucket, thisBucketRows);
-            for (int pq = 0; pq < thisBucketRows; pq++) {
-                for (int Gr = 0; Gr < nirreps_; Gr++) {
-                    // Transform ( a a | a a ) -> ( a a | a n )
-                    int Gs = h ^ Gr;
-                    int nrows = sopi_[Gr];
-                    int ncols = mopi_[Gs];
-                    int nlinks = mopi_[Gs];
-                    int rs = J.col_offset[h][Gr];
-                    double **pc = c->pointer(Gs);
-                    if (nrows && ncols && nlinks)
-                        C_DGEMM('n', 't', nrows, ncols, nlinks, 1.0, &J.matrix[h][pq][rs], nlinks, pc[0], ncols, 0.0,
-                                TMP[0], nso_);
-
-                    // Transform ( a a | a n ) -> ( a a | n n )
-                    nrows = sopi_[Gr];
-                    ncols = sopi_[Gs];
-                    nlinks = mopi_[Gr];
-                    rs = K.col_offset[h][Gr];
-                    pc = c->pointer(Gr);
-                    if (nrows && ncols && nlinks)
-                        C_DGEMM('n', 'n', nrows, ncols, nlinks, 1.0, pc[0], nrows, TMP[0], nso_, 0.0,
-                                &K.matrix[h][pq][rs], ncols);
-                } /* Gr */
-            }     /* pq */
+#pragma omp parallel num_threads(nthreads)
+            {
+                std::vector<double> TMP(static_cast<size_t>(nso_) * nso_);
+#pragma omp for schedule(dynamic)
+                for (int pq = 0; pq < thisBucketRows; pq++) {
+                    for (int Gr = 0; Gr < nirreps_; Gr++) {
+                        // Transform ( a a | a a ) -> ( a a | a n )
+                        int Gs = h ^ Gr;
+                        int nrows = sopi_[Gr];
+                        int ncols = mopi_[Gs];
+                        int nlinks = mopi_[Gs];
+                        int rs = J.col_offset[h][Gr];
+                        double **pc = c->pointer(Gs);
+                        if (nrows && ncols && nlinks)
+                            C_DGEMM('n', 't', nrows, ncols, nlinks, 1.0, &J.matrix[h][pq][rs], nlinks, pc[0], ncols,
+                                    0.0, TMP.data(), nso_);
+
+                        // Transform ( a a | a n ) -> ( a a | n n )
+                        nrows = sopi_[Gr];
+                        ncols = sopi_[Gs];
+                        nlinks = mopi_[Gr];
+                        rs = K.col_offset[h][Gr];
+                        pc = c->pointer(Gr);
+                        if (nrows && ncols && nlinks)
+                            C_DGEMM('n', 'n', nrows, ncols, nlinks, 1.0, pc[0], nrows, TMP.data(), nso_, 0.0,
+                                    &K.matrix[h][pq][rs], ncols);
+                    } /* Gr */
+                }     /* pq */
+            }
             global_dpd_->buf4_mat_irrep_wrt_block(&K, h, n * rowsPerBucket, thisBucketRows);
         }
         global_dpd_->buf4_mat_irrep_close_block(&J, h, rowsPerBucket);
@@ -167,6 +180,7 @@ void IntegralTransform::backtransform_tpdm_restricted() {
 
     global_dpd_->buf4_init(&K, PSIF_AO_TPDM, 0, DPD_ID("[n>=n]+"), DPD_ID("[n,n]"), DPD_ID("[n>=n]+"),
                            DPD_ID("[n>=n]+"), 0, "SO Basis TPDM (nn|nn)");
+    init_so_tpdm_sort(&K);
 
     for (int h = 0; h < nirreps_; h++) {
         if (J.params->coltot[h] && J.params->rowtot[h]) {
@@ -198,41 +212,45 @@ void IntegralTransform::backtransform_tpdm_restricted() {
             else
                 thisBucketRows = (n < nBuckets - 1) ? rowsPerBucket : rowsLeft;
             global_dpd_->buf4_mat_irrep_rd_block(&J, h, n * rowsPerBucket, thisBucketRows);
-            for (int pq = 0; pq < thisBucketRows; pq++) {
-                for (int Gr = 0; Gr < nirreps_; Gr++) {
-                    // Transform ( n n | a a ) -> ( n n | a n )
-                    int Gs = h ^ Gr;
-                    int nrows = sopi_[Gr];
-                    int ncols = mopi_[Gs];
-                    int nlinks = mopi_[Gs];
-                    int rs = J.col_offset[h][Gr];
-                    double **pc = c->pointer(Gs);
-                    if (nrows && ncols && nlinks)
-                        C_DGEMM('n', 't', nrows, ncols, nlinks, 1.0, &J.matrix[h][pq][rs], nlinks, pc[0], ncols, 0.0,
-                                TMP[0], nso_);
-
-                    // Transform ( n n | n a ) -> ( n n | n n )
-                    nrows = sopi_[Gr];
-                    ncols = sopi_[Gs];
-                    nlinks = mopi_[Gr];
-                    rs = K.col_offset[h][Gr];
-                    pc = c->pointer(Gr);
-                    if (nrows && ncols && nlinks)
-                        C_DGEMM('n', 'n', nrows, ncols, nlinks, 1.0, pc[0], nrows, TMP[0], nso_, 0.0,
-                                &K.matrix[h][pq][rs], ncols);
-                } /* Gr */
-            }     /* pq */
+#pragma omp parallel num_threads(nthreads)
+            {
+                std::vector<double> TMP(static_cast<size_t>(nso_) * nso_);
+#pragma omp for schedule(dynamic)
+                for (int pq = 0; pq < thisBucketRows; pq++) {
+                    for (int Gr = 0; Gr < nirreps_; Gr++) {
+                        // Transform ( n n | a a ) -> ( n n | a n )
+                        int Gs = h ^ Gr;
+                        int nrows = sopi_[Gr];
+                        int ncols = mopi_[Gs];
+                        int nlinks = mopi_[Gs];
+                        int rs = J.col_offset[h][Gr];
+                        double **pc = c->pointer(Gs);
+                        if (nrows && ncols && nlinks)
+                            C_DGEMM('n', 't', nrows, ncols, nlinks, 1.0, &J.matrix[h][pq][rs], nlinks, pc[0], ncols,
+                                    0.0, TMP.data(), nso_);
+
+                        // Transform ( n n | n a ) -> ( n n | n n )
+                        nrows = sopi_[Gr];
+                        ncols = sopi_[Gs];
+                        nlinks = mopi_[Gr];
+                        rs = K.col_offset[h][Gr];
+                        pc = c->pointer(Gr);
+                        if (nrows && ncols && nlinks)
+                            C_DGEMM('n', 'n', nrows, ncols, nlinks, 1.0, pc[0], nrows, TMP.data(), nso_, 0.0,
+                                    &K.matrix[h][pq][rs], ncols);
+                    } /* Gr */
+                }     /* pq */
+            }
             sort_so_tpdm(&K, h, n * rowsPerBucket, thisBucketRows, (h == 0 && n == 0));
             if (write_dpd_so_tpdm_) global_dpd_->buf4_mat_irrep_wrt_block(&K, h, n * rowsPerBucket, thisBucketRows);
         }
         global_dpd_->buf4_mat_irrep_close_block(&J, h, rowsPerBucket);
         global_dpd_->buf4_mat_irrep_close_block(&K, h, rowsPerBucket);
     }
+    flush_so_tpdm();
     global_dpd_->buf4_close(&K);
     global_dpd_->buf4_close(&J);
 
-    free_block(TMP);
-
     psio_->close(PSIF_TPDM_HALFTRANS, keepHtTpdm_);
     psio_->close(PSIF_AO_TPDM, 1);
 
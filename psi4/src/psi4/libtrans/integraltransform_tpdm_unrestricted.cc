@@ -41,6 +41,11 @@
 #include <cmath>
 #include <cctype>
 #include <cstdio>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 using namespace psi;
 
@@ -65,7 +70,10 @@ void IntegralTransform::backtransform_tpdm_unrestricted() {
     size_t rowsLeft;
     size_t memFree;
 
-    double **TMP = block_matrix(nso_, nso_);
+    int nthreads = 1;
+#ifdef _OPENMP
+    nthreads = omp_get_max_threads();
+#endif
 
     /*** first half transformation ***/
 
@@ -120,58 +128,68 @@ void IntegralTransform::backtransform_tpdm_unrestricted() {
 
             global_dpd_->buf4_mat_irrep_init_block(&J1, h, rowsPerBucket);
             global_dpd_->buf4_mat_irrep_rd_block(&J1, h, n * rowsPerBucket, thisBucketRows);
-            for (int pq = 0; pq < thisBucketRows; pq++) {
-                for (int Gr = 0; Gr < nirreps_; Gr++) {
-                    // Transform ( A A | A A ) -> ( A A | A n )
-                    int Gs = h ^ Gr;
-                    int nrows = sopi_[Gr];
-                    int ncols = mopi_[Gs];
-                    int nlinks = mopi_[Gs];
-                    int rs = J1.col_offset[h][Gr];
-                    double **pca = ca->pointer(Gs);
-                    if (nrows && ncols && nlinks)
-                        C_DGEMM('n', 't', nrows, ncols, nlinks, 1.0, &J1.matrix[h][pq][rs], nlinks, pca[0], ncols, 0.0,
-                                TMP[0], nso_);
-
-                    // Transform ( A A | A n ) -> ( A A | n n )
-                    nrows = sopi_[Gr];
-                    ncols = sopi_[Gs];
-                    nlinks = mopi_[Gr];
-                    rs = K.col_offset[h][Gr];
-                    pca = ca->pointer(Gr);
-                    if (nrows && ncols && nlinks)
-                        C_DGEMM('n', 'n', nrows, ncols, nlinks, 1.0, pca[0], nrows, TMP[0], nso_, 0.0,
-                                &K.matrix[h][pq][rs], ncols);
-                } /* Gr */
-            }     /* pq */
+#pragma omp parallel num_threads(nthreads)
+            {
+                std::vector<double> TMP(static_cast<size_t>(nso_) * nso_);
+#pragma omp for schedule(dynamic)
+                for (int pq = 0; pq < thisBucketRows; pq++) {
+                    for (int Gr = 0; Gr < nirreps_; Gr++) {
+                        // Transform ( A A | A A ) -> ( A A | A n )
+                        int Gs = h ^ Gr;
+                        int nrows = sopi_[Gr];
+                        int ncols = mopi_[Gs];
+                        int nlinks = mopi_[Gs];
+                        int rs = J1.col_offset[h][Gr];
+                        double **pca = ca->pointer(Gs);
+                        if (nrows && ncols && nlinks)
+                            C_DGEMM('n', 't', nrows, ncols, nlinks, 1.0, &J1.matrix[h][pq][rs], nlinks, pca[0], ncols,
+                                    0.0, TMP.data(), nso_);
+
+                        // Transform ( A A | A n ) -> ( A A | n n )
+                        nrows = sopi_[Gr];
+                        ncols = sopi_[Gs];
+                        nlinks = mopi_[Gr];
+                        rs = K.col_offset[h][Gr];
+                        pca = ca->pointer(Gr);
+                        if (nrows && ncols && nlinks)
+                            C_DGEMM('n', 'n', nrows, ncols, nlinks, 1.0, pca[0], nrows, TMP.data(), nso_, 0.0,
+                                    &K.matrix[h][pq][rs], ncols);
+                    } /* Gr */
+                }     /* pq */
+            }
             global_dpd_->buf4_mat_irrep_close_block(&J1, h, rowsPerBucket);
 
             global_dpd_->buf4_mat_irrep_init_block(&J2, h, rowsPerBucket);
             global_dpd_->buf4_mat_irrep_rd_block(&J2, h, n * rowsPerBucket, thisBucketRows);
-            for (int pq = 0; pq < thisBucketRows; pq++) {
-                for (int Gr = 0; Gr < nirreps_; Gr++) {
-                    // Transform ( A A | a a ) -> ( A A | a n )
-                    int Gs = h ^ Gr;
-                    int nrows = sopi_[Gr];
-                    int ncols = mopi_[Gs];
-                    int nlinks = mopi_[Gs];
-                    int rs = J2.col_offset[h][Gr];
-                    double **pcb = cb->pointer(Gs);
-                    if (nrows && ncols && nlinks)
-                        C_DGEMM('n', 't', nrows, ncols, nlinks, 1.0, &J2.matrix[h][pq][rs], nlinks, pcb[0], ncols, 0.0,
-                                TMP[0], nso_);
-
-                    // Transform ( A A | a n ) -> ( A A | n n )
-                    nrows = sopi_[Gr];
-                    ncols = sopi_[Gs];
-                    nlinks = mopi_[Gr];
-                    rs = K.col_offset[h][Gr];
-                    pcb = cb->pointer(Gr);
-                    if (nrows && ncols && nlinks)
-                        C_DGEMM('n', 'n', nrows, ncols, nlinks, 1.0, pcb[0], nrows, TMP[0], nso_, 1.0,
-                                &K.matrix[h][pq][rs], ncols);
-                } /* Gr */
-            }     /* pq */
+#pragma omp parallel num_threads(nthreads)
+            {
+                std::vector<double> TMP(static_cast<size_t>(nso_) * nso_);
+#pragma omp for schedule(dynamic)
+                for (int pq = 0; pq < thisBucketRows; pq++) {
+                    for (int Gr = 0; Gr < nirreps_; Gr++) {
+                        // Transform ( A A | a a ) -> ( A A | a n )
+                        int Gs = h ^ Gr;
+                        int nrows = sopi_[Gr];
+                        int ncols = mopi_[Gs];
+                        int nlinks = mopi_[Gs];
+                        int rs = J2.col_offset[h][Gr];
+                        double **pcb = cb->pointer(Gs);
+                        if (nrows && ncols && nlinks)
+                            C_DGEMM('n', 't', nrows, ncols, nlinks, 1.0, &J2.matrix[h][pq][rs], nlinks, pcb[0], ncols,
+                                    0.0, TMP.data(), nso_);
+
+                        // Transform ( A A | a n ) -> ( A A | n n )
+                        nrows = sopi_[Gr];
+                        ncols = sopi_[Gs];
+                        nlinks = mopi_[Gr];
+                        rs = K.col_offset[h][Gr];
+                        pcb = cb->pointer(Gr);
+                        if (nrows && ncols && nlinks)
+                            C_DGEMM('n', 'n', nrows, ncols, nlinks, 1.0, pcb[0], nrows, TMP.data(), nso_, 1.0,
+                                    &K.matrix[h][pq][rs], ncols);
+                    } /* Gr */
+                }     /* pq */
+            }
             global_dpd_->buf4_mat_irrep_wrt_block(&K, h, n * rowsPerBucket, thisBucketRows);
             global_dpd_->buf4_mat_irrep_close_block(&J2, h, rowsPerBucket);
         }
@@ -219,30 +237,35 @@ void IntegralTransform::backtransform_tpdm_unrestricted() {
 
             global_dpd_->buf4_mat_irrep_init_block(&J1, h, rowsPerBucket);
             global_dpd_->buf4_mat_irrep_rd_block(&J1, h, n * rowsPerBucket, thisBucketRows);
-            for (int pq = 0; pq < thisBucketRows; pq++) {
-                for (int Gr = 0; Gr < nirreps_; Gr++) {
-                    // Transform ( a a | a a ) -> ( a a | a n )
-                    int Gs = h ^ Gr;
-                    int nrows = sopi_[Gr];
-                    int ncols = mopi_[Gs];
-                    int nlinks = mopi_[Gs];
-                    int rs = J1.col_offset[h][Gr];
-                    double **pcb = cb->pointer(Gs);
-                    if (nrows && ncols && nlinks)
-                        C_DGEMM('n', 't', nrows, ncols, nlinks, 1.0, &J1.matrix[h][pq][rs], nlinks, pcb[0], ncols, 0.0,
-                                TMP[0], nso_);
-
-                    // Transform ( a a | a n ) -> ( a a | n n )
-                    nrows = sopi_[Gr];
-                    ncols = sopi_[Gs];
-                    nlinks = mopi_[Gr];
-                    rs = K.col_offset[h][Gr];
-                    pcb = cb->pointer(Gr);
-                    if (nrows && ncols && nlinks)
-                        C_DGEMM('n', 'n', nrows, ncols, nlinks, 1.0, pcb[0], nrows, TMP[0], nso_, 0.0,
-                                &K.matrix[h][pq][rs], ncols);
-                } /* Gr */
-            }     /* pq */
+#pragma omp parallel num_threads(nthreads)
+            {
+                std::vector<double> TMP(static_cast<size_t>(nso_) * nso_);
+#pragma omp for schedule(dynamic)
+                for (int pq = 0; pq < thisBucketRows; pq++) {
+                    for (int Gr = 0; Gr < nirreps_; Gr++) {
+                        // Transform ( a a | a a ) -> ( a a | a n )
+                        int Gs = h ^ Gr;
+                        int nrows = sopi_[Gr];
+                        int ncols = mopi_[Gs];
+                        int nlinks = mopi_[Gs];
+                        int rs = J1.col_offset[h][Gr];
+                        double **pcb = cb->pointer(Gs);
+                        if (nrows && ncols && nlinks)
+                            C_DGEMM('n', 't', nrows, ncols, nlinks, 1.0, &J1.matrix[h][pq][rs], nlinks, pcb[0], ncols,
+                                    0.0, TMP.data(), nso_);
+
+                        // Transform ( a a | a n ) -> ( a a | n n )
+                        nrows = sopi_[Gr];
+                        ncols = sopi_[Gs];
+                        nlinks = mopi_[Gr];
+                        rs = K.col_offset[h][Gr];
+                        pcb = cb->pointer(Gr);
+                        if (nrows && ncols && nlinks)
+                            C_DGEMM('n', 'n', nrows, ncols, nlinks, 1.0, pcb[0], nrows, TMP.data(), nso_, 0.0,
+                                    &K.matrix[h][pq][rs], ncols);
+                    } /* Gr */
+                }     /* pq */
+            }
             global_dpd_->buf4_mat_irrep_wrt_block(&K, h, n * rowsPerBucket, thisBucketRows);
             global_dpd_->buf4_mat_irrep_close_block(&J1, h, rowsPerBucket);
         }
@@ -285,6 +308,7 @@ void IntegralTransform::backtransform_tpdm_unrestricted() {
                            DPD_ID("[a>=a]+"), 0, "Half-Transformed TPDM (nn|aa)");
     global_dpd_->buf4_init(&K, PSIF_AO_TPDM, 0, DPD_ID("[n>=n]+"), DPD_ID("[n,n]"), DPD_ID("[n>=n]+"),
                            DPD_ID("[n>=n]+"), 0, "SO Basis TPDM (nn|nn)");
+    init_so_tpdm_sort(&K);
 
     for (int h = 0; h < nirreps_; h++) {
         if (J1.params->coltot[h] && J1.params->rowtot[h]) {
@@ -317,71 +341,80 @@ void IntegralTransform::backtransform_tpdm_unrestricted() {
 
             global_dpd_->buf4_mat_irrep_init_block(&J1, h, rowsPerBucket);
             global_dpd_->buf4_mat_irrep_rd_block(&J1, h, n * rowsPerBucket, thisBucketRows);
-            for (int pq = 0; pq < thisBucketRows; pq++) {
-                for (int Gr = 0; Gr < nirreps_; Gr++) {
-                    // Transform ( n n | A A ) -> ( n n | A n )
-                    int Gs = h ^ Gr;
-                    int nrows = sopi_[Gr];
-                    int ncols = mopi_[Gs];
-                    int nlinks = mopi_[Gs];
-                    int rs = J1.col_offset[h][Gr];
-                    double **pca = ca->pointer(Gs);
-                    if (nrows && ncols && nlinks)
-                        C_DGEMM('n', 't', nrows, ncols, nlinks, 1.0, &J1.matrix[h][pq][rs], nlinks, pca[0], ncols, 0.0,
-                                TMP[0], nso_);
-
-                    // Transform ( n n | n A ) -> ( n n | n n )
-                    nrows = sopi_[Gr];
-                    ncols = sopi_[Gs];
-                    nlinks = mopi_[Gr];
-                    rs = K.col_offset[h][Gr];
-                    pca = ca->pointer(Gr);
-                    if (nrows && ncols && nlinks)
-                        C_DGEMM('n', 'n', nrows, ncols, nlinks, 1.0, pca[0], nrows, TMP[0], nso_, 0.0,
-                                &K.matrix[h][pq][rs], ncols);
-                } /* Gr */
-            }     /* pq */
+#pragma omp parallel num_threads(nthreads)
+            {
+                std::vector<double> TMP(static_cast<size_t>(nso_) * nso_);
+#pragma omp for schedule(dynamic)
+                for (int pq = 0; pq < thisBucketRows; pq++) {
+                    for (int Gr = 0; Gr < nirreps_; Gr++) {
+                        // Transform ( n n | A A ) -> ( n n | A n )
+                        int Gs = h ^ Gr;
+                        int nrows = sopi_[Gr];
+                        int ncols = mopi_[Gs];
+                        int nlinks = mopi_[Gs];
+                        int rs = J1.col_offset[h][Gr];
+                        double **pca = ca->pointer(Gs);
+                        if (nrows && ncols && nlinks)
+                            C_DGEMM('n', 't', nrows, ncols, nlinks, 1.0, &J1.matrix[h][pq][rs], nlinks, pca[0], ncols,
+                                    0.0, TMP.data(), nso_);
+
+                        // Transform ( n n | n A ) -> ( n n | n n )
+                        nrows = sopi_[Gr];
+                        ncols = sopi_[Gs];
+                        nlinks = mopi_[Gr];
+                        rs = K.col_offset[h][Gr];
+                        pca = ca->pointer(Gr);
+                        if (nrows && ncols && nlinks)
+                            C_DGEMM('n', 'n', nrows, ncols, nlinks, 1.0, pca[0], nrows, TMP.data(), nso_, 0.0,
+                                    &K.matrix[h][pq][rs], ncols);
+                    } /* Gr */
+                }     /* pq */
+            }
             global_dpd_->buf4_mat_irrep_close_block(&J1, h, rowsPerBucket);
 
             global_dpd_->buf4_mat_irrep_init_block(&J2, h, rowsPerBucket);
             global_dpd_->buf4_mat_irrep_rd_block(&J2, h, n * rowsPerBucket, thisBucketRows);
-            for (int pq = 0; pq < thisBucketRows; pq++) {
-                int PQ = n * rowsPerBucket + pq;  // The absolute pq value
-                for (int Gr = 0; Gr < nirreps_; Gr++) {
-                    // Transform ( n n | a a ) -> ( n n | a n )
-                    int Gs = h ^ Gr;
-                    int nrows = sopi_[Gr];
-                    int ncols = mopi_[Gs];
-                    int nlinks = mopi_[Gs];
-                    int rs = J2.col_offset[h][Gr];
-                    double **pcb = cb->pointer(Gs);
-                    if (nrows && ncols && nlinks)
-                        C_DGEMM('n', 't', nrows, ncols, nlinks, 1.0, &J2.matrix[h][pq][rs], nlinks, pcb[0], ncols, 0.0,
-                                TMP[0], nso_);
-
-                    // Transform ( n n | n a ) -> ( n n | n n )
-                    nrows = sopi_[Gr];
-                    ncols = sopi_[Gs];
-                    nlinks = mopi_[Gr];
-                    rs = K.col_offset[h][Gr];
-                    pcb = cb->pointer(Gr);
-                    if (nrows && ncols && nlinks)
-                        C_DGEMM('n', 'n', nrows, ncols, nlinks, 1.0, pcb[0], nrows, TMP[0], nso_, 1.0,
-                                &K.matrix[h][pq][rs], ncols);
-                } /* Gr */
-            }     /* pq */
+#pragma omp parallel num_threads(nthreads)
+            {
+                std::vector<double> TMP(static_cast<size_t>(nso_) * nso_);
+#pragma omp for schedule(dynamic)
+                for (int pq = 0; pq < thisBucketRows; pq++) {
+                    int PQ = n * rowsPerBucket + pq;  // The absolute pq value
+                    for (int Gr = 0; Gr < nirreps_; Gr++) {
+                        // Transform ( n n | a a ) -> ( n n | a n )
+                        int Gs = h ^ Gr;
+                        int nrows = sopi_[Gr];
+                        int ncols = mopi_[Gs];
+                        int nlinks = mopi_[Gs];
+                        int rs = J2.col_offset[h][Gr];
+                        double **pcb = cb->pointer(Gs);
+                        if (nrows && ncols && nlinks)
+                            C_DGEMM('n', 't', nrows, ncols, nlinks, 1.0, &J2.matrix[h][pq][rs], nlinks, pcb[0], ncols,
+                                    0.0, TMP.data(), nso_);
+
+                        // Transform ( n n | n a ) -> ( n n | n n )
+                        nrows = sopi_[Gr];
+                        ncols = sopi_[Gs];
+                        nlinks = mopi_[Gr];
+                        rs = K.col_offset[h][Gr];
+                        pcb = cb->pointer(Gr);
+                        if (nrows && ncols && nlinks)
+                            C_DGEMM('n', 'n', nrows, ncols, nlinks, 1.0, pcb[0], nrows, TMP.data(), nso_, 1.0,
+                                    &K.matrix[h][pq][rs], ncols);
+                    } /* Gr */
+                }     /* pq */
+            }
             global_dpd_->buf4_mat_irrep_close_block(&J2, h, rowsPerBucket);
             sort_so_tpdm(&K, h, n * rowsPerBucket, thisBucketRows, (h == 0 && n == 0));
             if (write_dpd_so_tpdm_) global_dpd_->buf4_mat_irrep_wrt_block(&K, h, n * rowsPerBucket, thisBucketRows);
         }
         global_dpd_->buf4_mat_irrep_close_block(&K, h, rowsPerBucket);
     }
+    flush_so_tpdm();
     global_dpd_->buf4_close(&K);
     global_dpd_->buf4_close(&J1);
     global_dpd_->buf4_close(&J2);
 
-    free_block(TMP);
-
     psio_->close(PSIF_TPDM_HALFTRANS, keepHtTpdm_);
     psio_->close(PSIF_AO_TPDM, 1);
 
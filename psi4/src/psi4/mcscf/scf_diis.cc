@@ -74,6 +74,8 @@ void SCF::diis(int cycle) {
         outfile->Printf("/E");
         int matrix_size = ndiis + 1;
 
+        // The extrapolation scratch lives in an arena released at the end of the step
+        memory_manager->push_arena();
         double** diis_B;
         double* diis_A;
         allocate1(double, diis_A, matrix_size);
@@ -127,6 +129,7 @@ void SCF::diis(int cycle) {
 
         release1(diis_A);
         release2(diis_B);
+        memory_manager->pop_arena();
     }
     current_diis++;
     if (current_diis == ndiis) current_diis = 0;
@@ -63,6 +63,7 @@ double SCF::energy(int cycle, double old_energy) {
             norm_ci_grad += std::fabs(ci_grad[I]);
         }
 
+        memory_manager->push_arena();
         double* eigenvalues;
         double** eigenvectors;
         allocate1(double, eigenvalues, nci);
@@ -79,6 +80,7 @@ double SCF::energy(int cycle, double old_energy) {
         }
         release1(eigenvalues);
         release2(eigenvectors);
+        memory_manager->pop_arena();
     }
 
     return (total_energy);
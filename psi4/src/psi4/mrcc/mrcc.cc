@@ -47,6 +47,7 @@
 #include "psi4/libpsio/psio.hpp"
 #include "psi4/libqt/qt.h"
 #include "psi4/libscf_solver/rohf.h"
+#include "psi4/libtrans/fcidump_helper.h"
 #include "psi4/libtrans/integraltransform.h"
 #include "psi4/libtrans/mospace.h"
 
@@ -71,22 +72,9 @@ void write_oei_to_disk(std::shared_ptr<PsiOutStream> &printer, SharedMatrix moH)
 }
 
 void write_tei_to_disk(std::shared_ptr<PsiOutStream> &printer, int nirrep, dpdbuf4 &K, double ints_tolerance) {
-    for (int h = 0; h < nirrep; ++h) {
-        global_dpd_->buf4_mat_irrep_init(&K, h);
-        global_dpd_->buf4_mat_irrep_rd(&K, h);
-        for (int pq = 0; pq < K.params->rowtot[h]; ++pq) {
-            int p = K.params->roworb[h][pq][0];
-            int q = K.params->roworb[h][pq][1];
-            for (int rs = 0; rs < K.params->coltot[h]; ++rs) {
-                int r = K.params->colorb[h][rs][0];
-                int s = K.params->colorb[h][rs][1];
-
-                if (std::fabs(K.matrix[h][pq][rs]) > ints_tolerance)
-                    printer->Printf("%28.20E%4d%4d%4d%4d\n", K.matrix[h][pq][rs], p + 1, q + 1, r + 1, s + 1);
-            }
-        }
-        global_dpd_->buf4_mat_irrep_close(&K, h);
-    }
+    // fort.55 uses the FCIDUMP line layout, so share its threaded, panel-buffered writer
+    auto mo_index = [](const int i) { return i + 1; };
+    fcidump::detail::write_tei_to_disk(printer, nirrep, K, ints_tolerance, mo_index, mo_index);
 }
 
 void print_dim(const std::string &name, const Dimension &dim) {
@@ -119,6 +119,7 @@ void OCCWave::gfock() {
             // Build Virtual-Virtual block of correlation OPDM
             global_dpd_->file2_init(&G, PSIF_OCC_DENSITY, 0, ID('V'), ID('V'), "CORR OPDM <V|V>");
             global_dpd_->file2_mat_init(&G);
+#pragma omp parallel for
             for (int h = 0; h < nirrep_; ++h) {
                 for (int i = 0; i < avirtpiA[h]; ++i) {
                     for (int j = 0; j < avirtpiA[h]; ++j) {
@@ -338,6 +339,7 @@ void OCCWave::gfock() {
         global_dpd_->file2_init(&GF, PSIF_OCC_DENSITY, 0, ID('V'), ID('O'), "GF <V|O>");
         global_dpd_->file2_mat_init(&GF);
         global_dpd_->file2_mat_rd(&GF);
+#pragma omp parallel for
         for (int h = 0; h < nirrep_; ++h) {
             for (int a = 0; a < virtpiA[h]; ++a) {
                 for (int i = 0; i < occpiA[h]; ++i) {
@@ -351,6 +353,7 @@ void OCCWave::gfock() {
         global_dpd_->file2_init(&GF, PSIF_OCC_DENSITY, 0, ID('O'), ID('V'), "GF <O|V>");
         global_dpd_->file2_mat_init(&GF);
         global_dpd_->file2_mat_rd(&GF);
+#pragma omp parallel for
         for (int h = 0; h < nirrep_; ++h) {
             for (int i = 0; i < occpiA[h]; ++i) {
                 for (int a = 0; a < virtpiA[h]; ++a) {
@@ -997,6 +1000,7 @@ void OCCWave::gfock() {
         global_dpd_->file2_init(&GF, PSIF_OCC_DENSITY, 0, ID('V'), ID('O'), "GF <V|O>");
         global_dpd_->file2_mat_init(&GF);
         global_dpd_->file2_mat_rd(&GF);
+#pragma omp parallel for
         for (int h = 0; h < nirrep_; ++h) {
             for (int a = 0; a < virtpiA[h]; ++a) {
                 for (int i = 0; i < occpiA[h]; ++i) {
@@ -1010,6 +1014,7 @@ void OCCWave::gfock() {
         global_dpd_->file2_init(&GF, PSIF_OCC_DENSITY, 0, ID('v'), ID('o'), "GF <v|o>");
         global_dpd_->file2_mat_init(&GF);
         global_dpd_->file2_mat_rd(&GF);
+#pragma omp parallel for
         for (int h = 0; h < nirrep_; ++h) {
             for (int a = 0; a < virtpiB[h]; ++a) {
                 for (int i = 0; i < occpiB[h]; ++i) {
@@ -1023,6 +1028,7 @@ void OCCWave::gfock() {
         global_dpd_->file2_init(&GF, PSIF_OCC_DENSITY, 0, ID('O'), ID('V'), "GF <O|V>");
         global_dpd_->file2_mat_init(&GF);
         global_dpd_->file2_mat_rd(&GF);
+#pragma omp parallel for
         for (int h = 0; h < nirrep_; ++h) {
             for (int i = 0; i < occpiA[h]; ++i) {
                 for (int a = 0; a < virtpiA[h]; ++a) {
@@ -1036,6 +1042,7 @@ void OCCWave::gfock() {
         global_dpd_->file2_init(&GF, PSIF_OCC_DENSITY, 0, ID('o'), ID('v'), "GF <o|v>");
         global_dpd_->file2_mat_init(&GF);
         global_dpd_->file2_mat_rd(&GF);
+#pragma omp parallel for
         for (int h = 0; h < nirrep_; ++h) {
             for (int i = 0; i < occpiB[h]; ++i) {
                 for (int a = 0; a < virtpiB[h]; ++a) {
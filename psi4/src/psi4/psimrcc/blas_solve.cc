@@ -26,9 +26,15 @@
  * @END LICENSE
  */
 
+#include <algorithm>
 #include <cstdio>
+#include <set>
 #include "psi4/libmoinfo/libmoinfo.h"
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #include "blas.h"
 
 namespace psi {
@@ -187,13 +193,8 @@ void CCBLAS::compute() {
             matrices_in_deque_source[it->get_C_Matrix()]++;
         }
     }
-    while (!operations.empty()) {
-        // Read the element
-        CCOperation& op = operations.front();
-        // Compute the operation
-        op.compute();
-
-        // Decrease the counters for the matrices to be processed
+    // Decrease the counters for the matrices processed by an operation
+    auto release_operation = [&](CCOperation& op) {
         if (op.get_A_Matrix() != nullptr) {
             matrices_in_deque[op.get_A_Matrix()]--;
             matrices_in_deque_target[op.get_A_Matrix()]--;
@@ -206,8 +207,59 @@ void CCBLAS::compute() {
             matrices_in_deque[op.get_C_Matrix()]--;
             matrices_in_deque_source[op.get_C_Matrix()]--;
         }
-        // Eliminate the element
-        operations.pop_front();
+    };
+
+    int nthreads = std::min(static_cast<int>(work.size()), options_.get_int("CC_NUM_THREADS"));
+    if (full_in_core && nthreads > 1) {
+        while (!operations.empty()) {
+            // Collect the leading operations that do not depend on each other: no operation in the
+            // batch may read or write a matrix that another operation in the batch writes
+            std::vector<CCOperation*> batch;
+            std::set<CCMatrix*> targets;
+            std::set<CCMatrix*> sources;
+            for (OpDeque::iterator it = operations.begin(); it != operations.end(); ++it) {
+                CCMatrix* A = it->get_A_Matrix();
+                CCMatrix* B = it->get_B_Matrix();
+                CCMatrix* C = it->get_C_Matrix();
+                if (targets.count(A) || sources.count(A) || targets.count(B) || targets.count(C)) break;
+                batch.push_back(&(*it));
+                targets.insert(A);
+                if (B != nullptr) sources.insert(B);
+                if (C != nullptr) sources.insert(C);
+            }
+            // Loading is not thread safe, make sure all the matrices are in core beforehand
+            for (size_t n = 0; n < batch.size(); ++n) {
+                load(batch[n]->get_A_Matrix());
+                if (batch[n]->get_B_Matrix() != nullptr) load(batch[n]->get_B_Matrix());
+                if (batch[n]->get_C_Matrix() != nullptr) load(batch[n]->get_C_Matrix());
+            }
+            // Compute the batch, each thread uses its own work and buffer arrays
+            int nbatch = static_cast<int>(batch.size());
+#pragma omp parallel for schedule(dynamic) num_threads(nthreads) if (nbatch > 1)
+            for (int n = 0; n < nbatch; ++n) {
+                int thread = 0;
+#ifdef _OPENMP
+                thread = omp_get_thread_num();
+#endif
+                batch[n]->set_scratch(work[thread].data(), buffer[thread].data());
+                batch[n]->compute();
+            }
+            for (int n = 0; n < nbatch; ++n) {
+                release_operation(operations.front());
+                operations.pop_front();
+            }
+        }
+    } else {
+        while (!operations.empty()) {
+            // Read the element
+            CCOperation& op = operations.front();
+            // Compute the operation
+            op.compute();
+            // Decrease the counters for the matrices to be processed
+            release_operation(op);
+            // Eliminate the element
+            operations.pop_front();
+        }
     }
 }
 
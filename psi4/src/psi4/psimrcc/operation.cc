@@ -36,8 +36,6 @@ namespace psi {
 
 namespace psimrcc {
 
-double* CCOperation::local_work = nullptr;
-double* CCOperation::out_of_core_buffer = nullptr;
 double CCOperation::zero_timing = 0.0;
 double CCOperation::numerical_timing = 0.0;
 double CCOperation::contract_timing = 0.0;
@@ -58,6 +56,8 @@ CCOperation::CCOperation(double in_factor, std::string in_assignment, std::strin
       assignment(in_assignment),
       reindexing(in_reindexing),
       operation(in_operation),
+      out_of_core_buffer(buffer),
+      local_work(work),
       A_Matrix(in_A_Matrix),
       B_Matrix(in_B_Matrix),
       C_Matrix(in_C_Matrix) {
@@ -68,8 +68,6 @@ CCOperation::CCOperation(double in_factor, std::string in_assignment, std::strin
     } else {
         wfn_ = in_A_Matrix->wfn();
     }
-    local_work = work;
-    out_of_core_buffer = buffer;
 }
 
 CCOperation::~CCOperation() {}
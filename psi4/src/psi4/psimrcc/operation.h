@@ -56,6 +56,11 @@ class CCOperation {
     void print();
     void print_operation();
     void compute();
+    // Point the operation at the scratch arrays of the thread that will execute it
+    void set_scratch(double* work, double* buffer) {
+        local_work = work;
+        out_of_core_buffer = buffer;
+    }
 
    private:
     //            Variable        Syntax (p,q,r,s=integers)
@@ -63,8 +68,8 @@ class CCOperation {
     std::string assignment;  // = += >= +>=
     std::string reindexing;  // ## #pq# #pqrs#
     std::string operation;   // . @ / * X plus
-    static double* out_of_core_buffer;
-    static double* local_work;
+    double* out_of_core_buffer;
+    double* local_work;
     CCMatrix* A_Matrix;
     CCMatrix* B_Matrix;
     CCMatrix* C_Matrix;
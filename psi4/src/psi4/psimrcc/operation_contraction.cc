@@ -81,14 +81,23 @@ void CCOperation::setup_contractions() {
         if (T_matrix_offset > 0) zero_arr(&(local_work[0]), T_matrix_offset);
     }
 
+#pragma omp atomic
     PartA_timing += PartA.get();
     Timer PartB;
 
-    double** A_matrix;
-    double** B_matrix;
-    double** C_matrix;
+    // With B and C fully in core the irrep blocks of the target are independent and are contracted concurrently
+    int nirreps = wfn_->moinfo()->get_nirreps();
+    bool blocks_in_core = true;
+    for (int h = 0; h < nirreps; h++) {
+        bool B_out_of_core = !B_Matrix->is_block_allocated(h);
+        bool C_out_of_core = !C_Matrix->is_block_allocated(h);
+        if (B_out_of_core && B_Matrix->is_integral() && C_out_of_core && C_Matrix->is_integral())
+            throw PSIEXCEPTION("BOTH ON DISK MULTIPLY");
+        if (B_out_of_core || C_out_of_core) blocks_in_core = false;
+    }
 
-    for (int h = 0; h < wfn_->moinfo()->get_nirreps(); h++) {
+#pragma omp parallel for schedule(dynamic) if (blocks_in_core && nirreps > 1)
+    for (int h = 0; h < nirreps; h++) {
         bool B_on_disk = false;
         bool C_on_disk = false;
         if (!B_Matrix->is_block_allocated(h)) {
@@ -105,7 +114,6 @@ void CCOperation::setup_contractions() {
                 C_Matrix->load_irrep(h);
             }
         }
-        if (B_on_disk && C_on_disk) throw PSIEXCEPTION("BOTH ON DISK MULTIPLY");
 
         //////////////////////////////////////////////////////////
         // Case I. A,B,C are in core. Perform direct a BLAS call
@@ -113,9 +121,9 @@ void CCOperation::setup_contractions() {
         //////////////////////////////////////////////////////////
         if (!B_on_disk && !C_on_disk) {
             size_t offset = 0;
-            A_matrix = T_matrix[h];
-            B_matrix = B_Matrix->get_matrix()[h];
-            C_matrix = C_Matrix->get_matrix()[h];
+            double** A_matrix = T_matrix[h];
+            double** B_matrix = B_Matrix->get_matrix()[h];
+            double** C_matrix = C_Matrix->get_matrix()[h];
             size_t rows_A = T_left->get_pairpi(h);
             size_t cols_A = T_right->get_pairpi(h);
             size_t rows_B = B_Matrix->get_left_pairpi(h);
@@ -129,6 +137,7 @@ void CCOperation::setup_contractions() {
             contract_in_core(A_matrix, B_matrix, C_matrix, B_on_disk, C_on_disk, rows_A, rows_B, rows_C, cols_A, cols_B,
                              cols_C, offset);
             // Store the timing in moinfo
+#pragma omp critical(psimrcc_dgemm_timing)
             wfn_->moinfo()->add_dgemm_timing(timer.get());
         }
 
@@ -166,6 +175,7 @@ void CCOperation::setup_contractions() {
                     contract_in_core(A_matrix, B_matrix, C_matrix, B_on_disk, C_on_disk, rows_A, rows_B, rows_C, cols_A,
                                      cols_B, cols_C, offset);
                     // Store the timing in moinfo
+#pragma omp critical(psimrcc_dgemm_timing)
                     wfn_->moinfo()->add_dgemm_timing(timer.get());
                     offset += strip_length;
                 }
@@ -207,6 +217,7 @@ void CCOperation::setup_contractions() {
                     contract_in_core(A_matrix, B_matrix, C_matrix, B_on_disk, C_on_disk, rows_A, rows_B, rows_C, cols_A,
                                      cols_B, cols_C, offset);
                     // Store the timing in moinfo
+#pragma omp critical(psimrcc_dgemm_timing)
                     wfn_->moinfo()->add_dgemm_timing(timer.get());
                     offset += strip_length;
                 }
@@ -216,6 +227,7 @@ void CCOperation::setup_contractions() {
         }
     }  // end of for loop over irreps
 
+#pragma omp atomic
     PartB_timing += PartB.get();
     Timer PartC;
     if (need_sort) {
@@ -224,6 +236,7 @@ void CCOperation::setup_contractions() {
             //       if(T_left->get_pairpi(h)*T_right->get_pairpi(h)>0)
             delete[] T_matrix[h];
     }
+#pragma omp atomic
     PartC_timing += PartC.get();
 }
 
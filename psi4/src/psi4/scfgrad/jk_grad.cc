@@ -45,6 +45,9 @@
 #include "psi4/liboptions/liboptions.h"
 #include "psi4/libpsi4util/process.h"
 
+#include <algorithm>
+#include <numeric>
+
 #ifdef _OPENMP
 #include <omp.h>
 #endif
@@ -96,7 +99,8 @@ std::shared_ptr<JKGrad> JKGrad::build_JKGrad(int deriv, std::shared_ptr<MintsHel
             jk->set_df_ints_num_threads(options.get_int("DF_INTS_NUM_THREADS"));
 
         return std::shared_ptr<JKGrad>(jk);
-    } else if (options.get_str("SCF_TYPE") == "DIRECT" || options.get_str("SCF_TYPE") == "PK" || options.get_str("SCF_TYPE") == "OUT_OF_CORE") {
+    } else if (options.get_str("SCF_TYPE") == "DIRECT" || options.get_str("SCF_TYPE") == "PK" ||
+               options.get_str("SCF_TYPE") == "OUT_OF_CORE" || options.get_str("SCF_TYPE") == "AUTO") {
 
         DirectJKGrad* jk = new DirectJKGrad(deriv, mints->get_basisset("ORBITAL"));
 
@@ -868,7 +872,6 @@ void DFJKGrad::build_AB_x_terms()
 void DFJKGrad::build_Amn_x_terms() {
     // => Sizing <= //
 
-    int natom = primary_->molecule()->natom();
     int nso = primary_->nbf();
     int naux = auxiliary_->nbf();
     int na = Ca_->colspi()[0];
@@ -973,22 +976,22 @@ void DFJKGrad::build_Amn_x_terms() {
     psio_address next_Awija = PSIO_ZERO;
     psio_address next_Awijb = PSIO_ZERO;
 
-    // => Temporary Gradients <= //
+    // => Gradients <= //
 
-    std::vector<SharedMatrix> Jtemps;
-    std::vector<SharedMatrix> Ktemps;
-    std::vector<SharedMatrix> wKtemps;
-    for (int t = 0; t < df_ints_num_threads_; t++) {
-        if (do_J_) {
-            Jtemps.push_back(std::make_shared<Matrix>("Jtemp", natom, 3));
-        }
-        if (do_K_) {
-            Ktemps.push_back(std::make_shared<Matrix>("Ktemp", natom, 3));
-        }
-        if (do_wK_) {
-            wKtemps.push_back(std::make_shared<Matrix>("wKtemp", natom, 3));
-        }
-    }
+    // Each task adds its three centers straight into the shared gradients, rather than into per-thread copies
+    double** grad_Jp = do_J_ ? gradients_["Coulomb"]->pointer() : nullptr;
+    double** grad_Kp = do_K_ ? gradients_["Exchange"]->pointer() : nullptr;
+    double** grad_wKp = do_wK_ ? gradients_["Exchange,LR"]->pointer() : nullptr;
+
+    // => Task Ordering <= //
+
+    // Most expensive shell pairs first within every auxiliary shell
+    std::vector<int> pair_order(npairs);
+    std::iota(pair_order.begin(), pair_order.end(), 0);
+    std::stable_sort(pair_order.begin(), pair_order.end(), [&](int MN1, int MN2) {
+        return primary_->shell(shell_pairs[MN1].first).nfunction() * primary_->shell(shell_pairs[MN1].second).nfunction() >
+               primary_->shell(shell_pairs[MN2].first).nfunction() * primary_->shell(shell_pairs[MN2].second).nfunction();
+    });
 
     // => R/U doubling factor <= //
 
@@ -1055,6 +1058,13 @@ void DFJKGrad::build_Amn_x_terms() {
         }
 
         // > Integrals < //
+        // Largest auxiliary shells first, so the cheap tasks fill in the tail of the dynamic schedule
+        std::vector<int> Porder(NP);
+        std::iota(Porder.begin(), Porder.end(), Pstart);
+        std::stable_sort(Porder.begin(), Porder.end(), [&](int P1, int P2) {
+            return auxiliary_->shell(P1).nfunction() > auxiliary_->shell(P2).nfunction();
+        });
+
         int nthread_df = df_ints_num_threads_;
 #pragma omp parallel for schedule(dynamic) num_threads(nthread_df)
         for (long int PMN = 0L; PMN < static_cast<long>(NP) * npairs; PMN++) {
@@ -1063,27 +1073,22 @@ void DFJKGrad::build_Amn_x_terms() {
             thread = omp_get_thread_num();
 #endif
 
-            int P = PMN / npairs + Pstart;
-            int MN = PMN % npairs;
+            int P = Porder[PMN / npairs];
+            int MN = pair_order[PMN % npairs];
             int M = shell_pairs[MN].first;
             int N = shell_pairs[MN].second;
 
             eri[thread]->compute_shell_deriv1(P, 0, M, N);
 
-            const double* buffer = eri[thread]->buffer();
-
             int nP = auxiliary_->shell(P).nfunction();
-            int cP = auxiliary_->shell(P).ncartesian();
             int aP = auxiliary_->shell(P).ncenter();
             int oP = auxiliary_->shell(P).function_index() - pstart;
 
             int nM = primary_->shell(M).nfunction();
-            int cM = primary_->shell(M).ncartesian();
             int aM = primary_->shell(M).ncenter();
             int oM = primary_->shell(M).function_index();
 
             int nN = primary_->shell(N).nfunction();
-            int cN = primary_->shell(N).ncartesian();
             int aN = primary_->shell(N).ncenter();
             int oN = primary_->shell(N).function_index();
 
@@ -1100,19 +1105,11 @@ void DFJKGrad::build_Amn_x_terms() {
 
             double perm = (M == N ? 1.0 : 2.0);
 
-            double** grad_Jp;
-            double** grad_Kp;
-            double** grad_wKp;
-
-            if (do_J_) {
-                grad_Jp = Jtemps[thread]->pointer();
-            }
-            if (do_K_) {
-                grad_Kp = Ktemps[thread]->pointer();
-            }
-            if (do_wK_) {
-                grad_wKp = wKtemps[thread]->pointer();
-            }
+            // The three centers are fixed within a task, so the contractions are kept in registers,
+            // [P, M, N][x, y, z], and only added into the gradients once per task
+            double gJ[3][3] = {};
+            double gK[3][3] = {};
+            double gwK[3][3] = {};
 
             for (int p = 0; p < nP; p++) {
                 for (int m = 0; m < nM; m++) {
@@ -1120,43 +1117,43 @@ void DFJKGrad::build_Amn_x_terms() {
                         //  J^x = (A|pq)^x d_A Dt_pq
                         if (do_J_) {
                             double Ival = 1.0 * perm * dp[p + oP + pstart] * Dtp[m + oM][n + oN];
-                            grad_Jp[aP][0] += Ival * (*Px);
-                            grad_Jp[aP][1] += Ival * (*Py);
-                            grad_Jp[aP][2] += Ival * (*Pz);
-                            grad_Jp[aM][0] += Ival * (*Mx);
-                            grad_Jp[aM][1] += Ival * (*My);
-                            grad_Jp[aM][2] += Ival * (*Mz);
-                            grad_Jp[aN][0] += Ival * (*Nx);
-                            grad_Jp[aN][1] += Ival * (*Ny);
-                            grad_Jp[aN][2] += Ival * (*Nz);
+                            gJ[0][0] += Ival * (*Px);
+                            gJ[0][1] += Ival * (*Py);
+                            gJ[0][2] += Ival * (*Pz);
+                            gJ[1][0] += Ival * (*Mx);
+                            gJ[1][1] += Ival * (*My);
+                            gJ[1][2] += Ival * (*Mz);
+                            gJ[2][0] += Ival * (*Nx);
+                            gJ[2][1] += Ival * (*Ny);
+                            gJ[2][2] += Ival * (*Nz);
                         }
 
                         //  K^x = (A|pq)^x (A|pq)
                         if (do_K_) {
                             double Kval = 1.0 * perm * Kmnp[p + oP][(m + oM) * nso + (n + oN)];
-                            grad_Kp[aP][0] += Kval * (*Px);
-                            grad_Kp[aP][1] += Kval * (*Py);
-                            grad_Kp[aP][2] += Kval * (*Pz);
-                            grad_Kp[aM][0] += Kval * (*Mx);
-                            grad_Kp[aM][1] += Kval * (*My);
-                            grad_Kp[aM][2] += Kval * (*Mz);
-                            grad_Kp[aN][0] += Kval * (*Nx);
-                            grad_Kp[aN][1] += Kval * (*Ny);
-                            grad_Kp[aN][2] += Kval * (*Nz);
+                            gK[0][0] += Kval * (*Px);
+                            gK[0][1] += Kval * (*Py);
+                            gK[0][2] += Kval * (*Pz);
+                            gK[1][0] += Kval * (*Mx);
+                            gK[1][1] += Kval * (*My);
+                            gK[1][2] += Kval * (*Mz);
+                            gK[2][0] += Kval * (*Nx);
+                            gK[2][1] += Kval * (*Ny);
+                            gK[2][2] += Kval * (*Nz);
                         }
 
                         // wK^x = 0.5 * (A|pq)^x (A|w|pq)
                         if (do_wK_) {
                             double wKval = 0.5 * perm * wKmnp[p + oP][(m + oM) * nso + (n + oN)];
-                            grad_wKp[aP][0] += wKval * (*Px);
-                            grad_wKp[aP][1] += wKval * (*Py);
-                            grad_wKp[aP][2] += wKval * (*Pz);
-                            grad_wKp[aM][0] += wKval * (*Mx);
-                            grad_wKp[aM][1] += wKval * (*My);
-                            grad_wKp[aM][2] += wKval * (*Mz);
-                            grad_wKp[aN][0] += wKval * (*Nx);
-                            grad_wKp[aN][1] += wKval * (*Ny);
-                            grad_wKp[aN][2] += wKval * (*Nz);
+                            gwK[0][0] += wKval * (*Px);
+                            gwK[0][1] += wKval * (*Py);
+                            gwK[0][2] += wKval * (*Pz);
+                            gwK[1][0] += wKval * (*Mx);
+                            gwK[1][1] += wKval * (*My);
+                            gwK[1][2] += wKval * (*Mz);
+                            gwK[2][0] += wKval * (*Nx);
+                            gwK[2][1] += wKval * (*Ny);
+                            gwK[2][2] += wKval * (*Nz);
                         }
 
                         Px++;
@@ -1175,7 +1172,6 @@ void DFJKGrad::build_Amn_x_terms() {
             //  wK^x = 0.5 * (A|w|pq)^x (A|pq)
             if (do_wK_) {
                 omega_eri[thread]->compute_shell_deriv1(P, 0, M, N);
-                const double* buffer = omega_eri[thread]->buffer();
 
                 const auto buffers = omega_eri[thread]->buffers();
                 const double* Px = buffers[0];
@@ -1192,15 +1188,15 @@ void DFJKGrad::build_Amn_x_terms() {
                     for (int m = 0; m < nM; m++) {
                         for (int n = 0; n < nN; n++) {
                             double wKval = 0.5 * perm * Kmnp[p + oP][(m + oM) * nso + (n + oN)];
-                            grad_wKp[aP][0] += wKval * (*Px);
-                            grad_wKp[aP][1] += wKval * (*Py);
-                            grad_wKp[aP][2] += wKval * (*Pz);
-                            grad_wKp[aM][0] += wKval * (*Mx);
-                            grad_wKp[aM][1] += wKval * (*My);
-                            grad_wKp[aM][2] += wKval * (*Mz);
-                            grad_wKp[aN][0] += wKval * (*Nx);
-                            grad_wKp[aN][1] += wKval * (*Ny);
-                            grad_wKp[aN][2] += wKval * (*Nz);
+                            gwK[0][0] += wKval * (*Px);
+                            gwK[0][1] += wKval * (*Py);
+                            gwK[0][2] += wKval * (*Pz);
+                            gwK[1][0] += wKval * (*Mx);
+                            gwK[1][1] += wKval * (*My);
+                            gwK[1][2] += wKval * (*Mz);
+                            gwK[2][0] += wKval * (*Nx);
+                            gwK[2][1] += wKval * (*Ny);
+                            gwK[2][2] += wKval * (*Nz);
                             Px++;
                             Py++;
                             Pz++;
@@ -1214,34 +1210,27 @@ void DFJKGrad::build_Amn_x_terms() {
                     }
                 }
             }
-        }
-    }
-
-    // => Temporary Gradient Reduction <= //
 
-    // gradients_["Coulomb"]->zero();
-    // gradients_["Exchange"]->zero();
-    // gradients_["Exchange,LR"]->zero();
-
-    if (do_J_) {
-        for (int t = 0; t < df_ints_num_threads_; t++) {
-            gradients_["Coulomb"]->add(Jtemps[t]);
-        }
-    }
-    if (do_K_) {
-        for (int t = 0; t < df_ints_num_threads_; t++) {
-            gradients_["Exchange"]->add(Ktemps[t]);
-        }
-    }
-    if (do_wK_) {
-        for (int t = 0; t < df_ints_num_threads_; t++) {
-            gradients_["Exchange,LR"]->add(wKtemps[t]);
+            // > Per-atom reduction < //
+            const int centers[3] = {aP, aM, aN};
+            for (int c = 0; c < 3; c++) {
+                for (int xyz = 0; xyz < 3; xyz++) {
+                    if (do_J_) {
+#pragma omp atomic
+                        grad_Jp[centers[c]][xyz] += gJ[c][xyz];
+                    }
+                    if (do_K_) {
+#pragma omp atomic
+                        grad_Kp[centers[c]][xyz] += gK[c][xyz];
+                    }
+                    if (do_wK_) {
+#pragma omp atomic
+                        grad_wKp[centers[c]][xyz] += gwK[c][xyz];
+                    }
+                }
+            }
         }
     }
-
-    // gradients_["Coulomb"]->print();
-    // gradients_["Exchange"]->print();
-    // gradients_["Exchange,LR"]->print();
 }
 
 void DFJKGrad::compute_hessian() {
@@ -1342,8 +1331,14 @@ void DFJKGrad::compute_hessian() {
     auto Pmnfactory = std::make_shared<IntegralFactory>(auxiliary_, BasisSet::zero_ao_basis_set(), primary_, primary_);
     auto PQfactory = std::make_shared<IntegralFactory>(auxiliary_, BasisSet::zero_ao_basis_set(), auxiliary_,
                                                        BasisSet::zero_ao_basis_set());
-    std::shared_ptr<TwoBodyAOInt> Pmnint(Pmnfactory->eri(2));
-    std::shared_ptr<TwoBodyAOInt> PQint(PQfactory->eri(2));
+    std::vector<std::shared_ptr<TwoBodyAOInt>> Pmnint(df_ints_num_threads_);
+    std::vector<std::shared_ptr<TwoBodyAOInt>> PQint(df_ints_num_threads_);
+    Pmnint[0] = std::shared_ptr<TwoBodyAOInt>(Pmnfactory->eri(2));
+    PQint[0] = std::shared_ptr<TwoBodyAOInt>(PQfactory->eri(2));
+    for (int t = 1; t < df_ints_num_threads_; t++) {
+        Pmnint[t] = std::shared_ptr<TwoBodyAOInt>(Pmnint.front()->clone());
+        PQint[t] = std::shared_ptr<TwoBodyAOInt>(PQint.front()->clone());
+    }
     auto Amn = std::make_shared<Matrix>("(A|mn)", np, nso*nso);
     auto Aa_mi = std::make_shared<Matrix>("(A|mi)", np, nso*na);
     auto Aa_ij = std::make_shared<Matrix>("(A|ij)", np, na*na);
@@ -1372,7 +1367,12 @@ void DFJKGrad::compute_hessian() {
     double **Bb_mnp = Bb_mn->pointer();
     double **Db_PQp = Db_PQ->pointer();
 
+#pragma omp parallel for schedule(dynamic) num_threads(df_ints_num_threads_)
     for (int P = 0; P < nauxshell; ++P) {
+        int thread = 0;
+#ifdef _OPENMP
+        thread = omp_get_thread_num();
+#endif
         int nP = auxiliary_->shell(P).nfunction();
         int oP = auxiliary_->shell(P).function_index();
         for (int M = 0; M < nshell; ++M) {
@@ -1382,8 +1382,8 @@ void DFJKGrad::compute_hessian() {
                 int nN = primary_->shell(N).nfunction();
                 int oN = primary_->shell(N).function_index();
 
-                Pmnint->compute_shell(P, 0, M, N);
-                const double* buffer = Pmnint->buffer();
+                Pmnint[thread]->compute_shell(P, 0, M, N);
+                const double* buffer = Pmnint[thread]->buffer();
 
                 for (int p = oP; p < oP+nP; p++) {
                     for (int m = oM; m < oM+nM; m++) {
@@ -1415,13 +1415,6 @@ void DFJKGrad::compute_hessian() {
     }
     // c[A] = (A|mn) D[m][n]
     C_DGEMV('N', np, nso*(size_t)nso, 1.0, Amnp[0], nso*(size_t)nso, Dtp[0], 1, 0.0, cp, 1);
-    // (A|mj) = (A|mn) C[n][j]
-    C_DGEMM('N','N',np*(size_t)nso,na,nso,1.0,Amnp[0],nso,Cap[0],na,0.0,Aa_mip[0],na);
-    // (A|ij) = (A|mj) C[m][i]
-    #pragma omp parallel for
-    for (int p = 0; p < np; p++) {
-        C_DGEMM('T','N',na,na,nso,1.0,Aa_mip[p],na,Cap[0],na,0.0,&Aa_ijp[0][p * (size_t) na * na],na);
-    }
 
     // d[A] = Minv[A][B] c[B]
     C_DGEMV('n', np, np, 1.0, PQp[0], np, cp, 1, 0.0, dp, 1);
@@ -1456,12 +1449,18 @@ void DFJKGrad::compute_hessian() {
 
     int maxp = auxiliary_->max_function_per_shell();
     int maxm = primary_->max_function_per_shell();
-    auto Ta = std::make_shared<Matrix>("Ta", maxp, maxm*na);
-    double **Tap = Ta->pointer();
-    auto Tb = std::make_shared<Matrix>("Tb", maxp, maxm*nb);
-    double **Tbp = Tb->pointer();
+    std::vector<SharedMatrix> Ta, Tb;
+    for (int t = 0; t < df_ints_num_threads_; t++) {
+        Ta.push_back(std::make_shared<Matrix>("Ta", maxp, maxm*na));
+        Tb.push_back(std::make_shared<Matrix>("Tb", maxp, maxm*nb));
+    }
 
+#pragma omp parallel for schedule(dynamic) num_threads(df_ints_num_threads_)
     for (int P = 0; P < nauxshell; ++P) {
+        int thread = 0;
+#ifdef _OPENMP
+        thread = omp_get_thread_num();
+#endif
         int nP = auxiliary_->shell(P).nfunction();
         int oP = auxiliary_->shell(P).function_index();
         int Pcenter = auxiliary_->shell(P).ncenter();
@@ -1486,9 +1485,11 @@ void DFJKGrad::compute_hessian() {
                 int ny = 3 * Ncenter + 1;
                 int nz = 3 * Ncenter + 2;
 
-                Pmnint->compute_shell_deriv1(P, 0, M, N);
-                const double* buffer = Pmnint->buffer();
-                const auto& buffers = Pmnint->buffers();
+                double **Tap = Ta[thread]->pointer();
+                double **Tbp = Tb[thread]->pointer();
+                Pmnint[thread]->compute_shell_deriv1(P, 0, M, N);
+                const double* buffer = Pmnint[thread]->buffer();
+                const auto& buffers = Pmnint[thread]->buffers();
                 const double* PxBuf = buffers[0];
                 const double* PyBuf = buffers[1];
                 const double* PzBuf = buffers[2];
@@ -1529,78 +1530,60 @@ void DFJKGrad::compute_hessian() {
                 if(do_K_) {
                     // Alpha
                     C_DGEMM('n', 'n', nP*nM, na, nN, 1.0, const_cast<double*>(PxBuf), nN, Cap[oN], na, 0.0, Tap[0], na);
-#pragma omp parallel for
                     for(int p = 0; p < nP; ++p)
                         C_DGEMM('t', 'n', na, na, nM, 1.0, Cap[oM], na, Tap[0]+p*(nM*na), na, 1.0, &dAa_ijp[Px][(p+oP)*na*na], na);
                     C_DGEMM('n', 'n', nP*nM, na, nN, 1.0, const_cast<double*>(PyBuf), nN, Cap[oN], na, 0.0, Tap[0], na);
-#pragma omp parallel for
                     for(int p = 0; p < nP; ++p)
                         C_DGEMM('t', 'n', na, na, nM, 1.0, Cap[oM], na, Tap[0]+p*(nM*na), na, 1.0, &dAa_ijp[Py][(p+oP)*na*na], na);
                     C_DGEMM('n', 'n', nP*nM, na, nN, 1.0, const_cast<double*>(PzBuf), nN, Cap[oN], na, 0.0, Tap[0], na);
-#pragma omp parallel for
                     for(int p = 0; p < nP; ++p)
                         C_DGEMM('t', 'n', na, na, nM, 1.0, Cap[oM], na, Tap[0]+p*(nM*na), na, 1.0, &dAa_ijp[Pz][(p+oP)*na*na], na);
                     C_DGEMM('n', 'n', nP*nM, na, nN, 1.0, const_cast<double*>(mxBuf), nN, Cap[oN], na, 0.0, Tap[0], na);
-#pragma omp parallel for
                     for(int p = 0; p < nP; ++p)
                         C_DGEMM('t', 'n', na, na, nM, 1.0, Cap[oM], na, Tap[0]+p*(nM*na), na, 1.0, &dAa_ijp[mx][(p+oP)*na*na], na);
                     C_DGEMM('n', 'n', nP*nM, na, nN, 1.0, const_cast<double*>(myBuf), nN, Cap[oN], na, 0.0, Tap[0], na);
-#pragma omp parallel for
                     for(int p = 0; p < nP; ++p)
                         C_DGEMM('t', 'n', na, na, nM, 1.0, Cap[oM], na, Tap[0]+p*(nM*na), na, 1.0, &dAa_ijp[my][(p+oP)*na*na], na);
                     C_DGEMM('n', 'n', nP*nM, na, nN, 1.0, const_cast<double*>(mzBuf), nN, Cap[oN], na, 0.0, Tap[0], na);
-#pragma omp parallel for
                     for(int p = 0; p < nP; ++p)
                         C_DGEMM('t', 'n', na, na, nM, 1.0, Cap[oM], na, Tap[0]+p*(nM*na), na, 1.0, &dAa_ijp[mz][(p+oP)*na*na], na);
                     C_DGEMM('n', 'n', nP*nM, na, nN, 1.0, const_cast<double*>(nxBuf), nN, Cap[oN], na, 0.0, Tap[0], na);
-#pragma omp parallel for
                     for(int p = 0; p < nP; ++p)
                         C_DGEMM('t', 'n', na, na, nM, 1.0, Cap[oM], na, Tap[0]+p*(nM*na), na, 1.0, &dAa_ijp[nx][(p+oP)*na*na], na);
                     C_DGEMM('n', 'n', nP*nM, na, nN, 1.0, const_cast<double*>(nyBuf), nN, Cap[oN], na, 0.0, Tap[0], na);
-#pragma omp parallel for
                     for(int p = 0; p < nP; ++p)
                         C_DGEMM('t', 'n', na, na, nM, 1.0, Cap[oM], na, Tap[0]+p*(nM*na), na, 1.0, &dAa_ijp[ny][(p+oP)*na*na], na);
                     C_DGEMM('n', 'n', nP*nM, na, nN, 1.0, const_cast<double*>(nzBuf), nN, Cap[oN], na, 0.0, Tap[0], na);
-#pragma omp parallel for
                     for(int p = 0; p < nP; ++p)
                         C_DGEMM('t', 'n', na, na, nM, 1.0, Cap[oM], na, Tap[0]+p*(nM*na), na, 1.0, &dAa_ijp[nz][(p+oP)*na*na], na);
 
                     // Beta
                     if (!same_ab){
                         C_DGEMM('n', 'n', nP*nM, nb, nN, 1.0, const_cast<double*>(PxBuf), nN, Cbp[oN], nb, 0.0, Tbp[0], nb);
-#pragma omp parallel for
                         for(int p = 0; p < nP; ++p)
                             C_DGEMM('t', 'n', nb, nb, nM, 1.0, Cbp[oM], nb, Tbp[0]+p*(nM*nb), nb, 1.0, &dAb_ijp[Px][(p+oP)*nb*nb], nb);
                         C_DGEMM('n', 'n', nP*nM, nb, nN, 1.0, const_cast<double*>(PyBuf), nN, Cbp[oN], nb, 0.0, Tbp[0], nb);
-#pragma omp parallel for
                         for(int p = 0; p < nP; ++p)
                             C_DGEMM('t', 'n', nb, nb, nM, 1.0, Cbp[oM], nb, Tbp[0]+p*(nM*nb), nb, 1.0, &dAb_ijp[Py][(p+oP)*nb*nb], nb);
                         C_DGEMM('n', 'n', nP*nM, nb, nN, 1.0, const_cast<double*>(PzBuf), nN, Cbp[oN], nb, 0.0, Tbp[0], nb);
-#pragma omp parallel for
                         for(int p = 0; p < nP; ++p)
                             C_DGEMM('t', 'n', nb, nb, nM, 1.0, Cbp[oM], nb, Tbp[0]+p*(nM*nb), nb, 1.0, &dAb_ijp[Pz][(p+oP)*nb*nb], nb);
                         C_DGEMM('n', 'n', nP*nM, nb, nN, 1.0, const_cast<double*>(mxBuf), nN, Cbp[oN], nb, 0.0, Tbp[0], nb);
-#pragma omp parallel for
                         for(int p = 0; p < nP; ++p)
                             C_DGEMM('t', 'n', nb, nb, nM, 1.0, Cbp[oM], nb, Tbp[0]+p*(nM*nb), nb, 1.0, &dAb_ijp[mx][(p+oP)*nb*nb], nb);
                         C_DGEMM('n', 'n', nP*nM, nb, nN, 1.0, const_cast<double*>(myBuf), nN, Cbp[oN], nb, 0.0, Tbp[0], nb);
-#pragma omp parallel for
                         for(int p = 0; p < nP; ++p)
                             C_DGEMM('t', 'n', nb, nb, nM, 1.0, Cbp[oM], nb, Tbp[0]+p*(nM*nb), nb, 1.0, &dAb_ijp[my][(p+oP)*nb*nb], nb);
                         C_DGEMM('n', 'n', nP*nM, nb, nN, 1.0, const_cast<double*>(mzBuf), nN, Cbp[oN], nb, 0.0, Tbp[0], nb);
-#pragma omp parallel for
                         for(int p = 0; p < nP; ++p)
                             C_DGEMM('t', 'n', nb, nb, nM, 1.0, Cbp[oM], nb, Tbp[0]+p*(nM*nb), nb, 1.0, &dAb_ijp[mz][(p+oP)*nb*nb], nb);
                         C_DGEMM('n', 'n', nP*nM, nb, nN, 1.0, const_cast<double*>(nxBuf), nN, Cbp[oN], nb, 0.0, Tbp[0], nb);
-#pragma omp parallel for
                         for(int p = 0; p < nP; ++p)
                             C_DGEMM('t', 'n', nb, nb, nM, 1.0, Cbp[oM], nb, Tbp[0]+p*(nM*nb), nb, 1.0, &dAb_ijp[nx][(p+oP)*nb*nb], nb);
                         C_DGEMM('n', 'n', nP*nM, nb, nN, 1.0, const_cast<double*>(nyBuf), nN, Cbp[oN], nb, 0.0, Tbp[0], nb);
-#pragma omp parallel for
                         for(int p = 0; p < nP; ++p)
                             C_DGEMM('t', 'n', nb, nb, nM, 1.0, Cbp[oM], nb, Tbp[0]+p*(nM*nb), nb, 1.0, &dAb_ijp[ny][(p+oP)*nb*nb], nb);
                         C_DGEMM('n', 'n', nP*nM, nb, nN, 1.0, const_cast<double*>(nzBuf), nN, Cbp[oN], nb, 0.0, Tbp[0], nb);
-#pragma omp parallel for
                         for(int p = 0; p < nP; ++p)
                             C_DGEMM('t', 'n', nb, nb, nM, 1.0, Cbp[oM], nb, Tbp[0]+p*(nM*nb), nb, 1.0, &dAb_ijp[nz][(p+oP)*nb*nb], nb);
                     }
@@ -1612,7 +1595,12 @@ void DFJKGrad::compute_hessian() {
     // dd[x][A] = dc[x][B] Minv[B][A]
     C_DGEMM('N', 'N', 3 * natoms, np, np, 1.0, dcp[0], np, PQp[0], np, 0.0, ddp[0], np);
 
+#pragma omp parallel for schedule(dynamic) num_threads(df_ints_num_threads_)
     for (int P = 0; P < nauxshell; ++P) {
+        int thread = 0;
+#ifdef _OPENMP
+        thread = omp_get_thread_num();
+#endif
         int nP = auxiliary_->shell(P).nfunction();
         int oP = auxiliary_->shell(P).function_index();
         int Pcenter = auxiliary_->shell(P).ncenter();
@@ -1631,8 +1619,8 @@ void DFJKGrad::compute_hessian() {
 
             //size_t stride = static_cast<size_t>(Pncart) * Qncart;
 
-            PQint->compute_shell_deriv1(P, 0, Q, 0);
-            const auto& buffers = PQint->buffers();
+            PQint[thread]->compute_shell_deriv1(P, 0, Q, 0);
+            const auto& buffers = PQint[thread]->buffers();
             const double* Pxbuf = buffers[0];
             const double* Pybuf = buffers[1];
             const double* Pzbuf = buffers[2];
@@ -1677,7 +1665,21 @@ void DFJKGrad::compute_hessian() {
         }
     }
 
+    // The second derivative shell loops scatter into every atom pair of the Hessian, so each thread keeps its own
+    std::vector<SharedMatrix> JHess_t, KHess_t;
+    for (int t = 0; t < df_ints_num_threads_; t++) {
+        JHess_t.push_back(std::make_shared<Matrix>("Coulomb Hessian", 3 * natom, 3 * natom));
+        if (do_K_) KHess_t.push_back(std::make_shared<Matrix>("Exchange Hessian", 3 * natom, 3 * natom));
+    }
+
+#pragma omp parallel for schedule(dynamic) num_threads(df_ints_num_threads_)
     for (int P = 0; P < nauxshell; ++P) {
+        int thread = 0;
+#ifdef _OPENMP
+        thread = omp_get_thread_num();
+#endif
+        double **Jtp = JHess_t[thread]->pointer();
+        double **Ktp = do_K_ ? KHess_t[thread]->pointer() : nullptr;
         int nP = auxiliary_->shell(P).nfunction();
         int oP = auxiliary_->shell(P).function_index();
         int Pcenter = auxiliary_->shell(P).ncenter();
@@ -1702,8 +1704,8 @@ void DFJKGrad::compute_hessian() {
                 int ny = 3 * Ncenter + 1;
                 int nz = 3 * Ncenter + 2;
 
-                Pmnint->compute_shell_deriv2(P, 0, M, N);
-                const auto& buffers = Pmnint->buffers();
+                Pmnint[thread]->compute_shell_deriv2(P, 0, M, N);
+                const auto& buffers = Pmnint[thread]->buffers();
                 const double* PxPxBuf = buffers[0];
                 const double* PxPyBuf = buffers[1];
                 const double* PxPzBuf = buffers[2];
@@ -1817,51 +1819,51 @@ void DFJKGrad::compute_hessian() {
                         }
                     }
                 }
-                JHessp[Px][Px] += PxPx;
-                JHessp[Px][Py] += PxPy;
-                JHessp[Px][Pz] += PxPz;
-                JHessp[Px][mx] += Pmscale * Pxmx;
-                JHessp[Px][my] += Pxmy;
-                JHessp[Px][mz] += Pxmz;
-                JHessp[Px][nx] += Pnscale * Pxnx;
-                JHessp[Px][ny] += Pxny;
-                JHessp[Px][nz] += Pxnz;
-                JHessp[Py][Py] += PyPy;
-                JHessp[Py][Pz] += PyPz;
-                JHessp[Py][mx] += Pymx;
-                JHessp[Py][my] += Pmscale * Pymy;
-                JHessp[Py][mz] += Pymz;
-                JHessp[Py][nx] += Pynx;
-                JHessp[Py][ny] += Pnscale * Pyny;
-                JHessp[Py][nz] += Pynz;
-                JHessp[Pz][Pz] += PzPz;
-                JHessp[Pz][mx] += Pzmx;
-                JHessp[Pz][my] += Pzmy;
-                JHessp[Pz][mz] += Pmscale * Pzmz;
-                JHessp[Pz][nx] += Pznx;
-                JHessp[Pz][ny] += Pzny;
-                JHessp[Pz][nz] += Pnscale * Pznz;
-                JHessp[mx][mx] += mxmx;
-                JHessp[mx][my] += mxmy;
-                JHessp[mx][mz] += mxmz;
-                JHessp[mx][nx] += mnscale * mxnx;
-                JHessp[mx][ny] += mxny;
-                JHessp[mx][nz] += mxnz;
-                JHessp[my][my] += mymy;
-                JHessp[my][mz] += mymz;
-                JHessp[my][nx] += mynx;
-                JHessp[my][ny] += mnscale * myny;
-                JHessp[my][nz] += mynz;
-                JHessp[mz][mz] += mzmz;
-                JHessp[mz][nx] += mznx;
-                JHessp[mz][ny] += mzny;
-                JHessp[mz][nz] += mnscale * mznz;
-                JHessp[nx][nx] += nxnx;
-                JHessp[nx][ny] += nxny;
-                JHessp[nx][nz] += nxnz;
-                JHessp[ny][ny] += nyny;
-                JHessp[ny][nz] += nynz;
-                JHessp[nz][nz] += nznz;
+                Jtp[Px][Px] += PxPx;
+                Jtp[Px][Py] += PxPy;
+                Jtp[Px][Pz] += PxPz;
+                Jtp[Px][mx] += Pmscale * Pxmx;
+                Jtp[Px][my] += Pxmy;
+                Jtp[Px][mz] += Pxmz;
+                Jtp[Px][nx] += Pnscale * Pxnx;
+                Jtp[Px][ny] += Pxny;
+                Jtp[Px][nz] += Pxnz;
+                Jtp[Py][Py] += PyPy;
+                Jtp[Py][Pz] += PyPz;
+                Jtp[Py][mx] += Pymx;
+                Jtp[Py][my] += Pmscale * Pymy;
+                Jtp[Py][mz] += Pymz;
+                Jtp[Py][nx] += Pynx;
+                Jtp[Py][ny] += Pnscale * Pyny;
+                Jtp[Py][nz] += Pynz;
+                Jtp[Pz][Pz] += PzPz;
+                Jtp[Pz][mx] += Pzmx;
+                Jtp[Pz][my] += Pzmy;
+                Jtp[Pz][mz] += Pmscale * Pzmz;
+                Jtp[Pz][nx] += Pznx;
+                Jtp[Pz][ny] += Pzny;
+                Jtp[Pz][nz] += Pnscale * Pznz;
+                Jtp[mx][mx] += mxmx;
+                Jtp[mx][my] += mxmy;
+                Jtp[mx][mz] += mxmz;
+                Jtp[mx][nx] += mnscale * mxnx;
+                Jtp[mx][ny] += mxny;
+                Jtp[mx][nz] += mxnz;
+                Jtp[my][my] += mymy;
+                Jtp[my][mz] += mymz;
+                Jtp[my][nx] += mynx;
+                Jtp[my][ny] += mnscale * myny;
+                Jtp[my][nz] += mynz;
+                Jtp[mz][mz] += mzmz;
+                Jtp[mz][nx] += mznx;
+                Jtp[mz][ny] += mzny;
+                Jtp[mz][nz] += mnscale * mznz;
+                Jtp[nx][nx] += nxnx;
+                Jtp[nx][ny] += nxny;
+                Jtp[nx][nz] += nxnz;
+                Jtp[ny][ny] += nyny;
+                Jtp[ny][nz] += nynz;
+                Jtp[nz][nz] += nznz;
 
                 if (do_K_) {
                     // K terms
@@ -1929,58 +1931,65 @@ void DFJKGrad::compute_hessian() {
                                 }
                             }
                         }
-                        KHessp[Px][Px] += PxPx;
-                        KHessp[Px][Py] += PxPy;
-                        KHessp[Px][Pz] += PxPz;
-                        KHessp[Px][mx] += Pmscale*Pxmx;
-                        KHessp[Px][my] += Pxmy;
-                        KHessp[Px][mz] += Pxmz;
-                        KHessp[Px][nx] += Pnscale*Pxnx;
-                        KHessp[Px][ny] += Pxny;
-                        KHessp[Px][nz] += Pxnz;
-                        KHessp[Py][Py] += PyPy;
-                        KHessp[Py][Pz] += PyPz;
-                        KHessp[Py][mx] += Pymx;
-                        KHessp[Py][my] += Pmscale*Pymy;
-                        KHessp[Py][mz] += Pymz;
-                        KHessp[Py][nx] += Pynx;
-                        KHessp[Py][ny] += Pnscale*Pyny;
-                        KHessp[Py][nz] += Pynz;
-                        KHessp[Pz][Pz] += PzPz;
-                        KHessp[Pz][mx] += Pzmx;
-                        KHessp[Pz][my] += Pzmy;
-                        KHessp[Pz][mz] += Pmscale*Pzmz;
-                        KHessp[Pz][nx] += Pznx;
-                        KHessp[Pz][ny] += Pzny;
-                        KHessp[Pz][nz] += Pnscale*Pznz;
-                        KHessp[mx][mx] += mxmx;
-                        KHessp[mx][my] += mxmy;
-                        KHessp[mx][mz] += mxmz;
-                        KHessp[mx][nx] += mnscale*mxnx;
-                        KHessp[mx][ny] += mxny;
-                        KHessp[mx][nz] += mxnz;
-                        KHessp[my][my] += mymy;
-                        KHessp[my][mz] += mymz;
-                        KHessp[my][nx] += mynx;
-                        KHessp[my][ny] += mnscale*myny;
-                        KHessp[my][nz] += mynz;
-                        KHessp[mz][mz] += mzmz;
-                        KHessp[mz][nx] += mznx;
-                        KHessp[mz][ny] += mzny;
-                        KHessp[mz][nz] += mnscale*mznz;
-                        KHessp[nx][nx] += nxnx;
-                        KHessp[nx][ny] += nxny;
-                        KHessp[nx][nz] += nxnz;
-                        KHessp[ny][ny] += nyny;
-                        KHessp[ny][nz] += nynz;
-                        KHessp[nz][nz] += nznz;
+                        Ktp[Px][Px] += PxPx;
+                        Ktp[Px][Py] += PxPy;
+                        Ktp[Px][Pz] += PxPz;
+                        Ktp[Px][mx] += Pmscale*Pxmx;
+                        Ktp[Px][my] += Pxmy;
+                        Ktp[Px][mz] += Pxmz;
+                        Ktp[Px][nx] += Pnscale*Pxnx;
+                        Ktp[Px][ny] += Pxny;
+                        Ktp[Px][nz] += Pxnz;
+                        Ktp[Py][Py] += PyPy;
+                        Ktp[Py][Pz] += PyPz;
+                        Ktp[Py][mx] += Pymx;
+                        Ktp[Py][my] += Pmscale*Pymy;
+                        Ktp[Py][mz] += Pymz;
+                        Ktp[Py][nx] += Pynx;
+                        Ktp[Py][ny] += Pnscale*Pyny;
+                        Ktp[Py][nz] += Pynz;
+                        Ktp[Pz][Pz] += PzPz;
+                        Ktp[Pz][mx] += Pzmx;
+                        Ktp[Pz][my] += Pzmy;
+                        Ktp[Pz][mz] += Pmscale*Pzmz;
+                        Ktp[Pz][nx] += Pznx;
+                        Ktp[Pz][ny] += Pzny;
+                        Ktp[Pz][nz] += Pnscale*Pznz;
+                        Ktp[mx][mx] += mxmx;
+                        Ktp[mx][my] += mxmy;
+                        Ktp[mx][mz] += mxmz;
+                        Ktp[mx][nx] += mnscale*mxnx;
+                        Ktp[mx][ny] += mxny;
+                        Ktp[mx][nz] += mxnz;
+                        Ktp[my][my] += mymy;
+                        Ktp[my][mz] += mymz;
+                        Ktp[my][nx] += mynx;
+                        Ktp[my][ny] += mnscale*myny;
+                        Ktp[my][nz] += mynz;
+                        Ktp[mz][mz] += mzmz;
+                        Ktp[mz][nx] += mznx;
+                        Ktp[mz][ny] += mzny;
+                        Ktp[mz][nz] += mnscale*mznz;
+                        Ktp[nx][nx] += nxnx;
+                        Ktp[nx][ny] += nxny;
+                        Ktp[nx][nz] += nxnz;
+                        Ktp[ny][ny] += nyny;
+                        Ktp[ny][nz] += nynz;
+                        Ktp[nz][nz] += nznz;
                     }
                 }
             }
         }
     }
 
+#pragma omp parallel for schedule(dynamic) num_threads(df_ints_num_threads_)
     for (int P = 0; P < nauxshell; ++P) {
+        int thread = 0;
+#ifdef _OPENMP
+        thread = omp_get_thread_num();
+#endif
+        double **Jtp = JHess_t[thread]->pointer();
+        double **Ktp = do_K_ ? KHess_t[thread]->pointer() : nullptr;
         int nP = auxiliary_->shell(P).nfunction();
         int oP = auxiliary_->shell(P).function_index();
         int Pcenter = auxiliary_->shell(P).ncenter();
@@ -1997,8 +2006,8 @@ void DFJKGrad::compute_hessian() {
             int Qy = 3 * Qcenter + 1;
             int Qz = 3 * Qcenter + 2;
 
-            PQint->compute_shell_deriv2(P, 0, Q, 0);
-            const auto& buffers = PQint->buffers();
+            PQint[thread]->compute_shell_deriv2(P, 0, Q, 0);
+            const auto& buffers = PQint[thread]->buffers();
             const double* PxPxBuf = buffers[0];
             const double* PxPyBuf = buffers[1];
             const double* PxPzBuf = buffers[2];
@@ -2055,27 +2064,27 @@ void DFJKGrad::compute_hessian() {
                     ++delta;
                 }
             }
-            JHessp[Px][Px] += PxPx;
-            JHessp[Px][Py] += PxPy;
-            JHessp[Px][Pz] += PxPz;
-            JHessp[Px][Qx] += PQscale * PxQx;
-            JHessp[Px][Qy] += PxQy;
-            JHessp[Px][Qz] += PxQz;
-            JHessp[Py][Py] += PyPy;
-            JHessp[Py][Pz] += PyPz;
-            JHessp[Py][Qx] += PyQx;
-            JHessp[Py][Qy] += PQscale * PyQy;
-            JHessp[Py][Qz] += PyQz;
-            JHessp[Pz][Pz] += PzPz;
-            JHessp[Pz][Qx] += PzQx;
-            JHessp[Pz][Qy] += PzQy;
-            JHessp[Pz][Qz] += PQscale * PzQz;
-            JHessp[Qx][Qx] += QxQx;
-            JHessp[Qx][Qy] += QxQy;
-            JHessp[Qx][Qz] += QxQz;
-            JHessp[Qy][Qy] += QyQy;
-            JHessp[Qy][Qz] += QyQz;
-            JHessp[Qz][Qz] += QzQz;
+            Jtp[Px][Px] += PxPx;
+            Jtp[Px][Py] += PxPy;
+            Jtp[Px][Pz] += PxPz;
+            Jtp[Px][Qx] += PQscale * PxQx;
+            Jtp[Px][Qy] += PxQy;
+            Jtp[Px][Qz] += PxQz;
+            Jtp[Py][Py] += PyPy;
+            Jtp[Py][Pz] += PyPz;
+            Jtp[Py][Qx] += PyQx;
+            Jtp[Py][Qy] += PQscale * PyQy;
+            Jtp[Py][Qz] += PyQz;
+            Jtp[Pz][Pz] += PzPz;
+            Jtp[Pz][Qx] += PzQx;
+            Jtp[Pz][Qy] += PzQy;
+            Jtp[Pz][Qz] += PQscale * PzQz;
+            Jtp[Qx][Qx] += QxQx;
+            Jtp[Qx][Qy] += QxQy;
+            Jtp[Qx][Qz] += QxQz;
+            Jtp[Qy][Qy] += QyQy;
+            Jtp[Qy][Qz] += QyQz;
+            Jtp[Qz][Qz] += QzQz;
 
             if (do_K_) {
                 // K terms
@@ -2114,32 +2123,37 @@ void DFJKGrad::compute_hessian() {
                         }
 
                     }
-                    KHessp[Px][Px] += PxPx;
-                    KHessp[Px][Py] += PxPy;
-                    KHessp[Px][Pz] += PxPz;
-                    KHessp[Px][Qx] += PQscale*PxQx;
-                    KHessp[Px][Qy] += PxQy;
-                    KHessp[Px][Qz] += PxQz;
-                    KHessp[Py][Py] += PyPy;
-                    KHessp[Py][Pz] += PyPz;
-                    KHessp[Py][Qx] += PyQx;
-                    KHessp[Py][Qy] += PQscale*PyQy;
-                    KHessp[Py][Qz] += PyQz;
-                    KHessp[Pz][Pz] += PzPz;
-                    KHessp[Pz][Qx] += PzQx;
-                    KHessp[Pz][Qy] += PzQy;
-                    KHessp[Pz][Qz] += PQscale*PzQz;
-                    KHessp[Qx][Qx] += QxQx;
-                    KHessp[Qx][Qy] += QxQy;
-                    KHessp[Qx][Qz] += QxQz;
-                    KHessp[Qy][Qy] += QyQy;
-                    KHessp[Qy][Qz] += QyQz;
-                    KHessp[Qz][Qz] += QzQz;
+                    Ktp[Px][Px] += PxPx;
+                    Ktp[Px][Py] += PxPy;
+                    Ktp[Px][Pz] += PxPz;
+                    Ktp[Px][Qx] += PQscale*PxQx;
+                    Ktp[Px][Qy] += PxQy;
+                    Ktp[Px][Qz] += PxQz;
+                    Ktp[Py][Py] += PyPy;
+                    Ktp[Py][Pz] += PyPz;
+                    Ktp[Py][Qx] += PyQx;
+                    Ktp[Py][Qy] += PQscale*PyQy;
+                    Ktp[Py][Qz] += PyQz;
+                    Ktp[Pz][Pz] += PzPz;
+                    Ktp[Pz][Qx] += PzQx;
+                    Ktp[Pz][Qy] += PzQy;
+                    Ktp[Pz][Qz] += PQscale*PzQz;
+                    Ktp[Qx][Qx] += QxQx;
+                    Ktp[Qx][Qy] += QxQy;
+                    Ktp[Qx][Qz] += QxQz;
+                    Ktp[Qy][Qy] += QyQy;
+                    Ktp[Qy][Qz] += QyQz;
+                    Ktp[Qz][Qz] += QzQz;
                 }
             }
         }
     }
 
+    for (int t = 0; t < df_ints_num_threads_; t++) {
+        hessians_["Coulomb"]->add(JHess_t[t]);
+        if (do_K_) hessians_["Exchange"]->add(KHess_t[t]);
+    }
+
     // Add permutational symmetry components missing from the above
     for (int i = 0; i < 3 * natoms; ++i) {
         for (int j = 0; j < i; ++j) {
@@ -2150,9 +2164,12 @@ void DFJKGrad::compute_hessian() {
         }
     }
 
-    // Stitch all the intermediates together to form the actual Hessian contributions
+    // Stitch all the intermediates together to form the actual Hessian contributions.  Each perturbation y is
+    // contracted with the metric once, and every x is picked up by a single matrix-vector product over the
+    // (3 natom) x (A,i,j) intermediates, rather than repeating the metric contraction for every (x,y) pair.
 
-    auto tmp1 = std::make_shared<Matrix>("Tmp1", np, np*np);
+    int nxyz = 3 * natoms;
+    auto tmp1 = std::make_shared<Matrix>("Tmp1", nxyz, np);
     double **ptmp1 = tmp1->pointer();
 
     auto tmp_a = std::make_shared<Matrix>("Tmp [P][i,j]", np, na*na);
@@ -2160,28 +2177,29 @@ void DFJKGrad::compute_hessian() {
     auto tmp_b = std::make_shared<Matrix>("Tmp [P][i,j]", np, nb*nb);
     double **ptmp_b = tmp_b->pointer();
 
-    for (int x = 0; x < 3 * natoms; ++x) {
-        for (int y = 0; y < 3 * natoms; ++y) {
-            // J terms
-            JHessp[x][y] += 2.0*C_DDOT(np, ddp[x], 1, dcp[y], 1);
-            JHessp[x][y] -= 4.0*C_DDOT(np, ddp[x], 1, dep[y], 1);
-            C_DGEMV('n', np, np, 1.0, PQp[0], np, dep[y], 1, 0.0, ptmp1[0], 1);
-            JHessp[x][y] += 2.0*C_DDOT(np, dep[x], 1, ptmp1[0], 1);
+    // J terms
+    // JHess[x][y] += 2 dd[x] dc[y] - 4 dd[x] de[y] + 2 de[x] Minv de[y]
+    C_DGEMM('N', 'T', nxyz, nxyz, np, 2.0, ddp[0], np, dcp[0], np, 1.0, JHessp[0], nxyz);
+    C_DGEMM('N', 'T', nxyz, nxyz, np, -4.0, ddp[0], np, dep[0], np, 1.0, JHessp[0], nxyz);
+    C_DGEMM('N', 'T', nxyz, np, np, 1.0, dep[0], np, PQp[0], np, 0.0, ptmp1[0], np);
+    C_DGEMM('N', 'T', nxyz, nxyz, np, 2.0, dep[0], np, ptmp1[0], np, 1.0, JHessp[0], nxyz);
 
-            if (do_K_) {
-                // K terms
-                C_DGEMM('n', 'n', np, na*na, np,  1.0, PQp[0], np, dAa_ijp[y], na*na, 0.0, ptmp_a[0], na*na);
-                KHessp[x][y] += 2.0*C_DDOT(static_cast<size_t> (np)*na*na, dAa_ijp[x], 1, ptmp_a[0], 1);
-                C_DGEMM('n', 'n', np, na*na, np,  1.0, PQp[0], np, dea_ijp[y], na*na, 0.0, ptmp_a[0], na*na);
-                KHessp[x][y] -= 4.0*C_DDOT(static_cast<size_t> (np)*na*na, dAa_ijp[x], 1, ptmp_a[0], 1);
-                KHessp[x][y] += 2.0*C_DDOT(static_cast<size_t> (np)*na*na, dea_ijp[x], 1, ptmp_a[0], 1);
-                if (!same_ab){
-                    C_DGEMM('n', 'n', np, nb*nb, np,  1.0, PQp[0], np, dAb_ijp[y], nb*nb, 0.0, ptmp_b[0], nb*nb);
-                    KHessp[x][y] += 2.0*C_DDOT(static_cast<size_t> (np)*nb*nb, dAb_ijp[x], 1, ptmp_b[0], 1);
-                    C_DGEMM('n', 'n', np, nb*nb, np,  1.0, PQp[0], np, deb_ijp[y], nb*nb, 0.0, ptmp_b[0], nb*nb);
-                    KHessp[x][y] -= 4.0*C_DDOT(static_cast<size_t> (np)*nb*nb, dAb_ijp[x], 1, ptmp_b[0], 1);
-                    KHessp[x][y] += 2.0*C_DDOT(static_cast<size_t> (np)*nb*nb, deb_ijp[x], 1, ptmp_b[0], 1);
-                }
+    if (do_K_) {
+        // K terms, one column y at a time
+        size_t nAij_a = static_cast<size_t>(np) * na * na;
+        size_t nAij_b = static_cast<size_t>(np) * nb * nb;
+        for (int y = 0; y < nxyz; ++y) {
+            C_DGEMM('n', 'n', np, na*na, np,  1.0, PQp[0], np, dAa_ijp[y], na*na, 0.0, ptmp_a[0], na*na);
+            C_DGEMV('n', nxyz, nAij_a, 2.0, dAa_ijp[0], nAij_a, ptmp_a[0], 1, 1.0, &KHessp[0][y], nxyz);
+            C_DGEMM('n', 'n', np, na*na, np,  1.0, PQp[0], np, dea_ijp[y], na*na, 0.0, ptmp_a[0], na*na);
+            C_DGEMV('n', nxyz, nAij_a, -4.0, dAa_ijp[0], nAij_a, ptmp_a[0], 1, 1.0, &KHessp[0][y], nxyz);
+            C_DGEMV('n', nxyz, nAij_a, 2.0, dea_ijp[0], nAij_a, ptmp_a[0], 1, 1.0, &KHessp[0][y], nxyz);
+            if (!same_ab){
+                C_DGEMM('n', 'n', np, nb*nb, np,  1.0, PQp[0], np, dAb_ijp[y], nb*nb, 0.0, ptmp_b[0], nb*nb);
+                C_DGEMV('n', nxyz, nAij_b, 2.0, dAb_ijp[0], nAij_b, ptmp_b[0], 1, 1.0, &KHessp[0][y], nxyz);
+                C_DGEMM('n', 'n', np, nb*nb, np,  1.0, PQp[0], np, deb_ijp[y], nb*nb, 0.0, ptmp_b[0], nb*nb);
+                C_DGEMV('n', nxyz, nAij_b, -4.0, dAb_ijp[0], nAij_b, ptmp_b[0], 1, 1.0, &KHessp[0][y], nxyz);
+                C_DGEMV('n', nxyz, nAij_b, 2.0, deb_ijp[0], nAij_b, ptmp_b[0], 1, 1.0, &KHessp[0][y], nxyz);
             }
         }
     }
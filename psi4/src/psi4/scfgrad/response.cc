@@ -81,6 +81,103 @@ using namespace psi;
 namespace psi {
 namespace scfgrad {
 
+#ifdef USING_ecpint
+namespace {
+
+/// First derivative ECP integrals of one shell pair, kept only for the centers that can carry a nonzero derivative
+/// (the two shell centers and every ECP center).  values is ordered [center][xyz][p][q], following centers.
+struct ECPDeriv1Block {
+    int P;
+    int Q;
+    std::vector<int> centers;
+    std::vector<double> values;
+};
+
+/// The Hessian response contracts the ECP derivatives one perturbed atom at a time; computing each significant
+/// shell pair once up front, in parallel, avoids recomputing every pair natom times.
+std::vector<ECPDeriv1Block> compute_ecp_deriv1_blocks(const std::shared_ptr<IntegralFactory>& integral,
+                                                      const std::shared_ptr<BasisSet>& basisset) {
+    int nthreads = Process::environment.get_n_threads();
+    std::vector<std::shared_ptr<ECPInt>> ecpints;
+    for (int thread = 0; thread < nthreads; thread++) {
+        ecpints.push_back(std::shared_ptr<ECPInt>(dynamic_cast<ECPInt*>(integral->ao_ecp(1).release())));
+    }
+
+    std::set<int> ecp_centers;
+    for (int ecp_shell = 0; ecp_shell < basisset->n_ecp_shell(); ++ecp_shell) {
+        ecp_centers.insert(basisset->ecp_shell(ecp_shell).ncenter());
+    }
+
+    const auto& shell_pairs = ecpints[0]->shellpairs();
+    std::vector<ECPDeriv1Block> blocks(shell_pairs.size());
+
+#pragma omp parallel for schedule(dynamic) num_threads(nthreads)
+    for (size_t pair = 0; pair < shell_pairs.size(); ++pair) {
+#ifdef _OPENMP
+        const int rank = omp_get_thread_num();
+#else
+        const int rank = 0;
+#endif
+        auto& block = blocks[pair];
+        block.P = shell_pairs[pair].first;
+        block.Q = shell_pairs[pair].second;
+        const auto& shellP = basisset->shell(block.P);
+        const auto& shellQ = basisset->shell(block.Q);
+
+        std::set<int> all_centers(ecp_centers.begin(), ecp_centers.end());
+        all_centers.insert(shellP.ncenter());
+        all_centers.insert(shellQ.ncenter());
+        block.centers.assign(all_centers.begin(), all_centers.end());
+
+        ecpints[rank]->compute_shell_deriv1(block.P, block.Q);
+        const auto& buffers = ecpints[rank]->buffers();
+        size_t size = static_cast<size_t>(shellP.nfunction()) * shellQ.nfunction();
+        block.values.resize(3 * block.centers.size() * size);
+        for (size_t c = 0; c < block.centers.size(); ++c) {
+            for (int xyz = 0; xyz < 3; ++xyz) {
+                const double* buffer = buffers[3 * block.centers[c] + xyz];
+                std::copy(buffer, buffer + size, block.values.data() + (3 * c + xyz) * size);
+            }
+        }
+    }
+
+    return blocks;
+}
+
+}  // namespace
+#endif
+
+std::shared_ptr<JK> SCFDeriv::build_response_JK(size_t& doubles) {
+    std::string jk_type = options_.get_str("HESSIAN_RESPONSE_TYPE");
+    std::shared_ptr<BasisSet> auxiliary = get_basisset("DF_BASIS_SCF");
+
+    std::shared_ptr<JK> jk;
+    if (jk_type == "SCF_TYPE") {
+        jk = JK::build_JK(basisset_, auxiliary, options_, false, doubles / 2L);
+    } else if (jk_type == "DF") {
+        // Same MemDF/DiskDF choice JK::build_JK makes for SCF_TYPE DF
+        jk = JK::build_JK(basisset_, auxiliary, options_, "MEM_DF");
+        if (jk->memory_estimate() >= doubles / 2L) jk = JK::build_JK(basisset_, auxiliary, options_, "DISK_DF");
+    } else {
+        jk = JK::build_JK(basisset_, auxiliary, options_, jk_type);
+    }
+
+    // The JK gets its own footprint, up to half of the budget, and the perturbation batches get the rest, so
+    // that as many perturbed densities as possible share one JK::compute().  The JK's footprint is padded
+    // by one perturbation's worth of density-sized work space.
+    size_t jk_doubles = std::min(jk->memory_estimate() + 5L * basisset_->nbf() * basisset_->nbf(), doubles / 2L);
+    jk->set_memory(jk_doubles);
+    jk->initialize();
+    doubles -= jk_doubles;
+
+    return jk;
+}
+
+size_t SCFDeriv::response_block_size(size_t doubles, size_t per_A) const {
+    size_t max_A = doubles / per_A;
+    return std::max(std::min(max_A, 3 * static_cast<size_t>(molecule_->natom())), static_cast<size_t>(1));
+}
+
 std::shared_ptr<Matrix> RSCFDeriv::hessian_response() {
     // => Control Parameters <= //
 
@@ -501,7 +598,7 @@ std::shared_ptr<Matrix> RSCFDeriv::hessian_response() {
 #ifdef USING_ecpint
     {
         // Effective core potential derivatives
-        std::shared_ptr<ECPInt> ecpint(dynamic_cast<ECPInt*>(integral_->ao_ecp(1).release()));
+        const auto ecp_blocks = compute_ecp_deriv1_blocks(integral_, basisset_);
 
         auto Emix = std::make_shared<Matrix>("Emix", nso, nocc);
         auto Emiy = std::make_shared<Matrix>("Emiy", nso, nocc);
@@ -510,13 +607,6 @@ std::shared_ptr<Matrix> RSCFDeriv::hessian_response() {
         double** Emiyp = Emiy->pointer();
         double** Emizp = Emiz->pointer();
 
-        // Make a list of all ECP centers
-        std::set<int> ecp_centers;
-        for (int ecp_shell = 0; ecp_shell < basisset_->n_ecp_shell(); ++ecp_shell){
-            const GaussianShell &ecp = basisset_->ecp_shell(ecp_shell);
-            ecp_centers.insert(ecp.ncenter());
-        }
-
         auto Epi = std::make_shared<Matrix>("Epi", nmo, nocc);
         double** Epip = Epi->pointer();
         psio_address next_Epi = PSIO_ZERO;
@@ -526,58 +616,42 @@ std::shared_ptr<Matrix> RSCFDeriv::hessian_response() {
             Emix->zero();
             Emiy->zero();
             Emiz->zero();
-            const auto& shell_pairs = ecpint->shellpairs();
-            size_t n_pairs = shell_pairs.size();
-
-            for (size_t p = 0; p < n_pairs; ++p) {
-                auto P = shell_pairs[p].first;
-                auto Q = shell_pairs[p].second;
-                const auto & shellP = basisset_->shell(P);
-                const auto & shellQ = basisset_->shell(Q);
-                int aP = shellP.ncenter();
-                int aQ = shellQ.ncenter();
-
-                // Make a list of all ECP centers and the current basis function pair
-                std::set<int> all_centers(ecp_centers.begin(), ecp_centers.end());
-                all_centers.insert(aP);
-                all_centers.insert(aQ);
-                if (all_centers.find(A) == all_centers.end()) continue;
-
-                ecpint->compute_shell_deriv1(P, Q);
-                const auto &buffers = ecpint->buffers();
+            for (const auto& block : ecp_blocks) {
+                auto center = std::find(block.centers.begin(), block.centers.end(), A);
+                if (center == block.centers.end()) continue;
+                const auto & shellP = basisset_->shell(block.P);
+                const auto & shellQ = basisset_->shell(block.Q);
                 int nP = shellP.nfunction();
                 int nQ = shellQ.nfunction();
                 int oP = shellP.function_index();
                 int oQ = shellQ.function_index();
+                size_t size = static_cast<size_t>(nP) * nQ;
+                const double* values = block.values.data() + 3 * (center - block.centers.begin()) * size;
                 const double* buffer2;
 
-                for (const int center : all_centers) {
-                    double scale = P == Q ? 1.0 : 2.0;
-                    if (center == A) {
-                        // x
-                        buffer2 = buffers[3*center+0];
-                        for (int p = 0; p < nP; p++) {
-                            for (int q = 0; q < nQ; q++) {
-                                C_DAXPY(nocc, scale * (*buffer2), Cop[q + oQ], 1, Emixp[p + oP], 1);
-                                C_DAXPY(nocc, scale * (*buffer2++), Cop[p + oP], 1, Emixp[q + oQ], 1);
-                            }
-                        }
-                        // y
-                        buffer2 = buffers[3*center+1];
-                        for (int p = 0; p < nP; p++) {
-                            for (int q = 0; q < nQ; q++) {
-                                C_DAXPY(nocc, scale * (*buffer2), Cop[q + oQ], 1, Emiyp[p + oP], 1);
-                                C_DAXPY(nocc, scale * (*buffer2++), Cop[p + oP], 1, Emiyp[q + oQ], 1);
-                            }
-                        }
-                        // z
-                        buffer2 = buffers[3*center+2];
-                        for (int p = 0; p < nP; p++) {
-                            for (int q = 0; q < nQ; q++) {
-                                C_DAXPY(nocc, scale * (*buffer2), Cop[q + oQ], 1, Emizp[p + oP], 1);
-                                C_DAXPY(nocc, scale * (*buffer2++), Cop[p + oP], 1, Emizp[q + oQ], 1);
-                            }
-                        }
+                double scale = block.P == block.Q ? 1.0 : 2.0;
+                // x
+                buffer2 = values;
+                for (int p = 0; p < nP; p++) {
+                    for (int q = 0; q < nQ; q++) {
+                        C_DAXPY(nocc, scale * (*buffer2), Cop[q + oQ], 1, Emixp[p + oP], 1);
+                        C_DAXPY(nocc, scale * (*buffer2++), Cop[p + oP], 1, Emixp[q + oQ], 1);
+                    }
+                }
+                // y
+                buffer2 = values + size;
+                for (int p = 0; p < nP; p++) {
+                    for (int q = 0; q < nQ; q++) {
+                        C_DAXPY(nocc, scale * (*buffer2), Cop[q + oQ], 1, Emiyp[p + oP], 1);
+                        C_DAXPY(nocc, scale * (*buffer2++), Cop[p + oP], 1, Emiyp[q + oQ], 1);
+                    }
+                }
+                // z
+                buffer2 = values + 2 * size;
+                for (int p = 0; p < nP; p++) {
+                    for (int q = 0; q < nQ; q++) {
+                        C_DAXPY(nocc, scale * (*buffer2), Cop[q + oQ], 1, Emizp[p + oP], 1);
+                        C_DAXPY(nocc, scale * (*buffer2++), Cop[p + oP], 1, Emizp[q + oQ], 1);
                     }
                 }
             }
@@ -1933,15 +2007,11 @@ std::shared_ptr<Matrix> RSCFDeriv::hessian_response() {
     }
 
     size_t mem = 0.9 * memory_ / 8L;
-    size_t per_A = 3L * nso * nso + 1L * nocc * nso;
-    size_t max_A = (mem / 2L) / per_A;
-    max_A = (max_A > 3 * natom ? 3 * natom : max_A);
+    std::shared_ptr<JK> jk = build_response_JK(mem);
 
-    std::shared_ptr<JK> jk;
-    jk = JK::build_JK(basisset_, get_basisset("DF_BASIS_SCF"), options_, false, mem);
-
-    jk->set_memory(mem);
-    jk->initialize();
+    // Dx, Vx; D, J, K held by the JK; R
+    size_t per_A = 5L * nso * nso + 1L * nocc * nso;
+    size_t max_A = response_block_size(mem, per_A);
 
     // => J2pi/K2pi <= //
     {
@@ -2502,11 +2572,7 @@ std::shared_ptr<Matrix> USCFDeriv::hessian_response()
     JK_deriv1(Da, Ca, Ca_occ, Db, nso, naocc, navir, true);
     JK_deriv1(Db, Cb, Cb_occ, Da, nso, nbocc, nbvir, false);
 
-    std::shared_ptr<JK> jk;
-    jk = JK::build_JK(basisset_, get_basisset("DF_BASIS_SCF"), options_, false, mem);
-
-    jk->set_memory(mem);
-    jk->initialize();
+    std::shared_ptr<JK> jk = build_response_JK(mem);
 
     // Jpi/Kpi
     JK_deriv2(jk,mem, Ca, Ca_occ, Cb, Cb_occ, nso, naocc, nbocc, navir);
@@ -2525,10 +2591,9 @@ std::shared_ptr<Matrix> USCFDeriv::hessian_response()
     {
         uhf_wfn_->set_jk(jk);
 
-        // using naocc here
-        size_t per_A = 3L * nso * nso + 1L * naocc * nso;
-        size_t max_A = (mem / 2L) / per_A;
-        max_A = (max_A > 3 * natom ? 3 * natom : max_A);
+        // D, J, K held by the JK; L, R (alpha and beta)
+        size_t per_A = 6L * nso * nso + 2L * (naocc + nbocc) * nso;
+        size_t max_A = response_block_size(mem, per_A);
 
         psio_address next_Baia = PSIO_ZERO;
         psio_address next_Uaia = PSIO_ZERO;
@@ -2613,7 +2678,7 @@ std::shared_ptr<Matrix> USCFDeriv::hessian_response()
     assemble_U(naocc, navir, true);
     assemble_U(nbocc, nbvir, false);
 
-    assemble_Q(jk, Ca, Ca_occ, Cb, Cb_occ, nso, naocc, nbocc, navir);
+    assemble_Q(jk, mem, Ca, Ca_occ, Cb, Cb_occ, nso, naocc, nbocc, navir);
     jk.reset();
 
     // => Zipper <= //
@@ -3282,7 +3347,7 @@ void USCFDeriv::ecp_deriv(std::shared_ptr<Matrix> C,
                           std::shared_ptr<Matrix> Cocc,
                           int nso, int nocc, int nvir, bool alpha)
 {
-    std::shared_ptr<ECPInt> ecpint(dynamic_cast<ECPInt*>(integral_->ao_ecp(1).release()));
+    const auto ecp_blocks = compute_ecp_deriv1_blocks(integral_, basisset_);
     size_t nmo = nocc + nvir;
     int natom = molecule_->natom();
 
@@ -3296,13 +3361,6 @@ void USCFDeriv::ecp_deriv(std::shared_ptr<Matrix> C,
     double** Emiyp = Emiy->pointer();
     double** Emizp = Emiz->pointer();
 
-    // Make a list of all ECP centers
-    std::set<int> ecp_centers;
-    for (int ecp_shell = 0; ecp_shell < basisset_->n_ecp_shell(); ++ecp_shell){
-        const GaussianShell &ecp = basisset_->ecp_shell(ecp_shell);
-        ecp_centers.insert(ecp.ncenter());
-    }
-
     auto Epi = std::make_shared<Matrix>("Epi", nmo, nocc);
     double** Epip = Epi->pointer();
     psio_address next_Epi = PSIO_ZERO;
@@ -3312,58 +3370,42 @@ void USCFDeriv::ecp_deriv(std::shared_ptr<Matrix> C,
         Emix->zero();
         Emiy->zero();
         Emiz->zero();
-        const auto& shell_pairs = ecpint->shellpairs();
-        size_t n_pairs = shell_pairs.size();
-
-        for (size_t p = 0; p < n_pairs; ++p) {
-            auto P = shell_pairs[p].first;
-            auto Q = shell_pairs[p].second;
-            const auto & shellP = basisset_->shell(P);
-            const auto & shellQ = basisset_->shell(Q);
-            int aP = shellP.ncenter();
-            int aQ = shellQ.ncenter();
-
-            // Make a list of all ECP centers and the current basis function pair
-            std::set<int> all_centers(ecp_centers.begin(), ecp_centers.end());
-            all_centers.insert(aP);
-            all_centers.insert(aQ);
-            if (all_centers.find(A) == all_centers.end()) continue;
-
-            ecpint->compute_shell_deriv1(P, Q);
-            const auto &buffers = ecpint->buffers();
+        for (const auto& block : ecp_blocks) {
+            auto center = std::find(block.centers.begin(), block.centers.end(), A);
+            if (center == block.centers.end()) continue;
+            const auto & shellP = basisset_->shell(block.P);
+            const auto & shellQ = basisset_->shell(block.Q);
             int nP = shellP.nfunction();
             int nQ = shellQ.nfunction();
             int oP = shellP.function_index();
             int oQ = shellQ.function_index();
+            size_t size = static_cast<size_t>(nP) * nQ;
+            const double* values = block.values.data() + 3 * (center - block.centers.begin()) * size;
             const double* buffer2;
 
-            for (const int center : all_centers) {
-                double scale = P == Q ? 1.0 : 2.0;
-                if (center == A) {
-                    // x
-                    buffer2 = buffers[3*center+0];
-                    for (int p = 0; p < nP; p++) {
-                        for (int q = 0; q < nQ; q++) {
-                            C_DAXPY(nocc, scale * (*buffer2), Cop[q + oQ], 1, Emixp[p + oP], 1);
-                            C_DAXPY(nocc, scale * (*buffer2++), Cop[p + oP], 1, Emixp[q + oQ], 1);
-                        }
-                    }
-                    // y
-                    buffer2 = buffers[3*center+1];
-                    for (int p = 0; p < nP; p++) {
-                        for (int q = 0; q < nQ; q++) {
-                            C_DAXPY(nocc, scale * (*buffer2), Cop[q + oQ], 1, Emiyp[p + oP], 1);
-                            C_DAXPY(nocc, scale * (*buffer2++), Cop[p + oP], 1, Emiyp[q + oQ], 1);
-                        }
-                    }
-                    // z
-                    buffer2 = buffers[3*center+2];
-                    for (int p = 0; p < nP; p++) {
-                        for (int q = 0; q < nQ; q++) {
-                            C_DAXPY(nocc, scale * (*buffer2), Cop[q + oQ], 1, Emizp[p + oP], 1);
-                            C_DAXPY(nocc, scale * (*buffer2++), Cop[p + oP], 1, Emizp[q + oQ], 1);
-                        }
-                    }
+            double scale = block.P == block.Q ? 1.0 : 2.0;
+            // x
+            buffer2 = values;
+            for (int p = 0; p < nP; p++) {
+                for (int q = 0; q < nQ; q++) {
+                    C_DAXPY(nocc, scale * (*buffer2), Cop[q + oQ], 1, Emixp[p + oP], 1);
+                    C_DAXPY(nocc, scale * (*buffer2++), Cop[p + oP], 1, Emixp[q + oQ], 1);
+                }
+            }
+            // y
+            buffer2 = values + size;
+            for (int p = 0; p < nP; p++) {
+                for (int q = 0; q < nQ; q++) {
+                    C_DAXPY(nocc, scale * (*buffer2), Cop[q + oQ], 1, Emiyp[p + oP], 1);
+                    C_DAXPY(nocc, scale * (*buffer2++), Cop[p + oP], 1, Emiyp[q + oQ], 1);
+                }
+            }
+            // z
+            buffer2 = values + 2 * size;
+            for (int p = 0; p < nP; p++) {
+                for (int q = 0; q < nQ; q++) {
+                    C_DAXPY(nocc, scale * (*buffer2), Cop[q + oQ], 1, Emizp[p + oP], 1);
+                    C_DAXPY(nocc, scale * (*buffer2++), Cop[p + oP], 1, Emizp[q + oQ], 1);
                 }
             }
         }
@@ -4324,7 +4366,7 @@ void USCFDeriv::JK_deriv1(std::shared_ptr<Matrix> D1,
     } // End if density fitted
 }
 
-void USCFDeriv::JK_deriv2(std::shared_ptr<JK> jk, int mem,
+void USCFDeriv::JK_deriv2(std::shared_ptr<JK> jk, size_t mem,
                           std::shared_ptr<Matrix> Ca,
                           std::shared_ptr<Matrix> Caocc,
                           std::shared_ptr<Matrix> Cb,
@@ -4340,10 +4382,9 @@ void USCFDeriv::JK_deriv2(std::shared_ptr<JK> jk, int mem,
     auto nmo = static_cast<size_t>(naocc + navir);
     auto natom = molecule_->natom();
 
-    // Dx, Vx (alpha and beta); L, R (C1); L, R (C2)
-    size_t per_A = 2L * (2 * nso + naocc + nbocc) * nso;
-    size_t max_A = (mem / 2L) / per_A;
-    max_A = std::min(max_A, 3 * static_cast<size_t>(natom));
+    // Dx, Vx (alpha and beta); L, R (C1); L, R (C2); D, J, K held by the JK (alpha and beta)
+    size_t per_A = 2L * (5 * nso + naocc + nbocc) * nso;
+    size_t max_A = response_block_size(mem, per_A);
 
     // Figure out DFT functional info
     double Kscale = functional_->x_alpha();
@@ -4626,7 +4667,7 @@ void USCFDeriv::assemble_U(int nocc, int nvir, bool alpha)
     }
 }
 
-void USCFDeriv::assemble_Q(std::shared_ptr<JK> jk,
+void USCFDeriv::assemble_Q(std::shared_ptr<JK> jk, size_t mem,
                            std::shared_ptr<Matrix> Ca,
                            std::shared_ptr<Matrix> Caocc,
                            std::shared_ptr<Matrix> Cb,
@@ -4636,18 +4677,15 @@ void USCFDeriv::assemble_Q(std::shared_ptr<JK> jk,
     // => Qpi <= //
     size_t nmo = naocc + navir;
     int natom = molecule_->natom();
-    size_t mem = 0.9 * memory_ / 8L;
-    // Dx, Vx (alpha and beta); L, R (C1); L, R (C2)
-    size_t per_A = 2L * (2 * nso + naocc + nbocc) * nso;
-    size_t max_A = (mem / 2L) / per_A;
-    max_A = std::min(max_A, 3 * static_cast<size_t>(natom));
+    // Dx, Vx (alpha and beta); L, R (C1); L, R (C2); D, J, K held by the JK (alpha and beta)
+    size_t per_A = 2L * (5 * nso + naocc + nbocc) * nso;
+    size_t max_A = response_block_size(mem, per_A);
 
     auto Cap  = Ca->pointer();
     auto Caop = Caocc->pointer();
     auto Cbp = Cb->pointer();
     auto Cbop = Cbocc->pointer();
 
-    max_A = (max_A > 3 * natom ? 3 * natom : max_A);
     double Kscale = functional_->x_alpha();
     auto& L = jk->C_left();
     auto& R = jk->C_right();
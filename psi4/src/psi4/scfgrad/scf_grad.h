@@ -55,6 +55,12 @@ protected:
     std::map<std::string, SharedMatrix> gradients_;
     std::map<std::string, SharedMatrix> hessians_;
 
+    /// Builds and initializes the JK used by the Hessian response (|scf__hessian_response_type|) from a budget
+    /// of doubles; on return, doubles holds what is left for the batches of perturbed densities.
+    std::shared_ptr<JK> build_response_JK(size_t& doubles);
+    /// Number of perturbations pushed through one JK::compute(), given per_A doubles of work space each
+    size_t response_block_size(size_t doubles, size_t per_A) const;
+
 public:
     SCFDeriv(std::shared_ptr<scf::HF> ref_wfn, Options& options);
     ~SCFDeriv() override;
@@ -107,7 +113,7 @@ protected:
 
     // Compute the JK contribution to the the overlap derivative *
     //   TEI term  on the right-side of the CP-SCF equations.
-    void JK_deriv2(std::shared_ptr<JK> jk, int mem, 
+    void JK_deriv2(std::shared_ptr<JK> jk, size_t mem,
                    std::shared_ptr<Matrix> Ca,
                    std::shared_ptr<Matrix> Caocc,
                    std::shared_ptr<Matrix> Cb,
@@ -124,7 +130,7 @@ protected:
 
     void assemble_B(std::shared_ptr<Vector> eocc, int nocc, int nvir, bool alpha);
     void assemble_U(int nocc, int nvir, bool alpha);
-    void assemble_Q(std::shared_ptr<JK> jk,
+    void assemble_Q(std::shared_ptr<JK> jk, size_t mem,
                     std::shared_ptr<Matrix> C1, 
                     std::shared_ptr<Matrix> C1occ,
                     std::shared_ptr<Matrix> C2, 
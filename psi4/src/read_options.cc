@@ -132,6 +132,11 @@ int read_options(const std::string &name, Options &options, bool suppress_printi
     options.add("FREEZE_CORE_POLICY", new ArrayType());
 
     options.add("NUM_GPUS", 1);
+    /*- Number of NUMA domains (typically sockets) to lay out per-thread work for in DirectJK and
+    the DFT integration. Per-thread buffers are then allocated on their own thread, and DirectJK
+    accumulates J/K into one partial per domain before the final sum. Threads must be bound
+    (OMP_PROC_BIND and OMP_PLACES) for this to help. 0 disables. !expert -*/
+    options.add_int("NUMA_DOMAINS", 0);
     /*- Do use pure angular momentum basis functions?
     If not explicitly set, the default comes from the basis set.
     **Cfour Interface:** Keyword translates into |cfour__cfour_spherical|. -*/
@@ -178,9 +183,21 @@ int read_options(const std::string &name, Options &options, bool suppress_printi
     options.add_str_i("WRITER_FILE_LABEL", "");
     /*- The density fitting basis to use in coupled cluster computations. -*/
     options.add_str("DF_BASIS_CC", "");
+    /*- Memory (MiB) for keeping density-fitting metrics and in-core three-index integrals
+    between computations on the same geometry, e.g. from SCF into DF-MP2 or the
+    gradient. This is in addition to |globals__memory|; 0 disables the cache. !expert -*/
+    options.add_double("DF_CACHE_MEMORY", 0.0);
     /*- Assume external fields are arranged so that they have symmetry. It is up to the user to know what to do here.
        The code does NOT help you out in any way! !expert -*/
     options.add_bool("EXTERNAL_POTENTIAL_SYMMETRY", false);
+    /*- Highest multipole order used for distant cells of external point charges. Cells whose
+    center is at least |globals__external_potential_far_field_separation| cell radii from every atom are
+    replaced by their multipole expansion about the cell center; -1 treats every charge exactly. -*/
+    options.add_int("EXTERNAL_POTENTIAL_FAR_FIELD_ORDER", -1);
+    /*- Edge length [a0] of the cubic cells that external point charges are grouped into for the far field. -*/
+    options.add_double("EXTERNAL_POTENTIAL_FAR_FIELD_BOX_LENGTH", 10.0);
+    /*- Minimum distance, in cell radii, between a far field cell center and any atom. -*/
+    options.add_double("EXTERNAL_POTENTIAL_FAR_FIELD_SEPARATION", 4.0);
     /*- Text to be passed directly into CFOUR input files. May contain
     molecule, options, percent blocks, etc. Access through ``cfour {...}``
     block. -*/
@@ -191,8 +208,9 @@ int read_options(const std::string &name, Options &options, bool suppress_printi
     options.add_str("QC_MODULE", "", "CCENERGY DETCI DFMP2 FNOCC OCC CCT3 BUILTIN MRCC");
     /*- What algorithm to use for the SCF computation. See Table :ref:`SCF
     Convergence & Algorithm <table:conv_scf>` for default algorithm for
-    different calculation types. -*/
-    options.add_str("SCF_TYPE", "PK", "DIRECT DF MEM_DF DISK_DF PK OUT_OF_CORE CD GTFOCK DFDIRJ DFDIRJ+COSX DFDIRJ+LINK");
+    different calculation types. ``AUTO`` picks between in-core ``PK`` and
+    ``DIRECT`` with a cost model. -*/
+    options.add_str("SCF_TYPE", "PK", "AUTO DIRECT DF MEM_DF DISK_DF PK OUT_OF_CORE CD GTFOCK DFDIRJ DFDIRJ+COSX DFDIRJ+LINK CFMM CFMM+COSX CFMM+LINK");
     /*- Algorithm to use for MP2 computation.
     See :ref:`Cross-module Redundancies <table:managedmethods>` for details. -*/
     options.add_str("MP2_TYPE", "DF", "DF CONV CD");
@@ -208,11 +226,20 @@ int read_options(const std::string &name, Options &options, bool suppress_printi
     /*- Algorithm to use for CI computation (e.g., CID or CISD).
     See :ref:`Cross-module Redundancies <table:managedmethods>` for details. -*/
     options.add_str("CI_TYPE", "CONV", "CONV");
+    /*- Do truncate the virtual space to DF-MP2 frozen natural orbitals before a
+    CCENERGY/CCEOM, DFOCC, DCT, or DETCI energy? The MP2 energy of the discarded
+    virtuals is added back to the correlation energies. The truncation follows
+    |fnocc__occ_tolerance|, |fnocc__occ_percentage|, or |fnocc__active_nat_orbs|,
+    and the fitting basis is |dfmp2__df_basis_mp2|. RHF references only. FNOCC
+    has its own |fnocc__nat_orbs|. -*/
+    options.add_bool("FROZEN_NAT_ORBS", false);
     /*- Write all the MOs to the MOLDEN file (true) or discard the unoccupied MOs (false). -*/
     options.add_bool("MOLDEN_WITH_VIRTUAL", true);
 
-    /*- The type of screening used when computing two-electron integrals. -*/
-    options.add_str("SCREENING", "CSAM", "SCHWARZ CSAM DENSITY NONE");
+    /*- The type of screening used when computing two-electron integrals. QQR adds the distance
+    dependence of Maurer et al. (2012) to the Schwarz bound, and in DirectJK also multiplies it by
+    the (incremental) density as DENSITY does. -*/
+    options.add_str("SCREENING", "CSAM", "SCHWARZ CSAM QQR DENSITY NONE");
 
     // CDS-TODO: We should go through and check that the user hasn't done
     // something silly like specify frozen_docc in DETCI but not in TRANSQT.
@@ -234,6 +261,10 @@ int read_options(const std::string &name, Options &options, bool suppress_printi
     options.add_str("BASIS_RELATIVISTIC", "");
     /*- Order of Douglas-Kroll-Hess !expert -*/
     options.add_int("DKH_ORDER", 2);
+    /*- Decouple X2C with atom-diagonal blocks of the uncontracted basis (local unitary transformation,
+    DLU-X2C) instead of diagonalizing the full-molecule Dirac Hamiltonian. Much cheaper for many heavy
+    atoms, at a small, well-characterized loss of accuracy. -*/
+    options.add_bool("X2C_LOCAL_UNITARY", false);
 
     /*- Directory to which to write cube files. Default is the input file
     directory. -*/
@@ -507,9 +538,16 @@ int read_options(const std::string &name, Options &options, bool suppress_printi
         less core memory. -*/
         options.add_int("ICORE", 1);
 
-        /*- Number of threads for DETCI. !expert -*/
+        /*- Number of threads for DETCI. With |detci__icore| = 1 the sigma
+        subblocks are built in parallel. Defaults to the number of threads
+        given to Psi4. !expert -*/
         options.add_int("CI_NUM_THREADS", 1);
 
+        /*- Do keep the CI, sigma, and correction vectors in memory instead of
+        writing them to disk? Up to half of the memory given to Psi4 is used;
+        buffers that do not fit go to disk as usual. !expert -*/
+        options.add_bool("CI_VECS_IN_MEMORY", false);
+
         /*- Do print the sigma overlap matrix?  Not generally useful.  !expert -*/
         options.add_bool("SIGMA_OVERLAP", false);
 
@@ -592,8 +630,22 @@ int read_options(const std::string &name, Options &options, bool suppress_printi
         if only one root is to be found.
         The ``SEM`` method is the most robust, but it also
         requires $2NM+1$ CI vectors on disk, where $N$ is the maximum number of
-        iterations and $M$ is the number of roots. -*/
-        options.add_str("DIAG_METHOD", "SEM", "RSP DAVIDSON SEM");
+        iterations and $M$ is the number of roots. ``HCI`` skips the string-driven
+        CI space altogether and solves a heat-bath selected CI instead, which
+        keeps only the determinants $I$ for which $|H_{IJ} c_J|$ exceeds
+        |detci__hci_epsilon| for some determinant $J$ already selected; it
+        handles active spaces of up to 64 orbitals but ignores RAS restrictions. -*/
+        options.add_str("DIAG_METHOD", "SEM", "RSP DAVIDSON SEM HCI");
+
+        /*- Selection threshold of the heat-bath selected CI (|detci__diag_method|
+        ``HCI``).  Determinants $I$ are added once $|H_{IJ} c_J|$ exceeds this
+        value for a selected determinant $J$.  Smaller values give more
+        determinants and an energy closer to the full CI limit. -*/
+        options.add_double("HCI_EPSILON", 1.0e-4);
+
+        /*- Maximum number of selection iterations of the heat-bath selected CI.
+        The selection stops earlier once no new determinants are found. -*/
+        options.add_int("HCI_MAXITER", 20);
 
         /*- This specifies the type of preconditioner to use in the selected
         diagonalization method.  The valid options are: ``DAVIDSON`` which
@@ -959,6 +1011,16 @@ int read_options(const std::string &name, Options &options, bool suppress_printi
         /*- Start second-order (AH or OS) orbital-orbital MCSCF based on energy convergence -*/
         options.add_double("MCSCF_SO_START_E", 1e-4);
 
+        /*- Cheaper JK build for the orbital Hessian-vector products of the AH algorithm.
+        DF fits the products in the DF_BASIS_SCF basis while the orbital gradient is large,
+        and has no effect for MCSCF_TYPE DF. The orbital gradient always uses the exact
+        integrals. -*/
+        options.add_str("MCSCF_HK_JK", "NONE", "NONE DF");
+
+        /*- RMS of the orbital gradient below which the AH algorithm switches from the
+        MCSCF_HK_JK build to the exact Hessian-vector products -*/
+        options.add_double("MCSCF_HK_JK_GRAD", 1e-5);
+
         /*- Iteration to turn on DIIS for TS convergence -*/
         options.add_int("MCSCF_DIIS_START", 3);
 
@@ -1045,6 +1107,11 @@ int read_options(const std::string &name, Options &options, bool suppress_printi
         Use may speed up the computation slightly at the cost of spawning an
         additional thread. -*/
         options.add_bool("AIO_DF_INTS", false);
+        /*- Do hold the SAPT0 DF integrals in core once formed? Block reads
+        throughout the induction, exchange and dispersion terms then become
+        memory copies. Falls back to disk if the integrals need more than half
+        of the memory. -*/
+        options.add_bool("INCORE_DF_INTS", false);
 
         /*- Maximum number of CPHF iterations -*/
         options.add_int("MAXITER", 50);
@@ -1239,6 +1306,10 @@ int read_options(const std::string &name, Options &options, bool suppress_printi
         options.add_double("LOCAL_CONVERGENCE", 1.0E-12);
         /*- Maximum iterations in localization -*/
         options.add_int("LOCAL_MAXITER", 1000);
+        /*- Run each Boys or Pipek-Mezey Jacobi sweep as round-robin rounds of disjoint orbital pairs,
+        threaded within each round. The result does not depend on the thread count, but follows a different
+        rotation order than the default sequential sweep. -*/
+        options.add_bool("LOCAL_PARALLEL_SWEEP", false);
         /*- Use ghost atoms in Pipek-Mezey or IBO metric !expert -*/
         options.add_bool("LOCAL_USE_GHOSTS", false);
         /*- Condition number to use in IBO metric inversions !expert -*/
@@ -1429,8 +1500,22 @@ int read_options(const std::string &name, Options &options, bool suppress_printi
             forcibly select a sub-algorithm (usually only for debugging or profiling).
             Presently, ``SCF_SUBTYPE=DF``, ``SCF_SUBTYPE=MEM_DF``, and ``SCF_SUBTYPE=DISK_DF`` 
 	        can have ``INCORE`` and ``OUT_OF_CORE`` selected; and ``SCF_TYPE=PK``  can have ``INCORE``,
-	        ``OUT_OF_CORE``, ``YOSHIMINE_OUT_OF_CORE``, and ``REORDER_OUT_OF_CORE`` selected. !expert -*/
-	    options.add_str("SCF_SUBTYPE", "AUTO", "AUTO INCORE OUT_OF_CORE YOSHIMINE_OUT_OF_CORE REORDER_OUT_OF_CORE");
+	        ``INCORE_COMPRESSED``, ``OUT_OF_CORE``, ``YOSHIMINE_OUT_OF_CORE``, and ``REORDER_OUT_OF_CORE`` selected.
+	        ``INCORE_COMPRESSED`` keeps the PK supermatrices in core, dropping blocks of negligible integrals and
+	        storing small-magnitude blocks in single precision. !expert -*/
+	    options.add_str("SCF_SUBTYPE", "AUTO", "AUTO INCORE INCORE_COMPRESSED OUT_OF_CORE YOSHIMINE_OUT_OF_CORE REORDER_OUT_OF_CORE");
+        /*- Memory-map the files of out-of-core DFHelper tensors (e.g., ``SCF_TYPE=MEM_DF`` with
+            ``SCF_SUBTYPE=OUT_OF_CORE``) instead of reading and writing them through file streams.
+            Repeated reads are then served by the operating system page cache. !expert -*/
+        options.add_bool("DF_DISK_MMAP", false);
+        /*- Store out-of-core DFHelper integrals (e.g., ``SCF_TYPE=MEM_DF`` with ``SCF_SUBTYPE=OUT_OF_CORE``)
+            in single precision, halving their scratch volume. Introduces errors of roughly 1.0E-7 relative
+            in the integrals, the fitting metric is always kept in double precision. !expert -*/
+        options.add_bool("DF_DISK_COMPRESS", false);
+        /*- Compress the auxiliary space of in-core DFHelper integrals (e.g., ``SCF_TYPE=MEM_DF``) by dropping the
+            directions whose eigenvalue in the Gram matrix of the fitted (Q|mn) falls below this value. Every
+            later contraction runs over the compressed rank. Zero keeps the full auxiliary basis. !expert -*/
+        options.add_double("DF_AUX_RANK_TOLERANCE", 0.0);
         /*- Keep JK object for later use? -*/
         options.add_bool("SAVE_JK", false);
         /*- Memory safety factor for allocating JK -*/
@@ -1461,6 +1546,14 @@ int read_options(const std::string &name, Options &options, bool suppress_printi
         /*- If true, then repeat the specified guess procedure for the orbitals every time -
         even during a geometry optimization. -*/
         options.add_bool("GUESS_PERSIST", false);
+        /*- Extrapolate the guess orbitals from the SCF solutions at previous geometries of a geometry optimization
+        or molecular dynamics trajectory run within one session. ASPC combines the previous densities with the always
+        stable predictor-corrector coefficients of Kolafa; with a single previous solution, its orbitals are projected
+        onto the new geometry. Once a previous solution is stored, this takes precedence over |scf__guess|. -*/
+        options.add_str("GUESS_EXTRAPOLATION", "NONE", "NONE ASPC");
+        /*- Order of the ASPC guess extrapolation; up to |scf__guess_extrapolation_order| + 2 previous
+        solutions are used. -*/
+        options.add_int("GUESS_EXTRAPOLATION_ORDER", 3);
         /*- File name (case sensitive) to which to serialize Wavefunction orbital data. -*/
         options.add_str_i("ORBITALS_WRITE", "");
 
@@ -1539,6 +1632,11 @@ int read_options(const std::string &name, Options &options, bool suppress_printi
         options.add_int("SOLVER_MAXITER", 100);
         /*- Number of guess vectors per root for instability analysis. -*/
         options.add_int("SOLVER_N_GUESS", 1);
+        /*- JK algorithm for the perturbed Fock builds of the analytic Hessian response (CPHF/CPKS).
+        ``SCF_TYPE`` reuses the algorithm of the reference. Any of the density-fitted types fits the
+        response with |scf__df_basis_scf| even when the reference used exact integrals, which is much
+        faster for large molecules at the cost of a density-fitting error in the Hessian. -*/
+        options.add_str("HESSIAN_RESPONSE_TYPE", "SCF_TYPE", "SCF_TYPE DIRECT DF MEM_DF DISK_DF");
         /*- Number of roots to converge for all irreps during instability analysis. (Overridden by SOLVER_ROOTS_PER_IRREP.) -*/
         options.add_int("SOLVER_N_ROOT", 1);
         /*- Number of roots to converge, per irrep, during instability analysis. (Overrides SOLVER_N_ROOT.) -*/
@@ -1555,6 +1653,9 @@ int read_options(const std::string &name, Options &options, bool suppress_printi
         options.add_double("SOSCF_CONV", 5.0E-3);
         /*- Do we print the SOSCF microiterations?. -*/
         options.add_bool("SOSCF_PRINT", false);
+        /*- Initial and largest trust radius, as the norm of the orbital rotation, for second-order SCF steps.
+        The radius is halved after a step that raised the energy. -*/
+        options.add_double("SOSCF_TRUST_RADIUS", 0.5);
         /*- Whether to perform stability analysis after convergence.  NONE prevents analysis being
             performed. CHECK will print out the analysis of the wavefunction stability at the end of
             the computation.  FOLLOW will perform the analysis and, if a totally symmetric instability
@@ -1586,10 +1687,22 @@ int read_options(const std::string &name, Options &options, bool suppress_printi
         options.add_int("INCFOCK_FULL_FOCK_EVERY", 5);
         /*- The density threshold at which to stop building the Fock matrix incrementally -*/
         options.add_double("INCFOCK_CONVERGENCE", 1.0e-5);
+        /*- Eigenvalue cutoff when factoring the density change into pseudo-occupied orbitals for
+        incremental Fock builds with density-fitted algorithms (|globals__scf_type| ``MEM_DF``, ``DISK_DF``, or ``CD``).
+        Iterations where the factored change is not of lower rank than the occupied space fall back to a full build. -*/
+        options.add_double("INCFOCK_DF_TOLERANCE", 1.0e-8);
 
         /*- The screening tolerance used for ERI/Density sparsity in the LinK algorithm -*/
         options.add_double("LINK_INTS_TOLERANCE", 1.0e-12);
 
+        /*- Order of the multipole expansions used for well-separated cells in the CFMM Coulomb build -*/
+        options.add_int("CFMM_ORDER", 12);
+        /*- Edge length (bohr) of the boxes the CFMM Coulomb build sorts shell pairs into -*/
+        options.add_double("CFMM_BOX_LENGTH", 6.0);
+        /*- Two CFMM cells interact through multipoles if their distance exceeds this multiple of the
+        sum of their radii. Larger values are more accurate but move more work into the near field. -*/
+        options.add_double("CFMM_SEPARATION", 2.0);
+
         /*- SUBSECTION Fractional Occupation UHF/UKS -*/
 
         /*- The iteration to start fractionally occupying orbitals (or 0 for no fractional occupation) -*/
@@ -1660,6 +1773,23 @@ int read_options(const std::string &name, Options &options, bool suppress_printi
         options.add_str("DF_INTS_IO", "NONE", "NONE SAVE LOAD");
         /*- Fitting Condition, i.e. eigenvalue threshold for RI basis. Analogous to S_TOLERANCE !expert -*/
         options.add_double("DF_FITTING_CONDITION", 1.0E-10);
+        /*- Occupied-orbital coefficient cutoff for screening the exchange build in MEM_DF. Basis functions
+        whose Schwarz partners all have coefficients below this value in a block of occupied orbitals are
+        skipped for that block. Only worthwhile for localized orbitals; 0.0 uses the dense exchange build. !expert -*/
+        options.add_double("DF_K_ORBITAL_TOLERANCE", 0.0);
+        /*- Do apply the fitting metric in MEM_DF through triangular solves with its Cholesky factor,
+        instead of forming its inverse square root? Faster and more stable for large auxiliary basis sets;
+        the fitted integrals are rotated but J and K are unchanged. Not used with range-separated
+        exchange. !expert -*/
+        options.add_bool("DF_METRIC_SOLVE", false);
+        /*- Do run the exchange contractions of the JK build in single precision for early SCF iterations?
+        Supported by |globals__scf_type| ``MEM_DF`` and ``COSX``. The build returns to double precision once
+        the density change drops below |scf__scf_mixed_precision_convergence|, and always before convergence
+        is declared. !expert -*/
+        options.add_bool("SCF_MIXED_PRECISION", false);
+        /*- Density (orbital gradient) threshold at which |scf__scf_mixed_precision| switches
+        the JK build back to double precision. !expert -*/
+        options.add_double("SCF_MIXED_PRECISION_CONVERGENCE", 1.0e-5);
         /*- FastDF Fitting Metric -*/
         options.add_str("DF_METRIC", "COULOMB", "COULOMB EWALD OVERLAP");
         /*- FastDF SR Ewald metric range separation parameter -*/
@@ -1718,6 +1848,10 @@ int read_options(const std::string &name, Options &options, bool suppress_printi
         options.add_bool("SAD_SPIN_AVERAGE", true);
         /*- SAD guess density decomposition threshold !expert -*/
         options.add_double("SAD_CHOL_TOLERANCE", 1E-7);
+        /*- Directory in which converged SAD atomic densities are cached, keyed on element, occupation, basis and
+        SAD settings. Later computations that find a matching entry skip the atomic UHF. The default, an empty
+        string, disables the cache. !expert -*/
+        options.add_str_i("SAD_CACHE_DIR", "");
 
         /*- SUBSECTION DFT -*/
 
@@ -1755,6 +1889,12 @@ int read_options(const std::string &name, Options &options, bool suppress_printi
         options.add_double("DFT_BS_RADIUS_ALPHA", 1.0);
         /*- DFT basis cutoff. -*/
         options.add_double("DFT_BASIS_TOLERANCE", 1.0E-12);
+        /*- Store cached DFT collocation blocks in single precision, doubling the number of blocks that fit in
+        memory. Introduces errors of roughly 1.0E-7 relative in the basis function values. !expert -*/
+        options.add_bool("DFT_COLLOCATION_COMPRESS", false);
+        /*- Scratch space [MiB] for DFT collocation blocks that do not fit in memory. These blocks are read back each
+        iteration instead of being recomputed. Zero disables the disk tier. !expert -*/
+        options.add_int("DFT_COLLOCATION_DISK", 0);
         /*- grid weight cutoff. Disable with -1.0. !expert -*/
         options.add_double("DFT_WEIGHTS_TOLERANCE", 1.0E-15);
         /*- density cutoff for LibXC. A negative value turns the feature off and LibXC defaults are used. !expert -*/
@@ -1772,12 +1912,36 @@ int read_options(const std::string &name, Options &options, bool suppress_printi
         options.add_int("DFT_BLOCK_MAX_POINTS", 256);
         /*- The minimum number of grid points per evaluation block. !expert -*/
         options.add_int("DFT_BLOCK_MIN_POINTS", 100);
+        /*- Number of grid blocks per thread whose points are gathered into a single functional evaluation
+        during the SCF Fock build. Values above one amortize the per-call overhead of LibXC on grids with
+        small blocks, at the cost of one extra set of point workers per batched block. !expert -*/
+        options.add_int("DFT_BLOCK_BATCH", 1);
+        /*- Number of trial densities per block whose response potentials are built together with one
+        collocation GEMM each way in TDDFT and CPKS. Larger values use fewer, wider GEMMs but need
+        per-thread scratch of this many times the largest block collocation matrix. !expert -*/
+        options.add_int("DFT_VX_BATCH", 8);
+        /*- Skip grid blocks in the SCF Fock build whose largest density in the previous evaluation was below
+        this value. Once the SCF converges, a final iteration is run on the full grid. Zero disables the
+        screening. !expert -*/
+        options.add_double("DFT_BLOCK_SCREENING_CUTOFF", 0.0);
+        /*- Reuse the stored exchange-correlation potential contribution of a grid block in the SCF Fock build
+        while no density, density gradient or kinetic energy density value on it has moved by more than this
+        since the contribution was built. Once the SCF converges, a final iteration rebuilds every block.
+        The stored contributions take about as much memory as the collocation matrices. Zero disables the
+        reuse. !expert -*/
+        options.add_double("DFT_INCREMENTAL_XC_CUTOFF", 0.0);
         /*- The maximum radius to terminate subdivision of an octree block [au]. !expert -*/
         options.add_double("DFT_BLOCK_MAX_RADIUS", 3.0);
         /*- Remove points from the quadrature grid that exceed the spatial extend of the basis functions. !expert -*/
         options.add_bool("DFT_REMOVE_DISTANT_POINTS",true);
-        /*- The blocking scheme for DFT. !expert -*/
-        options.add_str("DFT_BLOCK_SCHEME", "OCTREE", "NAIVE OCTREE ATOMIC");
+        /*- Reuse the DFT grid built for a previous geometry when no atom has moved more than this distance
+        [au] from it. The atomic grids are moved with their nuclei and only the nuclear weights are recomputed;
+        the point set and blocking are kept. Intended for geometry optimizations and dynamics. Zero always
+        rebuilds the grid. !expert -*/
+        options.add_double("DFT_GRID_REUSE_TOLERANCE", 0.0);
+        /*- The blocking scheme for DFT. ``BALANCED`` bisects the grid into blocks of similar cost
+        (points times significant basis functions) and orders them most expensive first. !expert -*/
+        options.add_str("DFT_BLOCK_SCHEME", "OCTREE", "NAIVE OCTREE ATOMIC BALANCED");
         /*- Parameters defining the dispersion correction. See Table
         :ref:`-D Functionals <table:dft_disp>` for default values and Table
         :ref:`Dispersion Corrections <table:dashd>` for the order in which
@@ -1793,6 +1957,9 @@ int read_options(const std::string &name, Options &options, bool suppress_printi
         options.add_int("DFT_VV10_RADIAL_POINTS", 50);
         /*- Rho cutoff for VV10 NL integration. !expert -*/
         options.add_double("DFT_VV10_RHO_CUTOFF", 1.e-8);
+        /*- Interaction radius [au] for VV10 NL integration. NL grid points are binned into cubic cells of this
+        size and cells farther than this from a grid block are skipped. Zero sums all pairs. !expert -*/
+        options.add_double("DFT_VV10_CUTOFF_RADIUS", 0.0);
         /*- Define VV10 parameter b -*/
         options.add_double("DFT_VV10_B", 0.0);
         /*- Define VV10 parameter C -*/
@@ -1803,6 +1970,10 @@ int read_options(const std::string &name, Options &options, bool suppress_printi
         options.add_double("LOCAL_CONVERGENCE", 1E-12);
         /*- The maxiter on the orbital localization procedure -*/
         options.add_int("LOCAL_MAXITER", 200);
+        /*- Run each Boys or Pipek-Mezey Jacobi sweep as round-robin rounds of disjoint orbital pairs,
+        threaded within each round. The result does not depend on the thread count, but follows a different
+        rotation order than the default sequential sweep. -*/
+        options.add_bool("LOCAL_PARALLEL_SWEEP", false);
         /*- The number of NOONs to print in a UHF calc -*/
         options.add_str("UHF_NOONS", "3");
         /*- Save the UHF NOs -*/
@@ -1887,6 +2058,9 @@ int read_options(const std::string &name, Options &options, bool suppress_printi
         /*- Solver precondition type
          -*/
         options.add_str("SOLVER_PRECONDITION", "JACOBI", "SUBSPACE JACOBI NONE");
+        /*- Solve all right-hand sides with block conjugate gradients, sharing one search space.
+        Converged right-hand sides drop out of the block either way. -*/
+        options.add_bool("SOLVER_BLOCK_CG", false);
     }
     if (name == "CCTRANSORT" || options.read_globals()) {
         /*- MODULEDESCRIPTION Transforms and sorts integrals for CC codes. Called before (non-density-fitted) MP2 and
@@ -1903,6 +2077,21 @@ int read_options(const std::string &name, Options &options, bool suppress_printi
         options.add_int("CACHELEVEL", 2);
         /*- Force conversion of ROHF MOs to semicanonical MOs to run UHF-based energies -*/
         options.add_bool("SEMICANONICAL", false);
+        /*- Do reuse the sorted integrals left on disk by an earlier cctransort
+        run for the same reference?  The sort is skipped only if the earlier run
+        completed and its SCF energy, reference type and orbital counts match.
+        Meant for restarting an interrupted calculation from its scratch files
+        (see |ccenergy__amps_checkpoint_freq|). -*/
+        options.add_bool("REUSE_SORTED_INTS", false);
+        /*- Type of two-electron integrals handed to the CC modules.  DF and CD
+        build every MO integral block directly from density-fitted or
+        Cholesky-decomposed three-index factors, skipping the AO integral
+        file and the four-index transformation.  RHF and ROHF references
+        only. -*/
+        options.add_str("TEI_TYPE", "CONV", "CONV DF CD");
+        /*- Tolerance for the Cholesky decomposition of the ERI tensor when
+        |cctransort__tei_type| is CD. -*/
+        options.add_double("CHOLESKY_TOLERANCE", 1.0e-4);
         /*- Use cctransort module NOTE: Turning this option off requires separate
            installation of  ccsort and transqt2 modules, see http://github.com/psi4/psi4pasture -*/
         options.add_bool("RUN_CCTRANSORT", true);
@@ -2219,6 +2408,13 @@ int read_options(const std::string &name, Options &options, bool suppress_printi
         options.add_double("R_CONVERGENCE", 1e-7);
         /*- Do use DIIS extrapolation to accelerate convergence? -*/
         options.add_bool("DIIS", 1);
+        /*- Maximum number of perturbed wave functions (perturbation and frequency
+        pairs) iterated together.  Each iteration then reads the <ab|cd> integrals
+        once for the whole batch.  Polarizabilities at several frequencies are
+        batched across frequencies, at the cost of keeping all of their perturbed
+        amplitudes on disk at once.  Zero batches everything a property needs;
+        one solves the equations one at a time. -*/
+        options.add_int("RESPONSE_BATCH_SIZE", 0);
         /*- The response property desired.  Acceptable values are ``POLARIZABILITY``
         (default) for dipole polarizabilities, ``ROTATION`` for specific rotations,
         ``ROA`` for Raman Optical Activity (``ROA_TENSOR`` for each displacement),
@@ -2369,19 +2565,34 @@ int read_options(const std::string &name, Options &options, bool suppress_printi
         options.add_bool("RESTART", 1);
         /*- Do restart the coupled-cluster iterations even if MO phases are screwed up? !expert -*/
         options.add_bool("FORCE_RESTART", 0);
+        /*- Number of iterations between checkpoints of the CC iterations.
+        Each checkpoint writes the $t@@1$ and $t@@2$ amplitudes, the DIIS
+        subspace and the iteration count to the file
+        ``<prefix>.ccchk`` in the working directory, replacing the previous
+        one atomically.  Zero disables checkpointing. -*/
+        options.add_int("AMPS_CHECKPOINT_FREQ", 0);
+        /*- Do restart the CC iterations from the checkpoint file written by
+        |ccenergy__amps_checkpoint_freq|?  The checkpoint is ignored if it does
+        not match the dimensions of the current calculation. -*/
+        options.add_bool("AMPS_CHECKPOINT_RESTART", false);
         //#warning CCEnergy ao_basis keyword type was changed.
         /*- The algorithm to use for the $\left\langle VV||VV\right\rangle$ terms
         If AO_BASIS is ``NONE``, the MO-basis integrals will be used;
         if AO_BASIS is ``DISK``, the AO-basis integrals stored on disk will
         be used; if AO_BASIS is ``DIRECT``, the AO-basis integrals will be computed
-        on the fly as necessary.  NB: The ``DIRECT`` option is not fully
-        implemented and should only be used by experts.  Default is NONE.
+        on the fly (threaded) and the four-virtual-index integrals are never
+        formed, which removes their disk and I/O cost.  ``DIRECT`` is available
+        for RHF CCSD and CCSD(T) energies only.  Default is NONE.
         Note: The developers recommend use of this keyword only as a last
         resort because it significantly slows the calculation. The current
         algorithms for handling the MO-basis four-virtual-index integrals have
         been significantly improved and are preferable to the AO-based approach.
         !expert -*/
         options.add_str("AO_BASIS", "NONE", "NONE DISK DIRECT");
+        /*- Number of batches of occupied pairs for the AO_BASIS = ``DIRECT``
+        ladder term.  The SO integrals are recomputed once per batch.  Zero
+        chooses the fewest batches that fit in the available memory. !expert -*/
+        options.add_int("AO_DIRECT_NBATCH", 0);
         /*- Caching level for libdpd governing the storage of amplitudes,
         integrals, and intermediates in the CC procedure. A value of 0 retains
         no quantities in cache, while a level of 6 attempts to store all
@@ -2394,8 +2605,11 @@ int read_options(const std::string &name, Options &options, bool suppress_printi
         cache used by the libdpd codes. A value of ``LOW`` selects a "low priority"
         scheme in which the deletion of items from the cache is based on
         pre-programmed priorities. A value of LRU selects a "least recently used"
-        scheme in which the oldest item in the cache will be the first one deleted. -*/
-        options.add_str("CACHETYPE", "LOW", "LOW LRU");
+        scheme in which the oldest item in the cache will be the first one deleted.
+        A value of ``ADAPTIVE`` records how often each item is used and how long
+        it takes to re-read during the first iteration, and afterwards deletes
+        the item with the least disk time saved per byte of cache first. -*/
+        options.add_str("CACHETYPE", "LOW", "LOW LRU ADAPTIVE");
         /*- Number of threads -*/
         options.add_int("CC_NUM_THREADS", 1);
         /*- Do use DIIS extrapolation to accelerate convergence? -*/
@@ -2470,6 +2684,15 @@ int read_options(const std::string &name, Options &options, bool suppress_printi
         /*- Auxiliary basis set for MP2 density fitting computations.
         :ref:`Defaults <apdx:basisFamily>` to a RI basis. -*/
         options.add_str("DF_BASIS_MP2", "");
+        /*- Complementary auxiliary basis set for MP2-F12. The RI space is the union
+        of this and the orbital basis. Defaults to the OptRI set of a cc-pVXZ-F12
+        orbital basis. -*/
+        options.add_str("CABS_BASIS", "");
+        /*- Exponent of the Slater geminal in MP2-F12 -*/
+        options.add_double("F12_BETA", 1.0);
+        /*- Linear-dependency tolerance when orthogonalizing the RI space and
+        projecting the orbital basis out of it to obtain the CABS -*/
+        options.add_double("CABS_LINDEP_TOLERANCE", 1.0E-8);
         /*- OS Scale -*/
         options.add_double("MP2_OS_SCALE", 6.0 / 5.0);
         /*- SS Scale  -*/
@@ -2490,6 +2713,16 @@ int read_options(const std::string &name, Options &options, bool suppress_printi
         options.add_bool("OPDM_RELAX", true);
         /*- Do compute one-particle density matrix? -*/
         options.add_bool("ONEPDM", false);
+        /*- Do compute only the opposite-spin energy, in O(N^4) through a Laplace
+        factorization of the denominator? The same-spin term is not formed, so
+        the energy reported is the spin-component-scaled one with
+        |MP2_OS_SCALE| (1.3 for SOS-MP2). RHF energies only. -*/
+        options.add_bool("DFMP2_LAPLACE", false);
+        /*- Denominator factorization for |dfmp2__dfmp2_laplace|. -*/
+        options.add_str("DFMP2_DENOMINATOR_ALGORITHM", "LAPLACE", "LAPLACE CHOLESKY");
+        /*- Maximum error allowed (Max error norm in Delta tensor) in the
+        denominator factorization for |dfmp2__dfmp2_laplace|. -*/
+        options.add_double("DFMP2_DENOMINATOR_DELTA", 1.0E-6);
     }
     if (name == "DFEP2" || options.read_globals()) {
         /*- MODULEDESCRIPTION Performs density-fitted EP2 computations for RHF reference wavefunctions. -*/
@@ -2523,6 +2756,10 @@ int read_options(const std::string &name, Options &options, bool suppress_printi
         options.add_double("LOCAL_CONVERGENCE", 1.0E-12);
         /*- Maximum iterations in Foster-Boys localization -*/
         options.add_int("LOCAL_MAXITER", 1000);
+        /*- Run each Boys or Pipek-Mezey Jacobi sweep as round-robin rounds of disjoint orbital pairs,
+        threaded within each round. The result does not depend on the thread count, but follows a different
+        rotation order than the default sequential sweep. -*/
+        options.add_bool("LOCAL_PARALLEL_SWEEP", false);
         /*- Energy convergence criteria for local MP2 iterations -*/
         options.add_double("E_CONVERGENCE", 1e-6);
         /*- Residual convergence criteria for local MP2 iterations -*/
@@ -2573,7 +2810,7 @@ int read_options(const std::string &name, Options &options, bool suppress_printi
         options.add_double("DAMPING_PERCENTAGE", 0.0);
         /*- Maximum number of error vectors stored for DIIS extrapolation -*/
         options.add_int("DIIS_MAX_VECS", 7);
-        /*- Number of threads -*/
+        /*- Number of threads. In a fully in-core computation, independent tensor operations run concurrently on this many threads -*/
         options.add_int("CC_NUM_THREADS", 1);
         /*- Which root of the effective hamiltonian is the target state? -*/
         options.add_int("FOLLOW_ROOT", 1);
@@ -3045,6 +3282,8 @@ int read_options(const std::string &name, Options &options, bool suppress_printi
         options.add_int("PCG_MAXITER", 50);
         /*- Number of vectors used in orbital DIIS -*/
         options.add_int("MO_DIIS_NUM_VECS", 6);
+        /*- Number of step/gradient pairs kept by the LBFGS orbital step (|dfocc__hess_type| LBFGS) -*/
+        options.add_int("MO_LBFGS_NUM_VECS", 8);
         /*- Minimum number of vectors used in amplitude DIIS -*/
         options.add_int("CC_DIIS_MIN_VECS", 2);
         /*- Maximum number of vectors used in amplitude DIIS -*/
@@ -3114,8 +3353,10 @@ int read_options(const std::string &name, Options &options, bool suppress_printi
           option does not create the MO Hessian explicitly, instead it solves the simultaneous equations iteratively
           with the preconditioned conjugate gradient method. -*/
         options.add_str("ORB_RESP_SOLVER", "PCG", "PCG LINEQ");
-        /*- Type of the MO Hessian matrix -*/
-        options.add_str("HESS_TYPE", "HF", "APPROX_DIAG APPROX_DIAG_EKT APPROX_DIAG_HF HF");
+        /*- Type of the MO Hessian matrix. LBFGS builds a limited-memory quasi-Newton inverse Hessian from
+          the previous orbital steps and gradients on top of APPROX_DIAG_HF, so no orbital-response equations
+          are solved. -*/
+        options.add_str("HESS_TYPE", "HF", "APPROX_DIAG APPROX_DIAG_EKT APPROX_DIAG_HF HF LBFGS");
         /*- Type of the SCS method -*/
         options.add_str("SCS_TYPE", "SCS", "SCS SCSN SCSVDW SCSMI");
         /*- Type of the SOS method -*/
@@ -3136,7 +3377,9 @@ int read_options(const std::string &name, Options &options, bool suppress_printi
         options.add_str("MP2_AMP_TYPE", "DIRECT", "DIRECT CONV");
         /*- Type of the CCSD PPL term. -*/
         options.add_str("PPL_TYPE", "AUTO", "LOW_MEM HIGH_MEM CD AUTO");
-        /*- The algorithm to handle (ia|bc) type integrals that used for (T) correction. -*/
+        /*- The algorithm to handle (ia|bc) type integrals that used for (T) correction. For UHF references, DIRECT
+        assembles them on the fly from B(Q|ab) rather than writing them to disk, and INCORE and DISK use the disk
+        algorithm. -*/
         options.add_str("TRIPLES_IABC_TYPE", "DISK", "INCORE AUTO DIRECT DISK");
 
         /*- Do compute natural orbitals? -*/
@@ -3325,6 +3568,11 @@ int read_options(const std::string &name, Options &options, bool suppress_printi
         options.add_str("DF_BASIS_CC", "");
         /*- tolerance for Cholesky decomposition of the ERI tensor -*/
         options.add_double("CHOLESKY_TOLERANCE", 1.0e-4);
+        /*- Do keep the 3-index integrals and the doubles residual in core
+        during DF/CD-CCSD iterations?  Needs room for the AO-basis 3-index
+        integrals and one extra copy of the doubles amplitudes; otherwise
+        the disk-based algorithm is used. -*/
+        options.add_bool("DFCC_INCORE", false);
 
         /*- Is this a CEPA job? This parameter is used internally
         by the pythond driver.  Changing its value won't have any
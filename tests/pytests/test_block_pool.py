@@ -0,0 +1,64 @@
+import pytest
+
+import psi4
+
+pytestmark = [pytest.mark.psi, pytest.mark.api, pytest.mark.quick]
+
+
+@pytest.fixture
+def block_pool():
+    psi4.set_memory("500 MiB")
+    psi4.core.set_block_pool_limit(0)
+    yield
+    psi4.core.set_block_pool_limit(0)
+
+
+def test_block_pool_off_by_default(block_pool):
+    m = psi4.core.Matrix(100, 100)
+    del m
+    assert psi4.core.get_block_pool_limit() == 0
+    assert psi4.core.get_block_pool_cached() == 0
+
+
+def test_block_pool_reuse(block_pool):
+    assert psi4.core.set_block_pool_limit(10 * 1024 * 1024) == 10 * 1024 * 1024
+
+    m = psi4.core.Matrix(100, 100)
+    del m
+    cached = psi4.core.get_block_pool_cached()
+    assert cached >= 100 * 100 * 8
+
+    # A block of the same size class is handed out again, and comes back zeroed
+    m = psi4.core.Matrix(100, 100)
+    assert psi4.core.get_block_pool_cached() == 0
+    assert m.rms() == 0.0
+    del m
+
+    v = psi4.core.Vector(1000)
+    del v
+    assert psi4.core.get_block_pool_cached() > cached
+
+
+def test_block_pool_cap(block_pool):
+    psi4.core.set_block_pool_limit(1024 * 1024)
+
+    # 2 MB does not fit under the 1 MiB cap and goes straight back to the system
+    m = psi4.core.Matrix(500, 500)
+    del m
+    assert psi4.core.get_block_pool_cached() == 0
+
+    small = [psi4.core.Matrix(100, 100) for _ in range(20)]
+    del small
+    assert 0 < psi4.core.get_block_pool_cached() <= 1024 * 1024
+
+
+def test_block_pool_clean(block_pool):
+    psi4.core.set_block_pool_limit(10 * 1024 * 1024)
+
+    m = psi4.core.Matrix(100, 100)
+    del m
+    assert psi4.core.get_block_pool_cached() > 0
+
+    psi4.core.clean()
+    assert psi4.core.get_block_pool_cached() == 0
+    assert psi4.core.get_block_pool_limit() == 10 * 1024 * 1024
@@ -0,0 +1,83 @@
+import numpy as np
+import pytest
+
+import psi4
+
+pytestmark = [pytest.mark.psi, pytest.mark.api, pytest.mark.quick]
+
+_second = ["PHI_XX", "PHI_XY", "PHI_XZ", "PHI_YY", "PHI_YZ", "PHI_ZZ"]
+
+# third derivative block -> (second derivative block, direction it is differentiated along)
+_third = {
+    "PHI_XXX": ("PHI_XX", 0),
+    "PHI_XXY": ("PHI_XX", 1),
+    "PHI_XXZ": ("PHI_XX", 2),
+    "PHI_XYY": ("PHI_XY", 1),
+    "PHI_XYZ": ("PHI_XY", 2),
+    "PHI_XZZ": ("PHI_XZ", 2),
+    "PHI_YYY": ("PHI_YY", 1),
+    "PHI_YYZ": ("PHI_YY", 2),
+    "PHI_YZZ": ("PHI_YZ", 2),
+    "PHI_ZZZ": ("PHI_ZZ", 2),
+}
+
+
+def _points(mol, npoints):
+    """Random points around the molecule, at least 0.5 bohr away from every nucleus"""
+    rng = np.random.default_rng(1234)
+    geom = np.array(mol.geometry())
+    points = []
+    while len(points) < npoints:
+        p = rng.uniform(geom.min(axis=0) - 2.0, geom.max(axis=0) + 2.0)
+        if np.min(np.linalg.norm(geom - p, axis=1)) > 0.5:
+            points.append(p)
+    return np.array(points)
+
+
+def _collocation(basis, points, deriv):
+    npoints = points.shape[0]
+    extents = psi4.core.BasisExtents(basis, 0.0)
+    block = psi4.core.BlockOPoints(*(psi4.core.Vector.from_array(v) for v in (*points.T, np.ones(npoints))), extents)
+    funcs = psi4.core.BasisFunctions(basis, npoints, basis.nbf())
+    funcs.set_deriv(deriv)
+    funcs.compute_functions(block)
+    return {k: np.array(v)[:npoints, :basis.nbf()] for k, v in funcs.basis_values().items()}
+
+
+@pytest.mark.parametrize("basis_name, puream", [
+    pytest.param("cc-pvdz", True, id="spherical"),
+    pytest.param("6-31g**", False, id="cartesian"),
+])
+def test_collocation_deriv3(basis_name, puream):
+    mol = psi4.geometry("""
+    0 1
+    O
+    H 1 0.96
+    H 1 0.96 2 104.5
+    symmetry c1
+    """)
+    psi4.set_options({"basis": basis_name, "puream": puream})
+    basis = psi4.core.BasisSet.build(mol, "ORBITAL", basis_name, puream=puream)
+
+    points = _points(mol, 40)
+    deriv2 = _collocation(basis, points, 2)
+    deriv3 = _collocation(basis, points, 3)
+
+    # compute_phi and the lower blocks of a third-derivative collocation match the existing paths
+    phi = np.array([basis.compute_phi(*p) for p in points])
+    assert psi4.compare_values(phi, deriv2["PHI"], 12, "compute_phi vs BasisFunctions values")
+    for key in deriv2:
+        assert psi4.compare_values(deriv2[key], deriv3[key], 12, f"{key} at deriv 3 vs deriv 2")
+
+    # third derivatives are the derivatives of the Hessian blocks, by central differences
+    h = 1.e-4
+    shifted = {}
+    for xyz in range(3):
+        step = np.zeros(3)
+        step[xyz] = h
+        plus = _collocation(basis, points + step, 2)
+        minus = _collocation(basis, points - step, 2)
+        shifted[xyz] = {k: (plus[k] - minus[k]) / (2 * h) for k in _second}
+
+    for key, (hessian, xyz) in _third.items():
+        assert np.allclose(shifted[xyz][hessian], deriv3[key], rtol=1.e-5, atol=1.e-7), f"{key} vs finite difference"
@@ -0,0 +1,33 @@
+import pytest
+
+from utils import *
+
+import psi4
+
+pytestmark = [pytest.mark.psi, pytest.mark.api, pytest.mark.quick, pytest.mark.dfocc]
+
+
+@pytest.fixture
+def nh2():
+    return psi4.geometry(
+        """
+        0 2
+        N
+        H 1 1.013
+        H 1 1.013 2 103.2
+        """
+    )
+
+
+@pytest.mark.parametrize("name", ["omp2", "omp3"])
+def test_dfocc_lbfgs_orbital_step(nh2, name):
+    """L-BFGS orbital steps converge to the same orbital-optimized energy"""
+
+    psi4.set_options({"reference": "uhf", "basis": "cc-pvdz", "scf_type": "df", "mp_type": "df", "qc_module": "occ",
+                      "e_convergence": 10, "r_convergence": 8, "hess_type": "approx_diag"})
+    ref = psi4.energy(name)
+
+    psi4.set_options({"hess_type": "lbfgs"})
+    ene = psi4.energy(name)
+
+    assert compare_values(ref, ene, 8, f"lbfgs vs approx_diag {name}")
@@ -0,0 +1,33 @@
+import pytest
+
+from utils import *
+
+import psi4
+
+pytestmark = [pytest.mark.psi, pytest.mark.api, pytest.mark.quick, pytest.mark.dfocc]
+
+
+@pytest.fixture
+def nh2():
+    return psi4.geometry(
+        """
+        0 2
+        N
+        H 1 1.013
+        H 1 1.013 2 103.2
+        """
+    )
+
+
+@pytest.mark.parametrize("name", ["ccsd(t)", "a-ccsd(t)"])
+def test_dfocc_uhf_triples_direct(nh2, name):
+    """On-the-fly (ia|bc) for UHF (T) and (AT) matches the disk algorithm"""
+
+    psi4.set_options({"reference": "uhf", "basis": "cc-pvdz", "scf_type": "df", "cc_type": "df", "qc_module": "occ",
+                      "freeze_core": True, "e_convergence": 10, "r_convergence": 9, "triples_iabc_type": "disk"})
+    ref = psi4.energy(name)
+
+    psi4.set_options({"triples_iabc_type": "direct"})
+    ene = psi4.energy(name)
+
+    assert compare_values(ref, ene, 9, f"direct vs disk {name}")
@@ -156,3 +156,26 @@ def test_dft_block_scheme_distantpoints():
             P = psi4.variable("XC GRID TOTAL POINTS")
             XC = wfn.variable("DFT XC ENERGY")
             assert psi4.compare_integers(ref[f"{YN}"], P, f" scheme={S}; distant points={YN} ")
+
+
+@pytest.mark.parametrize("reference", ["RKS", "UKS"])
+def test_dft_incremental_xc(reference):
+    """Reusing the XC contributions of settled grid blocks must converge to the full-build energy."""
+
+    mol = psi4.geometry(
+        """
+    0 1
+    O 0.000000000000  0.000000000000 -0.068516219310
+    H 0.000000000000 -0.790689573744  0.543701060724
+    H 0.000000000000  0.790689573744  0.543701060724
+    symmetry c1
+    """
+    )
+    psi4.set_options({"BASIS": "def2-SVP", "REFERENCE": reference, "D_CONVERGENCE": 1e-8})
+
+    ref = psi4.energy("B3LYP")
+
+    psi4.set_options({"DFT_INCREMENTAL_XC_CUTOFF": 1.0e-6})
+    e = psi4.energy("B3LYP")
+
+    assert psi4.compare_values(ref, e, 8, f"{reference} incremental XC energy")
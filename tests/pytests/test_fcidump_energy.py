@@ -50,3 +50,29 @@ def test_fcidump_mp2_energy():
     fcidump_e = e_dict['SCF TOTAL ENERGY'] + e_dict['MP2 CORRELATION ENERGY']
 
     assert psi4.compare_values(mp2_e, fcidump_e, 5, 'MP2 energy')
+
+
+def test_fcidump_binary_tei():
+    """Compare binary FCIDUMP two-electron integrals against the text FCIDUMP"""
+
+    Ne = psi4.geometry("""
+      Ne 0 0 0
+    """)
+
+    psi4.set_options({'basis': 'cc-pVDZ',
+                      'scf_type': 'pk',
+                      'reference': 'rhf',
+                      'd_convergence': 1e-8,
+                      'e_convergence': 1e-8
+                     })
+    scf_e, scf_wfn = psi4.energy('scf', return_wfn=True)
+
+    psi4.fcidump(scf_wfn, fname='FCIDUMP_TEXT', oe_ints=['EIGENVALUES'])
+    psi4.fcidump(scf_wfn, fname='FCIDUMP_BIN', oe_ints=['EIGENVALUES'], binary=True)
+    text = psi4.fcidump_from_file('FCIDUMP_TEXT')
+    binary = psi4.fcidump_from_file('FCIDUMP_BIN', binary=True)
+
+    assert psi4.compare_arrays(text['eri'], binary['eri'], 12, 'binary ERI')
+    assert psi4.compare_arrays(text['hcore'], binary['hcore'], 12, 'binary Hcore')
+    e_dict = psi4.energies_from_fcidump(binary)
+    assert psi4.compare_values(scf_e, e_dict['SCF TOTAL ENERGY'], 5, 'SCF energy')
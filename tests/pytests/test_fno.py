@@ -0,0 +1,57 @@
+import pytest
+
+from utils import *
+
+import psi4
+
+pytestmark = [pytest.mark.psi, pytest.mark.api, pytest.mark.quick, pytest.mark.fnocc]
+
+
+@pytest.fixture
+def h2o():
+    return psi4.geometry(
+        """
+        O
+        H 1 1.0
+        H 1 1.0 2 104.5
+        """
+    )
+
+
+def test_fno_ccenergy_all_orbitals(h2o):
+    """Keeping every natural orbital reproduces the plain CCSD energy"""
+
+    psi4.set_options({"basis": "cc-pvdz", "scf_type": "pk", "freeze_core": True, "e_convergence": 10,
+                      "r_convergence": 9, "qc_module": "ccenergy"})
+    ref = psi4.energy("ccsd")
+
+    psi4.set_options({"frozen_nat_orbs": True, "active_nat_orbs": [8, 2, 3, 6]})
+    ene, wfn = psi4.energy("ccsd", return_wfn=True)
+
+    assert compare_values(0.0, wfn.variable("MP2 FNO CORRECTION ENERGY"), 9, "no correction")
+    assert compare_values(ref, ene, 8, "fno-ccsd, no truncation")
+
+
+def test_fno_ccenergy_truncated(h2o):
+    """The MP2 correction for the discarded virtuals is carried by every correlated energy"""
+
+    psi4.set_options({"basis": "cc-pvdz", "scf_type": "pk", "freeze_core": True, "e_convergence": 10,
+                      "r_convergence": 9, "qc_module": "ccenergy"})
+    ref = psi4.energy("ccsd(t)")
+
+    psi4.set_options({"frozen_nat_orbs": True, "occ_tolerance": 1.0e-4})
+    ene, wfn = psi4.energy("ccsd(t)", return_wfn=True)
+
+    delta = wfn.variable("MP2 FNO CORRECTION ENERGY")
+    assert delta < 0.0, "correction sign"
+    assert compare_values(ref, ene, 2, "fno-ccsd(t) vs ccsd(t)")
+    assert compare_values(wfn.variable("SCF TOTAL ENERGY") + wfn.variable("CCSD(T) CORRELATION ENERGY"), ene, 8,
+                          "total")
+    assert compare_values(ene, psi4.variable("CURRENT ENERGY"), 8, "current")
+
+
+def test_fno_requires_energy(h2o):
+    psi4.set_options({"basis": "cc-pvdz", "frozen_nat_orbs": True, "qc_module": "ccenergy"})
+
+    with pytest.raises(psi4.ValidationError):
+        psi4.gradient("ccsd")
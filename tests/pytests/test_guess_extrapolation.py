@@ -0,0 +1,57 @@
+import pytest
+
+import psi4
+from psi4.driver.procrouting.scf_proc import guess_extrapolation
+
+pytestmark = [pytest.mark.psi, pytest.mark.api, pytest.mark.scf]
+
+
+@pytest.mark.parametrize("npoints, expected", [
+    pytest.param(2, [2.0, -1.0], id="K0"),
+    pytest.param(3, [2.5, -2.0, 0.5], id="K1"),
+    pytest.param(4, [2.8, -2.8, 1.2, -0.2], id="K2"),
+])
+def test_aspc_coefficients(npoints, expected):
+    """Kolafa's predictor coefficients, J. Comput. Chem. 25, 335 (2004), Table I"""
+    computed = guess_extrapolation.aspc_coefficients(npoints)
+    assert psi4.compare_values(expected, computed, 12, f"ASPC B_j, {npoints} points")
+
+
+@pytest.mark.parametrize("reference", ["rhf", "uhf"])
+def test_aspc_trajectory(reference):
+    """ASPC guesses along a bond stretch reach the same energies in fewer iterations than SAD"""
+    h2o = psi4.geometry("""
+    0 1
+    O
+    H 1 R
+    H 1 R 2 104.5
+    """)
+    distances = [0.950, 0.955, 0.960, 0.965, 0.970]
+
+    psi4.set_options({
+        "basis": "cc-pvdz",
+        "reference": reference,
+        "scf_type": "pk",
+        "e_convergence": 1.e-10,
+        "d_convergence": 1.e-8,
+    })
+
+    def trajectory():
+        energies, iterations = [], []
+        for R in distances:
+            h2o.R = R
+            e, wfn = psi4.energy("scf", molecule=h2o, return_wfn=True)
+            energies.append(e)
+            iterations.append(int(wfn.variable("SCF ITERATIONS")))
+        return energies, iterations
+
+    e_sad, it_sad = trajectory()
+
+    guess_extrapolation.reset()
+    psi4.set_options({"guess_extrapolation": "aspc", "guess_extrapolation_order": 1})
+    e_aspc, it_aspc = trajectory()
+    guess_extrapolation.reset()
+
+    assert psi4.compare_values(e_sad, e_aspc, 8, f"{reference.upper()} energies with ASPC guesses")
+    # from the fourth point on, the full K = 1 history of three solutions is used
+    assert all(a < s for a, s in zip(it_aspc[3:], it_sad[3:])), f"ASPC {it_aspc} vs SAD {it_sad} iterations"
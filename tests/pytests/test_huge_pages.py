@@ -0,0 +1,41 @@
+import pytest
+
+import psi4
+
+pytestmark = [pytest.mark.psi, pytest.mark.api]
+
+
+def test_huge_page_threshold():
+    assert psi4.core.get_huge_page_threshold() == 0, "huge pages must be off by default"
+    psi4.core.set_huge_page_threshold(2 * 1024 * 1024)
+    assert psi4.core.get_huge_page_threshold() == 2 * 1024 * 1024
+    psi4.core.set_huge_page_threshold(0)
+    assert psi4.core.get_huge_page_threshold() == 0
+
+
+@pytest.mark.parametrize("method, options", [
+    pytest.param("scf", {"scf_type": "mem_df"}, id="dfhelper"),
+    pytest.param("mp2", {"scf_type": "df", "mp2_type": "df", "qc_module": "occ"}, id="dfocc"),
+    pytest.param("ccsd", {"scf_type": "pk"}, id="dpd"),
+])
+def test_huge_pages_energy(method, options):
+    """Energies with huge-page advice on every large buffer are those of the default run"""
+    h2o = psi4.geometry("""
+    0 1
+    O
+    H 1 0.96
+    H 1 0.96 2 104.5
+    """)
+    psi4.set_options({"basis": "cc-pvtz", "e_convergence": 1.e-10, "d_convergence": 1.e-9, "r_convergence": 1.e-9,
+                      **options})
+
+    e_ref = psi4.energy(method, molecule=h2o)
+
+    # 64 KiB advises nearly every Matrix, block_matrix, DPD and DFHelper buffer of this job
+    psi4.core.set_huge_page_threshold(64 * 1024)
+    try:
+        e_huge = psi4.energy(method, molecule=h2o)
+    finally:
+        psi4.core.set_huge_page_threshold(0)
+
+    assert psi4.compare_values(e_ref, e_huge, 10, f"{method} energy with huge pages")
@@ -267,6 +267,23 @@ def test_back_transform():
     assert compare_arrays(transformer.nph[0] @ original.nph[0] @ (transformer.nph[1]).T, transformed.nph[0]) 
     assert compare_arrays(transformer.nph[1] @ original.nph[1] @ (transformer.nph[0]).T, transformed.nph[1])
 
+def test_axpby():
+    dim = Dimension([3, 2])
+    x = build_random_mat(dim, dim)
+    y = build_random_mat(dim, dim)
+    expected = [0.5 * x.nph[h] - 2.0 * y.nph[h] for h in range(dim.n())]
+    y.axpby(0.5, x, -2.0)
+    for h in range(dim.n()):
+        assert compare_arrays(expected[h], y.nph[h])
+
+def test_antisymmetrize():
+    dim = Dimension([3, 2])
+    mat = build_random_mat(dim, dim)
+    expected = [mat.nph[h] - mat.nph[h].T for h in range(dim.n())]
+    mat.antisymmetrize()
+    for h in range(dim.n()):
+        assert compare_arrays(expected[h], mat.nph[h])
+
 def test_get_matrix():
     # Use get_matrix to extract a block of a non-totally symmetric matrix.
     dim = Dimension([3, 2])
@@ -335,3 +352,42 @@ def test_transpose():
             transposed_mat.set(0, k, j, i)
             i += 1
     assert psi4.compare_matrices(mat.transpose(), transposed_mat)
+
+@pytest.mark.parametrize("algorithm", [psi4.core.DiagonalizeAlgorithm.DSYEV, psi4.core.DiagonalizeAlgorithm.DSYEVD,
+                                       psi4.core.DiagonalizeAlgorithm.DSYEVR])
+@pytest.mark.parametrize("order", [psi4.core.DiagonalizeOrder.Ascending, psi4.core.DiagonalizeOrder.Descending])
+def test_diagonalize_algorithms(algorithm, order):
+    dim = Dimension([6, 4])
+    mat = Matrix("Symmetric", dim, dim)
+    for h in range(dim.n()):
+        a = np.random.randn(dim[h], dim[h])
+        mat.nph[h][:, :] = a + a.T
+    evecs = Matrix("Eigenvectors", dim, dim)
+    evals = psi4.core.Vector("Eigenvalues", dim)
+    mat.diagonalize(evecs, evals, order, algorithm)
+    for h in range(dim.n()):
+        ref = np.linalg.eigvalsh(mat.nph[h])
+        if order == psi4.core.DiagonalizeOrder.Descending:
+            ref = ref[::-1]
+        assert np.allclose(evals.nph[h], ref)
+        assert np.allclose(mat.nph[h] @ evecs.nph[h], evecs.nph[h] * evals.nph[h])
+
+
+def test_diagonalize_partial():
+    dim = Dimension([7, 5])
+    mat = Matrix("Symmetric", dim, dim)
+    for h in range(dim.n()):
+        a = np.random.randn(dim[h], dim[h])
+        mat.nph[h][:, :] = a + a.T
+
+    evecs, evals = mat.diagonalize_lowest(Dimension([3, 2]))
+    for h, k in enumerate([3, 2]):
+        ref = np.linalg.eigvalsh(mat.nph[h])
+        assert np.allclose(evals.nph[h], ref[:k])
+        assert np.allclose(mat.nph[h] @ evecs.nph[h], evecs.nph[h] * evals.nph[h])
+
+    evecs, evals = mat.diagonalize_range(0.0, 1.0e10)
+    for h in range(dim.n()):
+        ref = np.linalg.eigvalsh(mat.nph[h])
+        assert np.allclose(evals.nph[h], ref[ref > 0.0])
+        assert np.allclose(mat.nph[h] @ evecs.nph[h], evecs.nph[h] * evals.nph[h])
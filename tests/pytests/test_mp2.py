@@ -125,3 +125,25 @@ def test_scsmp2(inp):
 
     assert compare_values(ref_tot, ene, 5, "return")
     assert compare_values(ref_tot, wfn.energy(), 5, "wfn")
+
+
+@pytest.mark.dfmp2
+def test_dfmp2f12():
+    h2o = psi4.geometry(
+        """
+        O
+        H 1 1.0
+        H 1 1.0 2 104.5
+        symmetry c1
+        """
+    )
+
+    psi4.set_options({"basis": "cc-pvdz-f12", "freeze_core": True, "scf_type": "df", "mp2_type": "df"})
+    ene, wfn = psi4.energy("mp2-f12", return_wfn=True)
+
+    mp2_corl = wfn.variable("MP2 CORRELATION ENERGY")
+    f12_corr = wfn.variable("MP2-F12 CORRECTION ENERGY")
+    assert -0.1 < f12_corr < -0.01, "F12 correction out of range"
+    assert compare_values(mp2_corl + f12_corr, wfn.variable("MP2-F12 CORRELATION ENERGY"), 8, "mp2-f12 corl")
+    assert compare_values(wfn.variable("HF TOTAL ENERGY") + mp2_corl + f12_corr, ene, 8, "mp2-f12 total")
+    assert compare_values(ene, psi4.variable("CURRENT ENERGY"), 8, "current")
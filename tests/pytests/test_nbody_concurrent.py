@@ -0,0 +1,41 @@
+import pytest
+
+import psi4
+import qcengine as qcng
+
+pytestmark = [pytest.mark.psi, pytest.mark.api, pytest.mark.nbody]
+
+
+@pytest.mark.skipif(not qcng.get_program("psi4").found(raise_error=False),
+                    reason="concurrent n-body tasks run in psi4 subprocesses")
+@pytest.mark.parametrize("driver", ["energy", "gradient"])
+def test_nbody_concurrent_tasks(driver):
+    """Subsystems run four at a time in subprocesses reproduce the serial n-body results"""
+    eneyne = psi4.geometry("""
+C   0.000000  -0.667578  -2.124659
+C   0.000000   0.667578  -2.124659
+H   0.923621  -1.232253  -2.126185
+H  -0.923621  -1.232253  -2.126185
+H  -0.923621   1.232253  -2.126185
+H   0.923621   1.232253  -2.126185
+--
+C   0.000000   0.000000   2.900503
+C   0.000000   0.000000   1.693240
+H   0.000000   0.000000   0.627352
+H   0.000000   0.000000   3.963929
+""")
+
+    psi4.set_options({"basis": "6-31g", "scf_type": "pk", "e_convergence": 1.e-10, "d_convergence": 1.e-9})
+    kwargs = {"molecule": eneyne, "bsse_type": ["cp", "nocp", "vmfc"], "return_total_data": True}
+
+    serial = getattr(psi4, driver)("scf", **kwargs)
+    serial_vars = {k: psi4.variable(k) for k in ("CP-CORRECTED INTERACTION ENERGY",
+                                                 "NOCP-CORRECTED INTERACTION ENERGY",
+                                                 "VMFC-CORRECTED INTERACTION ENERGY")}
+    psi4.core.clean_variables()
+
+    concurrent = getattr(psi4, driver)("scf", concurrent_tasks=4, **kwargs)
+
+    assert psi4.compare_values(serial, concurrent, 8, f"concurrent n-body {driver}")
+    for label, value in serial_vars.items():
+        assert psi4.compare_values(value, psi4.variable(label), 8, f"concurrent {label}")
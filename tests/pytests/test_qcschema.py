@@ -1,3 +1,4 @@
+import io
 import sys
 import json
 import pprint
@@ -201,3 +202,40 @@ def test_qcschema_wavefunction_scf_occupations_es(result_data_fixture):
     assert compare_arrays(ea, (Ca.T @ Fa @ Ca).diagonal(), 10, "Orbital Consistency")
     assert compare_arrays(Da, Ca_occ @ Ca_occ.T, 10, "Occupied Orbital Consistency")
 
+
+
+def test_qcschema_worker(result_data_fixture):
+    result_data_fixture["model"]["method"] = "SCF"
+    instream = io.StringIO(json.dumps(result_data_fixture) + "\n\nnot json\n" + json.dumps(result_data_fixture) + "\n")
+    outstream = io.StringIO()
+
+    njobs = psi4.schema_wrapper.run_qcschema_worker(instream, outstream)
+    rets = [json.loads(line) for line in outstream.getvalue().splitlines()]
+
+    assert compare_integers(3, njobs, "Jobs Processed")
+    assert compare_integers(3, len(rets), "Results Written")
+    assert compare_integers(True, rets[0]["success"], "First Job Status")
+    assert compare_integers(False, rets[1]["success"], "Malformed Job Status")
+    assert compare_integers(True, rets[2]["success"], "Second Job Status")
+    assert compare_values(rets[0]["return_result"], rets[2]["return_result"], 8, "Repeated Job Energy")
+
+
+def test_qcschema_batch(result_data_fixture):
+    result_data_fixture["model"]["method"] = "SCF"
+    h2 = {
+        "molecule": {"geometry": [0.0, 0.0, 0.0, 0.0, 0.0, 1.4], "symbols": ["H", "H"]},
+        "driver": "energy",
+        "model": {"method": "SCF", "basis": "cc-pVDZ"},
+        "keywords": {"scf_type": "df"},
+    }
+
+    psi4.set_num_threads(2)
+    rets = psi4.schema_wrapper.run_qcschema_batch([result_data_fixture, h2, {"driver": "energy"}, h2], nworkers=2)
+
+    assert compare_integers(4, len(rets), "Results Returned")
+    assert compare_integers(True, rets[0].success, "Water Status")
+    assert compare_integers(True, rets[1].success, "H2 Status")
+    assert compare_integers(False, rets[2].success, "Malformed Job Status")
+    serial = psi4.schema_wrapper.run_qcschema(result_data_fixture)
+    assert compare_values(serial.return_result, rets[0].return_result, 8, "Water Energy")
+    assert compare_values(rets[1].return_result, rets[3].return_result, 8, "Repeated H2 Energy")
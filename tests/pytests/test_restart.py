@@ -34,6 +34,30 @@ def test_serialize_wfn():
     assert psi4.compare_wavefunctions(scf_wfn, wfn_new2, label='Serialization Check(dict)')
 
 
+def test_serialize_wfn_npz():
+    """wfn serialization to a compressed archive"""
+
+    h2o = psi4.geometry("""
+      O
+      H 1 0.96
+      H 1 0.96 2 104.5
+    """)
+
+    psi4.set_options({'basis': "cc-pVDZ"})
+    _, scf_wfn = psi4.energy('scf', return_wfn=True)
+
+    scf_wfn.to_file('pytest_wfn_archive', compress=True)
+    assert isfile("pytest_wfn_archive.npz")
+
+    wfn_new = psi4.core.Wavefunction.from_file('pytest_wfn_archive')
+    assert psi4.compare_wavefunctions(scf_wfn, wfn_new, label='Serialization Check(npz)')
+
+    psi4.core.clean()
+    psi4.set_options({'maxiter': 1})
+    psi4.energy('scf', restart_file='pytest_wfn_archive.npz')
+    assert psi4.compare_values(-76.0266327341067125, psi4.variable('SCF TOTAL ENERGY'), 6, 'SCF energy')
+
+
 def test_restart_scf_serial_wfn():
     """scf restart from wfn file"""
 
@@ -0,0 +1,46 @@
+import pytest
+
+import psi4
+
+pytestmark = [pytest.mark.psi, pytest.mark.api, pytest.mark.scf]
+
+
+@pytest.mark.parametrize("basis, expected", [
+    pytest.param("cc-pvdz", "PK", id="small"),
+    pytest.param("aug-cc-pvtz", "DIRECT", id="large"),
+])
+def test_scf_auto(basis, expected):
+    h2o = psi4.geometry("""
+    0 1
+    O
+    H 1 0.96
+    H 1 0.96 2 104.5
+    """)
+
+    # 100 MiB holds the cc-pVDZ PK supermatrices (0.7 MiB), but not the aug-cc-pVTZ ones (140 MiB)
+    psi4.set_memory("100 MiB")
+    psi4.set_options({"basis": basis, "scf_type": "auto", "e_convergence": 1.e-10, "d_convergence": 1.e-8})
+
+    wfn = psi4.core.Wavefunction.build(h2o, psi4.core.get_global_option("BASIS"))
+    doubles = psi4.get_memory() // 8
+    assert psi4.core.JK.select_JK_type(wfn.basisset(), False, doubles) == expected
+
+    e_auto = psi4.energy("scf", molecule=h2o)
+    psi4.set_options({"scf_type": expected})
+    e_explicit = psi4.energy("scf", molecule=h2o)
+    assert psi4.compare_values(e_explicit, e_auto, 8, f"SCF_TYPE AUTO ({expected}) energy")
+
+
+def test_scf_auto_respects_subtype():
+    h2o = psi4.geometry("""
+    0 1
+    O
+    H 1 0.96
+    H 1 0.96 2 104.5
+    """)
+
+    psi4.set_memory("100 MiB")
+    psi4.set_options({"basis": "aug-cc-pvtz", "scf_type": "auto", "scf_subtype": "reorder_out_of_core"})
+
+    wfn = psi4.core.Wavefunction.build(h2o, psi4.core.get_global_option("BASIS"))
+    assert psi4.core.JK.select_JK_type(wfn.basisset(), False, psi4.get_memory() // 8) == "PK"
@@ -0,0 +1,54 @@
+import pytest
+
+import psi4
+from psi4.driver.procrouting import scf_compute_states, scf_wavefunction_factory
+
+pytestmark = [pytest.mark.psi, pytest.mark.api, pytest.mark.scf]
+
+
+@pytest.mark.parametrize("scf_type", ["pk", "df"])
+def test_scf_compute_states(scf_type):
+    """UHF, ROHF and UKS states of triplet O2 converged on one JK object match separate SCF runs"""
+    o2 = psi4.geometry("""
+    0 3
+    O
+    O 1 1.2
+    """)
+
+    psi4.set_options({"basis": "cc-pvdz", "scf_type": scf_type, "e_convergence": 1.e-10, "d_convergence": 1.e-8})
+
+    states = [("hf", "UHF"), ("hf", "ROHF"), ("b3lyp", "UKS")]
+
+    expected = []
+    for name, reference in states:
+        psi4.set_options({"reference": reference})
+        expected.append(psi4.energy(name, molecule=o2))
+
+    ref_wfn = psi4.core.Wavefunction.build(o2, psi4.core.get_global_option("BASIS"))
+    wfns = []
+    for name, reference in states:
+        psi4.set_options({"reference": reference})
+        wfns.append(scf_wavefunction_factory(name, ref_wfn, reference))
+
+    energies = scf_compute_states(wfns)
+
+    jk = wfns[0].jk()
+    assert all(wfn.jk() is jk for wfn in wfns[1:]), "JK object not shared between states"
+    for (name, reference), e_ref, e in zip(states, expected, energies):
+        assert psi4.compare_values(e_ref, e, 8, f"{reference} {name} shared-JK energy")
+
+
+def test_scf_compute_states_omega_mismatch():
+    o2 = psi4.geometry("""
+    0 3
+    O
+    O 1 1.2
+    """)
+
+    psi4.set_options({"basis": "cc-pvdz", "scf_type": "pk", "reference": "uks"})
+
+    ref_wfn = psi4.core.Wavefunction.build(o2, psi4.core.get_global_option("BASIS"))
+    wfns = [scf_wavefunction_factory(name, ref_wfn, "UKS") for name in ("b3lyp", "wb97x")]
+
+    with pytest.raises(psi4.ValidationError, match="range-separation"):
+        scf_compute_states(wfns)
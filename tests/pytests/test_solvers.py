@@ -3,6 +3,7 @@ import pytest
 
 import psi4
 from psi4.driver.p4util.solvers import davidson_solver, hamiltonian_solver
+from psi4.driver.procrouting.response.scf_products import ProductCache
 from utils import compare_arrays
 
 pytestmark = [pytest.mark.psi, pytest.mark.api]
@@ -59,6 +60,25 @@ class DSProblemSimulate(SimulateBase):
         return R / (shift - np.diag(self.A))
 
 
+class CachedDSProblemSimulate(DSProblemSimulate):
+    "Caches products like the TDSCF engines, and rotates them on a subspace collapse"
+
+    def __init__(self, size, **kwargs):
+        super().__init__(size, **kwargs)
+        self.product_cache = ProductCache("A")
+
+    def compute_products(self, X):
+        n_old = self.product_cache.count()
+        if (len(X) < n_old) or (len(X) == n_old and not self.product_cache.collapsed):
+            self.product_cache.reset()
+            n_old = 0
+        new = [self.A.dot(x) for x in X[n_old:]]
+        return self.product_cache.add("A", new), len(new)
+
+    def collapse_products(self, coefficients):
+        self.product_cache.collapse(coefficients, self)
+
+
 class HSProblemSimulate(SimulateBase):
     "Provide the interface of an engine, around an actual matrix stored in memory"
 
@@ -111,6 +131,27 @@ def test_davidson_solver_numpy():
     compare_arrays(ref_vectors, np.column_stack(test_vectors), 8, "Davidson eigenvectors")
 
 
+@pytest.mark.unittest
+@pytest.mark.solver
+def test_davidson_solver_collapse_products():
+    BIGDIM = 100
+    nroot = 3
+    guess = list(np.linalg.qr(np.random.randn(BIGDIM, nroot))[0].T)
+    test_engine = CachedDSProblemSimulate(BIGDIM)
+    ret = davidson_solver(engine=test_engine, guess=guess, nroot=nroot, max_ss_size=8, verbose=0, maxiter=100)
+
+    stats = ret["stats"]
+    assert stats[-1]["done"], "Solver Failed to converge"
+    assert any(s["collapse"] for s in stats), "Subspace was never collapsed"
+    # collapsed vectors reuse the cached products, no products are computed in the iteration after a collapse
+    for prev, cur in zip(stats, stats[1:]):
+        if prev["collapse"]:
+            assert cur["product_count"] == prev["product_count"]
+
+    ref_vals = np.sort(np.linalg.eigvalsh(test_engine.A))[:nroot]
+    compare_arrays(ref_vals, ret["eigvals"], 6, "Davidson eigenvalues")
+
+
 @pytest.mark.unittest
 @pytest.mark.solver
 def test_hamiltonian_solver():
@@ -1,6 +1,7 @@
 #! examine JK packing forms
 
 import psi4
+import itertools
 import numpy as np
 from collections import OrderedDict
 
@@ -82,7 +83,7 @@ for method in methods:
         if(form != 'pqQ' and method == 'DIRECT_iaQ'): continue
         for AO_core in [False, True]:
             for MO_core in [False, True]:
-                for hold_met in [False, True]:
+                for hold_met, overlap_io in itertools.product([False, True], repeat=2):
                             
                     # get object
                     dfh = psi4.core.DFHelper(primary, aux)
@@ -95,6 +96,7 @@ for method in methods:
                     dfh.set_AO_core(AO_core)
                     dfh.set_MO_core(MO_core)
                     dfh.hold_met(hold_met)
+                    dfh.set_overlap_io(overlap_io)
 
                     # build
                     dfh.initialize()
@@ -124,8 +126,8 @@ for method in methods:
                         for ind, i in enumerate(transformations):
                             dfh_Qmo.append(np.asarray(dfh.get_tensor(i)))
 
-                    test_string = 'Alg: ' + method + ' + ' + form + ' core (AOs, MOs, met): [' 
-                    test_string += str(AO_core) + ', ' + str(MO_core) + ', ' + str(hold_met) +  ']' 
+                    test_string = 'Alg: ' + method + ' + ' + form + ' core (AOs, MOs, met), overlap I/O: [' 
+                    test_string += str(AO_core) + ', ' + str(MO_core) + ', ' + str(hold_met) +  '], ' + str(overlap_io)
 
                     print(test_string)
                     # am i right?
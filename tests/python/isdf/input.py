@@ -0,0 +1,58 @@
+#! ISDF/THC factorization of the water DF integrals against the exact fitted tensor
+
+import psi4
+import numpy as np
+
+psi4.set_output_file("output.dat", False)
+
+mol = psi4.geometry("""
+O
+H 1 1.0
+H 1 1.0 2 104.5
+symmetry c1
+""")
+
+psi4.set_options({'dft_spherical_points': 302,
+                  'dft_radial_points': 75})
+
+primary = psi4.core.BasisSet.build(mol, "ORBITAL", "cc-pVDZ")
+aux = psi4.core.BasisSet.build(mol, "ORBITAL", "cc-pVDZ-jkfit")
+grid = psi4.core.DFTGrid.build(mol, primary)
+
+nbf = primary.nbf()
+naux = aux.nbf()
+
+# exact symmetrically fitted B_Qmn
+mints = psi4.core.MintsHelper(primary)
+zero_bas = psi4.core.BasisSet.zero_ao_basis_set()
+Jinv = mints.ao_eri(aux, zero_bas, aux, zero_bas)
+Jinv.power(-0.5, 1.e-12)
+Jinv = np.squeeze(Jinv)
+Qpq = np.squeeze(mints.ao_eri(aux, zero_bas, primary, primary))
+Bexact = Jinv.dot(Qpq.reshape(naux, -1)).reshape(naux, nbf, nbf)
+
+isdf = psi4.core.ISDF(primary, aux, grid)
+isdf.set_tolerance(1.e-8)
+isdf.compute()
+
+X = isdf.X().np
+Y = isdf.Y().np
+Bisdf = np.einsum('QP,mP,nP->Qmn', Y, X, X)
+
+psi4.compare_integers(1, int(isdf.npoints() < grid.npoints()), 'ISDF selects a subset of the grid')
+psi4.compare_integers(1, int(isdf.npoints() <= nbf * (nbf + 1) // 2), 'ISDF rank bounded by the pair space')
+
+# Coulomb energy of a core guess density, the usual THC accuracy measure
+H = mints.ao_kinetic().np + mints.ao_potential().np
+S = mints.ao_overlap().np
+e, C = np.linalg.eigh(np.linalg.inv(np.linalg.cholesky(S)).dot(H).dot(np.linalg.inv(np.linalg.cholesky(S)).T))
+C = np.linalg.inv(np.linalg.cholesky(S)).T.dot(C)[:, :5]
+D = C.dot(C.T)
+
+Eexact = np.einsum('Qmn,mn->Q', Bexact, D)
+Eisdf = np.einsum('Qmn,mn->Q', Bisdf, D)
+psi4.compare_values(Eexact.dot(Eexact), Eisdf.dot(Eisdf), 4, 'ISDF Coulomb energy')
+
+Z = isdf.Z().np
+psi4.compare_values(Eisdf.dot(Eisdf), np.einsum('mnP,PQ,lsQ,mn,ls->', np.einsum('mP,nP->mnP', X, X), Z,
+                                                np.einsum('mP,nP->mnP', X, X), D, D), 8, 'THC core Z = Y^T Y')